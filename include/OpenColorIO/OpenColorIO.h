@@ -6,9 +6,11 @@
 #define INCLUDED_OCIO_OPENCOLORIO_H
 
 #include <stdexcept>
+#include <atomic>
 #include <iosfwd>
 #include <string>
 #include <cstddef>
+#include <future>
 
 #include "OpenColorABI.h"
 #include "OpenColorTypes.h"
@@ -99,6 +101,23 @@ OCIO_NAMESPACE_ENTER
         ExceptionMissingFile();
         ExceptionMissingFile & operator= (const ExceptionMissingFile &);
     };
+
+    //!cpp:class:: An exception class thrown when a CPU processing or a CPU processor
+    // finalization is stopped by its :cpp:class:`CPUCancellationToken`.
+    class OCIOEXPORT ExceptionCancelled : public Exception
+    {
+    public:
+        //!cpp:function:: Constructor that takes a string as the exception message.
+        explicit ExceptionCancelled(const char *);
+        //!cpp:function:: Constructor that takes an existing exception.
+        ExceptionCancelled(const ExceptionCancelled &);
+
+        ~ExceptionCancelled();
+
+    private:
+        ExceptionCancelled();
+        ExceptionCancelled & operator= (const ExceptionCancelled &);
+    };
     
     ///////////////////////////////////////////////////////////////////////////
     //!rst::
@@ -114,6 +133,24 @@ OCIO_NAMESPACE_ENTER
     // restarting.
     
     extern OCIOEXPORT void ClearAllCaches();
+
+    //!cpp:function:: Get the approximate number of bytes held by a global cache (i.e. the
+    // cached values and their keys, not counting the allocator overhead). Note that the
+    // processors cached by a config (refer to :cpp:func:`SetProcessorCacheSize`) are not
+    // global, refer to :cpp:func:`CPUProcessor::getMemoryFootprint` and
+    // :cpp:func:`GPUProcessor::getMemoryFootprint` for the processors.
+    extern OCIOEXPORT size_t GetCacheMemoryUsage(CacheType type);
+    //!cpp:function:: Get the approximate number of bytes held by all the global caches.
+    extern OCIOEXPORT size_t GetAllCachesMemoryUsage();
+
+    //!cpp:function:: Get a cumulative statistic of a cache since the library loading or the
+    // last :cpp:func:`ResetCacheStatistics` call, all threads included (e.g. to size the
+    // caches, or to measure the lock contention of concurrent processors). The lookups
+    // answered before taking any lock (e.g. a frozen context) are not counted.
+    extern OCIOEXPORT unsigned long long GetCacheStatistic(CacheType type,
+                                                           CacheStatistic statistic);
+    //!cpp:function:: Reset the statistics of all the caches.
+    extern OCIOEXPORT void ResetCacheStatistics();
     
     //!cpp:function:: Get the version number for the library, as a
     // dot-delimited string (e.g., "1.0.0"). This is also available
@@ -143,6 +180,184 @@ OCIO_NAMESPACE_ENTER
     extern OCIOEXPORT void SetLoggingFunction(LoggingFunction logFunction);
     extern OCIOEXPORT void ResetToDefaultLoggingFunction();
 
+    //!cpp:function:: Set the function receiving the tracing events of the library i.e. the
+    // begin & end events of the spans timing the config loading, the file loading (e.g. a
+    // LUT file), and the building, optimization and finalization of the processors. An
+    // empty function (the default) disables the tracing. The function could be called
+    // concurrently by several threads but the two events of a span always come from the
+    // same thread (e.g. to write the "B" and "E" events of a Chrome trace file).
+    extern OCIOEXPORT void SetTracingFunction(const TracingFunction & traceFunction);
+
+    //!cpp:function:: Set the number of threads of the internal work-stealing thread pool
+    // used by :cpp:func:`CPUProcessor::apply` when no executor is supplied. The default
+    // value of zero uses the number of hardware threads.
+    extern OCIOEXPORT void SetNumCPUThreads(unsigned numThreads);
+    //!cpp:function:: Get the number of threads of the internal thread pool.
+    extern OCIOEXPORT unsigned GetNumCPUThreads();
+
+    //!cpp:function:: Enable the NUMA-aware parallel processing (disabled by default).
+    // On a machine with several NUMA nodes, the threads of the internal thread pool are
+    // then pinned to the nodes, each node processes contiguous bands of lines, and each
+    // node uses its own copy of the CPU processor tables (e.g. 3D LUTs) allocated in its
+    // local memory. Note that the NUMA topology is currently only detected on Linux.
+    extern OCIOEXPORT void SetCPUNumaAware(bool numaAware);
+    //!cpp:function:: Is the NUMA-aware parallel processing enabled?
+    extern OCIOEXPORT bool IsCPUNumaAware();
+
+    //!cpp:function:: Set the maximum number of pixels processed at once by the CPU
+    // processing i.e. image lines are split into blocks of that size so the intermediate
+    // RGBA F32 buffer stays in the CPU data cache. The default value of zero computes a
+    // size from the L1 data cache size.
+    extern OCIOEXPORT void SetCPUBlockSize(long numPixels);
+    //!cpp:function:: Get the maximum number of pixels processed at once by the CPU processing.
+    extern OCIOEXPORT long GetCPUBlockSize();
+
+    //!cpp:function:: Set the size in bytes from which the destination image buffer of
+    // :cpp:func:`CPUProcessor::apply` (i.e. with distinct source and destination buffers)
+    // is written with streaming (i.e. non-temporal) stores, so a large write-once result
+    // does not evict the rest of the working set from the CPU caches. Only the packed
+    // destination buffers (e.g. RGBA, BGR) are concerned. The default value of zero uses
+    // the size of the last level CPU cache. Use the largest value to never stream.
+    extern OCIOEXPORT void SetCPUStreamingStoreThreshold(size_t numBytes);
+    //!cpp:function:: Get the size in bytes from which the destination image buffer is
+    // written with streaming stores.
+    extern OCIOEXPORT size_t GetCPUStreamingStoreThreshold();
+
+    //!cpp:function:: Store the 3D LUT tables of the CPU processing as half floats when
+    // the processor is finalized with :c:macro:`FINALIZATION_FAST` (disabled by default).
+    // It halves the memory footprint of the tables (e.g. 2.2 MB instead of 4.4 MB for a
+    // 65x65x65 LUT) at the cost of the half float precision of the LUT values.
+    extern OCIOEXPORT void SetCPULut3DHalfStorage(bool halfStorage);
+    //!cpp:function:: Are the 3D LUT tables of the CPU processing stored as half floats?
+    extern OCIOEXPORT bool IsCPULut3DHalfStorage();
+
+    //!cpp:function:: Share the 3D LUT tables of the CPU processing between the processes
+    // of the same user on the node (disabled by default), overriding the
+    // :envvar:`OCIO_CPU_SHARED_LUT_MEMORY` environment variable. The first process needing
+    // the tables of some LUT values publishes them in a shared memory named from their
+    // hash, and the other processes (e.g. several applications or render slots loading the
+    // same show LUTs) map them read-only instead of holding their own copy. A shared memory
+    // is removed with its last user. Only the tables of at least 64 KB (e.g. a 17x17x17
+    // LUT) are shared, and the processing results are unchanged.
+    extern OCIOEXPORT void SetCPUSharedLutMemory(bool sharedMemory);
+    //!cpp:function:: Are the 3D LUT tables of the CPU processing shared between the processes?
+    extern OCIOEXPORT bool IsCPUSharedLutMemory();
+
+    //!cpp:function:: Use faster but less accurate polynomial approximations of the log,
+    // exponential and power functions in the CPU renderers of the Log, Gamma and Exponent
+    // ops when the processor is finalized with :c:macro:`FINALIZATION_FAST` (disabled by
+    // default). The relative error of a power function is then smaller than
+    // 6.5e-5 * abs(exponent) + 8e-5 (instead of about 1e-5), and the absolute error of a
+    // log2 function is smaller than 1e-4 (instead of 1.3e-5) which is fine for a viewer.
+    // Only the SSE builds have the faster approximations.
+    extern OCIOEXPORT void SetCPUFastMath(bool fastMath);
+    //!cpp:function:: Do the CPU renderers use the faster math approximations?
+    extern OCIOEXPORT bool IsCPUFastMath();
+
+    //!cpp:function:: Promise that the pixel values processed by the CPU processors
+    // created afterwards are finite and within the half float range i.e. [-65504, 65504]
+    // (disabled by default). The CPU renderers of the half domain 1D LUTs then skip the
+    // NaN & infinity handling of their input values. The results are identical for such
+    // values, and undefined otherwise.
+    extern OCIOEXPORT void SetCPUFiniteInputs(bool finiteInputs);
+    //!cpp:function:: Are the pixel values processed by the CPU processors known to be finite?
+    extern OCIOEXPORT bool IsCPUFiniteInputs();
+
+    //!cpp:function:: Set the edge length of the 3D LUT replacing the whole processing
+    // when the :c:macro:`OPTIMIZATION_BAKE_LUT3D` optimization is requested. The default
+    // value is 33.
+    extern OCIOEXPORT void SetBakedLut3DSize(unsigned edgeLen);
+    //!cpp:function:: Get the edge length of the 3D LUT used by the baking optimization.
+    extern OCIOEXPORT unsigned GetBakedLut3DSize();
+
+    //!cpp:function:: Set the maximum error of the piecewise linear curves replacing the
+    // strings of separable ops when the :c:macro:`OPTIMIZATION_APPROX_SEPARABLE`
+    // optimization is requested. It is an absolute error below one, and a relative error
+    // above. The default value is 1e-4.
+    extern OCIOEXPORT void SetApproximationMaxError(double maxError);
+    //!cpp:function:: Get the maximum error used by the approximation optimization.
+    extern OCIOEXPORT double GetApproximationMaxError();
+
+    //!cpp:function:: Set the maximum number of processors cached by each config. The
+    // default value is 64 and zero disables the caches. :cpp:func:`Config::getProcessor`
+    // then returns the same processor for the same context and the same color spaces
+    // (or the same :cpp:class:`ColorSpaceTransform` or :cpp:class:`DisplayTransform`
+    // without any embedded transform) until the config is modified. The processors
+    // having dynamic properties are never cached. Changing the size (or calling
+    // :cpp:func:`ClearAllCaches`) clears the caches.
+    extern OCIOEXPORT void SetProcessorCacheSize(unsigned numProcessors);
+    //!cpp:function:: Get the maximum number of processors cached by each config.
+    extern OCIOEXPORT unsigned GetProcessorCacheSize();
+
+    //!cpp:function:: Set the directory of the processor disk cache (disabled by default
+    // i.e. an empty directory), overriding the :envvar:`OCIO_PROCESSOR_CACHE_DIR`
+    // environment variable. The processors which could be cached by a config (refer to
+    // :cpp:func:`SetProcessorCacheSize`) are then also saved to files named from the
+    // config cache id (i.e. including the files used by the config), the context and
+    // the color spaces or transform. Later :cpp:func:`Config::getProcessor` calls, from
+    // any process sharing the directory, load the processor from its file (i.e. the
+    // ops in the CTF format) instead of building it from the config and its LUT files.
+    // Note that the directory is never cleaned up.
+    extern OCIOEXPORT void SetProcessorDiskCacheDir(const char * dir);
+    //!cpp:function:: Get the directory of the processor disk cache. The returned string
+    // is only valid until the next call to :cpp:func:`SetProcessorDiskCacheDir`.
+    extern OCIOEXPORT const char * GetProcessorDiskCacheDir();
+
+    //!cpp:function:: Enable or disable the lazy loading of the color space transforms
+    // (disabled by default), overriding the :envvar:`OCIO_LAZY_TRANSFORMS` environment
+    // variable. When enabled, the configs read from a file or a stream only create the
+    // transforms of a color space on first use (e.g. by :cpp:func:`Config::getProcessor`)
+    // instead of creating all of them while reading, speeding up the loading of the
+    // large configs. Note that the errors in a transform definition are then only
+    // reported on first use.
+    extern OCIOEXPORT void SetLazyTransformLoading(bool enable);
+    //!cpp:function:: Is the lazy loading of the color space transforms enabled?
+    extern OCIOEXPORT bool GetLazyTransformLoading();
+
+    //!cpp:function:: Set the maximum number of bytes held by the cache of the files
+    // loaded by the :cpp:class:`FileTransform` (e.g. the LUT files). The default value is
+    // 512 MB. The cache is split in several shards each getting an equal part of the
+    // budget and, when over it, removing its least recently used files (but each shard
+    // always keeps its most recently used file). Reducing the budget immediately removes
+    // the files over it.
+    extern OCIOEXPORT void SetFileCacheMemoryBudget(size_t numBytes);
+    //!cpp:function:: Get the maximum number of bytes held by the file cache.
+    extern OCIOEXPORT size_t GetFileCacheMemoryBudget();
+
+    //!cpp:function:: Set the minimum number of milliseconds between two checks (i.e. of
+    // the modification time, the inode number and the size) of a cached file. A file
+    // changed since its loading is then loaded again by the :cpp:class:`FileTransform`
+    // and :cpp:func:`CDLTransform::CreateFromFile`, and the processors cached by the
+    // configs (refer to :cpp:func:`SetProcessorCacheSize`) using the file are created
+    // again, the other cached files and processors being kept. The default value of zero
+    // never checks the files i.e. only :cpp:func:`ClearAllCaches` reloads them.
+    extern OCIOEXPORT void SetFileCacheCheckInterval(unsigned milliseconds);
+    //!cpp:function:: Get the minimum number of milliseconds between two checks of a cached file.
+    extern OCIOEXPORT unsigned GetFileCacheCheckInterval();
+
+    //!cpp:function:: Set the directory of the file disk cache (disabled by default i.e.
+    // an empty directory), overriding the :envvar:`OCIO_FILE_CACHE_DIR` environment
+    // variable. The files loaded by the :cpp:class:`FileTransform` are then also saved,
+    // once parsed, to binary files named from the file path and its modification time,
+    // inode number and size. Later loadings of the files, from any process sharing the
+    // directory, read the binary files (i.e. the LUT arrays, the CDL parameters and the
+    // metadata) instead of parsing the original files. Note that only some formats are
+    // supported (i.e. spi1d, spi3d, Iridas & Resolve cube and ColorCorrection) and that
+    // the directory is never cleaned up.
+    extern OCIOEXPORT void SetFileDiskCacheDir(const char * dir);
+    //!cpp:function:: Get the directory of the file disk cache. The returned string
+    // is only valid until the next call to :cpp:func:`SetFileDiskCacheDir`.
+    extern OCIOEXPORT const char * GetFileDiskCacheDir();
+
+    //!cpp:function:: Get the dimensions of the LUTs of a file (i.e. zero when the file
+    // has no such LUT) by only reading its header, the LUT values being neither read
+    // nor cached. Return false when the file format does not support the header-only
+    // reading (only the spi3d and cube formats support it). The file path must be resolved
+    // (refer to :cpp:func:`Context::resolveFileLocation`).
+    extern OCIOEXPORT bool GetFileLutDimensions(const char * filepath,
+                                                unsigned & lut1DSize,
+                                                unsigned & lut3DSize);
+
     //
     // Note that the following env. variable access methods are not thread safe.
     //
@@ -228,6 +443,13 @@ OCIO_NAMESPACE_ENTER
         
         //!cpp:function::
         ConfigRcPtr createEditableCopy() const;
+        //!cpp:function:: Create an immutable copy of the configuration for concurrent use
+        // (e.g. by many render threads). All the lazily computed states (i.e. color space
+        // transforms, displays, sanity check, file references resolved in the current
+        // context and cache ids) are computed upfront so the common read paths of the
+        // snapshot do not take any lock. Use :cpp:func:`Config::createEditableCopy` to
+        // modify it.
+        ConstConfigRcPtr createSnapshot() const;
 
         //!cpp:function:: Get the configuration major version
         unsigned int getMajorVersion() const;
@@ -565,6 +787,16 @@ OCIO_NAMESPACE_ENTER
         ConstProcessorRcPtr getProcessor(const ConstContextRcPtr & context,
                                          const char * srcName,
                                          const char * dstName) const;
+
+        //!cpp:function:: Same as :cpp:func:`Config::getProcessor` but return an empty
+        // pointer, instead of throwing, when a color space (or role) name is not found
+        // (e.g. to cheaply probe many candidate color spaces). The other errors still throw.
+        ConstProcessorRcPtr tryGetProcessor(const char * srcName,
+                                            const char * dstName) const;
+        //!cpp:function::
+        ConstProcessorRcPtr tryGetProcessor(const ConstContextRcPtr & context,
+                                            const char * srcName,
+                                            const char * dstName) const;
         
         //!rst:: Get the processor for the specified transform.
         //
@@ -581,6 +813,28 @@ OCIO_NAMESPACE_ENTER
                                          const ConstTransformRcPtr& transform,
                                          TransformDirection direction) const;
 
+        //!cpp:function:: Load in the file cache, using numThreads threads (or the number
+        // of hardware threads when zero), all the files referenced by the color spaces
+        // and looks of the config i.e. the files resolved using the context. The first
+        // processors then do not wait on the sequential loading of their files. Note that
+        // the files failing to load are skipped, the error being reported by the
+        // processors using them.
+        void preloadFiles(const ConstContextRcPtr & context, unsigned numThreads) const;
+
+        //!cpp:function:: Build in background threads, using numThreads threads (or the
+        // number of hardware threads when zero), the processors from each source color
+        // space to all the active displays and views, and their default CPU and GPU
+        // processors. The processors are then found in the processor cache (refer to
+        // :cpp:func:`SetProcessorCacheSize`) i.e. the first view switches do not wait
+        // on the processor constructions. The source color spaces are a comma separated
+        // list (as for :cpp:func:`Config::setActiveDisplays`) where an empty list means
+        // the scene_linear role. The returned :cpp:class:`ProcessorWarmup` reports the
+        // progress and allows to cancel. Note that the config must outlive the warm-up
+        // (i.e. the destruction of the returned object cancels and waits).
+        ProcessorWarmupRcPtr warmupProcessors(const ConstContextRcPtr & context,
+                                              const char * srcColorSpaces,
+                                              unsigned numThreads) const;
+
     private:
         Config();
         ~Config();
@@ -765,6 +1019,12 @@ OCIO_NAMESPACE_ENTER
         
         static void deleter(ColorSpace* c);
         
+        // The config reader could defer the creation of the transforms to
+        // their first use (refer to SetLazyTransformLoading()).
+        friend class OCIOYaml;
+        typedef std::function<TransformRcPtr()> TransformLoader;
+        void setTransformLoader(const TransformLoader & loader, ColorSpaceDirection dir);
+
         class Impl;
         friend class Impl;
         Impl * m_impl;
@@ -1002,26 +1262,41 @@ OCIO_NAMESPACE_ENTER
         DynamicPropertyRcPtr getDynamicProperty(DynamicPropertyType type) const;
         bool hasDynamicProperty(DynamicPropertyType type) const;
 
-        //!cpp:function:: 
+        //!cpp:function:: Get an identifier of the color processing. It is computed from
+        // the losslessly optimized ops so the processors doing the same color processing
+        // (e.g. built from a file or from the equivalent inline transforms) have the same
+        // identifier and share their finalized :cpp:class:`GPUProcessor` instances.
         const char * getCacheID() const;
 
         ///////////////////////////////////////////////////////////////////////////
         //!rst::
         // GPU Renderer
         // ^^^^^^^^^^^^
-        // Get an optimized :cpp:class:`GPUProcessor` instance.
+        // Get an optimized :cpp:class:`GPUProcessor` instance. The instances are
+        // memoized i.e. the same flags return the same instance, except when the
+        // processor has dynamic properties.
 
         //!cpp:function::        
         ConstGPUProcessorRcPtr getDefaultGPUProcessor() const;
         //!cpp:function::        
         ConstGPUProcessorRcPtr getOptimizedGPUProcessor(OptimizationFlags oFlags, 
                                                         FinalizationFlags fFlags) const;
+        //!cpp:function:: Same as above but the LUTs follow the interpolation quality
+        // (e.g. a cheaper interpolation for previews), refer to
+        // :cpp:type:`LutInterpolationQuality`. The cache identifier of the shader then
+        // differs from the one of the full quality.
+        ConstGPUProcessorRcPtr getOptimizedGPUProcessor(OptimizationFlags oFlags,
+                                                        FinalizationFlags fFlags,
+                                                        LutInterpolationQuality interpQuality) const;
         
         ///////////////////////////////////////////////////////////////////////////
         //!rst::
         // CPU Renderer
         // ^^^^^^^^^^^^
-        // Get an optimized :cpp:class:`CPUProcessor` instance.
+        // Get an optimized :cpp:class:`CPUProcessor` instance. The instances are
+        // memoized i.e. the same bit-depths and flags return the same instance, except
+        // when the processor has dynamic properties (each instance then owns its
+        // dynamic properties).
         //        
         // .. note::
         //    This may provide higher fidelity than anticipated due to internal
@@ -1059,6 +1334,48 @@ OCIO_NAMESPACE_ENTER
                                                         OptimizationFlags oFlags, 
                                                         FinalizationFlags fFlags) const;
 
+        //!rst::
+        // Same as above but the finalization (e.g. the inversion of the LUTs) could be
+        // stopped, or prioritized, by a :cpp:class:`CPUCancellationToken`. A stopped
+        // finalization throws an :cpp:class:`ExceptionCancelled` and is not memoized.
+
+        //!cpp:function::
+        ConstCPUProcessorRcPtr getOptimizedCPUProcessor(BitDepth inBitDepth,
+                                                        BitDepth outBitDepth,
+                                                        OptimizationFlags oFlags,
+                                                        FinalizationFlags fFlags,
+                                                        const CPUCancellationToken & token) const;
+
+        //!rst::
+        // Same as above but the LUTs follow the interpolation quality, refer to
+        // :cpp:type:`LutInterpolationQuality`. For example, LUT_INTERPOLATION_DRAFT renders
+        // the 3D LUTs with their nearest entries for a fast scrubbing, while
+        // LUT_INTERPOLATION_FULL is identical to the overload without quality. The
+        // interpolation quality is part of the cache identifier of the CPU processor.
+
+        //!cpp:function::
+        ConstCPUProcessorRcPtr getOptimizedCPUProcessor(BitDepth inBitDepth,
+                                                        BitDepth outBitDepth,
+                                                        OptimizationFlags oFlags,
+                                                        FinalizationFlags fFlags,
+                                                        LutInterpolationQuality interpQuality) const;
+
+        //!rst::
+        // Get a render-only :cpp:class:`CPUProcessor` instance i.e. it only keeps the CPU
+        // renderers. The finalized ops are released once the renderers are created, the
+        // :cpp:class:`ProcessorMetadata` only lists the files, looks and renderers, and
+        // the instance is neither memoized nor replicated per NUMA node (refer to
+        // :cpp:func:`SetCPUNumaAware`). Once the processor itself is released (and
+        // not held by a config cache, refer to :cpp:func:`SetProcessorCacheSize`), only
+        // the renderer tables remain in memory which suits pure rendering (e.g. batch
+        // conversions or plugin pixel engines).
+
+        //!cpp:function::
+        ConstCPUProcessorRcPtr getRenderOnlyCPUProcessor(BitDepth inBitDepth,
+                                                         BitDepth outBitDepth,
+                                                         OptimizationFlags oFlags,
+                                                         FinalizationFlags fFlags) const;
+
     private:
         Processor();
         ~Processor();
@@ -1071,6 +1388,7 @@ OCIO_NAMESPACE_ENTER
         static void deleter(Processor* c);
         
         friend class Config;
+        friend class CPUProcessorGroup;
         
         class Impl;
         Impl * m_impl;
@@ -1083,7 +1401,55 @@ OCIO_NAMESPACE_ENTER
     //!rst::
     // CPUProcessor
     // ************
-    
+
+    //!rst::
+    // Lets a client stop a long CPU processing (or a CPU processor finalization) which
+    // became useless, and give it a scheduling priority. The token is checked between
+    // the bands of lines, the blocks of the parallel evaluations (e.g. the inversions of
+    // the LUTs) and the finalization stages, the stopped call then throwing an
+    // :cpp:class:`ExceptionCancelled` (the destination image being partially processed).
+    // The priority orders the pending tasks of the internal thread pool, it is ignored
+    // by the client executors (refer to :cpp:type:`CPUExecutor`).
+    //
+    // .. note::
+    //    The token must stay valid until the completion of the calls using it. A token
+    //    could be used by several calls, and cancelled from any thread.
+    //
+    // .. code-block:: cpp
+    //
+    //     OCIO::CPUCancellationToken token;
+    //     token.setPriority(OCIO::CPU_PRIORITY_HIGH);
+    //     std::future<void> done = cpuProcessor->applyAsync(frame, token);
+    //     // The user scrubs to another frame.
+    //     token.cancel();
+
+    //!cpp:class::
+    class OCIOEXPORT CPUCancellationToken
+    {
+    public:
+        //!cpp:function::
+        CPUCancellationToken() = default;
+        CPUCancellationToken(const CPUCancellationToken &) = delete;
+        CPUCancellationToken & operator=(const CPUCancellationToken &) = delete;
+
+        //!cpp:function:: Request the pending and future calls using the token to stop.
+        void cancel() noexcept;
+        //!cpp:function::
+        bool isCancelled() const noexcept;
+        //!cpp:function:: Clear the cancellation so the token could be reused.
+        void reset() noexcept;
+
+        //!cpp:function:: The default priority is :c:macro:`CPU_PRIORITY_NORMAL`. Only the
+        // tasks scheduled after the change use the new priority.
+        void setPriority(CPUPriority priority) noexcept;
+        //!cpp:function::
+        CPUPriority getPriority() const noexcept;
+
+    private:
+        std::atomic<bool> m_cancelled{ false };
+        std::atomic<int>  m_priority{ CPU_PRIORITY_NORMAL };
+    };
+
     //!cpp:class::
     class CPUProcessor
     {
@@ -1102,6 +1468,12 @@ OCIO_NAMESPACE_ENTER
         //!cpp:function:: Refer to :cpp:func:`GPUProcessor::getDynamicProperty`.
         DynamicPropertyRcPtr getDynamicProperty(DynamicPropertyType type) const;
 
+        //!cpp:function:: In addition to the files and looks used, the ProcessorMetadata
+        //                reports how the color processing was optimized i.e. the ops
+        //                before and after the optimization, the optimization passes which
+        //                changed the ops, the time spent and the selected renderers.
+        ConstProcessorMetadataRcPtr getProcessorMetadata() const;
+
         ///////////////////////////////////////////////////////////////////////////
         //!rst::
         // Apply to an image with any kind of channel ordering while respecting 
@@ -1112,6 +1484,117 @@ OCIO_NAMESPACE_ENTER
         //!cpp:function:: 
         void apply(const ImageDesc & srcImgDesc, ImageDesc & dstImgDesc) const;
 
+        //!rst::
+        // Apply to an image using several threads. The image is split into bands of
+        // lines which are processed concurrently. The bands are scheduled by the
+        // executor or, if the executor is empty, by the internal work-stealing thread
+        // pool (refer to :cpp:func:`SetNumCPUThreads`).
+        //
+        // .. code-block:: cpp
+        //
+        //     // Use the internal thread pool.
+        //     cpuProcessor->apply(img, OCIO::CPUExecutor());
+        //
+        //     // Use a client scheduler (e.g. TBB).
+        //     cpuProcessor->apply(img, [](long numTasks, const std::function<void(long)> & task)
+        //     {
+        //         tbb::parallel_for(0L, numTasks, task);
+        //     });
+
+        //!cpp:function:: 
+        void apply(ImageDesc & imgDesc, const CPUExecutor & executor) const;
+        //!cpp:function:: 
+        void apply(const ImageDesc & srcImgDesc, ImageDesc & dstImgDesc,
+                   const CPUExecutor & executor) const;
+
+        //!rst::
+        // Apply to an image using overridden values of the dynamic properties, only for
+        // this call (refer to :cpp:class:`DynamicPropertyOverrides`). The dynamic properties
+        // of the processor are unchanged so several threads could concurrently share the
+        // same processor (and its tables) with different values. It throws if a value
+        // overrides a property which is not dynamic in the processor.
+        //
+        // .. code-block:: cpp
+        //
+        //     OCIO::DynamicPropertyOverrides overrides;
+        //     overrides.setValue(OCIO::DYNAMIC_PROPERTY_EXPOSURE, shotExposure);
+        //     cpuProcessor->apply(thumbnail, overrides);
+
+        //!cpp:function:: 
+        void apply(ImageDesc & imgDesc, const DynamicPropertyOverrides & overrides) const;
+        //!cpp:function:: 
+        void apply(const ImageDesc & srcImgDesc, ImageDesc & dstImgDesc,
+                   const DynamicPropertyOverrides & overrides) const;
+        //!cpp:function:: 
+        void apply(ImageDesc & imgDesc, const CPUExecutor & executor,
+                   const DynamicPropertyOverrides & overrides) const;
+        //!cpp:function:: 
+        void apply(const ImageDesc & srcImgDesc, ImageDesc & dstImgDesc,
+                   const CPUExecutor & executor,
+                   const DynamicPropertyOverrides & overrides) const;
+
+        //!rst::
+        // Apply asynchronously to an image using the internal thread pool. The returned
+        // future completes once the whole image is processed (and rethrows any processing
+        // error). The optional callback is notified each time a band of lines is done so
+        // the caller can, for example, start writing the finished lines while the
+        // remaining ones are still processed.
+        //
+        // .. note::
+        //    The image descriptions and the CPU processor must stay valid until the
+        //    completion. Destroying the future waits for the completion.
+        //
+        // .. code-block:: cpp
+        //
+        //     std::future<void> done = cpuProcessor->applyAsync(src, dst,
+        //         [](long yBegin, long yEnd) { /* Encode the lines [yBegin, yEnd[. */ });
+        //     // Read the next frame...
+        //     done.get();
+
+        //!cpp:function:: 
+        std::future<void> applyAsync(ImageDesc & imgDesc,
+                                     const CPUBandCallback & bandDone = CPUBandCallback()) const;
+        //!cpp:function:: 
+        std::future<void> applyAsync(const ImageDesc & srcImgDesc, ImageDesc & dstImgDesc,
+                                     const CPUBandCallback & bandDone = CPUBandCallback()) const;
+
+        //!rst::
+        // Same as above but the processing could be stopped, or prioritized, by a
+        // :cpp:class:`CPUCancellationToken`. A stopped processing throws an
+        // :cpp:class:`ExceptionCancelled` (i.e. the future rethrows it).
+
+        //!cpp:function::
+        void apply(ImageDesc & imgDesc, const CPUExecutor & executor,
+                   const CPUCancellationToken & token) const;
+        //!cpp:function::
+        void apply(const ImageDesc & srcImgDesc, ImageDesc & dstImgDesc,
+                   const CPUExecutor & executor, const CPUCancellationToken & token) const;
+        //!cpp:function::
+        std::future<void> applyAsync(ImageDesc & imgDesc, const CPUCancellationToken & token,
+                                     const CPUBandCallback & bandDone = CPUBandCallback()) const;
+        //!cpp:function::
+        std::future<void> applyAsync(const ImageDesc & srcImgDesc, ImageDesc & dstImgDesc,
+                                     const CPUCancellationToken & token,
+                                     const CPUBandCallback & bandDone = CPUBandCallback()) const;
+
+        //!rst::
+        // Apply to several images in one call (e.g. thumbnails, swatches or texture tiles),
+        // `srcImgDescs[i]` being processed to `dstImgDescs[i]` (i.e. in place when both point
+        // to the same image description). The pixels of the small images are processed
+        // together in blocks spanning several images, so the cost per image is much lower
+        // than one :cpp:func:`CPUProcessor::apply` call per image. With an executor, the
+        // images are processed using several threads (as for :cpp:func:`CPUProcessor::apply`).
+        //
+        // .. note::
+        //    The image buffers of the different images must not overlap.
+
+        //!cpp:function:: 
+        void apply(const ImageDesc * const * srcImgDescs, ImageDesc * const * dstImgDescs,
+                   size_t numImages) const;
+        //!cpp:function:: 
+        void apply(const ImageDesc * const * srcImgDescs, ImageDesc * const * dstImgDescs,
+                   size_t numImages, const CPUExecutor & executor) const;
+
         //!rst::
         // Apply to a single pixel respecting that the input and output bit-depths
         // be 32-bit float and the image buffer be packed RGB/RGBA.
@@ -1126,6 +1609,107 @@ OCIO_NAMESPACE_ENTER
         //!cpp:function:: 
         void applyRGBA(float * pixel) const;
 
+        //!rst::
+        // Apply to an array of pixels (e.g. scattered colors) respecting that the input
+        // and output bit-depths be 32-bit float. The pixels are processed in blocks so it
+        // is as efficient as applying to an image. The stride is the number of bytes
+        // between two consecutive pixels (AutoStride means packed pixels).
+
+        //!cpp:function:: 
+        void applyRGB(float * pixels, long numPixels) const;
+        //!cpp:function:: 
+        void applyRGB(float * pixels, long numPixels, ptrdiff_t strideBytes) const;
+        //!cpp:function:: 
+        void applyRGBA(float * pixels, long numPixels) const;
+        //!cpp:function:: 
+        void applyRGBA(float * pixels, long numPixels, ptrdiff_t strideBytes) const;
+
+        //!rst::
+        // Profile the color processing i.e. apply it to packed RGBA 32-bit float pixels
+        // (in place, with the same blocks as :cpp:func:`CPUProcessor::applyRGBA`) while
+        // timing each renderer. The time spent by each renderer, in milliseconds, is added
+        // to the `times` array which must hold :cpp:func:`ProcessorMetadata::getNumRenderers`
+        // values (i.e. `times[i]` is the time of `getRenderer(i)`). It throws if the
+        // input or output bit-depth is not 32-bit float.
+        //
+        // .. note::
+        //    The timing adds a small overhead per block so the sum of the times is
+        //    slightly higher than the time of :cpp:func:`CPUProcessor::applyRGBA`.
+
+        //!cpp:function:: 
+        void profileRenderers(float * pixels, long numPixels, double * times) const;
+
+        //!rst::
+        // Instrument the image apply calls of the processor: when enabled, the time spent
+        // by each renderer and the number of pixels it processed are accumulated by all the
+        // threads applying the processor. The input & output bit-depth renderers include
+        // the unpacking & packing of the pixels. It is disabled by default, and then costs
+        // a single check per apply call (or per band of lines). The statistics (i.e. the
+        // times in milliseconds and the numbers of pixels, either array could be null) are
+        // copied in arrays holding :cpp:func:`ProcessorMetadata::getNumRenderers` values.
+        //
+        // .. note::
+        //    The processor could be shared (e.g. by the processor cache of the config) so
+        //    the statistics include all its apply calls.
+        //
+        // .. code-block:: cpp
+        //
+        //     cpuProcessor->setProfilingEnabled(true);
+        //     cpuProcessor->apply(img);
+        //
+        //     const int num = cpuProcessor->getProcessorMetadata()->getNumRenderers();
+        //     std::vector<double> times(num);
+        //     std::vector<long long> numPixels(num);
+        //     cpuProcessor->getProfilingStats(times.data(), numPixels.data());
+
+        //!cpp:function:: 
+        void setProfilingEnabled(bool enabled) const;
+        //!cpp:function:: 
+        bool isProfilingEnabled() const;
+        //!cpp:function:: 
+        void getProfilingStats(double * times, long long * numPixels) const;
+        //!cpp:function:: 
+        void resetProfilingStats() const;
+
+        //!rst::
+        // When the processor is finalized with :cpp:enumerator:`OPTIMIZATION_REPEATED_PIXELS`,
+        // the image apply calls count the pixels processed, and the pixels evaluated by the
+        // color processing (the others being copies of the previous identical pixel), so the
+        // hit rate is `1 - numEvaluatedPixels / numPixels`. Both are zero otherwise.
+        //
+        // .. note::
+        //    As for the profiling, the statistics include all the apply calls of the processor.
+
+        //!cpp:function:: 
+        void getRepeatedPixelsStats(long long & numPixels, long long & numEvaluatedPixels) const;
+        //!cpp:function:: 
+        void resetRepeatedPixelsStats() const;
+
+        //!cpp:function:: Get the approximate number of bytes held by the processor i.e. the
+        // ops and the tables built for the processing (e.g. the optimized 3D LUTs, the
+        // inverse LUT search structures, the integer lookup tables), including the replicas
+        // per NUMA node (refer to :cpp:func:`SetCPUNumaAware`). The op data shared with other
+        // processors (e.g. through the caches) are counted by each of them.
+        size_t getMemoryFootprint() const;
+
+        //!cpp:function:: Write a self-contained C++11 source file implementing the processor
+        // for fixed pipelines i.e. without any runtime dispatch. The file defines:
+        //
+        // * ``void <functionName>(float * rgba, long numPixels)`` processing in place packed
+        //   RGBA 32-bit float pixels,
+        // * ``extern const char <functionName>_cacheID[]`` holding the cache identifier of the
+        //   processor (refer to :cpp:func:`CPUProcessor::getCacheID`), so stale generated code
+        //   could be detected.
+        //
+        // The op parameters become constants and the LUTs static tables.
+        //
+        // .. note::
+        //    Only the 32-bit float processors of the matrix, range, 1D LUT, 3D LUT and basic
+        //    gamma ops are supported, an exception being thrown otherwise (e.g. for the
+        //    dynamic ops or the render-only processors). The results could slightly differ
+        //    from the processor ones (e.g. the power functions are never approximated).
+        void writeSourceCode(const char * functionName, std::ostream & os) const;
+
     private:
         CPUProcessor();
         ~CPUProcessor();
@@ -1136,6 +1720,91 @@ OCIO_NAMESPACE_ENTER
         static void deleter(CPUProcessor * c);
 
         friend class Processor;
+        friend class CPUProcessorGroup;
+
+        class Impl;
+        Impl * m_impl;
+        Impl * getImpl() { return m_impl; }
+        const Impl * getImpl() const { return m_impl; }
+    };
+
+
+    ///////////////////////////////////////////////////////////////////////////
+    //!rst::
+    // CPUProcessorGroup
+    // *****************
+    // Convert one source image buffer to several destination image buffers at once, for
+    // example a scene-linear frame to its SDR, HDR and proxy renditions. The ops shared by
+    // the start of all the processors (e.g. the conversion to the working space) are only
+    // evaluated once per pixel, each processed line being then converted to every
+    // destination image buffer while it is still in the CPU caches.
+    //
+    // .. note::
+    //    The shared ops and the remaining ops of each processor are optimized separately
+    //    so the results could slightly differ from the ones of the processors. The shared
+    //    ops stop at the first op having a dynamic property.
+    //
+    // .. code-block:: cpp
+    //
+    //     const OCIO::ConstProcessorRcPtr processors[2] = { toSDR, toHDR };
+    //     const OCIO::BitDepth outBitDepths[2] = { OCIO::BIT_DEPTH_UINT8, OCIO::BIT_DEPTH_F16 };
+    //
+    //     OCIO::ConstCPUProcessorGroupRcPtr group
+    //         = OCIO::CPUProcessorGroup::Create(processors, 2,
+    //                                           OCIO::BIT_DEPTH_F32, outBitDepths,
+    //                                           OCIO::OPTIMIZATION_DEFAULT,
+    //                                           OCIO::FINALIZATION_DEFAULT);
+    //
+    //     OCIO::ImageDesc * dstImgs[2] = { &sdrImg, &hdrImg };
+    //     group->apply(srcImg, dstImgs);
+
+    //!cpp:class::
+    class OCIOEXPORT CPUProcessorGroup
+    {
+    public:
+        //!cpp:function:: Create the group of the processors, the output bit-depths being the
+        // ones of the destination image buffers (in the processor order). Throws if the list
+        // is empty or holds a null processor.
+        static ConstCPUProcessorGroupRcPtr Create(const ConstProcessorRcPtr * processors,
+                                                  size_t numProcessors,
+                                                  BitDepth inBitDepth,
+                                                  const BitDepth * outBitDepths,
+                                                  OptimizationFlags oFlags,
+                                                  FinalizationFlags fFlags);
+
+        //!cpp:function:: Number of processors i.e. of destination image buffers.
+        size_t getNumProcessors() const;
+        //!cpp:function:: Number of ops (before the optimization) shared by all the
+        // processors, and evaluated once.
+        size_t getNumSharedOps() const;
+
+        //!cpp:function:: Bit-depth of the input pixel buffer.
+        BitDepth getInputBitDepth() const;
+        //!cpp:function:: Bit-depth of the output pixel buffer of the processor at index.
+        BitDepth getOutputBitDepth(size_t index) const;
+
+        //!rst::
+        // Apply to the source image buffer, the destination image buffers (one per processor)
+        // having the dimensions of the source one. The executor is used as for
+        // :cpp:func:`CPUProcessor::apply`.
+        //
+        // .. note::
+        //    The destination image buffers could not be 4:2:0 YUV image buffers.
+
+        //!cpp:function::
+        void apply(const ImageDesc & srcImgDesc, ImageDesc * const * dstImgDescs) const;
+        //!cpp:function::
+        void apply(const ImageDesc & srcImgDesc, ImageDesc * const * dstImgDescs,
+                   const CPUExecutor & executor) const;
+
+    private:
+        CPUProcessorGroup();
+        ~CPUProcessorGroup();
+
+        CPUProcessorGroup(const CPUProcessorGroup &);
+        CPUProcessorGroup& operator= (const CPUProcessorGroup &);
+
+        static void deleter(CPUProcessorGroup * c);
 
         class Impl;
         Impl * m_impl;
@@ -1178,6 +1847,30 @@ OCIO_NAMESPACE_ENTER
         //!cpp:function:: Extract the shader information to implement the color processing.
         void extractGpuShaderInfo(GpuShaderDescRcPtr & shaderDesc) const;
 
+        //!cpp:function:: Get the approximate number of bytes held by the processor i.e. its
+        // ops (the shader programs and textures are owned by the shader descriptions, and
+        // cached by the :cpp:enumerator:`CACHE_GPU_SHADER_PROGRAM` cache).
+        size_t getMemoryFootprint() const;
+
+        //!cpp:function:: Create a GPU processor applying the processors in sequence so a
+        // single shader program (i.e. one function) implements the whole color pipeline,
+        // for example the input, grading & display processing of a viewer rendered in one
+        // pass instead of three.
+        //
+        // The ops are optimized across the processor boundaries (e.g. a conversion to
+        // a working space followed by its inverse cancels out) and the shader resources
+        // are named as for any other processor so they do not collide. Throws if the list
+        // is empty or holds a null processor.
+        //
+        // .. note::
+        //    The dynamic properties are decoupled from the ones of the concatenated
+        //    processors, the ones of the same type being shared.
+        //
+        static ConstGPUProcessorRcPtr Concatenate(const ConstGPUProcessorRcPtr * processors,
+                                                  size_t numProcessors,
+                                                  OptimizationFlags oFlags,
+                                                  FinalizationFlags fFlags);
+
     private:
         GPUProcessor();
         ~GPUProcessor();
@@ -1221,6 +1914,54 @@ OCIO_NAMESPACE_ENTER
         void addFile(const char * fname);
         //!cpp:function::
         void addLook(const char * look);
+
+        //!rst::
+        // The following only describe the optimization of a :cpp:class:`CPUProcessor`
+        // (refer to :cpp:func:`CPUProcessor::getProcessorMetadata`). The ops are
+        // described by a short text, the optimization passes by their name followed by
+        // the resulting number of ops, and the renderers by their class name. Note that
+        // a renderer could process several ops (or convert the input or output
+        // bit-depth) so the renderers do not necessarily match the optimized ops.
+
+        //!cpp:function::
+        int getNumOriginalOps() const;
+        //!cpp:function::
+        const char * getOriginalOp(int index) const;
+
+        //!cpp:function::
+        int getNumOptimizedOps() const;
+        //!cpp:function::
+        const char * getOptimizedOp(int index) const;
+
+        //!cpp:function::
+        int getNumOptimizationPasses() const;
+        //!cpp:function::
+        const char * getOptimizationPass(int index) const;
+
+        //!cpp:function::
+        int getNumRenderers() const;
+        //!cpp:function::
+        const char * getRenderer(int index) const;
+
+        //!cpp:function:: Time spent to optimize the ops, in milliseconds.
+        double getOptimizationTime() const;
+        //!cpp:function:: Time spent to finalize the ops and to create their renderers,
+        //                in milliseconds.
+        double getFinalizationTime() const;
+
+        //!cpp:function::
+        void addOriginalOp(const char * op);
+        //!cpp:function::
+        void addOptimizedOp(const char * op);
+        //!cpp:function::
+        void addOptimizationPass(const char * pass);
+        //!cpp:function::
+        void addRenderer(const char * renderer);
+        //!cpp:function::
+        void setOptimizationTime(double ms);
+        //!cpp:function::
+        void setFinalizationTime(double ms);
+
     private:
         ProcessorMetadata();
         ~ProcessorMetadata();
@@ -1235,6 +1976,49 @@ OCIO_NAMESPACE_ENTER
         Impl * getImpl() { return m_impl; }
         const Impl * getImpl() const { return m_impl; }
     };
+
+
+    //!cpp:class::
+    // This class follows the background construction of processors started by
+    // :cpp:func:`Config::warmupProcessors`.
+
+    class OCIOEXPORT ProcessorWarmup
+    {
+    public:
+        //!cpp:function:: Number of processors to build.
+        int getNumProcessors() const;
+        //!cpp:function:: Number of processors already processed (i.e. built, failed
+        // or skipped by the cancellation).
+        int getNumCompleted() const;
+        //!cpp:function:: Number of processors which failed to build. Note that the
+        // errors are reported again by the corresponding :cpp:func:`Config::getProcessor`.
+        int getNumFailures() const;
+        //!cpp:function:: True once all the processors are processed.
+        bool isDone() const;
+
+        //!cpp:function:: Skip the processors not yet started. Note that it does not wait
+        // for the ones in progress (refer to :cpp:func:`ProcessorWarmup::wait`).
+        void cancel();
+        //!cpp:function:: Wait until all the processors are processed.
+        void wait();
+
+    private:
+        ProcessorWarmup();
+        ~ProcessorWarmup();
+        ProcessorWarmup(const ProcessorWarmup &);
+        ProcessorWarmup& operator= (const ProcessorWarmup &);
+
+        static ProcessorWarmupRcPtr Create();
+
+        static void deleter(ProcessorWarmup* c);
+
+        friend class Config;
+
+        class Impl;
+        Impl * m_impl;
+        Impl * getImpl() { return m_impl; }
+        const Impl * getImpl() const { return m_impl; }
+    };
     
     
     
@@ -1333,6 +2117,40 @@ OCIO_NAMESPACE_ENTER
         void setCubeSize(int cubesize);
         //!cpp:function:: get the cube sample size
         int getCubeSize() const;
+
+        //!cpp:function:: set the maximum interpolation error of the lut i.e.
+        // the largest absolute difference with the exact transform, measured
+        // on a test grid. When positive, the shaper and cube sizes that are
+        // not overridden are the smallest ones within the tolerance, instead
+        // of the format specific defaults.
+        // default: 0 (i.e. disabled)
+        void setTolerance(float tolerance);
+        //!cpp:function:: get the interpolation error tolerance
+        float getTolerance() const;
+
+        //!cpp:function:: when a tolerance is set and the shaper space is not,
+        // select the shaper space among the colorspaces of the config, as the
+        // one allowing the smallest cube within the tolerance. This is only
+        // useful for the formats supporting a shaper.
+        // default: false
+        void setAutoShaperSpace(bool autoShaperSpace);
+        //!cpp:function:: get whether the shaper space is automatically selected
+        bool getAutoShaperSpace() const;
+
+        //!cpp:function:: set the processor to bake, from the input to the target
+        // i.e. the lut approximates it. When set, the config, the input, shaper and
+        // target spaces, and the looks are ignored, and the processor (and its cached
+        // CPU processors) is directly reused. This allows to bake any transform.
+        void setProcessor(const ConstProcessorRcPtr & processor);
+        //!cpp:function:: get the processor to bake, if any
+        ConstProcessorRcPtr getProcessor() const;
+
+        //!cpp:function:: set an *optional* processor from the input to the shaper
+        // space, replacing the shaper space when a processor to bake is set. It must
+        // not have channel crosstalk and must be invertible.
+        void setShaperProcessor(const ConstProcessorRcPtr & shaperProcessor);
+        //!cpp:function:: get the shaper processor, if any
+        ConstProcessorRcPtr getShaperProcessor() const;
         
         //!cpp:function:: bake the lut into the output stream
         void bake(std::ostream & os) const;
@@ -1417,9 +2235,79 @@ OCIO_NAMESPACE_ENTER
         //!cpp:function:: Is the image buffer 32-bit float?
         virtual bool isFloat() const = 0;
 
+        //!rst::
+        // The region of interest restricts the processing to a rectangle of the image
+        // buffer (e.g. a crop window or a dirty tile) without any copy. The region starts
+        // at the pixel (x, y) and must be inside the image buffer. By default, the whole
+        // image buffer is processed.
+        //
+        // .. note::
+        //    When a region of interest is set, the source and destination regions must
+        //    have the same dimensions, and the lines notified by a :cpp:type:`CPUBandCallback`
+        //    are relative to the region.
+
+        //!cpp:function::
+        void setROI(long x, long y, long width, long height);
+        //!cpp:function:: Process the whole image buffer again.
+        void resetROI();
+        //!cpp:function::
+        bool hasROI() const;
+
+        //!cpp:function::
+        long getROIX() const;
+        //!cpp:function::
+        long getROIY() const;
+        //!cpp:function:: Get the width to process i.e. the image width when there is no region.
+        long getROIWidth() const;
+        //!cpp:function:: Get the height to process i.e. the image height when there is no region.
+        long getROIHeight() const;
+
+        //!rst::
+        // The color values of a premultiplied (i.e. associated alpha) image buffer are
+        // multiplied by its alpha. The CPU processor then unpremultiplies the color values
+        // of the source image buffer right after reading them, and premultiplies the color
+        // values of the destination image buffer right before writing them, so the color
+        // processing always sees straight color values. By default, the alpha is straight.
+        //
+        // .. note::
+        //    The color values of the pixels whose alpha is zero (or nearly zero) are not
+        //    unpremultiplied, and are then not premultiplied either when both image
+        //    buffers are premultiplied. An image buffer without alpha is never
+        //    premultiplied.
+
+        //!cpp:function::
+        void setPremultiplied(bool premultiplied);
+        //!cpp:function::
+        bool isPremultiplied() const;
+
+        //!rst::
+        // The dithering of a destination image buffer with an integer bit-depth varies the
+        // rounding of its values with the pixel position, so the smooth gradients become
+        // patterns of the two nearest codes instead of visible bands. It is done by the CPU
+        // processor right before the output conversion i.e. without any extra pass. By
+        // default, the values are not dithered.
+        //
+        // .. note::
+        //    The pattern depends on the position in the image buffer (i.e. including the
+        //    region of interest) so the tiles of an image are seamlessly dithered. The
+        //    alpha channel, and the 16-bit and 32-bit float image buffers, are not dithered.
+
+        //!cpp:function::
+        void setDither(DitherMode mode);
+        //!cpp:function::
+        DitherMode getDither() const;
+
     private:
         ImageDesc(const ImageDesc &);
         ImageDesc & operator= (const ImageDesc &);
+
+        long m_roiX = 0;
+        long m_roiY = 0;
+        long m_roiWidth = 0;
+        long m_roiHeight = 0;
+
+        bool m_premultiplied = false;
+        DitherMode m_dither = DITHER_NONE;
     };
     
     extern OCIOEXPORT std::ostream& operator<< (std::ostream&, const ImageDesc&);
@@ -1441,7 +2329,7 @@ OCIO_NAMESPACE_ENTER
         // the first pixel to process (which does not need to be the first pixel 
         // of the image). The number of channels must be greater than or equal to 3.
         // If a 4th channel is specified, it is assumed to be alpha
-        // information.  Channels > 4 will be ignored.
+        // information.  Channels > 4 are only supported with explicit channel offsets.
         //
         // .. note:: 
         // The methods assume the CPUProcessor bit-depth type for the data pointer.
@@ -1480,6 +2368,25 @@ OCIO_NAMESPACE_ENTER
                         ptrdiff_t xStrideBytes,
                         ptrdiff_t yStrideBytes);
 
+        //!cpp:function:: Describe pixels holding any number of interleaved channels
+        // (e.g. RGBA plus AOV channels) where the color channels are at explicit byte
+        // offsets within the pixel. Only the R, G, B and A channels are processed, the
+        // other channels are left untouched.
+        //
+        // .. note::
+        //    A negative aOffsetBytes means no alpha channel. The xStrideBytes defaults
+        //    (i.e. AutoStride) to numChannels times the size of one channel.
+        PackedImageDesc(void * data,
+                        long width, long height,
+                        long numChannels,
+                        BitDepth bitDepth,
+                        ptrdiff_t rOffsetBytes,
+                        ptrdiff_t gOffsetBytes,
+                        ptrdiff_t bOffsetBytes,
+                        ptrdiff_t aOffsetBytes,
+                        ptrdiff_t xStrideBytes,
+                        ptrdiff_t yStrideBytes);
+
         //!cpp:function::
         virtual ~PackedImageDesc();
 
@@ -1608,6 +2515,325 @@ OCIO_NAMESPACE_ENTER
     };
     
     
+    ///////////////////////////////////////////////////////////////////////////
+    //!rst::
+    // YUVImageDesc
+    // ^^^^^^^^^^^^
+    
+    //!cpp:class::
+    class OCIOEXPORT YUVImageDesc : public ImageDesc
+    {
+    public:
+
+        //!rst::
+        // The constructors expect pointers to the luma and chroma planes starting at the
+        // first pixel to process. The pixels are decoded to RGB when read, and encoded
+        // from RGB when written, in the same pass as the color processing (i.e. the
+        // image is read and written once).
+        //
+        // The chroma samples are upsampled by replication, and downsampled by averaging
+        // the pixels sharing a chroma sample. The alpha is always zero.
+        //
+        // .. note::
+        //    The processing of a YUV image buffer needs a :cpp:class:`CPUProcessor` using
+        //    a 32-bit float bit-depth on the YUV side (i.e. input for a source image, output
+        //    for a destination image), the decoded RGB values being normalized.
+        //
+        // .. note::
+        //    For the semi-planar layouts (i.e. NV12 & P010) uData is the interleaved UV
+        //    plane and vData must be null.
+
+        //!cpp:function::
+        YUVImageDesc(void * yData, void * uData, void * vData,
+                     long width, long height,
+                     YUVLayout layout,
+                     YUVMatrix matrix,
+                     YUVRange range);
+
+        //!cpp:function:: The strides are the bytes between two lines of the luma plane,
+        // and of the chroma plane(s).
+        YUVImageDesc(void * yData, void * uData, void * vData,
+                     long width, long height,
+                     YUVLayout layout,
+                     YUVMatrix matrix,
+                     YUVRange range,
+                     ptrdiff_t yStrideBytes,
+                     ptrdiff_t uvStrideBytes);
+
+        //!cpp:function::
+        virtual ~YUVImageDesc();
+
+        //!cpp:function::
+        YUVLayout getLayout() const;
+        //!cpp:function::
+        YUVMatrix getMatrix() const;
+        //!cpp:function::
+        YUVRange getRange() const;
+
+        //!cpp:function:: Get a pointer to the first luma sample.
+        void * getYData() const;
+        //!cpp:function:: Get a pointer to the first Cb sample.
+        void * getUData() const;
+        //!cpp:function:: Get a pointer to the first Cr sample.
+        void * getVData() const;
+
+        //!cpp:function:: Get the step in bytes between two lines of the chroma plane(s).
+        ptrdiff_t getUVStrideBytes() const;
+
+        //!cpp:function:: The RGB channels are not stored, so always null.
+        void * getRData() const override;
+        //!cpp:function::
+        void * getGData() const override;
+        //!cpp:function::
+        void * getBData() const override;
+        //!cpp:function::
+        void * getAData() const override;
+
+        //!cpp:function:: Get the bit-depth of the samples i.e. UINT8, or UINT16 for P010.
+        BitDepth getBitDepth() const override;
+
+        //!cpp:function::
+        long getWidth() const override;
+        //!cpp:function::
+        long getHeight() const override;
+
+        //!cpp:function:: Get the size in bytes of one luma sample.
+        ptrdiff_t getXStrideBytes() const override;
+        //!cpp:function:: Get the step in bytes between two lines of the luma plane.
+        ptrdiff_t getYStrideBytes() const override;
+
+        //!cpp:function::
+        bool isRGBAPacked() const override;
+        //!cpp:function::
+        bool isFloat() const override;
+
+    private:
+        struct Impl;
+        Impl * m_impl;
+        Impl * getImpl() { return m_impl; }
+        const Impl * getImpl() const { return m_impl; }
+        
+        YUVImageDesc();
+        YUVImageDesc(const YUVImageDesc &);
+        YUVImageDesc& operator= (const YUVImageDesc &);
+    };
+    
+    
+    ///////////////////////////////////////////////////////////////////////////
+    //!rst::
+    // ScanlineImageDesc
+    // ^^^^^^^^^^^^^^^^^
+    
+    //!cpp:class::
+    class OCIOEXPORT ScanlineImageDesc : public ImageDesc
+    {
+    public:
+
+        //!rst::
+        // The constructors expect arrays of 'height' line pointers, for the hosts storing
+        // each line of an image in its own allocation (i.e. there is no constant step in
+        // bytes between two lines). The lines are either packed (i.e. one array pointing to
+        // the first channel of each line) or planar (i.e. one array per channel).
+        //
+        // .. note::
+        //    The arrays of line pointers are not copied so they must outlive the image
+        //    buffer description.
+
+        //!cpp:function:: Packed lines of 32-bit float pixels.
+        ScanlineImageDesc(void * const * rows,
+                          long width, long height,
+                          ChannelOrdering chanOrder);
+
+        //!cpp:function:: Packed lines, the strides being the ones of the
+        // :cpp:class:`PackedImageDesc`.
+        ScanlineImageDesc(void * const * rows,
+                          long width, long height,
+                          ChannelOrdering chanOrder,
+                          BitDepth bitDepth,
+                          ptrdiff_t chanStrideBytes,
+                          ptrdiff_t xStrideBytes);
+
+        //!cpp:function:: Planar lines of 32-bit float pixels, aRows being null without alpha.
+        ScanlineImageDesc(void * const * rRows, void * const * gRows,
+                          void * const * bRows, void * const * aRows,
+                          long width, long height);
+
+        //!cpp:function:: Planar lines, the x stride being the one of the
+        // :cpp:class:`PlanarImageDesc`.
+        ScanlineImageDesc(void * const * rRows, void * const * gRows,
+                          void * const * bRows, void * const * aRows,
+                          long width, long height,
+                          BitDepth bitDepth,
+                          ptrdiff_t xStrideBytes);
+
+        //!cpp:function::
+        virtual ~ScanlineImageDesc();
+
+        //!cpp:function:: Is there one array of line pointers per channel?
+        bool isPlanar() const;
+
+        //!cpp:function:: Get the line pointers of the red channel (i.e. the line pointers
+        // of the packed lines).
+        void * const * getRRows() const;
+        //!cpp:function::
+        void * const * getGRows() const;
+        //!cpp:function::
+        void * const * getBRows() const;
+        //!cpp:function:: Null without alpha.
+        void * const * getARows() const;
+
+        //!cpp:function:: Get a pointer to the red channel of the first pixel of the first line.
+        void * getRData() const override;
+        //!cpp:function::
+        void * getGData() const override;
+        //!cpp:function::
+        void * getBData() const override;
+        //!cpp:function::
+        void * getAData() const override;
+
+        //!cpp:function::
+        BitDepth getBitDepth() const override;
+
+        //!cpp:function::
+        long getWidth() const override;
+        //!cpp:function::
+        long getHeight() const override;
+
+        //!cpp:function::
+        ptrdiff_t getXStrideBytes() const override;
+        //!cpp:function:: The lines are not evenly spaced, so always zero.
+        ptrdiff_t getYStrideBytes() const override;
+
+        //!cpp:function::
+        bool isRGBAPacked() const override;
+        //!cpp:function::
+        bool isFloat() const override;
+
+    private:
+        struct Impl;
+        Impl * m_impl;
+        Impl * getImpl() { return m_impl; }
+        const Impl * getImpl() const { return m_impl; }
+        
+        ScanlineImageDesc();
+        ScanlineImageDesc(const ScanlineImageDesc &);
+        ScanlineImageDesc& operator= (const ScanlineImageDesc &);
+    };
+    
+    
+    ///////////////////////////////////////////////////////////////////////////
+    //!rst::
+    // TiledImageDesc
+    // ^^^^^^^^^^^^^^
+    
+    //!cpp:class::
+    class OCIOEXPORT TiledImageDesc : public ImageDesc
+    {
+    public:
+
+        //!rst::
+        // The constructors describe an image made of tiles of tileWidth x tileHeight packed
+        // pixels, the lines of a tile following each other. The tiles are in row-major
+        // order, either evenly spaced from the first one or found from an array of tile
+        // pointers. The tiles of the last column and of the last row are complete tiles,
+        // even when the image dimensions are not multiples of the tile dimensions.
+        //
+        // .. note::
+        //    The :cpp:class:`CPUProcessor` apply methods process the image tile by tile,
+        //    each thread processing whole tiles. The other image buffer of an out-of-place
+        //    processing is either a tiled image buffer with the same tile dimensions, or
+        //    a packed or planar image buffer.
+
+        //!cpp:function:: Evenly spaced tiles of 32-bit float pixels.
+        TiledImageDesc(void * data,
+                       long width, long height,
+                       long tileWidth, long tileHeight,
+                       ChannelOrdering chanOrder);
+
+        //!cpp:function:: Evenly spaced tiles, the tile stride being the step in bytes
+        // between two tiles.
+        TiledImageDesc(void * data,
+                       long width, long height,
+                       long tileWidth, long tileHeight,
+                       ChannelOrdering chanOrder,
+                       BitDepth bitDepth,
+                       ptrdiff_t chanStrideBytes,
+                       ptrdiff_t xStrideBytes,
+                       ptrdiff_t tileStrideBytes);
+
+        //!cpp:function:: The array holds getNumTilesX() * getNumTilesY() tile pointers. It
+        // is not copied so it must outlive the image buffer description.
+        TiledImageDesc(void * const * tiles,
+                       long width, long height,
+                       long tileWidth, long tileHeight,
+                       ChannelOrdering chanOrder,
+                       BitDepth bitDepth,
+                       ptrdiff_t chanStrideBytes,
+                       ptrdiff_t xStrideBytes);
+
+        //!cpp:function::
+        virtual ~TiledImageDesc();
+
+        //!cpp:function::
+        ChannelOrdering getChannelOrder() const;
+
+        //!cpp:function::
+        long getTileWidth() const;
+        //!cpp:function::
+        long getTileHeight() const;
+        //!cpp:function::
+        long getNumTilesX() const;
+        //!cpp:function::
+        long getNumTilesY() const;
+
+        //!cpp:function:: Get the step in bytes between two tiles, or zero for the tile
+        // pointers.
+        ptrdiff_t getTileStrideBytes() const;
+        //!cpp:function:: Get a pointer to the first pixel of a tile.
+        void * getTileData(long tileX, long tileY) const;
+
+        //!cpp:function::
+        ptrdiff_t getChanStrideBytes() const;
+
+        //!cpp:function:: Get a pointer to the red channel of the first pixel of the first tile.
+        void * getRData() const override;
+        //!cpp:function::
+        void * getGData() const override;
+        //!cpp:function::
+        void * getBData() const override;
+        //!cpp:function::
+        void * getAData() const override;
+
+        //!cpp:function::
+        BitDepth getBitDepth() const override;
+
+        //!cpp:function::
+        long getWidth() const override;
+        //!cpp:function::
+        long getHeight() const override;
+
+        //!cpp:function::
+        ptrdiff_t getXStrideBytes() const override;
+        //!cpp:function:: Get the step in bytes between two lines of a tile.
+        ptrdiff_t getYStrideBytes() const override;
+
+        //!cpp:function::
+        bool isRGBAPacked() const override;
+        //!cpp:function::
+        bool isFloat() const override;
+
+    private:
+        struct Impl;
+        Impl * m_impl;
+        Impl * getImpl() { return m_impl; }
+        const Impl * getImpl() const { return m_impl; }
+        
+        TiledImageDesc();
+        TiledImageDesc(const TiledImageDesc &);
+        TiledImageDesc& operator= (const TiledImageDesc &);
+    };
+    
+    
     ///////////////////////////////////////////////////////////////////////////
     //!rst::
     // GpuShaderDesc
@@ -1813,6 +3039,189 @@ OCIO_NAMESPACE_ENTER
             TEXTURE_RGB_CHANNEL
         };
 
+        //!cpp:type:: Storage format of the texture values handed to the host.
+        enum TextureFormat
+        {
+            TEXTURE_FORMAT_F32 = 0, // 32-bit float values (the default)
+            TEXTURE_FORMAT_F16,     // 16-bit half float values
+            TEXTURE_FORMAT_UNORM16  // 16-bit normalized integer values (65535 is 1.0)
+        };
+
+        //!cpp:function:: Set the storage format of the textures, to be set before
+        // extracting the shader program. The 16-bit formats halve the texture upload
+        // bandwidth and memory at the cost of some precision (refer to
+        // :cpp:func:`GpuShaderDesc::GetTextureFormatMaxError`). The shader program is
+        // unchanged as the sampling of all the formats returns float values.
+        //
+        // .. note::
+        //   The textures with values outside of [0, 1] are stored in F16 instead of UNORM16.
+        //
+        void setTextureFormat(TextureFormat format);
+        //!cpp:function::
+        TextureFormat getTextureFormat() const;
+
+        //!cpp:function:: Get the maximum error of the values stored in a texture format
+        // i.e. a relative error for F16, an absolute error for UNORM16 and 0 for F32.
+        static double GetTextureFormatMaxError(TextureFormat format);
+
+        //!cpp:function:: Pack all the 1D LUTs of the shader program in a single 2D texture
+        // (i.e. an atlas whose width is the texture maximum width), the shader code using
+        // the row offset of each LUT. It reduces the number of samplers and texture binds
+        // of long color transforms. To be set before extracting the shader program.
+        // Disabled by default.
+        void setLut1DAtlasEnabled(bool enabled);
+        //!cpp:function::
+        bool isLut1DAtlasEnabled() const;
+
+        //!cpp:function:: Register each 1D LUT as a single-row texture of the LUT length (i.e.
+        // including the 65536 entries of the half-domain LUTs) instead of folding it in a 2D
+        // texture of the texture maximum width. The shader code then samples it with one 1D
+        // texture fetch, without the 2D coordinate computation and without the interpolation
+        // artifacts at the row seams. To be set before extracting the shader program when the
+        // API supports 1D textures (or texel buffers) of that length. Disabled by default.
+        //
+        // .. note::
+        //   The LUT length must not exceed the texture maximum width (refer to
+        //   :cpp:func:`GpuShaderDesc::setTextureMaxWidth`). These LUTs are not packed in the
+        //   1D LUT atlas. As for the other single-row
+        //   textures, the texture height is 1 and the host binds a 1D texture (e.g.
+        //   GL_TEXTURE_1D, Texture1D or texture1d).
+        //
+        void setLut1DNativeTexturesEnabled(bool enabled);
+        //!cpp:function::
+        bool isLut1DNativeTexturesEnabled() const;
+
+        //!cpp:function:: Render all the 3D LUTs with the hardware trilinear filtering (i.e.
+        // one texture fetch through the texture unit) instead of the tetrahedral
+        // interpolation computed in the shader code (i.e. four fetches and the branches
+        // sorting the fractional parts). It trades some precision for the ALU cost on the
+        // slower GPUs, refer to :cpp:func:`GpuShaderDesc::GetLut3DTrilinearError` to
+        // estimate the difference per LUT. To be set before extracting the shader program.
+        // Disabled by default.
+        //
+        // .. note::
+        //   The fractional parts of the filtering are quantized to 8 bits on some
+        //   hardware, which adds some error with the small grid sizes.
+        //
+        void setLut3DHardwareTrilinearEnabled(bool enabled);
+        //!cpp:function::
+        bool isLut3DHardwareTrilinearEnabled() const;
+
+        //!cpp:function:: Estimate the maximum absolute difference between the trilinear and
+        // the tetrahedral interpolation of a 3D texture (i.e. the values returned by
+        // :cpp:func:`GpuShaderDesc::get3DTextureValues`), sampled at several positions of
+        // each grid cell. A viewer could for example extract the shader program, compare
+        // the errors of its tetrahedral 3D LUTs to its tolerance and then decide to enable
+        // :cpp:func:`GpuShaderDesc::setLut3DHardwareTrilinearEnabled`.
+        static double GetLut3DTrilinearError(unsigned edgelen, const float * values);
+
+        //!cpp:function:: Keep a type of dynamic property live (i.e. a uniform the host can
+        // change) or not. The ops whose dynamic properties are not live use their current
+        // values as constants in the shader program, and are removed when they are then
+        // identities (e.g. the exposure & contrast ops of a viewer when the host never
+        // changes them). To be set before extracting the shader program. All the dynamic
+        // properties are live by default.
+        //
+        // .. note::
+        //   Only the exposure, contrast & gamma properties are uniforms, the dynamic CDL
+        //   always using its current values in the shader program.
+        //
+        void setDynamicPropertyLive(DynamicPropertyType type, bool live);
+        //!cpp:function::
+        bool isDynamicPropertyLive(DynamicPropertyType type) const;
+
+        //!cpp:function:: Add a compute kernel to the shader program, to process an image
+        // buffer of RGBA float pixels (i.e. a row-major array of vec4 values) into another
+        // one without rendering. One thread processes one pixel, the pixels outside of the
+        // image being skipped, and the work groups are 2D (refer to
+        // :cpp:func:`GpuShaderDesc::GetComputeNumWorkGroups`). To be set before extracting
+        // the shader program. Disabled by default.
+        //
+        // .. note::
+        //   The kernel is 'main' for GLSL (i.e. to be compiled with '#version 430' for
+        //   GLSL 4.0 and '#version 310 es' for GLSL ES 3.0), and <function name>Kernel
+        //   for HLSL & Metal. The image buffers are <resource prefix>InPixels &
+        //   <resource prefix>OutPixels and the image size is <resource prefix>ImageWidth
+        //   & <resource prefix>ImageHeight (i.e. unsigned integers), bound as follows:
+        //
+        //   * GLSL: the buffers to the bindings 0 & 1 and the size as uniforms.
+        //   * GLSL for Vulkan: the buffers to the bindings 0 & 1 of the descriptor set 3
+        //     and the size as push constants.
+        //   * HLSL: a StructuredBuffer, a RWStructuredBuffer and a cbuffer named
+        //     <resource prefix>ImageSize.
+        //   * Metal: the buffers 0 & 1 and the size (i.e. a uint2) in the buffer 2. The
+        //     textures & samplers use the indices of the shader function parameters (i.e.
+        //     3D ones first), and the uniforms (then the uniform block) the next buffers.
+        //
+        //   The compute kernel is not available for GLSL 1.x & Cg.
+        //
+        void setComputeKernelEnabled(bool enabled);
+        //!cpp:function::
+        bool isComputeKernelEnabled() const;
+
+        //!cpp:function:: Get the width & height of the work groups of the compute kernel.
+        static unsigned GetComputeWorkGroupSize();
+        //!cpp:function:: Get the number of work groups to dispatch to process an image.
+        static void GetComputeNumWorkGroups(unsigned width, unsigned height,
+                                            unsigned & numGroupsX, unsigned & numGroupsY);
+
+        //!cpp:function:: Set the GPU budget of the shader program i.e. its maximum ALU cost
+        // (i.e. the number of shader statements), number of textures (i.e. samplers) and
+        // texture memory (in bytes of 32-bit float values), zero meaning unlimited. When the
+        // shader program would exceed the budget, the shortest sub-chain of color processing
+        // bringing it within budget is baked into a 3D LUT (refer to
+        // :cpp:func:`GpuShaderDesc::setBudgetLut3DEdgelen`), the rest staying analytic. To
+        // be set before extracting the shader program. Unlimited by default.
+        //
+        // .. note::
+        //   As for the legacy shader description, a baked sub-chain is sampled on the
+        //   [0, 1] domain, so the latest sub-chains (i.e. usually display-referred) are
+        //   preferred. The ops using dynamic properties are never baked. Only applies to
+        //   the generic shader description.
+        //
+        void setGpuBudget(unsigned maxAluCost, unsigned maxNumTextures, unsigned maxTextureMemory);
+        //!cpp:function::
+        unsigned getMaxAluCost() const;
+        //!cpp:function::
+        unsigned getMaxNumTextures() const;
+        //!cpp:function::
+        unsigned getMaxTextureMemory() const;
+        //!cpp:function:: Set the edge length of the 3D LUTs baked to respect the GPU budget.
+        // The default is 32.
+        void setBudgetLut3DEdgelen(unsigned edgelen);
+        //!cpp:function::
+        unsigned getBudgetLut3DEdgelen() const;
+
+        //!cpp:function:: Render the inverse 1D LUTs with a binary search in their forward
+        // values (i.e. an exact inversion, as for the CPU), instead of baking a forward LUT
+        // approximating the inverse. It saves the CPU time & texture memory of the baked
+        // LUTs at the cost of a few texture lookups per channel. To be set before extracting
+        // the shader program. Disabled by default.
+        //
+        // .. note::
+        //   The choice is made per LUT i.e. only the LUTs fitting in a single texture row
+        //   (refer to :cpp:func:`GpuShaderDesc::setTextureMaxWidth`), without half domain
+        //   or hue adjustment, use the search.
+        //
+        void setLut1DInverseSearchEnabled(bool enabled);
+        //!cpp:function::
+        bool isLut1DInverseSearchEnabled() const;
+
+        //!cpp:function:: Let the ops tolerating it compute in half precision (i.e. mediump
+        // for GLSL, min16float for HLSL and half for Metal), to increase the ALU throughput
+        // of the mobile & Apple GPUs. It applies to the range, to the matrix (i.e. when the
+        // values are display-referred) and to the 3D LUT interpolation, the other ops (e.g.
+        // log & scene-linear ones) staying at full precision. To be set before extracting
+        // the shader program. Disabled by default.
+        //
+        // .. note::
+        //   The values are display-referred after a 1D LUT, a 3D LUT or a clamping range.
+        //   Only applies to the generic shader description.
+        //
+        void setHalfPrecisionEnabled(bool enabled);
+        //!cpp:function::
+        bool isHalfPrecisionEnabled() const;
+
         //!cpp:function:: Dynamic Property related methods.
         virtual unsigned getNumUniforms() const = 0;
         virtual void getUniform(unsigned index, const char *& name, 
@@ -1820,6 +3229,47 @@ OCIO_NAMESPACE_ENTER
         virtual bool addUniform(const char * name, 
                                 const DynamicPropertyRcPtr & value) = 0;
 
+        //!cpp:function:: Move the dynamic properties and the op parameters (i.e. the
+        // matrix, CDL and exposure & contrast values) of the shader program into a single
+        // uniform block named <resource prefix>UniformBlock, instead of standalone uniforms
+        // and literal values. The shader program is then shared by the color transforms
+        // only differing by these values, and a grade is updated by writing the block
+        // buffer (refer to :cpp:func:`GpuShaderDesc::fillUniformBlock`). To be set before
+        // extracting the shader program. Disabled by default.
+        //
+        // .. note::
+        //   The block uses the std140 layout (i.e. a cbuffer for HLSL and a struct for
+        //   Metal, with the same member offsets). Its members are float, vec4 or mat4
+        //   (i.e. column-major) values. For Vulkan, the block is bound to the descriptor
+        //   set 2 with the number of standalone uniforms as binding. For Metal, the block
+        //   is the last parameter of the shader function. The uniform block is not
+        //   available for GLSL 1.x & Cg and is ignored by the legacy shader description.
+        //
+        void setUniformBlockEnabled(bool enabled);
+        //!cpp:function::
+        bool isUniformBlockEnabled() const;
+
+        //!cpp:type:: Type of a uniform block member.
+        enum UniformType
+        {
+            UNIFORM_FLOAT = 0,  // One float (i.e. 4 bytes aligned on 4 bytes)
+            UNIFORM_VEC4,       // Four floats (i.e. 16 bytes aligned on 16 bytes)
+            UNIFORM_MAT4        // Four vec4 columns (i.e. 64 bytes aligned on 16 bytes)
+        };
+
+        //!cpp:function:: Uniform block related methods. The member value is the dynamic
+        // property of the member, or null for the op parameters.
+        virtual unsigned getNumUniformBlockMembers() const;
+        virtual void getUniformBlockMember(unsigned index, const char *& name,
+                                           UniformType & type, unsigned & offset,
+                                           DynamicPropertyRcPtr & value) const;
+        //!cpp:function:: Get the size in bytes of the uniform block (i.e. a multiple of 16).
+        virtual unsigned getUniformBlockSize() const;
+        //!cpp:function:: Write the current values of the uniform block members (i.e.
+        // including the current values of the dynamic properties) in a buffer of
+        // :cpp:func:`GpuShaderDesc::getUniformBlockSize` bytes.
+        virtual void fillUniformBlock(void * buffer) const;
+
         //!cpp:function:: 1D lut related methods
         virtual unsigned getTextureMaxWidth() const = 0;
         virtual void setTextureMaxWidth(unsigned maxWidth) = 0;
@@ -1832,6 +3282,10 @@ OCIO_NAMESPACE_ENTER
                                 unsigned & width, unsigned & height,
                                 TextureType & channel, Interpolation & interpolation) const = 0;
         virtual void getTextureValues(unsigned index, const float *& values) const = 0;
+        //!cpp:function:: Get the 16-bit values of a texture and their format (i.e. F16 or
+        // UNORM16) when the texture format is not F32.
+        virtual void getTextureValues16(unsigned index, TextureFormat & format,
+                                        const unsigned short *& values) const;
 
         //!cpp:function:: 3D lut related methods
         virtual unsigned getNum3DTextures() const = 0;
@@ -1840,6 +3294,10 @@ OCIO_NAMESPACE_ENTER
         virtual void get3DTexture(unsigned index, const char *& name, const char *& id, 
                                   unsigned & edgelen, Interpolation & interpolation) const = 0;
         virtual void get3DTextureValues(unsigned index, const float *& values) const = 0;
+        //!cpp:function:: Get the 16-bit values of a 3D texture and their format (i.e. F16
+        // or UNORM16) when the texture format is not F32.
+        virtual void get3DTextureValues16(unsigned index, TextureFormat & format,
+                                          const unsigned short *& values) const;
 
         //!cpp:function:: Methods to specialize parts of a OCIO shader program
         //
@@ -1908,6 +3366,27 @@ OCIO_NAMESPACE_ENTER
         //!cpp:function::
         virtual void finalize() = 0;
 
+        //!cpp:function:: Write the finalized shader program (i.e. its code, settings,
+        // uniforms & textures) in a binary stream to be read back by
+        // :cpp:func:`GpuShaderDesc::Deserialize`, for example to persist a shader cache
+        // allowing the next launch of an application to skip the processor creation.
+        // The key identifies the shader program, for example the cache identifier of
+        // the processor, or of the config & color spaces it was created from.
+        //
+        // .. note::
+        //   With a 16-bit texture format (refer to
+        //   :cpp:func:`GpuShaderDesc::setTextureFormat`), only the 16-bit texture values
+        //   are written i.e. the 32-bit values of the read texture are their conversion.
+        //   Throws for a shader description not created by the library.
+        //
+        void serialize(std::ostream & os, const char * key) const;
+        //!cpp:function:: Read a shader description written by
+        // :cpp:func:`GpuShaderDesc::serialize`. Returns null when the key differs (i.e.
+        // a stale cache) or when the stream was written by another version of the library
+        // or on a platform of different byte order. Throws when the stream is corrupted.
+        // The uniforms hold the dynamic property values at serialization time.
+        static GpuShaderDescRcPtr Deserialize(std::istream & is, const char * key);
+
     protected:
         //!cpp:function::
         GpuShaderDesc();
@@ -1999,6 +3478,11 @@ OCIO_NAMESPACE_ENTER
         // Also, walk the full search path until the file is found.
         // If the filename cannot be found, an exception will be thrown.
         const char * resolveFileLocation(const char * filename) const;
+
+        //!cpp:function:: Same as :cpp:func:`Context::resolveFileLocation` but return a
+        // null pointer, instead of throwing, when the file cannot be found (e.g. to cheaply
+        // probe many candidate files).
+        const char * tryResolveFileLocation(const char * filename) const;
     
     private:
         Context();
@@ -2009,6 +3493,10 @@ OCIO_NAMESPACE_ENTER
         
         static void deleter(Context* c);
         
+        // Used by the config snapshots to make the current results lock-free.
+        friend class Config;
+        void freeze();
+        
         class Impl;
         friend class Impl;
         Impl * m_impl;
@@ -252,6 +252,19 @@ OCIO_NAMESPACE_ENTER
         // are often useful for pipeline purposes and are
         // included in the serialization.
         
+        //!rst:: **Dynamic**
+        //
+        // When dynamic, the slope, offset, power and saturation values could be changed
+        // on the processors (refer to :cpp:func:`Processor::getDynamicProperty` with
+        // DYNAMIC_PROPERTY_CDL) without creating new ones, for instance to switch
+        // between the corrections of a ColorCorrectionCollection per shot. Note that
+        // it only applies to configs with version >= 2.
+
+        //!cpp:function::
+        bool isDynamic() const;
+        //!cpp:function::
+        void makeDynamic();
+
         //!cpp:function:: Unique Identifier for this correction.
         const char * getID() const;
         //!cpp:function::
@@ -453,6 +466,15 @@ OCIO_NAMESPACE_ENTER
         //!cpp:function::
         virtual void setValue(double value) = 0;
 
+        //!cpp:function:: Only for a CDL property i.e. slope, offset & power hold the three
+        // RGB values.
+        virtual void getCDLValues(double * slope, double * offset, double * power,
+                                  double & saturation) const = 0;
+        //!cpp:function:: The four values are changed at once i.e. a concurrent processing
+        // never sees a partial change. Will throw if the values are not valid.
+        virtual void setCDLValues(const double * slope, const double * offset,
+                                  const double * power, double saturation) = 0;
+
         //!cpp:function::
         virtual bool isDynamic() const = 0;
 
@@ -465,6 +487,35 @@ OCIO_NAMESPACE_ENTER
         DynamicProperty & operator=(const DynamicProperty &);
     };
 
+    //!cpp:class:: Values of dynamic properties only used by one CPU processing call (refer
+    // to :cpp:func:`CPUProcessor::apply`), the dynamic properties of the processor being
+    // unchanged. One finalized processor could then process concurrently several images
+    // with different values (e.g. thumbnails with different exposures).
+    class OCIOEXPORT DynamicPropertyOverrides
+    {
+    public:
+        //!cpp:function::
+        DynamicPropertyOverrides() = default;
+
+        //!cpp:function:: Override the value of a double precision dynamic property.
+        void setValue(DynamicPropertyType type, double value);
+        //!cpp:function::
+        bool hasValue(DynamicPropertyType type) const noexcept;
+        //!cpp:function:: Throws if the value of the dynamic property is not overridden.
+        double getDoubleValue(DynamicPropertyType type) const;
+
+        //!cpp:function:: Remove all the overrides.
+        void clear() noexcept;
+        //!cpp:function::
+        bool isEmpty() const noexcept;
+
+    private:
+        static constexpr unsigned NUM_TYPES = 3;
+
+        double   m_values[NUM_TYPES] = { 0., 0., 0. };
+        unsigned m_overridden = 0; // One bit per dynamic property type.
+    };
+
     //!rst:: //////////////////////////////////////////////////////////////////
 
     //!cpp:class:: Represents exponent transform: pow( clamp(color), value)
@@ -861,6 +912,9 @@ OCIO_NAMESPACE_ENTER
         
         static void deleter(GroupTransform * t);
         
+        // Builds (and caches) the op chains of the group.
+        friend class GroupOpsBuilder;
+
         class Impl;
         Impl * m_impl;
         Impl * getImpl() { return m_impl; }
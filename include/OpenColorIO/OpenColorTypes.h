@@ -71,6 +71,12 @@ OCIO_NAMESPACE_ENTER
     //!cpp:type::
     typedef OCIO_SHARED_PTR<CPUProcessor> CPUProcessorRcPtr;
     
+    class OCIOEXPORT CPUProcessorGroup;
+    //!cpp:type::
+    typedef OCIO_SHARED_PTR<const CPUProcessorGroup> ConstCPUProcessorGroupRcPtr;
+    //!cpp:type::
+    typedef OCIO_SHARED_PTR<CPUProcessorGroup> CPUProcessorGroupRcPtr;
+    
     class OCIOEXPORT GPUProcessor;
     //!cpp:type::
     typedef OCIO_SHARED_PTR<const GPUProcessor> ConstGPUProcessorRcPtr;
@@ -82,6 +88,10 @@ OCIO_NAMESPACE_ENTER
     typedef OCIO_SHARED_PTR<const ProcessorMetadata> ConstProcessorMetadataRcPtr;
     //!cpp:type::
     typedef OCIO_SHARED_PTR<ProcessorMetadata> ProcessorMetadataRcPtr;
+
+    class OCIOEXPORT ProcessorWarmup;
+    //!cpp:type::
+    typedef OCIO_SHARED_PTR<ProcessorWarmup> ProcessorWarmupRcPtr;
     
     class OCIOEXPORT Baker;
     //!cpp:type::
@@ -139,6 +149,8 @@ OCIO_NAMESPACE_ENTER
     typedef OCIO_SHARED_PTR<DisplayTransform> DisplayTransformRcPtr;
     
     class OCIOEXPORT DynamicProperty;
+    class OCIOEXPORT DynamicPropertyOverrides;
+    class OCIOEXPORT CPUCancellationToken;
     //!cpp:type::
     typedef OCIO_SHARED_PTR<const DynamicProperty> ConstDynamicPropertyRcPtr;
     //!cpp:type::
@@ -230,6 +242,24 @@ OCIO_NAMESPACE_ENTER
 
     using LoggingFunction = std::function<void(const char*)>;
 
+    //!cpp:type:: Function receiving the begin (i.e. when `begin` is true) and end events
+    // of the tracing spans (refer to :cpp:func:`SetTracingFunction`). The category (e.g.
+    // "config", "file", "processor" or "op") and the name (e.g. a file path or an op type)
+    // are only valid during the call.
+    using TracingFunction
+        = std::function<void(bool begin, const char * category, const char * name)>;
+
+    //!cpp:type:: Executor used to parallelize the CPU processing. It must call the task
+    // for every index in [0, numTasks[ (in any order and from any thread), propagate
+    // any exception thrown by the task, and only return once all the calls completed.
+    using CPUExecutor
+        = std::function<void(long numTasks, const std::function<void(long taskIndex)> & task)>;
+
+    //!cpp:type:: Callback notified when the lines [yBegin, yEnd[ of the destination image
+    // (or of its region of interest) are processed. It could be called concurrently from
+    // different threads.
+    using CPUBandCallback = std::function<void(long yBegin, long yEnd)>;
+
     //!rst::
     // Enums
     // *****
@@ -331,6 +361,49 @@ OCIO_NAMESPACE_ENTER
         CHANNEL_ORDERING_BGR
     };
 
+    //!cpp:type:: Used by :cpp:class`YUVImageDesc` to indicate the layout of the planes.
+    enum YUVLayout
+    {
+        YUV_LAYOUT_I420 = 0, // 8-bit Y, U and V planes with a 4:2:0 chroma subsampling.
+        YUV_LAYOUT_I422,     // 8-bit Y, U and V planes with a 4:2:2 chroma subsampling.
+        YUV_LAYOUT_NV12,     // 8-bit Y plane and interleaved UV plane (4:2:0).
+        YUV_LAYOUT_P010      // 16-bit Y plane and interleaved UV plane (4:2:0), the 10-bit
+                             // codes being in the high bits of the 16-bit words.
+    };
+
+    //!cpp:type:: Used by :cpp:class`YUVImageDesc` to indicate the YCbCr encoding matrix.
+    enum YUVMatrix
+    {
+        YUV_MATRIX_BT601 = 0,
+        YUV_MATRIX_BT709,
+        YUV_MATRIX_BT2020
+    };
+
+    //!cpp:type:: Used by :cpp:class`YUVImageDesc` to indicate the range of the code values.
+    enum YUVRange
+    {
+        YUV_RANGE_LIMITED = 0, // i.e. 16-235 for the luma and 16-240 for the chroma in 8-bit.
+        YUV_RANGE_FULL
+    };
+
+    //!cpp:type:: Used by :cpp:class`ImageDesc` to indicate the dithering of the integer
+    // output values.
+    enum DitherMode
+    {
+        DITHER_NONE = 0,  // The values are rounded to the nearest code.
+        DITHER_ORDERED    // The rounding threshold follows a tiled 8x8 Bayer matrix.
+    };
+
+    //!cpp:type:: Scheduling priority of the CPU processing in the internal thread pool
+    // (refer to :cpp:class:`CPUCancellationToken`). The pending tasks (e.g. the bands of
+    // lines) of the higher priorities are processed first.
+    enum CPUPriority
+    {
+        CPU_PRIORITY_LOW = 0,
+        CPU_PRIORITY_NORMAL,
+        CPU_PRIORITY_HIGH
+    };
+
     //!cpp:type::
     enum Allocation {
         ALLOCATION_UNKNOWN = 0,
@@ -339,6 +412,18 @@ OCIO_NAMESPACE_ENTER
     };
     
     //!cpp:type:: Used when there is a choice of hardware shader language.
+    //
+    // .. note::
+    //   The resource binding conventions of the shader programs are:
+    //
+    //   * GLSL ES 3.0 & Metal: the 1D LUTs use 2D textures with a height of one
+    //     (i.e. 1D textures are not available).
+    //   * GLSL for Vulkan: the resources are bound to the descriptor set 0 (1D & 2D
+    //     textures), 1 (3D textures) or 2 (uniforms, each one in its own uniform block)
+    //     with the index of the resource in the shader description as binding.
+    //   * Metal: the textures & samplers (i.e. the 3D ones first), and then the uniforms,
+    //     are parameters of the shader function instead of global declarations.
+    //
     enum GpuLanguage
     {
         GPU_LANGUAGE_UNKNOWN = 0,
@@ -346,7 +431,10 @@ OCIO_NAMESPACE_ENTER
         GPU_LANGUAGE_GLSL_1_0,          ///< OpenGL Shading Language
         GPU_LANGUAGE_GLSL_1_3,          ///< OpenGL Shading Language
         GPU_LANGUAGE_GLSL_4_0,          ///< OpenGL Shading Language
-        GPU_LANGUAGE_HLSL_DX11          ///< DirectX Shading Language
+        GPU_LANGUAGE_HLSL_DX11,         ///< DirectX Shading Language
+        GPU_LANGUAGE_GLSL_ES_3_0,       ///< OpenGL ES Shading Language
+        GPU_LANGUAGE_GLSL_VK_4_6,       ///< OpenGL Shading Language for Vulkan (SPIR-V)
+        GPU_LANGUAGE_MSL_2_0            ///< Metal Shading Language
     };
     
     //!cpp:type::
@@ -387,13 +475,15 @@ OCIO_NAMESPACE_ENTER
     {
         DYNAMIC_PROPERTY_EXPOSURE = 0, //! Image exposure value (double floating point value)
         DYNAMIC_PROPERTY_CONTRAST,     //! Image contrast value (double floating point value)
-        DYNAMIC_PROPERTY_GAMMA         //! Image gamma value (double floating point value)
+        DYNAMIC_PROPERTY_GAMMA,        //! Image gamma value (double floating point value)
+        DYNAMIC_PROPERTY_CDL           //! CDL slope, offset, power & saturation values
     };
 
     enum DynamicPropertyValueType
     {
         DYNAMIC_PROPERTY_DOUBLE, //! Value is a double
-        DYNAMIC_PROPERTY_BOOL    //! Value is a bool
+        DYNAMIC_PROPERTY_BOOL,   //! Value is a bool
+        DYNAMIC_PROPERTY_CDL_VALUES //! Values are the CDL slope, offset, power (RGB) & saturation
     };
 
     //!cpp:type:: Provides control over how the ops in a Processor are combined 
@@ -431,6 +521,31 @@ OCIO_NAMESPACE_ENTER
         // For integer input bit-depth only, replace separable ops 
         // (i.e. no channel crosstalk ops) by a single 1D LUT of input bit-depth domain.
         OPTIMIZATION_COMP_SEPARABLE_PREFIX = 0x0400,
+        // For integer (up to 16 bits) or half input bit-depths only, when there is no
+        // channel crosstalk, the CPU processor evaluates the whole processing into
+        // per-channel lookup tables of the input bit-depth domain (i.e. processing a pixel
+        // is then only a table lookup, the half values being indexed by their bits).
+        OPTIMIZATION_LOOKUP_INTEGER_INPUT  = 0x0800,
+        // Replace the whole processing (when it has channel crosstalk) by a shaper 1D LUT
+        // followed by a 3D LUT whose size is set by SetBakedLut3DSize(). The shaper
+        // depends on the input bit-depth and on the color space allocation, if any.
+        // Note that it could be quite lossy, and that the alpha channel is untouched.
+        OPTIMIZATION_BAKE_LUT3D            = 0x1000,
+        // The CPU processor evaluates only once each run of identical pixels (e.g. mattes,
+        // flat backgrounds or graphics) and copies the result to the rest of the run. It
+        // is not part of any grade as it costs a comparison per pixel when the image has
+        // no runs. Note that it is ignored when the integer lookup is used.
+        OPTIMIZATION_REPEATED_PIXELS       = 0x2000,
+        // Replace a 3D LUT by its smallest sub-grid (i.e. every 2^n-th grid point) whose
+        // interpolation reproduces the LUT values well below a 16-bit code value (or a bit
+        // above when 3D LUT compositions are allowed). It mostly shrinks the near-identity
+        // grading LUTs which only need the resolution of their changes.
+        OPTIMIZATION_COMPACT_LUT3D         = 0x4000,
+        // Replace a string of separable ops (e.g. a stack of 1D LUTs, logs and gammas)
+        // starting with a 1D LUT or a clamp to [0, 1] by a piecewise linear curve (i.e. a
+        // small 1D LUT) fitted within the maximum error set by SetApproximationMaxError().
+        // The optimization report includes the measured error.
+        OPTIMIZATION_APPROX_SEPARABLE      = 0x8000,
 
         // Can apply all the optimization types.
         OPTIMIZATION_ALL                   = 0xFFFF,
@@ -444,13 +559,16 @@ OCIO_NAMESPACE_ENTER
                                     | OPTIMIZATION_PAIR_IDENTITY_GAMMA
                                     | OPTIMIZATION_PAIR_IDENTITY_LOG
                                     | OPTIMIZATION_COMP_MATRIX
-                                    | OPTIMIZATION_COMP_GAMMA),
+                                    | OPTIMIZATION_COMP_GAMMA
+                                    | OPTIMIZATION_LOOKUP_INTEGER_INPUT),
 
         OPTIMIZATION_VERY_GOOD  = (OPTIMIZATION_LOSSLESS
                                     | OPTIMIZATION_COMP_LUT1D
                                     | OPTIMIZATION_COMP_SEPARABLE_PREFIX),
 
-        OPTIMIZATION_GOOD       = OPTIMIZATION_VERY_GOOD | OPTIMIZATION_COMP_LUT3D,
+        OPTIMIZATION_GOOD       = (OPTIMIZATION_VERY_GOOD
+                                    | OPTIMIZATION_COMP_LUT3D
+                                    | OPTIMIZATION_COMPACT_LUT3D),
 
         // For quite lossy optimizations.
         OPTIMIZATION_DRAFT      = OPTIMIZATION_ALL,
@@ -467,6 +585,51 @@ OCIO_NAMESPACE_ENTER
 
         FINALIZATION_DEFAULT = FINALIZATION_FAST
     };
+
+    //!cpp:type:: Interpolation of the forward LUTs applied by a processor, trading the
+    // accuracy for speed (e.g. when scrubbing previews) without editing the config (refer
+    // to :cpp:func:`Processor::getOptimizedCPUProcessor`).
+    enum LutInterpolationQuality
+    {
+        LUT_INTERPOLATION_FULL = 0, //! Interpolation of each LUT (i.e. from the config or the file)
+        LUT_INTERPOLATION_PREVIEW,  //! Trilinear interpolation of the 3D LUTs
+        LUT_INTERPOLATION_DRAFT     //! Nearest entry of the 3D LUTs and of the large 1D LUTs
+    };
+
+    //!cpp:type:: Enumeration of the global caches (refer to :cpp:func:`GetCacheMemoryUsage`
+    // and :cpp:func:`GetCacheStatistic`).
+    enum CacheType
+    {
+        CACHE_FILE = 0,             //! Files loaded by the FileTransform (e.g. the LUT files)
+        CACHE_PATH,                 //! Hashes of the files (i.e. the modification times)
+        CACHE_CDL_FILE,             //! Transforms of the CDL files (i.e. .cc & .ccc files)
+        CACHE_LUT3D_FAST_INVERSE,   //! Fast approximations of the inverse 3D LUTs
+        CACHE_COLORSPACE_OPS,       //! Op chains of the color space conversions
+        CACHE_GPU_SHADER_FRAGMENT,  //! Shader code generated by the ops
+        CACHE_GPU_SHADER_PROGRAM,   //! Shader programs (with their textures) of the processors
+        CACHE_LOOK_OPS,             //! Op chains applying the looks
+        CACHE_LUT1D_COMPOSE,        //! Compositions of the 1D LUTs with the following ops
+        CACHE_RENDERER_TABLES,      //! Tables of the released CPU renderers kept for reuse
+        CACHE_CONTEXT_RESULTS,      //! Resolved strings & file paths of the contexts (only
+                                    //! the statistics are global, the results being held by
+                                    //! each context)
+        CACHE_LOOK_PARSE            //! Parsed look strings (e.g. "+grade, -filmlook")
+    };
+
+    //!cpp:type:: Enumeration of the cumulative cache statistics (refer to
+    // :cpp:func:`GetCacheStatistic`).
+    enum CacheStatistic
+    {
+        CACHE_STATISTIC_LOOKUPS = 0,    //! Number of lookups (i.e. hits and misses)
+        CACHE_STATISTIC_HITS,           //! Lookups finding a valid entry
+        CACHE_STATISTIC_MISSES,         //! Lookups computing the entry
+        CACHE_STATISTIC_INSERTIONS,     //! Entries added to the cache
+        CACHE_STATISTIC_EVICTIONS,      //! Entries removed to fit the cache budget or
+                                        //! replaced because outdated (i.e. not counting
+                                        //! the entries removed by ClearAllCaches)
+        CACHE_STATISTIC_LOCK_WAIT_NS    //! Nanoseconds spent waiting for the cache locks
+                                        //! held by other threads
+    };
    
 
     //!rst::
@@ -0,0 +1,121 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the OpenColorIO Project.
+
+
+#ifndef INCLUDED_OCIO_AVX_H
+#define INCLUDED_OCIO_AVX_H
+
+
+#include "CPUInfo.h"
+
+
+#if defined(OCIO_USE_AVX)
+
+
+#include <immintrin.h>
+#include <limits>
+
+#include "SSE.h"
+
+
+OCIO_NAMESPACE_ENTER
+{
+
+// AVX2 versions of the SSE.h functions doing exactly the same operations on each 32-bit
+// element so all the CPUs produce identical results (i.e. FMA is not used). Note that the
+// constants are not global variables because their initialization would then need AVX.
+
+OCIO_TARGET_AVX2
+inline __m256 avxSelect(const __m256 & mask, const __m256 & arg_true, const __m256 & arg_false)
+{
+    return _mm256_blendv_ps(arg_false, arg_true, mask);
+}
+
+// Refer to sseLog2().
+OCIO_TARGET_AVX2
+inline __m256 avxLog2(__m256 x)
+{
+    const __m256i emask = _mm256_set1_epi32(EXP_MASK);
+
+    const __m256 mantissa
+        = _mm256_or_ps(_mm256_andnot_ps(_mm256_castsi256_ps(emask), x), _mm256_set1_ps(1.0f));
+
+    __m256 log2 = _mm256_set1_ps((float)+4.487361286440374006195e-2);
+    log2 = _mm256_add_ps(_mm256_mul_ps(log2, mantissa),
+                         _mm256_set1_ps((float)-4.165637071209677112635e-1));
+    log2 = _mm256_add_ps(_mm256_mul_ps(log2, mantissa),
+                         _mm256_set1_ps((float)+1.631148826119436277100));
+    log2 = _mm256_add_ps(_mm256_mul_ps(log2, mantissa),
+                         _mm256_set1_ps((float)-3.550793018041176193407));
+    log2 = _mm256_add_ps(_mm256_mul_ps(log2, mantissa),
+                         _mm256_set1_ps((float)+5.091710879305474367557));
+    log2 = _mm256_add_ps(_mm256_mul_ps(log2, mantissa),
+                         _mm256_set1_ps((float)-2.800364054395965731506));
+
+    const __m256i exponent
+        = _mm256_sub_epi32(
+            _mm256_srli_epi32(_mm256_and_si256(_mm256_castps_si256(x), emask), EXP_SHIFT),
+            _mm256_set1_epi32(EXP_BIAS));
+
+    return _mm256_add_ps(log2, _mm256_cvtepi32_ps(exponent));
+}
+
+// Refer to sseExp2().
+OCIO_TARGET_AVX2
+inline __m256 avxExp2(__m256 x)
+{
+    const __m256i floor_x
+        = _mm256_add_epi32(
+            _mm256_cvttps_epi32(x),
+            _mm256_castps_si256(_mm256_cmp_ps(_mm256_setzero_ps(), x, _CMP_NLE_US)));
+
+    const __m256 zf
+        = _mm256_castsi256_ps(
+            _mm256_slli_epi32(_mm256_add_epi32(floor_x, _mm256_set1_epi32(EXP_BIAS)),
+                              EXP_SHIFT));
+
+    const __m256 iexp = _mm256_cvtepi32_ps(floor_x);
+    const __m256 fraction = _mm256_sub_ps(x, iexp);
+
+    __m256 mexp = _mm256_set1_ps((float)1.353416792833547468620e-2);
+    mexp = _mm256_add_ps(_mm256_mul_ps(mexp, fraction),
+                         _mm256_set1_ps((float)5.201146058412685018921e-2));
+    mexp = _mm256_add_ps(_mm256_mul_ps(mexp, fraction),
+                         _mm256_set1_ps((float)2.414427569091865207710e-1));
+    mexp = _mm256_add_ps(_mm256_mul_ps(mexp, fraction),
+                         _mm256_set1_ps((float)6.930038344665415134202e-1));
+    mexp = _mm256_add_ps(_mm256_mul_ps(mexp, fraction),
+                         _mm256_set1_ps((float)1.000002593370603213644));
+
+    __m256 exp2 = _mm256_mul_ps(zf, mexp);
+
+    // Handle the underflow and the overflow.
+    exp2 = _mm256_andnot_ps(_mm256_cmp_ps(iexp, _mm256_set1_ps(-126.0f), _CMP_LT_OS), exp2);
+    exp2 = avxSelect(_mm256_cmp_ps(iexp, _mm256_set1_ps(127.0f), _CMP_GT_OS),
+                     _mm256_set1_ps(std::numeric_limits<float>::infinity()), exp2);
+
+    return exp2;
+}
+
+// Refer to ssePower().
+OCIO_TARGET_AVX2
+inline __m256 avxPower(__m256 x, __m256 exp)
+{
+    __m256 values = avxLog2(x);
+
+    values = _mm256_mul_ps(exp, values);
+
+    values = avxExp2(values);
+
+    // Handle values where base is smaller or equal than zero
+    values = _mm256_and_ps(values, _mm256_cmp_ps(x, _mm256_setzero_ps(), _CMP_GT_OS));
+
+    return values;
+}
+
+}
+OCIO_NAMESPACE_EXIT
+
+#endif // OCIO_USE_AVX
+
+#endif // INCLUDED_OCIO_AVX_H
@@ -6,6 +6,7 @@
 
 #include <OpenColorIO/OpenColorIO.h>
 
+#include "BakingUtils.h"
 #include "transforms/FileTransform.h"
 #include "MathUtils.h"
 #include "pystring/pystring.h"
@@ -37,10 +38,16 @@ OCIO_NAMESPACE_ENTER
         std::string targetSpace_;
         int shapersize_;
         int cubesize_;
+        float tolerance_;
+        bool autoShaperSpace_;
+        ConstProcessorRcPtr processor_;
+        ConstProcessorRcPtr shaperProcessor_;
         
         Impl() :
             shapersize_(-1),
-            cubesize_(-1)
+            cubesize_(-1),
+            tolerance_(0.0f),
+            autoShaperSpace_(false)
         {
         }
 
@@ -64,6 +71,10 @@ OCIO_NAMESPACE_ENTER
                 targetSpace_ = rhs.targetSpace_;
                 shapersize_ = rhs.shapersize_;
                 cubesize_ = rhs.cubesize_;
+                tolerance_ = rhs.tolerance_;
+                autoShaperSpace_ = rhs.autoShaperSpace_;
+                processor_ = rhs.processor_;
+                shaperProcessor_ = rhs.shaperProcessor_;
             }
             return *this;
         }
@@ -216,6 +227,46 @@ OCIO_NAMESPACE_ENTER
     {
         return getImpl()->cubesize_;
     }
+
+    void Baker::setTolerance(float tolerance)
+    {
+        getImpl()->tolerance_ = tolerance;
+    }
+
+    float Baker::getTolerance() const
+    {
+        return getImpl()->tolerance_;
+    }
+
+    void Baker::setAutoShaperSpace(bool autoShaperSpace)
+    {
+        getImpl()->autoShaperSpace_ = autoShaperSpace;
+    }
+
+    bool Baker::getAutoShaperSpace() const
+    {
+        return getImpl()->autoShaperSpace_;
+    }
+
+    void Baker::setProcessor(const ConstProcessorRcPtr & processor)
+    {
+        getImpl()->processor_ = processor;
+    }
+
+    ConstProcessorRcPtr Baker::getProcessor() const
+    {
+        return getImpl()->processor_;
+    }
+
+    void Baker::setShaperProcessor(const ConstProcessorRcPtr & shaperProcessor)
+    {
+        getImpl()->shaperProcessor_ = shaperProcessor;
+    }
+
+    ConstProcessorRcPtr Baker::getShaperProcessor() const
+    {
+        return getImpl()->shaperProcessor_;
+    }
     
     void Baker::bake(std::ostream & os) const
     {
@@ -229,14 +280,25 @@ OCIO_NAMESPACE_ENTER
             throw Exception(err.str().c_str());
         }
 
-        if(!getConfig())
+        // A processor to bake does not need any config.
+        if(!getProcessor() && !getConfig())
         {
             throw Exception("No OCIO config has been set");
         }
    
         try
         {
-            fmt->bake(*this, getImpl()->formatName_, os);
+            if(!getProcessor() && getImpl()->autoShaperSpace_ && getImpl()->tolerance_>0.0f
+                && getImpl()->shaperSpace_.empty())
+            {
+                BakerRcPtr baker = createEditableCopy();
+                baker->setShaperSpace(SelectShaperSpace(*this).c_str());
+                fmt->bake(*baker, getImpl()->formatName_, os);
+            }
+            else
+            {
+                fmt->bake(*this, getImpl()->formatName_, os);
+            }
         }
         catch(std::exception & e)
         {
@@ -270,6 +332,7 @@ OCIO_NAMESPACE_EXIT
 #ifdef OCIO_UNIT_TEST
 
 namespace OCIO = OCIO_NAMESPACE;
+#include "ParseUtils.h"
 #include "UnitTest.h"
 
 /*
@@ -393,6 +456,8 @@ OCIO_ADD_TEST(Baker, bake)
     OCIO_CHECK_EQUAL(4, bake->getShaperSize());
     bake->setCubeSize(2);
     OCIO_CHECK_EQUAL(2, bake->getCubeSize());
+    OCIO_CHECK_EQUAL(0.0f, bake->getTolerance());
+    OCIO_CHECK_ASSERT(!bake->getAutoShaperSpace());
     std::ostringstream os;
     OCIO_CHECK_NO_THROW(bake->bake(os));
     OCIO_CHECK_EQUAL(expectedLut, os.str());
@@ -406,6 +471,147 @@ OCIO_ADD_TEST(Baker, bake)
 
 }
 
+OCIO_ADD_TEST(Baker, tolerance)
+{
+    OCIO::ConfigRcPtr config = OCIO::Config::Create();
+
+    OCIO::ColorSpaceRcPtr input = OCIO::ColorSpace::Create();
+    input->setName("input");
+    config->addColorSpace(input);
+
+    OCIO::ColorSpaceRcPtr target = OCIO::ColorSpace::Create();
+    target->setName("target");
+    OCIO::MatrixTransformRcPtr matrix = OCIO::MatrixTransform::Create();
+    constexpr double m44[16] = { 0.9, 0.1, 0.0, 0.0,
+                                 0.2, 0.7, 0.1, 0.0,
+                                 0.0, 0.3, 0.6, 0.0,
+                                 0.0, 0.0, 0.0, 1.0 };
+    matrix->setMatrix(m44);
+    target->setTransform(matrix, OCIO::COLORSPACE_DIR_FROM_REFERENCE);
+    config->addColorSpace(target);
+
+    OCIO::BakerRcPtr bake = OCIO::Baker::Create();
+    bake->setConfig(config);
+    bake->setFormat("iridas_cube");
+    bake->setInputSpace("input");
+    bake->setTargetSpace("target");
+    bake->setTolerance(1e-4f);
+    OCIO_CHECK_EQUAL(1e-4f, bake->getTolerance());
+    bake->setAutoShaperSpace(true);
+    OCIO_CHECK_ASSERT(bake->getAutoShaperSpace());
+
+    // A matrix only needs the smallest cube.
+    std::ostringstream os;
+    OCIO_CHECK_NO_THROW(bake->bake(os));
+    OCIO_CHECK_NE(os.str().find("LUT_3D_SIZE 2\n"), std::string::npos);
+
+    // The copy keeps the tolerance.
+    OCIO::BakerRcPtr copy = bake->createEditableCopy();
+    OCIO_CHECK_EQUAL(1e-4f, copy->getTolerance());
+    OCIO_CHECK_ASSERT(copy->getAutoShaperSpace());
+}
+
+OCIO_ADD_TEST(Baker, processor)
+{
+    OCIO::ConfigRcPtr config = OCIO::Config::Create();
+
+    OCIO::ColorSpaceRcPtr lin = OCIO::ColorSpace::Create();
+    lin->setName("lin");
+    config->addColorSpace(lin);
+
+    OCIO::ColorSpaceRcPtr log = OCIO::ColorSpace::Create();
+    log->setName("log");
+    OCIO::LogTransformRcPtr logTransform = OCIO::LogTransform::Create();
+    logTransform->setBase(2.0);
+    log->setTransform(logTransform, OCIO::COLORSPACE_DIR_FROM_REFERENCE);
+    config->addColorSpace(log);
+
+    OCIO::ColorSpaceRcPtr target = OCIO::ColorSpace::Create();
+    target->setName("target");
+    OCIO::MatrixTransformRcPtr matrix = OCIO::MatrixTransform::Create();
+    constexpr double m44[16] = { 0.9, 0.1, 0.0, 0.0,
+                                 0.2, 0.7, 0.1, 0.0,
+                                 0.0, 0.3, 0.6, 0.0,
+                                 0.0, 0.0, 0.0, 1.0 };
+    matrix->setMatrix(m44);
+    target->setTransform(matrix, OCIO::COLORSPACE_DIR_FROM_REFERENCE);
+    config->addColorSpace(target);
+
+    // Compare the tokens of two baked LUTs, the numbers within a tolerance.
+    const auto compare = [](const std::string & lut1, const std::string & lut2)
+    {
+        std::istringstream is1(lut1);
+        std::istringstream is2(lut2);
+        std::string token1, token2;
+        while(is1 >> token1)
+        {
+            OCIO_REQUIRE_ASSERT(is2 >> token2);
+            float value1 = 0.0f, value2 = 0.0f;
+            if(OCIO::StringToFloat(&value1, token1.c_str()))
+            {
+                OCIO_REQUIRE_ASSERT(OCIO::StringToFloat(&value2, token2.c_str()));
+                OCIO_CHECK_CLOSE(value1, value2, 1e-4f);
+            }
+            else
+            {
+                OCIO_CHECK_EQUAL(token1, token2);
+            }
+        }
+        OCIO_CHECK_ASSERT(!(is2 >> token2));
+    };
+
+    OCIO::BakerRcPtr spacesBaker = OCIO::Baker::Create();
+    spacesBaker->setConfig(config);
+    spacesBaker->setFormat("resolve_cube");
+    spacesBaker->setInputSpace("lin");
+    spacesBaker->setTargetSpace("target");
+    spacesBaker->setShaperSize(16);
+    spacesBaker->setCubeSize(5);
+
+    // The processor baker does not need any config.
+    OCIO::BakerRcPtr processorBaker = OCIO::Baker::Create();
+    processorBaker->setFormat("resolve_cube");
+    processorBaker->setShaperSize(16);
+    processorBaker->setCubeSize(5);
+
+    OCIO::ConstProcessorRcPtr processor = config->getProcessor("lin", "target");
+    processorBaker->setProcessor(processor);
+    OCIO_CHECK_EQUAL(processorBaker->getProcessor(), processor);
+
+    // Without a shaper, the same processor is baked.
+    std::ostringstream spacesLut, processorLut;
+    OCIO_CHECK_NO_THROW(spacesBaker->bake(spacesLut));
+    OCIO_CHECK_NO_THROW(processorBaker->bake(processorLut));
+    OCIO_CHECK_EQUAL(spacesLut.str(), processorLut.str());
+
+    // With a shaper.
+    spacesBaker->setShaperSpace("log");
+    OCIO::ConstProcessorRcPtr shaper = config->getProcessor("lin", "log");
+    processorBaker->setShaperProcessor(shaper);
+    OCIO_CHECK_EQUAL(processorBaker->getShaperProcessor(), shaper);
+
+    spacesLut.str("");
+    processorLut.str("");
+    OCIO_CHECK_NO_THROW(spacesBaker->bake(spacesLut));
+    OCIO_CHECK_NO_THROW(processorBaker->bake(processorLut));
+    OCIO_CHECK_NE(processorLut.str().find("LUT_1D_SIZE 16\n"), std::string::npos);
+    OCIO_CHECK_NE(processorLut.str().find("LUT_3D_SIZE 5\n"), std::string::npos);
+    compare(spacesLut.str(), processorLut.str());
+
+    // The copy keeps the processors.
+    OCIO::BakerRcPtr copy = processorBaker->createEditableCopy();
+    OCIO_CHECK_EQUAL(copy->getProcessor(), processor);
+    OCIO_CHECK_EQUAL(copy->getShaperProcessor(), shaper);
+
+    // The CSP format without a shaper processor uses an identity shaper.
+    processorBaker->setShaperProcessor(OCIO::ConstProcessorRcPtr());
+    processorBaker->setFormat("cinespace");
+    processorLut.str("");
+    OCIO_CHECK_NO_THROW(processorBaker->bake(processorLut));
+    OCIO_CHECK_NE(processorLut.str().find("2\n0.000000 1.000000\n0.000000 1.000000\n"),
+                  std::string::npos);
+}
+
 OCIO_ADD_TEST(Baker, empty_config)
 {
     // Verify that running bake with an empty configuration
@@ -0,0 +1,707 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the OpenColorIO Project.
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <sstream>
+#include <string>
+
+#include <OpenColorIO/OpenColorIO.h>
+
+#include "BakingUtils.h"
+#include "Logging.h"
+#include "MathUtils.h"
+#include "ops/Lut1D/Lut1DOp.h"
+
+
+OCIO_NAMESPACE_ENTER
+{
+
+namespace
+{
+
+// The LUT grids are processed as images of lines of this width so the parallel image
+// processing could split them into bands.
+constexpr long BAKE_LINE_WIDTH = 1024;
+
+ConstProcessorRcPtr GetProcessor(const Baker & baker, const char * src, const char * dst)
+{
+    ConstConfigRcPtr config = baker.getConfig();
+
+    const std::string looks = baker.getLooks();
+    if(!looks.empty())
+    {
+        LookTransformRcPtr transform = LookTransform::Create();
+        transform->setLooks(looks.c_str());
+        transform->setSrc(src);
+        transform->setDst(dst);
+        return config->getProcessor(transform, TRANSFORM_DIR_FORWARD);
+    }
+
+    return config->getProcessor(src, dst);
+}
+
+// Get the shaper processor of the baker, throwing if there is none.
+ConstProcessorRcPtr GetShaperProcessor(const Baker & baker)
+{
+    ConstProcessorRcPtr shaper = baker.getShaperProcessor();
+    if(!shaper)
+    {
+        throw Exception("No shaper processor has been set.");
+    }
+    return shaper;
+}
+
+// Get the inverse of the shaper processor of the baker.
+GroupTransformRcPtr GetInverseShaperTransform(const Baker & baker)
+{
+    GroupTransformRcPtr inverse = GetShaperProcessor(baker)->createGroupTransform();
+    inverse->setDirection(TRANSFORM_DIR_INVERSE);
+    return inverse;
+}
+
+}
+
+ConstConfigRcPtr GetBakeConfig(const Baker & baker)
+{
+    return baker.getProcessor() ? Config::CreateRaw() : baker.getConfig();
+}
+
+bool HasShaper(const Baker & baker)
+{
+    return baker.getProcessor() ? bool(baker.getShaperProcessor())
+                                : std::string(baker.getShaperSpace()).size()>0;
+}
+
+ConstProcessorRcPtr GetInputToTargetProcessor(const Baker & baker)
+{
+    if(baker.getProcessor())
+    {
+        return baker.getProcessor();
+    }
+
+    return GetProcessor(baker, baker.getInputSpace(), baker.getTargetSpace());
+}
+
+ConstProcessorRcPtr GetShaperToTargetProcessor(const Baker & baker)
+{
+    if(baker.getProcessor())
+    {
+        GroupTransformRcPtr group = GroupTransform::Create();
+        group->appendTransform(GetInverseShaperTransform(baker));
+        group->appendTransform(baker.getProcessor()->createGroupTransform());
+        return GetBakeConfig(baker)->getProcessor(group);
+    }
+
+    return GetProcessor(baker, baker.getShaperSpace(), baker.getTargetSpace());
+}
+
+ConstProcessorRcPtr GetInputToShaperProcessor(const Baker & baker)
+{
+    if(baker.getProcessor())
+    {
+        return GetShaperProcessor(baker);
+    }
+
+    return baker.getConfig()->getProcessor(baker.getInputSpace(), baker.getShaperSpace());
+}
+
+ConstProcessorRcPtr GetShaperToInputProcessor(const Baker & baker)
+{
+    if(baker.getProcessor())
+    {
+        return GetBakeConfig(baker)->getProcessor(GetInverseShaperTransform(baker));
+    }
+
+    return baker.getConfig()->getProcessor(baker.getShaperSpace(), baker.getInputSpace());
+}
+
+void GetShaperRange(const Baker & baker, float & start, float & end)
+{
+    // Get the input value of 1.0 in the shaper space, as this is the highest value
+    // transformed by the cube (e.g. for a generic lin-to-log transform, what the
+    // log value 1.0 is in linear).
+    float values[6] = { 0.0f, 0.0f, 0.0f,
+                        1.0f, 1.0f, 1.0f };
+
+    GetShaperToInputProcessor(baker)->getDefaultCPUProcessor()->applyRGB(values, 2);
+
+    // Grab the green channel, as this is the one used by the prelut.
+    start = values[1];
+    end   = values[4];
+}
+
+void ApplyToRGB(const ConstProcessorRcPtr & processor, std::vector<float> & rgb)
+{
+    if(!processor || rgb.empty())
+    {
+        return;
+    }
+
+    ConstCPUProcessorRcPtr cpu = processor->getDefaultCPUProcessor();
+
+    const long numPixels = long(rgb.size() / 3);
+    const long numLines  = numPixels / BAKE_LINE_WIDTH;
+
+    if(numLines>0)
+    {
+        PackedImageDesc img(&rgb[0], BAKE_LINE_WIDTH, numLines, 3);
+        cpu->apply(img, CPUExecutor());
+    }
+
+    const long numRemainingPixels = numPixels - numLines * BAKE_LINE_WIDTH;
+    if(numRemainingPixels>0)
+    {
+        PackedImageDesc img(&rgb[3 * numLines * BAKE_LINE_WIDTH], numRemainingPixels, 1, 3);
+        cpu->apply(img);
+    }
+}
+
+std::vector<float> BakeLut3D(const ConstProcessorRcPtr & processor, int edgeLen,
+                             Lut3DOrder order)
+{
+    std::vector<float> rgb(size_t(edgeLen) * edgeLen * edgeLen * 3);
+    GenerateIdentityLut3D(&rgb[0], edgeLen, 3, order);
+
+    ApplyToRGB(processor, rgb);
+
+    return rgb;
+}
+
+std::vector<float> BakeLut1D(const ConstProcessorRcPtr & processor, int size)
+{
+    std::vector<float> rgb(size_t(size) * 3);
+    GenerateIdentityLut1D(&rgb[0], size, 3);
+
+    ApplyToRGB(processor, rgb);
+
+    return rgb;
+}
+
+std::vector<float> BakeLut1D(const ConstProcessorRcPtr & processor, int size,
+                             float start, float end)
+{
+    std::vector<float> rgb(size_t(size) * 3);
+
+    for(int i = 0; i < size; ++i)
+    {
+        const float x = (float)(double(i) / double(size - 1));
+        const float value = lerpf(start, end, x);
+
+        rgb[3*i+0] = value;
+        rgb[3*i+1] = value;
+        rgb[3*i+2] = value;
+    }
+
+    ApplyToRGB(processor, rgb);
+
+    return rgb;
+}
+
+namespace
+{
+
+// The candidate sizes, in increasing order. The cube sizes are the usual 2^n+1 ones,
+// supported by all the formats.
+const std::vector<int> CUBE_SIZES{ 2, 3, 5, 9, 17, 33, 65, 129 };
+const std::vector<int> SHAPER_SIZES{ 64, 256, 1024, 4096 };
+const std::vector<int> LUT1D_SIZES{ 256, 1024, 4096, 16384, 65536 };
+
+// The test values are the centers of the cells of a grid whose number of cells is
+// prime, so they are never on the nodes of a candidate LUT (i.e. where the LUT is exact).
+constexpr int TEST_GRID_SIZE = 37;
+constexpr int TEST_LUT1D_SIZE = 16411;
+
+constexpr int DEFAULT_SHAPER_SIZE = 1024;
+
+std::vector<float> GetTestGrid()
+{
+    std::vector<float> rgb(size_t(TEST_GRID_SIZE) * TEST_GRID_SIZE * TEST_GRID_SIZE * 3);
+
+    size_t idx = 0;
+    for(int b = 0; b < TEST_GRID_SIZE; ++b)
+    {
+        for(int g = 0; g < TEST_GRID_SIZE; ++g)
+        {
+            for(int r = 0; r < TEST_GRID_SIZE; ++r)
+            {
+                rgb[idx++] = (float(r) + 0.5f) / float(TEST_GRID_SIZE);
+                rgb[idx++] = (float(g) + 0.5f) / float(TEST_GRID_SIZE);
+                rgb[idx++] = (float(b) + 0.5f) / float(TEST_GRID_SIZE);
+            }
+        }
+    }
+
+    return rgb;
+}
+
+// The values out of the exact processor domain (i.e. not finite) are ignored.
+float GetMaxError(const std::vector<float> & exact, const std::vector<float> & approx)
+{
+    float maxError = 0.0f;
+    for(size_t idx = 0; idx < exact.size(); ++idx)
+    {
+        if(!std::isfinite(exact[idx]))
+        {
+            continue;
+        }
+
+        const float error = std::fabs(exact[idx] - approx[idx]);
+        if(std::isnan(error))
+        {
+            return std::numeric_limits<float>::infinity();
+        }
+        maxError = std::max(maxError, error);
+    }
+
+    return maxError;
+}
+
+// Get the maximum error of the approximation on the input values.
+float GetMaxError(const Baker & baker, const ConstTransformRcPtr & approximation,
+                  const std::vector<float> & input)
+{
+    std::vector<float> exact(input);
+    ApplyToRGB(GetInputToTargetProcessor(baker), exact);
+
+    std::vector<float> approx(input);
+    ApplyToRGB(GetBakeConfig(baker)->getProcessor(approximation), approx);
+
+    return GetMaxError(exact, approx);
+}
+
+TransformRcPtr CreateLut3D(const ConstProcessorRcPtr & processor, int cubeSize)
+{
+    const std::vector<float> values = BakeLut3D(processor, cubeSize, LUT3DORDER_FAST_RED);
+
+    LUT3DTransformRcPtr lut = LUT3DTransform::Create(cubeSize);
+
+    size_t idx = 0;
+    for(int b = 0; b < cubeSize; ++b)
+    {
+        for(int g = 0; g < cubeSize; ++g)
+        {
+            for(int r = 0; r < cubeSize; ++r, idx += 3)
+            {
+                lut->setValue(r, g, b, values[idx+0], values[idx+1], values[idx+2]);
+            }
+        }
+    }
+
+    return lut;
+}
+
+TransformRcPtr CreateLut1D(const std::vector<float> & values)
+{
+    const unsigned long length = (unsigned long)(values.size() / 3);
+
+    LUT1DTransformRcPtr lut = LUT1DTransform::Create();
+    lut->setLength(length);
+
+    for(unsigned long idx = 0; idx < length; ++idx)
+    {
+        lut->setValue(idx, values[3*idx+0], values[3*idx+1], values[3*idx+2]);
+    }
+
+    return lut;
+}
+
+// Return the first size whose error is within the tolerance, or the last size.
+int SelectSize(const std::vector<int> & sizes, float tolerance, const char * name,
+               const std::function<float(int)> & getError)
+{
+    for(int size : sizes)
+    {
+        if(getError(size) <= tolerance)
+        {
+            return size;
+        }
+    }
+
+    std::ostringstream os;
+    os << "The baked " << name << " is not within the tolerance of " << tolerance
+       << ", using the largest size " << sizes.back() << ".";
+    LogWarning(os.str());
+
+    return sizes.back();
+}
+
+}
+
+float GetBakeError(const Baker & baker, int cubeSize, int shaperSize)
+{
+    std::vector<float> input = GetTestGrid();
+
+    GroupTransformRcPtr group = GroupTransform::Create();
+
+    if(shaperSize>0)
+    {
+        float start = 0.0f;
+        float end = 0.0f;
+        GetShaperRange(baker, start, end);
+        if(!std::isfinite(start) || !std::isfinite(end) || !(start < end))
+        {
+            return std::numeric_limits<float>::infinity();
+        }
+
+        // The test values sample the shaper space i.e. the domain of the cube.
+        ApplyToRGB(GetShaperToInputProcessor(baker), input);
+
+        // The shaper linearly samples the input values from start to end.
+        const double oldmin[4] = { start, start, start, 0.0 };
+        const double oldmax[4] = { end, end, end, 1.0 };
+        const double newmin[4] = { 0.0, 0.0, 0.0, 0.0 };
+        const double newmax[4] = { 1.0, 1.0, 1.0, 1.0 };
+
+        double m44[16];
+        double offset4[4];
+        MatrixTransform::Fit(m44, offset4, oldmin, oldmax, newmin, newmax);
+
+        MatrixTransformRcPtr fit = MatrixTransform::Create();
+        fit->setMatrix(m44);
+        fit->setOffset(offset4);
+        group->appendTransform(fit);
+
+        group->appendTransform(
+            CreateLut1D(BakeLut1D(GetInputToShaperProcessor(baker), shaperSize, start, end)));
+        group->appendTransform(CreateLut3D(GetShaperToTargetProcessor(baker), cubeSize));
+    }
+    else
+    {
+        group->appendTransform(CreateLut3D(GetInputToTargetProcessor(baker), cubeSize));
+    }
+
+    return GetMaxError(baker, group, input);
+}
+
+float GetBakeLut1DError(const Baker & baker, int size)
+{
+    std::vector<float> input(size_t(TEST_LUT1D_SIZE) * 3);
+    for(int idx = 0; idx < TEST_LUT1D_SIZE; ++idx)
+    {
+        const float value = (float(idx) + 0.5f) / float(TEST_LUT1D_SIZE);
+        input[3*idx+0] = value;
+        input[3*idx+1] = value;
+        input[3*idx+2] = value;
+    }
+
+    return GetMaxError(baker, CreateLut1D(BakeLut1D(GetInputToTargetProcessor(baker), size)),
+                       input);
+}
+
+void SelectCubeSize(const Baker & baker, int & cubeSize)
+{
+    if(baker.getTolerance()<=0.0f || baker.getCubeSize()!=-1)
+    {
+        return;
+    }
+
+    cubeSize = SelectSize(CUBE_SIZES, baker.getTolerance(), "cube",
+                          [&baker](int size) { return GetBakeError(baker, size, 0); });
+}
+
+void SelectShaperAndCubeSizes(const Baker & baker, int & shaperSize, int & cubeSize)
+{
+    const bool selectCubeSize = baker.getCubeSize()==-1;
+    const bool selectShaperSize = baker.getShaperSize()<0;
+
+    if(baker.getTolerance()<=0.0f || (!selectCubeSize && !selectShaperSize))
+    {
+        return;
+    }
+
+    const std::vector<int> cubeSizes
+        = selectCubeSize ? CUBE_SIZES : std::vector<int>{ cubeSize };
+    const std::vector<int> shaperSizes
+        = selectShaperSize ? SHAPER_SIZES : std::vector<int>{ shaperSize };
+
+    // The cube is the largest part of the LUT, so its size is minimized first.
+    for(int cube : cubeSizes)
+    {
+        for(int shaper : shaperSizes)
+        {
+            if(GetBakeError(baker, cube, shaper) <= baker.getTolerance())
+            {
+                cubeSize = cube;
+                shaperSize = shaper;
+                return;
+            }
+        }
+    }
+
+    std::ostringstream os;
+    os << "The baked shaper and cube are not within the tolerance of "
+       << baker.getTolerance() << ", using the largest sizes.";
+    LogWarning(os.str());
+
+    cubeSize = cubeSizes.back();
+    shaperSize = shaperSizes.back();
+}
+
+void SelectLut1DSize(const Baker & baker, int & size)
+{
+    if(baker.getTolerance()<=0.0f || baker.getCubeSize()!=-1)
+    {
+        return;
+    }
+
+    size = SelectSize(LUT1D_SIZES, baker.getTolerance(), "1D LUT",
+                      [&baker](int lutSize) { return GetBakeLut1DError(baker, lutSize); });
+}
+
+std::string SelectShaperSpace(const Baker & baker)
+{
+    ConstConfigRcPtr config = baker.getConfig();
+    const float tolerance = baker.getTolerance();
+
+    const int shaperSize
+        = baker.getShaperSize()<2 ? DEFAULT_SHAPER_SIZE : baker.getShaperSize();
+
+    // Start from the smallest cube without shaper.
+    size_t bestIdx = 0;
+    while(bestIdx<CUBE_SIZES.size() && GetBakeError(baker, CUBE_SIZES[bestIdx], 0) > tolerance)
+    {
+        ++bestIdx;
+    }
+    std::string bestShaperSpace;
+
+    ConstColorSpaceRcPtr inputSpace = config->getColorSpace(baker.getInputSpace());
+
+    BakerRcPtr candidate = baker.createEditableCopy();
+    for(int idx = 0; idx < config->getNumColorSpaces() && bestIdx>0; ++idx)
+    {
+        const char * name = config->getColorSpaceNameByIndex(idx);
+
+        ConstColorSpaceRcPtr cs = config->getColorSpace(name);
+        if(!cs || cs->isData() || cs==inputSpace)
+        {
+            continue;
+        }
+
+        candidate->setShaperSpace(name);
+
+        try
+        {
+            // Only try the smaller cubes than the best one so far.
+            if(!GetInputToShaperProcessor(*candidate)->hasChannelCrosstalk())
+            {
+                for(size_t cubeIdx = 0; cubeIdx < bestIdx; ++cubeIdx)
+                {
+                    if(GetBakeError(*candidate, CUBE_SIZES[cubeIdx], shaperSize) <= tolerance)
+                    {
+                        bestIdx = cubeIdx;
+                        bestShaperSpace = name;
+                        break;
+                    }
+                }
+            }
+        }
+        catch(const Exception &)
+        {
+            // The colorspaces that could not be processed (e.g. missing LUT files) are
+            // not candidates.
+        }
+    }
+
+    if(!bestShaperSpace.empty())
+    {
+        std::ostringstream os;
+        os << "Selected the shaper space '" << bestShaperSpace << "'.";
+        LogInfo(os.str());
+    }
+
+    return bestShaperSpace;
+}
+
+}
+OCIO_NAMESPACE_EXIT
+
+
+///////////////////////////////////////////////////////////////////////////////
+
+#ifdef OCIO_UNIT_TEST
+
+namespace OCIO = OCIO_NAMESPACE;
+#include "UnitTest.h"
+
+namespace
+{
+
+OCIO::BakerRcPtr CreateTestBaker()
+{
+    OCIO::ConfigRcPtr config = OCIO::Config::Create();
+
+    OCIO::ColorSpaceRcPtr input = OCIO::ColorSpace::Create();
+    input->setName("input");
+    config->addColorSpace(input);
+
+    OCIO::ColorSpaceRcPtr target = OCIO::ColorSpace::Create();
+    target->setName("target");
+    OCIO::MatrixTransformRcPtr matrix = OCIO::MatrixTransform::Create();
+    constexpr double m44[16] = { 0.9, 0.1, 0.0, 0.0,
+                                 0.2, 0.7, 0.1, 0.0,
+                                 0.0, 0.3, 0.6, 0.0,
+                                 0.0, 0.0, 0.0, 1.0 };
+    matrix->setMatrix(m44);
+    target->setTransform(matrix, OCIO::COLORSPACE_DIR_FROM_REFERENCE);
+    config->addColorSpace(target);
+
+    OCIO::ColorSpaceRcPtr shaper = OCIO::ColorSpace::Create();
+    shaper->setName("shaper");
+    OCIO::ExponentTransformRcPtr exponent = OCIO::ExponentTransform::Create();
+    constexpr double exp4[4] = { 2.0, 2.0, 2.0, 1.0 };
+    exponent->setValue(exp4);
+    shaper->setTransform(exponent, OCIO::COLORSPACE_DIR_TO_REFERENCE);
+    config->addColorSpace(shaper);
+
+    OCIO::ColorSpaceRcPtr gamma = OCIO::ColorSpace::Create();
+    gamma->setName("gamma");
+    OCIO::ExponentTransformRcPtr gammaExponent = OCIO::ExponentTransform::Create();
+    constexpr double gamma4[4] = { 2.2, 2.2, 2.2, 1.0 };
+    gammaExponent->setValue(gamma4);
+    gamma->setTransform(gammaExponent, OCIO::COLORSPACE_DIR_FROM_REFERENCE);
+    config->addColorSpace(gamma);
+
+    OCIO::BakerRcPtr baker = OCIO::Baker::Create();
+    baker->setConfig(config);
+    baker->setInputSpace("input");
+    baker->setShaperSpace("shaper");
+    baker->setTargetSpace("target");
+
+    return baker;
+}
+
+}
+
+OCIO_ADD_TEST(BakingUtils, bake_lut3d)
+{
+    OCIO::BakerRcPtr baker = CreateTestBaker();
+
+    OCIO::ConstProcessorRcPtr processor;
+    OCIO_CHECK_NO_THROW(processor = OCIO::GetInputToTargetProcessor(*baker));
+    OCIO_REQUIRE_ASSERT(processor);
+
+    // The processors are cached by the config of the baker.
+    OCIO_CHECK_EQUAL(processor.get(), OCIO::GetInputToTargetProcessor(*baker).get());
+
+    // Use a cube larger than a line to process several lines and the remaining pixels.
+    constexpr int edgeLen = 17;
+
+    std::vector<float> cube;
+    OCIO_CHECK_NO_THROW(cube = OCIO::BakeLut3D(processor, edgeLen, OCIO::LUT3DORDER_FAST_RED));
+    OCIO_REQUIRE_EQUAL(cube.size(), size_t(edgeLen * edgeLen * edgeLen * 3));
+
+    // The grid is processed as the serial processing does.
+    std::vector<float> expected(cube.size());
+    OCIO::GenerateIdentityLut3D(&expected[0], edgeLen, 3, OCIO::LUT3DORDER_FAST_RED);
+    OCIO::PackedImageDesc img(&expected[0], edgeLen * edgeLen * edgeLen, 1, 3);
+    processor->getDefaultCPUProcessor()->apply(img);
+
+    for(size_t idx = 0; idx < cube.size(); ++idx)
+    {
+        OCIO_CHECK_EQUAL(cube[idx], expected[idx]);
+    }
+
+    // A null processor only generates the identity grid.
+    std::vector<float> identity;
+    OCIO_CHECK_NO_THROW(identity = OCIO::BakeLut3D(OCIO::ConstProcessorRcPtr(), 2,
+                                                   OCIO::LUT3DORDER_FAST_BLUE));
+    const std::vector<float> expectedIdentity{ 0.0f, 0.0f, 0.0f,
+                                               0.0f, 0.0f, 1.0f,
+                                               0.0f, 1.0f, 0.0f,
+                                               0.0f, 1.0f, 1.0f,
+                                               1.0f, 0.0f, 0.0f,
+                                               1.0f, 0.0f, 1.0f,
+                                               1.0f, 1.0f, 0.0f,
+                                               1.0f, 1.0f, 1.0f };
+    OCIO_CHECK_ASSERT(identity == expectedIdentity);
+}
+
+OCIO_ADD_TEST(BakingUtils, bake_shaper)
+{
+    OCIO::BakerRcPtr baker = CreateTestBaker();
+
+    // The shaper is a square root of the input.
+    float start = -1.0f;
+    float end = -1.0f;
+    OCIO_CHECK_NO_THROW(OCIO::GetShaperRange(*baker, start, end));
+    OCIO_CHECK_EQUAL(start, 0.0f);
+    OCIO_CHECK_CLOSE(end, 1.0f, 1e-6f);
+
+    std::vector<float> shaper;
+    OCIO_CHECK_NO_THROW(shaper = OCIO::BakeLut1D(OCIO::GetInputToShaperProcessor(*baker),
+                                                 5, 0.0f, 0.25f));
+    OCIO_REQUIRE_EQUAL(shaper.size(), size_t(5 * 3));
+
+    const float expected[5] = { 0.0f, 0.25f, 0.35355339f, 0.4330127f, 0.5f };
+    for(int idx = 0; idx < 5; ++idx)
+    {
+        OCIO_CHECK_CLOSE(shaper[3 * idx + 0], expected[idx], 1e-5f);
+        OCIO_CHECK_CLOSE(shaper[3 * idx + 1], expected[idx], 1e-5f);
+        OCIO_CHECK_CLOSE(shaper[3 * idx + 2], expected[idx], 1e-5f);
+    }
+
+    // Without a range, this is the identity 1D LUT grid.
+    std::vector<float> identity;
+    OCIO_CHECK_NO_THROW(identity = OCIO::BakeLut1D(OCIO::ConstProcessorRcPtr(), 3));
+    const std::vector<float> expectedIdentity{ 0.0f, 0.0f, 0.0f,
+                                               0.5f, 0.5f, 0.5f,
+                                               1.0f, 1.0f, 1.0f };
+    OCIO_CHECK_ASSERT(identity == expectedIdentity);
+}
+
+OCIO_ADD_TEST(BakingUtils, select_sizes)
+{
+    OCIO::BakerRcPtr baker = CreateTestBaker();
+
+    // Without tolerance, the sizes are unchanged.
+    int cubeSize = 33;
+    OCIO_CHECK_NO_THROW(OCIO::SelectCubeSize(*baker, cubeSize));
+    OCIO_CHECK_EQUAL(cubeSize, 33);
+
+    // A matrix is exactly interpolated by the smallest cube.
+    baker->setTolerance(1e-4f);
+    OCIO_CHECK_NO_THROW(OCIO::SelectCubeSize(*baker, cubeSize));
+    OCIO_CHECK_EQUAL(cubeSize, 2);
+
+    // A size set in the baker is never changed.
+    baker->setCubeSize(17);
+    cubeSize = 17;
+    OCIO_CHECK_NO_THROW(OCIO::SelectCubeSize(*baker, cubeSize));
+    OCIO_CHECK_EQUAL(cubeSize, 17);
+    baker->setCubeSize(-1);
+
+    // A curve needs a larger cube i.e. the smallest one within the tolerance.
+    baker->setTargetSpace("gamma");
+    OCIO_CHECK_NO_THROW(OCIO::SelectCubeSize(*baker, cubeSize));
+    OCIO_CHECK_EQUAL(cubeSize, 65);
+    OCIO_CHECK_ASSERT(OCIO::GetBakeError(*baker, 65, 0) <= 1e-4f);
+    OCIO_CHECK_ASSERT(OCIO::GetBakeError(*baker, 33, 0) > 1e-4f);
+
+    int size = 4096;
+    OCIO_CHECK_NO_THROW(OCIO::SelectLut1DSize(*baker, size));
+    OCIO_CHECK_ASSERT(OCIO::GetBakeLut1DError(*baker, size) <= 1e-4f);
+    OCIO_CHECK_ASSERT(size == 256 || OCIO::GetBakeLut1DError(*baker, size / 4) > 1e-4f);
+
+    // With a shaper.
+    int shaperSize = 1024;
+    cubeSize = 33;
+    OCIO_CHECK_NO_THROW(OCIO::SelectShaperAndCubeSizes(*baker, shaperSize, cubeSize));
+    OCIO_CHECK_ASSERT(OCIO::GetBakeError(*baker, cubeSize, shaperSize) <= 1e-4f);
+
+    // The shaper linearizing the transform only needs the smallest cube.
+    std::string shaperSpace;
+    OCIO_CHECK_NO_THROW(shaperSpace = OCIO::SelectShaperSpace(*baker));
+    OCIO_CHECK_EQUAL(shaperSpace, "gamma");
+
+    baker->setShaperSpace(shaperSpace.c_str());
+    shaperSize = 1024;
+    cubeSize = 33;
+    OCIO_CHECK_NO_THROW(OCIO::SelectShaperAndCubeSizes(*baker, shaperSize, cubeSize));
+    OCIO_CHECK_EQUAL(cubeSize, 2);
+    OCIO_CHECK_ASSERT(OCIO::GetBakeError(*baker, cubeSize, shaperSize) <= 1e-4f);
+}
+
+#endif // OCIO_UNIT_TEST
@@ -0,0 +1,91 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the OpenColorIO Project.
+
+
+#ifndef INCLUDED_OCIO_BAKINGUTILS_H
+#define INCLUDED_OCIO_BAKINGUTILS_H
+
+#include <string>
+#include <vector>
+
+#include <OpenColorIO/OpenColorIO.h>
+
+#include "ops/Lut3D/Lut3DOp.h"
+
+
+OCIO_NAMESPACE_ENTER
+{
+
+// The bake engine shared by all the file formats: the formats get the processors and
+// the evaluated LUT grids from here, and only serialize them.
+//
+// The processors come from the config of the baker so they are cached by the config
+// (refer to SetProcessorCacheSize()). Baking several formats, or several looks and
+// target spaces with the same baker, then reuses the intermediate processors.
+
+// When the baker has a processor to bake (refer to Baker::setProcessor()), the config
+// is not used: the processors come from the processor to bake and the optional shaper
+// processor instead of the spaces and the looks.
+
+// Get the config creating the processors of the LUT approximations i.e. the config of the
+// baker or, when baking a processor, a raw config.
+ConstConfigRcPtr GetBakeConfig(const Baker & baker);
+
+// Does the baker have a shaper i.e. a shaper space or, when baking a processor, a shaper
+// processor?
+bool HasShaper(const Baker & baker);
+
+// Get the processor from the input space to the target space, including the looks.
+ConstProcessorRcPtr GetInputToTargetProcessor(const Baker & baker);
+// Get the processor from the shaper space to the target space, including the looks.
+ConstProcessorRcPtr GetShaperToTargetProcessor(const Baker & baker);
+
+ConstProcessorRcPtr GetInputToShaperProcessor(const Baker & baker);
+ConstProcessorRcPtr GetShaperToInputProcessor(const Baker & baker);
+
+// Get the input space range covered by the shaper i.e. the input values of 0 and 1 in the
+// shaper space (using the green channel).
+void GetShaperRange(const Baker & baker, float & start, float & end);
+
+// Process packed RGB values (e.g. the grid of a LUT to bake) in place, using the
+// parallel image processing. A null processor does nothing.
+void ApplyToRGB(const ConstProcessorRcPtr & processor, std::vector<float> & rgb);
+
+// Evaluate the processor (if not null) on the identity 3D LUT grid i.e. edgeLen^3 packed
+// RGB values in the requested order.
+std::vector<float> BakeLut3D(const ConstProcessorRcPtr & processor, int edgeLen,
+                             Lut3DOrder order);
+
+// Evaluate the processor (if not null) on the identity 1D LUT grid i.e. size packed RGB
+// values linearly sampling [0, 1].
+std::vector<float> BakeLut1D(const ConstProcessorRcPtr & processor, int size);
+
+// Evaluate the processor (if not null) on a 1D LUT grid i.e. size packed RGB values
+// linearly sampling [start, end].
+std::vector<float> BakeLut1D(const ConstProcessorRcPtr & processor, int size,
+                             float start, float end);
+
+// The automatic selection of the LUT sizes (refer to Baker::setTolerance()).
+
+// Get the maximum absolute error, on a test grid, between the processor from the input
+// space to the target space and its approximation by a cube (preceded by a shaper from
+// the input space to the shaper space when shaperSize is positive).
+float GetBakeError(const Baker & baker, int cubeSize, int shaperSize);
+// Get the same error for a 1D LUT (i.e. sampling [0, 1]).
+float GetBakeLut1DError(const Baker & baker, int size);
+
+// When the baker has a tolerance, replace the sizes that the baker does not override
+// (i.e. -1) by the smallest ones whose error is within the tolerance.
+void SelectCubeSize(const Baker & baker, int & cubeSize);
+void SelectShaperAndCubeSizes(const Baker & baker, int & shaperSize, int & cubeSize);
+void SelectLut1DSize(const Baker & baker, int & size);
+
+// Select the shaper space, among the colorspaces of the config, allowing the smallest
+// cube within the tolerance of the baker. Return an empty string if no shaper space
+// does better than no shaper at all.
+std::string SelectShaperSpace(const Baker & baker);
+
+}
+OCIO_NAMESPACE_EXIT
+
+#endif
@@ -25,16 +25,18 @@ OCIO_NAMESPACE_ENTER
                 return (double)BitDepthInfo<BIT_DEPTH_UINT10>::maxValue;
             case BIT_DEPTH_UINT12:
                 return (double)BitDepthInfo<BIT_DEPTH_UINT12>::maxValue;
+            case BIT_DEPTH_UINT14:
+                return (double)BitDepthInfo<BIT_DEPTH_UINT14>::maxValue;
             case BIT_DEPTH_UINT16:
                 return (double)BitDepthInfo<BIT_DEPTH_UINT16>::maxValue;
+            case BIT_DEPTH_UINT32:
+                return (double)BitDepthInfo<BIT_DEPTH_UINT32>::maxValue;
             case BIT_DEPTH_F16:
                 return (double)BitDepthInfo<BIT_DEPTH_F16>::maxValue;
             case BIT_DEPTH_F32:
                 return (double)BitDepthInfo<BIT_DEPTH_F32>::maxValue;
 
             case BIT_DEPTH_UNKNOWN:
-            case BIT_DEPTH_UINT14:
-            case BIT_DEPTH_UINT32:
             default:
             {
                 std::string err(errBDNotSupported);
@@ -96,16 +98,18 @@ OCIO_NAMESPACE_ENTER
                 return BitDepthInfo<BIT_DEPTH_UINT10>::isFloat;
             case BIT_DEPTH_UINT12:
                 return BitDepthInfo<BIT_DEPTH_UINT12>::isFloat;
+            case BIT_DEPTH_UINT14:
+                return BitDepthInfo<BIT_DEPTH_UINT14>::isFloat;
             case BIT_DEPTH_UINT16:
                 return BitDepthInfo<BIT_DEPTH_UINT16>::isFloat;
+            case BIT_DEPTH_UINT32:
+                return BitDepthInfo<BIT_DEPTH_UINT32>::isFloat;
             case BIT_DEPTH_F16:
                 return BitDepthInfo<BIT_DEPTH_F16>::isFloat;
             case BIT_DEPTH_F32:
                 return BitDepthInfo<BIT_DEPTH_F32>::isFloat;
 
             case BIT_DEPTH_UNKNOWN:
-            case BIT_DEPTH_UINT14:
-            case BIT_DEPTH_UINT32:
             default:
             {
                 std::string err(errBDNotSupported);
@@ -130,7 +134,9 @@ namespace OCIO = OCIO_NAMESPACE;
 OCIO_ADD_TEST(BitDepthUtils, GetBitDepthMaxValue)
 {
     OCIO_CHECK_EQUAL(OCIO::GetBitDepthMaxValue(OCIO::BIT_DEPTH_UINT8), 255.0);
+    OCIO_CHECK_EQUAL(OCIO::GetBitDepthMaxValue(OCIO::BIT_DEPTH_UINT14), 16383.0);
     OCIO_CHECK_EQUAL(OCIO::GetBitDepthMaxValue(OCIO::BIT_DEPTH_UINT16), 65535.0);
+    OCIO_CHECK_EQUAL(OCIO::GetBitDepthMaxValue(OCIO::BIT_DEPTH_UINT32), 4294967295.0);
 
     OCIO_CHECK_EQUAL(OCIO::GetBitDepthMaxValue(OCIO::BIT_DEPTH_F16), 1.0);
     OCIO_CHECK_EQUAL(OCIO::GetBitDepthMaxValue(OCIO::BIT_DEPTH_F32), 1.0);
@@ -144,17 +150,13 @@ OCIO_ADD_TEST(BitDepthUtils, IsFloatBitDepth)
     OCIO_CHECK_ASSERT(!OCIO::IsFloatBitDepth(OCIO::BIT_DEPTH_UINT8));
     OCIO_CHECK_ASSERT(!OCIO::IsFloatBitDepth(OCIO::BIT_DEPTH_UINT10));
     OCIO_CHECK_ASSERT(!OCIO::IsFloatBitDepth(OCIO::BIT_DEPTH_UINT12));
+    OCIO_CHECK_ASSERT(!OCIO::IsFloatBitDepth(OCIO::BIT_DEPTH_UINT14));
     OCIO_CHECK_ASSERT(!OCIO::IsFloatBitDepth(OCIO::BIT_DEPTH_UINT16));
+    OCIO_CHECK_ASSERT(!OCIO::IsFloatBitDepth(OCIO::BIT_DEPTH_UINT32));
     
     OCIO_CHECK_ASSERT(OCIO::IsFloatBitDepth(OCIO::BIT_DEPTH_F16));
     OCIO_CHECK_ASSERT(OCIO::IsFloatBitDepth(OCIO::BIT_DEPTH_F32));
 
-    OCIO_CHECK_THROW_WHAT(
-        OCIO::IsFloatBitDepth(OCIO::BIT_DEPTH_UINT14), OCIO::Exception, "not supported");
-
-    OCIO_CHECK_THROW_WHAT(
-        OCIO::IsFloatBitDepth(OCIO::BIT_DEPTH_UINT32), OCIO::Exception, "not supported");
-
     OCIO_CHECK_THROW_WHAT(
         OCIO::IsFloatBitDepth((OCIO::BitDepth)42), OCIO::Exception, "not supported");
 }
@@ -50,6 +50,13 @@ template<> struct BitDepthInfo<BIT_DEPTH_UINT12>
     static const unsigned maxValue = 4095;
 };
 
+template<> struct BitDepthInfo<BIT_DEPTH_UINT14>
+{
+    typedef uint16_t Type;
+    static const bool isFloat = false;
+    static const unsigned maxValue = 16383;
+};
+
 template<> struct BitDepthInfo<BIT_DEPTH_UINT16>
 {
     typedef uint16_t Type;
@@ -57,6 +64,13 @@ template<> struct BitDepthInfo<BIT_DEPTH_UINT16>
     static const unsigned maxValue = 65535;
 };
 
+template<> struct BitDepthInfo<BIT_DEPTH_UINT32>
+{
+    typedef uint32_t Type;
+    static const bool isFloat = false;
+    static const unsigned maxValue = 4294967295u;
+};
+
 template<> struct BitDepthInfo<BIT_DEPTH_F16>
 {
     typedef half Type;
@@ -124,6 +138,19 @@ struct Converter<BIT_DEPTH_UINT12>
     }
 };
 
+template<>
+struct Converter<BIT_DEPTH_UINT14>
+{
+    typedef typename BitDepthInfo<BIT_DEPTH_UINT14>::Type Type;
+
+    static Type CastValue(float value)
+    {
+        // Compute once here instead of several times in the macro.
+        const float v = value + 0.5f;
+        return (Type)CLAMP(v, 0.0f, BitDepthInfo<BIT_DEPTH_UINT14>::maxValue);
+    }
+};
+
 template<>
 struct Converter<BIT_DEPTH_UINT16>
 {
@@ -137,6 +164,20 @@ struct Converter<BIT_DEPTH_UINT16>
     }
 };
 
+template<>
+struct Converter<BIT_DEPTH_UINT32>
+{
+    typedef typename BitDepthInfo<BIT_DEPTH_UINT32>::Type Type;
+
+    static Type CastValue(float value)
+    {
+        // The maximum value is not representable as a float (i.e. it would round
+        // to 2^32 which is out of range) so the clamping is done in double.
+        const double v = double(value) + 0.5;
+        return (Type)CLAMP(v, 0.0, (double)BitDepthInfo<BIT_DEPTH_UINT32>::maxValue);
+    }
+};
+
 template<>
 struct Converter<BIT_DEPTH_F16>
 {
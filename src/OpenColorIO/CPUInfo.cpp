@@ -0,0 +1,171 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the OpenColorIO Project.
+
+#include <OpenColorIO/OpenColorIO.h>
+
+#include "CPUInfo.h"
+
+#if defined(OCIO_USE_AVX)
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+
+OCIO_NAMESPACE_ENTER
+{
+
+namespace
+{
+
+#if defined(OCIO_USE_AVX)
+
+void GetCPUID(unsigned leaf, unsigned subLeaf, unsigned (&regs)[4])
+{
+#if defined(_MSC_VER)
+    int info[4];
+    __cpuidex(info, int(leaf), int(subLeaf));
+    for(int idx=0; idx<4; ++idx) regs[idx] = unsigned(info[idx]);
+#else
+    __cpuid_count(leaf, subLeaf, regs[0], regs[1], regs[2], regs[3]);
+#endif
+}
+
+// Get the extended registers saved by the OS.
+unsigned long long GetXCR0()
+{
+#if defined(_MSC_VER)
+    return _xgetbv(0);
+#else
+    unsigned eax = 0;
+    unsigned edx = 0;
+    __asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+    return (static_cast<unsigned long long>(edx) << 32) | eax;
+#endif
+}
+
+unsigned DetectFeatures()
+{
+    unsigned features = CPU_FEATURE_NONE;
+
+    unsigned regs[4] = { 0, 0, 0, 0 };
+    GetCPUID(0, 0, regs);
+    const unsigned maxLeaf = regs[0];
+
+    if(maxLeaf<1)
+    {
+        return features;
+    }
+
+    GetCPUID(1, 0, regs);
+    const unsigned ecx1 = regs[2];
+    const unsigned edx1 = regs[3];
+
+    if(edx1 & (1u << 26))
+    {
+        features |= CPU_FEATURE_SSE2;
+    }
+
+    // The AVX registers are only usable when the OS saves them.
+    const bool osxsave = (ecx1 & (1u << 27)) != 0;
+    const unsigned long long xcr0 = osxsave ? GetXCR0() : 0;
+
+    const bool ymmState = (xcr0 & 0x06) == 0x06;
+    const bool zmmState = (xcr0 & 0xE6) == 0xE6;
+
+    if(ymmState && (ecx1 & (1u << 28)))
+    {
+        features |= CPU_FEATURE_AVX;
+
+        if(ecx1 & (1u << 12))
+        {
+            features |= CPU_FEATURE_FMA3;
+        }
+
+        if(ecx1 & (1u << 29))
+        {
+            features |= CPU_FEATURE_F16C;
+        }
+
+        if(maxLeaf>=7)
+        {
+            GetCPUID(7, 0, regs);
+            const unsigned ebx7 = regs[1];
+
+            if(ebx7 & (1u << 5))
+            {
+                features |= CPU_FEATURE_AVX2;
+            }
+
+            if(zmmState && (ebx7 & (1u << 16)))
+            {
+                features |= CPU_FEATURE_AVX512F;
+            }
+        }
+    }
+
+    return features;
+}
+
+#else
+
+unsigned DetectFeatures()
+{
+    return CPU_FEATURE_NONE;
+}
+
+#endif
+
+}
+
+CPUInfo::CPUInfo()
+    :   m_features(DetectFeatures())
+{
+}
+
+const CPUInfo & CPUInfo::Instance()
+{
+    static const CPUInfo cpuInfo;
+    return cpuInfo;
+}
+
+}
+OCIO_NAMESPACE_EXIT
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+
+
+
+#ifdef OCIO_UNIT_TEST
+
+namespace OCIO = OCIO_NAMESPACE;
+#include "UnitTest.h"
+
+
+OCIO_ADD_TEST(CPUInfo, features)
+{
+    const OCIO::CPUInfo & cpuInfo = OCIO::CPUInfo::Instance();
+
+    // The instruction sets are cumulative.
+    if(cpuInfo.hasAVX512F())
+    {
+        OCIO_CHECK_ASSERT(cpuInfo.hasAVX2());
+    }
+    if(cpuInfo.hasAVX2() || cpuInfo.hasFMA3() || cpuInfo.hasF16C())
+    {
+        OCIO_CHECK_ASSERT(cpuInfo.hasAVX());
+    }
+
+#if defined(OCIO_USE_AVX) && (defined(__x86_64__) || defined(_M_X64))
+    // All x86 64-bit CPUs support SSE2.
+    OCIO_CHECK_ASSERT(cpuInfo.hasSSE2());
+#elif !defined(OCIO_USE_AVX)
+    OCIO_CHECK_EQUAL(cpuInfo.getFeatures(), (unsigned)OCIO::CPU_FEATURE_NONE);
+#endif
+}
+
+#endif // OCIO_UNIT_TEST
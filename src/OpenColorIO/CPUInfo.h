@@ -0,0 +1,96 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the OpenColorIO Project.
+
+
+#ifndef INCLUDED_OCIO_CPUINFO_H
+#define INCLUDED_OCIO_CPUINFO_H
+
+
+#include <OpenColorIO/OpenColorIO.h>
+
+
+// The AVX code paths are compiled on x86 whatever the compiler flags are (i.e. using
+// the target attribute), and only selected at runtime if the CPU supports them.
+#if defined(USE_SSE) && (defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86))
+#define OCIO_USE_AVX
+#endif
+
+// Note that the AVX-512 instruction set implies FMA so GCC must not contract the
+// multiplications and additions (i.e. the results would differ from the SSE ones).
+#if defined(OCIO_USE_AVX) && defined(__clang__)
+#define OCIO_TARGET_AVX2   __attribute__((target("avx2")))
+#define OCIO_TARGET_AVX512 __attribute__((target("avx512f")))
+#define OCIO_TARGET_F16C   __attribute__((target("avx,f16c")))
+#define OCIO_TARGET_AVX2_F16C __attribute__((target("avx2,f16c")))
+#elif defined(OCIO_USE_AVX) && defined(__GNUC__)
+#define OCIO_TARGET_AVX2   __attribute__((target("avx2"), optimize("fp-contract=off")))
+#define OCIO_TARGET_AVX512 __attribute__((target("avx512f"), optimize("fp-contract=off")))
+#define OCIO_TARGET_F16C   __attribute__((target("avx,f16c")))
+#define OCIO_TARGET_AVX2_F16C __attribute__((target("avx2,f16c"), optimize("fp-contract=off")))
+#else
+#define OCIO_TARGET_AVX2
+#define OCIO_TARGET_AVX512
+#define OCIO_TARGET_F16C
+#define OCIO_TARGET_AVX2_F16C
+#endif
+
+// Some GCC versions wrongly report uninitialized variables in the AVX-512 intrinsics
+// when they are used through the target attribute, so the AVX-512 code is enclosed by
+// these macros.
+#if defined(__GNUC__) && !defined(__clang__)
+#define OCIO_AVX512_DIAGNOSTIC_PUSH                                 \
+    _Pragma("GCC diagnostic push")                                  \
+    _Pragma("GCC diagnostic ignored \"-Wuninitialized\"")           \
+    _Pragma("GCC diagnostic ignored \"-Wmaybe-uninitialized\"")
+#define OCIO_AVX512_DIAGNOSTIC_POP _Pragma("GCC diagnostic pop")
+#else
+#define OCIO_AVX512_DIAGNOSTIC_PUSH
+#define OCIO_AVX512_DIAGNOSTIC_POP
+#endif
+
+
+OCIO_NAMESPACE_ENTER
+{
+
+enum CPUFeatureFlags
+{
+    CPU_FEATURE_NONE    = 0x00,
+    CPU_FEATURE_SSE2    = 0x01,
+    CPU_FEATURE_AVX     = 0x02,
+    CPU_FEATURE_AVX2    = 0x04,
+    CPU_FEATURE_FMA3    = 0x08,
+    CPU_FEATURE_AVX512F = 0x10,
+    CPU_FEATURE_F16C    = 0x20  // Half-float conversion instructions.
+};
+
+// Describe the instruction sets supported by the CPU and by the OS (i.e. the OS
+// must save the extended registers) the library is running on.
+class CPUInfo
+{
+public:
+    CPUInfo(const CPUInfo &) = delete;
+    CPUInfo & operator=(const CPUInfo &) = delete;
+
+    // Get the features of the CPU (detected on first use).
+    static const CPUInfo & Instance();
+
+    unsigned getFeatures() const noexcept { return m_features; }
+
+    bool hasSSE2() const noexcept    { return (m_features & CPU_FEATURE_SSE2) != 0; }
+    bool hasAVX() const noexcept     { return (m_features & CPU_FEATURE_AVX) != 0; }
+    bool hasAVX2() const noexcept    { return (m_features & CPU_FEATURE_AVX2) != 0; }
+    bool hasFMA3() const noexcept    { return (m_features & CPU_FEATURE_FMA3) != 0; }
+    bool hasAVX512F() const noexcept { return (m_features & CPU_FEATURE_AVX512F) != 0; }
+    bool hasF16C() const noexcept    { return (m_features & CPU_FEATURE_F16C) != 0; }
+
+private:
+    CPUInfo();
+
+    unsigned m_features = CPU_FEATURE_NONE;
+};
+
+}
+OCIO_NAMESPACE_EXIT
+
+
+#endif // INCLUDED_OCIO_CPUINFO_H
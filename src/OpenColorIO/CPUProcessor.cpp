@@ -1,17 +1,43 @@
 // SPDX-License-Identifier: BSD-3-Clause
 // Copyright Contributors to the OpenColorIO Project.
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
 #include <string.h>
+#include <typeinfo>
+#include <utility>
+
+#if defined(__GNUC__)
+#include <cxxabi.h>
+#endif
 
 #include <OpenColorIO/OpenColorIO.h>
 
 #include "BitDepthUtils.h"
+#include "CPUInfo.h"
 #include "CPUProcessor.h"
+#include "CPUSourceCode.h"
+#include "DynamicProperty.h"
+#include "FusedOpCPU.h"
+#include "HashUtils.h"
 #include "ops/Lut1D/Lut1DOpCPU.h"
 #include "ops/Lut3D/Lut3DOpCPU.h"
 #include "ops/Matrix/MatrixOps.h"
 #include "ops/Range/RangeOpCPU.h"
+#include "Processor.h"
 #include "ScanlineHelper.h"
+#include "SharedCPUOps.h"
+#include "ThreadPool.h"
+#include "Tracing.h"
+
+#if defined(OCIO_USE_AVX)
+#include <immintrin.h>
+#elif defined(__aarch64__)
+#include <arm_neon.h>
+#endif
 
 
 OCIO_NAMESPACE_ENTER
@@ -63,10 +89,315 @@ public:
             memcpy(outImg, inImg, 4*numPixels*sizeof(float));
         }
     }
+
+    bool hasPlanarApply() const override { return true; }
+
+    void applyPlanar(const float * const * inPlanes, float * const * outPlanes,
+                     long numPixels) const override
+    {
+        for(int c=0; c<4; ++c)
+        {
+            if(inPlanes[c]!=outPlanes[c])
+            {
+                memcpy(outPlanes[c], inPlanes[c], numPixels*sizeof(float));
+            }
+        }
+    }
+
+    bool hasRGBApply() const override { return true; }
+
+    void applyRGB(const float * inImg, float * outImg, long numPixels) const override
+    {
+        if(inImg!=outImg)
+        {
+            memcpy(outImg, inImg, 3*numPixels*sizeof(float));
+        }
+    }
+};
+
+// The bit-depth 'cast' also applying a Range op (i.e. its scale, offset & clamp) or a diagonal
+// Matrix op (i.e. its gain & offset) which is the first or last op, the processing then
+// saving one pass over the pixels. The op is applied after the normalization of the input
+// values, or before the scaling of the output values, so the results are unchanged.
+template<BitDepth inBD, BitDepth outBD>
+class ScaledBitDepthCast : public BitDepthCast<inBD, outBD>
+{
+    typedef typename BitDepthInfo<inBD>::Type InType;
+    typedef typename BitDepthInfo<outBD>::Type OutType;
+
+public:
+    ScaledBitDepthCast() = delete;
+    explicit ScaledBitDepthCast(const ConstOpRcPtr & op);
+    ~ScaledBitDepthCast() override {};
+
+    void apply(const void * inImg, void * outImg, long numPixels) const override
+    {
+        const InType * in = reinterpret_cast<const InType*>(inImg);
+        OutType * out = reinterpret_cast<OutType*>(outImg);
+
+        for(long pxl=0; pxl<numPixels; ++pxl)
+        {
+            for(int c=0; c<4; ++c)
+            {
+                out[c] = Converter<outBD>::CastValue(process(float(in[c]), c));
+            }
+
+            in  += 4;
+            out += 4;
+        }
+    }
+
+protected:
+    inline float applyOp(float v, int c) const
+    {
+        if(m_hasScale)
+        {
+            v = v * m_gain[c] + m_offset[c];
+        }
+
+        // The Range op only clamps the color channels, NaNs become the bound.
+        if(c<3)
+        {
+            if(m_hasLower)
+            {
+                v = std::max(m_lowerBound, v);
+            }
+            if(m_hasUpper)
+            {
+                v = std::min(m_upperBound, v);
+            }
+        }
+
+        return v;
+    }
+
+    inline float process(float v, int c) const
+    {
+        return inBD==BIT_DEPTH_F32 ? applyOp(v, c) * this->m_scale
+                                   : applyOp(v * this->m_scale, c);
+    }
+
+    float m_gain[4]   = { 1.0f, 1.0f, 1.0f, 1.0f };
+    float m_offset[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+    float m_lowerBound = 0.0f;
+    float m_upperBound = 0.0f;
+
+    bool m_hasScale = false;
+    bool m_hasLower = false;
+    bool m_hasUpper = false;
+};
+
+template<BitDepth inBD, BitDepth outBD>
+ScaledBitDepthCast<inBD, outBD>::ScaledBitDepthCast(const ConstOpRcPtr & op)
+    :   BitDepthCast<inBD, outBD>()
+{
+    if(op->data()->getType()==OpData::RangeType)
+    {
+        ConstRangeOpDataRcPtr range = DynamicPtrCast<const RangeOpData>(op->data());
+
+        m_hasScale = range->scales();
+        m_hasLower = !range->minIsEmpty();
+        m_hasUpper = !range->maxIsEmpty();
+
+        for(int c=0; c<3; ++c)
+        {
+            m_gain[c]   = (float)range->getScale();
+            m_offset[c] = (float)range->getOffset();
+        }
+
+        m_lowerBound = (float)range->getMinOutValue();
+        m_upperBound = (float)range->getMaxOutValue();
+    }
+    else
+    {
+        ConstMatrixOpDataRcPtr mat = DynamicPtrCast<const MatrixOpData>(op->data());
+        const ArrayDouble::Values & m = mat->getArray().getValues();
+        const unsigned long dim = mat->getArray().getLength();
+
+        m_hasScale = true;
+
+        for(unsigned long c=0; c<4; ++c)
+        {
+            m_gain[c]   = (float)m[c * dim + c];
+            m_offset[c] = (float)mat->getOffsets()[c];
+        }
+    }
+}
+
+namespace
+{
+
+// Convert 'numValues' half-floats to 32-bit floats (or the opposite).
+typedef void (*HalfToFloatFunc)(const half * in, float * out, long numValues);
+typedef void (*FloatToHalfFunc)(const float * in, half * out, long numValues);
+
+// The vectorized conversions round to the nearest even value exactly like the
+// half type so the results are identical (except for the NaN payloads).
+
+#if defined(OCIO_USE_AVX)
+
+OCIO_TARGET_F16C
+void HalfToFloatF16C(const half * in, float * out, long numValues)
+{
+    long idx = 0;
+    for(; idx + 8 <= numValues; idx += 8)
+    {
+        const __m128i h = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in + idx));
+        _mm256_storeu_ps(out + idx, _mm256_cvtph_ps(h));
+    }
+
+    for(; idx + 4 <= numValues; idx += 4)
+    {
+        const __m128i h = _mm_loadl_epi64(reinterpret_cast<const __m128i *>(in + idx));
+        _mm_storeu_ps(out + idx, _mm_cvtph_ps(h));
+    }
+
+    for(; idx<numValues; ++idx)
+    {
+        out[idx] = in[idx];
+    }
+}
+
+OCIO_TARGET_F16C
+void FloatToHalfF16C(const float * in, half * out, long numValues)
+{
+    long idx = 0;
+    for(; idx + 8 <= numValues; idx += 8)
+    {
+        const __m128i h = _mm256_cvtps_ph(_mm256_loadu_ps(in + idx), _MM_FROUND_TO_NEAREST_INT);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(out + idx), h);
+    }
+
+    for(; idx + 4 <= numValues; idx += 4)
+    {
+        const __m128i h = _mm_cvtps_ph(_mm_loadu_ps(in + idx), _MM_FROUND_TO_NEAREST_INT);
+        _mm_storel_epi64(reinterpret_cast<__m128i *>(out + idx), h);
+    }
+
+    for(; idx<numValues; ++idx)
+    {
+        out[idx] = half(in[idx]);
+    }
+}
+
+#elif defined(__aarch64__)
+
+// The half-float conversions are part of the ARMv8 baseline.
+
+void HalfToFloatNEON(const half * in, float * out, long numValues)
+{
+    long idx = 0;
+    for(; idx + 4 <= numValues; idx += 4)
+    {
+        const uint16x4_t h = vld1_u16(reinterpret_cast<const uint16_t *>(in + idx));
+        vst1q_f32(out + idx, vcvt_f32_f16(vreinterpret_f16_u16(h)));
+    }
+
+    for(; idx<numValues; ++idx)
+    {
+        out[idx] = in[idx];
+    }
+}
+
+void FloatToHalfNEON(const float * in, half * out, long numValues)
+{
+    long idx = 0;
+    for(; idx + 4 <= numValues; idx += 4)
+    {
+        const float16x4_t h = vcvt_f16_f32(vld1q_f32(in + idx));
+        vst1_u16(reinterpret_cast<uint16_t *>(out + idx), vreinterpret_u16_f16(h));
+    }
+
+    for(; idx<numValues; ++idx)
+    {
+        out[idx] = half(in[idx]);
+    }
+}
+
+#endif
+
+// Get the vectorized conversion supported by the CPU, if any.
+
+HalfToFloatFunc GetHalfToFloatFunc()
+{
+#if defined(OCIO_USE_AVX)
+    if(CPUInfo::Instance().hasF16C())
+    {
+        return HalfToFloatF16C;
+    }
+#elif defined(__aarch64__)
+    return HalfToFloatNEON;
+#endif
+
+    return nullptr;
+}
+
+FloatToHalfFunc GetFloatToHalfFunc()
+{
+#if defined(OCIO_USE_AVX)
+    if(CPUInfo::Instance().hasF16C())
+    {
+        return FloatToHalfF16C;
+    }
+#elif defined(__aarch64__)
+    return FloatToHalfNEON;
+#endif
+
+    return nullptr;
+}
+
+class HalfToFloatCast : public OpCPU
+{
+public:
+    HalfToFloatCast() = delete;
+    explicit HalfToFloatCast(HalfToFloatFunc convert) : OpCPU(), m_convert(convert) {}
+
+    void apply(const void * inImg, void * outImg, long numPixels) const override
+    {
+        m_convert(reinterpret_cast<const half *>(inImg),
+                  reinterpret_cast<float *>(outImg), 4 * numPixels);
+    }
+
+private:
+    const HalfToFloatFunc m_convert;
+};
+
+class FloatToHalfCast : public OpCPU
+{
+public:
+    FloatToHalfCast() = delete;
+    explicit FloatToHalfCast(FloatToHalfFunc convert) : OpCPU(), m_convert(convert) {}
+
+    void apply(const void * inImg, void * outImg, long numPixels) const override
+    {
+        m_convert(reinterpret_cast<const float *>(inImg),
+                  reinterpret_cast<half *>(outImg), 4 * numPixels);
+    }
+
+private:
+    const FloatToHalfFunc m_convert;
 };
 
+}
+
 ConstOpCPURcPtr CreateGenericBitDepthHelper(BitDepth in, BitDepth out)
 {
+    // Use the vectorized half-float conversions when the CPU supports them.
+    if(in==BIT_DEPTH_F16 && out==BIT_DEPTH_F32)
+    {
+        if(HalfToFloatFunc convert = GetHalfToFloatFunc())
+        {
+            return std::make_shared<HalfToFloatCast>(convert);
+        }
+    }
+    else if(in==BIT_DEPTH_F32 && out==BIT_DEPTH_F16)
+    {
+        if(FloatToHalfFunc convert = GetFloatToHalfFunc())
+        {
+            return std::make_shared<FloatToHalfCast>(convert);
+        }
+    }
+
 
 #define ADD_OUT_BIT_DEPTH(in, out)                    \
 case out:                                             \
@@ -83,11 +414,11 @@ case in:                                              \
         ADD_OUT_BIT_DEPTH(in, BIT_DEPTH_UINT8)        \
         ADD_OUT_BIT_DEPTH(in, BIT_DEPTH_UINT10)       \
         ADD_OUT_BIT_DEPTH(in, BIT_DEPTH_UINT12)       \
+        ADD_OUT_BIT_DEPTH(in, BIT_DEPTH_UINT14)       \
         ADD_OUT_BIT_DEPTH(in, BIT_DEPTH_UINT16)       \
+        ADD_OUT_BIT_DEPTH(in, BIT_DEPTH_UINT32)       \
         ADD_OUT_BIT_DEPTH(in, BIT_DEPTH_F16)          \
         ADD_OUT_BIT_DEPTH(in, BIT_DEPTH_F32)          \
-        case BIT_DEPTH_UINT14:                        \
-        case BIT_DEPTH_UINT32:                        \
         case BIT_DEPTH_UNKNOWN:                       \
         default:                                      \
             throw Exception("Unsupported bit-depth"); \
@@ -103,11 +434,11 @@ case in:                                              \
         ADD_IN_BIT_DEPTH(BIT_DEPTH_UINT8)
         ADD_IN_BIT_DEPTH(BIT_DEPTH_UINT10)
         ADD_IN_BIT_DEPTH(BIT_DEPTH_UINT12)
+        ADD_IN_BIT_DEPTH(BIT_DEPTH_UINT14)
         ADD_IN_BIT_DEPTH(BIT_DEPTH_UINT16)
+        ADD_IN_BIT_DEPTH(BIT_DEPTH_UINT32)
         ADD_IN_BIT_DEPTH(BIT_DEPTH_F16)
         ADD_IN_BIT_DEPTH(BIT_DEPTH_F32)
-        case BIT_DEPTH_UINT14:
-        case BIT_DEPTH_UINT32:
         case BIT_DEPTH_UNKNOWN:
         default:
             throw Exception("Unsupported bit-depth");
@@ -119,6 +450,73 @@ case in:                                              \
     throw Exception("Unsupported bit-depths");
 }
 
+namespace
+{
+
+// The 1D LUT renderers do not process the 14-bit and 32-bit integer bit-depths.
+bool IsLut1DRendererBitDepth(BitDepth bitDepth)
+{
+    return bitDepth!=BIT_DEPTH_UINT14 && bitDepth!=BIT_DEPTH_UINT32;
+}
+
+// Could the integer bit-depth 'cast' also apply the op (refer to ScaledBitDepthCast)?
+// The half-float conversions are left to their vectorized versions.
+bool IsScaledCastOp(const ConstOpRcPtr & op, BitDepth bitDepth)
+{
+    if(IsFloatBitDepth(bitDepth) || op->isDynamic())
+    {
+        return false;
+    }
+
+    if(op->data()->getType()==OpData::RangeType)
+    {
+        return true;
+    }
+
+    if(op->data()->getType()==OpData::MatrixType)
+    {
+        ConstMatrixOpDataRcPtr mat = DynamicPtrCast<const MatrixOpData>(op->data());
+        return mat->isDiagonal();
+    }
+
+    return false;
+}
+
+ConstOpCPURcPtr CreateScaledBitDepthHelper(BitDepth in, BitDepth out, const ConstOpRcPtr & op)
+{
+
+#define ADD_BIT_DEPTH(bitDepth)                                                       \
+case bitDepth:                                                                        \
+{                                                                                     \
+    if(in==BIT_DEPTH_F32)                                                             \
+    {                                                                                 \
+        return std::make_shared<ScaledBitDepthCast<BIT_DEPTH_F32, bitDepth>>(op);     \
+    }                                                                                 \
+    return std::make_shared<ScaledBitDepthCast<bitDepth, BIT_DEPTH_F32>>(op);         \
+}
+
+    switch(in==BIT_DEPTH_F32 ? out : in)
+    {
+        ADD_BIT_DEPTH(BIT_DEPTH_UINT8)
+        ADD_BIT_DEPTH(BIT_DEPTH_UINT10)
+        ADD_BIT_DEPTH(BIT_DEPTH_UINT12)
+        ADD_BIT_DEPTH(BIT_DEPTH_UINT14)
+        ADD_BIT_DEPTH(BIT_DEPTH_UINT16)
+        ADD_BIT_DEPTH(BIT_DEPTH_UINT32)
+        case BIT_DEPTH_F16:
+        case BIT_DEPTH_F32:
+        case BIT_DEPTH_UNKNOWN:
+        default:
+            break;
+    }
+
+#undef ADD_BIT_DEPTH
+
+    throw Exception("Unsupported bit-depths");
+}
+
+}
+
 void CreateCPUEngine(const OpRcPtrVec & ops, 
                      BitDepth in, 
                      BitDepth out,
@@ -127,63 +525,142 @@ void CreateCPUEngine(const OpRcPtrVec & ops,
                      // The remaining CPU Ops.
                      ConstOpCPURcPtrVec & cpuOps,
                      // The bit-depth 'cast' or the last CPU Op.
-                     ConstOpCPURcPtr & outBitDepthOp)
+                     ConstOpCPURcPtr & outBitDepthOp,
+                     // Only use bit-depth 'casts' i.e. all the ops process F32 pixels.
+                     bool castBitDepths)
 {
     const size_t maxOps = ops.size();
-    for(size_t idx=0; idx<maxOps; ++idx)
+
+    // The ops in [first, last[ process F32 pixels.
+    size_t first = 0;
+    size_t last  = maxOps;
+
+    // A 1D LUT could directly process the input or output bit-depth.
+
+    ConstOpRcPtr firstOp = maxOps>0 ? ops[0] : ConstOpRcPtr();
+    ConstOpRcPtr lastOp  = maxOps>0 ? ops[maxOps-1] : ConstOpRcPtr();
+
+    ConstLut3DOpDataRcPtr firstLut3D;
+    if(!castBitDepths && firstOp && firstOp->data()->getType()==OpData::Lut3DType)
     {
-        ConstOpRcPtr op = ops[idx];
-        ConstOpDataRcPtr opData = op->data();
+        firstLut3D = DynamicPtrCast<const Lut3DOpData>(firstOp->data());
+    }
 
-        if(idx==0)
-        {
-            if(opData->getType()==OpData::Lut1DType)
-            {
-                ConstLut1DOpDataRcPtr lut = DynamicPtrCast<const Lut1DOpData>(opData);
-                inBitDepthOp = GetLut1DRenderer(lut, in, BIT_DEPTH_F32);
-            }
-            else if(in==BIT_DEPTH_F32)
-            {
-                inBitDepthOp = op->getCPUOp();
-            }
-            else
-            {
-                inBitDepthOp = CreateGenericBitDepthHelper(in, BIT_DEPTH_F32);
-                cpuOps.push_back(op->getCPUOp());
-            }
+    // A shaper 1D LUT followed by a 3D LUT (i.e. a baked LUT) could directly process the input
+    // bit-depth in one pass.
+    ConstLut3DOpDataRcPtr shapedLut3D;
+    ConstOpRcPtr secondOp = maxOps>1 ? ops[1] : ConstOpRcPtr();
+    if(!castBitDepths && secondOp && firstOp->data()->getType()==OpData::Lut1DType
+        && secondOp->data()->getType()==OpData::Lut3DType)
+    {
+        shapedLut3D = DynamicPtrCast<const Lut3DOpData>(secondOp->data());
+    }
 
-            if(maxOps==1)
-            {
-                outBitDepthOp = CreateGenericBitDepthHelper(BIT_DEPTH_F32, out);
-            }
+    if(shapedLut3D && IsLut3DRendererBitDepth(shapedLut3D, in))
+    {
+        ConstLut1DOpDataRcPtr shaper = DynamicPtrCast<const Lut1DOpData>(firstOp->data());
+        inBitDepthOp = GetShaperLut3DRenderer(shaper, shapedLut3D, in);
+        first = 2;
+    }
+    else if(!castBitDepths && firstOp && firstOp->data()->getType()==OpData::Lut1DType
+        && IsLut1DRendererBitDepth(in)
+        // The float input pixels are processed by the fused shaper and 3D LUT CPU Op.
+        && !(shapedLut3D && IsFloatBitDepth(in)))
+    {
+        ConstLut1DOpDataRcPtr lut = DynamicPtrCast<const Lut1DOpData>(firstOp->data());
+        inBitDepthOp = GetSharedCPUOp(firstOp, in, BIT_DEPTH_F32,
+                                      [&lut, in]()
+                                      {
+                                          return GetLut1DRenderer(lut, in, BIT_DEPTH_F32);
+                                      });
+        first = 1;
+    }
+    else if(firstLut3D && IsLut3DRendererBitDepth(firstLut3D, in))
+    {
+        // The 3D LUT directly looks up the cells of the integer input codes.
+        inBitDepthOp = GetSharedCPUOp(firstOp, in, BIT_DEPTH_F32,
+                                      [&firstLut3D, in]()
+                                      {
+                                          return GetLut3DRenderer(firstLut3D, in);
+                                      });
+        first = 1;
+    }
+    else if(!castBitDepths && firstOp && IsScaledCastOp(firstOp, in))
+    {
+        // The input 'cast' also applies the leading Range or gain.
+        inBitDepthOp = CreateScaledBitDepthHelper(in, BIT_DEPTH_F32, firstOp);
+        first = 1;
+    }
+    else if(castBitDepths || in!=BIT_DEPTH_F32)
+    {
+        inBitDepthOp = CreateGenericBitDepthHelper(in, BIT_DEPTH_F32);
+    }
+
+    if(!castBitDepths && last>first && lastOp->data()->getType()==OpData::Lut1DType
+        && IsLut1DRendererBitDepth(out))
+    {
+        ConstLut1DOpDataRcPtr lut = DynamicPtrCast<const Lut1DOpData>(lastOp->data());
+        outBitDepthOp = GetSharedCPUOp(lastOp, BIT_DEPTH_F32, out,
+                                       [&lut, out]()
+                                       {
+                                           return GetLut1DRenderer(lut, BIT_DEPTH_F32, out);
+                                       });
+        --last;
+    }
+    else if(!castBitDepths && last>first && IsScaledCastOp(lastOp, out))
+    {
+        // The output 'cast' also applies the trailing Range (e.g. a clamp) or gain.
+        outBitDepthOp = CreateScaledBitDepthHelper(BIT_DEPTH_F32, out, lastOp);
+        --last;
+    }
+    else if(castBitDepths || out!=BIT_DEPTH_F32)
+    {
+        outBitDepthOp = CreateGenericBitDepthHelper(BIT_DEPTH_F32, out);
+    }
+
+    // Fuse the runs of short ops (e.g. Range -> Matrix) in single CPU ops.
+
+    ConstOpCPURcPtrVec f32Ops;
+    CreateFusedCPUOps(ops, first, last, f32Ops);
+
+    auto begin = f32Ops.begin();
+    auto end   = f32Ops.end();
+
+    if(!inBitDepthOp)
+    {
+        if(begin!=end)
+        {
+            // The first CPU Op directly processes the F32 input.
+            inBitDepthOp = *begin;
+            ++begin;
+        }
+        else
+        {
+            inBitDepthOp = CreateGenericBitDepthHelper(in, BIT_DEPTH_F32);
         }
-        else if(idx==(maxOps-1))
+    }
+
+    if(!outBitDepthOp)
+    {
+        if(begin!=end)
         {
-            if(opData->getType()==OpData::Lut1DType)
-            {
-                ConstLut1DOpDataRcPtr lut = DynamicPtrCast<const Lut1DOpData>(opData);
-                outBitDepthOp = GetLut1DRenderer(lut, BIT_DEPTH_F32, out);
-            }
-            else if(out==BIT_DEPTH_F32)
-            {
-                outBitDepthOp = op->getCPUOp();
-            }
-            else
-            {
-                outBitDepthOp = CreateGenericBitDepthHelper(BIT_DEPTH_F32, out);
-                cpuOps.push_back(op->getCPUOp());
-            }
+            // The last CPU Op directly produces the F32 output.
+            --end;
+            outBitDepthOp = *end;
         }
         else
         {
-            cpuOps.push_back(op->getCPUOp());
+            outBitDepthOp = CreateGenericBitDepthHelper(BIT_DEPTH_F32, out);
         }
     }
+
+    cpuOps.insert(cpuOps.end(), begin, end);
 }
 
 
 ScanlineHelper * CreateScanlineHelper(BitDepth in, const ConstOpCPURcPtr & inBitDepthOp,
-                                      BitDepth out, const ConstOpCPURcPtr & outBitDepthOp)
+                                      BitDepth out, const ConstOpCPURcPtr & outBitDepthOp,
+                                      bool touchesAlpha, bool repeatedPixels)
 {
 
 #define ADD_OUT_BIT_DEPTH(in, out)                    \
@@ -191,7 +668,9 @@ case out:                                             \
 {                                                     \
     return new GenericScanlineHelper<BitDepthInfo<in>::Type,                      \
                                      BitDepthInfo<out>::Type>(in, inBitDepthOp,   \
-                                                              out, outBitDepthOp);\
+                                                              out, outBitDepthOp, \
+                                                              touchesAlpha,       \
+                                                              repeatedPixels);    \
     break;                                            \
 }
 
@@ -203,11 +682,11 @@ case in:                                              \
         ADD_OUT_BIT_DEPTH(in, BIT_DEPTH_UINT8)        \
         ADD_OUT_BIT_DEPTH(in, BIT_DEPTH_UINT10)       \
         ADD_OUT_BIT_DEPTH(in, BIT_DEPTH_UINT12)       \
+        ADD_OUT_BIT_DEPTH(in, BIT_DEPTH_UINT14)       \
         ADD_OUT_BIT_DEPTH(in, BIT_DEPTH_UINT16)       \
+        ADD_OUT_BIT_DEPTH(in, BIT_DEPTH_UINT32)       \
         ADD_OUT_BIT_DEPTH(in, BIT_DEPTH_F16)          \
         ADD_OUT_BIT_DEPTH(in, BIT_DEPTH_F32)          \
-        case BIT_DEPTH_UINT14:                        \
-        case BIT_DEPTH_UINT32:                        \
         case BIT_DEPTH_UNKNOWN:                       \
         default:                                      \
             throw Exception("Unsupported bit-depth"); \
@@ -221,11 +700,11 @@ case in:                                              \
         ADD_IN_BIT_DEPTH(BIT_DEPTH_UINT8)
         ADD_IN_BIT_DEPTH(BIT_DEPTH_UINT10)
         ADD_IN_BIT_DEPTH(BIT_DEPTH_UINT12)
+        ADD_IN_BIT_DEPTH(BIT_DEPTH_UINT14)
         ADD_IN_BIT_DEPTH(BIT_DEPTH_UINT16)
+        ADD_IN_BIT_DEPTH(BIT_DEPTH_UINT32)
         ADD_IN_BIT_DEPTH(BIT_DEPTH_F16)
         ADD_IN_BIT_DEPTH(BIT_DEPTH_F32)
-        case BIT_DEPTH_UINT14:
-        case BIT_DEPTH_UINT32:
         case BIT_DEPTH_UNKNOWN:
         default:
             throw Exception("Unsupported bit-depth");
@@ -237,10 +716,137 @@ case in:                                              \
     throw Exception("Unsupported bit-depths");
 }
 
-DynamicPropertyRcPtr CPUProcessor::Impl::getDynamicProperty(DynamicPropertyType type) const
+// Accumulate the time spent by each renderer (i.e. aligned with the renderers of the
+// processor metadata) and the number of pixels it processed, from any thread.
+class CPUProfiler
 {
-    if(m_inBitDepthOp->hasDynamicProperty(type))
-    {
+public:
+    CPUProfiler() = delete;
+    CPUProfiler(const CPUProfiler &) = delete;
+    CPUProfiler & operator=(const CPUProfiler &) = delete;
+
+    explicit CPUProfiler(size_t numRenderers)
+        :   m_nanoseconds(numRenderers)
+        ,   m_numPixels(numRenderers)
+    {
+        reset();
+    }
+
+    bool isEnabled() const noexcept { return m_enabled.load(std::memory_order_relaxed); }
+    void setEnabled(bool enabled) noexcept { m_enabled.store(enabled, std::memory_order_relaxed); }
+
+    void add(size_t renderer, long numPixels,
+             const std::chrono::steady_clock::duration & elapsed) noexcept
+    {
+        const long long ns
+            = std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();
+        m_nanoseconds[renderer].fetch_add(ns, std::memory_order_relaxed);
+        m_numPixels[renderer].fetch_add(numPixels, std::memory_order_relaxed);
+    }
+
+    void get(double * times, long long * numPixels) const
+    {
+        for(size_t i = 0; i<m_nanoseconds.size(); ++i)
+        {
+            if(times)
+            {
+                times[i] = double(m_nanoseconds[i].load(std::memory_order_relaxed)) * 1e-6;
+            }
+            if(numPixels)
+            {
+                numPixels[i] = m_numPixels[i].load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    void reset() noexcept
+    {
+        for(size_t i = 0; i<m_nanoseconds.size(); ++i)
+        {
+            m_nanoseconds[i].store(0, std::memory_order_relaxed);
+            m_numPixels[i].store(0, std::memory_order_relaxed);
+        }
+    }
+
+private:
+    std::atomic<bool> m_enabled{ false };
+    std::vector<std::atomic<long long>> m_nanoseconds;
+    std::vector<std::atomic<long long>> m_numPixels;
+};
+
+namespace
+{
+
+// The timer of the renderers when the processing is not instrumented i.e. it compiles
+// to nothing.
+struct NoRendererTimer
+{
+    void start() const noexcept {}
+    void stop(size_t, long) const noexcept {}
+};
+
+// The timer of the renderers when profiling, where the renderer index is aligned with the
+// renderers of the processor metadata.
+class RendererTimer
+{
+public:
+    explicit RendererTimer(CPUProfiler & profiler) : m_profiler(profiler) {}
+
+    void start() noexcept { m_start = std::chrono::steady_clock::now(); }
+    void stop(size_t renderer, long numPixels) noexcept
+    {
+        m_profiler.add(renderer, numPixels, std::chrono::steady_clock::now() - m_start);
+    }
+
+private:
+    CPUProfiler & m_profiler;
+    std::chrono::steady_clock::time_point m_start;
+};
+
+}
+
+CPUProcessor::Impl::~Impl()
+{
+}
+
+namespace
+{
+
+// The maximum number of ScanlineHelper instances kept by a CPU processor.
+constexpr size_t MAX_POOLED_SCANLINE_HELPERS = 64;
+
+}
+
+std::unique_ptr<ScanlineHelper> CPUProcessor::Impl::acquireScanlineHelper() const
+{
+    {
+        std::lock_guard<std::mutex> lock(m_scanlineHelpersMutex);
+        if(!m_scanlineHelpers.empty())
+        {
+            std::unique_ptr<ScanlineHelper> helper = std::move(m_scanlineHelpers.back());
+            m_scanlineHelpers.pop_back();
+            return helper;
+        }
+    }
+
+    return std::unique_ptr<ScanlineHelper>(
+        CreateScanlineHelper(m_inBitDepth, m_inBitDepthOp, m_outBitDepth, m_outBitDepthOp,
+                             m_touchesAlpha, m_repeatedPixels));
+}
+
+void CPUProcessor::Impl::releaseScanlineHelper(std::unique_ptr<ScanlineHelper> && helper) const
+{
+    std::lock_guard<std::mutex> lock(m_scanlineHelpersMutex);
+    if(m_scanlineHelpers.size()<MAX_POOLED_SCANLINE_HELPERS)
+    {
+        m_scanlineHelpers.push_back(std::move(helper));
+    }
+}
+
+DynamicPropertyRcPtr CPUProcessor::Impl::getDynamicProperty(DynamicPropertyType type) const
+{
+    if(m_inBitDepthOp->hasDynamicProperty(type))
+    {
         return m_inBitDepthOp->getDynamicProperty(type);
     }
 
@@ -260,20 +866,148 @@ DynamicPropertyRcPtr CPUProcessor::Impl::getDynamicProperty(DynamicPropertyType
     throw Exception("Cannot find dynamic property; not used by CPU processor.");
 }
 
+namespace
+{
+
+bool HasDynamicOps(const OpRcPtrVec & ops)
+{
+    for(const auto & op : ops)
+    {
+        if(op->isDynamic())
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+}
+
+std::string GetRendererName(const OpCPU & op)
+{
+    std::string name(typeid(op).name());
+
+#if defined(__GNUC__)
+    int status = 0;
+    char * demangled = abi::__cxa_demangle(name.c_str(), nullptr, nullptr, &status);
+    if(demangled)
+    {
+        if(status==0)
+        {
+            name = demangled;
+        }
+        free(demangled);
+    }
+#endif
+
+    // Only keep the template arguments, if any.
+    const size_t templatePos = name.find('<');
+    const size_t scopePos
+        = name.rfind("::", templatePos==std::string::npos ? std::string::npos : templatePos);
+    if(scopePos!=std::string::npos)
+    {
+        name = name.substr(scopePos + 2);
+    }
+    else if(name.compare(0, 6, "class ")==0)
+    {
+        name = name.substr(6);
+    }
+
+    return name;
+}
+
+namespace
+{
+
+double GetElapsedTime(const std::chrono::steady_clock::time_point & start)
+{
+    const std::chrono::duration<double, std::milli> elapsed
+        = std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+
+bool HasPlanarOps(const ConstOpCPURcPtr & inBitDepthOp, const ConstOpCPURcPtrVec & cpuOps,
+                  const ConstOpCPURcPtr & outBitDepthOp)
+{
+    if(!inBitDepthOp->hasPlanarApply() || !outBitDepthOp->hasPlanarApply())
+    {
+        return false;
+    }
+
+    for(const auto & cpuOp : cpuOps)
+    {
+        if(!cpuOp->hasPlanarApply())
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool HasRGBOps(const ConstOpCPURcPtr & inBitDepthOp, const ConstOpCPURcPtrVec & cpuOps,
+               const ConstOpCPURcPtr & outBitDepthOp)
+{
+    if(!inBitDepthOp->hasRGBApply() || !outBitDepthOp->hasRGBApply())
+    {
+        return false;
+    }
+
+    for(const auto & cpuOp : cpuOps)
+    {
+        if(!cpuOp->hasRGBApply())
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+}
+
 void CPUProcessor::Impl::finalize(const OpRcPtrVec & rawOps,
                                   BitDepth in, BitDepth out,
-                                  OptimizationFlags oFlags, FinalizationFlags fFlags)
+                                  OptimizationFlags oFlags, FinalizationFlags fFlags,
+                                  bool renderOnly,
+                                  LutInterpolationQuality interpQuality)
 {
+    TracingSpan span("processor", "CPUProcessor::finalize");
+
     AutoMutex lock(m_mutex);
 
-    OpRcPtrVec ops = rawOps;
+    // The format metadata of the processor is not needed.
+    OpRcPtrVec ops;
+    ops.assignOps(rawOps);
+
+    ProcessorMetadataRcPtr metadata = ProcessorMetadata::Create();
+    for(const auto & op : ops)
+    {
+        op->dumpMetadata(metadata);
+        metadata->addOriginalOp(op->getInfo().c_str());
+    }
+
+    auto start = std::chrono::steady_clock::now();
 
     if(!ops.empty())
     {
         // Optimize the ops.
-        OptimizeOpVec(ops, in, oFlags);
+        StringVec passes;
+        OptimizeOpVec(ops, in, oFlags, &passes);
+        CheckCancellation();
+
+        for(const auto & pass : passes)
+        {
+            metadata->addOptimizationPass(pass.c_str());
+        }
     }
 
+    metadata->setOptimizationTime(GetElapsedTime(start));
+
+    // The identity ops below are only used by the paths which could not be bypassed.
+    const bool isNoOp = ops.empty();
+
     if(ops.empty())
     {
         // Support an empty list.
@@ -296,8 +1030,14 @@ void CPUProcessor::Impl::finalize(const OpRcPtrVec & rawOps,
 
     // Finalize the ops.
 
+    start = std::chrono::steady_clock::now();
+
+    // After the optimizations as they could create new LUTs (e.g. compositions).
+    ApplyLutInterpolationQuality(ops, interpQuality);
+
     FinalizeOpVec(ops, fFlags);
     UnifyDynamicProperties(ops);
+    CheckCancellation();
 
     m_inBitDepth  = in;
     m_outBitDepth = out;
@@ -314,2380 +1054,8499 @@ void CPUProcessor::Impl::finalize(const OpRcPtrVec & rawOps,
         }
     }
 
-    // Get the CPU Ops while taking care of the input and output bit-depths.
+    // Does the color processing change the alpha channel? Note that the alpha values
+    // are only copied if the bit-depths are the same (i.e. no scaling).
 
-    m_cpuOps.clear();
-    m_inBitDepthOp = nullptr;
-    m_outBitDepthOp = nullptr;
-    CreateCPUEngine(ops, in, out, m_inBitDepthOp, m_cpuOps, m_outBitDepthOp);
+    m_touchesAlpha = in!=out;
+    for(const auto & op : ops)
+    {
+        if(op->touchesAlpha())
+        {
+            m_touchesAlpha = true;
+            break;
+        }
+    }
 
-    // Compute the cache id.
+    // Without channel crosstalk, each output channel only depends on the input code
+    // of the same channel so the whole processing could be a per-channel table lookup.
+    // Note that the dynamic properties could change the processing after finalization.
+
+    const bool useIntegerLookup
+        = (oFlags & OPTIMIZATION_LOOKUP_INTEGER_INPUT) == OPTIMIZATION_LOOKUP_INTEGER_INPUT
+            && !m_hasChannelCrosstalk && IsIntegerLookupBitDepth(in) && !HasDynamicOps(ops);
 
-    std::stringstream ss;
-    ss << "CPU Processor: from " << BitDepthToString(in)
-       << " to "  << BitDepthToString(out)
-       << " oFlags " << oFlags
-       << " fFlags " << fFlags
-       << " ops :";
-    for(const auto & op : ops)
     {
-        ss << " " << op->getCacheID();
+        // The replicas use the previous ops.
+        std::lock_guard<std::mutex> lock(m_numaReplicasMutex);
+        m_numaReplicas.clear();
     }
 
-    m_cacheID = ss.str();
-}
+    // The integer lookup is faster than any detection of the repeated pixels.
+    m_repeatedPixels
+        = (oFlags & OPTIMIZATION_REPEATED_PIXELS) == OPTIMIZATION_REPEATED_PIXELS
+            && !useIntegerLookup;
+    m_repeatedPixelsStats = std::make_shared<RepeatedPixelsStats>();
 
-void CPUProcessor::Impl::apply(ImageDesc & imgDesc) const
-{   
-    // Get the ScanlineHelper for this thread (no significant performance impact).
-    std::unique_ptr<ScanlineHelper> 
-        scanlineBuilder(CreateScanlineHelper(m_inBitDepth, m_inBitDepthOp,
-                                             m_outBitDepth, m_outBitDepthOp));
+    m_isNoOp = isNoOp;
 
-    // Prepare the processing.
-    scanlineBuilder->init(imgDesc);
+    m_ops = std::move(ops);
+    createEngine(useIntegerLookup);
 
-    float * rgbaBuffer = nullptr;
-    long numPixels = 0;
+    metadata->setFinalizationTime(GetElapsedTime(start));
 
-    while(true)
+    for(const auto & op : m_ops)
     {
-        scanlineBuilder->prepRGBAScanline(&rgbaBuffer, numPixels);
-        if(numPixels == 0) break;
-
-        const size_t numOps = m_cpuOps.size();
-        for(size_t i = 0; i<numOps; ++i)
-        {
-            m_cpuOps[i]->apply(rgbaBuffer, rgbaBuffer, numPixels);
-        }
+        metadata->addOptimizedOp(op->getInfo().c_str());
+    }
 
-        scanlineBuilder->finishRGBAScanline();
+    if(m_integerLookup)
+    {
+        // The CPU Ops are then only used to build the lookup tables.
+        metadata->addRenderer("IntegerLookup");
     }
-}
+    metadata->addRenderer(GetRendererName(*m_inBitDepthOp).c_str());
+    for(const auto & cpuOp : m_cpuOps)
+    {
+        metadata->addRenderer(GetRendererName(*cpuOp).c_str());
+    }
+    metadata->addRenderer(GetRendererName(*m_outBitDepthOp).c_str());
 
-void CPUProcessor::Impl::apply(const ImageDesc & srcImgDesc, ImageDesc & dstImgDesc) const
-{
-    // Get the ScanlineHelper for this thread (no significant performance impact).
-    std::unique_ptr<ScanlineHelper> 
-        scanlineBuilder(CreateScanlineHelper(m_inBitDepth, m_inBitDepthOp,
-                                             m_outBitDepth, m_outBitDepthOp));
+    m_metadata = metadata;
 
-    // Prepare the processing.
-    scanlineBuilder->init(srcImgDesc, dstImgDesc);
+    m_profiler = std::make_shared<CPUProfiler>(metadata->getNumRenderers());
 
-    float * rgbaBuffer = nullptr;
-    long numPixels = 0;
+    // Compute the cache id i.e. the op cache ids are hashed without building
+    // the string of the full op chain.
 
-    while(true)
+    CacheIDHasher hasher;
+    for(const auto & op : m_ops)
     {
-        scanlineBuilder->prepRGBAScanline(&rgbaBuffer, numPixels);
-        if(numPixels == 0) break;
+        hasher.update(op->getCacheID());
+        hasher.update(" ", 1);
+    }
 
-        const size_t numOps = m_cpuOps.size();
-        for(size_t i = 0; i<numOps; ++i)
+    m_cacheID = std::string("CPU Processor: from ") + BitDepthToString(in)
+              + " to " + BitDepthToString(out)
+              + " oFlags " + std::to_string(oFlags)
+              + " fFlags " + std::to_string(fFlags)
+              + " ops " + hasher.digest();
+
+    m_renderOnly = renderOnly;
+    if(m_renderOnly)
+    {
+        // The engine of the premultiplied or dithered image buffers needs the finalized
+        // ops. Note that most of its CPU Ops are the shared ones of the processor.
+        getCastEngine();
+
+        // The CPU Ops hold their own tables (and the dynamic properties) so the finalized
+        // ops, and the LUT arrays only they still reference, could now be released.
+        m_ops = OpRcPtrVec();
+
+        ProcessorMetadataRcPtr renderMetadata = ProcessorMetadata::Create();
+        for(int idx = 0; idx < metadata->getNumFiles(); ++idx)
+        {
+            renderMetadata->addFile(metadata->getFile(idx));
+        }
+        for(int idx = 0; idx < metadata->getNumLooks(); ++idx)
         {
-            m_cpuOps[i]->apply(rgbaBuffer, rgbaBuffer, numPixels);
+            renderMetadata->addLook(metadata->getLook(idx));
         }
+        for(int idx = 0; idx < metadata->getNumRenderers(); ++idx)
+        {
+            renderMetadata->addRenderer(metadata->getRenderer(idx));
+        }
+        renderMetadata->setOptimizationTime(metadata->getOptimizationTime());
+        renderMetadata->setFinalizationTime(metadata->getFinalizationTime());
 
-        scanlineBuilder->finishRGBAScanline();
+        m_metadata = renderMetadata;
     }
 }
 
-void CPUProcessor::Impl::applyRGB(float * pixel) const
+void CPUProcessor::Impl::createEngine(bool useIntegerLookup)
 {
-    float v[4]{pixel[0], pixel[1], pixel[2], 0.0f};
+    TracingSpan span("processor", "CreateCPUEngine");
 
-    m_inBitDepthOp->apply(v, v, 1);
+    // Get the CPU Ops while taking care of the input and output bit-depths.
+
+    m_cpuOps.clear();
+    m_inBitDepthOp = nullptr;
+    m_outBitDepthOp = nullptr;
 
-    const size_t numOps = m_cpuOps.size();
-    for(size_t i = 0; i<numOps; ++i)
     {
-        m_cpuOps[i]->apply(pixel, pixel, 1);
+        // The pooled helpers use the previous bit-depth ops.
+        std::lock_guard<std::mutex> lock(m_scanlineHelpersMutex);
+        m_scanlineHelpers.clear();
     }
+    // The runs of repeated pixels are detected on the input pixels, so no op could
+    // directly process the input bit-depth.
+    CreateCPUEngine(m_ops, m_inBitDepth, m_outBitDepth, m_inBitDepthOp, m_cpuOps, m_outBitDepthOp,
+                    m_repeatedPixels);
 
-    m_outBitDepthOp->apply(v, v, 1);
+    // A single pass converts the bit-depth (e.g. the vectorized half-float conversions).
+    m_bypassOp = m_isNoOp && m_inBitDepth!=m_outBitDepth
+                    ? CreateGenericBitDepthHelper(m_inBitDepth, m_outBitDepth)
+                    : ConstOpCPURcPtr();
 
-    pixel[0] = v[0];
-    pixel[1] = v[1];
-    pixel[2] = v[2];
+    {
+        std::lock_guard<std::mutex> lock(m_castEngineMutex);
+        m_castEngine = nullptr;
+    }
+
+    // Could the 32-bit float planar image buffers be processed without packing the pixels?
+
+    m_hasPlanarOps = m_inBitDepth==BIT_DEPTH_F32 && m_outBitDepth==BIT_DEPTH_F32
+                        && !m_repeatedPixels
+                        && HasPlanarOps(m_inBitDepthOp, m_cpuOps, m_outBitDepthOp);
+
+    // Could the 32-bit float packed RGB image buffers be processed without packing the
+    // pixels in RGBA? A missing alpha is processed as zero so it must stay unused.
+
+    m_hasRGBOps = m_inBitDepth==BIT_DEPTH_F32 && m_outBitDepth==BIT_DEPTH_F32 && !m_touchesAlpha
+                    && !m_repeatedPixels
+                    && HasRGBOps(m_inBitDepthOp, m_cpuOps, m_outBitDepthOp);
+
+    m_integerLookup = nullptr;
+
+    if(useIntegerLookup)
+    {
+        m_integerLookup
+            = CreateIntegerLookup(m_inBitDepth, m_outBitDepth,
+                                  [this](const ImageDesc & srcImg, ImageDesc & dstImg)
+                                  {
+                                      // Building the tables is not profiled.
+                                      NoRendererTimer timer;
+                                      applyBand(srcImg, dstImg, 0, dstImg.getROIHeight(),
+                                                timer);
+                                  });
+    }
 }
 
-void CPUProcessor::Impl::applyRGBA(float * pixel) const
+CPUProcessor::Impl::ConstCastEngineRcPtr
+    CPUProcessor::Impl::getCastEngine() const
 {
-    m_inBitDepthOp->apply(pixel, pixel, 1);
+    std::lock_guard<std::mutex> lock(m_castEngineMutex);
 
-    const size_t numOps = m_cpuOps.size();
-    for(size_t i = 0; i<numOps; ++i)
+    if(!m_castEngine)
     {
-        m_cpuOps[i]->apply(pixel, pixel, 1);
+        // Unlike the regular engine, no op could process the input or output bit-depth
+        // as the color values must be (un)premultiplied or dithered in 32-bit float.
+
+        std::shared_ptr<CastEngine> engine = std::make_shared<CastEngine>();
+        CreateCPUEngine(m_ops, m_inBitDepth, m_outBitDepth,
+                        engine->m_inBitDepthOp, engine->m_cpuOps, engine->m_outBitDepthOp,
+                        true);
+
+        m_castEngine = engine;
     }
 
-    m_outBitDepthOp->apply(pixel, pixel, 1);
+    return m_castEngine;
 }
 
+const CPUProcessor::Impl & CPUProcessor::Impl::getNumaReplica() const
+{
+    // The replicas are created from the finalized ops.
+    if(m_renderOnly || !IsCPUNumaAware())
+    {
+        return *this;
+    }
 
+    const unsigned numNodes = GetNumNumaNodes();
+    const int node = GetCurrentNumaNode();
+    if(numNodes<=1 || node<0)
+    {
+        return *this;
+    }
 
+    std::lock_guard<std::mutex> lock(m_numaReplicasMutex);
 
-//////////////////////////////////////////////////////////////////////////
+    if(m_numaReplicas.size()!=numNodes)
+    {
+        m_numaReplicas.clear();
+        m_numaReplicas.resize(numNodes);
+    }
 
+    std::unique_ptr<Impl> & replica = m_numaReplicas[node];
+    if(!replica)
+    {
+        // As the replica is created by a thread of the node, its tables (e.g. the 3D LUT
+        // of a renderer) are allocated in the node memory (i.e. first-touch policy).
+        // Note that the replica shares the dynamic properties held by the ops.
+
+        replica.reset(new Impl);
+
+        replica->m_ops                 = m_ops;
+        replica->m_inBitDepth          = m_inBitDepth;
+        replica->m_outBitDepth         = m_outBitDepth;
+        replica->m_hasChannelCrosstalk = m_hasChannelCrosstalk;
+        replica->m_touchesAlpha        = m_touchesAlpha;
+        replica->m_isNoOp              = m_isNoOp;
+        replica->m_repeatedPixels      = m_repeatedPixels;
+        replica->m_repeatedPixelsStats = m_repeatedPixelsStats;
+        replica->m_cacheID             = m_cacheID;
+        replica->m_profiler            = m_profiler;
+
+        replica->createEngine(m_integerLookup!=nullptr);
+    }
 
+    return *replica;
+}
 
+namespace
+{
 
-void CPUProcessor::deleter(CPUProcessor * c)
+// Process all the lines selected by the scanline helper. Note that the unpacking &
+// packing of the pixels are timed with the input & output bit-depth renderers.
+template<typename Timer>
+void ProcessScanlines(ScanlineHelper & scanlineBuilder, const ConstOpCPURcPtrVec & cpuOps,
+                      Timer & timer)
 {
-    delete c;
+    float * rgbaBuffer = nullptr;
+    long numPixels = 0;
+
+    const size_t numOps = cpuOps.size();
+
+    while(true)
+    {
+        timer.start();
+        scanlineBuilder.prepRGBAScanline(&rgbaBuffer, numPixels);
+        if(numPixels == 0) break;
+        timer.stop(0, numPixels);
+
+        for(size_t i = 0; i<numOps; ++i)
+        {
+            timer.start();
+            cpuOps[i]->apply(rgbaBuffer, rgbaBuffer, numPixels);
+            timer.stop(1 + i, numPixels);
+        }
+
+        timer.start();
+        scanlineBuilder.finishRGBAScanline();
+        timer.stop(1 + numOps, numPixels);
+    }
 }
 
-CPUProcessor::CPUProcessor()
-    :   m_impl(new Impl)
+// Add the pixels of the lines [yBegin, yEnd[ processed by the scanline helper.
+void AddRepeatedPixelsStats(RepeatedPixelsStats & stats, const ImageDesc & dstImgDesc,
+                            long yBegin, long yEnd, const ScanlineHelper & scanlineBuilder)
 {
+    stats.m_numPixels += (long long)dstImgDesc.getROIWidth() * (yEnd - yBegin);
+    stats.m_numEvaluatedPixels += scanlineBuilder.getNumEvaluatedPixels();
 }
 
-CPUProcessor::~CPUProcessor()
+// Process the lines [yBegin, yEnd[ using the lookup tables of the complete processing.
+template<typename Timer>
+void ApplyIntegerLookup(const IntegerLookup & lookup,
+                        const ImageDesc & srcImgDesc, BitDepth in,
+                        const ImageDesc & dstImgDesc, BitDepth out,
+                        long yBegin, long yEnd, Timer & timer)
 {
-    delete m_impl;
-    m_impl = nullptr;
+    GenericImageDesc srcImg;
+    srcImg.init(srcImgDesc, in, ConstOpCPURcPtr());
+
+    GenericImageDesc dstImg;
+    dstImg.init(dstImgDesc, out, ConstOpCPURcPtr());
+
+    if(srcImg.m_width!=dstImg.m_width || srcImg.m_height!=dstImg.m_height)
+    {
+        throw Exception("Dimension inconsistency between source and destination image buffers.");
+    }
+
+    if(yBegin<0 || yBegin>yEnd || yEnd>dstImg.m_height)
+    {
+        throw Exception("Invalid line range.");
+    }
+
+    // The lookup is the first renderer.
+    timer.start();
+    lookup.apply(srcImg, dstImg, yBegin, yEnd);
+    timer.stop(0, (yEnd - yBegin) * dstImg.m_width);
 }
 
-bool CPUProcessor::hasChannelCrosstalk() const
+// Are the pixels of the image buffer in contiguous 32-bit float planes?
+bool IsPlanarFloatImage(const GenericImageDesc & img)
 {
-    return getImpl()->hasChannelCrosstalk();
+    return !img.isRGBAPacked() && img.isFloat() && img.m_xStrideBytes==sizeof(float);
 }
 
-const char * CPUProcessor::getCacheID() const
+// The minimum number of pixels of an image band processed by one task, in order
+// to keep the scheduling cost negligible compared to the color processing.
+constexpr long MIN_PIXELS_PER_BAND = 16384;
+
+// Note that the number of lines is even so the lines sharing the chroma samples of a 4:2:0
+// YUV image buffer are in the same band.
+long GetNumLinesPerBand(long width)
 {
-    return getImpl()->getCacheID();
+    const long numLines = std::max(1L, MIN_PIXELS_PER_BAND / std::max(1L, width));
+    return numLines + numLines % 2;
 }
 
-BitDepth CPUProcessor::getInputBitDepth() const
+// Split the image in bands of lines, and process them using the executor
+// (or the internal thread pool if the executor is empty).
+//
+// Note that the band processing is a template argument so the single band case
+// (e.g. a small tile) does not need any std::function allocation.
+template<typename ProcessBand>
+void ProcessBands(long width, long height, const ProcessBand & processBand,
+                  const CPUExecutor & executor)
 {
-    return getImpl()->getInputBitDepth();
-}
-
-BitDepth CPUProcessor::getOutputBitDepth() const
-{
-    return getImpl()->getOutputBitDepth();
-}
+    const long linesPerBand = GetNumLinesPerBand(width);
+    const long numBands     = (height + linesPerBand - 1) / linesPerBand;
 
-DynamicPropertyRcPtr CPUProcessor::getDynamicProperty(DynamicPropertyType type) const
-{
-    return getImpl()->getDynamicProperty(type);
-}
+    // The bands could be processed by the threads of a client executor.
+    const CPUCancellationToken * token = GetCurrentCancellationToken();
 
-void CPUProcessor::apply(ImageDesc & imgDesc) const
-{
-    getImpl()->apply(imgDesc);
-}
+    auto task = [&processBand, linesPerBand, height, token](long bandIdx)
+    {
+        CancellationGuard guard(token);
+        CheckCancellation();
 
-void CPUProcessor::apply(const ImageDesc & srcImgDesc, ImageDesc & dstImgDesc) const
-{
-    getImpl()->apply(srcImgDesc, dstImgDesc);
-}
+        const long yBegin = bandIdx * linesPerBand;
+        processBand(yBegin, std::min(yBegin + linesPerBand, height));
+    };
 
-void CPUProcessor::applyRGB(float * pixel) const
-{
-    getImpl()->applyRGB(pixel);
+    if(numBands <= 1)
+    {
+        CheckCancellation();
+        processBand(0, height);
+    }
+    else if(executor)
+    {
+        executor(numBands, task);
+    }
+    else
+    {
+        GetCPUThreadPool()->parallelFor(numBands, task);
+    }
 }
 
-void CPUProcessor::applyRGBA(float * pixel) const
+// A region of an image buffer (i.e. the same pixels with another region of interest), for
+// the tile by tile processing of a tiled image buffer (refer to TiledImageDesc).
+class RegionImageDesc : public ImageDesc
 {
-    getImpl()->applyRGBA(pixel);
-}
-
-}
-OCIO_NAMESPACE_EXIT
-
+public:
+    RegionImageDesc() = delete;
+    RegionImageDesc(const RegionImageDesc &) = delete;
+    RegionImageDesc & operator=(const RegionImageDesc &) = delete;
+
+    // The region coordinates are relative to the region of interest of the image buffer.
+    RegionImageDesc(const ImageDesc & img, long x, long y, long width, long height)
+        :   ImageDesc()
+        ,   m_img(img)
+    {
+        setROI(img.getROIX() + x, img.getROIY() + y, width, height);
+        setPremultiplied(img.isPremultiplied());
+        setDither(img.getDither());
+    }
 
+    void * getRData() const override { return m_img.getRData(); }
+    void * getGData() const override { return m_img.getGData(); }
+    void * getBData() const override { return m_img.getBData(); }
+    void * getAData() const override { return m_img.getAData(); }
 
-///////////////////////////////////////////////////////////////////////////////
+    BitDepth getBitDepth() const override { return m_img.getBitDepth(); }
 
+    long getWidth() const override { return m_img.getWidth(); }
+    long getHeight() const override { return m_img.getHeight(); }
 
+    ptrdiff_t getXStrideBytes() const override { return m_img.getXStrideBytes(); }
+    ptrdiff_t getYStrideBytes() const override { return m_img.getYStrideBytes(); }
 
-#ifdef OCIO_UNIT_TEST
+    bool isRGBAPacked() const override { return m_img.isRGBAPacked(); }
+    bool isFloat() const override { return m_img.isFloat(); }
 
-namespace OCIO = OCIO_NAMESPACE;
+private:
+    const ImageDesc & m_img;
+};
 
-#include "ops/Lut1D/Lut1DOp.h"
-#include "ops/Lut1D/Lut1DOpData.h"
-#include "ScanlineHelper.h"
-#include "UnitTest.h"
-#include "UnitTestUtils.h"
+// Get the description of a region of the image buffer, the coordinates being relative to
+// its region of interest. The region of a tiled image buffer must be in one tile.
+std::unique_ptr<ImageDesc> CreateRegionImageDesc(const ImageDesc & img,
+                                                 long x, long y, long width, long height)
+{
+    if(const TiledImageDesc * tiledImg = dynamic_cast<const TiledImageDesc *>(&img))
+    {
+        const long tileWidth  = tiledImg->getTileWidth();
+        const long tileHeight = tiledImg->getTileHeight();
 
+        const long imgX  = img.getROIX() + x;
+        const long imgY  = img.getROIY() + y;
+        const long tileX = imgX / tileWidth;
+        const long tileY = imgY / tileHeight;
 
-OCIO_ADD_TEST(CPUProcessor, flag_composition)
-{
-    // The test validates the build of a custom optimization flag.
+        std::unique_ptr<ImageDesc> tile(
+            new PackedImageDesc(tiledImg->getTileData(tileX, tileY), tileWidth, tileHeight,
+                                tiledImg->getChannelOrder(), tiledImg->getBitDepth(),
+                                tiledImg->getChanStrideBytes(), tiledImg->getXStrideBytes(),
+                                tiledImg->getYStrideBytes()));
 
-    OCIO::OptimizationFlags customFlags = OCIO::OPTIMIZATION_LOSSLESS;
+        tile->setROI(imgX - tileX * tileWidth, imgY - tileY * tileHeight, width, height);
+        tile->setPremultiplied(img.isPremultiplied());
+        tile->setDither(img.getDither());
 
-    OCIO_CHECK_EQUAL((customFlags & OCIO::OPTIMIZATION_COMP_LUT1D),
-                     OCIO::OPTIMIZATION_NONE);
+        return tile;
+    }
 
-    customFlags
-        = OCIO::OptimizationFlags(customFlags | OCIO::OPTIMIZATION_COMP_LUT1D);
+    return std::unique_ptr<ImageDesc>(new RegionImageDesc(img, x, y, width, height));
+}
 
-    OCIO_CHECK_EQUAL((customFlags & OCIO::OPTIMIZATION_COMP_LUT1D),
-                     OCIO::OPTIMIZATION_COMP_LUT1D);
+void CheckTiledImageROI(const TiledImageDesc & img)
+{
+    if(img.getROIX() + img.getROIWidth() > img.getWidth()
+        || img.getROIY() + img.getROIHeight() > img.getHeight())
+    {
+        throw Exception("The region of interest is outside of the image buffer.");
+    }
 }
 
+// Get the tiled image buffer driving the tile by tile processing of the image buffers,
+// or null if none is a tiled image buffer.
+const TiledImageDesc * GetTiledImage(const ImageDesc & srcImg, const ImageDesc & dstImg)
+{
+    const TiledImageDesc * srcTiledImg = dynamic_cast<const TiledImageDesc *>(&srcImg);
+    const TiledImageDesc * dstTiledImg = dynamic_cast<const TiledImageDesc *>(&dstImg);
 
-// TODO: CPUProcessor being part of the OCIO public API limits the ability
-//       to inspect the CPUProcessor instance content i.e. the list of CPUOps.
-//       Even a successful apply could hide a major performance hit because of
-//       a missing/partial optimization.
+    if(!srcTiledImg && !dstTiledImg)
+    {
+        return nullptr;
+    }
 
+    const TiledImageDesc * tiledImg = srcTiledImg ? srcTiledImg : dstTiledImg;
+    const ImageDesc & otherImg      = srcTiledImg ? dstImg : srcImg;
 
-template<OCIO::BitDepth inBD, OCIO::BitDepth outBD, unsigned line>
-OCIO::ConstCPUProcessorRcPtr ComputeValues(OCIO::ConstProcessorRcPtr processor,
-                                           const void * inImg,
-                                           OCIO::ChannelOrdering inChans,
-                                           const void * resImg,
-                                           OCIO::ChannelOrdering outChans,
-                                           long numPixels,
-                                           // Default value to nan to break any float comparisons
-                                           // as a valid error threshold is mandatory in that case.
-                                           float absErrorThreshold
-                                                = std::numeric_limits<float>::quiet_NaN())
-{
-    typedef typename OCIO::BitDepthInfo<inBD>::Type inType;
-    typedef typename OCIO::BitDepthInfo<outBD>::Type outType;
+    CheckTiledImageROI(*tiledImg);
 
-    OCIO::ConstCPUProcessorRcPtr cpuProcessor;
+    if(const TiledImageDesc * otherTiledImg = dynamic_cast<const TiledImageDesc *>(&otherImg))
+    {
+        CheckTiledImageROI(*otherTiledImg);
 
-    OCIO_CHECK_NO_THROW_FROM(cpuProcessor
-        = processor->getOptimizedCPUProcessor(inBD, outBD,
-                                              OCIO::OPTIMIZATION_DEFAULT,
-                                              OCIO::FINALIZATION_DEFAULT), line);
+        // The tiles of both image buffers must cover the same parts of the regions.
+        const long tileWidth  = tiledImg->getTileWidth();
+        const long tileHeight = tiledImg->getTileHeight();
 
-    size_t numChannels = 4;
-    if(outChans==OCIO::CHANNEL_ORDERING_RGB || outChans==OCIO::CHANNEL_ORDERING_BGR)
+        if(otherTiledImg->getTileWidth()!=tileWidth
+            || otherTiledImg->getTileHeight()!=tileHeight
+            || (otherImg.getROIX() - tiledImg->getROIX()) % tileWidth!=0
+            || (otherImg.getROIY() - tiledImg->getROIY()) % tileHeight!=0)
+        {
+            throw Exception("Tile layout mismatch between the source and destination "
+                            "image buffers.");
+        }
+    }
+    else if(dynamic_cast<const YUVImageDesc *>(&otherImg)
+            || dynamic_cast<const ScanlineImageDesc *>(&otherImg))
     {
-        numChannels = 3;
+        throw Exception("A tiled image buffer could only be processed with a packed, "
+                        "planar or tiled image buffer.");
     }
-    const size_t numValues = size_t(numPixels * numChannels);
 
-    const OCIO::PackedImageDesc srcImgDesc((void *)inImg, numPixels, 1,
-                                           inChans,
-                                           inBD,
-                                           sizeof(inType),
-                                           OCIO::AutoStride,
-                                           OCIO::AutoStride);
+    return tiledImg;
+}
 
-    std::vector<outType> out(numValues);
-    OCIO::PackedImageDesc dstImgDesc(&out[0], numPixels, 1,
-                                     outChans,
-                                     outBD,
-                                     sizeof(outType),
-                                     OCIO::AutoStride,
-                                     OCIO::AutoStride);
+// An image of a batch processed in blocks spanning several images.
+struct BatchImage
+{
+    GenericImageDesc m_srcImg;
+    GenericImageDesc m_dstImg;
+};
 
-    OCIO_CHECK_NO_THROW_FROM(cpuProcessor->apply(srcImgDesc, dstImgDesc), line);
+// Process the images in blocks of 'blockSize' pixels, a block holding the lines (or parts
+// of lines) of consecutive images so the CPU Ops always process full blocks even if the
+// images are tiny. As with the scanline helpers, the packing applies the bit-depth op of
+// the source images and the unpacking the one of the destination images.
+template<typename InType, typename OutType, typename Timer>
+void ApplyImageBlocks(std::vector<BatchImage> & images, const ConstOpCPURcPtrVec & cpuOps,
+                      long blockSize, Timer & timer)
+{
+    std::vector<float>   rgbaBuffer(4 * blockSize);
+    std::vector<InType>  inBitDepthBuffer(4 * blockSize);
+    std::vector<OutType> outBitDepthBuffer(4 * blockSize);
 
-    const outType * res = reinterpret_cast<const outType*>(resImg);
+    // The part of an image line held by the current block.
+    struct Segment
+    {
+        size_t m_imageIdx;
+        long   m_firstPixel; // Index of the first pixel in the image.
+        long   m_numPixels;
+        long   m_offset;     // Index of the first pixel in the block.
+    };
+    std::vector<Segment> segments;
+
+    const size_t numOps = cpuOps.size();
+    long numPixels = 0;
 
-    for(size_t idx=0; idx<numValues; ++idx)
+    auto processBlock = [&]()
     {
-        if(OCIO::BitDepthInfo<outBD>::isFloat)
+        for(size_t i = 0; i<numOps; ++i)
         {
-            OCIO_CHECK_CLOSE_FROM(out[idx], res[idx], absErrorThreshold, line);
+            timer.start();
+            cpuOps[i]->apply(&rgbaBuffer[0], &rgbaBuffer[0], numPixels);
+            timer.stop(1 + i, numPixels);
         }
-        else
+
+        timer.start();
+        for(const auto & segment : segments)
         {
-            OCIO_CHECK_EQUAL_FROM(out[idx], res[idx], line);
+            Generic<OutType>::UnpackRGBAToImageDesc(images[segment.m_imageIdx].m_dstImg,
+                                                    &rgbaBuffer[4 * segment.m_offset],
+                                                    &outBitDepthBuffer[4 * segment.m_offset],
+                                                    int(segment.m_numPixels),
+                                                    segment.m_firstPixel);
+        }
+        timer.stop(1 + numOps, numPixels);
+
+        segments.clear();
+        numPixels = 0;
+    };
+
+    for(size_t idx = 0; idx<images.size(); ++idx)
+    {
+        const GenericImageDesc & srcImg = images[idx].m_srcImg;
+        const long width = srcImg.m_width;
+
+        for(long y = 0; y<srcImg.m_height; ++y)
+        {
+            long x = 0;
+            while(x<width)
+            {
+                const long count = std::min(width - x, blockSize - numPixels);
+                const long firstPixel = y * width + x;
+
+                timer.start();
+                Generic<InType>::PackRGBAFromImageDesc(srcImg,
+                                                       &inBitDepthBuffer[4 * numPixels],
+                                                       &rgbaBuffer[4 * numPixels],
+                                                       int(count), firstPixel);
+                timer.stop(0, count);
+
+                segments.push_back({ idx, firstPixel, count, numPixels });
+                numPixels += count;
+                x += count;
+
+                if(numPixels==blockSize)
+                {
+                    processBlock();
+                }
+            }
         }
     }
 
-    return cpuProcessor;
+    if(numPixels>0)
+    {
+        processBlock();
+    }
 }
 
-OCIO_ADD_TEST(CPUProcessor, with_one_matrix)
+template<typename Timer>
+void ApplyImageBlocks(BitDepth in, BitDepth out, std::vector<BatchImage> & images,
+                      const ConstOpCPURcPtrVec & cpuOps, long blockSize, Timer & timer)
 {
-    // The unit test validates that pixel formats are correctly
-    // processed when the op list contains only one arbitrary Op
-    // (except a 1D LUT one which has dedicated optimizations).
 
-    OCIO::ConfigRcPtr config = OCIO::Config::Create();
+#define ADD_OUT_BIT_DEPTH(in, out)                                          \
+case out:                                                                   \
+{                                                                           \
+    ApplyImageBlocks<BitDepthInfo<in>::Type,                                \
+                     BitDepthInfo<out>::Type>(images, cpuOps, blockSize, timer); \
+    return;                                                                 \
+}
 
-    OCIO::MatrixTransformRcPtr transform = OCIO::MatrixTransform::Create();
-    constexpr double offset4[4] = { 1.4002, 0.4005, 0.0807, 0.5 };
-    transform->setOffset( offset4 );
+#define ADD_IN_BIT_DEPTH(in)                          \
+case in:                                              \
+{                                                     \
+    switch(out)                                       \
+    {                                                 \
+        ADD_OUT_BIT_DEPTH(in, BIT_DEPTH_UINT8)        \
+        ADD_OUT_BIT_DEPTH(in, BIT_DEPTH_UINT10)       \
+        ADD_OUT_BIT_DEPTH(in, BIT_DEPTH_UINT12)       \
+        ADD_OUT_BIT_DEPTH(in, BIT_DEPTH_UINT14)       \
+        ADD_OUT_BIT_DEPTH(in, BIT_DEPTH_UINT16)       \
+        ADD_OUT_BIT_DEPTH(in, BIT_DEPTH_UINT32)       \
+        ADD_OUT_BIT_DEPTH(in, BIT_DEPTH_F16)          \
+        ADD_OUT_BIT_DEPTH(in, BIT_DEPTH_F32)          \
+        case BIT_DEPTH_UNKNOWN:                       \
+        default:                                      \
+            throw Exception("Unsupported bit-depth"); \
+                                                      \
+    }                                                 \
+    break;                                            \
+}
 
-    OCIO::ConstProcessorRcPtr processor;
-    OCIO_CHECK_NO_THROW(processor = config->getProcessor(transform));
+    switch(in)
+    {
+        ADD_IN_BIT_DEPTH(BIT_DEPTH_UINT8)
+        ADD_IN_BIT_DEPTH(BIT_DEPTH_UINT10)
+        ADD_IN_BIT_DEPTH(BIT_DEPTH_UINT12)
+        ADD_IN_BIT_DEPTH(BIT_DEPTH_UINT14)
+        ADD_IN_BIT_DEPTH(BIT_DEPTH_UINT16)
+        ADD_IN_BIT_DEPTH(BIT_DEPTH_UINT32)
+        ADD_IN_BIT_DEPTH(BIT_DEPTH_F16)
+        ADD_IN_BIT_DEPTH(BIT_DEPTH_F32)
+        case BIT_DEPTH_UNKNOWN:
+        default:
+            throw Exception("Unsupported bit-depth");
+    }
 
-    constexpr unsigned NB_PIXELS = 3;
+#undef ADD_OUT_BIT_DEPTH
+#undef ADD_IN_BIT_DEPTH
 
-    const std::vector<float> f_inImg =
-        {  -1.0000f, -0.8000f, -0.1000f,  0.0f,
-            0.1023f,  0.5045f,  1.5089f,  1.0f,
-            1.0000f,  1.2500f,  1.9900f,  0.0f  };
+    throw Exception("Unsupported bit-depths");
+}
 
-    {
-        const std::vector<float> resImg
-            = { 0.4002f, -0.3995f, -0.0193f,  0.5000f,
-                1.5025f,  0.9050f,  1.5896f,  1.5000f,
-                2.4002f,  1.6505f,  2.0707f,  0.5000f };
+}
 
-        ComputeValues<OCIO::BIT_DEPTH_F32,
-                      OCIO::BIT_DEPTH_F32, __LINE__>(processor,
-                                                     &f_inImg[0], OCIO::CHANNEL_ORDERING_RGBA,
-                                                     &resImg[0],  OCIO::CHANNEL_ORDERING_RGBA,
-                                                     NB_PIXELS,
-                                                     1e-5f);
-    }
+// Note that the guard gives the helper back to the pool even if the processing throws.
+class CPUProcessor::Impl::ScanlineHelperGuard
+{
+public:
+    ScanlineHelperGuard() = delete;
+    ScanlineHelperGuard(const ScanlineHelperGuard &) = delete;
+    ScanlineHelperGuard & operator=(const ScanlineHelperGuard &) = delete;
 
+    explicit ScanlineHelperGuard(const Impl & processor)
+        :   m_processor(processor)
+        ,   m_helper(processor.acquireScanlineHelper())
     {
-        const std::vector<float> resImg
-            = { -0.9193f,   -0.3995f,  1.3002f,  0.5000f,
-                 0.182999f,  0.9050f,  2.9091f,  1.5000f,
-                 1.0807f,    1.6505f,  3.3902f,  0.5000f };
-
-        ComputeValues<OCIO::BIT_DEPTH_F32,
-                      OCIO::BIT_DEPTH_F32, __LINE__>(processor,
-                                                     &f_inImg[0], OCIO::CHANNEL_ORDERING_BGRA,
-                                                     &resImg[0],  OCIO::CHANNEL_ORDERING_BGRA,
-                                                     NB_PIXELS,
-                                                     1e-5f);
     }
 
+    ~ScanlineHelperGuard()
     {
-        const std::vector<float> resImg
-            = {  -0.500000f, -0.719300f, 0.300500f, 1.400200f,
-                  0.602300f,  0.585199f, 1.909399f, 2.400200f,
-                  1.500000f,  1.330700f, 2.390500f, 1.400200f  };
+        m_processor.releaseScanlineHelper(std::move(m_helper));
+    }
 
-        ComputeValues<OCIO::BIT_DEPTH_F32,
-                      OCIO::BIT_DEPTH_F32, __LINE__>(processor,
-                                                     &f_inImg[0], OCIO::CHANNEL_ORDERING_ABGR,
-                                                     &resImg[0],  OCIO::CHANNEL_ORDERING_ABGR,
-                                                     NB_PIXELS,
-                                                     1e-5f);
+    ScanlineHelper & operator*() const { return *m_helper; }
+    ScanlineHelper * operator->() const { return m_helper.get(); }
+
+private:
+    const Impl & m_processor;
+    std::unique_ptr<ScanlineHelper> m_helper;
+};
+
+template<typename Timer>
+bool CPUProcessor::Impl::applyBypass(const ImageDesc & srcImgDesc,
+                                     const ImageDesc & dstImgDesc,
+                                     long yBegin, long yEnd, Timer & timer) const
+{
+    if(!m_isNoOp)
+    {
+        return false;
     }
 
+    // The (un)premultiplication and the dithering are neutral only without a bit-depth
+    // change.
+    const bool needsCast = srcImgDesc.isPremultiplied() || dstImgDesc.isPremultiplied()
+        || (dstImgDesc.getDither()!=DITHER_NONE && !IsFloatBitDepth(m_outBitDepth));
+    if(needsCast && m_inBitDepth!=m_outBitDepth)
     {
-        const std::vector<float> resImg
-            = { -0.0193f, -0.3995f,  0.4002f,  0.5000f,
-                 1.5896f,  0.9050f,  1.5025f,  1.5000f,
-                 2.0707f,  1.6505f,  2.4002f,  0.5000f };
+        return false;
+    }
 
-        ComputeValues<OCIO::BIT_DEPTH_F32,
-                      OCIO::BIT_DEPTH_F32, __LINE__>(processor,
-                                                     &f_inImg[0], OCIO::CHANNEL_ORDERING_RGBA,
-                                                     &resImg[0],  OCIO::CHANNEL_ORDERING_BGRA,
-                                                     NB_PIXELS,
-                                                     1e-5f);
+    // The decoding & encoding of the YUV pixels are not neutral.
+    if(dynamic_cast<const YUVImageDesc *>(&srcImgDesc)
+        || dynamic_cast<const YUVImageDesc *>(&dstImgDesc))
+    {
+        return false;
     }
 
+    GenericImageDesc srcImg;
+    srcImg.init(srcImgDesc, m_inBitDepth, m_inBitDepthOp);
+
+    GenericImageDesc dstImg;
+    dstImg.init(dstImgDesc, m_outBitDepth, m_outBitDepthOp);
+
+    if(srcImg.m_width!=dstImg.m_width || srcImg.m_height!=dstImg.m_height)
     {
-        const std::vector<float> resImg
-            = { 0.5000f, -0.0193f, -0.3995f, 0.4002f,
-                1.5000f,  1.5896f,  0.9050f, 1.5025f,
-                0.5000f,  2.0707f,  1.6505f, 2.4002f  };
+        throw Exception("Dimension inconsistency between source and destination image buffers.");
+    }
 
-        ComputeValues<OCIO::BIT_DEPTH_F32,
-                      OCIO::BIT_DEPTH_F32, __LINE__>(processor,
-                                                     &f_inImg[0], OCIO::CHANNEL_ORDERING_RGBA,
-                                                     &resImg[0],  OCIO::CHANNEL_ORDERING_ABGR,
-                                                     NB_PIXELS,
-                                                     1e-5f);
+    if(yBegin<0 || yBegin>yEnd || yEnd>dstImg.m_height)
+    {
+        throw Exception("Invalid line range.");
     }
 
+    if(&srcImgDesc==&dstImgDesc)
     {
-        const std::vector<float> inImg =
-            {  -1.0000f, -0.8000f, -0.1000f,
-                0.1023f,  0.5045f,  1.5089f,
-                1.0000f,  1.2500f,  1.9900f  };
-
-        const std::vector<float> resImg
-            = { 0.4002f, -0.3995f, -0.0193f,
-                1.5025f,  0.9050f,  1.5896f,
-                2.4002f,  1.6505f,  2.0707f };
-
-        ComputeValues<OCIO::BIT_DEPTH_F32,
-                      OCIO::BIT_DEPTH_F32, __LINE__>(processor,
-                                                     &inImg[0],  OCIO::CHANNEL_ORDERING_RGB,
-                                                     &resImg[0], OCIO::CHANNEL_ORDERING_RGB,
-                                                     NB_PIXELS,
-                                                     1e-5f);
+        // Nothing to do in place (i.e. the bit-depths are then the same).
+        return true;
     }
 
-    {
-        const std::vector<float> inImg =
-            {    -1.0000f,    -0.8000f, -0.1000f,
-                   0.1023f,    0.5045f,  1.5089f,
-                   1.0000f,    1.2500f,  1.9900f  };
+    const long width = dstImg.m_width;
 
-        const std::vector<float> resImg
-            = { -0.919300f, -0.399500f,  1.300199f,
-                 0.182999f,  0.905000f,  2.909100f,
-                 1.080700f,  1.650500f,  3.390200f };
+    if(srcImg.isRGBAPacked() && dstImg.isRGBAPacked())
+    {
+        for(long y=yBegin; y<yEnd; ++y)
+        {
+            const char * in = srcImg.getLineData(srcImg.m_rData, 0, y);
+            char * out = dstImg.getLineData(dstImg.m_rData, 0, y);
 
-        ComputeValues<OCIO::BIT_DEPTH_F32,
-                      OCIO::BIT_DEPTH_F32, __LINE__>(processor,
-                                                     &inImg[0],  OCIO::CHANNEL_ORDERING_BGR,
-                                                     &resImg[0], OCIO::CHANNEL_ORDERING_BGR,
-                                                     NB_PIXELS,
-                                                     1e-5f);
+            timer.start();
+            if(m_bypassOp)
+            {
+                m_bypassOp->apply(in, out, width);
+            }
+            else if(in!=out)
+            {
+                memcpy(out, in, width * srcImg.m_xStrideBytes);
+            }
+            timer.stop(0, width);
+        }
+        return true;
     }
 
+    if(!m_bypassOp && IsPlanarFloatImage(srcImg) && IsPlanarFloatImage(dstImg)
+        && (srcImg.m_aData==nullptr)==(dstImg.m_aData==nullptr))
     {
-        const std::vector<float> inImg =
-            {  -1.0000f, -0.8000f, -0.1000f,
-                0.1023f,  0.5045f,  1.5089f,
-                1.0000f,  1.2500f,  1.9900f  };
-
-        const std::vector<float> resImg
-            = { -0.01929f,  -0.3995f,  0.4002f,
-                 1.58960f,   0.9050f,  1.5025f,
-                 2.070699f,  1.6505f,  2.4002f };
+        const char * inPlanes[4] = { srcImg.m_rData, srcImg.m_gData,
+                                     srcImg.m_bData, srcImg.m_aData };
+        char * outPlanes[4] = { dstImg.m_rData, dstImg.m_gData,
+                                dstImg.m_bData, dstImg.m_aData };
 
-        ComputeValues<OCIO::BIT_DEPTH_F32,
-                      OCIO::BIT_DEPTH_F32, __LINE__>(processor,
-                                                     &inImg[0],  OCIO::CHANNEL_ORDERING_RGB,
-                                                     &resImg[0], OCIO::CHANNEL_ORDERING_BGR,
-                                                     NB_PIXELS,
-                                                     1e-5f);
+        for(long y=yBegin; y<yEnd; ++y)
+        {
+            timer.start();
+            for(int c=0; c<4 && inPlanes[c]; ++c)
+            {
+                const char * in = srcImg.getLineData(inPlanes[c], c, y);
+                char * out = dstImg.getLineData(outPlanes[c], c, y);
+                if(in!=out)
+                {
+                    memcpy(out, in, width * sizeof(float));
+                }
+            }
+            timer.stop(0, width);
+        }
+        return true;
     }
 
+    return false;
+}
+
+template<typename Timer>
+bool CPUProcessor::Impl::applyPlanar(const ImageDesc & srcImgDesc,
+                                     const ImageDesc & dstImgDesc,
+                                     long yBegin, long yEnd, Timer & timer) const
+{
+    if(!m_hasPlanarOps)
     {
-        const std::vector<float> inImg =
-            {  -1.0000f, -0.8000f, -0.1000f,
-                0.1023f,  0.5045f,  1.5089f,
-                1.0000f,  1.2500f,  1.9900f  };
+        return false;
+    }
 
-        const std::vector<float> resImg
-            = { -0.01929f,  -0.3995f,  0.4002f, 0.5f,
-                 1.58960f,   0.9050f,  1.5025f, 0.5f,
-                 2.070699f,  1.6505f,  2.4002f, 0.5f   };
+    GenericImageDesc srcImg;
+    srcImg.init(srcImgDesc, m_inBitDepth, m_inBitDepthOp);
 
-        ComputeValues<OCIO::BIT_DEPTH_F32,
-                      OCIO::BIT_DEPTH_F32, __LINE__>(processor,
-                                                     &inImg[0],  OCIO::CHANNEL_ORDERING_RGB,
-                                                     &resImg[0], OCIO::CHANNEL_ORDERING_BGRA,
-                                                     NB_PIXELS,
-                                                     1e-5f);
-    }
+    GenericImageDesc dstImg;
+    dstImg.init(dstImgDesc, m_outBitDepth, m_outBitDepthOp);
 
+    if(!IsPlanarFloatImage(srcImg) || !IsPlanarFloatImage(dstImg))
     {
-        const std::vector<float> inImg =
-            {  -1.0000f, -0.8000f, -0.1000f,  0.0f,
-                0.1023f,  0.5045f,  1.5089f,  1.0f,
-                1.0000f,  1.2500f,  1.9900f,  0.0f  };
+        return false;
+    }
 
-        const std::vector<float> resImg
-            = { -0.01929f,  -0.3995f,  0.4002f,
-                 1.58960f,   0.9050f,  1.5025f,
-                 2.070699f,  1.6505f,  2.4002f   };
+    if(srcImg.m_width!=dstImg.m_width || srcImg.m_height!=dstImg.m_height)
+    {
+        throw Exception("Dimension inconsistency between source and destination image buffers.");
+    }
 
-        ComputeValues<OCIO::BIT_DEPTH_F32,
-                      OCIO::BIT_DEPTH_F32, __LINE__>(processor,
-                                                     &inImg[0],  OCIO::CHANNEL_ORDERING_RGBA,
-                                                     &resImg[0], OCIO::CHANNEL_ORDERING_BGR,
-                                                     NB_PIXELS,
-                                                     1e-5f);
+    if(yBegin<0 || yBegin>yEnd || yEnd>dstImg.m_height)
+    {
+        throw Exception("Invalid line range.");
     }
 
-    const std::vector<uint16_t> ui16_inImg =
-        {    0,      8,    32,  0,
-            64,    128,   256,  0,
-          5120,  20140, 65535,  0  };
+    const long width     = dstImg.m_width;
+    const long blockSize = std::min(width, GetCPUBlockSizeInPixels());
 
-    {
-        const std::vector<float> resImg
-            = { 1.40020000f,  0.40062206f,  0.08118829f,  0.5f,
-                1.40117657f,  0.40245315f,  0.08460631f,  0.5f,
-                1.47832620f,  0.70781672f,  1.08070004f,  0.5f };
+    // When no op touches the alpha channel, the alpha plane is only copied and the ops
+    // process the block size buffer instead.
+    const bool copyAlpha = !m_touchesAlpha && srcImg.m_aData;
 
-        ComputeValues<OCIO::BIT_DEPTH_UINT16,
-                      OCIO::BIT_DEPTH_F32, __LINE__>(processor,
-                                                     &ui16_inImg[0], OCIO::CHANNEL_ORDERING_RGBA,
-                                                     &resImg[0],  OCIO::CHANNEL_ORDERING_RGBA,
-                                                     NB_PIXELS,
-                                                     1e-5f);
+    // A missing alpha plane is processed as zeros, using a block size buffer.
+    std::vector<float> alphaBuffer;
+    if(!srcImg.m_aData || !dstImg.m_aData || copyAlpha)
+    {
+        alphaBuffer.resize(blockSize);
     }
 
+    for(long y=yBegin; y<yEnd; ++y)
     {
-        const std::vector<uint16_t> resImg
-            = { 65535, 26255,  5321, 32768,
-                65535, 26375,  5545, 32768,
-                65535, 46387, 65535, 32768 };
+        for(long x=0; x<width; x+=blockSize)
+        {
+            const long numPixels = std::min(blockSize, width - x);
+            const ptrdiff_t xOffset = x * sizeof(float);
 
-        ComputeValues<OCIO::BIT_DEPTH_UINT16,
-                      OCIO::BIT_DEPTH_UINT16, __LINE__>(processor,
-                                                        &ui16_inImg[0], OCIO::CHANNEL_ORDERING_RGBA,
-                                                        &resImg[0],  OCIO::CHANNEL_ORDERING_RGBA,
-                                                        NB_PIXELS);
-    }
+            if(!srcImg.m_aData)
+            {
+                std::fill(alphaBuffer.begin(), alphaBuffer.begin() + numPixels, 0.0f);
+            }
 
-    {
-        const std::vector<uint16_t> resImg
-            = {  5321, 26255, 65535, 32768,
-                 5545, 26375, 65535, 32768,
-                65535, 46387, 65535, 32768 };
+            const char * srcAlpha
+                = srcImg.m_aData ? srcImg.getLineData(srcImg.m_aData, 3, y) + xOffset : nullptr;
+            char * dstAlpha
+                = dstImg.m_aData ? dstImg.getLineData(dstImg.m_aData, 3, y) + xOffset : nullptr;
+
+            const float * inPlanes[4]
+                = { reinterpret_cast<const float *>(srcImg.getLineData(srcImg.m_rData, 0, y) + xOffset),
+                    reinterpret_cast<const float *>(srcImg.getLineData(srcImg.m_gData, 1, y) + xOffset),
+                    reinterpret_cast<const float *>(srcImg.getLineData(srcImg.m_bData, 2, y) + xOffset),
+                    srcAlpha && !copyAlpha
+                        ? reinterpret_cast<const float *>(srcAlpha)
+                        : &alphaBuffer[0] };
+
+            float * outPlanes[4]
+                = { reinterpret_cast<float *>(dstImg.getLineData(dstImg.m_rData, 0, y) + xOffset),
+                    reinterpret_cast<float *>(dstImg.getLineData(dstImg.m_gData, 1, y) + xOffset),
+                    reinterpret_cast<float *>(dstImg.getLineData(dstImg.m_bData, 2, y) + xOffset),
+                    dstAlpha && !copyAlpha
+                        ? reinterpret_cast<float *>(dstAlpha)
+                        : &alphaBuffer[0] };
+
+            if(copyAlpha && dstAlpha && srcAlpha!=dstAlpha)
+            {
+                memcpy(dstAlpha, srcAlpha, numPixels * sizeof(float));
+            }
 
-        ComputeValues<OCIO::BIT_DEPTH_UINT16,
-                      OCIO::BIT_DEPTH_UINT16, __LINE__>(processor,
-                                                        &ui16_inImg[0], OCIO::CHANNEL_ORDERING_RGBA,
-                                                        &resImg[0],  OCIO::CHANNEL_ORDERING_BGRA,
-                                                        NB_PIXELS);
-    }
+            // The first op reads the source planes, and the next ones process in place
+            // the destination planes.
+            timer.start();
+            m_inBitDepthOp->applyPlanar(inPlanes, outPlanes, numPixels);
+            timer.stop(0, numPixels);
 
-    {
-        const std::vector<uint16_t> resImg
-            = {  5321, 26255, 65535,
-                 5545, 26375, 65535,
-                65535, 46387, 65535 };
+            for(size_t i = 0; i<m_cpuOps.size(); ++i)
+            {
+                timer.start();
+                m_cpuOps[i]->applyPlanar(outPlanes, outPlanes, numPixels);
+                timer.stop(1 + i, numPixels);
+            }
 
-        ComputeValues<OCIO::BIT_DEPTH_UINT16,
-                      OCIO::BIT_DEPTH_UINT16, __LINE__>(processor,
-                                                        &ui16_inImg[0], OCIO::CHANNEL_ORDERING_RGBA,
-                                                        &resImg[0],  OCIO::CHANNEL_ORDERING_BGR,
-                                                        NB_PIXELS);
+            timer.start();
+            m_outBitDepthOp->applyPlanar(outPlanes, outPlanes, numPixels);
+            timer.stop(1 + m_cpuOps.size(), numPixels);
+        }
     }
 
-    {
-        const std::vector<uint8_t> resImg
-            = { 255, 102,  21, 128,
-                255, 103,  22, 128,
-                255, 180, 255, 128 };
+    return true;
+}
 
-        ComputeValues<OCIO::BIT_DEPTH_UINT16,
-                      OCIO::BIT_DEPTH_UINT8, __LINE__>(processor,
-                                                       &ui16_inImg[0], OCIO::CHANNEL_ORDERING_RGBA,
-                                                       &resImg[0],  OCIO::CHANNEL_ORDERING_RGBA,
-                                                       NB_PIXELS);
+template<typename Timer>
+bool CPUProcessor::Impl::applyRGB(const ImageDesc & srcImgDesc,
+                                  const ImageDesc & dstImgDesc,
+                                  long yBegin, long yEnd, Timer & timer) const
+{
+    if(!m_hasRGBOps)
+    {
+        return false;
     }
 
-    {
-        const std::vector<uint8_t> resImg
-            = {  21, 102, 255,
-                 22, 103, 255,
-                255, 180, 255 };
+    GenericImageDesc srcImg;
+    srcImg.init(srcImgDesc, m_inBitDepth, m_inBitDepthOp);
 
-        ComputeValues<OCIO::BIT_DEPTH_UINT16,
-                      OCIO::BIT_DEPTH_UINT8, __LINE__>(processor,
-                                                       &ui16_inImg[0], OCIO::CHANNEL_ORDERING_RGBA,
-                                                       &resImg[0],  OCIO::CHANNEL_ORDERING_BGR,
-                                                       NB_PIXELS);
+    GenericImageDesc dstImg;
+    dstImg.init(dstImgDesc, m_outBitDepth, m_outBitDepthOp);
+
+    if(GetOptimizationMode(srcImg)!=PACKED_RGB_FLOAT_OPTIMIZATION
+        || GetOptimizationMode(dstImg)!=PACKED_RGB_FLOAT_OPTIMIZATION)
+    {
+        return false;
     }
 
+    if(srcImg.m_width!=dstImg.m_width || srcImg.m_height!=dstImg.m_height)
     {
-        const std::vector<uint8_t> resImg
-            = { 128,  21, 102, 255,
-                128,  22, 103, 255,
-                128, 255, 180, 255 };
+        throw Exception("Dimension inconsistency between source and destination image buffers.");
+    }
 
-        ComputeValues<OCIO::BIT_DEPTH_UINT16,
-                      OCIO::BIT_DEPTH_UINT8, __LINE__>(processor,
-                                                       &ui16_inImg[0], OCIO::CHANNEL_ORDERING_RGBA,
-                                                       &resImg[0],  OCIO::CHANNEL_ORDERING_ABGR,
-                                                       NB_PIXELS);
+    if(yBegin<0 || yBegin>yEnd || yEnd>dstImg.m_height)
+    {
+        throw Exception("Invalid line range.");
     }
 
-    // Test OCIO::BIT_DEPTH_UINT10.
+    const long width     = dstImg.m_width;
+    const long blockSize = std::min(width, GetCPUBlockSizeInPixels());
 
+    for(long y=yBegin; y<yEnd; ++y)
     {
-        const std::vector<uint16_t> ui10_resImg
-            = { 1023,  410,   83,  512,
-                1023,  412,   87,  512,
-                1023,  724, 1023,  512 };
+        for(long x=0; x<width; x+=blockSize)
+        {
+            const long numPixels = std::min(blockSize, width - x);
 
-        ComputeValues<OCIO::BIT_DEPTH_UINT16,
-                      OCIO::BIT_DEPTH_UINT10, __LINE__>(processor,
-                                                        &ui16_inImg[0], OCIO::CHANNEL_ORDERING_RGBA,
-                                                        &ui10_resImg[0],  OCIO::CHANNEL_ORDERING_RGBA,
-                                                        NB_PIXELS);
+            const float * in = reinterpret_cast<const float *>(
+                srcImg.getLineData(srcImg.m_rData, 0, y) + x * srcImg.m_xStrideBytes);
+            float * out = reinterpret_cast<float *>(
+                dstImg.getLineData(dstImg.m_rData, 0, y) + x * dstImg.m_xStrideBytes);
 
-        const std::vector<uint16_t> ui10_inImg
-            = {    0,    8,   12,  256,
-                 128,   16,   64,  512,
-                1023,   32,   96,  512 };
+            // The first op reads the source pixels, and the next ones process in place
+            // the destination pixels.
+            timer.start();
+            m_inBitDepthOp->applyRGB(in, out, numPixels);
+            timer.stop(0, numPixels);
 
-        const std::vector<uint16_t> ui16_resImg
-            = { 65535, 26759,  6057, 49167,
-                65535, 27272,  9389, 65535,
-                65535, 28297, 11439, 65535 };
+            for(size_t i = 0; i<m_cpuOps.size(); ++i)
+            {
+                timer.start();
+                m_cpuOps[i]->applyRGB(out, out, numPixels);
+                timer.stop(1 + i, numPixels);
+            }
 
-        ComputeValues<OCIO::BIT_DEPTH_UINT10,
-                      OCIO::BIT_DEPTH_UINT16, __LINE__>(processor,
-                                                        &ui10_inImg[0], OCIO::CHANNEL_ORDERING_RGBA,
-                                                        &ui16_resImg[0],  OCIO::CHANNEL_ORDERING_RGBA,
-                                                        NB_PIXELS);
+            timer.start();
+            m_outBitDepthOp->applyRGB(out, out, numPixels);
+            timer.stop(1 + m_cpuOps.size(), numPixels);
+        }
     }
 
-    // Test OCIO::BIT_DEPTH_UINT12.
+    return true;
+}
 
+void CPUProcessor::Impl::apply(ImageDesc & imgDesc) const
+{   
+    if(const TiledImageDesc * tiledImg = GetTiledImage(imgDesc, imgDesc))
     {
-        const std::vector<uint16_t> ui12_resImg
-            = { 4095, 1641,  332, 2048,
-                4095, 1648,  346, 2048,
-                4095, 2899, 4095, 2048 };
-
-        ComputeValues<OCIO::BIT_DEPTH_UINT16,
-                      OCIO::BIT_DEPTH_UINT12, __LINE__>(processor,
-                                                        &ui16_inImg[0], OCIO::CHANNEL_ORDERING_RGBA,
-                                                        &ui12_resImg[0],  OCIO::CHANNEL_ORDERING_RGBA,
-                                                        NB_PIXELS);
-
-        const std::vector<uint16_t> ui12_inImg
-            = {     0,    8,    12,   1024,
-                 2048,   16,    64,   2048,
-                 4095,   32,    96,   4095 };
+        applyTiles(*tiledImg, imgDesc, imgDesc, nullptr, CPUBandCallback(), nullptr);
+        return;
+    }
 
-        const std::vector<uint16_t> ui16_resImg
-            = { 65535, 26375,  5481, 49155,
-                65535, 26503,  6313, 65535,
-                65535, 26759,  6825, 65535 };
+    applyBand(imgDesc, imgDesc, 0, imgDesc.getROIHeight());
+}
 
-        ComputeValues<OCIO::BIT_DEPTH_UINT12,
-                      OCIO::BIT_DEPTH_UINT16, __LINE__>(processor,
-                                                        &ui12_inImg[0], OCIO::CHANNEL_ORDERING_RGBA,
-                                                        &ui16_resImg[0],  OCIO::CHANNEL_ORDERING_RGBA,
-                                                        NB_PIXELS);
+void CPUProcessor::Impl::apply(const ImageDesc & srcImgDesc, ImageDesc & dstImgDesc) const
+{
+    if(const TiledImageDesc * tiledImg = GetTiledImage(srcImgDesc, dstImgDesc))
+    {
+        applyTiles(*tiledImg, srcImgDesc, dstImgDesc, nullptr, CPUBandCallback(), nullptr);
+        return;
     }
+
+    applyBand(srcImgDesc, dstImgDesc, 0, dstImgDesc.getROIHeight());
 }
 
-OCIO_ADD_TEST(CPUProcessor, with_one_1d_lut)
+void CPUProcessor::Impl::applyTiles(const TiledImageDesc & tiledImg,
+                                    const ImageDesc & srcImgDesc, ImageDesc & dstImgDesc,
+                                    const CPUExecutor * executor,
+                                    const CPUBandCallback & bandDone,
+                                    const DynamicPropertyOverrides * overrides) const
 {
-    // The unit test validates that pixel formats are correctly
-    // processed when the op list only contains one 1D LUT because it
-    // has a dedicated optimization when the input bit-depth is an integer type.
+    if(srcImgDesc.getROIWidth()!=dstImgDesc.getROIWidth()
+        || srcImgDesc.getROIHeight()!=dstImgDesc.getROIHeight())
+    {
+        throw Exception("Dimension inconsistency between source and destination image buffers.");
+    }
 
-    const std::string filePath
-        = std::string(OCIO::getTestFilesDir()) + "/lut1d_5.spi1d";
+    const long roiX   = tiledImg.getROIX();
+    const long roiY   = tiledImg.getROIY();
+    const long width  = tiledImg.getROIWidth();
+    const long height = tiledImg.getROIHeight();
 
-    OCIO::FileTransformRcPtr transform = OCIO::FileTransform::Create();
-    transform->setDirection(OCIO::TRANSFORM_DIR_FORWARD);
-    transform->setSrc(filePath.c_str());
-    transform->setInterpolation(OCIO::INTERP_LINEAR);
+    const long tileWidth  = tiledImg.getTileWidth();
+    const long tileHeight = tiledImg.getTileHeight();
 
-    OCIO::ConfigRcPtr config = OCIO::Config::Create();
+    // The tiles intersecting the region of interest.
+    const long firstTileX = roiX / tileWidth;
+    const long firstTileY = roiY / tileHeight;
+    const long numTilesX  = (roiX + width - 1) / tileWidth - firstTileX + 1;
+    const long numTilesY  = (roiY + height - 1) / tileHeight - firstTileY + 1;
+    const long numTiles   = numTilesX * numTilesY;
 
-    OCIO::ConstProcessorRcPtr processor;
-    OCIO_CHECK_NO_THROW(processor = config->getProcessor(transform));
+    // A task processes whole tiles, several ones for the small tiles in order to keep the
+    // scheduling cost negligible compared to the color processing.
+    const long tilesPerTask = std::max(1L, MIN_PIXELS_PER_BAND / (tileWidth * tileHeight));
+    const long numTasks     = (numTiles + tilesPerTask - 1) / tilesPerTask;
 
-    constexpr unsigned NB_PIXELS = 4;
+    // The number of processed tiles of each row of tiles.
+    std::vector<std::atomic<long>> rowTiles(bandDone ? numTilesY : 0);
 
-    const std::vector<float> f_inImg =
-        {  -1.0000f, -0.8000f, -0.1000f,  0.0f,
-            0.1002f,  0.2509f,  0.5009f,  1.0f,
-            0.5505f,  0.7090f,  0.9099f,  1.0f,
-            1.0000f,  1.2500f,  1.9900f,  0.0f  };
+    auto processTiles = [&](long taskIdx)
+    {
+        const long tileEnd = std::min((taskIdx + 1) * tilesPerTask, numTiles);
+        for(long tileIdx = taskIdx * tilesPerTask; tileIdx<tileEnd; ++tileIdx)
+        {
+            CheckCancellation();
+
+            const long tileX = firstTileX + tileIdx % numTilesX;
+            const long tileY = firstTileY + tileIdx / numTilesX;
+
+            // The part of the tile in the region of interest.
+            const long x0 = std::max(tileX * tileWidth, roiX) - roiX;
+            const long x1 = std::min((tileX + 1) * tileWidth, roiX + width) - roiX;
+            const long y0 = std::max(tileY * tileHeight, roiY) - roiY;
+            const long y1 = std::min((tileY + 1) * tileHeight, roiY + height) - roiY;
+
+            std::unique_ptr<ImageDesc> dstTile
+                = CreateRegionImageDesc(dstImgDesc, x0, y0, x1 - x0, y1 - y0);
 
+            if(&srcImgDesc==&dstImgDesc)
+            {
+                getNumaReplica().applyBand(*dstTile, *dstTile, 0, y1 - y0);
+            }
+            else
+            {
+                std::unique_ptr<ImageDesc> srcTile
+                    = CreateRegionImageDesc(srcImgDesc, x0, y0, x1 - x0, y1 - y0);
+                getNumaReplica().applyBand(*srcTile, *dstTile, 0, y1 - y0);
+            }
+
+            if(bandDone && ++rowTiles[tileIdx / numTilesX]==numTilesX)
+            {
+                bandDone(y0, y1);
+            }
+        }
+    };
+
+    if(!executor)
     {
-        const std::vector<float> resImg
-            = {  0,            0,            0,            0,
-                 0.03728949f,  0.10394855f,  0.24695572f,  1,
-                 0.29089212f,  0.50935059f,  1.91091322f,  1,
-                64,           64,           64,            0 };
+        for(long taskIdx = 0; taskIdx<numTasks; ++taskIdx)
+        {
+            processTiles(taskIdx);
+        }
+        return;
+    }
 
-        ComputeValues<OCIO::BIT_DEPTH_F32,
-                      OCIO::BIT_DEPTH_F32, __LINE__>(processor,
-                                                     &f_inImg[0], OCIO::CHANNEL_ORDERING_RGBA,
-                                                     &resImg[0],  OCIO::CHANNEL_ORDERING_RGBA,
-                                                     NB_PIXELS,
-                                                     1e-7f);
+    // The tiles could be processed by the threads of a client executor.
+    const CPUCancellationToken * token = GetCurrentCancellationToken();
+
+    auto task = [&processTiles, token, overrides](long taskIdx)
+    {
+        CancellationGuard guard(token);
+        DynamicPropertyOverridesGuard overridesGuard(overrides);
+
+        processTiles(taskIdx);
+    };
+
+    if(numTasks<=1)
+    {
+        task(0);
+    }
+    else if(*executor)
+    {
+        (*executor)(numTasks, task);
+    }
+    else
+    {
+        GetCPUThreadPool()->parallelFor(numTasks, task);
     }
+}
 
+void CPUProcessor::Impl::applyBand(const ImageDesc & srcImgDesc, ImageDesc & dstImgDesc,
+                                   long yBegin, long yEnd) const
+{
+    // Only one check when the processing is not instrumented.
+    if(m_profiler && m_profiler->isEnabled())
     {
-        const std::vector<uint16_t> resImg
-            = {     0,     0,     0,     0,
-                 2444,  6812, 16184, 65535,
-                19064, 33380, 65535, 65535,
-                65535, 65535, 65535,     0 };
+        RendererTimer timer(*m_profiler);
+        applyBand(srcImgDesc, dstImgDesc, yBegin, yEnd, timer);
+    }
+    else
+    {
+        NoRendererTimer timer;
+        applyBand(srcImgDesc, dstImgDesc, yBegin, yEnd, timer);
+    }
+}
 
-        ComputeValues<OCIO::BIT_DEPTH_F32,
-                      OCIO::BIT_DEPTH_UINT16, __LINE__>(processor,
-                                                        &f_inImg[0], OCIO::CHANNEL_ORDERING_RGBA,
-                                                        &resImg[0],  OCIO::CHANNEL_ORDERING_RGBA,
-                                                        NB_PIXELS);
+template<typename Timer>
+void CPUProcessor::Impl::applyBand(const ImageDesc & srcImgDesc, ImageDesc & dstImgDesc,
+                                   long yBegin, long yEnd, Timer & timer) const
+{
+    if(applyBypass(srcImgDesc, dstImgDesc, yBegin, yEnd, timer))
+    {
+        return;
     }
 
-    const std::vector<uint16_t> ui16_inImg =
-        {    0,      8,    32,     0,
-            64,    128,   256,    32,
-           512,   1024,  2048,    64,
-          5120,  20480, 65535,   512 };
+    if(srcImgDesc.isPremultiplied() || dstImgDesc.isPremultiplied()
+        || (dstImgDesc.getDither()!=DITHER_NONE && !IsFloatBitDepth(m_outBitDepth)))
+    {
+        // The integer lookup, the planar & the packed RGB processing are bypassed as the
+        // scanline helper (un)premultiplies the color values, or dithers the output ones,
+        // in 32-bit float. Note that the CPU Ops of the engine are not the ones of the
+        // processor metadata so the processing is not profiled.
+
+        const ConstCastEngineRcPtr engine = getCastEngine();
+
+        std::unique_ptr<ScanlineHelper> scanlineBuilder(
+            CreateScanlineHelper(m_inBitDepth, engine->m_inBitDepthOp,
+                                 m_outBitDepth, engine->m_outBitDepthOp, m_touchesAlpha,
+                                 m_repeatedPixels));
+
+        if(&srcImgDesc==&dstImgDesc)
+        {
+            scanlineBuilder->init(dstImgDesc);
+        }
+        else
+        {
+            scanlineBuilder->init(srcImgDesc, dstImgDesc);
+        }
+        scanlineBuilder->setLineRange(yBegin, yEnd);
+
+        NoRendererTimer noTimer;
+        ProcessScanlines(*scanlineBuilder, engine->m_cpuOps, noTimer);
 
+        if(m_repeatedPixels)
+        {
+            AddRepeatedPixelsStats(*m_repeatedPixelsStats, dstImgDesc, yBegin, yEnd,
+                                   *scanlineBuilder);
+        }
+    }
+    else if(m_integerLookup)
     {
-        const std::vector<float> resImg
-            = {  0,           0.00036166f, 0.00144666f, 0,
-                 0.00187417f, 0.00271759f, 0.00408672f, 0.00048828f,
-                 0.00601041f, 0.00912247f, 0.01456576f, 0.00097657f,
-                 0.03030112f, 0.13105739f, 64,          0.00781261f };
+        ApplyIntegerLookup(*m_integerLookup, srcImgDesc, m_inBitDepth,
+                           dstImgDesc, m_outBitDepth, yBegin, yEnd, timer);
+    }
+    else if(!applyPlanar(srcImgDesc, dstImgDesc, yBegin, yEnd, timer)
+                && !applyRGB(srcImgDesc, dstImgDesc, yBegin, yEnd, timer))
+    {
+        // Each band has its own ScanlineHelper i.e. its own intermediate buffers.
+        ScanlineHelperGuard scanlineBuilder(*this);
 
-        ComputeValues<OCIO::BIT_DEPTH_UINT16,
-                      OCIO::BIT_DEPTH_F32, __LINE__>(processor,
-                                                     &ui16_inImg[0], OCIO::CHANNEL_ORDERING_RGBA,
-                                                     &resImg[0],  OCIO::CHANNEL_ORDERING_RGBA,
-                                                     NB_PIXELS, 1e-7f);
+        if(&srcImgDesc==&dstImgDesc)
+        {
+            scanlineBuilder->init(dstImgDesc);
+        }
+        else
+        {
+            scanlineBuilder->init(srcImgDesc, dstImgDesc);
+        }
+        scanlineBuilder->setLineRange(yBegin, yEnd);
+
+        ProcessScanlines(*scanlineBuilder, m_cpuOps, timer);
+
+        if(m_repeatedPixels)
+        {
+            AddRepeatedPixelsStats(*m_repeatedPixelsStats, dstImgDesc, yBegin, yEnd,
+                                   *scanlineBuilder);
+        }
     }
+}
 
+void CPUProcessor::Impl::apply(ImageDesc & imgDesc, const CPUExecutor & executor,
+                               const CPUBandCallback & bandDone,
+                               const DynamicPropertyOverrides * overrides) const
+{
+    if(const TiledImageDesc * tiledImg = GetTiledImage(imgDesc, imgDesc))
     {
-        const std::vector<uint16_t> resImg
-            = {     0,    24,    95,     0,
-                  123,   178,   268,    32,
-                  394,   598,   955,    64,
-                 1986,  8589, 65535,   512 };
-
-        ComputeValues<OCIO::BIT_DEPTH_UINT16,
-                      OCIO::BIT_DEPTH_UINT16, __LINE__>(processor,
-                                                        &ui16_inImg[0], OCIO::CHANNEL_ORDERING_RGBA,
-                                                        &resImg[0],  OCIO::CHANNEL_ORDERING_RGBA,
-                                                        NB_PIXELS);
+        applyTiles(*tiledImg, imgDesc, imgDesc, &executor, bandDone, overrides);
+        return;
     }
 
+    auto processBand = [this, &imgDesc, &bandDone, overrides](long yBegin, long yEnd)
     {
-        const std::vector<uint16_t> resImg
-            = {    95,    24,     0,     0,
-                  268,   178,   123,    32,
-                  955,   598,   394,    64,
-                65535,  8589,  1986,   512 };
+        // The band could be processed by any thread.
+        DynamicPropertyOverridesGuard guard(overrides);
 
-        ComputeValues<OCIO::BIT_DEPTH_UINT16,
-                      OCIO::BIT_DEPTH_UINT16, __LINE__>(processor,
-                                                        &ui16_inImg[0], OCIO::CHANNEL_ORDERING_BGRA,
-                                                        &resImg[0],  OCIO::CHANNEL_ORDERING_RGBA,
-                                                        NB_PIXELS);
-    }
+        getNumaReplica().applyBand(imgDesc, imgDesc, yBegin, yEnd);
+
+        if(bandDone)
+        {
+            bandDone(yBegin, yEnd);
+        }
+    };
+
+    ProcessBands(imgDesc.getROIWidth(), imgDesc.getROIHeight(), processBand, executor);
+}
 
+void CPUProcessor::Impl::apply(const ImageDesc & srcImgDesc, ImageDesc & dstImgDesc,
+                               const CPUExecutor & executor,
+                               const CPUBandCallback & bandDone,
+                               const DynamicPropertyOverrides * overrides) const
+{
+    if(srcImgDesc.getROIWidth()!=dstImgDesc.getROIWidth()
+        || srcImgDesc.getROIHeight()!=dstImgDesc.getROIHeight())
     {
-        const std::vector<uint16_t> resImg
-            = {    95,    24,     0,     0,
-                  268,   178,   123,    32,
-                  955,   598,   394,    64,
-                65535,  8589,  1986,   512 };
+        throw Exception("Dimension inconsistency between source and destination image buffers.");
+    }
 
-        ComputeValues<OCIO::BIT_DEPTH_UINT16,
-                      OCIO::BIT_DEPTH_UINT16, __LINE__>(processor,
-                                                        &ui16_inImg[0], OCIO::CHANNEL_ORDERING_RGBA,
-                                                        &resImg[0],  OCIO::CHANNEL_ORDERING_BGRA,
-                                                        NB_PIXELS);
+    if(const TiledImageDesc * tiledImg = GetTiledImage(srcImgDesc, dstImgDesc))
+    {
+        applyTiles(*tiledImg, srcImgDesc, dstImgDesc, &executor, bandDone, overrides);
+        return;
     }
 
+    auto processBand = [this, &srcImgDesc, &dstImgDesc, &bandDone, overrides](long yBegin,
+                                                                               long yEnd)
     {
-        const std::vector<uint16_t> resImg
-            = {    95,    24,     0,
-                  268,   178,   123,
-                  955,   598,   394,
-                65535,  8589,  1986 };
+        // The band could be processed by any thread.
+        DynamicPropertyOverridesGuard guard(overrides);
 
-        ComputeValues<OCIO::BIT_DEPTH_UINT16,
-                      OCIO::BIT_DEPTH_UINT16, __LINE__>(processor,
-                                                        &ui16_inImg[0], OCIO::CHANNEL_ORDERING_RGBA,
-                                                        &resImg[0],  OCIO::CHANNEL_ORDERING_BGR,
-                                                        NB_PIXELS);
+        getNumaReplica().applyBand(srcImgDesc, dstImgDesc, yBegin, yEnd);
+
+        if(bandDone)
+        {
+            bandDone(yBegin, yEnd);
+        }
+    };
+
+    ProcessBands(dstImgDesc.getROIWidth(), dstImgDesc.getROIHeight(), processBand, executor);
+}
+
+void CPUProcessor::Impl::validateOverrides(const DynamicPropertyOverrides & overrides) const
+{
+    static const DynamicPropertyType types[]
+        = { DYNAMIC_PROPERTY_EXPOSURE, DYNAMIC_PROPERTY_CONTRAST, DYNAMIC_PROPERTY_GAMMA };
+
+    for(const auto type : types)
+    {
+        if(overrides.hasValue(type))
+        {
+            // Throw if the processor does not have the dynamic property.
+            getDynamicProperty(type);
+        }
     }
+}
+
+std::future<void> CPUProcessor::Impl::applyAsync(ImageDesc & imgDesc,
+                                                 const CPUBandCallback & bandDone) const
+{
+    // The dedicated thread only drives the processing, the bands being processed
+    // by the internal thread pool.
+    return std::async(std::launch::async, [this, &imgDesc, bandDone]()
+                      {
+                          apply(imgDesc, CPUExecutor(), bandDone);
+                      });
+}
+
+std::future<void> CPUProcessor::Impl::applyAsync(const ImageDesc & srcImgDesc,
+                                                 ImageDesc & dstImgDesc,
+                                                 const CPUBandCallback & bandDone) const
+{
+    return std::async(std::launch::async, [this, &srcImgDesc, &dstImgDesc, bandDone]()
+                      {
+                          apply(srcImgDesc, dstImgDesc, CPUExecutor(), bandDone);
+                      });
+}
 
+std::future<void> CPUProcessor::Impl::applyAsync(ImageDesc & imgDesc,
+                                                 const CPUCancellationToken & token,
+                                                 const CPUBandCallback & bandDone) const
+{
+    return std::async(std::launch::async, [this, &imgDesc, &token, bandDone]()
+                      {
+                          CancellationGuard guard(&token);
+                          apply(imgDesc, CPUExecutor(), bandDone);
+                      });
+}
+
+std::future<void> CPUProcessor::Impl::applyAsync(const ImageDesc & srcImgDesc,
+                                                 ImageDesc & dstImgDesc,
+                                                 const CPUCancellationToken & token,
+                                                 const CPUBandCallback & bandDone) const
+{
+    return std::async(std::launch::async, [this, &srcImgDesc, &dstImgDesc, &token, bandDone]()
+                      {
+                          CancellationGuard guard(&token);
+                          apply(srcImgDesc, dstImgDesc, CPUExecutor(), bandDone);
+                      });
+}
+
+bool CPUProcessor::Impl::canBatch(const ImageDesc & srcImgDesc,
+                                  const ImageDesc & dstImgDesc) const
+{
+    // The integer lookup, the bypass & the repeated pixels statistics work per image, and
+    // the (un)premultiplication, the dithering & the YUV conversions need the scanline helpers.
+    // The tiled image buffers are processed tile by tile.
+    return !m_integerLookup && !m_isNoOp && !m_repeatedPixels
+        && !srcImgDesc.isPremultiplied() && !dstImgDesc.isPremultiplied()
+        && (dstImgDesc.getDither()==DITHER_NONE || IsFloatBitDepth(m_outBitDepth))
+        && !dynamic_cast<const YUVImageDesc *>(&srcImgDesc)
+        && !dynamic_cast<const YUVImageDesc *>(&dstImgDesc)
+        && !GetTiledImage(srcImgDesc, dstImgDesc);
+}
+
+void CPUProcessor::Impl::applyBatchBlocks(const ImageDesc * const * srcImgDescs,
+                                          ImageDesc * const * dstImgDescs,
+                                          const size_t * indices, size_t numIndices) const
+{
+    std::vector<BatchImage> images(numIndices);
+    for(size_t i = 0; i<numIndices; ++i)
     {
-        const std::vector<uint16_t> resImg
-            = {     0,    24,    95,     0,
-                  123,   178,   268,    32,
-                  394,   598,   955,    64,
-                 1986,  8589, 65535,    512 };
+        images[i].m_srcImg.init(*srcImgDescs[indices[i]], m_inBitDepth, m_inBitDepthOp);
+        images[i].m_dstImg.init(*dstImgDescs[indices[i]], m_outBitDepth, m_outBitDepthOp);
+    }
 
-        ComputeValues<OCIO::BIT_DEPTH_UINT16,
-                      OCIO::BIT_DEPTH_UINT16, __LINE__>(processor,
-                                                        &ui16_inImg[0], OCIO::CHANNEL_ORDERING_BGRA,
-                                                        &resImg[0],  OCIO::CHANNEL_ORDERING_BGRA,
-                                                        NB_PIXELS);
+    const long blockSize = GetCPUBlockSizeInPixels();
+
+    if(m_profiler && m_profiler->isEnabled())
+    {
+        RendererTimer timer(*m_profiler);
+        ApplyImageBlocks(m_inBitDepth, m_outBitDepth, images, m_cpuOps, blockSize, timer);
+    }
+    else
+    {
+        NoRendererTimer timer;
+        ApplyImageBlocks(m_inBitDepth, m_outBitDepth, images, m_cpuOps, blockSize, timer);
     }
+}
 
+void CPUProcessor::Impl::apply(const ImageDesc * const * srcImgDescs,
+                               ImageDesc * const * dstImgDescs,
+                               size_t numImages, const CPUExecutor * executor) const
+{
+    if(numImages==0)
     {
-        const std::vector<uint16_t> my_i_inImg =
-            {    0,      8,    32,
-                64,    128,   256,
-               512,   1024,  2048,
-              5120,  20480, 65535  };
+        return;
+    }
 
-        const std::vector<uint16_t> resImg
-            = {    95,    24,     0,     0,
-                  268,   178,   123,     0,
-                  955,   598,   394,     0,
-                65535,  8589,  1986,     0 };
+    if(!srcImgDescs || !dstImgDescs)
+    {
+        throw Exception("Invalid image buffer descriptions for the batch processing.");
+    }
 
-        ComputeValues<OCIO::BIT_DEPTH_UINT16,
-                      OCIO::BIT_DEPTH_UINT16, __LINE__>(processor,
-                                                        &my_i_inImg[0], OCIO::CHANNEL_ORDERING_RGB,
-                                                        &resImg[0],  OCIO::CHANNEL_ORDERING_BGRA,
-                                                        NB_PIXELS);
+    for(size_t idx = 0; idx<numImages; ++idx)
+    {
+        if(!srcImgDescs[idx] || !dstImgDescs[idx])
+        {
+            throw Exception("Invalid image buffer descriptions for the batch processing.");
+        }
+
+        if(srcImgDescs[idx]->getROIWidth()!=dstImgDescs[idx]->getROIWidth()
+            || srcImgDescs[idx]->getROIHeight()!=dstImgDescs[idx]->getROIHeight())
+        {
+            throw Exception("Dimension inconsistency between source and destination image buffers.");
+        }
     }
 
-    // Test OCIO::BIT_DEPTH_UINT10.
+    const long blockSize = GetCPUBlockSizeInPixels();
 
+    // The small images are grouped so each group (i.e. each task) processes at least
+    // MIN_PIXELS_PER_BAND pixels, in blocks spanning several images. The other images
+    // are processed one by one, as usual.
+
+    std::vector<size_t> batchIndices;
+    std::vector<size_t> groupEnds;
+    long long groupPixels = 0;
+
+    for(size_t idx = 0; idx<numImages; ++idx)
     {
-        const std::vector<uint16_t> ui10_resImg
-            = {     0,     0,     1,     0,
-                    2,     3,     4,     0,
-                    6,     9,    15,     1,
-                   31,   134,  1023,     8 };
+        const ImageDesc & srcImg = *srcImgDescs[idx];
+        ImageDesc & dstImg       = *dstImgDescs[idx];
 
-        ComputeValues<OCIO::BIT_DEPTH_UINT16,
-                      OCIO::BIT_DEPTH_UINT10, __LINE__>(processor,
-                                                        &ui16_inImg[0], OCIO::CHANNEL_ORDERING_RGBA,
-                                                        &ui10_resImg[0],  OCIO::CHANNEL_ORDERING_RGBA,
-                                                        NB_PIXELS);
+        const long long numPixels = (long long)dstImg.getROIWidth() * dstImg.getROIHeight();
+
+        if(numPixels>=blockSize || !canBatch(srcImg, dstImg))
+        {
+            if(executor)
+            {
+                apply(srcImg, dstImg, *executor);
+            }
+            else
+            {
+                apply(srcImg, dstImg);
+            }
+        }
+        else if(numPixels>0)
+        {
+            batchIndices.push_back(idx);
+            groupPixels += numPixels;
+
+            if(groupPixels>=MIN_PIXELS_PER_BAND)
+            {
+                groupEnds.push_back(batchIndices.size());
+                groupPixels = 0;
+            }
+        }
     }
 
+    if(groupPixels>0)
     {
-        const std::vector<uint16_t> ui10_inImg 
-            = {     0,     8,    32,
-                   64,   128,   256,
+        groupEnds.push_back(batchIndices.size());
+    }
+
+    const long numGroups = long(groupEnds.size());
+
+    auto task = [this, srcImgDescs, dstImgDescs, &batchIndices, &groupEnds](long groupIdx)
+    {
+        const size_t first = groupIdx==0 ? 0 : groupEnds[groupIdx - 1];
+        getNumaReplica().applyBatchBlocks(srcImgDescs, dstImgDescs, &batchIndices[first],
+                                          groupEnds[groupIdx] - first);
+    };
+
+    if(numGroups==0)
+    {
+        return;
+    }
+    else if(numGroups==1 || !executor)
+    {
+        for(long groupIdx = 0; groupIdx<numGroups; ++groupIdx)
+        {
+            task(groupIdx);
+        }
+    }
+    else if(*executor)
+    {
+        (*executor)(numGroups, task);
+    }
+    else
+    {
+        GetCPUThreadPool()->parallelFor(numGroups, task);
+    }
+}
+
+void CPUProcessor::Impl::applyOps(float * rgbaBuffer, long numPixels) const
+{
+    if(m_isNoOp && m_inBitDepth==m_outBitDepth)
+    {
+        return;
+    }
+
+    m_inBitDepthOp->apply(rgbaBuffer, rgbaBuffer, numPixels);
+
+    const size_t numOps = m_cpuOps.size();
+    for(size_t i = 0; i<numOps; ++i)
+    {
+        m_cpuOps[i]->apply(rgbaBuffer, rgbaBuffer, numPixels);
+    }
+
+    m_outBitDepthOp->apply(rgbaBuffer, rgbaBuffer, numPixels);
+}
+
+void CPUProcessor::Impl::applyRGB(float * pixel) const
+{
+    float v[4]{pixel[0], pixel[1], pixel[2], 0.0f};
+
+    applyOps(v, 1);
+
+    pixel[0] = v[0];
+    pixel[1] = v[1];
+    pixel[2] = v[2];
+}
+
+void CPUProcessor::Impl::applyRGBA(float * pixel) const
+{
+    applyOps(pixel, 1);
+}
+
+namespace
+{
+
+// The number of pixels of the intermediate buffer used by the batched pixel processing.
+constexpr long NUM_PIXELS_PER_BATCH = 256;
+
+void ValidateBatchedPixels(BitDepth in, BitDepth out, const float * pixels, long numPixels)
+{
+    if(in!=BIT_DEPTH_F32 || out!=BIT_DEPTH_F32)
+    {
+        throw Exception("Batched pixel processing only supports 32-bit float bit-depths.");
+    }
+
+    if(numPixels<0 || (numPixels>0 && pixels==nullptr))
+    {
+        throw Exception("Invalid pixel buffer.");
+    }
+}
+
+}
+
+void CPUProcessor::Impl::applyRGB(float * pixels, long numPixels, ptrdiff_t strideBytes) const
+{
+    ValidateBatchedPixels(m_inBitDepth, m_outBitDepth, pixels, numPixels);
+
+    if(m_isNoOp)
+    {
+        return;
+    }
+
+    if(strideBytes==AutoStride)
+    {
+        strideBytes = 3 * sizeof(float);
+    }
+
+    char * pixelPtr = reinterpret_cast<char *>(pixels);
+
+    float rgbaBuffer[4 * NUM_PIXELS_PER_BATCH];
+
+    for(long first=0; first<numPixels; first+=NUM_PIXELS_PER_BATCH)
+    {
+        const long count = std::min(numPixels - first, NUM_PIXELS_PER_BATCH);
+
+        // Gather the pixels in a packed RGBA buffer.
+        char * ptr = pixelPtr;
+        for(long idx=0; idx<count; ++idx, ptr+=strideBytes)
+        {
+            const float * rgb = reinterpret_cast<const float *>(ptr);
+            rgbaBuffer[4 * idx + 0] = rgb[0];
+            rgbaBuffer[4 * idx + 1] = rgb[1];
+            rgbaBuffer[4 * idx + 2] = rgb[2];
+            rgbaBuffer[4 * idx + 3] = 0.0f;
+        }
+
+        applyOps(rgbaBuffer, count);
+
+        // Scatter the results.
+        ptr = pixelPtr;
+        for(long idx=0; idx<count; ++idx, ptr+=strideBytes)
+        {
+            float * rgb = reinterpret_cast<float *>(ptr);
+            rgb[0] = rgbaBuffer[4 * idx + 0];
+            rgb[1] = rgbaBuffer[4 * idx + 1];
+            rgb[2] = rgbaBuffer[4 * idx + 2];
+        }
+
+        pixelPtr = ptr;
+    }
+}
+
+void CPUProcessor::Impl::applyRGBA(float * pixels, long numPixels, ptrdiff_t strideBytes) const
+{
+    ValidateBatchedPixels(m_inBitDepth, m_outBitDepth, pixels, numPixels);
+
+    if(m_isNoOp)
+    {
+        return;
+    }
+
+    if(strideBytes==AutoStride || strideBytes==ptrdiff_t(4 * sizeof(float)))
+    {
+        // Packed pixels are directly processed in place, block by block.
+        const long blockSize = GetCPUBlockSizeInPixels();
+        for(long first=0; first<numPixels; first+=blockSize)
+        {
+            applyOps(pixels + 4 * first, std::min(numPixels - first, blockSize));
+        }
+        return;
+    }
+
+    char * pixelPtr = reinterpret_cast<char *>(pixels);
+
+    float rgbaBuffer[4 * NUM_PIXELS_PER_BATCH];
+
+    for(long first=0; first<numPixels; first+=NUM_PIXELS_PER_BATCH)
+    {
+        const long count = std::min(numPixels - first, NUM_PIXELS_PER_BATCH);
+
+        // Gather the pixels in a packed RGBA buffer.
+        char * ptr = pixelPtr;
+        for(long idx=0; idx<count; ++idx, ptr+=strideBytes)
+        {
+            const float * rgba = reinterpret_cast<const float *>(ptr);
+            rgbaBuffer[4 * idx + 0] = rgba[0];
+            rgbaBuffer[4 * idx + 1] = rgba[1];
+            rgbaBuffer[4 * idx + 2] = rgba[2];
+            rgbaBuffer[4 * idx + 3] = rgba[3];
+        }
+
+        applyOps(rgbaBuffer, count);
+
+        // Scatter the results.
+        ptr = pixelPtr;
+        for(long idx=0; idx<count; ++idx, ptr+=strideBytes)
+        {
+            float * rgba = reinterpret_cast<float *>(ptr);
+            rgba[0] = rgbaBuffer[4 * idx + 0];
+            rgba[1] = rgbaBuffer[4 * idx + 1];
+            rgba[2] = rgbaBuffer[4 * idx + 2];
+            rgba[3] = rgbaBuffer[4 * idx + 3];
+        }
+
+        pixelPtr = ptr;
+    }
+}
+
+void CPUProcessor::Impl::profileRenderers(float * pixels, long numPixels, double * times) const
+{
+    ValidateBatchedPixels(m_inBitDepth, m_outBitDepth, pixels, numPixels);
+
+    if(!times)
+    {
+        throw Exception("Invalid renderer time array.");
+    }
+
+    // Align the times with the renderers of the processor metadata.
+    const size_t first = m_integerLookup ? 1 : 0;
+    const size_t numOps = m_cpuOps.size();
+
+    const long blockSize = GetCPUBlockSizeInPixels();
+    for(long firstPixel=0; firstPixel<numPixels; firstPixel+=blockSize)
+    {
+        float * rgbaBuffer = pixels + 4 * firstPixel;
+        const long count = std::min(numPixels - firstPixel, blockSize);
+
+        auto start = std::chrono::steady_clock::now();
+        m_inBitDepthOp->apply(rgbaBuffer, rgbaBuffer, count);
+        times[first] += GetElapsedTime(start);
+
+        for(size_t i = 0; i<numOps; ++i)
+        {
+            start = std::chrono::steady_clock::now();
+            m_cpuOps[i]->apply(rgbaBuffer, rgbaBuffer, count);
+            times[first + 1 + i] += GetElapsedTime(start);
+        }
+
+        start = std::chrono::steady_clock::now();
+        m_outBitDepthOp->apply(rgbaBuffer, rgbaBuffer, count);
+        times[first + 1 + numOps] += GetElapsedTime(start);
+    }
+}
+
+void CPUProcessor::Impl::setProfilingEnabled(bool enabled) const
+{
+    m_profiler->setEnabled(enabled);
+}
+
+bool CPUProcessor::Impl::isProfilingEnabled() const
+{
+    return m_profiler->isEnabled();
+}
+
+void CPUProcessor::Impl::getProfilingStats(double * times, long long * numPixels) const
+{
+    m_profiler->get(times, numPixels);
+}
+
+void CPUProcessor::Impl::resetProfilingStats() const
+{
+    m_profiler->reset();
+}
+
+void CPUProcessor::Impl::getRepeatedPixelsStats(long long & numPixels,
+                                                long long & numEvaluatedPixels) const
+{
+    numPixels          = m_repeatedPixelsStats->m_numPixels;
+    numEvaluatedPixels = m_repeatedPixelsStats->m_numEvaluatedPixels;
+}
+
+void CPUProcessor::Impl::resetRepeatedPixelsStats() const
+{
+    m_repeatedPixelsStats->m_numPixels = 0;
+    m_repeatedPixelsStats->m_numEvaluatedPixels = 0;
+}
+
+size_t CPUProcessor::Impl::getEngineMemorySize() const
+{
+    size_t numBytes = 0;
+
+    if(m_inBitDepthOp)
+    {
+        numBytes += m_inBitDepthOp->getMemorySize();
+    }
+    for(const auto & op : m_cpuOps)
+    {
+        numBytes += op->getMemorySize();
+    }
+    if(m_outBitDepthOp)
+    {
+        numBytes += m_outBitDepthOp->getMemorySize();
+    }
+    if(m_integerLookup)
+    {
+        numBytes += m_integerLookup->getMemorySize();
+    }
+
+    return numBytes;
+}
+
+void CPUProcessor::Impl::writeSourceCode(const char * functionName, std::ostream & os) const
+{
+    if(m_renderOnly)
+    {
+        throw Exception("A render-only CPU processor releases its ops so its source code "
+                        "could not be written.");
+    }
+    if(m_inBitDepth!=BIT_DEPTH_F32 || m_outBitDepth!=BIT_DEPTH_F32)
+    {
+        throw Exception("Only the source code of the 32-bit float CPU processors "
+                        "could be written.");
+    }
+
+    WriteCPUSourceCode(m_ops, m_cacheID, functionName, os);
+}
+
+size_t CPUProcessor::Impl::getMemoryFootprint() const
+{
+    size_t numBytes = sizeof(Impl) + m_cacheID.capacity()
+                    + GetOpVecMemorySize(m_ops) + getEngineMemorySize();
+
+    // The replicas share the ops but have their own tables.
+    std::lock_guard<std::mutex> lock(m_numaReplicasMutex);
+    for(const auto & replica : m_numaReplicas)
+    {
+        if(replica)
+        {
+            numBytes += sizeof(Impl) + replica->getEngineMemorySize();
+        }
+    }
+
+    return numBytes;
+}
+
+
+
+
+//////////////////////////////////////////////////////////////////////////
+
+
+
+
+void CPUProcessor::deleter(CPUProcessor * c)
+{
+    delete c;
+}
+
+CPUProcessor::CPUProcessor()
+    :   m_impl(new Impl)
+{
+}
+
+CPUProcessor::~CPUProcessor()
+{
+    delete m_impl;
+    m_impl = nullptr;
+}
+
+bool CPUProcessor::hasChannelCrosstalk() const
+{
+    return getImpl()->hasChannelCrosstalk();
+}
+
+const char * CPUProcessor::getCacheID() const
+{
+    return getImpl()->getCacheID();
+}
+
+ConstProcessorMetadataRcPtr CPUProcessor::getProcessorMetadata() const
+{
+    return getImpl()->getProcessorMetadata();
+}
+
+BitDepth CPUProcessor::getInputBitDepth() const
+{
+    return getImpl()->getInputBitDepth();
+}
+
+BitDepth CPUProcessor::getOutputBitDepth() const
+{
+    return getImpl()->getOutputBitDepth();
+}
+
+DynamicPropertyRcPtr CPUProcessor::getDynamicProperty(DynamicPropertyType type) const
+{
+    return getImpl()->getDynamicProperty(type);
+}
+
+void CPUProcessor::apply(ImageDesc & imgDesc) const
+{
+    getImpl()->apply(imgDesc);
+}
+
+void CPUProcessor::apply(const ImageDesc & srcImgDesc, ImageDesc & dstImgDesc) const
+{
+    getImpl()->apply(srcImgDesc, dstImgDesc);
+}
+
+void CPUProcessor::apply(ImageDesc & imgDesc, const CPUExecutor & executor) const
+{
+    getImpl()->apply(imgDesc, executor);
+}
+
+void CPUProcessor::apply(const ImageDesc & srcImgDesc, ImageDesc & dstImgDesc,
+                         const CPUExecutor & executor) const
+{
+    getImpl()->apply(srcImgDesc, dstImgDesc, executor);
+}
+
+void CPUProcessor::apply(ImageDesc & imgDesc, const DynamicPropertyOverrides & overrides) const
+{
+    getImpl()->validateOverrides(overrides);
+
+    DynamicPropertyOverridesGuard guard(&overrides);
+    getImpl()->apply(imgDesc);
+}
+
+void CPUProcessor::apply(const ImageDesc & srcImgDesc, ImageDesc & dstImgDesc,
+                         const DynamicPropertyOverrides & overrides) const
+{
+    getImpl()->validateOverrides(overrides);
+
+    DynamicPropertyOverridesGuard guard(&overrides);
+    getImpl()->apply(srcImgDesc, dstImgDesc);
+}
+
+void CPUProcessor::apply(ImageDesc & imgDesc, const CPUExecutor & executor,
+                         const DynamicPropertyOverrides & overrides) const
+{
+    getImpl()->validateOverrides(overrides);
+    getImpl()->apply(imgDesc, executor, CPUBandCallback(), &overrides);
+}
+
+void CPUProcessor::apply(const ImageDesc & srcImgDesc, ImageDesc & dstImgDesc,
+                         const CPUExecutor & executor,
+                         const DynamicPropertyOverrides & overrides) const
+{
+    getImpl()->validateOverrides(overrides);
+    getImpl()->apply(srcImgDesc, dstImgDesc, executor, CPUBandCallback(), &overrides);
+}
+
+void CPUProcessor::apply(const ImageDesc * const * srcImgDescs, ImageDesc * const * dstImgDescs,
+                         size_t numImages) const
+{
+    getImpl()->apply(srcImgDescs, dstImgDescs, numImages, nullptr);
+}
+
+void CPUProcessor::apply(const ImageDesc * const * srcImgDescs, ImageDesc * const * dstImgDescs,
+                         size_t numImages, const CPUExecutor & executor) const
+{
+    getImpl()->apply(srcImgDescs, dstImgDescs, numImages, &executor);
+}
+
+std::future<void> CPUProcessor::applyAsync(ImageDesc & imgDesc,
+                                           const CPUBandCallback & bandDone) const
+{
+    return getImpl()->applyAsync(imgDesc, bandDone);
+}
+
+std::future<void> CPUProcessor::applyAsync(const ImageDesc & srcImgDesc, ImageDesc & dstImgDesc,
+                                           const CPUBandCallback & bandDone) const
+{
+    return getImpl()->applyAsync(srcImgDesc, dstImgDesc, bandDone);
+}
+
+void CPUProcessor::apply(ImageDesc & imgDesc, const CPUExecutor & executor,
+                         const CPUCancellationToken & token) const
+{
+    CancellationGuard guard(&token);
+    getImpl()->apply(imgDesc, executor);
+}
+
+void CPUProcessor::apply(const ImageDesc & srcImgDesc, ImageDesc & dstImgDesc,
+                         const CPUExecutor & executor, const CPUCancellationToken & token) const
+{
+    CancellationGuard guard(&token);
+    getImpl()->apply(srcImgDesc, dstImgDesc, executor);
+}
+
+std::future<void> CPUProcessor::applyAsync(ImageDesc & imgDesc,
+                                           const CPUCancellationToken & token,
+                                           const CPUBandCallback & bandDone) const
+{
+    return getImpl()->applyAsync(imgDesc, token, bandDone);
+}
+
+std::future<void> CPUProcessor::applyAsync(const ImageDesc & srcImgDesc, ImageDesc & dstImgDesc,
+                                           const CPUCancellationToken & token,
+                                           const CPUBandCallback & bandDone) const
+{
+    return getImpl()->applyAsync(srcImgDesc, dstImgDesc, token, bandDone);
+}
+
+void CPUProcessor::applyRGB(float * pixel) const
+{
+    getImpl()->applyRGB(pixel);
+}
+
+void CPUProcessor::applyRGBA(float * pixel) const
+{
+    getImpl()->applyRGBA(pixel);
+}
+
+void CPUProcessor::applyRGB(float * pixels, long numPixels) const
+{
+    getImpl()->applyRGB(pixels, numPixels, AutoStride);
+}
+
+void CPUProcessor::applyRGB(float * pixels, long numPixels, ptrdiff_t strideBytes) const
+{
+    getImpl()->applyRGB(pixels, numPixels, strideBytes);
+}
+
+void CPUProcessor::applyRGBA(float * pixels, long numPixels) const
+{
+    getImpl()->applyRGBA(pixels, numPixels, AutoStride);
+}
+
+void CPUProcessor::applyRGBA(float * pixels, long numPixels, ptrdiff_t strideBytes) const
+{
+    getImpl()->applyRGBA(pixels, numPixels, strideBytes);
+}
+
+void CPUProcessor::profileRenderers(float * pixels, long numPixels, double * times) const
+{
+    getImpl()->profileRenderers(pixels, numPixels, times);
+}
+
+void CPUProcessor::setProfilingEnabled(bool enabled) const
+{
+    getImpl()->setProfilingEnabled(enabled);
+}
+
+bool CPUProcessor::isProfilingEnabled() const
+{
+    return getImpl()->isProfilingEnabled();
+}
+
+void CPUProcessor::getProfilingStats(double * times, long long * numPixels) const
+{
+    getImpl()->getProfilingStats(times, numPixels);
+}
+
+void CPUProcessor::resetProfilingStats() const
+{
+    getImpl()->resetProfilingStats();
+}
+
+void CPUProcessor::getRepeatedPixelsStats(long long & numPixels,
+                                          long long & numEvaluatedPixels) const
+{
+    getImpl()->getRepeatedPixelsStats(numPixels, numEvaluatedPixels);
+}
+
+void CPUProcessor::resetRepeatedPixelsStats() const
+{
+    getImpl()->resetRepeatedPixelsStats();
+}
+
+size_t CPUProcessor::getMemoryFootprint() const
+{
+    return getImpl()->getMemoryFootprint();
+}
+
+void CPUProcessor::writeSourceCode(const char * functionName, std::ostream & os) const
+{
+    getImpl()->writeSourceCode(functionName, os);
+}
+
+
+namespace
+{
+
+// A packed RGBA 32-bit float line reused by all the lines of the image i.e. its line stride
+// is zero. A processor group converts each source line into it, and then from it to each
+// destination image buffer.
+class LineBufferImageDesc : public ImageDesc
+{
+public:
+    LineBufferImageDesc() = delete;
+    LineBufferImageDesc(const LineBufferImageDesc &) = delete;
+    LineBufferImageDesc & operator=(const LineBufferImageDesc &) = delete;
+
+    LineBufferImageDesc(float * line, long width, long height)
+        :   ImageDesc()
+        ,   m_line(line)
+        ,   m_width(width)
+        ,   m_height(height)
+    {
+    }
+
+    void * getRData() const override { return m_line; }
+    void * getGData() const override { return m_line + 1; }
+    void * getBData() const override { return m_line + 2; }
+    void * getAData() const override { return m_line + 3; }
+
+    BitDepth getBitDepth() const override { return BIT_DEPTH_F32; }
+
+    long getWidth() const override { return m_width; }
+    long getHeight() const override { return m_height; }
+
+    ptrdiff_t getXStrideBytes() const override { return 4 * sizeof(float); }
+    ptrdiff_t getYStrideBytes() const override { return 0; }
+
+    bool isRGBAPacked() const override { return true; }
+    bool isFloat() const override { return true; }
+
+private:
+    float * m_line;
+    long m_width;
+    long m_height;
+};
+
+// Are the chroma samples of the image buffer shared by two lines (i.e. a 4:2:0 YUV image
+// buffer)? Such lines could not be encoded one by one.
+bool HasSubsampledLines(const ImageDesc & img)
+{
+    const YUVImageDesc * yuvImg = dynamic_cast<const YUVImageDesc*>(&img);
+    return yuvImg && yuvImg->getLayout()!=YUV_LAYOUT_I422;
+}
+
+}
+
+class CPUProcessorGroup::Impl
+{
+public:
+    Impl() = default;
+    Impl(const Impl &) = delete;
+    Impl& operator=(const Impl &) = delete;
+
+    ~Impl() = default;
+
+    void finalize(const ConstProcessorRcPtr * processors, size_t numProcessors,
+                  BitDepth inBitDepth, const BitDepth * outBitDepths,
+                  OptimizationFlags oFlags, FinalizationFlags fFlags)
+    {
+        if(!processors || numProcessors==0)
+        {
+            throw Exception("A CPU processor group needs at least one processor.");
+        }
+        if(!outBitDepths)
+        {
+            throw Exception("The output bit-depths of the CPU processor group are missing.");
+        }
+
+        std::vector<const OpRcPtrVec *> ops(numProcessors);
+        for(size_t idx=0; idx<numProcessors; ++idx)
+        {
+            if(!processors[idx])
+            {
+                throw Exception("The CPU processor group holds a null processor.");
+            }
+            ops[idx] = &processors[idx]->getImpl()->getOps();
+        }
+
+        // Find the ops shared by the start of all the processors, the dynamic properties
+        // being owned by each processor.
+
+        size_t numShared = 0;
+        for(bool shared = true; shared; )
+        {
+            shared = numShared<ops[0]->size() && !(*ops[0])[numShared]->isDynamic();
+
+            const std::string cacheID = shared ? (*ops[0])[numShared]->getCacheID() : "";
+            for(size_t idx=1; idx<numProcessors && shared; ++idx)
+            {
+                shared = numShared<ops[idx]->size()
+                            && (*ops[idx])[numShared]->getCacheID()==cacheID;
+            }
+
+            numShared += shared ? 1 : 0;
+        }
+
+        m_numSharedOps = numShared;
+
+        // The shared ops produce the 32-bit float values processed by the remaining ops
+        // of each processor.
+
+        OpRcPtrVec sharedOps;
+        sharedOps.insert(sharedOps.end(), ops[0]->begin(), ops[0]->begin() + numShared);
+
+        m_sharedProcessor.reset(new CPUProcessor::Impl);
+        m_sharedProcessor->finalize(sharedOps, inBitDepth, BIT_DEPTH_F32, oFlags, fFlags);
+
+        m_processors.clear();
+        for(size_t idx=0; idx<numProcessors; ++idx)
+        {
+            OpRcPtrVec remainingOps;
+            remainingOps.insert(remainingOps.end(),
+                                ops[idx]->begin() + numShared, ops[idx]->end());
+
+            std::unique_ptr<CPUProcessor::Impl> processor(new CPUProcessor::Impl);
+            processor->finalize(remainingOps, BIT_DEPTH_F32, outBitDepths[idx], oFlags, fFlags);
+
+            m_processors.push_back(std::move(processor));
+        }
+    }
+
+    size_t getNumProcessors() const noexcept { return m_processors.size(); }
+    size_t getNumSharedOps() const noexcept { return m_numSharedOps; }
+
+    BitDepth getInputBitDepth() const noexcept { return m_sharedProcessor->getInputBitDepth(); }
+
+    BitDepth getOutputBitDepth(size_t index) const
+    {
+        if(index>=m_processors.size())
+        {
+            throw Exception("Invalid processor index of the CPU processor group.");
+        }
+        return m_processors[index]->getOutputBitDepth();
+    }
+
+    void apply(const ImageDesc & srcImgDesc, ImageDesc * const * dstImgDescs,
+               const CPUExecutor & executor) const
+    {
+        if(!dstImgDescs)
+        {
+            throw Exception("The destination image buffers of the CPU processor group "
+                            "are missing.");
+        }
+
+        const long width  = srcImgDesc.getROIWidth();
+        const long height = srcImgDesc.getROIHeight();
+
+        for(size_t idx=0; idx<m_processors.size(); ++idx)
+        {
+            if(!dstImgDescs[idx])
+            {
+                throw Exception("The CPU processor group holds a null destination image buffer.");
+            }
+            if(dstImgDescs[idx]->getROIWidth()!=width || dstImgDescs[idx]->getROIHeight()!=height)
+            {
+                throw Exception("Dimension inconsistency between source and destination "
+                                "image buffers.");
+            }
+            if(HasSubsampledLines(*dstImgDescs[idx]))
+            {
+                throw Exception("The CPU processor group does not support 4:2:0 YUV "
+                                "destination image buffers.");
+            }
+        }
+
+        auto processBand = [this, &srcImgDesc, dstImgDescs, width, height](long yBegin, long yEnd)
+        {
+            // Each band has its own line buffer, which stays in the CPU caches as each
+            // line is converted to all the destination image buffers before the next one.
+            std::vector<float> line(4 * width);
+            LineBufferImageDesc lineDesc(&line[0], width, height);
+
+            for(long y=yBegin; y<yEnd; ++y)
+            {
+                m_sharedProcessor->applyLines(srcImgDesc, lineDesc, y, y + 1);
+
+                for(size_t idx=0; idx<m_processors.size(); ++idx)
+                {
+                    m_processors[idx]->applyLines(lineDesc, *dstImgDescs[idx], y, y + 1);
+                }
+            }
+        };
+
+        ProcessBands(width, height, processBand, executor);
+    }
+
+private:
+    size_t m_numSharedOps = 0;
+
+    // Process the shared ops from the input bit-depth to 32-bit float.
+    std::unique_ptr<CPUProcessor::Impl> m_sharedProcessor;
+    // Process the remaining ops of each processor from 32-bit float to its output bit-depth.
+    std::vector<std::unique_ptr<CPUProcessor::Impl>> m_processors;
+};
+
+ConstCPUProcessorGroupRcPtr CPUProcessorGroup::Create(const ConstProcessorRcPtr * processors,
+                                                      size_t numProcessors,
+                                                      BitDepth inBitDepth,
+                                                      const BitDepth * outBitDepths,
+                                                      OptimizationFlags oFlags,
+                                                      FinalizationFlags fFlags)
+{
+    CPUProcessorGroupRcPtr group(new CPUProcessorGroup(), &CPUProcessorGroup::deleter);
+    group->getImpl()->finalize(processors, numProcessors, inBitDepth, outBitDepths,
+                               oFlags, fFlags);
+    return group;
+}
+
+void CPUProcessorGroup::deleter(CPUProcessorGroup * c)
+{
+    delete c;
+}
+
+CPUProcessorGroup::CPUProcessorGroup()
+    :   m_impl(new Impl)
+{
+}
+
+CPUProcessorGroup::~CPUProcessorGroup()
+{
+    delete m_impl;
+    m_impl = nullptr;
+}
+
+size_t CPUProcessorGroup::getNumProcessors() const
+{
+    return getImpl()->getNumProcessors();
+}
+
+size_t CPUProcessorGroup::getNumSharedOps() const
+{
+    return getImpl()->getNumSharedOps();
+}
+
+BitDepth CPUProcessorGroup::getInputBitDepth() const
+{
+    return getImpl()->getInputBitDepth();
+}
+
+BitDepth CPUProcessorGroup::getOutputBitDepth(size_t index) const
+{
+    return getImpl()->getOutputBitDepth(index);
+}
+
+void CPUProcessorGroup::apply(const ImageDesc & srcImgDesc, ImageDesc * const * dstImgDescs) const
+{
+    // All the bands are processed by the calling thread.
+    getImpl()->apply(srcImgDesc, dstImgDescs,
+                     [](long numTasks, const std::function<void(long)> & task)
+                     {
+                         for(long idx=0; idx<numTasks; ++idx)
+                         {
+                             task(idx);
+                         }
+                     });
+}
+
+void CPUProcessorGroup::apply(const ImageDesc & srcImgDesc, ImageDesc * const * dstImgDescs,
+                              const CPUExecutor & executor) const
+{
+    getImpl()->apply(srcImgDesc, dstImgDescs, executor);
+}
+
+}
+OCIO_NAMESPACE_EXIT
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+
+
+
+#ifdef OCIO_UNIT_TEST
+
+namespace OCIO = OCIO_NAMESPACE;
+
+#include "MathUtils.h"
+#include "ops/Log/LogOps.h"
+#include "ops/Lut1D/Lut1DOp.h"
+#include "ops/Lut1D/Lut1DOpData.h"
+#include "ops/Lut3D/Lut3DOp.h"
+#include "ops/Range/RangeOps.h"
+#include "ScanlineHelper.h"
+#include "UnitTest.h"
+#include "UnitTestUtils.h"
+
+
+OCIO_ADD_TEST(CPUProcessor, flag_composition)
+{
+    // The test validates the build of a custom optimization flag.
+
+    OCIO::OptimizationFlags customFlags = OCIO::OPTIMIZATION_LOSSLESS;
+
+    OCIO_CHECK_EQUAL((customFlags & OCIO::OPTIMIZATION_COMP_LUT1D),
+                     OCIO::OPTIMIZATION_NONE);
+
+    customFlags
+        = OCIO::OptimizationFlags(customFlags | OCIO::OPTIMIZATION_COMP_LUT1D);
+
+    OCIO_CHECK_EQUAL((customFlags & OCIO::OPTIMIZATION_COMP_LUT1D),
+                     OCIO::OPTIMIZATION_COMP_LUT1D);
+}
+
+
+// TODO: CPUProcessor being part of the OCIO public API limits the ability
+//       to inspect the CPUProcessor instance content i.e. the list of CPUOps.
+//       Even a successful apply could hide a major performance hit because of
+//       a missing/partial optimization.
+
+
+template<OCIO::BitDepth inBD, OCIO::BitDepth outBD, unsigned line>
+OCIO::ConstCPUProcessorRcPtr ComputeValues(OCIO::ConstProcessorRcPtr processor,
+                                           const void * inImg,
+                                           OCIO::ChannelOrdering inChans,
+                                           const void * resImg,
+                                           OCIO::ChannelOrdering outChans,
+                                           long numPixels,
+                                           // Default value to nan to break any float comparisons
+                                           // as a valid error threshold is mandatory in that case.
+                                           float absErrorThreshold
+                                                = std::numeric_limits<float>::quiet_NaN())
+{
+    typedef typename OCIO::BitDepthInfo<inBD>::Type inType;
+    typedef typename OCIO::BitDepthInfo<outBD>::Type outType;
+
+    OCIO::ConstCPUProcessorRcPtr cpuProcessor;
+
+    OCIO_CHECK_NO_THROW_FROM(cpuProcessor
+        = processor->getOptimizedCPUProcessor(inBD, outBD,
+                                              OCIO::OPTIMIZATION_DEFAULT,
+                                              OCIO::FINALIZATION_DEFAULT), line);
+
+    size_t numChannels = 4;
+    if(outChans==OCIO::CHANNEL_ORDERING_RGB || outChans==OCIO::CHANNEL_ORDERING_BGR)
+    {
+        numChannels = 3;
+    }
+    const size_t numValues = size_t(numPixels * numChannels);
+
+    const OCIO::PackedImageDesc srcImgDesc((void *)inImg, numPixels, 1,
+                                           inChans,
+                                           inBD,
+                                           sizeof(inType),
+                                           OCIO::AutoStride,
+                                           OCIO::AutoStride);
+
+    std::vector<outType> out(numValues);
+    OCIO::PackedImageDesc dstImgDesc(&out[0], numPixels, 1,
+                                     outChans,
+                                     outBD,
+                                     sizeof(outType),
+                                     OCIO::AutoStride,
+                                     OCIO::AutoStride);
+
+    OCIO_CHECK_NO_THROW_FROM(cpuProcessor->apply(srcImgDesc, dstImgDesc), line);
+
+    const outType * res = reinterpret_cast<const outType*>(resImg);
+
+    for(size_t idx=0; idx<numValues; ++idx)
+    {
+        if(OCIO::BitDepthInfo<outBD>::isFloat)
+        {
+            OCIO_CHECK_CLOSE_FROM(out[idx], res[idx], absErrorThreshold, line);
+        }
+        else
+        {
+            OCIO_CHECK_EQUAL_FROM(out[idx], res[idx], line);
+        }
+    }
+
+    return cpuProcessor;
+}
+
+OCIO_ADD_TEST(CPUProcessor, with_one_matrix)
+{
+    // The unit test validates that pixel formats are correctly
+    // processed when the op list contains only one arbitrary Op
+    // (except a 1D LUT one which has dedicated optimizations).
+
+    OCIO::ConfigRcPtr config = OCIO::Config::Create();
+
+    OCIO::MatrixTransformRcPtr transform = OCIO::MatrixTransform::Create();
+    constexpr double offset4[4] = { 1.4002, 0.4005, 0.0807, 0.5 };
+    transform->setOffset( offset4 );
+
+    OCIO::ConstProcessorRcPtr processor;
+    OCIO_CHECK_NO_THROW(processor = config->getProcessor(transform));
+
+    constexpr unsigned NB_PIXELS = 3;
+
+    const std::vector<float> f_inImg =
+        {  -1.0000f, -0.8000f, -0.1000f,  0.0f,
+            0.1023f,  0.5045f,  1.5089f,  1.0f,
+            1.0000f,  1.2500f,  1.9900f,  0.0f  };
+
+    {
+        const std::vector<float> resImg
+            = { 0.4002f, -0.3995f, -0.0193f,  0.5000f,
+                1.5025f,  0.9050f,  1.5896f,  1.5000f,
+                2.4002f,  1.6505f,  2.0707f,  0.5000f };
+
+        ComputeValues<OCIO::BIT_DEPTH_F32,
+                      OCIO::BIT_DEPTH_F32, __LINE__>(processor,
+                                                     &f_inImg[0], OCIO::CHANNEL_ORDERING_RGBA,
+                                                     &resImg[0],  OCIO::CHANNEL_ORDERING_RGBA,
+                                                     NB_PIXELS,
+                                                     1e-5f);
+    }
+
+    {
+        const std::vector<float> resImg
+            = { -0.9193f,   -0.3995f,  1.3002f,  0.5000f,
+                 0.182999f,  0.9050f,  2.9091f,  1.5000f,
+                 1.0807f,    1.6505f,  3.3902f,  0.5000f };
+
+        ComputeValues<OCIO::BIT_DEPTH_F32,
+                      OCIO::BIT_DEPTH_F32, __LINE__>(processor,
+                                                     &f_inImg[0], OCIO::CHANNEL_ORDERING_BGRA,
+                                                     &resImg[0],  OCIO::CHANNEL_ORDERING_BGRA,
+                                                     NB_PIXELS,
+                                                     1e-5f);
+    }
+
+    {
+        const std::vector<float> resImg
+            = {  -0.500000f, -0.719300f, 0.300500f, 1.400200f,
+                  0.602300f,  0.585199f, 1.909399f, 2.400200f,
+                  1.500000f,  1.330700f, 2.390500f, 1.400200f  };
+
+        ComputeValues<OCIO::BIT_DEPTH_F32,
+                      OCIO::BIT_DEPTH_F32, __LINE__>(processor,
+                                                     &f_inImg[0], OCIO::CHANNEL_ORDERING_ABGR,
+                                                     &resImg[0],  OCIO::CHANNEL_ORDERING_ABGR,
+                                                     NB_PIXELS,
+                                                     1e-5f);
+    }
+
+    {
+        const std::vector<float> resImg
+            = { -0.0193f, -0.3995f,  0.4002f,  0.5000f,
+                 1.5896f,  0.9050f,  1.5025f,  1.5000f,
+                 2.0707f,  1.6505f,  2.4002f,  0.5000f };
+
+        ComputeValues<OCIO::BIT_DEPTH_F32,
+                      OCIO::BIT_DEPTH_F32, __LINE__>(processor,
+                                                     &f_inImg[0], OCIO::CHANNEL_ORDERING_RGBA,
+                                                     &resImg[0],  OCIO::CHANNEL_ORDERING_BGRA,
+                                                     NB_PIXELS,
+                                                     1e-5f);
+    }
+
+    {
+        const std::vector<float> resImg
+            = { 0.5000f, -0.0193f, -0.3995f, 0.4002f,
+                1.5000f,  1.5896f,  0.9050f, 1.5025f,
+                0.5000f,  2.0707f,  1.6505f, 2.4002f  };
+
+        ComputeValues<OCIO::BIT_DEPTH_F32,
+                      OCIO::BIT_DEPTH_F32, __LINE__>(processor,
+                                                     &f_inImg[0], OCIO::CHANNEL_ORDERING_RGBA,
+                                                     &resImg[0],  OCIO::CHANNEL_ORDERING_ABGR,
+                                                     NB_PIXELS,
+                                                     1e-5f);
+    }
+
+    {
+        const std::vector<float> inImg =
+            {  -1.0000f, -0.8000f, -0.1000f,
+                0.1023f,  0.5045f,  1.5089f,
+                1.0000f,  1.2500f,  1.9900f  };
+
+        const std::vector<float> resImg
+            = { 0.4002f, -0.3995f, -0.0193f,
+                1.5025f,  0.9050f,  1.5896f,
+                2.4002f,  1.6505f,  2.0707f };
+
+        ComputeValues<OCIO::BIT_DEPTH_F32,
+                      OCIO::BIT_DEPTH_F32, __LINE__>(processor,
+                                                     &inImg[0],  OCIO::CHANNEL_ORDERING_RGB,
+                                                     &resImg[0], OCIO::CHANNEL_ORDERING_RGB,
+                                                     NB_PIXELS,
+                                                     1e-5f);
+    }
+
+    {
+        const std::vector<float> inImg =
+            {    -1.0000f,    -0.8000f, -0.1000f,
+                   0.1023f,    0.5045f,  1.5089f,
+                   1.0000f,    1.2500f,  1.9900f  };
+
+        const std::vector<float> resImg
+            = { -0.919300f, -0.399500f,  1.300199f,
+                 0.182999f,  0.905000f,  2.909100f,
+                 1.080700f,  1.650500f,  3.390200f };
+
+        ComputeValues<OCIO::BIT_DEPTH_F32,
+                      OCIO::BIT_DEPTH_F32, __LINE__>(processor,
+                                                     &inImg[0],  OCIO::CHANNEL_ORDERING_BGR,
+                                                     &resImg[0], OCIO::CHANNEL_ORDERING_BGR,
+                                                     NB_PIXELS,
+                                                     1e-5f);
+    }
+
+    {
+        const std::vector<float> inImg =
+            {  -1.0000f, -0.8000f, -0.1000f,
+                0.1023f,  0.5045f,  1.5089f,
+                1.0000f,  1.2500f,  1.9900f  };
+
+        const std::vector<float> resImg
+            = { -0.01929f,  -0.3995f,  0.4002f,
+                 1.58960f,   0.9050f,  1.5025f,
+                 2.070699f,  1.6505f,  2.4002f };
+
+        ComputeValues<OCIO::BIT_DEPTH_F32,
+                      OCIO::BIT_DEPTH_F32, __LINE__>(processor,
+                                                     &inImg[0],  OCIO::CHANNEL_ORDERING_RGB,
+                                                     &resImg[0], OCIO::CHANNEL_ORDERING_BGR,
+                                                     NB_PIXELS,
+                                                     1e-5f);
+    }
+
+    {
+        const std::vector<float> inImg =
+            {  -1.0000f, -0.8000f, -0.1000f,
+                0.1023f,  0.5045f,  1.5089f,
+                1.0000f,  1.2500f,  1.9900f  };
+
+        const std::vector<float> resImg
+            = { -0.01929f,  -0.3995f,  0.4002f, 0.5f,
+                 1.58960f,   0.9050f,  1.5025f, 0.5f,
+                 2.070699f,  1.6505f,  2.4002f, 0.5f   };
+
+        ComputeValues<OCIO::BIT_DEPTH_F32,
+                      OCIO::BIT_DEPTH_F32, __LINE__>(processor,
+                                                     &inImg[0],  OCIO::CHANNEL_ORDERING_RGB,
+                                                     &resImg[0], OCIO::CHANNEL_ORDERING_BGRA,
+                                                     NB_PIXELS,
+                                                     1e-5f);
+    }
+
+    {
+        const std::vector<float> inImg =
+            {  -1.0000f, -0.8000f, -0.1000f,  0.0f,
+                0.1023f,  0.5045f,  1.5089f,  1.0f,
+                1.0000f,  1.2500f,  1.9900f,  0.0f  };
+
+        const std::vector<float> resImg
+            = { -0.01929f,  -0.3995f,  0.4002f,
+                 1.58960f,   0.9050f,  1.5025f,
+                 2.070699f,  1.6505f,  2.4002f   };
+
+        ComputeValues<OCIO::BIT_DEPTH_F32,
+                      OCIO::BIT_DEPTH_F32, __LINE__>(processor,
+                                                     &inImg[0],  OCIO::CHANNEL_ORDERING_RGBA,
+                                                     &resImg[0], OCIO::CHANNEL_ORDERING_BGR,
+                                                     NB_PIXELS,
+                                                     1e-5f);
+    }
+
+    const std::vector<uint16_t> ui16_inImg =
+        {    0,      8,    32,  0,
+            64,    128,   256,  0,
+          5120,  20140, 65535,  0  };
+
+    {
+        const std::vector<float> resImg
+            = { 1.40020000f,  0.40062206f,  0.08118829f,  0.5f,
+                1.40117657f,  0.40245315f,  0.08460631f,  0.5f,
+                1.47832620f,  0.70781672f,  1.08070004f,  0.5f };
+
+        ComputeValues<OCIO::BIT_DEPTH_UINT16,
+                      OCIO::BIT_DEPTH_F32, __LINE__>(processor,
+                                                     &ui16_inImg[0], OCIO::CHANNEL_ORDERING_RGBA,
+                                                     &resImg[0],  OCIO::CHANNEL_ORDERING_RGBA,
+                                                     NB_PIXELS,
+                                                     1e-5f);
+    }
+
+    {
+        const std::vector<uint16_t> resImg
+            = { 65535, 26255,  5321, 32768,
+                65535, 26375,  5545, 32768,
+                65535, 46387, 65535, 32768 };
+
+        ComputeValues<OCIO::BIT_DEPTH_UINT16,
+                      OCIO::BIT_DEPTH_UINT16, __LINE__>(processor,
+                                                        &ui16_inImg[0], OCIO::CHANNEL_ORDERING_RGBA,
+                                                        &resImg[0],  OCIO::CHANNEL_ORDERING_RGBA,
+                                                        NB_PIXELS);
+    }
+
+    {
+        const std::vector<uint16_t> resImg
+            = {  5321, 26255, 65535, 32768,
+                 5545, 26375, 65535, 32768,
+                65535, 46387, 65535, 32768 };
+
+        ComputeValues<OCIO::BIT_DEPTH_UINT16,
+                      OCIO::BIT_DEPTH_UINT16, __LINE__>(processor,
+                                                        &ui16_inImg[0], OCIO::CHANNEL_ORDERING_RGBA,
+                                                        &resImg[0],  OCIO::CHANNEL_ORDERING_BGRA,
+                                                        NB_PIXELS);
+    }
+
+    {
+        const std::vector<uint16_t> resImg
+            = {  5321, 26255, 65535,
+                 5545, 26375, 65535,
+                65535, 46387, 65535 };
+
+        ComputeValues<OCIO::BIT_DEPTH_UINT16,
+                      OCIO::BIT_DEPTH_UINT16, __LINE__>(processor,
+                                                        &ui16_inImg[0], OCIO::CHANNEL_ORDERING_RGBA,
+                                                        &resImg[0],  OCIO::CHANNEL_ORDERING_BGR,
+                                                        NB_PIXELS);
+    }
+
+    {
+        const std::vector<uint8_t> resImg
+            = { 255, 102,  21, 128,
+                255, 103,  22, 128,
+                255, 180, 255, 128 };
+
+        ComputeValues<OCIO::BIT_DEPTH_UINT16,
+                      OCIO::BIT_DEPTH_UINT8, __LINE__>(processor,
+                                                       &ui16_inImg[0], OCIO::CHANNEL_ORDERING_RGBA,
+                                                       &resImg[0],  OCIO::CHANNEL_ORDERING_RGBA,
+                                                       NB_PIXELS);
+    }
+
+    {
+        const std::vector<uint8_t> resImg
+            = {  21, 102, 255,
+                 22, 103, 255,
+                255, 180, 255 };
+
+        ComputeValues<OCIO::BIT_DEPTH_UINT16,
+                      OCIO::BIT_DEPTH_UINT8, __LINE__>(processor,
+                                                       &ui16_inImg[0], OCIO::CHANNEL_ORDERING_RGBA,
+                                                       &resImg[0],  OCIO::CHANNEL_ORDERING_BGR,
+                                                       NB_PIXELS);
+    }
+
+    {
+        const std::vector<uint8_t> resImg
+            = { 128,  21, 102, 255,
+                128,  22, 103, 255,
+                128, 255, 180, 255 };
+
+        ComputeValues<OCIO::BIT_DEPTH_UINT16,
+                      OCIO::BIT_DEPTH_UINT8, __LINE__>(processor,
+                                                       &ui16_inImg[0], OCIO::CHANNEL_ORDERING_RGBA,
+                                                       &resImg[0],  OCIO::CHANNEL_ORDERING_ABGR,
+                                                       NB_PIXELS);
+    }
+
+    // Test OCIO::BIT_DEPTH_UINT10.
+
+    {
+        const std::vector<uint16_t> ui10_resImg
+            = { 1023,  410,   83,  512,
+                1023,  412,   87,  512,
+                1023,  724, 1023,  512 };
+
+        ComputeValues<OCIO::BIT_DEPTH_UINT16,
+                      OCIO::BIT_DEPTH_UINT10, __LINE__>(processor,
+                                                        &ui16_inImg[0], OCIO::CHANNEL_ORDERING_RGBA,
+                                                        &ui10_resImg[0],  OCIO::CHANNEL_ORDERING_RGBA,
+                                                        NB_PIXELS);
+
+        const std::vector<uint16_t> ui10_inImg
+            = {    0,    8,   12,  256,
+                 128,   16,   64,  512,
+                1023,   32,   96,  512 };
+
+        const std::vector<uint16_t> ui16_resImg
+            = { 65535, 26759,  6057, 49167,
+                65535, 27272,  9389, 65535,
+                65535, 28297, 11439, 65535 };
+
+        ComputeValues<OCIO::BIT_DEPTH_UINT10,
+                      OCIO::BIT_DEPTH_UINT16, __LINE__>(processor,
+                                                        &ui10_inImg[0], OCIO::CHANNEL_ORDERING_RGBA,
+                                                        &ui16_resImg[0],  OCIO::CHANNEL_ORDERING_RGBA,
+                                                        NB_PIXELS);
+    }
+
+    // Test OCIO::BIT_DEPTH_UINT12.
+
+    {
+        const std::vector<uint16_t> ui12_resImg
+            = { 4095, 1641,  332, 2048,
+                4095, 1648,  346, 2048,
+                4095, 2899, 4095, 2048 };
+
+        ComputeValues<OCIO::BIT_DEPTH_UINT16,
+                      OCIO::BIT_DEPTH_UINT12, __LINE__>(processor,
+                                                        &ui16_inImg[0], OCIO::CHANNEL_ORDERING_RGBA,
+                                                        &ui12_resImg[0],  OCIO::CHANNEL_ORDERING_RGBA,
+                                                        NB_PIXELS);
+
+        const std::vector<uint16_t> ui12_inImg
+            = {     0,    8,    12,   1024,
+                 2048,   16,    64,   2048,
+                 4095,   32,    96,   4095 };
+
+        const std::vector<uint16_t> ui16_resImg
+            = { 65535, 26375,  5481, 49155,
+                65535, 26503,  6313, 65535,
+                65535, 26759,  6825, 65535 };
+
+        ComputeValues<OCIO::BIT_DEPTH_UINT12,
+                      OCIO::BIT_DEPTH_UINT16, __LINE__>(processor,
+                                                        &ui12_inImg[0], OCIO::CHANNEL_ORDERING_RGBA,
+                                                        &ui16_resImg[0],  OCIO::CHANNEL_ORDERING_RGBA,
+                                                        NB_PIXELS);
+    }
+}
+
+OCIO_ADD_TEST(CPUProcessor, with_one_1d_lut)
+{
+    // The unit test validates that pixel formats are correctly
+    // processed when the op list only contains one 1D LUT because it
+    // has a dedicated optimization when the input bit-depth is an integer type.
+
+    const std::string filePath
+        = std::string(OCIO::getTestFilesDir()) + "/lut1d_5.spi1d";
+
+    OCIO::FileTransformRcPtr transform = OCIO::FileTransform::Create();
+    transform->setDirection(OCIO::TRANSFORM_DIR_FORWARD);
+    transform->setSrc(filePath.c_str());
+    transform->setInterpolation(OCIO::INTERP_LINEAR);
+
+    OCIO::ConfigRcPtr config = OCIO::Config::Create();
+
+    OCIO::ConstProcessorRcPtr processor;
+    OCIO_CHECK_NO_THROW(processor = config->getProcessor(transform));
+
+    constexpr unsigned NB_PIXELS = 4;
+
+    const std::vector<float> f_inImg =
+        {  -1.0000f, -0.8000f, -0.1000f,  0.0f,
+            0.1002f,  0.2509f,  0.5009f,  1.0f,
+            0.5505f,  0.7090f,  0.9099f,  1.0f,
+            1.0000f,  1.2500f,  1.9900f,  0.0f  };
+
+    {
+        const std::vector<float> resImg
+            = {  0,            0,            0,            0,
+                 0.03728949f,  0.10394855f,  0.24695572f,  1,
+                 0.29089212f,  0.50935059f,  1.91091322f,  1,
+                64,           64,           64,            0 };
+
+        ComputeValues<OCIO::BIT_DEPTH_F32,
+                      OCIO::BIT_DEPTH_F32, __LINE__>(processor,
+                                                     &f_inImg[0], OCIO::CHANNEL_ORDERING_RGBA,
+                                                     &resImg[0],  OCIO::CHANNEL_ORDERING_RGBA,
+                                                     NB_PIXELS,
+                                                     1e-7f);
+    }
+
+    {
+        const std::vector<uint16_t> resImg
+            = {     0,     0,     0,     0,
+                 2444,  6812, 16184, 65535,
+                19064, 33380, 65535, 65535,
+                65535, 65535, 65535,     0 };
+
+        ComputeValues<OCIO::BIT_DEPTH_F32,
+                      OCIO::BIT_DEPTH_UINT16, __LINE__>(processor,
+                                                        &f_inImg[0], OCIO::CHANNEL_ORDERING_RGBA,
+                                                        &resImg[0],  OCIO::CHANNEL_ORDERING_RGBA,
+                                                        NB_PIXELS);
+    }
+
+    const std::vector<uint16_t> ui16_inImg =
+        {    0,      8,    32,     0,
+            64,    128,   256,    32,
+           512,   1024,  2048,    64,
+          5120,  20480, 65535,   512 };
+
+    {
+        const std::vector<float> resImg
+            = {  0,           0.00036166f, 0.00144666f, 0,
+                 0.00187417f, 0.00271759f, 0.00408672f, 0.00048828f,
+                 0.00601041f, 0.00912247f, 0.01456576f, 0.00097657f,
+                 0.03030112f, 0.13105739f, 64,          0.00781261f };
+
+        ComputeValues<OCIO::BIT_DEPTH_UINT16,
+                      OCIO::BIT_DEPTH_F32, __LINE__>(processor,
+                                                     &ui16_inImg[0], OCIO::CHANNEL_ORDERING_RGBA,
+                                                     &resImg[0],  OCIO::CHANNEL_ORDERING_RGBA,
+                                                     NB_PIXELS, 1e-7f);
+    }
+
+    {
+        const std::vector<uint16_t> resImg
+            = {     0,    24,    95,     0,
+                  123,   178,   268,    32,
+                  394,   598,   955,    64,
+                 1986,  8589, 65535,   512 };
+
+        ComputeValues<OCIO::BIT_DEPTH_UINT16,
+                      OCIO::BIT_DEPTH_UINT16, __LINE__>(processor,
+                                                        &ui16_inImg[0], OCIO::CHANNEL_ORDERING_RGBA,
+                                                        &resImg[0],  OCIO::CHANNEL_ORDERING_RGBA,
+                                                        NB_PIXELS);
+    }
+
+    {
+        const std::vector<uint16_t> resImg
+            = {    95,    24,     0,     0,
+                  268,   178,   123,    32,
+                  955,   598,   394,    64,
+                65535,  8589,  1986,   512 };
+
+        ComputeValues<OCIO::BIT_DEPTH_UINT16,
+                      OCIO::BIT_DEPTH_UINT16, __LINE__>(processor,
+                                                        &ui16_inImg[0], OCIO::CHANNEL_ORDERING_BGRA,
+                                                        &resImg[0],  OCIO::CHANNEL_ORDERING_RGBA,
+                                                        NB_PIXELS);
+    }
+
+    {
+        const std::vector<uint16_t> resImg
+            = {    95,    24,     0,     0,
+                  268,   178,   123,    32,
+                  955,   598,   394,    64,
+                65535,  8589,  1986,   512 };
+
+        ComputeValues<OCIO::BIT_DEPTH_UINT16,
+                      OCIO::BIT_DEPTH_UINT16, __LINE__>(processor,
+                                                        &ui16_inImg[0], OCIO::CHANNEL_ORDERING_RGBA,
+                                                        &resImg[0],  OCIO::CHANNEL_ORDERING_BGRA,
+                                                        NB_PIXELS);
+    }
+
+    {
+        const std::vector<uint16_t> resImg
+            = {    95,    24,     0,
+                  268,   178,   123,
+                  955,   598,   394,
+                65535,  8589,  1986 };
+
+        ComputeValues<OCIO::BIT_DEPTH_UINT16,
+                      OCIO::BIT_DEPTH_UINT16, __LINE__>(processor,
+                                                        &ui16_inImg[0], OCIO::CHANNEL_ORDERING_RGBA,
+                                                        &resImg[0],  OCIO::CHANNEL_ORDERING_BGR,
+                                                        NB_PIXELS);
+    }
+
+    {
+        const std::vector<uint16_t> resImg
+            = {     0,    24,    95,     0,
+                  123,   178,   268,    32,
+                  394,   598,   955,    64,
+                 1986,  8589, 65535,    512 };
+
+        ComputeValues<OCIO::BIT_DEPTH_UINT16,
+                      OCIO::BIT_DEPTH_UINT16, __LINE__>(processor,
+                                                        &ui16_inImg[0], OCIO::CHANNEL_ORDERING_BGRA,
+                                                        &resImg[0],  OCIO::CHANNEL_ORDERING_BGRA,
+                                                        NB_PIXELS);
+    }
+
+    {
+        const std::vector<uint16_t> my_i_inImg =
+            {    0,      8,    32,
+                64,    128,   256,
+               512,   1024,  2048,
+              5120,  20480, 65535  };
+
+        const std::vector<uint16_t> resImg
+            = {    95,    24,     0,     0,
+                  268,   178,   123,     0,
+                  955,   598,   394,     0,
+                65535,  8589,  1986,     0 };
+
+        ComputeValues<OCIO::BIT_DEPTH_UINT16,
+                      OCIO::BIT_DEPTH_UINT16, __LINE__>(processor,
+                                                        &my_i_inImg[0], OCIO::CHANNEL_ORDERING_RGB,
+                                                        &resImg[0],  OCIO::CHANNEL_ORDERING_BGRA,
+                                                        NB_PIXELS);
+    }
+
+    // Test OCIO::BIT_DEPTH_UINT10.
+
+    {
+        const std::vector<uint16_t> ui10_resImg
+            = {     0,     0,     1,     0,
+                    2,     3,     4,     0,
+                    6,     9,    15,     1,
+                   31,   134,  1023,     8 };
+
+        ComputeValues<OCIO::BIT_DEPTH_UINT16,
+                      OCIO::BIT_DEPTH_UINT10, __LINE__>(processor,
+                                                        &ui16_inImg[0], OCIO::CHANNEL_ORDERING_RGBA,
+                                                        &ui10_resImg[0],  OCIO::CHANNEL_ORDERING_RGBA,
+                                                        NB_PIXELS);
+    }
+
+    {
+        const std::vector<uint16_t> ui10_inImg 
+            = {     0,     8,    32,
+                   64,   128,   256,
                    96,   256,   512,
                   128,  1023,   640  };
 
-        const std::vector<uint16_t> ui10_resImg
-            = {     0,     6,    15,   0,
-                   26,    48,   106,   0,
-                   36,   106,   252,   0,
-                   48,  1023,   384,   0 };
+        const std::vector<uint16_t> ui10_resImg
+            = {     0,     6,    15,   0,
+                   26,    48,   106,   0,
+                   36,   106,   252,   0,
+                   48,  1023,   384,   0 };
+
+        ComputeValues<OCIO::BIT_DEPTH_UINT10,
+                      OCIO::BIT_DEPTH_UINT10, __LINE__>(processor,
+                                                        &ui10_inImg[0], OCIO::CHANNEL_ORDERING_RGB,
+                                                        &ui10_resImg[0],  OCIO::CHANNEL_ORDERING_RGBA,
+                                                        NB_PIXELS);
+
+        const std::vector<uint16_t> ui16_resImg
+            = {     0,   394,   955,   0,
+                 1656,  3092,  6794,   0,
+                 2301,  6794, 16162,   0,
+                 3092, 65535, 24593,   0 };
+
+        ComputeValues<OCIO::BIT_DEPTH_UINT10,
+                      OCIO::BIT_DEPTH_UINT16, __LINE__>(processor,
+                                                        &ui10_inImg[0], OCIO::CHANNEL_ORDERING_RGB,
+                                                        &ui16_resImg[0],  OCIO::CHANNEL_ORDERING_RGBA,
+                                                        NB_PIXELS);
+    }
+
+    // Test OCIO::BIT_DEPTH_UINT12.
+
+    {
+        const std::vector<uint16_t> ui12_resImg
+            = {     0,     1,     6,     0,
+                    8,    11,    17,     2,
+                   25,    37,    60,     4,
+                  124,   537,  4095,    32 };
+
+        ComputeValues<OCIO::BIT_DEPTH_UINT16,
+                      OCIO::BIT_DEPTH_UINT12, __LINE__>(processor,
+                                                        &ui16_inImg[0], OCIO::CHANNEL_ORDERING_RGBA,
+                                                        &ui12_resImg[0],  OCIO::CHANNEL_ORDERING_RGBA,
+                                                        NB_PIXELS);
+    }
+
+    {
+        const std::vector<uint16_t> ui12_inImg 
+            = {     0,     8,    32,
+                   64,   128,   256,
+                   96,   256,   512,
+                 1024,  2048,  4095  };
+
+        const std::vector<uint16_t> ui12_resImg
+            = {     0,    11,    25,   0,
+                   37,    60,   103,   0,
+                   49,   103,   193,   0,
+                  424,  1009,  4095,   0 };
+
+        ComputeValues<OCIO::BIT_DEPTH_UINT12,
+                      OCIO::BIT_DEPTH_UINT12, __LINE__>(processor,
+                                                        &ui12_inImg[0], OCIO::CHANNEL_ORDERING_RGB,
+                                                        &ui12_resImg[0],  OCIO::CHANNEL_ORDERING_RGBA,
+                                                        NB_PIXELS);
+        const std::vector<uint16_t> ui16_resImg
+            = {     0,   178,   394,   0,
+                  598,   955,  1655,   0,
+                  779,  1655,  3089,   0,
+                 6789, 16143, 65535,   0 };
+
+        ComputeValues<OCIO::BIT_DEPTH_UINT12,
+                      OCIO::BIT_DEPTH_UINT16, __LINE__>(processor,
+                                                        &ui12_inImg[0], OCIO::CHANNEL_ORDERING_RGB,
+                                                        &ui16_resImg[0],  OCIO::CHANNEL_ORDERING_RGBA,
+                                                        NB_PIXELS);
+    }
+
+}
+
+OCIO_ADD_TEST(CPUProcessor, with_several_ops)
+{
+    // The unit test validates that pixel formats are correctly
+    // processed when the op list starts or ends with a 1D LUT because it
+    // has a dedicated optimization when the input bit-depth is an integer type.
+
+    const std::string SIMPLE_PROFILE =
+        "ocio_profile_version: 2\n"
+        "\n"
+        "search_path: " + std::string(OCIO::getTestFilesDir()) + "\n"
+        "strictparsing: true\n"
+        "luma: [0.2126, 0.7152, 0.0722]\n"
+        "\n"
+        "roles:\n"
+        "  default: cs1\n"
+        "  scene_linear: cs2\n"
+        "\n"
+        "displays:\n"
+        "  sRGB:\n"
+        "    - !<View> {name: Raw, colorspace: cs1}\n"
+        "\n"
+        "colorspaces:\n"
+        "  - !<ColorSpace>\n"
+        "    name: cs1\n"
+        "    allocation: uniform\n"
+        "\n"
+        "  - !<ColorSpace>\n"
+        "    name: cs2\n"
+        "    allocation: uniform\n";
+
+    // Step 1: The 1D LUT is the last Op.
+
+    {
+        const std::string strEnd =
+            "    from_reference: !<GroupTransform>\n"
+            "      children:\n"
+            "        - !<MatrixTransform> { offset: [-0.19, 0.19, -0.00019, 0] }\n"
+            "        - !<FileTransform>   { src: lut1d_5.spi1d, interpolation: linear }\n";
+
+        const std::string str = SIMPLE_PROFILE + strEnd;
+
+        std::istringstream is;
+        is.str(str);
+
+        OCIO::ConstConfigRcPtr config;
+        OCIO_CHECK_NO_THROW(config = OCIO::Config::CreateFromStream(is));
+        OCIO_CHECK_NO_THROW(config->sanityCheck());
+
+        OCIO::ConstProcessorRcPtr processor;
+        OCIO_CHECK_NO_THROW(processor = config->getProcessor("cs1", "cs2"));
+
+        constexpr unsigned NB_PIXELS = 4;
+
+        const std::vector<float> f_inImg =
+            {  -1.0000f, -0.8000f, -0.1000f,  0.0f,
+                0.1002f,  0.2509f,  0.5009f,  1.0f,
+                0.5505f,  0.7090f,  0.9099f,  1.0f,
+                1.0000f,  1.2500f,  1.9900f,  0.0f  };
+
+        {
+            const std::vector<float> resImg
+                = {  0.0f,         0.0f,         0.0f,         0.0f,
+                     0.0f,         0.20273837f,  0.24680146f,  1.0f,
+                     0.15488569f,  1.69210147f,  1.90666747f,  1.0f,
+                     0.81575858f, 64.0f,        64.0f,         0.0f };
+
+            ComputeValues<OCIO::BIT_DEPTH_F32,
+                          OCIO::BIT_DEPTH_F32, __LINE__>(processor,
+                                                         &f_inImg[0], OCIO::CHANNEL_ORDERING_RGBA,
+                                                         &resImg[0],  OCIO::CHANNEL_ORDERING_RGBA,
+                                                         NB_PIXELS, 1e-7f);
+        }
+
+        {
+            const std::vector<uint16_t> resImg
+                = {     0,     0,     0,     0,
+                        0, 13286, 16174, 65535,
+                    10150, 65535, 65535, 65535,
+                    53461, 65535, 65535,     0 };
+
+            ComputeValues<OCIO::BIT_DEPTH_F32,
+                          OCIO::BIT_DEPTH_UINT16, __LINE__>(processor,
+                                                            &f_inImg[0], OCIO::CHANNEL_ORDERING_RGBA,
+                                                            &resImg[0],  OCIO::CHANNEL_ORDERING_RGBA,
+                                                            NB_PIXELS);
+        }
+
+        const std::vector<uint16_t> i_inImg =
+            {    0,      8,    32,  0,
+                64,    128,   256,  65535,
+               512,   1024,  2048,  0,
+              5120,  20480, 65535,  65535  };
+
+        {
+            const std::vector<float> resImg
+                = {  0.0f,  0.07789713f,  0.00088374f,  0.0f,
+                     0.0f,  0.07871927f,  0.00396248f,  1.0f,
+                     0.0f,  0.08474064f,  0.01450117f,  0.0f,
+                     0.0f,  0.24826171f, 56.39490891f,  1.0f };
+
+            auto cpuProcessor = ComputeValues<OCIO::BIT_DEPTH_UINT16,
+                                              OCIO::BIT_DEPTH_F32,
+                                              __LINE__>(processor, 
+                                                        &i_inImg[0], OCIO::CHANNEL_ORDERING_RGBA, 
+                                                        &resImg[0],  OCIO::CHANNEL_ORDERING_RGBA, 
+                                                        NB_PIXELS, 1e-7f);
+
+            const std::string cacheID{ cpuProcessor->getCacheID() };
+
+            const std::string expectedID("CPU Processor: from 16ui to 32f oFlags 3839 fFlags 1 ops $");
+            OCIO_CHECK_EQUAL(cacheID.substr(0, expectedID.size()), expectedID);
+            OCIO_CHECK_EQUAL(cacheID.size(), expectedID.size() + 32);
+
+            // Test integer optimization. The separable prefix is only replaced by a 16-bit
+            // look-up LUT when it is cheaper (refer to Op::getCost()), which is not the case
+            // of the offset and the small 1D LUT. The CPU processor still evaluates the whole
+            // processing into per-channel lookup tables (i.e. OPTIMIZATION_LOOKUP_INTEGER_INPUT).
+            OCIO::ConstProcessorMetadataRcPtr metadata = cpuProcessor->getProcessorMetadata();
+            OCIO_REQUIRE_EQUAL(metadata->getNumOptimizedOps(), 2);
+            OCIO_CHECK_EQUAL(std::string(metadata->getOptimizedOp(0)), "<MatrixOffsetOp>");
+            OCIO_CHECK_EQUAL(std::string(metadata->getOptimizedOp(1)), "<Lut1DOp>");
+        }
+
+        {
+            const std::vector<uint16_t> resImg
+                = {     0,  5105,    58,     0,
+                        0,  5159,   260,     65535,
+                        0,  5553,   950,     0,
+                        0, 16270, 65535,     65535 };
+
+            ComputeValues<OCIO::BIT_DEPTH_UINT16,
+                          OCIO::BIT_DEPTH_UINT16, __LINE__>(processor,
+                                                            &i_inImg[0], OCIO::CHANNEL_ORDERING_RGBA,
+                                                            &resImg[0],  OCIO::CHANNEL_ORDERING_RGBA,
+                                                            NB_PIXELS);
+        }
+
+        {
+            const std::vector<uint16_t> resImg
+                = {     0,  5105,     0,     0,
+                        0,  5159,   112,     65535,
+                        0,  5553,   388,     0,
+                    53461, 16270,  1982,     65535 };
+
+            ComputeValues<OCIO::BIT_DEPTH_UINT16,
+                          OCIO::BIT_DEPTH_UINT16, __LINE__>(processor,
+                                                            &i_inImg[0], OCIO::CHANNEL_ORDERING_BGRA,
+                                                            &resImg[0],  OCIO::CHANNEL_ORDERING_RGBA,
+                                                            NB_PIXELS);
+        }
+
+        {
+            const std::vector<uint16_t> resImg
+                = {    58,  5105,     0,     0,
+                      260,  5159,     0,     65535,
+                      950,  5553,     0,     0,
+                    65535, 16270,     0,     65535 };
+
+            ComputeValues<OCIO::BIT_DEPTH_UINT16,
+                          OCIO::BIT_DEPTH_UINT16, __LINE__>(processor,
+                                                            &i_inImg[0], OCIO::CHANNEL_ORDERING_RGBA,
+                                                            &resImg[0],  OCIO::CHANNEL_ORDERING_BGRA,
+                                                            NB_PIXELS);
+        }
+
+        {
+            const std::vector<uint16_t> resImg
+                = {     0,  5105,     0,     0,
+                      112,  5159,     0,     65535,
+                      388,  5553,     0,     0,
+                     1982, 16270, 53461,     65535 };
+
+            ComputeValues<OCIO::BIT_DEPTH_UINT16,
+                          OCIO::BIT_DEPTH_UINT16, __LINE__>(processor,
+                                                            &i_inImg[0], OCIO::CHANNEL_ORDERING_BGRA,
+                                                            &resImg[0],  OCIO::CHANNEL_ORDERING_BGRA,
+                                                            NB_PIXELS);
+        }
+    }
+
+    // Step 2: The 1D LUT is the first Op.
+
+    {
+        const std::string strEnd =
+            "    from_reference: !<GroupTransform>\n"
+            "      children:\n"
+            "        - !<FileTransform>   { src: lut1d_5.spi1d, interpolation: linear }\n"
+            "        - !<MatrixTransform> { offset: [-0.19, 0.19, -0.00019, 0] }\n";
+
+        const std::string str = SIMPLE_PROFILE + strEnd;
+
+        std::istringstream is;
+        is.str(str);
+
+        OCIO::ConstConfigRcPtr config;
+        OCIO_CHECK_NO_THROW(config = OCIO::Config::CreateFromStream(is));
+        OCIO_CHECK_NO_THROW(config->sanityCheck());
+
+        OCIO::ConstProcessorRcPtr processor;
+        OCIO_CHECK_NO_THROW(processor = config->getProcessor("cs1", "cs2"));
+
+        const unsigned NB_PIXELS = 4;
+
+        const std::vector<float> f_inImg =
+            {  -1.0000f, -0.8000f, -0.1000f,  0.0f,
+                0.1002f,  0.2509f,  0.5009f,  1.0f,
+                0.5505f,  0.7090f,  0.9099f,  1.0f,
+                1.0000f,  1.2500f,  1.9900f,  0.0f  };
+
+        {
+            const std::vector<float> resImg
+                = { -0.18999999f,  0.18999999f, -0.00019000f,  0.0f,
+                    -0.15271049f,  0.29394856f,  0.24676571f,  1.0f,
+                     0.10089212f,  0.69935059f,  1.91072320f,  1.0f,
+                    63.81000137f, 64.19000244f, 63.99980927f,  0.0f };
+
+            ComputeValues<OCIO::BIT_DEPTH_F32,
+                          OCIO::BIT_DEPTH_F32, __LINE__>(processor,
+                                                         &f_inImg[0], OCIO::CHANNEL_ORDERING_RGBA,
+                                                         &resImg[0],  OCIO::CHANNEL_ORDERING_RGBA,
+                                                         NB_PIXELS, 1e-7f);
+        }
+
+        {
+            const std::vector<uint16_t> resImg
+                = {     0, 12452,     0,     0,
+                        0, 19264, 16172, 65535,
+                     6612, 45832, 65535, 65535,
+                    65535, 65535, 65535,     0 };
+
+            ComputeValues<OCIO::BIT_DEPTH_F32,
+                          OCIO::BIT_DEPTH_UINT16, __LINE__>(processor,
+                                                            &f_inImg[0], OCIO::CHANNEL_ORDERING_RGBA,
+                                                            &resImg[0],  OCIO::CHANNEL_ORDERING_RGBA,
+                                                            NB_PIXELS);
+        }
+
+        const std::vector<uint16_t> i_inImg =
+            {    0,      8,    32,  0,
+                64,    128,   256,  0,
+               512,   1024,  2048,  0,
+              5120,  20480, 65535,  0  };
+        {
+            const std::vector<float> resImg
+                = { -0.18999999f, 0.19036166f,  0.00125666f,  0.0f,
+                    -0.18812581f, 0.19271758f,  0.00389672f,  0.0f,
+                    -0.18398958f, 0.19912247f,  0.01437576f,  0.0f,
+                    -0.15969887f, 0.32105737f, 63.99980927f,  0.0f };
+
+            ComputeValues<OCIO::BIT_DEPTH_UINT16,
+                          OCIO::BIT_DEPTH_F32, __LINE__>(processor,
+                                                         &i_inImg[0], OCIO::CHANNEL_ORDERING_RGBA,
+                                                         &resImg[0],  OCIO::CHANNEL_ORDERING_RGBA,
+                                                         NB_PIXELS, 1e-7f);
+        }
+
+        {
+            const std::vector<uint16_t> resImg
+                = {     0, 12475,     0,     0,
+                      110, 12630,     0,     0,
+                      381, 13049,     0,     0,
+                     1973, 21040, 65535,     0 };
+
+            ComputeValues<OCIO::BIT_DEPTH_UINT16,
+                          OCIO::BIT_DEPTH_UINT16, __LINE__>(processor,
+                                                            &i_inImg[0], OCIO::CHANNEL_ORDERING_BGRA,
+                                                            &resImg[0],  OCIO::CHANNEL_ORDERING_BGRA,
+                                                            NB_PIXELS);
+        }
+    }
+
+    // Step 3: The 1D LUT is the first and the last Op.
+
+    {
+
+        const std::string strEnd =
+            "    from_reference: !<GroupTransform>\n"
+            "      children:\n"
+            "        - !<FileTransform>   { src: lut1d_5.spi1d, interpolation: linear }\n"
+            "        - !<MatrixTransform> { offset: [-0.19, 0.19, -0.00019, 0] }\n"
+            "        - !<FileTransform>   { src: lut1d_4.spi1d, interpolation: linear }\n";
+
+        const std::string str = SIMPLE_PROFILE + strEnd;
+
+        std::istringstream is;
+        is.str(str);
+
+        OCIO::ConstConfigRcPtr config;
+        OCIO_CHECK_NO_THROW(config = OCIO::Config::CreateFromStream(is));
+        OCIO_CHECK_NO_THROW(config->sanityCheck());
+
+        OCIO::ConstProcessorRcPtr processor;
+        OCIO_CHECK_NO_THROW(processor = config->getProcessor("cs1", "cs2"));
+
+        const unsigned NB_PIXELS = 4;
+
+        const std::vector<float> f_inImg =
+            {  -1.0000f, -0.8000f, -0.1000f,  0.0f,
+                0.1002f,  0.2509f,  0.5009f,  1.0f,
+                0.5505f,  0.7090f,  0.9099f,  1.0f,
+                1.0000f,  1.2500f,  1.9900f,  0.0f  };
+
+        {
+            const std::vector<float> resImg
+                = { -0.79690927f, -0.06224250f, -0.42994320f,  0.0f,
+                    -0.72481644f,  0.13872468f,  0.04750424f,  1.0f,
+                    -0.23451784f,  0.92250180f,  3.26448894f,  1.0f,
+                     3.43709063f,  3.43709063f,  3.43709063f,  0.0f };
+
+            ComputeValues<OCIO::BIT_DEPTH_F32,
+                          OCIO::BIT_DEPTH_F32, __LINE__>(processor,
+                                                         &f_inImg[0], OCIO::CHANNEL_ORDERING_RGBA,
+                                                         &resImg[0],  OCIO::CHANNEL_ORDERING_RGBA,
+                                                         NB_PIXELS, 1e-7f);
+        }
+
+        const std::vector<uint16_t> i_inImg =
+            {    0,      8,    32,  0,
+                64,    128,   256,  0,
+               512,   1024,  2048,  0,
+              5120,  20480, 65535,  0  };
+
+        {
+            const std::vector<uint16_t> resImg
+                = {     0,     0,     0,     0,
+                        0,     0,     0,     0,
+                        0,     0,     0,     0,
+                        0, 12526, 65535,     0 };
+
+            ComputeValues<OCIO::BIT_DEPTH_UINT16,
+                          OCIO::BIT_DEPTH_UINT16, __LINE__>(processor,
+                                                            &i_inImg[0], OCIO::CHANNEL_ORDERING_BGRA,
+                                                            &resImg[0],  OCIO::CHANNEL_ORDERING_BGRA,
+                                                            NB_PIXELS);
+        }
+    }
+}
+
+OCIO_ADD_TEST(CPUProcessor, image_desc)
+{
+    // The tests validate the image description types when using the same buffer image.
+
+    const std::string SIMPLE_PROFILE =
+        "ocio_profile_version: 2\n"
+        "\n"
+        "search_path: " + std::string(OCIO::getTestFilesDir()) + "\n"
+        "strictparsing: true\n"
+        "luma: [0.2126, 0.7152, 0.0722]\n"
+        "\n"
+        "roles:\n"
+        "  default: cs1\n"
+        "  scene_linear: cs2\n"
+        "\n"
+        "displays:\n"
+        "  sRGB:\n"
+        "    - !<View> {name: Raw, colorspace: cs1}\n"
+        "\n"
+        "colorspaces:\n"
+        "  - !<ColorSpace>\n"
+        "    name: cs1\n"
+        "    allocation: uniform\n"
+        "\n"
+        "  - !<ColorSpace>\n"
+        "    name: cs2\n"
+        "    allocation: uniform\n";
+
+    const std::string strEnd =
+        "    from_reference: !<GroupTransform>\n"
+        "      children:\n"
+        "        - !<MatrixTransform> { offset: [-0.19, 0.19, -0.00019, 0.5] }\n"
+        "        - !<FileTransform>   { src: lut1d_5.spi1d, interpolation: linear }\n";
+
+    const std::string str = SIMPLE_PROFILE + strEnd;
+
+    std::istringstream is;
+    is.str(str);
+
+    OCIO::ConstConfigRcPtr config;
+    OCIO_CHECK_NO_THROW(config = OCIO::Config::CreateFromStream(is));
+    OCIO_CHECK_NO_THROW(config->sanityCheck());
+
+    OCIO::ConstProcessorRcPtr processor;
+    OCIO_CHECK_NO_THROW(processor = config->getProcessor("cs1", "cs2"));
+
+    const std::vector<float> f_rInImg =
+        {  -1.0000f,
+            0.1002f,
+            0.5505f,
+            1.0000f,  };
+
+    const std::vector<float> f_gInImg =
+        {            -0.8000f,
+                      0.2509f,
+                      0.7090f,
+                      1.2500f  };
+
+    const std::vector<float> f_bInImg =
+        {                       -0.1000f,
+                                 0.5009f,
+                                 0.9099f,
+                                 1.9900f  };
+
+    const std::vector<float> f_aInImg =
+        {                                   0.0f,
+                                            1.0f,
+                                            0.5f,
+                                            0.0f  };
+
+    const std::vector<float> f_rOutImg
+        = {  0.0f,
+             0.0f,
+             0.15488569f,
+             0.81575858f };
+
+    const std::vector<float> f_gOutImg
+        = {                0.0f,
+                           0.20273837f,
+                           1.69210147f,
+                          64.0f };
+
+    const std::vector<float> f_bOutImg
+        = {                              0.0f,
+                                         0.24680146f,
+                                         1.90666747f,
+                                        64.0f };
+
+    const std::vector<float> f_aOutImg
+        = {                                            0.5f,
+                                                       1.5f,
+                                                       1.0f,
+                                                       0.5f };
+
+    {
+        // Packed Image Description with RGBA image.
+
+        std::vector<float> img =
+            {  f_rInImg[0], f_gInImg[0], f_bInImg[0], f_aInImg[0],
+               f_rInImg[1], f_gInImg[1], f_bInImg[1], f_aInImg[1],
+               f_rInImg[2], f_gInImg[2], f_bInImg[2], f_aInImg[2],
+               f_rInImg[3], f_gInImg[3], f_bInImg[3], f_aInImg[3] };
+
+        const std::vector<float> res
+            {  f_rOutImg[0], f_gOutImg[0], f_bOutImg[0], f_aOutImg[0],
+               f_rOutImg[1], f_gOutImg[1], f_bOutImg[1], f_aOutImg[1],
+               f_rOutImg[2], f_gOutImg[2], f_bOutImg[2], f_aOutImg[2],
+               f_rOutImg[3], f_gOutImg[3], f_bOutImg[3], f_aOutImg[3] };
+
+        OCIO::ConstCPUProcessorRcPtr cpu;
+        OCIO_CHECK_NO_THROW(cpu = processor->getDefaultCPUProcessor());
+
+        OCIO::PackedImageDesc desc(&img[0], 2, 2, 4);
+        OCIO_CHECK_NO_THROW(cpu->apply(desc));
+
+        for(size_t idx=0; idx<img.size(); ++idx)
+        {
+            OCIO_CHECK_CLOSE(img[idx], res[idx], 1e-7f);
+        }
+    }
+
+    {
+        // Packed Image Description with RGB image.
+
+        std::vector<float> img =
+            {  f_rInImg[0], f_gInImg[0], f_bInImg[0],
+               f_rInImg[1], f_gInImg[1], f_bInImg[1],
+               f_rInImg[2], f_gInImg[2], f_bInImg[2],
+               f_rInImg[3], f_gInImg[3], f_bInImg[3] };
+
+        const std::vector<float> res
+            {  f_rOutImg[0], f_gOutImg[0], f_bOutImg[0],
+               f_rOutImg[1], f_gOutImg[1], f_bOutImg[1],
+               f_rOutImg[2], f_gOutImg[2], f_bOutImg[2],
+               f_rOutImg[3], f_gOutImg[3], f_bOutImg[3] };
+
+        OCIO::ConstCPUProcessorRcPtr cpu;
+        OCIO_CHECK_NO_THROW(cpu = processor->getDefaultCPUProcessor());
+
+        OCIO::PackedImageDesc desc(&img[0], 4, 1, 3);
+        OCIO_CHECK_NO_THROW(cpu->apply(desc));
+
+        for(size_t idx=0; idx<img.size(); ++idx)
+        {
+            OCIO_CHECK_CLOSE(img[idx], res[idx], 1e-7f);
+        }
+    }
+
+    {
+        // Planar Image Description with R/G/B/A.
+
+        std::vector<float> imgRed   = f_rInImg;
+        std::vector<float> imgGreen = f_gInImg;
+        std::vector<float> imgBlue  = f_bInImg;
+        std::vector<float> imgAlpha = f_aInImg;
+
+        OCIO::ConstCPUProcessorRcPtr cpu;
+        OCIO_CHECK_NO_THROW(cpu = processor->getDefaultCPUProcessor());
+
+        OCIO::PlanarImageDesc desc(&imgRed[0], &imgGreen[0], &imgBlue[0], &imgAlpha[0], 2, 2);
+        OCIO_CHECK_NO_THROW(cpu->apply(desc));
+
+        for(size_t idx=0; idx<imgRed.size(); ++idx)
+        {
+            OCIO_CHECK_CLOSE(imgRed[idx],   f_rOutImg[idx], 1e-7f);
+            OCIO_CHECK_CLOSE(imgGreen[idx], f_gOutImg[idx], 1e-7f);
+            OCIO_CHECK_CLOSE(imgBlue[idx],  f_bOutImg[idx], 1e-7f);
+            OCIO_CHECK_CLOSE(imgAlpha[idx], f_aOutImg[idx], 1e-7f);
+        }
+    }
+
+    {
+        // Planar Image Description with R/G/B.
+
+        std::vector<float> imgRed   = f_rInImg;
+        std::vector<float> imgGreen = f_gInImg;
+        std::vector<float> imgBlue  = f_bInImg;
+
+        OCIO::ConstCPUProcessorRcPtr cpu;
+        OCIO_CHECK_NO_THROW(cpu = processor->getDefaultCPUProcessor());
+
+        OCIO::PlanarImageDesc desc(&imgRed[0], &imgGreen[0], &imgBlue[0], nullptr, 1, 4);
+        OCIO_CHECK_NO_THROW(cpu->apply(desc));
+
+        for(size_t idx=0; idx<imgRed.size(); ++idx)
+        {
+            OCIO_CHECK_CLOSE(imgRed[idx],   f_rOutImg[idx], 1e-7f);
+            OCIO_CHECK_CLOSE(imgGreen[idx], f_gOutImg[idx], 1e-7f);
+            OCIO_CHECK_CLOSE(imgBlue[idx],  f_bOutImg[idx], 1e-7f);
+        }
+    }
+}
+
+namespace
+{
+
+constexpr unsigned NB_PIXELS = 6;
+
+std::vector<float> inImgR =
+    {  -1.000012f,
+       -0.500012f,
+        0.100012f,
+        0.600012f,
+        1.102312f,
+        1.700012f  };
+
+std::vector<float> inImgG =
+    {              -0.800012f,
+                   -0.300012f,
+                    0.250012f,
+                    0.800012f,
+                    1.204512f,
+                    1.800012f };
+
+std::vector<float> inImgB =
+    {                          -0.600012f,
+                               -0.100012f,
+                                0.450012f,
+                                0.900012f,
+                                1.508912f,
+                                1.990012f };
+
+std::vector<float> inImgA =
+    {                                       0.005005f,
+                                            0.405005f,
+                                            0.905005f,
+                                            0.005005f,
+                                            1.005005f,
+                                            0.095005f  };
+
+std::vector<float> inImg =
+    { inImgR[0], inImgG[0], inImgB[0], inImgA[0],
+      inImgR[1], inImgG[1], inImgB[1], inImgA[1],
+      inImgR[2], inImgG[2], inImgB[2], inImgA[2],
+      inImgR[3], inImgG[3], inImgB[3], inImgA[3],
+      inImgR[4], inImgG[4], inImgB[4], inImgA[4],
+      inImgR[5], inImgG[5], inImgB[5], inImgA[5] };
+
+const std::vector<float> resImgR =
+    {  0.4001879692f,
+       0.9001880288f,
+       1.500211954f,
+       2.000211954f,
+       2.502511978f,
+       3.100212097f };
+
+const std::vector<float> resImgG =
+    {                 -0.3995119929f,
+                       0.1004880071f,
+                       0.6505119801f,
+                       1.200511932f,
+                       1.60501194f,
+                       2.200511932f };
+
+const std::vector<float> resImgB =
+    {                                 0.2006880045f,
+                                      0.7006880045f,
+                                      1.250712037f,
+                                      1.700711966f,
+                                      2.309612036f,
+                                      2.790712118f };
+
+const std::vector<float> resImgA =
+    {                                                0.5057050f,
+                                                     0.9057050f,
+                                                     1.4057050f,
+                                                     0.5057050f,
+                                                     1.5057050f,
+                                                     0.5957050f  };
+
+const std::vector<float> resImg =
+    { resImgR[0], resImgG[0], resImgB[0], resImgA[0],
+      resImgR[1], resImgG[1], resImgB[1], resImgA[1],
+      resImgR[2], resImgG[2], resImgB[2], resImgA[2],
+      resImgR[3], resImgG[3], resImgB[3], resImgA[3],
+      resImgR[4], resImgG[4], resImgB[4], resImgA[4],
+      resImgR[5], resImgG[5], resImgB[5], resImgA[5] };
+
+
+OCIO::ConstCPUProcessorRcPtr BuildCPUProcessor(OCIO::TransformDirection dir)
+{
+    OCIO::ConfigRcPtr config = OCIO::Config::Create();
+
+    OCIO::MatrixTransformRcPtr transform = OCIO::MatrixTransform::Create();
+    constexpr double offset4[4] = { 1.4002, 0.4005, 0.8007, 0.5007 };
+    transform->setOffset(offset4);
+    transform->setDirection(dir);
+
+    OCIO::ConstProcessorRcPtr processor = config->getProcessor(transform);
+    return processor->getDefaultCPUProcessor();
+}
+
+void Validate(const OCIO::PackedImageDesc & imgDesc, unsigned lineNo)
+{
+    const float * outImg = reinterpret_cast<float*>(imgDesc.getData());
+    for(size_t pxl=0; pxl<NB_PIXELS; ++pxl)
+    {
+        OCIO_CHECK_CLOSE_FROM(outImg[4*pxl+0], resImg[4*pxl+0], 1e-7f, lineNo);
+        OCIO_CHECK_CLOSE_FROM(outImg[4*pxl+1], resImg[4*pxl+1], 1e-7f, lineNo);
+        OCIO_CHECK_CLOSE_FROM(outImg[4*pxl+2], resImg[4*pxl+2], 1e-7f, lineNo);
+        OCIO_CHECK_CLOSE_FROM(outImg[4*pxl+3], resImg[4*pxl+3], 1e-7f, lineNo);
+    }
+}
+
+void Process(const OCIO::ConstCPUProcessorRcPtr & cpuProcessor,
+             const OCIO::PackedImageDesc & srcImgDesc,
+             OCIO::PackedImageDesc & dstImgDesc,
+             unsigned lineNo)
+{
+    OCIO_CHECK_NO_THROW_FROM(cpuProcessor->apply(srcImgDesc, dstImgDesc), lineNo);
+    Validate(dstImgDesc, lineNo);
+}
+
+void Process(const OCIO::ConstCPUProcessorRcPtr & cpuProcessor,
+             OCIO::PackedImageDesc & imgDesc,
+             unsigned lineNo)
+{
+    OCIO_CHECK_NO_THROW_FROM(cpuProcessor->apply(imgDesc), lineNo);
+    Validate(imgDesc, lineNo);
+}
+
+void Process(const OCIO::ConstCPUProcessorRcPtr & cpuProcessor,
+             const OCIO::PlanarImageDesc & srcImgDesc,
+             OCIO::PlanarImageDesc & dstImgDesc,
+             unsigned lineNo)
+{
+    OCIO_CHECK_NO_THROW_FROM(cpuProcessor->apply(srcImgDesc, dstImgDesc), lineNo);
+
+    const float * outImgR = reinterpret_cast<float*>(dstImgDesc.getRData());
+    const float * outImgG = reinterpret_cast<float*>(dstImgDesc.getGData());
+    const float * outImgB = reinterpret_cast<float*>(dstImgDesc.getBData());
+    const float * outImgA = reinterpret_cast<float*>(dstImgDesc.getAData());
+
+    for(size_t pxl=0; pxl<NB_PIXELS; ++pxl)
+    {
+        OCIO_CHECK_CLOSE_FROM(outImgR[pxl], resImg[4*pxl+0], 1e-7f, lineNo);
+        OCIO_CHECK_CLOSE_FROM(outImgG[pxl], resImg[4*pxl+1], 1e-7f, lineNo);
+        OCIO_CHECK_CLOSE_FROM(outImgB[pxl], resImg[4*pxl+2], 1e-7f, lineNo);
+        if(outImgA)
+        {
+            OCIO_CHECK_CLOSE_FROM(outImgA[pxl], resImg[4*pxl+3], 1e-7f, lineNo);
+        }
+    }
+}
+
+} // anon
+
+
+OCIO_ADD_TEST(CPUProcessor, planar_vs_packed)
+{
+    // The unit test validates different types for input and output imageDesc.
+
+    OCIO::ConstCPUProcessorRcPtr cpuProcessor;
+    OCIO_CHECK_NO_THROW(cpuProcessor = BuildCPUProcessor(OCIO::TRANSFORM_DIR_FORWARD));
+
+    // 1. Process from Packed to Planar Image Desc using the forward transform.
+
+    OCIO::PackedImageDesc srcImgDesc((void*)&inImg[0], NB_PIXELS, 1, 4);
+
+    std::vector<float> outR(NB_PIXELS), outG(NB_PIXELS), outB(NB_PIXELS), outA(NB_PIXELS);
+    OCIO::PlanarImageDesc dstImgDesc((void*)&outR[0], (void*)&outG[0],
+                                     (void*)&outB[0], (void*)&outA[0],
+                                     NB_PIXELS, 1);
+
+    OCIO_CHECK_NO_THROW(cpuProcessor->apply(srcImgDesc, dstImgDesc));
+
+    for(size_t idx=0; idx<NB_PIXELS; ++idx)
+    {
+        OCIO_CHECK_CLOSE(outR[idx], resImg[4*idx+0], 1e-7f);
+        OCIO_CHECK_CLOSE(outG[idx], resImg[4*idx+1], 1e-7f);
+        OCIO_CHECK_CLOSE(outB[idx], resImg[4*idx+2], 1e-7f);
+        OCIO_CHECK_CLOSE(outA[idx], resImg[4*idx+3], 1e-7f);
+    }
+
+    // 2. Process from Planar to Packed Image Desc using the inverse transform.
+
+    OCIO_CHECK_NO_THROW(cpuProcessor = BuildCPUProcessor(OCIO::TRANSFORM_DIR_INVERSE));
+
+    std::vector<float> outImg(NB_PIXELS*4, -1.0f);
+    OCIO::PackedImageDesc dstImgDesc2((void*)&outImg[0], NB_PIXELS, 1, 4);
+
+    OCIO_CHECK_NO_THROW(cpuProcessor->apply(dstImgDesc, dstImgDesc2));
+
+    for(size_t idx=0; idx<(NB_PIXELS*4); ++idx)
+    {
+        OCIO_CHECK_CLOSE(outImg[idx], inImg[idx], 1e-6f);
+    }
+}
+
+OCIO_ADD_TEST(CPUProcessor, scanline_helper_packed)
+{
+    // Test the packed image description.
+
+    OCIO::ConstCPUProcessorRcPtr cpuProcessor;
+    OCIO_CHECK_NO_THROW(cpuProcessor = BuildCPUProcessor(OCIO::TRANSFORM_DIR_FORWARD));
+
+    std::vector<float> outImg(NB_PIXELS*4);
+
+    {
+        OCIO::PackedImageDesc srcImgDesc(&inImg[0], NB_PIXELS, 1, 4);
+        OCIO::PackedImageDesc dstImgDesc(&outImg[0], NB_PIXELS, 1, 4);
+
+        Process(cpuProcessor, srcImgDesc, dstImgDesc, __LINE__);
+    }
+
+    {
+        OCIO::PackedImageDesc srcImgDesc(&inImg[0], 1, NB_PIXELS, 4);
+        OCIO::PackedImageDesc dstImgDesc(&outImg[0], 1, NB_PIXELS, 4);
+
+        Process(cpuProcessor, srcImgDesc, dstImgDesc, __LINE__);
+    }
+
+    {
+        OCIO::PackedImageDesc srcImgDesc(&inImg[0], 2, 3, 4);
+        OCIO::PackedImageDesc dstImgDesc(&outImg[0], 2, 3, 4);
+
+        Process(cpuProcessor, srcImgDesc, dstImgDesc, __LINE__);
+    }
+
+    {
+        OCIO::PackedImageDesc srcImgDesc(&inImg[0], 3, 2, 4);
+        OCIO::PackedImageDesc dstImgDesc(&outImg[0], 3, 2, 4);
+
+        Process(cpuProcessor, srcImgDesc, dstImgDesc, __LINE__);
+    }
+
+    {
+        OCIO::PackedImageDesc srcImgDesc(&inImg[0], 2, 3, 4);
+        OCIO::PackedImageDesc dstImgDesc(&outImg[0], 2, 3,
+                                         OCIO::CHANNEL_ORDERING_RGBA,
+                                         OCIO::BIT_DEPTH_F32,
+                                         sizeof(float),
+                                         OCIO::AutoStride,
+                                         OCIO::AutoStride);
+
+        Process(cpuProcessor, srcImgDesc, dstImgDesc, __LINE__);
+    }
+
+    {
+        OCIO::PackedImageDesc srcImgDesc(&inImg[0], 2, 3, 4);
+        OCIO::PackedImageDesc dstImgDesc(&outImg[0], 2, 3,
+                                         OCIO::CHANNEL_ORDERING_RGBA,
+                                         OCIO::BIT_DEPTH_F32,
+                                         sizeof(float),
+                                         4*sizeof(float),
+                                         OCIO::AutoStride);
+
+        Process(cpuProcessor, srcImgDesc, dstImgDesc, __LINE__);
+    }
+
+    {
+        OCIO::PackedImageDesc srcImgDesc(&inImg[0], 2, 3, 4);
+        OCIO::PackedImageDesc dstImgDesc(&outImg[0], 2, 3,
+                                         4, // Number of channels
+                                         OCIO::BIT_DEPTH_F32,
+                                         sizeof(float),
+                                         4*sizeof(float),
+                                         OCIO::AutoStride);
+
+        Process(cpuProcessor, srcImgDesc, dstImgDesc, __LINE__);
+    }
+
+    {
+        OCIO::PackedImageDesc srcImgDesc(&inImg[0], 2, 3, 4);
+        OCIO::PackedImageDesc dstImgDesc(&outImg[0], 2, 3,
+                                         4, // Number of channels
+                                         OCIO::BIT_DEPTH_F32,
+                                         OCIO::AutoStride,
+                                         4*sizeof(float),
+                                         OCIO::AutoStride);
+
+        Process(cpuProcessor, srcImgDesc, dstImgDesc, __LINE__);
+    }
+
+    {
+        OCIO::PackedImageDesc srcImgDesc(&inImg[0], 2, 3, 4);
+        OCIO::PackedImageDesc dstImgDesc(&outImg[0], 2, 3,
+                                         4, // Number of channels
+                                         OCIO::BIT_DEPTH_F32,
+                                         OCIO::AutoStride,
+                                         4*sizeof(float),
+                                         2*4*sizeof(float));
+
+        Process(cpuProcessor, srcImgDesc, dstImgDesc, __LINE__);
+    }
+
+    {
+        OCIO::PackedImageDesc srcImgDesc(&inImg[0], 2, 3, 4);
+        OCIO::PackedImageDesc dstImgDesc(&outImg[0], 2, 3,
+                                         4, // Number of channels
+                                         OCIO::BIT_DEPTH_F32,
+                                         OCIO::AutoStride,
+                                         OCIO::AutoStride,
+                                         2*4*sizeof(float));
+
+        Process(cpuProcessor, srcImgDesc, dstImgDesc, __LINE__);
+    }
+}
+
+OCIO_ADD_TEST(CPUProcessor, scanline_helper_packed_one_buffer)
+{
+    // Now that the previous unit test covers all cases with different buffers,
+    // let's test some cases using the same in and out buffer.
+
+    OCIO::ConstCPUProcessorRcPtr cpuProcessor;
+    OCIO_CHECK_NO_THROW(cpuProcessor = BuildCPUProcessor(OCIO::TRANSFORM_DIR_FORWARD));
+
+    std::vector<float> processingImg(NB_PIXELS*4);
+
+    {
+        processingImg = inImg;
+
+        OCIO::PackedImageDesc imgDesc(&processingImg[0], NB_PIXELS, 1, 4);
+
+        Process(cpuProcessor, imgDesc, __LINE__);
+    }
+
+    {
+        processingImg = inImg;
+
+        OCIO::PackedImageDesc imgDesc(&processingImg[0], 3, 2, 4);
+
+        Process(cpuProcessor, imgDesc, __LINE__);
+    }
+
+    {
+        processingImg = inImg;
+
+        OCIO::PackedImageDesc imgDesc(&processingImg[0], 1, NB_PIXELS, 4);
+
+        Process(cpuProcessor, imgDesc, __LINE__);
+    }
+}
+
+OCIO_ADD_TEST(CPUProcessor, scanline_helper_planar)
+{
+    // Test the planar image description.
+
+    OCIO::ConstCPUProcessorRcPtr cpuProcessor;
+    OCIO_CHECK_NO_THROW(cpuProcessor = BuildCPUProcessor(OCIO::TRANSFORM_DIR_FORWARD));
+
+    std::vector<float> outImgR(NB_PIXELS);
+    std::vector<float> outImgG(NB_PIXELS);
+    std::vector<float> outImgB(NB_PIXELS);
+    std::vector<float> outImgA(NB_PIXELS);
+
+    {
+        OCIO::PlanarImageDesc srcImgDesc(&inImgR[0], &inImgG[0], &inImgB[0], &inImgA[0], NB_PIXELS, 1);
+        OCIO::PlanarImageDesc dstImgDesc(&outImgR[0], &outImgG[0], &outImgB[0], &outImgA[0], NB_PIXELS, 1);
+
+        Process(cpuProcessor, srcImgDesc, dstImgDesc, __LINE__);
+    }
+
+    {
+        OCIO::PlanarImageDesc srcImgDesc(&inImgR[0], &inImgG[0], &inImgB[0], &inImgA[0], NB_PIXELS, 1);
+        OCIO::PlanarImageDesc dstImgDesc(&outImgR[0], &outImgG[0], &outImgB[0], &outImgA[0], NB_PIXELS, 1);
+
+        Process(cpuProcessor, srcImgDesc, dstImgDesc, __LINE__);
+    }
+
+    {
+        OCIO::PlanarImageDesc srcImgDesc(&inImgR[0], &inImgG[0], &inImgB[0], &inImgA[0], NB_PIXELS, 1);
+        OCIO::PlanarImageDesc dstImgDesc(&outImgR[0], &outImgG[0], &outImgB[0], &outImgA[0], NB_PIXELS, 1);
+
+        Process(cpuProcessor, srcImgDesc, dstImgDesc, __LINE__);
+    }
+
+    {
+        OCIO::PlanarImageDesc srcImgDesc(&inImgR[0], &inImgG[0], &inImgB[0], &inImgA[0], 3, 2);
+        OCIO::PlanarImageDesc dstImgDesc(&outImgR[0], &outImgG[0], &outImgB[0], &outImgA[0], 3, 2);
+
+        Process(cpuProcessor, srcImgDesc, dstImgDesc, __LINE__);
+    }
+
+    {
+        OCIO::PlanarImageDesc srcImgDesc(&inImgR[0], &inImgG[0], &inImgB[0], &inImgA[0], 2, 3);
+        OCIO::PlanarImageDesc dstImgDesc(&outImgR[0], &outImgG[0], &outImgB[0], &outImgA[0],
+                                         2, 3,
+                                         OCIO::BIT_DEPTH_F32,
+                                         sizeof(float),
+                                         OCIO::AutoStride);
+
+        Process(cpuProcessor, srcImgDesc, dstImgDesc, __LINE__);
+    }
+
+    {
+        OCIO::PlanarImageDesc srcImgDesc(&inImgR[0], &inImgG[0], &inImgB[0], &inImgA[0], 2, 3);
+        OCIO::PlanarImageDesc dstImgDesc(&outImgR[0], &outImgG[0], &outImgB[0], &outImgA[0],
+                                         2, 3,
+                                         OCIO::BIT_DEPTH_F32,
+                                         sizeof(float),
+                                         2*sizeof(float));
+
+        Process(cpuProcessor, srcImgDesc, dstImgDesc, __LINE__);
+    }
+
+    {
+        OCIO::PlanarImageDesc srcImgDesc(&inImgR[0], &inImgG[0], &inImgB[0], &inImgA[0], 2, 3);
+        OCIO::PlanarImageDesc dstImgDesc(&outImgR[0], &outImgG[0], &outImgB[0], &outImgA[0],
+                                         2, 3,
+                                         OCIO::BIT_DEPTH_F32,
+                                         OCIO::AutoStride,
+                                         2*sizeof(float));
+
+        Process(cpuProcessor, srcImgDesc, dstImgDesc, __LINE__);
+    }
+
+    {
+        OCIO::PlanarImageDesc srcImgDesc(&inImgR[0], &inImgG[0], &inImgB[0], &inImgA[0],
+                                         2, 3,
+                                         OCIO::BIT_DEPTH_F32,
+                                         OCIO::AutoStride,
+                                         2*sizeof(float));
+
+        OCIO::PlanarImageDesc dstImgDesc(&outImgR[0], &outImgG[0], &outImgB[0], &outImgA[0],
+                                         2, 3,
+                                         OCIO::BIT_DEPTH_F32,
+                                         OCIO::AutoStride,
+                                         2*sizeof(float));
+
+        Process(cpuProcessor, srcImgDesc, dstImgDesc, __LINE__);
+    }
+
+    {
+        OCIO::PlanarImageDesc srcImgDesc(&inImgR[0], &inImgG[0], &inImgB[0], &inImgA[0],
+                                         2, 3,
+                                         OCIO::BIT_DEPTH_F32,
+                                         sizeof(float),
+                                         2*sizeof(float));
+
+        OCIO::PlanarImageDesc dstImgDesc(&outImgR[0], &outImgG[0], &outImgB[0], &outImgA[0],
+                                         2, 3,
+                                         OCIO::BIT_DEPTH_F32,
+                                         OCIO::AutoStride,
+                                         2*sizeof(float));
+
+        Process(cpuProcessor, srcImgDesc, dstImgDesc, __LINE__);
+    }
+
+    {
+        OCIO::PlanarImageDesc srcImgDesc(&inImgR[0], &inImgG[0], &inImgB[0], &inImgA[0],
+                                         2, 3,
+                                         OCIO::BIT_DEPTH_F32,
+                                         sizeof(float),
+                                         2*sizeof(float));
+
+        OCIO::PlanarImageDesc dstImgDesc(&outImgR[0], &outImgG[0], &outImgB[0], nullptr,
+                                         2, 3,
+                                         OCIO::BIT_DEPTH_F32,
+                                         OCIO::AutoStride,
+                                         2*sizeof(float));
+
+        Process(cpuProcessor, srcImgDesc, dstImgDesc, __LINE__);
+    }
+
+    {
+        OCIO::PlanarImageDesc srcImgDesc(&inImgR[0], &inImgG[0], &inImgB[0], nullptr,
+                                         2, 3,
+                                         OCIO::BIT_DEPTH_F32,
+                                         sizeof(float),
+                                         2*sizeof(float));
+
+        OCIO::PlanarImageDesc dstImgDesc(&outImgR[0], &outImgG[0], &outImgB[0], nullptr,
+                                         2, 3,
+                                         OCIO::BIT_DEPTH_F32,
+                                         OCIO::AutoStride,
+                                         2*sizeof(float));
+
+        Process(cpuProcessor, srcImgDesc, dstImgDesc, __LINE__);
+    }
+}
+
+OCIO_ADD_TEST(CPUProcessor, scanline_helper_tile)
+{
+    // Process tiles.
+
+    OCIO::ConstCPUProcessorRcPtr cpuProcessor;
+    OCIO_CHECK_NO_THROW(cpuProcessor = BuildCPUProcessor(OCIO::TRANSFORM_DIR_FORWARD));
+
+    std::vector<float> outImg(NB_PIXELS*4);
+
+    {
+        // Pixels are { 1, 2, 3,
+        //              4, 5, 6  }
+
+        // Copy the 1st pixel which should be untouched.
+        outImg[(0 * 4) + 0] = resImg[(0 * 4) + 0];
+        outImg[(0 * 4) + 1] = resImg[(0 * 4) + 1];
+        outImg[(0 * 4) + 2] = resImg[(0 * 4) + 2];
+        outImg[(0 * 4) + 3] = resImg[(0 * 4) + 3];
+        // Copy the 4th pixel which should be untouched.
+        outImg[(3 * 4) + 0] = resImg[(3 * 4) + 0];
+        outImg[(3 * 4) + 1] = resImg[(3 * 4) + 1];
+        outImg[(3 * 4) + 2] = resImg[(3 * 4) + 2];
+        outImg[(3 * 4) + 3] = resImg[(3 * 4) + 3];
+
+        // Only process the pixels = { 2, 3,
+        //                             5, 6  }
+
+        OCIO::PackedImageDesc srcImgDesc(&inImg[4],
+                                         2, 2, 4,   // width=2, height=2, and nchannels=4
+                                         OCIO::BIT_DEPTH_F32,
+                                         sizeof(float),
+                                         4*sizeof(float),
+                                         3*4*sizeof(float));
+
+        OCIO::PackedImageDesc dstImgDesc(&outImg[4],
+                                         2, 2, 4,   // width=2, height=2, and nchannels=4
+                                         OCIO::BIT_DEPTH_F32,
+                                         sizeof(float),
+                                         4*sizeof(float),
+                                         3*4*sizeof(float));
+
+        OCIO_CHECK_NO_THROW(cpuProcessor->apply(srcImgDesc, dstImgDesc));
+
+        for(size_t pxl=0; pxl<NB_PIXELS; ++pxl)
+        {
+            OCIO_CHECK_CLOSE(outImg[4*pxl+0], resImg[4*pxl+0], 1e-7f);
+            OCIO_CHECK_CLOSE(outImg[4*pxl+1], resImg[4*pxl+1], 1e-7f);
+            OCIO_CHECK_CLOSE(outImg[4*pxl+2], resImg[4*pxl+2], 1e-7f);
+            OCIO_CHECK_CLOSE(outImg[4*pxl+3], resImg[4*pxl+3], 1e-7f);
+        }
+    }
+
+    {
+        // Pixels are { 1, 2, 3,
+        //              4, 5, 6  }
+
+        // Copy the 3rd pixel which should be untouched.
+        outImg[(2 * 4) + 0] = resImg[(2 * 4) + 0];
+        outImg[(2 * 4) + 1] = resImg[(2 * 4) + 1];
+        outImg[(2 * 4) + 2] = resImg[(2 * 4) + 2];
+        outImg[(2 * 4) + 3] = resImg[(2 * 4) + 3];
+        // Copy the 6th pixel which should be untouched.
+        outImg[(5 * 4) + 0] = resImg[(5 * 4) + 0];
+        outImg[(5 * 4) + 1] = resImg[(5 * 4) + 1];
+        outImg[(5 * 4) + 2] = resImg[(5 * 4) + 2];
+        outImg[(5 * 4) + 3] = resImg[(5 * 4) + 3];
+
+        // Only process the pixels = { 1, 2,
+        //                             4, 5 }
+
+        OCIO::PackedImageDesc srcImgDesc(&inImg[0],
+                                         2, 2, 4,   // width=2, height=2, and nchannels=4
+                                         OCIO::BIT_DEPTH_F32,
+                                         sizeof(float),
+                                         4*sizeof(float),
+                                         3*4*sizeof(float));
+
+        OCIO::PackedImageDesc dstImgDesc(&outImg[0],
+                                         2, 2, 4,   // width=2, height=2, and nchannels=4
+                                         OCIO::BIT_DEPTH_F32,
+                                         sizeof(float),
+                                         4*sizeof(float),
+                                         3*4*sizeof(float));
+
+        Process(cpuProcessor, srcImgDesc, dstImgDesc, __LINE__);
+    }
+
+    {
+        // Pixels are { 1, 2, 3,
+        //              4, 5, 6  }
+
+        outImg = inImg; // Use an in-place image buffer.
+
+        // Copy the 3rd pixel which should be untouched.
+        outImg[(2 * 4) + 0] = resImg[(2 * 4) + 0];
+        outImg[(2 * 4) + 1] = resImg[(2 * 4) + 1];
+        outImg[(2 * 4) + 2] = resImg[(2 * 4) + 2];
+        outImg[(2 * 4) + 3] = resImg[(2 * 4) + 3];
+        // Copy the 6th pixel which should be untouched.
+        outImg[(5 * 4) + 0] = resImg[(5 * 4) + 0];
+        outImg[(5 * 4) + 1] = resImg[(5 * 4) + 1];
+        outImg[(5 * 4) + 2] = resImg[(5 * 4) + 2];
+        outImg[(5 * 4) + 3] = resImg[(5 * 4) + 3];
+
+        // Only process the pixels = { 1, 2,
+        //                             4, 5 }
+
+        OCIO::PackedImageDesc dstImgDesc(&outImg[0],
+                                         2, 2, 4,   // width=2, height=2, and nchannels=4
+                                         OCIO::BIT_DEPTH_F32,
+                                         sizeof(float),
+                                         4*sizeof(float),
+                                         3*4*sizeof(float));
+
+        Process(cpuProcessor, dstImgDesc, dstImgDesc, __LINE__);
+    }
+
+}
+
+
+OCIO_ADD_TEST(CPUProcessor, custom_scanlines)
+{
+    // Cases testing custom xStrideBytes and yStrideBytes values.
+
+    const float magicNumber = 12345.6789f;
+
+    OCIO::ConstCPUProcessorRcPtr cpuProcessor;
+    OCIO_CHECK_NO_THROW(cpuProcessor = BuildCPUProcessor(OCIO::TRANSFORM_DIR_FORWARD));
+
+    {
+        // Pixels are { RGBA, RGBA, RGBA, x,
+        //              RGBA, RGBA, RGBA, x  } where x is not a color channel.
+
+        std::vector<float> img
+            = { inImg[ 0], inImg[ 1], inImg[ 2], inImg[ 3],
+                inImg[ 4], inImg[ 5], inImg[ 6], inImg[ 7],
+                inImg[ 8], inImg[ 9], inImg[10], inImg[11],
+                magicNumber,
+                inImg[12], inImg[13], inImg[14], inImg[15],
+                inImg[16], inImg[17], inImg[18], inImg[19],
+                inImg[20], inImg[21], inImg[22], inImg[23],
+                magicNumber };
+
+        OCIO::PackedImageDesc srcImgDesc(&img[0],
+                                         3, 2, 4,
+                                         OCIO::BIT_DEPTH_F32,
+                                         OCIO::AutoStride,
+                                         OCIO::AutoStride,
+                                         // Bytes to the next line.
+                                         3*4*sizeof(float)+sizeof(float));
+
+        std::vector<float> outImg(NB_PIXELS*4);
+        OCIO::PackedImageDesc dstImgDesc(&outImg[0], 3, 2, 4);
+
+        OCIO_CHECK_NO_THROW(cpuProcessor->apply(srcImgDesc, dstImgDesc));
+
+        for(size_t pxl=0; pxl<NB_PIXELS; ++pxl)
+        {
+            OCIO_CHECK_CLOSE(outImg[4*pxl+0], resImg[4*pxl+0], 1e-7f);
+            OCIO_CHECK_CLOSE(outImg[4*pxl+1], resImg[4*pxl+1], 1e-7f);
+            OCIO_CHECK_CLOSE(outImg[4*pxl+2], resImg[4*pxl+2], 1e-7f);
+            OCIO_CHECK_CLOSE(outImg[4*pxl+3], resImg[4*pxl+3], 1e-7f);
+        }
+    }
+
+    {
+        // Pixels are { RxGxBxAx, RxGxBxAx, RxGxBxAx,
+        //              RxGxBxAx, RxGxBxAx, RxGxBxAx  } where x is not a color channel.
+
+        std::vector<float> img
+            = { inImg[ 0], magicNumber, inImg[ 1], magicNumber, inImg[ 2], magicNumber, inImg[ 3], magicNumber,
+                inImg[ 4], magicNumber, inImg[ 5], magicNumber, inImg[ 6], magicNumber, inImg[ 7], magicNumber,
+                inImg[ 8], magicNumber, inImg[ 9], magicNumber, inImg[10], magicNumber, inImg[11], magicNumber,
+                inImg[12], magicNumber, inImg[13], magicNumber, inImg[14], magicNumber, inImg[15], magicNumber,
+                inImg[16], magicNumber, inImg[17], magicNumber, inImg[18], magicNumber, inImg[19], magicNumber,
+                inImg[20], magicNumber, inImg[21], magicNumber, inImg[22], magicNumber, inImg[23], magicNumber };
+
+        OCIO::PackedImageDesc srcImgDesc(&img[0],  3, 2, 4,
+                                         OCIO::BIT_DEPTH_F32,
+                                         // Bytes to the next channel.
+                                         sizeof(float)+sizeof(float),
+                                         OCIO::AutoStride,
+                                         OCIO::AutoStride);
+
+        std::vector<float> outImg(NB_PIXELS*3);
+        OCIO::PackedImageDesc dstImgDesc(&outImg[0], 3, 2, 3);
+
+        OCIO_CHECK_NO_THROW(cpuProcessor->apply(srcImgDesc, dstImgDesc));
+
+        for(size_t pxl=0; pxl<NB_PIXELS; ++pxl)
+        {
+            OCIO_CHECK_CLOSE(outImg[3*pxl+0], resImg[4*pxl+0], 1e-7f);
+            OCIO_CHECK_CLOSE(outImg[3*pxl+1], resImg[4*pxl+1], 1e-7f);
+            OCIO_CHECK_CLOSE(outImg[3*pxl+2], resImg[4*pxl+2], 1e-7f);
+        }
+    }
+
+    {
+        // Pixels are { RGBAx, RGBAx, RGBAx,
+        //              RGBAx, RGBAx, RGBAx  } where x is not a color channel.
+
+        std::vector<float> img
+            = { inImg[ 0], inImg[ 1], inImg[ 2], inImg[ 3], magicNumber,
+                inImg[ 4], inImg[ 5], inImg[ 6], inImg[ 7], magicNumber,
+                inImg[ 8], inImg[ 9], inImg[10], inImg[11], magicNumber,
+                inImg[12], inImg[13], inImg[14], inImg[15], magicNumber,
+                inImg[16], inImg[17], inImg[18], inImg[19], magicNumber,
+                inImg[20], inImg[21], inImg[22], inImg[23], magicNumber };
+
+        OCIO::PackedImageDesc srcImgDesc(&img[0], 3, 2, 4,
+                                         OCIO::BIT_DEPTH_F32,
+                                         OCIO::AutoStride,
+                                         // Bytes to the next pixel.
+                                         4*sizeof(float)+sizeof(float),
+                                         OCIO::AutoStride);
+
+        std::vector<float> outImg(NB_PIXELS*3);
+        OCIO::PackedImageDesc dstImgDesc(&outImg[0], 3, 2, 3);
+
+        OCIO_CHECK_NO_THROW(cpuProcessor->apply(srcImgDesc, dstImgDesc));
+
+        for(size_t pxl=0; pxl<NB_PIXELS; ++pxl)
+        {
+            OCIO_CHECK_CLOSE(outImg[3*pxl+0], resImg[4*pxl+0], 1e-7f);
+            OCIO_CHECK_CLOSE(outImg[3*pxl+1], resImg[4*pxl+1], 1e-7f);
+            OCIO_CHECK_CLOSE(outImg[3*pxl+2], resImg[4*pxl+2], 1e-7f);
+        }
+    }
+
+    {
+        // Pixels are { RGBAx, RGBAx, RGBAx, x
+        //              RGBAx, RGBAx, RGBAx, x  } where x is not a color channel.
+
+        std::vector<float> img
+            = { inImg[ 0], inImg[ 1], inImg[ 2], inImg[ 3], magicNumber,
+                inImg[ 4], inImg[ 5], inImg[ 6], inImg[ 7], magicNumber,
+                inImg[ 8], inImg[ 9], inImg[10], inImg[11], magicNumber,
+                magicNumber,
+                inImg[12], inImg[13], inImg[14], inImg[15], magicNumber,
+                inImg[16], inImg[17], inImg[18], inImg[19], magicNumber,
+                inImg[20], inImg[21], inImg[22], inImg[23], magicNumber,
+                magicNumber };
+
+        OCIO::PackedImageDesc srcImgDesc(&img[0],
+                                         3, 2, 4,
+                                         OCIO::BIT_DEPTH_F32,
+                                         OCIO::AutoStride,
+                                         // Bytes to the next pixel.
+                                         4*sizeof(float)+sizeof(float),
+                                         // Bytes to the next line.
+                                         3*(4*sizeof(float)+sizeof(float))+sizeof(float));
+
+        std::vector<float> outImg(NB_PIXELS*3);
+        OCIO::PackedImageDesc dstImgDesc(&outImg[0], 3, 2, 3);
+
+        OCIO_CHECK_NO_THROW(cpuProcessor->apply(srcImgDesc, dstImgDesc));
+
+        for(size_t pxl=0; pxl<NB_PIXELS; ++pxl)
+        {
+            OCIO_CHECK_CLOSE(outImg[3*pxl+0], resImg[4*pxl+0], 1e-7f);
+            OCIO_CHECK_CLOSE(outImg[3*pxl+1], resImg[4*pxl+1], 1e-7f);
+            OCIO_CHECK_CLOSE(outImg[3*pxl+2], resImg[4*pxl+2], 1e-7f);
+        }
+    }
+
+}
+
+OCIO_ADD_TEST(CPUProcessor, one_pixel)
+{
+    OCIO::ConstCPUProcessorRcPtr cpuProcessor;
+    OCIO_CHECK_NO_THROW(cpuProcessor = BuildCPUProcessor(OCIO::TRANSFORM_DIR_FORWARD));
+
+    // The CPU Processor only includes a Matrix with offset:
+    //   const float offset4[4] = { 1.4002f, 0.4005f, 0.8007f, 0.5007f };
+
+    {
+        float pixel[4]{ 0.1f, 0.3f, 0.9f, 1.0f };
+
+        OCIO_CHECK_NO_THROW(cpuProcessor->applyRGBA(pixel));
+
+        OCIO_CHECK_EQUAL(pixel[0], 0.1f + 1.4002f);
+        OCIO_CHECK_EQUAL(pixel[1], 0.3f + 0.4005f);
+        OCIO_CHECK_EQUAL(pixel[2], 0.9f + 0.8007f);
+        OCIO_CHECK_EQUAL(pixel[3], 1.0f + 0.5007f);
+    }
+
+    {
+        float pixel[3]{ 0.1f, 0.3f, 0.9f };
+
+        OCIO_CHECK_NO_THROW(cpuProcessor->applyRGB(pixel));
+
+        OCIO_CHECK_EQUAL(pixel[0], 0.1f + 1.4002f);
+        OCIO_CHECK_EQUAL(pixel[1], 0.3f + 0.4005f);
+        OCIO_CHECK_EQUAL(pixel[2], 0.9f + 0.8007f);
+    }
+}
+
+namespace
+{
+
+template<OCIO::BitDepth inBD, OCIO::BitDepth outBD>
+void ComputeImage(unsigned width, unsigned height, unsigned nChannels,
+                   const void * inBuf, void * outBuf,
+                   unsigned line)
+{
+    typedef typename OCIO::BitDepthInfo<inBD>::Type InType;
+    typedef typename OCIO::BitDepthInfo<outBD>::Type OutType;
+
+    OCIO::ConfigRcPtr config = OCIO::Config::Create();
+
+    OCIO::MatrixTransformRcPtr transform = OCIO::MatrixTransform::Create();
+    constexpr double offset4[4] = { 1.2002, 0.4005, 0.8007, 0.5 };
+    transform->setOffset( offset4 );
+
+    OCIO::ConstProcessorRcPtr processor;
+    OCIO_CHECK_NO_THROW(processor = config->getProcessor(transform));
+
+    OCIO::ConstCPUProcessorRcPtr cpuProcessor;
+    OCIO_CHECK_NO_THROW(cpuProcessor
+        = processor->getOptimizedCPUProcessor(inBD, outBD,
+                                              OCIO::OPTIMIZATION_DEFAULT,
+                                              OCIO::FINALIZATION_DEFAULT));
+
+    const OCIO::PackedImageDesc srcImgDesc((void *)inBuf,
+                                           width, height, nChannels,
+                                           inBD,
+                                           sizeof(InType),
+                                           OCIO::AutoStride,
+                                           OCIO::AutoStride);
+
+    OCIO::PackedImageDesc dstImgDesc(outBuf,
+                                     width, height, nChannels,
+                                     outBD,
+                                     sizeof(OutType),
+                                     OCIO::AutoStride,
+                                     OCIO::AutoStride);
+
+    OCIO_CHECK_NO_THROW(cpuProcessor->apply(srcImgDesc, dstImgDesc));
+
+
+    const InType * inValues  = (const InType *)inBuf;
+    OutType * outValues = (OutType *)outBuf;
+
+    const float inScale = float(GetBitDepthMaxValue(OCIO::BIT_DEPTH_F32)
+                                    / GetBitDepthMaxValue(inBD));
+
+    const float outScale = float( GetBitDepthMaxValue(outBD)
+                                    / GetBitDepthMaxValue(OCIO::BIT_DEPTH_F32));
+
+    for(size_t idx=0; idx<(width*height);)
+    {
+        // Manual computation of the results.
+
+        const float pxl[4]{ (float(inValues[idx+0]) * inScale + (float)offset4[0]) * outScale,
+                            (float(inValues[idx+1]) * inScale + (float)offset4[1]) * outScale,
+                            (float(inValues[idx+2]) * inScale + (float)offset4[2]) * outScale,
+                            nChannels==4 
+                                ? ((float(inValues[idx+3]) * inScale + (float)offset4[3]) * outScale) 
+                                : 0.0f 
+                          };
+
+        // Validate all the results.
+
+        if(OCIO::BitDepthInfo<outBD>::isFloat)
+        {
+            OCIO_CHECK_CLOSE_FROM(outValues[idx+0], pxl[0], 1e-6f, line);
+            OCIO_CHECK_CLOSE_FROM(outValues[idx+1], pxl[1], 1e-6f, line);
+            OCIO_CHECK_CLOSE_FROM(outValues[idx+2], pxl[2], 1e-6f, line);
+            if(nChannels==4)
+            {
+                OCIO_CHECK_CLOSE_FROM(outValues[idx+3], pxl[3], 1e-6f, line);
+            }
+        }
+        else
+        {
+            OCIO_CHECK_EQUAL_FROM(outValues[idx+0], OCIO::Converter<outBD>::CastValue(pxl[0]), line);
+            OCIO_CHECK_EQUAL_FROM(outValues[idx+1], OCIO::Converter<outBD>::CastValue(pxl[1]), line);
+            OCIO_CHECK_EQUAL_FROM(outValues[idx+2], OCIO::Converter<outBD>::CastValue(pxl[2]), line);
+            if(nChannels==4)
+            {
+                OCIO_CHECK_EQUAL_FROM(outValues[idx+3], OCIO::Converter<outBD>::CastValue(pxl[3]), line);
+            }
+        }
+
+        idx += nChannels;
+    }
+}
+
+}; //anon
+
+OCIO_ADD_TEST(CPUProcessor, optimizations)
+{
+    // The unit test validates some 'optimization' paths now implemented
+    // by the ScanlineHelper class. To fully validate these paths a 'normal' image
+    // must be used (i.e. 'few pixels' image is not enough).
+
+    constexpr const unsigned width     = 640;
+    constexpr const unsigned height    = 480;
+    constexpr const unsigned nChannels = 4;
+
+    // Input and Output are not packed RGBA i.e no optimizations.
+    {
+        std::vector<uint16_t> inBuf(width*height*3);
+        for(size_t idx=0; idx<inBuf.size(); ++idx)
+        {
+            inBuf[idx] = uint16_t(idx % OCIO::BitDepthInfo<OCIO::BIT_DEPTH_UINT16>::maxValue);
+        }
+
+        std::vector<uint16_t> outBuf(width*height*3);
+
+        ComputeImage<OCIO::BIT_DEPTH_UINT16, OCIO::BIT_DEPTH_UINT16>(width, height, 3,
+                                                                     &inBuf[0], &outBuf[0],
+                                                                     __LINE__);
+    }
+
+    // Input and Output are packed RGBA but not F32.
+    {
+        std::vector<uint16_t> inBuf(width*height*nChannels);
+        for(size_t idx=0; idx<inBuf.size(); ++idx)
+        {
+            inBuf[idx] = uint16_t(idx % OCIO::BitDepthInfo<OCIO::BIT_DEPTH_UINT16>::maxValue);
+        }
+
+        std::vector<uint16_t> outBuf(width*height*nChannels);
+
+        ComputeImage<OCIO::BIT_DEPTH_UINT16, OCIO::BIT_DEPTH_UINT16>(width, height, nChannels,
+                                                                     &inBuf[0], &outBuf[0],
+                                                                     __LINE__);
+    }
+
+    // Input is packed RGBA but not F32, and output is packed RGBA F32.
+    {
+        std::vector<uint16_t> inBuf(width*height*nChannels);
+        for(size_t idx=0; idx<inBuf.size(); ++idx)
+        {
+            inBuf[idx] = uint16_t(idx % OCIO::BitDepthInfo<OCIO::BIT_DEPTH_UINT16>::maxValue);
+        }
+
+        std::vector<float> outBuf(width*height*nChannels);
+
+        ComputeImage<OCIO::BIT_DEPTH_UINT16, OCIO::BIT_DEPTH_F32>(width, height, nChannels,
+                                                                  &inBuf[0], &outBuf[0],
+                                                                  __LINE__);
+    }
+
+    // Input is packed RGBA F32, and output is packed RGBA but not F32.
+    {
+        std::vector<float> inBuf(width*height*nChannels);
+        for(size_t idx=0; idx<inBuf.size(); ++idx)
+        {
+            inBuf[idx] = float(idx) / float(inBuf.size());
+        }
+
+        std::vector<uint16_t> outBuf(width*height*nChannels);
+
+        ComputeImage<OCIO::BIT_DEPTH_F32, OCIO::BIT_DEPTH_UINT16>(width, height, nChannels,
+                                                                  &inBuf[0], &outBuf[0],
+                                                                  __LINE__);
+    }
+
+    // Input and output are both packed RGBA F32.
+    {
+        std::vector<float> inBuf(width*height*nChannels);
+        for(size_t idx=0; idx<inBuf.size(); ++idx)
+        {
+            inBuf[idx] = float(idx) / float(inBuf.size());
+        }
+
+        std::vector<float> outBuf(width*height*nChannels);
+
+        ComputeImage<OCIO::BIT_DEPTH_F32, OCIO::BIT_DEPTH_F32>(width, height, nChannels,
+                                                               &inBuf[0], &outBuf[0],
+                                                               __LINE__);
+    }
+}
+
+namespace
+{
+
+OCIO::ConstProcessorRcPtr BuildParallelTestProcessor()
+{
+    OCIO::ConfigRcPtr config = OCIO::Config::Create();
+
+    OCIO::MatrixTransformRcPtr matrix = OCIO::MatrixTransform::Create();
+    constexpr double m44[16] = { 0.9, 0.1, 0.0, 0.0,
+                                 0.2, 0.7, 0.1, 0.0,
+                                 0.0, 0.3, 0.6, 0.0,
+                                 0.0, 0.0, 0.0, 1.0 };
+    matrix->setMatrix(m44);
+
+    OCIO::ExponentTransformRcPtr exponent = OCIO::ExponentTransform::Create();
+    constexpr double exp4[4] = { 2.2, 2.3, 2.4, 1.0 };
+    exponent->setValue(exp4);
+
+    OCIO::GroupTransformRcPtr group = OCIO::GroupTransform::Create();
+    group->appendTransform(matrix);
+    group->appendTransform(exponent);
+
+    return config->getProcessor(group);
+}
+
+}
+
+OCIO_ADD_TEST(CPUProcessor, apply_parallel)
+{
+    // The unit test validates that the parallel processing produces the same
+    // results as the serial one.
+
+    OCIO::ConstProcessorRcPtr processor;
+    OCIO_CHECK_NO_THROW(processor = BuildParallelTestProcessor());
+
+    OCIO::ConstCPUProcessorRcPtr cpuProcessor;
+    OCIO_CHECK_NO_THROW(cpuProcessor = processor->getDefaultCPUProcessor());
+
+    // Some odd dimensions to have a partial last band.
+    constexpr long width  = 301;
+    constexpr long height = 257;
+
+    std::vector<float> img(width * height * 4);
+    for(size_t idx=0; idx<img.size(); ++idx)
+    {
+        img[idx] = float(idx % 1031) / 1031.0f;
+    }
+
+    std::vector<float> serialRes(img);
+    OCIO::PackedImageDesc serialDesc(&serialRes[0], width, height, 4);
+    OCIO_CHECK_NO_THROW(cpuProcessor->apply(serialDesc));
+
+    // In-place processing using the internal thread pool.
+    {
+        std::vector<float> res(img);
+        OCIO::PackedImageDesc desc(&res[0], width, height, 4);
+        OCIO_CHECK_NO_THROW(cpuProcessor->apply(desc, OCIO::CPUExecutor()));
+
+        for(size_t idx=0; idx<res.size(); ++idx)
+        {
+            OCIO_CHECK_EQUAL(res[idx], serialRes[idx]);
+        }
+    }
+
+    // In-place processing using a client executor.
+    {
+        long numBands = 0;
+        std::vector<long> calls;
+
+        OCIO::CPUExecutor executor
+            = [&numBands, &calls](long numTasks, const std::function<void(long)> & task)
+            {
+                numBands = numTasks;
+                calls.resize(numTasks, 0);
+
+                // Process the bands in reverse order.
+                for(long idx=numTasks-1; idx>=0; --idx)
+                {
+                    task(idx);
+                    ++calls[idx];
+                }
+            };
+
+        std::vector<float> res(img);
+        OCIO::PackedImageDesc desc(&res[0], width, height, 4);
+        OCIO_CHECK_NO_THROW(cpuProcessor->apply(desc, executor));
+
+        OCIO_CHECK_GT(numBands, 1);
+        for(const auto & call : calls)
+        {
+            OCIO_CHECK_EQUAL(call, 1);
+        }
+
+        for(size_t idx=0; idx<res.size(); ++idx)
+        {
+            OCIO_CHECK_EQUAL(res[idx], serialRes[idx]);
+        }
+    }
+
+    // Out-of-place processing with a different channel ordering.
+    {
+        std::vector<float> res(width * height * 3);
+        const OCIO::PackedImageDesc srcDesc(&img[0], width, height, 4);
+        OCIO::PackedImageDesc dstDesc(&res[0], width, height, OCIO::CHANNEL_ORDERING_BGR);
+        OCIO_CHECK_NO_THROW(cpuProcessor->apply(srcDesc, dstDesc, OCIO::CPUExecutor()));
+
+        for(long pxl=0; pxl<width*height; ++pxl)
+        {
+            OCIO_CHECK_EQUAL(res[3*pxl+0], serialRes[4*pxl+2]);
+            OCIO_CHECK_EQUAL(res[3*pxl+1], serialRes[4*pxl+1]);
+            OCIO_CHECK_EQUAL(res[3*pxl+2], serialRes[4*pxl+0]);
+        }
+    }
+
+    // Dimension inconsistency.
+    {
+        std::vector<float> res(width * height * 4);
+        const OCIO::PackedImageDesc srcDesc(&img[0], width, height, 4);
+        OCIO::PackedImageDesc dstDesc(&res[0], width, height - 1, 4);
+        OCIO_CHECK_THROW_WHAT(cpuProcessor->apply(srcDesc, dstDesc, OCIO::CPUExecutor()),
+                              OCIO::Exception,
+                              "Dimension inconsistency");
+    }
+}
+
+OCIO_ADD_TEST(CPUProcessor, apply_parallel_bit_depths)
+{
+    OCIO::ConstProcessorRcPtr processor;
+    OCIO_CHECK_NO_THROW(processor = BuildParallelTestProcessor());
+
+    OCIO::ConstCPUProcessorRcPtr cpuProcessor;
+    OCIO_CHECK_NO_THROW(cpuProcessor
+        = processor->getOptimizedCPUProcessor(OCIO::BIT_DEPTH_UINT16, OCIO::BIT_DEPTH_UINT8,
+                                              OCIO::OPTIMIZATION_DEFAULT,
+                                              OCIO::FINALIZATION_DEFAULT));
+
+    constexpr long width  = 640;
+    constexpr long height = 97;
+
+    std::vector<uint16_t> img(width * height * 4);
+    for(size_t idx=0; idx<img.size(); ++idx)
+    {
+        img[idx] = uint16_t(idx % 65536);
+    }
+
+    const OCIO::PackedImageDesc srcDesc(&img[0], width, height, 4,
+                                        OCIO::BIT_DEPTH_UINT16, sizeof(uint16_t),
+                                        OCIO::AutoStride, OCIO::AutoStride);
+
+    std::vector<uint8_t> serialRes(width * height * 4);
+    OCIO::PackedImageDesc serialDesc(&serialRes[0], width, height, 4,
+                                     OCIO::BIT_DEPTH_UINT8, sizeof(uint8_t),
+                                     OCIO::AutoStride, OCIO::AutoStride);
+    OCIO_CHECK_NO_THROW(cpuProcessor->apply(srcDesc, serialDesc));
+
+    std::vector<uint8_t> res(width * height * 4);
+    OCIO::PackedImageDesc dstDesc(&res[0], width, height, 4,
+                                  OCIO::BIT_DEPTH_UINT8, sizeof(uint8_t),
+                                  OCIO::AutoStride, OCIO::AutoStride);
+    OCIO_CHECK_NO_THROW(cpuProcessor->apply(srcDesc, dstDesc, OCIO::CPUExecutor()));
+
+    for(size_t idx=0; idx<res.size(); ++idx)
+    {
+        OCIO_CHECK_EQUAL(res[idx], serialRes[idx]);
+    }
+}
+
+OCIO_ADD_TEST(CPUProcessor, apply_block_size)
+{
+    // The unit test validates that processing lines in several blocks produces
+    // the same results as processing whole lines.
+
+    OCIO_CHECK_THROW_WHAT(OCIO::SetCPUBlockSize(-1), OCIO::Exception, "Invalid CPU block size");
+    OCIO_CHECK_GE(OCIO::GetCPUBlockSize(), 256);
+
+    OCIO::ConstProcessorRcPtr processor;
+    OCIO_CHECK_NO_THROW(processor = BuildParallelTestProcessor());
+
+    OCIO::ConstCPUProcessorRcPtr cpuProcessor;
+    OCIO_CHECK_NO_THROW(cpuProcessor = processor->getDefaultCPUProcessor());
+
+    constexpr long width  = 53;
+    constexpr long height = 11;
+
+    std::vector<float> img(width * height * 4);
+    for(size_t idx=0; idx<img.size(); ++idx)
+    {
+        img[idx] = float(idx % 97) / 97.0f;
+    }
+
+    std::vector<float> lineRes(img);
+    OCIO::PackedImageDesc lineDesc(&lineRes[0], width, height, 4);
+    OCIO_CHECK_NO_THROW(cpuProcessor->apply(lineDesc));
+
+    // Use a block size not dividing the line width.
+    OCIO::SetCPUBlockSize(7);
+    OCIO_CHECK_EQUAL(OCIO::GetCPUBlockSize(), 7);
+
+    // Packed in-place processing.
+    std::vector<float> res(img);
+    OCIO::PackedImageDesc desc(&res[0], width, height, 4);
+    OCIO_CHECK_NO_THROW(cpuProcessor->apply(desc));
+
+    // Planar processing.
+    std::vector<float> r(width * height), g(width * height), b(width * height), a(width * height);
+    for(long idx=0; idx<width * height; ++idx)
+    {
+        r[idx] = img[4 * idx + 0];
+        g[idx] = img[4 * idx + 1];
+        b[idx] = img[4 * idx + 2];
+        a[idx] = img[4 * idx + 3];
+    }
+    OCIO::PlanarImageDesc planarDesc(&r[0], &g[0], &b[0], &a[0], width, height);
+    OCIO_CHECK_NO_THROW(cpuProcessor->apply(planarDesc));
+
+    OCIO::SetCPUBlockSize(0);
+
+    for(size_t idx=0; idx<res.size(); ++idx)
+    {
+        OCIO_CHECK_EQUAL(res[idx], lineRes[idx]);
+    }
+
+    for(long idx=0; idx<width * height; ++idx)
+    {
+        OCIO_CHECK_EQUAL(r[idx], lineRes[4 * idx + 0]);
+        OCIO_CHECK_EQUAL(g[idx], lineRes[4 * idx + 1]);
+        OCIO_CHECK_EQUAL(b[idx], lineRes[4 * idx + 2]);
+        OCIO_CHECK_EQUAL(a[idx], lineRes[4 * idx + 3]);
+    }
+}
+
+OCIO_ADD_TEST(CPUProcessor, apply_reused_helpers)
+{
+    // The ScanlineHelper instances are reused between apply calls so validate
+    // that alternating image layouts & sizes still produce the right results.
+
+    OCIO::ConstProcessorRcPtr processor;
+    OCIO_CHECK_NO_THROW(processor = BuildParallelTestProcessor());
+
+    OCIO::ConstCPUProcessorRcPtr cpuProcessor;
+    OCIO_CHECK_NO_THROW(cpuProcessor = processor->getDefaultCPUProcessor());
+
+    const std::vector<float> src = { 0.1f, 0.2f, 0.3f, 0.4f,
+                                     0.5f, 0.6f, 0.7f, 0.8f,
+                                     0.9f, 1.0f, 0.0f, 0.5f };
+
+    // Compute the expected result.
+    std::vector<float> expected(src);
+    for(size_t idx=0; idx<expected.size(); idx+=4)
+    {
+        OCIO_CHECK_NO_THROW(cpuProcessor->applyRGBA(&expected[idx]));
+    }
+
+    for(int iter=0; iter<3; ++iter)
+    {
+        // In-place packed processing.
+        std::vector<float> res(src);
+        OCIO::PackedImageDesc desc(&res[0], 3, 1, 4);
+        OCIO_CHECK_NO_THROW(cpuProcessor->apply(desc));
+        OCIO_CHECK_ASSERT(res == expected);
+
+        // In-place planar processing.
+        std::vector<float> r = { src[0], src[4], src[8] };
+        std::vector<float> g = { src[1], src[5], src[9] };
+        std::vector<float> b = { src[2], src[6], src[10] };
+        std::vector<float> a = { src[3], src[7], src[11] };
+        OCIO::PlanarImageDesc planarDesc(&r[0], &g[0], &b[0], &a[0], 1, 3);
+        OCIO_CHECK_NO_THROW(cpuProcessor->apply(planarDesc));
+        for(size_t idx=0; idx<3; ++idx)
+        {
+            OCIO_CHECK_EQUAL(r[idx], expected[4 * idx + 0]);
+            OCIO_CHECK_EQUAL(g[idx], expected[4 * idx + 1]);
+            OCIO_CHECK_EQUAL(b[idx], expected[4 * idx + 2]);
+            OCIO_CHECK_EQUAL(a[idx], expected[4 * idx + 3]);
+        }
+
+        // Packed RGB to packed RGBA processing.
+        const std::vector<float> srcRGB = { src[0], src[1], src[2],
+                                            src[4], src[5], src[6],
+                                            src[8], src[9], src[10] };
+        const OCIO::PackedImageDesc srcDesc(const_cast<float *>(&srcRGB[0]), 3, 1, 3);
+        std::vector<float> dst(12, -1.0f);
+        OCIO::PackedImageDesc dstDesc(&dst[0], 3, 1, 4);
+        OCIO_CHECK_NO_THROW(cpuProcessor->apply(srcDesc, dstDesc));
+        for(size_t idx=0; idx<3; ++idx)
+        {
+            OCIO_CHECK_EQUAL(dst[4 * idx + 0], expected[4 * idx + 0]);
+            OCIO_CHECK_EQUAL(dst[4 * idx + 1], expected[4 * idx + 1]);
+            OCIO_CHECK_EQUAL(dst[4 * idx + 2], expected[4 * idx + 2]);
+        }
+    }
+}
+
+OCIO_ADD_TEST(CPUProcessor, batched_pixels)
+{
+    OCIO::ConstProcessorRcPtr processor;
+    OCIO_CHECK_NO_THROW(processor = BuildParallelTestProcessor());
+
+    OCIO::ConstCPUProcessorRcPtr cpuProcessor;
+    OCIO_CHECK_NO_THROW(cpuProcessor = processor->getDefaultCPUProcessor());
+
+    // More pixels than the internal batch size.
+    constexpr long numPixels = 601;
+
+    std::vector<float> rgba(4 * numPixels);
+    for(size_t idx=0; idx<rgba.size(); ++idx)
+    {
+        rgba[idx] = float(idx % 211) / 211.0f;
+    }
+
+    // Compute the expected results, one pixel at a time.
+
+    std::vector<float> expectedRGBA(rgba);
+    std::vector<float> expectedRGB(3 * numPixels);
+    for(long pxl=0; pxl<numPixels; ++pxl)
+    {
+        OCIO_CHECK_NO_THROW(cpuProcessor->applyRGBA(&expectedRGBA[4 * pxl]));
+
+        float rgb[3] = { rgba[4 * pxl + 0], rgba[4 * pxl + 1], rgba[4 * pxl + 2] };
+        OCIO_CHECK_NO_THROW(cpuProcessor->applyRGB(rgb));
+
+        // The RGB processing uses an alpha of zero.
+        float pixel[4] = { rgba[4 * pxl + 0], rgba[4 * pxl + 1], rgba[4 * pxl + 2], 0.0f };
+        OCIO_CHECK_NO_THROW(cpuProcessor->applyRGBA(pixel));
+
+        OCIO_CHECK_EQUAL(rgb[0], pixel[0]);
+        OCIO_CHECK_EQUAL(rgb[1], pixel[1]);
+        OCIO_CHECK_EQUAL(rgb[2], pixel[2]);
+
+        expectedRGB[3 * pxl + 0] = rgb[0];
+        expectedRGB[3 * pxl + 1] = rgb[1];
+        expectedRGB[3 * pxl + 2] = rgb[2];
+    }
+
+    // Packed RGBA pixels.
+    {
+        std::vector<float> res(rgba);
+        OCIO_CHECK_NO_THROW(cpuProcessor->applyRGBA(&res[0], numPixels));
+        OCIO_CHECK_ASSERT(res == expectedRGBA);
+    }
+
+    // RGBA pixels with an additional channel.
+    {
+        std::vector<float> res(5 * numPixels, -1.0f);
+        for(long pxl=0; pxl<numPixels; ++pxl)
+        {
+            std::copy(&rgba[4 * pxl], &rgba[4 * pxl + 4], &res[5 * pxl]);
+        }
+
+        OCIO_CHECK_NO_THROW(cpuProcessor->applyRGBA(&res[0], numPixels, 5 * sizeof(float)));
+
+        for(long pxl=0; pxl<numPixels; ++pxl)
+        {
+            OCIO_CHECK_EQUAL(res[5 * pxl + 0], expectedRGBA[4 * pxl + 0]);
+            OCIO_CHECK_EQUAL(res[5 * pxl + 1], expectedRGBA[4 * pxl + 1]);
+            OCIO_CHECK_EQUAL(res[5 * pxl + 2], expectedRGBA[4 * pxl + 2]);
+            OCIO_CHECK_EQUAL(res[5 * pxl + 3], expectedRGBA[4 * pxl + 3]);
+            OCIO_CHECK_EQUAL(res[5 * pxl + 4], -1.0f);
+        }
+    }
+
+    // Packed RGB pixels.
+    {
+        std::vector<float> res(3 * numPixels);
+        for(long pxl=0; pxl<numPixels; ++pxl)
+        {
+            std::copy(&rgba[4 * pxl], &rgba[4 * pxl + 3], &res[3 * pxl]);
+        }
+
+        OCIO_CHECK_NO_THROW(cpuProcessor->applyRGB(&res[0], numPixels));
+        OCIO_CHECK_ASSERT(res == expectedRGB);
+    }
+
+    // RGB pixels with an alpha channel which must be preserved.
+    {
+        std::vector<float> res(rgba);
+        OCIO_CHECK_NO_THROW(cpuProcessor->applyRGB(&res[0], numPixels, 4 * sizeof(float)));
+
+        for(long pxl=0; pxl<numPixels; ++pxl)
+        {
+            OCIO_CHECK_EQUAL(res[4 * pxl + 0], expectedRGB[3 * pxl + 0]);
+            OCIO_CHECK_EQUAL(res[4 * pxl + 1], expectedRGB[3 * pxl + 1]);
+            OCIO_CHECK_EQUAL(res[4 * pxl + 2], expectedRGB[3 * pxl + 2]);
+            OCIO_CHECK_EQUAL(res[4 * pxl + 3], rgba[4 * pxl + 3]);
+        }
+    }
+
+    // Nothing to process.
+    OCIO_CHECK_NO_THROW(cpuProcessor->applyRGBA(nullptr, 0));
+
+    // Only 32-bit float processors are supported.
+    OCIO::ConstCPUProcessorRcPtr cpuProcessor8;
+    OCIO_CHECK_NO_THROW(cpuProcessor8
+        = processor->getOptimizedCPUProcessor(OCIO::BIT_DEPTH_UINT8, OCIO::BIT_DEPTH_F32,
+                                              OCIO::OPTIMIZATION_DEFAULT,
+                                              OCIO::FINALIZATION_DEFAULT));
+
+    std::vector<float> res(rgba);
+    OCIO_CHECK_THROW_WHAT(cpuProcessor8->applyRGBA(&res[0], numPixels),
+                          OCIO::Exception,
+                          "only supports 32-bit float bit-depths");
+}
+
+OCIO_ADD_TEST(CPUProcessor, profile_renderers)
+{
+    OCIO::ConstProcessorRcPtr processor;
+    OCIO_CHECK_NO_THROW(processor = BuildParallelTestProcessor());
+
+    OCIO::ConstCPUProcessorRcPtr cpuProcessor;
+    OCIO_CHECK_NO_THROW(cpuProcessor = processor->getDefaultCPUProcessor());
+
+    const size_t numRenderers = cpuProcessor->getProcessorMetadata()->getNumRenderers();
+    OCIO_REQUIRE_ASSERT(numRenderers >= 2);
+
+    // Use more pixels than a block to profile several blocks.
+    const long numPixels = 3 * OCIO::GetCPUBlockSizeInPixels() + 17;
+
+    std::vector<float> rgba(4 * numPixels);
+    for(size_t idx=0; idx<rgba.size(); ++idx)
+    {
+        rgba[idx] = float(idx % 97) / 96.0f;
+    }
+
+    std::vector<float> expected(rgba);
+    OCIO_CHECK_NO_THROW(cpuProcessor->applyRGBA(&expected[0], numPixels));
+
+    // The profiling produces the same results as the processing.
+    std::vector<double> times(numRenderers, 0.0);
+    OCIO_CHECK_NO_THROW(cpuProcessor->profileRenderers(&rgba[0], numPixels, &times[0]));
+
+    for(size_t idx=0; idx<rgba.size(); ++idx)
+    {
+        OCIO_CHECK_EQUAL(rgba[idx], expected[idx]);
+    }
+
+    for(const double time : times)
+    {
+        OCIO_CHECK_ASSERT(time >= 0.0);
+    }
+
+    // The times are accumulated.
+    std::vector<double> accumulated(times);
+    OCIO_CHECK_NO_THROW(cpuProcessor->profileRenderers(&rgba[0], numPixels, &accumulated[0]));
+    for(size_t idx=0; idx<numRenderers; ++idx)
+    {
+        OCIO_CHECK_ASSERT(accumulated[idx] >= times[idx]);
+    }
+
+    // Nothing to process.
+    OCIO_CHECK_NO_THROW(cpuProcessor->profileRenderers(nullptr, 0, &times[0]));
+
+    OCIO_CHECK_THROW_WHAT(cpuProcessor->profileRenderers(&rgba[0], numPixels, nullptr),
+                          OCIO::Exception,
+                          "Invalid renderer time array");
+
+    // Only 32-bit float processors are supported.
+    OCIO::ConstCPUProcessorRcPtr cpuProcessor8;
+    OCIO_CHECK_NO_THROW(cpuProcessor8
+        = processor->getOptimizedCPUProcessor(OCIO::BIT_DEPTH_UINT8, OCIO::BIT_DEPTH_F32,
+                                              OCIO::OPTIMIZATION_DEFAULT,
+                                              OCIO::FINALIZATION_DEFAULT));
+
+    OCIO_CHECK_THROW_WHAT(cpuProcessor8->profileRenderers(&rgba[0], numPixels, &times[0]),
+                          OCIO::Exception,
+                          "only supports 32-bit float bit-depths");
+}
+
+OCIO_ADD_TEST(CPUProcessor, profiling_stats)
+{
+    OCIO::ConstProcessorRcPtr processor;
+    OCIO_CHECK_NO_THROW(processor = BuildParallelTestProcessor());
+
+    OCIO::ConstCPUProcessorRcPtr cpuProcessor;
+    OCIO_CHECK_NO_THROW(cpuProcessor = processor->getDefaultCPUProcessor());
+
+    const size_t numRenderers = cpuProcessor->getProcessorMetadata()->getNumRenderers();
+    OCIO_REQUIRE_ASSERT(numRenderers >= 2);
+
+    const long width  = 300;
+    const long height = 200;
+
+    std::vector<float> rgba(4 * width * height);
+    for(size_t idx=0; idx<rgba.size(); ++idx)
+    {
+        rgba[idx] = float(idx % 97) / 96.0f;
+    }
+
+    std::vector<double> times(numRenderers, -1.0);
+    std::vector<long long> numPixels(numRenderers, -1);
+
+    // Disabled by default i.e. nothing is collected.
+    OCIO_CHECK_ASSERT(!cpuProcessor->isProfilingEnabled());
+    cpuProcessor->resetProfilingStats();
+
+    OCIO::PackedImageDesc img(&rgba[0], width, height, 4);
+    OCIO_CHECK_NO_THROW(cpuProcessor->apply(img));
+
+    cpuProcessor->getProfilingStats(&times[0], &numPixels[0]);
+    for(size_t idx=0; idx<numRenderers; ++idx)
+    {
+        OCIO_CHECK_EQUAL(times[idx], 0.0);
+        OCIO_CHECK_EQUAL(numPixels[idx], 0);
+    }
+
+    // Each renderer processes all the pixels, including with the parallel processing.
+    cpuProcessor->setProfilingEnabled(true);
+    OCIO_CHECK_ASSERT(cpuProcessor->isProfilingEnabled());
+
+    std::vector<float> expected(rgba);
+    OCIO_CHECK_NO_THROW(cpuProcessor->applyRGBA(&expected[0], width * height));
+
+    OCIO_CHECK_NO_THROW(cpuProcessor->apply(img));
+    OCIO_CHECK_NO_THROW(cpuProcessor->apply(img, OCIO::CPUExecutor()));
+
+    cpuProcessor->getProfilingStats(&times[0], &numPixels[0]);
+    for(size_t idx=0; idx<numRenderers; ++idx)
+    {
+        OCIO_CHECK_ASSERT(times[idx] >= 0.0);
+        OCIO_CHECK_EQUAL(numPixels[idx], 2 * width * height);
+    }
+
+    // The instrumented processing produces the same results.
+    OCIO_CHECK_NO_THROW(cpuProcessor->applyRGBA(&expected[0], width * height));
+    for(size_t idx=0; idx<rgba.size(); ++idx)
+    {
+        OCIO_CHECK_EQUAL(rgba[idx], expected[idx]);
+    }
+
+    // The arrays are optional.
+    OCIO_CHECK_NO_THROW(cpuProcessor->getProfilingStats(nullptr, &numPixels[0]));
+    OCIO_CHECK_NO_THROW(cpuProcessor->getProfilingStats(&times[0], nullptr));
+
+    cpuProcessor->resetProfilingStats();
+    cpuProcessor->getProfilingStats(&times[0], &numPixels[0]);
+    for(size_t idx=0; idx<numRenderers; ++idx)
+    {
+        OCIO_CHECK_EQUAL(times[idx], 0.0);
+        OCIO_CHECK_EQUAL(numPixels[idx], 0);
+    }
+
+    // The processor could be shared so restore its default.
+    cpuProcessor->setProfilingEnabled(false);
+    OCIO_CHECK_ASSERT(!cpuProcessor->isProfilingEnabled());
+}
+
+OCIO_ADD_TEST(CPUProcessor, memory_footprint)
+{
+    OCIO::ConfigRcPtr config = OCIO::Config::Create();
+
+    // A processor only holding a few parameters.
+    OCIO::MatrixTransformRcPtr matrix = OCIO::MatrixTransform::Create();
+    const double offset[4] = { 0.1, 0.2, 0.3, 0.0 };
+    matrix->setOffset(offset);
+
+    OCIO::ConstProcessorRcPtr processor;
+    OCIO_CHECK_NO_THROW(processor = config->getProcessor(matrix));
+    OCIO::ConstCPUProcessorRcPtr cpuProcessor;
+    OCIO_CHECK_NO_THROW(cpuProcessor = processor->getDefaultCPUProcessor());
+
+    const size_t matrixFootprint = cpuProcessor->getMemoryFootprint();
+    OCIO_CHECK_ASSERT(matrixFootprint > 0);
+    OCIO_CHECK_ASSERT(matrixFootprint < 64 * 1024);
+
+    // The 3D LUT values are held by the op data and by the renderer (i.e. at least in half
+    // floats).
+    constexpr unsigned long gridSize = 33;
+    OCIO::LUT3DTransformRcPtr lut = OCIO::LUT3DTransform::Create(gridSize);
+    lut->setValue(0, 0, 0, 0.1f, 0.0f, 0.0f);
+
+    OCIO_CHECK_NO_THROW(processor = config->getProcessor(lut));
+    OCIO_CHECK_NO_THROW(cpuProcessor = processor->getDefaultCPUProcessor());
+
+    const size_t numValues = gridSize * gridSize * gridSize * 3;
+    const size_t lutFootprint = cpuProcessor->getMemoryFootprint();
+    OCIO_CHECK_ASSERT(lutFootprint > numValues * (sizeof(float) + sizeof(half)));
+
+    OCIO::ConstGPUProcessorRcPtr gpuProcessor;
+    OCIO_CHECK_NO_THROW(gpuProcessor = processor->getDefaultGPUProcessor());
+    OCIO_CHECK_ASSERT(gpuProcessor->getMemoryFootprint() > numValues * sizeof(float));
+    OCIO_CHECK_ASSERT(gpuProcessor->getMemoryFootprint() < lutFootprint);
+
+    // The integer lookup tables are accounted for (i.e. the 3D LUT has channel crosstalk
+    // so the matrix one is used).
+    OCIO_CHECK_NO_THROW(processor = config->getProcessor(matrix));
+    OCIO_CHECK_NO_THROW(cpuProcessor
+        = processor->getOptimizedCPUProcessor(OCIO::BIT_DEPTH_UINT16, OCIO::BIT_DEPTH_UINT16,
+                                              OCIO::OPTIMIZATION_DEFAULT,
+                                              OCIO::FINALIZATION_DEFAULT));
+    OCIO_CHECK_ASSERT(cpuProcessor->getMemoryFootprint()
+                        > matrixFootprint + 3 * 65536 * sizeof(uint16_t));
+}
+
+OCIO_ADD_TEST(CPUProcessor, render_only)
+{
+    OCIO::ConfigRcPtr config = OCIO::Config::Create();
+
+    constexpr unsigned long gridSize = 33;
+    OCIO::LUT3DTransformRcPtr lut = OCIO::LUT3DTransform::Create(gridSize);
+    lut->setValue(0, 0, 0, 0.1f, 0.0f, 0.0f);
+    lut->setValue(1, 2, 3, 0.2f, 0.3f, 0.4f);
+
+    OCIO::ConstProcessorRcPtr processor;
+    OCIO_CHECK_NO_THROW(processor = config->getProcessor(lut));
+
+    OCIO::ConstCPUProcessorRcPtr cpuProcessor;
+    OCIO_CHECK_NO_THROW(cpuProcessor = processor->getDefaultCPUProcessor());
+
+    OCIO::ConstCPUProcessorRcPtr renderOnly;
+    OCIO_CHECK_NO_THROW(renderOnly
+        = processor->getRenderOnlyCPUProcessor(OCIO::BIT_DEPTH_F32, OCIO::BIT_DEPTH_F32,
+                                               OCIO::OPTIMIZATION_DEFAULT,
+                                               OCIO::FINALIZATION_DEFAULT));
+    OCIO_REQUIRE_ASSERT(renderOnly);
+
+    // A render-only processor is never memoized.
+    OCIO_CHECK_NE(renderOnly.get(), cpuProcessor.get());
+    OCIO::ConstCPUProcessorRcPtr renderOnly2;
+    OCIO_CHECK_NO_THROW(renderOnly2
+        = processor->getRenderOnlyCPUProcessor(OCIO::BIT_DEPTH_F32, OCIO::BIT_DEPTH_F32,
+                                               OCIO::OPTIMIZATION_DEFAULT,
+                                               OCIO::FINALIZATION_DEFAULT));
+    OCIO_CHECK_NE(renderOnly.get(), renderOnly2.get());
+    OCIO_CHECK_EQUAL(std::string(renderOnly->getCacheID()),
+                     std::string(cpuProcessor->getCacheID()));
+
+    // The finalized ops (i.e. with the 3D LUT values in floats) are released.
+    const size_t numValues = gridSize * gridSize * gridSize * 3;
+    OCIO_CHECK_ASSERT(renderOnly->getMemoryFootprint() + numValues * sizeof(float)
+                        <= cpuProcessor->getMemoryFootprint());
+
+    // Only the renderers are left in the metadata.
+    OCIO::ConstProcessorMetadataRcPtr metadata = cpuProcessor->getProcessorMetadata();
+    OCIO::ConstProcessorMetadataRcPtr renderMetadata = renderOnly->getProcessorMetadata();
+    OCIO_CHECK_EQUAL(renderMetadata->getNumOriginalOps(), 0);
+    OCIO_CHECK_EQUAL(renderMetadata->getNumOptimizedOps(), 0);
+    OCIO_REQUIRE_EQUAL(renderMetadata->getNumRenderers(), metadata->getNumRenderers());
+    for(int idx = 0; idx < metadata->getNumRenderers(); ++idx)
+    {
+        OCIO_CHECK_EQUAL(std::string(renderMetadata->getRenderer(idx)),
+                         std::string(metadata->getRenderer(idx)));
+    }
+
+    // The results are the same, even once the processor is released.
+    processor.reset();
+
+    float pixels[3 * 4] = {  0.0f,  0.0f,  0.0f, 1.0f,
+                            0.03f, 0.06f, 0.09f, 0.5f,
+                             0.7f,  0.2f,  0.4f, 0.0f };
+    float expected[3 * 4];
+    std::copy(pixels, pixels + 3 * 4, expected);
+
+    OCIO::PackedImageDesc expectedDesc(expected, 3, 1, 4);
+    OCIO_CHECK_NO_THROW(cpuProcessor->apply(expectedDesc));
+    OCIO::PackedImageDesc desc(pixels, 3, 1, 4);
+    OCIO_CHECK_NO_THROW(renderOnly->apply(desc));
+
+    for(size_t idx = 0; idx < 3 * 4; ++idx)
+    {
+        OCIO_CHECK_EQUAL(pixels[idx], expected[idx]);
+    }
+}
+
+OCIO_ADD_TEST(CPUProcessor, apply_async)
+{
+    OCIO::ConstProcessorRcPtr processor;
+    OCIO_CHECK_NO_THROW(processor = BuildParallelTestProcessor());
+
+    OCIO::ConstCPUProcessorRcPtr cpuProcessor;
+    OCIO_CHECK_NO_THROW(cpuProcessor = processor->getDefaultCPUProcessor());
+
+    constexpr long width  = 256;
+    constexpr long height = 301;
+
+    std::vector<float> img(width * height * 4);
+    for(size_t idx=0; idx<img.size(); ++idx)
+    {
+        img[idx] = float(idx % 701) / 701.0f;
+    }
+
+    std::vector<float> serialRes(img);
+    OCIO::PackedImageDesc serialDesc(&serialRes[0], width, height, 4);
+    OCIO_CHECK_NO_THROW(cpuProcessor->apply(serialDesc));
+
+    // In-place processing without any callback.
+    {
+        std::vector<float> res(img);
+        OCIO::PackedImageDesc desc(&res[0], width, height, 4);
+
+        std::future<void> done = cpuProcessor->applyAsync(desc);
+        OCIO_CHECK_NO_THROW(done.get());
+        OCIO_CHECK_ASSERT(res == serialRes);
+    }
+
+    // Processing notifying the processed bands.
+    {
+        const OCIO::PackedImageDesc srcDesc(&img[0], width, height, 4);
+
+        std::vector<float> res(img.size(), -1.0f);
+        OCIO::PackedImageDesc dstDesc(&res[0], width, height, 4);
+
+        std::mutex mutex;
+        std::vector<int> lines(height, 0);
+        bool validBands = true;
+
+        auto bandDone = [&](long yBegin, long yEnd)
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            for(long y=yBegin; y<yEnd; ++y)
+            {
+                ++lines[y];
+
+                // The lines of the band are already processed.
+                validBands = validBands && res[4 * width * y] == serialRes[4 * width * y];
+            }
+        };
+
+        std::future<void> done = cpuProcessor->applyAsync(srcDesc, dstDesc, bandDone);
+        OCIO_CHECK_NO_THROW(done.get());
+
+        OCIO_CHECK_ASSERT(res == serialRes);
+        OCIO_CHECK_ASSERT(validBands);
+        for(long y=0; y<height; ++y)
+        {
+            OCIO_CHECK_EQUAL(lines[y], 1);
+        }
+    }
+
+    // The processing errors are reported by the future.
+    {
+        const OCIO::PackedImageDesc srcDesc(&img[0], width, height, 4);
+
+        std::vector<float> res(img.size());
+        OCIO::PackedImageDesc dstDesc(&res[0], width, height - 1, 4);
+
+        std::future<void> done = cpuProcessor->applyAsync(srcDesc, dstDesc);
+        OCIO_CHECK_THROW_WHAT(done.get(), OCIO::Exception, "Dimension inconsistency");
+    }
+}
+
+OCIO_ADD_TEST(CPUProcessor, integer_lookup)
+{
+    // The unit test validates that the lookup tables of a processing without any channel
+    // crosstalk produce the same results as the regular processing.
+
+    OCIO::ConfigRcPtr config = OCIO::Config::Create();
+
+    OCIO::ExponentTransformRcPtr exponent = OCIO::ExponentTransform::Create();
+    constexpr double exp4[4] = { 2.2, 2.3, 2.4, 1.5 };
+    exponent->setValue(exp4);
+
+    OCIO::MatrixTransformRcPtr matrix = OCIO::MatrixTransform::Create();
+    constexpr double m44[16] = { 0.9, 0.0, 0.0, 0.0,
+                                 0.0, 1.1, 0.0, 0.0,
+                                 0.0, 0.0, 0.7, 0.0,
+                                 0.0, 0.0, 0.0, 0.8 };
+    constexpr double offset4[4] = { 0.01, -0.02, 0.03, 0.0 };
+    matrix->setMatrix(m44);
+    matrix->setOffset(offset4);
+
+    OCIO::GroupTransformRcPtr group = OCIO::GroupTransform::Create();
+    group->appendTransform(exponent);
+    group->appendTransform(matrix);
+
+    OCIO::ConstProcessorRcPtr processor;
+    OCIO_CHECK_NO_THROW(processor = config->getProcessor(group));
+
+    const OCIO::OptimizationFlags noLookup
+        = OCIO::OptimizationFlags(OCIO::OPTIMIZATION_DEFAULT
+                                  & ~OCIO::OPTIMIZATION_LOOKUP_INTEGER_INPUT);
+
+    OCIO::ConstCPUProcessorRcPtr lookupProcessor;
+    OCIO_CHECK_NO_THROW(lookupProcessor
+        = processor->getOptimizedCPUProcessor(OCIO::BIT_DEPTH_UINT10, OCIO::BIT_DEPTH_UINT16,
+                                              OCIO::OPTIMIZATION_DEFAULT,
+                                              OCIO::FINALIZATION_DEFAULT));
+    OCIO_CHECK_ASSERT(!lookupProcessor->hasChannelCrosstalk());
+
+    OCIO::ConstCPUProcessorRcPtr cpuProcessor;
+    OCIO_CHECK_NO_THROW(cpuProcessor
+        = processor->getOptimizedCPUProcessor(OCIO::BIT_DEPTH_UINT10, OCIO::BIT_DEPTH_UINT16,
+                                              noLookup, OCIO::FINALIZATION_DEFAULT));
+
+    constexpr long width  = 301;
+    constexpr long height = 67;
+
+    std::vector<uint16_t> img(width * height * 4);
+    for(size_t idx=0; idx<img.size(); ++idx)
+    {
+        img[idx] = uint16_t((idx * 7) % 1024);
+    }
+
+    // Packed RGBA image buffers.
+    {
+        const OCIO::PackedImageDesc srcDesc(&img[0], width, height, 4, OCIO::BIT_DEPTH_UINT10,
+                                            sizeof(uint16_t), OCIO::AutoStride, OCIO::AutoStride);
+
+        std::vector<uint16_t> ref(img.size());
+        OCIO::PackedImageDesc refDesc(&ref[0], width, height, 4, OCIO::BIT_DEPTH_UINT16,
+                                      sizeof(uint16_t), OCIO::AutoStride, OCIO::AutoStride);
+        OCIO_CHECK_NO_THROW(cpuProcessor->apply(srcDesc, refDesc));
+
+        std::vector<uint16_t> res(img.size());
+        OCIO::PackedImageDesc dstDesc(&res[0], width, height, 4, OCIO::BIT_DEPTH_UINT16,
+                                      sizeof(uint16_t), OCIO::AutoStride, OCIO::AutoStride);
+        OCIO_CHECK_NO_THROW(lookupProcessor->apply(srcDesc, dstDesc));
+        OCIO_CHECK_ASSERT(res == ref);
+
+        std::fill(res.begin(), res.end(), uint16_t(0));
+        OCIO_CHECK_NO_THROW(lookupProcessor->apply(srcDesc, dstDesc, OCIO::CPUExecutor()));
+        OCIO_CHECK_ASSERT(res == ref);
+    }
+
+    // Planar RGB image buffers i.e. processing a missing alpha.
+    {
+        std::vector<uint16_t> r(width * height), g(width * height), b(width * height);
+        for(long idx=0; idx<width * height; ++idx)
+        {
+            r[idx] = img[4 * idx + 0];
+            g[idx] = img[4 * idx + 1];
+            b[idx] = img[4 * idx + 2];
+        }
+
+        const OCIO::PlanarImageDesc srcDesc(&r[0], &g[0], &b[0], nullptr, width, height,
+                                            OCIO::BIT_DEPTH_UINT10,
+                                            sizeof(uint16_t), OCIO::AutoStride);
+
+        std::vector<uint16_t> ref(img.size());
+        OCIO::PackedImageDesc refDesc(&ref[0], width, height, 4, OCIO::BIT_DEPTH_UINT16,
+                                      sizeof(uint16_t), OCIO::AutoStride, OCIO::AutoStride);
+        OCIO_CHECK_NO_THROW(cpuProcessor->apply(srcDesc, refDesc));
+
+        std::vector<uint16_t> res(img.size());
+        OCIO::PackedImageDesc dstDesc(&res[0], width, height, 4, OCIO::BIT_DEPTH_UINT16,
+                                      sizeof(uint16_t), OCIO::AutoStride, OCIO::AutoStride);
+        OCIO_CHECK_NO_THROW(lookupProcessor->apply(srcDesc, dstDesc));
+        OCIO_CHECK_ASSERT(res == ref);
+    }
+
+    // In-place 8-bit processing.
+    {
+        OCIO::ConstCPUProcessorRcPtr lookup8;
+        OCIO_CHECK_NO_THROW(lookup8
+            = processor->getOptimizedCPUProcessor(OCIO::BIT_DEPTH_UINT8, OCIO::BIT_DEPTH_UINT8,
+                                                  OCIO::OPTIMIZATION_DEFAULT,
+                                                  OCIO::FINALIZATION_DEFAULT));
+        OCIO::ConstCPUProcessorRcPtr regular8;
+        OCIO_CHECK_NO_THROW(regular8
+            = processor->getOptimizedCPUProcessor(OCIO::BIT_DEPTH_UINT8, OCIO::BIT_DEPTH_UINT8,
+                                                  noLookup, OCIO::FINALIZATION_DEFAULT));
+
+        std::vector<uint8_t> ref(width * height * 3);
+        for(size_t idx=0; idx<ref.size(); ++idx)
+        {
+            ref[idx] = uint8_t(idx % 256);
+        }
+        std::vector<uint8_t> res(ref);
+
+        OCIO::PackedImageDesc refDesc(&ref[0], width, height, 3, OCIO::BIT_DEPTH_UINT8,
+                                      sizeof(uint8_t), OCIO::AutoStride, OCIO::AutoStride);
+        OCIO_CHECK_NO_THROW(regular8->apply(refDesc));
+
+        OCIO::PackedImageDesc resDesc(&res[0], width, height, 3, OCIO::BIT_DEPTH_UINT8,
+                                      sizeof(uint8_t), OCIO::AutoStride, OCIO::AutoStride);
+        OCIO_CHECK_NO_THROW(lookup8->apply(resDesc));
+
+        OCIO_CHECK_ASSERT(res == ref);
+    }
+}
+
+OCIO_ADD_TEST(CPUProcessor, half_lookup)
+{
+    // The half input values are looked-up by their bits so validate all the half values
+    // (including the infinities and the NaNs) against the regular processing.
+
+    OCIO::ConfigRcPtr config = OCIO::Config::Create();
+
+    OCIO::LogTransformRcPtr log = OCIO::LogTransform::Create();
+    log->setBase(10.0);
+
+    OCIO::MatrixTransformRcPtr matrix = OCIO::MatrixTransform::Create();
+    constexpr double offset4[4] = { 0.5, 0.6, 0.7, 0.0 };
+    matrix->setOffset(offset4);
+
+    OCIO::GroupTransformRcPtr group = OCIO::GroupTransform::Create();
+    group->appendTransform(log);
+    group->appendTransform(matrix);
+
+    OCIO::ConstProcessorRcPtr processor;
+    OCIO_CHECK_NO_THROW(processor = config->getProcessor(group));
+
+    const OCIO::OptimizationFlags noLookup
+        = OCIO::OptimizationFlags(OCIO::OPTIMIZATION_DEFAULT
+                                  & ~OCIO::OPTIMIZATION_LOOKUP_INTEGER_INPUT);
+
+    constexpr long width  = 256;
+    constexpr long height = 64;
+
+    std::vector<half> img(width * height * 4);
+    for(size_t idx=0; idx<img.size(); ++idx)
+    {
+        img[idx].setBits((unsigned short)idx);
+    }
+
+    const OCIO::PackedImageDesc srcDesc(&img[0], width, height, 4, OCIO::BIT_DEPTH_F16,
+                                        sizeof(half), OCIO::AutoStride, OCIO::AutoStride);
+
+    // To 32-bit float values.
+    {
+        OCIO::ConstCPUProcessorRcPtr lookupProcessor;
+        OCIO_CHECK_NO_THROW(lookupProcessor
+            = processor->getOptimizedCPUProcessor(OCIO::BIT_DEPTH_F16, OCIO::BIT_DEPTH_F32,
+                                                  OCIO::OPTIMIZATION_DEFAULT,
+                                                  OCIO::FINALIZATION_DEFAULT));
+        OCIO_CHECK_EQUAL(std::string(lookupProcessor->getProcessorMetadata()->getRenderer(0)),
+                         "IntegerLookup");
+
+        OCIO::ConstCPUProcessorRcPtr cpuProcessor;
+        OCIO_CHECK_NO_THROW(cpuProcessor
+            = processor->getOptimizedCPUProcessor(OCIO::BIT_DEPTH_F16, OCIO::BIT_DEPTH_F32,
+                                                  noLookup, OCIO::FINALIZATION_DEFAULT));
+
+        std::vector<float> ref(img.size());
+        OCIO::PackedImageDesc refDesc(&ref[0], width, height, 4);
+        OCIO_CHECK_NO_THROW(cpuProcessor->apply(srcDesc, refDesc));
+
+        std::vector<float> res(img.size());
+        OCIO::PackedImageDesc dstDesc(&res[0], width, height, 4);
+        OCIO_CHECK_NO_THROW(lookupProcessor->apply(srcDesc, dstDesc));
+
+        // Compare the bits as the NaNs are never equal.
+        OCIO_CHECK_EQUAL(memcmp(&res[0], &ref[0], res.size() * sizeof(float)), 0);
+    }
+
+    // To half values.
+    {
+        OCIO::ConstCPUProcessorRcPtr lookupProcessor;
+        OCIO_CHECK_NO_THROW(lookupProcessor
+            = processor->getOptimizedCPUProcessor(OCIO::BIT_DEPTH_F16, OCIO::BIT_DEPTH_F16,
+                                                  OCIO::OPTIMIZATION_DEFAULT,
+                                                  OCIO::FINALIZATION_DEFAULT));
+
+        OCIO::ConstCPUProcessorRcPtr cpuProcessor;
+        OCIO_CHECK_NO_THROW(cpuProcessor
+            = processor->getOptimizedCPUProcessor(OCIO::BIT_DEPTH_F16, OCIO::BIT_DEPTH_F16,
+                                                  noLookup, OCIO::FINALIZATION_DEFAULT));
+
+        std::vector<half> ref(img.size());
+        OCIO::PackedImageDesc refDesc(&ref[0], width, height, 4, OCIO::BIT_DEPTH_F16,
+                                      sizeof(half), OCIO::AutoStride, OCIO::AutoStride);
+        OCIO_CHECK_NO_THROW(cpuProcessor->apply(srcDesc, refDesc));
+
+        std::vector<half> res(img.size());
+        OCIO::PackedImageDesc dstDesc(&res[0], width, height, 4, OCIO::BIT_DEPTH_F16,
+                                      sizeof(half), OCIO::AutoStride, OCIO::AutoStride);
+        OCIO_CHECK_NO_THROW(lookupProcessor->apply(srcDesc, dstDesc));
+
+        OCIO_CHECK_EQUAL(memcmp(&res[0], &ref[0], res.size() * sizeof(half)), 0);
+    }
+}
+
+namespace
+{
+
+OCIO::ConstProcessorRcPtr BuildPlanarTestProcessor()
+{
+    OCIO::ConfigRcPtr config = OCIO::Config::Create();
+
+    OCIO::RangeTransformRcPtr range = OCIO::RangeTransform::Create();
+    range->setMinInValue(-0.1);
+    range->setMinOutValue(-0.2);
+    range->setMaxInValue(1.2);
+    range->setMaxOutValue(1.3);
+
+    OCIO::MatrixTransformRcPtr matrix = OCIO::MatrixTransform::Create();
+    constexpr double m44[16] = { 0.9, 0.1, 0.0, 0.0,
+                                 0.2, 0.7, 0.1, 0.0,
+                                 0.0, 0.3, 0.6, 0.0,
+                                 0.1, 0.0, 0.0, 0.9 };
+    constexpr double offset4[4] = { 0.25, 0.3, 0.35, 0.05 };
+    matrix->setMatrix(m44);
+    matrix->setOffset(offset4);
+
+    OCIO::LogAffineTransformRcPtr log = OCIO::LogAffineTransform::Create();
+    constexpr double linSlope[3] = { 1.1, 1.2, 1.3 };
+    constexpr double logOffset[3] = { 0.1, 0.2, 0.3 };
+    log->setLinSideSlopeValue(linSlope);
+    log->setLogSideOffsetValue(logOffset);
+
+    OCIO::LUT1DTransformRcPtr lut = OCIO::LUT1DTransform::Create(32, false);
+    for(unsigned long idx=0; idx<32; ++idx)
+    {
+        const float val = float(idx) / 31.0f;
+        lut->setValue(idx, val * val, val * 0.5f, std::sqrt(val));
+    }
+
+    OCIO::GroupTransformRcPtr group = OCIO::GroupTransform::Create();
+    group->appendTransform(range);
+    group->appendTransform(matrix);
+    group->appendTransform(log);
+    group->appendTransform(lut);
+
+    return config->getProcessor(group);
+}
+
+}
+
+OCIO_ADD_TEST(CPUProcessor, planar_processing)
+{
+    // The 32-bit float planar image buffers are directly processed on the planes
+    // (i.e. without packing the pixels) so validate the results against the packed ones.
+
+    OCIO::ConstProcessorRcPtr processor;
+    OCIO_CHECK_NO_THROW(processor = BuildPlanarTestProcessor());
+
+    OCIO::ConstCPUProcessorRcPtr cpuProcessor;
+    OCIO_CHECK_NO_THROW(cpuProcessor = processor->getDefaultCPUProcessor());
+
+    // Use several bands of lines (refer to MIN_PIXELS_PER_BAND).
+    constexpr long width  = 1031;
+    constexpr long height = 37;
+    constexpr long numPixels = width * height;
+
+    std::vector<float> img(numPixels * 4);
+    for(size_t idx=0; idx<img.size(); ++idx)
+    {
+        img[idx] = float(idx % 113) / 100.0f - 0.05f;
+    }
+
+    std::vector<float> ref(img);
+    OCIO::PackedImageDesc refDesc(&ref[0], width, height, 4);
+    OCIO_CHECK_NO_THROW(cpuProcessor->apply(refDesc));
+
+    std::vector<float> r(numPixels), g(numPixels), b(numPixels), a(numPixels);
+    for(long idx=0; idx<numPixels; ++idx)
+    {
+        r[idx] = img[4 * idx + 0];
+        g[idx] = img[4 * idx + 1];
+        b[idx] = img[4 * idx + 2];
+        a[idx] = img[4 * idx + 3];
+    }
+
+    // In-place processing using a block size not dividing the line width.
+    {
+        std::vector<float> resR(r), resG(g), resB(b), resA(a);
+        OCIO::PlanarImageDesc desc(&resR[0], &resG[0], &resB[0], &resA[0], width, height);
+
+        OCIO::SetCPUBlockSize(6);
+        OCIO_CHECK_NO_THROW(cpuProcessor->apply(desc));
+        OCIO::SetCPUBlockSize(0);
+
+        for(long idx=0; idx<numPixels; ++idx)
+        {
+            OCIO_CHECK_EQUAL(resR[idx], ref[4 * idx + 0]);
+            OCIO_CHECK_EQUAL(resG[idx], ref[4 * idx + 1]);
+            OCIO_CHECK_EQUAL(resB[idx], ref[4 * idx + 2]);
+            OCIO_CHECK_EQUAL(resA[idx], ref[4 * idx + 3]);
+        }
+    }
+
+    // Processing several bands from the source to the destination planes.
+    {
+        const OCIO::PlanarImageDesc srcDesc(&r[0], &g[0], &b[0], &a[0], width, height);
+
+        std::vector<float> resR(numPixels), resG(numPixels), resB(numPixels), resA(numPixels);
+        OCIO::PlanarImageDesc dstDesc(&resR[0], &resG[0], &resB[0], &resA[0], width, height);
+
+        OCIO::CPUExecutor executor = [](long numTasks, const std::function<void(long)> & task)
+        {
+            for(long idx=0; idx<numTasks; ++idx) task(idx);
+        };
+        OCIO_CHECK_NO_THROW(cpuProcessor->apply(srcDesc, dstDesc, executor));
+
+        for(long idx=0; idx<numPixels; ++idx)
+        {
+            OCIO_CHECK_EQUAL(resR[idx], ref[4 * idx + 0]);
+            OCIO_CHECK_EQUAL(resG[idx], ref[4 * idx + 1]);
+            OCIO_CHECK_EQUAL(resB[idx], ref[4 * idx + 2]);
+            OCIO_CHECK_EQUAL(resA[idx], ref[4 * idx + 3]);
+        }
+
+        // The source planes are untouched.
+        OCIO_CHECK_EQUAL(r[1], img[4]);
+    }
+
+    // Missing alpha planes are processed as zeros.
+    {
+        std::vector<float> rgba(img);
+        for(long idx=0; idx<numPixels; ++idx)
+        {
+            rgba[4 * idx + 3] = 0.0f;
+        }
+        OCIO::PackedImageDesc rgbaDesc(&rgba[0], width, height, 4);
+        OCIO_CHECK_NO_THROW(cpuProcessor->apply(rgbaDesc));
+
+        const OCIO::PlanarImageDesc srcDesc(&r[0], &g[0], &b[0], nullptr, width, height);
+
+        std::vector<float> resR(numPixels), resG(numPixels), resB(numPixels), resA(numPixels);
+        OCIO::PlanarImageDesc dstDesc(&resR[0], &resG[0], &resB[0], &resA[0], width, height);
+        OCIO_CHECK_NO_THROW(cpuProcessor->apply(srcDesc, dstDesc));
+
+        std::vector<float> rgbR(r), rgbG(g), rgbB(b);
+        OCIO::PlanarImageDesc inPlaceDesc(&rgbR[0], &rgbG[0], &rgbB[0], nullptr, width, height);
+        OCIO_CHECK_NO_THROW(cpuProcessor->apply(inPlaceDesc));
+
+        for(long idx=0; idx<numPixels; ++idx)
+        {
+            OCIO_CHECK_EQUAL(resR[idx], rgba[4 * idx + 0]);
+            OCIO_CHECK_EQUAL(resG[idx], rgba[4 * idx + 1]);
+            OCIO_CHECK_EQUAL(resB[idx], rgba[4 * idx + 2]);
+            OCIO_CHECK_EQUAL(resA[idx], rgba[4 * idx + 3]);
+
+            OCIO_CHECK_EQUAL(rgbR[idx], rgba[4 * idx + 0]);
+            OCIO_CHECK_EQUAL(rgbG[idx], rgba[4 * idx + 1]);
+            OCIO_CHECK_EQUAL(rgbB[idx], rgba[4 * idx + 2]);
+        }
+    }
+
+    // A strided planar image buffer is packed as before.
+    {
+        std::vector<float> planes(numPixels * 2 * 4);
+        for(long idx=0; idx<numPixels; ++idx)
+        {
+            planes[2 * idx + 0 * numPixels * 2] = r[idx];
+            planes[2 * idx + 1 * numPixels * 2] = g[idx];
+            planes[2 * idx + 2 * numPixels * 2] = b[idx];
+            planes[2 * idx + 3 * numPixels * 2] = a[idx];
+        }
+
+        OCIO::PlanarImageDesc desc(&planes[0], &planes[numPixels * 2],
+                                   &planes[numPixels * 4], &planes[numPixels * 6],
+                                   width, height, OCIO::BIT_DEPTH_F32,
+                                   2 * sizeof(float), OCIO::AutoStride);
+        OCIO_CHECK_NO_THROW(cpuProcessor->apply(desc));
+
+        for(long idx=0; idx<numPixels; ++idx)
+        {
+            OCIO_CHECK_EQUAL(planes[2 * idx + 0 * numPixels * 2], ref[4 * idx + 0]);
+            OCIO_CHECK_EQUAL(planes[2 * idx + 1 * numPixels * 2], ref[4 * idx + 1]);
+            OCIO_CHECK_EQUAL(planes[2 * idx + 2 * numPixels * 2], ref[4 * idx + 2]);
+            OCIO_CHECK_EQUAL(planes[2 * idx + 3 * numPixels * 2], ref[4 * idx + 3]);
+        }
+    }
+}
+
+namespace
+{
+
+OCIO::GroupTransformRcPtr BuildAlphaUntouchedGroup()
+{
+    OCIO::RangeTransformRcPtr range = OCIO::RangeTransform::Create();
+    range->setMinInValue(0.05);
+    range->setMinOutValue(0.1);
+    range->setMaxInValue(0.95);
+    range->setMaxOutValue(0.9);
+
+    // The alpha row & column are the identity ones.
+    OCIO::MatrixTransformRcPtr matrix = OCIO::MatrixTransform::Create();
+    constexpr double m44[16] = { 0.8, 0.1, 0.1, 0.0,
+                                 0.2, 0.7, 0.1, 0.0,
+                                 0.0, 0.3, 0.6, 0.0,
+                                 0.0, 0.0, 0.0, 1.0 };
+    constexpr double offset4[4] = { 0.05, 0.02, 0.01, 0.0 };
+    matrix->setMatrix(m44);
+    matrix->setOffset(offset4);
+
+    OCIO::LogAffineTransformRcPtr log = OCIO::LogAffineTransform::Create();
+    constexpr double linOffset[3] = { 0.1, 0.2, 0.3 };
+    log->setLinSideOffsetValue(linOffset);
+
+    OCIO::GroupTransformRcPtr group = OCIO::GroupTransform::Create();
+    group->appendTransform(range);
+    group->appendTransform(matrix);
+    group->appendTransform(log);
+
+    return group;
+}
+
+}
+
+OCIO_ADD_TEST(CPUProcessor, alpha_untouched)
+{
+    // The unit test validates that the alpha channel of an arbitrary channel layout is
+    // directly copied when no op touches it, and processed as before otherwise.
+
+    OCIO::GroupTransformRcPtr group = BuildAlphaUntouchedGroup();
+
+    OCIO::ConfigRcPtr config = OCIO::Config::Create();
+
+    const OCIO::OptimizationFlags noLookup
+        = OCIO::OptimizationFlags(OCIO::OPTIMIZATION_DEFAULT
+                                  & ~OCIO::OPTIMIZATION_LOOKUP_INTEGER_INPUT);
+
+    constexpr long width  = 131;
+    constexpr long height = 7;
+    constexpr long numPixels = width * height;
+
+    std::vector<uint16_t> img(numPixels * 4);
+    for(size_t idx=0; idx<img.size(); ++idx)
+    {
+        img[idx] = uint16_t((idx * 997) % 65536);
+    }
+
+    for(int touchesAlpha=0; touchesAlpha<2; ++touchesAlpha)
+    {
+        if(touchesAlpha)
+        {
+            OCIO::ExponentTransformRcPtr exponent = OCIO::ExponentTransform::Create();
+            constexpr double exp4[4] = { 1.0, 1.0, 1.0, 1.5 };
+            exponent->setValue(exp4);
+            group->appendTransform(exponent);
+        }
+
+        OCIO::ConstProcessorRcPtr processor;
+        OCIO_CHECK_NO_THROW(processor = config->getProcessor(group));
+
+        OCIO::ConstCPUProcessorRcPtr cpuProcessor;
+        OCIO_CHECK_NO_THROW(cpuProcessor
+            = processor->getOptimizedCPUProcessor(OCIO::BIT_DEPTH_UINT16, OCIO::BIT_DEPTH_UINT16,
+                                                  noLookup, OCIO::FINALIZATION_DEFAULT));
+
+        // The packed RGBA buffer processes the alpha channel.
+        std::vector<uint16_t> ref(img);
+        OCIO::PackedImageDesc refDesc(&ref[0], width, height, 4, OCIO::BIT_DEPTH_UINT16,
+                                      sizeof(uint16_t), 4 * sizeof(uint16_t),
+                                      width * 4 * sizeof(uint16_t));
+        OCIO_CHECK_NO_THROW(cpuProcessor->apply(refDesc));
+
+        bool alphaChanged = false;
+        for(long idx=0; idx<numPixels; ++idx)
+        {
+            alphaChanged |= ref[4 * idx + 3]!=img[4 * idx + 3];
+        }
+        OCIO_CHECK_EQUAL(alphaChanged, touchesAlpha!=0);
+
+        std::vector<uint16_t> r(numPixels), g(numPixels), b(numPixels), a(numPixels);
+        for(long idx=0; idx<numPixels; ++idx)
+        {
+            r[idx] = img[4 * idx + 0];
+            g[idx] = img[4 * idx + 1];
+            b[idx] = img[4 * idx + 2];
+            a[idx] = img[4 * idx + 3];
+        }
+
+        // Process from the source to the destination planes, using a block size
+        // not dividing the line width.
+        {
+            const OCIO::PlanarImageDesc srcDesc(&r[0], &g[0], &b[0], &a[0], width, height,
+                                                OCIO::BIT_DEPTH_UINT16, sizeof(uint16_t),
+                                                OCIO::AutoStride);
+
+            std::vector<uint16_t> resR(numPixels), resG(numPixels);
+            std::vector<uint16_t> resB(numPixels), resA(numPixels);
+            OCIO::PlanarImageDesc dstDesc(&resR[0], &resG[0], &resB[0], &resA[0],
+                                          width, height, OCIO::BIT_DEPTH_UINT16,
+                                          sizeof(uint16_t), OCIO::AutoStride);
+
+            OCIO::SetCPUBlockSize(6);
+            OCIO_CHECK_NO_THROW(cpuProcessor->apply(srcDesc, dstDesc));
+            OCIO::SetCPUBlockSize(0);
+
+            for(long idx=0; idx<numPixels; ++idx)
+            {
+                OCIO_CHECK_EQUAL(resR[idx], ref[4 * idx + 0]);
+                OCIO_CHECK_EQUAL(resG[idx], ref[4 * idx + 1]);
+                OCIO_CHECK_EQUAL(resB[idx], ref[4 * idx + 2]);
+                OCIO_CHECK_EQUAL(resA[idx], ref[4 * idx + 3]);
+            }
+        }
+
+        // Process in place.
+        {
+            std::vector<uint16_t> resR(r), resG(g), resB(b), resA(a);
+            OCIO::PlanarImageDesc desc(&resR[0], &resG[0], &resB[0], &resA[0], width, height,
+                                       OCIO::BIT_DEPTH_UINT16, sizeof(uint16_t),
+                                       OCIO::AutoStride);
+            OCIO_CHECK_NO_THROW(cpuProcessor->apply(desc));
+
+            for(long idx=0; idx<numPixels; ++idx)
+            {
+                OCIO_CHECK_EQUAL(resR[idx], ref[4 * idx + 0]);
+                OCIO_CHECK_EQUAL(resG[idx], ref[4 * idx + 1]);
+                OCIO_CHECK_EQUAL(resB[idx], ref[4 * idx + 2]);
+                OCIO_CHECK_EQUAL(resA[idx], ref[4 * idx + 3]);
+            }
+        }
+
+        // The 32-bit float planes are processed without packing (refer to applyPlanar()).
+        {
+            OCIO::ConstCPUProcessorRcPtr floatProcessor;
+            OCIO_CHECK_NO_THROW(floatProcessor = processor->getDefaultCPUProcessor());
+
+            std::vector<float> rgba(numPixels * 4);
+            for(size_t idx=0; idx<rgba.size(); ++idx)
+            {
+                rgba[idx] = float(img[idx]) / 65535.0f;
+            }
+
+            std::vector<float> fR(numPixels), fG(numPixels), fB(numPixels), fA(numPixels);
+            for(long idx=0; idx<numPixels; ++idx)
+            {
+                fR[idx] = rgba[4 * idx + 0];
+                fG[idx] = rgba[4 * idx + 1];
+                fB[idx] = rgba[4 * idx + 2];
+                fA[idx] = rgba[4 * idx + 3];
+            }
+
+            OCIO::PackedImageDesc rgbaDesc(&rgba[0], width, height, 4);
+            OCIO_CHECK_NO_THROW(floatProcessor->apply(rgbaDesc));
+
+            const OCIO::PlanarImageDesc srcDesc(&fR[0], &fG[0], &fB[0], &fA[0], width, height);
+
+            std::vector<float> resR(numPixels), resG(numPixels);
+            std::vector<float> resB(numPixels), resA(numPixels);
+            OCIO::PlanarImageDesc dstDesc(&resR[0], &resG[0], &resB[0], &resA[0],
+                                          width, height);
+            OCIO_CHECK_NO_THROW(floatProcessor->apply(srcDesc, dstDesc));
+
+            OCIO::PlanarImageDesc inPlaceDesc(&fR[0], &fG[0], &fB[0], &fA[0], width, height);
+            OCIO_CHECK_NO_THROW(floatProcessor->apply(inPlaceDesc));
+
+            for(long idx=0; idx<numPixels; ++idx)
+            {
+                OCIO_CHECK_EQUAL(resR[idx], rgba[4 * idx + 0]);
+                OCIO_CHECK_EQUAL(resG[idx], rgba[4 * idx + 1]);
+                OCIO_CHECK_EQUAL(resB[idx], rgba[4 * idx + 2]);
+                OCIO_CHECK_EQUAL(resA[idx], rgba[4 * idx + 3]);
+
+                OCIO_CHECK_EQUAL(fR[idx], rgba[4 * idx + 0]);
+                OCIO_CHECK_EQUAL(fA[idx], rgba[4 * idx + 3]);
+            }
+        }
+    }
+}
+
+namespace
+{
+
+// Process the image in the BGRA, ARGB & ABGR channel orderings (i.e. from the source to
+// the destination image, and in place), and check the results against the RGBA ones.
+template<typename Type>
+void ValidateShuffledChannels(const OCIO::ConstProcessorRcPtr & processor,
+                              OCIO::BitDepth bitDepth, const std::vector<Type> & rgbaImg,
+                              long width, long height)
+{
+    const OCIO::OptimizationFlags noLookup
+        = OCIO::OptimizationFlags(OCIO::OPTIMIZATION_DEFAULT
+                                  & ~OCIO::OPTIMIZATION_LOOKUP_INTEGER_INPUT);
+
+    OCIO::ConstCPUProcessorRcPtr cpuProcessor;
+    OCIO_CHECK_NO_THROW(cpuProcessor
+        = processor->getOptimizedCPUProcessor(bitDepth, bitDepth,
+                                              noLookup, OCIO::FINALIZATION_DEFAULT));
+
+    const ptrdiff_t xStrideBytes = 4 * sizeof(Type);
+    const ptrdiff_t yStrideBytes = width * xStrideBytes;
+    const long numPixels = width * height;
+
+    std::vector<Type> ref(rgbaImg);
+    OCIO::PackedImageDesc refDesc(&ref[0], width, height, 4, bitDepth,
+                                  sizeof(Type), xStrideBytes, yStrideBytes);
+    OCIO_CHECK_NO_THROW(cpuProcessor->apply(refDesc));
+
+    // The positions of the R, G, B & A channels in the pixels.
+    constexpr size_t orderings[3][4] = { { 2, 1, 0, 3 }, { 1, 2, 3, 0 }, { 3, 2, 1, 0 } };
+
+    for(const auto & pos : orderings)
+    {
+        std::vector<Type> src(rgbaImg.size());
+        for(long idx=0; idx<numPixels; ++idx)
+        {
+            for(size_t chan=0; chan<4; ++chan)
+            {
+                src[4 * idx + pos[chan]] = rgbaImg[4 * idx + chan];
+            }
+        }
+
+        std::vector<Type> dst(src.size());
+        const OCIO::PlanarImageDesc srcDesc(&src[pos[0]], &src[pos[1]], &src[pos[2]],
+                                            &src[pos[3]], width, height, bitDepth,
+                                            xStrideBytes, yStrideBytes);
+        OCIO::PlanarImageDesc dstDesc(&dst[pos[0]], &dst[pos[1]], &dst[pos[2]], &dst[pos[3]],
+                                      width, height, bitDepth, xStrideBytes, yStrideBytes);
+        OCIO_CHECK_NO_THROW(cpuProcessor->apply(srcDesc, dstDesc));
+
+        OCIO::PlanarImageDesc inPlaceDesc(&src[pos[0]], &src[pos[1]], &src[pos[2]],
+                                          &src[pos[3]], width, height, bitDepth,
+                                          xStrideBytes, yStrideBytes);
+        OCIO_CHECK_NO_THROW(cpuProcessor->apply(inPlaceDesc));
+
+        for(long idx=0; idx<numPixels; ++idx)
+        {
+            for(size_t chan=0; chan<4; ++chan)
+            {
+                const Type * res = &ref[4 * idx + chan];
+                OCIO_CHECK_EQUAL(memcmp(&dst[4 * idx + pos[chan]], res, sizeof(Type)), 0);
+                OCIO_CHECK_EQUAL(memcmp(&src[4 * idx + pos[chan]], res, sizeof(Type)), 0);
+            }
+        }
+    }
+}
+
+}
+
+OCIO_ADD_TEST(CPUProcessor, shuffled_channels)
+{
+    // The unit test validates that the four channel layouts in any channel ordering
+    // (i.e. packed & unpacked with byte shuffles when available) give the same results
+    // than the RGBA ones, with and without changing the alpha channel.
+
+    OCIO::GroupTransformRcPtr group = BuildAlphaUntouchedGroup();
+
+    OCIO::ConfigRcPtr config = OCIO::Config::Create();
+
+    // A width not multiple of the number of pixels per vector.
+    constexpr long width  = 67;
+    constexpr long height = 5;
+    constexpr long numPixels = width * height;
+
+    std::vector<uint8_t> img8(numPixels * 4);
+    std::vector<uint16_t> img16(numPixels * 4);
+    std::vector<half> imgHalf(numPixels * 4);
+    std::vector<float> imgFloat(numPixels * 4);
+    for(size_t idx=0; idx<img8.size(); ++idx)
+    {
+        img8[idx]     = uint8_t((idx * 37) % 256);
+        img16[idx]    = uint16_t((idx * 997) % 65536);
+        imgFloat[idx] = float((idx * 37) % 1000) / 999.0f;
+        imgHalf[idx]  = half(imgFloat[idx]);
+    }
+
+    for(int touchesAlpha=0; touchesAlpha<2; ++touchesAlpha)
+    {
+        if(touchesAlpha)
+        {
+            OCIO::ExponentTransformRcPtr exponent = OCIO::ExponentTransform::Create();
+            constexpr double exp4[4] = { 1.0, 1.0, 1.0, 1.5 };
+            exponent->setValue(exp4);
+            group->appendTransform(exponent);
+        }
+
+        OCIO::ConstProcessorRcPtr processor;
+        OCIO_CHECK_NO_THROW(processor = config->getProcessor(group));
+
+        ValidateShuffledChannels(processor, OCIO::BIT_DEPTH_UINT8, img8, width, height);
+        ValidateShuffledChannels(processor, OCIO::BIT_DEPTH_UINT16, img16, width, height);
+        ValidateShuffledChannels(processor, OCIO::BIT_DEPTH_F16, imgHalf, width, height);
+        ValidateShuffledChannels(processor, OCIO::BIT_DEPTH_F32, imgFloat, width, height);
+    }
+}
+
+OCIO_ADD_TEST(CPUProcessor, packed_rgb_processing)
+{
+    // The unit test validates that the 32-bit float packed RGB image buffers give the
+    // same results than the packed RGBA ones with a zero alpha (i.e. whatever the
+    // processing path is).
+
+    OCIO::GroupTransformRcPtr group = BuildAlphaUntouchedGroup();
+
+    OCIO::ConfigRcPtr config = OCIO::Config::Create();
+
+    constexpr long width  = 131;
+    constexpr long height = 7;
+    constexpr long numPixels = width * height;
+
+    std::vector<float> img(numPixels * 3);
+    for(size_t idx=0; idx<img.size(); ++idx)
+    {
+        img[idx] = float((idx * 997) % 1200) / 1000.0f - 0.1f;
+    }
+
+    for(int touchesAlpha=0; touchesAlpha<2; ++touchesAlpha)
+    {
+        if(touchesAlpha)
+        {
+            // The packed RGB pixels are then processed through the packed RGBA buffers.
+            OCIO::ExponentTransformRcPtr exponent = OCIO::ExponentTransform::Create();
+            constexpr double exp4[4] = { 1.0, 1.0, 1.0, 1.5 };
+            exponent->setValue(exp4);
+            group->appendTransform(exponent);
+        }
+
+        OCIO::ConstProcessorRcPtr processor;
+        OCIO_CHECK_NO_THROW(processor = config->getProcessor(group));
+
+        OCIO::ConstCPUProcessorRcPtr cpuProcessor;
+        OCIO_CHECK_NO_THROW(cpuProcessor = processor->getDefaultCPUProcessor());
+
+        std::vector<float> ref(numPixels * 4);
+        for(long idx=0; idx<numPixels; ++idx)
+        {
+            ref[4 * idx + 0] = img[3 * idx + 0];
+            ref[4 * idx + 1] = img[3 * idx + 1];
+            ref[4 * idx + 2] = img[3 * idx + 2];
+            ref[4 * idx + 3] = 0.0f;
+        }
+        OCIO::PackedImageDesc refDesc(&ref[0], width, height, 4);
+        OCIO_CHECK_NO_THROW(cpuProcessor->apply(refDesc));
+
+        // In-place processing.
+        {
+            std::vector<float> res(img);
+            OCIO::PackedImageDesc resDesc(&res[0], width, height, 3);
+            OCIO_CHECK_NO_THROW(cpuProcessor->apply(resDesc));
+
+            for(long idx=0; idx<numPixels; ++idx)
+            {
+                for(long c=0; c<3; ++c)
+                {
+                    OCIO_CHECK_EQUAL(res[3 * idx + c], ref[4 * idx + c]);
+                }
+            }
+        }
+
+        // Process from the source to the destination buffer by bands, using a block
+        // size not dividing the line width.
+        {
+            const OCIO::PackedImageDesc srcDesc(&img[0], width, height, 3);
+
+            std::vector<float> res(img.size(), -1.0f);
+            OCIO::PackedImageDesc dstDesc(&res[0], width, height, 3);
+
+            OCIO::CPUExecutor executor = [](long numTasks, const std::function<void(long)> & task)
+            {
+                for(long idx=0; idx<numTasks; ++idx)
+                {
+                    task(idx);
+                }
+            };
+
+            OCIO::SetCPUBlockSize(6);
+            OCIO_CHECK_NO_THROW(cpuProcessor->apply(srcDesc, dstDesc, executor));
+            OCIO::SetCPUBlockSize(0);
+
+            for(long idx=0; idx<numPixels; ++idx)
+            {
+                for(long c=0; c<3; ++c)
+                {
+                    OCIO_CHECK_EQUAL(res[3 * idx + c], ref[4 * idx + c]);
+                }
+            }
+        }
+    }
+}
+
+namespace
+{
+
+// Process in place an image having extra channels around the color ones, and check that
+// the color channels give the RGBA results while the other channels are left untouched.
+template<typename Type>
+void ValidateChannelOffsets(const OCIO::ConstProcessorRcPtr & processor,
+                            OCIO::BitDepth bitDepth, const std::vector<Type> & rgbaImg,
+                            long width, long height)
+{
+    OCIO::ConstCPUProcessorRcPtr cpuProcessor;
+    OCIO_CHECK_NO_THROW(cpuProcessor
+        = processor->getOptimizedCPUProcessor(bitDepth, bitDepth,
+                                              OCIO::OPTIMIZATION_DEFAULT,
+                                              OCIO::FINALIZATION_DEFAULT));
+
+    const long numPixels = width * height;
+
+    std::vector<Type> ref(rgbaImg);
+    OCIO::PackedImageDesc refDesc(&ref[0], width, height, 4, bitDepth, sizeof(Type),
+                                  OCIO::AutoStride, OCIO::AutoStride);
+    OCIO_CHECK_NO_THROW(cpuProcessor->apply(refDesc));
+
+    // Seven channels per pixel, the color ones being at the positions 3 (R), 1 (G),
+    // 4 (B) and 6 (A).
+    constexpr long numChannels = 7;
+    constexpr size_t pos[4] = { 3, 1, 4, 6 };
+
+    std::vector<Type> img(numPixels * numChannels);
+    for(size_t idx=0; idx<img.size(); ++idx)
+    {
+        img[idx] = rgbaImg[(idx * 7) % rgbaImg.size()];
+    }
+    for(long idx=0; idx<numPixels; ++idx)
+    {
+        for(size_t chan=0; chan<4; ++chan)
+        {
+            img[numChannels * idx + pos[chan]] = rgbaImg[4 * idx + chan];
+        }
+    }
+    const std::vector<Type> src(img);
+
+    OCIO::PackedImageDesc imgDesc(&img[0], width, height, numChannels, bitDepth,
+                                  pos[0] * sizeof(Type), pos[1] * sizeof(Type),
+                                  pos[2] * sizeof(Type), pos[3] * sizeof(Type),
+                                  OCIO::AutoStride, OCIO::AutoStride);
+    OCIO_CHECK_ASSERT(!imgDesc.isRGBAPacked());
+    OCIO_CHECK_NO_THROW(cpuProcessor->apply(imgDesc));
+
+    for(long idx=0; idx<numPixels; ++idx)
+    {
+        for(size_t chan=0; chan<size_t(numChannels); ++chan)
+        {
+            const Type * res = &src[numChannels * idx + chan];
+            for(size_t c=0; c<4; ++c)
+            {
+                if(pos[c]==chan)
+                {
+                    res = &ref[4 * idx + c];
+                }
+            }
+            OCIO_CHECK_EQUAL(memcmp(&img[numChannels * idx + chan], res, sizeof(Type)), 0);
+        }
+    }
+}
+
+}
 
-        ComputeValues<OCIO::BIT_DEPTH_UINT10,
-                      OCIO::BIT_DEPTH_UINT10, __LINE__>(processor,
-                                                        &ui10_inImg[0], OCIO::CHANNEL_ORDERING_RGB,
-                                                        &ui10_resImg[0],  OCIO::CHANNEL_ORDERING_RGBA,
-                                                        NB_PIXELS);
+OCIO_ADD_TEST(CPUProcessor, channel_offsets)
+{
+    // The unit test validates the packed image buffers with more than four channels (i.e.
+    // the color channels being at explicit offsets within the pixels).
 
-        const std::vector<uint16_t> ui16_resImg
-            = {     0,   394,   955,   0,
-                 1656,  3092,  6794,   0,
-                 2301,  6794, 16162,   0,
-                 3092, 65535, 24593,   0 };
+    OCIO::GroupTransformRcPtr group = BuildAlphaUntouchedGroup();
 
-        ComputeValues<OCIO::BIT_DEPTH_UINT10,
-                      OCIO::BIT_DEPTH_UINT16, __LINE__>(processor,
-                                                        &ui10_inImg[0], OCIO::CHANNEL_ORDERING_RGB,
-                                                        &ui16_resImg[0],  OCIO::CHANNEL_ORDERING_RGBA,
-                                                        NB_PIXELS);
-    }
+    OCIO::ConfigRcPtr config = OCIO::Config::Create();
 
-    // Test OCIO::BIT_DEPTH_UINT12.
+    constexpr long width  = 37;
+    constexpr long height = 3;
+    constexpr long numPixels = width * height;
 
+    std::vector<uint16_t> img16(numPixels * 4);
+    std::vector<float> imgFloat(numPixels * 4);
+    for(size_t idx=0; idx<imgFloat.size(); ++idx)
     {
-        const std::vector<uint16_t> ui12_resImg
-            = {     0,     1,     6,     0,
-                    8,    11,    17,     2,
-                   25,    37,    60,     4,
-                  124,   537,  4095,    32 };
-
-        ComputeValues<OCIO::BIT_DEPTH_UINT16,
-                      OCIO::BIT_DEPTH_UINT12, __LINE__>(processor,
-                                                        &ui16_inImg[0], OCIO::CHANNEL_ORDERING_RGBA,
-                                                        &ui12_resImg[0],  OCIO::CHANNEL_ORDERING_RGBA,
-                                                        NB_PIXELS);
+        img16[idx]    = uint16_t((idx * 997) % 65536);
+        imgFloat[idx] = float((idx * 37) % 1000) / 999.0f;
     }
 
+    for(int touchesAlpha=0; touchesAlpha<2; ++touchesAlpha)
     {
-        const std::vector<uint16_t> ui12_inImg 
-            = {     0,     8,    32,
-                   64,   128,   256,
-                   96,   256,   512,
-                 1024,  2048,  4095  };
-
-        const std::vector<uint16_t> ui12_resImg
-            = {     0,    11,    25,   0,
-                   37,    60,   103,   0,
-                   49,   103,   193,   0,
-                  424,  1009,  4095,   0 };
+        if(touchesAlpha)
+        {
+            OCIO::ExponentTransformRcPtr exponent = OCIO::ExponentTransform::Create();
+            constexpr double exp4[4] = { 1.0, 1.0, 1.0, 1.5 };
+            exponent->setValue(exp4);
+            group->appendTransform(exponent);
+        }
 
-        ComputeValues<OCIO::BIT_DEPTH_UINT12,
-                      OCIO::BIT_DEPTH_UINT12, __LINE__>(processor,
-                                                        &ui12_inImg[0], OCIO::CHANNEL_ORDERING_RGB,
-                                                        &ui12_resImg[0],  OCIO::CHANNEL_ORDERING_RGBA,
-                                                        NB_PIXELS);
-        const std::vector<uint16_t> ui16_resImg
-            = {     0,   178,   394,   0,
-                  598,   955,  1655,   0,
-                  779,  1655,  3089,   0,
-                 6789, 16143, 65535,   0 };
+        OCIO::ConstProcessorRcPtr processor;
+        OCIO_CHECK_NO_THROW(processor = config->getProcessor(group));
 
-        ComputeValues<OCIO::BIT_DEPTH_UINT12,
-                      OCIO::BIT_DEPTH_UINT16, __LINE__>(processor,
-                                                        &ui12_inImg[0], OCIO::CHANNEL_ORDERING_RGB,
-                                                        &ui16_resImg[0],  OCIO::CHANNEL_ORDERING_RGBA,
-                                                        NB_PIXELS);
+        ValidateChannelOffsets(processor, OCIO::BIT_DEPTH_UINT16, img16, width, height);
+        ValidateChannelOffsets(processor, OCIO::BIT_DEPTH_F32, imgFloat, width, height);
     }
 
+    // Validate the channel offsets.
+
+    std::vector<float> img(numPixels * 6);
+    const ptrdiff_t chanSize = sizeof(float);
+
+    OCIO_CHECK_NO_THROW(OCIO::PackedImageDesc(&img[0], width, height, 6, OCIO::BIT_DEPTH_F32,
+                                              0, chanSize, 2 * chanSize, -1,
+                                              OCIO::AutoStride, OCIO::AutoStride));
+    OCIO_CHECK_THROW_WHAT(OCIO::PackedImageDesc(&img[0], width, height, 6, OCIO::BIT_DEPTH_F32,
+                                                0, chanSize, 6 * chanSize, -1,
+                                                OCIO::AutoStride, OCIO::AutoStride),
+                          OCIO::Exception, "Invalid channel offset");
+    OCIO_CHECK_THROW_WHAT(OCIO::PackedImageDesc(&img[0], width, height, 6, OCIO::BIT_DEPTH_F32,
+                                                0, chanSize, chanSize, -1,
+                                                OCIO::AutoStride, OCIO::AutoStride),
+                          OCIO::Exception, "Overlapping channel offsets");
+    OCIO_CHECK_THROW_WHAT(OCIO::PackedImageDesc(&img[0], width, height, 3, OCIO::BIT_DEPTH_F32,
+                                                0, chanSize, 2 * chanSize, 3 * chanSize,
+                                                OCIO::AutoStride, OCIO::AutoStride),
+                          OCIO::Exception, "Invalid number of channels");
+
+    // The four channels packed in RGBA order are still optimized.
+    OCIO::PackedImageDesc rgbaDesc(&img[0], width, height, 4, OCIO::BIT_DEPTH_F32,
+                                   0, chanSize, 2 * chanSize, 3 * chanSize,
+                                   OCIO::AutoStride, OCIO::AutoStride);
+    OCIO_CHECK_ASSERT(rgbaDesc.isRGBAPacked());
+    OCIO_CHECK_EQUAL(rgbaDesc.getNumChannels(), 4);
 }
 
-OCIO_ADD_TEST(CPUProcessor, with_several_ops)
+namespace
 {
-    // The unit test validates that pixel formats are correctly
-    // processed when the op list starts or ends with a 1D LUT because it
-    // has a dedicated optimization when the input bit-depth is an integer type.
 
-    const std::string SIMPLE_PROFILE =
-        "ocio_profile_version: 2\n"
-        "\n"
-        "search_path: " + std::string(OCIO::getTestFilesDir()) + "\n"
-        "strictparsing: true\n"
-        "luma: [0.2126, 0.7152, 0.0722]\n"
-        "\n"
-        "roles:\n"
-        "  default: cs1\n"
-        "  scene_linear: cs2\n"
-        "\n"
-        "displays:\n"
-        "  sRGB:\n"
-        "    - !<View> {name: Raw, colorspace: cs1}\n"
-        "\n"
-        "colorspaces:\n"
-        "  - !<ColorSpace>\n"
-        "    name: cs1\n"
-        "    allocation: uniform\n"
-        "\n"
-        "  - !<ColorSpace>\n"
-        "    name: cs2\n"
-        "    allocation: uniform\n";
+// The BT.709 limited range conversions of the 8-bit codes.
+void DecodeBT709(float y, float u, float v, float rgb[3])
+{
+    const float luma = (y - 16.0f) / 219.0f;
+    const float cb   = (u - 128.0f) / 224.0f;
+    const float cr   = (v - 128.0f) / 224.0f;
 
-    // Step 1: The 1D LUT is the last Op.
+    rgb[0] = luma + 1.5748f * cr;
+    rgb[1] = luma - 0.0722f * 1.8556f / 0.7152f * cb - 0.2126f * 1.5748f / 0.7152f * cr;
+    rgb[2] = luma + 1.8556f * cb;
+}
 
-    {
-        const std::string strEnd =
-            "    from_reference: !<GroupTransform>\n"
-            "      children:\n"
-            "        - !<MatrixTransform> { offset: [-0.19, 0.19, -0.00019, 0] }\n"
-            "        - !<FileTransform>   { src: lut1d_5.spi1d, interpolation: linear }\n";
+void EncodeBT709(const float rgb[3], float & luma, float & cb, float & cr)
+{
+    luma = 0.2126f * rgb[0] + 0.7152f * rgb[1] + 0.0722f * rgb[2];
+    cb   = (rgb[2] - luma) / 1.8556f;
+    cr   = (rgb[0] - luma) / 1.5748f;
+}
 
-        const std::string str = SIMPLE_PROFILE + strEnd;
+}
 
-        std::istringstream is;
-        is.str(str);
+OCIO_ADD_TEST(CPUProcessor, yuv_image_desc)
+{
+    // The unit test validates the decoding & encoding of the YUV image buffers, including
+    // the odd dimensions, and the chroma samples shared by several blocks of pixels.
 
-        OCIO::ConstConfigRcPtr config;
-        OCIO_CHECK_NO_THROW(config = OCIO::Config::CreateFromStream(is));
-        OCIO_CHECK_NO_THROW(config->sanityCheck());
+    constexpr long width    = 13;
+    constexpr long height   = 7;
+    constexpr long uvWidth  = (width + 1) / 2;
+    constexpr long uvHeight = (height + 1) / 2;
 
-        OCIO::ConstProcessorRcPtr processor;
-        OCIO_CHECK_NO_THROW(processor = config->getProcessor("cs1", "cs2"));
+    std::vector<uint8_t> yPlane(width * height);
+    std::vector<uint8_t> uvPlane(2 * uvWidth * uvHeight);
+    for(size_t idx=0; idx<yPlane.size(); ++idx)
+    {
+        yPlane[idx] = uint8_t(16 + (idx * 37) % 220);
+    }
+    for(size_t idx=0; idx<uvPlane.size(); ++idx)
+    {
+        uvPlane[idx] = uint8_t(16 + (idx * 53) % 225);
+    }
 
-        constexpr unsigned NB_PIXELS = 4;
+    OCIO::ConfigRcPtr config = OCIO::Config::Create();
 
-        const std::vector<float> f_inImg =
-            {  -1.0000f, -0.8000f, -0.1000f,  0.0f,
-                0.1002f,  0.2509f,  0.5009f,  1.0f,
-                0.5505f,  0.7090f,  0.9099f,  1.0f,
-                1.0000f,  1.2500f,  1.9900f,  0.0f  };
+    OCIO::ConstProcessorRcPtr processor;
+    OCIO_CHECK_NO_THROW(processor = config->getProcessor(OCIO::MatrixTransform::Create()));
+    OCIO::ConstCPUProcessorRcPtr cpuProcessor;
+    OCIO_CHECK_NO_THROW(cpuProcessor = processor->getDefaultCPUProcessor());
 
-        {
-            const std::vector<float> resImg
-                = {  0.0f,         0.0f,         0.0f,         0.0f,
-                     0.0f,         0.20273837f,  0.24680146f,  1.0f,
-                     0.15488569f,  1.69210147f,  1.90666747f,  1.0f,
-                     0.81575858f, 64.0f,        64.0f,         0.0f };
+    // Decode the NV12 image buffer.
+    {
+        const OCIO::YUVImageDesc srcDesc(&yPlane[0], &uvPlane[0], nullptr, width, height,
+                                         OCIO::YUV_LAYOUT_NV12, OCIO::YUV_MATRIX_BT709,
+                                         OCIO::YUV_RANGE_LIMITED);
 
-            ComputeValues<OCIO::BIT_DEPTH_F32,
-                          OCIO::BIT_DEPTH_F32, __LINE__>(processor,
-                                                         &f_inImg[0], OCIO::CHANNEL_ORDERING_RGBA,
-                                                         &resImg[0],  OCIO::CHANNEL_ORDERING_RGBA,
-                                                         NB_PIXELS, 1e-7f);
-        }
+        std::vector<float> rgba(4 * width * height, -1.0f);
+        OCIO::PackedImageDesc dstDesc(&rgba[0], width, height, 4);
+        OCIO_CHECK_NO_THROW(cpuProcessor->apply(srcDesc, dstDesc));
 
+        for(long y=0; y<height; ++y)
         {
-            const std::vector<uint16_t> resImg
-                = {     0,     0,     0,     0,
-                        0, 13286, 16174, 65535,
-                    10150, 65535, 65535, 65535,
-                    53461, 65535, 65535,     0 };
+            for(long x=0; x<width; ++x)
+            {
+                const size_t uvIdx = 2 * ((y / 2) * uvWidth + x / 2);
 
-            ComputeValues<OCIO::BIT_DEPTH_F32,
-                          OCIO::BIT_DEPTH_UINT16, __LINE__>(processor,
-                                                            &f_inImg[0], OCIO::CHANNEL_ORDERING_RGBA,
-                                                            &resImg[0],  OCIO::CHANNEL_ORDERING_RGBA,
-                                                            NB_PIXELS);
+                float rgb[3];
+                DecodeBT709(yPlane[y * width + x], uvPlane[uvIdx], uvPlane[uvIdx + 1], rgb);
+
+                const float * res = &rgba[4 * (y * width + x)];
+                OCIO_CHECK_CLOSE(res[0], rgb[0], 1e-5f);
+                OCIO_CHECK_CLOSE(res[1], rgb[1], 1e-5f);
+                OCIO_CHECK_CLOSE(res[2], rgb[2], 1e-5f);
+                OCIO_CHECK_EQUAL(res[3], 0.0f);
+            }
         }
+    }
 
-        const std::vector<uint16_t> i_inImg =
-            {    0,      8,    32,  0,
-                64,    128,   256,  65535,
-               512,   1024,  2048,  0,
-              5120,  20480, 65535,  65535  };
+    // The in-place processing gives the same codes (i.e. the pixels sharing a chroma sample
+    // have the same chroma values), even with blocks not aligned on the chroma samples.
+    {
+        std::vector<uint8_t> yRes(yPlane);
+        std::vector<uint8_t> uvRes(uvPlane);
+        OCIO::YUVImageDesc imgDesc(&yRes[0], &uvRes[0], nullptr, width, height,
+                                   OCIO::YUV_LAYOUT_NV12, OCIO::YUV_MATRIX_BT709,
+                                   OCIO::YUV_RANGE_LIMITED);
+
+        OCIO::SetCPUBlockSize(3);
+        OCIO_CHECK_NO_THROW(cpuProcessor->apply(imgDesc));
+        OCIO::SetCPUBlockSize(0);
+
+        OCIO_CHECK_ASSERT(yRes==yPlane);
+        OCIO_CHECK_ASSERT(uvRes==uvPlane);
+    }
 
+    // Encode to the I420 image buffer i.e. the chroma samples being the average of the
+    // pixels sharing them.
+    {
+        std::vector<float> rgba(4 * width * height);
+        for(size_t idx=0; idx<rgba.size(); ++idx)
         {
-            const std::vector<float> resImg
-                = {  0.0f,  0.07789713f,  0.00088374f,  0.0f,
-                     0.0f,  0.07871927f,  0.00396248f,  1.0f,
-                     0.0f,  0.08474064f,  0.01450117f,  0.0f,
-                     0.0f,  0.24826171f, 56.39490891f,  1.0f };
-
-            auto cpuProcessor = ComputeValues<OCIO::BIT_DEPTH_UINT16,
-                                              OCIO::BIT_DEPTH_F32,
-                                              __LINE__>(processor, 
-                                                        &i_inImg[0], OCIO::CHANNEL_ORDERING_RGBA, 
-                                                        &resImg[0],  OCIO::CHANNEL_ORDERING_RGBA, 
-                                                        NB_PIXELS, 1e-7f);
+            rgba[idx] = float((idx * 29) % 100) / 99.0f;
+        }
+        const OCIO::PackedImageDesc srcDesc(&rgba[0], width, height, 4);
 
-            const std::string cacheID{ cpuProcessor->getCacheID() };
+        std::vector<uint8_t> yRes(width * height);
+        std::vector<uint8_t> uRes(uvWidth * uvHeight);
+        std::vector<uint8_t> vRes(uvWidth * uvHeight);
+        OCIO::YUVImageDesc dstDesc(&yRes[0], &uRes[0], &vRes[0], width, height,
+                                   OCIO::YUV_LAYOUT_I420, OCIO::YUV_MATRIX_BT709,
+                                   OCIO::YUV_RANGE_LIMITED);
 
-            const std::string expectedID("CPU Processor: from 16ui to 32f oFlags 1791 fFlags 1 ops"
-                " : <Lut1D $a57d7444e629d796d2234c18a0539c74 forward default standard domain none >");
+        OCIO::SetCPUBlockSize(3);
+        OCIO_CHECK_NO_THROW(cpuProcessor->apply(srcDesc, dstDesc));
+        OCIO::SetCPUBlockSize(0);
 
-            // Test integer optimization. The ops should be optimized into a single LUT
-            // when finalizing with an integer input bit-depth.
-            OCIO_CHECK_EQUAL(cacheID, expectedID);
-        }
+        std::vector<float> cbSums(uvWidth * uvHeight, 0.0f);
+        std::vector<float> crSums(uvWidth * uvHeight, 0.0f);
+        std::vector<float> counts(uvWidth * uvHeight, 0.0f);
 
+        for(long y=0; y<height; ++y)
         {
-            const std::vector<uint16_t> resImg
-                = {     0,  5105,    58,     0,
-                        0,  5159,   260,     65535,
-                        0,  5553,   950,     0,
-                        0, 16270, 65535,     65535 };
+            for(long x=0; x<width; ++x)
+            {
+                float luma, cb, cr;
+                EncodeBT709(&rgba[4 * (y * width + x)], luma, cb, cr);
 
-            ComputeValues<OCIO::BIT_DEPTH_UINT16,
-                          OCIO::BIT_DEPTH_UINT16, __LINE__>(processor,
-                                                            &i_inImg[0], OCIO::CHANNEL_ORDERING_RGBA,
-                                                            &resImg[0],  OCIO::CHANNEL_ORDERING_RGBA,
-                                                            NB_PIXELS);
+                OCIO_CHECK_CLOSE(float(yRes[y * width + x]), luma * 219.0f + 16.0f, 0.51f);
+
+                const size_t uvIdx = (y / 2) * uvWidth + x / 2;
+                cbSums[uvIdx] += cb;
+                crSums[uvIdx] += cr;
+                counts[uvIdx] += 1.0f;
+            }
         }
 
+        for(size_t idx=0; idx<uRes.size(); ++idx)
         {
-            const std::vector<uint16_t> resImg
-                = {     0,  5105,     0,     0,
-                        0,  5159,   112,     65535,
-                        0,  5553,   388,     0,
-                    53461, 16270,  1982,     65535 };
-
-            ComputeValues<OCIO::BIT_DEPTH_UINT16,
-                          OCIO::BIT_DEPTH_UINT16, __LINE__>(processor,
-                                                            &i_inImg[0], OCIO::CHANNEL_ORDERING_BGRA,
-                                                            &resImg[0],  OCIO::CHANNEL_ORDERING_RGBA,
-                                                            NB_PIXELS);
+            OCIO_CHECK_CLOSE(float(uRes[idx]), cbSums[idx] / counts[idx] * 224.0f + 128.0f, 0.51f);
+            OCIO_CHECK_CLOSE(float(vRes[idx]), crSums[idx] / counts[idx] * 224.0f + 128.0f, 0.51f);
         }
+    }
 
+    // The P010 codes are in the high bits of the 16-bit words.
+    {
+        std::vector<uint16_t> yRes(width * height);
+        std::vector<uint16_t> uvRes(2 * uvWidth * uvHeight);
+        for(size_t idx=0; idx<yRes.size(); ++idx)
         {
-            const std::vector<uint16_t> resImg
-                = {    58,  5105,     0,     0,
-                      260,  5159,     0,     65535,
-                      950,  5553,     0,     0,
-                    65535, 16270,     0,     65535 };
-
-            ComputeValues<OCIO::BIT_DEPTH_UINT16,
-                          OCIO::BIT_DEPTH_UINT16, __LINE__>(processor,
-                                                            &i_inImg[0], OCIO::CHANNEL_ORDERING_RGBA,
-                                                            &resImg[0],  OCIO::CHANNEL_ORDERING_BGRA,
-                                                            NB_PIXELS);
+            yRes[idx] = uint16_t(yPlane[idx] << 8);
         }
-
+        for(size_t idx=0; idx<uvRes.size(); ++idx)
         {
-            const std::vector<uint16_t> resImg
-                = {     0,  5105,     0,     0,
-                      112,  5159,     0,     65535,
-                      388,  5553,     0,     0,
-                     1982, 16270, 53461,     65535 };
-
-            ComputeValues<OCIO::BIT_DEPTH_UINT16,
-                          OCIO::BIT_DEPTH_UINT16, __LINE__>(processor,
-                                                            &i_inImg[0], OCIO::CHANNEL_ORDERING_BGRA,
-                                                            &resImg[0],  OCIO::CHANNEL_ORDERING_BGRA,
-                                                            NB_PIXELS);
+            uvRes[idx] = uint16_t(uvPlane[idx] << 8);
         }
+        const std::vector<uint16_t> yRef(yRes);
+        const std::vector<uint16_t> uvRef(uvRes);
+
+        OCIO::YUVImageDesc imgDesc(&yRes[0], &uvRes[0], nullptr, width, height,
+                                   OCIO::YUV_LAYOUT_P010, OCIO::YUV_MATRIX_BT2020,
+                                   OCIO::YUV_RANGE_FULL);
+        OCIO_CHECK_EQUAL(imgDesc.getBitDepth(), OCIO::BIT_DEPTH_UINT16);
+        OCIO_CHECK_NO_THROW(cpuProcessor->apply(imgDesc));
+
+        OCIO_CHECK_ASSERT(yRes==yRef);
+        OCIO_CHECK_ASSERT(uvRes==uvRef);
     }
 
-    // Step 2: The 1D LUT is the first Op.
+    // Faulty cases.
+
+    OCIO_CHECK_THROW_WHAT(OCIO::YUVImageDesc(&yPlane[0], &uvPlane[0], &uvPlane[1], width, height,
+                                             OCIO::YUV_LAYOUT_NV12, OCIO::YUV_MATRIX_BT709,
+                                             OCIO::YUV_RANGE_LIMITED),
+                          OCIO::Exception, "Invalid image buffer");
+    OCIO_CHECK_THROW_WHAT(OCIO::YUVImageDesc(&yPlane[0], &uvPlane[0], nullptr, width, height,
+                                             OCIO::YUV_LAYOUT_NV12, OCIO::YUV_MATRIX_BT709,
+                                             OCIO::YUV_RANGE_LIMITED, width - 1, OCIO::AutoStride),
+                          OCIO::Exception, "Invalid luma stride");
+
+    OCIO::YUVImageDesc imgDesc(&yPlane[0], &uvPlane[0], nullptr, width, height,
+                               OCIO::YUV_LAYOUT_NV12, OCIO::YUV_MATRIX_BT709,
+                               OCIO::YUV_RANGE_LIMITED);
+
+    // The YUV side of the processing must be 32-bit float.
+    OCIO::ConstCPUProcessorRcPtr cpuProcessor8;
+    OCIO_CHECK_NO_THROW(cpuProcessor8
+        = processor->getOptimizedCPUProcessor(OCIO::BIT_DEPTH_UINT8, OCIO::BIT_DEPTH_UINT8,
+                                              OCIO::OPTIMIZATION_DEFAULT,
+                                              OCIO::FINALIZATION_DEFAULT));
+    OCIO_CHECK_THROW_WHAT(cpuProcessor8->apply(imgDesc), OCIO::Exception,
+                          "YUV image buffers need a 32-bit float processing bit-depth");
+
+    // The region of interest must start on a chroma sample.
+    imgDesc.setROI(1, 2, 4, 4);
+    OCIO_CHECK_THROW_WHAT(cpuProcessor->apply(imgDesc), OCIO::Exception,
+                          "must start on a chroma sample");
+    imgDesc.setROI(2, 2, 4, 4);
+    OCIO_CHECK_NO_THROW(cpuProcessor->apply(imgDesc));
+}
+
+namespace
+{
+
+// Compute the expected premultiplied (or straight) F32 pixel from a premultiplied
+// (or straight) one, using the straight F32 processing.
+void ComputePremultipliedPixel(const OCIO::ConstCPUProcessorRcPtr & f32Processor,
+                               float * rgba, bool srcPremultiplied, bool dstPremultiplied)
+{
+    const bool transparent = rgba[3]<=1e-6f;
 
+    if(srcPremultiplied && !transparent)
     {
-        const std::string strEnd =
-            "    from_reference: !<GroupTransform>\n"
-            "      children:\n"
-            "        - !<FileTransform>   { src: lut1d_5.spi1d, interpolation: linear }\n"
-            "        - !<MatrixTransform> { offset: [-0.19, 0.19, -0.00019, 0] }\n";
+        rgba[0] /= rgba[3];
+        rgba[1] /= rgba[3];
+        rgba[2] /= rgba[3];
+    }
 
-        const std::string str = SIMPLE_PROFILE + strEnd;
+    f32Processor->applyRGBA(rgba);
 
-        std::istringstream is;
-        is.str(str);
+    if(dstPremultiplied && !(srcPremultiplied && transparent))
+    {
+        rgba[0] *= rgba[3];
+        rgba[1] *= rgba[3];
+        rgba[2] *= rgba[3];
+    }
+}
 
-        OCIO::ConstConfigRcPtr config;
-        OCIO_CHECK_NO_THROW(config = OCIO::Config::CreateFromStream(is));
-        OCIO_CHECK_NO_THROW(config->sanityCheck());
+}
 
-        OCIO::ConstProcessorRcPtr processor;
-        OCIO_CHECK_NO_THROW(processor = config->getProcessor("cs1", "cs2"));
+OCIO_ADD_TEST(CPUProcessor, premultiplied_alpha)
+{
+    // The unit test validates that the premultiplied image buffers are unpremultiplied
+    // before, and premultiplied after, the color processing (including the transparent
+    // pixels) even when the bit-depth conversions are fused with the 1D LUTs.
+
+    OCIO::ConfigRcPtr config = OCIO::Config::Create();
+
+    OCIO::LUT1DTransformRcPtr firstLut = OCIO::LUT1DTransform::Create(32, false);
+    OCIO::LUT1DTransformRcPtr lastLut  = OCIO::LUT1DTransform::Create(32, false);
+    for(unsigned long idx=0; idx<32; ++idx)
+    {
+        const float val = float(idx) / 31.0f;
+        firstLut->setValue(idx, val * val, std::sqrt(val), val * 0.5f);
+        lastLut->setValue(idx, std::sqrt(val), val * 0.8f, val * val);
+    }
+
+    OCIO::MatrixTransformRcPtr matrix = OCIO::MatrixTransform::Create();
+    constexpr double m44[16] = { 0.8, 0.1, 0.1, 0.0,
+                                 0.2, 0.7, 0.1, 0.0,
+                                 0.1, 0.2, 0.7, 0.0,
+                                 0.0, 0.0, 0.0, 1.0 };
+    matrix->setMatrix(m44);
 
-        const unsigned NB_PIXELS = 4;
+    OCIO::GroupTransformRcPtr group = OCIO::GroupTransform::Create();
+    group->appendTransform(firstLut);
+    group->appendTransform(matrix);
+    group->appendTransform(lastLut);
 
-        const std::vector<float> f_inImg =
-            {  -1.0000f, -0.8000f, -0.1000f,  0.0f,
-                0.1002f,  0.2509f,  0.5009f,  1.0f,
-                0.5505f,  0.7090f,  0.9099f,  1.0f,
-                1.0000f,  1.2500f,  1.9900f,  0.0f  };
+    OCIO::ConstProcessorRcPtr processor;
+    OCIO_CHECK_NO_THROW(processor = config->getProcessor(group));
 
-        {
-            const std::vector<float> resImg
-                = { -0.18999999f,  0.18999999f, -0.00019000f,  0.0f,
-                    -0.15271049f,  0.29394856f,  0.24676571f,  1.0f,
-                     0.10089212f,  0.69935059f,  1.91072320f,  1.0f,
-                    63.81000137f, 64.19000244f, 63.99980927f,  0.0f };
+    OCIO::ConstCPUProcessorRcPtr f32Processor;
+    OCIO_CHECK_NO_THROW(f32Processor = processor->getDefaultCPUProcessor());
 
-            ComputeValues<OCIO::BIT_DEPTH_F32,
-                          OCIO::BIT_DEPTH_F32, __LINE__>(processor,
-                                                         &f_inImg[0], OCIO::CHANNEL_ORDERING_RGBA,
-                                                         &resImg[0],  OCIO::CHANNEL_ORDERING_RGBA,
-                                                         NB_PIXELS, 1e-7f);
-        }
+    constexpr long width  = 37;
+    constexpr long height = 5;
+    constexpr long numPixels = width * height;
 
-        {
-            const std::vector<uint16_t> resImg
-                = {     0, 12452,     0,     0,
-                        0, 19264, 16172, 65535,
-                     6612, 45832, 65535, 65535,
-                    65535, 65535, 65535,     0 };
+    // Premultiplied 8-bit pixels where some of them are transparent.
+    std::vector<uint8_t> img(numPixels * 4);
+    for(long idx=0; idx<numPixels; ++idx)
+    {
+        const uint8_t alpha = idx%7==0 ? 0 : uint8_t((idx * 37) % 256);
+        img[4 * idx + 0] = uint8_t((idx * 13) % (alpha + 1));
+        img[4 * idx + 1] = uint8_t((idx * 17) % (alpha + 1));
+        img[4 * idx + 2] = uint8_t((idx * 19) % (alpha + 1));
+        img[4 * idx + 3] = alpha;
+    }
+    // A transparent pixel could still hold some color values (e.g. an additive glow).
+    img[0] = 50;
 
-            ComputeValues<OCIO::BIT_DEPTH_F32,
-                          OCIO::BIT_DEPTH_UINT16, __LINE__>(processor,
-                                                            &f_inImg[0], OCIO::CHANNEL_ORDERING_RGBA,
-                                                            &resImg[0],  OCIO::CHANNEL_ORDERING_RGBA,
-                                                            NB_PIXELS);
-        }
+    // From an 8-bit image buffer where the input 1D LUT would process the integer values
+    // (i.e. the integer lookup is enabled by default).
 
-        const std::vector<uint16_t> i_inImg =
-            {    0,      8,    32,  0,
-                64,    128,   256,  0,
-               512,   1024,  2048,  0,
-              5120,  20480, 65535,  0  };
+    OCIO::ConstCPUProcessorRcPtr cpuProcessor;
+    OCIO_CHECK_NO_THROW(cpuProcessor
+        = processor->getOptimizedCPUProcessor(OCIO::BIT_DEPTH_UINT8, OCIO::BIT_DEPTH_F32,
+                                              OCIO::OPTIMIZATION_DEFAULT,
+                                              OCIO::FINALIZATION_DEFAULT));
+
+    for(bool srcPremultiplied : { false, true })
+    {
+        for(bool dstPremultiplied : { false, true })
         {
-            const std::vector<float> resImg
-                = { -0.18999999f, 0.19036166f,  0.00125666f,  0.0f,
-                    -0.18812581f, 0.19271758f,  0.00389672f,  0.0f,
-                    -0.18398958f, 0.19912247f,  0.01437576f,  0.0f,
-                    -0.15969887f, 0.32105737f, 63.99980927f,  0.0f };
+            OCIO::PackedImageDesc srcDesc(&img[0], width, height, 4, OCIO::BIT_DEPTH_UINT8,
+                                          sizeof(uint8_t), OCIO::AutoStride,
+                                          OCIO::AutoStride);
+            srcDesc.setPremultiplied(srcPremultiplied);
 
-            ComputeValues<OCIO::BIT_DEPTH_UINT16,
-                          OCIO::BIT_DEPTH_F32, __LINE__>(processor,
-                                                         &i_inImg[0], OCIO::CHANNEL_ORDERING_RGBA,
-                                                         &resImg[0],  OCIO::CHANNEL_ORDERING_RGBA,
-                                                         NB_PIXELS, 1e-7f);
-        }
+            std::vector<float> res(numPixels * 4, -1.0f);
+            OCIO::PackedImageDesc dstDesc(&res[0], width, height, 4);
+            dstDesc.setPremultiplied(dstPremultiplied);
 
-        {
-            const std::vector<uint16_t> resImg
-                = {     0, 12475,     0,     0,
-                      110, 12630,     0,     0,
-                      381, 13049,     0,     0,
-                     1973, 21040, 65535,     0 };
+            OCIO_CHECK_NO_THROW(cpuProcessor->apply(srcDesc, dstDesc));
 
-            ComputeValues<OCIO::BIT_DEPTH_UINT16,
-                          OCIO::BIT_DEPTH_UINT16, __LINE__>(processor,
-                                                            &i_inImg[0], OCIO::CHANNEL_ORDERING_BGRA,
-                                                            &resImg[0],  OCIO::CHANNEL_ORDERING_BGRA,
-                                                            NB_PIXELS);
+            for(long idx=0; idx<numPixels; ++idx)
+            {
+                float rgba[4] = { img[4 * idx + 0] / 255.0f, img[4 * idx + 1] / 255.0f,
+                                  img[4 * idx + 2] / 255.0f, img[4 * idx + 3] / 255.0f };
+                ComputePremultipliedPixel(f32Processor, rgba, srcPremultiplied,
+                                          dstPremultiplied);
+
+                for(long chan=0; chan<4; ++chan)
+                {
+                    OCIO_CHECK_CLOSE(res[4 * idx + chan], rgba[chan], 1e-5f);
+                }
+            }
         }
     }
 
-    // Step 3: The 1D LUT is the first and the last Op.
-
+    // The transparent pixel keeps its color values, and the straight processing is
+    // unchanged.
     {
+        OCIO::PackedImageDesc srcDesc(&img[0], width, height, 4, OCIO::BIT_DEPTH_UINT8,
+                                      sizeof(uint8_t), OCIO::AutoStride, OCIO::AutoStride);
+        std::vector<float> res(numPixels * 4);
+        OCIO::PackedImageDesc dstDesc(&res[0], width, height, 4);
 
-        const std::string strEnd =
-            "    from_reference: !<GroupTransform>\n"
-            "      children:\n"
-            "        - !<FileTransform>   { src: lut1d_5.spi1d, interpolation: linear }\n"
-            "        - !<MatrixTransform> { offset: [-0.19, 0.19, -0.00019, 0] }\n"
-            "        - !<FileTransform>   { src: lut1d_4.spi1d, interpolation: linear }\n";
+        OCIO_CHECK_NO_THROW(cpuProcessor->apply(srcDesc, dstDesc));
+        const float straightRed = res[0];
 
-        const std::string str = SIMPLE_PROFILE + strEnd;
+        srcDesc.setPremultiplied(true);
+        dstDesc.setPremultiplied(true);
+        OCIO_CHECK_ASSERT(srcDesc.isPremultiplied());
 
-        std::istringstream is;
-        is.str(str);
+        OCIO_CHECK_NO_THROW(cpuProcessor->apply(srcDesc, dstDesc));
+        OCIO_CHECK_CLOSE(res[0], straightRed, 1e-5f);
+        OCIO_CHECK_EQUAL(res[3], 0.0f);
+    }
 
-        OCIO::ConstConfigRcPtr config;
-        OCIO_CHECK_NO_THROW(config = OCIO::Config::CreateFromStream(is));
-        OCIO_CHECK_NO_THROW(config->sanityCheck());
+    // In place on 32-bit float planar image buffers, for the regular and the render-only
+    // processors (i.e. without the planar processing).
 
-        OCIO::ConstProcessorRcPtr processor;
-        OCIO_CHECK_NO_THROW(processor = config->getProcessor("cs1", "cs2"));
+    OCIO::ConstCPUProcessorRcPtr renderOnly;
+    OCIO_CHECK_NO_THROW(renderOnly
+        = processor->getRenderOnlyCPUProcessor(OCIO::BIT_DEPTH_F32, OCIO::BIT_DEPTH_F32,
+                                               OCIO::OPTIMIZATION_DEFAULT,
+                                               OCIO::FINALIZATION_DEFAULT));
 
-        const unsigned NB_PIXELS = 4;
+    for(const auto & proc : { f32Processor, renderOnly })
+    {
+        std::vector<float> r(numPixels), g(numPixels), b(numPixels), a(numPixels);
+        for(long idx=0; idx<numPixels; ++idx)
+        {
+            r[idx] = img[4 * idx + 0] / 255.0f;
+            g[idx] = img[4 * idx + 1] / 255.0f;
+            b[idx] = img[4 * idx + 2] / 255.0f;
+            a[idx] = img[4 * idx + 3] / 255.0f;
+        }
 
-        const std::vector<float> f_inImg =
-            {  -1.0000f, -0.8000f, -0.1000f,  0.0f,
-                0.1002f,  0.2509f,  0.5009f,  1.0f,
-                0.5505f,  0.7090f,  0.9099f,  1.0f,
-                1.0000f,  1.2500f,  1.9900f,  0.0f  };
+        OCIO::PlanarImageDesc desc(&r[0], &g[0], &b[0], &a[0], width, height);
+        desc.setPremultiplied(true);
 
+        OCIO_CHECK_NO_THROW(proc->apply(desc));
+
+        for(long idx=0; idx<numPixels; ++idx)
         {
-            const std::vector<float> resImg
-                = { -0.79690927f, -0.06224250f, -0.42994320f,  0.0f,
-                    -0.72481626f,  0.13872468f,  0.04750441f,  1.0f,
-                    -0.23451784f,  0.92250210f,  3.26448941f,  1.0f,
-                     3.43709063f,  3.43709063f,  3.43709063f,  0.0f };
+            float rgba[4] = { img[4 * idx + 0] / 255.0f, img[4 * idx + 1] / 255.0f,
+                              img[4 * idx + 2] / 255.0f, img[4 * idx + 3] / 255.0f };
+            ComputePremultipliedPixel(f32Processor, rgba, true, true);
+
+            OCIO_CHECK_CLOSE(r[idx], rgba[0], 1e-5f);
+            OCIO_CHECK_CLOSE(g[idx], rgba[1], 1e-5f);
+            OCIO_CHECK_CLOSE(b[idx], rgba[2], 1e-5f);
+            OCIO_CHECK_EQUAL(a[idx], rgba[3]);
+        }
+    }
 
-            ComputeValues<OCIO::BIT_DEPTH_F32,
-                          OCIO::BIT_DEPTH_F32, __LINE__>(processor,
-                                                         &f_inImg[0], OCIO::CHANNEL_ORDERING_RGBA,
-                                                         &resImg[0],  OCIO::CHANNEL_ORDERING_RGBA,
-                                                         NB_PIXELS, 1e-7f);
+    // Without alpha, the color values are straight.
+    {
+        std::vector<float> rgb(numPixels * 3);
+        for(long idx=0; idx<numPixels; ++idx)
+        {
+            rgb[3 * idx + 0] = img[4 * idx + 0] / 255.0f;
+            rgb[3 * idx + 1] = img[4 * idx + 1] / 255.0f;
+            rgb[3 * idx + 2] = img[4 * idx + 2] / 255.0f;
         }
+        std::vector<float> ref(rgb);
 
-        const std::vector<uint16_t> i_inImg =
-            {    0,      8,    32,  0,
-                64,    128,   256,  0,
-               512,   1024,  2048,  0,
-              5120,  20480, 65535,  0  };
+        OCIO::PackedImageDesc refDesc(&ref[0], width, height, 3);
+        OCIO_CHECK_NO_THROW(f32Processor->apply(refDesc));
 
-        {
-            const std::vector<uint16_t> resImg
-                = {     0,     0,     0,     0,
-                        0,     0,     0,     0,
-                        0,     0,     0,     0,
-                        0, 12526, 65535,     0 };
+        OCIO::PackedImageDesc desc(&rgb[0], width, height, 3);
+        desc.setPremultiplied(true);
+        OCIO_CHECK_NO_THROW(f32Processor->apply(desc));
 
-            ComputeValues<OCIO::BIT_DEPTH_UINT16,
-                          OCIO::BIT_DEPTH_UINT16, __LINE__>(processor,
-                                                            &i_inImg[0], OCIO::CHANNEL_ORDERING_BGRA,
-                                                            &resImg[0],  OCIO::CHANNEL_ORDERING_BGRA,
-                                                            NB_PIXELS);
+        for(size_t idx=0; idx<rgb.size(); ++idx)
+        {
+            OCIO_CHECK_CLOSE(rgb[idx], ref[idx], 1e-6f);
         }
     }
 }
 
-OCIO_ADD_TEST(CPUProcessor, image_desc)
+OCIO_ADD_TEST(CPUProcessor, ordered_dithering)
 {
-    // The tests validate the image description types when using the same buffer image.
-
-    const std::string SIMPLE_PROFILE =
-        "ocio_profile_version: 2\n"
-        "\n"
-        "search_path: " + std::string(OCIO::getTestFilesDir()) + "\n"
-        "strictparsing: true\n"
-        "luma: [0.2126, 0.7152, 0.0722]\n"
-        "\n"
-        "roles:\n"
-        "  default: cs1\n"
-        "  scene_linear: cs2\n"
-        "\n"
-        "displays:\n"
-        "  sRGB:\n"
-        "    - !<View> {name: Raw, colorspace: cs1}\n"
-        "\n"
-        "colorspaces:\n"
-        "  - !<ColorSpace>\n"
-        "    name: cs1\n"
-        "    allocation: uniform\n"
-        "\n"
-        "  - !<ColorSpace>\n"
-        "    name: cs2\n"
-        "    allocation: uniform\n";
-
-    const std::string strEnd =
-        "    from_reference: !<GroupTransform>\n"
-        "      children:\n"
-        "        - !<MatrixTransform> { offset: [-0.19, 0.19, -0.00019, 0.5] }\n"
-        "        - !<FileTransform>   { src: lut1d_5.spi1d, interpolation: linear }\n";
+    // The unit test validates that the dithered integer output values average to the
+    // processed values, and that the pattern is aligned on the image buffer.
 
-    const std::string str = SIMPLE_PROFILE + strEnd;
-
-    std::istringstream is;
-    is.str(str);
+    OCIO::ConfigRcPtr config = OCIO::Config::Create();
 
-    OCIO::ConstConfigRcPtr config;
-    OCIO_CHECK_NO_THROW(config = OCIO::Config::CreateFromStream(is));
-    OCIO_CHECK_NO_THROW(config->sanityCheck());
+    // A 1D LUT would otherwise directly produce the 8-bit output values.
+    OCIO::LUT1DTransformRcPtr lut = OCIO::LUT1DTransform::Create(32, false);
+    for(unsigned long idx=0; idx<32; ++idx)
+    {
+        const float val = float(idx) / 31.0f;
+        lut->setValue(idx, val * 0.5f, val * 0.5f, val * 0.5f);
+    }
 
     OCIO::ConstProcessorRcPtr processor;
-    OCIO_CHECK_NO_THROW(processor = config->getProcessor("cs1", "cs2"));
-
-    const std::vector<float> f_rInImg =
-        {  -1.0000f,
-            0.1002f,
-            0.5505f,
-            1.0000f,  };
+    OCIO_CHECK_NO_THROW(processor = config->getProcessor(lut));
 
-    const std::vector<float> f_gInImg =
-        {            -0.8000f,
-                      0.2509f,
-                      0.7090f,
-                      1.2500f  };
+    OCIO::ConstCPUProcessorRcPtr cpuProcessor;
+    OCIO_CHECK_NO_THROW(cpuProcessor
+        = processor->getOptimizedCPUProcessor(OCIO::BIT_DEPTH_F32, OCIO::BIT_DEPTH_UINT8,
+                                              OCIO::OPTIMIZATION_DEFAULT,
+                                              OCIO::FINALIZATION_DEFAULT));
 
-    const std::vector<float> f_bInImg =
-        {                       -0.1000f,
-                                 0.5009f,
-                                 0.9099f,
-                                 1.9900f  };
+    constexpr long width  = 64;
+    constexpr long height = 16;
+    constexpr long numPixels = width * height;
 
-    const std::vector<float> f_aInImg =
-        {                                   0.0f,
-                                            1.0f,
-                                            0.5f,
-                                            0.0f  };
+    // The processed value is 100.3 in 8-bit.
+    const float inValue = 2.0f * 100.3f / 255.0f;
+    const std::vector<float> img(numPixels * 4, inValue);
 
-    const std::vector<float> f_rOutImg
-        = {  0.0f,
-             0.0f,
-             0.15488569f,
-             0.81575858f };
+    const OCIO::PackedImageDesc srcDesc(const_cast<float *>(&img[0]), width, height, 4);
 
-    const std::vector<float> f_gOutImg
-        = {                0.0f,
-                           0.20273837f,
-                           1.69210147f,
-                          64.0f };
+    std::vector<uint8_t> rounded(numPixels * 4);
+    OCIO::PackedImageDesc roundedDesc(&rounded[0], width, height, 4, OCIO::BIT_DEPTH_UINT8,
+                                      sizeof(uint8_t), OCIO::AutoStride, OCIO::AutoStride);
+    OCIO_CHECK_EQUAL(roundedDesc.getDither(), OCIO::DITHER_NONE);
+    OCIO_CHECK_NO_THROW(cpuProcessor->apply(srcDesc, roundedDesc));
 
-    const std::vector<float> f_bOutImg
-        = {                              0.0f,
-                                         0.24680146f,
-                                         1.90666747f,
-                                        64.0f };
+    std::vector<uint8_t> dithered(numPixels * 4);
+    OCIO::PackedImageDesc ditheredDesc(&dithered[0], width, height, 4, OCIO::BIT_DEPTH_UINT8,
+                                       sizeof(uint8_t), OCIO::AutoStride, OCIO::AutoStride);
+    ditheredDesc.setDither(OCIO::DITHER_ORDERED);
+    OCIO_CHECK_NO_THROW(cpuProcessor->apply(srcDesc, ditheredDesc));
 
-    const std::vector<float> f_aOutImg
-        = {                                            0.5f,
-                                                       1.5f,
-                                                       1.0f,
-                                                       0.5f };
+    // Each 8x8 tile has 19 pixels (i.e. 0.3 of 64) rounded up.
+    for(long tileY=0; tileY<height; tileY+=8)
+    {
+        for(long tileX=0; tileX<width; tileX+=8)
+        {
+            long numRoundedUp = 0;
+            for(long y=tileY; y<tileY+8; ++y)
+            {
+                for(long x=tileX; x<tileX+8; ++x)
+                {
+                    const long pxl = y * width + x;
+                    OCIO_CHECK_EQUAL(rounded[4 * pxl + 0], 100);
+
+                    OCIO_CHECK_ASSERT(dithered[4 * pxl + 0]==100 || dithered[4 * pxl + 0]==101);
+                    OCIO_CHECK_EQUAL(dithered[4 * pxl + 1], dithered[4 * pxl + 0]);
+                    OCIO_CHECK_EQUAL(dithered[4 * pxl + 2], dithered[4 * pxl + 0]);
+                    // The alpha is not dithered.
+                    OCIO_CHECK_EQUAL(dithered[4 * pxl + 3], rounded[4 * pxl + 3]);
+
+                    numRoundedUp += dithered[4 * pxl + 0]==101 ? 1 : 0;
+                }
+            }
+            OCIO_CHECK_EQUAL(numRoundedUp, 19);
+        }
+    }
 
+    // The region of interest keeps the pattern of the complete image buffer.
     {
-        // Packed Image Description with RGBA image.
+        constexpr long roiX = 3;
+        constexpr long roiY = 5;
 
-        std::vector<float> img =
-            {  f_rInImg[0], f_gInImg[0], f_bInImg[0], f_aInImg[0],
-               f_rInImg[1], f_gInImg[1], f_bInImg[1], f_aInImg[1],
-               f_rInImg[2], f_gInImg[2], f_bInImg[2], f_aInImg[2],
-               f_rInImg[3], f_gInImg[3], f_bInImg[3], f_aInImg[3] };
+        std::vector<float> roiImg(img);
+        std::vector<uint8_t> res(numPixels * 4, 0);
 
-        const std::vector<float> res
-            {  f_rOutImg[0], f_gOutImg[0], f_bOutImg[0], f_aOutImg[0],
-               f_rOutImg[1], f_gOutImg[1], f_bOutImg[1], f_aOutImg[1],
-               f_rOutImg[2], f_gOutImg[2], f_bOutImg[2], f_aOutImg[2],
-               f_rOutImg[3], f_gOutImg[3], f_bOutImg[3], f_aOutImg[3] };
+        OCIO::PackedImageDesc roiSrcDesc(&roiImg[0], width, height, 4);
+        roiSrcDesc.setROI(roiX, roiY, 13, 7);
 
-        OCIO::ConstCPUProcessorRcPtr cpu;
-        OCIO_CHECK_NO_THROW(cpu = processor->getDefaultCPUProcessor());
+        OCIO::PackedImageDesc roiDstDesc(&res[0], width, height, 4, OCIO::BIT_DEPTH_UINT8,
+                                         sizeof(uint8_t), OCIO::AutoStride,
+                                         OCIO::AutoStride);
+        roiDstDesc.setROI(roiX, roiY, 13, 7);
+        roiDstDesc.setDither(OCIO::DITHER_ORDERED);
 
-        OCIO::PackedImageDesc desc(&img[0], 2, 2, 4);
-        OCIO_CHECK_NO_THROW(cpu->apply(desc));
+        OCIO_CHECK_NO_THROW(cpuProcessor->apply(roiSrcDesc, roiDstDesc));
 
-        for(size_t idx=0; idx<img.size(); ++idx)
+        for(long y=roiY; y<roiY+7; ++y)
         {
-            OCIO_CHECK_CLOSE(img[idx], res[idx], 1e-7f);
+            for(long x=roiX; x<roiX+13; ++x)
+            {
+                const long pxl = y * width + x;
+                OCIO_CHECK_EQUAL(res[4 * pxl + 0], dithered[4 * pxl + 0]);
+            }
         }
     }
 
+    // The 32-bit float output values are not dithered.
     {
-        // Packed Image Description with RGB image.
+        OCIO::ConstCPUProcessorRcPtr f32Processor;
+        OCIO_CHECK_NO_THROW(f32Processor = processor->getDefaultCPUProcessor());
 
-        std::vector<float> img =
-            {  f_rInImg[0], f_gInImg[0], f_bInImg[0],
-               f_rInImg[1], f_gInImg[1], f_bInImg[1],
-               f_rInImg[2], f_gInImg[2], f_bInImg[2],
-               f_rInImg[3], f_gInImg[3], f_bInImg[3] };
+        std::vector<float> ref(img), res(img);
+        OCIO::PackedImageDesc refDesc(&ref[0], width, height, 4);
+        OCIO::PackedImageDesc resDesc(&res[0], width, height, 4);
+        resDesc.setDither(OCIO::DITHER_ORDERED);
 
-        const std::vector<float> res
-            {  f_rOutImg[0], f_gOutImg[0], f_bOutImg[0],
-               f_rOutImg[1], f_gOutImg[1], f_bOutImg[1],
-               f_rOutImg[2], f_gOutImg[2], f_bOutImg[2],
-               f_rOutImg[3], f_gOutImg[3], f_bOutImg[3] };
+        OCIO_CHECK_NO_THROW(f32Processor->apply(refDesc));
+        OCIO_CHECK_NO_THROW(f32Processor->apply(resDesc));
+        OCIO_CHECK_ASSERT(ref==res);
+    }
+}
 
-        OCIO::ConstCPUProcessorRcPtr cpu;
-        OCIO_CHECK_NO_THROW(cpu = processor->getDefaultCPUProcessor());
+OCIO_ADD_TEST(CPUProcessor, repeated_pixels)
+{
+    // The unit test validates that evaluating once each run of identical pixels does
+    // not change the results, and counts the evaluated pixels.
+
+    OCIO::ConfigRcPtr config = OCIO::Config::Create();
 
-        OCIO::PackedImageDesc desc(&img[0], 4, 1, 3);
-        OCIO_CHECK_NO_THROW(cpu->apply(desc));
+    OCIO::LUT3DTransformRcPtr lut = OCIO::LUT3DTransform::Create(17);
+    lut->setValue(0, 0, 0, 0.1f, 0.0f, 0.0f);
+    lut->setValue(8, 3, 5, 0.2f, 0.3f, 0.4f);
 
-        for(size_t idx=0; idx<img.size(); ++idx)
-        {
-            OCIO_CHECK_CLOSE(img[idx], res[idx], 1e-7f);
-        }
-    }
+    OCIO::ConstProcessorRcPtr processor;
+    OCIO_CHECK_NO_THROW(processor = config->getProcessor(lut));
 
-    {
-        // Planar Image Description with R/G/B/A.
+    const OCIO::OptimizationFlags repeated
+        = OCIO::OptimizationFlags(OCIO::OPTIMIZATION_DEFAULT
+                                  | OCIO::OPTIMIZATION_REPEATED_PIXELS);
 
-        std::vector<float> imgRed   = f_rInImg;
-        std::vector<float> imgGreen = f_gInImg;
-        std::vector<float> imgBlue  = f_bInImg;
-        std::vector<float> imgAlpha = f_aInImg;
+    OCIO::ConstCPUProcessorRcPtr cpuProcessor;
+    OCIO_CHECK_NO_THROW(cpuProcessor
+        = processor->getOptimizedCPUProcessor(OCIO::BIT_DEPTH_F32, OCIO::BIT_DEPTH_F32,
+                                              repeated, OCIO::FINALIZATION_DEFAULT));
 
-        OCIO::ConstCPUProcessorRcPtr cpu;
-        OCIO_CHECK_NO_THROW(cpu = processor->getDefaultCPUProcessor());
+    OCIO::ConstCPUProcessorRcPtr defaultProcessor;
+    OCIO_CHECK_NO_THROW(defaultProcessor = processor->getDefaultCPUProcessor());
 
-        OCIO::PlanarImageDesc desc(&imgRed[0], &imgGreen[0], &imgBlue[0], &imgAlpha[0], 2, 2);
-        OCIO_CHECK_NO_THROW(cpu->apply(desc));
+    // The lines are narrower than a block so each run is evaluated once.
+    constexpr long width  = 100;
+    constexpr long height = 9;
+    constexpr long numPixels = width * height;
 
-        for(size_t idx=0; idx<imgRed.size(); ++idx)
+    std::vector<float> img(numPixels * 4);
+    long numRuns = 0;
+    for(long y=0; y<height; ++y)
+    {
+        for(long x=0; x<width; ++x)
         {
-            OCIO_CHECK_CLOSE(imgRed[idx],   f_rOutImg[idx], 1e-7f);
-            OCIO_CHECK_CLOSE(imgGreen[idx], f_gOutImg[idx], 1e-7f);
-            OCIO_CHECK_CLOSE(imgBlue[idx],  f_bOutImg[idx], 1e-7f);
-            OCIO_CHECK_CLOSE(imgAlpha[idx], f_aOutImg[idx], 1e-7f);
+            // Runs of 1 to 7 pixels, the last line having no run at all.
+            const long run = y==height-1 ? x : x / (1 + y % 7);
+            numRuns += (x==0 || run!=(y==height-1 ? x-1 : (x-1) / (1 + y % 7))) ? 1 : 0;
+
+            float * pixel = &img[4 * (y * width + x)];
+            pixel[0] = float(run % 11) / 10.0f;
+            pixel[1] = float(run % 5) / 4.0f;
+            pixel[2] = float(y) / height;
+            pixel[3] = 0.5f;
         }
     }
+    // The values only differing by the sign of zero are not identical (i.e. the second
+    // line has runs of two pixels, and its first pixel is zero).
+    img[4 * (width + 1) + 0] = -0.0f;
+
+    long long numProcessed = -1, numEvaluated = -1;
+    cpuProcessor->getRepeatedPixelsStats(numProcessed, numEvaluated);
+    OCIO_CHECK_EQUAL(numProcessed, 0);
+    OCIO_CHECK_EQUAL(numEvaluated, 0);
+
+    std::vector<float> ref(img);
+    OCIO::PackedImageDesc refDesc(&ref[0], width, height, 4);
+    OCIO_CHECK_NO_THROW(defaultProcessor->apply(refDesc));
 
+    // Packed image buffer.
     {
-        // Planar Image Description with R/G/B.
+        std::vector<float> res(img);
+        OCIO::PackedImageDesc desc(&res[0], width, height, 4);
+        OCIO_CHECK_NO_THROW(cpuProcessor->apply(desc));
+        OCIO_CHECK_ASSERT(res==ref);
+
+        cpuProcessor->getRepeatedPixelsStats(numProcessed, numEvaluated);
+        OCIO_CHECK_EQUAL(numProcessed, numPixels);
+        OCIO_CHECK_EQUAL(numEvaluated, numRuns + 1);
+    }
 
-        std::vector<float> imgRed   = f_rInImg;
-        std::vector<float> imgGreen = f_gInImg;
-        std::vector<float> imgBlue  = f_bInImg;
+    cpuProcessor->resetRepeatedPixelsStats();
 
-        OCIO::ConstCPUProcessorRcPtr cpu;
-        OCIO_CHECK_NO_THROW(cpu = processor->getDefaultCPUProcessor());
+    // Planar image buffers (i.e. not directly processed on the planes).
+    {
+        std::vector<float> r(numPixels), g(numPixels), b(numPixels), a(numPixels);
+        for(long idx=0; idx<numPixels; ++idx)
+        {
+            r[idx] = img[4 * idx + 0];
+            g[idx] = img[4 * idx + 1];
+            b[idx] = img[4 * idx + 2];
+            a[idx] = img[4 * idx + 3];
+        }
 
-        OCIO::PlanarImageDesc desc(&imgRed[0], &imgGreen[0], &imgBlue[0], nullptr, 1, 4);
-        OCIO_CHECK_NO_THROW(cpu->apply(desc));
+        OCIO::PlanarImageDesc desc(&r[0], &g[0], &b[0], &a[0], width, height);
+        OCIO_CHECK_NO_THROW(cpuProcessor->apply(desc));
 
-        for(size_t idx=0; idx<imgRed.size(); ++idx)
+        for(long idx=0; idx<numPixels; ++idx)
         {
-            OCIO_CHECK_CLOSE(imgRed[idx],   f_rOutImg[idx], 1e-7f);
-            OCIO_CHECK_CLOSE(imgGreen[idx], f_gOutImg[idx], 1e-7f);
-            OCIO_CHECK_CLOSE(imgBlue[idx],  f_bOutImg[idx], 1e-7f);
+            OCIO_CHECK_EQUAL(r[idx], ref[4 * idx + 0]);
+            OCIO_CHECK_EQUAL(g[idx], ref[4 * idx + 1]);
+            OCIO_CHECK_EQUAL(b[idx], ref[4 * idx + 2]);
+            OCIO_CHECK_EQUAL(a[idx], ref[4 * idx + 3]);
         }
+
+        cpuProcessor->getRepeatedPixelsStats(numProcessed, numEvaluated);
+        OCIO_CHECK_EQUAL(numProcessed, numPixels);
+        OCIO_CHECK_EQUAL(numEvaluated, numRuns + 1);
     }
+
+    // The default processor does not count anything.
+    defaultProcessor->getRepeatedPixelsStats(numProcessed, numEvaluated);
+    OCIO_CHECK_EQUAL(numProcessed, 0);
+    OCIO_CHECK_EQUAL(numEvaluated, 0);
 }
 
-namespace
+OCIO_ADD_TEST(CPUProcessor, processor_group)
 {
+    // The unit test validates that a processor group produces the same results as its
+    // processors, the ops shared by the start of the processors being only applied once.
 
-constexpr unsigned NB_PIXELS = 6;
-
-std::vector<float> inImgR =
-    {  -1.000012f,
-       -0.500012f,
-        0.100012f,
-        0.600012f,
-        1.102312f,
-        1.700012f  };
-
-std::vector<float> inImgG =
-    {              -0.800012f,
-                   -0.300012f,
-                    0.250012f,
-                    0.800012f,
-                    1.204512f,
-                    1.800012f };
-
-std::vector<float> inImgB =
-    {                          -0.600012f,
-                               -0.100012f,
-                                0.450012f,
-                                0.900012f,
-                                1.508912f,
-                                1.990012f };
+    OCIO::ConfigRcPtr config = OCIO::Config::Create();
 
-std::vector<float> inImgA =
-    {                                       0.005005f,
-                                            0.405005f,
-                                            0.905005f,
-                                            0.005005f,
-                                            1.005005f,
-                                            0.095005f  };
+    OCIO::MatrixTransformRcPtr matrix = OCIO::MatrixTransform::Create();
+    const double offset[4] = { 0.1, 0.05, 0.0, 0.0 };
+    matrix->setOffset(offset);
+
+    OCIO::LUT3DTransformRcPtr lut = OCIO::LUT3DTransform::Create(17);
+    lut->setValue(8, 3, 5, 0.2f, 0.3f, 0.4f);
+
+    OCIO::ExponentTransformRcPtr exponent = OCIO::ExponentTransform::Create();
+    const double gamma[4] = { 2.2, 2.2, 2.2, 1.0 };
+    exponent->setValue(gamma);
+
+    OCIO::LogTransformRcPtr log = OCIO::LogTransform::Create();
+
+    OCIO::GroupTransformRcPtr group1 = OCIO::GroupTransform::Create();
+    group1->appendTransform(matrix);
+    group1->appendTransform(lut);
+    group1->appendTransform(exponent);
+
+    OCIO::GroupTransformRcPtr group2 = OCIO::GroupTransform::Create();
+    group2->appendTransform(matrix);
+    group2->appendTransform(lut);
+    group2->appendTransform(log);
+
+    OCIO::ConstProcessorRcPtr processors[2];
+    OCIO_CHECK_NO_THROW(processors[0] = config->getProcessor(group1));
+    OCIO_CHECK_NO_THROW(processors[1] = config->getProcessor(group2));
+
+    const OCIO::BitDepth outBitDepths[2] = { OCIO::BIT_DEPTH_UINT8, OCIO::BIT_DEPTH_F32 };
+
+    OCIO::ConstCPUProcessorGroupRcPtr group;
+    OCIO_CHECK_NO_THROW(group = OCIO::CPUProcessorGroup::Create(processors, 2,
+                                                                OCIO::BIT_DEPTH_UINT16,
+                                                                outBitDepths,
+                                                                OCIO::OPTIMIZATION_DEFAULT,
+                                                                OCIO::FINALIZATION_DEFAULT));
+    OCIO_CHECK_EQUAL(group->getNumProcessors(), 2);
+    OCIO_CHECK_EQUAL(group->getNumSharedOps(), 2);
+    OCIO_CHECK_EQUAL(group->getInputBitDepth(), OCIO::BIT_DEPTH_UINT16);
+    OCIO_CHECK_EQUAL(group->getOutputBitDepth(0), OCIO::BIT_DEPTH_UINT8);
+    OCIO_CHECK_EQUAL(group->getOutputBitDepth(1), OCIO::BIT_DEPTH_F32);
+    OCIO_CHECK_THROW_WHAT(group->getOutputBitDepth(2), OCIO::Exception,
+                          "Invalid processor index");
+
+    constexpr long width  = 67;
+    constexpr long height = 5;
+    constexpr long numPixels = width * height;
+
+    std::vector<uint16_t> src(numPixels * 4);
+    for(size_t idx=0; idx<src.size(); ++idx)
+    {
+        src[idx] = uint16_t((idx * 2477) % 65536);
+    }
+    const OCIO::PackedImageDesc srcDesc(&src[0], width, height, 4,
+                                        OCIO::BIT_DEPTH_UINT16,
+                                        sizeof(uint16_t), OCIO::AutoStride, OCIO::AutoStride);
+
+    std::vector<uint8_t> res1(numPixels * 4);
+    std::vector<float> res2(numPixels * 4);
+    OCIO::PackedImageDesc resDesc1(&res1[0], width, height, 4,
+                                   OCIO::BIT_DEPTH_UINT8,
+                                   sizeof(uint8_t), OCIO::AutoStride, OCIO::AutoStride);
+    OCIO::PackedImageDesc resDesc2(&res2[0], width, height, 4);
+
+    OCIO::ImageDesc * dstDescs[2] = { &resDesc1, &resDesc2 };
+    OCIO_CHECK_NO_THROW(group->apply(srcDesc, dstDescs));
+
+    // The individual processors.
+
+    std::vector<uint8_t> ref1(numPixels * 4);
+    std::vector<float> ref2(numPixels * 4);
+    OCIO::PackedImageDesc refDesc1(&ref1[0], width, height, 4,
+                                   OCIO::BIT_DEPTH_UINT8,
+                                   sizeof(uint8_t), OCIO::AutoStride, OCIO::AutoStride);
+    OCIO::PackedImageDesc refDesc2(&ref2[0], width, height, 4);
+
+    OCIO::ConstCPUProcessorRcPtr cpu1, cpu2;
+    OCIO_CHECK_NO_THROW(cpu1 = processors[0]->getOptimizedCPUProcessor(OCIO::BIT_DEPTH_UINT16,
+                                                                       OCIO::BIT_DEPTH_UINT8,
+                                                                       OCIO::OPTIMIZATION_DEFAULT,
+                                                                       OCIO::FINALIZATION_DEFAULT));
+    OCIO_CHECK_NO_THROW(cpu2 = processors[1]->getOptimizedCPUProcessor(OCIO::BIT_DEPTH_UINT16,
+                                                                       OCIO::BIT_DEPTH_F32,
+                                                                       OCIO::OPTIMIZATION_DEFAULT,
+                                                                       OCIO::FINALIZATION_DEFAULT));
+    OCIO_CHECK_NO_THROW(cpu1->apply(srcDesc, refDesc1));
+    OCIO_CHECK_NO_THROW(cpu2->apply(srcDesc, refDesc2));
+
+    // The ops are differently optimized (e.g. the shared ops could not be combined with the
+    // others) so the integer results could differ by one code value.
+    for(long idx=0; idx<numPixels * 4; ++idx)
+    {
+        OCIO_CHECK_ASSERT(std::abs(int(res1[idx]) - int(ref1[idx])) <= 1);
+        OCIO_CHECK_CLOSE(res2[idx], ref2[idx], 1e-4f);
+    }
 
-std::vector<float> inImg =
-    { inImgR[0], inImgG[0], inImgB[0], inImgA[0],
-      inImgR[1], inImgG[1], inImgB[1], inImgA[1],
-      inImgR[2], inImgG[2], inImgB[2], inImgA[2],
-      inImgR[3], inImgG[3], inImgB[3], inImgA[3],
-      inImgR[4], inImgG[4], inImgB[4], inImgA[4],
-      inImgR[5], inImgG[5], inImgB[5], inImgA[5] };
+    // Same results with several threads.
+    {
+        std::vector<float> res(numPixels * 4);
+        OCIO::PackedImageDesc resDesc(&res[0], width, height, 4);
+        dstDescs[1] = &resDesc;
 
-const std::vector<float> resImgR =
-    {  0.4001879692f,
-       0.9001880288f,
-       1.500211954f,
-       2.000211954f,
-       2.502511978f,
-       3.100212097f };
+        OCIO_CHECK_NO_THROW(group->apply(srcDesc, dstDescs, OCIO::CPUExecutor()));
+        OCIO_CHECK_ASSERT(res==res2);
 
-const std::vector<float> resImgG =
-    {                 -0.3995119929f,
-                       0.1004880071f,
-                       0.6505119801f,
-                       1.200511932f,
-                       1.60501194f,
-                       2.200511932f };
+        dstDescs[1] = &resDesc2;
+    }
 
-const std::vector<float> resImgB =
-    {                                 0.2006880045f,
-                                      0.7006880045f,
-                                      1.250712037f,
-                                      1.700711966f,
-                                      2.309612036f,
-                                      2.790712118f };
+    // Mismatching dimensions.
+    {
+        std::vector<float> res(numPixels * 4);
+        OCIO::PackedImageDesc resDesc(&res[0], width - 1, height, 4);
+        dstDescs[1] = &resDesc;
 
-const std::vector<float> resImgA =
-    {                                                0.5057050f,
-                                                     0.9057050f,
-                                                     1.4057050f,
-                                                     0.5057050f,
-                                                     1.5057050f,
-                                                     0.5957050f  };
+        OCIO_CHECK_THROW_WHAT(group->apply(srcDesc, dstDescs), OCIO::Exception,
+                              "Dimension inconsistency");
 
-const std::vector<float> resImg =
-    { resImgR[0], resImgG[0], resImgB[0], resImgA[0],
-      resImgR[1], resImgG[1], resImgB[1], resImgA[1],
-      resImgR[2], resImgG[2], resImgB[2], resImgA[2],
-      resImgR[3], resImgG[3], resImgB[3], resImgA[3],
-      resImgR[4], resImgG[4], resImgB[4], resImgA[4],
-      resImgR[5], resImgG[5], resImgB[5], resImgA[5] };
+        dstDescs[1] = &resDesc2;
+    }
 
+    // No shared op.
+    OCIO::ConstProcessorRcPtr others[2] = { processors[0], nullptr };
+    OCIO_CHECK_NO_THROW(others[1] = config->getProcessor(log));
+    OCIO_CHECK_NO_THROW(group = OCIO::CPUProcessorGroup::Create(others, 2,
+                                                                OCIO::BIT_DEPTH_UINT16,
+                                                                outBitDepths,
+                                                                OCIO::OPTIMIZATION_DEFAULT,
+                                                                OCIO::FINALIZATION_DEFAULT));
+    OCIO_CHECK_EQUAL(group->getNumSharedOps(), 0);
+
+    OCIO_CHECK_THROW_WHAT(OCIO::CPUProcessorGroup::Create(others, 0,
+                                                          OCIO::BIT_DEPTH_UINT16,
+                                                          outBitDepths,
+                                                          OCIO::OPTIMIZATION_DEFAULT,
+                                                          OCIO::FINALIZATION_DEFAULT),
+                          OCIO::Exception, "at least one processor");
+}
 
-OCIO::ConstCPUProcessorRcPtr BuildCPUProcessor(OCIO::TransformDirection dir)
+OCIO_ADD_TEST(CPUProcessor, half_conversion)
 {
+    // The unit test validates that the (potentially vectorized) half-float conversions
+    // give the same results than the half type.
+
     OCIO::ConfigRcPtr config = OCIO::Config::Create();
 
-    OCIO::MatrixTransformRcPtr transform = OCIO::MatrixTransform::Create();
-    constexpr double offset4[4] = { 1.4002, 0.4005, 0.8007, 0.5007 };
-    transform->setOffset(offset4);
-    transform->setDirection(dir);
+    OCIO::ConstProcessorRcPtr processor;
+    OCIO_CHECK_NO_THROW(processor = config->getProcessor(OCIO::MatrixTransform::Create()));
 
-    OCIO::ConstProcessorRcPtr processor = config->getProcessor(transform);
-    return processor->getDefaultCPUProcessor();
-}
+    // All the half-float values, with a number of pixels not multiple of two.
+    constexpr long numHalfPixels = 65536 / 4 - 1;
 
-void Validate(const OCIO::PackedImageDesc & imgDesc, unsigned lineNo)
-{
-    const float * outImg = reinterpret_cast<float*>(imgDesc.getData());
-    for(size_t pxl=0; pxl<NB_PIXELS; ++pxl)
+    std::vector<half> halfImg(numHalfPixels * 4);
+    for(size_t idx=0; idx<halfImg.size(); ++idx)
     {
-        OCIO_CHECK_CLOSE_FROM(outImg[4*pxl+0], resImg[4*pxl+0], 1e-7f, lineNo);
-        OCIO_CHECK_CLOSE_FROM(outImg[4*pxl+1], resImg[4*pxl+1], 1e-7f, lineNo);
-        OCIO_CHECK_CLOSE_FROM(outImg[4*pxl+2], resImg[4*pxl+2], 1e-7f, lineNo);
-        OCIO_CHECK_CLOSE_FROM(outImg[4*pxl+3], resImg[4*pxl+3], 1e-7f, lineNo);
+        halfImg[idx].setBits((unsigned short)idx);
     }
-}
 
-void Process(const OCIO::ConstCPUProcessorRcPtr & cpuProcessor,
-             const OCIO::PackedImageDesc & srcImgDesc,
-             OCIO::PackedImageDesc & dstImgDesc,
-             unsigned lineNo)
-{
-    OCIO_CHECK_NO_THROW_FROM(cpuProcessor->apply(srcImgDesc, dstImgDesc), lineNo);
-    Validate(dstImgDesc, lineNo);
-}
+    {
+        OCIO::ConstCPUProcessorRcPtr cpuProcessor;
+        OCIO_CHECK_NO_THROW(cpuProcessor
+            = processor->getOptimizedCPUProcessor(OCIO::BIT_DEPTH_F16, OCIO::BIT_DEPTH_F32,
+                                                  OCIO::OPTIMIZATION_DEFAULT,
+                                                  OCIO::FINALIZATION_DEFAULT));
 
-void Process(const OCIO::ConstCPUProcessorRcPtr & cpuProcessor,
-             OCIO::PackedImageDesc & imgDesc,
-             unsigned lineNo)
-{
-    OCIO_CHECK_NO_THROW_FROM(cpuProcessor->apply(imgDesc), lineNo);
-    Validate(imgDesc, lineNo);
-}
+        const OCIO::PackedImageDesc srcDesc(&halfImg[0], numHalfPixels, 1, 4,
+                                            OCIO::BIT_DEPTH_F16, sizeof(half),
+                                            4 * sizeof(half), OCIO::AutoStride);
 
-void Process(const OCIO::ConstCPUProcessorRcPtr & cpuProcessor,
-             const OCIO::PlanarImageDesc & srcImgDesc,
-             OCIO::PlanarImageDesc & dstImgDesc,
-             unsigned lineNo)
-{
-    OCIO_CHECK_NO_THROW_FROM(cpuProcessor->apply(srcImgDesc, dstImgDesc), lineNo);
+        std::vector<float> res(halfImg.size());
+        OCIO::PackedImageDesc dstDesc(&res[0], numHalfPixels, 1, 4);
 
-    const float * outImgR = reinterpret_cast<float*>(dstImgDesc.getRData());
-    const float * outImgG = reinterpret_cast<float*>(dstImgDesc.getGData());
-    const float * outImgB = reinterpret_cast<float*>(dstImgDesc.getBData());
-    const float * outImgA = reinterpret_cast<float*>(dstImgDesc.getAData());
+        OCIO_CHECK_NO_THROW(cpuProcessor->apply(srcDesc, dstDesc));
+
+        for(size_t idx=0; idx<res.size(); ++idx)
+        {
+            const float expected = halfImg[idx];
+            if(OCIO::IsNan(expected))
+            {
+                OCIO_CHECK_ASSERT(OCIO::IsNan(res[idx]));
+            }
+            else
+            {
+                OCIO_CHECK_EQUAL(res[idx], expected);
+            }
+        }
+    }
 
-    for(size_t pxl=0; pxl<NB_PIXELS; ++pxl)
     {
-        OCIO_CHECK_CLOSE_FROM(outImgR[pxl], resImg[4*pxl+0], 1e-7f, lineNo);
-        OCIO_CHECK_CLOSE_FROM(outImgG[pxl], resImg[4*pxl+1], 1e-7f, lineNo);
-        OCIO_CHECK_CLOSE_FROM(outImgB[pxl], resImg[4*pxl+2], 1e-7f, lineNo);
-        if(outImgA)
+        OCIO::ConstCPUProcessorRcPtr cpuProcessor;
+        OCIO_CHECK_NO_THROW(cpuProcessor
+            = processor->getOptimizedCPUProcessor(OCIO::BIT_DEPTH_F32, OCIO::BIT_DEPTH_F16,
+                                                  OCIO::OPTIMIZATION_DEFAULT,
+                                                  OCIO::FINALIZATION_DEFAULT));
+
+        // The finite half-float values, the midpoints between them (i.e. the rounding
+        // ties), values slightly above the midpoints and out of range values.
+        std::vector<float> img;
+        for(size_t idx=0; idx<halfImg.size(); ++idx)
         {
-            OCIO_CHECK_CLOSE_FROM(outImgA[pxl], resImg[4*pxl+3], 1e-7f, lineNo);
+            const half h = halfImg[idx];
+            if(h.isFinite())
+            {
+                half next;
+                next.setBits(h.bits() + 1);
+
+                const float value = h;
+                img.push_back(value);
+                if(next.isFinite() && (h.bits() & 0x7FFF)!=0x7BFF)
+                {
+                    const float midpoint = (value + float(next)) / 2.0f;
+                    img.push_back(midpoint);
+                    img.push_back(std::nextafter(midpoint, float(next)));
+                }
+            }
+        }
+        img.push_back(65519.0f);
+        img.push_back(65520.0f);
+        img.push_back(-1.0e10f);
+        img.push_back(std::numeric_limits<float>::infinity());
+        img.push_back(std::numeric_limits<float>::quiet_NaN());
+        img.push_back(std::numeric_limits<float>::denorm_min());
+        while(img.size() % 4)
+        {
+            img.push_back(0.5f);
+        }
+
+        const long numPixels = long(img.size() / 4);
+
+        const OCIO::PackedImageDesc srcDesc(&img[0], numPixels, 1, 4);
+
+        std::vector<half> res(img.size());
+        OCIO::PackedImageDesc dstDesc(&res[0], numPixels, 1, 4,
+                                      OCIO::BIT_DEPTH_F16, sizeof(half),
+                                      4 * sizeof(half), OCIO::AutoStride);
+
+        OCIO_CHECK_NO_THROW(cpuProcessor->apply(srcDesc, dstDesc));
+
+        for(size_t idx=0; idx<res.size(); ++idx)
+        {
+            const half expected(img[idx]);
+            if(expected.isNan())
+            {
+                OCIO_CHECK_ASSERT(res[idx].isNan());
+            }
+            else
+            {
+                OCIO_CHECK_EQUAL(res[idx].bits(), expected.bits());
+            }
         }
     }
 }
 
-} // anon
+OCIO_ADD_TEST(CPUProcessor, uint14_uint32_bit_depths)
+{
+    // The unit test validates the processing of the 14-bit and 32-bit integer image buffers.
 
+    OCIO::ConfigRcPtr config = OCIO::Config::Create();
 
-OCIO_ADD_TEST(CPUProcessor, planar_vs_packed)
-{
-    // The unit test validates different types for input and output imageDesc.
+    OCIO::ExponentTransformRcPtr exponent = OCIO::ExponentTransform::Create();
+    constexpr double exp4[4] = { 2.2, 2.2, 2.2, 1.0 };
+    exponent->setValue(exp4);
 
-    OCIO::ConstCPUProcessorRcPtr cpuProcessor;
-    OCIO_CHECK_NO_THROW(cpuProcessor = BuildCPUProcessor(OCIO::TRANSFORM_DIR_FORWARD));
+    OCIO::ConstProcessorRcPtr processor;
+    OCIO_CHECK_NO_THROW(processor = config->getProcessor(exponent));
 
-    // 1. Process from Packed to Planar Image Desc using the forward transform.
+    // Process all the 14-bit codes with the integer lookup tables, and without
+    // (i.e. then a 1D LUT replaces the exponent).
+    constexpr long numCodes = 16384;
 
-    OCIO::PackedImageDesc srcImgDesc((void*)&inImg[0], NB_PIXELS, 1, 4);
+    std::vector<uint16_t> codes(numCodes * 4);
+    for(long idx=0; idx<numCodes; ++idx)
+    {
+        codes[4 * idx + 0] = uint16_t(idx);
+        codes[4 * idx + 1] = uint16_t(numCodes - 1 - idx);
+        codes[4 * idx + 2] = uint16_t(idx);
+        codes[4 * idx + 3] = uint16_t(idx);
+    }
 
-    std::vector<float> outR(NB_PIXELS), outG(NB_PIXELS), outB(NB_PIXELS), outA(NB_PIXELS);
-    OCIO::PlanarImageDesc dstImgDesc((void*)&outR[0], (void*)&outG[0],
-                                     (void*)&outB[0], (void*)&outA[0],
-                                     NB_PIXELS, 1);
+    const OCIO::OptimizationFlags noLookup
+        = OCIO::OptimizationFlags(OCIO::OPTIMIZATION_DEFAULT
+                                  & ~OCIO::OPTIMIZATION_LOOKUP_INTEGER_INPUT);
 
-    OCIO_CHECK_NO_THROW(cpuProcessor->apply(srcImgDesc, dstImgDesc));
+    for(OCIO::OptimizationFlags oFlags : { OCIO::OPTIMIZATION_DEFAULT, noLookup })
+    {
+        OCIO::ConstCPUProcessorRcPtr cpuProcessor;
+        OCIO_CHECK_NO_THROW(cpuProcessor
+            = processor->getOptimizedCPUProcessor(OCIO::BIT_DEPTH_UINT14, OCIO::BIT_DEPTH_UINT14,
+                                                  oFlags, OCIO::FINALIZATION_DEFAULT));
 
-    for(size_t idx=0; idx<NB_PIXELS; ++idx)
+        std::vector<uint16_t> res(codes);
+        OCIO::PackedImageDesc desc(&res[0], numCodes, 1, 4, OCIO::BIT_DEPTH_UINT14,
+                                   sizeof(uint16_t), 4 * sizeof(uint16_t), OCIO::AutoStride);
+        OCIO_CHECK_NO_THROW(cpuProcessor->apply(desc));
+
+        for(size_t idx=0; idx<res.size(); ++idx)
+        {
+            if(idx%4==3)
+            {
+                OCIO_CHECK_EQUAL(res[idx], codes[idx]);
+            }
+            else
+            {
+                const double expected = std::pow(codes[idx] / 16383.0, 2.2) * 16383.0;
+                OCIO_CHECK_CLOSE(double(res[idx]), expected, 1.0);
+            }
+        }
+    }
+
+    // The 32-bit integer output is clamped and rounded.
     {
-        OCIO_CHECK_CLOSE(outR[idx], resImg[4*idx+0], 1e-7f);
-        OCIO_CHECK_CLOSE(outG[idx], resImg[4*idx+1], 1e-7f);
-        OCIO_CHECK_CLOSE(outB[idx], resImg[4*idx+2], 1e-7f);
-        OCIO_CHECK_CLOSE(outA[idx], resImg[4*idx+3], 1e-7f);
+        OCIO::ConstCPUProcessorRcPtr cpuProcessor;
+        OCIO_CHECK_NO_THROW(cpuProcessor
+            = processor->getOptimizedCPUProcessor(OCIO::BIT_DEPTH_F32, OCIO::BIT_DEPTH_UINT32,
+                                                  OCIO::OPTIMIZATION_DEFAULT,
+                                                  OCIO::FINALIZATION_DEFAULT));
+
+        std::vector<float> img = { 0.0f, 1.0f, 2.0f,  0.5f,
+                                   1.0f, 0.0f, 0.0f, -0.1f };
+
+        std::vector<uint32_t> res(img.size());
+        const OCIO::PackedImageDesc srcDesc(&img[0], 2, 1, 4);
+        OCIO::PackedImageDesc dstDesc(&res[0], 2, 1, 4, OCIO::BIT_DEPTH_UINT32,
+                                      sizeof(uint32_t), 4 * sizeof(uint32_t), OCIO::AutoStride);
+        OCIO_CHECK_NO_THROW(cpuProcessor->apply(srcDesc, dstDesc));
+
+        OCIO_CHECK_EQUAL(res[0], 0u);
+        OCIO_CHECK_EQUAL(res[1], 4294967295u);
+        OCIO_CHECK_EQUAL(res[2], 4294967295u);
+        OCIO_CHECK_EQUAL(res[3], 2147483648u);
+        OCIO_CHECK_EQUAL(res[4], 4294967295u);
+        OCIO_CHECK_EQUAL(res[7], 0u);
     }
 
-    // 2. Process from Planar to Packed Image Desc using the inverse transform.
+    // The 32-bit integer input.
+    {
+        OCIO::ConstCPUProcessorRcPtr cpuProcessor;
+        OCIO_CHECK_NO_THROW(cpuProcessor
+            = processor->getOptimizedCPUProcessor(OCIO::BIT_DEPTH_UINT32, OCIO::BIT_DEPTH_F32,
+                                                  OCIO::OPTIMIZATION_DEFAULT,
+                                                  OCIO::FINALIZATION_DEFAULT));
+
+        std::vector<uint32_t> img = { 0u, 4294967295u, 2147483648u, 4294967295u };
+
+        std::vector<float> res(img.size());
+        const OCIO::PackedImageDesc srcDesc(&img[0], 1, 1, 4, OCIO::BIT_DEPTH_UINT32,
+                                            sizeof(uint32_t), 4 * sizeof(uint32_t),
+                                            OCIO::AutoStride);
+        OCIO::PackedImageDesc dstDesc(&res[0], 1, 1, 4);
+        OCIO_CHECK_NO_THROW(cpuProcessor->apply(srcDesc, dstDesc));
+
+        OCIO_CHECK_EQUAL(res[0], 0.0f);
+        OCIO_CHECK_CLOSE(res[1], 1.0f, 1e-6f);
+        OCIO_CHECK_CLOSE(res[2], std::pow(0.5f, 2.2f), 1e-5f);
+        OCIO_CHECK_CLOSE(res[3], 1.0f, 1e-6f);
+    }
+}
 
-    OCIO_CHECK_NO_THROW(cpuProcessor = BuildCPUProcessor(OCIO::TRANSFORM_DIR_INVERSE));
+OCIO_ADD_TEST(CPUProcessor, scaled_bit_depth_casts)
+{
+    // The unit test validates that the integer bit-depth 'casts' applying the leading
+    // and trailing Range or gain ops produce the same results as the individual CPU ops.
 
-    std::vector<float> outImg(NB_PIXELS*4, -1.0f);
-    OCIO::PackedImageDesc dstImgDesc2((void*)&outImg[0], NB_PIXELS, 1, 4);
+    constexpr long numPixels = 1031;
+
+    std::vector<uint16_t> src(numPixels * 4);
+    for(size_t idx=0; idx<src.size(); ++idx)
+    {
+        src[idx] = uint16_t((idx * 2477) % 65536);
+    }
+
+    const auto process = [&src](const OCIO::OpRcPtrVec & ops, bool castBitDepths,
+                                std::vector<uint8_t> & res)
+    {
+        OCIO::ConstOpCPURcPtr inBitDepthOp;
+        OCIO::ConstOpCPURcPtrVec cpuOps;
+        OCIO::ConstOpCPURcPtr outBitDepthOp;
+        OCIO::CreateCPUEngine(ops, OCIO::BIT_DEPTH_UINT16, OCIO::BIT_DEPTH_UINT8,
+                              inBitDepthOp, cpuOps, outBitDepthOp, castBitDepths);
+
+        std::vector<float> buf(numPixels * 4);
+        inBitDepthOp->apply(&src[0], &buf[0], numPixels);
+        for(const auto & op : cpuOps)
+        {
+            op->apply(&buf[0], &buf[0], numPixels);
+        }
+        outBitDepthOp->apply(&buf[0], &res[0], numPixels);
 
-    OCIO_CHECK_NO_THROW(cpuProcessor->apply(dstImgDesc, dstImgDesc2));
+        return cpuOps.size();
+    };
 
-    for(size_t idx=0; idx<(NB_PIXELS*4); ++idx)
+    const double scale4[4] = { 0.25, 0.5, 0.75, 0.5 };
+    const double offset4[4] = { 0.1, 0.0, -0.1, 0.2 };
+
+    for(int trailingOp=0; trailingOp<3; ++trailingOp)
     {
-        OCIO_CHECK_CLOSE(outImg[idx], inImg[idx], 1e-6f);
+        OCIO::OpRcPtrVec ops;
+        OCIO::CreateRangeOp(ops, 0.1, 0.9, 0.0, 1.0, OCIO::TRANSFORM_DIR_FORWARD);
+        OCIO::CreateLogOp(ops, 2.0, OCIO::TRANSFORM_DIR_FORWARD);
+        if(trailingOp==0)
+        {
+            OCIO::CreateRangeOp(ops, -1.0, 0.5, -1.0, 0.5, OCIO::TRANSFORM_DIR_FORWARD);
+        }
+        else if(trailingOp==1)
+        {
+            OCIO::CreateRangeOp(ops, -2.0, OCIO::RangeOpData::EmptyValue(),
+                                0.0, OCIO::RangeOpData::EmptyValue(),
+                                OCIO::TRANSFORM_DIR_FORWARD);
+        }
+        else
+        {
+            OCIO::CreateScaleOffsetOp(ops, scale4, offset4, OCIO::TRANSFORM_DIR_FORWARD);
+        }
+        OCIO_CHECK_NO_THROW(OCIO::FinalizeOpVec(ops, OCIO::FINALIZATION_DEFAULT));
+
+        std::vector<uint8_t> expected(numPixels * 4);
+        OCIO_CHECK_EQUAL(process(ops, true, expected), 3);
+
+        // Only the Log op remains between the bit-depth 'casts'.
+        std::vector<uint8_t> res(numPixels * 4);
+        OCIO_CHECK_EQUAL(process(ops, false, res), 1);
+
+        for(size_t idx=0; idx<res.size(); ++idx)
+        {
+            OCIO_CHECK_EQUAL(int(res[idx]), int(expected[idx]));
+        }
     }
 }
 
-OCIO_ADD_TEST(CPUProcessor, scanline_helper_packed)
+OCIO_ADD_TEST(CPUProcessor, uint8_lut3d_input)
 {
-    // Test the packed image description.
-
-    OCIO::ConstCPUProcessorRcPtr cpuProcessor;
-    OCIO_CHECK_NO_THROW(cpuProcessor = BuildCPUProcessor(OCIO::TRANSFORM_DIR_FORWARD));
+    // The leading tetrahedral 3D LUT directly processes the 8-bit input pixels, giving the
+    // results of the 'cast' to 32-bit float followed by the 3D LUT.
 
-    std::vector<float> outImg(NB_PIXELS*4);
+    constexpr long numPixels = 1031;
 
+    std::vector<uint8_t> src(numPixels * 4);
+    for(size_t idx=0; idx<src.size(); ++idx)
     {
-        OCIO::PackedImageDesc srcImgDesc(&inImg[0], NB_PIXELS, 1, 4);
-        OCIO::PackedImageDesc dstImgDesc(&outImg[0], NB_PIXELS, 1, 4);
-
-        Process(cpuProcessor, srcImgDesc, dstImgDesc, __LINE__);
+        src[idx] = uint8_t((idx * 2477) % 256);
     }
 
+    const auto process = [&src](const OCIO::OpRcPtrVec & ops, bool castBitDepths,
+                                std::vector<uint8_t> & res, std::string & inRenderer)
     {
-        OCIO::PackedImageDesc srcImgDesc(&inImg[0], 1, NB_PIXELS, 4);
-        OCIO::PackedImageDesc dstImgDesc(&outImg[0], 1, NB_PIXELS, 4);
+        OCIO::ConstOpCPURcPtr inBitDepthOp;
+        OCIO::ConstOpCPURcPtrVec cpuOps;
+        OCIO::ConstOpCPURcPtr outBitDepthOp;
+        OCIO::CreateCPUEngine(ops, OCIO::BIT_DEPTH_UINT8, OCIO::BIT_DEPTH_UINT8,
+                              inBitDepthOp, cpuOps, outBitDepthOp, castBitDepths);
+
+        std::vector<float> buf(numPixels * 4);
+        inBitDepthOp->apply(&src[0], &buf[0], numPixels);
+        for(const auto & op : cpuOps)
+        {
+            op->apply(&buf[0], &buf[0], numPixels);
+        }
+        outBitDepthOp->apply(&buf[0], &res[0], numPixels);
 
-        Process(cpuProcessor, srcImgDesc, dstImgDesc, __LINE__);
-    }
+        inRenderer = OCIO::GetRendererName(*inBitDepthOp);
 
-    {
-        OCIO::PackedImageDesc srcImgDesc(&inImg[0], 2, 3, 4);
-        OCIO::PackedImageDesc dstImgDesc(&outImg[0], 2, 3, 4);
+        return cpuOps.size();
+    };
 
-        Process(cpuProcessor, srcImgDesc, dstImgDesc, __LINE__);
+    OCIO::Lut3DOpDataRcPtr lut
+        = std::make_shared<OCIO::Lut3DOpData>(OCIO::INTERP_TETRAHEDRAL, 33);
+    OCIO::Array::Values & values = lut->getArray().getValues();
+    for(size_t idx=0; idx<values.size(); ++idx)
+    {
+        values[idx] = std::sin(float(idx) * 0.01f) * 0.5f + 0.5f;
     }
 
-    {
-        OCIO::PackedImageDesc srcImgDesc(&inImg[0], 3, 2, 4);
-        OCIO::PackedImageDesc dstImgDesc(&outImg[0], 3, 2, 4);
+    OCIO::OpRcPtrVec ops;
+    OCIO::CreateLut3DOp(ops, lut, OCIO::TRANSFORM_DIR_FORWARD);
+    OCIO::CreateLogOp(ops, 2.0, OCIO::TRANSFORM_DIR_FORWARD);
+    OCIO_CHECK_NO_THROW(OCIO::FinalizeOpVec(ops, OCIO::FINALIZATION_DEFAULT));
 
-        Process(cpuProcessor, srcImgDesc, dstImgDesc, __LINE__);
-    }
+    std::string renderer;
 
-    {
-        OCIO::PackedImageDesc srcImgDesc(&inImg[0], 2, 3, 4);
-        OCIO::PackedImageDesc dstImgDesc(&outImg[0], 2, 3,
-                                         OCIO::CHANNEL_ORDERING_RGBA,
-                                         OCIO::BIT_DEPTH_F32,
-                                         sizeof(float),
-                                         OCIO::AutoStride,
-                                         OCIO::AutoStride);
+    std::vector<uint8_t> expected(numPixels * 4);
+    OCIO_CHECK_EQUAL(process(ops, true, expected, renderer), 2);
 
-        Process(cpuProcessor, srcImgDesc, dstImgDesc, __LINE__);
-    }
+    // Only the Log op remains after the 8-bit 3D LUT renderer.
+    std::vector<uint8_t> res(numPixels * 4);
+    OCIO_CHECK_EQUAL(process(ops, false, res, renderer), 1);
+    OCIO_CHECK_EQUAL(renderer, std::string("Lut3DTetrahedralUInt8Renderer"));
 
+    for(size_t idx=0; idx<res.size(); ++idx)
     {
-        OCIO::PackedImageDesc srcImgDesc(&inImg[0], 2, 3, 4);
-        OCIO::PackedImageDesc dstImgDesc(&outImg[0], 2, 3,
-                                         OCIO::CHANNEL_ORDERING_RGBA,
-                                         OCIO::BIT_DEPTH_F32,
-                                         sizeof(float),
-                                         4*sizeof(float),
-                                         OCIO::AutoStride);
-
-        Process(cpuProcessor, srcImgDesc, dstImgDesc, __LINE__);
+        OCIO_CHECK_EQUAL(int(res[idx]), int(expected[idx]));
     }
+}
 
-    {
-        OCIO::PackedImageDesc srcImgDesc(&inImg[0], 2, 3, 4);
-        OCIO::PackedImageDesc dstImgDesc(&outImg[0], 2, 3,
-                                         4, // Number of channels
-                                         OCIO::BIT_DEPTH_F32,
-                                         sizeof(float),
-                                         4*sizeof(float),
-                                         OCIO::AutoStride);
+OCIO_ADD_TEST(CPUProcessor, uint8_shaper_lut3d_input)
+{
+    // The shaper 1D LUT and the tetrahedral 3D LUT (i.e. a baked LUT) directly process the
+    // 8-bit input pixels in one pass, giving the results of the 8-bit 1D LUT renderer followed
+    // by the 3D LUT renderer.
 
-        Process(cpuProcessor, srcImgDesc, dstImgDesc, __LINE__);
-    }
+    constexpr long numPixels = 1031;
 
+    std::vector<uint8_t> src(numPixels * 4);
+    for(size_t idx=0; idx<src.size(); ++idx)
     {
-        OCIO::PackedImageDesc srcImgDesc(&inImg[0], 2, 3, 4);
-        OCIO::PackedImageDesc dstImgDesc(&outImg[0], 2, 3,
-                                         4, // Number of channels
-                                         OCIO::BIT_DEPTH_F32,
-                                         OCIO::AutoStride,
-                                         4*sizeof(float),
-                                         OCIO::AutoStride);
-
-        Process(cpuProcessor, srcImgDesc, dstImgDesc, __LINE__);
+        src[idx] = uint8_t((idx * 2477) % 256);
     }
 
+    OCIO::Lut1DOpDataRcPtr shaper = std::make_shared<OCIO::Lut1DOpData>(1024);
+    OCIO::Array::Values & shaperValues = shaper->getArray().getValues();
+    for(size_t idx=0; idx<shaperValues.size(); ++idx)
     {
-        OCIO::PackedImageDesc srcImgDesc(&inImg[0], 2, 3, 4);
-        OCIO::PackedImageDesc dstImgDesc(&outImg[0], 2, 3,
-                                         4, // Number of channels
-                                         OCIO::BIT_DEPTH_F32,
-                                         OCIO::AutoStride,
-                                         4*sizeof(float),
-                                         2*4*sizeof(float));
-
-        Process(cpuProcessor, srcImgDesc, dstImgDesc, __LINE__);
+        // Some values are outside of the 3D LUT domain.
+        shaperValues[idx] = std::pow(float(idx / 3) / 1023.0f, 0.45f) * 1.1f - 0.05f;
     }
 
+    OCIO::Lut3DOpDataRcPtr lut
+        = std::make_shared<OCIO::Lut3DOpData>(OCIO::INTERP_TETRAHEDRAL, 17);
+    OCIO::Array::Values & values = lut->getArray().getValues();
+    for(size_t idx=0; idx<values.size(); ++idx)
     {
-        OCIO::PackedImageDesc srcImgDesc(&inImg[0], 2, 3, 4);
-        OCIO::PackedImageDesc dstImgDesc(&outImg[0], 2, 3,
-                                         4, // Number of channels
-                                         OCIO::BIT_DEPTH_F32,
-                                         OCIO::AutoStride,
-                                         OCIO::AutoStride,
-                                         2*4*sizeof(float));
+        values[idx] = std::sin(float(idx) * 0.01f) * 0.5f + 0.5f;
+    }
 
-        Process(cpuProcessor, srcImgDesc, dstImgDesc, __LINE__);
+    OCIO::OpRcPtrVec ops;
+    OCIO::CreateLut1DOp(ops, shaper, OCIO::TRANSFORM_DIR_FORWARD);
+    OCIO::CreateLut3DOp(ops, lut, OCIO::TRANSFORM_DIR_FORWARD);
+    OCIO::CreateLogOp(ops, 2.0, OCIO::TRANSFORM_DIR_FORWARD);
+    OCIO_CHECK_NO_THROW(OCIO::FinalizeOpVec(ops, OCIO::FINALIZATION_DEFAULT));
+
+    OCIO::ConstOpCPURcPtr inBitDepthOp;
+    OCIO::ConstOpCPURcPtrVec cpuOps;
+    OCIO::ConstOpCPURcPtr outBitDepthOp;
+    OCIO_CHECK_NO_THROW(OCIO::CreateCPUEngine(ops, OCIO::BIT_DEPTH_UINT8, OCIO::BIT_DEPTH_UINT8,
+                                              inBitDepthOp, cpuOps, outBitDepthOp, false));
+
+    // Only the Log op remains after the 8-bit shaper and 3D LUT renderer.
+    OCIO_CHECK_EQUAL(cpuOps.size(), 1);
+    OCIO_CHECK_EQUAL(OCIO::GetRendererName(*inBitDepthOp),
+                     std::string("Lut3DTetrahedralUInt8Renderer"));
+
+    std::vector<float> res(numPixels * 4);
+    inBitDepthOp->apply(&src[0], &res[0], numPixels);
+
+    OCIO::ConstLut1DOpDataRcPtr constShaper = shaper;
+    std::vector<float> expected(numPixels * 4);
+    OCIO::GetLut1DRenderer(constShaper, OCIO::BIT_DEPTH_UINT8, OCIO::BIT_DEPTH_F32)
+        ->apply(&src[0], &expected[0], numPixels);
+    OCIO::ConstOpRcPtr lutOp = ops[1];
+    lutOp->getCPUOp()->apply(&expected[0], &expected[0], numPixels);
+
+    for(size_t idx=0; idx<res.size(); ++idx)
+    {
+#ifdef USE_SSE
+        OCIO_CHECK_EQUAL(res[idx], expected[idx]);
+#else
+        OCIO_CHECK_CLOSE(res[idx], expected[idx], 1e-6f);
+#endif
     }
+
+    // The 32-bit float input pixels are processed by the shaper and 3D LUT CPU op.
+    OCIO::ConstOpCPURcPtr f32InOp;
+    OCIO::ConstOpCPURcPtrVec f32CPUOps;
+    OCIO::ConstOpCPURcPtr f32OutOp;
+    OCIO_CHECK_NO_THROW(OCIO::CreateCPUEngine(ops, OCIO::BIT_DEPTH_F32, OCIO::BIT_DEPTH_F32,
+                                              f32InOp, f32CPUOps, f32OutOp, false));
+    OCIO_CHECK_EQUAL(OCIO::GetRendererName(*f32InOp), std::string("ShaperLut3DRenderer"));
+    OCIO_CHECK_EQUAL(f32CPUOps.size(), 0);
 }
 
-OCIO_ADD_TEST(CPUProcessor, scanline_helper_packed_one_buffer)
+OCIO_ADD_TEST(CPUProcessor, region_of_interest)
 {
-    // Now that the previous unit test covers all cases with different buffers,
-    // let's test some cases using the same in and out buffer.
+    // The unit test validates that only the region of interest of the image buffers
+    // is processed, for the different processing paths.
 
-    OCIO::ConstCPUProcessorRcPtr cpuProcessor;
-    OCIO_CHECK_NO_THROW(cpuProcessor = BuildCPUProcessor(OCIO::TRANSFORM_DIR_FORWARD));
+    OCIO::ConstProcessorRcPtr processor;
+    OCIO_CHECK_NO_THROW(processor = BuildParallelTestProcessor());
 
-    std::vector<float> processingImg(NB_PIXELS*4);
+    OCIO::ConstCPUProcessorRcPtr cpuProcessor;
+    OCIO_CHECK_NO_THROW(cpuProcessor = processor->getDefaultCPUProcessor());
 
-    {
-        processingImg = inImg;
+    constexpr long width  = 301;
+    constexpr long height = 257;
 
-        OCIO::PackedImageDesc imgDesc(&processingImg[0], NB_PIXELS, 1, 4);
+    constexpr long roiX      = 17;
+    constexpr long roiY      = 101;
+    constexpr long roiWidth  = 203;
+    constexpr long roiHeight = 83;
 
-        Process(cpuProcessor, imgDesc, __LINE__);
+    std::vector<float> img(width * height * 4);
+    for(size_t idx=0; idx<img.size(); ++idx)
+    {
+        img[idx] = float(idx % 1031) / 1031.0f;
     }
 
+    std::vector<float> ref(img);
+    OCIO::PackedImageDesc refDesc(&ref[0], width, height, 4);
+    OCIO_CHECK_NO_THROW(cpuProcessor->apply(refDesc));
+
+    auto inROI = [](long pxl)
     {
-        processingImg = inImg;
+        const long x = pxl % width;
+        const long y = pxl / width;
+        return x>=roiX && x<roiX+roiWidth && y>=roiY && y<roiY+roiHeight;
+    };
 
-        OCIO::PackedImageDesc imgDesc(&processingImg[0], 3, 2, 4);
+    // In-place processing, serial and parallel.
+    for(bool parallel : { false, true })
+    {
+        std::vector<float> res(img);
+        OCIO::PackedImageDesc desc(&res[0], width, height, 4);
+        OCIO_CHECK_ASSERT(!desc.hasROI());
+        OCIO_CHECK_EQUAL(desc.getROIWidth(), width);
+        OCIO_CHECK_EQUAL(desc.getROIHeight(), height);
+
+        desc.setROI(roiX, roiY, roiWidth, roiHeight);
+        OCIO_CHECK_ASSERT(desc.hasROI());
+        OCIO_CHECK_EQUAL(desc.getROIWidth(), roiWidth);
+        OCIO_CHECK_EQUAL(desc.getROIHeight(), roiHeight);
+
+        if(parallel)
+        {
+            OCIO_CHECK_NO_THROW(cpuProcessor->apply(desc, OCIO::CPUExecutor()));
+        }
+        else
+        {
+            OCIO_CHECK_NO_THROW(cpuProcessor->apply(desc));
+        }
 
-        Process(cpuProcessor, imgDesc, __LINE__);
+        for(long pxl=0; pxl<width*height; ++pxl)
+        {
+            const std::vector<float> & expected = inROI(pxl) ? ref : img;
+            for(long c=0; c<4; ++c)
+            {
+                OCIO_CHECK_EQUAL(res[4*pxl+c], expected[4*pxl+c]);
+            }
+        }
     }
 
+    // Out-of-place processing into a buffer only holding the region.
     {
-        processingImg = inImg;
+        std::vector<float> res(roiWidth * roiHeight * 3);
+        OCIO::PackedImageDesc srcDesc(&img[0], width, height, 4);
+        srcDesc.setROI(roiX, roiY, roiWidth, roiHeight);
+        OCIO::PackedImageDesc dstDesc(&res[0], roiWidth, roiHeight, OCIO::CHANNEL_ORDERING_BGR);
+        OCIO_CHECK_NO_THROW(cpuProcessor->apply(srcDesc, dstDesc));
 
-        OCIO::PackedImageDesc imgDesc(&processingImg[0], 1, NB_PIXELS, 4);
+        for(long y=0; y<roiHeight; ++y)
+        {
+            for(long x=0; x<roiWidth; ++x)
+            {
+                const long srcPxl = (y + roiY) * width + x + roiX;
+                const long dstPxl = y * roiWidth + x;
 
-        Process(cpuProcessor, imgDesc, __LINE__);
+                OCIO_CHECK_EQUAL(res[3*dstPxl+0], ref[4*srcPxl+2]);
+                OCIO_CHECK_EQUAL(res[3*dstPxl+1], ref[4*srcPxl+1]);
+                OCIO_CHECK_EQUAL(res[3*dstPxl+2], ref[4*srcPxl+0]);
+            }
+        }
     }
-}
-
-OCIO_ADD_TEST(CPUProcessor, scanline_helper_planar)
-{
-    // Test the planar image description.
 
-    OCIO::ConstCPUProcessorRcPtr cpuProcessor;
-    OCIO_CHECK_NO_THROW(cpuProcessor = BuildCPUProcessor(OCIO::TRANSFORM_DIR_FORWARD));
+    // Planar processing.
+    {
+        std::vector<float> r(width * height), g(width * height), b(width * height);
+        for(long pxl=0; pxl<width*height; ++pxl)
+        {
+            r[pxl] = img[4*pxl+0];
+            g[pxl] = img[4*pxl+1];
+            b[pxl] = img[4*pxl+2];
+        }
 
-    std::vector<float> outImgR(NB_PIXELS);
-    std::vector<float> outImgG(NB_PIXELS);
-    std::vector<float> outImgB(NB_PIXELS);
-    std::vector<float> outImgA(NB_PIXELS);
+        OCIO::PlanarImageDesc desc(&r[0], &g[0], &b[0], nullptr, width, height);
+        desc.setROI(roiX, roiY, roiWidth, roiHeight);
+        OCIO_CHECK_NO_THROW(cpuProcessor->apply(desc));
 
-    {
-        OCIO::PlanarImageDesc srcImgDesc(&inImgR[0], &inImgG[0], &inImgB[0], &inImgA[0], NB_PIXELS, 1);
-        OCIO::PlanarImageDesc dstImgDesc(&outImgR[0], &outImgG[0], &outImgB[0], &outImgA[0], NB_PIXELS, 1);
+        std::vector<float> rgba(img);
+        OCIO::PackedImageDesc rgbaDesc(&rgba[0], width, height, 4);
+        rgbaDesc.setROI(roiX, roiY, roiWidth, roiHeight);
+        OCIO_CHECK_NO_THROW(cpuProcessor->apply(rgbaDesc));
 
-        Process(cpuProcessor, srcImgDesc, dstImgDesc, __LINE__);
+        for(long pxl=0; pxl<width*height; ++pxl)
+        {
+            OCIO_CHECK_CLOSE(r[pxl], rgba[4*pxl+0], 1e-6f);
+            OCIO_CHECK_CLOSE(g[pxl], rgba[4*pxl+1], 1e-6f);
+            OCIO_CHECK_CLOSE(b[pxl], rgba[4*pxl+2], 1e-6f);
+        }
     }
 
+    // Back to the complete image buffer.
     {
-        OCIO::PlanarImageDesc srcImgDesc(&inImgR[0], &inImgG[0], &inImgB[0], &inImgA[0], NB_PIXELS, 1);
-        OCIO::PlanarImageDesc dstImgDesc(&outImgR[0], &outImgG[0], &outImgB[0], &outImgA[0], NB_PIXELS, 1);
-
-        Process(cpuProcessor, srcImgDesc, dstImgDesc, __LINE__);
+        std::vector<float> res(img);
+        OCIO::PackedImageDesc desc(&res[0], width, height, 4);
+        desc.setROI(roiX, roiY, roiWidth, roiHeight);
+        desc.resetROI();
+        OCIO_CHECK_ASSERT(!desc.hasROI());
+        OCIO_CHECK_NO_THROW(cpuProcessor->apply(desc));
+
+        for(size_t idx=0; idx<res.size(); ++idx)
+        {
+            OCIO_CHECK_EQUAL(res[idx], ref[idx]);
+        }
     }
 
+    // Invalid regions.
     {
-        OCIO::PlanarImageDesc srcImgDesc(&inImgR[0], &inImgG[0], &inImgB[0], &inImgA[0], NB_PIXELS, 1);
-        OCIO::PlanarImageDesc dstImgDesc(&outImgR[0], &outImgG[0], &outImgB[0], &outImgA[0], NB_PIXELS, 1);
-
-        Process(cpuProcessor, srcImgDesc, dstImgDesc, __LINE__);
+        std::vector<float> res(img);
+        OCIO::PackedImageDesc desc(&res[0], width, height, 4);
+
+        OCIO_CHECK_THROW_WHAT(desc.setROI(-1, 0, 10, 10), OCIO::Exception,
+                              "Invalid region of interest");
+        OCIO_CHECK_THROW_WHAT(desc.setROI(0, 0, 0, 10), OCIO::Exception,
+                              "Invalid region of interest");
+
+        desc.setROI(width - 10, 0, 11, 10);
+        OCIO_CHECK_THROW_WHAT(cpuProcessor->apply(desc), OCIO::Exception,
+                              "outside of the image buffer");
+
+        std::vector<float> dst(img);
+        OCIO::PackedImageDesc srcDesc(&img[0], width, height, 4);
+        srcDesc.setROI(roiX, roiY, roiWidth, roiHeight);
+        OCIO::PackedImageDesc dstDesc(&dst[0], width, height, 4);
+        OCIO_CHECK_THROW_WHAT(cpuProcessor->apply(srcDesc, dstDesc, OCIO::CPUExecutor()),
+                              OCIO::Exception,
+                              "Dimension inconsistency");
     }
+}
 
-    {
-        OCIO::PlanarImageDesc srcImgDesc(&inImgR[0], &inImgG[0], &inImgB[0], &inImgA[0], 3, 2);
-        OCIO::PlanarImageDesc dstImgDesc(&outImgR[0], &outImgG[0], &outImgB[0], &outImgA[0], 3, 2);
+OCIO_ADD_TEST(CPUProcessor, scanline_image_desc)
+{
+    // The unit test validates that the image buffers made of separate lines give the same
+    // results as the contiguous ones, for the different processing paths.
 
-        Process(cpuProcessor, srcImgDesc, dstImgDesc, __LINE__);
-    }
+    OCIO::ConstProcessorRcPtr processor;
+    OCIO_CHECK_NO_THROW(processor = BuildParallelTestProcessor());
 
-    {
-        OCIO::PlanarImageDesc srcImgDesc(&inImgR[0], &inImgG[0], &inImgB[0], &inImgA[0], 2, 3);
-        OCIO::PlanarImageDesc dstImgDesc(&outImgR[0], &outImgG[0], &outImgB[0], &outImgA[0],
-                                         2, 3,
-                                         OCIO::BIT_DEPTH_F32,
-                                         sizeof(float),
-                                         OCIO::AutoStride);
+    OCIO::ConstCPUProcessorRcPtr cpuProcessor;
+    OCIO_CHECK_NO_THROW(cpuProcessor = processor->getDefaultCPUProcessor());
 
-        Process(cpuProcessor, srcImgDesc, dstImgDesc, __LINE__);
-    }
+    constexpr long width  = 301;
+    constexpr long height = 257;
 
+    std::vector<float> img(width * height * 4);
+    for(size_t idx=0; idx<img.size(); ++idx)
     {
-        OCIO::PlanarImageDesc srcImgDesc(&inImgR[0], &inImgG[0], &inImgB[0], &inImgA[0], 2, 3);
-        OCIO::PlanarImageDesc dstImgDesc(&outImgR[0], &outImgG[0], &outImgB[0], &outImgA[0],
-                                         2, 3,
-                                         OCIO::BIT_DEPTH_F32,
-                                         sizeof(float),
-                                         2*sizeof(float));
-
-        Process(cpuProcessor, srcImgDesc, dstImgDesc, __LINE__);
+        img[idx] = float(idx % 1031) / 1031.0f;
     }
 
-    {
-        OCIO::PlanarImageDesc srcImgDesc(&inImgR[0], &inImgG[0], &inImgB[0], &inImgA[0], 2, 3);
-        OCIO::PlanarImageDesc dstImgDesc(&outImgR[0], &outImgG[0], &outImgB[0], &outImgA[0],
-                                         2, 3,
-                                         OCIO::BIT_DEPTH_F32,
-                                         OCIO::AutoStride,
-                                         2*sizeof(float));
+    std::vector<float> ref(img);
+    OCIO::PackedImageDesc refDesc(&ref[0], width, height, 4);
+    OCIO_CHECK_NO_THROW(cpuProcessor->apply(refDesc));
 
-        Process(cpuProcessor, srcImgDesc, dstImgDesc, __LINE__);
-    }
+    // Each line has its own allocation (i.e. there is no constant y stride).
+    std::vector<std::vector<float>> lines(height);
+    std::vector<void *> rows(height);
 
+    auto initLines = [&lines, &rows, &img]()
     {
-        OCIO::PlanarImageDesc srcImgDesc(&inImgR[0], &inImgG[0], &inImgB[0], &inImgA[0],
-                                         2, 3,
-                                         OCIO::BIT_DEPTH_F32,
-                                         OCIO::AutoStride,
-                                         2*sizeof(float));
+        for(long y=0; y<height; ++y)
+        {
+            lines[y].assign(img.begin() + 4 * width * y, img.begin() + 4 * width * (y + 1));
+            rows[y] = &lines[y][0];
+        }
+    };
 
-        OCIO::PlanarImageDesc dstImgDesc(&outImgR[0], &outImgG[0], &outImgB[0], &outImgA[0],
-                                         2, 3,
-                                         OCIO::BIT_DEPTH_F32,
-                                         OCIO::AutoStride,
-                                         2*sizeof(float));
+    // In-place processing of packed lines, serial and parallel.
+    for(bool parallel : { false, true })
+    {
+        initLines();
+
+        OCIO::ScanlineImageDesc desc(&rows[0], width, height, OCIO::CHANNEL_ORDERING_RGBA);
+        OCIO_CHECK_ASSERT(!desc.isPlanar());
+        OCIO_CHECK_ASSERT(desc.isRGBAPacked());
+        OCIO_CHECK_ASSERT(desc.isFloat());
+        OCIO_CHECK_EQUAL(desc.getRRows(), &rows[0]);
+        OCIO_CHECK_EQUAL(desc.getARows(), &rows[0]);
+        OCIO_CHECK_EQUAL(desc.getRData(), rows[0]);
+        // The alpha channel of the first pixel.
+        OCIO_CHECK_EQUAL(desc.getAData(), (void *)&lines[0][3]);
+        OCIO_CHECK_EQUAL(desc.getHeight(), height);
+        OCIO_CHECK_EQUAL(desc.getYStrideBytes(), 0);
+
+        if(parallel)
+        {
+            OCIO_CHECK_NO_THROW(cpuProcessor->apply(desc, OCIO::CPUExecutor()));
+        }
+        else
+        {
+            OCIO_CHECK_NO_THROW(cpuProcessor->apply(desc));
+        }
 
-        Process(cpuProcessor, srcImgDesc, dstImgDesc, __LINE__);
+        for(long y=0; y<height; ++y)
+        {
+            for(long idx=0; idx<4*width; ++idx)
+            {
+                OCIO_CHECK_EQUAL(lines[y][idx], ref[4*width*y + idx]);
+            }
+        }
     }
 
+    // Packed lines in another channel ordering, from contiguous pixels.
     {
-        OCIO::PlanarImageDesc srcImgDesc(&inImgR[0], &inImgG[0], &inImgB[0], &inImgA[0],
-                                         2, 3,
-                                         OCIO::BIT_DEPTH_F32,
-                                         sizeof(float),
-                                         2*sizeof(float));
+        std::vector<std::vector<float>> dstLines(height, std::vector<float>(3 * width + 5));
+        std::vector<void *> dstRows(height);
+        for(long y=0; y<height; ++y)
+        {
+            dstRows[y] = &dstLines[y][0];
+        }
 
-        OCIO::PlanarImageDesc dstImgDesc(&outImgR[0], &outImgG[0], &outImgB[0], &outImgA[0],
-                                         2, 3,
-                                         OCIO::BIT_DEPTH_F32,
-                                         OCIO::AutoStride,
-                                         2*sizeof(float));
+        OCIO::PackedImageDesc srcDesc(&img[0], width, height, 4);
+        OCIO::ScanlineImageDesc dstDesc(&dstRows[0], width, height, OCIO::CHANNEL_ORDERING_BGR);
+        OCIO_CHECK_ASSERT(!dstDesc.getARows());
+        OCIO_CHECK_NO_THROW(cpuProcessor->apply(srcDesc, dstDesc, OCIO::CPUExecutor()));
 
-        Process(cpuProcessor, srcImgDesc, dstImgDesc, __LINE__);
+        for(long y=0; y<height; ++y)
+        {
+            for(long x=0; x<width; ++x)
+            {
+                const long pxl = y * width + x;
+                OCIO_CHECK_EQUAL(dstLines[y][3*x+0], ref[4*pxl+2]);
+                OCIO_CHECK_EQUAL(dstLines[y][3*x+1], ref[4*pxl+1]);
+                OCIO_CHECK_EQUAL(dstLines[y][3*x+2], ref[4*pxl+0]);
+            }
+        }
     }
 
+    // Planar lines.
     {
-        OCIO::PlanarImageDesc srcImgDesc(&inImgR[0], &inImgG[0], &inImgB[0], &inImgA[0],
-                                         2, 3,
-                                         OCIO::BIT_DEPTH_F32,
-                                         sizeof(float),
-                                         2*sizeof(float));
+        std::vector<std::vector<float>> planes(4 * height, std::vector<float>(width));
+        std::vector<void *> planeRows[4];
+        for(int c=0; c<4; ++c)
+        {
+            planeRows[c].resize(height);
+            for(long y=0; y<height; ++y)
+            {
+                std::vector<float> & line = planes[y * 4 + c];
+                for(long x=0; x<width; ++x)
+                {
+                    line[x] = img[4 * (y * width + x) + c];
+                }
+                planeRows[c][y] = &line[0];
+            }
+        }
 
-        OCIO::PlanarImageDesc dstImgDesc(&outImgR[0], &outImgG[0], &outImgB[0], nullptr,
-                                         2, 3,
-                                         OCIO::BIT_DEPTH_F32,
-                                         OCIO::AutoStride,
-                                         2*sizeof(float));
+        OCIO::ScanlineImageDesc desc(&planeRows[0][0], &planeRows[1][0],
+                                     &planeRows[2][0], &planeRows[3][0], width, height);
+        OCIO_CHECK_ASSERT(desc.isPlanar());
+        OCIO_CHECK_ASSERT(!desc.isRGBAPacked());
+        OCIO_CHECK_EQUAL(desc.getGRows(), &planeRows[1][0]);
+        OCIO_CHECK_NO_THROW(cpuProcessor->apply(desc, OCIO::CPUExecutor()));
 
-        Process(cpuProcessor, srcImgDesc, dstImgDesc, __LINE__);
+        for(long y=0; y<height; ++y)
+        {
+            for(long x=0; x<width; ++x)
+            {
+                for(int c=0; c<4; ++c)
+                {
+                    OCIO_CHECK_CLOSE(planes[y * 4 + c][x], ref[4 * (y * width + x) + c], 1e-6f);
+                }
+            }
+        }
     }
 
+    // Packed 16-bit integer lines with a region of interest.
     {
-        OCIO::PlanarImageDesc srcImgDesc(&inImgR[0], &inImgG[0], &inImgB[0], nullptr,
-                                         2, 3,
-                                         OCIO::BIT_DEPTH_F32,
-                                         sizeof(float),
-                                         2*sizeof(float));
+        OCIO::ConstCPUProcessorRcPtr cpuProcessorUint16;
+        OCIO_CHECK_NO_THROW(cpuProcessorUint16
+            = processor->getOptimizedCPUProcessor(OCIO::BIT_DEPTH_UINT16, OCIO::BIT_DEPTH_UINT16,
+                                                  OCIO::OPTIMIZATION_DEFAULT,
+                                                  OCIO::FINALIZATION_DEFAULT));
 
-        OCIO::PlanarImageDesc dstImgDesc(&outImgR[0], &outImgG[0], &outImgB[0], nullptr,
-                                         2, 3,
-                                         OCIO::BIT_DEPTH_F32,
-                                         OCIO::AutoStride,
-                                         2*sizeof(float));
+        std::vector<uint16_t> img16(img.size());
+        for(size_t idx=0; idx<img.size(); ++idx)
+        {
+            img16[idx] = uint16_t(img[idx] * 65535.0f);
+        }
 
-        Process(cpuProcessor, srcImgDesc, dstImgDesc, __LINE__);
+        std::vector<uint16_t> ref16(img16);
+        OCIO::PackedImageDesc ref16Desc(&ref16[0], width, height, 4, OCIO::BIT_DEPTH_UINT16,
+                                        sizeof(uint16_t), OCIO::AutoStride, OCIO::AutoStride);
+        ref16Desc.setROI(17, 101, 203, 83);
+        OCIO_CHECK_NO_THROW(cpuProcessorUint16->apply(ref16Desc));
+
+        std::vector<std::vector<uint16_t>> lines16(height);
+        std::vector<void *> rows16(height);
+        for(long y=0; y<height; ++y)
+        {
+            lines16[y].assign(img16.begin() + 4 * width * y, img16.begin() + 4 * width * (y + 1));
+            rows16[y] = &lines16[y][0];
+        }
+
+        OCIO::ScanlineImageDesc desc(&rows16[0], width, height, OCIO::CHANNEL_ORDERING_RGBA,
+                                     OCIO::BIT_DEPTH_UINT16, sizeof(uint16_t), OCIO::AutoStride);
+        desc.setROI(17, 101, 203, 83);
+        OCIO_CHECK_NO_THROW(cpuProcessorUint16->apply(desc, OCIO::CPUExecutor()));
+
+        for(long y=0; y<height; ++y)
+        {
+            for(long idx=0; idx<4*width; ++idx)
+            {
+                OCIO_CHECK_EQUAL(lines16[y][idx], ref16[4*width*y + idx]);
+            }
+        }
+    }
+
+    // Invalid line pointers.
+    {
+        initLines();
+
+        OCIO_CHECK_THROW_WHAT(OCIO::ScanlineImageDesc(nullptr, width, height,
+                                                      OCIO::CHANNEL_ORDERING_RGBA),
+                              OCIO::Exception, "Invalid image buffer");
+        OCIO_CHECK_THROW_WHAT(OCIO::ScanlineImageDesc(&rows[0], width, 0,
+                                                      OCIO::CHANNEL_ORDERING_RGBA),
+                              OCIO::Exception, "Invalid image dimensions");
+
+        rows[height - 1] = nullptr;
+        OCIO_CHECK_THROW_WHAT(OCIO::ScanlineImageDesc(&rows[0], width, height,
+                                                      OCIO::CHANNEL_ORDERING_RGBA),
+                              OCIO::Exception, "Invalid line pointer");
+        OCIO_CHECK_THROW_WHAT(OCIO::ScanlineImageDesc(&rows[0], &rows[0], &rows[0], nullptr,
+                                                      width, height),
+                              OCIO::Exception, "Invalid line pointer");
     }
 }
 
-OCIO_ADD_TEST(CPUProcessor, scanline_helper_tile)
+OCIO_ADD_TEST(CPUProcessor, tiled_image_desc)
 {
-    // Process tiles.
+    // The unit test validates that the tiled image buffers give the same results as the
+    // contiguous ones, processed serially or tile by tile by several threads.
+
+    OCIO::ConstProcessorRcPtr processor;
+    OCIO_CHECK_NO_THROW(processor = BuildParallelTestProcessor());
 
     OCIO::ConstCPUProcessorRcPtr cpuProcessor;
-    OCIO_CHECK_NO_THROW(cpuProcessor = BuildCPUProcessor(OCIO::TRANSFORM_DIR_FORWARD));
+    OCIO_CHECK_NO_THROW(cpuProcessor = processor->getDefaultCPUProcessor());
 
-    std::vector<float> outImg(NB_PIXELS*4);
+    // Some odd dimensions to have partial tiles.
+    constexpr long width  = 301;
+    constexpr long height = 257;
 
+    std::vector<float> img(width * height * 4);
+    for(size_t idx=0; idx<img.size(); ++idx)
     {
-        // Pixels are { 1, 2, 3,
-        //              4, 5, 6  }
+        img[idx] = float(idx % 1031) / 1031.0f;
+    }
 
-        // Copy the 1st pixel which should be untouched.
-        outImg[(0 * 4) + 0] = resImg[(0 * 4) + 0];
-        outImg[(0 * 4) + 1] = resImg[(0 * 4) + 1];
-        outImg[(0 * 4) + 2] = resImg[(0 * 4) + 2];
-        outImg[(0 * 4) + 3] = resImg[(0 * 4) + 3];
-        // Copy the 4th pixel which should be untouched.
-        outImg[(3 * 4) + 0] = resImg[(3 * 4) + 0];
-        outImg[(3 * 4) + 1] = resImg[(3 * 4) + 1];
-        outImg[(3 * 4) + 2] = resImg[(3 * 4) + 2];
-        outImg[(3 * 4) + 3] = resImg[(3 * 4) + 3];
+    std::vector<float> ref(img);
+    OCIO::PackedImageDesc refDesc(&ref[0], width, height, 4);
+    OCIO_CHECK_NO_THROW(cpuProcessor->apply(refDesc));
 
-        // Only process the pixels = { 2, 3,
-        //                             5, 6  }
+    // Evenly spaced tiles with some padding between two tiles.
+    constexpr long tileWidth  = 64;
+    constexpr long tileHeight = 32;
+    constexpr long numTilesX  = (width + tileWidth - 1) / tileWidth;
+    constexpr long numTilesY  = (height + tileHeight - 1) / tileHeight;
+    constexpr long tileFloats = tileWidth * tileHeight * 4 + 16;
 
-        OCIO::PackedImageDesc srcImgDesc(&inImg[4],
-                                         2, 2, 4,   // width=2, height=2, and nchannels=4
-                                         OCIO::BIT_DEPTH_F32,
-                                         sizeof(float),
-                                         4*sizeof(float),
-                                         3*4*sizeof(float));
+    // Get the index in the tiled buffer of the pixel (x, y).
+    auto tiledIndex = [](long x, long y)
+    {
+        const long tileIdx = (y / tileHeight) * numTilesX + x / tileWidth;
+        return tileIdx * tileFloats + ((y % tileHeight) * tileWidth + x % tileWidth) * 4;
+    };
 
-        OCIO::PackedImageDesc dstImgDesc(&outImg[4],
-                                         2, 2, 4,   // width=2, height=2, and nchannels=4
-                                         OCIO::BIT_DEPTH_F32,
-                                         sizeof(float),
-                                         4*sizeof(float),
-                                         3*4*sizeof(float));
+    auto toTiles = [&img, &tiledIndex]()
+    {
+        std::vector<float> tiles(numTilesX * numTilesY * tileFloats, -1.0f);
+        for(long y=0; y<height; ++y)
+        {
+            for(long x=0; x<width; ++x)
+            {
+                for(long c=0; c<4; ++c)
+                {
+                    tiles[tiledIndex(x, y) + c] = img[4 * (y * width + x) + c];
+                }
+            }
+        }
+        return tiles;
+    };
 
-        OCIO_CHECK_NO_THROW(cpuProcessor->apply(srcImgDesc, dstImgDesc));
+    // In-place processing, serial and parallel.
+    for(bool parallel : { false, true })
+    {
+        std::vector<float> tiles = toTiles();
+
+        OCIO::TiledImageDesc desc(&tiles[0], width, height, tileWidth, tileHeight,
+                                  OCIO::CHANNEL_ORDERING_RGBA, OCIO::BIT_DEPTH_F32,
+                                  OCIO::AutoStride, OCIO::AutoStride,
+                                  tileFloats * sizeof(float));
+        OCIO_CHECK_EQUAL(desc.getNumTilesX(), numTilesX);
+        OCIO_CHECK_EQUAL(desc.getNumTilesY(), numTilesY);
+        OCIO_CHECK_EQUAL(desc.getYStrideBytes(), ptrdiff_t(tileWidth * 4 * sizeof(float)));
+        OCIO_CHECK_EQUAL(desc.getTileData(1, 1), &tiles[(numTilesX + 1) * tileFloats]);
+        OCIO_CHECK_ASSERT(desc.isRGBAPacked());
+
+        if(parallel)
+        {
+            OCIO_CHECK_NO_THROW(cpuProcessor->apply(desc, OCIO::CPUExecutor()));
+        }
+        else
+        {
+            OCIO_CHECK_NO_THROW(cpuProcessor->apply(desc));
+        }
 
-        for(size_t pxl=0; pxl<NB_PIXELS; ++pxl)
+        for(long y=0; y<height; ++y)
         {
-            OCIO_CHECK_CLOSE(outImg[4*pxl+0], resImg[4*pxl+0], 1e-7f);
-            OCIO_CHECK_CLOSE(outImg[4*pxl+1], resImg[4*pxl+1], 1e-7f);
-            OCIO_CHECK_CLOSE(outImg[4*pxl+2], resImg[4*pxl+2], 1e-7f);
-            OCIO_CHECK_CLOSE(outImg[4*pxl+3], resImg[4*pxl+3], 1e-7f);
+            for(long x=0; x<width; ++x)
+            {
+                for(long c=0; c<4; ++c)
+                {
+                    OCIO_CHECK_EQUAL(tiles[tiledIndex(x, y) + c], ref[4 * (y * width + x) + c]);
+                }
+            }
         }
+
+        // The padding is untouched.
+        OCIO_CHECK_EQUAL(tiles[tileFloats - 1], -1.0f);
     }
 
+    // Small tiles from an array of tile pointers, processed from contiguous pixels and
+    // notifying the processed rows of tiles.
     {
-        // Pixels are { 1, 2, 3,
-        //              4, 5, 6  }
+        constexpr long smallSize = 16;
+        constexpr long numSmallX = (width + smallSize - 1) / smallSize;
+        constexpr long numSmallY = (height + smallSize - 1) / smallSize;
+
+        std::vector<std::vector<float>> tiles(numSmallX * numSmallY,
+                                              std::vector<float>(smallSize * smallSize * 3));
+        std::vector<void *> tilePtrs;
+        // The tiles are not in the memory order.
+        for(auto & tile : tiles)
+        {
+            tilePtrs.push_back(&tile[0]);
+        }
+        std::reverse(tilePtrs.begin(), tilePtrs.end());
 
-        // Copy the 3rd pixel which should be untouched.
-        outImg[(2 * 4) + 0] = resImg[(2 * 4) + 0];
-        outImg[(2 * 4) + 1] = resImg[(2 * 4) + 1];
-        outImg[(2 * 4) + 2] = resImg[(2 * 4) + 2];
-        outImg[(2 * 4) + 3] = resImg[(2 * 4) + 3];
-        // Copy the 6th pixel which should be untouched.
-        outImg[(5 * 4) + 0] = resImg[(5 * 4) + 0];
-        outImg[(5 * 4) + 1] = resImg[(5 * 4) + 1];
-        outImg[(5 * 4) + 2] = resImg[(5 * 4) + 2];
-        outImg[(5 * 4) + 3] = resImg[(5 * 4) + 3];
+        OCIO::TiledImageDesc dstDesc(&tilePtrs[0], width, height, smallSize, smallSize,
+                                     OCIO::CHANNEL_ORDERING_BGR, OCIO::BIT_DEPTH_F32,
+                                     OCIO::AutoStride, OCIO::AutoStride);
+        OCIO_CHECK_EQUAL(dstDesc.getTileStrideBytes(), 0);
 
-        // Only process the pixels = { 1, 2,
-        //                             4, 5 }
+        const OCIO::PackedImageDesc srcDesc(&img[0], width, height, 4);
 
-        OCIO::PackedImageDesc srcImgDesc(&inImg[0],
-                                         2, 2, 4,   // width=2, height=2, and nchannels=4
-                                         OCIO::BIT_DEPTH_F32,
-                                         sizeof(float),
-                                         4*sizeof(float),
-                                         3*4*sizeof(float));
+        long numTasks = 0;
+        OCIO::CPUExecutor executor
+            = [&numTasks](long num, const std::function<void(long)> & task)
+            {
+                numTasks = num;
+                for(long idx=0; idx<num; ++idx)
+                {
+                    task(idx);
+                }
+            };
+
+        OCIO_CHECK_NO_THROW(cpuProcessor->apply(srcDesc, dstDesc, executor));
+
+        // The small tiles are grouped so a task processes enough pixels.
+        OCIO_CHECK_GT(numTasks, 1);
+        OCIO_CHECK_ASSERT(numTasks < numSmallX * numSmallY);
+
+        std::mutex mutex;
+        std::vector<int> lines(height, 0);
+        auto bandDone = [&mutex, &lines](long yBegin, long yEnd)
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            for(long y=yBegin; y<yEnd; ++y)
+            {
+                ++lines[y];
+            }
+        };
 
-        OCIO::PackedImageDesc dstImgDesc(&outImg[0],
-                                         2, 2, 4,   // width=2, height=2, and nchannels=4
-                                         OCIO::BIT_DEPTH_F32,
-                                         sizeof(float),
-                                         4*sizeof(float),
-                                         3*4*sizeof(float));
+        std::future<void> done = cpuProcessor->applyAsync(srcDesc, dstDesc, bandDone);
+        OCIO_CHECK_NO_THROW(done.get());
 
-        Process(cpuProcessor, srcImgDesc, dstImgDesc, __LINE__);
+        for(long y=0; y<height; ++y)
+        {
+            OCIO_CHECK_EQUAL(lines[y], 1);
+
+            for(long x=0; x<width; ++x)
+            {
+                const long tileIdx = (y / smallSize) * numSmallX + x / smallSize;
+                const float * pixel = static_cast<const float *>(tilePtrs[tileIdx])
+                    + ((y % smallSize) * smallSize + x % smallSize) * 3;
+
+                const long pxl = y * width + x;
+                OCIO_CHECK_EQUAL(pixel[0], ref[4*pxl+2]);
+                OCIO_CHECK_EQUAL(pixel[1], ref[4*pxl+1]);
+                OCIO_CHECK_EQUAL(pixel[2], ref[4*pxl+0]);
+            }
+        }
     }
 
+    // Region of interest of a tiled image buffer processed to a planar image buffer.
     {
-        // Pixels are { 1, 2, 3,
-        //              4, 5, 6  }
-
-        outImg = inImg; // Use an in-place image buffer.
-
-        // Copy the 3rd pixel which should be untouched.
-        outImg[(2 * 4) + 0] = resImg[(2 * 4) + 0];
-        outImg[(2 * 4) + 1] = resImg[(2 * 4) + 1];
-        outImg[(2 * 4) + 2] = resImg[(2 * 4) + 2];
-        outImg[(2 * 4) + 3] = resImg[(2 * 4) + 3];
-        // Copy the 6th pixel which should be untouched.
-        outImg[(5 * 4) + 0] = resImg[(5 * 4) + 0];
-        outImg[(5 * 4) + 1] = resImg[(5 * 4) + 1];
-        outImg[(5 * 4) + 2] = resImg[(5 * 4) + 2];
-        outImg[(5 * 4) + 3] = resImg[(5 * 4) + 3];
-
-        // Only process the pixels = { 1, 2,
-        //                             4, 5 }
+        constexpr long roiX      = 17;
+        constexpr long roiY      = 101;
+        constexpr long roiWidth  = 203;
+        constexpr long roiHeight = 83;
+
+        std::vector<float> tiles = toTiles();
+        OCIO::TiledImageDesc srcDesc(&tiles[0], width, height, tileWidth, tileHeight,
+                                     OCIO::CHANNEL_ORDERING_RGBA, OCIO::BIT_DEPTH_F32,
+                                     OCIO::AutoStride, OCIO::AutoStride,
+                                     tileFloats * sizeof(float));
+        srcDesc.setROI(roiX, roiY, roiWidth, roiHeight);
+
+        std::vector<float> r(roiWidth * roiHeight), g(r.size()), b(r.size()), a(r.size());
+        OCIO::PlanarImageDesc dstDesc(&r[0], &g[0], &b[0], &a[0], roiWidth, roiHeight);
+        OCIO_CHECK_NO_THROW(cpuProcessor->apply(srcDesc, dstDesc, OCIO::CPUExecutor()));
+
+        for(long y=0; y<roiHeight; ++y)
+        {
+            for(long x=0; x<roiWidth; ++x)
+            {
+                const long srcPxl = (y + roiY) * width + x + roiX;
+                const long dstPxl = y * roiWidth + x;
 
-        OCIO::PackedImageDesc dstImgDesc(&outImg[0],
-                                         2, 2, 4,   // width=2, height=2, and nchannels=4
-                                         OCIO::BIT_DEPTH_F32,
-                                         sizeof(float),
-                                         4*sizeof(float),
-                                         3*4*sizeof(float));
+                OCIO_CHECK_CLOSE(r[dstPxl], ref[4*srcPxl+0], 1e-6f);
+                OCIO_CHECK_CLOSE(g[dstPxl], ref[4*srcPxl+1], 1e-6f);
+                OCIO_CHECK_CLOSE(b[dstPxl], ref[4*srcPxl+2], 1e-6f);
+                OCIO_CHECK_CLOSE(a[dstPxl], ref[4*srcPxl+3], 1e-6f);
+            }
+        }
 
-        Process(cpuProcessor, dstImgDesc, dstImgDesc, __LINE__);
+        // The source tiles are not modified.
+        OCIO_CHECK_EQUAL(tiles[tiledIndex(roiX, roiY)], img[4 * (roiY * width + roiX)]);
     }
 
+    // Invalid tiled image buffers.
+    {
+        std::vector<float> tiles = toTiles();
+
+        OCIO_CHECK_THROW_WHAT(OCIO::TiledImageDesc(&tiles[0], width, height, 0, tileHeight,
+                                                   OCIO::CHANNEL_ORDERING_RGBA),
+                              OCIO::Exception, "Invalid tile dimensions");
+        OCIO_CHECK_THROW_WHAT(OCIO::TiledImageDesc(&tiles[0], width, height,
+                                                   tileWidth, tileHeight,
+                                                   OCIO::CHANNEL_ORDERING_RGBA,
+                                                   OCIO::BIT_DEPTH_F32,
+                                                   OCIO::AutoStride, OCIO::AutoStride, 16),
+                              OCIO::Exception, "Invalid tile stride");
+
+        std::vector<void *> tilePtrs(numTilesX * numTilesY, &tiles[0]);
+        tilePtrs.back() = nullptr;
+        OCIO_CHECK_THROW_WHAT(OCIO::TiledImageDesc(&tilePtrs[0], width, height,
+                                                   tileWidth, tileHeight,
+                                                   OCIO::CHANNEL_ORDERING_RGBA,
+                                                   OCIO::BIT_DEPTH_F32,
+                                                   OCIO::AutoStride, OCIO::AutoStride),
+                              OCIO::Exception, "Invalid tile pointer");
+
+        // The tiles of the source and destination image buffers must match.
+        OCIO::TiledImageDesc srcDesc(&tiles[0], width, height, tileWidth, tileHeight,
+                                     OCIO::CHANNEL_ORDERING_RGBA);
+        std::vector<float> dst(tiles.size());
+        OCIO::TiledImageDesc dstDesc(&dst[0], width, height, tileHeight, tileWidth,
+                                     OCIO::CHANNEL_ORDERING_RGBA);
+        OCIO_CHECK_THROW_WHAT(cpuProcessor->apply(srcDesc, dstDesc), OCIO::Exception,
+                              "Tile layout mismatch");
+
+        // Only the apply methods process the tiled image buffers.
+        OCIO_CHECK_THROW_WHAT(OCIO::GenericImageDesc().init(srcDesc, OCIO::BIT_DEPTH_F32,
+                                                            nullptr),
+                              OCIO::Exception, "only supported by the CPUProcessor apply");
+    }
 }
 
+namespace
+{
 
-OCIO_ADD_TEST(CPUProcessor, custom_scanlines)
+// Restore the global CPU processing settings changed by a test, even when the test
+// throws (i.e. other tests expect the default settings).
+class CPUSettingsGuard
 {
-    // Cases testing custom xStrideBytes and yStrideBytes values.
+public:
+    CPUSettingsGuard()
+        :   m_numaAware(OCIO::IsCPUNumaAware())
+    {
+    }
 
-    const float magicNumber = 12345.6789f;
+    ~CPUSettingsGuard()
+    {
+        OCIO::SetCPUNumaAware(m_numaAware);
+        OCIO::SetCPUStreamingStoreThreshold(0);
+    }
 
-    OCIO::ConstCPUProcessorRcPtr cpuProcessor;
-    OCIO_CHECK_NO_THROW(cpuProcessor = BuildCPUProcessor(OCIO::TRANSFORM_DIR_FORWARD));
+private:
+    const bool m_numaAware;
 
-    {
-        // Pixels are { RGBA, RGBA, RGBA, x,
-        //              RGBA, RGBA, RGBA, x  } where x is not a color channel.
+    CPUSettingsGuard(const CPUSettingsGuard &) = delete;
+    CPUSettingsGuard & operator=(const CPUSettingsGuard &) = delete;
+};
 
-        std::vector<float> img
-            = { inImg[ 0], inImg[ 1], inImg[ 2], inImg[ 3],
-                inImg[ 4], inImg[ 5], inImg[ 6], inImg[ 7],
-                inImg[ 8], inImg[ 9], inImg[10], inImg[11],
-                magicNumber,
-                inImg[12], inImg[13], inImg[14], inImg[15],
-                inImg[16], inImg[17], inImg[18], inImg[19],
-                inImg[20], inImg[21], inImg[22], inImg[23],
-                magicNumber };
+}
 
-        OCIO::PackedImageDesc srcImgDesc(&img[0],
-                                         3, 2, 4,
-                                         OCIO::BIT_DEPTH_F32,
-                                         OCIO::AutoStride,
-                                         OCIO::AutoStride,
-                                         // Bytes to the next line.
-                                         3*4*sizeof(float)+sizeof(float));
+OCIO_ADD_TEST(CPUProcessor, streaming_stores)
+{
+    // The unit test validates that writing the destination image with streaming stores
+    // produces the same results.
 
-        std::vector<float> outImg(NB_PIXELS*4);
-        OCIO::PackedImageDesc dstImgDesc(&outImg[0], 3, 2, 4);
+    OCIO::ConstProcessorRcPtr processor;
+    OCIO_CHECK_NO_THROW(processor = BuildParallelTestProcessor());
 
-        OCIO_CHECK_NO_THROW(cpuProcessor->apply(srcImgDesc, dstImgDesc));
+    // Some odd dimensions to have unaligned lines.
+    constexpr long width  = 301;
+    constexpr long height = 57;
+    constexpr long numPixels = width * height;
 
-        for(size_t pxl=0; pxl<NB_PIXELS; ++pxl)
-        {
-            OCIO_CHECK_CLOSE(outImg[4*pxl+0], resImg[4*pxl+0], 1e-7f);
-            OCIO_CHECK_CLOSE(outImg[4*pxl+1], resImg[4*pxl+1], 1e-7f);
-            OCIO_CHECK_CLOSE(outImg[4*pxl+2], resImg[4*pxl+2], 1e-7f);
-            OCIO_CHECK_CLOSE(outImg[4*pxl+3], resImg[4*pxl+3], 1e-7f);
-        }
+    std::vector<float> img(numPixels * 4);
+    for(size_t idx=0; idx<img.size(); ++idx)
+    {
+        img[idx] = float(idx % 1031) / 1031.0f;
     }
 
+    const OCIO::PackedImageDesc srcDesc(&img[0], width, height, 4);
+
+    auto process = [&processor, &srcDesc](OCIO::BitDepth outBitDepth,
+                                          OCIO::ChannelOrdering chanOrder,
+                                          void * dst,
+                                          size_t threshold)
     {
-        // Pixels are { RxGxBxAx, RxGxBxAx, RxGxBxAx,
-        //              RxGxBxAx, RxGxBxAx, RxGxBxAx  } where x is not a color channel.
+        OCIO::ConstCPUProcessorRcPtr cpuProcessor
+            = processor->getOptimizedCPUProcessor(OCIO::BIT_DEPTH_F32, outBitDepth,
+                                                  OCIO::OPTIMIZATION_DEFAULT,
+                                                  OCIO::FINALIZATION_DEFAULT);
 
-        std::vector<float> img
-            = { inImg[ 0], magicNumber, inImg[ 1], magicNumber, inImg[ 2], magicNumber, inImg[ 3], magicNumber,
-                inImg[ 4], magicNumber, inImg[ 5], magicNumber, inImg[ 6], magicNumber, inImg[ 7], magicNumber,
-                inImg[ 8], magicNumber, inImg[ 9], magicNumber, inImg[10], magicNumber, inImg[11], magicNumber,
-                inImg[12], magicNumber, inImg[13], magicNumber, inImg[14], magicNumber, inImg[15], magicNumber,
-                inImg[16], magicNumber, inImg[17], magicNumber, inImg[18], magicNumber, inImg[19], magicNumber,
-                inImg[20], magicNumber, inImg[21], magicNumber, inImg[22], magicNumber, inImg[23], magicNumber };
+        const ptrdiff_t chanStrideBytes
+            = outBitDepth == OCIO::BIT_DEPTH_UINT8  ? sizeof(uint8_t)
+            : outBitDepth == OCIO::BIT_DEPTH_UINT16 ? sizeof(uint16_t) : sizeof(float);
 
-        OCIO::PackedImageDesc srcImgDesc(&img[0],  3, 2, 4,
-                                         OCIO::BIT_DEPTH_F32,
-                                         // Bytes to the next channel.
-                                         sizeof(float)+sizeof(float),
-                                         OCIO::AutoStride,
-                                         OCIO::AutoStride);
+        OCIO::PackedImageDesc dstDesc(dst, width, height, chanOrder, outBitDepth,
+                                      chanStrideBytes, OCIO::AutoStride, OCIO::AutoStride);
 
-        std::vector<float> outImg(NB_PIXELS*3);
-        OCIO::PackedImageDesc dstImgDesc(&outImg[0], 3, 2, 3);
+        CPUSettingsGuard guard;
+        OCIO::SetCPUStreamingStoreThreshold(threshold);
+        OCIO_CHECK_NO_THROW(cpuProcessor->apply(srcDesc, dstDesc));
+        OCIO_CHECK_NO_THROW(cpuProcessor->apply(srcDesc, dstDesc, OCIO::CPUExecutor()));
+    };
 
-        OCIO_CHECK_NO_THROW(cpuProcessor->apply(srcImgDesc, dstImgDesc));
+    constexpr size_t noStreaming = std::numeric_limits<size_t>::max();
 
-        for(size_t pxl=0; pxl<NB_PIXELS; ++pxl)
-        {
-            OCIO_CHECK_CLOSE(outImg[3*pxl+0], resImg[4*pxl+0], 1e-7f);
-            OCIO_CHECK_CLOSE(outImg[3*pxl+1], resImg[4*pxl+1], 1e-7f);
-            OCIO_CHECK_CLOSE(outImg[3*pxl+2], resImg[4*pxl+2], 1e-7f);
-        }
+    // Packed RGBA buffers.
+    {
+        std::vector<float> ref(numPixels * 4), res(numPixels * 4);
+        process(OCIO::BIT_DEPTH_F32, OCIO::CHANNEL_ORDERING_RGBA, &ref[0], noStreaming);
+        process(OCIO::BIT_DEPTH_F32, OCIO::CHANNEL_ORDERING_RGBA, &res[0], 1);
+        OCIO_CHECK_ASSERT(res==ref);
     }
-
     {
-        // Pixels are { RGBAx, RGBAx, RGBAx,
-        //              RGBAx, RGBAx, RGBAx  } where x is not a color channel.
-
-        std::vector<float> img
-            = { inImg[ 0], inImg[ 1], inImg[ 2], inImg[ 3], magicNumber,
-                inImg[ 4], inImg[ 5], inImg[ 6], inImg[ 7], magicNumber,
-                inImg[ 8], inImg[ 9], inImg[10], inImg[11], magicNumber,
-                inImg[12], inImg[13], inImg[14], inImg[15], magicNumber,
-                inImg[16], inImg[17], inImg[18], inImg[19], magicNumber,
-                inImg[20], inImg[21], inImg[22], inImg[23], magicNumber };
-
-        OCIO::PackedImageDesc srcImgDesc(&img[0], 3, 2, 4,
-                                         OCIO::BIT_DEPTH_F32,
-                                         OCIO::AutoStride,
-                                         // Bytes to the next pixel.
-                                         4*sizeof(float)+sizeof(float),
-                                         OCIO::AutoStride);
+        std::vector<uint16_t> ref(numPixels * 4), res(numPixels * 4);
+        process(OCIO::BIT_DEPTH_UINT16, OCIO::CHANNEL_ORDERING_RGBA, &ref[0], noStreaming);
+        process(OCIO::BIT_DEPTH_UINT16, OCIO::CHANNEL_ORDERING_RGBA, &res[0], 1);
+        OCIO_CHECK_ASSERT(res==ref);
+    }
 
-        std::vector<float> outImg(NB_PIXELS*3);
-        OCIO::PackedImageDesc dstImgDesc(&outImg[0], 3, 2, 3);
+    // Other packed buffers.
+    {
+        std::vector<uint8_t> ref(numPixels * 4), res(numPixels * 4);
+        process(OCIO::BIT_DEPTH_UINT8, OCIO::CHANNEL_ORDERING_BGRA, &ref[0], noStreaming);
+        process(OCIO::BIT_DEPTH_UINT8, OCIO::CHANNEL_ORDERING_BGRA, &res[0], 1);
+        OCIO_CHECK_ASSERT(res==ref);
+    }
+    {
+        std::vector<uint16_t> ref(numPixels * 3), res(numPixels * 3);
+        process(OCIO::BIT_DEPTH_UINT16, OCIO::CHANNEL_ORDERING_BGR, &ref[0], noStreaming);
+        process(OCIO::BIT_DEPTH_UINT16, OCIO::CHANNEL_ORDERING_BGR, &res[0], 1);
+        OCIO_CHECK_ASSERT(res==ref);
+    }
+    {
+        // Note that the untouched alpha channel is then copied instead.
+        std::vector<float> ref(numPixels * 4), res(numPixels * 4);
+        process(OCIO::BIT_DEPTH_F32, OCIO::CHANNEL_ORDERING_ABGR, &ref[0], noStreaming);
+        process(OCIO::BIT_DEPTH_F32, OCIO::CHANNEL_ORDERING_ABGR, &res[0], 1);
+        OCIO_CHECK_ASSERT(res==ref);
+    }
 
-        OCIO_CHECK_NO_THROW(cpuProcessor->apply(srcImgDesc, dstImgDesc));
+    // Unaligned and partial copies.
+    {
+        std::vector<uint8_t> in(301), out(301);
+        for(size_t idx=0; idx<in.size(); ++idx)
+        {
+            in[idx] = uint8_t(idx);
+        }
 
-        for(size_t pxl=0; pxl<NB_PIXELS; ++pxl)
+        for(size_t offset : { 0, 1, 7, 15 })
         {
-            OCIO_CHECK_CLOSE(outImg[3*pxl+0], resImg[4*pxl+0], 1e-7f);
-            OCIO_CHECK_CLOSE(outImg[3*pxl+1], resImg[4*pxl+1], 1e-7f);
-            OCIO_CHECK_CLOSE(outImg[3*pxl+2], resImg[4*pxl+2], 1e-7f);
+            for(size_t numBytes : { 0, 3, 16, 33, 280 })
+            {
+                std::fill(out.begin(), out.end(), uint8_t(0));
+
+                OCIO::StreamingCopy(&out[offset], &in[offset + 1], numBytes);
+                OCIO::StreamingFence();
+
+                for(size_t idx=0; idx<out.size(); ++idx)
+                {
+                    const bool copied = idx>=offset && idx<offset+numBytes;
+                    OCIO_CHECK_EQUAL(out[idx], copied ? in[idx + 1] : 0);
+                }
+            }
         }
     }
 
+    OCIO_CHECK_ASSERT(OCIO::GetCPUStreamingStoreThreshold()>0);
+}
+
+OCIO_ADD_TEST(CPUProcessor, apply_numa_aware)
+{
+    // The unit test validates that the NUMA-aware parallel processing (i.e. using per
+    // node replicas of the processor on machines having several NUMA nodes) produces
+    // the same results as the serial one.
+
+    OCIO::ConstProcessorRcPtr processor;
+    OCIO_CHECK_NO_THROW(processor = BuildParallelTestProcessor());
+
+    constexpr long width  = 301;
+    constexpr long height = 257;
+
+    std::vector<float> img(width * height * 4);
+    for(size_t idx=0; idx<img.size(); ++idx)
     {
-        // Pixels are { RGBAx, RGBAx, RGBAx, x
-        //              RGBAx, RGBAx, RGBAx, x  } where x is not a color channel.
+        img[idx] = float(idx % 1031) / 1031.0f;
+    }
 
-        std::vector<float> img
-            = { inImg[ 0], inImg[ 1], inImg[ 2], inImg[ 3], magicNumber,
-                inImg[ 4], inImg[ 5], inImg[ 6], inImg[ 7], magicNumber,
-                inImg[ 8], inImg[ 9], inImg[10], inImg[11], magicNumber,
-                magicNumber,
-                inImg[12], inImg[13], inImg[14], inImg[15], magicNumber,
-                inImg[16], inImg[17], inImg[18], inImg[19], magicNumber,
-                inImg[20], inImg[21], inImg[22], inImg[23], magicNumber,
-                magicNumber };
+    std::vector<uint16_t> img16(img.size());
+    for(size_t idx=0; idx<img.size(); ++idx)
+    {
+        img16[idx] = uint16_t(img[idx] * 65535.0f);
+    }
 
-        OCIO::PackedImageDesc srcImgDesc(&img[0],
-                                         3, 2, 4,
-                                         OCIO::BIT_DEPTH_F32,
-                                         OCIO::AutoStride,
-                                         // Bytes to the next pixel.
-                                         4*sizeof(float)+sizeof(float),
-                                         // Bytes to the next line.
-                                         3*(4*sizeof(float)+sizeof(float))+sizeof(float));
+    CPUSettingsGuard guard;
+    OCIO::SetCPUNumaAware(true);
 
-        std::vector<float> outImg(NB_PIXELS*3);
-        OCIO::PackedImageDesc dstImgDesc(&outImg[0], 3, 2, 3);
+    // The 32-bit float processing.
+    {
+        OCIO::ConstCPUProcessorRcPtr cpuProcessor;
+        OCIO_CHECK_NO_THROW(cpuProcessor = processor->getDefaultCPUProcessor());
 
-        OCIO_CHECK_NO_THROW(cpuProcessor->apply(srcImgDesc, dstImgDesc));
+        std::vector<float> ref(img);
+        OCIO::PackedImageDesc refDesc(&ref[0], width, height, 4);
+        OCIO_CHECK_NO_THROW(cpuProcessor->apply(refDesc));
 
-        for(size_t pxl=0; pxl<NB_PIXELS; ++pxl)
+        // Twice to also reuse the replicas.
+        for(int iter=0; iter<2; ++iter)
         {
-            OCIO_CHECK_CLOSE(outImg[3*pxl+0], resImg[4*pxl+0], 1e-7f);
-            OCIO_CHECK_CLOSE(outImg[3*pxl+1], resImg[4*pxl+1], 1e-7f);
-            OCIO_CHECK_CLOSE(outImg[3*pxl+2], resImg[4*pxl+2], 1e-7f);
+            std::vector<float> res(img);
+            OCIO::PackedImageDesc desc(&res[0], width, height, 4);
+            OCIO_CHECK_NO_THROW(cpuProcessor->apply(desc, OCIO::CPUExecutor()));
+            OCIO_CHECK_ASSERT(res==ref);
         }
     }
 
+    // The integer lookup processing.
+    {
+        OCIO::ConstCPUProcessorRcPtr cpuProcessor;
+        OCIO_CHECK_NO_THROW(cpuProcessor
+            = processor->getOptimizedCPUProcessor(OCIO::BIT_DEPTH_UINT16, OCIO::BIT_DEPTH_F32,
+                                                  OCIO::OPTIMIZATION_DEFAULT,
+                                                  OCIO::FINALIZATION_DEFAULT));
+
+        const OCIO::PackedImageDesc srcDesc(&img16[0], width, height, 4,
+                                            OCIO::BIT_DEPTH_UINT16, sizeof(uint16_t),
+                                            OCIO::AutoStride, OCIO::AutoStride);
+
+        std::vector<float> ref(img.size());
+        OCIO::PackedImageDesc refDesc(&ref[0], width, height, 4);
+        OCIO_CHECK_NO_THROW(cpuProcessor->apply(srcDesc, refDesc));
+
+        std::vector<float> res(img.size());
+        OCIO::PackedImageDesc resDesc(&res[0], width, height, 4);
+        OCIO_CHECK_NO_THROW(cpuProcessor->apply(srcDesc, resDesc, OCIO::CPUExecutor()));
+        OCIO_CHECK_ASSERT(res==ref);
+    }
 }
 
-OCIO_ADD_TEST(CPUProcessor, one_pixel)
+OCIO_ADD_TEST(CPUProcessor, optimization_report)
 {
+    OCIO::ConfigRcPtr config = OCIO::Config::Create();
+
+    constexpr double m44[16] = { 0.9, 0.1, 0.0, 0.0,
+                                 0.2, 0.7, 0.1, 0.0,
+                                 0.0, 0.3, 0.6, 0.0,
+                                 0.0, 0.0, 0.0, 1.0 };
+
+    OCIO::MatrixTransformRcPtr matrix = OCIO::MatrixTransform::Create();
+    matrix->setMatrix(m44);
+
+    OCIO::MatrixTransformRcPtr inverse = OCIO::MatrixTransform::Create();
+    inverse->setMatrix(m44);
+    inverse->setDirection(OCIO::TRANSFORM_DIR_INVERSE);
+
+    OCIO::MatrixTransformRcPtr other = OCIO::MatrixTransform::Create();
+    other->setMatrix(m44);
+
+    OCIO::GroupTransformRcPtr group = OCIO::GroupTransform::Create();
+    group->appendTransform(matrix);
+    group->appendTransform(inverse);
+    group->appendTransform(other);
+
+    OCIO::ConstProcessorRcPtr processor;
+    OCIO_CHECK_NO_THROW(processor = config->getProcessor(group));
+
     OCIO::ConstCPUProcessorRcPtr cpuProcessor;
-    OCIO_CHECK_NO_THROW(cpuProcessor = BuildCPUProcessor(OCIO::TRANSFORM_DIR_FORWARD));
+    OCIO_CHECK_NO_THROW(cpuProcessor = processor->getDefaultCPUProcessor());
 
-    // The CPU Processor only includes a Matrix with offset:
-    //   const float offset4[4] = { 1.4002f, 0.4005f, 0.8007f, 0.5007f };
+    OCIO::ConstProcessorMetadataRcPtr metadata = cpuProcessor->getProcessorMetadata();
+    OCIO_REQUIRE_ASSERT(metadata);
 
-    {
-        float pixel[4]{ 0.1f, 0.3f, 0.9f, 1.0f };
+    OCIO_CHECK_EQUAL(metadata->getNumOriginalOps(), 3);
+    OCIO_CHECK_EQUAL(std::string(metadata->getOriginalOp(0)), "<MatrixOffsetOp>");
+    OCIO_CHECK_EQUAL(std::string(metadata->getOriginalOp(3)), "");
 
-        OCIO_CHECK_NO_THROW(cpuProcessor->applyRGBA(pixel));
+    // The matrix and its inverse are removed.
+    OCIO_REQUIRE_EQUAL(metadata->getNumOptimizationPasses(), 1);
+    OCIO_CHECK_EQUAL(std::string(metadata->getOptimizationPass(0)), "RemoveInverseOps: 1 ops");
 
-        OCIO_CHECK_EQUAL(pixel[0], 0.1f + 1.4002f);
-        OCIO_CHECK_EQUAL(pixel[1], 0.3f + 0.4005f);
-        OCIO_CHECK_EQUAL(pixel[2], 0.9f + 0.8007f);
-        OCIO_CHECK_EQUAL(pixel[3], 1.0f + 0.5007f);
-    }
+    OCIO_CHECK_EQUAL(metadata->getNumOptimizedOps(), 1);
+    OCIO_CHECK_EQUAL(std::string(metadata->getOptimizedOp(0)), "<MatrixOffsetOp>");
 
-    {
-        float pixel[3]{ 0.1f, 0.3f, 0.9f };
+    // The matrix renderer (i.e. depending on the CPU instructions) directly processes
+    // the F32 input, and a bit-depth helper produces the F32 output.
+    OCIO_REQUIRE_EQUAL(metadata->getNumRenderers(), 2);
+    const std::string renderer(metadata->getRenderer(0));
+    OCIO_CHECK_ASSERT(renderer.compare(0, 6, "Matrix") == 0);
+    OCIO_CHECK_NE(renderer.find("Renderer"), std::string::npos);
 
-        OCIO_CHECK_NO_THROW(cpuProcessor->applyRGB(pixel));
+    OCIO_CHECK_ASSERT(metadata->getOptimizationTime() >= 0.0);
+    OCIO_CHECK_ASSERT(metadata->getFinalizationTime() >= 0.0);
 
-        OCIO_CHECK_EQUAL(pixel[0], 0.1f + 1.4002f);
-        OCIO_CHECK_EQUAL(pixel[1], 0.3f + 0.4005f);
-        OCIO_CHECK_EQUAL(pixel[2], 0.9f + 0.8007f);
-    }
+    // The processor metadata does not report any optimization.
+    OCIO_CHECK_EQUAL(processor->getProcessorMetadata()->getNumOriginalOps(), 0);
+    OCIO_CHECK_EQUAL(processor->getProcessorMetadata()->getNumRenderers(), 0);
 }
 
-namespace
-{
-
-template<OCIO::BitDepth inBD, OCIO::BitDepth outBD>
-void ComputeImage(unsigned width, unsigned height, unsigned nChannels,
-                   const void * inBuf, void * outBuf,
-                   unsigned line)
+OCIO_ADD_TEST(CPUProcessor, no_op_bypass)
 {
-    typedef typename OCIO::BitDepthInfo<inBD>::Type InType;
-    typedef typename OCIO::BitDepthInfo<outBD>::Type OutType;
+    // The identity processors only copy, or convert, the pixels and nothing is done
+    // in place.
 
     OCIO::ConfigRcPtr config = OCIO::Config::Create();
 
-    OCIO::MatrixTransformRcPtr transform = OCIO::MatrixTransform::Create();
-    constexpr double offset4[4] = { 1.2002, 0.4005, 0.8007, 0.5 };
-    transform->setOffset( offset4 );
-
     OCIO::ConstProcessorRcPtr processor;
-    OCIO_CHECK_NO_THROW(processor = config->getProcessor(transform));
+    OCIO_CHECK_NO_THROW(processor = config->getProcessor(OCIO::MatrixTransform::Create()));
 
-    OCIO::ConstCPUProcessorRcPtr cpuProcessor;
-    OCIO_CHECK_NO_THROW(cpuProcessor
-        = processor->getOptimizedCPUProcessor(inBD, outBD,
-                                              OCIO::OPTIMIZATION_DEFAULT,
-                                              OCIO::FINALIZATION_DEFAULT));
+    const float inf = std::numeric_limits<float>::infinity();
+    const float qnan = std::numeric_limits<float>::quiet_NaN();
 
-    const OCIO::PackedImageDesc srcImgDesc((void *)inBuf,
-                                           width, height, nChannels,
-                                           inBD,
-                                           sizeof(InType),
-                                           OCIO::AutoStride,
-                                           OCIO::AutoStride);
+    constexpr long width  = 5;
+    constexpr long height = 3;
+    std::vector<float> img(4 * width * height);
+    for(size_t idx=0; idx<img.size(); ++idx)
+    {
+        img[idx] = float(idx) * 0.07f - 0.5f;
+    }
+    img[0] = inf;
+    img[1] = qnan;
+    img[6] = -inf;
 
-    OCIO::PackedImageDesc dstImgDesc(outBuf,
-                                     width, height, nChannels,
-                                     outBD,
-                                     sizeof(OutType),
-                                     OCIO::AutoStride,
-                                     OCIO::AutoStride);
+    OCIO::ConstCPUProcessorRcPtr cpuProcessor;
+    OCIO_CHECK_NO_THROW(cpuProcessor = processor->getDefaultCPUProcessor());
 
-    OCIO_CHECK_NO_THROW(cpuProcessor->apply(srcImgDesc, dstImgDesc));
+    {
+        std::vector<float> res(img);
+        OCIO::PackedImageDesc desc(&res[0], width, height, 4);
+        OCIO_CHECK_NO_THROW(cpuProcessor->apply(desc));
+        OCIO_CHECK_ASSERT(memcmp(&res[0], &img[0], img.size() * sizeof(float)) == 0);
+
+        OCIO_CHECK_NO_THROW(cpuProcessor->applyRGBA(&res[0], width * height, OCIO::AutoStride));
+        OCIO_CHECK_ASSERT(memcmp(&res[0], &img[0], img.size() * sizeof(float)) == 0);
+    }
 
+    {
+        const OCIO::PackedImageDesc srcDesc(&img[0], width, height, 4);
 
-    const InType * inValues  = (const InType *)inBuf;
-    OutType * outValues = (OutType *)outBuf;
+        std::vector<float> res(img.size(), -1.0f);
+        OCIO::PackedImageDesc dstDesc(&res[0], width, height, 4);
+        OCIO_CHECK_NO_THROW(cpuProcessor->apply(srcDesc, dstDesc));
+        OCIO_CHECK_ASSERT(memcmp(&res[0], &img[0], img.size() * sizeof(float)) == 0);
+    }
 
-    const float inScale = float(GetBitDepthMaxValue(OCIO::BIT_DEPTH_F32)
-                                    / GetBitDepthMaxValue(inBD));
+    {
+        // The planes of the image i.e. only a buffer layout change.
+        const long numPixels = width * height;
+        const OCIO::PlanarImageDesc srcDesc(&img[0], &img[numPixels],
+                                            &img[2 * numPixels], &img[3 * numPixels],
+                                            width, height);
+
+        std::vector<float> res(img.size(), -1.0f);
+        OCIO::PlanarImageDesc dstDesc(&res[0], &res[numPixels],
+                                      &res[2 * numPixels], &res[3 * numPixels],
+                                      width, height);
+        OCIO_CHECK_NO_THROW(cpuProcessor->apply(srcDesc, dstDesc));
+        OCIO_CHECK_ASSERT(memcmp(&res[0], &img[0], img.size() * sizeof(float)) == 0);
+    }
 
-    const float outScale = float( GetBitDepthMaxValue(outBD)
-                                    / GetBitDepthMaxValue(OCIO::BIT_DEPTH_F32));
+    // A bit-depth change is a single conversion, and a different channel ordering uses
+    // the regular processing.
 
-    for(size_t idx=0; idx<(width*height);)
+    std::vector<uint8_t> codes(4 * width * height);
+    for(size_t idx=0; idx<codes.size(); ++idx)
     {
-        // Manual computation of the results.
+        codes[idx] = uint8_t(idx * 17);
+    }
 
-        const float pxl[4]{ (float(inValues[idx+0]) * inScale + (float)offset4[0]) * outScale,
-                            (float(inValues[idx+1]) * inScale + (float)offset4[1]) * outScale,
-                            (float(inValues[idx+2]) * inScale + (float)offset4[2]) * outScale,
-                            nChannels==4 
-                                ? ((float(inValues[idx+3]) * inScale + (float)offset4[3]) * outScale) 
-                                : 0.0f 
-                          };
+    OCIO_CHECK_NO_THROW(cpuProcessor
+        = processor->getOptimizedCPUProcessor(OCIO::BIT_DEPTH_UINT8, OCIO::BIT_DEPTH_F32,
+                                              OCIO::OPTIMIZATION_DEFAULT,
+                                              OCIO::FINALIZATION_DEFAULT));
 
-        // Validate all the results.
+    {
+        const OCIO::PackedImageDesc srcDesc(&codes[0], width, height, 4, OCIO::BIT_DEPTH_UINT8,
+                                            sizeof(uint8_t), OCIO::AutoStride,
+                                            OCIO::AutoStride);
 
-        if(OCIO::BitDepthInfo<outBD>::isFloat)
+        std::vector<float> res(codes.size(), -1.0f);
+        OCIO::PackedImageDesc dstDesc(&res[0], width, height, 4);
+        OCIO_CHECK_NO_THROW(cpuProcessor->apply(srcDesc, dstDesc));
+
+        for(size_t idx=0; idx<res.size(); ++idx)
         {
-            OCIO_CHECK_CLOSE_FROM(outValues[idx+0], pxl[0], 1e-6f, line);
-            OCIO_CHECK_CLOSE_FROM(outValues[idx+1], pxl[1], 1e-6f, line);
-            OCIO_CHECK_CLOSE_FROM(outValues[idx+2], pxl[2], 1e-6f, line);
-            if(nChannels==4)
-            {
-                OCIO_CHECK_CLOSE_FROM(outValues[idx+3], pxl[3], 1e-6f, line);
-            }
+            OCIO_CHECK_CLOSE(res[idx], float(codes[idx]) / 255.0f, 1e-6f);
         }
-        else
+    }
+
+    {
+        const OCIO::PackedImageDesc srcDesc(&codes[0], width, height,
+                                            OCIO::CHANNEL_ORDERING_BGRA, OCIO::BIT_DEPTH_UINT8,
+                                            sizeof(uint8_t), OCIO::AutoStride,
+                                            OCIO::AutoStride);
+
+        std::vector<float> res(codes.size(), -1.0f);
+        OCIO::PackedImageDesc dstDesc(&res[0], width, height, 4);
+        OCIO_CHECK_NO_THROW(cpuProcessor->apply(srcDesc, dstDesc));
+
+        for(long idx=0; idx<width * height; ++idx)
         {
-            OCIO_CHECK_EQUAL_FROM(outValues[idx+0], OCIO::Converter<outBD>::CastValue(pxl[0]), line);
-            OCIO_CHECK_EQUAL_FROM(outValues[idx+1], OCIO::Converter<outBD>::CastValue(pxl[1]), line);
-            OCIO_CHECK_EQUAL_FROM(outValues[idx+2], OCIO::Converter<outBD>::CastValue(pxl[2]), line);
-            if(nChannels==4)
-            {
-                OCIO_CHECK_EQUAL_FROM(outValues[idx+3], OCIO::Converter<outBD>::CastValue(pxl[3]), line);
-            }
+            OCIO_CHECK_CLOSE(res[4 * idx + 0], float(codes[4 * idx + 2]) / 255.0f, 1e-6f);
+            OCIO_CHECK_CLOSE(res[4 * idx + 1], float(codes[4 * idx + 1]) / 255.0f, 1e-6f);
+            OCIO_CHECK_CLOSE(res[4 * idx + 2], float(codes[4 * idx + 0]) / 255.0f, 1e-6f);
+            OCIO_CHECK_CLOSE(res[4 * idx + 3], float(codes[4 * idx + 3]) / 255.0f, 1e-6f);
         }
-
-        idx += nChannels;
     }
 }
 
-}; //anon
-
-OCIO_ADD_TEST(CPUProcessor, optimizations)
+OCIO_ADD_TEST(CPUProcessor, batch_apply)
 {
-    // The unit test validates some 'optimization' paths now implemented
-    // by the ScanlineHelper class. To fully validate these paths a 'normal' image
-    // must be used (i.e. 'few pixels' image is not enough).
+    // A small block size so the blocks span several images, and the largest image is
+    // processed on its own.
+    OCIO::SetCPUBlockSize(64);
 
-    constexpr const unsigned width     = 640;
-    constexpr const unsigned height    = 480;
-    constexpr const unsigned nChannels = 4;
+    OCIO::ConstProcessorRcPtr processor = BuildParallelTestProcessor();
 
-    // Input and Output are not packed RGBA i.e no optimizations.
+    OCIO::ConstCPUProcessorRcPtr cpuProcessor;
+    OCIO_CHECK_NO_THROW(cpuProcessor = processor->getDefaultCPUProcessor());
+
+    const long widths[]  = { 3, 7, 1, 5, 20, 9 };
+    const long heights[] = { 2, 5, 1, 4, 10, 3 };
+    constexpr size_t numImages = 6;
+
+    std::vector<std::vector<float>> srcBufs(numImages), dstBufs(numImages), refBufs(numImages);
+    std::vector<std::unique_ptr<OCIO::PackedImageDesc>> srcDescs(numImages), dstDescs(numImages);
+
+    for(size_t i = 0; i<numImages; ++i)
     {
-        std::vector<uint16_t> inBuf(width*height*3);
-        for(size_t idx=0; idx<inBuf.size(); ++idx)
+        // The image 2 is RGB and the image 3 is BGRA.
+        const long numChannels = i==2 ? 3 : 4;
+        const OCIO::ChannelOrdering ordering
+            = i==2 ? OCIO::CHANNEL_ORDERING_RGB
+                   : (i==3 ? OCIO::CHANNEL_ORDERING_BGRA : OCIO::CHANNEL_ORDERING_RGBA);
+
+        srcBufs[i].resize(numChannels * widths[i] * heights[i]);
+        for(size_t idx = 0; idx<srcBufs[i].size(); ++idx)
         {
-            inBuf[idx] = uint16_t(idx % OCIO::BitDepthInfo<OCIO::BIT_DEPTH_UINT16>::maxValue);
+            srcBufs[i][idx] = float((idx * 7 + i * 13) % 101) / 100.0f;
         }
 
-        std::vector<uint16_t> outBuf(width*height*3);
+        refBufs[i].resize(srcBufs[i].size(), -1.0f);
+        OCIO::PackedImageDesc srcDesc(&srcBufs[i][0], widths[i], heights[i],
+                                      ordering, OCIO::BIT_DEPTH_F32,
+                                      OCIO::AutoStride, OCIO::AutoStride, OCIO::AutoStride);
+        OCIO::PackedImageDesc refDesc(&refBufs[i][0], widths[i], heights[i],
+                                      ordering, OCIO::BIT_DEPTH_F32,
+                                      OCIO::AutoStride, OCIO::AutoStride, OCIO::AutoStride);
+        OCIO_CHECK_NO_THROW(cpuProcessor->apply(srcDesc, refDesc));
+
+        srcDescs[i].reset(new OCIO::PackedImageDesc(&srcBufs[i][0], widths[i], heights[i],
+                                                    ordering, OCIO::BIT_DEPTH_F32,
+                                                    OCIO::AutoStride, OCIO::AutoStride,
+                                                    OCIO::AutoStride));
+
+        if(i==1 || i==4)
+        {
+            // Processed in place.
+            dstBufs[i] = srcBufs[i];
+            dstDescs[i].reset(new OCIO::PackedImageDesc(&dstBufs[i][0], widths[i], heights[i],
+                                                        ordering, OCIO::BIT_DEPTH_F32,
+                                                        OCIO::AutoStride, OCIO::AutoStride,
+                                                        OCIO::AutoStride));
+        }
+        else
+        {
+            dstBufs[i].resize(srcBufs[i].size(), -1.0f);
+            dstDescs[i].reset(new OCIO::PackedImageDesc(&dstBufs[i][0], widths[i], heights[i],
+                                                        ordering, OCIO::BIT_DEPTH_F32,
+                                                        OCIO::AutoStride, OCIO::AutoStride,
+                                                        OCIO::AutoStride));
+        }
+    }
 
-        ComputeImage<OCIO::BIT_DEPTH_UINT16, OCIO::BIT_DEPTH_UINT16>(width, height, 3,
-                                                                     &inBuf[0], &outBuf[0],
-                                                                     __LINE__);
+    const OCIO::ImageDesc * srcs[numImages];
+    OCIO::ImageDesc * dsts[numImages];
+    for(size_t i = 0; i<numImages; ++i)
+    {
+        srcs[i] = (i==1 || i==4) ? dstDescs[i].get() : srcDescs[i].get();
+        dsts[i] = dstDescs[i].get();
     }
 
-    // Input and Output are packed RGBA but not F32.
+    OCIO_CHECK_NO_THROW(cpuProcessor->apply(srcs, dsts, numImages));
+    for(size_t i = 0; i<numImages; ++i)
     {
-        std::vector<uint16_t> inBuf(width*height*nChannels);
-        for(size_t idx=0; idx<inBuf.size(); ++idx)
+        for(size_t idx = 0; idx<refBufs[i].size(); ++idx)
         {
-            inBuf[idx] = uint16_t(idx % OCIO::BitDepthInfo<OCIO::BIT_DEPTH_UINT16>::maxValue);
+            OCIO_CHECK_CLOSE(dstBufs[i][idx], refBufs[i][idx], 1e-6f);
         }
-
-        std::vector<uint16_t> outBuf(width*height*nChannels);
-
-        ComputeImage<OCIO::BIT_DEPTH_UINT16, OCIO::BIT_DEPTH_UINT16>(width, height, nChannels,
-                                                                     &inBuf[0], &outBuf[0],
-                                                                     __LINE__);
     }
 
-    // Input is packed RGBA but not F32, and output is packed RGBA F32.
+    // The same with several threads.
+    for(size_t i = 0; i<numImages; ++i)
     {
-        std::vector<uint16_t> inBuf(width*height*nChannels);
-        for(size_t idx=0; idx<inBuf.size(); ++idx)
+        if(i==1 || i==4)
         {
-            inBuf[idx] = uint16_t(idx % OCIO::BitDepthInfo<OCIO::BIT_DEPTH_UINT16>::maxValue);
+            dstBufs[i] = srcBufs[i];
+        }
+        else
+        {
+            std::fill(dstBufs[i].begin(), dstBufs[i].end(), -1.0f);
         }
-
-        std::vector<float> outBuf(width*height*nChannels);
-
-        ComputeImage<OCIO::BIT_DEPTH_UINT16, OCIO::BIT_DEPTH_F32>(width, height, nChannels,
-                                                                  &inBuf[0], &outBuf[0],
-                                                                  __LINE__);
     }
 
-    // Input is packed RGBA F32, and output is packed RGBA but not F32.
+    OCIO_CHECK_NO_THROW(cpuProcessor->apply(srcs, dsts, numImages, OCIO::CPUExecutor()));
+    for(size_t i = 0; i<numImages; ++i)
     {
-        std::vector<float> inBuf(width*height*nChannels);
-        for(size_t idx=0; idx<inBuf.size(); ++idx)
+        for(size_t idx = 0; idx<refBufs[i].size(); ++idx)
         {
-            inBuf[idx] = float(idx) / float(inBuf.size());
+            OCIO_CHECK_CLOSE(dstBufs[i][idx], refBufs[i][idx], 1e-6f);
         }
+    }
 
-        std::vector<uint16_t> outBuf(width*height*nChannels);
+    // Some faulty batches.
 
-        ComputeImage<OCIO::BIT_DEPTH_F32, OCIO::BIT_DEPTH_UINT16>(width, height, nChannels,
-                                                                  &inBuf[0], &outBuf[0],
-                                                                  __LINE__);
+    OCIO_CHECK_NO_THROW(cpuProcessor->apply(srcs, dsts, 0));
+
+    dsts[2] = nullptr;
+    OCIO_CHECK_THROW_WHAT(cpuProcessor->apply(srcs, dsts, numImages), OCIO::Exception,
+                          "Invalid image buffer descriptions");
+
+    dsts[2] = dstDescs[3].get();
+    OCIO_CHECK_THROW_WHAT(cpuProcessor->apply(srcs, dsts, numImages), OCIO::Exception,
+                          "Dimension inconsistency between source and destination");
+
+    OCIO::SetCPUBlockSize(0);
+}
+
+OCIO_ADD_TEST(CPUProcessor, cancellation)
+{
+    OCIO::ConstProcessorRcPtr processor = BuildParallelTestProcessor();
+
+    OCIO::ConstCPUProcessorRcPtr cpuProcessor;
+    OCIO_CHECK_NO_THROW(cpuProcessor = processor->getDefaultCPUProcessor());
+
+    constexpr long width  = 256;
+    constexpr long height = 512;
+
+    std::vector<float> src(4 * width * height);
+    for(size_t idx=0; idx<src.size(); ++idx)
+    {
+        src[idx] = float(idx % 1021) / 1020.0f;
     }
 
-    // Input and output are both packed RGBA F32.
+    std::vector<float> ref(src.size());
     {
-        std::vector<float> inBuf(width*height*nChannels);
-        for(size_t idx=0; idx<inBuf.size(); ++idx)
+        const OCIO::PackedImageDesc srcDesc(&src[0], width, height, 4);
+        OCIO::PackedImageDesc refDesc(&ref[0], width, height, 4);
+        OCIO_CHECK_NO_THROW(cpuProcessor->apply(srcDesc, refDesc));
+    }
+
+    const OCIO::PackedImageDesc srcDesc(&src[0], width, height, 4);
+
+    std::vector<float> dst(src.size(), -1.0f);
+    OCIO::PackedImageDesc dstDesc(&dst[0], width, height, 4);
+
+    OCIO::CPUCancellationToken token;
+    token.setPriority(OCIO::CPU_PRIORITY_LOW);
+
+    // A token which is not cancelled does not change the processing.
+    OCIO_CHECK_NO_THROW(cpuProcessor->apply(srcDesc, dstDesc, OCIO::CPUExecutor(), token));
+    OCIO_CHECK_ASSERT(memcmp(&dst[0], &ref[0], ref.size() * sizeof(float)) == 0);
+
+    std::fill(dst.begin(), dst.end(), -1.0f);
+    std::future<void> done;
+    OCIO_CHECK_NO_THROW(done = cpuProcessor->applyAsync(srcDesc, dstDesc, token));
+    OCIO_CHECK_NO_THROW(done.get());
+    OCIO_CHECK_ASSERT(memcmp(&dst[0], &ref[0], ref.size() * sizeof(float)) == 0);
+
+    // The processing of a client executor stops at the next band once the token is
+    // cancelled.
+    long numProcessedBands = 0;
+    const OCIO::CPUExecutor sequential
+        = [&numProcessedBands, &token](long numTasks, const std::function<void(long)> & task)
+    {
+        for(long idx=0; idx<numTasks; ++idx)
         {
-            inBuf[idx] = float(idx) / float(inBuf.size());
+            task(idx);
+            ++numProcessedBands;
+            token.cancel();
         }
+    };
 
-        std::vector<float> outBuf(width*height*nChannels);
+    OCIO_CHECK_THROW_WHAT(cpuProcessor->apply(srcDesc, dstDesc, sequential, token),
+                          OCIO::ExceptionCancelled,
+                          "The processing was cancelled");
+    OCIO_CHECK_EQUAL(numProcessedBands, 1);
 
-        ComputeImage<OCIO::BIT_DEPTH_F32, OCIO::BIT_DEPTH_F32>(width, height, nChannels,
-                                                               &inBuf[0], &outBuf[0],
-                                                               __LINE__);
-    }
+    // The internal thread pool and the asynchronous processing skip all the bands.
+    OCIO_CHECK_THROW_WHAT(cpuProcessor->apply(srcDesc, dstDesc, OCIO::CPUExecutor(), token),
+                          OCIO::ExceptionCancelled,
+                          "The processing was cancelled");
+
+    std::fill(dst.begin(), dst.end(), -1.0f);
+    OCIO_CHECK_NO_THROW(done = cpuProcessor->applyAsync(srcDesc, dstDesc, token));
+    OCIO_CHECK_THROW_WHAT(done.get(), OCIO::ExceptionCancelled, "The processing was cancelled");
+    OCIO_CHECK_EQUAL(dst[0], -1.0f);
+
+    // The token is only used by the calls having it.
+    OCIO_CHECK_NO_THROW(cpuProcessor->apply(srcDesc, dstDesc, OCIO::CPUExecutor()));
+    OCIO_CHECK_ASSERT(memcmp(&dst[0], &ref[0], ref.size() * sizeof(float)) == 0);
+
+    // A cancelled finalization is not memoized.
+
+    OCIO::ConfigRcPtr config = OCIO::Config::Create();
+
+    OCIO::ExponentTransformRcPtr exponent = OCIO::ExponentTransform::Create();
+    constexpr double exp4[4] = { 1.8, 1.9, 2.0, 1.0 };
+    exponent->setValue(exp4);
+
+    OCIO_CHECK_NO_THROW(processor = config->getProcessor(exponent));
+
+    OCIO_CHECK_THROW_WHAT(processor->getOptimizedCPUProcessor(OCIO::BIT_DEPTH_F32,
+                                                              OCIO::BIT_DEPTH_F32,
+                                                              OCIO::OPTIMIZATION_DEFAULT,
+                                                              OCIO::FINALIZATION_DEFAULT,
+                                                              token),
+                          OCIO::ExceptionCancelled,
+                          "The processing was cancelled");
+
+    token.reset();
+    OCIO::ConstCPUProcessorRcPtr cpu1, cpu2;
+    OCIO_CHECK_NO_THROW(cpu1 = processor->getOptimizedCPUProcessor(OCIO::BIT_DEPTH_F32,
+                                                                   OCIO::BIT_DEPTH_F32,
+                                                                   OCIO::OPTIMIZATION_DEFAULT,
+                                                                   OCIO::FINALIZATION_DEFAULT,
+                                                                   token));
+    OCIO_CHECK_NO_THROW(cpu2 = processor->getDefaultCPUProcessor());
+    OCIO_CHECK_EQUAL(cpu1.get(), cpu2.get());
 }
 
 #endif // OCIO_UNIT_TEST
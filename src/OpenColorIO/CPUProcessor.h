@@ -6,16 +6,40 @@
 #define INCLUDED_OCIO_CPUPROCESSOR_H
 
 
+#include <atomic>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
 #include <OpenColorIO/OpenColorIO.h>
 
+#include "IntegerLookupCPU.h"
 #include "Op.h"
 
 
 OCIO_NAMESPACE_ENTER
 {
 
+class CPUProfiler;
 class ScanlineHelper;
 
+// Create the CPU Op converting the pixels from one bit-depth to another (e.g. the input
+// and output conversions of the processing in 32-bit float).
+ConstOpCPURcPtr CreateGenericBitDepthHelper(BitDepth in, BitDepth out);
+
+// Get the class name of the CPU Op (e.g. Lut3DTetrahedralRenderer) without its namespaces.
+std::string GetRendererName(const OpCPU & op);
+
+// The numbers of pixels processed, and evaluated by the CPU Ops, by the image apply calls
+// of a processor evaluating once the repeated pixels (refer to OPTIMIZATION_REPEATED_PIXELS).
+struct RepeatedPixelsStats
+{
+    std::atomic<long long> m_numPixels{0};
+    std::atomic<long long> m_numEvaluatedPixels{0};
+};
+
 class CPUProcessor::Impl
 {
 public:
@@ -23,7 +47,7 @@ public:
     Impl(const Impl &) = delete;
     Impl& operator=(const Impl &) = delete;
 
-    ~Impl() = default;
+    ~Impl();
 
     bool hasChannelCrosstalk() const noexcept { return m_hasChannelCrosstalk; }
 
@@ -34,33 +58,230 @@ public:
 
     DynamicPropertyRcPtr getDynamicProperty(DynamicPropertyType type) const;
 
+    ConstProcessorMetadataRcPtr getProcessorMetadata() const noexcept { return m_metadata; }
+
     void apply(ImageDesc & imgDesc) const;
     void apply(const ImageDesc & srcImgDesc, ImageDesc & dstImgDesc) const;
 
+    // Note that the overrides (if not null) are used by all the bands.
+    void apply(ImageDesc & imgDesc, const CPUExecutor & executor,
+               const CPUBandCallback & bandDone = CPUBandCallback(),
+               const DynamicPropertyOverrides * overrides = nullptr) const;
+    void apply(const ImageDesc & srcImgDesc, ImageDesc & dstImgDesc,
+               const CPUExecutor & executor,
+               const CPUBandCallback & bandDone = CPUBandCallback(),
+               const DynamicPropertyOverrides * overrides = nullptr) const;
+
+    // Throw if a value overrides a property which is not dynamic in the processor.
+    void validateOverrides(const DynamicPropertyOverrides & overrides) const;
+
+    std::future<void> applyAsync(ImageDesc & imgDesc, const CPUBandCallback & bandDone) const;
+    std::future<void> applyAsync(const ImageDesc & srcImgDesc, ImageDesc & dstImgDesc,
+                                 const CPUBandCallback & bandDone) const;
+    // The processing thread uses the cancellation token (refer to CancellationGuard).
+    std::future<void> applyAsync(ImageDesc & imgDesc, const CPUCancellationToken & token,
+                                 const CPUBandCallback & bandDone) const;
+    std::future<void> applyAsync(const ImageDesc & srcImgDesc, ImageDesc & dstImgDesc,
+                                 const CPUCancellationToken & token,
+                                 const CPUBandCallback & bandDone) const;
+
+    // Process a batch of images, using several threads when the executor is not null.
+    void apply(const ImageDesc * const * srcImgDescs, ImageDesc * const * dstImgDescs,
+               size_t numImages, const CPUExecutor * executor) const;
+
     // Note that the method only accepts one packed RGB and 32-bit float pixel.
     void applyRGB(float * pixel) const;
     // Note that the method only accepts one packed RGBA and 32-bit float pixel.
     void applyRGBA(float * pixel) const;
 
+    // Note that the methods only accept RGB or RGBA 32-bit float pixels.
+    void applyRGB(float * pixels, long numPixels, ptrdiff_t strideBytes) const;
+    void applyRGBA(float * pixels, long numPixels, ptrdiff_t strideBytes) const;
+
+    // Note that the method only accepts packed RGBA 32-bit float pixels.
+    void profileRenderers(float * pixels, long numPixels, double * times) const;
+
+    void setProfilingEnabled(bool enabled) const;
+    bool isProfilingEnabled() const;
+    void getProfilingStats(double * times, long long * numPixels) const;
+    void resetProfilingStats() const;
+
+    void getRepeatedPixelsStats(long long & numPixels, long long & numEvaluatedPixels) const;
+    void resetRepeatedPixelsStats() const;
+
+    size_t getMemoryFootprint() const;
+
+    void writeSourceCode(const char * functionName, std::ostream & os) const;
+
     ////////////////////////////////////////////
     //
     // Functions not exposed to the OCIO public API.
         
+    // Note that a render-only processor releases the finalized ops once the CPU Ops are
+    // created, and only keeps the files, looks & renderers of the processor metadata.
     void finalize(const OpRcPtrVec & rawOps,
                   BitDepth in, BitDepth out,
-                  OptimizationFlags oFlags, FinalizationFlags fFlags);
+                  OptimizationFlags oFlags, FinalizationFlags fFlags,
+                  bool renderOnly = false,
+                  LutInterpolationQuality interpQuality = LUT_INTERPOLATION_FULL);
+
+    bool isRenderOnly() const noexcept { return m_renderOnly; }
+
+    // Process the lines [yBegin, yEnd[ using the replica of the calling thread (e.g. the
+    // lines of a processor group, refer to CPUProcessorGroup).
+    void applyLines(const ImageDesc & srcImgDesc, ImageDesc & dstImgDesc,
+                    long yBegin, long yEnd) const
+    {
+        getNumaReplica().applyBand(srcImgDesc, dstImgDesc, yBegin, yEnd);
+    }
 
 private:
+    // Get a pooled ScanlineHelper & give it back once the processing completes.
+    class ScanlineHelperGuard;
+
+    // Create the CPU Ops (and the integer lookup, if requested) from m_ops.
+    void createEngine(bool useIntegerLookup);
+
+    // The CPU Ops where the bit-depth ops are only conversions, so the scanline helper
+    // could process the 32-bit float values before and after all the ops i.e. to
+    // (un)premultiply the color values (refer to ImageDesc::setPremultiplied()) or
+    // to dither the output ones (refer to ImageDesc::setDither()).
+    struct CastEngine
+    {
+        ConstOpCPURcPtr    m_inBitDepthOp;
+        ConstOpCPURcPtrVec m_cpuOps;
+        ConstOpCPURcPtr    m_outBitDepthOp;
+    };
+    typedef std::shared_ptr<const CastEngine> ConstCastEngineRcPtr;
+
+    // Get the engine of the premultiplied or dithered image buffers, created on first use.
+    ConstCastEngineRcPtr getCastEngine() const;
+
+    // Get the number of bytes of the tables created by createEngine().
+    size_t getEngineMemorySize() const;
+
+    // Get the replica of the processor for the NUMA node running the calling thread
+    // (refer to SetCPUNumaAware()), or the processor itself.
+    const Impl & getNumaReplica() const;
+
+    // Process the lines [yBegin, yEnd[ (i.e. in place if both images are the same).
+    void applyBand(const ImageDesc & srcImgDesc, ImageDesc & dstImgDesc,
+                   long yBegin, long yEnd) const;
+
+    // The processing of applyBand() where the timer either times each renderer (when
+    // profiling) or does nothing (so the processing is not instrumented at all).
+    template<typename Timer>
+    void applyBand(const ImageDesc & srcImgDesc, ImageDesc & dstImgDesc,
+                   long yBegin, long yEnd, Timer & timer) const;
+
+    // Process the image buffers tile by tile (refer to TiledImageDesc), using several threads
+    // when the executor is not null. Each row of tiles is reported to the band callback once
+    // all its tiles are processed.
+    void applyTiles(const TiledImageDesc & tiledImg,
+                    const ImageDesc & srcImgDesc, ImageDesc & dstImgDesc,
+                    const CPUExecutor * executor,
+                    const CPUBandCallback & bandDone,
+                    const DynamicPropertyOverrides * overrides) const;
+
+    // Process the images at the indices in blocks of pixels spanning several images
+    // (refer to canBatch()).
+    void applyBatchBlocks(const ImageDesc * const * srcImgDescs,
+                          ImageDesc * const * dstImgDescs,
+                          const size_t * indices, size_t numIndices) const;
+
+    // Could the image be processed with the ones of a batch, in the same blocks of pixels
+    // i.e. it only needs the packing & unpacking of the pixels?
+    bool canBatch(const ImageDesc & srcImgDesc, const ImageDesc & dstImgDesc) const;
+
+    // Get a ScanlineHelper from the pool of reusable helpers (or create a new one).
+    std::unique_ptr<ScanlineHelper> acquireScanlineHelper() const;
+    // Return the ScanlineHelper to the pool so another apply call could reuse it.
+    void releaseScanlineHelper(std::unique_ptr<ScanlineHelper> && helper) const;
+
+    // Process packed RGBA F32 pixels in place.
+    void applyOps(float * rgbaBuffer, long numPixels) const;
+
+    // Process the lines [yBegin, yEnd[ of an identity processing (refer to m_isNoOp) i.e.
+    // nothing is done in place, otherwise the pixels are copied or only converted to the
+    // output bit-depth. It returns false (without processing anything) when the image
+    // buffers need the regular processing (e.g. a different channel ordering).
+    template<typename Timer>
+    bool applyBypass(const ImageDesc & srcImgDesc, const ImageDesc & dstImgDesc,
+                     long yBegin, long yEnd, Timer & timer) const;
+
+    // Process the lines [yBegin, yEnd[ directly on the planes of 32-bit float planar
+    // image buffers. It returns false (without processing anything) when the image
+    // buffers or the CPU Ops do not support the planar processing.
+    template<typename Timer>
+    bool applyPlanar(const ImageDesc & srcImgDesc, const ImageDesc & dstImgDesc,
+                     long yBegin, long yEnd, Timer & timer) const;
+
+    // Process the lines [yBegin, yEnd[ directly on 32-bit float packed RGB image buffers
+    // (i.e. without alpha). It returns false (without processing anything) when the image
+    // buffers or the CPU Ops do not support the packed RGB processing.
+    template<typename Timer>
+    bool applyRGB(const ImageDesc & srcImgDesc, const ImageDesc & dstImgDesc,
+                  long yBegin, long yEnd, Timer & timer) const;
+
     ConstOpCPURcPtr    m_inBitDepthOp; // Converts from in to F32. It could be done by the first op.
     ConstOpCPURcPtrVec m_cpuOps;       // It could be empty if the OpVec only contains a 1D LUT op
                                        // (e.g. the 1D LUT CPUOp instance would be in the m_inBitDepthOp).
     ConstOpCPURcPtr    m_outBitDepthOp;// Converts from F32 to out. It could be done by the last op.
 
+    // When not null, it replaces the complete processing (i.e. the CPU Ops are then
+    // only used to build the lookup tables).
+    ConstIntegerLookupRcPtr m_integerLookup;
+
+    // Created from m_ops by getCastEngine() (or by finalize() for a render-only
+    // processor) as most processors never see a premultiplied or dithered image buffer.
+    mutable ConstCastEngineRcPtr m_castEngine;
+    mutable std::mutex m_castEngineMutex;
+
+    // The optimized op list is empty so the processing only converts the bit-depth (the
+    // finalized ops then being an identity or a scale op, refer to applyBypass()).
+    bool               m_isNoOp = false;
+    // Directly converts from in to out when the processing is empty and the bit-depths
+    // differ.
+    ConstOpCPURcPtr    m_bypassOp;
+
+    // All the CPU Ops could process 32-bit float planes (refer to applyPlanar()).
+    bool               m_hasPlanarOps = false;
+    // All the CPU Ops could process 32-bit float packed RGB pixels (refer to applyRGB()).
+    bool               m_hasRGBOps = false;
+
+    // Each run of identical pixels is evaluated once (refer to OPTIMIZATION_REPEATED_PIXELS)
+    // so all the images are processed by the scanline helpers.
+    bool               m_repeatedPixels = false;
+    // The statistics of the repeated pixels (shared with the replicas).
+    std::shared_ptr<RepeatedPixelsStats> m_repeatedPixelsStats;
+
     BitDepth           m_inBitDepth = BIT_DEPTH_F32;
     BitDepth           m_outBitDepth = BIT_DEPTH_F32;
     bool               m_hasChannelCrosstalk = true;
+    bool               m_touchesAlpha = true;
+    // The finalized ops were released i.e. there are no NUMA replicas.
+    bool               m_renderOnly = false;
     std::string        m_cacheID;
     Mutex              m_mutex;
+
+    // The pool of ScanlineHelper instances (with their intermediate buffers) kept
+    // between apply calls to avoid any allocation when processing small images.
+    mutable std::vector<std::unique_ptr<ScanlineHelper>> m_scanlineHelpers;
+    mutable std::mutex m_scanlineHelpersMutex;
+
+    // The finalized ops (empty for a render-only processor).
+    OpRcPtrVec         m_ops;
+
+    // The files & looks used, and the optimization report.
+    ProcessorMetadataRcPtr m_metadata;
+
+    // The statistics per renderer of the instrumented apply calls (shared with the
+    // replicas).
+    std::shared_ptr<CPUProfiler> m_profiler;
+
+    // The replicas of the processor per NUMA node, created on first use.
+    mutable std::vector<std::unique_ptr<Impl>> m_numaReplicas;
+    mutable std::mutex m_numaReplicasMutex;
 };
 
 
@@ -0,0 +1,509 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the OpenColorIO Project.
+
+#include <cctype>
+#include <cmath>
+#include <iomanip>
+#include <sstream>
+
+#include <OpenColorIO/OpenColorIO.h>
+
+#include "CPUSourceCode.h"
+#include "ops/Gamma/GammaOpData.h"
+#include "ops/Lut1D/Lut1DOpData.h"
+#include "ops/Lut3D/Lut3DOpData.h"
+#include "ops/Matrix/MatrixOpData.h"
+#include "ops/Range/RangeOpData.h"
+
+
+OCIO_NAMESPACE_ENTER
+{
+
+namespace
+{
+
+// The interpolation functions of the generated code, which are the scalar versions of
+// the CPU renderers (e.g. NaNs become zero i.e. the first LUT entry).
+
+const char * LUT1D_FUNCTION =
+    "inline float Lut1D(const float * lut, int dim, int channel, float value)\n"
+    "{\n"
+    "    float idx = value * float(dim - 1);\n"
+    "    idx = idx > 0.0f ? idx : 0.0f;\n"
+    "    idx = idx < float(dim - 1) ? idx : float(dim - 1);\n"
+    "\n"
+    "    const int lIdx = int(idx);\n"
+    "    const int hIdx = lIdx + 1 < dim ? lIdx + 1 : dim - 1;\n"
+    "    const float delta = idx - float(lIdx);\n"
+    "\n"
+    "    const float l = lut[3 * lIdx + channel];\n"
+    "    return l + (lut[3 * hIdx + channel] - l) * delta;\n"
+    "}\n";
+
+const char * LUT3D_INDICES =
+    "    int lIdx[3], hIdx[3];\n"
+    "    float delta[3];\n"
+    "    for(int c=0; c<3; ++c)\n"
+    "    {\n"
+    "        float idx = rgb[c] * float(dim - 1);\n"
+    "        idx = idx > 0.0f ? idx : 0.0f;\n"
+    "        idx = idx < float(dim - 1) ? idx : float(dim - 1);\n"
+    "\n"
+    "        lIdx[c]  = int(idx);\n"
+    "        hIdx[c]  = lIdx[c] + 1 < dim ? lIdx[c] + 1 : dim - 1;\n"
+    "        delta[c] = idx - float(lIdx[c]);\n"
+    "    }\n"
+    "\n"
+    "    // The table is stored in blue-fastest order.\n"
+    "    auto entry = [lut, dim](int r, int g, int b) { return lut + 3 * ((r * dim + g) * dim + b); };\n"
+    "\n"
+    "    const float * c000 = entry(lIdx[0], lIdx[1], lIdx[2]);\n"
+    "    const float * c001 = entry(lIdx[0], lIdx[1], hIdx[2]);\n"
+    "    const float * c010 = entry(lIdx[0], hIdx[1], lIdx[2]);\n"
+    "    const float * c011 = entry(lIdx[0], hIdx[1], hIdx[2]);\n"
+    "    const float * c100 = entry(hIdx[0], lIdx[1], lIdx[2]);\n"
+    "    const float * c101 = entry(hIdx[0], lIdx[1], hIdx[2]);\n"
+    "    const float * c110 = entry(hIdx[0], hIdx[1], lIdx[2]);\n"
+    "    const float * c111 = entry(hIdx[0], hIdx[1], hIdx[2]);\n"
+    "\n"
+    "    const float fx = delta[0], fy = delta[1], fz = delta[2];\n";
+
+const char * LUT3D_TETRAHEDRAL_FUNCTION =
+    "inline void Lut3DTetrahedral(const float * lut, int dim, float * rgb)\n"
+    "{\n"
+    "%INDICES%"
+    "\n"
+    "    for(int c=0; c<3; ++c)\n"
+    "    {\n"
+    "        if(fx > fy)\n"
+    "        {\n"
+    "            if(fy > fz)\n"
+    "                rgb[c] = (1.0f - fx) * c000[c] + (fx - fy) * c100[c] + (fy - fz) * c110[c] + fz * c111[c];\n"
+    "            else if(fx > fz)\n"
+    "                rgb[c] = (1.0f - fx) * c000[c] + (fx - fz) * c100[c] + (fz - fy) * c101[c] + fy * c111[c];\n"
+    "            else\n"
+    "                rgb[c] = (1.0f - fz) * c000[c] + (fz - fx) * c001[c] + (fx - fy) * c101[c] + fy * c111[c];\n"
+    "        }\n"
+    "        else\n"
+    "        {\n"
+    "            if(fz > fy)\n"
+    "                rgb[c] = (1.0f - fz) * c000[c] + (fz - fy) * c001[c] + (fy - fx) * c011[c] + fx * c111[c];\n"
+    "            else if(fz > fx)\n"
+    "                rgb[c] = (1.0f - fy) * c000[c] + (fy - fz) * c010[c] + (fz - fx) * c011[c] + fx * c111[c];\n"
+    "            else\n"
+    "                rgb[c] = (1.0f - fy) * c000[c] + (fy - fx) * c010[c] + (fx - fz) * c110[c] + fz * c111[c];\n"
+    "        }\n"
+    "    }\n"
+    "}\n";
+
+const char * LUT3D_TRILINEAR_FUNCTION =
+    "inline void Lut3DTrilinear(const float * lut, int dim, float * rgb)\n"
+    "{\n"
+    "%INDICES%"
+    "\n"
+    "    for(int c=0; c<3; ++c)\n"
+    "    {\n"
+    "        const float b00 = c000[c] + (c001[c] - c000[c]) * fz;\n"
+    "        const float b01 = c010[c] + (c011[c] - c010[c]) * fz;\n"
+    "        const float b10 = c100[c] + (c101[c] - c100[c]) * fz;\n"
+    "        const float b11 = c110[c] + (c111[c] - c110[c]) * fz;\n"
+    "\n"
+    "        const float g0 = b00 + (b01 - b00) * fy;\n"
+    "        const float g1 = b10 + (b11 - b10) * fy;\n"
+    "\n"
+    "        rgb[c] = g0 + (g1 - g0) * fx;\n"
+    "    }\n"
+    "}\n";
+
+std::string ReplaceIndices(const char * function)
+{
+    std::string str(function);
+    const std::string key("%INDICES%");
+    str.replace(str.find(key), key.size(), LUT3D_INDICES);
+    return str;
+}
+
+// Get a float literal keeping all the bits of the value.
+std::string FloatLiteral(double value)
+{
+    std::ostringstream oss;
+    oss.imbue(std::locale::classic());
+    oss << std::scientific << std::setprecision(9) << float(value) << "f";
+    return oss.str();
+}
+
+bool IsIdentifier(const char * name)
+{
+    if(!name || !*name || std::isdigit((unsigned char)*name))
+    {
+        return false;
+    }
+    for(const char * c = name; *c; ++c)
+    {
+        if(!std::isalnum((unsigned char)*c) && *c!='_')
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+// The generated code of the ops, where the pixel being processed is 'float rgba[4]'.
+class SourceCodeBuilder
+{
+public:
+    explicit SourceCodeBuilder(const std::string & functionName)
+        :   m_functionName(functionName)
+    {
+        m_tables.imbue(std::locale::classic());
+        m_body.imbue(std::locale::classic());
+    }
+
+    void addOp(const ConstOpRcPtr & op, size_t opIndex)
+    {
+        if(op->isDynamic())
+        {
+            throw Exception("The source code of a dynamic op could not be written.");
+        }
+
+        const ConstOpDataRcPtr data = op->data();
+
+        m_body << "\n        // " << op->getInfo() << "\n";
+
+        switch(data->getType())
+        {
+            case OpData::MatrixType:
+                addMatrix(OCIO_DYNAMIC_POINTER_CAST<const MatrixOpData>(data));
+                break;
+            case OpData::RangeType:
+                addRange(OCIO_DYNAMIC_POINTER_CAST<const RangeOpData>(data));
+                break;
+            case OpData::Lut1DType:
+                addLut1D(OCIO_DYNAMIC_POINTER_CAST<const Lut1DOpData>(data), opIndex);
+                break;
+            case OpData::Lut3DType:
+                addLut3D(OCIO_DYNAMIC_POINTER_CAST<const Lut3DOpData>(data), opIndex);
+                break;
+            case OpData::GammaType:
+                addGamma(OCIO_DYNAMIC_POINTER_CAST<const GammaOpData>(data));
+                break;
+            case OpData::NoOpType:
+                break;
+
+            default:
+            {
+                std::ostringstream oss;
+                oss << "The source code of the op '" << op->getInfo()
+                    << "' could not be written.";
+                throw Exception(oss.str().c_str());
+            }
+        }
+    }
+
+    void write(const std::string & cacheID, std::ostream & os) const
+    {
+        os << "// Generated by OpenColorIO " << GetVersion() << " from the CPU processor:\n";
+        os << "//   " << cacheID << "\n";
+        os << "//\n";
+        os << "// Do not edit, regenerate the file when the processor changes.\n";
+        os << "\n";
+        if(m_needsCMath)
+        {
+            os << "#include <cmath>\n";
+            os << "\n";
+        }
+        os << "\n";
+        os << "extern const char " << m_functionName << "_cacheID[];\n";
+        os << "void " << m_functionName << "(float * rgba, long numPixels);\n";
+        os << "\n";
+        os << "const char " << m_functionName << "_cacheID[] = \"";
+        for(const char c : cacheID)
+        {
+            if(c=='"' || c=='\\') os << '\\';
+            os << c;
+        }
+        os << "\";\n";
+        os << "\n";
+        os << "namespace\n";
+        os << "{\n";
+        if(m_hasLut1D)
+        {
+            os << "\n" << LUT1D_FUNCTION;
+        }
+        if(m_hasTetrahedral)
+        {
+            os << "\n" << ReplaceIndices(LUT3D_TETRAHEDRAL_FUNCTION);
+        }
+        if(m_hasTrilinear)
+        {
+            os << "\n" << ReplaceIndices(LUT3D_TRILINEAR_FUNCTION);
+        }
+        os << m_tables.str();
+        os << "\n";
+        os << "}\n";
+        os << "\n";
+        os << "void " << m_functionName << "(float * rgba, long numPixels)\n";
+        os << "{\n";
+        os << "    for(long idx=0; idx<numPixels; ++idx, rgba += 4)\n";
+        os << "    {\n";
+        os << m_body.str();
+        os << "    }\n";
+        os << "}\n";
+    }
+
+private:
+    void addMatrix(ConstMatrixOpDataRcPtr matrix)
+    {
+        const auto & values = matrix->getArray().getValues();
+        const auto & offsets = matrix->getOffsets();
+
+        m_body << "        {\n";
+        m_body << "            const float in[4] = { rgba[0], rgba[1], rgba[2], rgba[3] };\n";
+        for(unsigned long row=0; row<4; ++row)
+        {
+            m_body << "            rgba[" << row << "] = ";
+            for(unsigned long col=0; col<4; ++col)
+            {
+                m_body << FloatLiteral(values[row * 4 + col]) << " * in[" << col << "] + ";
+            }
+            m_body << FloatLiteral(offsets[row]) << ";\n";
+        }
+        m_body << "        }\n";
+    }
+
+    void addRange(ConstRangeOpDataRcPtr range)
+    {
+        m_body << "        for(int c=0; c<3; ++c)\n";
+        m_body << "        {\n";
+        if(range->scales())
+        {
+            m_body << "            rgba[c] = rgba[c] * " << FloatLiteral(range->getScale())
+                   << " + " << FloatLiteral(range->getOffset()) << ";\n";
+        }
+        if(!range->minIsEmpty())
+        {
+            // NaNs become the lower bound.
+            const std::string bound = FloatLiteral(range->getMinOutValue());
+            m_body << "            rgba[c] = rgba[c] > " << bound << " ? rgba[c] : "
+                   << bound << ";\n";
+        }
+        if(!range->maxIsEmpty())
+        {
+            const std::string bound = FloatLiteral(range->getMaxOutValue());
+            m_body << "            rgba[c] = rgba[c] < " << bound << " ? rgba[c] : "
+                   << bound << ";\n";
+        }
+        m_body << "        }\n";
+    }
+
+    void addLut1D(ConstLut1DOpDataRcPtr lut, size_t opIndex)
+    {
+        if(lut->getDirection()!=TRANSFORM_DIR_FORWARD || lut->isInputHalfDomain()
+            || lut->getHueAdjust()!=HUE_NONE)
+        {
+            throw Exception("The source code of the inverse, half domain or hue adjusting "
+                            "1D LUTs could not be written.");
+        }
+
+        if(lut->getConcreteInterpolation()==INTERP_NEAREST)
+        {
+            throw Exception("The source code of the draft interpolation quality "
+                            "could not be written.");
+        }
+
+        const std::string table = addTable(opIndex, lut->getArray().getValues());
+        const unsigned long dim = lut->getArray().getLength();
+
+        m_hasLut1D = true;
+
+        m_body << "        for(int c=0; c<3; ++c)\n";
+        m_body << "        {\n";
+        m_body << "            rgba[c] = Lut1D(" << table << ", " << dim << ", c, rgba[c]);\n";
+        m_body << "        }\n";
+    }
+
+    void addLut3D(ConstLut3DOpDataRcPtr lut, size_t opIndex)
+    {
+        if(lut->getDirection()!=TRANSFORM_DIR_FORWARD)
+        {
+            throw Exception("The source code of the inverse 3D LUTs could not be written.");
+        }
+
+        if(lut->getConcreteInterpolation()==INTERP_NEAREST)
+        {
+            throw Exception("The source code of the draft interpolation quality "
+                            "could not be written.");
+        }
+
+        const std::string table = addTable(opIndex, lut->getArray().getValues());
+        const long dim = lut->getGridSize();
+
+        const bool tetrahedral = lut->getConcreteInterpolation()==INTERP_TETRAHEDRAL;
+        m_hasTetrahedral = m_hasTetrahedral || tetrahedral;
+        m_hasTrilinear   = m_hasTrilinear || !tetrahedral;
+
+        m_body << "        " << (tetrahedral ? "Lut3DTetrahedral(" : "Lut3DTrilinear(")
+               << table << ", " << dim << ", rgba);\n";
+    }
+
+    void addGamma(ConstGammaOpDataRcPtr gamma)
+    {
+        const GammaOpData::Style style = gamma->getStyle();
+        if(style!=GammaOpData::BASIC_FWD && style!=GammaOpData::BASIC_REV)
+        {
+            throw Exception("The source code of the moncurve gammas could not be written.");
+        }
+
+        const GammaOpData::Params * params[4] = { &gamma->getRedParams(),
+                                                  &gamma->getGreenParams(),
+                                                  &gamma->getBlueParams(),
+                                                  &gamma->getAlphaParams() };
+
+        for(int c=0; c<4; ++c)
+        {
+            const double exponent
+                = style==GammaOpData::BASIC_FWD ? (*params[c])[0] : 1. / (*params[c])[0];
+
+            m_body << "        rgba[" << c << "] = std::pow(rgba[" << c << "] > 0.0f ? rgba["
+                   << c << "] : 0.0f, " << FloatLiteral(exponent) << ");\n";
+        }
+
+        m_needsCMath = true;
+    }
+
+    template<typename Values>
+    std::string addTable(size_t opIndex, const Values & values)
+    {
+        std::ostringstream name;
+        name << "lut" << opIndex;
+
+        m_tables << "\n";
+        m_tables << "const float " << name.str() << "[" << values.size() << "] =\n";
+        m_tables << "{";
+        for(size_t idx=0; idx<values.size(); ++idx)
+        {
+            m_tables << (idx % 6 == 0 ? "\n    " : " ") << FloatLiteral(values[idx]) << ",";
+        }
+        m_tables << "\n};\n";
+
+        return name.str();
+    }
+
+    const std::string m_functionName;
+
+    std::ostringstream m_tables; // The LUT tables.
+    std::ostringstream m_body;   // The processing of one pixel.
+
+    bool m_hasLut1D       = false;
+    bool m_hasTetrahedral = false;
+    bool m_hasTrilinear   = false;
+    bool m_needsCMath     = false;
+};
+
+}
+
+void WriteCPUSourceCode(const OpRcPtrVec & ops, const std::string & cacheID,
+                        const char * functionName, std::ostream & os)
+{
+    if(!IsIdentifier(functionName))
+    {
+        std::ostringstream oss;
+        oss << "The function name '" << (functionName ? functionName : "")
+            << "' is not a valid C++ identifier.";
+        throw Exception(oss.str().c_str());
+    }
+
+    SourceCodeBuilder builder(functionName);
+    for(size_t idx=0; idx<ops.size(); ++idx)
+    {
+        builder.addOp(ops[idx], idx);
+    }
+
+    builder.write(cacheID, os);
+}
+
+}
+OCIO_NAMESPACE_EXIT
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+
+
+
+#ifdef OCIO_UNIT_TEST
+
+namespace OCIO = OCIO_NAMESPACE;
+#include "UnitTest.h"
+
+
+OCIO_ADD_TEST(CPUSourceCode, write)
+{
+    OCIO::ConfigRcPtr config = OCIO::Config::Create();
+
+    OCIO::MatrixTransformRcPtr matrix = OCIO::MatrixTransform::Create();
+    const double offset[4] = { 0.1, 0.05, 0.0, 0.0 };
+    matrix->setOffset(offset);
+
+    OCIO::LUT3DTransformRcPtr lut = OCIO::LUT3DTransform::Create(5);
+    lut->setValue(2, 3, 1, 0.2f, 0.3f, 0.4f);
+    lut->setInterpolation(OCIO::INTERP_TETRAHEDRAL);
+
+    OCIO::GroupTransformRcPtr group = OCIO::GroupTransform::Create();
+    group->appendTransform(matrix);
+    group->appendTransform(lut);
+
+    OCIO::ConstProcessorRcPtr processor;
+    OCIO_CHECK_NO_THROW(processor = config->getProcessor(group));
+
+    OCIO::ConstCPUProcessorRcPtr cpuProcessor;
+    OCIO_CHECK_NO_THROW(cpuProcessor = processor->getDefaultCPUProcessor());
+
+    std::ostringstream oss;
+    OCIO_CHECK_NO_THROW(cpuProcessor->writeSourceCode("ProcessPixels", oss));
+
+    const std::string code = oss.str();
+
+    // The cache identifier of the processor is available.
+    OCIO_CHECK_NE(code.find(std::string("const char ProcessPixels_cacheID[] = \"")
+                            + cpuProcessor->getCacheID() + "\";"),
+                  std::string::npos);
+
+    OCIO_CHECK_NE(code.find("void ProcessPixels(float * rgba, long numPixels)\n{"),
+                  std::string::npos);
+
+    // The matrix parameters are constants.
+    OCIO_CHECK_NE(code.find("rgba[0] = 1.000000000e+00f * in[0] + 0.000000000e+00f * in[1]"
+                            " + 0.000000000e+00f * in[2] + 0.000000000e+00f * in[3]"
+                            " + 1.000000015e-01f;"),
+                  std::string::npos);
+
+    // The 3D LUT is a static table.
+    OCIO_CHECK_NE(code.find("const float lut1[375] =\n{"), std::string::npos);
+    OCIO_CHECK_NE(code.find("Lut3DTetrahedral(lut1, 5, rgba);"), std::string::npos);
+    OCIO_CHECK_EQUAL(code.find("Lut3DTrilinear"), std::string::npos);
+    OCIO_CHECK_EQUAL(code.find("Lut1D"), std::string::npos);
+    OCIO_CHECK_EQUAL(code.find("#include <cmath>"), std::string::npos);
+
+    OCIO_CHECK_THROW_WHAT(cpuProcessor->writeSourceCode("2ProcessPixels", oss),
+                          OCIO::Exception, "is not a valid C++ identifier");
+    OCIO_CHECK_THROW_WHAT(cpuProcessor->writeSourceCode(nullptr, oss),
+                          OCIO::Exception, "is not a valid C++ identifier");
+
+    // Only the 32-bit float processors are supported.
+    OCIO_CHECK_NO_THROW(cpuProcessor
+        = processor->getOptimizedCPUProcessor(OCIO::BIT_DEPTH_UINT8, OCIO::BIT_DEPTH_F32,
+                                              OCIO::OPTIMIZATION_DEFAULT,
+                                              OCIO::FINALIZATION_DEFAULT));
+    OCIO_CHECK_THROW_WHAT(cpuProcessor->writeSourceCode("ProcessPixels", oss),
+                          OCIO::Exception, "Only the source code of the 32-bit float");
+
+    // Unsupported op.
+    OCIO::LogTransformRcPtr log = OCIO::LogTransform::Create();
+    OCIO_CHECK_NO_THROW(processor = config->getProcessor(log));
+    OCIO_CHECK_NO_THROW(cpuProcessor = processor->getDefaultCPUProcessor());
+    OCIO_CHECK_THROW_WHAT(cpuProcessor->writeSourceCode("ProcessPixels", oss),
+                          OCIO::Exception, "could not be written");
+}
+
+#endif // OCIO_UNIT_TEST
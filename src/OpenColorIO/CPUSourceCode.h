@@ -0,0 +1,28 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the OpenColorIO Project.
+
+
+#ifndef INCLUDED_OCIO_CPUSOURCECODE_H
+#define INCLUDED_OCIO_CPUSOURCECODE_H
+
+#include <ostream>
+#include <string>
+
+#include <OpenColorIO/OpenColorIO.h>
+
+#include "Op.h"
+
+
+OCIO_NAMESPACE_ENTER
+{
+
+// Write a self-contained C++ source file processing in place packed RGBA 32-bit float pixels
+// with the finalized ops, refer to CPUProcessor::writeSourceCode(). It throws if an op could
+// not be generated (e.g. a dynamic op or an unsupported op type).
+void WriteCPUSourceCode(const OpRcPtrVec & ops, const std::string & cacheID,
+                        const char * functionName, std::ostream & os);
+
+}
+OCIO_NAMESPACE_EXIT
+
+#endif
@@ -0,0 +1,117 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the OpenColorIO Project.
+
+
+#ifndef INCLUDED_OCIO_CACHESTATISTICS_H
+#define INCLUDED_OCIO_CACHESTATISTICS_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+#include <OpenColorIO/OpenColorIO.h>
+
+#include "Mutex.h"
+
+
+OCIO_NAMESPACE_ENTER
+{
+
+// Cumulative statistics of a global cache (refer to GetCacheStatistic()). The counters are
+// relaxed atomics so the instrumentation does not add any contention to the caches.
+class CacheStatistics
+{
+public:
+    CacheStatistics() = default;
+    CacheStatistics(const CacheStatistics &) = delete;
+    CacheStatistics & operator=(const CacheStatistics &) = delete;
+
+    void addHit()                    { add(m_hits, 1); }
+    void addMiss()                   { add(m_misses, 1); }
+    void addInsertion()              { add(m_insertions, 1); }
+    void addEvictions(size_t num)    { add(m_evictions, num); }
+    void addLockWait(uint64_t ns)    { add(m_lockWaitNs, ns); }
+
+    unsigned long long get(CacheStatistic statistic) const;
+
+    void reset();
+
+private:
+    static void add(std::atomic<uint64_t> & counter, uint64_t value)
+    {
+        counter.fetch_add(value, std::memory_order_relaxed);
+    }
+
+    std::atomic<uint64_t> m_hits{ 0 };
+    std::atomic<uint64_t> m_misses{ 0 };
+    std::atomic<uint64_t> m_insertions{ 0 };
+    std::atomic<uint64_t> m_evictions{ 0 };
+    std::atomic<uint64_t> m_lockWaitNs{ 0 };
+};
+
+// Get the statistics of a global cache. An exception is thrown for an unknown cache type.
+CacheStatistics & GetCacheStatistics(CacheType type);
+
+// Lock guard accounting the time spent waiting for a mutex held by another thread in the
+// statistics of a cache. An uncontended lock only costs a try_lock (i.e. no clock read).
+template<typename MutexType>
+class AutoTimedLock
+{
+public:
+    AutoTimedLock(MutexType & mutex, CacheStatistics & statistics)
+        :   m_mutex(mutex)
+    {
+        if (!m_mutex.try_lock())
+        {
+            const auto start = std::chrono::steady_clock::now();
+            m_mutex.lock();
+            statistics.addLockWait(ElapsedNs(start));
+        }
+    }
+
+    ~AutoTimedLock() { m_mutex.unlock(); }
+
+    AutoTimedLock(const AutoTimedLock &) = delete;
+    AutoTimedLock & operator=(const AutoTimedLock &) = delete;
+
+    static uint64_t ElapsedNs(std::chrono::steady_clock::time_point start)
+    {
+        return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - start).count();
+    }
+
+private:
+    MutexType & m_mutex;
+};
+
+typedef AutoTimedLock<Mutex> AutoTimedMutex;
+typedef AutoTimedLock<SharedMutex> AutoTimedExclusiveLock;
+
+// Same as AutoTimedLock for the shared lock of a read-mostly cache.
+class AutoTimedSharedLock
+{
+public:
+    AutoTimedSharedLock(SharedMutex & mutex, CacheStatistics & statistics)
+        :   m_mutex(mutex)
+    {
+        if (!m_mutex.try_lock_shared())
+        {
+            const auto start = std::chrono::steady_clock::now();
+            m_mutex.lock_shared();
+            statistics.addLockWait(AutoTimedMutex::ElapsedNs(start));
+        }
+    }
+
+    ~AutoTimedSharedLock() { m_mutex.unlock_shared(); }
+
+    AutoTimedSharedLock(const AutoTimedSharedLock &) = delete;
+    AutoTimedSharedLock & operator=(const AutoTimedSharedLock &) = delete;
+
+private:
+    SharedMutex & m_mutex;
+};
+
+}
+OCIO_NAMESPACE_EXIT
+
+#endif
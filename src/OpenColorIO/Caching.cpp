@@ -3,12 +3,78 @@
 
 #include <OpenColorIO/OpenColorIO.h>
 
+#include "CacheStatistics.h"
+#include "GPUProcessor.h"
+#include "LookParse.h"
+#include "ops/Lut1D/Lut1DOpData.h"
+#include "ops/Lut3D/Lut3DOpData.h"
 #include "transforms/CDLTransform.h"
+#include "transforms/ColorSpaceTransform.h"
 #include "PathUtils.h"
+#include "Processor.h"
+#include "RendererAllocator.h"
+#include "SharedCPUOps.h"
 #include "transforms/FileTransform.h"
+#include "transforms/GroupTransform.h"
+#include "transforms/LookTransform.h"
 
 OCIO_NAMESPACE_ENTER
 {
+    namespace
+    {
+        constexpr int NUM_CACHE_TYPES = CACHE_LOOK_PARSE + 1;
+
+        CacheStatistics g_cacheStatistics[NUM_CACHE_TYPES];
+    }
+
+    unsigned long long CacheStatistics::get(CacheStatistic statistic) const
+    {
+        switch(statistic)
+        {
+            case CACHE_STATISTIC_LOOKUPS:
+                return m_hits.load(std::memory_order_relaxed)
+                     + m_misses.load(std::memory_order_relaxed);
+            case CACHE_STATISTIC_HITS:         return m_hits.load(std::memory_order_relaxed);
+            case CACHE_STATISTIC_MISSES:       return m_misses.load(std::memory_order_relaxed);
+            case CACHE_STATISTIC_INSERTIONS:   return m_insertions.load(std::memory_order_relaxed);
+            case CACHE_STATISTIC_EVICTIONS:    return m_evictions.load(std::memory_order_relaxed);
+            case CACHE_STATISTIC_LOCK_WAIT_NS: return m_lockWaitNs.load(std::memory_order_relaxed);
+        }
+
+        throw Exception("Unknown cache statistic.");
+    }
+
+    void CacheStatistics::reset()
+    {
+        m_hits       = 0;
+        m_misses     = 0;
+        m_insertions = 0;
+        m_evictions  = 0;
+        m_lockWaitNs = 0;
+    }
+
+    CacheStatistics & GetCacheStatistics(CacheType type)
+    {
+        if(type < 0 || type >= NUM_CACHE_TYPES)
+        {
+            throw Exception("Unknown cache type.");
+        }
+        return g_cacheStatistics[type];
+    }
+
+    unsigned long long GetCacheStatistic(CacheType type, CacheStatistic statistic)
+    {
+        return GetCacheStatistics(type).get(statistic);
+    }
+
+    void ResetCacheStatistics()
+    {
+        for(auto & statistics : g_cacheStatistics)
+        {
+            statistics.reset();
+        }
+    }
+
     // TODO: Processors which the user hangs onto have local caches.
     // Should these be cleared?
     
@@ -17,6 +83,176 @@ OCIO_NAMESPACE_ENTER
         ClearPathCaches();
         ClearFileTransformCaches();
         ClearCDLTransformFileCache();
+        ClearLut3DFastInverseCache();
+        ClearLut1DComposeCache();
+        ClearColorSpaceOpsCache();
+        ClearLookOpsCache();
+        ClearLookParseCache();
+        ClearGroupOpsCache();
+        ClearProcessorCaches();
+        ClearSharedCPUOpCache();
+        ClearGpuShaderFragmentCache();
+        ClearGpuShaderProgramCache();
+        // Last, as clearing the other caches could release renderers.
+        ClearRendererTablePool();
+    }
+
+    size_t GetCacheMemoryUsage(CacheType type)
+    {
+        switch(type)
+        {
+            case CACHE_FILE:                return GetFileCacheMemoryUsage();
+            case CACHE_PATH:                return GetPathCacheMemoryUsage();
+            case CACHE_CDL_FILE:            return GetCDLTransformFileCacheMemoryUsage();
+            case CACHE_LUT3D_FAST_INVERSE:  return GetLut3DFastInverseCacheMemoryUsage();
+            case CACHE_COLORSPACE_OPS:      return GetColorSpaceOpsCacheMemoryUsage();
+            case CACHE_GPU_SHADER_FRAGMENT: return GetGpuShaderFragmentCacheMemoryUsage();
+            case CACHE_GPU_SHADER_PROGRAM:  return GetGpuShaderProgramCacheMemoryUsage();
+            case CACHE_LOOK_OPS:            return GetLookOpsCacheMemoryUsage();
+            case CACHE_LUT1D_COMPOSE:       return GetLut1DComposeCacheMemoryUsage();
+            case CACHE_RENDERER_TABLES:     return GetRendererTablePoolMemoryUsage();
+            // The results are held by the contexts.
+            case CACHE_CONTEXT_RESULTS:     return 0;
+            case CACHE_LOOK_PARSE:          return GetLookParseCacheMemoryUsage();
+        }
+
+        throw Exception("Unknown cache type.");
+    }
+
+    size_t GetAllCachesMemoryUsage()
+    {
+        return GetCacheMemoryUsage(CACHE_FILE)
+             + GetCacheMemoryUsage(CACHE_PATH)
+             + GetCacheMemoryUsage(CACHE_CDL_FILE)
+             + GetCacheMemoryUsage(CACHE_LUT3D_FAST_INVERSE)
+             + GetCacheMemoryUsage(CACHE_COLORSPACE_OPS)
+             + GetCacheMemoryUsage(CACHE_GPU_SHADER_FRAGMENT)
+             + GetCacheMemoryUsage(CACHE_GPU_SHADER_PROGRAM)
+             + GetCacheMemoryUsage(CACHE_LOOK_OPS)
+             + GetCacheMemoryUsage(CACHE_LUT1D_COMPOSE)
+             + GetCacheMemoryUsage(CACHE_RENDERER_TABLES)
+             + GetCacheMemoryUsage(CACHE_LOOK_PARSE);
     }
 }
 OCIO_NAMESPACE_EXIT
+
+
+///////////////////////////////////////////////////////////////////////////////
+
+
+
+#ifdef OCIO_UNIT_TEST
+
+#include <sstream>
+
+namespace OCIO = OCIO_NAMESPACE;
+#include "UnitTest.h"
+#include "UnitTestUtils.h"
+
+OCIO_ADD_TEST(Caching, memory_usage)
+{
+    OCIO::ClearAllCaches();
+    OCIO_CHECK_EQUAL(OCIO::GetCacheMemoryUsage(OCIO::CACHE_FILE), 0);
+    OCIO_CHECK_EQUAL(OCIO::GetCacheMemoryUsage(OCIO::CACHE_PATH), 0);
+    OCIO_CHECK_EQUAL(OCIO::GetCacheMemoryUsage(OCIO::CACHE_CDL_FILE), 0);
+    OCIO_CHECK_EQUAL(OCIO::GetCacheMemoryUsage(OCIO::CACHE_LUT3D_FAST_INVERSE), 0);
+    OCIO_CHECK_EQUAL(OCIO::GetCacheMemoryUsage(OCIO::CACHE_COLORSPACE_OPS), 0);
+    OCIO_CHECK_EQUAL(OCIO::GetCacheMemoryUsage(OCIO::CACHE_GPU_SHADER_FRAGMENT), 0);
+    OCIO_CHECK_EQUAL(OCIO::GetCacheMemoryUsage(OCIO::CACHE_GPU_SHADER_PROGRAM), 0);
+    OCIO_CHECK_EQUAL(OCIO::GetCacheMemoryUsage(OCIO::CACHE_LOOK_OPS), 0);
+    OCIO_CHECK_EQUAL(OCIO::GetCacheMemoryUsage(OCIO::CACHE_LUT1D_COMPOSE), 0);
+    OCIO_CHECK_EQUAL(OCIO::GetCacheMemoryUsage(OCIO::CACHE_RENDERER_TABLES), 0);
+    OCIO_CHECK_EQUAL(OCIO::GetCacheMemoryUsage(OCIO::CACHE_LOOK_PARSE), 0);
+    OCIO_CHECK_EQUAL(OCIO::GetAllCachesMemoryUsage(), 0);
+
+    // Loading a LUT file fills the file & path caches.
+    OCIO::FileTransformRcPtr file = OCIO::FileTransform::Create();
+    file->setSrc("lut1d_5.spi1d");
+    file->setInterpolation(OCIO::INTERP_LINEAR);
+
+    OCIO::ConfigRcPtr config = OCIO::Config::Create();
+    config->setSearchPath(OCIO::getTestFilesDir());
+
+    OCIO_CHECK_NO_THROW(config->getProcessor(file));
+    OCIO_CHECK_ASSERT(OCIO::GetCacheMemoryUsage(OCIO::CACHE_FILE) > 0);
+    OCIO_CHECK_ASSERT(OCIO::GetCacheMemoryUsage(OCIO::CACHE_PATH) > 0);
+
+    const size_t usage = OCIO::GetAllCachesMemoryUsage();
+    OCIO_CHECK_ASSERT(usage >= OCIO::GetCacheMemoryUsage(OCIO::CACHE_FILE)
+                               + OCIO::GetCacheMemoryUsage(OCIO::CACHE_PATH));
+
+    OCIO::ClearAllCaches();
+    OCIO_CHECK_EQUAL(OCIO::GetAllCachesMemoryUsage(), 0);
+}
+
+OCIO_ADD_TEST(Caching, statistics)
+{
+    OCIO::ClearAllCaches();
+    OCIO::ResetCacheStatistics();
+
+    const OCIO::CacheStatistic statistics[]
+        = { OCIO::CACHE_STATISTIC_LOOKUPS, OCIO::CACHE_STATISTIC_HITS,
+            OCIO::CACHE_STATISTIC_MISSES, OCIO::CACHE_STATISTIC_INSERTIONS,
+            OCIO::CACHE_STATISTIC_EVICTIONS, OCIO::CACHE_STATISTIC_LOCK_WAIT_NS };
+
+    for(int type = OCIO::CACHE_FILE; type <= OCIO::CACHE_LOOK_PARSE; ++type)
+    {
+        for(const auto statistic : statistics)
+        {
+            OCIO_CHECK_EQUAL(OCIO::GetCacheStatistic(OCIO::CacheType(type), statistic), 0);
+        }
+    }
+
+    OCIO::FileTransformRcPtr file = OCIO::FileTransform::Create();
+    file->setSrc("lut1d_5.spi1d");
+    file->setInterpolation(OCIO::INTERP_LINEAR);
+
+    // The first config loads the file.
+    OCIO::ConfigRcPtr config = OCIO::Config::Create();
+    config->setSearchPath(OCIO::getTestFilesDir());
+    OCIO_CHECK_NO_THROW(config->getProcessor(file));
+
+    OCIO_CHECK_EQUAL(OCIO::GetCacheStatistic(OCIO::CACHE_FILE, OCIO::CACHE_STATISTIC_HITS), 0);
+    OCIO_CHECK_EQUAL(OCIO::GetCacheStatistic(OCIO::CACHE_FILE, OCIO::CACHE_STATISTIC_MISSES), 1);
+    OCIO_CHECK_EQUAL(OCIO::GetCacheStatistic(OCIO::CACHE_FILE,
+                                             OCIO::CACHE_STATISTIC_INSERTIONS), 1);
+    OCIO_CHECK_ASSERT(OCIO::GetCacheStatistic(OCIO::CACHE_PATH,
+                                              OCIO::CACHE_STATISTIC_MISSES) > 0);
+    OCIO_CHECK_ASSERT(OCIO::GetCacheStatistic(OCIO::CACHE_CONTEXT_RESULTS,
+                                              OCIO::CACHE_STATISTIC_INSERTIONS) > 0);
+
+    // Another config (i.e. not sharing the processor cache) finds the loaded file.
+    OCIO::ConfigRcPtr config2 = OCIO::Config::Create();
+    config2->setSearchPath(OCIO::getTestFilesDir());
+    OCIO_CHECK_NO_THROW(config2->getProcessor(file));
+
+    OCIO_CHECK_EQUAL(OCIO::GetCacheStatistic(OCIO::CACHE_FILE, OCIO::CACHE_STATISTIC_HITS), 1);
+    OCIO_CHECK_EQUAL(OCIO::GetCacheStatistic(OCIO::CACHE_FILE, OCIO::CACHE_STATISTIC_MISSES), 1);
+    OCIO_CHECK_EQUAL(OCIO::GetCacheStatistic(OCIO::CACHE_FILE, OCIO::CACHE_STATISTIC_LOOKUPS), 2);
+    OCIO_CHECK_ASSERT(OCIO::GetCacheStatistic(OCIO::CACHE_PATH,
+                                              OCIO::CACHE_STATISTIC_HITS) > 0);
+
+    for(int type = OCIO::CACHE_FILE; type <= OCIO::CACHE_LOOK_PARSE; ++type)
+    {
+        const OCIO::CacheType cache = OCIO::CacheType(type);
+        OCIO_CHECK_EQUAL(OCIO::GetCacheStatistic(cache, OCIO::CACHE_STATISTIC_LOOKUPS),
+                         OCIO::GetCacheStatistic(cache, OCIO::CACHE_STATISTIC_HITS)
+                         + OCIO::GetCacheStatistic(cache, OCIO::CACHE_STATISTIC_MISSES));
+    }
+
+    // Clearing the caches does not reset the statistics.
+    OCIO::ClearAllCaches();
+    OCIO_CHECK_EQUAL(OCIO::GetCacheStatistic(OCIO::CACHE_FILE, OCIO::CACHE_STATISTIC_LOOKUPS), 2);
+    OCIO_CHECK_EQUAL(OCIO::GetCacheStatistic(OCIO::CACHE_FILE,
+                                             OCIO::CACHE_STATISTIC_EVICTIONS), 0);
+
+    OCIO::ResetCacheStatistics();
+    OCIO_CHECK_EQUAL(OCIO::GetCacheStatistic(OCIO::CACHE_FILE, OCIO::CACHE_STATISTIC_LOOKUPS), 0);
+    OCIO_CHECK_EQUAL(OCIO::GetCacheStatistic(OCIO::CACHE_PATH, OCIO::CACHE_STATISTIC_LOOKUPS), 0);
+
+    OCIO_CHECK_THROW_WHAT(OCIO::GetCacheStatistic(OCIO::CacheType(-1),
+                                                  OCIO::CACHE_STATISTIC_HITS),
+                          OCIO::Exception, "Unknown cache type");
+}
+
+#endif // OCIO_UNIT_TEST
@@ -1,12 +1,14 @@
 // SPDX-License-Identifier: BSD-3-Clause
 // Copyright Contributors to the OpenColorIO Project.
 
+#include <atomic>
 #include <cstring>
 #include <sstream>
 #include <vector>
 
 #include <OpenColorIO/OpenColorIO.h>
 
+#include "Mutex.h"
 #include "PrivateTypes.h"
 #include "pystring/pystring.h"
 
@@ -38,8 +40,16 @@ OCIO_NAMESPACE_ENTER
         Allocation allocation_;
         std::vector<float> allocationVars_;
         
-        TransformRcPtr toRefTransform_;
-        TransformRcPtr fromRefTransform_;
+        // The transforms are mutable as, when their loader is set, they are only
+        // created on first use (refer to SetLazyTransformLoading()).
+        mutable TransformRcPtr toRefTransform_;
+        mutable TransformRcPtr fromRefTransform_;
+
+        mutable TransformLoader toRefLoader_;
+        mutable TransformLoader fromRefLoader_;
+        mutable Mutex transformMutex_;
+        // Once both transforms are loaded, getTransform() does not need the lock.
+        mutable std::atomic<bool> transformsLoaded_{ true };
         
         bool toRefSpecified_;
         bool fromRefSpecified_;
@@ -73,13 +83,22 @@ OCIO_NAMESPACE_ENTER
                 allocation_ = rhs.allocation_;
                 allocationVars_ = rhs.allocationVars_;
 
-                toRefTransform_ = rhs.toRefTransform_?
-                    rhs.toRefTransform_->createEditableCopy()
-                    : rhs.toRefTransform_;
+                {
+                    // A not yet loaded transform stays lazy in the copy.
+                    AutoMutex lock(rhs.transformMutex_);
+
+                    toRefTransform_ = rhs.toRefTransform_?
+                        rhs.toRefTransform_->createEditableCopy()
+                        : rhs.toRefTransform_;
 
-                fromRefTransform_ = rhs.fromRefTransform_?
-                    rhs.fromRefTransform_->createEditableCopy()
-                    : rhs.fromRefTransform_;
+                    fromRefTransform_ = rhs.fromRefTransform_?
+                        rhs.fromRefTransform_->createEditableCopy()
+                        : rhs.fromRefTransform_;
+
+                    toRefLoader_ = rhs.toRefLoader_;
+                    fromRefLoader_ = rhs.fromRefLoader_;
+                    updateTransformsLoaded();
+                }
 
                 toRefSpecified_ = rhs.toRefSpecified_;
                 fromRefSpecified_ = rhs.fromRefSpecified_;
@@ -107,6 +126,39 @@ OCIO_NAMESPACE_ENTER
             return categories_.end();
         }
 
+        ConstTransformRcPtr getTransform(ColorSpaceDirection dir) const
+        {
+            TransformRcPtr & transform 
+                = dir==COLORSPACE_DIR_TO_REFERENCE ? toRefTransform_ : fromRefTransform_;
+            TransformLoader & loader
+                = dir==COLORSPACE_DIR_TO_REFERENCE ? toRefLoader_ : fromRefLoader_;
+
+            // Note that the transforms could only change through the (non-const)
+            // setters which are not thread-safe anyway.
+            if(transformsLoaded_.load(std::memory_order_acquire))
+            {
+                return transform;
+            }
+
+            AutoMutex lock(transformMutex_);
+
+            if(loader)
+            {
+                // In case of failure, the loader is kept to throw again on next use.
+                transform = loader();
+                loader = nullptr;
+                updateTransformsLoaded();
+            }
+
+            return transform;
+        }
+
+        // Note that the caller holds the transform lock.
+        void updateTransformsLoaded() const
+        {
+            transformsLoaded_.store(!toRefLoader_ && !fromRefLoader_, std::memory_order_release);
+        }
+
         void removeCategory(const char * category)
         {
             if(!category || !*category) return;
@@ -285,10 +337,8 @@ OCIO_NAMESPACE_ENTER
     
     ConstTransformRcPtr ColorSpace::getTransform(ColorSpaceDirection dir) const
     {
-        if(dir == COLORSPACE_DIR_TO_REFERENCE)
-            return getImpl()->toRefTransform_;
-        else if(dir == COLORSPACE_DIR_FROM_REFERENCE)
-            return getImpl()->fromRefTransform_;
+        if(dir == COLORSPACE_DIR_TO_REFERENCE || dir == COLORSPACE_DIR_FROM_REFERENCE)
+            return getImpl()->getTransform(dir);
         
         throw Exception("Unspecified ColorSpaceDirection");
     }
@@ -299,12 +349,43 @@ OCIO_NAMESPACE_ENTER
         TransformRcPtr transformCopy;
         if(transform) transformCopy = transform->createEditableCopy();
         
+        AutoMutex lock(getImpl()->transformMutex_);
+
         if(dir == COLORSPACE_DIR_TO_REFERENCE)
+        {
             getImpl()->toRefTransform_ = transformCopy;
+            getImpl()->toRefLoader_ = nullptr;
+        }
         else if(dir == COLORSPACE_DIR_FROM_REFERENCE)
+        {
             getImpl()->fromRefTransform_ = transformCopy;
+            getImpl()->fromRefLoader_ = nullptr;
+        }
         else
             throw Exception("Unspecified ColorSpaceDirection");
+
+        getImpl()->updateTransformsLoaded();
+    }
+
+    void ColorSpace::setTransformLoader(const TransformLoader & loader,
+                                        ColorSpaceDirection dir)
+    {
+        AutoMutex lock(getImpl()->transformMutex_);
+
+        if(dir == COLORSPACE_DIR_TO_REFERENCE)
+        {
+            getImpl()->toRefTransform_ = TransformRcPtr();
+            getImpl()->toRefLoader_ = loader;
+        }
+        else if(dir == COLORSPACE_DIR_FROM_REFERENCE)
+        {
+            getImpl()->fromRefTransform_ = TransformRcPtr();
+            getImpl()->fromRefLoader_ = loader;
+        }
+        else
+            throw Exception("Unspecified ColorSpaceDirection");
+
+        getImpl()->updateTransformsLoaded();
     }
     
     std::ostream& operator<< (std::ostream& os, const ColorSpace& cs)
@@ -2,11 +2,12 @@
 // Copyright Contributors to the OpenColorIO Project.
 
 #include <sstream>
+#include <unordered_map>
 
 #include <OpenColorIO/OpenColorIO.h>
 
+#include "ParseUtils.h"
 #include "PrivateTypes.h"
-#include "pystring/pystring.h"
 
 
 OCIO_NAMESPACE_ENTER
@@ -30,6 +31,7 @@ public:
             {
                 m_colorSpaces.push_back(cs->createEditableCopy());
             }
+            m_index = rhs.m_index;
         }
         return *this;
     }
@@ -82,31 +84,18 @@ public:
 
     ConstColorSpaceRcPtr getByName(const char * csName) const 
     {
-        if(csName && *csName)
-        {
-            const std::string str = pystring::lower(csName);
-            for(auto & cs: m_colorSpaces)
-            {
-                if(pystring::lower(cs->getName())==str)
-                {
-                    return cs;
-                }
-            }
-        }
-        return ColorSpaceRcPtr();
+        const int idx = getIndex(csName);
+        return idx==-1 ? ColorSpaceRcPtr() : m_colorSpaces[idx];
     }
 
     int getIndex(const char * csName) const 
     {
         if(csName && *csName)
         {
-            const std::string str = pystring::lower(csName);
-            for(size_t idx = 0; idx<m_colorSpaces.size(); ++idx)
+            const auto it = m_index.find(csName);
+            if(it!=m_index.end())
             {
-                if(pystring::lower(m_colorSpaces[idx]->getName())==str)
-                {
-                    return static_cast<int>(idx);
-                }
+                return static_cast<int>(it->second);
             }
         }
 
@@ -115,23 +104,22 @@ public:
 
     void add(const ConstColorSpaceRcPtr & cs)
     {
-        const std::string csName = pystring::lower(cs->getName());
+        const std::string csName = cs->getName();
         if(csName.empty())
         {
             throw Exception("Cannot add a color space with an empty name.");
         }
 
-        for(auto & entry: m_colorSpaces)
+        const auto it = m_index.find(csName);
+        if(it!=m_index.end())
         {
-            if(pystring::lower(entry->getName())==csName)
-            {
-                // The color space replaces the existing one.
-                entry = cs->createEditableCopy();
-                return;
-            }
+            // The color space replaces the existing one.
+            m_colorSpaces[it->second] = cs->createEditableCopy();
+            return;
         }
 
         m_colorSpaces.push_back(cs->createEditableCopy());
+        m_index.emplace(csName, m_colorSpaces.size() - 1);
     }
 
     void add(const Impl & rhs)
@@ -144,15 +132,18 @@ public:
 
     void remove(const char * csName)
     {
-        const std::string name = pystring::lower(csName);
-        if(name.empty()) return;
+        const int idx = getIndex(csName);
+        if(idx==-1) return;
+
+        m_colorSpaces.erase(m_colorSpaces.begin() + idx);
 
-        for(auto itr = m_colorSpaces.begin(); itr != m_colorSpaces.end(); ++itr)
+        // Shift the indices of the next color spaces.
+        m_index.erase(csName);
+        for(auto & entry : m_index)
         {
-            if(pystring::lower((*itr)->getName())==name)
+            if(entry.second > static_cast<size_t>(idx))
             {
-                m_colorSpaces.erase(itr);
-                return;
+                --entry.second;
             }
         }
     }
@@ -168,11 +159,17 @@ public:
     void clear()
     {
         m_colorSpaces.clear();
+        m_index.clear();
     }
 
 private:
     typedef std::vector<ColorSpaceRcPtr> ColorSpaceVec;
     ColorSpaceVec m_colorSpaces;
+
+    // Case-insensitive index of the color space names (i.e. name to position in
+    // m_colorSpaces) to avoid scanning all the color spaces for each lookup.
+    typedef std::unordered_map<std::string, size_t, CaseIgnoreHash, CaseIgnoreEqual> NameIndex;
+    NameIndex m_index;
 };
 
 
@@ -633,4 +630,54 @@ OCIO_ADD_TEST(ColorSpaceSet, operations_on_set)
     OCIO_CHECK_EQUAL(css4->getNumColorSpaces(), 0);
 }
 
+OCIO_ADD_TEST(ColorSpaceSet, name_index)
+{
+    OCIO::ColorSpaceSetRcPtr css = OCIO::ColorSpaceSet::Create();
+
+    for (const char * name : { "cs1", "CS2", "cs3", "cs4" })
+    {
+        OCIO::ColorSpaceRcPtr cs = OCIO::ColorSpace::Create();
+        cs->setName(name);
+        OCIO_CHECK_NO_THROW(css->addColorSpace(cs));
+    }
+    OCIO_REQUIRE_EQUAL(css->getNumColorSpaces(), 4);
+
+    // The lookups ignore the case.
+
+    OCIO_CHECK_EQUAL(css->getIndexForColorSpace("cs2"), 1);
+    OCIO_CHECK_EQUAL(css->getIndexForColorSpace("Cs4"), 3);
+    OCIO_CHECK_EQUAL(css->getIndexForColorSpace("cs5"), -1);
+    OCIO_CHECK_EQUAL(css->getIndexForColorSpace(""), -1);
+    OCIO_CHECK_EQUAL(css->getIndexForColorSpace(nullptr), -1);
+    OCIO_REQUIRE_ASSERT(css->getColorSpace("CS3"));
+    OCIO_CHECK_EQUAL(std::string(css->getColorSpace("CS3")->getName()), std::string("cs3"));
+
+    // Replacing a color space keeps its position.
+
+    OCIO::ColorSpaceRcPtr cs = OCIO::ColorSpace::Create();
+    cs->setName("Cs2");
+    cs->setFamily("replaced");
+    OCIO_CHECK_NO_THROW(css->addColorSpace(cs));
+    OCIO_REQUIRE_EQUAL(css->getNumColorSpaces(), 4);
+    OCIO_CHECK_EQUAL(css->getIndexForColorSpace("cs2"), 1);
+    OCIO_CHECK_EQUAL(std::string(css->getColorSpaceByIndex(1)->getFamily()),
+                     std::string("replaced"));
+
+    // Removing a color space shifts the next ones.
+
+    OCIO_CHECK_NO_THROW(css->removeColorSpace("CS1"));
+    OCIO_REQUIRE_EQUAL(css->getNumColorSpaces(), 3);
+    OCIO_CHECK_EQUAL(css->getIndexForColorSpace("cs1"), -1);
+    OCIO_CHECK_EQUAL(css->getIndexForColorSpace("cs2"), 0);
+    OCIO_CHECK_EQUAL(css->getIndexForColorSpace("cs3"), 1);
+    OCIO_CHECK_EQUAL(css->getIndexForColorSpace("cs4"), 2);
+
+    // The copies have their own index.
+
+    OCIO::ColorSpaceSetRcPtr copy = css->createEditableCopy();
+    OCIO_CHECK_NO_THROW(css->clearColorSpaces());
+    OCIO_CHECK_EQUAL(css->getIndexForColorSpace("cs3"), -1);
+    OCIO_CHECK_EQUAL(copy->getIndexForColorSpace("cs3"), 1);
+}
+
 #endif // OCIO_UNIT_TEST
@@ -2,11 +2,19 @@
 // Copyright Contributors to the OpenColorIO Project.
 
 
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
 #include <cstdlib>
 #include <cstring>
+#include <list>
+#include <random>
 #include <set>
 #include <sstream>
 #include <fstream>
+#include <functional>
+#include <thread>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -23,9 +31,13 @@
 #include "ParseUtils.h"
 #include "PrivateTypes.h"
 #include "Processor.h"
+#include "ProcessorWarmup.h"
 #include "pystring/pystring.h"
 #include "OCIOYaml.h"
 #include "Platform.h"
+#include "ThreadPool.h"
+#include "Tracing.h"
+#include "transforms/FileTransform.h"
 
 OCIO_NAMESPACE_ENTER
 {
@@ -187,8 +199,269 @@ OCIO_NAMESPACE_ENTER
         *index = colorspaces->getIndexForColorSpace(csname.c_str());
         return *index!=-1;
     }
+
+    // The maximum number of processors per config (refer to SetProcessorCacheSize()).
+    std::atomic<unsigned> g_processorCacheSize{ 64 };
+    // Incremented by ClearProcessorCaches() to invalidate the caches of all the configs.
+    std::atomic<unsigned> g_processorCacheGeneration{ 0 };
+
+    // The files used by a processor with their hash (refer to GetFastFileHash()).
+    typedef std::vector<std::pair<std::string, std::string>> FileHashes;
+
+    void GetProcessorFileHashes(FileHashes & fileHashes, const ConstProcessorRcPtr & processor)
+    {
+        ConstProcessorMetadataRcPtr metadata = processor->getProcessorMetadata();
+        for(int idx = 0; idx < metadata->getNumFiles(); ++idx)
+        {
+            const std::string file(metadata->getFile(idx));
+            fileHashes.emplace_back(file, GetFastFileHash(file));
+        }
+    }
+
+    bool HaveFilesChanged(const FileHashes & fileHashes)
+    {
+        for(const auto & fileHash : fileHashes)
+        {
+            if(GetFastFileHash(fileHash.first) != fileHash.second)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Bounded cache of the processors created by a config i.e. the least recently used
+    // processor is removed when the cache is full. When the files are checked (refer to
+    // SetFileCacheCheckInterval()), a processor using a file changed since its creation
+    // is removed.
+    class ProcessorCache
+    {
+    public:
+        ProcessorCache() = default;
+        ProcessorCache(const ProcessorCache &) = delete;
+        ProcessorCache & operator=(const ProcessorCache &) = delete;
+
+        // Get the current generation to later add a processor (refer to add()).
+        unsigned getGeneration()
+        {
+            AutoMutex lock(m_mutex);
+            validate();
+            return m_generation;
+        }
+
+        ConstProcessorRcPtr get(const std::string & key)
+        {
+            ConstProcessorRcPtr processor;
+            FileHashes fileHashes;
+            {
+                AutoMutex lock(m_mutex);
+                validate();
+
+                Index::iterator iter = m_index.find(key);
+                if(iter == m_index.end())
+                {
+                    return ConstProcessorRcPtr();
+                }
+
+                // It is now the most recently used processor.
+                m_entries.splice(m_entries.begin(), m_entries, iter->second);
+                processor = iter->second->m_processor;
+
+                if(GetFileCacheCheckInterval() == 0)
+                {
+                    return processor;
+                }
+                fileHashes = iter->second->m_fileHashes;
+            }
+
+            // Check the files without blocking the other lookups.
+            if(HaveFilesChanged(fileHashes))
+            {
+                AutoMutex lock(m_mutex);
+
+                Index::iterator iter = m_index.find(key);
+                if(iter != m_index.end() && iter->second->m_processor == processor)
+                {
+                    m_entries.erase(iter->second);
+                    m_index.erase(iter);
+                }
+                return ConstProcessorRcPtr();
+            }
+
+            return processor;
+        }
+
+        // Add the processor unless the cache was cleared since the 'generation' was
+        // obtained i.e. the processor could have been created from an obsolete config.
+        void add(const std::string & key, const ConstProcessorRcPtr & processor,
+                 unsigned generation)
+        {
+            const size_t maxSize = g_processorCacheSize;
+            if(maxSize == 0)
+            {
+                return;
+            }
+
+            // Note that it computes the processor metadata.
+            FileHashes fileHashes;
+            GetProcessorFileHashes(fileHashes, processor);
+
+            AutoMutex lock(m_mutex);
+            validate();
+
+            if(generation != m_generation || maxSize == 0
+                || m_index.find(key) != m_index.end())
+            {
+                return;
+            }
+
+            m_entries.emplace_front(key, processor, fileHashes);
+            m_index[key] = m_entries.begin();
+
+            while(m_entries.size() > maxSize)
+            {
+                m_index.erase(m_entries.back().m_key);
+                m_entries.pop_back();
+            }
+        }
+
+        void clear()
+        {
+            AutoMutex lock(m_mutex);
+            clearEntries();
+        }
+
+    private:
+        void clearEntries()
+        {
+            m_entries.clear();
+            m_index.clear();
+            ++m_generation;
+        }
+
+        // Clear the cache if all the caches were cleared in the meantime.
+        void validate()
+        {
+            const unsigned globalGeneration = g_processorCacheGeneration;
+            if(globalGeneration != m_globalGeneration)
+            {
+                clearEntries();
+                m_globalGeneration = globalGeneration;
+            }
+        }
+
+        struct Entry
+        {
+            Entry(const std::string & key, const ConstProcessorRcPtr & processor,
+                  const FileHashes & fileHashes)
+                :   m_key(key)
+                ,   m_processor(processor)
+                ,   m_fileHashes(fileHashes)
+            {}
+
+            std::string         m_key;
+            ConstProcessorRcPtr m_processor;
+            FileHashes          m_fileHashes; // The files used by the processor.
+        };
+
+        typedef std::list<Entry> Entries;
+        typedef std::unordered_map<std::string, Entries::iterator> Index;
+
+        Entries  m_entries; // The most recently used processor first.
+        Index    m_index;
+        unsigned m_generation = 0;
+        unsigned m_globalGeneration = g_processorCacheGeneration;
+        Mutex    m_mutex;
+    };
+
+    const char * OCIO_PROCESSOR_CACHE_DIR_ENVVAR = "OCIO_PROCESSOR_CACHE_DIR";
+
+    std::string InitProcessorDiskCacheDir()
+    {
+        std::string dir;
+        Platform::Getenv(OCIO_PROCESSOR_CACHE_DIR_ENVVAR, dir);
+        return dir;
+    }
+
+    // The directory of the processor disk cache (refer to SetProcessorDiskCacheDir()).
+    std::string g_processorDiskCacheDir = InitProcessorDiskCacheDir();
+    Mutex g_processorDiskCacheDirMutex;
+
+    std::string GetProcessorDiskCacheFilename(const std::string & key)
+    {
+        std::string dir;
+        {
+            AutoMutex lock(g_processorDiskCacheDirMutex);
+            dir = g_processorDiskCacheDir;
+        }
+
+        if(dir.empty())
+        {
+            return "";
+        }
+
+        // Skip the '$' prefix of the hash.
+        const std::string hash = CacheIDHash(key.c_str(), key.size());
+        return dir + "/" + hash.substr(1) + ".ocioproc";
+    }
+
+    // The config cache id identifies the config and the files it uses, and the library
+    // version the way the ops are built.
+    std::string GetProcessorDiskCacheKey(const Config & config,
+                                         const ConstContextRcPtr & context,
+                                         const std::string & key)
+    {
+        return key + "\n" + config.getCacheID(context) + "\n" + GetVersion();
+    }
+
+    // Is a directory set for the processor disk cache?
+    bool IsProcessorDiskCacheEnabled()
+    {
+        AutoMutex lock(g_processorDiskCacheDirMutex);
+        return !g_processorDiskCacheDir.empty();
+    }
+
+    std::string GetProcessorCacheKey(const ConstContextRcPtr & context, const char * type,
+                                     const StringVec & args)
+    {
+        std::ostringstream key;
+        key << (context ? context->getCacheID() : "") << "\n" << type;
+        for(const auto & arg : args)
+        {
+            key << "\n" << arg;
+        }
+        return key.str();
+    }
         
     } // namespace
+
+    void SetProcessorCacheSize(unsigned numProcessors)
+    {
+        g_processorCacheSize = numProcessors;
+        ClearProcessorCaches();
+    }
+
+    unsigned GetProcessorCacheSize()
+    {
+        return g_processorCacheSize;
+    }
+
+    void SetProcessorDiskCacheDir(const char * dir)
+    {
+        AutoMutex lock(g_processorDiskCacheDirMutex);
+        g_processorDiskCacheDir = dir ? dir : "";
+    }
+
+    const char * GetProcessorDiskCacheDir()
+    {
+        AutoMutex lock(g_processorDiskCacheDirMutex);
+        return g_processorDiskCacheDir.c_str();
+    }
+
+    void ClearProcessorCaches()
+    {
+        ++g_processorCacheGeneration;
+    }
     
     static const unsigned FirstSupportedMajorVersion_ = 1;
     static const unsigned LastSupportedMajorVersion_  = 2;
@@ -205,6 +478,15 @@ OCIO_NAMESPACE_ENTER
 
         StringMap roles_;
         LookVec looksList_;
+
+        // Case-insensitive indices of the look names (i.e. name to position in
+        // looksList_) and of the display names (i.e. name to key in displays_).
+        typedef std::unordered_map<std::string, size_t,
+                                   CaseIgnoreHash, CaseIgnoreEqual> LookIndex;
+        typedef std::unordered_map<std::string, std::string,
+                                   CaseIgnoreHash, CaseIgnoreEqual> DisplayIndex;
+        LookIndex lookIndex_;
+        DisplayIndex displayIndex_;
         
         DisplayMap displays_;
         StringVec activeDisplays_;
@@ -223,9 +505,17 @@ OCIO_NAMESPACE_ENTER
         mutable Sanity sanity_;
         mutable std::string sanitytext_;
         
-        mutable Mutex cacheidMutex_;
+        // The cache id hits only take a shared lock (i.e. read-mostly cache).
+        mutable SharedMutex cacheidMutex_;
         mutable StringMap cacheids_;
         mutable std::string cacheidnocontext_;
+
+        mutable ProcessorCache processorCache_;
+
+        // A snapshot is never modified (see Config::createSnapshot()) so its cache ids,
+        // computed upfront, are read without any lock.
+        bool snapshot_ = false;
+        StringMap snapshotCacheIDs_;
         
         OCIOYaml io_;
         
@@ -284,11 +574,13 @@ OCIO_NAMESPACE_ENTER
                     looksList_.push_back(
                         rhs.looksList_[i]->createEditableCopy());
                 }
+                lookIndex_ = rhs.lookIndex_;
                 
                 // Assignment operator will suffice for these
                 roles_ = rhs.roles_;
                 
                 displays_ = rhs.displays_;
+                displayIndex_ = rhs.displayIndex_;
                 activeDisplays_ = rhs.activeDisplays_;
                 activeViews_ = rhs.activeViews_;
                 activeViewsEnvOverride_ = rhs.activeViewsEnvOverride_;
@@ -304,10 +596,20 @@ OCIO_NAMESPACE_ENTER
                 
                 cacheids_ = rhs.cacheids_;
                 cacheidnocontext_ = rhs.cacheidnocontext_;
+
+                // A copy is always editable.
+                snapshot_ = false;
+                snapshotCacheIDs_.clear();
             }
             return *this;
         }
 
+        DisplayMap::const_iterator findDisplay(const std::string & display) const
+        {
+            const auto it = displayIndex_.find(display);
+            return it==displayIndex_.end() ? displays_.end() : displays_.find(it->second);
+        }
+
         // Any time you modify the state of the config, you must call this
         // to reset internal cache states.  You also should do this in a
         // thread safe manner by acquiring the cacheidMutex_;
@@ -316,6 +618,24 @@ OCIO_NAMESPACE_ENTER
         // Get all internal transforms (to generate cacheIDs, validation, etc).
         // This currently crawls colorspaces + looks
         void getAllInternalTransforms(ConstTransformVec & transformVec) const;
+
+        // Get the processor from the cache (or from the disk cache), or create it. An
+        // empty key means that the processor cannot be cached, and 'create' could also
+        // prevent the caching.
+        ConstProcessorRcPtr getCachedProcessor(
+            const Config & config,
+            const ConstContextRcPtr & context,
+            const std::string & key,
+            const std::function<ConstProcessorRcPtr(bool &)> & create) const;
+
+        // Load the processor identified by the key (i.e. including the config and context
+        // cache ids) from the disk cache, or return an empty pointer if missing.
+        ConstProcessorRcPtr loadFromDiskCache(const Config & config,
+                                              const ConstContextRcPtr & context,
+                                              const std::string & key) const;
+        // Save the processor to the disk cache (i.e. the failures are only logged).
+        void saveToDiskCache(const ConstProcessorRcPtr & processor,
+                             const std::string & key) const;
     };
     
     
@@ -357,6 +677,8 @@ OCIO_NAMESPACE_ENTER
     
     ConstConfigRcPtr Config::CreateFromFile(const char * filename)
     {
+        TracingSpan span("config", filename);
+
         std::ifstream istream(filename);
         if(istream.fail()) {
             std::ostringstream os;
@@ -372,6 +694,8 @@ OCIO_NAMESPACE_ENTER
     
     ConstConfigRcPtr Config::CreateFromStream(std::istream & istream)
     {
+        TracingSpan span("config", "CreateFromStream");
+
         ConfigRcPtr config = Config::Create();
         config->getImpl()->io_.open(istream, config);
         return config;
@@ -431,6 +755,51 @@ OCIO_NAMESPACE_ENTER
         return config;
     }
     
+    ConstConfigRcPtr Config::createSnapshot() const
+    {
+        ConfigRcPtr config = createEditableCopy();
+        Impl * impl = config->getImpl();
+
+        // Load all the color space transforms. Note that the failures are reported
+        // again on use.
+        for(int i=0; i<impl->colorspaces_->getNumColorSpaces(); ++i)
+        {
+            ConstColorSpaceRcPtr cs = impl->colorspaces_->getColorSpaceByIndex(i);
+            try
+            {
+                cs->getTransform(COLORSPACE_DIR_TO_REFERENCE);
+                cs->getTransform(COLORSPACE_DIR_FROM_REFERENCE);
+            }
+            catch(const Exception &)
+            {
+            }
+        }
+
+        // Keep the result (or the error) of the sanity check.
+        try
+        {
+            config->sanityCheck();
+        }
+        catch(const Exception &)
+        {
+        }
+
+        config->getNumDisplays();
+        impl->activeDisplaysStr_ = JoinStringEnvStyle(impl->activeDisplays_);
+        impl->activeViewsStr_ = JoinStringEnvStyle(impl->activeViews_);
+
+        // Computing the cache id with the current context resolves all the file
+        // references so the frozen context holds them.
+        impl->snapshotCacheIDs_[""] = config->getCacheID(ConstContextRcPtr());
+        const std::string cacheID = config->getCacheID(impl->context_);
+        impl->context_->freeze();
+        impl->snapshotCacheIDs_[impl->context_->getCacheID()] = cacheID;
+
+        impl->snapshot_ = true;
+
+        return config;
+    }
+    
     void Config::sanityCheck() const
     {
         if(getImpl()->sanity_ == SANITY_SANE) return;
@@ -706,7 +1075,7 @@ OCIO_NAMESPACE_ENTER
     {
         getImpl()->description_ = description;
         
-        AutoMutex lock(getImpl()->cacheidMutex_);
+        AutoExclusiveLock lock(getImpl()->cacheidMutex_);
         getImpl()->resetCacheIDs();
     }
     
@@ -731,7 +1100,7 @@ OCIO_NAMESPACE_ENTER
             if(iter != getImpl()->env_.end()) getImpl()->env_.erase(iter);
         }
         
-        AutoMutex lock(getImpl()->cacheidMutex_);
+        AutoExclusiveLock lock(getImpl()->cacheidMutex_);
         getImpl()->resetCacheIDs();
     }
     
@@ -758,7 +1127,7 @@ OCIO_NAMESPACE_ENTER
         getImpl()->env_.clear();
         getImpl()->context_->clearStringVars();
         
-        AutoMutex lock(getImpl()->cacheidMutex_);
+        AutoExclusiveLock lock(getImpl()->cacheidMutex_);
         getImpl()->resetCacheIDs();
     }
     
@@ -766,7 +1135,7 @@ OCIO_NAMESPACE_ENTER
     {
         getImpl()->context_->setEnvironmentMode(mode);
         
-        AutoMutex lock(getImpl()->cacheidMutex_);
+        AutoExclusiveLock lock(getImpl()->cacheidMutex_);
         getImpl()->resetCacheIDs();
     }
     
@@ -779,7 +1148,7 @@ OCIO_NAMESPACE_ENTER
     {
         getImpl()->context_->loadEnvironment();
         
-        AutoMutex lock(getImpl()->cacheidMutex_);
+        AutoExclusiveLock lock(getImpl()->cacheidMutex_);
         getImpl()->resetCacheIDs();
     }
     
@@ -792,7 +1161,7 @@ OCIO_NAMESPACE_ENTER
     {
         getImpl()->context_->setSearchPath(path);
         
-        AutoMutex lock(getImpl()->cacheidMutex_);
+        AutoExclusiveLock lock(getImpl()->cacheidMutex_);
         getImpl()->resetCacheIDs();
     }
     
@@ -810,7 +1179,7 @@ OCIO_NAMESPACE_ENTER
     {
         getImpl()->context_->clearSearchPaths();
 
-        AutoMutex lock(getImpl()->cacheidMutex_);
+        AutoExclusiveLock lock(getImpl()->cacheidMutex_);
         getImpl()->resetCacheIDs();
     }
 
@@ -818,7 +1187,7 @@ OCIO_NAMESPACE_ENTER
     {
         getImpl()->context_->addSearchPath(path);
 
-        AutoMutex lock(getImpl()->cacheidMutex_);
+        AutoExclusiveLock lock(getImpl()->cacheidMutex_);
         getImpl()->resetCacheIDs();
     }
 
@@ -831,7 +1200,7 @@ OCIO_NAMESPACE_ENTER
     {
         getImpl()->context_->setWorkingDir(dirname);
         
-        AutoMutex lock(getImpl()->cacheidMutex_);
+        AutoExclusiveLock lock(getImpl()->cacheidMutex_);
         getImpl()->resetCacheIDs();
     }
     
@@ -910,7 +1279,7 @@ OCIO_NAMESPACE_ENTER
     {
         getImpl()->colorspaces_->addColorSpace(original);
         
-        AutoMutex lock(getImpl()->cacheidMutex_);
+        AutoExclusiveLock lock(getImpl()->cacheidMutex_);
         getImpl()->resetCacheIDs();
     }
 
@@ -918,7 +1287,7 @@ OCIO_NAMESPACE_ENTER
     {
         getImpl()->colorspaces_->removeColorSpace(name);
         
-        AutoMutex lock(getImpl()->cacheidMutex_);
+        AutoExclusiveLock lock(getImpl()->cacheidMutex_);
         getImpl()->resetCacheIDs();
     }
 
@@ -926,7 +1295,7 @@ OCIO_NAMESPACE_ENTER
     {
         getImpl()->colorspaces_->clearColorSpaces();
         
-        AutoMutex lock(getImpl()->cacheidMutex_);
+        AutoExclusiveLock lock(getImpl()->cacheidMutex_);
         getImpl()->resetCacheIDs();
     }
     
@@ -1008,7 +1377,7 @@ OCIO_NAMESPACE_ENTER
     {
         getImpl()->strictParsing_ = enabled;
         
-        AutoMutex lock(getImpl()->cacheidMutex_);
+        AutoExclusiveLock lock(getImpl()->cacheidMutex_);
         getImpl()->resetCacheIDs();
     }
     
@@ -1030,7 +1399,7 @@ OCIO_NAMESPACE_ENTER
             }
         }
         
-        AutoMutex lock(getImpl()->cacheidMutex_);
+        AutoExclusiveLock lock(getImpl()->cacheidMutex_);
         getImpl()->resetCacheIDs();
     }
     
@@ -1112,7 +1481,7 @@ OCIO_NAMESPACE_ENTER
         
         if(!display) return 0;
         
-        DisplayMap::const_iterator iter = find_display_const(getImpl()->displays_, display);
+        DisplayMap::const_iterator iter = getImpl()->findDisplay(display);
         if(iter == getImpl()->displays_.end()) return 0;
         
         const ViewVec & views = iter->second;
@@ -1159,7 +1528,7 @@ OCIO_NAMESPACE_ENTER
         
         if(!display) return "";
         
-        DisplayMap::const_iterator iter = find_display_const(getImpl()->displays_, display);
+        DisplayMap::const_iterator iter = getImpl()->findDisplay(display);
         if(iter == getImpl()->displays_.end()) return "";
         
         const ViewVec & views = iter->second;
@@ -1210,7 +1579,7 @@ OCIO_NAMESPACE_ENTER
     {
         if(!display || !view) return "";
         
-        DisplayMap::const_iterator iter = find_display_const(getImpl()->displays_, display);
+        DisplayMap::const_iterator iter = getImpl()->findDisplay(display);
         if(iter == getImpl()->displays_.end()) return "";
         
         const ViewVec & views = iter->second;
@@ -1224,7 +1593,7 @@ OCIO_NAMESPACE_ENTER
     {
         if(!display || !view) return "";
         
-        DisplayMap::const_iterator iter = find_display_const(getImpl()->displays_, display);
+        DisplayMap::const_iterator iter = getImpl()->findDisplay(display);
         if(iter == getImpl()->displays_.end()) return "";
         
         const ViewVec & views = iter->second;
@@ -1242,18 +1611,21 @@ OCIO_NAMESPACE_ENTER
         
         AddDisplay(getImpl()->displays_,
                    display, view, colorSpaceName, lookName);
+        // Note that an existing display (i.e. ignoring the case) keeps its key.
+        getImpl()->displayIndex_.emplace(display, display);
         getImpl()->displayCache_.clear();
         
-        AutoMutex lock(getImpl()->cacheidMutex_);
+        AutoExclusiveLock lock(getImpl()->cacheidMutex_);
         getImpl()->resetCacheIDs();
     }
     
     void Config::clearDisplays()
     {
         getImpl()->displays_.clear();
+        getImpl()->displayIndex_.clear();
         getImpl()->displayCache_.clear();
         
-        AutoMutex lock(getImpl()->cacheidMutex_);
+        AutoExclusiveLock lock(getImpl()->cacheidMutex_);
         getImpl()->resetCacheIDs();
     }
     
@@ -1264,12 +1636,17 @@ OCIO_NAMESPACE_ENTER
         
         getImpl()->displayCache_.clear();
         
-        AutoMutex lock(getImpl()->cacheidMutex_);
+        AutoExclusiveLock lock(getImpl()->cacheidMutex_);
         getImpl()->resetCacheIDs();
     }
 
     const char * Config::getActiveDisplays() const
     {
+        if(getImpl()->snapshot_)
+        {
+            return getImpl()->activeDisplaysStr_.c_str();
+        }
+
         getImpl()->activeDisplaysStr_ = JoinStringEnvStyle(getImpl()->activeDisplays_);
         return getImpl()->activeDisplaysStr_.c_str();
     }
@@ -1281,12 +1658,17 @@ OCIO_NAMESPACE_ENTER
         
         getImpl()->displayCache_.clear();
         
-        AutoMutex lock(getImpl()->cacheidMutex_);
+        AutoExclusiveLock lock(getImpl()->cacheidMutex_);
         getImpl()->resetCacheIDs();
     }
 
     const char * Config::getActiveViews() const
     {
+        if(getImpl()->snapshot_)
+        {
+            return getImpl()->activeViewsStr_.c_str();
+        }
+
         getImpl()->activeViewsStr_ = JoinStringEnvStyle(getImpl()->activeViews_);
         return getImpl()->activeViewsStr_.c_str();
     }
@@ -1303,7 +1685,7 @@ OCIO_NAMESPACE_ENTER
     {
         memcpy(&getImpl()->defaultLumaCoefs_[0], c3, 3*sizeof(double));
         
-        AutoMutex lock(getImpl()->cacheidMutex_);
+        AutoExclusiveLock lock(getImpl()->cacheidMutex_);
         getImpl()->resetCacheIDs();
     }
     
@@ -1317,14 +1699,12 @@ OCIO_NAMESPACE_ENTER
     
     ConstLookRcPtr Config::getLook(const char * name) const
     {
-        std::string namelower = pystring::lower(name);
-        
-        for(unsigned int i=0; i<getImpl()->looksList_.size(); ++i)
+        if(!name) return ConstLookRcPtr();
+
+        const auto it = getImpl()->lookIndex_.find(name);
+        if(it != getImpl()->lookIndex_.end())
         {
-            if(pystring::lower(getImpl()->looksList_[i]->getName()) == namelower)
-            {
-                return getImpl()->looksList_[i];
-            }
+            return getImpl()->looksList_[it->second];
         }
         
         return ConstLookRcPtr();
@@ -1351,30 +1731,29 @@ OCIO_NAMESPACE_ENTER
         if(name.empty())
             throw Exception("Cannot addLook with an empty name.");
         
-        std::string namelower = pystring::lower(name);
-        
         // If the look exists, replace it
-        for(unsigned int i=0; i<getImpl()->looksList_.size(); ++i)
+        const auto it = getImpl()->lookIndex_.find(name);
+        if(it != getImpl()->lookIndex_.end())
         {
-            if(pystring::lower(getImpl()->looksList_[i]->getName()) == namelower)
-            {
-                getImpl()->looksList_[i] = look->createEditableCopy();
-                return;
-            }
+            getImpl()->looksList_[it->second] = look->createEditableCopy();
         }
-        
         // Otherwise, add it
-        getImpl()->looksList_.push_back(look->createEditableCopy());
+        else
+        {
+            getImpl()->looksList_.push_back(look->createEditableCopy());
+            getImpl()->lookIndex_.emplace(name, getImpl()->looksList_.size() - 1);
+        }
         
-        AutoMutex lock(getImpl()->cacheidMutex_);
+        AutoExclusiveLock lock(getImpl()->cacheidMutex_);
         getImpl()->resetCacheIDs();
     }
     
     void Config::clearLooks()
     {
         getImpl()->looksList_.clear();
+        getImpl()->lookIndex_.clear();
         
-        AutoMutex lock(getImpl()->cacheidMutex_);
+        AutoExclusiveLock lock(getImpl()->cacheidMutex_);
         getImpl()->resetCacheIDs();
     }
     
@@ -1401,11 +1780,23 @@ OCIO_NAMESPACE_ENTER
         {
             throw Exception("Config::GetProcessor failed. Destination colorspace is null.");
         }
-        
-        ProcessorRcPtr processor = Processor::Create();
-        processor->getImpl()->setColorSpaceConversion(*this, context, src, dst);
-        processor->getImpl()->computeMetadata();
-        return processor;
+
+        // Only the color spaces of the config are identified by their names.
+        std::string key;
+        if(getColorSpace(src->getName()).get() == src.get()
+            && getColorSpace(dst->getName()).get() == dst.get())
+        {
+            key = GetProcessorCacheKey(context, "ColorSpaces", { src->getName(), dst->getName() });
+        }
+
+        return getImpl()->getCachedProcessor(*this, context, key,
+            [&](bool & canCache)
+            {
+                ProcessorRcPtr processor = Processor::Create();
+                processor->getImpl()->setColorSpaceConversion(*this, context, src, dst);
+                canCache = !processor->getImpl()->isDynamic();
+                return processor;
+            });
     }
     
     ConstProcessorRcPtr Config::getProcessor(const char * srcName,
@@ -1438,6 +1829,27 @@ OCIO_NAMESPACE_ENTER
         
         return getProcessor(context, src, dst);
     }
+
+    ConstProcessorRcPtr Config::tryGetProcessor(const char * srcName,
+                                                const char * dstName) const
+    {
+        ConstContextRcPtr context = getCurrentContext();
+        return tryGetProcessor(context, srcName, dstName);
+    }
+
+    ConstProcessorRcPtr Config::tryGetProcessor(const ConstContextRcPtr & context,
+                                                const char * srcName,
+                                                const char * dstName) const
+    {
+        ConstColorSpaceRcPtr src = getColorSpace(srcName);
+        ConstColorSpaceRcPtr dst = getColorSpace(dstName);
+        if(!src || !dst)
+        {
+            return ConstProcessorRcPtr();
+        }
+
+        return getProcessor(context, src, dst);
+    }
     
     
     ConstProcessorRcPtr Config::getProcessor(const ConstTransformRcPtr& transform) const
@@ -1457,10 +1869,151 @@ OCIO_NAMESPACE_ENTER
                                              const ConstTransformRcPtr& transform,
                                              TransformDirection direction) const
     {
-        ProcessorRcPtr processor = Processor::Create();
-        processor->getImpl()->setTransform(*this, context, transform, direction);
-        processor->getImpl()->computeMetadata();
-        return processor;
+        // Only the transforms fully identified by names (i.e. with no LUT values to
+        // compare) are cached.
+        std::string key;
+        if(transform)
+        {
+            const TransformDirection dir
+                = CombineTransformDirections(direction, transform->getDirection());
+
+            if(ConstColorSpaceTransformRcPtr csTransform
+                = DynamicPtrCast<const ColorSpaceTransform>(transform))
+            {
+                key = GetProcessorCacheKey(context, "ColorSpaceTransform",
+                                           { csTransform->getSrc(),
+                                             csTransform->getDst(),
+                                             TransformDirectionToString(dir) });
+            }
+            else if(ConstDisplayTransformRcPtr displayTransform
+                = DynamicPtrCast<const DisplayTransform>(transform))
+            {
+                if(!displayTransform->getLinearCC() && !displayTransform->getColorTimingCC()
+                    && !displayTransform->getChannelView() && !displayTransform->getDisplayCC())
+                {
+                    key = GetProcessorCacheKey(context, "DisplayTransform",
+                                               { displayTransform->getInputColorSpaceName(),
+                                                 displayTransform->getDisplay(),
+                                                 displayTransform->getView(),
+                                                 displayTransform->getLooksOverride(),
+                                                 displayTransform->getLooksOverrideEnabled()
+                                                     ? "1" : "0",
+                                                 TransformDirectionToString(dir) });
+                }
+            }
+            else if(ConstLookTransformRcPtr lookTransform
+                = DynamicPtrCast<const LookTransform>(transform))
+            {
+                key = GetProcessorCacheKey(context, "LookTransform",
+                                           { lookTransform->getSrc(),
+                                             lookTransform->getDst(),
+                                             lookTransform->getLooks(),
+                                             TransformDirectionToString(dir) });
+            }
+        }
+
+        return getImpl()->getCachedProcessor(*this, context, key,
+            [&](bool & canCache)
+            {
+                ProcessorRcPtr processor = Processor::Create();
+                processor->getImpl()->setTransform(*this, context, transform, direction);
+                canCache = !processor->getImpl()->isDynamic();
+                return processor;
+            });
+    }
+
+    void Config::preloadFiles(const ConstContextRcPtr & context, unsigned numThreads) const
+    {
+        ConstTransformVec allTransforms;
+        getImpl()->getAllInternalTransforms(allTransforms);
+
+        std::set<std::string> files;
+        for(const auto & transform : allTransforms)
+        {
+            GetFileReferences(files, transform);
+        }
+
+        std::vector<std::string> filepaths;
+        filepaths.reserve(files.size());
+        for(const auto & file : files)
+        {
+            if(file.empty()) continue;
+
+            const char * filepath = context->tryResolveFileLocation(file.c_str());
+            if(filepath)
+            {
+                filepaths.push_back(filepath);
+            }
+            else
+            {
+                LogDebug(std::string("Preloading skipped: '") + file + "' could not be located.");
+            }
+        }
+
+        if(filepaths.empty()) return;
+
+        if(numThreads == 0)
+        {
+            numThreads = std::max(std::thread::hardware_concurrency(), 1u);
+        }
+        numThreads = std::min(numThreads, unsigned(filepaths.size()));
+
+        // The loading is mostly waiting for the file reads, so the CPU thread pool
+        // is not used.
+        ThreadPool pool(numThreads);
+        pool.parallelFor(long(filepaths.size()), [&filepaths](long idx)
+        {
+            std::string errorText;
+            if(!TryLoadFile(filepaths[idx], errorText))
+            {
+                LogDebug(std::string("Preloading failed: ") + errorText);
+            }
+        });
+    }
+
+    ProcessorWarmupRcPtr Config::warmupProcessors(const ConstContextRcPtr & context,
+                                                  const char * srcColorSpaces,
+                                                  unsigned numThreads) const
+    {
+        StringVec sources;
+        SplitStringEnvStyle(sources, srcColorSpaces);
+        // An empty string gives an empty name.
+        sources.erase(std::remove(sources.begin(), sources.end(), std::string()), sources.end());
+        if(sources.empty())
+        {
+            sources.push_back(ROLE_SCENE_LINEAR);
+        }
+
+        // Note that the displays & views are listed by the calling thread as the
+        // display list is lazily computed.
+        std::vector<ProcessorWarmup::Impl::Task> tasks;
+        for(const auto & src : sources)
+        {
+            for(int i=0; i<getNumDisplays(); ++i)
+            {
+                const std::string display = getDisplay(i);
+                for(int j=0; j<getNumViews(display.c_str()); ++j)
+                {
+                    const std::string view = getView(display.c_str(), j);
+                    tasks.push_back([this, context, src, display, view]()
+                    {
+                        DisplayTransformRcPtr transform = DisplayTransform::Create();
+                        transform->setInputColorSpaceName(src.c_str());
+                        transform->setDisplay(display.c_str());
+                        transform->setView(view.c_str());
+
+                        ConstProcessorRcPtr processor
+                            = getProcessor(context, transform, TRANSFORM_DIR_FORWARD);
+                        processor->getDefaultCPUProcessor();
+                        processor->getDefaultGPUProcessor();
+                    });
+                }
+            }
+        }
+
+        ProcessorWarmupRcPtr warmup = ProcessorWarmup::Create();
+        warmup->getImpl()->start(std::move(tasks), numThreads);
+        return warmup;
     }
     
     std::ostream& operator<< (std::ostream& os, const Config& config)
@@ -1479,12 +2032,33 @@ OCIO_NAMESPACE_ENTER
     
     const char * Config::getCacheID(const ConstContextRcPtr & context) const
     {
-        AutoMutex lock(getImpl()->cacheidMutex_);
-        
         // A null context will use the empty cacheid
         std::string contextcacheid = "";
         if(context) contextcacheid = context->getCacheID();
+
+        if(getImpl()->snapshot_)
+        {
+            StringMap::const_iterator iter = getImpl()->snapshotCacheIDs_.find(contextcacheid);
+            if(iter != getImpl()->snapshotCacheIDs_.end())
+            {
+                return iter->second.c_str();
+            }
+        }
         
+        // Concurrent cache hits do not wait for each other.
+        {
+            AutoSharedLock lock(getImpl()->cacheidMutex_);
+
+            StringMap::const_iterator cacheiditer = getImpl()->cacheids_.find(contextcacheid);
+            if(cacheiditer != getImpl()->cacheids_.end())
+            {
+                return cacheiditer->second.c_str();
+            }
+        }
+
+        AutoExclusiveLock lock(getImpl()->cacheidMutex_);
+
+        // Another thread could have computed it in the meantime.
         StringMap::const_iterator cacheiditer = getImpl()->cacheids_.find(contextcacheid);
         if(cacheiditer != getImpl()->cacheids_.end())
         {
@@ -1565,6 +2139,8 @@ OCIO_NAMESPACE_ENTER
         cacheidnocontext_ = "";
         sanity_ = SANITY_UNKNOWN;
         sanitytext_ = "";
+
+        processorCache_.clear();
     }
     
     void Config::Impl::getAllInternalTransforms(ConstTransformVec & transformVec) const
@@ -1594,17 +2170,161 @@ OCIO_NAMESPACE_ENTER
         }
     
     }
-}
-OCIO_NAMESPACE_EXIT
 
-///////////////////////////////////////////////////////////////////////////////
+    ConstProcessorRcPtr Config::Impl::loadFromDiskCache(const Config & config,
+                                                        const ConstContextRcPtr & context,
+                                                        const std::string & key) const
+    {
+        const std::string filename = GetProcessorDiskCacheFilename(key);
+        if(filename.empty())
+        {
+            return ConstProcessorRcPtr();
+        }
+
+        std::ifstream is(filename.c_str(), std::ios_base::in | std::ios_base::binary);
+        if(!is)
+        {
+            return ConstProcessorRcPtr();
+        }
+
+        try
+        {
+            ProcessorRcPtr processor = Processor::Create();
+            processor->getImpl()->readFromDiskCache(config, context, is, filename);
+            return processor;
+        }
+        catch(std::exception & e)
+        {
+            OCIO_LOG_DEBUG("Could not read the processor cache file '" << filename << "': "
+                           << e.what());
+        }
+
+        return ConstProcessorRcPtr();
+    }
+
+    void Config::Impl::saveToDiskCache(const ConstProcessorRcPtr & processor,
+                                       const std::string & key) const
+    {
+        const std::string filename = GetProcessorDiskCacheFilename(key);
+        if(filename.empty())
+        {
+            return;
+        }
+
+        // Write a temporary file renamed once complete so that the concurrent readers
+        // (e.g. other processes sharing the directory) never see a partial file.
+        std::string tmpFilename;
+
+        try
+        {
+            std::ostringstream oss;
+            oss << filename << "." << std::random_device()() << ".tmp";
+            tmpFilename = oss.str();
+
+            {
+                std::ofstream os(tmpFilename.c_str(),
+                                 std::ios_base::out | std::ios_base::binary);
+                if(!os)
+                {
+                    throw Exception("Could not open the file.");
+                }
+
+                processor->getImpl()->writeToDiskCache(os);
+
+                os.close();
+                if(!os)
+                {
+                    throw Exception("Could not write the file.");
+                }
+            }
+
+            if(std::rename(tmpFilename.c_str(), filename.c_str()) != 0)
+            {
+                // Another thread or process could have written it in the meantime.
+                std::remove(tmpFilename.c_str());
+            }
+        }
+        catch(std::exception & e)
+        {
+            if(!tmpFilename.empty())
+            {
+                std::remove(tmpFilename.c_str());
+            }
+
+            OCIO_LOG_DEBUG("Could not write the processor cache file '" << filename << "': "
+                           << e.what());
+        }
+    }
+
+    ConstProcessorRcPtr Config::Impl::getCachedProcessor(
+        const Config & config,
+        const ConstContextRcPtr & context,
+        const std::string & key,
+        const std::function<ConstProcessorRcPtr(bool &)> & create) const
+    {
+        const bool useCache = !key.empty() && g_processorCacheSize != 0;
+        const bool useDiskCache = !key.empty() && IsProcessorDiskCacheEnabled();
+
+        bool canCache = useCache || useDiskCache;
+        if(!canCache)
+        {
+            return create(canCache);
+        }
+
+        ConstProcessorRcPtr processor;
+        unsigned generation = 0;
+        if(useCache)
+        {
+            processor = processorCache_.get(key);
+            if(processor)
+            {
+                return processor;
+            }
+
+            generation = processorCache_.getGeneration();
+        }
+
+        std::string diskKey;
+        if(useDiskCache)
+        {
+            diskKey = GetProcessorDiskCacheKey(config, context, key);
+            processor = loadFromDiskCache(config, context, diskKey);
+        }
+
+        if(!processor)
+        {
+            processor = create(canCache);
+            if(!canCache)
+            {
+                return processor;
+            }
+
+            if(useDiskCache)
+            {
+                saveToDiskCache(processor, diskKey);
+            }
+        }
+
+        if(useCache)
+        {
+            processorCache_.add(key, processor, generation);
+        }
+
+        return processor;
+    }
+}
+OCIO_NAMESPACE_EXIT
+
+///////////////////////////////////////////////////////////////////////////////
 
 #ifdef OCIO_UNIT_TEST
 
 #include "UnitTest.h"
 #include "UnitTestUtils.h"
 
+#include <chrono>
 #include <sys/stat.h>
+#include <thread>
 #include "pystring/pystring.h"
 namespace OCIO = OCIO_NAMESPACE;
 
@@ -4201,4 +4921,925 @@ OCIO_ADD_TEST(Config, add_color_space)
     OCIO_CHECK_EQUAL(config->getNumColorSpaces(), 0);
 }
 
+OCIO_ADD_TEST(Config, shared_color_space_ops)
+{
+    static const std::string PROFILE =
+        "ocio_profile_version: 2\n"
+        "\n"
+        "roles:\n"
+        "  default: raw\n"
+        "\n"
+        "colorspaces:\n"
+        "  - !<ColorSpace>\n"
+        "    name: raw\n"
+        "\n"
+        "  - !<ColorSpace>\n"
+        "    name: src\n"
+        "    to_reference: !<GroupTransform>\n"
+        "      children:\n"
+        "        - !<LogTransform> {base: 10, direction: inverse}\n"
+        "        - !<MatrixTransform> {matrix: [0.8, 0.1, 0.1, 0, 0.1, 0.8, 0.1, 0,"
+                   " 0.1, 0.1, 0.8, 0, 0, 0, 0, 1]}\n"
+        "\n"
+        "  - !<ColorSpace>\n"
+        "    name: dst1\n"
+        "    from_reference: !<ExponentTransform> {value: [2.2, 2.2, 2.2, 1]}\n"
+        "\n"
+        "  - !<ColorSpace>\n"
+        "    name: dst2\n"
+        "    to_reference: !<MatrixTransform> {offset: [0.1, 0.2, 0.3, 0]}\n"
+        "\n"
+        "  - !<ColorSpace>\n"
+        "    name: dyn\n"
+        "    from_reference: !<ExposureContrastTransform> {style: video,"
+                   " exposure: {value: 1.5, dynamic: true}, contrast: 0.5}\n";
+
+    std::istringstream is;
+    is.str(PROFILE);
+    OCIO::ConstConfigRcPtr config;
+    OCIO_CHECK_NO_THROW(config = OCIO::Config::CreateFromStream(is));
+
+    OCIO::ClearAllCaches();
+
+    OCIO::ConstContextRcPtr context = config->getCurrentContext();
+
+    OCIO::OpRcPtrVec ops1;
+    OCIO_CHECK_NO_THROW(OCIO::BuildColorSpaceOps(ops1, *config, context,
+                                                 config->getColorSpace("src"),
+                                                 config->getColorSpace("dst1")));
+    OCIO::OpRcPtrVec ops2;
+    OCIO_CHECK_NO_THROW(OCIO::BuildColorSpaceOps(ops2, *config, context,
+                                                 config->getColorSpace("src"),
+                                                 config->getColorSpace("dst2")));
+
+    // Allocation, log, matrix, exponent (or inverse matrix), allocation.
+    OCIO_REQUIRE_EQUAL(ops1.size(), 5);
+    OCIO_REQUIRE_EQUAL(ops2.size(), 5);
+
+    // The ops going to the reference space are shared.
+    OCIO_CHECK_ASSERT(ops1[1] == ops2[1]);
+    OCIO_CHECK_ASSERT(ops1[2] == ops2[2]);
+    OCIO_CHECK_ASSERT(ops1[1]->isShared());
+    OCIO_CHECK_ASSERT(ops1[3]->isShared());
+    OCIO_CHECK_ASSERT(ops1[3] != ops2[3]);
+
+    // The dynamic ops are never shared.
+    OCIO::OpRcPtrVec ops3;
+    OCIO_CHECK_NO_THROW(OCIO::BuildColorSpaceOps(ops3, *config, context,
+                                                 config->getColorSpace("src"),
+                                                 config->getColorSpace("dyn")));
+    OCIO::OpRcPtrVec ops4;
+    OCIO_CHECK_NO_THROW(OCIO::BuildColorSpaceOps(ops4, *config, context,
+                                                 config->getColorSpace("src"),
+                                                 config->getColorSpace("dyn")));
+    OCIO_REQUIRE_EQUAL(ops3.size(), 5);
+    OCIO_REQUIRE_EQUAL(ops4.size(), 5);
+    OCIO_CHECK_ASSERT(ops3[1] == ops4[1]);
+    OCIO_CHECK_ASSERT(ops3[3] != ops4[3]);
+    OCIO_CHECK_ASSERT(!ops3[3]->isShared());
+
+    // A non-exact finalization never modifies the shared ops.
+    const std::string cacheID = ops1[1]->getCacheID();
+    OCIO::OpRcPtrVec ops5 = ops1;
+    OCIO_CHECK_NO_THROW(OCIO::FinalizeOpVec(ops5, OCIO::FINALIZATION_FAST));
+    OCIO_CHECK_ASSERT(ops5[1] != ops1[1]);
+    OCIO_CHECK_ASSERT(!ops5[1]->isShared());
+    OCIO_CHECK_EQUAL(ops1[1]->getCacheID(), cacheID);
+
+    // An exact finalization simply keeps them.
+    ops5 = ops1;
+    OCIO_CHECK_NO_THROW(OCIO::FinalizeOpVec(ops5, OCIO::FINALIZATION_EXACT));
+    OCIO_CHECK_ASSERT(ops5[1] == ops1[1]);
+
+    // The processors using the shared ops are unchanged.
+    const float src[4] = { 0.5f, 0.4f, 0.3f, 1.0f };
+
+    OCIO::ConstCPUProcessorRcPtr cpu;
+    OCIO_CHECK_NO_THROW(cpu = config->getProcessor("src", "dst1")->getDefaultCPUProcessor());
+    float cached[4] = { src[0], src[1], src[2], src[3] };
+    cpu->applyRGBA(cached);
+
+    OCIO::ClearAllCaches();
+
+    OCIO::OpRcPtrVec ops6;
+    OCIO_CHECK_NO_THROW(OCIO::BuildColorSpaceOps(ops6, *config, context,
+                                                 config->getColorSpace("src"),
+                                                 config->getColorSpace("dst1")));
+    OCIO_REQUIRE_EQUAL(ops6.size(), 5);
+    OCIO_CHECK_ASSERT(ops6[1] != ops1[1]);
+
+    OCIO_CHECK_NO_THROW(cpu = config->getProcessor("src", "dst1")->getDefaultCPUProcessor());
+    float rebuilt[4] = { src[0], src[1], src[2], src[3] };
+    cpu->applyRGBA(rebuilt);
+
+    for (unsigned idx = 0; idx < 4; ++idx)
+    {
+        OCIO_CHECK_EQUAL(cached[idx], rebuilt[idx]);
+    }
+}
+
+OCIO_ADD_TEST(Config, shared_color_space_ops_contexts)
+{
+    static const std::string PROFILE =
+        "ocio_profile_version: 2\n"
+        "\n"
+        "roles:\n"
+        "  default: raw\n"
+        "\n"
+        "colorspaces:\n"
+        "  - !<ColorSpace>\n"
+        "    name: raw\n"
+        "\n"
+        "  - !<ColorSpace>\n"
+        "    name: hub\n"
+        "    to_reference: !<MatrixTransform> {offset: [0.1, 0.2, 0.3, 0]}\n"
+        "\n"
+        "  - !<ColorSpace>\n"
+        "    name: lut\n"
+        "    from_reference: !<FileTransform> {src: lut1d_$SHOT.spi1d, interpolation: linear}\n";
+
+    std::istringstream is;
+    is.str(PROFILE);
+    OCIO::ConstConfigRcPtr config;
+    OCIO_CHECK_NO_THROW(config = OCIO::Config::CreateFromStream(is));
+    OCIO::ConfigRcPtr editableConfig = config->createEditableCopy();
+    editableConfig->setSearchPath(OCIO::getTestFilesDir());
+    config = editableConfig;
+
+    OCIO::ClearAllCaches();
+
+    // Two contexts (e.g. for two shots) with different cache ids and LUT files.
+    OCIO::ContextRcPtr context1 = config->getCurrentContext()->createEditableCopy();
+    context1->setStringVar("SHOT", "1");
+    OCIO::ContextRcPtr context2 = context1->createEditableCopy();
+    context2->setStringVar("SHOT", "2");
+    OCIO_REQUIRE_ASSERT(std::string(context1->getCacheID())
+                            != std::string(context2->getCacheID()));
+
+    OCIO::OpRcPtrVec ops1;
+    OCIO_CHECK_NO_THROW(OCIO::BuildColorSpaceOps(ops1, *config, context1,
+                                                 config->getColorSpace("hub"),
+                                                 config->getColorSpace("lut")));
+    OCIO::OpRcPtrVec ops2;
+    OCIO_CHECK_NO_THROW(OCIO::BuildColorSpaceOps(ops2, *config, context2,
+                                                 config->getColorSpace("hub"),
+                                                 config->getColorSpace("lut")));
+
+    // Allocation, matrix, file no-op, 1D LUT, allocation.
+    OCIO_REQUIRE_EQUAL(ops1.size(), 5);
+    OCIO_REQUIRE_EQUAL(ops2.size(), 5);
+
+    // The ops of the color space without file references are shared by all the contexts.
+    OCIO_CHECK_ASSERT(ops1[1] == ops2[1]);
+    OCIO_CHECK_ASSERT(ops1[1]->isShared());
+
+    // The ops depending on the context are not.
+    OCIO_CHECK_ASSERT(ops1[3]->isShared());
+    OCIO_CHECK_ASSERT(ops1[3] != ops2[3]);
+}
+
+OCIO_ADD_TEST(Config, shared_look_ops)
+{
+    static const std::string PROFILE =
+        "ocio_profile_version: 2\n"
+        "\n"
+        "roles:\n"
+        "  default: raw\n"
+        "  scene_linear: raw\n"
+        "\n"
+        "displays:\n"
+        "  disp:\n"
+        "    - !<View> {name: view, colorspace: dst, looks: look1}\n"
+        "\n"
+        "looks:\n"
+        "  - !<Look>\n"
+        "    name: look1\n"
+        "    process_space: log\n"
+        "    transform: !<CDLTransform> {slope: [2, 2, 2]}\n"
+        "\n"
+        "  - !<Look>\n"
+        "    name: look2\n"
+        "    process_space: log\n"
+        "    transform: !<ExponentTransform> {value: [2, 2, 2, 1]}\n"
+        "\n"
+        "colorspaces:\n"
+        "  - !<ColorSpace>\n"
+        "    name: raw\n"
+        "\n"
+        "  - !<ColorSpace>\n"
+        "    name: log\n"
+        "    from_reference: !<LogTransform> {base: 10}\n"
+        "\n"
+        "  - !<ColorSpace>\n"
+        "    name: dst\n"
+        "    from_reference: !<ExponentTransform> {value: [2.2, 2.2, 2.2, 1]}\n";
+
+    std::istringstream is;
+    is.str(PROFILE);
+    OCIO::ConstConfigRcPtr config;
+    OCIO_CHECK_NO_THROW(config = OCIO::Config::CreateFromStream(is));
+
+    OCIO::ClearAllCaches();
+
+    OCIO::ConstContextRcPtr context = config->getCurrentContext();
+
+    OCIO::LookParseResult looks;
+    looks.parse("look1");
+
+    OCIO::ConstColorSpaceRcPtr cs1 = config->getColorSpace("raw");
+    OCIO::OpRcPtrVec ops1;
+    OCIO_CHECK_NO_THROW(OCIO::BuildLookOps(ops1, cs1, false, *config, context, looks));
+    OCIO_REQUIRE_ASSERT(cs1);
+    OCIO_CHECK_EQUAL(std::string(cs1->getName()), "log");
+    OCIO_CHECK_ASSERT(OCIO::GetCacheMemoryUsage(OCIO::CACHE_LOOK_OPS) > 0);
+
+    OCIO::ConstColorSpaceRcPtr cs2 = config->getColorSpace("raw");
+    OCIO::OpRcPtrVec ops2;
+    OCIO_CHECK_NO_THROW(OCIO::BuildLookOps(ops2, cs2, false, *config, context, looks));
+    OCIO_CHECK_ASSERT(cs1 == cs2);
+
+    // The op chain of the look is shared.
+    OCIO_REQUIRE_ASSERT(!ops1.empty());
+    OCIO_REQUIRE_EQUAL(ops1.size(), ops2.size());
+    for (size_t idx = 0; idx < ops1.size(); ++idx)
+    {
+        OCIO_CHECK_ASSERT(ops1[idx] == ops2[idx]);
+        OCIO_CHECK_ASSERT(ops1[idx]->isShared());
+    }
+
+    // Another look, or skipping the color space conversions, is another op chain.
+    OCIO::LookParseResult otherLooks;
+    otherLooks.parse("look2");
+    OCIO::ConstColorSpaceRcPtr cs3 = config->getColorSpace("raw");
+    OCIO::OpRcPtrVec ops3;
+    OCIO_CHECK_NO_THROW(OCIO::BuildLookOps(ops3, cs3, false, *config, context, otherLooks));
+    OCIO_REQUIRE_ASSERT(!ops3.empty());
+    OCIO_CHECK_ASSERT(ops3.back() != ops1.back());
+
+    OCIO::ConstColorSpaceRcPtr cs4 = config->getColorSpace("raw");
+    OCIO::OpRcPtrVec ops4;
+    OCIO_CHECK_NO_THROW(OCIO::BuildLookOps(ops4, cs4, true, *config, context, looks));
+    OCIO_CHECK_EQUAL(std::string(cs4->getName()), "raw");
+    OCIO_CHECK_ASSERT(ops4.size() < ops1.size());
+
+    // Toggling the look of a display transform (i.e. with a linear CC so the processor
+    // itself is not cached) gives the same results as rebuilding everything.
+    OCIO::DisplayTransformRcPtr display = OCIO::DisplayTransform::Create();
+    display->setInputColorSpaceName("raw");
+    display->setDisplay("disp");
+    display->setView("view");
+    OCIO::MatrixTransformRcPtr exposure = OCIO::MatrixTransform::Create();
+    const double slope[4] = { 1.5, 1.5, 1.5, 1.0 };
+    double m44[16];
+    double offset4[4];
+    OCIO::MatrixTransform::Scale(m44, offset4, slope);
+    exposure->setMatrix(m44);
+    display->setLinearCC(exposure);
+
+    // The exposed values are above 1 so the looks do not clamp their logs to 0.
+    const float src[4] = { 2.0f, 1.6f, 1.2f, 1.0f };
+
+    float cached[2][4];
+    for (int look = 0; look < 2; ++look)
+    {
+        display->setLooksOverride(look == 0 ? "look1" : "look2");
+        display->setLooksOverrideEnabled(true);
+
+        OCIO::ConstCPUProcessorRcPtr cpu;
+        OCIO_CHECK_NO_THROW(cpu = config->getProcessor(display)->getDefaultCPUProcessor());
+        std::copy(src, src + 4, cached[look]);
+        cpu->applyRGBA(cached[look]);
+    }
+    OCIO_CHECK_NE(cached[0][0], cached[1][0]);
+
+    for (int look = 0; look < 2; ++look)
+    {
+        OCIO::ClearAllCaches();
+
+        display->setLooksOverride(look == 0 ? "look1" : "look2");
+
+        OCIO::ConstCPUProcessorRcPtr cpu;
+        OCIO_CHECK_NO_THROW(cpu = config->getProcessor(display)->getDefaultCPUProcessor());
+        float rebuilt[4] = { src[0], src[1], src[2], src[3] };
+        cpu->applyRGBA(rebuilt);
+
+        for (unsigned idx = 0; idx < 4; ++idx)
+        {
+            OCIO_CHECK_EQUAL(cached[look][idx], rebuilt[idx]);
+        }
+    }
+
+    // Stacking a look reuses the op chain of the looks already built and the parsed
+    // look string.
+    OCIO::ClearAllCaches();
+    OCIO::ResetCacheStatistics();
+
+    OCIO::ConstColorSpaceRcPtr cs5 = config->getColorSpace("raw");
+    OCIO::OpRcPtrVec ops5;
+    OCIO_CHECK_NO_THROW(OCIO::BuildLookOps(ops5, cs5, true, *config, context, looks));
+    OCIO_REQUIRE_ASSERT(!ops5.empty());
+
+    OCIO::LookParseResult stackedLooks;
+    stackedLooks.parse("look1, look2");
+    OCIO::ConstColorSpaceRcPtr cs6 = config->getColorSpace("raw");
+    OCIO::OpRcPtrVec ops6;
+    OCIO_CHECK_NO_THROW(OCIO::BuildLookOps(ops6, cs6, true, *config, context, stackedLooks));
+    OCIO_REQUIRE_ASSERT(ops6.size() > ops5.size());
+    for (size_t idx = 0; idx < ops5.size(); ++idx)
+    {
+        OCIO_CHECK_ASSERT(ops5[idx] == ops6[idx]);
+    }
+
+    // The complete look strings: 2 misses, look1: 1 miss & 1 hit, look2: 1 miss.
+    OCIO_CHECK_EQUAL(OCIO::GetCacheStatistic(OCIO::CACHE_LOOK_OPS,
+                                             OCIO::CACHE_STATISTIC_HITS), 1);
+    OCIO_CHECK_EQUAL(OCIO::GetCacheStatistic(OCIO::CACHE_LOOK_OPS,
+                                             OCIO::CACHE_STATISTIC_MISSES), 4);
+
+    stackedLooks.parse("look1, look2");
+    OCIO_CHECK_EQUAL(stackedLooks.getOptions().size(), 1);
+    OCIO_CHECK_EQUAL(stackedLooks.getOptions()[0].size(), 2);
+    OCIO_CHECK_EQUAL(OCIO::GetCacheStatistic(OCIO::CACHE_LOOK_PARSE,
+                                             OCIO::CACHE_STATISTIC_HITS), 1);
+    OCIO_CHECK_ASSERT(OCIO::GetCacheMemoryUsage(OCIO::CACHE_LOOK_PARSE) > 0);
+}
+
+OCIO_ADD_TEST(Config, processor_cache)
+{
+    static const std::string PROFILE =
+        "ocio_profile_version: 2\n"
+        "\n"
+        "roles:\n"
+        "  default: raw\n"
+        "\n"
+        "displays:\n"
+        "  sRGB:\n"
+        "    - !<View> {name: Log, colorspace: log}\n"
+        "\n"
+        "colorspaces:\n"
+        "  - !<ColorSpace>\n"
+        "    name: raw\n"
+        "\n"
+        "  - !<ColorSpace>\n"
+        "    name: log\n"
+        "    from_reference: !<LogTransform> {base: 10}\n"
+        "\n"
+        "  - !<ColorSpace>\n"
+        "    name: gamma\n"
+        "    from_reference: !<ExponentTransform> {value: [2.2, 2.2, 2.2, 1]}\n"
+        "\n"
+        "  - !<ColorSpace>\n"
+        "    name: dyn\n"
+        "    from_reference: !<ExposureContrastTransform> {style: video,"
+                   " exposure: {value: 1.5, dynamic: true}, contrast: 0.5}\n";
+
+    std::istringstream is;
+    is.str(PROFILE);
+    OCIO::ConstConfigRcPtr constConfig;
+    OCIO_CHECK_NO_THROW(constConfig = OCIO::Config::CreateFromStream(is));
+    OCIO::ConfigRcPtr config = constConfig->createEditableCopy();
+
+    OCIO_CHECK_EQUAL(OCIO::GetProcessorCacheSize(), 64);
+
+    // The same color spaces (or roles) return the same processor.
+    OCIO::ConstProcessorRcPtr proc1 = config->getProcessor("raw", "log");
+    OCIO_CHECK_ASSERT(proc1 == config->getProcessor("raw", "log"));
+    OCIO_CHECK_ASSERT(proc1 == config->getProcessor("default", "log"));
+    OCIO_CHECK_ASSERT(proc1 != config->getProcessor("raw", "gamma"));
+
+    // The non-throwing variant returns the same processor, or nothing for a missing name.
+    OCIO_CHECK_ASSERT(proc1 == config->tryGetProcessor("default", "log"));
+    OCIO::ConstProcessorRcPtr missing;
+    OCIO_CHECK_NO_THROW(missing = config->tryGetProcessor("raw", "missing"));
+    OCIO_CHECK_ASSERT(!missing);
+    OCIO_CHECK_NO_THROW(missing = config->tryGetProcessor("missing", "log"));
+    OCIO_CHECK_ASSERT(!missing);
+    OCIO_CHECK_THROW_WHAT(config->getProcessor("raw", "missing"), OCIO::Exception,
+                          "Could not find colorspace 'missing'");
+
+    // The equivalent transforms also return the same processor.
+    OCIO::ColorSpaceTransformRcPtr csTransform = OCIO::ColorSpaceTransform::Create();
+    csTransform->setSrc("raw");
+    csTransform->setDst("log");
+    OCIO::ConstProcessorRcPtr proc2 = config->getProcessor(csTransform);
+    OCIO_CHECK_ASSERT(proc2 == config->getProcessor(csTransform));
+    OCIO_CHECK_ASSERT(proc2 != config->getProcessor(csTransform, OCIO::TRANSFORM_DIR_INVERSE));
+
+    OCIO::DisplayTransformRcPtr displayTransform = OCIO::DisplayTransform::Create();
+    displayTransform->setInputColorSpaceName("raw");
+    displayTransform->setDisplay("sRGB");
+    displayTransform->setView("Log");
+    OCIO::ConstProcessorRcPtr proc3 = config->getProcessor(displayTransform);
+    OCIO_CHECK_ASSERT(proc3 == config->getProcessor(displayTransform));
+
+    OCIO::LookTransformRcPtr lookTransform = OCIO::LookTransform::Create();
+    lookTransform->setSrc("raw");
+    lookTransform->setDst("gamma");
+    lookTransform->setLooks("");
+    OCIO::ConstProcessorRcPtr proc5 = config->getProcessor(lookTransform);
+    OCIO_CHECK_ASSERT(proc5 == config->getProcessor(lookTransform));
+    lookTransform->setDst("log");
+    OCIO_CHECK_ASSERT(proc5 != config->getProcessor(lookTransform));
+
+    // Not with an embedded transform.
+    displayTransform->setLinearCC(OCIO::MatrixTransform::Create());
+    OCIO_CHECK_ASSERT(config->getProcessor(displayTransform)
+                        != config->getProcessor(displayTransform));
+
+    // A context change creates a new processor.
+    OCIO::ContextRcPtr context = config->getCurrentContext()->createEditableCopy();
+    context->setStringVar("SHOT", "01");
+    OCIO::ConstProcessorRcPtr proc4 = config->getProcessor(context, "raw", "log");
+    OCIO_CHECK_ASSERT(proc4 != proc1);
+    OCIO_CHECK_ASSERT(proc4 == config->getProcessor(context, "raw", "log"));
+
+    // The processors with dynamic properties are never shared.
+    OCIO_CHECK_ASSERT(config->getProcessor("raw", "dyn") != config->getProcessor("raw", "dyn"));
+
+    // A config change clears the cache.
+    OCIO_CHECK_NO_THROW(config->setRole("scene_linear", "raw"));
+    OCIO_CHECK_ASSERT(proc1 != config->getProcessor("raw", "log"));
+    proc1 = config->getProcessor("raw", "log");
+
+    // The copy of a config does not share its cache.
+    OCIO::ConfigRcPtr copy = config->createEditableCopy();
+    OCIO_CHECK_ASSERT(proc1 != copy->getProcessor("raw", "log"));
+
+    // Clearing all the caches also clears the processor caches.
+    OCIO::ClearAllCaches();
+    OCIO_CHECK_ASSERT(proc1 != config->getProcessor("raw", "log"));
+    proc1 = config->getProcessor("raw", "log");
+
+    // The cache is bounded i.e. the least recently used processor is removed.
+    OCIO_CHECK_NO_THROW(OCIO::SetProcessorCacheSize(2));
+    proc1 = config->getProcessor("raw", "log");
+    proc2 = config->getProcessor("raw", "gamma");
+    OCIO_CHECK_ASSERT(proc1 == config->getProcessor("raw", "log"));
+    proc3 = config->getProcessor("log", "gamma");
+    OCIO_CHECK_ASSERT(proc1 == config->getProcessor("raw", "log"));
+    OCIO_CHECK_ASSERT(proc2 != config->getProcessor("raw", "gamma"));
+
+    // The cache could be disabled.
+    OCIO_CHECK_NO_THROW(OCIO::SetProcessorCacheSize(0));
+    OCIO_CHECK_ASSERT(config->getProcessor("raw", "log") != config->getProcessor("raw", "log"));
+
+    OCIO::SetProcessorCacheSize(64);
+}
+
+OCIO_ADD_TEST(Config, processor_cache_file_changes)
+{
+    std::string filename;
+    OCIO_CHECK_NO_THROW(OCIO::Platform::CreateTempFilename(filename, ".cc"));
+
+    const auto writeFile = [&filename](const char * slope)
+    {
+        std::fstream stream(filename, std::ios_base::out|std::ios_base::trunc);
+        stream << "<ColorCorrection id=\"cc\">"
+               << "<SOPNode><Slope>" << slope << "</Slope>"
+               << "<Offset>0 0 0</Offset><Power>1 1 1</Power></SOPNode>"
+               << "</ColorCorrection>\n";
+        stream.close();
+    };
+
+    writeFile("2 2 2");
+
+    const std::string profile =
+        "ocio_profile_version: 2\n"
+        "\n"
+        "roles:\n"
+        "  default: raw\n"
+        "\n"
+        "colorspaces:\n"
+        "  - !<ColorSpace>\n"
+        "    name: raw\n"
+        "\n"
+        "  - !<ColorSpace>\n"
+        "    name: log\n"
+        "    from_reference: !<LogTransform> {base: 10}\n"
+        "\n"
+        "  - !<ColorSpace>\n"
+        "    name: file\n"
+        "    from_reference: !<FileTransform> {src: \"" + filename + "\"}\n";
+
+    std::istringstream is;
+    is.str(profile);
+    OCIO::ConstConfigRcPtr config;
+    OCIO_CHECK_NO_THROW(config = OCIO::Config::CreateFromStream(is));
+
+    OCIO::SetFileCacheCheckInterval(1);
+
+    OCIO::ConstProcessorRcPtr procLog = config->getProcessor("raw", "log");
+    OCIO::ConstProcessorRcPtr procFile = config->getProcessor("raw", "file");
+
+    float pixel[3] = { 0.25f, 0.25f, 0.25f };
+    procFile->getDefaultCPUProcessor()->applyRGB(pixel);
+    OCIO_CHECK_CLOSE(pixel[0], 0.5f, 1e-4f);
+
+    // The processors using unchanged files are kept.
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    OCIO_CHECK_ASSERT(procFile == config->getProcessor("raw", "file"));
+
+    // Only the processors using the changed file are created again (i.e. the size of the
+    // file also changes in case the file system has a coarse modification time).
+    writeFile("3.0 3.0 3.0");
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+    OCIO::ConstProcessorRcPtr procFile2 = config->getProcessor("raw", "file");
+    OCIO_CHECK_ASSERT(procFile != procFile2);
+    OCIO_CHECK_ASSERT(procFile2 == config->getProcessor("raw", "file"));
+    OCIO_CHECK_ASSERT(procLog == config->getProcessor("raw", "log"));
+
+    pixel[0] = pixel[1] = pixel[2] = 0.25f;
+    procFile2->getDefaultCPUProcessor()->applyRGB(pixel);
+    OCIO_CHECK_CLOSE(pixel[0], 0.75f, 1e-4f);
+
+    OCIO::SetFileCacheCheckInterval(0);
+}
+
+OCIO_ADD_TEST(Config, processor_metadata)
+{
+    // Without the processor cache, nothing requests the metadata when creating the
+    // processor so it is only computed by getProcessorMetadata().
+    OCIO::SetProcessorCacheSize(0);
+
+    OCIO::ConstProcessorRcPtr processor;
+    OCIO_CHECK_NO_THROW(processor = OCIO::GetFileTransformProcessor("lut1d_1.spi1d"));
+
+    OCIO::ConstProcessorMetadataRcPtr metadata;
+    OCIO_CHECK_NO_THROW(metadata = processor->getProcessorMetadata());
+    OCIO_REQUIRE_EQUAL(metadata->getNumFiles(), 1);
+    OCIO_CHECK_NE(std::string(metadata->getFile(0)).find("lut1d_1.spi1d"), std::string::npos);
+    OCIO_CHECK_EQUAL(metadata->getNumLooks(), 0);
+
+    // The metadata is only computed once.
+    OCIO_CHECK_EQUAL(processor->getProcessorMetadata().get(), metadata.get());
+
+    // The same metadata is computed when the processor is cached.
+    OCIO::SetProcessorCacheSize(64);
+
+    OCIO_CHECK_NO_THROW(processor = OCIO::GetFileTransformProcessor("lut1d_1.spi1d"));
+    OCIO_REQUIRE_EQUAL(processor->getProcessorMetadata()->getNumFiles(), 1);
+    OCIO_CHECK_EQUAL(std::string(processor->getProcessorMetadata()->getFile(0)),
+                     std::string(metadata->getFile(0)));
+}
+
+OCIO_ADD_TEST(Config, processor_disk_cache)
+{
+    static const std::string PROFILE =
+        "ocio_profile_version: 2\n"
+        "\n"
+        "roles:\n"
+        "  default: raw\n"
+        "\n"
+        "colorspaces:\n"
+        "  - !<ColorSpace>\n"
+        "    name: raw\n"
+        "\n"
+        "  - !<ColorSpace>\n"
+        "    name: log\n"
+        "    from_reference: !<LogTransform> {base: 10}\n"
+        "\n"
+        "  - !<ColorSpace>\n"
+        "    name: gamma\n"
+        "    from_reference: !<ExponentTransform> {value: [2.2, 2.2, 2.2, 1]}\n";
+
+    std::istringstream is;
+    is.str(PROFILE);
+    OCIO::ConstConfigRcPtr config;
+    OCIO_CHECK_NO_THROW(config = OCIO::Config::CreateFromStream(is));
+    OCIO::ConstContextRcPtr context = config->getCurrentContext();
+
+    std::string tmpFilename;
+    OCIO_CHECK_NO_THROW(OCIO::Platform::CreateTempFilename(tmpFilename, ""));
+    const std::string dir = pystring::os::path::dirname(tmpFilename);
+
+    OCIO_CHECK_EQUAL(std::string(OCIO::GetProcessorDiskCacheDir()), std::string(""));
+    OCIO::SetProcessorDiskCacheDir(dir.c_str());
+    OCIO_CHECK_EQUAL(std::string(OCIO::GetProcessorDiskCacheDir()), dir);
+
+    const auto getFilename = [&](const char * src, const char * dst)
+    {
+        const std::string key
+            = OCIO::GetProcessorCacheKey(context, "ColorSpaces", { src, dst });
+        return OCIO::GetProcessorDiskCacheFilename(
+            OCIO::GetProcessorDiskCacheKey(*config, context, key));
+    };
+
+    const std::string logFilename = getFilename("raw", "log");
+    const std::string gammaFilename = getFilename("raw", "gamma");
+    std::remove(logFilename.c_str());
+    std::remove(gammaFilename.c_str());
+
+    // Creating a processor saves it.
+    OCIO::ConstProcessorRcPtr procLog = config->getProcessor("raw", "log");
+    OCIO::ConstProcessorRcPtr procGamma = config->getProcessor("raw", "gamma");
+    OCIO_CHECK_ASSERT(std::ifstream(logFilename).good());
+    OCIO_CHECK_ASSERT(std::ifstream(gammaFilename).good());
+
+    // Without the processor cache, the processor is loaded from its file.
+    OCIO::SetProcessorCacheSize(0);
+
+    OCIO::ConstProcessorRcPtr proc = config->getProcessor("raw", "log");
+    OCIO_CHECK_ASSERT(proc != procLog);
+
+    float pixel1[3] = { 0.1f, 0.5f, 0.9f };
+    float pixel2[3] = { 0.1f, 0.5f, 0.9f };
+    procLog->getDefaultCPUProcessor()->applyRGB(pixel1);
+    proc->getDefaultCPUProcessor()->applyRGB(pixel2);
+    OCIO_CHECK_EQUAL(pixel1[0], pixel2[0]);
+    OCIO_CHECK_EQUAL(pixel1[1], pixel2[1]);
+    OCIO_CHECK_EQUAL(pixel1[2], pixel2[2]);
+
+    // Prove it by replacing the file of the log processor by the gamma one.
+    {
+        std::ifstream src(gammaFilename, std::ios_base::binary);
+        std::ofstream dst(logFilename, std::ios_base::binary | std::ios_base::trunc);
+        dst << src.rdbuf();
+    }
+
+    proc = config->getProcessor("raw", "log");
+
+    float pixel3[3] = { 0.1f, 0.5f, 0.9f };
+    float pixel4[3] = { 0.1f, 0.5f, 0.9f };
+    procGamma->getDefaultCPUProcessor()->applyRGB(pixel3);
+    proc->getDefaultCPUProcessor()->applyRGB(pixel4);
+    OCIO_CHECK_EQUAL(pixel3[0], pixel4[0]);
+    OCIO_CHECK_EQUAL(pixel3[1], pixel4[1]);
+    OCIO_CHECK_EQUAL(pixel3[2], pixel4[2]);
+
+    // An invalid file is ignored (i.e. the processor is created and saved again).
+    {
+        std::ofstream dst(logFilename, std::ios_base::binary | std::ios_base::trunc);
+        dst << "Not a processor";
+    }
+
+    OCIO::ConstProcessorRcPtr proc2;
+    OCIO_CHECK_NO_THROW(proc2 = config->getProcessor("raw", "log"));
+
+    float pixel5[3] = { 0.1f, 0.5f, 0.9f };
+    proc2->getDefaultCPUProcessor()->applyRGB(pixel5);
+    OCIO_CHECK_EQUAL(pixel1[0], pixel5[0]);
+
+    std::remove(logFilename.c_str());
+    std::remove(gammaFilename.c_str());
+
+    OCIO::SetProcessorDiskCacheDir(nullptr);
+    OCIO_CHECK_EQUAL(std::string(OCIO::GetProcessorDiskCacheDir()), std::string(""));
+    OCIO::SetProcessorCacheSize(64);
+}
+
+OCIO_ADD_TEST(Config, lazy_transform_loading)
+{
+    static const std::string PROFILE =
+        "ocio_profile_version: 2\n"
+        "\n"
+        "roles:\n"
+        "  default: raw\n"
+        "\n"
+        "colorspaces:\n"
+        "  - !<ColorSpace>\n"
+        "    name: raw\n"
+        "\n"
+        "  - !<ColorSpace>\n"
+        "    name: log\n"
+        "    from_reference: !<LogTransform> {base: 10}\n"
+        "\n"
+        "  - !<ColorSpace>\n"
+        "    name: bad\n"
+        "    from_reference: !<UnknownTransform> {}\n";
+
+    OCIO_CHECK_ASSERT(!OCIO::GetLazyTransformLoading());
+
+    {
+        std::istringstream is(PROFILE);
+        OCIO_CHECK_THROW_WHAT(OCIO::Config::CreateFromStream(is), OCIO::Exception,
+                              "Unsupported transform type !<UnknownTransform>");
+    }
+
+    OCIO::SetLazyTransformLoading(true);
+    OCIO_CHECK_ASSERT(OCIO::GetLazyTransformLoading());
+
+    OCIO::ConstConfigRcPtr config;
+    {
+        std::istringstream is(PROFILE);
+        OCIO_CHECK_NO_THROW(config = OCIO::Config::CreateFromStream(is));
+    }
+
+    OCIO::SetLazyTransformLoading(false);
+
+    // The transform is created on first use.
+    OCIO::ConstColorSpaceRcPtr cs = config->getColorSpace("log");
+    OCIO::ConstTransformRcPtr transform;
+    OCIO_CHECK_NO_THROW(transform = cs->getTransform(OCIO::COLORSPACE_DIR_FROM_REFERENCE));
+    OCIO_REQUIRE_ASSERT(transform);
+    OCIO_CHECK_ASSERT(OCIO::DynamicPtrCast<const OCIO::LogTransform>(transform));
+    OCIO_CHECK_ASSERT(!cs->getTransform(OCIO::COLORSPACE_DIR_TO_REFERENCE));
+    OCIO_CHECK_NO_THROW(config->getProcessor("raw", "log"));
+
+    // The errors are reported on first use, and on the next ones.
+    OCIO_CHECK_THROW_WHAT(config->getProcessor("raw", "bad"), OCIO::Exception,
+                          "Unsupported transform type !<UnknownTransform>");
+    OCIO_CHECK_THROW_WHAT(config->getProcessor("raw", "bad"), OCIO::Exception,
+                          "Unsupported transform type !<UnknownTransform>");
+
+    // A copy keeps the not yet loaded transforms.
+    OCIO::ConfigRcPtr copy = config->createEditableCopy();
+    OCIO_CHECK_NO_THROW(copy->getProcessor("raw", "log"));
+    OCIO_CHECK_THROW_WHAT(copy->getProcessor("raw", "bad"), OCIO::Exception,
+                          "Unsupported transform type !<UnknownTransform>");
+
+    // Setting a transform replaces its loader.
+    OCIO::ColorSpaceRcPtr bad = copy->getColorSpace("bad")->createEditableCopy();
+    bad->setTransform(OCIO::LogTransform::Create(), OCIO::COLORSPACE_DIR_FROM_REFERENCE);
+    copy->addColorSpace(bad);
+    OCIO_CHECK_NO_THROW(copy->getProcessor("raw", "bad"));
+}
+
+OCIO_ADD_TEST(Config, snapshot)
+{
+    static const std::string PROFILE =
+        "ocio_profile_version: 2\n"
+        "\n"
+        "search_path: " + std::string(OCIO::getTestFilesDir()) + "\n"
+        "\n"
+        "roles:\n"
+        "  default: raw\n"
+        "\n"
+        "displays:\n"
+        "  sRGB:\n"
+        "    - !<View> {name: Lut, colorspace: lut}\n"
+        "\n"
+        "active_displays: [sRGB]\n"
+        "\n"
+        "colorspaces:\n"
+        "  - !<ColorSpace>\n"
+        "    name: raw\n"
+        "\n"
+        "  - !<ColorSpace>\n"
+        "    name: lut\n"
+        "    from_reference: !<FileTransform> {src: lut1d_1.spi1d, interpolation: linear}\n";
+
+    OCIO::SetLazyTransformLoading(true);
+    OCIO::ConstConfigRcPtr config;
+    {
+        std::istringstream is(PROFILE);
+        OCIO_CHECK_NO_THROW(config = OCIO::Config::CreateFromStream(is));
+    }
+    OCIO::SetLazyTransformLoading(false);
+
+    OCIO::ConstConfigRcPtr snapshot;
+    OCIO_CHECK_NO_THROW(snapshot = config->createSnapshot());
+    OCIO_REQUIRE_ASSERT(snapshot);
+    OCIO_CHECK_ASSERT(snapshot.get() != config.get());
+
+    // The snapshot is identical to the original config.
+    const std::string cacheID = config->getCacheID();
+    OCIO_CHECK_EQUAL(cacheID, std::string(snapshot->getCacheID()));
+    OCIO_CHECK_EQUAL(std::string(config->getCacheID(OCIO::ConstContextRcPtr())),
+                     std::string(snapshot->getCacheID(OCIO::ConstContextRcPtr())));
+    OCIO_CHECK_EQUAL(std::string(config->getCurrentContext()->getCacheID()),
+                     std::string(snapshot->getCurrentContext()->getCacheID()));
+    OCIO_CHECK_EQUAL(snapshot->getNumDisplays(), 1);
+    OCIO_CHECK_EQUAL(std::string(snapshot->getActiveDisplays()), "sRGB");
+    OCIO_CHECK_NO_THROW(snapshot->sanityCheck());
+
+    // The file references are already resolved.
+    OCIO_CHECK_EQUAL(
+        std::string(snapshot->getCurrentContext()->resolveFileLocation("lut1d_1.spi1d")),
+        std::string(config->getCurrentContext()->resolveFileLocation("lut1d_1.spi1d")));
+
+    // Other contexts are still supported.
+    OCIO::ContextRcPtr context = snapshot->getCurrentContext()->createEditableCopy();
+    context->setStringVar("VAR", "value");
+    OCIO_CHECK_EQUAL(std::string(config->getCacheID(context)),
+                     std::string(snapshot->getCacheID(context)));
+    OCIO_CHECK_NO_THROW(snapshot->getProcessor(context, "raw", "lut"));
+
+    // Concurrent uses of the snapshot give the same results.
+    float expected[4] = { 0.1f, 0.5f, 0.9f, 1.0f };
+    OCIO_CHECK_NO_THROW(config->getProcessor("raw", "lut")
+                            ->getDefaultCPUProcessor()->applyRGBA(expected));
+
+    std::atomic<int> numFailures{ 0 };
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t)
+    {
+        threads.emplace_back([&snapshot, &expected, &cacheID, &numFailures]()
+        {
+            for (int i = 0; i < 20; ++i)
+            {
+                try
+                {
+                    float pixel[4] = { 0.1f, 0.5f, 0.9f, 1.0f };
+                    snapshot->getProcessor("raw", "lut")->getDefaultCPUProcessor()
+                        ->applyRGBA(pixel);
+                    if (pixel[0] != expected[0] || pixel[1] != expected[1]
+                        || pixel[2] != expected[2] || cacheID != snapshot->getCacheID())
+                    {
+                        ++numFailures;
+                    }
+                }
+                catch (...)
+                {
+                    ++numFailures;
+                }
+            }
+        });
+    }
+    for (auto & thread : threads)
+    {
+        thread.join();
+    }
+    OCIO_CHECK_EQUAL(numFailures, 0);
+
+    // A copy of the snapshot is editable.
+    OCIO::ConfigRcPtr copy;
+    OCIO_CHECK_NO_THROW(copy = snapshot->createEditableCopy());
+    OCIO_CHECK_NO_THROW(copy->setActiveDisplays(""));
+    OCIO_CHECK_EQUAL(std::string(copy->getActiveDisplays()), "");
+    OCIO_CHECK_EQUAL(std::string(snapshot->getActiveDisplays()), "sRGB");
+    OCIO_CHECK_NE(cacheID, std::string(copy->getCacheID()));
+    OCIO_CHECK_EQUAL(cacheID, std::string(snapshot->getCacheID()));
+}
+
+OCIO_ADD_TEST(Config, warmup_processors)
+{
+    static const std::string PROFILE =
+        "ocio_profile_version: 2\n"
+        "\n"
+        "roles:\n"
+        "  default: raw\n"
+        "  scene_linear: raw\n"
+        "\n"
+        "displays:\n"
+        "  sRGB:\n"
+        "    - !<View> {name: Log, colorspace: log}\n"
+        "    - !<View> {name: Gamma, colorspace: gamma}\n"
+        "  P3:\n"
+        "    - !<View> {name: Log, colorspace: log}\n"
+        "\n"
+        "active_displays: [sRGB]\n"
+        "\n"
+        "colorspaces:\n"
+        "  - !<ColorSpace>\n"
+        "    name: raw\n"
+        "\n"
+        "  - !<ColorSpace>\n"
+        "    name: log\n"
+        "    from_reference: !<LogTransform> {base: 10}\n"
+        "\n"
+        "  - !<ColorSpace>\n"
+        "    name: gamma\n"
+        "    from_reference: !<ExponentTransform> {value: [2.2, 2.2, 2.2, 1]}\n";
+
+    std::istringstream is(PROFILE);
+    OCIO::ConstConfigRcPtr config;
+    OCIO_CHECK_NO_THROW(config = OCIO::Config::CreateFromStream(is));
+
+    OCIO::ClearAllCaches();
+
+    // Only the active displays, and the scene_linear role by default.
+    OCIO::ProcessorWarmupRcPtr warmup;
+    OCIO_CHECK_NO_THROW(warmup = config->warmupProcessors(config->getCurrentContext(), "", 2));
+    OCIO_REQUIRE_ASSERT(warmup);
+    OCIO_CHECK_EQUAL(warmup->getNumProcessors(), 2);
+    OCIO_CHECK_NO_THROW(warmup->wait());
+    OCIO_CHECK_ASSERT(warmup->isDone());
+    OCIO_CHECK_EQUAL(warmup->getNumCompleted(), 2);
+    OCIO_CHECK_EQUAL(warmup->getNumFailures(), 0);
+    OCIO_CHECK_ASSERT(OCIO::GetCacheMemoryUsage(OCIO::CACHE_COLORSPACE_OPS) > 0);
+
+    // The warm processors give the same results.
+    OCIO::DisplayTransformRcPtr transform = OCIO::DisplayTransform::Create();
+    transform->setInputColorSpaceName("raw");
+    transform->setDisplay("sRGB");
+    transform->setView("Gamma");
+    float pixel[4] = { 0.1f, 0.5f, 0.9f, 1.0f };
+    OCIO_CHECK_NO_THROW(config->getProcessor(transform)->getDefaultCPUProcessor()
+                            ->applyRGBA(pixel));
+    OCIO_CHECK_CLOSE(pixel[0], std::pow(0.1f, 2.2f), 1e-5f);
+
+    // The failures are only counted.
+    OCIO_CHECK_NO_THROW(warmup = config->warmupProcessors(config->getCurrentContext(),
+                                                          "raw, unknown", 0));
+    OCIO_CHECK_EQUAL(warmup->getNumProcessors(), 4);
+    OCIO_CHECK_NO_THROW(warmup->wait());
+    OCIO_CHECK_EQUAL(warmup->getNumCompleted(), 4);
+    OCIO_CHECK_EQUAL(warmup->getNumFailures(), 2);
+
+    // A cancelled warm-up skips the remaining processors.
+    OCIO_CHECK_NO_THROW(warmup = config->warmupProcessors(config->getCurrentContext(),
+                                                          "raw, log, gamma", 1));
+    OCIO_CHECK_EQUAL(warmup->getNumProcessors(), 6);
+    warmup->cancel();
+    OCIO_CHECK_NO_THROW(warmup->wait());
+    OCIO_CHECK_ASSERT(warmup->isDone());
+    OCIO_CHECK_EQUAL(warmup->getNumCompleted(), 6);
+
+    // Releasing a running warm-up waits for it.
+    OCIO_CHECK_NO_THROW(warmup = config->warmupProcessors(config->getCurrentContext(),
+                                                          "log, gamma", 0));
+    warmup.reset();
+}
+
 #endif // OCIO_UNIT_TEST
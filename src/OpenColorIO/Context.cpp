@@ -9,6 +9,7 @@
 
 #include <OpenColorIO/OpenColorIO.h>
 
+#include "CacheStatistics.h"
 #include "HashUtils.h"
 #include "Mutex.h"
 #include "PathUtils.h"
@@ -24,11 +25,23 @@ namespace
                                 const StringVec & pathStrings,
                                 const std::string & configRootDir,
                                 const EnvMap & map);
+
+    // The number of states of a context keeping their resolved results.
+    constexpr size_t MAX_CONTEXT_STATES = 16;
 }
     
     class Context::Impl
     {
     public:
+        // The results resolved for one state of the context (i.e. one cache id).
+        struct Resolutions
+        {
+            StringMap results_;
+            // The expanded & normalized search paths, computed on first use.
+            StringVec absoluteSearchPaths_;
+            bool hasAbsoluteSearchPaths_ = false;
+        };
+
         // New platform-agnostic search paths vector.
         StringVec searchPaths_;
         // Original concatenated string search paths (keeping it for now to
@@ -38,13 +51,32 @@ namespace
         EnvironmentMode envmode_;
         EnvMap envMap_;
         
-        mutable std::string cacheID_;
-        mutable StringMap resultsCache_;
-        mutable Mutex resultsCacheMutex_;
+        // The cache id is the hash of the digests of the settings (i.e. the search paths,
+        // the working dir & the environment mode) and of the string vars. The digest of the
+        // string vars is the xor of the digests of each variable so changing a variable
+        // only hashes the variable.
+        uint8_t settingsDigest_[16];
+        uint8_t varsDigest_[16];
+        std::string cacheID_;
+
+        // The results of the recent states of the context, by cache id, so going back to
+        // a previous state (e.g. switching between two shots) reuses its results.
+        mutable std::map<std::string, Resolutions> resolutions_;
+        // The results of the current state i.e. an element of resolutions_.
+        Resolutions * current_ = nullptr;
+        // The cache hits only take a shared lock (i.e. read-mostly cache).
+        mutable SharedMutex resultsCacheMutex_;
+        // A frozen context (i.e. from a config snapshot) is never modified so its
+        // cache id & the results resolved at freeze time are read without any lock.
+        bool frozen_ = false;
+        StringMap frozenResults_;
         
         Impl() :
             envmode_(ENV_ENVIRONMENT_LOAD_PREDEFINED)
         {
+            updateSettingsDigest();
+            updateVarsDigest();
+            updateCacheID();
         }
         
         ~Impl()
@@ -56,19 +88,130 @@ namespace
         {
             if(this!=&rhs)
             {
-                AutoMutex lock1(resultsCacheMutex_);
-                AutoMutex lock2(rhs.resultsCacheMutex_);
+                AutoExclusiveLock lock1(resultsCacheMutex_);
+                AutoSharedLock lock2(rhs.resultsCacheMutex_);
                 
                 searchPaths_ = rhs.searchPaths_;
                 searchPath_ = rhs.searchPath_;
                 workingDir_ = rhs.workingDir_;
+                envmode_ = rhs.envmode_;
                 envMap_ = rhs.envMap_;
                 
-                resultsCache_ = rhs.resultsCache_;
+                memcpy(settingsDigest_, rhs.settingsDigest_, sizeof(settingsDigest_));
+                memcpy(varsDigest_, rhs.varsDigest_, sizeof(varsDigest_));
                 cacheID_ = rhs.cacheID_;
+
+                resolutions_ = rhs.resolutions_;
+                current_ = &resolutions_[cacheID_];
+
+                // A copy is always editable.
+                frozen_ = false;
+                frozenResults_.clear();
             }
             return *this;
         }
+
+        // Note that a frozen context only exists for a constant pointer.
+        const char * findFrozenResult(const char * val) const
+        {
+            if(frozen_)
+            {
+                StringMap::const_iterator iter = frozenResults_.find(val);
+                if(iter != frozenResults_.end())
+                {
+                    return iter->second.c_str();
+                }
+            }
+            return nullptr;
+        }
+
+        // Note that the caller holds the exclusive lock.
+        void updateSettingsDigest()
+        {
+            std::ostringstream settings;
+            if (!searchPaths_.empty())
+            {
+                settings << "Search Path ";
+                for (auto & path : searchPaths_)
+                {
+                    settings << path << " ";
+                }
+            }
+            settings << "Working Dir " << workingDir_ << " ";
+            settings << "Environment Mode " << envmode_ << " ";
+
+            CacheIDHasher hasher;
+            hasher.update(settings.str());
+            hasher.digest(settingsDigest_);
+        }
+
+        // Add or remove the variable to/from the digest of the string vars. Note that the
+        // caller holds the exclusive lock.
+        void toggleVar(const std::string & name, const std::string & value)
+        {
+            CacheIDHasher hasher;
+            // The name includes its terminating null character to separate it from the value.
+            hasher.update(name.c_str(), name.size() + 1);
+            hasher.update(value);
+
+            uint8_t digest[16];
+            hasher.digest(digest);
+
+            for (size_t idx = 0; idx < sizeof(varsDigest_); ++idx)
+            {
+                varsDigest_[idx] ^= digest[idx];
+            }
+        }
+
+        // Note that the caller holds the exclusive lock.
+        void updateVarsDigest()
+        {
+            memset(varsDigest_, 0, sizeof(varsDigest_));
+            for (const auto & var : envMap_)
+            {
+                toggleVar(var.first, var.second);
+            }
+        }
+
+        // Switch to the results of the new state of the context. Note that the caller holds
+        // the exclusive lock.
+        void updateCacheID()
+        {
+            CacheIDHasher hasher;
+            hasher.update(settingsDigest_, sizeof(settingsDigest_));
+            hasher.update(varsDigest_, sizeof(varsDigest_));
+            cacheID_ = hasher.digest();
+
+            auto iter = resolutions_.find(cacheID_);
+            if (iter == resolutions_.end())
+            {
+                if (resolutions_.size() >= MAX_CONTEXT_STATES)
+                {
+                    size_t numResults = 0;
+                    for (const auto & resolutions : resolutions_)
+                    {
+                        numResults += resolutions.second.results_.size();
+                    }
+                    GetCacheStatistics(CACHE_CONTEXT_RESULTS).addEvictions(numResults);
+
+                    resolutions_.clear();
+                }
+                iter = resolutions_.emplace(cacheID_, Resolutions()).first;
+            }
+            current_ = &iter->second;
+        }
+
+        // Note that the caller holds the exclusive lock.
+        const StringVec & getAbsoluteSearchPaths() const
+        {
+            if(!current_->hasAbsoluteSearchPaths_)
+            {
+                GetAbsoluteSearchPaths(current_->absoluteSearchPaths_, searchPaths_,
+                                       workingDir_, envMap_);
+                current_->hasAbsoluteSearchPaths_ = true;
+            }
+            return current_->absoluteSearchPaths_;
+        }
     };
     
     
@@ -108,45 +251,24 @@ namespace
     
     const char * Context::getCacheID() const
     {
-        AutoMutex lock(getImpl()->resultsCacheMutex_);
-        
-        if(getImpl()->cacheID_.empty())
+        if(getImpl()->frozen_)
         {
-            std::ostringstream cacheid;
-            if (!getImpl()->searchPaths_.empty())
-            {
-                cacheid << "Search Path ";
-                for (auto & path : getImpl()->searchPaths_)
-                {
-                    cacheid << path << " ";
-                }
-            }
-            cacheid << "Working Dir " << getImpl()->workingDir_ << " ";
-            cacheid << "Environment Mode " << getImpl()->envmode_ << " ";
-            
-            for (EnvMap::const_iterator iter = getImpl()->envMap_.begin(),
-                 end = getImpl()->envMap_.end();
-                 iter != end; ++iter)
-            {
-                cacheid << iter->first << "=" << iter->second << " ";
-            }
-            
-            std::string fullstr = cacheid.str();
-            getImpl()->cacheID_ = CacheIDHash(fullstr.c_str(), (int)fullstr.size());
+            return getImpl()->cacheID_.c_str();
         }
-        
+
+        AutoSharedLock lock(getImpl()->resultsCacheMutex_);
         return getImpl()->cacheID_.c_str();
     }
     
     void Context::setSearchPath(const char * path)
     {
-        AutoMutex lock(getImpl()->resultsCacheMutex_);
+        AutoExclusiveLock lock(getImpl()->resultsCacheMutex_);
         
         pystring::split(path, getImpl()->searchPaths_, ":");
         
         getImpl()->searchPath_ = path;
-        getImpl()->resultsCache_.clear();
-        getImpl()->cacheID_ = "";
+        getImpl()->updateSettingsDigest();
+        getImpl()->updateCacheID();
     }
     
     const char * Context::getSearchPath() const
@@ -167,39 +289,40 @@ namespace
 
     void Context::clearSearchPaths()
     {
-        AutoMutex lock(getImpl()->resultsCacheMutex_);
+        AutoExclusiveLock lock(getImpl()->resultsCacheMutex_);
 
         getImpl()->searchPath_ = "";
         getImpl()->searchPaths_.clear();
-        getImpl()->resultsCache_.clear();
-        getImpl()->cacheID_ = "";
+        getImpl()->updateSettingsDigest();
+        getImpl()->updateCacheID();
     }
 
     void Context::addSearchPath(const char * path)
     {
-        AutoMutex lock(getImpl()->resultsCacheMutex_);
+        AutoExclusiveLock lock(getImpl()->resultsCacheMutex_);
 
         if (strlen(path) != 0)
         {
             getImpl()->searchPaths_.emplace_back(path);
-            getImpl()->resultsCache_.clear();
-            getImpl()->cacheID_ = "";
 
             if (getImpl()->searchPath_.size() != 0)
             {
                 getImpl()->searchPath_ += ":";
             }
             getImpl()->searchPath_ += getImpl()->searchPaths_.back();
+
+            getImpl()->updateSettingsDigest();
+            getImpl()->updateCacheID();
         }
     }
 
     void Context::setWorkingDir(const char * dirname)
     {
-        AutoMutex lock(getImpl()->resultsCacheMutex_);
+        AutoExclusiveLock lock(getImpl()->resultsCacheMutex_);
         
         getImpl()->workingDir_ = dirname;
-        getImpl()->resultsCache_.clear();
-        getImpl()->cacheID_ = "";
+        getImpl()->updateSettingsDigest();
+        getImpl()->updateCacheID();
     }
     
     const char * Context::getWorkingDir() const
@@ -209,12 +332,12 @@ namespace
     
     void Context::setEnvironmentMode(EnvironmentMode mode)
     {
-        AutoMutex lock(getImpl()->resultsCacheMutex_);
+        AutoExclusiveLock lock(getImpl()->resultsCacheMutex_);
         
         getImpl()->envmode_ = mode;
         
-        getImpl()->resultsCache_.clear();
-        getImpl()->cacheID_ = "";
+        getImpl()->updateSettingsDigest();
+        getImpl()->updateCacheID();
     }
     
     EnvironmentMode Context::getEnvironmentMode() const
@@ -227,34 +350,53 @@ namespace
         bool update = (getImpl()->envmode_ == ENV_ENVIRONMENT_LOAD_ALL) ? false : true;
         LoadEnvironment(getImpl()->envMap_, update);
         
-        AutoMutex lock(getImpl()->resultsCacheMutex_);
-        getImpl()->resultsCache_.clear();
-        getImpl()->cacheID_ = "";
+        AutoExclusiveLock lock(getImpl()->resultsCacheMutex_);
+        getImpl()->updateVarsDigest();
+        getImpl()->updateCacheID();
     }
     
     void Context::setStringVar(const char * name, const char * value)
     {
         if(!name) return;
         
-        AutoMutex lock(getImpl()->resultsCacheMutex_);
+        AutoExclusiveLock lock(getImpl()->resultsCacheMutex_);
         
+        // Only the changed variable updates the digest of the string vars.
+        EnvMap::iterator iter = getImpl()->envMap_.find(name);
+        if(iter != getImpl()->envMap_.end())
+        {
+            if(value && iter->second == value)
+            {
+                return;
+            }
+
+            getImpl()->toggleVar(iter->first, iter->second);
+        }
+
         // Set the value if specified
         if(value)
         {
-            getImpl()->envMap_[name] = value;
+            if(iter != getImpl()->envMap_.end())
+            {
+                iter->second = value;
+            }
+            else
+            {
+                iter = getImpl()->envMap_.emplace(name, value).first;
+            }
+            getImpl()->toggleVar(iter->first, iter->second);
         }
         // If a null value is specified, erase it
+        else if(iter != getImpl()->envMap_.end())
+        {
+            getImpl()->envMap_.erase(iter);
+        }
         else
         {
-            EnvMap::iterator iter = getImpl()->envMap_.find(name);
-            if(iter != getImpl()->envMap_.end())
-            {
-                getImpl()->envMap_.erase(iter);
-            }
+            return;
         }
         
-        getImpl()->resultsCache_.clear();
-        getImpl()->cacheID_ = "";
+        getImpl()->updateCacheID();
     }
     
     const char * Context::getStringVar(const char * name) const
@@ -288,46 +430,132 @@ namespace
     
     void Context::clearStringVars()
     {
+        AutoExclusiveLock lock(getImpl()->resultsCacheMutex_);
+
         getImpl()->envMap_.clear();
+        getImpl()->updateVarsDigest();
+        getImpl()->updateCacheID();
     }
     
     const char * Context::resolveStringVar(const char * val) const
     {
-        AutoMutex lock(getImpl()->resultsCacheMutex_);
-        
         if(!val || !*val)
         {
             return "";
         }
         
-        StringMap::const_iterator iter = getImpl()->resultsCache_.find(val);
-        if(iter != getImpl()->resultsCache_.end())
+        if(const char * result = getImpl()->findFrozenResult(val))
+        {
+            return result;
+        }
+
+        CacheStatistics & statistics = GetCacheStatistics(CACHE_CONTEXT_RESULTS);
+
         {
+            AutoTimedSharedLock lock(getImpl()->resultsCacheMutex_, statistics);
+
+            StringMap::const_iterator iter = getImpl()->current_->results_.find(val);
+            if(iter != getImpl()->current_->results_.end())
+            {
+                statistics.addHit();
+                return iter->second.c_str();
+            }
+        }
+
+        AutoTimedExclusiveLock lock(getImpl()->resultsCacheMutex_, statistics);
+
+        // Another thread could have resolved it in the meantime.
+        StringMap::const_iterator iter = getImpl()->current_->results_.find(val);
+        if(iter != getImpl()->current_->results_.end())
+        {
+            statistics.addHit();
             return iter->second.c_str();
         }
+
+        statistics.addMiss();
         
         std::string resolvedval = EnvExpand(val, getImpl()->envMap_);
         
-        getImpl()->resultsCache_[val] = resolvedval;
-        return getImpl()->resultsCache_[val].c_str();
+        statistics.addInsertion();
+        getImpl()->current_->results_[val] = resolvedval;
+        return getImpl()->current_->results_[val].c_str();
     }
     
     
     
     const char * Context::resolveFileLocation(const char * filename) const
     {
-        AutoMutex lock(getImpl()->resultsCacheMutex_);
-        
+        if(const char * result = tryResolveFileLocation(filename))
+        {
+            return result;
+        }
+
+        // Only the failures build the error message i.e. walk again the search paths.
+        std::string expandedfullpath = EnvExpand(filename, getImpl()->envMap_);
+        if(pystring::os::path::isabs(expandedfullpath))
+        {
+            std::ostringstream errortext;
+            errortext << "The specified absolute file reference ";
+            errortext << "'" << expandedfullpath << "' could not be located. ";
+            throw Exception(errortext.str().c_str());
+        }
+
+        std::ostringstream errortext;
+        errortext << "The specified file reference ";
+        errortext << " '" << filename << "' could not be located. ";
+        errortext << "The following attempts were made: ";
+
+        // The absolute search paths could be lazily computed.
+        AutoExclusiveLock lock(getImpl()->resultsCacheMutex_);
+
+        const StringVec & searchpaths = getImpl()->getAbsoluteSearchPaths();
+        for (unsigned int i = 0; i < searchpaths.size(); ++i)
+        {
+            std::string fullpath = pystring::os::path::join(searchpaths[i], filename);
+            if(i!=0) errortext << " : ";
+            errortext << EnvExpand(fullpath, getImpl()->envMap_);
+        }
+
+        throw ExceptionMissingFile(errortext.str().c_str());
+    }
+
+    const char * Context::tryResolveFileLocation(const char * filename) const
+    {
         if(!filename || !*filename)
         {
             return "";
         }
         
-        StringMap::const_iterator iter = getImpl()->resultsCache_.find(filename);
-        if(iter != getImpl()->resultsCache_.end())
+        if(const char * result = getImpl()->findFrozenResult(filename))
+        {
+            return result;
+        }
+
+        CacheStatistics & statistics = GetCacheStatistics(CACHE_CONTEXT_RESULTS);
+
+        // Concurrent cache hits do not wait for each other.
+        {
+            AutoTimedSharedLock lock(getImpl()->resultsCacheMutex_, statistics);
+
+            StringMap::const_iterator iter = getImpl()->current_->results_.find(filename);
+            if(iter != getImpl()->current_->results_.end())
+            {
+                statistics.addHit();
+                return iter->second.c_str();
+            }
+        }
+
+        AutoTimedExclusiveLock lock(getImpl()->resultsCacheMutex_, statistics);
+
+        // Another thread could have resolved it in the meantime.
+        StringMap::const_iterator iter = getImpl()->current_->results_.find(filename);
+        if(iter != getImpl()->current_->results_.end())
         {
+            statistics.addHit();
             return iter->second.c_str();
         }
+
+        statistics.addMiss();
         
         // Attempt to load an absolute file reference
         {
@@ -336,46 +564,46 @@ namespace
         {
             if(FileExists(expandedfullpath))
             {
-                getImpl()->resultsCache_[filename] = pystring::os::path::normpath(expandedfullpath);
-                return getImpl()->resultsCache_[filename].c_str();
+                statistics.addInsertion();
+                getImpl()->current_->results_[filename] = pystring::os::path::normpath(expandedfullpath);
+                return getImpl()->current_->results_[filename].c_str();
             }
-            std::ostringstream errortext;
-            errortext << "The specified absolute file reference ";
-            errortext << "'" << expandedfullpath << "' could not be located. ";
-            throw Exception(errortext.str().c_str());
+            return nullptr;
         }
         }
         
         // Load a relative file reference
-        // Prep the search path vector
-        // TODO: Cache this prepped vector?
-        StringVec searchpaths;
-        GetAbsoluteSearchPaths(searchpaths,
-                               getImpl()->searchPaths_,
-                               getImpl()->workingDir_,
-                               getImpl()->envMap_);
+        const StringVec & searchpaths = getImpl()->getAbsoluteSearchPaths();
         
         // Loop over each path, and try to find the file
-        std::ostringstream errortext;
-        errortext << "The specified file reference ";
-        errortext << " '" << filename << "' could not be located. ";
-        errortext << "The following attempts were made: ";
-        
         for (unsigned int i = 0; i < searchpaths.size(); ++i)
         {
             // Make an attempt to find the LUT in one of the search paths
             std::string fullpath = pystring::os::path::join(searchpaths[i], filename);
             std::string expandedfullpath = EnvExpand(fullpath, getImpl()->envMap_);
-            if(FileExists(expandedfullpath))
+
+            // The cached listing of the directory avoids a stat call per search path.
+            std::string dirname, basename;
+            pystring::os::path::split(dirname, basename, expandedfullpath);
+            if(FindDirectoryEntry(dirname, basename) != DIRECTORY_ENTRY_MISSING
+                && FileExists(expandedfullpath))
             {
-                getImpl()->resultsCache_[filename] = pystring::os::path::normpath(expandedfullpath);
-                return getImpl()->resultsCache_[filename].c_str();
+                statistics.addInsertion();
+                getImpl()->current_->results_[filename] = pystring::os::path::normpath(expandedfullpath);
+                return getImpl()->current_->results_[filename].c_str();
             }
-            if(i!=0) errortext << " : ";
-            errortext << expandedfullpath;
         }
         
-        throw ExceptionMissingFile(errortext.str().c_str());
+        return nullptr;
+    }
+
+    void Context::freeze()
+    {
+        AutoExclusiveLock lock(getImpl()->resultsCacheMutex_);
+
+        // The results resolved later are still cached in the (locked) results cache.
+        getImpl()->frozenResults_ = getImpl()->current_->results_;
+        getImpl()->frozen_ = true;
     }
 
     std::ostream& operator<< (std::ostream& os, const Context& context)
@@ -1,6 +1,9 @@
 // SPDX-License-Identifier: BSD-3-Clause
 // Copyright Contributors to the OpenColorIO Project.
 
+#include <sstream>
+#include <thread>
+
 #include <OpenColorIO/OpenColorIO.h>
 
 #include "DynamicProperty.h"
@@ -20,20 +23,89 @@ bool operator==(const DynamicProperty &lhs, const DynamicProperty &rhs)
     return false;
 }
 
+namespace
+{
+
+// The ASC v1.2 spec places the following restrictions:
+//   slope >= 0, power > 0, sat >= 0, (offset unbounded).
+void ValidateCDLValues(const double * slope, const double * power, double saturation)
+{
+    for (unsigned i = 0; i < 3; ++i)
+    {
+        if (!(slope[i] >= 0.) || !(power[i] > 0.))
+        {
+            std::ostringstream oss;
+            oss << "CDL dynamic property: Invalid slope '" << slope[i]
+                << "' or power '" << power[i] << "'.";
+            throw Exception(oss.str().c_str());
+        }
+    }
+
+    if (!(saturation >= 0.))
+    {
+        std::ostringstream oss;
+        oss << "CDL dynamic property: Invalid saturation '" << saturation << "'.";
+        throw Exception(oss.str().c_str());
+    }
+}
+
+}
+
 DynamicPropertyImpl::DynamicPropertyImpl(DynamicPropertyType type, double value, bool dynamic)
     :   m_type(type)
     ,   m_valueType(DYNAMIC_PROPERTY_DOUBLE)
     ,   m_value(value)
     ,   m_isDynamic(dynamic)
 {
+    for (auto & v : m_cdlValues)
+    {
+        v.store(0., std::memory_order_relaxed);
+    }
+}
+
+DynamicPropertyImpl::DynamicPropertyImpl(const double * slope,
+                                         const double * offset,
+                                         const double * power,
+                                         double saturation,
+                                         bool dynamic)
+    :   m_type(DYNAMIC_PROPERTY_CDL)
+    ,   m_valueType(DYNAMIC_PROPERTY_CDL_VALUES)
+    ,   m_isDynamic(dynamic)
+{
+    ValidateCDLValues(slope, power, saturation);
+
+    for (unsigned i = 0; i < 3; ++i)
+    {
+        m_cdlValues[i    ].store(slope[i],  std::memory_order_relaxed);
+        m_cdlValues[i + 3].store(offset[i], std::memory_order_relaxed);
+        m_cdlValues[i + 6].store(power[i],  std::memory_order_relaxed);
+    }
+    m_cdlValues[9].store(saturation, std::memory_order_relaxed);
 }
 
 DynamicPropertyImpl::DynamicPropertyImpl(DynamicPropertyImpl & rhs)
     :   m_type(rhs.m_type)
     ,   m_valueType(rhs.m_valueType)
-    ,   m_value(rhs.m_value)
+    ,   m_value(rhs.m_value.load())
     ,   m_isDynamic(rhs.m_isDynamic)
 {   
+    if (m_valueType == DYNAMIC_PROPERTY_CDL_VALUES)
+    {
+        double values[NUM_CDL_VALUES];
+        rhs.getCDLValues(&values[0], &values[3], &values[6], values[9]);
+
+        for (unsigned i = 0; i < NUM_CDL_VALUES; ++i)
+        {
+            m_cdlValues[i].store(values[i], std::memory_order_relaxed);
+        }
+    }
+    else
+    {
+        for (auto & v : m_cdlValues)
+        {
+            v.store(0., std::memory_order_relaxed);
+        }
+    }
 }
 
 double DynamicPropertyImpl::getDoubleValue() const
@@ -43,7 +115,7 @@ double DynamicPropertyImpl::getDoubleValue() const
         throw Exception("The dynamic property does not hold a double precision value.");
     }
 
-    return m_value;
+    return m_value.load(std::memory_order_acquire);
 }
 
 void DynamicPropertyImpl::setValue(double value)
@@ -53,7 +125,85 @@ void DynamicPropertyImpl::setValue(double value)
         throw Exception("The dynamic property does not hold a double precision value.");
     }
 
-    m_value = value;
+    m_value.store(value, std::memory_order_release);
+    m_version.fetch_add(1, std::memory_order_release);
+}
+
+void DynamicPropertyImpl::getCDLValues(double * slope, double * offset, double * power,
+                                       double & saturation) const
+{
+    if(m_valueType!=DYNAMIC_PROPERTY_CDL_VALUES)
+    {
+        throw Exception("The dynamic property does not hold CDL values.");
+    }
+
+    if (!slope || !offset || !power)
+    {
+        throw Exception("CDL dynamic property: Invalid input pointer.");
+    }
+
+    double values[NUM_CDL_VALUES];
+    unsigned long long seq = 0;
+    do
+    {
+        seq = m_cdlSequence.load(std::memory_order_acquire);
+        for (unsigned i = 0; i < NUM_CDL_VALUES; ++i)
+        {
+            values[i] = m_cdlValues[i].load(std::memory_order_relaxed);
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+    }
+    // Read again if a change was in progress.
+    while ((seq & 1) || seq != m_cdlSequence.load(std::memory_order_relaxed));
+
+    for (unsigned i = 0; i < 3; ++i)
+    {
+        slope[i]  = values[i];
+        offset[i] = values[i + 3];
+        power[i]  = values[i + 6];
+    }
+    saturation = values[9];
+}
+
+void DynamicPropertyImpl::setCDLValues(const double * slope, const double * offset,
+                                       const double * power, double saturation)
+{
+    if(m_valueType!=DYNAMIC_PROPERTY_CDL_VALUES)
+    {
+        throw Exception("The dynamic property does not hold CDL values.");
+    }
+
+    if (!slope || !offset || !power)
+    {
+        throw Exception("CDL dynamic property: Invalid input pointer.");
+    }
+
+    ValidateCDLValues(slope, power, saturation);
+
+    // Only one writer at a time i.e. wait for the end of a concurrent change.
+    unsigned long long seq = m_cdlSequence.load(std::memory_order_relaxed);
+    do
+    {
+        while (seq & 1)
+        {
+            std::this_thread::yield();
+            seq = m_cdlSequence.load(std::memory_order_relaxed);
+        }
+    }
+    while (!m_cdlSequence.compare_exchange_weak(seq, seq + 1, std::memory_order_acquire,
+                                                std::memory_order_relaxed));
+    std::atomic_thread_fence(std::memory_order_release);
+
+    for (unsigned i = 0; i < 3; ++i)
+    {
+        m_cdlValues[i    ].store(slope[i],  std::memory_order_relaxed);
+        m_cdlValues[i + 3].store(offset[i], std::memory_order_relaxed);
+        m_cdlValues[i + 6].store(power[i],  std::memory_order_relaxed);
+    }
+    m_cdlValues[9].store(saturation, std::memory_order_relaxed);
+
+    m_cdlSequence.store(seq + 2, std::memory_order_release);
+    m_version.fetch_add(1, std::memory_order_release);
 }
 
 bool DynamicPropertyImpl::equals(const DynamicPropertyImpl & rhs) const
@@ -64,7 +214,20 @@ bool DynamicPropertyImpl::equals(const DynamicPropertyImpl & rhs) const
     {
         if (!m_isDynamic)
         {
-            if (m_value == rhs.m_value)
+            if (m_valueType == DYNAMIC_PROPERTY_CDL_VALUES)
+            {
+                double lhsValues[NUM_CDL_VALUES], rhsValues[NUM_CDL_VALUES];
+                getCDLValues(&lhsValues[0], &lhsValues[3], &lhsValues[6], lhsValues[9]);
+                rhs.getCDLValues(&rhsValues[0], &rhsValues[3], &rhsValues[6], rhsValues[9]);
+
+                for (unsigned i = 0; i < NUM_CDL_VALUES; ++i)
+                {
+                    if (lhsValues[i] != rhsValues[i]) return false;
+                }
+                return true;
+            }
+
+            if (m_value.load() == rhs.m_value.load())
             {
                 // Both not dynamic, same value.
                 return true;
@@ -96,6 +259,85 @@ DynamicProperty::~DynamicProperty()
 
 }
 
+namespace
+{
+
+bool IsValidType(DynamicPropertyType type) noexcept
+{
+    return type==DYNAMIC_PROPERTY_EXPOSURE
+        || type==DYNAMIC_PROPERTY_CONTRAST
+        || type==DYNAMIC_PROPERTY_GAMMA;
+}
+
+// The overrides used by the calling thread.
+thread_local const DynamicPropertyOverrides * t_overrides = nullptr;
+
+}
+
+void DynamicPropertyOverrides::setValue(DynamicPropertyType type, double value)
+{
+    if(!IsValidType(type))
+    {
+        throw Exception("Unknown dynamic property type.");
+    }
+
+    m_values[type] = value;
+    m_overridden |= 1u << type;
+}
+
+bool DynamicPropertyOverrides::hasValue(DynamicPropertyType type) const noexcept
+{
+    return IsValidType(type) && (m_overridden & (1u << type))!=0;
+}
+
+double DynamicPropertyOverrides::getDoubleValue(DynamicPropertyType type) const
+{
+    if(!hasValue(type))
+    {
+        throw Exception("The dynamic property value is not overridden.");
+    }
+
+    return m_values[type];
+}
+
+void DynamicPropertyOverrides::clear() noexcept
+{
+    m_overridden = 0;
+}
+
+bool DynamicPropertyOverrides::isEmpty() const noexcept
+{
+    return m_overridden==0;
+}
+
+DynamicPropertyOverridesGuard::DynamicPropertyOverridesGuard(
+    const DynamicPropertyOverrides * overrides)
+    :   m_previous(t_overrides)
+{
+    t_overrides = overrides;
+}
+
+DynamicPropertyOverridesGuard::~DynamicPropertyOverridesGuard()
+{
+    t_overrides = m_previous;
+}
+
+const DynamicPropertyOverrides * GetThreadDynamicPropertyOverrides() noexcept
+{
+    return t_overrides;
+}
+
+double GetDynamicPropertyValue(const DynamicPropertyImpl & prop,
+                               const DynamicPropertyOverrides * overrides)
+{
+    if(overrides && prop.isDynamic() && overrides->hasValue(prop.getType()))
+    {
+        return overrides->getDoubleValue(prop.getType());
+    }
+
+    return prop.getDoubleValue();
+}
+
 }
 OCIO_NAMESPACE_EXIT
 
@@ -106,6 +348,9 @@ OCIO_NAMESPACE_EXIT
 namespace OCIO = OCIO_NAMESPACE;
 
 #include <sstream>
+#include <thread>
+#include <vector>
+
 #include "UnitTest.h"
 #include "UnitTestUtils.h"
 
@@ -123,11 +368,17 @@ OCIO_ADD_TEST(DynamicPropertyImpl, basic)
     OCIO_REQUIRE_ASSERT(dpImpl);
     OCIO_CHECK_ASSERT(!dpImpl->isDynamic());
     OCIO_CHECK_EQUAL(dpImpl->getDoubleValue(), 1.0);
+    OCIO_CHECK_EQUAL(dpImpl->getVersion(), 0ULL);
 
     dpImpl->makeDynamic();
     OCIO_CHECK_ASSERT(dpImpl->isDynamic());
     dpImpl->setValue(2.0);
     OCIO_CHECK_EQUAL(dpImpl->getDoubleValue(), 2.0);
+    OCIO_CHECK_EQUAL(dpImpl->getVersion(), 1ULL);
+
+    // Every change is a new version, even when setting the same value.
+    dpImpl->setValue(2.0);
+    OCIO_CHECK_EQUAL(dpImpl->getVersion(), 2ULL);
 }
 
 OCIO_ADD_TEST(DynamicPropertyImpl, equal)
@@ -164,6 +415,108 @@ OCIO_ADD_TEST(DynamicPropertyImpl, equal)
     OCIO_CHECK_ASSERT(*dp0 == *dp1);
 }
 
+OCIO_ADD_TEST(DynamicPropertyImpl, cdl_values)
+{
+    const double slope[3]  = { 1.1, 1.2, 1.3 };
+    const double offset[3] = { 0.1, -0.2, 0.3 };
+    const double power[3]  = { 0.9, 1.0, 1.1 };
+
+    OCIO::DynamicPropertyImplRcPtr dpImpl
+        = std::make_shared<OCIO::DynamicPropertyImpl>(slope, offset, power, 0.8, false);
+    OCIO_CHECK_EQUAL(dpImpl->getType(), OCIO::DYNAMIC_PROPERTY_CDL);
+    OCIO_CHECK_EQUAL(dpImpl->getValueType(), OCIO::DYNAMIC_PROPERTY_CDL_VALUES);
+    OCIO_CHECK_THROW_WHAT(dpImpl->getDoubleValue(), OCIO::Exception,
+                          "does not hold a double precision value");
+    OCIO_CHECK_THROW_WHAT(dpImpl->setValue(1.0), OCIO::Exception,
+                          "does not hold a double precision value");
+
+    double s[3], o[3], p[3], sat = 0.;
+    dpImpl->getCDLValues(s, o, p, sat);
+    OCIO_CHECK_EQUAL(s[2], 1.3);
+    OCIO_CHECK_EQUAL(o[1], -0.2);
+    OCIO_CHECK_EQUAL(p[0], 0.9);
+    OCIO_CHECK_EQUAL(sat, 0.8);
+    OCIO_CHECK_EQUAL(dpImpl->getVersion(), 0ULL);
+
+    const double newSlope[3] = { 2.0, 2.0, 2.0 };
+    dpImpl->setCDLValues(newSlope, offset, power, 1.0);
+    dpImpl->getCDLValues(s, o, p, sat);
+    OCIO_CHECK_EQUAL(s[0], 2.0);
+    OCIO_CHECK_EQUAL(sat, 1.0);
+    OCIO_CHECK_EQUAL(dpImpl->getVersion(), 1ULL);
+
+    // Invalid values are rejected and the current values are kept.
+    const double badPower[3] = { 1.0, 0.0, 1.0 };
+    OCIO_CHECK_THROW_WHAT(dpImpl->setCDLValues(newSlope, offset, badPower, 1.0),
+                          OCIO::Exception, "Invalid slope");
+    OCIO_CHECK_THROW_WHAT(dpImpl->setCDLValues(newSlope, offset, power, -1.0),
+                          OCIO::Exception, "Invalid saturation");
+    dpImpl->getCDLValues(s, o, p, sat);
+    OCIO_CHECK_EQUAL(p[1], 1.0);
+    OCIO_CHECK_EQUAL(dpImpl->getVersion(), 1ULL);
+
+    // A double property does not hold CDL values.
+    OCIO::DynamicPropertyImpl dpExposure(OCIO::DYNAMIC_PROPERTY_EXPOSURE, 1.0, false);
+    OCIO_CHECK_THROW_WHAT(dpExposure.getCDLValues(s, o, p, sat), OCIO::Exception,
+                          "does not hold CDL values");
+
+    // Copy & equality.
+    OCIO::DynamicPropertyImpl dpCopy(*dpImpl);
+    dpCopy.getCDLValues(s, o, p, sat);
+    OCIO_CHECK_EQUAL(s[1], 2.0);
+    OCIO_CHECK_ASSERT(dpCopy.equals(*dpImpl));
+    dpCopy.setCDLValues(slope, offset, power, 1.0);
+    OCIO_CHECK_ASSERT(!dpCopy.equals(*dpImpl));
+    dpCopy.makeDynamic();
+    dpImpl->makeDynamic();
+    OCIO_CHECK_ASSERT(dpCopy.equals(*dpImpl));
+}
+
+OCIO_ADD_TEST(DynamicPropertyImpl, cdl_values_concurrent_changes)
+{
+    const double one[3] = { 1., 1., 1. };
+    OCIO::DynamicPropertyImpl dp(one, one, one, 1.0, true);
+
+    // The writers always set the same value in all the fields, so a reader
+    // must never see a mix of two changes.
+    std::atomic<bool> torn{ false };
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 2; ++t)
+    {
+        threads.emplace_back([&dp, t]()
+        {
+            for (int i = 1; i <= 2000; ++i)
+            {
+                const double v = double(t * 10000 + i);
+                const double vec[3] = { v, v, v };
+                dp.setCDLValues(vec, vec, vec, v);
+            }
+        });
+    }
+    for (int t = 0; t < 2; ++t)
+    {
+        threads.emplace_back([&dp, &torn]()
+        {
+            for (int i = 0; i < 2000; ++i)
+            {
+                double s[3], o[3], p[3], sat = 0.;
+                dp.getCDLValues(s, o, p, sat);
+                for (int c = 0; c < 3; ++c)
+                {
+                    if (s[c] != sat || o[c] != sat || p[c] != sat) torn = true;
+                }
+            }
+        });
+    }
+    for (auto & thread : threads)
+    {
+        thread.join();
+    }
+
+    OCIO_CHECK_ASSERT(!torn);
+    OCIO_CHECK_EQUAL(dp.getVersion(), 4000ULL);
+}
+
 namespace
 {
 OCIO::ConstProcessorRcPtr LoadTransformFile(const std::string & fileName)
@@ -241,5 +594,126 @@ OCIO_ADD_TEST(DynamicProperty, get_dynamic_via_processor)
                           "Cannot find dynamic property");
 }
 
+OCIO_ADD_TEST(DynamicPropertyOverrides, basic)
+{
+    OCIO::DynamicPropertyOverrides overrides;
+    OCIO_CHECK_ASSERT(overrides.isEmpty());
+    OCIO_CHECK_ASSERT(!overrides.hasValue(OCIO::DYNAMIC_PROPERTY_EXPOSURE));
+    OCIO_CHECK_THROW_WHAT(overrides.getDoubleValue(OCIO::DYNAMIC_PROPERTY_EXPOSURE),
+                          OCIO::Exception,
+                          "not overridden");
+
+    overrides.setValue(OCIO::DYNAMIC_PROPERTY_CONTRAST, 1.5);
+    OCIO_CHECK_ASSERT(!overrides.isEmpty());
+    OCIO_CHECK_ASSERT(overrides.hasValue(OCIO::DYNAMIC_PROPERTY_CONTRAST));
+    OCIO_CHECK_ASSERT(!overrides.hasValue(OCIO::DYNAMIC_PROPERTY_GAMMA));
+    OCIO_CHECK_EQUAL(overrides.getDoubleValue(OCIO::DYNAMIC_PROPERTY_CONTRAST), 1.5);
+
+    OCIO_CHECK_THROW_WHAT(overrides.setValue((OCIO::DynamicPropertyType)42, 1.),
+                          OCIO::Exception,
+                          "Unknown dynamic property type");
+
+    overrides.clear();
+    OCIO_CHECK_ASSERT(overrides.isEmpty());
+    OCIO_CHECK_ASSERT(!overrides.hasValue(OCIO::DYNAMIC_PROPERTY_CONTRAST));
+
+    // Only the dynamic properties are overridden.
+    OCIO::DynamicPropertyImpl prop(OCIO::DYNAMIC_PROPERTY_GAMMA, 1.2, false);
+    overrides.setValue(OCIO::DYNAMIC_PROPERTY_GAMMA, 2.0);
+    OCIO_CHECK_EQUAL(OCIO::GetDynamicPropertyValue(prop, &overrides), 1.2);
+    prop.makeDynamic();
+    OCIO_CHECK_EQUAL(OCIO::GetDynamicPropertyValue(prop, &overrides), 2.0);
+    OCIO_CHECK_EQUAL(OCIO::GetDynamicPropertyValue(prop, nullptr), 1.2);
+}
+
+// Process with overridden values while the dynamic properties of the processor
+// are unchanged.
+OCIO_ADD_TEST(DynamicProperty, apply_with_overrides)
+{
+    const std::string ctfFile("exposure_contrast_video_dp.ctf");
+
+    OCIO::ConstProcessorRcPtr processor;
+    OCIO_CHECK_NO_THROW(processor = LoadTransformFile(ctfFile));
+
+    OCIO::ConstCPUProcessorRcPtr cpuProcessor;
+    OCIO_CHECK_NO_THROW(cpuProcessor = processor->getDefaultCPUProcessor());
+
+    OCIO::DynamicPropertyRcPtr dp;
+    OCIO_CHECK_NO_THROW(dp = cpuProcessor->getDynamicProperty(OCIO::DYNAMIC_PROPERTY_EXPOSURE));
+    const double fileValue = dp->getDoubleValue();
+
+    // Process a small image using the properties.
+    static constexpr long width  = 64;
+    static constexpr long height = 512;
+    std::vector<float> srcImg(width * height * 4);
+    for (size_t idx = 0; idx < srcImg.size(); ++idx)
+    {
+        srcImg[idx] = float(idx % 97) / 96.0f;
+    }
+
+    std::vector<float> refImg(srcImg.size());
+    {
+        dp->setValue(0.4);
+
+        OCIO::PackedImageDesc src(srcImg.data(), width, height, 4);
+        OCIO::PackedImageDesc dst(refImg.data(), width, height, 4);
+        cpuProcessor->apply(src, dst);
+
+        dp->setValue(fileValue);
+    }
+
+    OCIO::DynamicPropertyOverrides overrides;
+    overrides.setValue(OCIO::DYNAMIC_PROPERTY_EXPOSURE, 0.4);
+
+    // Single-threaded processing.
+    {
+        std::vector<float> img(srcImg.size());
+        OCIO::PackedImageDesc src(srcImg.data(), width, height, 4);
+        OCIO::PackedImageDesc dst(img.data(), width, height, 4);
+        OCIO_CHECK_NO_THROW(cpuProcessor->apply(src, dst, overrides));
+
+        OCIO_CHECK_ASSERT(img == refImg);
+        OCIO_CHECK_EQUAL(dp->getDoubleValue(), fileValue);
+    }
+
+    // Multi-threaded processing i.e. the image bands are processed by other threads.
+    {
+        std::vector<float> img(srcImg.size());
+        OCIO::PackedImageDesc src(srcImg.data(), width, height, 4);
+        OCIO::PackedImageDesc dst(img.data(), width, height, 4);
+        OCIO_CHECK_NO_THROW(cpuProcessor->apply(src, dst, OCIO::CPUExecutor(), overrides));
+
+        OCIO_CHECK_ASSERT(img == refImg);
+        OCIO_CHECK_EQUAL(dp->getDoubleValue(), fileValue);
+    }
+
+    // In place processing.
+    {
+        std::vector<float> img = srcImg;
+        OCIO::PackedImageDesc desc(img.data(), width, height, 4);
+        OCIO_CHECK_NO_THROW(cpuProcessor->apply(desc, overrides));
+
+        OCIO_CHECK_ASSERT(img == refImg);
+    }
+
+    // The next calls without overrides use the properties.
+    {
+        std::vector<float> img(srcImg.size());
+        OCIO::PackedImageDesc src(srcImg.data(), width, height, 4);
+        OCIO::PackedImageDesc dst(img.data(), width, height, 4);
+        OCIO_CHECK_NO_THROW(cpuProcessor->apply(src, dst));
+
+        OCIO_CHECK_ASSERT(img != refImg);
+    }
+
+    // Note: The CTF does not define gamma as being dynamic.
+    overrides.setValue(OCIO::DYNAMIC_PROPERTY_GAMMA, 1.2);
+    std::vector<float> img = srcImg;
+    OCIO::PackedImageDesc desc(img.data(), width, height, 4);
+    OCIO_CHECK_THROW_WHAT(cpuProcessor->apply(desc, overrides),
+                          OCIO::Exception,
+                          "Cannot find dynamic property");
+}
+
 
 #endif
\ No newline at end of file
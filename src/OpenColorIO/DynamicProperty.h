@@ -4,6 +4,8 @@
 #ifndef INCLUDED_OCIO_DYNAMICPROPERTY_H
 #define INCLUDED_OCIO_DYNAMICPROPERTY_H
 
+#include <atomic>
+
 #include <OpenColorIO/OpenColorIO.h>
 
 OCIO_NAMESPACE_ENTER
@@ -13,16 +15,40 @@ class DynamicPropertyImpl;
 typedef OCIO_SHARED_PTR<DynamicPropertyImpl> DynamicPropertyImplRcPtr;
 
 // Holds a value that can be made dynamic.
+//
+// The value could be changed while CPU renderers are processing images (e.g. a viewer
+// moving an exposure slider while the render threads are inside apply()), so it is
+// stored atomically. The renderers read the value once at the start of an apply() call
+// (i.e. of an image band) so a change is only seen by the following calls. Every change
+// also increments a version allowing the renderers to only recompute the values they
+// derive from the property when it really changed.
+//
+// A CDL property holds several values which are protected by a sequence lock, so a
+// reader always gets the values of one change.
 class DynamicPropertyImpl : public DynamicProperty
 {
 public:
     DynamicPropertyImpl(DynamicPropertyType type, double value, bool dynamic);
+    DynamicPropertyImpl(const double * slope, const double * offset, const double * power,
+                        double saturation, bool dynamic);
     DynamicPropertyImpl(DynamicPropertyImpl & rhs);
     virtual ~DynamicPropertyImpl() = default;
 
     double getDoubleValue() const override;
     void setValue(double value) override;
 
+    void getCDLValues(double * slope, double * offset, double * power,
+                      double & saturation) const override;
+    void setCDLValues(const double * slope, const double * offset, const double * power,
+                      double saturation) override;
+
+    // Get the number of value changes. Note that reading the version before the value
+    // guarantees the value to be at least as recent as the version.
+    unsigned long long getVersion() const noexcept
+    {
+        return m_version.load(std::memory_order_acquire);
+    }
+
     DynamicPropertyType getType() const override
     {
         return m_type;
@@ -60,12 +86,44 @@ private:
     DynamicPropertyType m_type = DYNAMIC_PROPERTY_EXPOSURE;
 
     DynamicPropertyValueType m_valueType = DYNAMIC_PROPERTY_DOUBLE;
-    double m_value = 0;
+    std::atomic<double> m_value{ 0. };
+    std::atomic<unsigned long long> m_version{ 0 };
+
+    // The slope, offset, power (RGB) & saturation values of a CDL property.
+    static constexpr unsigned NUM_CDL_VALUES = 10;
+    std::atomic<double> m_cdlValues[NUM_CDL_VALUES];
+    // Odd while the CDL values are changed.
+    std::atomic<unsigned long long> m_cdlSequence{ 0 };
     bool m_isDynamic = false;
 };
 
 bool operator ==(const DynamicProperty &, const DynamicProperty &);
 
+// Install the dynamic property overrides of the calling thread while the guard exists
+// (refer to CPUProcessor::apply()). The CPU renderers then use the overridden values
+// instead of the values of their dynamic properties.
+class DynamicPropertyOverridesGuard
+{
+public:
+    DynamicPropertyOverridesGuard() = delete;
+    DynamicPropertyOverridesGuard(const DynamicPropertyOverridesGuard &) = delete;
+    DynamicPropertyOverridesGuard & operator=(const DynamicPropertyOverridesGuard &) = delete;
+
+    explicit DynamicPropertyOverridesGuard(const DynamicPropertyOverrides * overrides);
+    ~DynamicPropertyOverridesGuard();
+
+private:
+    const DynamicPropertyOverrides * m_previous;
+};
+
+// Get the dynamic property overrides of the calling thread, or null if none.
+const DynamicPropertyOverrides * GetThreadDynamicPropertyOverrides() noexcept;
+
+// Get the value of the dynamic property, taking into account the overrides of the calling
+// thread. Note that only a dynamic property could be overridden.
+double GetDynamicPropertyValue(const DynamicPropertyImpl & prop,
+                               const DynamicPropertyOverrides * overrides);
+
 }
 OCIO_NAMESPACE_EXIT
 
@@ -35,6 +35,21 @@ ExceptionMissingFile::~ExceptionMissingFile()
 {
 }
 
+
+ExceptionCancelled::ExceptionCancelled(const char * msg)
+    :   Exception(msg)
+{
+}
+
+ExceptionCancelled::ExceptionCancelled(const ExceptionCancelled & e)
+    :   Exception(e)
+{
+}
+
+ExceptionCancelled::~ExceptionCancelled()
+{
+}
+
 }
 OCIO_NAMESPACE_EXIT
 
@@ -0,0 +1,1027 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the OpenColorIO Project.
+
+#include <algorithm>
+
+#include <OpenColorIO/OpenColorIO.h>
+
+#include "FusedOpCPU.h"
+#include "MathUtils.h"
+#include "ops/CDL/CDLOpCPU.h"
+#include "ops/FixedFunction/FixedFunctionOpCPU.h"
+#include "ops/Matrix/MatrixOpData.h"
+#include "ops/Range/RangeOpData.h"
+#include "SharedCPUOps.h"
+#include "SSE.h"
+#include "ThreadPool.h"
+
+
+OCIO_NAMESPACE_ENTER
+{
+
+namespace
+{
+
+// One stage of the fused pixel loop.
+struct FusedStage
+{
+    enum Type
+    {
+        STAGE_SCALE = 0, // Diagonal matrix i.e. 4 channel scale with an optional offset.
+        STAGE_MATRIX,    // 4x4 matrix with an optional offset.
+        STAGE_RANGE,     // RGB scale & offset with optional lower and upper bounds.
+        STAGE_CDL        // RGB slope, offset, power & saturation (any CDL style).
+    };
+
+    Type m_type = STAGE_SCALE;
+
+    float m_column1[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+    float m_column2[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+    float m_column3[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+    float m_column4[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+
+    float m_scale[4]  = { 1.0f, 1.0f, 1.0f, 1.0f };
+    float m_offset[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+    float m_lower[4]  = { 0.0f, 0.0f, 0.0f, 0.0f };
+    float m_upper[4]  = { 0.0f, 0.0f, 0.0f, 0.0f };
+
+    bool m_hasScale  = false;
+    bool m_hasOffset = false;
+    bool m_hasLower  = false;
+    bool m_hasUpper  = false;
+
+    // The render parameters of the CDL renderers (i.e. already reversed if needed).
+    RenderParams m_cdl;
+};
+
+typedef std::vector<FusedStage> FusedStages;
+
+void AddMatrixStage(ConstMatrixOpDataRcPtr & mat, FusedStages & stages)
+{
+    FusedStage stage;
+
+    const unsigned long dim = mat->getArray().getLength();
+    const ArrayDouble::Values & m = mat->getArray().getValues();
+
+    if(mat->isDiagonal())
+    {
+        stage.m_type = FusedStage::STAGE_SCALE;
+
+        for(unsigned long idx=0; idx<4; ++idx)
+        {
+            stage.m_scale[idx] = (float)m[idx * dim + idx];
+        }
+    }
+    else
+    {
+        stage.m_type = FusedStage::STAGE_MATRIX;
+
+        for(unsigned long idx=0; idx<4; ++idx)
+        {
+            stage.m_column1[idx] = (float)m[idx * dim];
+            stage.m_column2[idx] = (float)m[idx * dim + 1];
+            stage.m_column3[idx] = (float)m[idx * dim + 2];
+            stage.m_column4[idx] = (float)m[idx * dim + 3];
+        }
+    }
+
+    stage.m_hasOffset = mat->hasOffsets();
+    if(stage.m_hasOffset)
+    {
+        const MatrixOpData::Offsets & o = mat->getOffsets();
+        for(unsigned long idx=0; idx<4; ++idx)
+        {
+            stage.m_offset[idx] = (float)o[idx];
+        }
+    }
+
+    stages.push_back(stage);
+}
+
+void AddRangeStage(ConstRangeOpDataRcPtr & range, FusedStages & stages)
+{
+    FusedStage stage;
+    stage.m_type = FusedStage::STAGE_RANGE;
+
+    stage.m_hasScale = range->scales();
+    stage.m_hasLower = !range->minIsEmpty();
+    stage.m_hasUpper = !range->maxIsEmpty();
+
+    for(unsigned long idx=0; idx<3; ++idx)
+    {
+        stage.m_scale[idx]  = (float)range->getScale();
+        stage.m_offset[idx] = (float)range->getOffset();
+        stage.m_lower[idx]  = (float)range->getMinOutValue();
+        stage.m_upper[idx]  = (float)range->getMaxOutValue();
+    }
+
+    stages.push_back(stage);
+}
+
+void AddCDLStage(ConstCDLOpDataRcPtr & cdl, FusedStages & stages)
+{
+    FusedStage stage;
+    stage.m_type = FusedStage::STAGE_CDL;
+    stage.m_cdl.update(cdl);
+
+    stages.push_back(stage);
+}
+
+#ifdef USE_SSE
+// Process the RGB channels of one pixel as the CDL renderers do.
+inline __m128 ProcessCDL(const RenderParams & params, __m128 pix)
+{
+    const __m128 slope      = _mm_loadu_ps(params.getSlope());
+    const __m128 offset     = _mm_loadu_ps(params.getOffset());
+    const __m128 power      = _mm_loadu_ps(params.getPower());
+    const __m128 saturation = _mm_set1_ps(params.getSaturation());
+
+    if(params.isReverse())
+    {
+        if(params.isNoClamp())
+        {
+            CDLUtil::ApplyReverse<false>(pix, slope, offset, power, saturation);
+        }
+        else
+        {
+            CDLUtil::ApplyReverse<true>(pix, slope, offset, power, saturation);
+        }
+    }
+    else
+    {
+        if(params.isNoClamp())
+        {
+            CDLUtil::ApplyForward<false>(pix, slope, offset, power, saturation);
+        }
+        else
+        {
+            CDLUtil::ApplyForward<true>(pix, slope, offset, power, saturation);
+        }
+    }
+
+    return pix;
+}
+
+// Process all the stages on one pixel.
+inline __m128 ProcessStages(const FusedStages & stages, __m128 pix)
+{
+    // Only process the RGB channels for the range stages.
+    const __m128 rgbMask = _mm_castsi128_ps(_mm_set_epi32(0, -1, -1, -1));
+
+    for(const auto & stage : stages)
+    {
+        switch(stage.m_type)
+        {
+            case FusedStage::STAGE_SCALE:
+            {
+                pix = _mm_mul_ps(pix, _mm_loadu_ps(stage.m_scale));
+                if(stage.m_hasOffset)
+                {
+                    pix = _mm_add_ps(pix, _mm_loadu_ps(stage.m_offset));
+                }
+                break;
+            }
+            case FusedStage::STAGE_MATRIX:
+            {
+                const __m128 r = _mm_shuffle_ps(pix, pix, _MM_SHUFFLE(0, 0, 0, 0));
+                const __m128 g = _mm_shuffle_ps(pix, pix, _MM_SHUFFLE(1, 1, 1, 1));
+                const __m128 b = _mm_shuffle_ps(pix, pix, _MM_SHUFFLE(2, 2, 2, 2));
+                const __m128 a = _mm_shuffle_ps(pix, pix, _MM_SHUFFLE(3, 3, 3, 3));
+
+                const __m128 rm0 = _mm_mul_ps(_mm_loadu_ps(stage.m_column1), r);
+                const __m128 gm1 = _mm_mul_ps(_mm_loadu_ps(stage.m_column2), g);
+                const __m128 bm2 = _mm_mul_ps(_mm_loadu_ps(stage.m_column3), b);
+                const __m128 am3 = _mm_mul_ps(_mm_loadu_ps(stage.m_column4), a);
+
+                pix = _mm_add_ps(_mm_add_ps(rm0, gm1), _mm_add_ps(bm2, am3));
+                if(stage.m_hasOffset)
+                {
+                    pix = _mm_add_ps(pix, _mm_loadu_ps(stage.m_offset));
+                }
+                break;
+            }
+            case FusedStage::STAGE_RANGE:
+            {
+                __m128 t = pix;
+                if(stage.m_hasScale)
+                {
+                    t = _mm_add_ps(_mm_mul_ps(t, _mm_loadu_ps(stage.m_scale)),
+                                   _mm_loadu_ps(stage.m_offset));
+                }
+
+                // Note that the argument order makes NaNs become the bounds.
+                if(stage.m_hasLower)
+                {
+                    t = _mm_max_ps(t, _mm_loadu_ps(stage.m_lower));
+                }
+                if(stage.m_hasUpper)
+                {
+                    t = _mm_min_ps(t, _mm_loadu_ps(stage.m_upper));
+                }
+
+                pix = _mm_or_ps(_mm_and_ps(rgbMask, t), _mm_andnot_ps(rgbMask, pix));
+                break;
+            }
+            case FusedStage::STAGE_CDL:
+            {
+                const __m128 t = ProcessCDL(stage.m_cdl, pix);
+                pix = _mm_or_ps(_mm_and_ps(rgbMask, t), _mm_andnot_ps(rgbMask, pix));
+                break;
+            }
+        }
+    }
+
+    return pix;
+}
+#else
+// Process the RGB channels of one pixel as the CDL renderers do.
+inline void ProcessCDL(const RenderParams & params, float * pix)
+{
+    if(params.isReverse())
+    {
+        if(params.isNoClamp())
+        {
+            CDLUtil::ApplyReverse<false>(pix, params);
+        }
+        else
+        {
+            CDLUtil::ApplyReverse<true>(pix, params);
+        }
+    }
+    else
+    {
+        if(params.isNoClamp())
+        {
+            CDLUtil::ApplyForward<false>(pix, params);
+        }
+        else
+        {
+            CDLUtil::ApplyForward<true>(pix, params);
+        }
+    }
+}
+
+// Process all the stages on one pixel.
+inline void ProcessStages(const FusedStages & stages, float * pix)
+{
+    for(const auto & stage : stages)
+    {
+        switch(stage.m_type)
+        {
+            case FusedStage::STAGE_SCALE:
+            {
+                for(int c=0; c<4; ++c)
+                {
+                    pix[c] = pix[c] * stage.m_scale[c];
+                    if(stage.m_hasOffset)
+                    {
+                        pix[c] = pix[c] + stage.m_offset[c];
+                    }
+                }
+                break;
+            }
+            case FusedStage::STAGE_MATRIX:
+            {
+                const float r = pix[0];
+                const float g = pix[1];
+                const float b = pix[2];
+                const float a = pix[3];
+
+                for(int c=0; c<4; ++c)
+                {
+                    pix[c] = r*stage.m_column1[c]
+                           + g*stage.m_column2[c]
+                           + b*stage.m_column3[c]
+                           + a*stage.m_column4[c];
+                    if(stage.m_hasOffset)
+                    {
+                        pix[c] = pix[c] + stage.m_offset[c];
+                    }
+                }
+                break;
+            }
+            case FusedStage::STAGE_RANGE:
+            {
+                for(int c=0; c<3; ++c)
+                {
+                    if(stage.m_hasScale)
+                    {
+                        pix[c] = pix[c] * stage.m_scale[c] + stage.m_offset[c];
+                    }
+
+                    // NaNs become the bounds.
+                    if(stage.m_hasLower)
+                    {
+                        pix[c] = std::max(stage.m_lower[c], pix[c]);
+                    }
+                    if(stage.m_hasUpper)
+                    {
+                        pix[c] = std::min(stage.m_upper[c], pix[c]);
+                    }
+                }
+                break;
+            }
+            case FusedStage::STAGE_CDL:
+            {
+                ProcessCDL(stage.m_cdl, pix);
+                break;
+            }
+        }
+    }
+}
+#endif
+
+// Process a run of fused ops in one pass over the pixels. Each stage performs
+// exactly the same computations than the corresponding CPU op renderer so the
+// fused results are identical.
+class FusedRenderer : public OpCPU
+{
+public:
+    FusedRenderer() = delete;
+    FusedRenderer(const FusedRenderer &) = delete;
+    explicit FusedRenderer(const FusedStages & stages);
+
+    void apply(const void * inImg, void * outImg, long numPixels) const override;
+
+    bool hasPlanarApply() const override { return true; }
+    void applyPlanar(const float * const * inPlanes, float * const * outPlanes,
+                     long numPixels) const override;
+
+    bool hasRGBApply() const override { return true; }
+    void applyRGB(const float * inImg, float * outImg, long numPixels) const override;
+
+private:
+    const FusedStages m_stages;
+};
+
+FusedRenderer::FusedRenderer(const FusedStages & stages)
+    :   OpCPU()
+    ,   m_stages(stages)
+{
+}
+
+void FusedRenderer::apply(const void * inImg, void * outImg, long numPixels) const
+{
+    const float * in = (const float *)inImg;
+    float * out = (float *)outImg;
+
+#ifdef USE_SSE
+    for(long idx=0; idx<numPixels; ++idx)
+    {
+        const __m128 pix = ProcessStages(m_stages, _mm_loadu_ps(in));
+
+        _mm_storeu_ps(out, pix);
+
+        in  += 4;
+        out += 4;
+    }
+#else
+    for(long idx=0; idx<numPixels; ++idx)
+    {
+        float pix[4] = { in[0], in[1], in[2], in[3] };
+
+        ProcessStages(m_stages, pix);
+
+        out[0] = pix[0];
+        out[1] = pix[1];
+        out[2] = pix[2];
+        out[3] = pix[3];
+
+        in  += 4;
+        out += 4;
+    }
+#endif
+}
+
+void FusedRenderer::applyPlanar(const float * const * inPlanes, float * const * outPlanes,
+                                long numPixels) const
+{
+#ifdef USE_SSE
+    // Process four pixels at a time i.e. one register per channel.
+    for(long idx=0; idx<numPixels; idx+=4)
+    {
+        const long count = std::min(4L, numPixels - idx);
+
+        __m128 pix[4];
+        for(int c=0; c<4; ++c)
+        {
+            pix[c] = sseLoadPartial(inPlanes[c] + idx, count);
+        }
+
+        for(const auto & stage : m_stages)
+        {
+            switch(stage.m_type)
+            {
+                case FusedStage::STAGE_SCALE:
+                {
+                    for(int c=0; c<4; ++c)
+                    {
+                        pix[c] = _mm_mul_ps(pix[c], _mm_set1_ps(stage.m_scale[c]));
+                        if(stage.m_hasOffset)
+                        {
+                            pix[c] = _mm_add_ps(pix[c], _mm_set1_ps(stage.m_offset[c]));
+                        }
+                    }
+                    break;
+                }
+                case FusedStage::STAGE_MATRIX:
+                {
+                    const __m128 r = pix[0];
+                    const __m128 g = pix[1];
+                    const __m128 b = pix[2];
+                    const __m128 a = pix[3];
+
+                    for(int c=0; c<4; ++c)
+                    {
+                        const __m128 rm0 = _mm_mul_ps(_mm_set1_ps(stage.m_column1[c]), r);
+                        const __m128 gm1 = _mm_mul_ps(_mm_set1_ps(stage.m_column2[c]), g);
+                        const __m128 bm2 = _mm_mul_ps(_mm_set1_ps(stage.m_column3[c]), b);
+                        const __m128 am3 = _mm_mul_ps(_mm_set1_ps(stage.m_column4[c]), a);
+
+                        pix[c] = _mm_add_ps(_mm_add_ps(rm0, gm1), _mm_add_ps(bm2, am3));
+                        if(stage.m_hasOffset)
+                        {
+                            pix[c] = _mm_add_ps(pix[c], _mm_set1_ps(stage.m_offset[c]));
+                        }
+                    }
+                    break;
+                }
+                case FusedStage::STAGE_RANGE:
+                {
+                    for(int c=0; c<3; ++c)
+                    {
+                        if(stage.m_hasScale)
+                        {
+                            pix[c] = _mm_add_ps(_mm_mul_ps(pix[c], _mm_set1_ps(stage.m_scale[c])),
+                                                _mm_set1_ps(stage.m_offset[c]));
+                        }
+
+                        // Note that the argument order makes NaNs become the bounds.
+                        if(stage.m_hasLower)
+                        {
+                            pix[c] = _mm_max_ps(pix[c], _mm_set1_ps(stage.m_lower[c]));
+                        }
+                        if(stage.m_hasUpper)
+                        {
+                            pix[c] = _mm_min_ps(pix[c], _mm_set1_ps(stage.m_upper[c]));
+                        }
+                    }
+                    break;
+                }
+                case FusedStage::STAGE_CDL:
+                {
+                    // The CDL saturation mixes the channels of a pixel so the four pixels
+                    // are processed one by one, and the alpha channel is left unchanged.
+                    __m128 p0 = pix[0], p1 = pix[1], p2 = pix[2], p3 = pix[3];
+                    _MM_TRANSPOSE4_PS(p0, p1, p2, p3);
+
+                    p0 = ProcessCDL(stage.m_cdl, p0);
+                    p1 = ProcessCDL(stage.m_cdl, p1);
+                    p2 = ProcessCDL(stage.m_cdl, p2);
+                    p3 = ProcessCDL(stage.m_cdl, p3);
+
+                    _MM_TRANSPOSE4_PS(p0, p1, p2, p3);
+                    pix[0] = p0;
+                    pix[1] = p1;
+                    pix[2] = p2;
+                    break;
+                }
+            }
+        }
+
+        for(int c=0; c<4; ++c)
+        {
+            sseStorePartial(outPlanes[c] + idx, pix[c], count);
+        }
+    }
+#else
+    for(long idx=0; idx<numPixels; ++idx)
+    {
+        float pix[4] = { inPlanes[0][idx], inPlanes[1][idx], inPlanes[2][idx], inPlanes[3][idx] };
+
+        ProcessStages(m_stages, pix);
+
+        for(int c=0; c<4; ++c)
+        {
+            outPlanes[c][idx] = pix[c];
+        }
+    }
+#endif
+}
+
+void FusedRenderer::applyRGB(const float * in, float * out, long numPixels) const
+{
+    for(long idx=0; idx<numPixels; ++idx)
+    {
+#ifdef USE_SSE
+        const __m128 pix = ProcessStages(m_stages, _mm_setr_ps(in[0], in[1], in[2], 0.0f));
+
+        // Only store the RGB channels i.e. do not overwrite the next pixel.
+        _mm_storel_pi((__m64 *)out, pix);
+        _mm_store_ss(out + 2, _mm_movehl_ps(pix, pix));
+#else
+        float pix[4] = { in[0], in[1], in[2], 0.0f };
+
+        ProcessStages(m_stages, pix);
+
+        out[0] = pix[0];
+        out[1] = pix[1];
+        out[2] = pix[2];
+#endif
+
+        in  += 3;
+        out += 3;
+    }
+}
+
+// Process a shaper 1D LUT followed by a 3D LUT (i.e. the layout of the baked LUT formats) in
+// one pass over the image. The pixels are processed by small chunks so the shaped values stay
+// in the cache between the two renderers, and the results are the ones of the renderers.
+class ShaperLut3DRenderer : public OpCPU
+{
+public:
+    ShaperLut3DRenderer() = delete;
+    ShaperLut3DRenderer(const ShaperLut3DRenderer &) = delete;
+    ShaperLut3DRenderer(const ConstOpCPURcPtr & shaper, const ConstOpCPURcPtr & lut);
+
+    void apply(const void * inImg, void * outImg, long numPixels) const override;
+
+    size_t getMemorySize() const override
+    {
+        return m_shaper->getMemorySize() + m_lut->getMemorySize();
+    }
+
+private:
+    // Number of pixels of a chunk.
+    static constexpr long CHUNK_SIZE = 64;
+
+    const ConstOpCPURcPtr m_shaper;
+    const ConstOpCPURcPtr m_lut;
+};
+
+ShaperLut3DRenderer::ShaperLut3DRenderer(const ConstOpCPURcPtr & shaper,
+                                         const ConstOpCPURcPtr & lut)
+    :   OpCPU()
+    ,   m_shaper(shaper)
+    ,   m_lut(lut)
+{
+}
+
+void ShaperLut3DRenderer::apply(const void * inImg, void * outImg, long numPixels) const
+{
+    const float * in = (const float *)inImg;
+    float * out = (float *)outImg;
+
+    OCIO_ALIGN(float shaped[4 * CHUNK_SIZE]);
+
+    for(long idx=0; idx<numPixels; idx+=CHUNK_SIZE)
+    {
+        const long n = std::min(CHUNK_SIZE, numPixels - idx);
+
+        m_shaper->apply(in, shaped, n);
+        m_lut->apply(shaped, out, n);
+
+        in  += 4 * n;
+        out += 4 * n;
+    }
+}
+
+// Is ops[idx] a shaper 1D LUT followed by a 3D LUT?
+bool IsShaperLut3D(const OpRcPtrVec & ops, size_t idx, size_t last)
+{
+    if(idx+1>=last)
+    {
+        return false;
+    }
+
+    ConstOpRcPtr shaper = ops[idx];
+    ConstOpRcPtr lut    = ops[idx+1];
+    return shaper->data()->getType()==OpData::Lut1DType
+        && lut->data()->getType()==OpData::Lut3DType;
+}
+
+void AddFusedStage(const ConstOpRcPtr & op, FusedStages & stages)
+{
+    ConstOpDataRcPtr opData = op->data();
+
+    if(opData->getType()==OpData::MatrixType)
+    {
+        ConstMatrixOpDataRcPtr mat = DynamicPtrCast<const MatrixOpData>(opData);
+        AddMatrixStage(mat, stages);
+    }
+    else if(opData->getType()==OpData::CDLType)
+    {
+        ConstCDLOpDataRcPtr cdl = DynamicPtrCast<const CDLOpData>(opData);
+        AddCDLStage(cdl, stages);
+    }
+    else
+    {
+        ConstRangeOpDataRcPtr range = DynamicPtrCast<const RangeOpData>(opData);
+        AddRangeStage(range, stages);
+    }
+}
+
+}
+
+bool IsFusableCPUOp(const ConstOpRcPtr & op)
+{
+    ConstOpDataRcPtr opData = op->data();
+
+    switch(opData->getType())
+    {
+        case OpData::MatrixType:
+        {
+            return true;
+        }
+        case OpData::RangeType:
+        {
+            // Note that a range without any processing does not have a renderer.
+            ConstRangeOpDataRcPtr range = DynamicPtrCast<const RangeOpData>(opData);
+            return range->scales() || !range->minIsEmpty() || !range->maxIsEmpty();
+        }
+        case OpData::CDLType:
+        {
+            // The values of a dynamic CDL are read by its renderer at each apply call.
+            return !op->isDynamic();
+        }
+        default:
+        {
+            return false;
+        }
+    }
+}
+
+void CreateFusedCPUOps(const OpRcPtrVec & ops, size_t first, size_t last,
+                       ConstOpCPURcPtrVec & cpuOps)
+{
+    size_t idx = first;
+    while(idx<last)
+    {
+        // The ACES RRT sweeteners have their own specialized fused CPU op.
+        size_t numChainOps = 0;
+        ConstOpCPURcPtr chain = GetACESChainCPURenderer(ops, idx, last, numChainOps);
+        if(chain)
+        {
+            cpuOps.push_back(chain);
+            idx += numChainOps;
+            continue;
+        }
+
+        size_t runEnd = idx;
+        while(runEnd<last && IsFusableCPUOp(ops[runEnd]))
+        {
+            ++runEnd;
+        }
+
+        if(runEnd-idx>=2)
+        {
+            FusedStages stages;
+            for(; idx<runEnd; ++idx)
+            {
+                AddFusedStage(ops[idx], stages);
+            }
+
+            cpuOps.push_back(std::make_shared<FusedRenderer>(stages));
+        }
+        else if(IsShaperLut3D(ops, idx, last))
+        {
+            CheckCancellation();
+
+            ConstOpRcPtr shaper = ops[idx];
+            ConstOpRcPtr lut    = ops[idx+1];
+            cpuOps.push_back(
+                std::make_shared<ShaperLut3DRenderer>(
+                    GetSharedCPUOp(shaper, BIT_DEPTH_F32, BIT_DEPTH_F32,
+                                   [&shaper]() { return shaper->getCPUOp(); }),
+                    GetSharedCPUOp(lut, BIT_DEPTH_F32, BIT_DEPTH_F32,
+                                   [&lut]() { return lut->getCPUOp(); })));
+            idx += 2;
+        }
+        else
+        {
+            // The creation of some renderers (e.g. an exact inverse 3D LUT) is expensive.
+            CheckCancellation();
+
+            ConstOpRcPtr op = ops[idx];
+            cpuOps.push_back(GetSharedCPUOp(op, BIT_DEPTH_F32, BIT_DEPTH_F32,
+                                            [&op]() { return op->getCPUOp(); }));
+            ++idx;
+        }
+    }
+}
+
+}
+OCIO_NAMESPACE_EXIT
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+
+
+
+#ifdef OCIO_UNIT_TEST
+
+namespace OCIO = OCIO_NAMESPACE;
+#include "UnitTest.h"
+
+#include "ops/CDL/CDLOps.h"
+#include "ops/Log/LogOps.h"
+#include "ops/Lut1D/Lut1DOp.h"
+#include "ops/Lut3D/Lut3DOp.h"
+#include "ops/Matrix/MatrixOps.h"
+#include "ops/Range/RangeOps.h"
+
+namespace
+{
+
+// Compare the fused processing with the processing of the individual CPU ops.
+void ValidateFusedCPUOps(OCIO::OpRcPtrVec & ops, size_t expectedNumCPUOps)
+{
+    OCIO_CHECK_NO_THROW(OCIO::FinalizeOpVec(ops, OCIO::FINALIZATION_DEFAULT));
+
+    OCIO::ConstOpCPURcPtrVec fusedOps;
+    OCIO_CHECK_NO_THROW(OCIO::CreateFusedCPUOps(ops, 0, ops.size(), fusedOps));
+    OCIO_CHECK_EQUAL(fusedOps.size(), expectedNumCPUOps);
+
+    const float qnan = std::numeric_limits<float>::quiet_NaN();
+    const float inf  = std::numeric_limits<float>::infinity();
+
+    const std::vector<float> img = {
+        -0.50f,  0.00f,  0.25f,  1.00f,
+         0.10f,  0.40f,  0.80f,  0.50f,
+         1.50f,  2.00f, -1.00f,  0.00f,
+         qnan,   0.50f,  inf,    qnan,
+        -inf,    0.75f,  0.01f,  1.00f,
+        -0.00f,  1.00f,  0.99f, -0.25f };
+    const long numPixels = long(img.size() / 4);
+
+    std::vector<float> ref(img);
+    for(size_t idx=0; idx<ops.size(); ++idx)
+    {
+        OCIO::ConstOpRcPtr op = ops[idx];
+        op->getCPUOp()->apply(&ref[0], &ref[0], numPixels);
+    }
+
+    // Out-of-place processing.
+    std::vector<float> res(img.size(), -1.0f);
+    for(size_t idx=0; idx<fusedOps.size(); ++idx)
+    {
+        fusedOps[idx]->apply(idx==0 ? &img[0] : &res[0], &res[0], numPixels);
+    }
+
+    for(size_t idx=0; idx<res.size(); ++idx)
+    {
+        if(OCIO::IsNan(ref[idx]))
+        {
+            OCIO_CHECK_ASSERT(OCIO::IsNan(res[idx]));
+        }
+        else
+        {
+            OCIO_CHECK_EQUAL(res[idx], ref[idx]);
+        }
+    }
+
+    // In-place planar processing.
+    std::vector<float> planes(img.size());
+    for(long idx=0; idx<numPixels; ++idx)
+    {
+        for(long c=0; c<4; ++c)
+        {
+            planes[c * numPixels + idx] = img[4 * idx + c];
+        }
+    }
+
+    float * p[4] = { &planes[0], &planes[numPixels], &planes[2 * numPixels], &planes[3 * numPixels] };
+    for(size_t idx=0; idx<fusedOps.size(); ++idx)
+    {
+        OCIO_REQUIRE_ASSERT(fusedOps[idx]->hasPlanarApply());
+        fusedOps[idx]->applyPlanar(p, p, numPixels);
+    }
+
+    for(long idx=0; idx<numPixels; ++idx)
+    {
+        for(long c=0; c<4; ++c)
+        {
+            const float expected = ref[4 * idx + c];
+            const float result = planes[c * numPixels + idx];
+            if(OCIO::IsNan(expected))
+            {
+                OCIO_CHECK_ASSERT(OCIO::IsNan(result));
+            }
+            else
+            {
+                OCIO_CHECK_EQUAL(result, expected);
+            }
+        }
+    }
+
+    // In-place packed RGB processing i.e. processed as RGBA pixels with a zero alpha.
+    std::vector<float> refRGB(img);
+    for(long idx=0; idx<numPixels; ++idx)
+    {
+        refRGB[4 * idx + 3] = 0.0f;
+    }
+    for(size_t idx=0; idx<ops.size(); ++idx)
+    {
+        OCIO::ConstOpRcPtr op = ops[idx];
+        op->getCPUOp()->apply(&refRGB[0], &refRGB[0], numPixels);
+    }
+
+    std::vector<float> rgb(3 * numPixels);
+    for(long idx=0; idx<numPixels; ++idx)
+    {
+        for(long c=0; c<3; ++c)
+        {
+            rgb[3 * idx + c] = img[4 * idx + c];
+        }
+    }
+
+    for(size_t idx=0; idx<fusedOps.size(); ++idx)
+    {
+        OCIO_REQUIRE_ASSERT(fusedOps[idx]->hasRGBApply());
+        fusedOps[idx]->applyRGB(&rgb[0], &rgb[0], numPixels);
+    }
+
+    for(long idx=0; idx<numPixels; ++idx)
+    {
+        for(long c=0; c<3; ++c)
+        {
+            const float expected = refRGB[4 * idx + c];
+            const float result = rgb[3 * idx + c];
+            if(OCIO::IsNan(expected))
+            {
+                OCIO_CHECK_ASSERT(OCIO::IsNan(result));
+            }
+            else
+            {
+                OCIO_CHECK_EQUAL(result, expected);
+            }
+        }
+    }
+}
+
+}
+
+OCIO_ADD_TEST(FusedOpCPU, range_matrix)
+{
+    const double m44[16] = { 1.1, 0.2, 0.3, 0.4,
+                             0.5, 1.6, 0.7, 0.8,
+                             0.2, 0.1, 1.1, 0.2,
+                             0.3, 0.4, 0.5, 1.6 };
+    const double offset4[4] = { 0.1, -0.2, 0.3, -0.4 };
+
+    OCIO::OpRcPtrVec ops;
+    OCIO_CHECK_NO_THROW(OCIO::CreateRangeOp(ops, 0.0, 1.0, 0.5, 1.5, OCIO::TRANSFORM_DIR_FORWARD));
+    OCIO_CHECK_NO_THROW(OCIO::CreateMatrixOffsetOp(ops, m44, offset4,
+                                                   OCIO::TRANSFORM_DIR_FORWARD));
+    OCIO_CHECK_EQUAL(ops.size(), 2);
+
+    OCIO_CHECK_ASSERT(OCIO::IsFusableCPUOp(ops[0]));
+    OCIO_CHECK_ASSERT(OCIO::IsFusableCPUOp(ops[1]));
+
+    ValidateFusedCPUOps(ops, 1);
+}
+
+OCIO_ADD_TEST(FusedOpCPU, matrix_range_variants)
+{
+    const double m44[16] = { 1.1, 0.2, 0.3, 0.0,
+                             0.5, 1.6, 0.7, 0.0,
+                             0.2, 0.1, 1.1, 0.0,
+                             0.0, 0.0, 0.0, 1.0 };
+    const double scale4[4]  = { 2.0, 0.5, 1.5, 1.0 };
+    const double offset4[4] = { 0.1, -0.2, 0.3, 0.0 };
+
+    OCIO::OpRcPtrVec ops;
+    OCIO_CHECK_NO_THROW(OCIO::CreateMatrixOp(ops, m44, OCIO::TRANSFORM_DIR_FORWARD));
+    // Range with only a lower bound.
+    OCIO_CHECK_NO_THROW(OCIO::CreateRangeOp(ops, 0.0, OCIO::RangeOpData::EmptyValue(),
+                                            0.0, OCIO::RangeOpData::EmptyValue(),
+                                            OCIO::TRANSFORM_DIR_FORWARD));
+    OCIO_CHECK_NO_THROW(OCIO::CreateScaleOp(ops, scale4, OCIO::TRANSFORM_DIR_FORWARD));
+    // Range with only an upper bound.
+    OCIO_CHECK_NO_THROW(OCIO::CreateRangeOp(ops, OCIO::RangeOpData::EmptyValue(), 1.0,
+                                            OCIO::RangeOpData::EmptyValue(), 2.0,
+                                            OCIO::TRANSFORM_DIR_FORWARD));
+    OCIO_CHECK_NO_THROW(OCIO::CreateScaleOffsetOp(ops, scale4, offset4,
+                                                  OCIO::TRANSFORM_DIR_FORWARD));
+    // Inverse range i.e. the fusion happens after the finalization.
+    OCIO_CHECK_NO_THROW(OCIO::CreateRangeOp(ops, -0.5, 1.5, 0.0, 1.0,
+                                            OCIO::TRANSFORM_DIR_INVERSE));
+    OCIO_CHECK_EQUAL(ops.size(), 6);
+
+    ValidateFusedCPUOps(ops, 1);
+}
+
+OCIO_ADD_TEST(FusedOpCPU, cdl)
+{
+    const double slope[3]  = { 1.35, 1.1, 0.71 };
+    const double offset[3] = { 0.05, -0.23, 0.11 };
+    const double power[3]  = { 0.93, 0.81, 1.27 };
+    const double saturation = 1.23;
+
+    const double m44[16] = { 1.1, 0.2, 0.3, 0.0,
+                             0.5, 1.6, 0.7, 0.0,
+                             0.2, 0.1, 1.1, 0.0,
+                             0.0, 0.0, 0.0, 1.0 };
+
+    const OCIO::CDLOpData::Style styles[4] = { OCIO::CDLOpData::CDL_V1_2_FWD,
+                                               OCIO::CDLOpData::CDL_V1_2_REV,
+                                               OCIO::CDLOpData::CDL_NO_CLAMP_FWD,
+                                               OCIO::CDLOpData::CDL_NO_CLAMP_REV };
+
+    for(const auto style : styles)
+    {
+        OCIO::OpRcPtrVec ops;
+        OCIO_CHECK_NO_THROW(OCIO::CreateMatrixOp(ops, m44, OCIO::TRANSFORM_DIR_FORWARD));
+        OCIO::CDLOpDataRcPtr cdl
+            = std::make_shared<OCIO::CDLOpData>(style,
+                                                OCIO::CDLOpData::ChannelParams(slope[0], slope[1], slope[2]),
+                                                OCIO::CDLOpData::ChannelParams(offset[0], offset[1], offset[2]),
+                                                OCIO::CDLOpData::ChannelParams(power[0], power[1], power[2]),
+                                                saturation);
+        OCIO_CHECK_NO_THROW(OCIO::CreateCDLOp(ops, cdl, OCIO::TRANSFORM_DIR_FORWARD));
+        OCIO_CHECK_NO_THROW(OCIO::CreateRangeOp(ops, 0.0, 1.0, 0.5, 1.5,
+                                                OCIO::TRANSFORM_DIR_FORWARD));
+        OCIO_CHECK_EQUAL(ops.size(), 3);
+
+        OCIO_CHECK_ASSERT(OCIO::IsFusableCPUOp(ops[1]));
+
+        ValidateFusedCPUOps(ops, 1);
+    }
+}
+
+OCIO_ADD_TEST(FusedOpCPU, partial_runs)
+{
+    const double scale4[4] = { 2.0, 0.5, 1.5, 1.0 };
+    const double base = 10.0;
+
+    OCIO::OpRcPtrVec ops;
+    OCIO_CHECK_NO_THROW(OCIO::CreateScaleOp(ops, scale4, OCIO::TRANSFORM_DIR_FORWARD));
+    OCIO_CHECK_NO_THROW(OCIO::CreateLogOp(ops, base, OCIO::TRANSFORM_DIR_FORWARD));
+    OCIO_CHECK_NO_THROW(OCIO::CreateRangeOp(ops, 0.0, 1.0, 0.5, 1.5, OCIO::TRANSFORM_DIR_FORWARD));
+    OCIO_CHECK_NO_THROW(OCIO::CreateScaleOp(ops, scale4, OCIO::TRANSFORM_DIR_FORWARD));
+    OCIO_CHECK_EQUAL(ops.size(), 4);
+
+    OCIO_CHECK_ASSERT(!OCIO::IsFusableCPUOp(ops[1]));
+
+    // The single matrix and the log are not fused, but the range and the
+    // last matrix are.
+    ValidateFusedCPUOps(ops, 3);
+}
+
+OCIO_ADD_TEST(FusedOpCPU, shaper_lut3d)
+{
+    OCIO::Lut1DOpDataRcPtr shaper = std::make_shared<OCIO::Lut1DOpData>(256);
+    OCIO::Array::Values & shaperValues = shaper->getArray().getValues();
+    for(size_t idx=0; idx<shaperValues.size(); ++idx)
+    {
+        shaperValues[idx] = std::sqrt(float(idx / 3) / 255.0f);
+    }
+
+    OCIO::Lut3DOpDataRcPtr lut = std::make_shared<OCIO::Lut3DOpData>(17);
+    OCIO::Array::Values & values = lut->getArray().getValues();
+    for(size_t idx=0; idx<values.size(); ++idx)
+    {
+        values[idx] = std::cos(float(idx) * 0.02f) * 0.5f + 0.5f;
+    }
+
+    OCIO::OpRcPtrVec ops;
+    OCIO_CHECK_NO_THROW(OCIO::CreateLut1DOp(ops, shaper, OCIO::TRANSFORM_DIR_FORWARD));
+    OCIO_CHECK_NO_THROW(OCIO::CreateLut3DOp(ops, lut, OCIO::TRANSFORM_DIR_FORWARD));
+    OCIO_CHECK_NO_THROW(OCIO::CreateLogOp(ops, 10.0, OCIO::TRANSFORM_DIR_FORWARD));
+    OCIO_CHECK_NO_THROW(OCIO::FinalizeOpVec(ops, OCIO::FINALIZATION_DEFAULT));
+
+    // The shaper and the 3D LUT are processed by one CPU op.
+    OCIO::ConstOpCPURcPtrVec fusedOps;
+    OCIO_CHECK_NO_THROW(OCIO::CreateFusedCPUOps(ops, 0, ops.size(), fusedOps));
+    OCIO_REQUIRE_EQUAL(fusedOps.size(), 2);
+
+    // Several chunks with a partial last one.
+    const long numPixels = 150;
+    std::vector<float> img(4 * numPixels);
+    for(size_t idx=0; idx<img.size(); ++idx)
+    {
+        img[idx] = float(idx % 97) / 80.0f - 0.1f;
+    }
+
+    std::vector<float> ref(img);
+    for(size_t idx=0; idx<ops.size(); ++idx)
+    {
+        OCIO::ConstOpRcPtr op = ops[idx];
+        op->getCPUOp()->apply(&ref[0], &ref[0], numPixels);
+    }
+
+    // In-place processing.
+    std::vector<float> res(img);
+    for(const auto & op : fusedOps)
+    {
+        op->apply(&res[0], &res[0], numPixels);
+    }
+
+    for(size_t idx=0; idx<res.size(); ++idx)
+    {
+        OCIO_CHECK_EQUAL(res[idx], ref[idx]);
+    }
+}
+
+#endif // OCIO_UNIT_TEST
@@ -0,0 +1,39 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the OpenColorIO Project.
+
+
+#ifndef INCLUDED_OCIO_FUSEDOPCPU_H
+#define INCLUDED_OCIO_FUSEDOPCPU_H
+
+
+#include <OpenColorIO/OpenColorIO.h>
+
+#include "Op.h"
+
+
+OCIO_NAMESPACE_ENTER
+{
+
+// Is the op a candidate of a fused CPU op i.e. its processing is simple enough
+// to be done by the fused pixel loop?
+bool IsFusableCPUOp(const ConstOpRcPtr & op);
+
+// Append the CPU ops of ops[first, last[ to the list of CPU ops, replacing each
+// run of at least two consecutive fusable ops (e.g. Range -> Matrix -> CDL) by a single
+// CPU op. This fused CPU op processes all the stages of the run in one pass over
+// the pixels, the pixel values staying in registers between the stages, and the op
+// parameters being folded in the stages when the processor is finalized.
+//
+// Note that the fused CPU op produces the same results as the individual CPU ops.
+// The ACES RRT sweeteners are also replaced by a single CPU op (refer to
+// GetACESChainCPURenderer()) which produces the same results within a small tolerance.
+// A shaper 1D LUT followed by a 3D LUT (i.e. a baked LUT) is also replaced by a single CPU op
+// processing the pixels by small chunks through the two renderers.
+void CreateFusedCPUOps(const OpRcPtrVec & ops, size_t first, size_t last,
+                       ConstOpCPURcPtrVec & cpuOps);
+
+}
+OCIO_NAMESPACE_EXIT
+
+
+#endif // INCLUDED_OCIO_FUSEDOPCPU_H
@@ -1,17 +1,28 @@
 // SPDX-License-Identifier: BSD-3-Clause
 // Copyright Contributors to the OpenColorIO Project.
 
+#include <algorithm>
+#include <cmath>
+#include <cstring>
 #include <sstream>
+#include <unordered_map>
 
 #include <OpenColorIO/OpenColorIO.h>
 
+#include "CacheStatistics.h"
 #include "GPUProcessor.h"
 #include "GpuShader.h"
 #include "GpuShaderUtils.h"
 #include "Logging.h"
+#include "Mutex.h"
 #include "ops/Allocation/AllocationOp.h"
+#include "ops/Lut1D/Lut1DOpData.h"
+#include "ops/Lut1D/Lut1DOpGPU.h"
 #include "ops/Lut3D/Lut3DOp.h"
 #include "ops/NoOp/NoOps.h"
+#include "ops/Range/RangeOpData.h"
+#include "OpTools.h"
+#include "Tracing.h"
 
 
 OCIO_NAMESPACE_ENTER
@@ -20,6 +31,149 @@ OCIO_NAMESPACE_ENTER
 namespace
 {
 
+std::string GetUniformBlockName(const GpuShaderDescRcPtr & shaderDesc)
+{
+    return std::string(shaderDesc->getResourcePrefix()) + "UniformBlock";
+}
+
+std::string GetUniformKeyword(const GpuShaderText & ss, GpuShaderDesc::UniformType type)
+{
+    switch (type)
+    {
+        case GpuShaderDesc::UNIFORM_FLOAT:
+            return "float";
+        case GpuShaderDesc::UNIFORM_VEC4:
+            return ss.vec4fKeyword();
+        case GpuShaderDesc::UNIFORM_MAT4:
+            return ss.mat4fKeyword();
+    }
+
+    throw Exception("Unknown uniform type.");
+}
+
+// Declare the uniform block (i.e. once all the ops added their members).
+void WriteUniformBlock(GpuShaderDescRcPtr & shaderDesc)
+{
+    if (shaderDesc->getNumUniformBlockMembers()==0)
+    {
+        return;
+    }
+
+    const std::string blockName(GetUniformBlockName(shaderDesc));
+
+    GpuShaderText ss(shaderDesc->getLanguage());
+
+    switch (shaderDesc->getLanguage())
+    {
+        case GPU_LANGUAGE_HLSL_DX11:
+            ss.newLine() << "cbuffer " << blockName;
+            break;
+        case GPU_LANGUAGE_MSL_2_0:
+            // The block is the last parameter of the shader function.
+            ss.newLine() << "struct " << blockName;
+            break;
+        case GPU_LANGUAGE_GLSL_VK_4_6:
+            // Refer to GpuLanguage for the descriptor sets.
+            ss.newLine() << "layout(std140, set = 2, binding = " << shaderDesc->getNumUniforms()
+                         << ") uniform " << blockName;
+            break;
+        default:
+            ss.newLine() << "layout(std140) uniform " << blockName;
+            break;
+    }
+
+    ss.newLine() << "{";
+    ss.indent();
+
+    for (unsigned idx = 0; idx < shaderDesc->getNumUniformBlockMembers(); ++idx)
+    {
+        const char * name = nullptr;
+        GpuShaderDesc::UniformType type = GpuShaderDesc::UNIFORM_FLOAT;
+        unsigned offset = 0;
+        DynamicPropertyRcPtr value;
+        shaderDesc->getUniformBlockMember(idx, name, type, offset, value);
+
+        ss.newLine() << GetUniformKeyword(ss, type) << " " << name << ";";
+    }
+
+    ss.dedent();
+    ss.newLine() << "};";
+
+    shaderDesc->addToDeclareShaderCode(ss.string().c_str());
+}
+
+// A resource parameter of the Metal shader function (i.e. Metal has no global resources).
+struct MetalParameter
+{
+    std::string m_type;       // The type in the shader function.
+    std::string m_kernelType; // The type in the compute kernel.
+    std::string m_name;
+    std::string m_binding;    // The attribute in the compute kernel.
+};
+
+// The first buffers of the compute kernel are the image buffers & size.
+constexpr unsigned MetalKernelFirstBuffer = 3;
+
+std::vector<MetalParameter> GetMetalParameters(const GpuShaderDescRcPtr & shaderDesc)
+{
+    std::vector<MetalParameter> params;
+
+    unsigned textureIdx = 0;
+    const auto addTexture = [&params, &textureIdx](const std::string & type, const char * name)
+    {
+        const std::string idx(std::to_string(textureIdx++));
+        const std::string textureName(GpuShaderText::getTextureName(name));
+        params.push_back({ type, type, textureName, "[[texture(" + idx + ")]]" });
+        params.push_back({ "sampler", "sampler", name, "[[sampler(" + idx + ")]]" });
+    };
+
+    for(unsigned idx = 0; idx < shaderDesc->getNum3DTextures(); ++idx)
+    {
+        const char * name = nullptr;
+        const char * id = nullptr;
+        unsigned edgelen = 0;
+        Interpolation interpolation = INTERP_UNKNOWN;
+        shaderDesc->get3DTexture(idx, name, id, edgelen, interpolation);
+
+        addTexture("texture3d<float>", name);
+    }
+
+    for(unsigned idx = 0; idx < shaderDesc->getNumTextures(); ++idx)
+    {
+        const char * name = nullptr;
+        const char * id = nullptr;
+        unsigned width = 0;
+        unsigned height = 0;
+        GpuShaderDesc::TextureType channel = GpuShaderDesc::TEXTURE_RGB_CHANNEL;
+        Interpolation interpolation = INTERP_UNKNOWN;
+        shaderDesc->getTexture(idx, name, id, width, height, channel, interpolation);
+
+        // The 1D textures are 2D textures with a height of one.
+        addTexture("texture2d<float>", name);
+    }
+
+    unsigned bufferIdx = MetalKernelFirstBuffer;
+
+    for(unsigned idx = 0; idx < shaderDesc->getNumUniforms(); ++idx)
+    {
+        const char * name = nullptr;
+        DynamicPropertyRcPtr value;
+        shaderDesc->getUniform(idx, name, value);
+
+        params.push_back({ "float", "constant float &", name,
+                           "[[buffer(" + std::to_string(bufferIdx++) + ")]]" });
+    }
+
+    if (shaderDesc->getNumUniformBlockMembers() > 0)
+    {
+        const std::string type("constant " + GetUniformBlockName(shaderDesc) + " &");
+        params.push_back({ type, type, GetUniformBlockName(shaderDesc) + "Values",
+                           "[[buffer(" + std::to_string(bufferIdx++) + ")]]" });
+    }
+
+    return params;
+}
+
 void WriteShaderHeader(GpuShaderDescRcPtr & shaderDesc)
 {
     const std::string fcnName(shaderDesc->getFunctionName());
@@ -30,13 +184,48 @@ void WriteShaderHeader(GpuShaderDescRcPtr & shaderDesc)
     ss.newLine() << "// Declaration of the OCIO shader function";
     ss.newLine();
 
-    ss.newLine() << ss.vec4fKeyword() << " " << fcnName 
-                 << "(in "  << ss.vec4fKeyword() << " inPixel)";
+    if(shaderDesc->getLanguage()==GPU_LANGUAGE_MSL_2_0)
+    {
+        // Metal has no global resources so the textures, samplers & uniforms are
+        // parameters of the shader function.
+        ss.newLine() << ss.vec4fKeyword() << " " << fcnName 
+                     << "(" << ss.vec4fKeyword() << " inPixel";
+        ss.indent();
+
+        for(const auto & param : GetMetalParameters(shaderDesc))
+        {
+            ss.newLine() << ", " << param.m_type << " " << param.m_name;
+        }
+
+        ss.dedent();
+        ss.newLine() << ")";
+    }
+    else
+    {
+        ss.newLine() << ss.vec4fKeyword() << " " << fcnName 
+                     << "(in "  << ss.vec4fKeyword() << " inPixel)";
+    }
     ss.newLine() << "{";
     ss.indent();
     ss.newLine() << ss.vec4fKeyword() << " " 
                  << shaderDesc->getPixelName() << " = inPixel;";
 
+    if (shaderDesc->getLanguage()==GPU_LANGUAGE_MSL_2_0)
+    {
+        // The code of the ops uses the names of the uniform block members.
+        for (unsigned idx = 0; idx < shaderDesc->getNumUniformBlockMembers(); ++idx)
+        {
+            const char * name = nullptr;
+            GpuShaderDesc::UniformType type = GpuShaderDesc::UNIFORM_FLOAT;
+            unsigned offset = 0;
+            DynamicPropertyRcPtr value;
+            shaderDesc->getUniformBlockMember(idx, name, type, offset, value);
+
+            ss.newLine() << GetUniformKeyword(ss, type) << " " << name << " = "
+                         << GetUniformBlockName(shaderDesc) << "Values." << name << ";";
+        }
+    }
+
     shaderDesc->addToFunctionHeaderShaderCode(ss.string().c_str());
 }
 
@@ -54,11 +243,285 @@ void WriteShaderFooter(GpuShaderDescRcPtr & shaderDesc)
     shaderDesc->addToFunctionFooterShaderCode(ss.string().c_str());
 }
 
+// Add the compute kernel processing an image buffer with the shader function
+// (refer to GpuShaderDesc::setComputeKernelEnabled()).
+void WriteComputeKernel(GpuShaderDescRcPtr & shaderDesc)
+{
+    if (!shaderDesc->isComputeKernelEnabled())
+    {
+        return;
+    }
+
+    const GpuLanguage lang = shaderDesc->getLanguage();
 
-OpRcPtrVec Create3DLut(const OpRcPtrVec & ops, unsigned edgelen)
+    const std::string prefix(shaderDesc->getResourcePrefix());
+    const std::string fcnName(shaderDesc->getFunctionName());
+    const std::string groupSize(std::to_string(GpuShaderDesc::GetComputeWorkGroupSize()));
+
+    const std::string inPixels(prefix + "InPixels");
+    const std::string outPixels(prefix + "OutPixels");
+    const std::string width(prefix + "ImageWidth");
+    const std::string height(prefix + "ImageHeight");
+
+    GpuShaderText ss(lang);
+
+    ss.newLine();
+    ss.newLine() << "// Declaration of the OCIO compute kernel";
+    ss.newLine();
+
+    std::string pos("pos");
+    std::string call;
+
+    switch (lang)
+    {
+        case GPU_LANGUAGE_GLSL_4_0:
+        case GPU_LANGUAGE_GLSL_ES_3_0:
+        case GPU_LANGUAGE_GLSL_VK_4_6:
+        {
+            const std::string set(lang==GPU_LANGUAGE_GLSL_VK_4_6 ? "set = 3, " : "");
+
+            ss.newLine() << "layout(local_size_x = " << groupSize
+                         << ", local_size_y = " << groupSize << ") in;";
+            ss.newLine() << "layout(std430, " << set << "binding = 0) readonly buffer "
+                         << prefix << "InBuffer { vec4 " << inPixels << "[]; };";
+            ss.newLine() << "layout(std430, " << set << "binding = 1) writeonly buffer "
+                         << prefix << "OutBuffer { vec4 " << outPixels << "[]; };";
+
+            if (lang==GPU_LANGUAGE_GLSL_VK_4_6)
+            {
+                ss.newLine() << "layout(push_constant) uniform " << prefix << "ImageSize"
+                             << " { uint " << width << "; uint " << height << "; };";
+            }
+            else
+            {
+                ss.newLine() << "uniform uint " << width << ";";
+                ss.newLine() << "uniform uint " << height << ";";
+            }
+
+            ss.newLine();
+            ss.newLine() << "void main()";
+            ss.newLine() << "{";
+            ss.indent();
+            ss.newLine() << "uvec2 pos = gl_GlobalInvocationID.xy;";
+            break;
+        }
+        case GPU_LANGUAGE_HLSL_DX11:
+        {
+            ss.newLine() << "StructuredBuffer<float4> " << inPixels << ";";
+            ss.newLine() << "RWStructuredBuffer<float4> " << outPixels << ";";
+            ss.newLine() << "cbuffer " << prefix << "ImageSize"
+                         << " { uint " << width << "; uint " << height << "; };";
+
+            ss.newLine();
+            ss.newLine() << "[numthreads(" << groupSize << ", " << groupSize << ", 1)]";
+            ss.newLine() << "void " << fcnName << "Kernel(uint3 id : SV_DispatchThreadID)";
+            ss.newLine() << "{";
+            ss.indent();
+            ss.newLine() << "uint2 pos = id.xy;";
+            break;
+        }
+        case GPU_LANGUAGE_MSL_2_0:
+        {
+            const std::vector<MetalParameter> params(GetMetalParameters(shaderDesc));
+
+            ss.newLine() << "kernel void " << fcnName << "Kernel(";
+            ss.indent();
+            ss.newLine() << "device const float4 * " << inPixels << " [[buffer(0)]]";
+            ss.newLine() << ", device float4 * " << outPixels << " [[buffer(1)]]";
+            ss.newLine() << ", constant uint2 & " << prefix << "ImageSize [[buffer(2)]]";
+            for (const auto & param : params)
+            {
+                ss.newLine() << ", " << param.m_kernelType << " " << param.m_name
+                             << " " << param.m_binding;
+                call += ", " + param.m_name;
+            }
+            ss.newLine() << ", uint2 gid [[thread_position_in_grid]])";
+            ss.dedent();
+            ss.newLine() << "{";
+            ss.indent();
+            ss.newLine() << "uint " << width << " = " << prefix << "ImageSize.x;";
+            ss.newLine() << "uint " << height << " = " << prefix << "ImageSize.y;";
+            pos = "gid";
+            break;
+        }
+        case GPU_LANGUAGE_CG:
+        case GPU_LANGUAGE_GLSL_1_0:
+        case GPU_LANGUAGE_GLSL_1_3:
+        case GPU_LANGUAGE_UNKNOWN:
+        default:
+        {
+            std::string err("The compute kernel is not supported by the GPU language: ");
+            err += GpuLanguageToString(lang);
+            throw Exception(err.c_str());
+        }
+    }
+
+    ss.newLine() << "if (" << pos << ".x >= " << width << " || "
+                 << pos << ".y >= " << height << ") return;";
+    ss.newLine() << "uint idx = " << pos << ".y * " << width << " + " << pos << ".x;";
+    ss.newLine() << outPixels << "[idx] = " << fcnName << "(" << inPixels << "[idx]" << call << ");";
+    ss.dedent();
+    ss.newLine() << "}";
+
+    shaderDesc->addToFunctionFooterShaderCode(ss.string().c_str());
+}
+
+
+// Each of the following caches is cleared when full to bound the memory used by long
+// sessions.
+
+// The shader code added by the ops which only contribute to the shader function body
+// (i.e. no declaration, helper method, texture or uniform), cached by the op cache id
+// and the shader description settings used by the code.
+typedef std::unordered_map<std::string, std::string> ShaderFragmentCache;
+
+ShaderFragmentCache g_shaderFragmentCache;
+Mutex g_shaderFragmentCacheLock;
+constexpr size_t MaxShaderFragments = 1024;
+
+// The finalized shader programs, cached by processor cache id and shader description
+// settings, so extracting again the shader of a processor only copies the program (the
+// texture values being shared).
+typedef std::unordered_map<std::string, ConstGpuShaderDescRcPtr> ShaderProgramCache;
+
+ShaderProgramCache g_shaderProgramCache;
+Mutex g_shaderProgramCacheLock;
+constexpr size_t MaxShaderPrograms = 256;
+
+// The 3D LUTs baked for the legacy shader descriptions, cached by processor cache id and
+// edge length so the lattice is only processed once whatever the other shader settings
+// (e.g. language or function name) are.
+typedef std::unordered_map<std::string, ConstLut3DOpDataRcPtr> LegacyLut3DCache;
+
+LegacyLut3DCache g_legacyLut3DCache;
+Mutex g_legacyLut3DCacheLock;
+constexpr size_t MaxLegacyLut3Ds = 32;
+
+// Are the output values of the op bounded (i.e. display-referred)?
+bool HasDisplayReferredOutput(const ConstOpRcPtr & op, bool displayReferredInput)
 {
-    if(ops.size()==0) return OpRcPtrVec();
+    const ConstOpDataRcPtr data = op->data();
+    switch (data->getType())
+    {
+        case OpData::Lut1DType:
+        {
+            auto lut = DynamicPtrCast<const Lut1DOpData>(data);
+            return lut && !lut->isInputHalfDomain();
+        }
+        case OpData::Lut3DType:
+        {
+            return true;
+        }
+        case OpData::RangeType:
+        {
+            auto range = DynamicPtrCast<const RangeOpData>(data);
+            return displayReferredInput
+                || (range && !range->minIsEmpty() && !range->maxIsEmpty());
+        }
+        case OpData::MatrixType:
+        {
+            return displayReferredInput;
+        }
+        default:
+        {
+            return false;
+        }
+    }
+}
+
+// Does the op tolerate to compute in half precision (refer to
+// GpuShaderDesc::setHalfPrecisionEnabled())?
+bool ToleratesHalfPrecision(const ConstOpRcPtr & op, bool displayReferredInput)
+{
+    const ConstOpDataRcPtr data = op->data();
+    switch (data->getType())
+    {
+        case OpData::Lut3DType:
+        {
+            // The 3D LUT input is clamped.
+            return true;
+        }
+        case OpData::RangeType:
+        {
+            // The range bounds must also be representable as half values.
+            constexpr double HalfMax = 65504.;
+            auto range = DynamicPtrCast<const RangeOpData>(data);
+            return range && HasDisplayReferredOutput(op, displayReferredInput)
+                && (range->minIsEmpty() || std::fabs(range->getMinOutValue()) < HalfMax)
+                && (range->maxIsEmpty() || std::fabs(range->getMaxOutValue()) < HalfMax);
+        }
+        case OpData::MatrixType:
+        {
+            return displayReferredInput;
+        }
+        default:
+        {
+            return false;
+        }
+    }
+}
+
+void ExtractOpGpuShaderInfo(const ConstOpRcPtr & op, GpuShaderDescRcPtr & shaderDesc)
+{
+    GpuShaderCodeState before;
+    const std::string opCacheID = op->getCacheID();
+    if (op->isDynamic() || opCacheID.empty() || !GetGpuShaderCodeState(*shaderDesc, before))
+    {
+        op->extractGpuShaderInfo(shaderDesc);
+        return;
+    }
+
+    std::string key(std::to_string(int(shaderDesc->getLanguage())));
+    key += " ";
+    key += shaderDesc->getPixelName();
+    key += " ";
+    key += shaderDesc->getResourcePrefix();
+    key += shaderDesc->isUniformBlockEnabled() ? " ub " : " ";
+    key += IsHalfPrecisionOp(*shaderDesc) ? "half " : "";
+    key += opCacheID;
 
+    CacheStatistics & statistics = GetCacheStatistics(CACHE_GPU_SHADER_FRAGMENT);
+
+    {
+        AutoTimedMutex lock(g_shaderFragmentCacheLock, statistics);
+
+        const auto it = g_shaderFragmentCache.find(key);
+        if (it != g_shaderFragmentCache.end())
+        {
+            statistics.addHit();
+            shaderDesc->addToFunctionShaderCode(it->second.c_str());
+            return;
+        }
+    }
+
+    statistics.addMiss();
+
+    const size_t bodySize = before.m_functionBody->size();
+
+    op->extractGpuShaderInfo(shaderDesc);
+
+    GpuShaderCodeState after;
+    GetGpuShaderCodeState(*shaderDesc, after);
+    if (after.hasSameResources(before) && after.m_functionBody->size() >= bodySize)
+    {
+        AutoTimedMutex lock(g_shaderFragmentCacheLock, statistics);
+
+        if (g_shaderFragmentCache.size() >= MaxShaderFragments)
+        {
+            statistics.addEvictions(g_shaderFragmentCache.size());
+            g_shaderFragmentCache.clear();
+        }
+        if (g_shaderFragmentCache.find(key) == g_shaderFragmentCache.end())
+        {
+            statistics.addInsertion();
+        }
+        g_shaderFragmentCache[key] = after.m_functionBody->substr(bodySize);
+    }
+}
+
+
+Lut3DOpDataRcPtr BakeLut3D(const OpRcPtrVec & ops, unsigned edgelen)
+{
     const unsigned lut3DEdgeLen   = edgelen;
     const unsigned lut3DNumPixels = lut3DEdgeLen*lut3DEdgeLen*lut3DEdgeLen;
 
@@ -69,10 +532,7 @@ OpRcPtrVec Create3DLut(const OpRcPtrVec & ops, unsigned edgelen)
     GenerateIdentityLut3D(&lut3D[0], lut3DEdgeLen, 4, LUT3DORDER_FAST_BLUE);
 
     // Apply the lattice ops to it
-    for(const auto & op : ops)
-    {
-        op->apply(&lut3D[0], &lut3D[0], lut3DNumPixels);
-    }
+    EvalTransformRGBA(&lut3D[0], lut3DNumPixels, ops);
 
     // Convert the RGBA image to an RGB image, in place.
     auto & lutArray = lut->getArray();
@@ -83,11 +543,312 @@ OpRcPtrVec Create3DLut(const OpRcPtrVec & ops, unsigned edgelen)
         lutArray[3*i+2] = lut3D[4*i+2];
     }
 
+    return lut;
+}
+
+OpRcPtrVec Create3DLut(const OpRcPtrVec & ops, unsigned edgelen)
+{
+    if(ops.size()==0) return OpRcPtrVec();
+
+    Lut3DOpDataRcPtr lut = BakeLut3D(ops, edgelen);
+
     OpRcPtrVec newOps;
     CreateLut3DOp(newOps, lut, TRANSFORM_DIR_FORWARD);
     return newOps;
 }
 
+// Same as Create3DLut() but reusing the LUT baked by a previous call with the same key (the
+// ops being then ignored). An empty key disables the caching.
+OpRcPtrVec CreateCached3DLut(const OpRcPtrVec & ops, unsigned edgelen, const std::string & key)
+{
+    if(ops.size()==0) return OpRcPtrVec();
+
+    if(key.empty())
+    {
+        return Create3DLut(ops, edgelen);
+    }
+
+    CacheStatistics & statistics = GetCacheStatistics(CACHE_GPU_SHADER_PROGRAM);
+
+    ConstLut3DOpDataRcPtr lut;
+    {
+        AutoTimedMutex cacheLock(g_legacyLut3DCacheLock, statistics);
+
+        const auto it = g_legacyLut3DCache.find(key);
+        if(it != g_legacyLut3DCache.end())
+        {
+            lut = it->second;
+        }
+    }
+
+    if(!lut)
+    {
+        // Bake outside of the lock as processing the lattice is the expensive part.
+        lut = BakeLut3D(ops, edgelen);
+
+        AutoTimedMutex cacheLock(g_legacyLut3DCacheLock, statistics);
+
+        if(g_legacyLut3DCache.size() >= MaxLegacyLut3Ds)
+        {
+            statistics.addEvictions(g_legacyLut3DCache.size());
+            g_legacyLut3DCache.clear();
+        }
+        g_legacyLut3DCache.emplace(key, lut);
+    }
+
+    // The ops own their data so the cached LUT is copied.
+    Lut3DOpDataRcPtr lutCopy = lut->clone();
+
+    OpRcPtrVec newOps;
+    CreateLut3DOp(newOps, lutCopy, TRANSFORM_DIR_FORWARD);
+    return newOps;
+}
+
+// The GPU cost of some color processing (refer to GpuShaderDesc::setGpuBudget()).
+struct GpuCost
+{
+    unsigned m_aluCost       = 0; // i.e. number of shader statements
+    unsigned m_numTextures   = 0;
+    size_t   m_textureMemory = 0; // i.e. in bytes of 32-bit float values
+
+    GpuCost & operator+=(const GpuCost & rhs)
+    {
+        m_aluCost       += rhs.m_aluCost;
+        m_numTextures   += rhs.m_numTextures;
+        m_textureMemory += rhs.m_textureMemory;
+        return *this;
+    }
+
+    GpuCost & operator-=(const GpuCost & rhs)
+    {
+        m_aluCost       -= rhs.m_aluCost;
+        m_numTextures   -= rhs.m_numTextures;
+        m_textureMemory -= rhs.m_textureMemory;
+        return *this;
+    }
+
+    bool fits(const GpuShaderDesc & shaderDesc) const
+    {
+        return (shaderDesc.getMaxAluCost()==0 || m_aluCost <= shaderDesc.getMaxAluCost())
+            && (shaderDesc.getMaxNumTextures()==0
+                || m_numTextures <= shaderDesc.getMaxNumTextures())
+            && (shaderDesc.getMaxTextureMemory()==0
+                || m_textureMemory <= shaderDesc.getMaxTextureMemory());
+    }
+};
+
+// Measure the GPU cost of an op by extracting its shader code in a scratch shader description.
+GpuCost GetGpuCost(const ConstOpRcPtr & op, const GpuShaderDesc & shaderDesc)
+{
+    GpuShaderDescRcPtr scratch = GpuShaderDesc::CreateShaderDesc();
+    scratch->setLanguage(shaderDesc.getLanguage());
+    scratch->setTextureMaxWidth(shaderDesc.getTextureMaxWidth());
+
+    op->extractGpuShaderInfo(scratch);
+    scratch->finalize();
+
+    GpuCost cost;
+
+    const std::string text(scratch->getShaderText());
+    cost.m_aluCost = (unsigned)std::count(text.begin(), text.end(), ';');
+
+    for (unsigned idx = 0; idx < scratch->getNumTextures(); ++idx)
+    {
+        const char * name = nullptr;
+        const char * id = nullptr;
+        unsigned width = 0;
+        unsigned height = 0;
+        GpuShaderDesc::TextureType channel = GpuShaderDesc::TEXTURE_RGB_CHANNEL;
+        Interpolation interpolation = INTERP_UNKNOWN;
+        scratch->getTexture(idx, name, id, width, height, channel, interpolation);
+
+        const size_t numChannels = channel==GpuShaderDesc::TEXTURE_RGB_CHANNEL ? 3 : 1;
+        cost.m_textureMemory += size_t(width) * height * numChannels * sizeof(float);
+    }
+
+    for (unsigned idx = 0; idx < scratch->getNum3DTextures(); ++idx)
+    {
+        const char * name = nullptr;
+        const char * id = nullptr;
+        unsigned edgelen = 0;
+        Interpolation interpolation = INTERP_UNKNOWN;
+        scratch->get3DTexture(idx, name, id, edgelen, interpolation);
+
+        cost.m_textureMemory += size_t(edgelen) * edgelen * edgelen * 3 * sizeof(float);
+    }
+
+    cost.m_numTextures = scratch->getNumTextures() + scratch->getNum3DTextures();
+
+    return cost;
+}
+
+// Bake the sub-chain [first, last] of ops into a 3D LUT.
+void BakeGpuOps(OpRcPtrVec & ops, size_t first, size_t last, unsigned edgelen)
+{
+    OpRcPtrVec subChain;
+    for (size_t idx = first; idx <= last; ++idx)
+    {
+        subChain.push_back(ops[idx]);
+    }
+
+    OpRcPtrVec lut = Create3DLut(subChain, edgelen);
+    FinalizeOpVec(lut, FINALIZATION_DEFAULT);
+
+    OpRcPtrVec newOps;
+    for (size_t idx = 0; idx < first; ++idx)
+    {
+        newOps.push_back(ops[idx]);
+    }
+    newOps += lut;
+    for (size_t idx = last + 1; idx < ops.size(); ++idx)
+    {
+        newOps.push_back(ops[idx]);
+    }
+
+    ops = newOps;
+}
+
+// Replace the dynamic properties which are not live in the shader description (refer to
+// GpuShaderDesc::setDynamicPropertyLive()) by constant ones holding their current values,
+// the ops then becoming identities being removed. The ops are cloned so the processor ops
+// keep their dynamic properties.
+void FreezeDynamicProperties(OpRcPtrVec & ops, const GpuShaderDesc & shaderDesc)
+{
+    static constexpr DynamicPropertyType types[] = { DYNAMIC_PROPERTY_EXPOSURE,
+                                                     DYNAMIC_PROPERTY_CONTRAST,
+                                                     DYNAMIC_PROPERTY_GAMMA };
+
+    bool allLive = true;
+    for (const auto type : types)
+    {
+        allLive = allLive && shaderDesc.isDynamicPropertyLive(type);
+    }
+
+    if (allLive)
+    {
+        return;
+    }
+
+    OpRcPtrVec newOps;
+    for (const auto & op : ops)
+    {
+        OpRcPtr newOp = op;
+
+        for (const auto type : types)
+        {
+            if (!shaderDesc.isDynamicPropertyLive(type) && newOp->hasDynamicProperty(type))
+            {
+                if (newOp == op)
+                {
+                    newOp = op->clone();
+                }
+
+                const double value = newOp->getDynamicProperty(type)->getDoubleValue();
+                newOp->replaceDynamicProperty(
+                    type, std::make_shared<DynamicPropertyImpl>(type, value, false));
+            }
+        }
+
+        if (newOp != op)
+        {
+            // Update the cache identifier with the values.
+            newOp->finalize(FINALIZATION_DEFAULT);
+
+            if (newOp->isNoOp())
+            {
+                continue;
+            }
+        }
+
+        newOps.push_back(newOp);
+    }
+
+    ops = newOps;
+}
+
+// When the shader program would exceed the GPU budget of the shader description, bake the
+// shortest sub-chain of ops bringing it within budget into a 3D LUT. If no single sub-chain
+// is enough, all the sub-chains between the dynamic ops are baked.
+void ApplyGpuBudget(OpRcPtrVec & ops, const GpuShaderDesc & shaderDesc)
+{
+    if (shaderDesc.getMaxAluCost()==0 && shaderDesc.getMaxNumTextures()==0
+        && shaderDesc.getMaxTextureMemory()==0)
+    {
+        return;
+    }
+
+    std::vector<GpuCost> costs;
+    GpuCost total;
+    for (const auto & op : ops)
+    {
+        costs.push_back(GetGpuCost(op, shaderDesc));
+        total += costs.back();
+    }
+
+    if (total.fits(shaderDesc))
+    {
+        return;
+    }
+
+    const unsigned edgelen = shaderDesc.getBudgetLut3DEdgelen();
+
+    // Measure the cost of the 3D LUT replacing a baked sub-chain.
+    OpRcPtrVec lut;
+    Lut3DOpDataRcPtr lutData = std::make_shared<Lut3DOpData>(edgelen);
+    CreateLut3DOp(lut, lutData, TRANSFORM_DIR_FORWARD);
+    FinalizeOpVec(lut, FINALIZATION_DEFAULT);
+    const GpuCost lutCost = GetGpuCost(lut[0], shaderDesc);
+
+    // Look for the shortest sub-chain to bake, the latest one (i.e. more likely to be
+    // display-referred) being preferred.
+    const size_t numOps = ops.size();
+    for (size_t length = 1; length <= numOps; ++length)
+    {
+        for (size_t first = numOps - length + 1; first-- > 0; )
+        {
+            const size_t last = first + length - 1;
+
+            GpuCost cost = total;
+            bool isDynamic = false;
+            for (size_t idx = first; idx <= last && !isDynamic; ++idx)
+            {
+                isDynamic = ops[idx]->isDynamic();
+                cost -= costs[idx];
+            }
+            cost += lutCost;
+
+            if (!isDynamic && cost.fits(shaderDesc))
+            {
+                BakeGpuOps(ops, first, last, edgelen);
+                return;
+            }
+        }
+    }
+
+    // Bake all the sub-chains between the dynamic ops.
+    for (size_t last = ops.size(); last-- > 0; )
+    {
+        if (ops[last]->isDynamic())
+        {
+            continue;
+        }
+
+        size_t first = last;
+        while (first > 0 && !ops[first - 1]->isDynamic())
+        {
+            --first;
+        }
+
+        BakeGpuOps(ops, first, last, edgelen);
+        last = first;
+    }
+
+    std::ostringstream oss;
+    oss << "The GPU shader program exceeds the GPU budget even when baking "
+        << "all the color processing not using dynamic properties.";
+    LogWarning(oss.str());
+}
+
 }
 
 
@@ -106,15 +867,20 @@ DynamicPropertyRcPtr GPUProcessor::Impl::getDynamicProperty(DynamicPropertyType
 
 void GPUProcessor::Impl::finalize(const OpRcPtrVec & rawOps,
                                   OptimizationFlags oFlags,
-                                  FinalizationFlags fFlags)
+                                  FinalizationFlags fFlags,
+                                  LutInterpolationQuality interpQuality)
 {
+    TracingSpan span("processor", "GPUProcessor::finalize");
+
     AutoMutex lock(m_mutex);
 
     // Prepare the list of ops.
 
-    m_ops = rawOps;
+    // The format metadata of the processor is not needed.
+    m_ops.assignOps(rawOps);
 
     OptimizeOpVec(m_ops, BIT_DEPTH_F32, oFlags);
+    ApplyLutInterpolationQuality(m_ops, interpQuality);
     FinalizeOpVec(m_ops, fFlags);
     UnifyDynamicProperties(m_ops);
 
@@ -130,6 +896,16 @@ void GPUProcessor::Impl::finalize(const OpRcPtrVec & rawOps,
         }
     }
 
+    m_isDynamic = false;
+    for(const auto & op : m_ops)
+    {
+        if(op->isDynamic())
+        {
+            m_isDynamic = true;
+            break;
+        }
+    }
+
     // Compute the cache id.
 
     std::stringstream ss;
@@ -144,16 +920,55 @@ void GPUProcessor::Impl::finalize(const OpRcPtrVec & rawOps,
     m_cacheID = ss.str();
 }
 
+void GPUProcessor::Impl::appendOps(OpRcPtrVec & ops) const
+{
+    AutoMutex lock(m_mutex);
+
+    for(const auto & op : m_ops)
+    {
+        ops.push_back(op->clone());
+    }
+}
+
+size_t GPUProcessor::Impl::getMemoryFootprint() const
+{
+    return sizeof(Impl) + m_cacheID.capacity() + GetOpVecMemorySize(m_ops);
+}
+
 void GPUProcessor::Impl::extractGpuShaderInfo(GpuShaderDescRcPtr & shaderDesc) const
 {
     AutoMutex lock(m_mutex);
 
-    OpRcPtrVec gpuOps;
+    // The shader programs using uniforms (i.e. dynamic properties) are never shared.
+    std::string programKey;
+    if(!m_isDynamic)
+    {
+        const std::string settingsID = GetGpuShaderSettingsID(*shaderDesc);
+        if(!settingsID.empty())
+        {
+            programKey = m_cacheID + " " + settingsID;
+
+            CacheStatistics & statistics = GetCacheStatistics(CACHE_GPU_SHADER_PROGRAM);
+            AutoTimedMutex cacheLock(g_shaderProgramCacheLock, statistics);
+
+            const auto it = g_shaderProgramCache.find(programKey);
+            if(it != g_shaderProgramCache.end())
+            {
+                statistics.addHit();
+                CopyGpuShaderProgram(*it->second, *shaderDesc);
+                return;
+            }
+
+            statistics.addMiss();
+        }
+    }
+
+    OpRcPtrVec gpuOps = m_ops;
+    FreezeDynamicProperties(gpuOps, *shaderDesc);
 
     LegacyGpuShaderDesc * legacy = dynamic_cast<LegacyGpuShaderDesc*>(shaderDesc.get());
     if(legacy)
     {
-        gpuOps = m_ops;
 
         // GPU Process setup
         //
@@ -179,7 +994,12 @@ void GPUProcessor::Impl::extractGpuShaderInfo(GpuShaderDescRcPtr & shaderDesc) c
 
         LogDebug("GPU Ops: 3DLUT");
         FinalizeOpVec(gpuOpsCpuLatticeProcess, FINALIZATION_DEFAULT);
-        OpRcPtrVec gpuLut = Create3DLut(gpuOpsCpuLatticeProcess, legacy->getEdgelen());
+        // The baked LUT only depends on the processor and the edge length, unless dynamic
+        // properties were frozen to their current values.
+        const std::string lutKey
+            = m_isDynamic ? "" : m_cacheID + " " + std::to_string(legacy->getEdgelen());
+        OpRcPtrVec gpuLut
+            = CreateCached3DLut(gpuOpsCpuLatticeProcess, legacy->getEdgelen(), lutKey);
 
         gpuOps.clear();
         gpuOps += gpuOpsHwPreProcess;
@@ -191,17 +1011,30 @@ void GPUProcessor::Impl::extractGpuShaderInfo(GpuShaderDescRcPtr & shaderDesc) c
     }
     else
     {
-        gpuOps = m_ops;
+        ApplyGpuBudget(gpuOps, *shaderDesc);
     }
 
     // Create the shader program information
+    const bool halfPrecision = shaderDesc->isHalfPrecisionEnabled();
+    bool displayReferred = false;
     for(const auto & op : gpuOps)
     {
-        op->extractGpuShaderInfo(shaderDesc);
+        if(halfPrecision)
+        {
+            SetHalfPrecisionOp(*shaderDesc, ToleratesHalfPrecision(op, displayReferred));
+            displayReferred = HasDisplayReferredOutput(op, displayReferred);
+        }
+
+        ExtractOpGpuShaderInfo(op, shaderDesc);
     }
+    SetHalfPrecisionOp(*shaderDesc, false);
+
+    GetLut1DAtlasGPUShaderProgram(shaderDesc);
+    WriteUniformBlock(shaderDesc);
 
     WriteShaderHeader(shaderDesc);
     WriteShaderFooter(shaderDesc);
+    WriteComputeKernel(shaderDesc);
 
     shaderDesc->finalize();
 
@@ -210,12 +1043,119 @@ void GPUProcessor::Impl::extractGpuShaderInfo(GpuShaderDescRcPtr & shaderDesc) c
         LogDebug("GPU Shader");
         LogDebug(shaderDesc->getShaderText());
     }
+
+    if(!programKey.empty())
+    {
+        ConstGpuShaderDescRcPtr program = CloneGpuShaderDesc(*shaderDesc);
+
+        CacheStatistics & statistics = GetCacheStatistics(CACHE_GPU_SHADER_PROGRAM);
+        AutoTimedMutex cacheLock(g_shaderProgramCacheLock, statistics);
+
+        if(g_shaderProgramCache.size() >= MaxShaderPrograms)
+        {
+            statistics.addEvictions(g_shaderProgramCache.size());
+            g_shaderProgramCache.clear();
+        }
+        if(g_shaderProgramCache.find(programKey) == g_shaderProgramCache.end())
+        {
+            statistics.addInsertion();
+        }
+        g_shaderProgramCache[programKey] = program;
+    }
 }
 
 
 //////////////////////////////////////////////////////////////////////////
 
 
+void ClearGpuShaderFragmentCache()
+{
+    AutoMutex lock(g_shaderFragmentCacheLock);
+    g_shaderFragmentCache.clear();
+}
+
+void ClearGpuShaderProgramCache()
+{
+    {
+        AutoMutex lock(g_shaderProgramCacheLock);
+        g_shaderProgramCache.clear();
+    }
+
+    AutoMutex lock(g_legacyLut3DCacheLock);
+    g_legacyLut3DCache.clear();
+}
+
+size_t GetGpuShaderFragmentCacheMemoryUsage()
+{
+    AutoMutex lock(g_shaderFragmentCacheLock);
+
+    size_t numBytes = 0;
+    for(const auto & fragment : g_shaderFragmentCache)
+    {
+        numBytes += fragment.first.capacity() + fragment.second.capacity();
+    }
+
+    return numBytes;
+}
+
+namespace
+{
+
+size_t GetGpuShaderDescMemorySize(const GpuShaderDesc & shaderDesc)
+{
+    size_t numBytes = strlen(shaderDesc.getShaderText());
+
+    for(unsigned idx = 0; idx < shaderDesc.getNumTextures(); ++idx)
+    {
+        const char * name = nullptr;
+        const char * id = nullptr;
+        unsigned width = 0;
+        unsigned height = 0;
+        GpuShaderDesc::TextureType channel = GpuShaderDesc::TEXTURE_RGB_CHANNEL;
+        Interpolation interpolation = INTERP_UNKNOWN;
+        shaderDesc.getTexture(idx, name, id, width, height, channel, interpolation);
+
+        const size_t numChannels = channel == GpuShaderDesc::TEXTURE_RED_CHANNEL ? 1 : 3;
+        numBytes += size_t(width) * height * numChannels * sizeof(float);
+    }
+
+    for(unsigned idx = 0; idx < shaderDesc.getNum3DTextures(); ++idx)
+    {
+        const char * name = nullptr;
+        const char * id = nullptr;
+        unsigned edgelen = 0;
+        Interpolation interpolation = INTERP_UNKNOWN;
+        shaderDesc.get3DTexture(idx, name, id, edgelen, interpolation);
+
+        numBytes += size_t(edgelen) * edgelen * edgelen * 3 * sizeof(float);
+    }
+
+    return numBytes;
+}
+
+}
+
+size_t GetGpuShaderProgramCacheMemoryUsage()
+{
+    AutoMutex lock(g_shaderProgramCacheLock);
+
+    size_t numBytes = 0;
+    for(const auto & program : g_shaderProgramCache)
+    {
+        numBytes += program.first.capacity() + GetGpuShaderDescMemorySize(*program.second);
+    }
+
+    AutoMutex lutLock(g_legacyLut3DCacheLock);
+    for(const auto & lut : g_legacyLut3DCache)
+    {
+        numBytes += lut.first.capacity()
+                  + lut.second->getArray().getValues().size() * sizeof(float);
+    }
+
+    return numBytes;
+}
+
+
 void GPUProcessor::deleter(GPUProcessor * c)
 {
     delete c;
@@ -257,6 +1197,38 @@ void GPUProcessor::extractGpuShaderInfo(GpuShaderDescRcPtr & shaderDesc) const
     return getImpl()->extractGpuShaderInfo(shaderDesc);
 }
 
+size_t GPUProcessor::getMemoryFootprint() const
+{
+    return getImpl()->getMemoryFootprint();
+}
+
+ConstGPUProcessorRcPtr GPUProcessor::Concatenate(const ConstGPUProcessorRcPtr * processors,
+                                                 size_t numProcessors,
+                                                 OptimizationFlags oFlags,
+                                                 FinalizationFlags fFlags)
+{
+    if(!processors || numProcessors == 0)
+    {
+        throw Exception("Cannot concatenate an empty list of GPU processors.");
+    }
+
+    OpRcPtrVec ops;
+    for(size_t idx = 0; idx < numProcessors; ++idx)
+    {
+        if(!processors[idx])
+        {
+            throw Exception("Cannot concatenate a null GPU processor.");
+        }
+
+        processors[idx]->getImpl()->appendOps(ops);
+    }
+
+    GPUProcessorRcPtr gpu = GPUProcessorRcPtr(new GPUProcessor(), &GPUProcessor::deleter);
+    gpu->getImpl()->finalize(ops, oFlags, fFlags);
+
+    return gpu;
+}
+
 
 }
 OCIO_NAMESPACE_EXIT
@@ -30,20 +30,40 @@ public:
 
     void extractGpuShaderInfo(GpuShaderDescRcPtr & shaderDesc) const;
 
+    size_t getMemoryFootprint() const;
+
     ////////////////////////////////////////////
     //
     // Builder functions, Not exposed
         
     void finalize(const OpRcPtrVec & rawOps,
-                  OptimizationFlags oFlags, FinalizationFlags fFlags);
+                  OptimizationFlags oFlags, FinalizationFlags fFlags,
+                  LutInterpolationQuality interpQuality = LUT_INTERPOLATION_FULL);
+
+    // Append a clone of the ops (i.e. to concatenate the color processing of processors).
+    void appendOps(OpRcPtrVec & ops) const;
 
 private:
     OpRcPtrVec    m_ops;
     bool          m_hasChannelCrosstalk = true;
+    bool          m_isDynamic = false;
     std::string   m_cacheID;
     mutable Mutex m_mutex;
 };
 
+// Clear the cache of the shader code generated by the ops.
+void ClearGpuShaderFragmentCache();
+
+// Clear the cache of the shader programs generated by the processors.
+void ClearGpuShaderProgramCache();
+
+// Get the approximate number of bytes held by the shader fragment cache.
+size_t GetGpuShaderFragmentCacheMemoryUsage();
+
+// Get the approximate number of bytes held by the shader program cache (i.e. the shader
+// texts and the texture values).
+size_t GetGpuShaderProgramCacheMemoryUsage();
+
 
 }
 OCIO_NAMESPACE_EXIT
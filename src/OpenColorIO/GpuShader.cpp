@@ -2,15 +2,22 @@
 // Copyright Contributors to the OpenColorIO Project.
 
 #include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <istream>
+#include <ostream>
 #include <sstream>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include <OpenColorIO/OpenColorIO.h>
 
 #include "DynamicProperty.h"
 #include "GpuShader.h"
+#include "BitDepthUtils.h"
 #include "HashUtils.h"
+#include "Mutex.h"
 #include "ops/Lut3D/Lut3DOpData.h"
 #include "Platform.h"
 
@@ -21,10 +28,19 @@ OCIO_NAMESPACE_ENTER
 namespace
 {
 
-static void  CreateArray(const float * buf, 
-                         unsigned w, unsigned h, unsigned d, 
-                         GpuShaderDesc::TextureType type, 
-                         std::vector<float> & res)
+typedef std::vector<float> TextureValues;
+typedef OCIO_SHARED_PTR<const TextureValues> ConstTextureValuesRcPtr;
+
+// The texture values in use, indexed by texture identifier, so identical textures
+// (e.g. the same LUT used by several processors or shader programs) are stored once.
+typedef std::unordered_map<std::string, std::weak_ptr<const TextureValues>> TextureValuesCache;
+
+TextureValuesCache g_textureValuesCache;
+Mutex g_textureValuesCacheMutex;
+
+static ConstTextureValuesRcPtr CreateArray(const char * id, const float * buf, 
+                                           unsigned w, unsigned h, unsigned d, 
+                                           GpuShaderDesc::TextureType type)
 {
     if(buf==nullptr)
     {
@@ -33,8 +49,193 @@ static void  CreateArray(const float * buf,
 
     const size_t size 
         = w * h * d * (type==GpuShaderDesc::TEXTURE_RGB_CHANNEL ? 3 : 1);
-    res.resize(size);
-    memcpy(&res[0], buf, size * sizeof(float));
+
+    AutoMutex lock(g_textureValuesCacheMutex);
+
+    // The identifier is only a hint so the values are compared.
+    ConstTextureValuesRcPtr values = g_textureValuesCache[id].lock();
+    if(values && values->size()==size
+        && memcmp(values->data(), buf, size * sizeof(float))==0)
+    {
+        return values;
+    }
+
+    // Remove the values not used anymore.
+    for(auto it = g_textureValuesCache.begin(); it != g_textureValuesCache.end(); )
+    {
+        if(it->second.expired() && it->first!=id)
+        {
+            it = g_textureValuesCache.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+
+    values = std::make_shared<const TextureValues>(buf, buf + size);
+    g_textureValuesCache[id] = values;
+    return values;
+}
+
+typedef std::vector<unsigned short> TextureValues16;
+typedef OCIO_SHARED_PTR<const TextureValues16> ConstTextureValues16RcPtr;
+
+// Convert the texture values to the requested 16-bit format. The values outside of
+// [0, 1] cannot be stored in UNORM16 so F16 is then used.
+static ConstTextureValues16RcPtr CreateArray16(const TextureValues & values,
+                                               GpuShaderDesc::TextureFormat & format)
+{
+    if(format==GpuShaderDesc::TEXTURE_FORMAT_UNORM16)
+    {
+        const auto minmax = std::minmax_element(values.begin(), values.end());
+        if(values.empty() || *minmax.first < 0.0f || *minmax.second > 1.0f)
+        {
+            format = GpuShaderDesc::TEXTURE_FORMAT_F16;
+        }
+    }
+
+    auto values16 = std::make_shared<TextureValues16>(values.size());
+    unsigned short * out = values16->data();
+
+    if(format==GpuShaderDesc::TEXTURE_FORMAT_UNORM16)
+    {
+        for(const float v : values)
+        {
+            *out++ = (unsigned short)(v * 65535.0f + 0.5f);
+        }
+    }
+    else
+    {
+        for(const float v : values)
+        {
+            // Clamp to avoid infinities (i.e. NaNs are preserved).
+            *out++ = half(v > HALF_MAX ? HALF_MAX : (v < -HALF_MAX ? -HALF_MAX : v)).bits();
+        }
+    }
+
+    return values16;
+}
+
+// Binary I/O of the serialized shader descriptions, in the native byte order (refer to
+// SerializeGpuShaderDesc()).
+
+template<typename T>
+void WriteBinary(std::ostream & os, const T & value)
+{
+    os.write(reinterpret_cast<const char *>(&value), sizeof(T));
+}
+
+void WriteBinary(std::ostream & os, const std::string & str)
+{
+    WriteBinary(os, uint64_t(str.size()));
+    os.write(str.data(), str.size());
+}
+
+template<typename T>
+void WriteBinary(std::ostream & os, const std::vector<T> & values)
+{
+    WriteBinary(os, uint64_t(values.size()));
+    os.write(reinterpret_cast<const char *>(values.data()), values.size() * sizeof(T));
+}
+
+static void ThrowCorruptedShaderDesc()
+{
+    throw Exception("The serialized shader description is corrupted.");
+}
+
+template<typename T>
+void ReadBinary(std::istream & is, T & value)
+{
+    if (!is.read(reinterpret_cast<char *>(&value), sizeof(T)))
+    {
+        ThrowCorruptedShaderDesc();
+    }
+}
+
+// Read the size of a string or an array, a corrupted size being detected before any
+// allocation.
+static size_t ReadBinarySize(std::istream & is)
+{
+    static constexpr uint64_t MaxSize = uint64_t(1) << 32;
+
+    uint64_t size = 0;
+    ReadBinary(is, size);
+    if (size > MaxSize)
+    {
+        ThrowCorruptedShaderDesc();
+    }
+    return size_t(size);
+}
+
+void ReadBinary(std::istream & is, std::string & str)
+{
+    str.resize(ReadBinarySize(is));
+    if (!str.empty() && !is.read(&str[0], str.size()))
+    {
+        ThrowCorruptedShaderDesc();
+    }
+}
+
+template<typename T>
+void ReadBinary(std::istream & is, std::vector<T> & values)
+{
+    values.resize(ReadBinarySize(is));
+    if (!values.empty() 
+        && !is.read(reinterpret_cast<char *>(values.data()), values.size() * sizeof(T)))
+    {
+        ThrowCorruptedShaderDesc();
+    }
+}
+
+// Read an enumeration written as an unsigned value, checking its range.
+template<typename T>
+T ReadBinaryEnum(std::istream & is, unsigned maxValue)
+{
+    uint32_t value = 0;
+    ReadBinary(is, value);
+    if (value > maxValue)
+    {
+        ThrowCorruptedShaderDesc();
+    }
+    return static_cast<T>(value);
+}
+
+// Write the current value(s) of a dynamic property.
+static void WriteDynamicProperty(std::ostream & os, const DynamicProperty & prop)
+{
+    WriteBinary(os, uint32_t(prop.getType()));
+    if (prop.getValueType()==DYNAMIC_PROPERTY_CDL_VALUES)
+    {
+        std::vector<double> values(10);
+        prop.getCDLValues(&values[0], &values[3], &values[6], values[9]);
+        WriteBinary(os, values);
+    }
+    else
+    {
+        WriteBinary(os, prop.getDoubleValue());
+    }
+}
+
+// Read a dynamic property written by WriteDynamicProperty(), the property being dynamic.
+static DynamicPropertyRcPtr ReadDynamicProperty(std::istream & is)
+{
+    const auto type = ReadBinaryEnum<DynamicPropertyType>(is, DYNAMIC_PROPERTY_CDL);
+    if (type==DYNAMIC_PROPERTY_CDL)
+    {
+        std::vector<double> values;
+        ReadBinary(is, values);
+        if (values.size() != 10)
+        {
+            ThrowCorruptedShaderDesc();
+        }
+        return std::make_shared<DynamicPropertyImpl>(&values[0], &values[3], &values[6],
+                                                     values[9], true);
+    }
+
+    double value = 0.;
+    ReadBinary(is, value);
+    return std::make_shared<DynamicPropertyImpl>(type, value, true);
 }
 
 class PrivateImpl
@@ -69,10 +270,10 @@ public:
                 throw Exception(ss.str().c_str());
             }
 
-            // An unfortunate copy is mandatory to allow the creation of a GPU shader cache. 
-            // The cache needs a decoupling of the processor and shader instances forbidding
-            // shared naked pointer usage.
-            CreateArray(v, m_width, m_height, m_depth, m_type, m_values);
+            // A copy is mandatory to allow the creation of a GPU shader cache. The cache
+            // needs a decoupling of the processor and shader instances forbidding shared
+            // naked pointer usage. The copies of identical textures are shared.
+            m_values = CreateArray(identifier, v, m_width, m_height, m_depth, m_type);
         }
 
         std::string m_name;
@@ -83,7 +284,33 @@ public:
         GpuShaderDesc::TextureType m_type;
         Interpolation m_interp;
 
-        std::vector<float> m_values;
+        // The values are immutable so they are shared between the copies of the texture.
+        ConstTextureValuesRcPtr m_values;
+
+        // The 16-bit values (i.e. only when a 16-bit texture format is requested).
+        GpuShaderDesc::TextureFormat m_format = GpuShaderDesc::TEXTURE_FORMAT_F32;
+        ConstTextureValues16RcPtr m_values16;
+
+        void setFormat(GpuShaderDesc::TextureFormat format)
+        {
+            m_format = format;
+            if(format!=GpuShaderDesc::TEXTURE_FORMAT_F32)
+            {
+                m_values16 = CreateArray16(*m_values, m_format);
+            }
+        }
+
+        void getValues16(GpuShaderDesc::TextureFormat & format,
+                         const unsigned short *& values) const
+        {
+            if(!m_values16)
+            {
+                throw Exception("The texture values are not stored in a 16-bit format.");
+            }
+
+            format = m_format;
+            values = m_values16->data();
+        }
 
         Texture() = delete;
     };
@@ -122,6 +349,19 @@ public:
 
     typedef std::vector<Uniform> Uniforms;
 
+    struct UniformBlockMember
+    {
+        std::string m_name;
+        GpuShaderDesc::UniformType m_type;
+        unsigned m_offset;
+
+        // The values of an op parameter, or the dynamic property.
+        std::vector<float> m_values;
+        DynamicPropertyRcPtr m_value;
+    };
+
+    typedef std::vector<UniformBlockMember> UniformBlockMembers;
+
 public:
     PrivateImpl()
         :   m_max1DLUTWidth(4 * 1024)
@@ -137,7 +377,8 @@ public:
 
     void addTexture(const char * name, const char * id, unsigned width, unsigned height, 
                     GpuShaderDesc::TextureType channel,
-                    Interpolation interpolation, const float * values)
+                    Interpolation interpolation, const float * values,
+                    GpuShaderDesc::TextureFormat format)
     {
         if(width > get1dLutMaxWidth())
         {
@@ -148,6 +389,7 @@ public:
         }
 
         Texture t(name, id, width, height, 1, channel, interpolation, values);
+        t.setFormat(format);
         m_textures.push_back(t);
     }
 
@@ -184,11 +426,26 @@ public:
         }
 
         const Texture & t = m_textures[index];
-        values   = &t.m_values[0];
+        values   = t.m_values->data();
+    }
+
+    void getTextureValues16(unsigned index, GpuShaderDesc::TextureFormat & format,
+                            const unsigned short *& values) const
+    {
+        if(index >= m_textures.size())
+        {
+            std::ostringstream ss;
+            ss << "1D LUT access error: index = " << index
+               << " where size = " << m_textures.size();
+            throw Exception(ss.str().c_str());
+        }
+
+        m_textures[index].getValues16(format, values);
     }
 
     void add3DTexture(const char * name, const char * id, unsigned dimension, 
-                      Interpolation interpolation, const float * values)
+                      Interpolation interpolation, const float * values,
+                      GpuShaderDesc::TextureFormat format)
     {
         if(dimension > get3dLutMaxDimension())
         {
@@ -202,6 +459,7 @@ public:
             name, id, dimension, dimension, dimension, 
             GpuShaderDesc::TEXTURE_RGB_CHANNEL, 
             interpolation, values);
+        t.setFormat(format);
         m_textures3D.push_back(t);
     }
 
@@ -235,7 +493,21 @@ public:
         }
 
         const Texture & t = m_textures3D[index];
-        values = &t.m_values[0];
+        values = t.m_values->data();
+    }
+
+    void get3DTextureValues16(unsigned index, GpuShaderDesc::TextureFormat & format,
+                              const unsigned short *& values) const
+    {
+        if(index >= m_textures3D.size())
+        {
+            std::ostringstream ss;
+            ss << "3D LUT access error: index = " << index
+               << " where size = " << m_textures3D.size();
+            throw Exception(ss.str().c_str());
+        }
+
+        m_textures3D[index].getValues16(format, values);
     }
 
     unsigned getNumUniforms() const
@@ -278,13 +550,120 @@ public:
         return true;
     }
 
+    // Add a member to the uniform block using the std140 layout rules (i.e. only for
+    // float, vec4 & mat4 types which have the same offsets in HLSL cbuffers & Metal
+    // structs) and return its index.
+    size_t addUniformBlockMember(const std::string & name, GpuShaderDesc::UniformType type,
+                                 const float * values, const DynamicPropertyRcPtr & value)
+    {
+        static constexpr unsigned NumFloats[] = { 1, 4, 16 };
+
+        UniformBlockMember m;
+        m.m_name = name;
+        m.m_type = type;
+
+        const unsigned alignment = (type==GpuShaderDesc::UNIFORM_FLOAT) ? 4 : 16;
+        m.m_offset = (m_uniformBlockSize + alignment - 1) / alignment * alignment;
+
+        if (value)
+        {
+            m.m_value 
+                = std::make_shared<DynamicPropertyImpl>(
+                    *dynamic_cast<DynamicPropertyImpl*>(value.get()) );
+        }
+        else
+        {
+            m.m_values.assign(values, values + NumFloats[type]);
+        }
+
+        m_uniformBlockSize = m.m_offset + NumFloats[type] * unsigned(sizeof(float));
+        m_uniformBlock.push_back(m);
+
+        return m_uniformBlock.size() - 1;
+    }
+
+    // Add a dynamic property to the uniform block unless already there.
+    void addUniformBlockMember(const std::string & name, const DynamicPropertyRcPtr & value)
+    {
+        for (const auto & m : m_uniformBlock)
+        {
+            if (m.m_value && *m.m_value == *value)
+            {
+                if (name!=m.m_name)
+                {
+                    std::string err("Same dynamic properties must have the same name: ");
+                    err += m.m_name + " vs. " + name;
+                    throw Exception(err.c_str());
+                }
+
+                return;
+            }
+        }
+
+        addUniformBlockMember(name, GpuShaderDesc::UNIFORM_FLOAT, nullptr, value);
+    }
+
+    void getUniformBlockMember(unsigned index, const char *& name,
+                               GpuShaderDesc::UniformType & type, unsigned & offset,
+                               DynamicPropertyRcPtr & value) const
+    {
+        if (index >= (unsigned)m_uniformBlock.size())
+        {
+            std::ostringstream ss;
+            ss << "Uniform block access error: index = " << index
+               << " where size = " << m_uniformBlock.size();
+            throw Exception(ss.str().c_str());
+        }
+
+        const UniformBlockMember & m = m_uniformBlock[index];
+        name   = m.m_name.c_str();
+        type   = m.m_type;
+        offset = m.m_offset;
+        value  = m.m_value;
+    }
+
+    // The std140 block size is a multiple of a vec4.
+    unsigned getUniformBlockSize() const
+    {
+        return (m_uniformBlockSize + 15) / 16 * 16;
+    }
+
+    void fillUniformBlock(void * buffer) const
+    {
+        if (buffer==nullptr)
+        {
+            throw Exception("The uniform block buffer is invalid.");
+        }
+
+        char * out = reinterpret_cast<char *>(buffer);
+        memset(out, 0, getUniformBlockSize());
+
+        for (const auto & m : m_uniformBlock)
+        {
+            if (m.m_value)
+            {
+                const float v = (float)m.m_value->getDoubleValue();
+                memcpy(out + m.m_offset, &v, sizeof(float));
+            }
+            else
+            {
+                memcpy(out + m.m_offset, m.m_values.data(), m.m_values.size() * sizeof(float));
+            }
+        }
+    }
+
     void createShaderText(const char * shaderDeclarations,
                           const char * shaderHelperMethods,
                           const char * shaderFunctionHeader,
                           const char * shaderFunctionBody,
                           const char * shaderFunctionFooter)
     {
+        const auto length = [](const char * str) { return str ? strlen(str) : 0; };
+
         m_shaderCode.resize(0);
+        m_shaderCode.reserve(length(shaderDeclarations) + length(shaderHelperMethods)
+                             + length(shaderFunctionHeader) + length(shaderFunctionBody)
+                             + length(shaderFunctionFooter));
         m_shaderCode += (shaderDeclarations   && *shaderDeclarations)   ? shaderDeclarations   : "";
         m_shaderCode += (shaderHelperMethods  && *shaderHelperMethods)  ? shaderHelperMethods  : "";
         m_shaderCode += (shaderFunctionHeader && *shaderFunctionHeader) ? shaderFunctionHeader : "";
@@ -303,28 +682,272 @@ public:
                          m_functionBody.c_str(), 
                          m_functionFooter.c_str());
 
-        // Compute the identifier
-        std::ostringstream os;
-        os << m_shaderCode;
-        os << "T3D: " << m_textures3D.size();
+        // Compute the identifier (i.e. hash the shader text in place instead of
+        // copying it).
+        CacheIDHasher hasher;
+        hasher.update(m_shaderCode);
+        hasher.update("T3D: " + std::to_string(m_textures3D.size()));
         for(auto & t : m_textures3D)
         {
-            os << t.m_id << " ";
+            hasher.update(t.m_id + " ");
         }
-        os << "T1D: " << m_textures.size();
+        hasher.update("T1D: " + std::to_string(m_textures.size()));
         for(auto & t : m_textures)
         {
-            os << t.m_id << " ";
+            hasher.update(t.m_id + " ");
         }
-        os << "U: " << m_uniforms.size();
+        hasher.update("U: " + std::to_string(m_uniforms.size()));
         for (auto & u : m_uniforms)
         {
-            os << u.m_name << " ";
+            hasher.update(u.m_name + " ");
+        }
+        if (!m_uniformBlock.empty())
+        {
+            hasher.update("UB: " + std::to_string(m_uniformBlock.size()));
+            for (auto & m : m_uniformBlock)
+            {
+                hasher.update(m.m_name + " ");
+            }
         }
 
-        const std::string id = os.str();
-        m_shaderCodeID = cacheID 
-            + CacheIDHash(id.c_str(), unsigned(id.length()));
+        m_shaderCodeID = cacheID + hasher.digest();
+    }
+
+    // Copy the shader program (i.e. code, textures & uniforms), the texture values being
+    // shared.
+    void copyProgram(const PrivateImpl & rhs)
+    {
+        m_declarations   = rhs.m_declarations;
+        m_helperMethods  = rhs.m_helperMethods;
+        m_functionHeader = rhs.m_functionHeader;
+        m_functionBody   = rhs.m_functionBody;
+        m_functionFooter = rhs.m_functionFooter;
+
+        m_shaderCode   = rhs.m_shaderCode;
+        m_shaderCodeID = rhs.m_shaderCodeID;
+
+        m_textures   = rhs.m_textures;
+        m_textures3D = rhs.m_textures3D;
+        m_uniforms   = rhs.m_uniforms;
+
+        m_uniformBlock     = rhs.m_uniformBlock;
+        m_uniformBlockSize = rhs.m_uniformBlockSize;
+
+        m_max1DLUTWidth = rhs.m_max1DLUTWidth;
+    }
+
+    // Write the shader program (refer to SerializeGpuShaderDesc()). Only the 16-bit values
+    // of the textures are written when a 16-bit texture format is used.
+    void write(std::ostream & os) const
+    {
+        WriteBinary(os, uint32_t(m_max1DLUTWidth));
+
+        WriteBinary(os, m_declarations);
+        WriteBinary(os, m_helperMethods);
+        WriteBinary(os, m_functionHeader);
+        WriteBinary(os, m_functionBody);
+        WriteBinary(os, m_functionFooter);
+        WriteBinary(os, m_shaderCode);
+        WriteBinary(os, m_shaderCodeID);
+
+        for (const Textures * textures : { &m_textures, &m_textures3D })
+        {
+            WriteBinary(os, uint32_t(textures->size()));
+            for (const auto & t : *textures)
+            {
+                WriteBinary(os, t.m_name);
+                WriteBinary(os, t.m_id);
+                WriteBinary(os, uint32_t(t.m_width));
+                WriteBinary(os, uint32_t(t.m_height));
+                WriteBinary(os, uint32_t(t.m_depth));
+                WriteBinary(os, uint32_t(t.m_type));
+                WriteBinary(os, uint32_t(t.m_interp));
+                WriteBinary(os, uint32_t(t.m_format));
+                if (t.m_values16)
+                {
+                    WriteBinary(os, *t.m_values16);
+                }
+                else
+                {
+                    WriteBinary(os, *t.m_values);
+                }
+            }
+        }
+
+        WriteBinary(os, uint32_t(m_uniforms.size()));
+        for (const auto & u : m_uniforms)
+        {
+            WriteBinary(os, u.m_name);
+            WriteDynamicProperty(os, *u.m_value);
+        }
+
+        WriteBinary(os, uint32_t(m_uniformBlockSize));
+        WriteBinary(os, uint32_t(m_uniformBlock.size()));
+        for (const auto & m : m_uniformBlock)
+        {
+            WriteBinary(os, m.m_name);
+            WriteBinary(os, uint32_t(m.m_type));
+            WriteBinary(os, uint32_t(m.m_offset));
+            WriteBinary(os, uint8_t(m.m_value ? 1 : 0));
+            if (m.m_value)
+            {
+                WriteDynamicProperty(os, *m.m_value);
+            }
+            else
+            {
+                WriteBinary(os, m.m_values);
+            }
+        }
+    }
+
+    // Read a shader program written by write() in an empty shader description.
+    void read(std::istream & is)
+    {
+        uint32_t maxWidth = 0;
+        ReadBinary(is, maxWidth);
+        m_max1DLUTWidth = maxWidth;
+
+        ReadBinary(is, m_declarations);
+        ReadBinary(is, m_helperMethods);
+        ReadBinary(is, m_functionHeader);
+        ReadBinary(is, m_functionBody);
+        ReadBinary(is, m_functionFooter);
+        ReadBinary(is, m_shaderCode);
+        ReadBinary(is, m_shaderCodeID);
+
+        for (Textures * textures : { &m_textures, &m_textures3D })
+        {
+            uint32_t numTextures = 0;
+            ReadBinary(is, numTextures);
+            for (uint32_t idx = 0; idx < numTextures; ++idx)
+            {
+                std::string name, id;
+                ReadBinary(is, name);
+                ReadBinary(is, id);
+
+                uint32_t width = 0, height = 0, depth = 0;
+                ReadBinary(is, width);
+                ReadBinary(is, height);
+                ReadBinary(is, depth);
+
+                const auto type 
+                    = ReadBinaryEnum<GpuShaderDesc::TextureType>(
+                        is, GpuShaderDesc::TEXTURE_RGB_CHANNEL);
+                const auto interp = ReadBinaryEnum<Interpolation>(is, INTERP_BEST);
+                const auto format
+                    = ReadBinaryEnum<GpuShaderDesc::TextureFormat>(
+                        is, GpuShaderDesc::TEXTURE_FORMAT_UNORM16);
+
+                std::vector<float> values;
+                if (format==GpuShaderDesc::TEXTURE_FORMAT_F32)
+                {
+                    ReadBinary(is, values);
+                }
+                else
+                {
+                    // The 16-bit values are converted back exactly by Texture::setFormat().
+                    std::vector<unsigned short> values16;
+                    ReadBinary(is, values16);
+
+                    values.resize(values16.size());
+                    for (size_t v = 0; v < values16.size(); ++v)
+                    {
+                        if (format==GpuShaderDesc::TEXTURE_FORMAT_UNORM16)
+                        {
+                            values[v] = float(values16[v]) / 65535.0f;
+                        }
+                        else
+                        {
+                            half h;
+                            h.setBits(values16[v]);
+                            values[v] = float(h);
+                        }
+                    }
+                }
+
+                const size_t numChannels = (type==GpuShaderDesc::TEXTURE_RGB_CHANNEL) ? 3 : 1;
+                if (values.size() != size_t(width) * height * depth * numChannels)
+                {
+                    ThrowCorruptedShaderDesc();
+                }
+
+                Texture t(name.c_str(), id.c_str(), width, height, depth, type, interp,
+                          values.data());
+                t.setFormat(format);
+                textures->push_back(t);
+            }
+        }
+
+        uint32_t numUniforms = 0;
+        ReadBinary(is, numUniforms);
+        for (uint32_t idx = 0; idx < numUniforms; ++idx)
+        {
+            std::string name;
+            ReadBinary(is, name);
+            m_uniforms.emplace_back(name.c_str(), ReadDynamicProperty(is));
+        }
+
+        uint32_t blockSize = 0, numMembers = 0;
+        ReadBinary(is, blockSize);
+        ReadBinary(is, numMembers);
+        m_uniformBlockSize = blockSize;
+        for (uint32_t idx = 0; idx < numMembers; ++idx)
+        {
+            UniformBlockMember m;
+            ReadBinary(is, m.m_name);
+            m.m_type = ReadBinaryEnum<GpuShaderDesc::UniformType>(is, GpuShaderDesc::UNIFORM_MAT4);
+
+            uint32_t offset = 0;
+            ReadBinary(is, offset);
+            m.m_offset = offset;
+
+            static constexpr unsigned NumFloats[] = { 1, 4, 16 };
+            if (m.m_offset + NumFloats[m.m_type] * sizeof(float) > m_uniformBlockSize)
+            {
+                ThrowCorruptedShaderDesc();
+            }
+
+            uint8_t isProperty = 0;
+            ReadBinary(is, isProperty);
+            if (isProperty)
+            {
+                m.m_value = ReadDynamicProperty(is);
+            }
+            else
+            {
+                ReadBinary(is, m.m_values);
+                if (m.m_values.size() != NumFloats[m.m_type])
+                {
+                    ThrowCorruptedShaderDesc();
+                }
+            }
+
+            m_uniformBlock.push_back(m);
+        }
+    }
+
+    bool isEmpty() const
+    {
+        return m_declarations.empty() && m_helperMethods.empty() && m_functionHeader.empty()
+            && m_functionBody.empty() && m_functionFooter.empty()
+            && m_textures.empty() && m_textures3D.empty() && m_uniforms.empty()
+            && m_uniformBlock.empty();
+    }
+
+    void getCodeState(GpuShaderCodeState & state) const
+    {
+        state.m_declarationsSize   = m_declarations.size();
+        state.m_helperMethodsSize  = m_helperMethods.size();
+        state.m_functionHeaderSize = m_functionHeader.size();
+        state.m_functionFooterSize = m_functionFooter.size();
+
+        state.m_numTextures   = (unsigned)m_textures.size();
+        state.m_num3DTextures = (unsigned)m_textures3D.size();
+        state.m_numUniforms   = (unsigned)m_uniforms.size();
+
+        state.m_numUniformBlockMembers = (unsigned)m_uniformBlock.size();
+
+        state.m_functionBody = &m_functionBody;
     }
 
     std::string m_declarations;
@@ -341,6 +964,10 @@ public:
 
     Uniforms m_uniforms;
 
+    // The members of the uniform block and its size in bytes (i.e. before rounding).
+    UniformBlockMembers m_uniformBlock;
+    unsigned m_uniformBlockSize = 0;
+
 protected:
     unsigned m_max1DLUTWidth;
 
@@ -439,6 +1066,12 @@ void LegacyGpuShaderDesc::getTextureValues(unsigned, const float *&) const
     throw Exception("1D LUTs are not supported");
 }
 
+void LegacyGpuShaderDesc::getTextureValues16(unsigned, TextureFormat &,
+                                             const unsigned short *&) const
+{
+    throw Exception("1D LUTs are not supported");
+}
+
 unsigned LegacyGpuShaderDesc::getNum3DTextures() const
 {
     return unsigned(getImpl()->m_textures3D.size());
@@ -461,7 +1094,7 @@ void LegacyGpuShaderDesc::add3DTexture(const char * name, const char * id, unsig
         throw Exception(ss.c_str());
     }
 
-    getImpl()->add3DTexture(name, id, dimension, interpolation, values);
+    getImpl()->add3DTexture(name, id, dimension, interpolation, values, getTextureFormat());
 }
 
 void LegacyGpuShaderDesc::get3DTexture(unsigned index, const char *& name, 
@@ -476,6 +1109,12 @@ void LegacyGpuShaderDesc::get3DTextureValues(unsigned index, const float *& valu
     getImpl()->get3DTextureValues(index, values);
 }
 
+void LegacyGpuShaderDesc::get3DTextureValues16(unsigned index, TextureFormat & format,
+                                               const unsigned short *& values) const
+{
+    getImpl()->get3DTextureValues16(index, format, values);
+}
+
 const char * LegacyGpuShaderDesc::getShaderText() const
 {
     return getImpl()->m_shaderCode.c_str();
@@ -544,6 +1183,15 @@ class GenericGpuShaderDesc::Impl : public PrivateImpl
 public:       
     Impl() : PrivateImpl() {}
     ~Impl() {}
+
+    // The 1D LUTs waiting to be packed in the atlas texture (i.e. rows of the texture
+    // maximum width), refer to AddToLut1DAtlas().
+    std::string m_atlasID;
+    unsigned m_atlasHeight = 0;
+    std::vector<float> m_atlasValues;
+
+    // Is the op being extracted allowed to compute in half precision?
+    bool m_halfPrecisionOp = false;
 };
 
 GpuShaderDescRcPtr GenericGpuShaderDesc::Create()
@@ -579,6 +1227,28 @@ bool GenericGpuShaderDesc::addUniform(const char * name, const DynamicPropertyRc
     return getImpl()->addUniform(name, value);
 }
 
+unsigned GenericGpuShaderDesc::getNumUniformBlockMembers() const
+{
+    return unsigned(getImpl()->m_uniformBlock.size());
+}
+
+void GenericGpuShaderDesc::getUniformBlockMember(unsigned index, const char *& name,
+                                                 UniformType & type, unsigned & offset,
+                                                 DynamicPropertyRcPtr & value) const
+{
+    getImpl()->getUniformBlockMember(index, name, type, offset, value);
+}
+
+unsigned GenericGpuShaderDesc::getUniformBlockSize() const
+{
+    return getImpl()->getUniformBlockSize();
+}
+
+void GenericGpuShaderDesc::fillUniformBlock(void * buffer) const
+{
+    getImpl()->fillUniformBlock(buffer);
+}
+
 unsigned GenericGpuShaderDesc::getTextureMaxWidth() const 
 {
     return getImpl()->get1dLutMaxWidth();
@@ -600,7 +1270,8 @@ void GenericGpuShaderDesc::addTexture(const char * name, const char * id,
                                       Interpolation interpolation,
                                       const float * values)
 {
-    getImpl()->addTexture(name, id, width, height, channel, interpolation, values);
+    getImpl()->addTexture(name, id, width, height, channel, interpolation, values,
+                          getTextureFormat());
 }
 
 void GenericGpuShaderDesc::getTexture(unsigned index, const char *& name, 
@@ -616,6 +1287,12 @@ void GenericGpuShaderDesc::getTextureValues(unsigned index, const float *& value
     getImpl()->getTextureValues(index, values);
 }
 
+void GenericGpuShaderDesc::getTextureValues16(unsigned index, TextureFormat & format,
+                                              const unsigned short *& values) const
+{
+    getImpl()->getTextureValues16(index, format, values);
+}
+
 unsigned GenericGpuShaderDesc::getNum3DTextures() const
 {
     return unsigned(getImpl()->m_textures3D.size());
@@ -625,7 +1302,7 @@ void GenericGpuShaderDesc::add3DTexture(
     const char * name, const char * id, unsigned edgelen, 
     Interpolation interpolation, const float * values)
 {
-    getImpl()->add3DTexture(name, id, edgelen, interpolation, values);
+    getImpl()->add3DTexture(name, id, edgelen, interpolation, values, getTextureFormat());
 }
 
 void GenericGpuShaderDesc::get3DTexture(unsigned index, const char *& name, 
@@ -640,6 +1317,12 @@ void GenericGpuShaderDesc::get3DTextureValues(unsigned index, const float *& val
     getImpl()->get3DTextureValues(index, values);
 }
 
+void GenericGpuShaderDesc::get3DTextureValues16(unsigned index, TextureFormat & format,
+                                                const unsigned short *& values) const
+{
+    getImpl()->get3DTextureValues16(index, format, values);
+}
+
 const char * GenericGpuShaderDesc::getShaderText() const
 {
     return getImpl()->m_shaderCode.c_str();
@@ -705,6 +1388,466 @@ void GenericGpuShaderDesc::Deleter(GenericGpuShaderDesc* c)
     delete c;
 }
 
+
+///////////////////////////////////////////////////////////////////////////
+
+bool GpuShaderCodeState::hasSameResources(const GpuShaderCodeState & rhs) const
+{
+    return m_declarationsSize   == rhs.m_declarationsSize
+        && m_helperMethodsSize  == rhs.m_helperMethodsSize
+        && m_functionHeaderSize == rhs.m_functionHeaderSize
+        && m_functionFooterSize == rhs.m_functionFooterSize
+        && m_numTextures        == rhs.m_numTextures
+        && m_num3DTextures      == rhs.m_num3DTextures
+        && m_numUniforms        == rhs.m_numUniforms
+        && m_numUniformBlockMembers == rhs.m_numUniformBlockMembers;
+}
+
+bool GetGpuShaderCodeState(const GpuShaderDesc & shaderDesc, GpuShaderCodeState & state)
+{
+    if (auto generic = dynamic_cast<const GenericGpuShaderDesc *>(&shaderDesc))
+    {
+        generic->getImpl()->getCodeState(state);
+        return true;
+    }
+    else if (auto legacy = dynamic_cast<const LegacyGpuShaderDesc *>(&shaderDesc))
+    {
+        legacy->getImpl()->getCodeState(state);
+        return true;
+    }
+
+    return false;
+}
+
+namespace
+{
+// The types of dynamic property which could be live or not in a shader program.
+constexpr DynamicPropertyType LiveDynamicPropertyTypes[] = { DYNAMIC_PROPERTY_EXPOSURE,
+                                                             DYNAMIC_PROPERTY_CONTRAST,
+                                                             DYNAMIC_PROPERTY_GAMMA,
+                                                             DYNAMIC_PROPERTY_CDL };
+}
+
+std::string GetGpuShaderSettingsID(const GpuShaderDesc & shaderDesc)
+{
+    std::ostringstream oss;
+
+    if (auto generic = dynamic_cast<const GenericGpuShaderDesc *>(&shaderDesc))
+    {
+        if (!generic->getImpl()->isEmpty())
+        {
+            return "";
+        }
+        oss << "generic " << generic->getTextureMaxWidth();
+    }
+    else if (auto legacy = dynamic_cast<const LegacyGpuShaderDesc *>(&shaderDesc))
+    {
+        if (!legacy->getImpl()->isEmpty())
+        {
+            return "";
+        }
+        oss << "legacy " << legacy->getEdgelen();
+    }
+    else
+    {
+        return "";
+    }
+
+    oss << " " << GpuLanguageToString(shaderDesc.getLanguage())
+        << " " << shaderDesc.getFunctionName()
+        << " " << shaderDesc.getPixelName()
+        << " " << shaderDesc.getResourcePrefix()
+        << " " << shaderDesc.getTextureFormat()
+        << " " << shaderDesc.isLut1DAtlasEnabled()
+        << " " << shaderDesc.isLut1DNativeTexturesEnabled()
+        << " " << shaderDesc.isLut3DHardwareTrilinearEnabled()
+        << " " << shaderDesc.isUniformBlockEnabled()
+        << " " << shaderDesc.isComputeKernelEnabled()
+        << " " << shaderDesc.getMaxAluCost()
+        << " " << shaderDesc.getMaxNumTextures()
+        << " " << shaderDesc.getMaxTextureMemory()
+        << " " << shaderDesc.getBudgetLut3DEdgelen()
+        << " " << shaderDesc.isHalfPrecisionEnabled()
+        << " " << shaderDesc.isLut1DInverseSearchEnabled();
+
+    for (const auto type : LiveDynamicPropertyTypes)
+    {
+        oss << " " << shaderDesc.isDynamicPropertyLive(type);
+    }
+
+    return oss.str();
+}
+
+GpuShaderDescRcPtr CloneGpuShaderDesc(const GpuShaderDesc & shaderDesc)
+{
+    GpuShaderDescRcPtr clone;
+
+    if (auto generic = dynamic_cast<const GenericGpuShaderDesc *>(&shaderDesc))
+    {
+        clone = GenericGpuShaderDesc::Create();
+        clone->setTextureMaxWidth(generic->getTextureMaxWidth());
+    }
+    else if (auto legacy = dynamic_cast<const LegacyGpuShaderDesc *>(&shaderDesc))
+    {
+        clone = LegacyGpuShaderDesc::Create(legacy->getEdgelen());
+    }
+    else
+    {
+        throw Exception("Only the library shader descriptions can be cloned.");
+    }
+
+    clone->setLanguage(shaderDesc.getLanguage());
+    clone->setFunctionName(shaderDesc.getFunctionName());
+    clone->setPixelName(shaderDesc.getPixelName());
+    clone->setResourcePrefix(shaderDesc.getResourcePrefix());
+    clone->setTextureFormat(shaderDesc.getTextureFormat());
+    clone->setLut1DAtlasEnabled(shaderDesc.isLut1DAtlasEnabled());
+    clone->setLut1DNativeTexturesEnabled(shaderDesc.isLut1DNativeTexturesEnabled());
+    clone->setLut3DHardwareTrilinearEnabled(shaderDesc.isLut3DHardwareTrilinearEnabled());
+    clone->setUniformBlockEnabled(shaderDesc.isUniformBlockEnabled());
+    clone->setComputeKernelEnabled(shaderDesc.isComputeKernelEnabled());
+    clone->setGpuBudget(shaderDesc.getMaxAluCost(),
+                        shaderDesc.getMaxNumTextures(),
+                        shaderDesc.getMaxTextureMemory());
+    clone->setBudgetLut3DEdgelen(shaderDesc.getBudgetLut3DEdgelen());
+    clone->setHalfPrecisionEnabled(shaderDesc.isHalfPrecisionEnabled());
+    clone->setLut1DInverseSearchEnabled(shaderDesc.isLut1DInverseSearchEnabled());
+    for (const auto type : LiveDynamicPropertyTypes)
+    {
+        clone->setDynamicPropertyLive(type, shaderDesc.isDynamicPropertyLive(type));
+    }
+
+    CopyGpuShaderProgram(shaderDesc, *clone);
+
+    return clone;
+}
+
+void CopyGpuShaderProgram(const GpuShaderDesc & src, GpuShaderDesc & dst)
+{
+    auto genericSrc = dynamic_cast<const GenericGpuShaderDesc *>(&src);
+    auto genericDst = dynamic_cast<GenericGpuShaderDesc *>(&dst);
+    if (genericSrc && genericDst)
+    {
+        genericDst->getImpl()->copyProgram(*genericSrc->getImpl());
+        return;
+    }
+
+    auto legacySrc = dynamic_cast<const LegacyGpuShaderDesc *>(&src);
+    auto legacyDst = dynamic_cast<LegacyGpuShaderDesc *>(&dst);
+    if (legacySrc && legacyDst && legacySrc->getEdgelen()==legacyDst->getEdgelen())
+    {
+        legacyDst->getImpl()->copyProgram(*legacySrc->getImpl());
+        return;
+    }
+
+    throw Exception("The shader descriptions are not of the same type.");
+}
+
+namespace
+{
+
+// The header of the serialized shader descriptions.
+constexpr char SerializedShaderMagic[8] = { 'O', 'C', 'I', 'O', 'G', 'P', 'U', 0 };
+constexpr uint32_t SerializedShaderVersion = 4;
+constexpr uint32_t SerializedShaderByteOrder = 0x01020304;
+
+}
+
+void SerializeGpuShaderDesc(const GpuShaderDesc & shaderDesc, const char * key,
+                            std::ostream & os)
+{
+    const PrivateImpl * impl = nullptr;
+    uint32_t edgelen = 0;
+
+    if (auto generic = dynamic_cast<const GenericGpuShaderDesc *>(&shaderDesc))
+    {
+        impl = generic->getImpl();
+    }
+    else if (auto legacy = dynamic_cast<const LegacyGpuShaderDesc *>(&shaderDesc))
+    {
+        impl = legacy->getImpl();
+        edgelen = legacy->getEdgelen();
+    }
+    else
+    {
+        throw Exception("Only the library shader descriptions can be serialized.");
+    }
+
+    if (impl->m_shaderCode.empty())
+    {
+        throw Exception("Only a finalized shader description can be serialized.");
+    }
+
+    os.write(SerializedShaderMagic, sizeof(SerializedShaderMagic));
+    WriteBinary(os, SerializedShaderVersion);
+    WriteBinary(os, SerializedShaderByteOrder);
+    WriteBinary(os, std::string(key ? key : ""));
+
+    // The settings (i.e. a legacy shader description has a non-zero edge length).
+    WriteBinary(os, edgelen);
+    WriteBinary(os, uint32_t(shaderDesc.getLanguage()));
+    WriteBinary(os, std::string(shaderDesc.getFunctionName()));
+    WriteBinary(os, std::string(shaderDesc.getPixelName()));
+    WriteBinary(os, std::string(shaderDesc.getResourcePrefix()));
+    WriteBinary(os, uint32_t(shaderDesc.getTextureFormat()));
+    WriteBinary(os, uint8_t(shaderDesc.isLut1DAtlasEnabled()));
+    WriteBinary(os, uint8_t(shaderDesc.isLut1DNativeTexturesEnabled()));
+    WriteBinary(os, uint8_t(shaderDesc.isLut3DHardwareTrilinearEnabled()));
+    WriteBinary(os, uint8_t(shaderDesc.isUniformBlockEnabled()));
+    WriteBinary(os, uint8_t(shaderDesc.isComputeKernelEnabled()));
+    WriteBinary(os, uint32_t(shaderDesc.getMaxAluCost()));
+    WriteBinary(os, uint32_t(shaderDesc.getMaxNumTextures()));
+    WriteBinary(os, uint32_t(shaderDesc.getMaxTextureMemory()));
+    WriteBinary(os, uint32_t(shaderDesc.getBudgetLut3DEdgelen()));
+    WriteBinary(os, uint8_t(shaderDesc.isHalfPrecisionEnabled()));
+    WriteBinary(os, uint8_t(shaderDesc.isLut1DInverseSearchEnabled()));
+    for (const auto type : LiveDynamicPropertyTypes)
+    {
+        WriteBinary(os, uint8_t(shaderDesc.isDynamicPropertyLive(type)));
+    }
+
+    impl->write(os);
+
+    if (!os)
+    {
+        throw Exception("Failed to write the serialized shader description.");
+    }
+}
+
+GpuShaderDescRcPtr DeserializeGpuShaderDesc(std::istream & is, const char * key)
+{
+    char magic[sizeof(SerializedShaderMagic)];
+    if (!is.read(magic, sizeof(magic))
+        || memcmp(magic, SerializedShaderMagic, sizeof(magic))!=0)
+    {
+        throw Exception("The stream does not contain a serialized shader description.");
+    }
+
+    uint32_t version = 0, byteOrder = 0;
+    ReadBinary(is, version);
+    ReadBinary(is, byteOrder);
+
+    if (version!=SerializedShaderVersion || byteOrder!=SerializedShaderByteOrder)
+    {
+        // Written by another version of the library, or on another architecture.
+        return GpuShaderDescRcPtr();
+    }
+
+    std::string storedKey;
+    ReadBinary(is, storedKey);
+    if (storedKey!=std::string(key ? key : ""))
+    {
+        return GpuShaderDescRcPtr();
+    }
+
+    uint32_t edgelen = 0;
+    ReadBinary(is, edgelen);
+
+    GpuShaderDescRcPtr shaderDesc;
+    PrivateImpl * impl = nullptr;
+    if (edgelen==0)
+    {
+        shaderDesc = GenericGpuShaderDesc::Create();
+        impl = dynamic_cast<GenericGpuShaderDesc *>(shaderDesc.get())->getImpl();
+    }
+    else
+    {
+        shaderDesc = LegacyGpuShaderDesc::Create(edgelen);
+        impl = dynamic_cast<LegacyGpuShaderDesc *>(shaderDesc.get())->getImpl();
+    }
+
+    const auto readFlag = [&is]() -> bool
+    {
+        uint8_t flag = 0;
+        ReadBinary(is, flag);
+        return flag!=0;
+    };
+
+    shaderDesc->setLanguage(ReadBinaryEnum<GpuLanguage>(is, GPU_LANGUAGE_MSL_2_0));
+
+    std::string str;
+    ReadBinary(is, str);
+    shaderDesc->setFunctionName(str.c_str());
+    ReadBinary(is, str);
+    shaderDesc->setPixelName(str.c_str());
+    ReadBinary(is, str);
+    shaderDesc->setResourcePrefix(str.c_str());
+
+    shaderDesc->setTextureFormat(
+        ReadBinaryEnum<GpuShaderDesc::TextureFormat>(is, GpuShaderDesc::TEXTURE_FORMAT_UNORM16));
+    shaderDesc->setLut1DAtlasEnabled(readFlag());
+    shaderDesc->setLut1DNativeTexturesEnabled(readFlag());
+    shaderDesc->setLut3DHardwareTrilinearEnabled(readFlag());
+    shaderDesc->setUniformBlockEnabled(readFlag());
+    shaderDesc->setComputeKernelEnabled(readFlag());
+
+    uint32_t maxAluCost = 0, maxNumTextures = 0, maxTextureMemory = 0, budgetEdgelen = 0;
+    ReadBinary(is, maxAluCost);
+    ReadBinary(is, maxNumTextures);
+    ReadBinary(is, maxTextureMemory);
+    ReadBinary(is, budgetEdgelen);
+    shaderDesc->setGpuBudget(maxAluCost, maxNumTextures, maxTextureMemory);
+    try
+    {
+        shaderDesc->setBudgetLut3DEdgelen(budgetEdgelen);
+    }
+    catch (const Exception &)
+    {
+        ThrowCorruptedShaderDesc();
+    }
+
+    shaderDesc->setHalfPrecisionEnabled(readFlag());
+    shaderDesc->setLut1DInverseSearchEnabled(readFlag());
+    for (const auto type : LiveDynamicPropertyTypes)
+    {
+        shaderDesc->setDynamicPropertyLive(type, readFlag());
+    }
+
+    impl->read(is);
+
+    return shaderDesc;
+}
+
+namespace
+{
+// Get the shader description when its uniform block is enabled.
+GenericGpuShaderDesc * GetUniformBlockShaderDesc(GpuShaderDesc & shaderDesc)
+{
+    auto generic = dynamic_cast<GenericGpuShaderDesc *>(&shaderDesc);
+    if (!generic || !shaderDesc.isUniformBlockEnabled())
+    {
+        return nullptr;
+    }
+
+    switch (shaderDesc.getLanguage())
+    {
+        case GPU_LANGUAGE_GLSL_4_0:
+        case GPU_LANGUAGE_GLSL_ES_3_0:
+        case GPU_LANGUAGE_GLSL_VK_4_6:
+        case GPU_LANGUAGE_HLSL_DX11:
+        case GPU_LANGUAGE_MSL_2_0:
+            break;
+
+        default:
+        {
+            std::string err("The uniform block is not supported by the GPU language: ");
+            err += GpuLanguageToString(shaderDesc.getLanguage());
+            throw Exception(err.c_str());
+        }
+    }
+
+    return generic;
+}
+}
+
+std::string AddUniformBlockMember(GpuShaderDesc & shaderDesc, const std::string & name,
+                                  GpuShaderDesc::UniformType type, const float * values)
+{
+    GenericGpuShaderDesc * generic = GetUniformBlockShaderDesc(shaderDesc);
+    if (!generic)
+    {
+        return "";
+    }
+
+    if (values==nullptr)
+    {
+        throw Exception("The buffer is invalid");
+    }
+
+    GenericGpuShaderDesc::Impl * impl = generic->getImpl();
+
+    const std::string memberName = name + "_" + std::to_string(impl->m_uniformBlock.size());
+    impl->addUniformBlockMember(memberName, type, values, DynamicPropertyRcPtr());
+
+    return memberName;
+}
+
+bool AddUniformBlockMember(GpuShaderDesc & shaderDesc, const std::string & name,
+                           const DynamicPropertyRcPtr & value)
+{
+    GenericGpuShaderDesc * generic = GetUniformBlockShaderDesc(shaderDesc);
+    if (!generic)
+    {
+        return false;
+    }
+
+    if (!value || !value->isDynamic())
+    {
+        throw Exception("The dynamic property is not dynamic.");
+    }
+
+    generic->getImpl()->addUniformBlockMember(name, value);
+
+    return true;
+}
+
+bool AddToLut1DAtlas(GpuShaderDesc & shaderDesc, const char * id, unsigned height,
+                     const float * values, unsigned & firstRow)
+{
+    auto generic = dynamic_cast<GenericGpuShaderDesc *>(&shaderDesc);
+    if (!generic || !shaderDesc.isLut1DAtlasEnabled() || height==0)
+    {
+        return false;
+    }
+
+    GenericGpuShaderDesc::Impl * impl = generic->getImpl();
+
+    const unsigned width = impl->get1dLutMaxWidth();
+    if (impl->m_atlasHeight + height > width)
+    {
+        return false;
+    }
+
+    if (values==nullptr)
+    {
+        throw Exception("The buffer is invalid");
+    }
+
+    firstRow = impl->m_atlasHeight;
+
+    impl->m_atlasValues.insert(impl->m_atlasValues.end(), values, values + width * height * 3);
+    impl->m_atlasID += (impl->m_atlasID.empty() ? "" : " ") + std::string(id ? id : "");
+    impl->m_atlasHeight += height;
+
+    return true;
+}
+
+unsigned AddLut1DAtlasTexture(GpuShaderDesc & shaderDesc, const char * name)
+{
+    auto generic = dynamic_cast<GenericGpuShaderDesc *>(&shaderDesc);
+    if (!generic || generic->getImpl()->m_atlasHeight==0)
+    {
+        return 0;
+    }
+
+    GenericGpuShaderDesc::Impl * impl = generic->getImpl();
+
+    const unsigned height = impl->m_atlasHeight;
+    shaderDesc.addTexture(name, impl->m_atlasID.c_str(), impl->get1dLutMaxWidth(), height,
+                          GpuShaderDesc::TEXTURE_RGB_CHANNEL, INTERP_LINEAR,
+                          impl->m_atlasValues.data());
+
+    impl->m_atlasID.clear();
+    impl->m_atlasHeight = 0;
+    std::vector<float>().swap(impl->m_atlasValues);
+
+    return height;
+}
+
+void SetHalfPrecisionOp(GpuShaderDesc & shaderDesc, bool halfPrecision)
+{
+    if (auto generic = dynamic_cast<GenericGpuShaderDesc *>(&shaderDesc))
+    {
+        generic->getImpl()->m_halfPrecisionOp = halfPrecision;
+    }
+}
+
+bool IsHalfPrecisionOp(const GpuShaderDesc & shaderDesc)
+{
+    auto generic = dynamic_cast<const GenericGpuShaderDesc *>(&shaderDesc);
+    return generic && generic->getImpl()->m_halfPrecisionOp;
+}
+
 }
 OCIO_NAMESPACE_EXIT
 
@@ -739,7 +1882,7 @@ OCIO_ADD_TEST(GpuShader, generic_shader)
         OCIO_CHECK_NO_THROW(shaderDesc->finalize());
         const std::string id(shaderDesc->getCacheID());
         OCIO_CHECK_EQUAL(id, std::string("glsl_1.3 1sd234_ res_1sd234_ pxl_1sd234_ "
-                                         "$159b6ac2bdbbe3b57824faea46bd829b"));
+                                         "$c81cdb2bf12e1f33bf489e799e8e181a"));
         OCIO_CHECK_NO_THROW(shaderDesc->setResourcePrefix("res_1"));
         OCIO_CHECK_NO_THROW(shaderDesc->finalize());
         OCIO_CHECK_NE(std::string(shaderDesc->getCacheID()), id);
@@ -978,5 +2121,206 @@ OCIO_ADD_TEST(GpuShader, legacy_shader)
     }
 }
 
+OCIO_ADD_TEST(GpuShader, texture_format)
+{
+    OCIO_CHECK_EQUAL(OCIO::GpuShaderDesc::GetTextureFormatMaxError(
+                         OCIO::GpuShaderDesc::TEXTURE_FORMAT_F32), 0.0);
+    OCIO_CHECK_EQUAL(OCIO::GpuShaderDesc::GetTextureFormatMaxError(
+                         OCIO::GpuShaderDesc::TEXTURE_FORMAT_F16), 1.0 / 2048.0);
+    OCIO_CHECK_EQUAL(OCIO::GpuShaderDesc::GetTextureFormatMaxError(
+                         OCIO::GpuShaderDesc::TEXTURE_FORMAT_UNORM16), 0.5 / 65535.0);
+
+    const unsigned width = 2;
+    const float inRange[width * 3]  = { 0.0f, 0.25f, 0.5f,  0.75f, 1.0f, 0.1f };
+    const float outRange[width * 3] = { -0.5f, 0.25f, 0.5f,  1e6f, 1.0f, 0.1f };
+
+    OCIO::GpuShaderDesc::TextureFormat format = OCIO::GpuShaderDesc::TEXTURE_FORMAT_F32;
+    const unsigned short * values16 = nullptr;
+
+    // The default format only provides the 32-bit values.
+
+    OCIO::GpuShaderDescRcPtr shaderDesc = OCIO::GenericGpuShaderDesc::Create();
+    OCIO_CHECK_EQUAL(shaderDesc->getTextureFormat(), OCIO::GpuShaderDesc::TEXTURE_FORMAT_F32);
+
+    OCIO_CHECK_NO_THROW(shaderDesc->addTexture("lut1", "tf1", width, 1,
+                                               OCIO::GpuShaderDesc::TEXTURE_RGB_CHANNEL,
+                                               OCIO::INTERP_LINEAR, &inRange[0]));
+    OCIO_CHECK_THROW_WHAT(shaderDesc->getTextureValues16(0, format, values16),
+                          OCIO::Exception,
+                          "not stored in a 16-bit format");
+
+    // Half float values.
+
+    shaderDesc = OCIO::GenericGpuShaderDesc::Create();
+    shaderDesc->setTextureFormat(OCIO::GpuShaderDesc::TEXTURE_FORMAT_F16);
+
+    OCIO_CHECK_NO_THROW(shaderDesc->addTexture("lut1", "tf2", width, 1,
+                                               OCIO::GpuShaderDesc::TEXTURE_RGB_CHANNEL,
+                                               OCIO::INTERP_LINEAR, &outRange[0]));
+    OCIO_CHECK_NO_THROW(shaderDesc->getTextureValues16(0, format, values16));
+    OCIO_CHECK_EQUAL(format, OCIO::GpuShaderDesc::TEXTURE_FORMAT_F16);
+    OCIO_CHECK_EQUAL(values16[0], half(-0.5f).bits());
+    OCIO_CHECK_EQUAL(values16[1], half(0.25f).bits());
+    OCIO_CHECK_EQUAL(values16[3], half(HALF_MAX).bits());
+
+    // The 32-bit values are still available.
+    const float * values = nullptr;
+    OCIO_CHECK_NO_THROW(shaderDesc->getTextureValues(0, values));
+    OCIO_CHECK_EQUAL(values[3], 1e6f);
+
+    // Normalized integer values.
+
+    shaderDesc = OCIO::GenericGpuShaderDesc::Create();
+    shaderDesc->setTextureFormat(OCIO::GpuShaderDesc::TEXTURE_FORMAT_UNORM16);
+
+    OCIO_CHECK_NO_THROW(shaderDesc->addTexture("lut1", "tf1", width, 1,
+                                               OCIO::GpuShaderDesc::TEXTURE_RGB_CHANNEL,
+                                               OCIO::INTERP_LINEAR, &inRange[0]));
+    OCIO_CHECK_NO_THROW(shaderDesc->getTextureValues16(0, format, values16));
+    OCIO_CHECK_EQUAL(format, OCIO::GpuShaderDesc::TEXTURE_FORMAT_UNORM16);
+    OCIO_CHECK_EQUAL(values16[0], 0);
+    OCIO_CHECK_EQUAL(values16[1], 16384);
+    OCIO_CHECK_EQUAL(values16[4], 65535);
+
+    // The values outside of [0, 1] fall back to half floats.
+    OCIO_CHECK_NO_THROW(shaderDesc->addTexture("lut2", "tf2", width, 1,
+                                               OCIO::GpuShaderDesc::TEXTURE_RGB_CHANNEL,
+                                               OCIO::INTERP_LINEAR, &outRange[0]));
+    OCIO_CHECK_NO_THROW(shaderDesc->getTextureValues16(1, format, values16));
+    OCIO_CHECK_EQUAL(format, OCIO::GpuShaderDesc::TEXTURE_FORMAT_F16);
+    OCIO_CHECK_EQUAL(values16[0], half(-0.5f).bits());
+
+    // The texture format is part of the shader program identifier.
+
+    std::string ids[3];
+    const OCIO::GpuShaderDesc::TextureFormat formats[3]
+        = { OCIO::GpuShaderDesc::TEXTURE_FORMAT_F32,
+            OCIO::GpuShaderDesc::TEXTURE_FORMAT_F16,
+            OCIO::GpuShaderDesc::TEXTURE_FORMAT_UNORM16 };
+    for(unsigned idx = 0; idx < 3; ++idx)
+    {
+        shaderDesc = OCIO::GenericGpuShaderDesc::Create();
+        shaderDesc->setTextureFormat(formats[idx]);
+        OCIO_CHECK_NO_THROW(shaderDesc->addTexture("lut1", "tf1", width, 1,
+                                                   OCIO::GpuShaderDesc::TEXTURE_RGB_CHANNEL,
+                                                   OCIO::INTERP_LINEAR, &inRange[0]));
+        OCIO_CHECK_NO_THROW(shaderDesc->finalize());
+        ids[idx] = shaderDesc->getCacheID();
+    }
+    OCIO_CHECK_NE(ids[0], ids[1]);
+    OCIO_CHECK_NE(ids[0], ids[2]);
+    OCIO_CHECK_NE(ids[1], ids[2]);
+
+    // The 3D textures of the legacy shader description.
+
+    const unsigned edgelen = 2;
+    float values3D[edgelen * edgelen * edgelen * 3];
+    for(unsigned idx = 0; idx < edgelen * edgelen * edgelen * 3; ++idx)
+    {
+        values3D[idx] = float(idx) / 24.0f;
+    }
+
+    shaderDesc = OCIO::LegacyGpuShaderDesc::Create(edgelen);
+    shaderDesc->setTextureFormat(OCIO::GpuShaderDesc::TEXTURE_FORMAT_UNORM16);
+    OCIO_CHECK_NO_THROW(shaderDesc->add3DTexture("lut3", "tf3", edgelen,
+                                                 OCIO::INTERP_TETRAHEDRAL, &values3D[0]));
+    OCIO_CHECK_NO_THROW(shaderDesc->get3DTextureValues16(0, format, values16));
+    OCIO_CHECK_EQUAL(format, OCIO::GpuShaderDesc::TEXTURE_FORMAT_UNORM16);
+    OCIO_CHECK_EQUAL(values16[12], 32768);
+}
+
+OCIO_ADD_TEST(GpuShader, serialization)
+{
+    OCIO::GpuShaderDescRcPtr shaderDesc = OCIO::GenericGpuShaderDesc::Create();
+    shaderDesc->setLanguage(OCIO::GPU_LANGUAGE_GLSL_4_0);
+    shaderDesc->setTextureFormat(OCIO::GpuShaderDesc::TEXTURE_FORMAT_F16);
+    shaderDesc->setUniformBlockEnabled(true);
+    shaderDesc->setTextureMaxWidth(16);
+
+    const float values[6] = { -0.5f, 0.25f, 0.5f,  0.75f, 1.0f, 0.1f };
+    OCIO_CHECK_NO_THROW(shaderDesc->addTexture("lut1", "ts1", 2, 1,
+                                               OCIO::GpuShaderDesc::TEXTURE_RGB_CHANNEL,
+                                               OCIO::INTERP_LINEAR, &values[0]));
+
+    OCIO::DynamicPropertyRcPtr exposure
+        = std::make_shared<OCIO::DynamicPropertyImpl>(OCIO::DYNAMIC_PROPERTY_EXPOSURE,
+                                                      1.5, true);
+    OCIO_CHECK_NO_THROW(shaderDesc->addUniform("exposure", exposure));
+
+    const float offset[4] = { 0.1f, 0.2f, 0.3f, 0.4f };
+    std::string member;
+    OCIO_CHECK_NO_THROW(member = OCIO::AddUniformBlockMember(*shaderDesc, "offset",
+                                                             OCIO::GpuShaderDesc::UNIFORM_VEC4,
+                                                             offset));
+    OCIO_CHECK_ASSERT(!member.empty());
+
+    // Only a finalized shader description can be serialized.
+    std::ostringstream os;
+    OCIO_CHECK_THROW_WHAT(shaderDesc->serialize(os, "key"), OCIO::Exception, "finalized");
+
+    shaderDesc->addToFunctionShaderCode("outColor = outColor + offset;");
+    OCIO_CHECK_NO_THROW(shaderDesc->finalize());
+    OCIO_CHECK_NO_THROW(shaderDesc->serialize(os, "key"));
+
+    const std::string buffer(os.str());
+
+    // A different key (i.e. a stale cache) is not an error.
+    {
+        std::istringstream is(buffer);
+        OCIO::GpuShaderDescRcPtr desc;
+        OCIO_CHECK_NO_THROW(desc = OCIO::GpuShaderDesc::Deserialize(is, "other key"));
+        OCIO_CHECK_ASSERT(!desc);
+    }
+
+    std::istringstream is(buffer);
+    OCIO::GpuShaderDescRcPtr desc;
+    OCIO_CHECK_NO_THROW(desc = OCIO::GpuShaderDesc::Deserialize(is, "key"));
+    OCIO_REQUIRE_ASSERT(desc);
+
+    OCIO_CHECK_EQUAL(desc->getLanguage(), OCIO::GPU_LANGUAGE_GLSL_4_0);
+    OCIO_CHECK_EQUAL(desc->getTextureMaxWidth(), 16U);
+    OCIO_CHECK_ASSERT(desc->isUniformBlockEnabled());
+    OCIO_CHECK_EQUAL(std::string(desc->getShaderText()), std::string(shaderDesc->getShaderText()));
+    OCIO_CHECK_EQUAL(std::string(desc->getCacheID()), std::string(shaderDesc->getCacheID()));
+
+    // The 16-bit texture values are preserved.
+    OCIO_REQUIRE_EQUAL(desc->getNumTextures(), 1U);
+    OCIO::GpuShaderDesc::TextureFormat format = OCIO::GpuShaderDesc::TEXTURE_FORMAT_F32;
+    const unsigned short * values16 = nullptr;
+    const unsigned short * srcValues16 = nullptr;
+    OCIO_CHECK_NO_THROW(desc->getTextureValues16(0, format, values16));
+    OCIO_CHECK_NO_THROW(shaderDesc->getTextureValues16(0, format, srcValues16));
+    OCIO_CHECK_EQUAL(format, OCIO::GpuShaderDesc::TEXTURE_FORMAT_F16);
+    for (unsigned idx = 0; idx < 6; ++idx)
+    {
+        OCIO_CHECK_EQUAL(values16[idx], srcValues16[idx]);
+    }
+
+    // The uniforms hold the values at serialization time.
+    OCIO_REQUIRE_EQUAL(desc->getNumUniforms(), 1U);
+    const char * name = nullptr;
+    OCIO::DynamicPropertyRcPtr value;
+    OCIO_CHECK_NO_THROW(desc->getUniform(0, name, value));
+    OCIO_CHECK_EQUAL(std::string(name), "exposure");
+    OCIO_CHECK_EQUAL(value->getType(), OCIO::DYNAMIC_PROPERTY_EXPOSURE);
+    OCIO_CHECK_EQUAL(value->getDoubleValue(), 1.5);
+
+    OCIO_REQUIRE_EQUAL(desc->getUniformBlockSize(), shaderDesc->getUniformBlockSize());
+    std::vector<char> block(desc->getUniformBlockSize());
+    std::vector<char> srcBlock(desc->getUniformBlockSize());
+    OCIO_CHECK_NO_THROW(desc->fillUniformBlock(block.data()));
+    OCIO_CHECK_NO_THROW(shaderDesc->fillUniformBlock(srcBlock.data()));
+    OCIO_CHECK_ASSERT(block==srcBlock);
+
+    // A truncated stream is an error.
+    std::istringstream truncated(buffer.substr(0, buffer.size() - 4));
+    OCIO_CHECK_THROW_WHAT(OCIO::GpuShaderDesc::Deserialize(truncated, "key"),
+                          OCIO::Exception, "corrupted");
+
+    std::istringstream garbage("not a shader");
+    OCIO_CHECK_THROW_WHAT(OCIO::GpuShaderDesc::Deserialize(garbage, "key"),
+                          OCIO::Exception, "does not contain a serialized shader");
+}
+
 
 #endif
\ No newline at end of file
@@ -5,12 +5,103 @@
 #define INCLUDED_OCIO_GPU_SHADER_H
 
 
+#include <iosfwd>
+#include <string>
+
 #include <OpenColorIO/OpenColorIO.h>
 
 
 OCIO_NAMESPACE_ENTER
 {
 
+// Sizes of the shader code sections and numbers of resources of a shader description
+// (i.e. before its finalization). Comparing two states allows to find the shader code
+// added by an op (refer to the GPU processor shader fragment cache).
+struct GpuShaderCodeState
+{
+    size_t m_declarationsSize   = 0;
+    size_t m_helperMethodsSize  = 0;
+    size_t m_functionHeaderSize = 0;
+    size_t m_functionFooterSize = 0;
+
+    unsigned m_numTextures   = 0;
+    unsigned m_num3DTextures = 0;
+    unsigned m_numUniforms   = 0;
+
+    unsigned m_numUniformBlockMembers = 0;
+
+    // The shader function body built so far.
+    const std::string * m_functionBody = nullptr;
+
+    // Only the function body is allowed to differ.
+    bool hasSameResources(const GpuShaderCodeState & rhs) const;
+};
+
+// Get the current state of a shader description built by the library. It returns false
+// for other implementations of GpuShaderDesc.
+bool GetGpuShaderCodeState(const GpuShaderDesc & shaderDesc, GpuShaderCodeState & state);
+
+// Get the identifier of the settings of an empty shader description built by the library
+// (i.e. its type, language, names & texture limits) which, combined with a processor
+// cache identifier, identifies a complete shader program. It returns an empty string
+// for other implementations or when the shader description already contains code.
+std::string GetGpuShaderSettingsID(const GpuShaderDesc & shaderDesc);
+
+// Create a copy (i.e. with the same settings & shader program) of a shader description
+// built by the library. The texture values are shared.
+GpuShaderDescRcPtr CloneGpuShaderDesc(const GpuShaderDesc & shaderDesc);
+
+// Copy the shader program (i.e. code, textures & uniforms) between two shader descriptions
+// of the same type. The texture values are shared.
+void CopyGpuShaderProgram(const GpuShaderDesc & src, GpuShaderDesc & dst);
+
+// Write a finalized shader description built by the library (i.e. its settings & shader
+// program) in a binary stream, with a key identifying the program (refer to
+// GpuShaderDesc::serialize()).
+void SerializeGpuShaderDesc(const GpuShaderDesc & shaderDesc, const char * key,
+                            std::ostream & os);
+
+// Read a shader description written by SerializeGpuShaderDesc(). It returns null when the
+// key differs or when the stream was written by another version of the format, and throws
+// when the stream is corrupted.
+GpuShaderDescRcPtr DeserializeGpuShaderDesc(std::istream & is, const char * key);
+
+// Add the RGB values of a 1D LUT (i.e. 'height' rows of the texture maximum width) to the
+// 1D LUT atlas of a generic shader description (refer to 
+// GpuShaderDesc::setLut1DAtlasEnabled()) and get the index of its first row. It returns
+// false when the atlas would be higher than the texture maximum width, or for other
+// shader descriptions.
+bool AddToLut1DAtlas(GpuShaderDesc & shaderDesc, const char * id, unsigned height,
+                     const float * values, unsigned & firstRow);
+
+// Add an op parameter to the uniform block of a generic shader description (refer to
+// GpuShaderDesc::setUniformBlockEnabled()) and get the name of the member (i.e. the name
+// with a unique suffix). The values of a UNIFORM_MAT4 are column-major. It returns an
+// empty string when the uniform block is disabled, or for other shader descriptions, the
+// value being then expected in the shader code. It throws when the shader language does
+// not support uniform blocks.
+std::string AddUniformBlockMember(GpuShaderDesc & shaderDesc, const std::string & name,
+                                  GpuShaderDesc::UniformType type, const float * values);
+
+// Add a dynamic property (i.e. a float member named 'name') to the uniform block, a
+// property being only added once. It returns false when the uniform block is disabled,
+// or for other shader descriptions.
+bool AddUniformBlockMember(GpuShaderDesc & shaderDesc, const std::string & name,
+                           const DynamicPropertyRcPtr & value);
+
+// Add the 1D LUT atlas built so far as a 2D texture of the shader description, and return
+// its height (i.e. zero when the atlas is empty, no texture being then added).
+unsigned AddLut1DAtlasTexture(GpuShaderDesc & shaderDesc, const char * name);
+
+// Allow the op being extracted in a generic shader description to compute in half precision
+// (refer to GpuShaderDesc::setHalfPrecisionEnabled()), the GPU processor deciding which ops
+// tolerate it. It has no effect on other shader descriptions.
+void SetHalfPrecisionOp(GpuShaderDesc & shaderDesc, bool halfPrecision);
+
+// Is the op being extracted allowed to compute in half precision?
+bool IsHalfPrecisionOp(const GpuShaderDesc & shaderDesc);
+
+
 ///////////////////////////////////////////////////////////////////////////
 
 // LegacyGpuShaderDesc
@@ -36,6 +127,8 @@ public:
                       const char *& id, unsigned & edgelen, 
                       Interpolation & interpolation) const override;
     void get3DTextureValues(unsigned index, const float *& value) const override;
+    void get3DTextureValues16(unsigned index, TextureFormat & format,
+                              const unsigned short *& values) const override;
 
     // Get the complete shader text
     const char * getShaderText() const override;
@@ -87,6 +180,8 @@ protected:
                     Interpolation & interpolation) const override;
     // Get the texture 1D or 2D values only
     void getTextureValues(unsigned index, const float *& values) const override;
+    void getTextureValues16(unsigned index, TextureFormat & format,
+                            const unsigned short *& values) const override;
 
 private:
     LegacyGpuShaderDesc();
@@ -97,6 +192,12 @@ private:
     LegacyGpuShaderDesc& operator= (const LegacyGpuShaderDesc &) = delete;
     
     static void Deleter(LegacyGpuShaderDesc* c);
+
+    friend bool GetGpuShaderCodeState(const GpuShaderDesc &, GpuShaderCodeState &);
+    friend std::string GetGpuShaderSettingsID(const GpuShaderDesc &);
+    friend void CopyGpuShaderProgram(const GpuShaderDesc &, GpuShaderDesc &);
+    friend void SerializeGpuShaderDesc(const GpuShaderDesc &, const char *, std::ostream &);
+    friend GpuShaderDescRcPtr DeserializeGpuShaderDesc(std::istream &, const char *);
     
     class Impl;
     friend class Impl;
@@ -132,6 +233,15 @@ public:
     bool addUniform(const char * name,
                     const DynamicPropertyRcPtr & value) override;
 
+    // Accessors to the uniform block
+    //
+    unsigned getNumUniformBlockMembers() const override;
+    void getUniformBlockMember(unsigned index, const char *& name,
+                               UniformType & type, unsigned & offset,
+                               DynamicPropertyRcPtr & value) const override;
+    unsigned getUniformBlockSize() const override;
+    void fillUniformBlock(void * buffer) const override;
+
     // Accessors to the 1D & 2D textures built from 1D LUT
     //
     unsigned getNumTextures() const override;
@@ -143,6 +253,8 @@ public:
                     TextureType & channel,
                     Interpolation & interpolation) const override;
     void getTextureValues(unsigned index, const float *& values) const override;
+    void getTextureValues16(unsigned index, TextureFormat & format,
+                            const unsigned short *& values) const override;
 
     // Accessors to the 3D textures built from 3D LUT
     //
@@ -153,6 +265,8 @@ public:
                       const char *& id, unsigned & edgelen, 
                       Interpolation & interpolation) const override;
     void get3DTextureValues(unsigned index, const float *& value) const override;
+    void get3DTextureValues16(unsigned index, TextureFormat & format,
+                              const unsigned short *& values) const override;
 
     // Get the complete shader text
     const char * getShaderText() const override;
@@ -186,6 +300,21 @@ private:
     GenericGpuShaderDesc& operator= (const GenericGpuShaderDesc &) = delete;
     
     static void Deleter(GenericGpuShaderDesc* c);
+
+    friend bool GetGpuShaderCodeState(const GpuShaderDesc &, GpuShaderCodeState &);
+    friend std::string GetGpuShaderSettingsID(const GpuShaderDesc &);
+    friend void CopyGpuShaderProgram(const GpuShaderDesc &, GpuShaderDesc &);
+    friend void SerializeGpuShaderDesc(const GpuShaderDesc &, const char *, std::ostream &);
+    friend GpuShaderDescRcPtr DeserializeGpuShaderDesc(std::istream &, const char *);
+    friend bool AddToLut1DAtlas(GpuShaderDesc &, const char *, unsigned,
+                                const float *, unsigned &);
+    friend unsigned AddLut1DAtlasTexture(GpuShaderDesc &, const char *);
+    friend std::string AddUniformBlockMember(GpuShaderDesc &, const std::string &,
+                                             GpuShaderDesc::UniformType, const float *);
+    friend bool AddUniformBlockMember(GpuShaderDesc &, const std::string &,
+                                      const DynamicPropertyRcPtr &);
+    friend void SetHalfPrecisionOp(GpuShaderDesc &, bool);
+    friend bool IsHalfPrecisionOp(const GpuShaderDesc &);
     
     class Impl;
     friend class Impl;
@@ -7,6 +7,8 @@
 
 #include "GpuShader.h"
 #include "Mutex.h"
+#include "ops/Lut3D/Lut3DOpData.h"
+#include "ops/Lut3D/Lut3DOpGPU.h"
 
 OCIO_NAMESPACE_ENTER
 {
@@ -17,6 +19,19 @@ OCIO_NAMESPACE_ENTER
         std::string functionName_;
         std::string resourcePrefix_;
         std::string pixelName_;
+        TextureFormat textureFormat_;
+        bool lut1DAtlas_;
+        bool lut1DNativeTextures_;
+        bool lut3DHardwareTrilinear_;
+        unsigned frozenDynamicProperties_; // i.e. one bit per non-live property type
+        bool uniformBlock_;
+        bool computeKernel_;
+        unsigned maxAluCost_;
+        unsigned maxNumTextures_;
+        unsigned maxTextureMemory_;
+        unsigned budgetLut3DEdgelen_;
+        bool halfPrecision_;
+        bool lut1DInverseSearch_;
         
         mutable std::string cacheID_;
         mutable Mutex cacheIDMutex_;
@@ -26,6 +41,19 @@ OCIO_NAMESPACE_ENTER
             ,   functionName_("OCIOMain")
             ,   resourcePrefix_("ocio")
             ,   pixelName_("outColor")
+            ,   textureFormat_(TEXTURE_FORMAT_F32)
+            ,   lut1DAtlas_(false)
+            ,   lut1DNativeTextures_(false)
+            ,   lut3DHardwareTrilinear_(false)
+            ,   frozenDynamicProperties_(0)
+            ,   uniformBlock_(false)
+            ,   computeKernel_(false)
+            ,   maxAluCost_(0)
+            ,   maxNumTextures_(0)
+            ,   maxTextureMemory_(0)
+            ,   budgetLut3DEdgelen_(32)
+            ,   halfPrecision_(false)
+            ,   lut1DInverseSearch_(false)
         {
         }
         
@@ -40,6 +68,19 @@ OCIO_NAMESPACE_ENTER
                 functionName_ = rhs.functionName_;
                 resourcePrefix_ = rhs.resourcePrefix_;
                 pixelName_ = rhs.pixelName_;
+                textureFormat_ = rhs.textureFormat_;
+                lut1DAtlas_ = rhs.lut1DAtlas_;
+                lut1DNativeTextures_ = rhs.lut1DNativeTextures_;
+                lut3DHardwareTrilinear_ = rhs.lut3DHardwareTrilinear_;
+                frozenDynamicProperties_ = rhs.frozenDynamicProperties_;
+                uniformBlock_ = rhs.uniformBlock_;
+                computeKernel_ = rhs.computeKernel_;
+                maxAluCost_ = rhs.maxAluCost_;
+                maxNumTextures_ = rhs.maxNumTextures_;
+                maxTextureMemory_ = rhs.maxTextureMemory_;
+                budgetLut3DEdgelen_ = rhs.budgetLut3DEdgelen_;
+                halfPrecision_ = rhs.halfPrecision_;
+                lut1DInverseSearch_ = rhs.lut1DInverseSearch_;
                 cacheID_ = rhs.cacheID_;
             }
             return *this;
@@ -117,6 +158,251 @@ OCIO_NAMESPACE_ENTER
         return getImpl()->pixelName_.c_str();
     }
 
+    void GpuShaderDesc::setTextureFormat(TextureFormat format)
+    {
+        AutoMutex lock(getImpl()->cacheIDMutex_);
+        getImpl()->textureFormat_ = format;
+        getImpl()->cacheID_ = "";
+    }
+
+    GpuShaderDesc::TextureFormat GpuShaderDesc::getTextureFormat() const
+    {
+        return getImpl()->textureFormat_;
+    }
+
+    void GpuShaderDesc::setLut1DAtlasEnabled(bool enabled)
+    {
+        AutoMutex lock(getImpl()->cacheIDMutex_);
+        getImpl()->lut1DAtlas_ = enabled;
+        getImpl()->cacheID_ = "";
+    }
+
+    bool GpuShaderDesc::isLut1DAtlasEnabled() const
+    {
+        return getImpl()->lut1DAtlas_;
+    }
+
+    void GpuShaderDesc::setLut1DNativeTexturesEnabled(bool enabled)
+    {
+        AutoMutex lock(getImpl()->cacheIDMutex_);
+        getImpl()->lut1DNativeTextures_ = enabled;
+        getImpl()->cacheID_ = "";
+    }
+
+    bool GpuShaderDesc::isLut1DNativeTexturesEnabled() const
+    {
+        return getImpl()->lut1DNativeTextures_;
+    }
+
+    void GpuShaderDesc::setLut3DHardwareTrilinearEnabled(bool enabled)
+    {
+        AutoMutex lock(getImpl()->cacheIDMutex_);
+        getImpl()->lut3DHardwareTrilinear_ = enabled;
+        getImpl()->cacheID_ = "";
+    }
+
+    bool GpuShaderDesc::isLut3DHardwareTrilinearEnabled() const
+    {
+        return getImpl()->lut3DHardwareTrilinear_;
+    }
+
+    double GpuShaderDesc::GetLut3DTrilinearError(unsigned edgelen, const float * values)
+    {
+        if (!values)
+        {
+            throw Exception("The 3D texture values are missing.");
+        }
+
+        return ComputeLut3DTrilinearError(edgelen, values);
+    }
+
+    void GpuShaderDesc::setDynamicPropertyLive(DynamicPropertyType type, bool live)
+    {
+        AutoMutex lock(getImpl()->cacheIDMutex_);
+        if (live)
+        {
+            getImpl()->frozenDynamicProperties_ &= ~(1u << type);
+        }
+        else
+        {
+            getImpl()->frozenDynamicProperties_ |= (1u << type);
+        }
+        getImpl()->cacheID_ = "";
+    }
+
+    bool GpuShaderDesc::isDynamicPropertyLive(DynamicPropertyType type) const
+    {
+        return (getImpl()->frozenDynamicProperties_ & (1u << type)) == 0;
+    }
+
+    void GpuShaderDesc::setUniformBlockEnabled(bool enabled)
+    {
+        AutoMutex lock(getImpl()->cacheIDMutex_);
+        getImpl()->uniformBlock_ = enabled;
+        getImpl()->cacheID_ = "";
+    }
+
+    bool GpuShaderDesc::isUniformBlockEnabled() const
+    {
+        return getImpl()->uniformBlock_;
+    }
+
+    void GpuShaderDesc::setComputeKernelEnabled(bool enabled)
+    {
+        AutoMutex lock(getImpl()->cacheIDMutex_);
+        getImpl()->computeKernel_ = enabled;
+        getImpl()->cacheID_ = "";
+    }
+
+    bool GpuShaderDesc::isComputeKernelEnabled() const
+    {
+        return getImpl()->computeKernel_;
+    }
+
+    unsigned GpuShaderDesc::GetComputeWorkGroupSize()
+    {
+        // 256 threads per group is supported by all the APIs, and is large enough to
+        // hide the memory latency.
+        return 16;
+    }
+
+    void GpuShaderDesc::GetComputeNumWorkGroups(unsigned width, unsigned height,
+                                                unsigned & numGroupsX, unsigned & numGroupsY)
+    {
+        const unsigned size = GetComputeWorkGroupSize();
+
+        numGroupsX = (width  + size - 1) / size;
+        numGroupsY = (height + size - 1) / size;
+    }
+
+    void GpuShaderDesc::setGpuBudget(unsigned maxAluCost, unsigned maxNumTextures,
+                                     unsigned maxTextureMemory)
+    {
+        AutoMutex lock(getImpl()->cacheIDMutex_);
+        getImpl()->maxAluCost_ = maxAluCost;
+        getImpl()->maxNumTextures_ = maxNumTextures;
+        getImpl()->maxTextureMemory_ = maxTextureMemory;
+        getImpl()->cacheID_ = "";
+    }
+
+    unsigned GpuShaderDesc::getMaxAluCost() const
+    {
+        return getImpl()->maxAluCost_;
+    }
+
+    unsigned GpuShaderDesc::getMaxNumTextures() const
+    {
+        return getImpl()->maxNumTextures_;
+    }
+
+    unsigned GpuShaderDesc::getMaxTextureMemory() const
+    {
+        return getImpl()->maxTextureMemory_;
+    }
+
+    void GpuShaderDesc::setBudgetLut3DEdgelen(unsigned edgelen)
+    {
+        if (edgelen < 2 || edgelen > Lut3DOpData::maxSupportedLength)
+        {
+            std::ostringstream oss;
+            oss << "Invalid budget 3D LUT edge length " << edgelen
+                << ", the valid range is [2, " << Lut3DOpData::maxSupportedLength << "].";
+            throw Exception(oss.str().c_str());
+        }
+
+        AutoMutex lock(getImpl()->cacheIDMutex_);
+        getImpl()->budgetLut3DEdgelen_ = edgelen;
+        getImpl()->cacheID_ = "";
+    }
+
+    unsigned GpuShaderDesc::getBudgetLut3DEdgelen() const
+    {
+        return getImpl()->budgetLut3DEdgelen_;
+    }
+
+    void GpuShaderDesc::setLut1DInverseSearchEnabled(bool enabled)
+    {
+        AutoMutex lock(getImpl()->cacheIDMutex_);
+        getImpl()->lut1DInverseSearch_ = enabled;
+        getImpl()->cacheID_ = "";
+    }
+
+    bool GpuShaderDesc::isLut1DInverseSearchEnabled() const
+    {
+        return getImpl()->lut1DInverseSearch_;
+    }
+
+    void GpuShaderDesc::setHalfPrecisionEnabled(bool enabled)
+    {
+        AutoMutex lock(getImpl()->cacheIDMutex_);
+        getImpl()->halfPrecision_ = enabled;
+        getImpl()->cacheID_ = "";
+    }
+
+    bool GpuShaderDesc::isHalfPrecisionEnabled() const
+    {
+        return getImpl()->halfPrecision_;
+    }
+
+    unsigned GpuShaderDesc::getNumUniformBlockMembers() const
+    {
+        return 0;
+    }
+
+    void GpuShaderDesc::getUniformBlockMember(unsigned, const char *&, UniformType &,
+                                              unsigned &, DynamicPropertyRcPtr &) const
+    {
+        throw Exception("The uniform block is not supported.");
+    }
+
+    unsigned GpuShaderDesc::getUniformBlockSize() const
+    {
+        return 0;
+    }
+
+    void GpuShaderDesc::fillUniformBlock(void *) const
+    {
+        throw Exception("The uniform block is not supported.");
+    }
+
+    double GpuShaderDesc::GetTextureFormatMaxError(TextureFormat format)
+    {
+        switch(format)
+        {
+            case TEXTURE_FORMAT_F32:
+                return 0.0;
+            // Half the spacing between consecutive values i.e. 2^-11 of the value.
+            case TEXTURE_FORMAT_F16:
+                return 1.0 / 2048.0;
+            case TEXTURE_FORMAT_UNORM16:
+                return 0.5 / 65535.0;
+        }
+
+        throw Exception("Unknown texture format.");
+    }
+
+    void GpuShaderDesc::getTextureValues16(unsigned, TextureFormat &,
+                                           const unsigned short *&) const
+    {
+        throw Exception("The 16-bit textures are not supported.");
+    }
+
+    void GpuShaderDesc::get3DTextureValues16(unsigned, TextureFormat &,
+                                             const unsigned short *&) const
+    {
+        throw Exception("The 16-bit textures are not supported.");
+    }
+
+    void GpuShaderDesc::serialize(std::ostream & os, const char * key) const
+    {
+        SerializeGpuShaderDesc(*this, key, os);
+    }
+
+    GpuShaderDescRcPtr GpuShaderDesc::Deserialize(std::istream & is, const char * key)
+    {
+        return DeserializeGpuShaderDesc(is, key);
+    }
+
     const char * GpuShaderDesc::getCacheID() const
     {
         AutoMutex lock(getImpl()->cacheIDMutex_);
@@ -128,6 +414,54 @@ OCIO_NAMESPACE_ENTER
             os << getImpl()->functionName_ << " ";
             os << getImpl()->resourcePrefix_ << " ";
             os << getImpl()->pixelName_ << " ";
+            if(getImpl()->textureFormat_==TEXTURE_FORMAT_F16)
+            {
+                os << "f16 ";
+            }
+            else if(getImpl()->textureFormat_==TEXTURE_FORMAT_UNORM16)
+            {
+                os << "unorm16 ";
+            }
+            if(getImpl()->lut1DAtlas_)
+            {
+                os << "lut1d_atlas ";
+            }
+            if(getImpl()->lut1DNativeTextures_)
+            {
+                os << "lut1d_native_textures ";
+            }
+            if(getImpl()->lut3DHardwareTrilinear_)
+            {
+                os << "lut3d_hardware_trilinear ";
+            }
+            if(getImpl()->frozenDynamicProperties_)
+            {
+                os << "frozen_properties " << getImpl()->frozenDynamicProperties_ << " ";
+            }
+            if(getImpl()->uniformBlock_)
+            {
+                os << "uniform_block ";
+            }
+            if(getImpl()->computeKernel_)
+            {
+                os << "compute_kernel ";
+            }
+            if(getImpl()->maxAluCost_ || getImpl()->maxNumTextures_
+               || getImpl()->maxTextureMemory_)
+            {
+                os << "budget " << getImpl()->maxAluCost_
+                   << " " << getImpl()->maxNumTextures_
+                   << " " << getImpl()->maxTextureMemory_
+                   << " " << getImpl()->budgetLut3DEdgelen_ << " ";
+            }
+            if(getImpl()->halfPrecision_)
+            {
+                os << "half_precision ";
+            }
+            if(getImpl()->lut1DInverseSearch_)
+            {
+                os << "lut1d_inverse_search ";
+            }
             getImpl()->cacheID_ = os.str();
         }
         
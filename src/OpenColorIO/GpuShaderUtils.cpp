@@ -43,6 +43,8 @@ OCIO_NAMESPACE_ENTER
             case GPU_LANGUAGE_GLSL_1_0:
             case GPU_LANGUAGE_GLSL_1_3:
             case GPU_LANGUAGE_GLSL_4_0:
+            case GPU_LANGUAGE_GLSL_ES_3_0:
+            case GPU_LANGUAGE_GLSL_VK_4_6:
             {
                 kw << "vec" << N;
                 break;
@@ -54,6 +56,7 @@ OCIO_NAMESPACE_ENTER
             }
 
             case GPU_LANGUAGE_HLSL_DX11:
+            case GPU_LANGUAGE_MSL_2_0:
             {
                 kw << "float" << N;
                 break;
@@ -68,10 +71,72 @@ OCIO_NAMESPACE_ENTER
         return kw.str();
     }
 
+    template<int N>
+    std::string getHalfVecKeyword(GpuLanguage lang)
+    {
+        std::ostringstream kw;
+        switch (lang)
+        {
+            case GPU_LANGUAGE_GLSL_1_0:
+            case GPU_LANGUAGE_GLSL_1_3:
+            case GPU_LANGUAGE_GLSL_4_0:
+            case GPU_LANGUAGE_GLSL_ES_3_0:
+            case GPU_LANGUAGE_GLSL_VK_4_6:
+            {
+                // The precision is a qualifier of the declarations.
+                kw << "vec" << N;
+                break;
+            }
+            case GPU_LANGUAGE_CG:
+            case GPU_LANGUAGE_MSL_2_0:
+            {
+                kw << "half" << N;
+                break;
+            }
+            case GPU_LANGUAGE_HLSL_DX11:
+            {
+                kw << "min16float" << N;
+                break;
+            }
+
+            case GPU_LANGUAGE_UNKNOWN:
+            default:
+            {
+                throw Exception("Unknown Gpu shader language");
+            }
+        }
+        return kw.str();
+    }
+
+    // Get the precision qualifier of the half declarations (i.e. GLSL 1.0 has none).
+    std::string getHalfQualifier(GpuLanguage lang)
+    {
+        switch (lang)
+        {
+            case GPU_LANGUAGE_GLSL_1_3:
+            case GPU_LANGUAGE_GLSL_4_0:
+            case GPU_LANGUAGE_GLSL_ES_3_0:
+            case GPU_LANGUAGE_GLSL_VK_4_6:
+            {
+                return "mediump ";
+            }
+            default:
+            {
+                return "";
+            }
+        }
+    }
+
+    // Refer to GpuLanguage for the binding conventions of the textures & uniforms.
+    static constexpr unsigned VulkanTextureSet   = 0;
+    static constexpr unsigned VulkanTexture3DSet = 1;
+    static constexpr unsigned VulkanUniformSet   = 2;
+
     template<int N>
     void getTexDecl(GpuLanguage lang,
                     const std::string & textureName, 
                     const std::string & samplerName,
+                    unsigned index,
                     std::string & textureDecl, 
                     std::string & samplerDecl)
     {
@@ -100,6 +165,34 @@ OCIO_NAMESPACE_ENTER
                 samplerDecl = t.str();
                 break;
             }
+            case GPU_LANGUAGE_GLSL_ES_3_0:
+            {
+                // No 1D textures and no default precision for the 3D samplers.
+                textureDecl = "";
+
+                std::ostringstream kw;
+                kw << "uniform highp sampler" << (N == 1 ? 2 : N) << "D " << samplerName << ";";
+                samplerDecl = kw.str();
+                break;
+            }
+            case GPU_LANGUAGE_GLSL_VK_4_6:
+            {
+                textureDecl = "";
+
+                std::ostringstream kw;
+                kw << "layout(set = " << (N == 3 ? VulkanTexture3DSet : VulkanTextureSet)
+                   << ", binding = " << index << ") uniform sampler" << N << "D "
+                   << samplerName << ";";
+                samplerDecl = kw.str();
+                break;
+            }
+            case GPU_LANGUAGE_MSL_2_0:
+            {
+                // The textures & samplers are parameters of the shader function.
+                textureDecl = "";
+                samplerDecl = "";
+                break;
+            }
 
             case GPU_LANGUAGE_UNKNOWN:
             default:
@@ -132,14 +225,46 @@ OCIO_NAMESPACE_ENTER
             }
             case GPU_LANGUAGE_HLSL_DX11:
             {
-                kw << textureName << ".Sample(" << samplerName << ", " << coords << ")";
+                // The LUT textures have no mipmaps so an explicit level of detail gives
+                // the same result, and is also available in compute shaders.
+                kw << textureName << ".SampleLevel(" << samplerName << ", " << coords << ", 0)";
                 break;
             }
             case GPU_LANGUAGE_GLSL_4_0:
+            case GPU_LANGUAGE_GLSL_VK_4_6:
             {
                 kw << "texture(" << samplerName << ", " << coords << ")";
                 break;
             }
+            case GPU_LANGUAGE_GLSL_ES_3_0:
+            {
+                // The 1D textures are 2D textures with a height of one.
+                if (N == 1)
+                {
+                    kw << "texture(" << samplerName << ", vec2(" << coords << ", 0.5))";
+                }
+                else
+                {
+                    kw << "texture(" << samplerName << ", " << coords << ")";
+                }
+                break;
+            }
+            case GPU_LANGUAGE_MSL_2_0:
+            {
+                // The 1D textures are 2D textures with a height of one. As for HLSL, the
+                // explicit level of detail is also available in kernel functions.
+                if (N == 1)
+                {
+                    kw << textureName << ".sample(" << samplerName 
+                       << ", float2(" << coords << ", 0.5), level(0))";
+                }
+                else
+                {
+                    kw << textureName << ".sample(" << samplerName << ", " << coords 
+                       << ", level(0))";
+                }
+                break;
+            }
 
             case GPU_LANGUAGE_UNKNOWN:
             default:
@@ -186,32 +311,32 @@ OCIO_NAMESPACE_ENTER
     {
         if (str)
         {
-            m_text->m_ossLine << str;
+            m_text->m_line += str;
         }
         return *this;
     }
 
     GpuShaderText::GpuShaderLine& GpuShaderText::GpuShaderLine::operator<<(float value)
     {
-        m_text->m_ossLine << getFloatString(value, m_text->m_lang);
+        m_text->m_line += getFloatString(value, m_text->m_lang);
         return *this;
     }
 
     GpuShaderText::GpuShaderLine& GpuShaderText::GpuShaderLine::operator<<(double value)
     {
-        m_text->m_ossLine << getFloatString(value, m_text->m_lang);
+        m_text->m_line += getFloatString(value, m_text->m_lang);
         return *this;
     }
 
     GpuShaderText::GpuShaderLine& GpuShaderText::GpuShaderLine::operator<<(unsigned value)
     {
-        m_text->m_ossLine << value;
+        m_text->m_line += std::to_string(value);
         return *this;
     }
 
     GpuShaderText::GpuShaderLine& GpuShaderText::GpuShaderLine::operator<<(const std::string& str)
     {
-        m_text->m_ossLine << str;
+        m_text->m_line += str;
         return *this;
     }
 
@@ -227,9 +352,10 @@ OCIO_NAMESPACE_ENTER
     GpuShaderText::GpuShaderText(GpuLanguage lang)
         :   m_lang(lang)
         ,   m_indent(0)
+        ,   m_halfPrecision(false)
     {
-        m_ossText.precision(16);
-        m_ossLine.precision(16);
+        m_text.reserve(4096);
+        m_line.reserve(256);
     }
 
     void GpuShaderText::setIndent(unsigned i)
@@ -254,19 +380,18 @@ OCIO_NAMESPACE_ENTER
 
     std::string GpuShaderText::string() const
     {
-        return m_ossText.str();
+        return m_text;
     }
 
     void GpuShaderText::flushLine()
     {
         static const unsigned tabSize = 2;
 
-        m_ossText << std::string(tabSize * m_indent, ' ')
-                  << m_ossLine.str()
-                  << std::endl;
+        m_text.append(tabSize * m_indent, ' ');
+        m_text += m_line;
+        m_text += '\n';
 
-        m_ossLine.str("");
-        m_ossLine.clear();
+        m_line.clear();
     }
 
     void GpuShaderText::declareVar(const std::string & name, float v)
@@ -285,6 +410,38 @@ OCIO_NAMESPACE_ENTER
                   << name << " = " << v << ";";
     }
 
+    void GpuShaderText::declareFloatConst(const std::string & name, float v)
+    {
+        if(name.empty())
+        {
+           throw Exception("Gpu variable name is empty");
+        }
+
+        switch (m_lang)
+        {
+            case GPU_LANGUAGE_CG:
+            case GPU_LANGUAGE_HLSL_DX11:
+            {
+                // Without 'static' a global constant is a uniform.
+                newLine() << "static const float " << name << " = " 
+                          << getFloatString(v, m_lang) << ";";
+                break;
+            }
+            case GPU_LANGUAGE_MSL_2_0:
+            {
+                newLine() << "constant float " << name << " = " 
+                          << getFloatString(v, m_lang) << ";";
+                break;
+            }
+            default:
+            {
+                newLine() << "const float " << name << " = " 
+                          << getFloatString(v, m_lang) << ";";
+                break;
+            }
+        }
+    }
+
     std::string GpuShaderText::vec2fKeyword() const
     {
         return getVecKeyword<2>(m_lang);
@@ -471,10 +628,22 @@ OCIO_NAMESPACE_ENTER
         return textureName + "Sampler";
     }
 
-    void GpuShaderText::declareTex1D(const std::string & textureName)
+    std::string GpuShaderText::getTextureName(const std::string& samplerName)
+    {
+        static const std::string suffix("Sampler");
+        if (samplerName.size() > suffix.size()
+            && samplerName.compare(samplerName.size() - suffix.size(), suffix.size(), suffix) == 0)
+        {
+            return samplerName.substr(0, samplerName.size() - suffix.size());
+        }
+        return samplerName;
+    }
+
+    void GpuShaderText::declareTex1D(const std::string & textureName, unsigned index)
     {
         std::string textureDecl, samplerDecl;
-        getTexDecl<1>(m_lang, textureName, getSamplerName(textureName), textureDecl, samplerDecl);
+        getTexDecl<1>(m_lang, textureName, getSamplerName(textureName), index,
+                       textureDecl, samplerDecl);
 
         if (!textureDecl.empty())
         {
@@ -487,10 +656,11 @@ OCIO_NAMESPACE_ENTER
         }
     }
 
-    void GpuShaderText::declareTex2D(const std::string & textureName)
+    void GpuShaderText::declareTex2D(const std::string & textureName, unsigned index)
     {
         std::string textureDecl, samplerDecl;
-        getTexDecl<2>(m_lang, textureName, getSamplerName(textureName), textureDecl, samplerDecl);
+        getTexDecl<2>(m_lang, textureName, getSamplerName(textureName), index,
+                       textureDecl, samplerDecl);
 
         if (!textureDecl.empty())
         {
@@ -503,10 +673,11 @@ OCIO_NAMESPACE_ENTER
         }
     }
 
-    void GpuShaderText::declareTex3D(const std::string& textureName)
+    void GpuShaderText::declareTex3D(const std::string& textureName, unsigned index)
     {
         std::string textureDecl, samplerDecl;
-        getTexDecl<3>(m_lang, textureName, getSamplerName(textureName), textureDecl, samplerDecl);
+        getTexDecl<3>(m_lang, textureName, getSamplerName(textureName), index,
+                       textureDecl, samplerDecl);
 
         if (!textureDecl.empty())
         {
@@ -538,14 +709,35 @@ OCIO_NAMESPACE_ENTER
     }
 
 
-    void GpuShaderText::declareUniformFloat(const std::string & uniformName)
+    void GpuShaderText::declareUniformFloat(const std::string & uniformName, unsigned index)
     {
-        newLine() << "uniform float " << uniformName << ";";
+        switch (m_lang)
+        {
+            case GPU_LANGUAGE_GLSL_VK_4_6:
+            {
+                // Vulkan only supports the uniforms in blocks.
+                newLine() << "layout(set = " << VulkanUniformSet << ", binding = " << index
+                          << ") uniform " << uniformName << "Block { float " << uniformName 
+                          << "; };";
+                break;
+            }
+            case GPU_LANGUAGE_MSL_2_0:
+            {
+                // The uniforms are parameters of the shader function.
+                break;
+            }
+            default:
+            {
+                newLine() << "uniform float " << uniformName << ";";
+                break;
+            }
+        }
     }
 
     // Keep the method private as only float & double types are expected
     template<typename T>
-    std::string matrix4Mul(const T * m4x4, const std::string & vecName, GpuLanguage lang)
+    std::string matrix4Mul(const T * m4x4, const std::string & vecName, GpuLanguage lang,
+                           bool halfPrecision = false)
     {
         if (vecName.empty())
         {
@@ -558,12 +750,21 @@ OCIO_NAMESPACE_ENTER
             case GPU_LANGUAGE_GLSL_1_0:
             case GPU_LANGUAGE_GLSL_1_3:
             case GPU_LANGUAGE_GLSL_4_0:
+            case GPU_LANGUAGE_GLSL_ES_3_0:
+            case GPU_LANGUAGE_GLSL_VK_4_6:
             {
                 // OpenGL shader program requests a transposed matrix
                 kw << "mat4(" 
                    << getMatrixValues<T, 4>(m4x4, lang, true) << ") * " << vecName;
                 break;
             }
+            case GPU_LANGUAGE_MSL_2_0:
+            {
+                // Metal matrices are also column-major.
+                kw << (halfPrecision ? "half4x4(" : "float4x4(")
+                   << getMatrixValues<T, 4>(m4x4, lang, true) << ") * " << vecName;
+                break;
+            }
             case GPU_LANGUAGE_CG:
             {
                 kw << "mul(half4x4(" 
@@ -573,7 +774,8 @@ OCIO_NAMESPACE_ENTER
             case GPU_LANGUAGE_HLSL_DX11:
             {
                 kw << "mul(" << vecName 
-                   << ", float4x4(" << getMatrixValues<T, 4>(m4x4, lang, true) << "))";
+                   << (halfPrecision ? ", min16float4x4(" : ", float4x4(")
+                   << getMatrixValues<T, 4>(m4x4, lang, true) << "))";
                 break;
             }
 
@@ -598,6 +800,184 @@ OCIO_NAMESPACE_ENTER
         return matrix4Mul<double>(m4x4, vecName, m_lang);
     }
 
+    std::string GpuShaderText::mat4fMul(const std::string & matName, 
+                                        const std::string & vecName) const
+    {
+        if (matName.empty() || vecName.empty())
+        {
+           throw Exception("Gpu variable name is empty");
+        }
+
+        switch (m_lang)
+        {
+            case GPU_LANGUAGE_CG:
+            case GPU_LANGUAGE_HLSL_DX11:
+            {
+                // The default matrix packing is also column-major.
+                return "mul(" + matName + ", " + vecName + ")";
+            }
+            case GPU_LANGUAGE_UNKNOWN:
+            {
+                throw Exception("Unknown Gpu shader language");
+            }
+            default:
+            {
+                return matName + " * " + vecName;
+            }
+        }
+    }
+
+    std::string GpuShaderText::mat4fKeyword() const
+    {
+        switch (m_lang)
+        {
+            case GPU_LANGUAGE_GLSL_1_0:
+            case GPU_LANGUAGE_GLSL_1_3:
+            case GPU_LANGUAGE_GLSL_4_0:
+            case GPU_LANGUAGE_GLSL_ES_3_0:
+            case GPU_LANGUAGE_GLSL_VK_4_6:
+            {
+                return "mat4";
+            }
+            case GPU_LANGUAGE_CG:
+            {
+                return "half4x4";
+            }
+            case GPU_LANGUAGE_HLSL_DX11:
+            case GPU_LANGUAGE_MSL_2_0:
+            {
+                return "float4x4";
+            }
+
+            case GPU_LANGUAGE_UNKNOWN:
+            default:
+            {
+                throw Exception("Unknown Gpu shader language");
+            }
+        }
+    }
+
+    void GpuShaderText::setHalfPrecision(bool halfPrecision)
+    {
+        m_halfPrecision = halfPrecision;
+    }
+
+    std::string GpuShaderText::vec3hKeyword() const
+    {
+        return m_halfPrecision ? getHalfVecKeyword<3>(m_lang) : vec3fKeyword();
+    }
+
+    std::string GpuShaderText::vec3hConst(double x, double y, double z) const
+    {
+        std::ostringstream kw;
+        kw << vec3hKeyword() << "(" << getFloatString(x, m_lang) << ", "
+           << getFloatString(y, m_lang) << ", " << getFloatString(z, m_lang) << ")";
+        return kw.str();
+    }
+
+    std::string GpuShaderText::vec3hConst(double v) const
+    {
+        return vec3hConst(v, v, v);
+    }
+
+    std::string GpuShaderText::vec3hConst(const std::string & v) const
+    {
+        std::ostringstream kw;
+        kw << vec3hKeyword() << "(" << v << ", " << v << ", " << v << ")";
+        return kw.str();
+    }
+
+    std::string GpuShaderText::vec3hDecl(const std::string & name) const
+    {
+        if (!m_halfPrecision)
+        {
+            return vec3fDecl(name);
+        }
+
+        if (name.empty())
+        {
+           throw Exception("Gpu variable name is empty");
+        }
+
+        return getHalfQualifier(m_lang) + vec3hKeyword() + " " + name;
+    }
+
+    std::string GpuShaderText::vec3hCast(const std::string & v) const
+    {
+        // The GLSL precision only depends on the declarations, and Cg is already in half.
+        if (!m_halfPrecision || vec3hKeyword()==vec3fKeyword())
+        {
+            return v;
+        }
+
+        return vec3hKeyword() + "(" + v + ")";
+    }
+
+    std::string GpuShaderText::vec3fCast(const std::string & v) const
+    {
+        if (!m_halfPrecision || vec3hKeyword()==vec3fKeyword())
+        {
+            return v;
+        }
+
+        return vec3fKeyword() + "(" + v + ")";
+    }
+
+    std::string GpuShaderText::vec4hKeyword() const
+    {
+        return m_halfPrecision ? getHalfVecKeyword<4>(m_lang) : vec4fKeyword();
+    }
+
+    std::string GpuShaderText::vec4hConst(double x, double y, double z, double w) const
+    {
+        std::ostringstream kw;
+        kw << vec4hKeyword() << "(" << getFloatString(x, m_lang) << ", "
+           << getFloatString(y, m_lang) << ", " << getFloatString(z, m_lang) << ", "
+           << getFloatString(w, m_lang) << ")";
+        return kw.str();
+    }
+
+    std::string GpuShaderText::vec4hDecl(const std::string & name) const
+    {
+        if (!m_halfPrecision)
+        {
+            return vec4fDecl(name);
+        }
+
+        if (name.empty())
+        {
+           throw Exception("Gpu variable name is empty");
+        }
+
+        return getHalfQualifier(m_lang) + vec4hKeyword() + " " + name;
+    }
+
+    std::string GpuShaderText::vec4hCast(const std::string & v) const
+    {
+        if (!m_halfPrecision || vec4hKeyword()==vec4fKeyword())
+        {
+            return v;
+        }
+
+        return vec4hKeyword() + "(" + v + ")";
+    }
+
+    std::string GpuShaderText::vec4fCast(const std::string & v) const
+    {
+        if (!m_halfPrecision || vec4hKeyword()==vec4fKeyword())
+        {
+            return v;
+        }
+
+        return vec4fKeyword() + "(" + v + ")";
+    }
+
+    std::string GpuShaderText::mat4hMul(const double * m4x4, 
+                                        const std::string & vecName) const
+    {
+        return matrix4Mul<double>(m4x4, vecName, m_lang, m_halfPrecision);
+    }
+
     std::string GpuShaderText::lerp(const std::string & x, 
                                     const std::string & y, 
                                     const std::string & a) const
@@ -608,6 +988,9 @@ OCIO_NAMESPACE_ENTER
             case GPU_LANGUAGE_GLSL_1_0:
             case GPU_LANGUAGE_GLSL_1_3:
             case GPU_LANGUAGE_GLSL_4_0:
+            case GPU_LANGUAGE_GLSL_ES_3_0:
+            case GPU_LANGUAGE_GLSL_VK_4_6:
+            case GPU_LANGUAGE_MSL_2_0:
             {
                 kw << "mix(" << x << ", " << y << ", " << a << ")";
                 break;
@@ -637,11 +1020,18 @@ OCIO_NAMESPACE_ENTER
             case GPU_LANGUAGE_GLSL_1_0:
             case GPU_LANGUAGE_GLSL_1_3:
             case GPU_LANGUAGE_GLSL_4_0:
+            case GPU_LANGUAGE_GLSL_ES_3_0:
+            case GPU_LANGUAGE_GLSL_VK_4_6:
             case GPU_LANGUAGE_CG:
             {
                 kw << vec4fKeyword() << "(greaterThan( " << a << ", " << b << "))";
                 break;
             }
+            case GPU_LANGUAGE_MSL_2_0:
+            {
+                kw << vec4fKeyword() << "(" << a << " > " << b << ")";
+                break;
+            }
             case GPU_LANGUAGE_HLSL_DX11:
             {
                 kw << vec4fKeyword() << "((" << a << " > " << b << ") ? " 
@@ -668,6 +1058,8 @@ OCIO_NAMESPACE_ENTER
             case GPU_LANGUAGE_GLSL_1_0:
             case GPU_LANGUAGE_GLSL_1_3:
             case GPU_LANGUAGE_GLSL_4_0:
+            case GPU_LANGUAGE_GLSL_ES_3_0:
+            case GPU_LANGUAGE_GLSL_VK_4_6:
             {
                 // note: "atan" not "atan2"
                 kw << "atan(" << y << ", " << x << ")";
@@ -679,6 +1071,11 @@ OCIO_NAMESPACE_ENTER
                 kw << "atan2(" << x << ", " << y << ")";
                 break;
             }
+            case GPU_LANGUAGE_MSL_2_0:
+            {
+                kw << "atan2(" << y << ", " << x << ")";
+                break;
+            }
 
             case GPU_LANGUAGE_UNKNOWN:
             default:
@@ -709,4 +1106,169 @@ OCIO_ADD_TEST(GpuShaderUtils, FloatToString)
     OCIO_CHECK_EQUAL(OCIO::getFloatString((float)1, OCIO::GPU_LANGUAGE_GLSL_1_3), "1.");
 }
 
+OCIO_ADD_TEST(GpuShaderUtils, Languages)
+{
+    for (auto lang : { OCIO::GPU_LANGUAGE_GLSL_ES_3_0,
+                       OCIO::GPU_LANGUAGE_GLSL_VK_4_6,
+                       OCIO::GPU_LANGUAGE_MSL_2_0 })
+    {
+        OCIO_CHECK_EQUAL(OCIO::GpuLanguageFromString(OCIO::GpuLanguageToString(lang)), lang);
+    }
+
+    {
+        OCIO::GpuShaderText ss(OCIO::GPU_LANGUAGE_GLSL_ES_3_0);
+        OCIO_CHECK_EQUAL(ss.vec3fKeyword(), "vec3");
+
+        ss.declareTex1D("lut1d_0", 0);
+        ss.declareTex3D("lut3d_0", 0);
+        ss.declareUniformFloat("exposureVal", 0);
+        OCIO_CHECK_EQUAL(ss.string(), "uniform highp sampler2D lut1d_0Sampler;\n"
+                                      "uniform highp sampler3D lut3d_0Sampler;\n"
+                                      "uniform float exposureVal;\n");
+
+        OCIO_CHECK_EQUAL(ss.sampleTex1D("lut1d_0", "coords.r"),
+                         "texture(lut1d_0Sampler, vec2(coords.r, 0.5))");
+        OCIO_CHECK_EQUAL(ss.sampleTex3D("lut3d_0", "coords"), "texture(lut3d_0Sampler, coords)");
+    }
+
+    {
+        OCIO::GpuShaderText ss(OCIO::GPU_LANGUAGE_GLSL_VK_4_6);
+        OCIO_CHECK_EQUAL(ss.vec4fKeyword(), "vec4");
+
+        ss.declareTex2D("lut1d_1", 1);
+        ss.declareTex3D("lut3d_0", 0);
+        ss.declareUniformFloat("exposureVal", 2);
+        OCIO_CHECK_EQUAL(ss.string(),
+                         "layout(set = 0, binding = 1) uniform sampler2D lut1d_1Sampler;\n"
+                         "layout(set = 1, binding = 0) uniform sampler3D lut3d_0Sampler;\n"
+                         "layout(set = 2, binding = 2) uniform exposureValBlock "
+                         "{ float exposureVal; };\n");
+
+        OCIO_CHECK_EQUAL(ss.sampleTex2D("lut1d_1", "pos"), "texture(lut1d_1Sampler, pos)");
+    }
+
+    {
+        OCIO::GpuShaderText ss(OCIO::GPU_LANGUAGE_MSL_2_0);
+        OCIO_CHECK_EQUAL(ss.vec3fKeyword(), "float3");
+
+        // The resources are parameters of the shader function.
+        ss.declareTex1D("lut1d_0", 0);
+        ss.declareTex3D("lut3d_0", 0);
+        ss.declareUniformFloat("exposureVal", 0);
+        OCIO_CHECK_EQUAL(ss.string(), "");
+
+        OCIO_CHECK_EQUAL(ss.sampleTex1D("lut1d_0", "coords.r"),
+                         "lut1d_0.sample(lut1d_0Sampler, float2(coords.r, 0.5), level(0))");
+        OCIO_CHECK_EQUAL(ss.sampleTex3D("lut3d_0", "coords"),
+                         "lut3d_0.sample(lut3d_0Sampler, coords, level(0))");
+        OCIO_CHECK_EQUAL(ss.lerp("a", "b", "c"), "mix(a, b, c)");
+        OCIO_CHECK_EQUAL(ss.atan2("y", "x"), "atan2(y, x)");
+        OCIO_CHECK_EQUAL(ss.vec4fGreaterThan("a", "b"), "float4(a > b)");
+
+        const float m[16] = { 1.f, 2.f, 3.f, 4.f,  5.f, 6.f, 7.f, 8.f,
+                              9.f, 10.f, 11.f, 12.f,  13.f, 14.f, 15.f, 16.f };
+        OCIO_CHECK_EQUAL(ss.mat4fMul(m, "pix"),
+                         "float4x4(1., 5., 9., 13., 2., 6., 10., 14., "
+                         "3., 7., 11., 15., 4., 8., 12., 16.) * pix");
+
+        OCIO_CHECK_EQUAL(OCIO::GpuShaderText::getTextureName("lut3d_0Sampler"), "lut3d_0");
+        OCIO_CHECK_EQUAL(OCIO::GpuShaderText::getTextureName("lut3d_0"), "lut3d_0");
+    }
+
+    {
+        OCIO::GpuShaderText ss(OCIO::GPU_LANGUAGE_HLSL_DX11);
+        OCIO_CHECK_EQUAL(ss.sampleTex3D("lut3d_0", "coords"),
+                         "lut3d_0.SampleLevel(lut3d_0Sampler, coords, 0)");
+    }
+}
+
+OCIO_ADD_TEST(GpuShaderUtils, UniformMatrix)
+{
+    {
+        OCIO::GpuShaderText ss(OCIO::GPU_LANGUAGE_GLSL_4_0);
+        OCIO_CHECK_EQUAL(ss.mat4fKeyword(), "mat4");
+        OCIO_CHECK_EQUAL(ss.mat4fMul(std::string("m"), "pix"), "m * pix");
+    }
+    {
+        OCIO::GpuShaderText ss(OCIO::GPU_LANGUAGE_HLSL_DX11);
+        OCIO_CHECK_EQUAL(ss.mat4fKeyword(), "float4x4");
+        OCIO_CHECK_EQUAL(ss.mat4fMul(std::string("m"), "pix"), "mul(m, pix)");
+    }
+    {
+        OCIO::GpuShaderText ss(OCIO::GPU_LANGUAGE_MSL_2_0);
+        OCIO_CHECK_EQUAL(ss.mat4fKeyword(), "float4x4");
+        OCIO_CHECK_EQUAL(ss.mat4fMul(std::string("m"), "pix"), "m * pix");
+    }
+}
+
+OCIO_ADD_TEST(GpuShaderUtils, FloatConst)
+{
+    {
+        OCIO::GpuShaderText ss(OCIO::GPU_LANGUAGE_GLSL_1_3);
+        ss.declareFloatConst("height", 12.0f);
+        OCIO_CHECK_EQUAL(ss.string(), "const float height = 12.;\n");
+    }
+    {
+        OCIO::GpuShaderText ss(OCIO::GPU_LANGUAGE_HLSL_DX11);
+        ss.declareFloatConst("height", 12.0f);
+        OCIO_CHECK_EQUAL(ss.string(), "static const float height = 12.;\n");
+    }
+    {
+        OCIO::GpuShaderText ss(OCIO::GPU_LANGUAGE_MSL_2_0);
+        ss.declareFloatConst("height", 0.5f);
+        OCIO_CHECK_EQUAL(ss.string(), "constant float height = 0.5;\n");
+    }
+
+    OCIO::GpuShaderText ss(OCIO::GPU_LANGUAGE_GLSL_1_3);
+    OCIO_CHECK_THROW_WHAT(ss.declareFloatConst("", 1.0f), OCIO::Exception, "name is empty");
+}
+
+OCIO_ADD_TEST(GpuShaderUtils, HalfPrecision)
+{
+    const double m[16] = { 1., 0., 0., 0.,
+                           0., 1., 0., 0.,
+                           0., 0., 1., 0.,
+                           0., 0., 0., 1. };
+    {
+        // Without half precision, the helpers use the full precision types.
+        OCIO::GpuShaderText ss(OCIO::GPU_LANGUAGE_MSL_2_0);
+        OCIO_CHECK_ASSERT(!ss.isHalfPrecision());
+        OCIO_CHECK_EQUAL(ss.vec3hDecl("v"), "float3 v");
+        OCIO_CHECK_EQUAL(ss.vec3hCast("pix.rgb"), "pix.rgb");
+        OCIO_CHECK_EQUAL(ss.vec3hConst(0.5), "float3(0.5, 0.5, 0.5)");
+    }
+    {
+        OCIO::GpuShaderText ss(OCIO::GPU_LANGUAGE_MSL_2_0);
+        ss.setHalfPrecision(true);
+        OCIO_CHECK_EQUAL(ss.vec3hDecl("v"), "half3 v");
+        OCIO_CHECK_EQUAL(ss.vec3hConst(0.5), "half3(0.5, 0.5, 0.5)");
+        OCIO_CHECK_EQUAL(ss.vec3hCast("pix.rgb"), "half3(pix.rgb)");
+        OCIO_CHECK_EQUAL(ss.vec3fCast("v"), "float3(v)");
+        OCIO_CHECK_EQUAL(ss.vec4hDecl("p"), "half4 p");
+        OCIO_CHECK_EQUAL(ss.vec4hConst(1., 2., 3., 0.), "half4(1., 2., 3., 0.)");
+        OCIO_CHECK_EQUAL(ss.vec4fCast("p"), "float4(p)");
+        OCIO_CHECK_EQUAL(ss.mat4hMul(m, "p").substr(0, 8), "half4x4(");
+    }
+    {
+        OCIO::GpuShaderText ss(OCIO::GPU_LANGUAGE_HLSL_DX11);
+        ss.setHalfPrecision(true);
+        OCIO_CHECK_EQUAL(ss.vec3hDecl("v"), "min16float3 v");
+        OCIO_CHECK_EQUAL(ss.vec4hCast("pix"), "min16float4(pix)");
+        OCIO_CHECK_EQUAL(ss.mat4hMul(m, "p").substr(0, 21), "mul(p, min16float4x4(");
+    }
+    {
+        OCIO::GpuShaderText ss(OCIO::GPU_LANGUAGE_GLSL_ES_3_0);
+        ss.setHalfPrecision(true);
+        OCIO_CHECK_EQUAL(ss.vec3hDecl("v"), "mediump vec3 v");
+        OCIO_CHECK_EQUAL(ss.vec3hCast("pix.rgb"), "pix.rgb");
+        OCIO_CHECK_EQUAL(ss.vec3fCast("v"), "v");
+    }
+    {
+        // GLSL 1.0 has no precision qualifier.
+        OCIO::GpuShaderText ss(OCIO::GPU_LANGUAGE_GLSL_1_0);
+        ss.setHalfPrecision(true);
+        OCIO_CHECK_EQUAL(ss.vec4hDecl("p"), "vec4 p");
+    }
+}
+
 #endif // OCIO_UNIT_TEST
@@ -8,6 +8,7 @@
 #include <OpenColorIO/OpenColorIO.h>
 
 #include <sstream>
+#include <string>
 
 
 OCIO_NAMESPACE_ENTER
@@ -70,6 +71,8 @@ OCIO_NAMESPACE_ENTER
         void declareVar(const std::string& name, float v);
         // Declare a float variable
         void declareVar(const std::string& name, const std::string& v);
+        // Declare a global float constant (i.e. in the declaration part of the shader)
+        void declareFloatConst(const std::string& name, float v);
 
         //
         // Vec2f helper functions
@@ -139,13 +142,17 @@ OCIO_NAMESPACE_ENTER
         // Texture helpers
         //
         static std::string getSamplerName(const std::string& textureName);
+        // Get the texture name from its sampler name (i.e. inverse of getSamplerName()).
+        static std::string getTextureName(const std::string& samplerName);
 
         // Declare the global texture and sampler information for a 1D texture.
-        void declareTex1D(const std::string& textureName);
+        // The index is the one of the texture in the shader description 
+        // (i.e. used as binding by some languages).
+        void declareTex1D(const std::string& textureName, unsigned index);
         // Declare the global texture and sampler information for a 2D texture.
-        void declareTex2D(const std::string& textureName);
+        void declareTex2D(const std::string& textureName, unsigned index);
         // Declare the global texture and sampler information for a 3D texture.
-        void declareTex3D(const std::string& textureName);
+        void declareTex3D(const std::string& textureName, unsigned index);
 
         // Get the texture lookup call for a 1D texture.
         std::string sampleTex1D(const std::string& textureName, const std::string& coords) const;
@@ -154,7 +161,9 @@ OCIO_NAMESPACE_ENTER
         // Get the texture lookup call for a 3D texture.
         std::string sampleTex3D(const std::string& textureName, const std::string& coords) const;
 
-        void declareUniformFloat(const std::string & uniformName);
+        // Declare a float uniform, the index being the one of the uniform 
+        // in the shader description.
+        void declareUniformFloat(const std::string & uniformName, unsigned index);
 
         //
         // Matrix multiplication helpers
@@ -163,6 +172,47 @@ OCIO_NAMESPACE_ENTER
         // Get the string for multiplying a 4x4 matrix and a four-element vector
         std::string mat4fMul(const float * m4x4, const std::string & vecName) const;
         std::string mat4fMul(const double * m4x4, const std::string & vecName) const;
+        // Get the string for multiplying a 4x4 matrix variable (i.e. column-major in
+        // memory) and a four-element vector
+        std::string mat4fMul(const std::string & matName, const std::string & vecName) const;
+        // Get the keyword for declaring/using 4x4 matrices
+        std::string mat4fKeyword() const;
+
+        //
+        // Half precision helper functions
+        //
+
+        // Use the half precision types (i.e. mediump, min16float or half) in the half
+        // precision helper functions, which otherwise use the full precision ones.
+        void setHalfPrecision(bool halfPrecision);
+        bool isHalfPrecision() const { return m_halfPrecision; }
+
+        // Get the keyword for declaring/using half vectors with three elements
+        std::string vec3hKeyword() const;
+        // Get the string for creating constant half vector with three elements
+        std::string vec3hConst(double x, double y, double z) const;
+        std::string vec3hConst(double v) const;
+        std::string vec3hConst(const std::string& v) const;
+        // Get the declaration for a half vector with three elements
+        std::string vec3hDecl(const std::string& name) const;
+        // Get the string for converting a vector with three elements to half precision
+        std::string vec3hCast(const std::string& v) const;
+        // Get the string for converting a half vector with three elements to full precision
+        std::string vec3fCast(const std::string& v) const;
+
+        // Get the keyword for declaring/using half vectors with four elements
+        std::string vec4hKeyword() const;
+        // Get the string for creating constant half vector with four elements
+        std::string vec4hConst(double x, double y, double z, double w) const;
+        // Get the declaration for a half vector with four elements
+        std::string vec4hDecl(const std::string& name) const;
+        // Get the string for converting a vector with four elements to half precision
+        std::string vec4hCast(const std::string& v) const;
+        // Get the string for converting a half vector with four elements to full precision
+        std::string vec4fCast(const std::string& v) const;
+
+        // Get the string for multiplying a 4x4 half matrix and a four-element half vector
+        std::string mat4hMul(const double * m4x4, const std::string & vecName) const;
 
         //
         // Special function helpers
@@ -192,20 +242,24 @@ OCIO_NAMESPACE_ENTER
     private:
         // Shader language to use in the various shader text builder methods.
         GpuLanguage m_lang; 
-        // String stream containing the current shader text.
-        std::ostringstream m_ossText;
-
-        // In order to avoid repeated allocations of an output string stream 
-        // for multiple shader lines, create a single ostringstream instance 
-        // on the shader text and just reset it after a line has  been added 
-        // to the text. This should not pose a racing problem since we're only 
-        // creating a single line at a time for a given shader text.
+        // Buffer containing the current shader text (preallocated to avoid
+        // the reallocations while appending the lines).
+        std::string m_text;
+
+        // In order to avoid repeated allocations for multiple shader lines, 
+        // a single buffer is kept on the shader text and just reset after a 
+        // line has been added to the text. This should not pose a racing 
+        // problem since we're only creating a single line at a time for a 
+        // given shader text.
         
-        // String stream containing the current shader line.
-        std::ostringstream m_ossLine;
+        // Buffer containing the current shader line.
+        std::string m_line;
 
         // Indentation level to use for the next line.
         unsigned m_indent;
+
+        // Do the half precision helper functions use the half precision types?
+        bool m_halfPrecision;
     };
 }
 OCIO_NAMESPACE_EXIT
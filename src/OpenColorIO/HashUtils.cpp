@@ -1,29 +1,163 @@
 // SPDX-License-Identifier: BSD-3-Clause
 // Copyright Contributors to the OpenColorIO Project.
 
+#include <algorithm>
+#include <cstring>
+
 #include <OpenColorIO/OpenColorIO.h>
 
 #include "HashUtils.h"
-#include "md5/md5.h"
-
-#include <sstream>
-#include <iostream>
 
 OCIO_NAMESPACE_ENTER
 {
-    std::string CacheIDHash(const char * array, int size)
+    namespace
     {
-        md5_state_t state;
-        md5_byte_t digest[16];
-        
-        md5_init(&state);
-        md5_append(&state, (const md5_byte_t *)array, size);
-        md5_finish(&state, digest);
-        
-        return GetPrintableHash(digest);
+    const uint64_t C1 = 0x87c37b91114253d5ULL;
+    const uint64_t C2 = 0x4cf5ad432745937fULL;
+
+    inline uint64_t Rotl64(uint64_t x, int r)
+    {
+        return (x << r) | (x >> (64 - r));
+    }
+
+    inline uint64_t Load64(const uint8_t * bytes)
+    {
+        // Note that the hash reads the blocks in the little-endian order.
+        uint64_t val = 0;
+        for (int i = 7; i >= 0; --i)
+        {
+            val = (val << 8) | bytes[i];
+        }
+        return val;
+    }
+
+    inline uint64_t MixK1(uint64_t k1)
+    {
+        k1 *= C1;
+        k1  = Rotl64(k1, 31);
+        k1 *= C2;
+        return k1;
+    }
+
+    inline uint64_t MixK2(uint64_t k2)
+    {
+        k2 *= C2;
+        k2  = Rotl64(k2, 33);
+        k2 *= C1;
+        return k2;
+    }
+
+    inline uint64_t FMix64(uint64_t k)
+    {
+        k ^= k >> 33;
+        k *= 0xff51afd7ed558ccdULL;
+        k ^= k >> 33;
+        k *= 0xc4ceb9fe1a85ec53ULL;
+        k ^= k >> 33;
+        return k;
+    }
+
+    inline void ProcessBlock(const uint8_t * block, uint64_t & h1, uint64_t & h2)
+    {
+        h1 ^= MixK1(Load64(block));
+        h1  = Rotl64(h1, 27);
+        h1 += h2;
+        h1  = h1 * 5 + 0x52dce729;
+
+        h2 ^= MixK2(Load64(block + 8));
+        h2  = Rotl64(h2, 31);
+        h2 += h1;
+        h2  = h2 * 5 + 0x38495ab5;
+    }
+    }
+
+    void CacheIDHasher::update(const void * data, size_t size)
+    {
+        const uint8_t * bytes = static_cast<const uint8_t *>(data);
+
+        m_length += size;
+
+        // Complete the pending block first.
+        if (m_tailSize > 0)
+        {
+            const size_t num = std::min(sizeof(m_tail) - m_tailSize, size);
+            memcpy(m_tail + m_tailSize, bytes, num);
+            m_tailSize += num;
+            bytes      += num;
+            size       -= num;
+
+            if (m_tailSize < sizeof(m_tail))
+            {
+                return;
+            }
+
+            ProcessBlock(m_tail, m_h1, m_h2);
+            m_tailSize = 0;
+        }
+
+        for (; size >= sizeof(m_tail); bytes += sizeof(m_tail), size -= sizeof(m_tail))
+        {
+            ProcessBlock(bytes, m_h1, m_h2);
+        }
+
+        if (size > 0)
+        {
+            memcpy(m_tail, bytes, size);
+            m_tailSize = size;
+        }
+    }
+
+    void CacheIDHasher::digest(uint8_t * bytes) const
+    {
+        uint64_t h1 = m_h1;
+        uint64_t h2 = m_h2;
+
+        if (m_tailSize > 0)
+        {
+            uint8_t tail[16] = { 0 };
+            memcpy(tail, m_tail, m_tailSize);
+
+            if (m_tailSize > 8)
+            {
+                h2 ^= MixK2(Load64(tail + 8));
+            }
+            h1 ^= MixK1(Load64(tail));
+        }
+
+        h1 ^= m_length;
+        h2 ^= m_length;
+
+        h1 += h2;
+        h2 += h1;
+
+        h1 = FMix64(h1);
+        h2 = FMix64(h2);
+
+        h1 += h2;
+        h2 += h1;
+
+        for (int i = 0; i < 8; ++i)
+        {
+            bytes[i]     = uint8_t(h1 >> (8 * i));
+            bytes[i + 8] = uint8_t(h2 >> (8 * i));
+        }
+    }
+
+    std::string CacheIDHasher::digest() const
+    {
+        uint8_t bytes[16];
+        digest(bytes);
+        return GetPrintableHash(bytes);
+    }
+
+    std::string CacheIDHash(const char * array, size_t size)
+    {
+        CacheIDHasher hasher;
+        hasher.update(array, size);
+        return hasher.digest();
     }
     
-    std::string GetPrintableHash(const md5_byte_t * digest)
+    std::string GetPrintableHash(const uint8_t * digest)
     {
         static char charmap[] = "0123456789abcdef";
         
@@ -44,3 +178,41 @@ OCIO_NAMESPACE_ENTER
     }
 }
 OCIO_NAMESPACE_EXIT
+
+
+#ifdef OCIO_UNIT_TEST
+
+#include "UnitTest.h"
+
+namespace OCIO = OCIO_NAMESPACE;
+
+OCIO_ADD_TEST(HashUtils, cache_id_hash)
+{
+    // MurmurHash3 x64 128-bit reference values i.e. with a zero seed.
+    OCIO_CHECK_EQUAL(OCIO::CacheIDHash("", 0), "$00000000000000000000000000000000");
+    OCIO_CHECK_EQUAL(OCIO::CacheIDHash("hello", 5), "$20b9db143b7a8dbc91d1ea84a609e1b5");
+
+    // Appending the data in several parts gives the same digest.
+
+    std::string str;
+    for (int i = 0; i < 100; ++i)
+    {
+        str += char('a' + i % 26);
+    }
+
+    const std::string digest = OCIO::CacheIDHash(str.c_str(), str.size());
+
+    for (size_t partSize : { 1, 3, 15, 16, 17, 40 })
+    {
+        OCIO::CacheIDHasher hasher;
+        for (size_t pos = 0; pos < str.size(); pos += partSize)
+        {
+            hasher.update(str.c_str() + pos, std::min(partSize, str.size() - pos));
+        }
+        OCIO_CHECK_EQUAL(hasher.digest(), digest);
+    }
+
+    OCIO_CHECK_NE(OCIO::CacheIDHash(str.c_str(), str.size() - 1), digest);
+}
+
+#endif // OCIO_UNIT_TEST
@@ -7,17 +7,44 @@
 
 #include <OpenColorIO/OpenColorIO.h>
 
-#include "md5/md5.h"
+#include <cstddef>
+#include <cstdint>
 #include <string>
 
 OCIO_NAMESPACE_ENTER
 {
-    std::string CacheIDHash(const char * array, int size);
-    
-    // TODO: get rid of md5.h include, make this a generic byte array
-    std::string GetPrintableHash(const md5_byte_t * digest);
+    // Incremental 128-bit non-cryptographic hash (i.e. MurmurHash3 x64 128-bit) used
+    // to compute the cache identifiers. Appending the data in several update() calls
+    // gives the same digest as a single call with the concatenated data, so the cache
+    // identifiers of an op chain could be hashed without building the full string.
+    class CacheIDHasher
+    {
+    public:
+        CacheIDHasher() = default;
+
+        void update(const void * data, size_t size);
+        void update(const std::string & str) { update(str.c_str(), str.size()); }
+
+        // Get the printable digest i.e. '$' followed by 32 hexadecimal characters.
+        std::string digest() const;
+        // Get the 16 bytes of the digest.
+        void digest(uint8_t * bytes) const;
+
+    private:
+        uint64_t m_h1 = 0;
+        uint64_t m_h2 = 0;
+        uint64_t m_length = 0;
+
+        // The bytes not yet hashed i.e. the hash processes blocks of 16 bytes.
+        uint8_t m_tail[16];
+        size_t  m_tailSize = 0;
+    };
+
+    std::string CacheIDHash(const char * array, size_t size);
+
+    // Build a printable string from a 16 bytes digest.
+    std::string GetPrintableHash(const uint8_t * digest);
 }
 OCIO_NAMESPACE_EXIT
 
 #endif
-
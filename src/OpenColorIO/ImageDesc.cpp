@@ -2,6 +2,7 @@
 // Copyright Contributors to the OpenColorIO Project.
 
 #include <cstdlib>
+#include <memory>
 #include <sstream>
 
 #include <OpenColorIO/OpenColorIO.h>
@@ -41,6 +42,48 @@ OCIO_NAMESPACE_ENTER
             os << "yStrideBytes=" << planarImg->getYStrideBytes() << "";
             os << ">";
         }
+        else if(const YUVImageDesc * yuvImg = dynamic_cast<const YUVImageDesc*>(&img))
+        {
+            os << "<YUVImageDesc ";
+            os << "yData=" << yuvImg->getYData() << ", ";
+            os << "uData=" << yuvImg->getUData() << ", ";
+            os << "vData=" << yuvImg->getVData() << ", ";
+            os << "layout=" << yuvImg->getLayout() << ", ";
+            os << "matrix=" << yuvImg->getMatrix() << ", ";
+            os << "range=" << yuvImg->getRange() << ", ";
+            os << "width=" << yuvImg->getWidth() << ", ";
+            os << "height=" << yuvImg->getHeight() << ", ";
+            os << "yStrideBytes=" << yuvImg->getYStrideBytes() << ", ";
+            os << "uvStrideBytes=" << yuvImg->getUVStrideBytes() << "";
+            os << ">";
+        }
+        else if(const ScanlineImageDesc * scanlineImg = dynamic_cast<const ScanlineImageDesc*>(&img))
+        {
+            os << "<ScanlineImageDesc ";
+            os << "rRows=" << scanlineImg->getRRows() << ", ";
+            os << "gRows=" << scanlineImg->getGRows() << ", ";
+            os << "bRows=" << scanlineImg->getBRows() << ", ";
+            os << "aRows=" << scanlineImg->getARows() << ", ";
+            os << "planar=" << scanlineImg->isPlanar() << ", ";
+            os << "width=" << scanlineImg->getWidth() << ", ";
+            os << "height=" << scanlineImg->getHeight() << ", ";
+            os << "xStrideBytes=" << scanlineImg->getXStrideBytes() << "";
+            os << ">";
+        }
+        else if(const TiledImageDesc * tiledImg = dynamic_cast<const TiledImageDesc*>(&img))
+        {
+            os << "<TiledImageDesc ";
+            os << "data=" << tiledImg->getTileData(0, 0) << ", ";
+            os << "chanOrder=" << tiledImg->getChannelOrder() << ", ";
+            os << "width=" << tiledImg->getWidth() << ", ";
+            os << "height=" << tiledImg->getHeight() << ", ";
+            os << "tileWidth=" << tiledImg->getTileWidth() << ", ";
+            os << "tileHeight=" << tiledImg->getTileHeight() << ", ";
+            os << "chanStrideBytes=" << tiledImg->getChanStrideBytes() << ", ";
+            os << "xStrideBytes=" << tiledImg->getXStrideBytes() << ", ";
+            os << "tileStrideBytes=" << tiledImg->getTileStrideBytes() << "";
+            os << ">";
+        }
         else
         {
             os << "<ImageDesc ";
@@ -68,16 +111,206 @@ OCIO_NAMESPACE_ENTER
     
     }
 
+    void ImageDesc::setROI(long x, long y, long width, long height)
+    {
+        if(x<0 || y<0 || width<=0 || height<=0)
+        {
+            throw Exception("Invalid region of interest.");
+        }
+
+        m_roiX      = x;
+        m_roiY      = y;
+        m_roiWidth  = width;
+        m_roiHeight = height;
+    }
+
+    void ImageDesc::resetROI()
+    {
+        m_roiX      = 0;
+        m_roiY      = 0;
+        m_roiWidth  = 0;
+        m_roiHeight = 0;
+    }
+
+    bool ImageDesc::hasROI() const
+    {
+        return m_roiWidth>0;
+    }
+
+    long ImageDesc::getROIX() const
+    {
+        return m_roiX;
+    }
+
+    long ImageDesc::getROIY() const
+    {
+        return m_roiY;
+    }
+
+    long ImageDesc::getROIWidth() const
+    {
+        return hasROI() ? m_roiWidth : getWidth();
+    }
+
+    long ImageDesc::getROIHeight() const
+    {
+        return hasROI() ? m_roiHeight : getHeight();
+    }
+
+    void ImageDesc::setPremultiplied(bool premultiplied)
+    {
+        m_premultiplied = premultiplied;
+    }
+
+    bool ImageDesc::isPremultiplied() const
+    {
+        return m_premultiplied;
+    }
+
+    void ImageDesc::setDither(DitherMode mode)
+    {
+        m_dither = mode;
+    }
+
+    DitherMode ImageDesc::getDither() const
+    {
+        return m_dither;
+    }
+
     
     ///////////////////////////////////////////////////////////////////////////
 
 
+    namespace
+    {
+        void InitYUV(GenericYUVDesc & yuv, const YUVImageDesc & img, long width)
+        {
+            const YUVLayout layout = img.getLayout();
+
+            yuv.m_yData = reinterpret_cast<char *>(img.getYData());
+            yuv.m_uData = reinterpret_cast<char *>(img.getUData());
+            yuv.m_vData = reinterpret_cast<char *>(img.getVData());
+
+            yuv.m_yStrideBytes  = img.getYStrideBytes();
+            yuv.m_uvStrideBytes = img.getUVStrideBytes();
+
+            yuv.m_is16Bits        = layout==YUV_LAYOUT_P010;
+            yuv.m_subsampledLines = layout!=YUV_LAYOUT_I422;
+            yuv.m_codeBits        = yuv.m_is16Bits ? 10 : 8;
+            yuv.m_maxCode         = float((1 << yuv.m_codeBits) - 1);
+
+            const ptrdiff_t sampleBytes = yuv.m_is16Bits ? 2 : 1;
+            yuv.m_uvXStrideBytes = (layout==YUV_LAYOUT_NV12 || layout==YUV_LAYOUT_P010)
+                ? 2 * sampleBytes : sampleBytes;
+
+            if(img.getRange()==YUV_RANGE_FULL)
+            {
+                yuv.m_lumaOffset   = 0.0f;
+                yuv.m_lumaScale    = 1.0f / yuv.m_maxCode;
+                yuv.m_chromaOffset = float(1 << (yuv.m_codeBits - 1));
+                yuv.m_chromaScale  = 1.0f / yuv.m_maxCode;
+            }
+            else
+            {
+                // The 8-bit limited range codes are scaled for the higher bit-depths.
+                const float codeScale = float(1 << (yuv.m_codeBits - 8));
+                yuv.m_lumaOffset   = 16.0f * codeScale;
+                yuv.m_lumaScale    = 1.0f / (219.0f * codeScale);
+                yuv.m_chromaOffset = 128.0f * codeScale;
+                yuv.m_chromaScale  = 1.0f / (224.0f * codeScale);
+            }
+
+            switch(img.getMatrix())
+            {
+                case YUV_MATRIX_BT601:
+                    yuv.m_kr = 0.299f;
+                    yuv.m_kb = 0.114f;
+                    break;
+                case YUV_MATRIX_BT709:
+                    yuv.m_kr = 0.2126f;
+                    yuv.m_kb = 0.0722f;
+                    break;
+                case YUV_MATRIX_BT2020:
+                    yuv.m_kr = 0.2627f;
+                    yuv.m_kb = 0.0593f;
+                    break;
+                default:
+                    throw Exception("YUVImageDesc Error: Unknown YUV matrix.");
+            }
+
+            yuv.m_chromaSums.assign(3 * ((width + 1) / 2), 0.0f);
+        }
+    }
+
     void GenericImageDesc::init(const ImageDesc & img, BitDepth bitDepth, const ConstOpCPURcPtr & bitDepthOp)
     {
         m_bitDepthOp = bitDepthOp;
 
-        m_width  = img.getWidth();
-        m_height = img.getHeight();
+        m_rows[0] = m_rows[1] = m_rows[2] = m_rows[3] = nullptr;
+
+        if(dynamic_cast<const TiledImageDesc*>(&img))
+        {
+            throw Exception("A tiled image buffer is only supported by the "
+                            "CPUProcessor apply methods.");
+        }
+
+        if(const YUVImageDesc * yuvImg = dynamic_cast<const YUVImageDesc*>(&img))
+        {
+            // The YUV pixels are decoded to (or encoded from) normalized RGB values.
+            if(bitDepth!=BIT_DEPTH_F32)
+            {
+                throw Exception("YUV image buffers need a 32-bit float processing bit-depth.");
+            }
+
+            m_width  = img.getROIWidth();
+            m_height = img.getROIHeight();
+
+            m_xStrideBytes = img.getXStrideBytes();
+            m_yStrideBytes = img.getYStrideBytes();
+
+            m_rData = nullptr;
+            m_gData = nullptr;
+            m_bData = nullptr;
+            m_aData = nullptr;
+
+            m_isRGBAPacked = false;
+            m_isFloat      = false;
+            m_isPremultiplied = false;
+            m_dither = DITHER_NONE;
+
+            InitYUV(m_yuv, *yuvImg, m_width);
+
+            if(img.hasROI())
+            {
+                if(img.getROIX() + m_width > img.getWidth()
+                    || img.getROIY() + m_height > img.getHeight())
+                {
+                    throw Exception("The region of interest is outside of the image buffer.");
+                }
+
+                // The region must start on a chroma sample.
+                if(img.getROIX()%2!=0 || (m_yuv.m_subsampledLines && img.getROIY()%2!=0))
+                {
+                    throw Exception("The region of interest of a YUV image buffer must "
+                                    "start on a chroma sample.");
+                }
+
+                const long uvY = m_yuv.m_subsampledLines ? img.getROIY() / 2 : img.getROIY();
+                const ptrdiff_t uvOffset = (img.getROIX() / 2) * m_yuv.m_uvXStrideBytes
+                                            + uvY * m_yuv.m_uvStrideBytes;
+
+                m_yuv.m_yData += img.getROIX() * m_xStrideBytes + img.getROIY() * m_yStrideBytes;
+                m_yuv.m_uData += uvOffset;
+                m_yuv.m_vData += uvOffset;
+            }
+
+            return;
+        }
+
+        m_yuv = GenericYUVDesc();
+
+        m_width  = img.getROIWidth();
+        m_height = img.getROIHeight();
 
         m_xStrideBytes = img.getXStrideBytes();
         m_yStrideBytes = img.getYStrideBytes();
@@ -87,9 +320,58 @@ OCIO_NAMESPACE_ENTER
         m_bData = reinterpret_cast<char *>(img.getBData());
         m_aData = reinterpret_cast<char *>(img.getAData());
 
+        if(img.hasROI())
+        {
+            if(img.getROIX() + m_width > img.getWidth()
+                || img.getROIY() + m_height > img.getHeight())
+            {
+                throw Exception("The region of interest is outside of the image buffer.");
+            }
+
+            // Start at the first pixel of the region, the strides being the ones
+            // of the complete image buffer.
+            const ptrdiff_t offset = img.getROIX() * m_xStrideBytes
+                                        + img.getROIY() * m_yStrideBytes;
+
+            m_rData += offset;
+            m_gData += offset;
+            m_bData += offset;
+            if(m_aData)
+            {
+                m_aData += offset;
+            }
+        }
+
+        if(const ScanlineImageDesc * scanlineImg = dynamic_cast<const ScanlineImageDesc*>(&img))
+        {
+            // The channel pointers move from the first line of the image buffer to the first
+            // line to process, keeping their offsets in the line.
+            void * const * rows[4] = { scanlineImg->getRRows(), scanlineImg->getGRows(),
+                                       scanlineImg->getBRows(), scanlineImg->getARows() };
+            char ** data[4] = { &m_rData, &m_gData, &m_bData, &m_aData };
+
+            for(int chan=0; chan<4; ++chan)
+            {
+                if(rows[chan] && *data[chan])
+                {
+                    m_rows[chan] = rows[chan] + img.getROIY();
+                    *data[chan] = static_cast<char *>(m_rows[chan][0])
+                        + (*data[chan] - static_cast<char *>(rows[chan][0]));
+                }
+            }
+        }
+
         m_isRGBAPacked = img.isRGBAPacked();
         m_isFloat      = img.isFloat();
 
+        // Without alpha, the color values are straight.
+        m_isPremultiplied = img.isPremultiplied() && m_aData!=nullptr;
+
+        // Only the integer values are rounded.
+        m_dither  = IsFloatBitDepth(bitDepth) ? DITHER_NONE : img.getDither();
+        m_ditherX = img.getROIX();
+        m_ditherY = img.getROIY();
+
         if(img.getBitDepth()!=bitDepth)
         {
             throw Exception("Bit-depth mismatch between the image buffer and the finalization setting.");
@@ -101,6 +383,14 @@ OCIO_NAMESPACE_ENTER
         return m_isFloat && m_isRGBAPacked;
     }
 
+    bool GenericImageDesc::isPackedFloatRGB() const
+    {
+        return m_isFloat && m_aData==nullptr
+            && m_gData==m_rData + sizeof(float)
+            && m_bData==m_rData + 2 * sizeof(float)
+            && m_xStrideBytes==ptrdiff_t(3 * sizeof(float));
+    }
+
     bool GenericImageDesc::isRGBAPacked() const
     {
         return m_isRGBAPacked;
@@ -111,10 +401,49 @@ OCIO_NAMESPACE_ENTER
         return m_isFloat;
     }
 
+    bool GenericImageDesc::isYUV() const
+    {
+        return m_yuv.m_yData!=nullptr;
+    }
+
 
     ///////////////////////////////////////////////////////////////////////////
 
 
+    namespace
+    {
+        // Size in bytes of one channel value for the bit-depth.
+        ptrdiff_t GetChannelSizeInBytes(BitDepth bitDepth)
+        {
+            switch(bitDepth)
+            {
+                case BIT_DEPTH_UINT8:
+                    return sizeof(BitDepthInfo<BIT_DEPTH_UINT8>::Type);
+                case BIT_DEPTH_UINT10:
+                    return sizeof(BitDepthInfo<BIT_DEPTH_UINT10>::Type);
+                case BIT_DEPTH_UINT12:
+                    return sizeof(BitDepthInfo<BIT_DEPTH_UINT12>::Type);
+                case BIT_DEPTH_UINT14:
+                    return sizeof(BitDepthInfo<BIT_DEPTH_UINT14>::Type);
+                case BIT_DEPTH_UINT16:
+                    return sizeof(BitDepthInfo<BIT_DEPTH_UINT16>::Type);
+                case BIT_DEPTH_UINT32:
+                    return sizeof(BitDepthInfo<BIT_DEPTH_UINT32>::Type);
+                case BIT_DEPTH_F16:
+                    return sizeof(BitDepthInfo<BIT_DEPTH_F16>::Type);
+                case BIT_DEPTH_F32:
+                    return sizeof(BitDepthInfo<BIT_DEPTH_F32>::Type);
+                default:
+                {
+                    std::string err("PackedImageDesc Error: Unsupported bit-depth: ");
+                    err += BitDepthToString(bitDepth);
+                    err += ".";
+                    throw Exception(err.c_str());
+                }
+            }
+        }
+    }
+
     struct PackedImageDesc::Impl
     {
         void * m_data = nullptr;
@@ -132,6 +461,14 @@ OCIO_NAMESPACE_ENTER
         long m_height = 0;
         long m_numChannels = 0;
 
+        // Byte offsets of the color channels within a pixel when explicitly specified
+        // (i.e. the pixel could then hold other channels which are left untouched).
+        bool m_hasChannelOffsets = false;
+        ptrdiff_t m_rOffsetBytes = 0;
+        ptrdiff_t m_gOffsetBytes = 0;
+        ptrdiff_t m_bOffsetBytes = 0;
+        ptrdiff_t m_aOffsetBytes = -1;
+
         // Byte numbers computed from the bit depth.
         ptrdiff_t m_chanStrideBytes = 0;
         ptrdiff_t m_xStrideBytes = 0;
@@ -142,7 +479,14 @@ OCIO_NAMESPACE_ENTER
 
         void initValues()
         {
-            if(m_chanOrder==CHANNEL_ORDERING_RGBA
+            if(m_hasChannelOffsets)
+            {
+                m_rData = (char*)m_data + m_rOffsetBytes;
+                m_gData = (char*)m_data + m_gOffsetBytes;
+                m_bData = (char*)m_data + m_bOffsetBytes;
+                m_aData = m_aOffsetBytes>=0 ? (char*)m_data + m_aOffsetBytes : nullptr;
+            }
+            else if(m_chanOrder==CHANNEL_ORDERING_RGBA
                 || m_chanOrder==CHANNEL_ORDERING_RGB)
             {
                 m_rData = m_data;
@@ -217,6 +561,15 @@ OCIO_NAMESPACE_ENTER
                     }
                     break;
                 }
+                case BIT_DEPTH_UINT14:
+                {
+                    // Note that a 14-bit integer bit-depth value is stored in a uint16_t type.
+                    if(m_chanStrideBytes!=sizeof(BitDepthInfo<BIT_DEPTH_UINT14>::Type))
+                    {
+                        return false;
+                    }
+                    break;
+                }
                 case BIT_DEPTH_UINT16:
                 {
                     if(m_chanStrideBytes!=sizeof(BitDepthInfo<BIT_DEPTH_UINT16>::Type))
@@ -225,6 +578,14 @@ OCIO_NAMESPACE_ENTER
                     }
                     break;
                 }
+                case BIT_DEPTH_UINT32:
+                {
+                    if(m_chanStrideBytes!=sizeof(BitDepthInfo<BIT_DEPTH_UINT32>::Type))
+                    {
+                        return false;
+                    }
+                    break;
+                }
                 case BIT_DEPTH_F16:
                 {
                     // Note that a 16-bit float bit-depth value is stored in a half type.
@@ -292,7 +653,7 @@ OCIO_NAMESPACE_ENTER
                 throw Exception("PackedImageDesc Error: Invalid channel stride.");
             }
 
-            if(m_numChannels<3 || m_numChannels>4)
+            if(m_numChannels<3 || (m_numChannels>4 && !m_hasChannelOffsets))
             {
                 throw Exception("PackedImageDesc Error: Invalid channel number.");
             }
@@ -321,6 +682,38 @@ OCIO_NAMESPACE_ENTER
             {
                 throw Exception("PackedImageDesc Error: Unknown bit-depth of the image buffer.");
             }
+
+            if(m_hasChannelOffsets)
+            {
+                validateChannelOffsets();
+            }
+        }
+
+        void validateChannelOffsets() const
+        {
+            const ptrdiff_t offsets[4]
+                = { m_rOffsetBytes, m_gOffsetBytes, m_bOffsetBytes, m_aOffsetBytes };
+            const size_t numOffsets = m_aOffsetBytes>=0 ? 4 : 3;
+
+            for(size_t idx=0; idx<numOffsets; ++idx)
+            {
+                // A channel must be aligned on its type, and fit in the pixel.
+                if(offsets[idx]<0 || offsets[idx] % m_chanStrideBytes != 0
+                    || offsets[idx] + m_chanStrideBytes > m_xStrideBytes)
+                {
+                    throw Exception("PackedImageDesc Error: Invalid channel offset.");
+                }
+
+                // Two channels must not overlap.
+                for(size_t other=0; other<idx; ++other)
+                {
+                    const ptrdiff_t dist = offsets[idx] - offsets[other];
+                    if(dist > -m_chanStrideBytes && dist < m_chanStrideBytes)
+                    {
+                        throw Exception("PackedImageDesc Error: Overlapping channel offsets.");
+                    }
+                }
+            }
         }
     };
     
@@ -513,6 +906,53 @@ OCIO_NAMESPACE_ENTER
         getImpl()->validate();
     }
 
+    PackedImageDesc::PackedImageDesc(void * data,
+                                     long width, long height,
+                                     long numChannels,
+                                     BitDepth bitDepth,
+                                     ptrdiff_t rOffsetBytes,
+                                     ptrdiff_t gOffsetBytes,
+                                     ptrdiff_t bOffsetBytes,
+                                     ptrdiff_t aOffsetBytes,
+                                     ptrdiff_t xStrideBytes,
+                                     ptrdiff_t yStrideBytes)
+        :   ImageDesc()
+        ,   m_impl(new PackedImageDesc::Impl)
+    {
+        getImpl()->m_data        = data;
+        getImpl()->m_width       = width;
+        getImpl()->m_height      = height;
+        getImpl()->m_numChannels = numChannels;
+        getImpl()->m_bitDepth    = bitDepth;
+
+        getImpl()->m_hasChannelOffsets = true;
+        getImpl()->m_rOffsetBytes      = rOffsetBytes;
+        getImpl()->m_gOffsetBytes      = gOffsetBytes;
+        getImpl()->m_bOffsetBytes      = bOffsetBytes;
+        getImpl()->m_aOffsetBytes      = aOffsetBytes<0 ? -1 : aOffsetBytes;
+
+        getImpl()->m_chanOrder = aOffsetBytes<0 ? CHANNEL_ORDERING_RGB : CHANNEL_ORDERING_RGBA;
+
+        if(numChannels<(aOffsetBytes<0 ? 3 : 4))
+        {
+            throw Exception("PackedImageDesc Error: Invalid number of channels.");
+        }
+
+        getImpl()->m_chanStrideBytes = GetChannelSizeInBytes(bitDepth);
+
+        getImpl()->m_xStrideBytes = (xStrideBytes == AutoStride)
+            ? getImpl()->m_chanStrideBytes * getImpl()->m_numChannels : xStrideBytes;
+        getImpl()->m_yStrideBytes = (yStrideBytes == AutoStride)
+            ? getImpl()->m_xStrideBytes * width : yStrideBytes;
+
+        getImpl()->initValues();
+
+        getImpl()->m_isRGBAPacked = getImpl()->isRGBAPacked();
+        getImpl()->m_isFloat      = getImpl()->isFloat();
+
+        getImpl()->validate();
+    }
+
     PackedImageDesc::~PackedImageDesc()
     {
         delete m_impl;
@@ -782,5 +1222,692 @@ OCIO_NAMESPACE_ENTER
     {
         return getImpl()->m_isFloat;
     }
+    
+    ///////////////////////////////////////////////////////////////////////////
+    
+    
+    
+    struct YUVImageDesc::Impl
+    {
+        void * m_yData = nullptr;
+        void * m_uData = nullptr;
+        void * m_vData = nullptr;
+
+        YUVLayout m_layout = YUV_LAYOUT_I420;
+        YUVMatrix m_matrix = YUV_MATRIX_BT709;
+        YUVRange  m_range  = YUV_RANGE_LIMITED;
+
+        long m_width = 0;
+        long m_height = 0;
+
+        ptrdiff_t m_yStrideBytes = 0;
+        ptrdiff_t m_uvStrideBytes = 0;
+
+        // Size in bytes of one sample.
+        ptrdiff_t sampleBytes() const
+        {
+            return m_layout==YUV_LAYOUT_P010 ? 2 : 1;
+        }
+
+        bool isSemiPlanar() const
+        {
+            return m_layout==YUV_LAYOUT_NV12 || m_layout==YUV_LAYOUT_P010;
+        }
+
+        void init(void * yData, void * uData, void * vData,
+                  long width, long height,
+                  YUVLayout layout, YUVMatrix matrix, YUVRange range,
+                  ptrdiff_t yStrideBytes, ptrdiff_t uvStrideBytes)
+        {
+            if(layout!=YUV_LAYOUT_I420 && layout!=YUV_LAYOUT_I422
+                && layout!=YUV_LAYOUT_NV12 && layout!=YUV_LAYOUT_P010)
+            {
+                throw Exception("YUVImageDesc Error: Unknown YUV layout.");
+            }
+
+            if(matrix!=YUV_MATRIX_BT601 && matrix!=YUV_MATRIX_BT709 && matrix!=YUV_MATRIX_BT2020)
+            {
+                throw Exception("YUVImageDesc Error: Unknown YUV matrix.");
+            }
+
+            if(range!=YUV_RANGE_LIMITED && range!=YUV_RANGE_FULL)
+            {
+                throw Exception("YUVImageDesc Error: Unknown YUV range.");
+            }
+
+            m_layout = layout;
+            m_matrix = matrix;
+            m_range  = range;
+
+            if(yData==nullptr || uData==nullptr
+                || (isSemiPlanar() ? vData!=nullptr : vData==nullptr))
+            {
+                throw Exception("YUVImageDesc Error: Invalid image buffer.");
+            }
+
+            if(width<=0 || height<=0)
+            {
+                throw Exception("YUVImageDesc Error: Invalid image dimensions.");
+            }
+
+            m_yData = yData;
+            m_uData = uData;
+            // The Cr samples follow the Cb ones in the interleaved UV plane.
+            m_vData = isSemiPlanar() ? (char*)uData + sampleBytes() : vData;
+
+            m_width  = width;
+            m_height = height;
+
+            // The chroma samples of a line.
+            const ptrdiff_t uvLineBytes
+                = ((width + 1) / 2) * sampleBytes() * (isSemiPlanar() ? 2 : 1);
+
+            m_yStrideBytes  = (yStrideBytes == AutoStride)
+                ? width * sampleBytes() : yStrideBytes;
+            m_uvStrideBytes = (uvStrideBytes == AutoStride) ? uvLineBytes : uvStrideBytes;
+
+            if(m_yStrideBytes<width * sampleBytes())
+            {
+                throw Exception("YUVImageDesc Error: Invalid luma stride.");
+            }
+
+            if(m_uvStrideBytes<uvLineBytes)
+            {
+                throw Exception("YUVImageDesc Error: Invalid chroma stride.");
+            }
+        }
+    };
+    
+    YUVImageDesc::YUVImageDesc(void * yData, void * uData, void * vData,
+                               long width, long height,
+                               YUVLayout layout,
+                               YUVMatrix matrix,
+                               YUVRange range)
+        :   ImageDesc()
+        ,   m_impl(new YUVImageDesc::Impl())
+    {
+        getImpl()->init(yData, uData, vData, width, height, layout, matrix, range,
+                        AutoStride, AutoStride);
+    }
+
+    YUVImageDesc::YUVImageDesc(void * yData, void * uData, void * vData,
+                               long width, long height,
+                               YUVLayout layout,
+                               YUVMatrix matrix,
+                               YUVRange range,
+                               ptrdiff_t yStrideBytes,
+                               ptrdiff_t uvStrideBytes)
+        :   ImageDesc()
+        ,   m_impl(new YUVImageDesc::Impl())
+    {
+        getImpl()->init(yData, uData, vData, width, height, layout, matrix, range,
+                        yStrideBytes, uvStrideBytes);
+    }
+
+    YUVImageDesc::~YUVImageDesc()
+    {
+        delete m_impl;
+        m_impl = nullptr;
+    }
+
+    YUVLayout YUVImageDesc::getLayout() const
+    {
+        return getImpl()->m_layout;
+    }
+
+    YUVMatrix YUVImageDesc::getMatrix() const
+    {
+        return getImpl()->m_matrix;
+    }
+
+    YUVRange YUVImageDesc::getRange() const
+    {
+        return getImpl()->m_range;
+    }
+
+    void * YUVImageDesc::getYData() const
+    {
+        return getImpl()->m_yData;
+    }
+
+    void * YUVImageDesc::getUData() const
+    {
+        return getImpl()->m_uData;
+    }
+
+    void * YUVImageDesc::getVData() const
+    {
+        return getImpl()->m_vData;
+    }
+
+    ptrdiff_t YUVImageDesc::getUVStrideBytes() const
+    {
+        return getImpl()->m_uvStrideBytes;
+    }
+
+    void * YUVImageDesc::getRData() const
+    {
+        return nullptr;
+    }
+
+    void * YUVImageDesc::getGData() const
+    {
+        return nullptr;
+    }
+
+    void * YUVImageDesc::getBData() const
+    {
+        return nullptr;
+    }
+
+    void * YUVImageDesc::getAData() const
+    {
+        return nullptr;
+    }
+
+    BitDepth YUVImageDesc::getBitDepth() const
+    {
+        return getImpl()->m_layout==YUV_LAYOUT_P010 ? BIT_DEPTH_UINT16 : BIT_DEPTH_UINT8;
+    }
+
+    long YUVImageDesc::getWidth() const
+    {
+        return getImpl()->m_width;
+    }
+
+    long YUVImageDesc::getHeight() const
+    {
+        return getImpl()->m_height;
+    }
+
+    ptrdiff_t YUVImageDesc::getXStrideBytes() const
+    {
+        return getImpl()->sampleBytes();
+    }
+
+    ptrdiff_t YUVImageDesc::getYStrideBytes() const
+    {
+        return getImpl()->m_yStrideBytes;
+    }
+
+    bool YUVImageDesc::isRGBAPacked() const
+    {
+        return false;
+    }
+
+    bool YUVImageDesc::isFloat() const
+    {
+        return false;
+    }
+    
+    ///////////////////////////////////////////////////////////////////////////
+    
+    
+    
+    struct ScanlineImageDesc::Impl
+    {
+        // The description of the first line, which validates the channels & the strides
+        // which are the same for all the lines.
+        std::unique_ptr<ImageDesc> m_line;
+
+        void * const * m_rRows = nullptr;
+        void * const * m_gRows = nullptr;
+        void * const * m_bRows = nullptr;
+        void * const * m_aRows = nullptr;
+
+        long m_height = 0;
+
+        bool m_isPlanar = false;
+
+        void validateRows(void * const * rows, long height) const
+        {
+            if(rows==nullptr)
+            {
+                throw Exception("ScanlineImageDesc Error: Invalid image buffer.");
+            }
+
+            for(long y=0; y<height; ++y)
+            {
+                if(rows[y]==nullptr)
+                {
+                    throw Exception("ScanlineImageDesc Error: Invalid line pointer.");
+                }
+            }
+        }
+
+        void initPacked(void * const * rows,
+                        long width, long height,
+                        ChannelOrdering chanOrder,
+                        BitDepth bitDepth,
+                        ptrdiff_t chanStrideBytes,
+                        ptrdiff_t xStrideBytes)
+        {
+            if(width<=0 || height<=0)
+            {
+                throw Exception("ScanlineImageDesc Error: Invalid image dimensions.");
+            }
+
+            validateRows(rows, height);
+
+            m_line.reset(new PackedImageDesc(rows[0], width, 1, chanOrder, bitDepth,
+                                             chanStrideBytes, xStrideBytes, AutoStride));
+
+            m_rRows = rows;
+            m_gRows = rows;
+            m_bRows = rows;
+            m_aRows = m_line->getAData() ? rows : nullptr;
+
+            m_height   = height;
+            m_isPlanar = false;
+        }
+
+        void initPlanar(void * const * rRows, void * const * gRows,
+                        void * const * bRows, void * const * aRows,
+                        long width, long height,
+                        BitDepth bitDepth,
+                        ptrdiff_t xStrideBytes)
+        {
+            if(width<=0 || height<=0)
+            {
+                throw Exception("ScanlineImageDesc Error: Invalid image dimensions.");
+            }
+
+            validateRows(rRows, height);
+            validateRows(gRows, height);
+            validateRows(bRows, height);
+            if(aRows)
+            {
+                validateRows(aRows, height);
+            }
+
+            m_line.reset(new PlanarImageDesc(rRows[0], gRows[0], bRows[0],
+                                             aRows ? aRows[0] : nullptr,
+                                             width, 1, bitDepth, xStrideBytes, AutoStride));
+
+            m_rRows = rRows;
+            m_gRows = gRows;
+            m_bRows = bRows;
+            m_aRows = aRows;
+
+            m_height   = height;
+            m_isPlanar = true;
+        }
+    };
+
+    ScanlineImageDesc::ScanlineImageDesc(void * const * rows,
+                                         long width, long height,
+                                         ChannelOrdering chanOrder)
+        :   ImageDesc()
+        ,   m_impl(new ScanlineImageDesc::Impl())
+    {
+        getImpl()->initPacked(rows, width, height, chanOrder,
+                              BIT_DEPTH_F32, AutoStride, AutoStride);
+    }
+
+    ScanlineImageDesc::ScanlineImageDesc(void * const * rows,
+                                         long width, long height,
+                                         ChannelOrdering chanOrder,
+                                         BitDepth bitDepth,
+                                         ptrdiff_t chanStrideBytes,
+                                         ptrdiff_t xStrideBytes)
+        :   ImageDesc()
+        ,   m_impl(new ScanlineImageDesc::Impl())
+    {
+        getImpl()->initPacked(rows, width, height, chanOrder,
+                              bitDepth, chanStrideBytes, xStrideBytes);
+    }
+
+    ScanlineImageDesc::ScanlineImageDesc(void * const * rRows, void * const * gRows,
+                                         void * const * bRows, void * const * aRows,
+                                         long width, long height)
+        :   ImageDesc()
+        ,   m_impl(new ScanlineImageDesc::Impl())
+    {
+        getImpl()->initPlanar(rRows, gRows, bRows, aRows, width, height,
+                              BIT_DEPTH_F32, AutoStride);
+    }
+
+    ScanlineImageDesc::ScanlineImageDesc(void * const * rRows, void * const * gRows,
+                                         void * const * bRows, void * const * aRows,
+                                         long width, long height,
+                                         BitDepth bitDepth,
+                                         ptrdiff_t xStrideBytes)
+        :   ImageDesc()
+        ,   m_impl(new ScanlineImageDesc::Impl())
+    {
+        getImpl()->initPlanar(rRows, gRows, bRows, aRows, width, height,
+                              bitDepth, xStrideBytes);
+    }
+
+    ScanlineImageDesc::~ScanlineImageDesc()
+    {
+        delete m_impl;
+        m_impl = nullptr;
+    }
+
+    bool ScanlineImageDesc::isPlanar() const
+    {
+        return getImpl()->m_isPlanar;
+    }
+
+    void * const * ScanlineImageDesc::getRRows() const
+    {
+        return getImpl()->m_rRows;
+    }
+
+    void * const * ScanlineImageDesc::getGRows() const
+    {
+        return getImpl()->m_gRows;
+    }
+
+    void * const * ScanlineImageDesc::getBRows() const
+    {
+        return getImpl()->m_bRows;
+    }
+
+    void * const * ScanlineImageDesc::getARows() const
+    {
+        return getImpl()->m_aRows;
+    }
+
+    void * ScanlineImageDesc::getRData() const
+    {
+        return getImpl()->m_line->getRData();
+    }
+
+    void * ScanlineImageDesc::getGData() const
+    {
+        return getImpl()->m_line->getGData();
+    }
+
+    void * ScanlineImageDesc::getBData() const
+    {
+        return getImpl()->m_line->getBData();
+    }
+
+    void * ScanlineImageDesc::getAData() const
+    {
+        return getImpl()->m_line->getAData();
+    }
+
+    BitDepth ScanlineImageDesc::getBitDepth() const
+    {
+        return getImpl()->m_line->getBitDepth();
+    }
+
+    long ScanlineImageDesc::getWidth() const
+    {
+        return getImpl()->m_line->getWidth();
+    }
+
+    long ScanlineImageDesc::getHeight() const
+    {
+        return getImpl()->m_height;
+    }
+
+    ptrdiff_t ScanlineImageDesc::getXStrideBytes() const
+    {
+        return getImpl()->m_line->getXStrideBytes();
+    }
+
+    ptrdiff_t ScanlineImageDesc::getYStrideBytes() const
+    {
+        return 0;
+    }
+
+    bool ScanlineImageDesc::isRGBAPacked() const
+    {
+        return getImpl()->m_line->isRGBAPacked();
+    }
+
+    bool ScanlineImageDesc::isFloat() const
+    {
+        return getImpl()->m_line->isFloat();
+    }
+    
+    ///////////////////////////////////////////////////////////////////////////
+    
+    
+    
+    struct TiledImageDesc::Impl
+    {
+        // The description of the first tile, which validates the channels & the strides
+        // which are the same for all the tiles.
+        std::unique_ptr<PackedImageDesc> m_tile;
+
+        void * m_data = nullptr;
+        void * const * m_tiles = nullptr;
+
+        long m_width = 0;
+        long m_height = 0;
+        long m_tileWidth = 0;
+        long m_tileHeight = 0;
+        long m_numTilesX = 0;
+        long m_numTilesY = 0;
+
+        ptrdiff_t m_tileStrideBytes = 0;
+
+        void init(void * data, void * const * tiles,
+                  long width, long height,
+                  long tileWidth, long tileHeight,
+                  ChannelOrdering chanOrder,
+                  BitDepth bitDepth,
+                  ptrdiff_t chanStrideBytes,
+                  ptrdiff_t xStrideBytes,
+                  ptrdiff_t tileStrideBytes)
+        {
+            if(width<=0 || height<=0)
+            {
+                throw Exception("TiledImageDesc Error: Invalid image dimensions.");
+            }
+
+            if(tileWidth<=0 || tileHeight<=0)
+            {
+                throw Exception("TiledImageDesc Error: Invalid tile dimensions.");
+            }
+
+            m_width      = width;
+            m_height     = height;
+            m_tileWidth  = tileWidth;
+            m_tileHeight = tileHeight;
+            m_numTilesX  = (width + tileWidth - 1) / tileWidth;
+            m_numTilesY  = (height + tileHeight - 1) / tileHeight;
+
+            if(tiles)
+            {
+                for(long idx=0; idx<m_numTilesX*m_numTilesY; ++idx)
+                {
+                    if(tiles[idx]==nullptr)
+                    {
+                        throw Exception("TiledImageDesc Error: Invalid tile pointer.");
+                    }
+                }
+                data = tiles[0];
+            }
+            else if(data==nullptr)
+            {
+                throw Exception("TiledImageDesc Error: Invalid image buffer.");
+            }
+
+            m_tile.reset(new PackedImageDesc(data, tileWidth, tileHeight, chanOrder, bitDepth,
+                                             chanStrideBytes, xStrideBytes, AutoStride));
+
+            m_data  = data;
+            m_tiles = tiles;
+
+            const ptrdiff_t tileBytes = m_tile->getYStrideBytes() * tileHeight;
+
+            if(tiles)
+            {
+                m_tileStrideBytes = 0;
+            }
+            else
+            {
+                m_tileStrideBytes
+                    = (tileStrideBytes == AutoStride) ? tileBytes : tileStrideBytes;
+
+                if(m_tileStrideBytes<tileBytes)
+                {
+                    throw Exception("TiledImageDesc Error: Invalid tile stride.");
+                }
+            }
+        }
+    };
+
+    TiledImageDesc::TiledImageDesc(void * data,
+                                   long width, long height,
+                                   long tileWidth, long tileHeight,
+                                   ChannelOrdering chanOrder)
+        :   ImageDesc()
+        ,   m_impl(new TiledImageDesc::Impl())
+    {
+        getImpl()->init(data, nullptr, width, height, tileWidth, tileHeight, chanOrder,
+                        BIT_DEPTH_F32, AutoStride, AutoStride, AutoStride);
+    }
+
+    TiledImageDesc::TiledImageDesc(void * data,
+                                   long width, long height,
+                                   long tileWidth, long tileHeight,
+                                   ChannelOrdering chanOrder,
+                                   BitDepth bitDepth,
+                                   ptrdiff_t chanStrideBytes,
+                                   ptrdiff_t xStrideBytes,
+                                   ptrdiff_t tileStrideBytes)
+        :   ImageDesc()
+        ,   m_impl(new TiledImageDesc::Impl())
+    {
+        getImpl()->init(data, nullptr, width, height, tileWidth, tileHeight, chanOrder,
+                        bitDepth, chanStrideBytes, xStrideBytes, tileStrideBytes);
+    }
+
+    TiledImageDesc::TiledImageDesc(void * const * tiles,
+                                   long width, long height,
+                                   long tileWidth, long tileHeight,
+                                   ChannelOrdering chanOrder,
+                                   BitDepth bitDepth,
+                                   ptrdiff_t chanStrideBytes,
+                                   ptrdiff_t xStrideBytes)
+        :   ImageDesc()
+        ,   m_impl(new TiledImageDesc::Impl())
+    {
+        if(tiles==nullptr)
+        {
+            throw Exception("TiledImageDesc Error: Invalid image buffer.");
+        }
+
+        getImpl()->init(nullptr, tiles, width, height, tileWidth, tileHeight, chanOrder,
+                        bitDepth, chanStrideBytes, xStrideBytes, AutoStride);
+    }
+
+    TiledImageDesc::~TiledImageDesc()
+    {
+        delete m_impl;
+        m_impl = nullptr;
+    }
+
+    ChannelOrdering TiledImageDesc::getChannelOrder() const
+    {
+        return getImpl()->m_tile->getChannelOrder();
+    }
+
+    long TiledImageDesc::getTileWidth() const
+    {
+        return getImpl()->m_tileWidth;
+    }
+
+    long TiledImageDesc::getTileHeight() const
+    {
+        return getImpl()->m_tileHeight;
+    }
+
+    long TiledImageDesc::getNumTilesX() const
+    {
+        return getImpl()->m_numTilesX;
+    }
+
+    long TiledImageDesc::getNumTilesY() const
+    {
+        return getImpl()->m_numTilesY;
+    }
+
+    ptrdiff_t TiledImageDesc::getTileStrideBytes() const
+    {
+        return getImpl()->m_tileStrideBytes;
+    }
+
+    void * TiledImageDesc::getTileData(long tileX, long tileY) const
+    {
+        if(tileX<0 || tileX>=getImpl()->m_numTilesX || tileY<0 || tileY>=getImpl()->m_numTilesY)
+        {
+            throw Exception("TiledImageDesc Error: Invalid tile index.");
+        }
+
+        const long idx = tileY * getImpl()->m_numTilesX + tileX;
+        if(getImpl()->m_tiles)
+        {
+            return getImpl()->m_tiles[idx];
+        }
+        return (char*)getImpl()->m_data + getImpl()->m_tileStrideBytes * idx;
+    }
+
+    ptrdiff_t TiledImageDesc::getChanStrideBytes() const
+    {
+        return getImpl()->m_tile->getChanStrideBytes();
+    }
+
+    void * TiledImageDesc::getRData() const
+    {
+        return getImpl()->m_tile->getRData();
+    }
+
+    void * TiledImageDesc::getGData() const
+    {
+        return getImpl()->m_tile->getGData();
+    }
+
+    void * TiledImageDesc::getBData() const
+    {
+        return getImpl()->m_tile->getBData();
+    }
+
+    void * TiledImageDesc::getAData() const
+    {
+        return getImpl()->m_tile->getAData();
+    }
+
+    BitDepth TiledImageDesc::getBitDepth() const
+    {
+        return getImpl()->m_tile->getBitDepth();
+    }
+
+    long TiledImageDesc::getWidth() const
+    {
+        return getImpl()->m_width;
+    }
+
+    long TiledImageDesc::getHeight() const
+    {
+        return getImpl()->m_height;
+    }
+
+    ptrdiff_t TiledImageDesc::getXStrideBytes() const
+    {
+        return getImpl()->m_tile->getXStrideBytes();
+    }
+
+    ptrdiff_t TiledImageDesc::getYStrideBytes() const
+    {
+        return getImpl()->m_tile->getYStrideBytes();
+    }
+
+    bool TiledImageDesc::isRGBAPacked() const
+    {
+        return getImpl()->m_tile->isRGBAPacked();
+    }
+
+    bool TiledImageDesc::isFloat() const
+    {
+        return getImpl()->m_tile->isFloat();
+    }
 }
 OCIO_NAMESPACE_EXIT
@@ -1,6 +1,7 @@
 // SPDX-License-Identifier: BSD-3-Clause
 // Copyright Contributors to the OpenColorIO Project.
 
+#include <algorithm>
 #include <sstream>
 #include <iostream>
 #include <cassert>
@@ -11,12 +12,286 @@
 #include <OpenColorIO/OpenColorIO.h>
 
 #include "BitDepthUtils.h"
+#include "CPUInfo.h"
 #include "ImagePacking.h"
 
+#if defined(USE_SSE)
+#include <emmintrin.h>
+#endif
+
+#if defined(OCIO_USE_AVX)
+#include <immintrin.h>
+#endif
+
 
 OCIO_NAMESPACE_ENTER
 {
 
+namespace
+{
+
+#if defined(OCIO_USE_AVX)
+
+// Return the first byte of the first pixel, and the position (i.e. from 0 to 3) of the R, G,
+// B & A channels in the pixels, if the pixels are only made of the four channels (i.e. in any
+// order, and without padding), or null otherwise.
+char * GetChannelPositions(const GenericImageDesc & img, size_t chanSizeBytes,
+                           size_t positions[4])
+{
+    if(!img.m_aData || img.m_xStrideBytes!=ptrdiff_t(4 * chanSizeBytes))
+    {
+        return nullptr;
+    }
+
+    char * chans[4] = { img.m_rData, img.m_gData, img.m_bData, img.m_aData };
+    char * first = *std::min_element(chans, chans + 4);
+
+    // Each channel must be at a distinct position inside the pixel.
+    bool used[4] = { false, false, false, false };
+    for(size_t idx=0; idx<4; ++idx)
+    {
+        const ptrdiff_t offset = chans[idx] - first;
+        if(offset % chanSizeBytes !=0 || size_t(offset / chanSizeBytes)>=4
+            || used[offset / chanSizeBytes])
+        {
+            return nullptr;
+        }
+        positions[idx] = size_t(offset / chanSizeBytes);
+        used[positions[idx]] = true;
+    }
+
+    return first;
+}
+
+// Apply the same byte permutation to each block of 16 bytes i.e. 'shuffle' gives the index
+// in the input block of each byte of the output block. Note that all the bit-depths have
+// a whole number of pixels per block.
+OCIO_TARGET_AVX2
+void ShuffleBytesAVX2(const char * in, char * out, size_t numBytes, const uint8_t * shuffle)
+{
+    const __m256i mask = _mm256_broadcastsi128_si256(
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(shuffle)));
+
+    size_t idx = 0;
+    for(; idx + 32 <= numBytes; idx += 32)
+    {
+        const __m256i pixels = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(in + idx));
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + idx),
+                            _mm256_shuffle_epi8(pixels, mask));
+    }
+
+    // The remaining pixels.
+    for(; idx < numBytes; ++idx)
+    {
+        out[idx] = in[idx - idx % 16 + shuffle[idx % 16]];
+    }
+}
+
+// Pack the pixels of a four channel image in any channel ordering (refer to
+// GetChannelPositions()) to a RGBA buffer of the same bit-depth, or unpack them, by
+// shuffling their bytes. Return false if the image layout (or the CPU) does not allow it.
+bool ShuffleRGBA(const GenericImageDesc & img, size_t chanSizeBytes, long imagePixelStartIndex,
+                 long numPixels, char * rgbaBuffer, bool pack)
+{
+    if(!CPUInfo::Instance().hasAVX2())
+    {
+        return false;
+    }
+
+    size_t positions[4];
+    char * first = GetChannelPositions(img, chanSizeBytes, positions);
+    if(!first)
+    {
+        return false;
+    }
+
+    const size_t pixelBytes = 4 * chanSizeBytes;
+
+    uint8_t shuffle[16];
+    for(size_t pixel=0; pixel<16; pixel+=pixelBytes)
+    {
+        for(size_t chan=0; chan<4; ++chan)
+        {
+            for(size_t byte=0; byte<chanSizeBytes; ++byte)
+            {
+                const size_t rgbaIdx = pixel + chan * chanSizeBytes + byte;
+                const size_t imgIdx  = pixel + positions[chan] * chanSizeBytes + byte;
+
+                if(pack)
+                {
+                    shuffle[rgbaIdx] = uint8_t(imgIdx);
+                }
+                else
+                {
+                    shuffle[imgIdx] = uint8_t(rgbaIdx);
+                }
+            }
+        }
+    }
+
+    char * pixels = img.getLineData(first, 0, imagePixelStartIndex / img.m_width)
+                          + img.m_xStrideBytes * (imagePixelStartIndex % img.m_width);
+
+    const size_t numBytes = size_t(numPixels) * pixelBytes;
+    if(pack)
+    {
+        ShuffleBytesAVX2(pixels, rgbaBuffer, numBytes, shuffle);
+    }
+    else
+    {
+        ShuffleBytesAVX2(rgbaBuffer, pixels, numBytes, shuffle);
+    }
+
+    return true;
+}
+
+#endif // OCIO_USE_AVX
+
+// The coefficients of the YCbCr to RGB conversion i.e. R = Y + crToR * Cr,
+// G = Y + cbToG * Cb + crToG * Cr, and B = Y + cbToB * Cb.
+struct YUVCoefs
+{
+    explicit YUVCoefs(const GenericYUVDesc & yuv)
+        :   kr(yuv.m_kr)
+        ,   kg(1.0f - yuv.m_kr - yuv.m_kb)
+        ,   kb(yuv.m_kb)
+        ,   crToR(2.0f * (1.0f - yuv.m_kr))
+        ,   cbToB(2.0f * (1.0f - yuv.m_kb))
+        ,   cbToG(-cbToB * kb / kg)
+        ,   crToG(-crToR * kr / kg)
+    {
+    }
+
+    const float kr;
+    const float kg;
+    const float kb;
+    const float crToR;
+    const float cbToB;
+    const float cbToG;
+    const float crToG;
+};
+
+inline float ReadYUVCode(const GenericYUVDesc & yuv, const char * sample)
+{
+    if(yuv.m_is16Bits)
+    {
+        return float(*reinterpret_cast<const uint16_t *>(sample) >> (16 - yuv.m_codeBits));
+    }
+    return float(*reinterpret_cast<const uint8_t *>(sample));
+}
+
+inline void WriteYUVCode(const GenericYUVDesc & yuv, char * sample, float code)
+{
+    // Note that the NaN values give the zero code.
+    const unsigned value = unsigned(std::max(0.0f, std::min(code, yuv.m_maxCode)) + 0.5f);
+
+    if(yuv.m_is16Bits)
+    {
+        *reinterpret_cast<uint16_t *>(sample) = uint16_t(value << (16 - yuv.m_codeBits));
+    }
+    else
+    {
+        *reinterpret_cast<uint8_t *>(sample) = uint8_t(value);
+    }
+}
+
+// Decode the pixels of a line to RGBA i.e. the chroma samples being replicated, and the
+// alpha being zero.
+void DecodeYUV(const GenericYUVDesc & yuv, long yIndex, long xIndex,
+               int numPixels, float * rgbaBuffer)
+{
+    const YUVCoefs coefs(yuv);
+
+    const ptrdiff_t sampleBytes = yuv.m_is16Bits ? 2 : 1;
+    const long uvIndex = yuv.m_subsampledLines ? yIndex / 2 : yIndex;
+
+    const char * yRow = yuv.m_yData + yuv.m_yStrideBytes * yIndex;
+    const char * uRow = yuv.m_uData + yuv.m_uvStrideBytes * uvIndex;
+    const char * vRow = yuv.m_vData + yuv.m_uvStrideBytes * uvIndex;
+
+    for(int idx=0; idx<numPixels; ++idx, ++xIndex)
+    {
+        const ptrdiff_t uvOffset = (xIndex / 2) * yuv.m_uvXStrideBytes;
+
+        const float luma = (ReadYUVCode(yuv, yRow + xIndex * sampleBytes) - yuv.m_lumaOffset)
+                            * yuv.m_lumaScale;
+        const float cb = (ReadYUVCode(yuv, uRow + uvOffset) - yuv.m_chromaOffset)
+                            * yuv.m_chromaScale;
+        const float cr = (ReadYUVCode(yuv, vRow + uvOffset) - yuv.m_chromaOffset)
+                            * yuv.m_chromaScale;
+
+        rgbaBuffer[4*idx+0] = luma + coefs.crToR * cr;
+        rgbaBuffer[4*idx+1] = luma + coefs.cbToG * cb + coefs.crToG * cr;
+        rgbaBuffer[4*idx+2] = luma + coefs.cbToB * cb;
+        rgbaBuffer[4*idx+3] = 0.0f;
+    }
+}
+
+// Encode the pixels of a line from RGBA. A chroma sample is the average of the pixels
+// sharing it, and is written once its last pixel is encoded. Note that the lines sharing
+// the chroma samples must then be processed in order, and by the same helper.
+void EncodeYUV(GenericYUVDesc & yuv, long width, long height, long yIndex, long xIndex,
+               int numPixels, const float * rgbaBuffer)
+{
+    const YUVCoefs coefs(yuv);
+
+    const ptrdiff_t sampleBytes = yuv.m_is16Bits ? 2 : 1;
+    const long uvIndex = yuv.m_subsampledLines ? yIndex / 2 : yIndex;
+
+    char * yRow = yuv.m_yData + yuv.m_yStrideBytes * yIndex;
+    char * uRow = yuv.m_uData + yuv.m_uvStrideBytes * uvIndex;
+    char * vRow = yuv.m_vData + yuv.m_uvStrideBytes * uvIndex;
+
+    const bool lastLine = !yuv.m_subsampledLines || yIndex % 2 == 1 || yIndex == height - 1;
+
+    const float invLumaScale   = 1.0f / yuv.m_lumaScale;
+    const float invChromaScale = 1.0f / yuv.m_chromaScale;
+    const float invCbToB       = 1.0f / coefs.cbToB;
+    const float invCrToR       = 1.0f / coefs.crToR;
+
+    for(int idx=0; idx<numPixels; ++idx, ++xIndex)
+    {
+        const float r = rgbaBuffer[4*idx+0];
+        const float g = rgbaBuffer[4*idx+1];
+        const float b = rgbaBuffer[4*idx+2];
+
+        const float luma = coefs.kr * r + coefs.kg * g + coefs.kb * b;
+        WriteYUVCode(yuv, yRow + xIndex * sampleBytes, luma * invLumaScale + yuv.m_lumaOffset);
+
+        float * sums = &yuv.m_chromaSums[3 * (xIndex / 2)];
+        sums[0] += (b - luma) * invCbToB;
+        sums[1] += (r - luma) * invCrToR;
+        sums[2] += 1.0f;
+
+        if(lastLine && (xIndex % 2 == 1 || xIndex == width - 1))
+        {
+            const ptrdiff_t uvOffset = (xIndex / 2) * yuv.m_uvXStrideBytes;
+            const float scale = invChromaScale / sums[2];
+
+            WriteYUVCode(yuv, uRow + uvOffset, sums[0] * scale + yuv.m_chromaOffset);
+            WriteYUVCode(yuv, vRow + uvOffset, sums[1] * scale + yuv.m_chromaOffset);
+
+            sums[0] = 0.0f;
+            sums[1] = 0.0f;
+            sums[2] = 0.0f;
+        }
+    }
+}
+
+}
+
+bool CanShuffleRGBA(const GenericImageDesc & img, size_t chanSizeBytes)
+{
+#if defined(OCIO_USE_AVX)
+    size_t positions[4];
+    return CPUInfo::Instance().hasAVX2()
+        && GetChannelPositions(img, chanSizeBytes, positions)!=nullptr;
+#else
+    (void)img;
+    (void)chanSizeBytes;
+    return false;
+#endif
+}
 
 template<typename Type>
 void Generic<Type>::PackRGBAFromImageDesc(const GenericImageDesc & srcImg,
@@ -39,16 +314,24 @@ void Generic<Type>::PackRGBAFromImageDesc(const GenericImageDesc & srcImg,
         throw Exception("Invalid output image position.");
     }
 
+#if defined(OCIO_USE_AVX)
+    if(ShuffleRGBA(srcImg, sizeof(Type), imagePixelStartIndex, outputBufferSize,
+                   reinterpret_cast<char *>(inBitDepthBuffer), true))
+    {
+        srcImg.m_bitDepthOp->apply(&inBitDepthBuffer[0], outputBuffer, outputBufferSize);
+        return;
+    }
+#endif
+
     const ptrdiff_t xStrideBytes = srcImg.m_xStrideBytes;
-    const ptrdiff_t yStrideBytes = srcImg.m_yStrideBytes;
 
     const long yIndex = imagePixelStartIndex / imgWidth;
     long xIndex = imagePixelStartIndex % imgWidth;
 
     // Figure out our initial ptr positions
-    char * rRow = srcImg.m_rData + yStrideBytes * yIndex;
-    char * gRow = srcImg.m_gData + yStrideBytes * yIndex;
-    char * bRow = srcImg.m_bData + yStrideBytes * yIndex;
+    char * rRow = srcImg.getLineData(srcImg.m_rData, 0, yIndex);
+    char * gRow = srcImg.getLineData(srcImg.m_gData, 1, yIndex);
+    char * bRow = srcImg.getLineData(srcImg.m_bData, 2, yIndex);
     char * aRow = nullptr;
 
     Type * rPtr = reinterpret_cast<Type*>(rRow + xStrideBytes * xIndex);
@@ -58,7 +341,7 @@ void Generic<Type>::PackRGBAFromImageDesc(const GenericImageDesc & srcImg,
 
     if(srcImg.m_aData)
     {
-        aRow = srcImg.m_aData + yStrideBytes * yIndex;
+        aRow = srcImg.getLineData(srcImg.m_aData, 3, yIndex);
         aPtr = reinterpret_cast<Type*>(aRow + xStrideBytes*xIndex);
     }
 
@@ -109,16 +392,34 @@ void Generic<float>::PackRGBAFromImageDesc(const GenericImageDesc & srcImg,
         throw Exception("Invalid output image position.");
     }
 
+    if(srcImg.isYUV())
+    {
+        DecodeYUV(srcImg.m_yuv, imagePixelStartIndex / imgWidth, imagePixelStartIndex % imgWidth,
+                  outputBufferSize, outputBuffer);
+
+        // In the float specialization, the BitDepthOp is the first Op of the color processing.
+        srcImg.m_bitDepthOp->apply(&outputBuffer[0], &outputBuffer[0], outputBufferSize);
+        return;
+    }
+
+#if defined(OCIO_USE_AVX)
+    if(ShuffleRGBA(srcImg, sizeof(float), imagePixelStartIndex, outputBufferSize,
+                   reinterpret_cast<char *>(outputBuffer), true))
+    {
+        srcImg.m_bitDepthOp->apply(&outputBuffer[0], &outputBuffer[0], outputBufferSize);
+        return;
+    }
+#endif
+
     const ptrdiff_t xStrideBytes = srcImg.m_xStrideBytes;
-    const ptrdiff_t yStrideBytes = srcImg.m_yStrideBytes;
 
     const long yIndex = imagePixelStartIndex / imgWidth;
     long xIndex = imagePixelStartIndex % imgWidth;
 
     // Figure out our initial ptr positions
-    char * rRow = srcImg.m_rData + yStrideBytes * yIndex;
-    char * gRow = srcImg.m_gData + yStrideBytes * yIndex;
-    char * bRow = srcImg.m_bData + yStrideBytes * yIndex;
+    char * rRow = srcImg.getLineData(srcImg.m_rData, 0, yIndex);
+    char * gRow = srcImg.getLineData(srcImg.m_gData, 1, yIndex);
+    char * bRow = srcImg.getLineData(srcImg.m_bData, 2, yIndex);
     char * aRow = nullptr;
 
     float * rPtr = reinterpret_cast<float*>(rRow + xStrideBytes * xIndex);
@@ -128,7 +429,7 @@ void Generic<float>::PackRGBAFromImageDesc(const GenericImageDesc & srcImg,
 
     if(srcImg.m_aData)
     {
-        aRow = srcImg.m_aData + yStrideBytes * yIndex;
+        aRow = srcImg.getLineData(srcImg.m_aData, 3, yIndex);
         aPtr = reinterpret_cast<float*>(aRow + xStrideBytes*xIndex);
     }
 
@@ -180,15 +481,14 @@ void Generic<Type>::UnpackRGBAToImageDesc(GenericImageDesc & dstImg,
     }
 
     const ptrdiff_t xStrideBytes = dstImg.m_xStrideBytes;
-    const ptrdiff_t yStrideBytes = dstImg.m_yStrideBytes;
 
     const long yIndex = imagePixelStartIndex / imgWidth;
     long xIndex = imagePixelStartIndex % imgWidth;
 
     // Figure out our initial ptr positions
-    char * rRow = dstImg.m_rData + yStrideBytes * yIndex;
-    char * gRow = dstImg.m_gData + yStrideBytes * yIndex;
-    char * bRow = dstImg.m_bData + yStrideBytes * yIndex;
+    char * rRow = dstImg.getLineData(dstImg.m_rData, 0, yIndex);
+    char * gRow = dstImg.getLineData(dstImg.m_gData, 1, yIndex);
+    char * bRow = dstImg.getLineData(dstImg.m_bData, 2, yIndex);
     char * aRow = nullptr;
 
     Type * rPtr = reinterpret_cast<Type*>(rRow + xStrideBytes * xIndex);
@@ -198,13 +498,21 @@ void Generic<Type>::UnpackRGBAToImageDesc(GenericImageDesc & dstImg,
 
     if(dstImg.m_aData)
     {
-        aRow = dstImg.m_aData + yStrideBytes * yIndex;
+        aRow = dstImg.getLineData(dstImg.m_aData, 3, yIndex);
         aPtr = reinterpret_cast<Type*>(aRow + xStrideBytes * xIndex);
     }
 
     // Convert from F32 to the output bit-depth (i.e always RGBA).
     dstImg.m_bitDepthOp->apply(&inputBuffer[0], &outBitDepthBuffer[0], numPixelsToUnpack);
 
+#if defined(OCIO_USE_AVX)
+    if(ShuffleRGBA(dstImg, sizeof(Type), imagePixelStartIndex, numPixelsToUnpack,
+                   reinterpret_cast<char *>(outBitDepthBuffer), false))
+    {
+        return;
+    }
+#endif
+
     // Process one single, complete scanline.
     int pixelsCopied = 0;
     while(pixelsCopied < numPixelsToUnpack)
@@ -249,16 +557,26 @@ void Generic<float>::UnpackRGBAToImageDesc(GenericImageDesc & dstImg,
         return;
     }
 
+    if(dstImg.isYUV())
+    {
+        // In the float specialization, the BitDepthOp is the last Op of the color processing.
+        dstImg.m_bitDepthOp->apply(&inputBuffer[0], &inputBuffer[0], numPixelsToUnpack);
+
+        EncodeYUV(dstImg.m_yuv, imgWidth, imgHeight,
+                  imagePixelStartIndex / imgWidth, imagePixelStartIndex % imgWidth,
+                  numPixelsToUnpack, inputBuffer);
+        return;
+    }
+
     const ptrdiff_t xStrideBytes = dstImg.m_xStrideBytes;
-    const ptrdiff_t yStrideBytes = dstImg.m_yStrideBytes;
 
     const long yIndex = imagePixelStartIndex / imgWidth;
     long xIndex = imagePixelStartIndex % imgWidth;
 
     // Figure out our initial ptr positions
-    char * rRow = dstImg.m_rData + yStrideBytes * yIndex;
-    char * gRow = dstImg.m_gData + yStrideBytes * yIndex;
-    char * bRow = dstImg.m_bData + yStrideBytes * yIndex;
+    char * rRow = dstImg.getLineData(dstImg.m_rData, 0, yIndex);
+    char * gRow = dstImg.getLineData(dstImg.m_gData, 1, yIndex);
+    char * bRow = dstImg.getLineData(dstImg.m_bData, 2, yIndex);
     char * aRow = nullptr;
 
     float * rPtr = reinterpret_cast<float*>(rRow + xStrideBytes * xIndex);
@@ -268,13 +586,21 @@ void Generic<float>::UnpackRGBAToImageDesc(GenericImageDesc & dstImg,
 
     if(dstImg.m_aData)
     {
-        aRow = dstImg.m_aData + yStrideBytes * yIndex;
+        aRow = dstImg.getLineData(dstImg.m_aData, 3, yIndex);
         aPtr = reinterpret_cast<float*>(aRow + xStrideBytes * xIndex);
     }
 
     // In the float specialization, the BitDepthOp is the last Op of the color processing.
     dstImg.m_bitDepthOp->apply(&inputBuffer[0], &inputBuffer[0], numPixelsToUnpack);
 
+#if defined(OCIO_USE_AVX)
+    if(ShuffleRGBA(dstImg, sizeof(float), imagePixelStartIndex, numPixelsToUnpack,
+                   reinterpret_cast<char *>(inputBuffer), false))
+    {
+        return;
+    }
+#endif
+
     // Process one single, complete scanline.
     int pixelsCopied = 0;
     while(pixelsCopied < numPixelsToUnpack)
@@ -300,11 +626,50 @@ void Generic<float>::UnpackRGBAToImageDesc(GenericImageDesc & dstImg,
 
 
 
+void StreamingCopy(void * dst, const void * src, size_t numBytes)
+{
+#if defined(USE_SSE)
+    char * out = reinterpret_cast<char *>(dst);
+    const char * in = reinterpret_cast<const char *>(src);
+
+    // The streaming stores need a 16-byte aligned destination.
+    const size_t headBytes
+        = std::min(numBytes, size_t(-reinterpret_cast<uintptr_t>(out) & 15));
+    memcpy(out, in, headBytes);
+
+    out += headBytes;
+    in  += headBytes;
+    numBytes -= headBytes;
+
+    const size_t numVectors = numBytes / 16;
+    for(size_t idx=0; idx<numVectors; ++idx)
+    {
+        _mm_stream_si128(reinterpret_cast<__m128i *>(out),
+                         _mm_loadu_si128(reinterpret_cast<const __m128i *>(in)));
+        out += 16;
+        in  += 16;
+    }
+
+    memcpy(out, in, numBytes - numVectors * 16);
+#else
+    memcpy(dst, src, numBytes);
+#endif
+}
+
+void StreamingFence()
+{
+#if defined(USE_SSE)
+    _mm_sfence();
+#endif
+}
+
+
 ////////////////////////////////////////////////////////////////////////////
 
 
 template struct Generic<uint8_t>;
 template struct Generic<uint16_t>;
+template struct Generic<uint32_t>;
 template struct Generic<half>;
 
 
@@ -5,6 +5,8 @@
 #ifndef INCLUDED_OCIO_IMAGEPACKING_H
 #define INCLUDED_OCIO_IMAGEPACKING_H
 
+#include <vector>
+
 #include <OpenColorIO/OpenColorIO.h>
 
 #include "Op.h"
@@ -13,6 +15,41 @@
 OCIO_NAMESPACE_ENTER
 {
 
+// Description of a YUV image buffer. The pixels are decoded to RGB by the packing, and
+// encoded from RGB by the unpacking, of the 32-bit float processing.
+struct GenericYUVDesc
+{
+    char * m_yData = nullptr;
+    char * m_uData = nullptr;
+    char * m_vData = nullptr;
+
+    ptrdiff_t m_yStrideBytes   = 0; // Between two lines of the luma plane.
+    ptrdiff_t m_uvStrideBytes  = 0; // Between two lines of the chroma plane(s).
+    ptrdiff_t m_uvXStrideBytes = 0; // Between two chroma samples of a line.
+
+    bool m_is16Bits = false;           // The samples are 16-bit words (i.e. P010).
+    bool m_subsampledLines = false;    // 4:2:0 i.e. two lines share the chroma samples.
+
+    // The codes are 'm_codeBits' bits, stored in the high bits of the 16-bit words.
+    unsigned m_codeBits = 8;
+    float m_maxCode = 255.0f;
+
+    // Normalized value = (code - offset) * scale.
+    float m_lumaOffset   = 0.0f;
+    float m_lumaScale    = 1.0f;
+    float m_chromaOffset = 0.0f;
+    float m_chromaScale  = 1.0f;
+
+    // The luma weights of the red & blue channels.
+    float m_kr = 0.0f;
+    float m_kb = 0.0f;
+
+    // Sums of the Cb & Cr values, and number of pixels, of the chroma samples of the
+    // current lines being encoded (i.e. the pixels sharing a chroma sample could be
+    // in different blocks or lines).
+    std::vector<float> m_chromaSums;
+};
+
 struct GenericImageDesc
 {
     long m_width  = 0;
@@ -33,6 +70,23 @@ struct GenericImageDesc
     bool m_isRGBAPacked = false;
     // Is the image buffer a 32-bit float image buffer?
     bool m_isFloat      = false;
+    // Are the color values multiplied by the alpha (refer to ImageDesc::setPremultiplied())?
+    bool m_isPremultiplied = false;
+
+    // The dithering of the integer values (refer to ImageDesc::setDither()), the pattern
+    // being aligned on the image buffer i.e. (m_ditherX, m_ditherY) is the position of
+    // the first pixel to process.
+    DitherMode m_dither = DITHER_NONE;
+    long m_ditherX = 0;
+    long m_ditherY = 0;
+
+    // Only used by the YUV image buffers (i.e. the RGBA pointers are then null).
+    GenericYUVDesc m_yuv;
+
+    // Only used by the image buffers made of separate lines (refer to ScanlineImageDesc): the
+    // line pointers of each channel, starting at the first line to process, the RGBA pointers
+    // then being in the first line (i.e. m_yStrideBytes is zero).
+    void * const * m_rows[4] = { nullptr, nullptr, nullptr, nullptr };
 
     
     // Resolves all AutoStride.
@@ -40,10 +94,28 @@ struct GenericImageDesc
     
     // Is the image buffer a packed RGBA 32-bit float buffer?
     bool isPackedFloatRGBA() const;
+    // Is the image buffer a packed RGB (i.e. without alpha) 32-bit float buffer?
+    bool isPackedFloatRGB() const;
     // Is the image buffer a RGBA packed buffer?
     bool isRGBAPacked() const;
     // Is the image buffer a 32-bit float image buffer?
     bool isFloat() const;
+    // Is the image buffer a YUV image buffer?
+    bool isYUV() const;
+    // Is the image buffer made of separate lines?
+    bool hasRows() const { return m_rows[0]!=nullptr; }
+
+    // Get the address in the line 'yIndex' of 'data', an address in the first line of the
+    // channel 'chan' (i.e. 0 for red to 3 for alpha).
+    char * getLineData(const char * data, int chan, long yIndex) const
+    {
+        if(m_rows[chan])
+        {
+            return static_cast<char *>(m_rows[chan][yIndex])
+                + (data - static_cast<const char *>(m_rows[chan][0]));
+        }
+        return const_cast<char *>(data) + m_yStrideBytes * yIndex;
+    }
 };
 
 template<typename Type>
@@ -62,6 +134,18 @@ struct Generic
                                       long imagePixelStartIndex);
 };
 
+// Are the pixels only made of the four channels of 'chanSizeBytes' bytes in any ordering
+// (e.g. BGRA, ARGB) and without padding? The packing & unpacking then shuffle the bytes of several
+// pixels at once instead of copying the channels one by one. Note that it needs the AVX2
+// instruction set.
+bool CanShuffleRGBA(const GenericImageDesc & img, size_t chanSizeBytes);
+
+// Copy to the destination using streaming (i.e. non-temporal) stores when available, so the
+// destination bytes are not loaded in the CPU caches. Call StreamingFence() once all the
+// copies are done to make the streamed bytes visible to the other threads.
+void StreamingCopy(void * dst, const void * src, size_t numBytes);
+void StreamingFence();
+
 }
 OCIO_NAMESPACE_EXIT
 
@@ -0,0 +1,475 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the OpenColorIO Project.
+
+#include <algorithm>
+#include <vector>
+
+#include <OpenColorIO/OpenColorIO.h>
+
+#include "BitDepthUtils.h"
+#include "IntegerLookupCPU.h"
+
+
+OCIO_NAMESPACE_ENTER
+{
+
+namespace
+{
+
+// The input codes of an integer bit-depth.
+template<BitDepth inBD>
+struct LookupCodes
+{
+    typedef typename BitDepthInfo<inBD>::Type InType;
+
+    static constexpr unsigned NumCodes = BitDepthInfo<inBD>::maxValue + 1;
+
+    static inline InType GetCode(unsigned idx)
+    {
+        return InType(idx);
+    }
+
+    // Note that the 10-bit, 12-bit & 14-bit codes are stored in 16-bit integers so an
+    // out-of-range code is clamped instead of reading outside of the table.
+    static inline unsigned GetIndex(InType code)
+    {
+        return std::min(unsigned(code), BitDepthInfo<inBD>::maxValue);
+    }
+};
+
+// The input codes of the half bit-depth are all the half bit patterns (including the
+// infinities and the NaNs).
+template<>
+struct LookupCodes<BIT_DEPTH_F16>
+{
+    typedef half InType;
+
+    static constexpr unsigned NumCodes = 65536;
+
+    static inline InType GetCode(unsigned idx)
+    {
+        half code;
+        code.setBits((unsigned short)idx);
+        return code;
+    }
+
+    static inline unsigned GetIndex(InType code)
+    {
+        return code.bits();
+    }
+};
+
+template<BitDepth inBD, BitDepth outBD>
+class IntegerLookupRenderer : public IntegerLookup
+{
+    typedef typename LookupCodes<inBD>::InType InType;
+    typedef typename BitDepthInfo<outBD>::Type OutType;
+
+    static constexpr unsigned NumCodes = LookupCodes<inBD>::NumCodes;
+
+public:
+    IntegerLookupRenderer() = delete;
+    explicit IntegerLookupRenderer(const ImageProcessing & process);
+    ~IntegerLookupRenderer() override {}
+
+    void apply(const GenericImageDesc & srcImg, const GenericImageDesc & dstImg,
+               long yBegin, long yEnd) const override;
+
+    size_t getMemorySize() const override
+    {
+        return (m_lutR.capacity() + m_lutG.capacity() + m_lutB.capacity() + m_lutA.capacity())
+                * sizeof(OutType);
+    }
+
+protected:
+    static inline unsigned GetIndex(InType code)
+    {
+        return LookupCodes<inBD>::GetIndex(code);
+    }
+
+    void applyPacked(const GenericImageDesc & srcImg, const GenericImageDesc & dstImg,
+                     long yIndex) const;
+    void applyGeneric(const GenericImageDesc & srcImg, const GenericImageDesc & dstImg,
+                      long yIndex) const;
+
+private:
+    std::vector<OutType> m_lutR;
+    std::vector<OutType> m_lutG;
+    std::vector<OutType> m_lutB;
+    std::vector<OutType> m_lutA;
+};
+
+template<BitDepth inBD, BitDepth outBD>
+IntegerLookupRenderer<inBD, outBD>::IntegerLookupRenderer(const ImageProcessing & process)
+    :   IntegerLookup()
+{
+    // Process an image containing all the input codes (i.e. the same code in all
+    // the channels of a pixel) so the tables hold exactly the results of the
+    // color processing.
+
+    std::vector<InType> codes(4 * NumCodes);
+    for(unsigned idx=0; idx<NumCodes; ++idx)
+    {
+        const InType code = LookupCodes<inBD>::GetCode(idx);
+        codes[4*idx+0] = code;
+        codes[4*idx+1] = code;
+        codes[4*idx+2] = code;
+        codes[4*idx+3] = code;
+    }
+
+    std::vector<OutType> values(4 * NumCodes);
+
+    const PackedImageDesc srcImg(&codes[0], long(NumCodes), 1, 4, inBD,
+                                 sizeof(InType), AutoStride, AutoStride);
+    PackedImageDesc dstImg(&values[0], long(NumCodes), 1, 4, outBD,
+                           sizeof(OutType), AutoStride, AutoStride);
+
+    process(srcImg, dstImg);
+
+    m_lutR.resize(NumCodes);
+    m_lutG.resize(NumCodes);
+    m_lutB.resize(NumCodes);
+    m_lutA.resize(NumCodes);
+
+    for(unsigned idx=0; idx<NumCodes; ++idx)
+    {
+        m_lutR[idx] = values[4*idx+0];
+        m_lutG[idx] = values[4*idx+1];
+        m_lutB[idx] = values[4*idx+2];
+        m_lutA[idx] = values[4*idx+3];
+    }
+}
+
+template<BitDepth inBD, BitDepth outBD>
+void IntegerLookupRenderer<inBD, outBD>::applyPacked(const GenericImageDesc & srcImg,
+                                                     const GenericImageDesc & dstImg,
+                                                     long yIndex) const
+{
+    const InType * in
+        = reinterpret_cast<const InType *>(srcImg.getLineData(srcImg.m_rData, 0, yIndex));
+    OutType * out
+        = reinterpret_cast<OutType *>(dstImg.getLineData(dstImg.m_rData, 0, yIndex));
+
+    const OutType * lutR = m_lutR.data();
+    const OutType * lutG = m_lutG.data();
+    const OutType * lutB = m_lutB.data();
+    const OutType * lutA = m_lutA.data();
+
+    const long width = dstImg.m_width;
+    for(long idx=0; idx<width; ++idx)
+    {
+        // Read the complete pixel first as the processing could be in place.
+        const InType r = in[0];
+        const InType g = in[1];
+        const InType b = in[2];
+        const InType a = in[3];
+
+        out[0] = lutR[GetIndex(r)];
+        out[1] = lutG[GetIndex(g)];
+        out[2] = lutB[GetIndex(b)];
+        out[3] = lutA[GetIndex(a)];
+
+        in  += 4;
+        out += 4;
+    }
+}
+
+template<BitDepth inBD, BitDepth outBD>
+void IntegerLookupRenderer<inBD, outBD>::applyGeneric(const GenericImageDesc & srcImg,
+                                                      const GenericImageDesc & dstImg,
+                                                      long yIndex) const
+{
+    const ptrdiff_t srcXStrideBytes = srcImg.m_xStrideBytes;
+    const ptrdiff_t dstXStrideBytes = dstImg.m_xStrideBytes;
+
+    const char * rIn = srcImg.getLineData(srcImg.m_rData, 0, yIndex);
+    const char * gIn = srcImg.getLineData(srcImg.m_gData, 1, yIndex);
+    const char * bIn = srcImg.getLineData(srcImg.m_bData, 2, yIndex);
+    const char * aIn = srcImg.m_aData ? srcImg.getLineData(srcImg.m_aData, 3, yIndex) : nullptr;
+
+    char * rOut = dstImg.getLineData(dstImg.m_rData, 0, yIndex);
+    char * gOut = dstImg.getLineData(dstImg.m_gData, 1, yIndex);
+    char * bOut = dstImg.getLineData(dstImg.m_bData, 2, yIndex);
+    char * aOut = dstImg.m_aData ? dstImg.getLineData(dstImg.m_aData, 3, yIndex) : nullptr;
+
+    // As for the scanline processing, a missing input alpha is processed as zero.
+    const OutType alpha = m_lutA[0];
+
+    const long width = dstImg.m_width;
+    for(long idx=0; idx<width; ++idx)
+    {
+        const InType r = *reinterpret_cast<const InType *>(rIn);
+        const InType g = *reinterpret_cast<const InType *>(gIn);
+        const InType b = *reinterpret_cast<const InType *>(bIn);
+
+        const OutType a = aIn ? m_lutA[GetIndex(*reinterpret_cast<const InType *>(aIn))]
+                              : alpha;
+
+        *reinterpret_cast<OutType *>(rOut) = m_lutR[GetIndex(r)];
+        *reinterpret_cast<OutType *>(gOut) = m_lutG[GetIndex(g)];
+        *reinterpret_cast<OutType *>(bOut) = m_lutB[GetIndex(b)];
+
+        rIn += srcXStrideBytes;
+        gIn += srcXStrideBytes;
+        bIn += srcXStrideBytes;
+
+        rOut += dstXStrideBytes;
+        gOut += dstXStrideBytes;
+        bOut += dstXStrideBytes;
+
+        if(aIn)
+        {
+            aIn += srcXStrideBytes;
+        }
+
+        if(aOut)
+        {
+            *reinterpret_cast<OutType *>(aOut) = a;
+            aOut += dstXStrideBytes;
+        }
+    }
+}
+
+template<BitDepth inBD, BitDepth outBD>
+void IntegerLookupRenderer<inBD, outBD>::apply(const GenericImageDesc & srcImg,
+                                               const GenericImageDesc & dstImg,
+                                               long yBegin, long yEnd) const
+{
+    const bool packed = srcImg.isRGBAPacked() && dstImg.isRGBAPacked();
+
+    for(long yIndex=yBegin; yIndex<yEnd; ++yIndex)
+    {
+        if(packed)
+        {
+            applyPacked(srcImg, dstImg, yIndex);
+        }
+        else
+        {
+            applyGeneric(srcImg, dstImg, yIndex);
+        }
+    }
+}
+
+}
+
+bool IsIntegerLookupBitDepth(BitDepth in)
+{
+    switch(in)
+    {
+        case BIT_DEPTH_UINT8:
+        case BIT_DEPTH_UINT10:
+        case BIT_DEPTH_UINT12:
+        case BIT_DEPTH_UINT14:
+        case BIT_DEPTH_UINT16:
+        case BIT_DEPTH_F16:
+            return true;
+
+        // Note that the 32-bit integer lookup tables would be far too large.
+
+        default:
+            return false;
+    }
+}
+
+ConstIntegerLookupRcPtr CreateIntegerLookup(BitDepth in, BitDepth out,
+                                            const ImageProcessing & process)
+{
+
+#define ADD_OUT_BIT_DEPTH(in, out)                                       \
+case out:                                                                \
+{                                                                        \
+    return std::make_shared<IntegerLookupRenderer<in, out>>(process);    \
+    break;                                                               \
+}
+
+#define ADD_IN_BIT_DEPTH(in)                          \
+case in:                                              \
+{                                                     \
+    switch(out)                                       \
+    {                                                 \
+        ADD_OUT_BIT_DEPTH(in, BIT_DEPTH_UINT8)        \
+        ADD_OUT_BIT_DEPTH(in, BIT_DEPTH_UINT10)       \
+        ADD_OUT_BIT_DEPTH(in, BIT_DEPTH_UINT12)       \
+        ADD_OUT_BIT_DEPTH(in, BIT_DEPTH_UINT14)       \
+        ADD_OUT_BIT_DEPTH(in, BIT_DEPTH_UINT16)       \
+        ADD_OUT_BIT_DEPTH(in, BIT_DEPTH_UINT32)       \
+        ADD_OUT_BIT_DEPTH(in, BIT_DEPTH_F16)          \
+        ADD_OUT_BIT_DEPTH(in, BIT_DEPTH_F32)          \
+        case BIT_DEPTH_UNKNOWN:                       \
+        default:                                      \
+            throw Exception("Unsupported bit-depth"); \
+                                                      \
+    }                                                 \
+    break;                                            \
+}
+
+    switch(in)
+    {
+        ADD_IN_BIT_DEPTH(BIT_DEPTH_UINT8)
+        ADD_IN_BIT_DEPTH(BIT_DEPTH_UINT10)
+        ADD_IN_BIT_DEPTH(BIT_DEPTH_UINT12)
+        ADD_IN_BIT_DEPTH(BIT_DEPTH_UINT14)
+        ADD_IN_BIT_DEPTH(BIT_DEPTH_UINT16)
+        ADD_IN_BIT_DEPTH(BIT_DEPTH_F16)
+        case BIT_DEPTH_F32:
+        case BIT_DEPTH_UINT32:
+        case BIT_DEPTH_UNKNOWN:
+        default:
+            throw Exception("Unsupported bit-depth for an integer lookup.");
+    }
+
+#undef ADD_OUT_BIT_DEPTH
+#undef ADD_IN_BIT_DEPTH
+
+    throw Exception("Unsupported bit-depths");
+}
+
+}
+OCIO_NAMESPACE_EXIT
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+
+
+
+#ifdef OCIO_UNIT_TEST
+
+namespace OCIO = OCIO_NAMESPACE;
+#include "UnitTest.h"
+
+
+OCIO_ADD_TEST(IntegerLookupCPU, bit_depths)
+{
+    OCIO_CHECK_ASSERT(OCIO::IsIntegerLookupBitDepth(OCIO::BIT_DEPTH_UINT8));
+    OCIO_CHECK_ASSERT(OCIO::IsIntegerLookupBitDepth(OCIO::BIT_DEPTH_UINT10));
+    OCIO_CHECK_ASSERT(OCIO::IsIntegerLookupBitDepth(OCIO::BIT_DEPTH_UINT12));
+    OCIO_CHECK_ASSERT(OCIO::IsIntegerLookupBitDepth(OCIO::BIT_DEPTH_UINT14));
+    OCIO_CHECK_ASSERT(OCIO::IsIntegerLookupBitDepth(OCIO::BIT_DEPTH_UINT16));
+    OCIO_CHECK_ASSERT(!OCIO::IsIntegerLookupBitDepth(OCIO::BIT_DEPTH_UINT32));
+    OCIO_CHECK_ASSERT(OCIO::IsIntegerLookupBitDepth(OCIO::BIT_DEPTH_F16));
+    OCIO_CHECK_ASSERT(!OCIO::IsIntegerLookupBitDepth(OCIO::BIT_DEPTH_F32));
+
+    const OCIO::ImageProcessing process = [](const OCIO::ImageDesc &, OCIO::ImageDesc &) {};
+
+    OCIO_CHECK_THROW_WHAT(OCIO::CreateIntegerLookup(OCIO::BIT_DEPTH_F32,
+                                                    OCIO::BIT_DEPTH_UINT8, process),
+                          OCIO::Exception,
+                          "Unsupported bit-depth for an integer lookup.");
+}
+
+OCIO_ADD_TEST(IntegerLookupCPU, apply)
+{
+    // An inversion of the 8-bit codes, the alpha channel being untouched.
+    const OCIO::ImageProcessing process
+        = [](const OCIO::ImageDesc & srcDesc, OCIO::ImageDesc & dstDesc)
+    {
+        const OCIO::PackedImageDesc & src = dynamic_cast<const OCIO::PackedImageDesc &>(srcDesc);
+        OCIO::PackedImageDesc & dst = dynamic_cast<OCIO::PackedImageDesc &>(dstDesc);
+
+        const uint8_t * in = reinterpret_cast<const uint8_t *>(src.getData());
+        uint16_t * out = reinterpret_cast<uint16_t *>(dst.getData());
+
+        for(long idx=0; idx<src.getWidth()*4; ++idx)
+        {
+            out[idx] = (idx%4)==3 ? uint16_t(in[idx]) : uint16_t((255 - in[idx]) * 4);
+        }
+    };
+
+    OCIO::ConstIntegerLookupRcPtr lookup;
+    OCIO_CHECK_NO_THROW(lookup = OCIO::CreateIntegerLookup(OCIO::BIT_DEPTH_UINT8,
+                                                           OCIO::BIT_DEPTH_UINT10, process));
+    OCIO_REQUIRE_ASSERT(lookup);
+
+    // Packed RGBA image buffers.
+    {
+        uint8_t inImg[8] = { 0, 1, 2, 3, 250, 251, 252, 253 };
+        uint16_t outImg[8] = { 0 };
+
+        OCIO::PackedImageDesc srcDesc(inImg, 2, 1, 4, OCIO::BIT_DEPTH_UINT8,
+                                      sizeof(uint8_t), OCIO::AutoStride, OCIO::AutoStride);
+        OCIO::PackedImageDesc dstDesc(outImg, 2, 1, 4, OCIO::BIT_DEPTH_UINT10,
+                                      sizeof(uint16_t), OCIO::AutoStride, OCIO::AutoStride);
+
+        OCIO::GenericImageDesc src, dst;
+        src.init(srcDesc, OCIO::BIT_DEPTH_UINT8, OCIO::ConstOpCPURcPtr());
+        dst.init(dstDesc, OCIO::BIT_DEPTH_UINT10, OCIO::ConstOpCPURcPtr());
+
+        OCIO_CHECK_NO_THROW(lookup->apply(src, dst, 0, 1));
+
+        const uint16_t res[8] = { 1020, 1016, 1012, 3, 20, 16, 12, 253 };
+        for(size_t idx=0; idx<8; ++idx)
+        {
+            OCIO_CHECK_EQUAL(outImg[idx], res[idx]);
+        }
+    }
+
+    // Planar RGB image buffers to packed RGBA ones i.e. the missing alpha is zero.
+    {
+        uint8_t r[2] = { 0, 10 };
+        uint8_t g[2] = { 1, 11 };
+        uint8_t b[2] = { 2, 12 };
+        uint16_t outImg[8] = { 0 };
+
+        OCIO::PlanarImageDesc srcDesc(r, g, b, nullptr, 2, 1, OCIO::BIT_DEPTH_UINT8,
+                                      sizeof(uint8_t), OCIO::AutoStride);
+        OCIO::PackedImageDesc dstDesc(outImg, 2, 1, 4, OCIO::BIT_DEPTH_UINT10,
+                                      sizeof(uint16_t), OCIO::AutoStride, OCIO::AutoStride);
+
+        OCIO::GenericImageDesc src, dst;
+        src.init(srcDesc, OCIO::BIT_DEPTH_UINT8, OCIO::ConstOpCPURcPtr());
+        dst.init(dstDesc, OCIO::BIT_DEPTH_UINT10, OCIO::ConstOpCPURcPtr());
+
+        OCIO_CHECK_NO_THROW(lookup->apply(src, dst, 0, 1));
+
+        const uint16_t res[8] = { 1020, 1016, 1012, 0, 980, 976, 972, 0 };
+        for(size_t idx=0; idx<8; ++idx)
+        {
+            OCIO_CHECK_EQUAL(outImg[idx], res[idx]);
+        }
+    }
+}
+
+OCIO_ADD_TEST(IntegerLookupCPU, out_of_range_codes)
+{
+    const OCIO::ImageProcessing process
+        = [](const OCIO::ImageDesc & srcDesc, OCIO::ImageDesc & dstDesc)
+    {
+        const OCIO::PackedImageDesc & src = dynamic_cast<const OCIO::PackedImageDesc &>(srcDesc);
+        OCIO::PackedImageDesc & dst = dynamic_cast<OCIO::PackedImageDesc &>(dstDesc);
+
+        const uint16_t * in = reinterpret_cast<const uint16_t *>(src.getData());
+        float * out = reinterpret_cast<float *>(dst.getData());
+
+        for(long idx=0; idx<src.getWidth()*4; ++idx)
+        {
+            out[idx] = float(in[idx]) / 1023.0f;
+        }
+    };
+
+    OCIO::ConstIntegerLookupRcPtr lookup;
+    OCIO_CHECK_NO_THROW(lookup = OCIO::CreateIntegerLookup(OCIO::BIT_DEPTH_UINT10,
+                                                           OCIO::BIT_DEPTH_F32, process));
+
+    // The 10-bit codes above 1023 are clamped.
+    uint16_t inImg[4] = { 0, 1023, 1024, 65535 };
+    float outImg[4] = { -1.0f, -1.0f, -1.0f, -1.0f };
+
+    OCIO::PackedImageDesc srcDesc(inImg, 1, 1, 4, OCIO::BIT_DEPTH_UINT10,
+                                  sizeof(uint16_t), OCIO::AutoStride, OCIO::AutoStride);
+    OCIO::PackedImageDesc dstDesc(outImg, 1, 1, 4, OCIO::BIT_DEPTH_F32,
+                                  sizeof(float), OCIO::AutoStride, OCIO::AutoStride);
+
+    OCIO::GenericImageDesc src, dst;
+    src.init(srcDesc, OCIO::BIT_DEPTH_UINT10, OCIO::ConstOpCPURcPtr());
+    dst.init(dstDesc, OCIO::BIT_DEPTH_F32, OCIO::ConstOpCPURcPtr());
+
+    OCIO_CHECK_NO_THROW(lookup->apply(src, dst, 0, 1));
+
+    OCIO_CHECK_EQUAL(outImg[0], 0.0f);
+    OCIO_CHECK_EQUAL(outImg[1], 1.0f);
+    OCIO_CHECK_EQUAL(outImg[2], 1.0f);
+    OCIO_CHECK_EQUAL(outImg[3], 1.0f);
+}
+
+#endif // OCIO_UNIT_TEST
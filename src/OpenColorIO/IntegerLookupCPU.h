@@ -0,0 +1,58 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the OpenColorIO Project.
+
+
+#ifndef INCLUDED_OCIO_INTEGERLOOKUPCPU_H
+#define INCLUDED_OCIO_INTEGERLOOKUPCPU_H
+
+
+#include <functional>
+
+#include <OpenColorIO/OpenColorIO.h>
+
+#include "ImagePacking.h"
+
+
+OCIO_NAMESPACE_ENTER
+{
+
+// Per-channel lookup tables indexed by the input integer code (or the half bit pattern),
+// holding the result of the complete color processing in the output bit-depth.
+//
+// Note that it is only valid if the processing has no channel crosstalk.
+class IntegerLookup
+{
+public:
+    IntegerLookup() = default;
+    IntegerLookup(const IntegerLookup &) = delete;
+    IntegerLookup & operator=(const IntegerLookup &) = delete;
+
+    virtual ~IntegerLookup() = default;
+
+    // Process the lines [yBegin, yEnd[ of the source image buffer into
+    // the destination image buffer (which could be the same one).
+    virtual void apply(const GenericImageDesc & srcImg, const GenericImageDesc & dstImg,
+                       long yBegin, long yEnd) const = 0;
+
+    // The number of bytes of the lookup tables.
+    virtual size_t getMemorySize() const = 0;
+};
+
+typedef OCIO_SHARED_PTR<const IntegerLookup> ConstIntegerLookupRcPtr;
+
+// Process packed RGBA pixels from the input to the output bit-depth.
+typedef std::function<void(const ImageDesc & srcImg, ImageDesc & dstImg)> ImageProcessing;
+
+// Is the input bit-depth one of the bit-depths supported by the lookup tables i.e. the
+// integer bit-depths up to 16 bits, and the half bit-depth?
+bool IsIntegerLookupBitDepth(BitDepth in);
+
+// Build the lookup tables by processing all the input codes with the color processing.
+ConstIntegerLookupRcPtr CreateIntegerLookup(BitDepth in, BitDepth out,
+                                            const ImageProcessing & process);
+
+}
+OCIO_NAMESPACE_EXIT
+
+
+#endif // INCLUDED_OCIO_INTEGERLOOKUPCPU_H
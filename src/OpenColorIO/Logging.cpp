@@ -1,6 +1,7 @@
 // SPDX-License-Identifier: BSD-3-Clause
 // Copyright Contributors to the OpenColorIO Project.
 
+#include <atomic>
 #include <cstdlib>
 #include <iostream>
 #include <sstream>
@@ -19,39 +20,46 @@ OCIO_NAMESPACE_ENTER
     {
         constexpr static const char * OCIO_LOGGING_LEVEL_ENVVAR = "OCIO_LOGGING_LEVEL";
         
+        // Serializes the calls to the logging function.
         Mutex g_logmutex;
 
-        LoggingLevel g_logginglevel = LOGGING_LEVEL_UNKNOWN;
+        // The level is checked by every log call, from any thread, so it is an atomic
+        // rather than being protected by the logging mutex.
+        std::atomic<LoggingLevel> g_logginglevel{ LOGGING_LEVEL_UNKNOWN };
 
-        bool g_initialized = false;
         bool g_loggingOverride = false;
         
-        // You must manually acquire the logging mutex before calling this.
-        // This will set g_logginglevel, g_initialized, g_loggingOverride
-        void InitLogging()
+        // Initialize g_logginglevel and g_loggingOverride from the environment, once.
+        bool InitLoggingOnce()
         {
-            if(g_initialized) return;
-            
-            g_initialized = true;
-            
+            LoggingLevel level = LOGGING_LEVEL_DEFAULT;
+
             std::string levelstr;
             Platform::Getenv(OCIO_LOGGING_LEVEL_ENVVAR, levelstr);
             if(!levelstr.empty())
             {
                 g_loggingOverride = true;
-                g_logginglevel = LoggingLevelFromString(levelstr.c_str());
+                level = LoggingLevelFromString(levelstr.c_str());
                 
-                if(g_logginglevel == LOGGING_LEVEL_UNKNOWN)
+                if(level == LOGGING_LEVEL_UNKNOWN)
                 {
                     std::cerr << "[OpenColorIO Warning]: Invalid $OCIO_LOGGING_LEVEL specified. ";
                     std::cerr << "Options: none (0), warning (1), info (2), debug (3)" << std::endl;
-                    g_logginglevel = LOGGING_LEVEL_DEFAULT;
+                    level = LOGGING_LEVEL_DEFAULT;
                 }
             }
-            else
-            {
-                g_logginglevel = LOGGING_LEVEL_DEFAULT;
-            }
+
+            g_logginglevel.store(level, std::memory_order_relaxed);
+
+            return true;
+        }
+
+        // The initialization of a function static is thread-safe, and only costs a check
+        // once done.
+        void InitLogging()
+        {
+            static const bool initialized = InitLoggingOnce();
+            (void)initialized;
         }
 
         // That's the default logging function.
@@ -67,6 +75,8 @@ OCIO_NAMESPACE_ENTER
         // to output the content line by line.
         void LogMessage(const char * messagePrefix, const std::string & message)
         {
+            AutoMutex lock(g_logmutex);
+
             StringVec parts;
             pystring::split( pystring::rstrip(message), parts, "\n");
 
@@ -83,15 +93,13 @@ OCIO_NAMESPACE_ENTER
     
     LoggingLevel GetLoggingLevel()
     {
-        AutoMutex lock(g_logmutex);
         InitLogging();
         
-        return g_logginglevel;
+        return g_logginglevel.load(std::memory_order_relaxed);
     }
     
     void SetLoggingLevel(LoggingLevel level)
     {
-        AutoMutex lock(g_logmutex);
         InitLogging();
         
         // Calls to SetLoggingLevel are ignored if OCIO_LOGGING_LEVEL_ENVVAR
@@ -100,53 +108,51 @@ OCIO_NAMESPACE_ENTER
         
         if(!g_loggingOverride)
         {
-            g_logginglevel = level;
+            g_logginglevel.store(level, std::memory_order_relaxed);
         }
     }
 
     void SetLoggingFunction(LoggingFunction logFunction)
     {
+        AutoMutex lock(g_logmutex);
         g_loggingFunction = logFunction;
     }
 
     void ResetToDefaultLoggingFunction()
     {
+        AutoMutex lock(g_logmutex);
         g_loggingFunction = DefaultLoggingFunction;
     }
 
+    bool IsLoggingLevelEnabled(LoggingLevel level)
+    {
+        return GetLoggingLevel()>=level;
+    }
+
     void LogWarning(const std::string & text)
     {
-        AutoMutex lock(g_logmutex);
-        InitLogging();
-        
-        if(g_logginglevel<LOGGING_LEVEL_WARNING) return;
+        if(!IsLoggingLevelEnabled(LOGGING_LEVEL_WARNING)) return;
 
         LogMessage("[OpenColorIO Warning]: ", text);
     }
     
     void LogInfo(const std::string & text)
     {
-        AutoMutex lock(g_logmutex);
-        InitLogging();
-        
-        if(g_logginglevel<LOGGING_LEVEL_INFO) return;
+        if(!IsLoggingLevelEnabled(LOGGING_LEVEL_INFO)) return;
 
         LogMessage("[OpenColorIO Info]: ", text);
     }
     
     void LogDebug(const std::string & text)
     {
-        AutoMutex lock(g_logmutex);
-        InitLogging();
-        
-        if(g_logginglevel<LOGGING_LEVEL_DEBUG) return;
+        if(!IsLoggingLevelEnabled(LOGGING_LEVEL_DEBUG)) return;
         
         LogMessage("[OpenColorIO Debug]: ", text);
     }
     
     bool IsDebugLoggingEnabled()
     {
-        return (GetLoggingLevel()>=LOGGING_LEVEL_DEBUG);
+        return IsLoggingLevelEnabled(LOGGING_LEVEL_DEBUG);
     }
     
 }
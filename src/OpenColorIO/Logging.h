@@ -7,6 +7,7 @@
 
 #include <OpenColorIO/OpenColorIO.h>
 
+#include <sstream>
 #include <string>
 
 OCIO_NAMESPACE_ENTER
@@ -15,8 +16,34 @@ OCIO_NAMESPACE_ENTER
     void LogInfo(const std::string & text);
     void LogDebug(const std::string & text);
     
+    // The level checks do not lock i.e. they are cheap enough to be done before building
+    // any message.
+    bool IsLoggingLevelEnabled(LoggingLevel level);
     bool IsDebugLoggingEnabled();
 }
 OCIO_NAMESPACE_EXIT
 
+// Log a message only built when the logging level is enabled, where the message is
+// anything that can be streamed in a std::ostream e.g.
+//
+//   OCIO_LOG_DEBUG("Opening " << filepath);
+//
+#define OCIO_LOG_MESSAGE(level, logFunction, message)           \
+    do                                                          \
+    {                                                           \
+        if (OCIO_NAMESPACE::IsLoggingLevelEnabled(level))       \
+        {                                                       \
+            std::ostringstream ocio_log_os;                     \
+            ocio_log_os << message;                             \
+            logFunction(ocio_log_os.str());                     \
+        }                                                       \
+    } while (false)
+
+#define OCIO_LOG_WARNING(message) \
+    OCIO_LOG_MESSAGE(OCIO_NAMESPACE::LOGGING_LEVEL_WARNING, OCIO_NAMESPACE::LogWarning, message)
+#define OCIO_LOG_INFO(message) \
+    OCIO_LOG_MESSAGE(OCIO_NAMESPACE::LOGGING_LEVEL_INFO, OCIO_NAMESPACE::LogInfo, message)
+#define OCIO_LOG_DEBUG(message) \
+    OCIO_LOG_MESSAGE(OCIO_NAMESPACE::LOGGING_LEVEL_DEBUG, OCIO_NAMESPACE::LogDebug, message)
+
 #endif
@@ -4,14 +4,61 @@
 #include <OpenColorIO/OpenColorIO.h>
 
 #include <algorithm>
+#include <map>
 
+#include "CacheStatistics.h"
 #include "LookParse.h"
+#include "Mutex.h"
 #include "ParseUtils.h"
 #include "pystring/pystring.h"
 #include <iostream>
 
 OCIO_NAMESPACE_ENTER
 {
+    namespace
+    {
+        // The cache is emptied once full as the look strings of a config (and the
+        // overrides of a viewer) are far fewer in practice.
+        constexpr size_t MAX_LOOK_PARSE_CACHE_ENTRIES = 1024;
+
+        typedef std::map<std::string, LookParseResult::Options> LookParseCache;
+
+        LookParseCache g_lookParseCache;
+        Mutex g_lookParseCacheLock;
+
+        void ParseLooks(const std::string & looksstr, LookParseResult::Options & result)
+        {
+            std::string strippedlooks = pystring::strip(looksstr);
+            if(strippedlooks.empty())
+            {
+                return;
+            }
+            
+            StringVec options;
+            pystring::split(strippedlooks, options, "|");
+            
+            StringVec vec;
+            
+            for(unsigned int optionsindex=0;
+                optionsindex<options.size();
+                ++optionsindex)
+            {
+                LookParseResult::Tokens tokens;
+                
+                vec.clear();
+                SplitStringEnvStyle(vec, options[optionsindex].c_str());
+                for(unsigned int i=0; i<vec.size(); ++i)
+                {
+                    LookParseResult::Token t;
+                    t.parse(vec[i]);
+                    tokens.push_back(t);
+                }
+                
+                result.push_back(tokens);
+            }
+        }
+    }
+    
     void LookParseResult::Token::parse(const std::string & str)
     {
         // Assert no commas, colons, or | in str.
@@ -63,33 +110,35 @@ OCIO_NAMESPACE_ENTER
     {
         m_options.clear();
         
-        std::string strippedlooks = pystring::strip(looksstr);
-        if(strippedlooks.empty())
+        CacheStatistics & statistics = GetCacheStatistics(CACHE_LOOK_PARSE);
+        
         {
-            return m_options;
+            AutoTimedMutex lock(g_lookParseCacheLock, statistics);
+            
+            LookParseCache::const_iterator iter = g_lookParseCache.find(looksstr);
+            if(iter != g_lookParseCache.end())
+            {
+                statistics.addHit();
+                m_options = iter->second;
+                return m_options;
+            }
         }
         
-        StringVec options;
-        pystring::split(strippedlooks, options, "|");
+        statistics.addMiss();
+        
+        ParseLooks(looksstr, m_options);
         
-        StringVec vec;
+        AutoTimedMutex lock(g_lookParseCacheLock, statistics);
         
-        for(unsigned int optionsindex=0;
-            optionsindex<options.size();
-            ++optionsindex)
+        if(g_lookParseCache.size() >= MAX_LOOK_PARSE_CACHE_ENTRIES)
         {
-            LookParseResult::Tokens tokens;
-            
-            vec.clear();
-            SplitStringEnvStyle(vec, options[optionsindex].c_str());
-            for(unsigned int i=0; i<vec.size(); ++i)
-            {
-                LookParseResult::Token t;
-                t.parse(vec[i]);
-                tokens.push_back(t);
-            }
-            
-            m_options.push_back(tokens);
+            statistics.addEvictions(g_lookParseCache.size());
+            g_lookParseCache.clear();
+        }
+        
+        if(g_lookParseCache.insert(std::make_pair(looksstr, m_options)).second)
+        {
+            statistics.addInsertion();
         }
         
         return m_options;
@@ -128,6 +177,34 @@ OCIO_NAMESPACE_ENTER
             }
         }
     }
+    
+    void ClearLookParseCache()
+    {
+        AutoMutex lock(g_lookParseCacheLock);
+        g_lookParseCache.clear();
+    }
+    
+    size_t GetLookParseCacheMemoryUsage()
+    {
+        AutoMutex lock(g_lookParseCacheLock);
+        
+        size_t numBytes = 0;
+        for(const auto & entry : g_lookParseCache)
+        {
+            numBytes += entry.first.capacity()
+                      + entry.second.capacity() * sizeof(LookParseResult::Tokens);
+            for(const auto & tokens : entry.second)
+            {
+                numBytes += tokens.capacity() * sizeof(LookParseResult::Token);
+                for(const auto & token : tokens)
+                {
+                    numBytes += token.name.capacity();
+                }
+            }
+        }
+        
+        return numBytes;
+    }
 }
 OCIO_NAMESPACE_EXIT
 
@@ -48,6 +48,11 @@ OCIO_NAMESPACE_ENTER
         Options m_options;
     };
     
+    // The parsed look strings are cached (refer to LookParseResult::parse()) as the same
+    // strings are parsed again for each display or look processor.
+    void ClearLookParseCache();
+    size_t GetLookParseCacheMemoryUsage();
+    
 }
 OCIO_NAMESPACE_EXIT
 
@@ -6,6 +6,8 @@
 #define INCLUDED_OCIO_MUTEX_H
 
 
+#include <atomic>
+#include <condition_variable>
 #include <mutex> 
 #include <assert.h>
 
@@ -27,7 +29,7 @@ OCIO_NAMESPACE_ENTER
 
         void lock()   { assert(!m_locked); m_mutex.lock(); m_locked = true; }
         void unlock() { assert(m_locked); m_mutex.unlock(); m_locked = false; }
-        void try_lock() { assert(!m_locked); m_locked = m_mutex.try_lock(); }
+        bool try_lock() { assert(!m_locked); m_locked = m_mutex.try_lock(); return m_locked; }
 
         bool locked() const { return m_locked; }
 
@@ -46,6 +48,122 @@ OCIO_NAMESPACE_ENTER
 
     typedef std::lock_guard<Mutex> AutoMutex;
 
+
+    // Reader-writer lock for the read-mostly caches (i.e. std::shared_mutex is C++17).
+    // Without writer, the readers only increment and decrement an atomic counter so
+    // concurrent cache hits never wait for each other. A writer blocks the new readers,
+    // then waits for the current ones to leave; the blocked readers and writers wait on
+    // condition variables. Note that it is not recursive, and that the writers are only
+    // expected on cache misses and changes.
+    class SharedMutex
+    {
+    public:
+        SharedMutex() = default;
+        SharedMutex(const SharedMutex &) = delete;
+        SharedMutex& operator=(const SharedMutex &) = delete;
+
+        void lock_shared()
+        {
+            while (!try_lock_shared())
+            {
+                // Wait for the writer to leave.
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_readerCondition.wait(lock, [this]() { return !(m_state.load() & WRITER); });
+            }
+        }
+
+        bool try_lock_shared()
+        {
+            unsigned state = m_state.load(std::memory_order_relaxed);
+            while (!(state & WRITER))
+            {
+                if (m_state.compare_exchange_weak(state, state + READER,
+                                                  std::memory_order_acquire,
+                                                  std::memory_order_relaxed))
+                {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        void unlock_shared()
+        {
+            // The last reader wakes up the pending writer.
+            if (m_state.fetch_sub(READER, std::memory_order_release) == (WRITER | READER))
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_writerCondition.notify_one();
+            }
+        }
+
+        void lock()
+        {
+            // Only one writer is pending or active.
+            m_writerMutex.lock();
+
+            // Block the new readers, then wait for the current ones to leave.
+            if (m_state.fetch_or(WRITER, std::memory_order_acquire) != 0)
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_writerCondition.wait(lock, [this]() { return m_state.load() == WRITER; });
+            }
+        }
+
+        bool try_lock()
+        {
+            if (!m_writerMutex.try_lock())
+            {
+                return false;
+            }
+
+            // Only succeed without any reader.
+            unsigned expected = 0;
+            if (m_state.compare_exchange_strong(expected, WRITER, std::memory_order_acquire))
+            {
+                return true;
+            }
+
+            m_writerMutex.unlock();
+            return false;
+        }
+
+        void unlock()
+        {
+            m_state.fetch_and(~WRITER, std::memory_order_release);
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_readerCondition.notify_all();
+            }
+            m_writerMutex.unlock();
+        }
+
+    private:
+        static const unsigned WRITER = 1;
+        static const unsigned READER = 2;
+
+        std::atomic<unsigned>   m_state{ 0 };
+        std::mutex              m_writerMutex;
+        std::mutex              m_mutex;           // Only used to block.
+        std::condition_variable m_readerCondition; // Waiting for no writer.
+        std::condition_variable m_writerCondition; // Waiting for no reader.
+    };
+
+    typedef std::lock_guard<SharedMutex> AutoExclusiveLock;
+
+    class AutoSharedLock
+    {
+    public:
+        explicit AutoSharedLock(SharedMutex & mutex) : m_mutex(mutex) { m_mutex.lock_shared(); }
+        ~AutoSharedLock() { m_mutex.unlock_shared(); }
+
+        AutoSharedLock(const AutoSharedLock &) = delete;
+        AutoSharedLock& operator=(const AutoSharedLock &) = delete;
+
+    private:
+        SharedMutex & m_mutex;
+    };
+
 }
 OCIO_NAMESPACE_EXIT
 
@@ -1,7 +1,14 @@
 // SPDX-License-Identifier: BSD-3-Clause
 // Copyright Contributors to the OpenColorIO Project.
 
+#include <atomic>
+#include <cctype>
+#include <clocale>
+#include <cmath>
+#include <cstdio>
 #include <cstring>
+#include <locale>
+#include <unordered_set>
 
 #include <OpenColorIO/OpenColorIO.h>
 
@@ -60,9 +67,11 @@ namespace YAML {
 #include "Display.h"
 #include "Logging.h"
 #include "MathUtils.h"
+#include "Mutex.h"
 #include "pystring/pystring.h"
 #include "PathUtils.h"
 #include "ParseUtils.h"
+#include "Platform.h"
 #include "OCIOYaml.h"
 #include "ops/Log/LogUtils.h"
 
@@ -108,6 +117,71 @@ OCIO_NAMESPACE_ENTER
         }
 #endif
         
+#ifndef OLDYAML
+        // The yaml-cpp conversion of the numbers creates a string stream per scalar, which
+        // dominates the loading of the configs with many inline values (e.g. matrices).
+        // The common numbers are parsed directly, the result being identical, and anything
+        // else (e.g. .inf or invalid values) is left to yaml-cpp and its error handling.
+        inline const char * ParseNumber(const char * str, const char * end, float & value)
+        {
+            return ParseFloat(str, end, value);
+        }
+
+        inline const char * ParseNumber(const char * str, const char * end, double & value)
+        {
+            return ParseDouble(str, end, value);
+        }
+
+        template<typename T>
+        inline bool ParseScalar(const YAML::Node & node, T & x)
+        {
+            if (!node.IsScalar())
+            {
+                return false;
+            }
+
+            const std::string & str = node.Scalar();
+            if (str.empty() || isspace((unsigned char)str[0]))
+            {
+                return false;
+            }
+
+            const char * end = str.c_str() + str.size();
+            T value;
+            if (ParseNumber(str.c_str(), end, value) != end)
+            {
+                return false;
+            }
+
+            x = value;
+            return true;
+        }
+
+        template<typename T>
+        inline bool ParseScalars(const YAML::Node & node, std::vector<T> & x)
+        {
+            if (!node.IsSequence())
+            {
+                return false;
+            }
+
+            std::vector<T> values;
+            values.reserve(node.size());
+            for (const auto & item : node)
+            {
+                T value;
+                if (!ParseScalar(item, value))
+                {
+                    return false;
+                }
+                values.push_back(value);
+            }
+
+            x.swap(values);
+            return true;
+        }
+#endif
+
         // Basic types
         
         inline void load(const YAML::Node& node, bool& x)
@@ -162,118 +236,969 @@ OCIO_NAMESPACE_ENTER
                 throw Exception(os.str().c_str());
             }
 
-#endif
-        }
-        
-        inline void load(const YAML::Node& node, float& x)
-        {
-#ifdef OLDYAML
-            if (!node.Read<float>(x))
+#endif
+        }
+        
+        inline void load(const YAML::Node& node, float& x)
+        {
+#ifdef OLDYAML
+            if (!node.Read<float>(x))
+            {
+                std::ostringstream os;
+                os << "At line " << (node.GetMark().line + 1)
+                   << ", '" << node.Tag() << "' parsing float failed.";
+
+                throw Exception(os.str().c_str());
+            }
+#else
+            if (ParseScalar(node, x))
+            {
+                return;
+            }
+
+            try
+            {
+                x = node.as<float>();
+            }
+            catch (const std::exception & e)
+            {
+                std::ostringstream os;
+                os << "At line " << (node.GetMark().line + 1)
+                   << ", '" << node.Tag() << "' parsing float failed "
+                   << "with: " << e.what();
+                throw Exception(os.str().c_str());
+            }
+
+#endif
+        }
+        
+        inline void load(const YAML::Node& node, double& x)
+        {
+#ifdef OLDYAML
+            if (!node.Read<double>(x))
+            {
+                std::ostringstream os;
+                os << "At line " << (node.GetMark().line + 1)
+                   << ", '" << node.Tag() << "' parsing double failed.";
+
+                throw Exception(os.str().c_str());
+            }
+#else
+            if (ParseScalar(node, x))
+            {
+                return;
+            }
+
+            try
+            {
+                x = node.as<double>();
+            }
+            catch (const std::exception & e)
+            {
+                std::ostringstream os;
+                os << "At line " << (node.GetMark().line + 1)
+                   << ", '" << node.Tag() << "' parsing double failed "
+                   << "with: " << e.what();
+                throw Exception(os.str().c_str());
+            }
+#endif
+        }
+        
+        inline void load(const YAML::Node& node, std::string& x)
+        {
+#ifdef OLDYAML
+            if (!node.Read<std::string>(x))
+            {
+                std::ostringstream os;
+                os << "At line " << (node.GetMark().line + 1)
+                   << ", '" << node.Tag() << "' parsing string failed.";
+
+                throw Exception(os.str().c_str());
+            }
+#else
+            try
+            {
+                x = node.as<std::string>();
+            }
+            catch (const std::exception & e)
+            {
+                std::ostringstream os;
+                os << "At line " << (node.GetMark().line + 1)
+                   << ", '" << node.Tag() << "' parsing string failed "
+                   << "with: " << e.what();
+                throw Exception(os.str().c_str());
+            }
+#endif
+        }
+        
+        inline void load(const YAML::Node & node, StringVec & x)
+        {
+#ifdef OLDYAML
+            node >> x;
+#else
+            x = node.as<StringVec>();
+#endif
+        }
+        
+        inline void load(const YAML::Node & node, std::vector<float> & x)
+        {
+#ifdef OLDYAML
+            node >> x;
+#else
+            if (!ParseScalars(node, x))
+            {
+                x = node.as<std::vector<float> >();
+            }
+#endif
+        }
+        
+        inline void load(const YAML::Node& node, std::vector<double>& x)
+        {
+#ifdef OLDYAML
+            node >> x;
+#else
+            if (!ParseScalars(node, x))
+            {
+                x = node.as<std::vector<double> >();
+            }
+#endif
+        }
+        
+        // Writer
+
+        // The settings of the fast mode of the writer, found once by comparing its output
+        // with the output of the yaml-cpp emitter (see GetFastYamlSettings()).
+        struct FastYamlSettings
+        {
+            bool m_enabled = false;
+            int m_doublePrecision = 0;
+            int m_floatPrecision = 0;
+            // The newer yaml-cpp versions do not indent the empty lines of literal strings.
+            bool m_lazyLiteralIndent = false;
+        };
+
+        // The save functions write through this class rather than directly through a
+        // YAML::Emitter. By default it forwards everything to a yaml-cpp emitter. In fast
+        // mode it formats the subset of YAML used by the configs (i.e. block & flow maps
+        // and sequences, verbatim tags, newlines, plain & literal strings, booleans and
+        // numbers) straight into a string buffer, following the layout rules of yaml-cpp.
+        // yaml-cpp creates a string stream for each number and matches each string
+        // against regular expressions, which dominates the saving of large configs.
+        //
+        // The fast mode stops at anything it does not reproduce exactly (e.g. a string
+        // needing quotes or escapes, a NaN): good() is then false and the config must be
+        // saved again through yaml-cpp.
+        class YamlWriter
+        {
+        public:
+            explicit YamlWriter(YAML::Emitter & emitter)
+                :   m_emitter(&emitter)
+            {
+            }
+
+            YamlWriter(std::string & buffer, const FastYamlSettings & settings)
+                :   m_buffer(&buffer)
+                ,   m_settings(&settings)
+            {
+                m_groups.reserve(16);
+            }
+
+            YamlWriter(const YamlWriter &) = delete;
+            YamlWriter & operator=(const YamlWriter &) = delete;
+
+            bool good() const { return m_good; }
+
+            YamlWriter & operator<<(YAML::EMITTER_MANIP manip)
+            {
+                if (m_emitter)
+                {
+                    *m_emitter << manip;
+                }
+                else if (m_good)
+                {
+                    switch (manip)
+                    {
+                        case YAML::BeginMap: beginGroup(true);            break;
+                        case YAML::EndMap:   endGroup(true);              break;
+                        case YAML::BeginSeq: beginGroup(false);           break;
+                        case YAML::EndSeq:   endGroup(false);             break;
+                        case YAML::Newline:  writeNewline();              break;
+                        case YAML::Flow:     m_flow = true;               break;
+                        case YAML::Block:    m_flow = false;              break;
+                        case YAML::Literal:  m_literal = true;            break;
+                        // The keys & values are deduced from the number of map children.
+                        case YAML::Key:
+                        case YAML::Value:                                 break;
+                        default:             m_good = false;              break;
+                    }
+                }
+                return *this;
+            }
+
+            YamlWriter & operator<<(const YAML::_Tag & tag)
+            {
+                if (m_emitter)
+                {
+                    *m_emitter << tag;
+                }
+                else if (m_good)
+                {
+                    writeTag(tag);
+                }
+                return *this;
+            }
+
+            YamlWriter & operator<<(const std::string & str)
+            {
+                if (m_emitter)
+                {
+                    *m_emitter << str;
+                }
+                else if (m_good)
+                {
+                    writeString(str.c_str(), str.size());
+                }
+                return *this;
+            }
+
+            YamlWriter & operator<<(const char * str)
+            {
+                if (m_emitter)
+                {
+                    *m_emitter << str;
+                }
+                else if (m_good)
+                {
+                    writeString(str, strlen(str));
+                }
+                return *this;
+            }
+
+            YamlWriter & operator<<(bool value)
+            {
+                if (m_emitter)
+                {
+                    *m_emitter << value;
+                }
+                else if (m_good)
+                {
+                    writeScalar(value ? "true" : "false", value ? 4 : 5);
+                }
+                return *this;
+            }
+
+            YamlWriter & operator<<(double value)
+            {
+                if (m_emitter)
+                {
+                    *m_emitter << value;
+                }
+                else if (m_good)
+                {
+                    writeNumber(value, m_settings->m_doublePrecision);
+                }
+                return *this;
+            }
+
+            YamlWriter & operator<<(float value)
+            {
+                if (m_emitter)
+                {
+                    *m_emitter << value;
+                }
+                else if (m_good)
+                {
+                    writeNumber(value, m_settings->m_floatPrecision);
+                }
+                return *this;
+            }
+
+            // Same as the yaml-cpp operator for the STL sequences.
+            template<typename T>
+            YamlWriter & operator<<(const std::vector<T> & values)
+            {
+                *this << YAML::BeginSeq;
+                for (const auto & value : values)
+                {
+                    *this << value;
+                }
+                return *this << YAML::EndSeq;
+            }
+
+        private:
+            enum NodeType
+            {
+                NODE_NONE = 0,
+                NODE_PROPERTY,
+                NODE_SCALAR,
+                NODE_FLOW_SEQ,
+                NODE_FLOW_MAP,
+                NODE_BLOCK_SEQ,
+                NODE_BLOCK_MAP
+            };
+
+            struct Group
+            {
+                bool m_isMap;
+                bool m_isFlow;
+                size_t m_numChildren;
+            };
+
+            // The yaml-cpp default indentation.
+            static const size_t INDENT = 2;
+
+            // Only the characters never leading yaml-cpp to quote a string.
+            static bool IsPlainChar(char c)
+            {
+                return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9')
+                       || c == ' ' || c == '_' || c == '-' || c == '.' || c == '/' || c == '+'
+                       || c == '(' || c == ')' || c == '=';
+            }
+
+            static bool IsPlainString(const char * str, size_t len)
+            {
+                if (len == 0 || len > 1024)
+                {
+                    return false;
+                }
+
+                const char first = str[0];
+                if (!((first >= 'a' && first <= 'z') || (first >= 'A' && first <= 'Z')
+                      || (first >= '0' && first <= '9') || first == '_' || first == '.'
+                      || first == '/' || first == '(' || first == '+'))
+                {
+                    return false;
+                }
+
+                if (str[len - 1] == ' ')
+                {
+                    return false;
+                }
+
+                for (size_t idx = 1; idx < len; ++idx)
+                {
+                    if (!IsPlainChar(str[idx]))
+                    {
+                        return false;
+                    }
+                }
+
+                // Some yaml-cpp versions quote the null & boolean like strings.
+                static const char * reserved[]
+                    = { "null", "true", "false", "yes", "no", "on", "off", "y", "n" };
+                if (len <= 5)
+                {
+                    const std::string lower = pystring::lower(std::string(str, len));
+                    for (const char * word : reserved)
+                    {
+                        if (lower == word)
+                        {
+                            return false;
+                        }
+                    }
+                }
+
+                return true;
+            }
+
+            static bool IsLiteralString(const char * str, size_t len)
+            {
+                for (size_t idx = 0; idx < len; ++idx)
+                {
+                    const char c = str[idx];
+                    if (c != '\n' && (c < ' ' || c > '~'))
+                    {
+                        return false;
+                    }
+                }
+                return true;
+            }
+
+            void append(char c)
+            {
+                m_buffer->push_back(c);
+                m_column = (c == '\n') ? 0 : m_column + 1;
+            }
+
+            // Note that 'str' must not contain any newline.
+            void append(const char * str, size_t len)
+            {
+                m_buffer->append(str, len);
+                m_column += len;
+            }
+
+            void indentTo(size_t indent)
+            {
+                if (m_column < indent)
+                {
+                    m_buffer->append(indent - m_column, ' ');
+                    m_column = indent;
+                }
+            }
+
+            void spaceOrIndentTo(bool requireSpace, size_t indent)
+            {
+                if (m_column > 0 && requireSpace)
+                {
+                    append(' ');
+                }
+                indentTo(indent);
+            }
+
+            bool hasBegunNode() const { return m_hasTag || m_hasNonContent; }
+            bool hasBegunContent() const { return m_hasTag; }
+
+            size_t lastIndent() const
+            {
+                return m_groups.size() <= 1 ? 0 : m_curIndent - INDENT;
+            }
+
+            // Write what precedes a node (or a newline) in the current group e.g. the
+            // sequence entry indicator or the key separator.
+            void prepareNode(NodeType child)
+            {
+                if (m_groups.empty())
+                {
+                    prepareTopNode(child);
+                }
+                else if (m_groups.back().m_isFlow)
+                {
+                    if (m_groups.back().m_isMap)
+                    {
+                        prepareFlowMapNode(child);
+                    }
+                    else
+                    {
+                        prepareFlowSeqNode(child);
+                    }
+                }
+                else
+                {
+                    if (m_groups.back().m_isMap)
+                    {
+                        prepareBlockMapNode(child);
+                    }
+                    else
+                    {
+                        prepareBlockSeqNode(child);
+                    }
+                }
+            }
+
+            void prepareTopNode(NodeType child)
+            {
+                if (child == NODE_NONE)
+                {
+                    return;
+                }
+
+                // yaml-cpp would start another document.
+                if (m_numDocuments > 0)
+                {
+                    m_good = false;
+                    return;
+                }
+
+                if (child == NODE_BLOCK_SEQ || child == NODE_BLOCK_MAP)
+                {
+                    if (hasBegunNode())
+                    {
+                        append('\n');
+                    }
+                }
+                else
+                {
+                    spaceOrIndentTo(hasBegunContent(), 0);
+                }
+            }
+
+            void prepareFlowSeqNode(NodeType child)
+            {
+                const size_t numChildren = m_groups.back().m_numChildren;
+                const size_t indent = lastIndent();
+
+                if (!hasBegunNode())
+                {
+                    indentTo(indent);
+                    append(numChildren == 0 ? '[' : ',');
+                }
+
+                if (child != NODE_NONE)
+                {
+                    spaceOrIndentTo(hasBegunContent() || numChildren > 0, indent);
+                }
+            }
+
+            void prepareFlowMapNode(NodeType child)
+            {
+                const size_t numChildren = m_groups.back().m_numChildren;
+                const size_t indent = lastIndent();
+
+                if (numChildren % 2 == 0)
+                {
+                    if (!hasBegunNode())
+                    {
+                        indentTo(indent);
+                        append(numChildren == 0 ? '{' : ',');
+                    }
+
+                    if (child != NODE_NONE)
+                    {
+                        spaceOrIndentTo(hasBegunContent() || numChildren > 0, indent);
+                    }
+                }
+                else
+                {
+                    if (!hasBegunNode())
+                    {
+                        append(':');
+                    }
+
+                    if (child != NODE_NONE)
+                    {
+                        spaceOrIndentTo(true, indent);
+                    }
+                }
+            }
+
+            void prepareBlockSeqNode(NodeType child)
+            {
+                if (child == NODE_NONE)
+                {
+                    return;
+                }
+
+                if (!hasBegunContent())
+                {
+                    if (m_groups.back().m_numChildren > 0)
+                    {
+                        append('\n');
+                    }
+                    indentTo(m_curIndent);
+                    append('-');
+                }
+
+                switch (child)
+                {
+                    case NODE_BLOCK_SEQ:
+                        append('\n');
+                        break;
+                    case NODE_BLOCK_MAP:
+                        if (hasBegunContent())
+                        {
+                            append('\n');
+                        }
+                        break;
+                    default:
+                        spaceOrIndentTo(hasBegunContent(), m_curIndent + INDENT);
+                        break;
+                }
+            }
+
+            void prepareBlockMapNode(NodeType child)
+            {
+                const size_t numChildren = m_groups.back().m_numChildren;
+
+                if (numChildren % 2 == 0)
+                {
+                    // yaml-cpp would write a long key (i.e. '? key').
+                    if (child == NODE_BLOCK_SEQ || child == NODE_BLOCK_MAP)
+                    {
+                        m_good = false;
+                        return;
+                    }
+
+                    if (child == NODE_NONE)
+                    {
+                        return;
+                    }
+
+                    if (!hasBegunNode() && numChildren > 0)
+                    {
+                        append('\n');
+                    }
+                    spaceOrIndentTo(hasBegunContent(), m_curIndent);
+                }
+                else
+                {
+                    if (!hasBegunNode())
+                    {
+                        append(':');
+                    }
+
+                    switch (child)
+                    {
+                        case NODE_NONE:
+                            break;
+                        case NODE_BLOCK_SEQ:
+                        case NODE_BLOCK_MAP:
+                            append('\n');
+                            break;
+                        default:
+                            spaceOrIndentTo(true, m_curIndent + INDENT);
+                            break;
+                    }
+                }
+            }
+
+            void startedNode()
+            {
+                if (m_groups.empty())
+                {
+                    ++m_numDocuments;
+                }
+                else
+                {
+                    ++m_groups.back().m_numChildren;
+                }
+
+                m_hasTag = false;
+                m_hasNonContent = false;
+                m_flow = false;
+                m_literal = false;
+            }
+
+            void beginGroup(bool isMap)
+            {
+                if (m_literal)
+                {
+                    m_good = false;
+                    return;
+                }
+
+                // A flow group only holds flow groups.
+                const bool isFlow = m_flow || (!m_groups.empty() && m_groups.back().m_isFlow);
+
+                prepareNode(isMap ? (isFlow ? NODE_FLOW_MAP : NODE_BLOCK_MAP)
+                                  : (isFlow ? NODE_FLOW_SEQ : NODE_BLOCK_SEQ));
+                startedNode();
+
+                if (!m_groups.empty())
+                {
+                    m_curIndent += INDENT;
+                }
+                m_groups.push_back({ isMap, isFlow, 0 });
+            }
+
+            void endGroup(bool isMap)
+            {
+                if (m_groups.empty() || m_groups.back().m_isMap != isMap
+                    || (isMap && m_groups.back().m_numChildren % 2 != 0))
+                {
+                    m_good = false;
+                    return;
+                }
+
+                // An empty group is always written in flow style.
+                const Group & group = m_groups.back();
+                if (group.m_isFlow || group.m_numChildren == 0)
+                {
+                    indentTo(m_curIndent);
+                    if (group.m_numChildren == 0)
+                    {
+                        append(isMap ? '{' : '[');
+                    }
+                    append(isMap ? '}' : ']');
+                }
+
+                m_groups.pop_back();
+                if (!m_groups.empty())
+                {
+                    m_curIndent -= INDENT;
+                }
+
+                m_hasTag = false;
+                m_hasNonContent = false;
+                m_flow = false;
+                m_literal = false;
+            }
+
+            void writeNewline()
             {
-                std::ostringstream os;
-                os << "At line " << (node.GetMark().line + 1)
-                   << ", '" << node.Tag() << "' parsing float failed.";
+                prepareNode(NODE_NONE);
+                append('\n');
+                m_hasNonContent = true;
+            }
 
-                throw Exception(os.str().c_str());
+            void writeTag(const YAML::_Tag & tag)
+            {
+                if (tag.type != YAML::_Tag::Type::Verbatim || !tag.prefix.empty()
+                    || !IsPlainString(tag.content.c_str(), tag.content.size())
+                    || tag.content.find(' ') != std::string::npos)
+                {
+                    m_good = false;
+                    return;
+                }
+
+                prepareNode(NODE_PROPERTY);
+                append("!<", 2);
+                append(tag.content.c_str(), tag.content.size());
+                append('>');
+                m_hasTag = true;
             }
-#else
-            try
+
+            void writeScalar(const char * str, size_t len)
             {
-                x = node.as<float>();
+                prepareNode(NODE_SCALAR);
+                append(str, len);
+                startedNode();
             }
-            catch (const std::exception & e)
+
+            void writeString(const char * str, size_t len)
             {
-                std::ostringstream os;
-                os << "At line " << (node.GetMark().line + 1)
-                   << ", '" << node.Tag() << "' parsing float failed "
-                   << "with: " << e.what();
-                throw Exception(os.str().c_str());
+                if (m_literal)
+                {
+                    // yaml-cpp double quotes the literal strings of the flow groups.
+                    if (m_groups.empty() || m_groups.back().m_isFlow
+                        || !IsLiteralString(str, len))
+                    {
+                        m_good = false;
+                        return;
+                    }
+
+                    prepareNode(NODE_SCALAR);
+                    writeLiteral(str, len, m_curIndent + INDENT);
+                    startedNode();
+                }
+                else if (len == 0)
+                {
+                    writeScalar("\"\"", 2);
+                }
+                else if (IsPlainString(str, len))
+                {
+                    writeScalar(str, len);
+                }
+                else
+                {
+                    m_good = false;
+                }
             }
 
-#endif
-        }
-        
-        inline void load(const YAML::Node& node, double& x)
-        {
-#ifdef OLDYAML
-            if (!node.Read<double>(x))
+            void writeLiteral(const char * str, size_t len, size_t indent)
             {
-                std::ostringstream os;
-                os << "At line " << (node.GetMark().line + 1)
-                   << ", '" << node.Tag() << "' parsing double failed.";
+                const bool lazyIndent = m_settings->m_lazyLiteralIndent;
 
-                throw Exception(os.str().c_str());
+                append('|');
+                append('\n');
+                if (!lazyIndent)
+                {
+                    indentTo(indent);
+                }
+
+                for (size_t idx = 0; idx < len; ++idx)
+                {
+                    if (str[idx] == '\n')
+                    {
+                        append('\n');
+                        if (!lazyIndent)
+                        {
+                            indentTo(indent);
+                        }
+                    }
+                    else
+                    {
+                        if (lazyIndent)
+                        {
+                            indentTo(indent);
+                        }
+                        append(str[idx]);
+                    }
+                }
             }
-#else
-            try
+
+            void writeNumber(double value, int precision)
             {
-                x = node.as<double>();
+                // yaml-cpp writes '.nan' & '.inf'.
+                if (!std::isfinite(value))
+                {
+                    m_good = false;
+                    return;
+                }
+
+                // Same as a stream using the 'C' locale and the yaml-cpp precision.
+                char number[64];
+                const int len = snprintf(number, sizeof(number), "%.*g", precision, value);
+                if (len <= 0 || len >= int(sizeof(number)))
+                {
+                    m_good = false;
+                    return;
+                }
+
+                writeScalar(number, size_t(len));
             }
-            catch (const std::exception & e)
+
+            YAML::Emitter * m_emitter = nullptr;
+
+            std::string * m_buffer = nullptr;
+            const FastYamlSettings * m_settings = nullptr;
+            bool m_good = true;
+
+            std::vector<Group> m_groups;
+            size_t m_numDocuments = 0;
+            size_t m_curIndent = 0;
+            size_t m_column = 0;
+
+            // The state of the next node.
+            bool m_hasTag = false;
+            bool m_hasNonContent = false;
+            bool m_flow = false;
+            bool m_literal = false;
+        };
+
+        // Write a document using all the constructs of the fast mode.
+        void WriteFastYamlProbe(YamlWriter & out)
+        {
+            out << YAML::Block;
+            out << YAML::BeginMap;
+            out << YAML::Key << "version" << YAML::Value << "2";
+            out << YAML::Newline;
+            out << YAML::Newline;
+            out << YAML::Key << "environment";
+            out << YAML::Value << YAML::BeginMap;
+            out << YAML::Key << "SHOT" << YAML::Value << "001";
+            out << YAML::EndMap;
+            out << YAML::Newline;
+            out << YAML::Key << "empty" << YAML::Value << "";
+            out << YAML::Key << "paths" << YAML::Value << StringVec{ "a b", "../c", "+d" };
+            out << YAML::Key << "flag" << YAML::Value << true;
+            out << YAML::Key << "mode" << YAML::Value << YAML::Flow << "linear";
+            out << YAML::Key << "values" << YAML::Value << YAML::Flow
+                << std::vector<double>{ 0.25, 1.0, -2.5e-08 };
+            out << YAML::Newline;
+            out << YAML::Key << "roles" << YAML::Value << YAML::BeginMap << YAML::EndMap;
+            out << YAML::Newline;
+            out << YAML::Newline;
+            out << YAML::Key << "names" << YAML::Value << YAML::Flow << StringVec{};
+            out << YAML::Newline;
+            out << YAML::Key << "views";
+            out << YAML::Value << YAML::BeginMap;
+            out << YAML::Key << "display" << YAML::Value << YAML::BeginSeq;
+            out << YAML::VerbatimTag("View") << YAML::Flow << YAML::BeginMap;
+            out << YAML::Key << "name" << YAML::Value << "Film (sRGB)";
+            out << YAML::EndMap;
+            out << YAML::EndSeq;
+            out << YAML::EndMap;
+            out << YAML::Newline;
+            out << YAML::Key << "items";
+            out << YAML::Value << YAML::BeginSeq;
+            for (int idx = 0; idx < 2; ++idx)
             {
-                std::ostringstream os;
-                os << "At line " << (node.GetMark().line + 1)
-                   << ", '" << node.Tag() << "' parsing double failed "
-                   << "with: " << e.what();
-                throw Exception(os.str().c_str());
+                out << YAML::VerbatimTag("Item");
+                out << YAML::BeginMap;
+                out << YAML::Key << "name" << YAML::Value << "item";
+                out << YAML::Key << "description";
+                out << YAML::Value << YAML::Literal << "First line\n\n  Third line\n";
+                out << YAML::Key << "vars" << YAML::Flow << YAML::Value
+                    << std::vector<float>{ 0.5f, -3.0f };
+                out << YAML::Key << "transform";
+                out << YAML::Value << YAML::VerbatimTag("Group") << YAML::BeginMap;
+                out << YAML::Key << "children" << YAML::Value << YAML::BeginSeq;
+                out << YAML::VerbatimTag("Leaf") << YAML::Flow << YAML::BeginMap;
+                out << YAML::Key << "gain" << YAML::Value << YAML::BeginMap;
+                out << YAML::Key << "value" << YAML::Value << 1.5;
+                out << YAML::Key << "dynamic" << YAML::Value << YAML::Flow << true;
+                out << YAML::EndMap;
+                out << YAML::Key << "matrix" << YAML::Value << YAML::Flow
+                    << std::vector<double>{ 1.0, 0.0, 0.125 };
+                out << YAML::EndMap;
+                out << YAML::VerbatimTag("Empty") << YAML::Flow << YAML::BeginMap;
+                out << YAML::EndMap;
+                out << YAML::EndSeq;
+                out << YAML::EndMap;
+                out << YAML::EndMap;
+                out << YAML::Newline;
             }
-#endif
+            out << YAML::EndSeq;
+            out << YAML::EndMap;
         }
-        
-        inline void load(const YAML::Node& node, std::string& x)
+
+        bool GetYamlPrecision(const std::string & str, double value, int & precision)
         {
-#ifdef OLDYAML
-            if (!node.Read<std::string>(x))
+            for (int prec = 1; prec < 40; ++prec)
             {
-                std::ostringstream os;
-                os << "At line " << (node.GetMark().line + 1)
-                   << ", '" << node.Tag() << "' parsing string failed.";
-
-                throw Exception(os.str().c_str());
+                char number[64];
+                snprintf(number, sizeof(number), "%.*g", prec, value);
+                if (str == number)
+                {
+                    precision = prec;
+                    return true;
+                }
             }
-#else
+            return false;
+        }
+
+        FastYamlSettings CalibrateFastYaml()
+        {
+            FastYamlSettings settings;
+
+#ifndef OLDYAML
             try
             {
-                x = node.as<std::string>();
+                // The number precisions differ between the yaml-cpp versions.
+                YAML::Emitter numbers;
+                numbers << YAML::Flow << YAML::BeginSeq << (1.0 / 3.0) << (1.0f / 3.0f)
+                        << YAML::EndSeq;
+
+                // i.e. '[<double>, <float>]'
+                const std::string str(numbers.c_str());
+                const size_t sep = str.find(", ");
+                if (str.size() < 2 || str.front() != '[' || str.back() != ']'
+                    || sep == std::string::npos
+                    || !GetYamlPrecision(str.substr(1, sep - 1), 1.0 / 3.0,
+                                         settings.m_doublePrecision)
+                    || !GetYamlPrecision(str.substr(sep + 2, str.size() - sep - 3), 1.0f / 3.0f,
+                                         settings.m_floatPrecision))
+                {
+                    return settings;
+                }
+
+                YAML::Emitter emitter;
+                {
+                    YamlWriter out(emitter);
+                    WriteFastYamlProbe(out);
+                }
+                const std::string expected(emitter.c_str());
+
+                for (bool lazyIndent : { true, false })
+                {
+                    settings.m_lazyLiteralIndent = lazyIndent;
+
+                    std::string buffer;
+                    YamlWriter out(buffer, settings);
+                    WriteFastYamlProbe(out);
+
+                    if (out.good() && buffer == expected)
+                    {
+                        settings.m_enabled = true;
+                        break;
+                    }
+                }
             }
-            catch (const std::exception & e)
+            catch (...)
             {
-                std::ostringstream os;
-                os << "At line " << (node.GetMark().line + 1)
-                   << ", '" << node.Tag() << "' parsing string failed "
-                   << "with: " << e.what();
-                throw Exception(os.str().c_str());
+                settings.m_enabled = false;
             }
 #endif
+
+            return settings;
         }
-        
-        inline void load(const YAML::Node & node, StringVec & x)
-        {
-#ifdef OLDYAML
-            node >> x;
-#else
-            x = node.as<StringVec>();
-#endif
-        }
-        
-        inline void load(const YAML::Node & node, std::vector<float> & x)
+
+        // The fast mode is only enabled when it reproduces the linked yaml-cpp version.
+        const FastYamlSettings & GetFastYamlSettings()
         {
-#ifdef OLDYAML
-            node >> x;
-#else
-            x = node.as<std::vector<float> >();
-#endif
+            static const FastYamlSettings settings = CalibrateFastYaml();
+            return settings;
         }
-        
-        inline void load(const YAML::Node& node, std::vector<double>& x)
+
+        // The numbers of the fast mode follow the C locale whereas the ones of yaml-cpp
+        // follow the global C++ locale.
+        bool IsClassicNumericLocale()
         {
-#ifdef OLDYAML
-            node >> x;
-#else
-            x = node.as<std::vector<double> >();
-#endif
+            const struct lconv * conv = localeconv();
+            return std::locale() == std::locale::classic()
+                   && conv && conv->decimal_point && strcmp(conv->decimal_point, ".") == 0;
         }
-        
+
         // Enums
         
         inline void load(const YAML::Node& node, BitDepth& depth)
@@ -283,7 +1208,7 @@ OCIO_NAMESPACE_ENTER
             depth = BitDepthFromString(str.c_str());
         }
         
-        inline void save(YAML::Emitter& out, BitDepth depth)
+        inline void save(YamlWriter& out, BitDepth depth)
         {
             out << BitDepthToString(depth);
         }
@@ -295,7 +1220,7 @@ OCIO_NAMESPACE_ENTER
             alloc = AllocationFromString(str.c_str());
         }
         
-        inline void save(YAML::Emitter& out, Allocation alloc)
+        inline void save(YamlWriter& out, Allocation alloc)
         {
             out << AllocationToString(alloc);
         }
@@ -307,7 +1232,7 @@ OCIO_NAMESPACE_ENTER
             dir = ColorSpaceDirectionFromString(str.c_str());
         }
         
-        inline void save(YAML::Emitter& out, ColorSpaceDirection dir)
+        inline void save(YamlWriter& out, ColorSpaceDirection dir)
         {
             out << ColorSpaceDirectionToString(dir);
         }
@@ -319,7 +1244,7 @@ OCIO_NAMESPACE_ENTER
             dir = TransformDirectionFromString(str.c_str());
         }
         
-        inline void save(YAML::Emitter& out, TransformDirection dir)
+        inline void save(YamlWriter& out, TransformDirection dir)
         {
             out << TransformDirectionToString(dir);
         }
@@ -331,7 +1256,7 @@ OCIO_NAMESPACE_ENTER
             interp = InterpolationFromString(str.c_str());
         }
         
-        inline void save(YAML::Emitter& out, Interpolation interp)
+        inline void save(YamlWriter& out, Interpolation interp)
         {
             out << InterpolationToString(interp);
         }
@@ -441,7 +1366,7 @@ OCIO_NAMESPACE_ENTER
             }
         }
         
-        inline void save(YAML::Emitter& out, View view)
+        inline void save(YamlWriter& out, View view)
         {
             out << YAML::VerbatimTag("View");
             out << YAML::Flow;
@@ -454,7 +1379,7 @@ OCIO_NAMESPACE_ENTER
         
         // Common Transform
         
-        inline void EmitBaseTransformKeyValues(YAML::Emitter & out,
+        inline void EmitBaseTransformKeyValues(YamlWriter & out,
                                                const ConstTransformRcPtr & t)
         {
             if(t->getDirection() != TRANSFORM_DIR_FORWARD)
@@ -512,7 +1437,7 @@ OCIO_NAMESPACE_ENTER
             }
         }
         
-        inline void save(YAML::Emitter& out, ConstAllocationTransformRcPtr t)
+        inline void save(YamlWriter& out, ConstAllocationTransformRcPtr t)
         {
             out << YAML::VerbatimTag("AllocationTransform");
             out << YAML::Flow << YAML::BeginMap;
@@ -608,7 +1533,7 @@ OCIO_NAMESPACE_ENTER
             }
         }
         
-        inline void save(YAML::Emitter& out, ConstCDLTransformRcPtr t)
+        inline void save(YamlWriter& out, ConstCDLTransformRcPtr t)
         {
             out << YAML::VerbatimTag("CDLTransform");
             out << YAML::Flow << YAML::BeginMap;
@@ -688,7 +1613,7 @@ OCIO_NAMESPACE_ENTER
             }
         }
         
-        inline void save(YAML::Emitter& out, ConstColorSpaceTransformRcPtr t)
+        inline void save(YamlWriter& out, ConstColorSpaceTransformRcPtr t)
         {
             out << YAML::VerbatimTag("ColorSpaceTransform");
             out << YAML::Flow << YAML::BeginMap;
@@ -744,7 +1669,7 @@ OCIO_NAMESPACE_ENTER
             }
         }
         
-        inline void save(YAML::Emitter& out, ConstExponentTransformRcPtr t)
+        inline void save(YamlWriter& out, ConstExponentTransformRcPtr t)
         {
             out << YAML::VerbatimTag("ExponentTransform");
             out << YAML::Flow << YAML::BeginMap;
@@ -856,7 +1781,7 @@ OCIO_NAMESPACE_ENTER
             }
         }
 
-        inline void save(YAML::Emitter& out, ConstExponentWithLinearTransformRcPtr t)
+        inline void save(YamlWriter& out, ConstExponentWithLinearTransformRcPtr t)
         {
             out << YAML::VerbatimTag("ExponentWithLinearTransform");
             out << YAML::Flow << YAML::BeginMap;
@@ -1010,7 +1935,7 @@ OCIO_NAMESPACE_ENTER
             }
         }
 
-        inline void saveDynamicProperty(YAML::Emitter& out,
+        inline void saveDynamicProperty(YamlWriter& out,
                                         bool dynamic, double value)
         {
             if (dynamic)
@@ -1027,7 +1952,7 @@ OCIO_NAMESPACE_ENTER
             }
         }
 
-        inline void save(YAML::Emitter& out, ConstExposureContrastTransformRcPtr t)
+        inline void save(YamlWriter& out, ConstExposureContrastTransformRcPtr t)
         {
             out << YAML::VerbatimTag("ExposureContrastTransform");
             out << YAML::Flow << YAML::BeginMap;
@@ -1105,7 +2030,7 @@ OCIO_NAMESPACE_ENTER
             }
         }
         
-        inline void save(YAML::Emitter& out, ConstFileTransformRcPtr t)
+        inline void save(YamlWriter& out, ConstFileTransformRcPtr t)
         {
             out << YAML::VerbatimTag("FileTransform");
             out << YAML::Flow << YAML::BeginMap;
@@ -1167,7 +2092,7 @@ OCIO_NAMESPACE_ENTER
             }
         }
         
-        inline void save(YAML::Emitter& out, ConstFixedFunctionTransformRcPtr t)
+        inline void save(YamlWriter& out, ConstFixedFunctionTransformRcPtr t)
         {
             out << YAML::VerbatimTag("FixedFunctionTransform");
             out << YAML::Flow << YAML::BeginMap;
@@ -1191,7 +2116,7 @@ OCIO_NAMESPACE_ENTER
         // GroupTransform
         
         void load(const YAML::Node& node, TransformRcPtr& t);
-        void save(YAML::Emitter& out, ConstTransformRcPtr t);
+        void save(YamlWriter& out, ConstTransformRcPtr t);
         
         inline void load(const YAML::Node& node, GroupTransformRcPtr& t)
         {
@@ -1241,7 +2166,7 @@ OCIO_NAMESPACE_ENTER
             }
         }
         
-        inline void save(YAML::Emitter& out, ConstGroupTransformRcPtr t)
+        inline void save(YamlWriter& out, ConstGroupTransformRcPtr t)
         {
             out << YAML::VerbatimTag("GroupTransform");
             out << YAML::BeginMap;
@@ -1362,7 +2287,7 @@ OCIO_NAMESPACE_ENTER
             t->setLogSideOffsetValue(logOffset);
         }
         
-        inline void saveLogParam(YAML::Emitter& out, const double(&param)[3],
+        inline void saveLogParam(YamlWriter& out, const double(&param)[3],
                                  double defaultVal, const char * paramName)
         {
             // (See test in Config.cpp that verifies double precision is preserved.)
@@ -1381,7 +2306,7 @@ OCIO_NAMESPACE_ENTER
             }
         }
 
-        inline void save(YAML::Emitter& out, ConstLogAffineTransformRcPtr t)
+        inline void save(YamlWriter& out, ConstLogAffineTransformRcPtr t)
         {
             out << YAML::VerbatimTag("LogAffineTransform");
             out << YAML::Flow << YAML::BeginMap;
@@ -1458,7 +2383,7 @@ OCIO_NAMESPACE_ENTER
             }
         }
 
-        inline void save(YAML::Emitter& out, ConstLogTransformRcPtr t)
+        inline void save(YamlWriter& out, ConstLogTransformRcPtr t)
         {
             out << YAML::VerbatimTag("LogTransform");
             out << YAML::Flow << YAML::BeginMap;
@@ -1518,7 +2443,7 @@ OCIO_NAMESPACE_ENTER
             }
         }
         
-        inline void save(YAML::Emitter& out, ConstLookTransformRcPtr t)
+        inline void save(YamlWriter& out, ConstLookTransformRcPtr t)
         {
             out << YAML::VerbatimTag("LookTransform");
             out << YAML::Flow << YAML::BeginMap;
@@ -1587,7 +2512,7 @@ OCIO_NAMESPACE_ENTER
             }
         }
         
-        inline void save(YAML::Emitter& out, ConstMatrixTransformRcPtr t)
+        inline void save(YamlWriter& out, ConstMatrixTransformRcPtr t)
         {
             out << YAML::VerbatimTag("MatrixTransform");
             out << YAML::Flow << YAML::BeginMap;
@@ -1675,7 +2600,7 @@ OCIO_NAMESPACE_ENTER
             }
         }
         
-        inline void save(YAML::Emitter& out, ConstRangeTransformRcPtr t)
+        inline void save(YamlWriter& out, ConstRangeTransformRcPtr t)
         {
             out << YAML::VerbatimTag("RangeTransform");
             out << YAML::Flow << YAML::BeginMap;
@@ -1818,7 +2743,7 @@ OCIO_NAMESPACE_ENTER
             }
         }
         
-        void save(YAML::Emitter& out, ConstTransformRcPtr t)
+        void save(YamlWriter& out, ConstTransformRcPtr t)
         {
             if(ConstAllocationTransformRcPtr Allocation_tran = \
                 DynamicPtrCast<const AllocationTransform>(t))
@@ -1868,6 +2793,51 @@ OCIO_NAMESPACE_ENTER
         
         // ColorSpace
         
+        const char * OCIO_LAZY_TRANSFORMS_ENVVAR = "OCIO_LAZY_TRANSFORMS";
+
+        bool InitLazyTransformLoading()
+        {
+            std::string value;
+            Platform::Getenv(OCIO_LAZY_TRANSFORMS_ENVVAR, value);
+            return !value.empty() && value != "0";
+        }
+
+        // Refer to SetLazyTransformLoading().
+        std::atomic<bool> g_lazyTransformLoading(InitLazyTransformLoading());
+
+        // Protect the yaml nodes read by the lazy loaders from different threads.
+        Mutex g_lazyTransformLoadingMutex;
+
+        inline void load(const YAML::Node& node, ColorSpaceRcPtr& cs, ColorSpaceDirection dir)
+        {
+            if(!g_lazyTransformLoading)
+            {
+                TransformRcPtr val;
+                load(node, val);
+                cs->setTransform(val, dir);
+                return;
+            }
+
+            // The loader keeps the node, and then the yaml document, alive.
+            const YAML::Node transformNode = node;
+            OCIOYaml::SetTransformLoader(cs, [transformNode]()
+            {
+                AutoMutex lock(g_lazyTransformLoadingMutex);
+                try
+                {
+                    TransformRcPtr val;
+                    load(transformNode, val);
+                    return val;
+                }
+                catch(const std::exception & e)
+                {
+                    std::ostringstream os;
+                    os << "Error: Loading the color space transform failed. " << e.what();
+                    throw Exception(os.str().c_str());
+                }
+            }, dir);
+        }
+
         inline void load(const YAML::Node& node, ColorSpaceRcPtr& cs)
         {
             if(node.Tag() != "ColorSpace")
@@ -1942,15 +2912,11 @@ OCIO_NAMESPACE_ENTER
                 }
                 else if(key == "to_reference")
                 {
-                    TransformRcPtr val;
-                    load(second, val);
-                    cs->setTransform(val, COLORSPACE_DIR_TO_REFERENCE);
+                    load(second, cs, COLORSPACE_DIR_TO_REFERENCE);
                 }
                 else if(key == "from_reference")
                 {
-                    TransformRcPtr val;
-                    load(second, val);
-                    cs->setTransform(val, COLORSPACE_DIR_FROM_REFERENCE);
+                    load(second, cs, COLORSPACE_DIR_FROM_REFERENCE);
                 }
                 else
                 {
@@ -1959,7 +2925,7 @@ OCIO_NAMESPACE_ENTER
             }
         }
         
-        inline void save(YAML::Emitter& out, ConstColorSpaceRcPtr cs)
+        inline void save(YamlWriter& out, ConstColorSpaceRcPtr cs)
         {
             out << YAML::VerbatimTag("ColorSpace");
             out << YAML::BeginMap;
@@ -2071,7 +3037,7 @@ OCIO_NAMESPACE_ENTER
             }
         }
         
-        inline void save(YAML::Emitter& out, ConstLookRcPtr look)
+        inline void save(YamlWriter& out, ConstLookRcPtr look)
         {
             out << YAML::VerbatimTag("Look");
             out << YAML::BeginMap;
@@ -2323,20 +3289,25 @@ OCIO_NAMESPACE_ENTER
                         os << "'colorspaces' field needs to be a (- !<ColorSpace>) list.";
                         throwError(node, os.str());
                     }
+                    // The names already loaded, to not scan all the color spaces for each
+                    // new one.
+                    std::unordered_set<std::string> names;
+                    for(int ii = 0; ii < c->getNumColorSpaces(); ++ii)
+                    {
+                        names.insert(c->getColorSpaceNameByIndex(ii));
+                    }
+
                     for(unsigned i = 0; i < second.size(); ++i)
                     {
                         if(second[i].Tag() == "ColorSpace")
                         {
                             ColorSpaceRcPtr cs = ColorSpace::Create();
                             load(second[i], cs);
-                            for(int ii = 0; ii < c->getNumColorSpaces(); ++ii)
+                            if(!names.insert(cs->getName()).second)
                             {
-                                if(strcmp(c->getColorSpaceNameByIndex(ii), cs->getName()) == 0)
-                                {
-                                    std::ostringstream os;
-                                    os << "Colorspace with name '" << cs->getName() << "' already defined.";
-                                    throwError(node, os.str());
-                                }
+                                std::ostringstream os;
+                                os << "Colorspace with name '" << cs->getName() << "' already defined.";
+                                throwError(node, os.str());
                             }
                             c->addColorSpace(cs);
                         }
@@ -2393,7 +3364,7 @@ OCIO_NAMESPACE_ENTER
             c->setEnvironmentMode(mode);
             c->loadEnvironment();
             
-            if(mode == ENV_ENVIRONMENT_LOAD_ALL)
+            if(mode == ENV_ENVIRONMENT_LOAD_ALL && IsDebugLoggingEnabled())
             {
                 std::ostringstream os;
                 os << "This .ocio config ";
@@ -2410,7 +3381,7 @@ OCIO_NAMESPACE_ENTER
             
         }
         
-        inline void save(YAML::Emitter& out, const Config* c)
+        inline void save(YamlWriter& out, const Config* c)
         {
             std::stringstream ss;
             const unsigned configMajorVersion = c->getMajorVersion();
@@ -2589,6 +3560,23 @@ OCIO_NAMESPACE_ENTER
     }
     
     ///////////////////////////////////////////////////////////////////////////
+
+    void SetLazyTransformLoading(bool enable)
+    {
+        g_lazyTransformLoading = enable;
+    }
+
+    bool GetLazyTransformLoading()
+    {
+        return g_lazyTransformLoading;
+    }
+
+    void OCIOYaml::SetTransformLoader(ColorSpaceRcPtr & cs,
+                                      const std::function<TransformRcPtr()> & loader,
+                                      ColorSpaceDirection dir)
+    {
+        cs->setTransformLoader(loader, dir);
+    }
     
     void OCIOYaml::open(std::istream& istream, ConfigRcPtr& c, const char* filename) const
     {
@@ -2615,10 +3603,246 @@ OCIO_NAMESPACE_ENTER
     
     void OCIOYaml::write(std::ostream& ostream, const Config* c) const
     {
-        YAML::Emitter out;
+        const FastYamlSettings & settings = GetFastYamlSettings();
+        if (settings.m_enabled && IsClassicNumericLocale())
+        {
+            std::string buffer;
+            buffer.reserve(4096 + 1024 * size_t(c->getNumColorSpaces() + c->getNumLooks()));
+
+            YamlWriter out(buffer, settings);
+            save(out, c);
+            if (out.good())
+            {
+                ostream << buffer;
+                return;
+            }
+        }
+
+        YAML::Emitter emitter;
+        YamlWriter out(emitter);
         save(out, c);
-        ostream << out.c_str();
+        ostream << emitter.c_str();
     }
     
 }
 OCIO_NAMESPACE_EXIT
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+
+
+
+#ifdef OCIO_UNIT_TEST
+
+namespace OCIO = OCIO_NAMESPACE;
+#include "UnitTest.h"
+
+namespace
+{
+
+const std::string FAST_WRITER_PROFILE =
+    "ocio_profile_version: 2\n"
+    "\n"
+    "environment:\n"
+    "  SHOT: 001\n"
+    "search_path:\n"
+    "  - luts\n"
+    "  - ../shared/luts\n"
+    "strictparsing: false\n"
+    "luma: [0.2126, 0.7152, 0.0722]\n"
+    "description: A config with most of the transforms\n"
+    "\n"
+    "roles:\n"
+    "  default: raw\n"
+    "  scene_linear: lnh\n"
+    "\n"
+    "displays:\n"
+    "  sRGB:\n"
+    "    - !<View> {name: Raw, colorspace: raw}\n"
+    "    - !<View> {name: Film (sRGB), colorspace: vd8, looks: +grade}\n"
+    "\n"
+    "active_displays: [sRGB]\n"
+    "active_views: []\n"
+    "\n"
+    "looks:\n"
+    "  - !<Look>\n"
+    "    name: grade\n"
+    "    process_space: lnh\n"
+    "    description: |\n"
+    "      First line\n"
+    "\n"
+    "      Third line\n"
+    "    transform: !<CDLTransform> {slope: [1.1, 1, 0.9], offset: [0.01, 0, -0.01], "
+    "power: [1, 1, 1], sat: 0.8}\n"
+    "\n"
+    "colorspaces:\n"
+    "  - !<ColorSpace>\n"
+    "    name: raw\n"
+    "    family: raw\n"
+    "    equalitygroup: \"\"\n"
+    "    bitdepth: 32f\n"
+    "    description: |\n"
+    "      A raw color space.\n"
+    "    isdata: true\n"
+    "    categories: [file-io, working-space]\n"
+    "    allocation: uniform\n"
+    "    allocationvars: [0, 1]\n"
+    "\n"
+    "  - !<ColorSpace>\n"
+    "    name: lnh\n"
+    "    family: ln\n"
+    "    equalitygroup: \"\"\n"
+    "    bitdepth: 16f\n"
+    "    isdata: false\n"
+    "    allocation: lg2\n"
+    "    allocationvars: [-15, 6]\n"
+    "    to_reference: !<GroupTransform>\n"
+    "      children:\n"
+    "        - !<MatrixTransform> {matrix: [0.5, 0, 0, 0, 0, 0.25, 0, 0, 0, 0, 0.125, 0, 0, 0, 0, 1], "
+    "offset: [0.1, 0.2, 0.3, 0]}\n"
+    "        - !<LogAffineTransform> {base: 10, logSideSlope: [1.3, 1.4, 1.5], "
+    "linSideOffset: [0.1234567890123, 0.5, 0.1]}\n"
+    "        - !<ExposureContrastTransform> {style: video, exposure: {value: 1.5, dynamic: true}, "
+    "contrast: 0.5, gamma: 1.1, pivot: 0.18}\n"
+    "        - !<RangeTransform> {minInValue: -0.0109, maxInValue: 1.0505, minOutValue: 0.0009, "
+    "maxOutValue: 2.5, style: noClamp}\n"
+    "        - !<ExponentWithLinearTransform> {gamma: [2.4, 2.4, 2.4, 1], "
+    "offset: [0.055, 0.055, 0.055, 0], direction: inverse}\n"
+    "        - !<FixedFunctionTransform> {style: ACES_RedMod03}\n"
+    "        - !<AllocationTransform> {allocation: lg2, vars: [-8, 5, 0.003]}\n"
+    "        - !<LogTransform> {base: 2}\n"
+    "\n"
+    "  - !<ColorSpace>\n"
+    "    name: vd8\n"
+    "    family: vd8\n"
+    "    equalitygroup: \"\"\n"
+    "    bitdepth: 8ui\n"
+    "    isdata: false\n"
+    "    allocation: uniform\n"
+    "    from_reference: !<GroupTransform>\n"
+    "      children:\n"
+    "        - !<ColorSpaceTransform> {src: lnh, dst: raw}\n"
+    "        - !<LookTransform> {src: lnh, dst: raw, looks: grade}\n"
+    "        - !<ExponentTransform> {value: [2.2, 2.2, 2.2, 1], direction: inverse}\n"
+    "        - !<FileTransform> {src: lut1d_1.spi1d, interpolation: linear}\n";
+
+// Save the config through yaml-cpp and, if enabled, through the fast mode.
+void SaveConfig(const OCIO::ConstConfigRcPtr & config,
+                std::string & yamlOut, std::string & fastOut, bool & fastGood)
+{
+    YAML::Emitter emitter;
+    OCIO::YamlWriter yamlWriter(emitter);
+    OCIO::save(yamlWriter, config.get());
+    yamlOut = emitter.c_str();
+
+    fastOut.clear();
+    OCIO::YamlWriter fastWriter(fastOut, OCIO::GetFastYamlSettings());
+    OCIO::save(fastWriter, config.get());
+    fastGood = fastWriter.good();
+}
+
+}
+
+OCIO_ADD_TEST(OCIOYaml, fast_writer)
+{
+    const OCIO::FastYamlSettings & settings = OCIO::GetFastYamlSettings();
+#ifdef OLDYAML
+    OCIO_CHECK_ASSERT(!settings.m_enabled);
+#else
+    // The fast mode reproduces the supported yaml-cpp versions.
+    OCIO_REQUIRE_ASSERT(settings.m_enabled);
+#endif
+
+    std::istringstream is(FAST_WRITER_PROFILE);
+    OCIO::ConfigRcPtr config;
+    OCIO_CHECK_NO_THROW(config = OCIO::Config::CreateFromStream(is)->createEditableCopy());
+    OCIO_REQUIRE_ASSERT(config);
+
+    std::string yamlOut, fastOut;
+    bool fastGood = false;
+    SaveConfig(config, yamlOut, fastOut, fastGood);
+    OCIO_CHECK_ASSERT(fastGood);
+    OCIO_CHECK_EQUAL(fastOut, yamlOut);
+
+    std::ostringstream os;
+    OCIO_CHECK_NO_THROW(config->serialize(os));
+    OCIO_CHECK_EQUAL(os.str(), yamlOut);
+
+    // The strings needing quotes or escapes are left to yaml-cpp.
+
+    OCIO::ColorSpaceRcPtr cs = config->getColorSpace("raw")->createEditableCopy();
+    cs->setFamily("raw: \"quoted\"");
+    cs->setDescription("Tab\tand trailing space ");
+    config->addColorSpace(cs);
+
+    SaveConfig(config, yamlOut, fastOut, fastGood);
+    OCIO_CHECK_ASSERT(!fastGood);
+
+    os.str("");
+    OCIO_CHECK_NO_THROW(config->serialize(os));
+    OCIO_CHECK_EQUAL(os.str(), yamlOut);
+    OCIO_CHECK_NE(os.str().find("family: \"raw: \\\"quoted\\\"\""), std::string::npos);
+}
+
+OCIO_ADD_TEST(OCIOYaml, load_numbers)
+{
+    const std::string PROFILE =
+        "ocio_profile_version: 2\n"
+        "colorspaces:\n"
+        "  - !<ColorSpace>\n"
+        "    name: raw\n"
+        "  - !<ColorSpace>\n"
+        "    name: lin\n"
+        "    to_reference: !<MatrixTransform> {matrix: [0.1234567890123, -1e-3, 2.5E+2, 0, "
+        "0, 1, 0, 0, 0, 0, +1, 0, 0, 0, 0, 1], offset: [.5, -0, 16, .inf]}\n";
+
+    std::istringstream is(PROFILE);
+    OCIO::ConstConfigRcPtr config;
+    OCIO_CHECK_NO_THROW(config = OCIO::Config::CreateFromStream(is));
+    OCIO_REQUIRE_ASSERT(config);
+
+    OCIO::ConstTransformRcPtr tr
+        = config->getColorSpace("lin")->getTransform(OCIO::COLORSPACE_DIR_TO_REFERENCE);
+    auto mat = OCIO::DynamicPtrCast<const OCIO::MatrixTransform>(tr);
+    OCIO_REQUIRE_ASSERT(mat);
+
+    double m44[16];
+    mat->getMatrix(m44);
+    OCIO_CHECK_EQUAL(m44[0], 0.1234567890123);
+    OCIO_CHECK_EQUAL(m44[1], -1e-3);
+    OCIO_CHECK_EQUAL(m44[2], 250.0);
+    OCIO_CHECK_EQUAL(m44[10], 1.0);
+
+    // The special values are left to yaml-cpp.
+    double offset[4];
+    mat->getOffset(offset);
+    OCIO_CHECK_EQUAL(offset[0], 0.5);
+    OCIO_CHECK_EQUAL(offset[1], 0.0);
+    OCIO_CHECK_EQUAL(offset[2], 16.0);
+    OCIO_CHECK_EQUAL(offset[3], std::numeric_limits<double>::infinity());
+
+    // The invalid values still fail.
+    std::istringstream is2(
+        "ocio_profile_version: 2\n"
+        "colorspaces:\n"
+        "  - !<ColorSpace>\n"
+        "    name: lin\n"
+        "    to_reference: !<ExponentTransform> {value: [2.2, 2.2x, 2.2, 1]}\n");
+    OCIO_CHECK_THROW(OCIO::Config::CreateFromStream(is2), OCIO::Exception);
+
+    // The duplicated color spaces are still detected.
+    std::istringstream is3(
+        "ocio_profile_version: 2\n"
+        "colorspaces:\n"
+        "  - !<ColorSpace>\n"
+        "    name: raw\n"
+        "  - !<ColorSpace>\n"
+        "    name: lin\n"
+        "  - !<ColorSpace>\n"
+        "    name: raw\n");
+    OCIO_CHECK_THROW_WHAT(OCIO::Config::CreateFromStream(is3), OCIO::Exception,
+                          "Colorspace with name 'raw' already defined");
+}
+
+#endif // OCIO_UNIT_TEST
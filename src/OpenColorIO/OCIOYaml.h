@@ -14,6 +14,11 @@ OCIO_NAMESPACE_ENTER
     public:
         void open(std::istream& istream, ConfigRcPtr& c, const char* filename = NULL) const;
         void write(std::ostream& ostream, const Config* c) const;
+
+        // Defer the creation of a color space transform to its first use.
+        static void SetTransformLoader(ColorSpaceRcPtr & cs,
+                                       const std::function<TransformRcPtr()> & loader,
+                                       ColorSpaceDirection dir);
     };
     
 }
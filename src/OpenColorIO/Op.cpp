@@ -1,8 +1,10 @@
 // SPDX-License-Identifier: BSD-3-Clause
 // Copyright Contributors to the OpenColorIO Project.
 
+#include <atomic>
 #include <cstring>
 #include <sstream>
+#include <utility>
 
 #include <OpenColorIO/OpenColorIO.h>
 
@@ -17,10 +19,42 @@
 #include "ops/Lut3D/Lut3DOp.h"
 #include "ops/Range/RangeOps.h"
 #include "pystring/pystring.h"
+#include "ThreadPool.h"
+#include "Tracing.h"
+#include "transforms/FileTransform.h"
 
 
 OCIO_NAMESPACE_ENTER
 {
+    namespace
+    {
+        // Refer to SetCPUFastMath().
+        std::atomic<bool> g_fastMath{ false };
+
+        // Refer to SetCPUFiniteInputs().
+        std::atomic<bool> g_finiteInputs{ false };
+    }
+
+    void SetCPUFastMath(bool fastMath)
+    {
+        g_fastMath = fastMath;
+    }
+
+    bool IsCPUFastMath()
+    {
+        return g_fastMath;
+    }
+
+    void SetCPUFiniteInputs(bool finiteInputs)
+    {
+        g_finiteInputs = finiteInputs;
+    }
+
+    bool IsCPUFiniteInputs()
+    {
+        return g_finiteInputs;
+    }
+
     bool OpCPU::hasDynamicProperty(DynamicPropertyType type) const
     {
         return false;
@@ -31,6 +65,32 @@ OCIO_NAMESPACE_ENTER
         throw Exception("Op does not implement dynamic property.");
     }
 
+    bool OpCPU::hasPlanarApply() const
+    {
+        return false;
+    }
+
+    void OpCPU::applyPlanar(const float * const * inPlanes, float * const * outPlanes,
+                            long numPixels) const
+    {
+        throw Exception("Op does not implement planar processing.");
+    }
+
+    bool OpCPU::hasRGBApply() const
+    {
+        return false;
+    }
+
+    void OpCPU::applyRGB(const float * inImg, float * outImg, long numPixels) const
+    {
+        throw Exception("Op does not implement packed RGB processing.");
+    }
+
+    size_t OpCPU::getMemorySize() const
+    {
+        return 0;
+    }
+
 
     OpData::OpData()
         :   m_metadata()
@@ -150,6 +210,31 @@ OCIO_NAMESPACE_ENTER
         return *this;
     }
 
+    OpRcPtrVec::OpRcPtrVec(OpRcPtrVec && v)
+        : m_ops(std::move(v.m_ops))
+        , m_metadata(std::move(v.m_metadata))
+    {
+    }
+
+    OpRcPtrVec & OpRcPtrVec::operator=(OpRcPtrVec && v)
+    {
+        if(this!=&v)
+        {
+            m_ops = std::move(v.m_ops);
+            m_metadata = std::move(v.m_metadata);
+        }
+
+        return *this;
+    }
+
+    void OpRcPtrVec::assignOps(const OpRcPtrVec & v)
+    {
+        if(this!=&v)
+        {
+            m_ops = v.m_ops;
+        }
+    }
+
     OpRcPtrVec & OpRcPtrVec::operator+=(const OpRcPtrVec & v)
     {
         if (this != &v)
@@ -188,6 +273,11 @@ OCIO_NAMESPACE_ENTER
         m_ops.push_back(val);
     }
 
+    void OpRcPtrVec::push_back(OpRcPtrVec::value_type && val)
+    {
+        m_ops.push_back(std::move(val));
+    }
+
     OpRcPtrVec::const_reference OpRcPtrVec::back() const
     {
         return m_ops.back();
@@ -254,18 +344,120 @@ OCIO_NAMESPACE_ENTER
         return true;
     }
     
+    double GetOpVecCost(const OpRcPtrVec & ops)
+    {
+        double cost = 0.0;
+        for(const auto & op : ops)
+        {
+            cost += op->getCost();
+        }
+
+        return cost;
+    }
+
+    size_t GetOpVecMemorySize(const OpRcPtrVec & ops)
+    {
+        size_t numBytes = 0;
+        for(const auto & op : ops)
+        {
+            ConstOpRcPtr constOp = op;
+            numBytes += GetOpDataMemorySize(constOp->data());
+        }
+
+        return numBytes;
+    }
+
+    double GetLutMemoryCost(size_t numBytes)
+    {
+        // Fits in the L1 cache.
+        if(numBytes <= 32 * 1024)
+        {
+            return 0.0;
+        }
+        // Fits in the L2 cache.
+        else if(numBytes <= 256 * 1024)
+        {
+            return 0.5;
+        }
+        // Fits in a typical L3 cache.
+        else if(numBytes <= 4 * 1024 * 1024)
+        {
+            return 1.5;
+        }
+
+        return 3.0;
+    }
+
     void FinalizeOpVec(OpRcPtrVec & ops, FinalizationFlags fFlags)
     {
+        TracingSpan span("processor", "FinalizeOpVec");
+
         for(auto & op : ops)
         {
+            if (op->isShared())
+            {
+                if (fFlags == FINALIZATION_EXACT)
+                {
+                    // Already finalized.
+                    continue;
+                }
+
+                // Never modify a shared op.
+                op = op->clone();
+            }
+
+            // The finalization of some ops (e.g. an inverse LUT) is expensive.
+            CheckCancellation();
+            TracingSpan opSpan("op", IsTracingEnabled() ? op->getInfo() : std::string());
             op->finalize(fFlags);
         }
     }
 
+    void ApplyLutInterpolationQuality(OpRcPtrVec & ops, LutInterpolationQuality quality)
+    {
+        if (quality == LUT_INTERPOLATION_FULL)
+        {
+            return;
+        }
+
+        for(auto & op : ops)
+        {
+            ConstOpRcPtr constOp = op;
+            ConstOpDataRcPtr data = constOp->data();
+
+            OpRcPtrVec newOps;
+            if (data->getType() == OpData::Lut1DType)
+            {
+                ConstLut1DOpDataRcPtr lut = DynamicPtrCast<const Lut1DOpData>(data);
+                if (lut->getDirection() == TRANSFORM_DIR_FORWARD)
+                {
+                    Lut1DOpDataRcPtr newLut = lut->clone();
+                    newLut->setInterpolationQuality(quality);
+                    CreateLut1DOp(newOps, newLut, TRANSFORM_DIR_FORWARD);
+                }
+            }
+            else if (data->getType() == OpData::Lut3DType)
+            {
+                ConstLut3DOpDataRcPtr lut = DynamicPtrCast<const Lut3DOpData>(data);
+                if (lut->getDirection() == TRANSFORM_DIR_FORWARD)
+                {
+                    Lut3DOpDataRcPtr newLut = lut->clone();
+                    newLut->setInterpolationQuality(quality);
+                    CreateLut3DOp(newOps, newLut, TRANSFORM_DIR_FORWARD);
+                }
+            }
+
+            if (newOps.size() == 1)
+            {
+                op = newOps[0];
+            }
+        }
+    }
+
     namespace
     {
 
-    void UnifyDynamicProperty(OpRcPtr op,
+    void UnifyDynamicProperty(const OpRcPtr & op,
                               DynamicPropertyImplRcPtr & prop,
                               DynamicPropertyType type)
     {
@@ -295,11 +487,13 @@ OCIO_NAMESPACE_ENTER
         DynamicPropertyImplRcPtr dpExposure;
         DynamicPropertyImplRcPtr dpContrast;
         DynamicPropertyImplRcPtr dpGamma;
+        DynamicPropertyImplRcPtr dpCDL;
         for (auto op : ops)
         {
             UnifyDynamicProperty(op, dpExposure, DYNAMIC_PROPERTY_EXPOSURE);
             UnifyDynamicProperty(op, dpContrast, DYNAMIC_PROPERTY_CONTRAST);
             UnifyDynamicProperty(op, dpGamma, DYNAMIC_PROPERTY_GAMMA);
+            UnifyDynamicProperty(op, dpCDL, DYNAMIC_PROPERTY_CDL);
         }
     }
 
@@ -786,6 +980,41 @@ OCIO_ADD_TEST(OpRcPtrVec, erase_insert)
     OCIO_CHECK_EQUAL(ops2[3]->getInfo(), "<RangeOp>");
 }
 
+OCIO_ADD_TEST(OpRcPtrVec, move_assign_ops)
+{
+    OCIO::OpRcPtrVec ops;
+    auto mat = OCIO::MatrixOpData::CreateDiagonalMatrix(1.1);
+    OCIO::CreateMatrixOp(ops, mat, OCIO::TRANSFORM_DIR_FORWARD);
+    OCIO::CreateLogOp(ops, 2.0, OCIO::TRANSFORM_DIR_FORWARD);
+    ops.getFormatMetadata().addAttribute(OCIO::METADATA_ID, "ID");
+    OCIO_REQUIRE_EQUAL(ops.size(), 2);
+
+    const OCIO::ConstOpRcPtr firstOp = ops[0];
+
+    // Only the op pointers are copied i.e. neither the ops nor the metadata.
+    OCIO::OpRcPtrVec opsOnly;
+    opsOnly.assignOps(ops);
+    OCIO_REQUIRE_EQUAL(opsOnly.size(), 2);
+    OCIO_CHECK_EQUAL(opsOnly[0].get(), firstOp.get());
+    OCIO_CHECK_EQUAL(opsOnly.getFormatMetadata().getNumAttributes(), 0);
+
+    // The move keeps the ops and the metadata.
+    OCIO::OpRcPtrVec moved(std::move(ops));
+    OCIO_REQUIRE_EQUAL(moved.size(), 2);
+    OCIO_CHECK_EQUAL(moved[0].get(), firstOp.get());
+    OCIO_CHECK_EQUAL(std::string(moved.getFormatMetadata().getAttributeValue(0)), "ID");
+
+    // The moved-from list could still be used.
+    OCIO_CHECK_NO_THROW(ops += moved);
+    OCIO_CHECK_EQUAL(ops.size(), 2);
+
+    OCIO::OpRcPtrVec assigned;
+    assigned = std::move(moved);
+    OCIO_REQUIRE_EQUAL(assigned.size(), 2);
+    OCIO_CHECK_EQUAL(assigned[0].get(), firstOp.get());
+    OCIO_CHECK_EQUAL(assigned.getFormatMetadata().getNumAttributes(), 1);
+}
+
 OCIO_ADD_TEST(OpData, equality)
 {
     auto mat1 = OCIO::MatrixOpData::CreateDiagonalMatrix(1.1);
@@ -13,6 +13,7 @@
 #include "DynamicProperty.h"
 #include "fileformats/FormatMetadata.h"
 #include "Mutex.h"
+#include "PrivateTypes.h"
 
 OCIO_NAMESPACE_ENTER
 {
@@ -59,6 +60,26 @@ OCIO_NAMESPACE_ENTER
         virtual bool hasDynamicProperty(DynamicPropertyType type) const;
         virtual DynamicPropertyRcPtr getDynamicProperty(DynamicPropertyType type) const;
 
+        // Some renderers could also directly process planar 32-bit float pixels i.e. each
+        // channel has its own buffer (in the R, G, B & A order). The input and output
+        // planes could be the same buffers.
+        //
+        // Note that applyPlanar() must only be called when hasPlanarApply() is true.
+        virtual bool hasPlanarApply() const;
+        virtual void applyPlanar(const float * const * inPlanes, float * const * outPlanes,
+                                 long numPixels) const;
+
+        // Some renderers could also directly process packed RGB 32-bit float pixels
+        // (i.e. three floats per pixel), the missing alpha being processed as zero.
+        // The input and output buffers could be the same buffer.
+        //
+        // Note that applyRGB() must only be called when hasRGBApply() is true.
+        virtual bool hasRGBApply() const;
+        virtual void applyRGB(const float * inImg, float * outImg, long numPixels) const;
+
+        // The number of bytes of the tables (e.g. the LUT values) allocated by the
+        // renderer i.e. zero for the renderers only holding a few parameters.
+        virtual size_t getMemorySize() const;
     };
 
     class OpData;
@@ -151,6 +172,12 @@ OCIO_NAMESPACE_ENTER
         // returns true if the op's output does not combine input channels
         virtual bool hasChannelCrosstalk() const = 0;
 
+        // Determine whether the op uses or changes the alpha channel i.e. the output
+        // alpha differs from the input alpha, or the R, G, B outputs depend on it.
+        // Note that the bit-depth scaling of the alpha is not taken into account.
+        // returns true by default as it is always safe to process the alpha channel
+        virtual bool touchesAlpha() const { return true; }
+
         virtual bool operator==(const OpData & other) const;
         bool operator!=(const OpData & other) const = delete;
 
@@ -179,13 +206,32 @@ OCIO_NAMESPACE_ENTER
     
     std::string SerializeOpVec(const OpRcPtrVec & ops, int indent=0);
     bool IsOpVecNoOp(const OpRcPtrVec & ops);
+
+    // Estimated cost to process one pixel through all the ops (refer to Op::getCost()).
+    double GetOpVecCost(const OpRcPtrVec & ops);
+
+    // Approximate number of bytes held by the op data of all the ops (refer to
+    // GetOpDataMemorySize()).
+    size_t GetOpVecMemorySize(const OpRcPtrVec & ops);
+
+    // Estimated additional cost of the look-ups in a table of 'numBytes' bytes i.e. the
+    // cache misses once the table does not fit anymore in the L1 or L2 caches.
+    double GetLutMemoryCost(size_t numBytes);
     
-    // Sets all ops to F32 and finalize them.
+    // Sets all ops to F32 and finalize them. The shared ops are replaced by finalized
+    // clones unless the finalization is exact (refer to Op::isShared()).
     void FinalizeOpVec(OpRcPtrVec & opVec, FinalizationFlags fFlags);
 
+    // Replace the forward LUT ops by copies following the interpolation quality (refer to
+    // LutInterpolationQuality), nothing is done for LUT_INTERPOLATION_FULL.
+    void ApplyLutInterpolationQuality(OpRcPtrVec & opVec, LutInterpolationQuality quality);
+
+    // When not null, 'passes' lists the optimization passes which changed the ops
+    // (e.g. "CombineOps: 3 ops") in the order they were applied.
     void OptimizeOpVec(OpRcPtrVec & result,
                        const BitDepth & inBitDepth,
-                       OptimizationFlags oFlags);
+                       OptimizationFlags oFlags,
+                       StringVec * passes = nullptr);
 
     void UnifyDynamicProperties(OpRcPtrVec & ops);
    
@@ -239,6 +285,15 @@ OCIO_NAMESPACE_ENTER
             virtual void combineWith(OpRcPtrVec & ops, ConstOpRcPtr & secondOp) const;
             
             virtual bool hasChannelCrosstalk() const { return m_data->hasChannelCrosstalk(); }
+
+            virtual bool touchesAlpha() const { return m_data->touchesAlpha(); }
+
+            // Estimated cost to process one pixel, expressed in units of a 3x3 matrix
+            // with offsets. It takes into account the CPU renderer selected by the
+            // op parameters (e.g. SSE or fast math versions) and the memory footprint
+            // of the LUTs. The optimizer uses it to never replace ops by a more
+            // expensive equivalent. It must be valid to call *prior* to finalize.
+            virtual double getCost() const { return 1.0; }
             
             virtual void dumpMetadata(ProcessorMetadataRcPtr & /*metadata*/) const
             { }
@@ -279,6 +334,13 @@ OCIO_NAMESPACE_ENTER
 
             ConstOpDataRcPtr data() const { return std::const_pointer_cast<const OpData>(m_data); }
 
+            // A shared op (e.g. from the cache of the color space op chains) could be used
+            // by several processors at the same time so it must never be modified anymore.
+            // It is already finalized with FINALIZATION_EXACT (refer to FinalizeOpVec()).
+            // Note that a clone is never shared.
+            bool isShared() const noexcept { return m_shared; }
+            void setShared() noexcept { m_shared = true; }
+
         protected:
             Op();
             OpDataRcPtr & data() { return m_data; }
@@ -291,6 +353,8 @@ OCIO_NAMESPACE_ENTER
 
             // The OpData instance holds the parameters (LUT values, matrix coefs, etc.) being used.
             OpDataRcPtr m_data;
+
+            bool m_shared = false;
     };
     
     std::ostream& operator<< (std::ostream&, const Op&);
@@ -319,10 +383,17 @@ OCIO_NAMESPACE_ENTER
 
         OpRcPtrVec(const OpRcPtrVec & v);
         OpRcPtrVec & operator=(const OpRcPtrVec & v);
+        OpRcPtrVec(OpRcPtrVec && v);
+        OpRcPtrVec & operator=(OpRcPtrVec && v);
         // Note: It copies elements i.e. no clone.
         OpRcPtrVec & operator+=(const OpRcPtrVec & v);
 
         size_type size() const { return m_ops.size(); }
+        void reserve(size_type n) { m_ops.reserve(n); }
+
+        // Copy the op pointers only i.e. neither clone the ops nor copy the format
+        // metadata (e.g. the processor finalizations only need the ops).
+        void assignOps(const OpRcPtrVec & v);
 
         iterator begin() noexcept { return m_ops.begin(); }
         const_iterator begin() const noexcept { return m_ops.begin(); }
@@ -348,6 +419,7 @@ OCIO_NAMESPACE_ENTER
         bool empty() const noexcept { return m_ops.empty(); }
 
         void push_back(const value_type & val);
+        void push_back(value_type && val);
 
         const_reference back() const;
         const_reference front() const;
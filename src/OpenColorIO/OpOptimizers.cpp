@@ -2,15 +2,30 @@
 // Copyright Contributors to the OpenColorIO Project.
 
 #include <algorithm>
+#include <atomic>
+#include <cmath>
 #include <iterator>
 #include <sstream>
+#include <utility>
 
 #include <OpenColorIO/OpenColorIO.h>
 
+#include "BitDepthUtils.h"
 #include "Logging.h"
+#include "MathUtils.h"
 #include "Op.h"
+#include "OpTools.h"
+#include "ops/Allocation/AllocationOp.h"
 #include "ops/Lut1D/Lut1DOp.h"
 #include "ops/Lut1D/Lut1DOpData.h"
+#include "ops/Lut3D/Lut3DOp.h"
+#include "ops/Lut3D/Lut3DOpData.h"
+#include "ops/Matrix/MatrixOpData.h"
+#include "ops/Matrix/MatrixOps.h"
+#include "ops/NoOp/NoOps.h"
+#include "ops/Range/RangeOpData.h"
+#include "ops/Range/RangeOps.h"
+#include "Tracing.h"
 
 OCIO_NAMESPACE_ENTER
 {
@@ -18,6 +33,12 @@ OCIO_NAMESPACE_ENTER
     {
     const int MAX_OPTIMIZATION_PASSES = 8;
 
+    // The edge length of the 3D LUT used by the OPTIMIZATION_BAKE_LUT3D optimization.
+    std::atomic<unsigned> g_bakedLut3DSize{ 33 };
+
+    // The maximum error of the OPTIMIZATION_APPROX_SEPARABLE optimization.
+    std::atomic<double> g_approximationMaxError{ 1e-4 };
+
     void RemoveNoOpTypes(OpRcPtrVec & opVec)
     {
         OpRcPtrVec::iterator iter = opVec.begin();
@@ -120,6 +141,14 @@ OCIO_NAMESPACE_ENTER
                 tmpops.clear();
                 first->combineWith(tmpops, second);
 
+                // Only keep the combination if it is not more expensive to process
+                // than the original ops (refer to Op::getCost()).
+                if (GetOpVecCost(tmpops) > first->getCost() + second->getCost())
+                {
+                    ++firstindex;
+                    continue;
+                }
+
                 // tmpops may have any number of ops in it. (0, 1, 2, ...)
                 // (size 0 would occur potentially iff the combination
                 // results in a no-op)
@@ -151,6 +180,344 @@ OCIO_NAMESPACE_ENTER
 
         return count;
     }
+
+    // Is the op a forward LUT whose input is clamped to the [0, 1] domain and whose
+    // output is a linear interpolation of its entries?
+    bool IsFoldableLut(ConstOpRcPtr & op)
+    {
+        if (op->getDirection() != TRANSFORM_DIR_FORWARD)
+        {
+            return false;
+        }
+
+        ConstOpDataRcPtr data = op->data();
+        if (data->getType() == OpData::Lut1DType)
+        {
+            ConstLut1DOpDataRcPtr lut = DynamicPtrCast<const Lut1DOpData>(data);
+            return lut->getHueAdjust() == HUE_NONE && !lut->isOutputRawHalfs();
+        }
+
+        return data->getType() == OpData::Lut3DType;
+    }
+
+    // Does the op clamp its input to the [0, 1] domain (i.e. a LUT without a half-domain)?
+    bool ClampsToLutDomain(ConstOpRcPtr & op)
+    {
+        if (!IsFoldableLut(op))
+        {
+            return false;
+        }
+
+        ConstOpDataRcPtr data = op->data();
+        if (data->getType() == OpData::Lut1DType)
+        {
+            return !DynamicPtrCast<const Lut1DOpData>(data)->isInputHalfDomain();
+        }
+
+        return true;
+    }
+
+    // The RGB affine function out = m * in + o.
+    struct AffineRGB
+    {
+        double m[9];
+        double o[3];
+
+        bool isDiagonal() const
+        {
+            return m[1] == 0.0 && m[2] == 0.0 && m[3] == 0.0
+                && m[5] == 0.0 && m[6] == 0.0 && m[7] == 0.0;
+        }
+    };
+
+    // Get the affine function of a matrix (that does not touch the alpha) or of a range
+    // that does not clamp any of the 'values'. Return false if there is none.
+    bool GetAffineRGB(ConstOpRcPtr & op, const Array::Values & values, AffineRGB & affine)
+    {
+        ConstOpDataRcPtr data = op->data();
+
+        if (data->getType() == OpData::MatrixType)
+        {
+            ConstMatrixOpDataRcPtr mat = DynamicPtrCast<const MatrixOpData>(data);
+            if (op->getDirection() == TRANSFORM_DIR_INVERSE)
+            {
+                try
+                {
+                    mat = mat->inverse();
+                }
+                catch (Exception &)
+                {
+                    return false; // Singular matrix.
+                }
+            }
+
+            if (mat->touchesAlpha())
+            {
+                return false;
+            }
+
+            const ArrayDouble::Values & m = mat->getArray().getValues();
+            for (unsigned long row = 0; row < 3; ++row)
+            {
+                for (unsigned long col = 0; col < 3; ++col)
+                {
+                    affine.m[row * 3 + col] = m[row * 4 + col];
+                }
+                affine.o[row] = mat->getOffsets()[row];
+            }
+
+            return true;
+        }
+        else if (data->getType() == OpData::RangeType)
+        {
+            ConstRangeOpDataRcPtr range = DynamicPtrCast<const RangeOpData>(data);
+            if (op->getDirection() == TRANSFORM_DIR_INVERSE)
+            {
+                range = range->inverse();
+            }
+
+            // Computes the scale & offset.
+            range->validate();
+
+            for (const auto & v : values)
+            {
+                if ((range->hasMinInValue() && v < range->getMinInValue())
+                    || (range->hasMaxInValue() && v > range->getMaxInValue()))
+                {
+                    return false; // The range would clamp that value.
+                }
+            }
+
+            affine = { { range->getScale(), 0.0, 0.0,
+                         0.0, range->getScale(), 0.0,
+                         0.0, 0.0, range->getScale() },
+                       { range->getOffset(), range->getOffset(), range->getOffset() } };
+
+            return true;
+        }
+
+        return false;
+    }
+
+    // Is the op a range that only clamps values outside of the [0, 1] domain
+    // i.e. a clamp already done by a following LUT?
+    bool IsLutDomainClamp(ConstOpRcPtr & op)
+    {
+        if (op->data()->getType() != OpData::RangeType)
+        {
+            return false;
+        }
+
+        ConstRangeOpDataRcPtr range = DynamicPtrCast<const RangeOpData>(op->data());
+        if (op->getDirection() == TRANSFORM_DIR_INVERSE)
+        {
+            range = range->inverse();
+        }
+
+        range->validate();
+
+        return !range->scales()
+            && (!range->hasMinInValue() || range->getMinInValue() <= 0.0)
+            && (!range->hasMaxInValue() || range->getMaxInValue() >= 1.0);
+    }
+
+    // Fold the matrices and ranges into their adjacent LUTs when that is exact:
+    //
+    // - A LUT output is a weighted average of its entries (i.e. the weights sum to one)
+    //   so a following affine function (i.e. a matrix, or a range that does not clamp
+    //   any of the entries) can be applied to the entries instead. A 1D LUT only
+    //   absorbs the functions without channel crosstalk.
+    // - A LUT with a standard domain clamps its input to [0, 1] so a preceding range
+    //   that only clamps outside of that domain is removed.
+    //
+    // Note: The LUTs do not have a domain scaling, so a preceding scale (or offset)
+    //       cannot be absorbed without resampling the LUT i.e. that is not done here.
+    int FoldMatricesAndRangesIntoLuts(OpRcPtrVec & opVec)
+    {
+        int count      = 0;
+        int firstindex = 0; // this must be a signed int
+
+        OpRcPtrVec newOps;
+
+        while (firstindex < static_cast<int>(opVec.size() - 1))
+        {
+            ConstOpRcPtr first  = opVec[firstindex];
+            ConstOpRcPtr second = opVec[firstindex + 1];
+
+            newOps.clear();
+
+            if (IsFoldableLut(first))
+            {
+                if (first->data()->getType() == OpData::Lut1DType)
+                {
+                    ConstLut1DOpDataRcPtr lut
+                        = DynamicPtrCast<const Lut1DOpData>(first->data());
+
+                    AffineRGB affine;
+                    if (GetAffineRGB(second, lut->getArray().getValues(), affine)
+                        && affine.isDiagonal())
+                    {
+                        Lut1DOpDataRcPtr newLut = lut->clone();
+                        Array & array = newLut->getArray();
+                        array.setNumColorComponents(3);
+
+                        Array::Values & values = array.getValues();
+                        const unsigned long length = array.getLength();
+                        for (unsigned long idx = 0; idx < length; ++idx)
+                        {
+                            for (unsigned long c = 0; c < 3; ++c)
+                            {
+                                const double v = values[idx * 3 + c];
+                                values[idx * 3 + c]
+                                    = (float)(affine.m[c * 4] * v + affine.o[c]);
+                            }
+                        }
+                        array.adjustColorComponentNumber();
+
+                        CreateLut1DOp(newOps, newLut, TRANSFORM_DIR_FORWARD);
+                    }
+                }
+                else
+                {
+                    ConstLut3DOpDataRcPtr lut
+                        = DynamicPtrCast<const Lut3DOpData>(first->data());
+
+                    AffineRGB affine;
+                    if (GetAffineRGB(second, lut->getArray().getValues(), affine))
+                    {
+                        Lut3DOpDataRcPtr newLut = lut->clone();
+
+                        Array::Values & values = newLut->getArray().getValues();
+                        const size_t numEntries = values.size() / 3;
+                        for (size_t idx = 0; idx < numEntries; ++idx)
+                        {
+                            const double r = values[idx * 3 + 0];
+                            const double g = values[idx * 3 + 1];
+                            const double b = values[idx * 3 + 2];
+
+                            for (size_t c = 0; c < 3; ++c)
+                            {
+                                values[idx * 3 + c]
+                                    = (float)(affine.m[c * 3 + 0] * r
+                                              + affine.m[c * 3 + 1] * g
+                                              + affine.m[c * 3 + 2] * b
+                                              + affine.o[c]);
+                            }
+                        }
+
+                        CreateLut3DOp(newOps, newLut, TRANSFORM_DIR_FORWARD);
+                    }
+                }
+            }
+
+            if (!newOps.empty())
+            {
+                // Replace the LUT and the absorbed op by the new LUT.
+                opVec.erase(opVec.begin() + firstindex, opVec.begin() + firstindex + 2);
+                opVec.insert(opVec.begin() + firstindex, newOps.begin(), newOps.end());
+                ++count;
+            }
+            else if (IsLutDomainClamp(first) && ClampsToLutDomain(second))
+            {
+                // The LUT already clamps to its domain.
+                opVec.erase(opVec.begin() + firstindex);
+                ++count;
+            }
+            else
+            {
+                ++firstindex;
+            }
+        }
+
+        return count;
+    }
+
+    // Get the forward matrix of a matrix op, return false if it is not a matrix or if
+    // it is not invertible.
+    bool GetForwardMatrix(ConstOpRcPtr & op, ConstMatrixOpDataRcPtr & mat)
+    {
+        if (op->data()->getType() != OpData::MatrixType)
+        {
+            return false;
+        }
+
+        mat = DynamicPtrCast<const MatrixOpData>(op->data());
+        if (op->getDirection() == TRANSFORM_DIR_INVERSE)
+        {
+            try
+            {
+                mat = mat->inverse();
+            }
+            catch (Exception &)
+            {
+                return false; // Singular matrix.
+            }
+        }
+
+        return true;
+    }
+
+    // Fold the scale & offset of a range sitting between two matrices into the
+    // preceding matrix, the range then only clamping i.e. the scale is free as the
+    // matrix already multiplies the values.
+    //
+    // Note: The clamp bounds are the range output bounds so they stay exact.
+    int FoldRangeScalesIntoMatrices(OpRcPtrVec & opVec)
+    {
+        int count = 0;
+
+        for (size_t idx = 1; idx + 1 < opVec.size(); ++idx)
+        {
+            ConstOpRcPtr prev  = opVec[idx - 1];
+            ConstOpRcPtr op    = opVec[idx];
+            ConstOpRcPtr next  = opVec[idx + 1];
+
+            if (op->data()->getType() != OpData::RangeType
+                || next->data()->getType() != OpData::MatrixType)
+            {
+                continue;
+            }
+
+            ConstRangeOpDataRcPtr range = DynamicPtrCast<const RangeOpData>(op->data());
+            if (op->getDirection() == TRANSFORM_DIR_INVERSE)
+            {
+                range = range->inverse();
+            }
+
+            // Computes the scale & offset.
+            range->validate();
+
+            ConstMatrixOpDataRcPtr mat;
+            if (!range->scales() || !GetForwardMatrix(prev, mat))
+            {
+                continue;
+            }
+
+            ConstMatrixOpDataRcPtr scale = range->convertToMatrix();
+            MatrixOpDataRcPtr newMat = mat->compose(scale);
+
+            RangeOpDataRcPtr clamp = range->clone();
+            if (range->hasMinOutValue())
+            {
+                clamp->setMinInValue(range->getMinOutValue());
+            }
+            if (range->hasMaxOutValue())
+            {
+                clamp->setMaxInValue(range->getMaxOutValue());
+            }
+            clamp->validate();
+
+            OpRcPtrVec newOps;
+            CreateMatrixOp(newOps, newMat, TRANSFORM_DIR_FORWARD);
+            CreateRangeOp(newOps, clamp, TRANSFORM_DIR_FORWARD);
+
+            opVec.erase(opVec.begin() + idx - 1, opVec.begin() + idx + 1);
+            opVec.insert(opVec.begin() + idx - 1, newOps.begin(), newOps.end());
+            ++count;
+        }
+
+        return count;
+    }
     } // namespace
 
     // (Note: the term "separable" in mathematics refers to a multi-dimensional
@@ -198,57 +565,149 @@ OCIO_NAMESPACE_ENTER
             }
         }
 
-        // Some ops are so fast that it may not make sense to replace just one of those.
-        // E.g., if it's just a single matrix, it may not be faster to replace it with a LUT.
-        // So make sure there are some more expensive ops to combine.
-        unsigned expensiveOps = 0u;
-        for (unsigned i = 0; i < prefixLen; ++i)
-        {
-            auto op = ops[i];
+        // Note: Some ops are so fast (e.g. a single matrix) that it may not be faster to
+        //       replace them with a LUT. That's decided by OptimizeSeparablePrefix()
+        //       comparing the costs.
 
-            if (op->hasChannelCrosstalk())
-            {
-                // Non-separable ops (should never get here).
-                throw Exception("Non-separable op.");
-            }
+        // TODO: The main source of potential lossiness is where there is a 1D LUT
+        // that has extended range values followed by something that clamps.  In
+        // that case, the clamp would get baked into the LUT entries and therefore
+        // result in a different interpolated value.  Could look for that case and
+        // turn off the optimization.
 
-            ConstOpRcPtr constOp = op;
-            switch (constOp->data()->getType())
+        return prefixLen;
+    }
+
+    namespace
+    {
+    // Evaluate, with a linear interpolation, a 1D LUT having a standard domain.
+    inline float EvalStandardLut1D(const Array::Values & values, unsigned long length,
+                                   float x, unsigned long channel)
+    {
+        const float pos = Clamp(x, 0.0f, 1.0f) * float(length - 1);
+        const unsigned long idx = std::min((unsigned long)pos, length - 2);
+        const float frac = pos - float(idx);
+
+        const float v0 = values[idx * 3 + channel];
+        const float v1 = values[(idx + 1) * 3 + channel];
+        return v0 + frac * (v1 - v0);
+    }
+
+    inline bool IsWithinTolerance(float value, float expected, float tolerance)
+    {
+        // Absolute error below one, and relative error above.
+        // Note that it is false when any of the values is a NaN.
+        return std::fabs(value - expected) <= tolerance * std::max(1.0f, std::fabs(expected));
+    }
+
+    // The 1D LUT built by OptimizeSeparablePrefix() does an exact look-up of each possible
+    // input value (i.e. each code of an integer bit-depth, or each half value) so it could
+    // be large (e.g. 65536 entries for 16i or 16f) hurting the cache usage. Look for a
+    // smaller LUT with a standard domain that interpolates the 'lookupLut' values within
+    // the tolerance. Return null if there is none.
+    Lut1DOpDataRcPtr FindSmallerPrefixLut(ConstLut1DOpDataRcPtr & lookupLut,
+                                          OpRcPtrVec & prefixOps,
+                                          float tolerance)
+    {
+        const Array::Values & lookupValues = lookupLut->getArray().getValues();
+        const unsigned long lookupLength = lookupLut->getArray().getLength();
+
+        // The input values (i.e. the look-up LUT domain) to check.
+        std::vector<float> inputs;
+        std::vector<unsigned long> indices;
+        inputs.reserve(lookupLength);
+        indices.reserve(lookupLength);
+
+        if (lookupLut->isInputHalfDomain())
+        {
+            // A standard domain clamps to [0, 1] so it's only possible when the prefix ops
+            // also clamp i.e. they give the same results below 0 and above 1.
+            static constexpr unsigned long HalfZero = 0x0000;
+            static constexpr unsigned long HalfOne  = 0x3C00;
+
+            for (unsigned long idx = 0; idx < lookupLength; ++idx)
             {
-                // Potentially separable, but inexpensive ops.
-                // TODO: Perhaps a LUT is faster once the conversion to float is considered?
-                case OpData::MatrixType:
-                case OpData::RangeType:
+                half h;
+                h.setBits((unsigned short)idx);
+                if (h.isNan())
                 {
-                    break;
+                    continue;
                 }
 
-                // Potentially separable, and more expensive.
-                default:
+                const float x = h;
+                if (x < 0.0f || x > 1.0f)
+                {
+                    const unsigned long clampedIdx = x < 0.0f ? HalfZero : HalfOne;
+                    for (unsigned long c = 0; c < 3; ++c)
+                    {
+                        if (!IsWithinTolerance(lookupValues[idx * 3 + c],
+                                               lookupValues[clampedIdx * 3 + c],
+                                               tolerance))
+                        {
+                            return Lut1DOpDataRcPtr();
+                        }
+                    }
+                }
+                else
                 {
-                    expensiveOps++;
-                    break;
+                    inputs.push_back(x);
+                    indices.push_back(idx);
                 }
             }
         }
-
-        if (expensiveOps == 0)
+        else
         {
-            return 0;
+            for (unsigned long idx = 0; idx < lookupLength; ++idx)
+            {
+                inputs.push_back(float(idx) / float(lookupLength - 1));
+                indices.push_back(idx);
+            }
         }
 
-        // TODO: The main source of potential lossiness is where there is a 1D LUT
-        // that has extended range values followed by something that clamps.  In
-        // that case, the clamp would get baked into the LUT entries and therefore
-        // result in a different interpolated value.  Could look for that case and
-        // turn off the optimization.
+        // Try the sizes from the smallest, while it saves at least half of the entries.
+        static constexpr unsigned long Sizes[] = { 1024, 4096, 16384 };
 
-        return prefixLen;
+        for (const auto length : Sizes)
+        {
+            if (2 * length > lookupLength)
+            {
+                break;
+            }
+
+            Lut1DOpDataRcPtr lut = std::make_shared<Lut1DOpData>(length);
+            Lut1DOpData::ComposeVec(lut, prefixOps);
+
+            const Array::Values & values = lut->getArray().getValues();
+
+            bool accurate = true;
+            for (size_t i = 0; i < inputs.size() && accurate; ++i)
+            {
+                for (unsigned long c = 0; c < 3; ++c)
+                {
+                    if (!IsWithinTolerance(EvalStandardLut1D(values, length, inputs[i], c),
+                                           lookupValues[indices[i] * 3 + c],
+                                           tolerance))
+                    {
+                        accurate = false;
+                        break;
+                    }
+                }
+            }
+
+            if (accurate)
+            {
+                return lut;
+            }
+        }
+
+        return Lut1DOpDataRcPtr();
     }
+    } // namespace
 
     // Use functional composition to replace a string of separable ops at the head of
-    // the op list with a single 1D LUT that is built to do a look-up for the input bit-depth.
-    void OptimizeSeparablePrefix(OpRcPtrVec & ops, BitDepth in, OptimizationFlags /*oFlags*/)
+    // the op list with a single 1D LUT that is built to do a look-up for the input bit-depth,
+    // or with a smaller LUT when it is accurate enough (refer to FindSmallerPrefixLut()).
+    void OptimizeSeparablePrefix(OpRcPtrVec & ops, BitDepth in, OptimizationFlags oFlags)
     {
         // TODO: Take care of the dynamic properties.
 
@@ -271,8 +730,17 @@ OCIO_NAMESPACE_ENTER
         }
 
         OpRcPtrVec prefixOps;
+        prefixOps.reserve(prefixLen);
+        bool hasInverseLut = false;
         for (unsigned i = 0; i < prefixLen; ++i)
         {
+            ConstOpRcPtr constOp = ops[i];
+            if (constOp->data()->getType() == OpData::Lut1DType &&
+                constOp->getDirection() == TRANSFORM_DIR_INVERSE)
+            {
+                hasInverseLut = true;
+            }
+
             prefixOps.push_back(ops[i]->clone());
         }
 
@@ -283,22 +751,406 @@ OCIO_NAMESPACE_ENTER
         // Note: This sets the outBitDepth of newDomain to match prefixOps.
         Lut1DOpData::ComposeVec(newDomain, prefixOps);
 
-        // Remove the prefix ops.
-        ops.erase(ops.begin(), ops.begin() + prefixLen);
+        // When lossy 1D LUT compositions are allowed, a smaller LUT could be used if
+        // it is accurate enough. The tolerance depends on the requested optimizations
+        // i.e. well below a 16-bit code value unless 3D LUT compositions are allowed.
+        if ((oFlags & OPTIMIZATION_COMP_LUT1D) == OPTIMIZATION_COMP_LUT1D)
+        {
+            const float tolerance
+                = ((oFlags & OPTIMIZATION_COMP_LUT3D) == OPTIMIZATION_COMP_LUT3D) ? 1e-5f
+                                                                                  : 1e-6f;
+
+            ConstLut1DOpDataRcPtr lookupLut = newDomain;
+            Lut1DOpDataRcPtr smallerLut = FindSmallerPrefixLut(lookupLut, prefixOps, tolerance);
+            if (smallerLut)
+            {
+                newDomain = smallerLut;
+            }
+        }
+
+        OpRcPtrVec lutOps;
+        CreateLut1DOp(lutOps, newDomain, TRANSFORM_DIR_FORWARD);
+
+        // Only replace the prefix ops if the LUT is cheaper (refer to Op::getCost()).
+        // Note that the LUT size, hence its cost, depends on the input bit-depth.
+        // An inverse 1D LUT is always replaced as the look-up is then also more accurate
+        // than its fast inverse.
+        if (!hasInverseLut && GetOpVecCost(lutOps) >= GetOpVecCost(prefixOps))
+        {
+            return;
+        }
+
+        // Replace the prefix ops by the new LUT.
+        ops.erase(ops.begin(), ops.begin() + prefixLen);
+        ops.insert(ops.begin(), lutOps.begin(), lutOps.end());
+    }
+
+    void SetBakedLut3DSize(unsigned edgeLen)
+    {
+        if (edgeLen < 2 || edgeLen > Lut3DOpData::maxSupportedLength)
+        {
+            std::ostringstream os;
+            os << "Invalid baked 3D LUT size '" << edgeLen << "', it must be between 2 and ";
+            os << Lut3DOpData::maxSupportedLength << ".";
+            throw Exception(os.str().c_str());
+        }
+
+        g_bakedLut3DSize = edgeLen;
+    }
+
+    unsigned GetBakedLut3DSize()
+    {
+        return g_bakedLut3DSize;
+    }
+
+    namespace
+    {
+    // Is the op list already the result of the baking i.e. an optional 1D LUT
+    // followed by a 3D LUT?
+    bool IsBakedLut3D(const OpRcPtrVec & ops)
+    {
+        if (ops.size() == 1)
+        {
+            ConstOpRcPtr op = ops[0];
+            return op->data()->getType() == OpData::Lut3DType;
+        }
+        else if (ops.size() == 2)
+        {
+            ConstOpRcPtr op0 = ops[0];
+            ConstOpRcPtr op1 = ops[1];
+            return op0->data()->getType() == OpData::Lut1DType
+                && op1->data()->getType() == OpData::Lut3DType;
+        }
+
+        return false;
+    }
+
+    // Get the allocation of the input color space i.e. an allocation NoOp
+    // before any processing op.
+    bool GetInputAllocation(const OpRcPtrVec & ops, AllocationData & allocation)
+    {
+        for (const auto & op : ops)
+        {
+            if (!op->isNoOp())
+            {
+                break;
+            }
+
+            if (GetGpuAllocation(allocation, op))
+            {
+                return allocation.allocation == ALLOCATION_UNIFORM
+                    || allocation.allocation == ALLOCATION_LG2;
+            }
+        }
+
+        return false;
+    }
+    } // namespace
+
+    // Replace the whole list of ops by a shaper 1D LUT followed by a 3D LUT, so the
+    // processing cost of a pixel is fixed whatever the ops are.
+    //
+    // As the 3D LUT domain is [0, 1], an integer input bit-depth does not need any
+    // shaper. For a float input bit-depth, the shaper is the allocation of the input color
+    // space if any, or the default log2 allocation (i.e. [2^-10, 2^6]) otherwise. The shaper
+    // is then a half-domain 1D LUT so that float input pixels are mostly looked-up.
+    void BakeLut3D(OpRcPtrVec & ops, BitDepth in, const AllocationData * inputAllocation)
+    {
+        bool hasCrosstalk = false;
+        for (const auto & op : ops)
+        {
+            // The dynamic properties must still be editable after finalization.
+            if (op->isDynamic())
+            {
+                return;
+            }
+
+            hasCrosstalk = hasCrosstalk || op->hasChannelCrosstalk();
+        }
+
+        // A separable processing is better handled by the 1D LUT optimizations.
+        if (!hasCrosstalk || IsBakedLut3D(ops))
+        {
+            return;
+        }
+
+        OpRcPtrVec shaperOps;
+        OpRcPtrVec latticeOps;
+
+        if (IsFloatBitDepth(in))
+        {
+            AllocationData allocation;
+            if (inputAllocation)
+            {
+                allocation = *inputAllocation;
+            }
+            else
+            {
+                allocation.allocation = ALLOCATION_LG2;
+            }
+
+            CreateAllocationOps(shaperOps, allocation, TRANSFORM_DIR_FORWARD);
+            CreateAllocationOps(latticeOps, allocation, TRANSFORM_DIR_INVERSE);
+        }
+
+        latticeOps.reserve(latticeOps.size() + ops.size());
+        for (const auto & op : ops)
+        {
+            latticeOps.push_back(op->clone());
+        }
+
+        // Send the 3D LUT domain through the inverse shaper and the ops.
+
+        Lut3DOpDataRcPtr lut
+            = std::make_shared<Lut3DOpData>(INTERP_TETRAHEDRAL, g_bakedLut3DSize);
+
+        const long gridSize = lut->getArray().getLength();
+        Array::Values & values = lut->getArray().getValues();
+
+        EvalTransform(&values[0], &values[0], gridSize * gridSize * gridSize, latticeOps);
+
+        OpRcPtrVec bakedOps;
+
+        if (!shaperOps.empty())
+        {
+            Lut1DOpDataRcPtr shaper = Lut1DOpData::MakeLookupDomain(BIT_DEPTH_F16);
+            Lut1DOpData::ComposeVec(shaper, shaperOps);
+
+            CreateLut1DOp(bakedOps, shaper, TRANSFORM_DIR_FORWARD);
+        }
+
+        CreateLut3DOp(bakedOps, lut, TRANSFORM_DIR_FORWARD);
+
+        ops = std::move(bakedOps);
+    }
+
+    // Replace each 3D LUT by its smallest accurate sub-grid, if any (refer to
+    // Lut3DOpData::makeCompact()).
+    void CompactLut3Ds(OpRcPtrVec & ops, OptimizationFlags oFlags)
+    {
+        const float tolerance
+            = ((oFlags & OPTIMIZATION_COMP_LUT3D) == OPTIMIZATION_COMP_LUT3D) ? 1e-5f : 1e-6f;
+
+        for (auto & op : ops)
+        {
+            ConstOpRcPtr constOp = op;
+            if (constOp->data()->getType() != OpData::Lut3DType
+                || constOp->getDirection() != TRANSFORM_DIR_FORWARD)
+            {
+                continue;
+            }
+
+            ConstLut3DOpDataRcPtr lut = DynamicPtrCast<const Lut3DOpData>(constOp->data());
+
+            Lut3DOpDataRcPtr compactLut = lut->makeCompact(tolerance);
+            if (compactLut)
+            {
+                OpRcPtrVec compactOps;
+                CreateLut3DOp(compactOps, compactLut, TRANSFORM_DIR_FORWARD);
+                op = compactOps[0];
+            }
+        }
+    }
+
+    void SetApproximationMaxError(double maxError)
+    {
+        if (!(maxError > 0.0 && maxError < 1.0))
+        {
+            std::ostringstream os;
+            os << "Invalid approximation maximum error '" << maxError;
+            os << "', it must be greater than 0 and less than 1.";
+            throw Exception(os.str().c_str());
+        }
+
+        g_approximationMaxError = maxError;
+    }
+
+    double GetApproximationMaxError()
+    {
+        return g_approximationMaxError;
+    }
+
+    namespace
+    {
+    // Does the op only depend on the input values clamped to [0, 1] i.e. a forward 1D LUT
+    // with a standard domain, or a range clamping into [0, 1]?
+    bool ClampsToUnitDomain(ConstOpRcPtr & op)
+    {
+        if (op->getDirection() != TRANSFORM_DIR_FORWARD)
+        {
+            return false;
+        }
+
+        if (op->data()->getType() == OpData::Lut1DType)
+        {
+            ConstLut1DOpDataRcPtr lut = DynamicPtrCast<const Lut1DOpData>(op->data());
+            return !lut->isInputHalfDomain();
+        }
+        else if (op->data()->getType() == OpData::RangeType)
+        {
+            ConstRangeOpDataRcPtr range = DynamicPtrCast<const RangeOpData>(op->data());
+            return !range->minIsEmpty() && !range->maxIsEmpty()
+                && range->getMinInValue() >= 0.0 && range->getMaxInValue() <= 1.0;
+        }
+
+        return false;
+    }
+
+    // Find the smallest 1D LUT with a standard domain (i.e. a piecewise linear curve with
+    // uniform knots) whose interpolation reproduces the segment ops within the maximum
+    // error at each 16-bit input value, and set the measured error. Return null if there
+    // is none.
+    Lut1DOpDataRcPtr FitSegmentLut(OpRcPtrVec & segmentOps, double maxError,
+                                   double & measuredError)
+    {
+        Lut1DOpDataRcPtr reference = Lut1DOpData::MakeLookupDomain(BIT_DEPTH_UINT16);
+        Lut1DOpData::ComposeVec(reference, segmentOps);
+
+        const Array::Values & refValues = reference->getArray().getValues();
+        const unsigned long refLength = reference->getArray().getLength();
+
+        for (unsigned long length = 5; length <= 4097; length = 2 * length - 1)
+        {
+            Lut1DOpDataRcPtr lut = std::make_shared<Lut1DOpData>(length);
+            Lut1DOpData::ComposeVec(lut, segmentOps);
+
+            const Array::Values & values = lut->getArray().getValues();
+
+            double error = 0.0;
+            for (unsigned long idx = 0; idx < refLength && error <= maxError; ++idx)
+            {
+                const float x = float(idx) / float(refLength - 1);
+                for (unsigned long c = 0; c < 3; ++c)
+                {
+                    const float expected = refValues[idx * 3 + c];
+                    const double diff = std::fabs(EvalStandardLut1D(values, length, x, c)
+                                                  - expected);
+
+                    // Absolute error below one, and relative error above.
+                    // Note that a NaN is never within the maximum error.
+                    const double relDiff = diff / std::max(1.0f, std::fabs(expected));
+                    error = (relDiff <= error) ? error : relDiff;
+                }
+            }
+
+            if (error <= maxError)
+            {
+                measuredError = error;
+                return lut;
+            }
+        }
+
+        return Lut1DOpDataRcPtr();
+    }
+    } // namespace
+
+    // Replace each string of separable ops starting with an op clamping to [0, 1] (e.g. a
+    // stack of 1D LUTs, logs and gammas) by a piecewise linear curve i.e. a small 1D LUT
+    // fitted within the maximum error (refer to SetApproximationMaxError()), when it is
+    // cheaper. Return the largest measured error, or a negative value if nothing changed.
+    double ApproximateSeparableSegments(OpRcPtrVec & ops)
+    {
+        const double maxError = GetApproximationMaxError();
+        double largestError = -1.0;
+
+        for (size_t start = 0; start < ops.size(); ++start)
+        {
+            ConstOpRcPtr first = ops[start];
+            if (first->hasChannelCrosstalk() || first->isDynamic() || !ClampsToUnitDomain(first))
+            {
+                continue;
+            }
+
+            size_t end = start + 1;
+            while (end < ops.size() && !ops[end]->hasChannelCrosstalk() && !ops[end]->isDynamic())
+            {
+                ++end;
+            }
+
+            OpRcPtrVec originalOps;
+            OpRcPtrVec segmentOps;
+            segmentOps.reserve(end - start);
+            for (size_t idx = start; idx < end; ++idx)
+            {
+                originalOps.push_back(ops[idx]);
+                segmentOps.push_back(ops[idx]->clone());
+            }
+
+            // Note that the following ops of a segment which could not be approximated
+            // are not tried, as the fitting is costly.
+            double error = 0.0;
+            Lut1DOpDataRcPtr lut = FitSegmentLut(segmentOps, maxError, error);
+            if (!lut)
+            {
+                start = end - 1;
+                continue;
+            }
+
+            OpRcPtrVec lutOps;
+            CreateLut1DOp(lutOps, lut, TRANSFORM_DIR_FORWARD);
+
+            if (GetOpVecCost(lutOps) >= GetOpVecCost(originalOps))
+            {
+                start = end - 1;
+                continue;
+            }
+
+            ops.erase(ops.begin() + start, ops.begin() + end);
+            ops.insert(ops.begin() + start, lutOps.begin(), lutOps.end());
+
+            largestError = std::max(largestError, error);
+        }
+
+        return largestError;
+    }
+
+    namespace
+    {
+
+    // Lists the optimization passes which changed the ops i.e. when their result is
+    // not the same op instances. It does nothing if the list is null.
+    class PassReport
+    {
+    public:
+        explicit PassReport(StringVec * passes) : m_passes(passes) { }
+
+        void start(const OpRcPtrVec & ops)
+        {
+            if (m_passes)
+            {
+                m_before.assign(ops.begin(), ops.end());
+            }
+        }
+
+        void end(const char * name, const OpRcPtrVec & ops)
+        {
+            if (!m_passes
+                || (m_before.size() == ops.size()
+                    && std::equal(m_before.begin(), m_before.end(), ops.begin())))
+            {
+                return;
+            }
+
+            std::ostringstream oss;
+            oss << name << ": " << ops.size() << " ops";
+            m_passes->push_back(oss.str());
+        }
 
-        // Insert the new LUT to replace the prefix ops.
-        OpRcPtrVec lutOps;
-        CreateLut1DOp(lutOps, newDomain, TRANSFORM_DIR_FORWARD);
+    private:
+        StringVec * m_passes;
+        std::vector<OpRcPtr> m_before;
+    };
 
-        ops.insert(ops.begin(), lutOps.begin(), lutOps.end());
     }
 
     void OptimizeOpVec(OpRcPtrVec & ops, const BitDepth & inBitDepth,
-                       OptimizationFlags oFlags)
+                       OptimizationFlags oFlags, StringVec * passes)
     {
         if (ops.empty())
             return;
 
+        TracingSpan span("processor", "OptimizeOpVec");
+
         if (IsDebugLoggingEnabled())
         {
             LogDebug("Optimizing Op Vec...");
@@ -309,17 +1161,39 @@ OCIO_NAMESPACE_ENTER
         // request and they may be altered by the following optimizations,
         // preserve their values.
 
+        // The ops removal loses the allocation of the input color space.
+        AllocationData inputAllocation;
+        const bool hasInputAllocation = GetInputAllocation(ops, inputAllocation);
+
         OpRcPtrVec::size_type originalSize = ops.size();
         int total_noops                    = 0;
         int total_inverseops               = 0;
         int total_combines                 = 0;
-        int passes                         = 0;
+        int numPasses                      = 0;
 
-        while (passes <= MAX_OPTIMIZATION_PASSES)
+        PassReport report(passes);
+
+        while (numPasses <= MAX_OPTIMIZATION_PASSES)
         {
-            int noops      = RemoveNoOps(ops);
-            int inverseops = RemoveInverseOps(ops);
-            int combines   = CombineOps(ops);
+            report.start(ops);
+            const int noops = RemoveNoOps(ops);
+            report.end("RemoveNoOps", ops);
+
+            report.start(ops);
+            const int inverseops = RemoveInverseOps(ops);
+            report.end("RemoveInverseOps", ops);
+
+            report.start(ops);
+            int combines = CombineOps(ops);
+            report.end("CombineOps", ops);
+
+            report.start(ops);
+            combines += FoldMatricesAndRangesIntoLuts(ops);
+            report.end("FoldMatricesAndRangesIntoLuts", ops);
+
+            report.start(ops);
+            combines += FoldRangeScalesIntoMatrices(ops);
+            report.end("FoldRangeScalesIntoMatrices", ops);
 
             if (noops == 0 && inverseops == 0 && combines == 0)
             {
@@ -331,24 +1205,49 @@ OCIO_NAMESPACE_ENTER
             total_inverseops += inverseops;
             total_combines += combines;
 
-            ++passes;
+            ++numPasses;
         }
 
         if (!ops.empty())
         {
+            if((oFlags & OPTIMIZATION_COMPACT_LUT3D) == OPTIMIZATION_COMPACT_LUT3D)
+            {
+                report.start(ops);
+                CompactLut3Ds(ops, oFlags);
+                report.end("CompactLut3Ds", ops);
+            }
+
+            if((oFlags & OPTIMIZATION_APPROX_SEPARABLE) == OPTIMIZATION_APPROX_SEPARABLE)
+            {
+                report.start(ops);
+                const double error = ApproximateSeparableSegments(ops);
+                std::ostringstream name;
+                name << "ApproximateSeparableSegments (max error " << error << ")";
+                report.end(name.str().c_str(), ops);
+            }
+
+            if((oFlags & OPTIMIZATION_BAKE_LUT3D) == OPTIMIZATION_BAKE_LUT3D)
+            {
+                report.start(ops);
+                BakeLut3D(ops, inBitDepth, hasInputAllocation ? &inputAllocation : nullptr);
+                report.end("BakeLut3D", ops);
+            }
+
             if((oFlags & OPTIMIZATION_COMP_SEPARABLE_PREFIX)
                     == OPTIMIZATION_COMP_SEPARABLE_PREFIX)
             {
+                report.start(ops);
                 OptimizeSeparablePrefix(ops, inBitDepth, oFlags);
+                report.end("OptimizeSeparablePrefix", ops);
             }
         }
 
         OpRcPtrVec::size_type finalSize = ops.size();
 
-        if (passes == MAX_OPTIMIZATION_PASSES)
+        if (numPasses == MAX_OPTIMIZATION_PASSES && IsDebugLoggingEnabled())
         {
             std::ostringstream os;
-            os << "The max number of passes, " << passes << ", ";
+            os << "The max number of passes, " << numPasses << ", ";
             os << "was reached during optimization. This is likely a sign ";
             os << "that either the complexity of the color transform is ";
             os << "very high, or that some internal optimizers are in conflict ";
@@ -361,7 +1260,7 @@ OCIO_NAMESPACE_ENTER
             std::ostringstream os;
             os << "Optimized ";
             os << originalSize << "->" << finalSize << ", ";
-            os << passes << " passes, ";
+            os << numPasses << " passes, ";
             os << total_noops << " noops removed, ";
             os << total_inverseops << " inverse ops removed\n";
             os << total_combines << " ops combines\n";
@@ -382,7 +1281,9 @@ OCIO_NAMESPACE_EXIT
 #include "ops/Exponent/ExponentOps.h"
 #include "ops/Gamma/GammaOps.h"
 #include "ops/Log/LogOps.h"
+#include "ops/Lut3D/Lut3DOpData.h"
 #include "ops/Matrix/MatrixOps.h"
+#include "ops/NoOp/NoOps.h"
 #include "ops/Range/RangeOps.h"
 #include "ops/exposurecontrast/ExposureContrastOps.h"
 
@@ -696,6 +1597,336 @@ OCIO_ADD_TEST(OptimizeSeparablePrefix, multi_op_prefix)
     compareRender(originalOps, optimizedOps, __LINE__);
 }
 
+OCIO_ADD_TEST(OptimizeSeparablePrefix, cost_model)
+{
+    // The ops are only replaced by a look-up when it is cheaper.
+
+    const double scale4[4] = { 2.0, 2.0, 2.0, 1.0 };
+    const double exp4[4]   = { 1.8, 1.8, 1.8, 1.0 };
+
+    OCIO::OpRcPtrVec diagonalOps;
+    OCIO::CreateScaleOp(diagonalOps, scale4, OCIO::TRANSFORM_DIR_FORWARD);
+
+    OCIO::OpRcPtrVec exponentOps;
+    OCIO::CreateExponentOp(exponentOps, exp4, OCIO::TRANSFORM_DIR_FORWARD);
+
+    OCIO::Lut1DOpDataRcPtr lut8 = OCIO::Lut1DOpData::MakeLookupDomain(OCIO::BIT_DEPTH_UINT8);
+    OCIO::OpRcPtrVec lut8Ops;
+    OCIO::CreateLut1DOp(lut8Ops, lut8, OCIO::TRANSFORM_DIR_FORWARD);
+
+    OCIO::Lut1DOpDataRcPtr lut16 = OCIO::Lut1DOpData::MakeLookupDomain(OCIO::BIT_DEPTH_UINT16);
+    OCIO::OpRcPtrVec lut16Ops;
+    OCIO::CreateLut1DOp(lut16Ops, lut16, OCIO::TRANSFORM_DIR_FORWARD);
+
+    OCIO_REQUIRE_EQUAL(diagonalOps.size(), 1U);
+    OCIO_REQUIRE_EQUAL(exponentOps.size(), 1U);
+    OCIO_REQUIRE_EQUAL(lut8Ops.size(), 1U);
+    OCIO_REQUIRE_EQUAL(lut16Ops.size(), 1U);
+
+    // A large LUT is more expensive because of the cache misses.
+    OCIO_CHECK_LT(OCIO::GetOpVecCost(diagonalOps), OCIO::GetOpVecCost(lut8Ops));
+    OCIO_CHECK_LT(OCIO::GetOpVecCost(lut8Ops), OCIO::GetOpVecCost(lut16Ops));
+    OCIO_CHECK_LT(OCIO::GetOpVecCost(lut16Ops), OCIO::GetOpVecCost(exponentOps));
+
+    OCIO_CHECK_EQUAL(OCIO::GetLutMemoryCost(256 * 3 * sizeof(float)), 0.0);
+    OCIO_CHECK_LT(OCIO::GetLutMemoryCost(65536 * 3 * sizeof(float)),
+                  OCIO::GetLutMemoryCost(65 * 65 * 65 * 4 * sizeof(float)));
+
+    // Three cheap ops are not replaced by a 256 entries LUT.
+    {
+        OCIO::OpRcPtrVec ops;
+        OCIO::CreateScaleOp(ops, scale4, OCIO::TRANSFORM_DIR_FORWARD);
+        OCIO::CreateRangeOp(ops, 0., 1., 0., 1., OCIO::TRANSFORM_DIR_FORWARD);
+        OCIO::CreateScaleOp(ops, scale4, OCIO::TRANSFORM_DIR_INVERSE);
+        OCIO_REQUIRE_EQUAL(ops.size(), 3U);
+        OCIO_CHECK_LT(OCIO::GetOpVecCost(ops), OCIO::GetOpVecCost(lut8Ops));
+
+        OCIO_CHECK_NO_THROW(OCIO::OptimizeSeparablePrefix(ops,
+                                                          OCIO::BIT_DEPTH_UINT8,
+                                                          OCIO::OPTIMIZATION_VERY_GOOD));
+        OCIO_CHECK_EQUAL(ops.size(), 3U);
+    }
+
+    // The exponent is more expensive than a 65536 entries LUT.
+    {
+        OCIO::OpRcPtrVec ops = exponentOps;
+        OCIO_CHECK_NO_THROW(OCIO::OptimizeSeparablePrefix(ops,
+                                                          OCIO::BIT_DEPTH_UINT16,
+                                                          OCIO::OPTIMIZATION_VERY_GOOD));
+        OCIO_REQUIRE_EQUAL(ops.size(), 1U);
+        OCIO::ConstOpRcPtr o = ops[0];
+        OCIO_CHECK_EQUAL(o->data()->getType(), OCIO::OpData::Lut1DType);
+        OCIO_CHECK_LT(OCIO::GetOpVecCost(ops), OCIO::GetOpVecCost(exponentOps));
+    }
+}
+
+OCIO_ADD_TEST(OptimizeSeparablePrefix, adaptive_size)
+{
+    // A smooth function does not need a look-up of all the 16-bit values.
+
+    const double exp4[4] = { 2.2, 2.2, 2.2, 1.0 };
+
+    OCIO::OpRcPtrVec originalOps;
+    OCIO::CreateExponentOp(originalOps, exp4, OCIO::TRANSFORM_DIR_FORWARD);
+
+    OCIO::OpRcPtrVec optimizedOps = originalOps;
+    OCIO_CHECK_NO_THROW(OCIO::OptimizeSeparablePrefix(optimizedOps,
+                                                      OCIO::BIT_DEPTH_UINT16,
+                                                      OCIO::OPTIMIZATION_VERY_GOOD));
+    OCIO_REQUIRE_EQUAL(optimizedOps.size(), 1U);
+    {
+        OCIO::ConstOpRcPtr o = optimizedOps[0];
+        OCIO::ConstLut1DOpDataRcPtr lut = OCIO::DynamicPtrCast<const OCIO::Lut1DOpData>(o->data());
+        OCIO_REQUIRE_ASSERT(lut);
+        OCIO_CHECK_ASSERT(!lut->isInputHalfDomain());
+        OCIO_CHECK_LT(lut->getArray().getLength(), 65536U);
+    }
+
+    OCIO_CHECK_NO_THROW(FinalizeOpVec(originalOps, OCIO::FINALIZATION_EXACT));
+    OCIO_CHECK_NO_THROW(FinalizeOpVec(optimizedOps, OCIO::FINALIZATION_EXACT));
+    compareRender(originalOps, optimizedOps, __LINE__);
+
+    // Without lossy 1D LUT compositions, it is still a look-up.
+    optimizedOps = originalOps;
+    OCIO_CHECK_NO_THROW(OCIO::OptimizeSeparablePrefix(
+        optimizedOps, OCIO::BIT_DEPTH_UINT16,
+        (OCIO::OptimizationFlags)(OCIO::OPTIMIZATION_LOSSLESS
+                                  | OCIO::OPTIMIZATION_COMP_SEPARABLE_PREFIX)));
+    OCIO_REQUIRE_EQUAL(optimizedOps.size(), 1U);
+    {
+        OCIO::ConstOpRcPtr o = optimizedOps[0];
+        OCIO::ConstLut1DOpDataRcPtr lut = OCIO::DynamicPtrCast<const OCIO::Lut1DOpData>(o->data());
+        OCIO_REQUIRE_ASSERT(lut);
+        OCIO_CHECK_EQUAL(lut->getArray().getLength(), 65536U);
+    }
+
+    // For a half input, the values above one are only handled by a half-domain.
+    optimizedOps = originalOps;
+    OCIO_CHECK_NO_THROW(OCIO::OptimizeSeparablePrefix(optimizedOps,
+                                                      OCIO::BIT_DEPTH_F16,
+                                                      OCIO::OPTIMIZATION_VERY_GOOD));
+    OCIO_REQUIRE_EQUAL(optimizedOps.size(), 1U);
+    {
+        OCIO::ConstOpRcPtr o = optimizedOps[0];
+        OCIO::ConstLut1DOpDataRcPtr lut = OCIO::DynamicPtrCast<const OCIO::Lut1DOpData>(o->data());
+        OCIO_REQUIRE_ASSERT(lut);
+        OCIO_CHECK_ASSERT(lut->isInputHalfDomain());
+    }
+
+    // Unless the ops clamp to [0, 1].
+    OCIO::OpRcPtrVec clampedOps;
+    OCIO::CreateRangeOp(clampedOps, 0., 1., 0., 1., OCIO::TRANSFORM_DIR_FORWARD);
+    OCIO::CreateExponentOp(clampedOps, exp4, OCIO::TRANSFORM_DIR_FORWARD);
+
+    optimizedOps = clampedOps;
+    OCIO_CHECK_NO_THROW(OCIO::OptimizeSeparablePrefix(optimizedOps,
+                                                      OCIO::BIT_DEPTH_F16,
+                                                      OCIO::OPTIMIZATION_VERY_GOOD));
+    OCIO_REQUIRE_EQUAL(optimizedOps.size(), 1U);
+    {
+        OCIO::ConstOpRcPtr o = optimizedOps[0];
+        OCIO::ConstLut1DOpDataRcPtr lut = OCIO::DynamicPtrCast<const OCIO::Lut1DOpData>(o->data());
+        OCIO_REQUIRE_ASSERT(lut);
+        OCIO_CHECK_ASSERT(!lut->isInputHalfDomain());
+        OCIO_CHECK_LT(lut->getArray().getLength(), 65536U);
+    }
+
+    OCIO_CHECK_NO_THROW(FinalizeOpVec(clampedOps, OCIO::FINALIZATION_EXACT));
+    OCIO_CHECK_NO_THROW(FinalizeOpVec(optimizedOps, OCIO::FINALIZATION_EXACT));
+    compareRender(clampedOps, optimizedOps, __LINE__);
+}
+
+OCIO_ADD_TEST(OpOptimizers, fold_into_luts)
+{
+    // Square the values of an identity 1D LUT.
+    OCIO::Lut1DOpDataRcPtr lut1d = std::make_shared<OCIO::Lut1DOpData>(256);
+    for (auto & v : lut1d->getArray().getValues())
+    {
+        v = v * v;
+    }
+
+    // Square the values of an identity 3D LUT, and add some crosstalk.
+    OCIO::Lut3DOpDataRcPtr lut3d = std::make_shared<OCIO::Lut3DOpData>(5);
+    OCIO::Array::Values & values3d = lut3d->getArray().getValues();
+    for (size_t idx = 0; idx < values3d.size(); idx += 3)
+    {
+        const float r = values3d[idx];
+        values3d[idx]     = r * r;
+        values3d[idx + 1] = 0.8f * values3d[idx + 1] + 0.2f * r;
+    }
+
+    const double scale4[4]  = { 1.5, 0.5, 2.0, 1.0 };
+    const double offset4[4] = { 0.1, -0.2, 0.0, 0.0 };
+    const double m44[16] = { 0.80, 0.15, 0.05, 0.0,
+                             0.10, 0.85, 0.05, 0.0,
+                             0.02, 0.08, 0.90, 0.0,
+                             0.00, 0.00, 0.00, 1.0 };
+
+    // A following diagonal matrix is baked into the 1D LUT.
+    {
+        OCIO::OpRcPtrVec ops;
+        OCIO::CreateLut1DOp(ops, lut1d, OCIO::TRANSFORM_DIR_FORWARD);
+        OCIO::CreateScaleOffsetOp(ops, scale4, offset4, OCIO::TRANSFORM_DIR_FORWARD);
+
+        OCIO::OpRcPtrVec optimizedOps = ops;
+        OCIO_CHECK_NO_THROW(OCIO::OptimizeOpVec(optimizedOps, OCIO::BIT_DEPTH_F32,
+                                                OCIO::OPTIMIZATION_DEFAULT));
+        OCIO_REQUIRE_EQUAL(optimizedOps.size(), 1U);
+        OCIO::ConstOpRcPtr o = optimizedOps[0];
+        OCIO_CHECK_EQUAL(o->data()->getType(), OCIO::OpData::Lut1DType);
+
+        OCIO_CHECK_NO_THROW(FinalizeOpVec(ops, OCIO::FINALIZATION_EXACT));
+        OCIO_CHECK_NO_THROW(FinalizeOpVec(optimizedOps, OCIO::FINALIZATION_EXACT));
+        compareRender(ops, optimizedOps, __LINE__);
+    }
+
+    // But not a matrix with crosstalk.
+    {
+        OCIO::OpRcPtrVec ops;
+        OCIO::CreateLut1DOp(ops, lut1d, OCIO::TRANSFORM_DIR_FORWARD);
+        OCIO::CreateMatrixOp(ops, m44, OCIO::TRANSFORM_DIR_FORWARD);
+
+        OCIO_CHECK_NO_THROW(OCIO::OptimizeOpVec(ops, OCIO::BIT_DEPTH_F32,
+                                                OCIO::OPTIMIZATION_DEFAULT));
+        OCIO_CHECK_EQUAL(ops.size(), 2U);
+    }
+
+    // Any following matrix is baked into the 3D LUT.
+    {
+        OCIO::OpRcPtrVec ops;
+        OCIO::CreateLut3DOp(ops, lut3d, OCIO::TRANSFORM_DIR_FORWARD);
+        OCIO::CreateMatrixOp(ops, m44, OCIO::TRANSFORM_DIR_INVERSE);
+
+        OCIO::OpRcPtrVec optimizedOps = ops;
+        OCIO_CHECK_NO_THROW(OCIO::OptimizeOpVec(optimizedOps, OCIO::BIT_DEPTH_F32,
+                                                OCIO::OPTIMIZATION_DEFAULT));
+        OCIO_REQUIRE_EQUAL(optimizedOps.size(), 1U);
+        OCIO::ConstOpRcPtr o = optimizedOps[0];
+        OCIO_CHECK_EQUAL(o->data()->getType(), OCIO::OpData::Lut3DType);
+
+        OCIO_CHECK_NO_THROW(FinalizeOpVec(ops, OCIO::FINALIZATION_EXACT));
+        OCIO_CHECK_NO_THROW(FinalizeOpVec(optimizedOps, OCIO::FINALIZATION_EXACT));
+        compareRender(ops, optimizedOps, __LINE__);
+    }
+
+    // A following range is baked into the LUT when it does not clamp the LUT values.
+    {
+        OCIO::OpRcPtrVec ops;
+        OCIO::CreateLut3DOp(ops, lut3d, OCIO::TRANSFORM_DIR_FORWARD);
+        OCIO::CreateRangeOp(ops, 0., 1., 0.25, 0.75, OCIO::TRANSFORM_DIR_FORWARD);
+
+        OCIO::OpRcPtrVec optimizedOps = ops;
+        OCIO_CHECK_NO_THROW(OCIO::OptimizeOpVec(optimizedOps, OCIO::BIT_DEPTH_F32,
+                                                OCIO::OPTIMIZATION_DEFAULT));
+        OCIO_REQUIRE_EQUAL(optimizedOps.size(), 1U);
+
+        OCIO_CHECK_NO_THROW(FinalizeOpVec(ops, OCIO::FINALIZATION_EXACT));
+        OCIO_CHECK_NO_THROW(FinalizeOpVec(optimizedOps, OCIO::FINALIZATION_EXACT));
+        compareRender(ops, optimizedOps, __LINE__);
+    }
+    {
+        OCIO::OpRcPtrVec ops;
+        OCIO::CreateLut1DOp(ops, lut1d, OCIO::TRANSFORM_DIR_FORWARD);
+        OCIO::CreateRangeOp(ops, 0.5, 1., 0.5, 1., OCIO::TRANSFORM_DIR_FORWARD);
+
+        OCIO_CHECK_NO_THROW(OCIO::OptimizeOpVec(ops, OCIO::BIT_DEPTH_F32,
+                                                OCIO::OPTIMIZATION_DEFAULT));
+        OCIO_CHECK_EQUAL(ops.size(), 2U);
+    }
+
+    // A preceding range is removed when the LUT does the same clamp.
+    {
+        OCIO::OpRcPtrVec ops;
+        OCIO::CreateRangeOp(ops, 0., 1., 0., 1., OCIO::TRANSFORM_DIR_FORWARD);
+        OCIO::CreateLut1DOp(ops, lut1d, OCIO::TRANSFORM_DIR_FORWARD);
+
+        OCIO::OpRcPtrVec optimizedOps = ops;
+        OCIO_CHECK_NO_THROW(OCIO::OptimizeOpVec(optimizedOps, OCIO::BIT_DEPTH_F32,
+                                                OCIO::OPTIMIZATION_DEFAULT));
+        OCIO_REQUIRE_EQUAL(optimizedOps.size(), 1U);
+        OCIO::ConstOpRcPtr o = optimizedOps[0];
+        OCIO_CHECK_EQUAL(o->data()->getType(), OCIO::OpData::Lut1DType);
+
+        OCIO_CHECK_NO_THROW(FinalizeOpVec(ops, OCIO::FINALIZATION_EXACT));
+        OCIO_CHECK_NO_THROW(FinalizeOpVec(optimizedOps, OCIO::FINALIZATION_EXACT));
+        compareRender(ops, optimizedOps, __LINE__);
+    }
+
+    // But not a range that scales.
+    {
+        OCIO::OpRcPtrVec ops;
+        OCIO::CreateRangeOp(ops, 0.1, 0.9, 0., 1., OCIO::TRANSFORM_DIR_FORWARD);
+        OCIO::CreateLut3DOp(ops, lut3d, OCIO::TRANSFORM_DIR_FORWARD);
+
+        OCIO_CHECK_NO_THROW(OCIO::OptimizeOpVec(ops, OCIO::BIT_DEPTH_F32,
+                                                OCIO::OPTIMIZATION_DEFAULT));
+        OCIO_CHECK_EQUAL(ops.size(), 2U);
+    }
+}
+
+OCIO_ADD_TEST(OpOptimizers, fold_range_scales_into_matrices)
+{
+    const double m44[16] = { 0.80, 0.15, 0.05, 0.0,
+                             0.10, 0.85, 0.05, 0.0,
+                             0.02, 0.08, 0.90, 0.0,
+                             0.00, 0.00, 0.00, 1.0 };
+
+    // The scale of a range between two matrices is folded into the first matrix.
+    for (auto dir : { OCIO::TRANSFORM_DIR_FORWARD, OCIO::TRANSFORM_DIR_INVERSE })
+    {
+        OCIO::OpRcPtrVec ops;
+        OCIO::CreateMatrixOp(ops, m44, OCIO::TRANSFORM_DIR_FORWARD);
+        OCIO::CreateRangeOp(ops, 0.1, 0.9, -0.5, 1.5, dir);
+        OCIO::CreateMatrixOp(ops, m44, OCIO::TRANSFORM_DIR_INVERSE);
+
+        OCIO::OpRcPtrVec optimizedOps = ops;
+        OCIO_CHECK_NO_THROW(OCIO::OptimizeOpVec(optimizedOps, OCIO::BIT_DEPTH_F32,
+                                                OCIO::OPTIMIZATION_DEFAULT));
+        OCIO_REQUIRE_EQUAL(optimizedOps.size(), 3U);
+        OCIO::ConstOpRcPtr o0 = optimizedOps[0];
+        OCIO::ConstOpRcPtr o1 = optimizedOps[1];
+        OCIO::ConstOpRcPtr o2 = optimizedOps[2];
+        OCIO_CHECK_EQUAL(o0->data()->getType(), OCIO::OpData::MatrixType);
+        OCIO_REQUIRE_EQUAL(o1->data()->getType(), OCIO::OpData::RangeType);
+        OCIO_CHECK_EQUAL(o2->data()->getType(), OCIO::OpData::MatrixType);
+
+        // Only the clamp is left.
+        OCIO::ConstRangeOpDataRcPtr range
+            = OCIO::DynamicPtrCast<const OCIO::RangeOpData>(o1->data());
+        OCIO_CHECK_EQUAL(o1->getDirection(), OCIO::TRANSFORM_DIR_FORWARD);
+        OCIO_CHECK_ASSERT(!range->scales());
+        if (dir == OCIO::TRANSFORM_DIR_FORWARD)
+        {
+            OCIO_CHECK_EQUAL(range->getMinInValue(), -0.5);
+            OCIO_CHECK_EQUAL(range->getMaxInValue(), 1.5);
+        }
+        else
+        {
+            OCIO_CHECK_EQUAL(range->getMinInValue(), 0.1);
+            OCIO_CHECK_EQUAL(range->getMaxInValue(), 0.9);
+        }
+
+        OCIO_CHECK_NO_THROW(FinalizeOpVec(ops, OCIO::FINALIZATION_EXACT));
+        OCIO_CHECK_NO_THROW(FinalizeOpVec(optimizedOps, OCIO::FINALIZATION_EXACT));
+        compareRender(ops, optimizedOps, __LINE__);
+    }
+
+    // But not a range next to only one matrix.
+    {
+        OCIO::OpRcPtrVec ops;
+        OCIO::CreateMatrixOp(ops, m44, OCIO::TRANSFORM_DIR_FORWARD);
+        OCIO::CreateRangeOp(ops, 0.1, 0.9, -0.5, 1.5, OCIO::TRANSFORM_DIR_FORWARD);
+
+        OCIO_CHECK_NO_THROW(OCIO::OptimizeOpVec(ops, OCIO::BIT_DEPTH_F32,
+                                                OCIO::OPTIMIZATION_DEFAULT));
+        OCIO_REQUIRE_EQUAL(ops.size(), 2U);
+        OCIO::ConstOpRcPtr o = ops[1];
+        OCIO::ConstRangeOpDataRcPtr range
+            = OCIO::DynamicPtrCast<const OCIO::RangeOpData>(o->data());
+        OCIO_CHECK_ASSERT(range->scales());
+    }
+}
+
 OCIO_ADD_TEST(OptimizeSeparablePrefix, op_with_dyn_properties)
 {
     // Test prefix optimization of a complex transform.
@@ -748,6 +1979,343 @@ OCIO_ADD_TEST(OptimizeSeparablePrefix, op_with_dyn_properties)
     OCIO_CHECK_ASSERT(exp->isDynamic());
 }
 
+namespace
+{
+
+// Processed by the ops, the values are not on the baked 3D LUT lattice.
+const std::vector<float> bakeInputs = {
+    0.0130f, 0.2500f, 0.7770f, 1.0f,
+    0.5100f, 0.5400f, 0.5800f, 0.5f,
+    0.9370f, 0.0420f, 0.3310f, 0.0f,
+    0.6103f, 0.9001f, 0.1207f, 1.0f };
+
+// A matrix with crosstalk followed by a gamma.
+void CreateBakeTestOps(OCIO::OpRcPtrVec & ops)
+{
+    const double m44[16] = { 0.80, 0.15, 0.05, 0.0,
+                             0.10, 0.85, 0.05, 0.0,
+                             0.02, 0.08, 0.90, 0.0,
+                             0.00, 0.00, 0.00, 1.0 };
+    OCIO::CreateMatrixOp(ops, m44, OCIO::TRANSFORM_DIR_FORWARD);
+
+    const double exp4[4] = { 1.8, 1.8, 1.8, 1.0 };
+    OCIO::CreateExponentOp(ops, exp4, OCIO::TRANSFORM_DIR_FORWARD);
+}
+
+// Note that a negative error is a relative error.
+void compareBakedRender(OCIO::OpRcPtrVec ops1, OCIO::OpRcPtrVec ops2,
+                        const std::vector<float> & inputs, float error, unsigned line)
+{
+    OCIO_CHECK_NO_THROW_FROM(FinalizeOpVec(ops1, OCIO::FINALIZATION_EXACT), line);
+    OCIO_CHECK_NO_THROW_FROM(FinalizeOpVec(ops2, OCIO::FINALIZATION_EXACT), line);
+
+    std::vector<float> img1 = inputs;
+    std::vector<float> img2 = inputs;
+
+    const long numPixels = long(inputs.size() / 4);
+
+    for (const auto & op : ops1)
+    {
+        op->apply(&img1[0], &img1[0], numPixels);
+    }
+
+    for (const auto & op : ops2)
+    {
+        op->apply(&img2[0], &img2[0], numPixels);
+    }
+
+    for (size_t idx = 0; idx < img1.size(); ++idx)
+    {
+        const float absError = error < 0.0f ? -error * std::max(1.0f, std::fabs(img1[idx]))
+                                            : error;
+        OCIO_CHECK_CLOSE_FROM(img1[idx], img2[idx], absError, line);
+    }
+}
+
+} // namespace
+
+OCIO_ADD_TEST(BakeLut3D, integer_input)
+{
+    OCIO::OpRcPtrVec originalOps;
+    CreateBakeTestOps(originalOps);
+
+    OCIO::OpRcPtrVec optimizedOps = originalOps;
+    OCIO_CHECK_NO_THROW(OCIO::OptimizeOpVec(optimizedOps, OCIO::BIT_DEPTH_UINT10,
+                                            OCIO::OPTIMIZATION_BAKE_LUT3D));
+
+    // The 3D LUT domain already is the input integer domain i.e. no shaper.
+    OCIO_REQUIRE_EQUAL(optimizedOps.size(), 1U);
+
+    OCIO::ConstOpRcPtr o = optimizedOps[0];
+    OCIO::ConstLut3DOpDataRcPtr lut = OCIO::DynamicPtrCast<const OCIO::Lut3DOpData>(o->data());
+    OCIO_REQUIRE_ASSERT(lut);
+    OCIO_CHECK_EQUAL(lut->getArray().getLength(), 33);
+    OCIO_CHECK_EQUAL(lut->getInterpolation(), OCIO::INTERP_TETRAHEDRAL);
+
+    compareBakedRender(originalOps, optimizedOps, bakeInputs, 1e-3f, __LINE__);
+
+    // Optimizing again does not bake the 3D LUT again.
+    OCIO::OpRcPtrVec bakedOps = optimizedOps;
+    OCIO_CHECK_NO_THROW(OCIO::OptimizeOpVec(bakedOps, OCIO::BIT_DEPTH_UINT10,
+                                            OCIO::OPTIMIZATION_BAKE_LUT3D));
+    OCIO_REQUIRE_EQUAL(bakedOps.size(), 1U);
+    OCIO_CHECK_EQUAL(bakedOps[0], optimizedOps[0]);
+}
+
+OCIO_ADD_TEST(BakeLut3D, float_input)
+{
+    OCIO::OpRcPtrVec originalOps;
+    CreateBakeTestOps(originalOps);
+
+    OCIO::OpRcPtrVec optimizedOps = originalOps;
+    OCIO_CHECK_NO_THROW(OCIO::OptimizeOpVec(optimizedOps, OCIO::BIT_DEPTH_F32,
+                                            OCIO::OPTIMIZATION_BAKE_LUT3D));
+
+    // The log2 shaper followed by the 3D LUT.
+    OCIO_REQUIRE_EQUAL(optimizedOps.size(), 2U);
+
+    OCIO::ConstOpRcPtr o = optimizedOps[0];
+    OCIO::ConstLut1DOpDataRcPtr shaper
+        = OCIO::DynamicPtrCast<const OCIO::Lut1DOpData>(o->data());
+    OCIO_REQUIRE_ASSERT(shaper);
+    OCIO_CHECK_ASSERT(shaper->isInputHalfDomain());
+
+    o = optimizedOps[1];
+    OCIO_CHECK_EQUAL(o->data()->getType(), OCIO::OpData::Lut3DType);
+
+    // The log2 shaper covers values above one at the cost of a lower precision
+    // (i.e. the 33 grid points are spread over 16 stops).
+    std::vector<float> inputs = bakeInputs;
+    inputs.insert(inputs.end(), { 2.5f, 7.0f, 13.0f, 1.0f });
+
+    compareBakedRender(originalOps, optimizedOps, inputs, -6e-2f, __LINE__);
+}
+
+OCIO_ADD_TEST(BakeLut3D, input_allocation)
+{
+    // The allocation of the input color space selects the shaper.
+
+    OCIO::AllocationData allocation;
+    allocation.allocation = OCIO::ALLOCATION_UNIFORM;
+    allocation.vars = { 0.0f, 4.0f };
+
+    OCIO::OpRcPtrVec originalOps;
+    OCIO::CreateGpuAllocationNoOp(originalOps, allocation);
+
+    const double m44[16] = { 0.80, 0.15, 0.05, 0.0,
+                             0.10, 0.85, 0.05, 0.0,
+                             0.02, 0.08, 0.90, 0.0,
+                             0.00, 0.00, 0.00, 1.0 };
+    OCIO::CreateMatrixOp(originalOps, m44, OCIO::TRANSFORM_DIR_FORWARD);
+
+    OCIO::OpRcPtrVec optimizedOps = originalOps;
+    OCIO_CHECK_NO_THROW(OCIO::OptimizeOpVec(optimizedOps, OCIO::BIT_DEPTH_F16,
+                                            OCIO::OPTIMIZATION_BAKE_LUT3D));
+    OCIO_REQUIRE_EQUAL(optimizedOps.size(), 2U);
+
+    // A matrix is linear in the uniform allocation so the 3D LUT interpolation is exact
+    // (i.e. only the half-domain shaper quantization remains).
+    const std::vector<float> inputs = { 0.5f, 1.5f, 3.5f, 1.0f,
+                                        3.0f, 0.1f, 2.0f, 0.0f };
+
+    compareBakedRender(originalOps, optimizedOps, inputs, 2e-3f, __LINE__);
+}
+
+OCIO_ADD_TEST(BakeLut3D, not_baked)
+{
+    // No channel crosstalk.
+    {
+        OCIO::OpRcPtrVec ops;
+        const double exp4[4] = { 1.8, 1.8, 1.8, 1.0 };
+        OCIO::CreateExponentOp(ops, exp4, OCIO::TRANSFORM_DIR_FORWARD);
+        const double logSlope[3]  = { 0.18, 0.18, 0.18 };
+        const double linSlope[3]  = { 2.0, 2.0, 2.0 };
+        const double linOffset[3] = { 0.1, 0.1, 0.1 };
+        const double logOffset[3] = { 1.0, 1.0, 1.0 };
+        OCIO::CreateLogOp(ops, 10.0, logSlope, logOffset, linSlope, linOffset,
+                          OCIO::TRANSFORM_DIR_FORWARD);
+
+        OCIO_CHECK_NO_THROW(OCIO::OptimizeOpVec(ops, OCIO::BIT_DEPTH_F32,
+                                                OCIO::OPTIMIZATION_BAKE_LUT3D));
+        OCIO_REQUIRE_EQUAL(ops.size(), 2U);
+        OCIO::ConstOpRcPtr o = ops[0];
+        OCIO_CHECK_EQUAL(o->data()->getType(), OCIO::OpData::ExponentType);
+    }
+
+    // An op with a dynamic property.
+    {
+        OCIO::OpRcPtrVec ops;
+        CreateBakeTestOps(ops);
+
+        OCIO::ExposureContrastOpDataRcPtr exposure
+            = std::make_shared<OCIO::ExposureContrastOpData>();
+        exposure->setExposure(1.2);
+        exposure->getExposureProperty()->makeDynamic();
+        OCIO::CreateExposureContrastOp(ops, exposure, OCIO::TRANSFORM_DIR_FORWARD);
+
+        OCIO_CHECK_NO_THROW(OCIO::OptimizeOpVec(ops, OCIO::BIT_DEPTH_F32,
+                                                OCIO::OPTIMIZATION_BAKE_LUT3D));
+        OCIO_CHECK_EQUAL(ops.size(), 3U);
+    }
+
+    // The optimization is not requested.
+    {
+        OCIO::OpRcPtrVec ops;
+        CreateBakeTestOps(ops);
+
+        OCIO_CHECK_NO_THROW(OCIO::OptimizeOpVec(ops, OCIO::BIT_DEPTH_UINT8,
+                                                OCIO::OPTIMIZATION_DEFAULT));
+        OCIO_CHECK_EQUAL(ops.size(), 2U);
+    }
+}
+
+OCIO_ADD_TEST(BakeLut3D, lut_size)
+{
+    OCIO_CHECK_EQUAL(OCIO::GetBakedLut3DSize(), 33U);
+
+    OCIO_CHECK_THROW_WHAT(OCIO::SetBakedLut3DSize(1), OCIO::Exception,
+                          "Invalid baked 3D LUT size '1'");
+    OCIO_CHECK_THROW_WHAT(OCIO::SetBakedLut3DSize(130), OCIO::Exception,
+                          "Invalid baked 3D LUT size '130'");
+
+    OCIO_CHECK_NO_THROW(OCIO::SetBakedLut3DSize(65));
+    OCIO_CHECK_EQUAL(OCIO::GetBakedLut3DSize(), 65U);
+
+    OCIO::OpRcPtrVec originalOps;
+    CreateBakeTestOps(originalOps);
+
+    OCIO::OpRcPtrVec optimizedOps = originalOps;
+    OCIO_CHECK_NO_THROW(OCIO::OptimizeOpVec(optimizedOps, OCIO::BIT_DEPTH_UINT16,
+                                            OCIO::OPTIMIZATION_BAKE_LUT3D));
+
+    OCIO::SetBakedLut3DSize(33);
+
+    OCIO_REQUIRE_EQUAL(optimizedOps.size(), 1U);
+    OCIO::ConstOpRcPtr o = optimizedOps[0];
+    OCIO::ConstLut3DOpDataRcPtr lut = OCIO::DynamicPtrCast<const OCIO::Lut3DOpData>(o->data());
+    OCIO_REQUIRE_ASSERT(lut);
+    OCIO_CHECK_EQUAL(lut->getArray().getLength(), 65);
+
+    // A larger 3D LUT is more accurate.
+    compareBakedRender(originalOps, optimizedOps, bakeInputs, 3e-4f, __LINE__);
+}
+
+OCIO_ADD_TEST(CompactLut3Ds, near_identity)
+{
+    // A 3D LUT with a small channel crosstalk on an identity.
+    OCIO::Lut3DOpDataRcPtr lut = std::make_shared<OCIO::Lut3DOpData>(33);
+    OCIO::Array::Values & values = lut->getArray().getValues();
+    for (size_t idx = 0; idx < values.size(); idx += 3)
+    {
+        values[idx + 1] += 0.05f * values[idx];
+    }
+
+    OCIO::OpRcPtrVec ops;
+    OCIO::CreateLut3DOp(ops, lut, OCIO::TRANSFORM_DIR_FORWARD);
+
+    // Not compacted without the optimization.
+    OCIO::OpRcPtrVec optimizedOps = ops;
+    OCIO_CHECK_NO_THROW(OCIO::OptimizeOpVec(optimizedOps, OCIO::BIT_DEPTH_F32,
+                                            OCIO::OPTIMIZATION_LOSSLESS));
+    OCIO_REQUIRE_EQUAL(optimizedOps.size(), 1U);
+    OCIO_CHECK_EQUAL(optimizedOps[0], ops[0]);
+
+    OCIO::StringVec passes;
+    optimizedOps = ops;
+    OCIO_CHECK_NO_THROW(OCIO::OptimizeOpVec(optimizedOps, OCIO::BIT_DEPTH_F32,
+                                            OCIO::OPTIMIZATION_GOOD, &passes));
+    OCIO_REQUIRE_EQUAL(optimizedOps.size(), 1U);
+    OCIO::ConstOpRcPtr o = optimizedOps[0];
+    OCIO::ConstLut3DOpDataRcPtr compact
+        = OCIO::DynamicPtrCast<const OCIO::Lut3DOpData>(o->data());
+    OCIO_REQUIRE_ASSERT(compact);
+    OCIO_CHECK_EQUAL(compact->getGridSize(), 2);
+    OCIO_REQUIRE_EQUAL(passes.size(), 1U);
+    OCIO_CHECK_EQUAL(passes[0], "CompactLut3Ds: 1 ops");
+
+    OCIO_CHECK_NO_THROW(FinalizeOpVec(ops, OCIO::FINALIZATION_EXACT));
+    OCIO_CHECK_NO_THROW(FinalizeOpVec(optimizedOps, OCIO::FINALIZATION_EXACT));
+    compareRender(ops, optimizedOps, __LINE__);
+
+    // The inverse 3D LUT is not compacted.
+    ops.clear();
+    OCIO::CreateLut3DOp(ops, lut, OCIO::TRANSFORM_DIR_INVERSE);
+    optimizedOps = ops;
+    OCIO_CHECK_NO_THROW(OCIO::OptimizeOpVec(optimizedOps, OCIO::BIT_DEPTH_F32,
+                                            OCIO::OPTIMIZATION_GOOD));
+    OCIO_REQUIRE_EQUAL(optimizedOps.size(), 1U);
+    OCIO_CHECK_EQUAL(optimizedOps[0], ops[0]);
+}
+
+OCIO_ADD_TEST(ApproximateSeparableSegments, lut_stack)
+{
+    OCIO_CHECK_EQUAL(OCIO::GetApproximationMaxError(), 1e-4);
+    OCIO_CHECK_THROW_WHAT(OCIO::SetApproximationMaxError(0.), OCIO::Exception,
+                          "Invalid approximation maximum error '0'");
+
+    // A large 1D LUT of a smooth curve, followed by a log and a matrix with crosstalk.
+    OCIO::Lut1DOpDataRcPtr lut = std::make_shared<OCIO::Lut1DOpData>(4096);
+    OCIO::Array::Values & values = lut->getArray().getValues();
+    for (size_t idx = 0; idx < values.size(); ++idx)
+    {
+        values[idx] = 0.1f + 0.9f * values[idx] * values[idx];
+    }
+
+    const double m44[16] = { 0.80, 0.15, 0.05, 0.0,
+                             0.10, 0.85, 0.05, 0.0,
+                             0.02, 0.08, 0.90, 0.0,
+                             0.00, 0.00, 0.00, 1.0 };
+
+    OCIO::OpRcPtrVec originalOps;
+    OCIO::CreateLut1DOp(originalOps, lut, OCIO::TRANSFORM_DIR_FORWARD);
+    OCIO::CreateLogOp(originalOps, 2.0, OCIO::TRANSFORM_DIR_FORWARD);
+    OCIO::CreateMatrixOp(originalOps, m44, OCIO::TRANSFORM_DIR_FORWARD);
+
+    OCIO::SetApproximationMaxError(1e-5);
+
+    OCIO::StringVec passes;
+    OCIO::OpRcPtrVec optimizedOps = originalOps;
+    OCIO_CHECK_NO_THROW(OCIO::OptimizeOpVec(optimizedOps, OCIO::BIT_DEPTH_F32,
+                                            OCIO::OPTIMIZATION_APPROX_SEPARABLE, &passes));
+
+    OCIO::SetApproximationMaxError(1e-4);
+
+    // The 1D LUT and the log are replaced by a smaller 1D LUT.
+    OCIO_REQUIRE_EQUAL(optimizedOps.size(), 2U);
+    OCIO::ConstOpRcPtr o = optimizedOps[0];
+    OCIO::ConstLut1DOpDataRcPtr approxLut = OCIO::DynamicPtrCast<const OCIO::Lut1DOpData>(o->data());
+    OCIO_REQUIRE_ASSERT(approxLut);
+    OCIO_CHECK_ASSERT(!approxLut->isInputHalfDomain());
+    OCIO_CHECK_LT(approxLut->getArray().getLength(), 4096U);
+    OCIO_CHECK_EQUAL(optimizedOps[1], originalOps[2]);
+
+    // The report includes the measured error.
+    OCIO_REQUIRE_EQUAL(passes.size(), 1U);
+    OCIO_CHECK_EQUAL(passes[0].find("ApproximateSeparableSegments (max error "), 0U);
+    OCIO_CHECK_NE(passes[0].find("): 2 ops"), std::string::npos);
+
+    OCIO_CHECK_NO_THROW(FinalizeOpVec(originalOps, OCIO::FINALIZATION_EXACT));
+    OCIO_CHECK_NO_THROW(FinalizeOpVec(optimizedOps, OCIO::FINALIZATION_EXACT));
+    compareRender(originalOps, optimizedOps, __LINE__);
+
+    // The input values of a log are not clamped.
+    OCIO::OpRcPtrVec logOps;
+    OCIO::CreateLogOp(logOps, 2.0, OCIO::TRANSFORM_DIR_FORWARD);
+    OCIO::CreateLut1DOp(logOps, lut, OCIO::TRANSFORM_DIR_FORWARD);
+
+    optimizedOps = logOps;
+    OCIO_CHECK_NO_THROW(OCIO::OptimizeOpVec(optimizedOps, OCIO::BIT_DEPTH_F32,
+                                            OCIO::OPTIMIZATION_APPROX_SEPARABLE));
+    OCIO_REQUIRE_EQUAL(optimizedOps.size(), 2U);
+    OCIO_CHECK_EQUAL(optimizedOps[0], logOps[0]);
+
+    // Not approximated without the optimization.
+    optimizedOps = originalOps;
+    OCIO_CHECK_NO_THROW(OCIO::OptimizeOpVec(optimizedOps, OCIO::BIT_DEPTH_F32,
+                                            OCIO::OPTIMIZATION_DEFAULT));
+    OCIO_REQUIRE_EQUAL(optimizedOps.size(), 3U);
+}
+
 // TODO: Add separable prefix tests that mix in more non-separable ops.
 
 // TODO: Add synColor unit tests opt_prefix_test1
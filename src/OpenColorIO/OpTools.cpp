@@ -1,50 +1,97 @@
 // SPDX-License-Identifier: BSD-3-Clause
 // Copyright Contributors to the OpenColorIO Project.
 
+#include <algorithm>
+
 #include <OpenColorIO/OpenColorIO.h>
 
 #include "BitDepthUtils.h"
+#include "FusedOpCPU.h"
 #include "OpTools.h"
+#include "ThreadPool.h"
 
 OCIO_NAMESPACE_ENTER
 {
+    namespace
+    {
+        // The number of pixels of the blocks evaluated in parallel.
+        constexpr long EvalBlockSize = 1024;
+    }
+
     void EvalTransform(const float * in,
                        float * out,
                        long numPixels,
                        OpRcPtrVec & ops)
     {
-        std::vector<float> tmp(numPixels * 4);
-
-        // Render the LUT entries (domain) through the ops.
-        const float * values = in;
-        for (long idx = 0; idx<numPixels; ++idx)
-        {
-            tmp[4 * idx + 0] = values[0];
-            tmp[4 * idx + 1] = values[1];
-            tmp[4 * idx + 2] = values[2];
-            tmp[4 * idx + 3] = 1.0f;
-
-            values += 3;
-        }
-
         // Sets the bit-depths at each op interface to 32f so there is never
         // any quantization to integer.
         FinalizeOpVec(ops, FINALIZATION_EXACT);
 
-        for (OpRcPtrVec::size_type i = 0, size = ops.size(); i<size; ++i)
+        // Create the CPU renderers only once as some of them are slow to create
+        // (e.g. the exact inverse of a Lut3D), the runs of short ops being fused.
+        ConstOpCPURcPtrVec cpuOps;
+        CreateFusedCPUOps(ops, 0, ops.size(), cpuOps);
+
+        // The domain (e.g. all the entries of a large Lut3D) is rendered in blocks
+        // processed in parallel, each block going through all the ops.
+        const long numBlocks = (numPixels + EvalBlockSize - 1) / EvalBlockSize;
+
+        GetCPUThreadPool()->parallelFor(numBlocks, [&](long blockIdx)
         {
-            ops[i]->apply(&tmp[0], &tmp[0], numPixels);
-        }
+            const long first = blockIdx * EvalBlockSize;
+            const long numBlockPixels = std::min(EvalBlockSize, numPixels - first);
+
+            std::vector<float> tmp(numBlockPixels * 4);
+
+            // Render the LUT entries (domain) through the ops.
+            const float * values = in + 3 * first;
+            for (long idx = 0; idx<numBlockPixels; ++idx)
+            {
+                tmp[4 * idx + 0] = values[0];
+                tmp[4 * idx + 1] = values[1];
+                tmp[4 * idx + 2] = values[2];
+                tmp[4 * idx + 3] = 1.0f;
 
-        float * result = out;
-        for (long idx = 0; idx<numPixels; ++idx)
+                values += 3;
+            }
+
+            for (const auto & cpuOp : cpuOps)
+            {
+                cpuOp->apply(&tmp[0], &tmp[0], numBlockPixels);
+            }
+
+            float * result = out + 3 * first;
+            for (long idx = 0; idx<numBlockPixels; ++idx)
+            {
+                result[0] = tmp[4 * idx + 0];
+                result[1] = tmp[4 * idx + 1];
+                result[2] = tmp[4 * idx + 2];
+
+                result += 3;
+            }
+        });
+    }
+
+    void EvalTransformRGBA(float * rgba, long numPixels, const OpRcPtrVec & ops)
+    {
+        ConstOpCPURcPtrVec cpuOps;
+        CreateFusedCPUOps(ops, 0, ops.size(), cpuOps);
+
+        // The blocks are processed in place and in parallel, each block going through
+        // all the ops while it is still in the cache.
+        const long numBlocks = (numPixels + EvalBlockSize - 1) / EvalBlockSize;
+
+        GetCPUThreadPool()->parallelFor(numBlocks, [&](long blockIdx)
         {
-            result[0] = tmp[4 * idx + 0];
-            result[1] = tmp[4 * idx + 1];
-            result[2] = tmp[4 * idx + 2];
+            const long first = blockIdx * EvalBlockSize;
+            const long numBlockPixels = std::min(EvalBlockSize, numPixels - first);
 
-            result += 3;
-        }
+            float * values = rgba + 4 * first;
+            for (const auto & cpuOp : cpuOps)
+            {
+                cpuOp->apply(values, values, numBlockPixels);
+            }
+        });
     }
 
     const char * GetInvQualityName(LutInversionQuality invStyle)
@@ -71,5 +118,76 @@ OCIO_NAMESPACE_ENTER
 
         throw Exception("The LUT has an unrecognized inversion quality setting.");
     }
+
+    const char * GetInterpQualityName(LutInterpolationQuality quality)
+    {
+        switch (quality)
+        {
+        case LUT_INTERPOLATION_FULL:
+        {
+            return "full";
+        }
+        case LUT_INTERPOLATION_PREVIEW:
+        {
+            return "preview";
+        }
+        case LUT_INTERPOLATION_DRAFT:
+        {
+            return "draft";
+        }
+        }
+
+        throw Exception("The LUT has an unrecognized interpolation quality setting.");
+    }
 }
 OCIO_NAMESPACE_EXIT
+
+
+#ifdef OCIO_UNIT_TEST
+
+namespace OCIO = OCIO_NAMESPACE;
+#include "UnitTest.h"
+
+#include "ops/Log/LogOps.h"
+#include "ops/Matrix/MatrixOps.h"
+#include "ops/Range/RangeOps.h"
+
+OCIO_ADD_TEST(OpTools, eval_transform_rgba)
+{
+    // The parallel evaluation produces the same results as the individual ops.
+
+    const double m44[16] = { 0.9, 0.1, 0.0, 0.0,
+                             0.2, 0.7, 0.1, 0.0,
+                             0.0, 0.3, 0.6, 0.0,
+                             0.0, 0.0, 0.0, 1.0 };
+
+    OCIO::OpRcPtrVec ops;
+    OCIO::CreateMatrixOp(ops, m44, OCIO::TRANSFORM_DIR_FORWARD);
+    OCIO::CreateRangeOp(ops, 0.0, 1.0, 0.1, 0.9, OCIO::TRANSFORM_DIR_FORWARD);
+    OCIO::CreateLogOp(ops, 2.0, OCIO::TRANSFORM_DIR_FORWARD);
+    OCIO_CHECK_NO_THROW(OCIO::FinalizeOpVec(ops, OCIO::FINALIZATION_EXACT));
+
+    // Use several blocks and a partial one.
+    constexpr long numPixels = 4111;
+
+    std::vector<float> rgba(numPixels * 4);
+    for (size_t idx = 0; idx < rgba.size(); ++idx)
+    {
+        rgba[idx] = float(idx % 251) / 125.0f - 0.5f;
+    }
+
+    std::vector<float> expected(rgba);
+    for (const auto & op : ops)
+    {
+        op->apply(&expected[0], &expected[0], numPixels);
+    }
+
+    OCIO_CHECK_NO_THROW(OCIO::EvalTransformRGBA(&rgba[0], numPixels, ops));
+
+    for (size_t idx = 0; idx < rgba.size(); ++idx)
+    {
+        OCIO_CHECK_EQUAL(rgba[idx], expected[idx]);
+    }
+}
+
+#endif // OCIO_UNIT_TEST
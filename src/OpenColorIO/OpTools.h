@@ -18,8 +18,14 @@ void EvalTransform(const float * in, float * out,
                    long numPixels,
                    OpRcPtrVec & ops);
 
+// Process in place packed RGBA 32-bit float pixels (e.g. the grid of a 3D LUT to bake)
+// through the finalized ops, the pixels being processed in parallel blocks.
+void EvalTransformRGBA(float * rgba, long numPixels, const OpRcPtrVec & ops);
+
 const char * GetInvQualityName(LutInversionQuality invStyle);
 
+const char * GetInterpQualityName(LutInterpolationQuality quality);
+
 // Allow us to temporarily manipulate the inversion quality without
 // cloning the object.
 template <class LutType>
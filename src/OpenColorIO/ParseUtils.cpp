@@ -1,7 +1,15 @@
 // SPDX-License-Identifier: BSD-3-Clause
 // Copyright Contributors to the OpenColorIO Project.
 
+#include <algorithm>
+#include <cctype>
+#include <clocale>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
 #include <iostream>
+#include <locale>
 #include <set>
 #include <sstream>
 
@@ -225,6 +233,9 @@ OCIO_NAMESPACE_ENTER
         else if(language == GPU_LANGUAGE_GLSL_1_3)  return "glsl_1.3";
         else if(language == GPU_LANGUAGE_GLSL_4_0)  return "glsl_4.0";
         else if(language == GPU_LANGUAGE_HLSL_DX11) return "hlsl_dx11";
+        else if(language == GPU_LANGUAGE_GLSL_ES_3_0) return "glsl_es_3.0";
+        else if(language == GPU_LANGUAGE_GLSL_VK_4_6) return "glsl_vk_4.6";
+        else if(language == GPU_LANGUAGE_MSL_2_0)     return "msl_2.0";
         return "unknown";
     }
     
@@ -236,6 +247,9 @@ OCIO_NAMESPACE_ENTER
         else if(str == "glsl_1.3") return GPU_LANGUAGE_GLSL_1_3;
         else if(str == "glsl_4.0") return GPU_LANGUAGE_GLSL_4_0;
         else if(str == "hlsl_dx11") return GPU_LANGUAGE_HLSL_DX11;
+        else if(str == "glsl_es_3.0") return GPU_LANGUAGE_GLSL_ES_3_0;
+        else if(str == "glsl_vk_4.6") return GPU_LANGUAGE_GLSL_VK_4_6;
+        else if(str == "msl_2.0") return GPU_LANGUAGE_MSL_2_0;
         return GPU_LANGUAGE_UNKNOWN;
     }
     
@@ -385,13 +399,198 @@ OCIO_NAMESPACE_ENTER
         return pretty.str();
     }
     
+    namespace
+    {
+        inline bool IsSpace(char c)
+        {
+            return c==' ' || (c>='\t' && c<='\r');
+        }
+
+        inline bool IsDigit(char c)
+        {
+            return c>='0' && c<='9';
+        }
+
+        // The powers of ten exactly represented by a double.
+        const double POWERS_OF_TEN[] = { 1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,
+                                         1e8,  1e9,  1e10, 1e11, 1e12, 1e13, 1e14, 1e15,
+                                         1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22 };
+        const int MAX_POWER_OF_TEN = 22;
+
+        // Slow path using a stream in the "C" locale, for the numbers the fast path
+        // cannot exactly convert (e.g. too many digits, large exponents).
+        template<typename T>
+        const char * ParseNumberStream(const char * str, const char * end, T & value)
+        {
+            std::istringstream is(std::string(str, end));
+            is.imbue(std::locale::classic());
+
+            T x;
+            if(!(is >> x))
+            {
+                return str;
+            }
+            value = x;
+
+            // Reaching the end of the string makes tellg() fail.
+            const std::streamoff pos = is.tellg();
+            return pos < 0 ? end : str + pos;
+        }
+
+        // Exact conversion of the decimal number [-]mantissa*10^exponent. Return false
+        // if the fast path does not apply (the value then being left unchanged).
+        inline bool ConvertFast(bool negative, uint64_t mantissa, int exponent, double & value)
+        {
+            // The mantissa and the power of ten are exactly represented by doubles, so
+            // the result of the (single) operation is correctly rounded.
+            if(mantissa > (uint64_t(1) << 53)
+                || exponent < -MAX_POWER_OF_TEN || exponent > MAX_POWER_OF_TEN)
+            {
+                return false;
+            }
+
+            double val = double(mantissa);
+            val = exponent < 0 ? val / POWERS_OF_TEN[-exponent]
+                               : val * POWERS_OF_TEN[exponent];
+            value = negative ? -val : val;
+            return true;
+        }
+
+        inline bool ConvertFast(bool negative, uint64_t mantissa, int exponent, float & value)
+        {
+            double val;
+            if(!ConvertFast(negative, mantissa, exponent, val))
+            {
+                return false;
+            }
+
+            // Rounding the correctly rounded double to a float is only wrong when the
+            // double is exactly halfway between two floats (i.e. rounding twice).
+            uint64_t bits;
+            std::memcpy(&bits, &val, sizeof(bits));
+            if((bits & 0x1FFFFFFF) == 0x10000000)
+            {
+                return false;
+            }
+
+            const float fval = float(val);
+            if(std::isinf(fval))
+            {
+                return false;
+            }
+
+            value = fval;
+            return true;
+        }
+
+        template<typename T>
+        const char * ParseNumber(const char * str, const char * end, T & value)
+        {
+            const char * p = str;
+            while(p<end && IsSpace(*p)) ++p;
+
+            const char * start = p;
+
+            bool negative = false;
+            if(p<end && (*p=='-' || *p=='+'))
+            {
+                negative = *p=='-';
+                ++p;
+            }
+
+            // Only keep the significant digits i.e. the leading zeros are skipped.
+            uint64_t mantissa = 0;
+            int numDigits = 0;
+            int exponent = 0;
+            bool hasDigits = false;
+            bool tooManyDigits = false;
+
+            const auto addDigit = [&](char c)
+            {
+                hasDigits = true;
+                if(mantissa==0 && c=='0') return;
+                if(numDigits < 19)
+                {
+                    mantissa = mantissa * 10 + uint64_t(c - '0');
+                    ++numDigits;
+                }
+                else
+                {
+                    tooManyDigits = true;
+                }
+            };
+
+            for(; p<end && IsDigit(*p); ++p)
+            {
+                addDigit(*p);
+            }
+
+            if(p<end && *p=='.')
+            {
+                for(++p; p<end && IsDigit(*p); ++p)
+                {
+                    addDigit(*p);
+                    --exponent;
+                }
+            }
+
+            if(!hasDigits || tooManyDigits)
+            {
+                // Let the stream handle (or reject) it.
+                return ParseNumberStream(start, end, value);
+            }
+
+            if(p<end && (*p=='e' || *p=='E'))
+            {
+                const char * q = p + 1;
+                bool negativeExp = false;
+                if(q<end && (*q=='-' || *q=='+'))
+                {
+                    negativeExp = *q=='-';
+                    ++q;
+                }
+
+                if(q==end || !IsDigit(*q))
+                {
+                    return ParseNumberStream(start, end, value);
+                }
+
+                int exp = 0;
+                for(; q<end && IsDigit(*q); ++q)
+                {
+                    if(exp < 10000) exp = exp * 10 + (*q - '0');
+                }
+
+                exponent += negativeExp ? -exp : exp;
+                p = q;
+            }
+
+            if(!ConvertFast(negative, mantissa, exponent, value))
+            {
+                return ParseNumberStream(start, end, value);
+            }
+
+            return p;
+        }
+    }
+
+    const char * ParseFloat(const char * str, const char * end, float & value)
+    {
+        return ParseNumber(str, end, value);
+    }
+
+    const char * ParseDouble(const char * str, const char * end, double & value)
+    {
+        return ParseNumber(str, end, value);
+    }
+
     bool StringToFloat(float * fval, const char * str)
     {
         if(!str) return false;
         
-        std::istringstream inputStringstream(str);
         float x;
-        if(!(inputStringstream >> x))
+        const char * end = str + strlen(str);
+        if(ParseFloat(str, end, x) == str)
         {
             return false;
         }
@@ -435,6 +634,131 @@ OCIO_NAMESPACE_ENTER
         return pretty.str();
     }
 
+    namespace
+    {
+        // Size of the NumberWriter buffer, and the room kept in the buffer for a number.
+        const size_t NUMBER_WRITER_BUFFER_SIZE = 64 * 1024;
+        const size_t NUMBER_WRITER_MAX_SIZE    = 512;
+    }
+
+    NumberWriter::NumberWriter(std::ostream & ostream)
+        : m_ostream(ostream)
+        , m_buffer(NUMBER_WRITER_BUFFER_SIZE)
+    {
+        const char * decimalPoint = localeconv()->decimal_point;
+        if (decimalPoint && *decimalPoint)
+        {
+            m_decimalPoint = *decimalPoint;
+        }
+    }
+
+    NumberWriter::~NumberWriter()
+    {
+        flush();
+    }
+
+    void NumberWriter::flush()
+    {
+        if (m_size)
+        {
+            m_ostream.write(m_buffer.data(), std::streamsize(m_size));
+            m_size = 0;
+        }
+    }
+
+    void NumberWriter::writeNumber(double value, int precision, int width, bool fixed)
+    {
+        if (m_buffer.size() - m_size < NUMBER_WRITER_MAX_SIZE)
+        {
+            flush();
+        }
+
+        char * str = m_buffer.data() + m_size;
+        const int len = snprintf(str, NUMBER_WRITER_MAX_SIZE, fixed ? "%*.*f" : "%*.*g",
+                                 width, precision, value);
+        if (len < 0 || size_t(len) >= NUMBER_WRITER_MAX_SIZE)
+        {
+            // Only a huge fixed value or width could not fit, so use the stream.
+            flush();
+            std::ostringstream oss;
+            oss.imbue(std::locale::classic());
+            oss.precision(precision);
+            oss.width(width);
+            if (fixed)
+            {
+                oss.setf(std::ios::fixed, std::ios::floatfield);
+            }
+            oss << value;
+            m_ostream << oss.str();
+            return;
+        }
+
+        if (m_decimalPoint != '.')
+        {
+            std::replace(str, str + len, m_decimalPoint, '.');
+        }
+        m_size += size_t(len);
+    }
+
+    void NumberWriter::writeGeneral(double value, int precision, int width)
+    {
+        writeNumber(value, precision, width, false);
+    }
+
+    void NumberWriter::writeFixed(double value, int precision, int width)
+    {
+        writeNumber(value, precision, width, true);
+    }
+
+    void NumberWriter::writeInt(long value, int width)
+    {
+        if (m_buffer.size() - m_size < NUMBER_WRITER_MAX_SIZE)
+        {
+            flush();
+        }
+
+        const int len = snprintf(m_buffer.data() + m_size, NUMBER_WRITER_MAX_SIZE,
+                                 "%*ld", std::min(width, 256), value);
+        if (len > 0)
+        {
+            m_size += size_t(len);
+        }
+    }
+
+    void NumberWriter::writeString(const char * str, int width)
+    {
+        const size_t len = strlen(str);
+        if (width > 0 && size_t(width) > len)
+        {
+            for (size_t i = len; i < size_t(width); ++i)
+            {
+                writeChar(' ');
+            }
+        }
+
+        if (m_buffer.size() - m_size < len)
+        {
+            flush();
+        }
+        if (len > m_buffer.size())
+        {
+            m_ostream.write(str, std::streamsize(len));
+            return;
+        }
+
+        memcpy(m_buffer.data() + m_size, str, len);
+        m_size += len;
+    }
+
+    void NumberWriter::writeChar(char c)
+    {
+        if (m_size == m_buffer.size())
+        {
+            flush();
+        }
+        m_buffer[m_size++] = c;
+    }
+
     bool StringVecToFloatVec(std::vector<float> &floatArray,
                              const StringVec &lineParts)
     {
@@ -442,17 +766,42 @@ OCIO_NAMESPACE_ENTER
         
         for(unsigned int i=0; i<lineParts.size(); i++)
         {
-            std::istringstream inputStringstream(lineParts[i]);
-            float x;
-            if(!(inputStringstream >> x))
+            const char * str = lineParts[i].c_str();
+            if(ParseFloat(str, str + lineParts[i].size(), floatArray[i]) == str)
             {
                 return false;
             }
-            floatArray[i] = x;
         }
         
         return true;
     }
+
+    bool StringToFloats(const char * str, std::vector<float> & floatArray)
+    {
+        floatArray.clear();
+        if(!str) return true;
+
+        const char * end = str + strlen(str);
+        const char * p = str;
+        while(true)
+        {
+            while(p<end && IsSpace(*p)) ++p;
+            if(p==end) break;
+
+            float x;
+            const char * next = ParseFloat(p, end, x);
+            if(next==p)
+            {
+                return false;
+            }
+            floatArray.push_back(x);
+
+            // Skip the remaining characters of the token.
+            for(p = next; p<end && !IsSpace(*p); ++p);
+        }
+
+        return true;
+    }
     
     // This will resize intArray to the size of lineParts.
     // Returns true if all lineParts have been recognized as int.
@@ -505,7 +854,26 @@ OCIO_NAMESPACE_ENTER
     
     bool StrEqualsCaseIgnore(const std::string & a, const std::string & b)
     {
-        return (pystring::lower(a) == pystring::lower(b));
+        // Same as comparing the pystring::lower() strings without allocating them.
+        if (a.size() != b.size()) return false;
+
+        for (size_t i = 0; i < a.size(); ++i)
+        {
+            if (::tolower((unsigned char)a[i]) != ::tolower((unsigned char)b[i])) return false;
+        }
+        return true;
+    }
+
+    size_t CaseIgnoreHash::operator()(const std::string & str) const
+    {
+        // FNV-1a hash of the lower case characters.
+        size_t hash = size_t(2166136261U);
+        for (const char c : str)
+        {
+            hash ^= size_t(::tolower((unsigned char)c));
+            hash *= size_t(16777619U);
+        }
+        return hash;
     }
     
     // If a ',' is in the string, split on it
@@ -589,6 +957,9 @@ OCIO_NAMESPACE_EXIT
 
 #ifdef OCIO_UNIT_TEST
 
+#include <cstdio>
+#include <unordered_map>
+
 namespace OCIO = OCIO_NAMESPACE;
 
 #include "UnitTest.h"
@@ -920,6 +1291,88 @@ OCIO_ADD_TEST(ParseUtils, StringToFloat)
     OCIO_CHECK_EQUAL(fval, 1.0f);
 }
 
+OCIO_ADD_TEST(ParseUtils, ParseFloat)
+{
+    // Compare with the stream parsing in the "C" locale.
+    const auto streamParse = [](const std::string & str, float & value)
+    {
+        std::istringstream is(str);
+        is.imbue(std::locale::classic());
+        return bool(is >> value);
+    };
+
+    const char * strs[] = { "0", "-0", "+1", "1.", ".5", "-.25", "00012.5000", "3.40282e38",
+                            "3.40283e38", "1e-45", "1.17549435e-38", "0.1", "0.3333333",
+                            "16777217", "1.00000005960464477539062", "123456789012345678901",
+                            "0.000000000000000000000000123", "1e", "1e+", "1.5e3x", "7E-3",
+                            "-", ".", "e5", "nan", "inf", "  \t42", "4 2" };
+
+    for(const char * str : strs)
+    {
+        float expected = -1.0f;
+        const bool success = streamParse(str, expected);
+
+        float value = -1.0f;
+        const char * end = str + strlen(str);
+        const char * next = OCIO::ParseFloat(str, end, value);
+        OCIO_CHECK_EQUAL(next != str, success);
+        if(success)
+        {
+            OCIO_CHECK_EQUAL(value, expected);
+            OCIO_CHECK_EQUAL(std::signbit(value), std::signbit(expected));
+        }
+    }
+
+    // Compare the parsing of many printed values.
+    uint32_t seed = 1;
+    for(int i=0; i<100000; ++i)
+    {
+        seed = seed * 1664525u + 1013904223u;
+        float x = 0.0f;
+        const uint32_t bits = seed & 0x7F7FFFFF;
+        memcpy(&x, &bits, sizeof(x));
+        if(i%2) x = float(seed % 100000) / 65535.0f;
+
+        char buffer[64];
+        const char * formats[] = { "%.9g", "%.6f", "%e" };
+        snprintf(buffer, sizeof(buffer), formats[i%3], x);
+
+        float expected = 0.0f;
+        OCIO_CHECK_ASSERT(streamParse(buffer, expected));
+
+        float value = 0.0f;
+        OCIO_CHECK_ASSERT(OCIO::ParseFloat(buffer, buffer + strlen(buffer), value) != buffer);
+        OCIO_CHECK_EQUAL(value, expected);
+    }
+
+    // The string does not need to be null terminated.
+    const char str[] = "1.2345";
+    float value = 0.0f;
+    OCIO_CHECK_EQUAL(OCIO::ParseFloat(str, str + 3, value), str + 3);
+    OCIO_CHECK_EQUAL(value, 1.2f);
+
+    double dvalue = 0.0;
+    OCIO_CHECK_EQUAL(OCIO::ParseDouble(str, str + 6, dvalue), str + 6);
+    OCIO_CHECK_EQUAL(dvalue, 1.2345);
+}
+
+OCIO_ADD_TEST(ParseUtils, StringToFloats)
+{
+    std::vector<float> values;
+    OCIO_CHECK_ASSERT(OCIO::StringToFloats("  0.5 1\t-2e1 3x  ", values));
+    OCIO_REQUIRE_EQUAL(values.size(), 4);
+    OCIO_CHECK_EQUAL(values[0], 0.5f);
+    OCIO_CHECK_EQUAL(values[1], 1.0f);
+    OCIO_CHECK_EQUAL(values[2], -20.0f);
+    OCIO_CHECK_EQUAL(values[3], 3.0f);
+
+    OCIO_CHECK_ASSERT(OCIO::StringToFloats("   ", values));
+    OCIO_CHECK_ASSERT(values.empty());
+
+    OCIO_CHECK_ASSERT(!OCIO::StringToFloats("0.5 LUT_3D_SIZE", values));
+    OCIO_CHECK_ASSERT(!OCIO::StringToFloats("LUT_3D_SIZE 33", values));
+}
+
 OCIO_ADD_TEST(ParseUtils, FloatDouble)
 {
     std::string resStr;
@@ -942,6 +1395,63 @@ OCIO_ADD_TEST(ParseUtils, FloatDouble)
     OCIO_CHECK_EQUAL("0.11", resStr);
 }
 
+OCIO_ADD_TEST(ParseUtils, NumberWriter)
+{
+    // The numbers are formatted as the stream formatting.
+    const double values[] = { 0.0, -0.0, 1.0, 0.1, 1.0 / 3.0, -2.5e-7, 65535.0, 1e20, -1e300 };
+
+    for (int precision : { 5, 6, 8, 15 })
+    {
+        for (int width : { 0, 5, 11, 19 })
+        {
+            std::ostringstream ref;
+            std::ostringstream fixedRef;
+            fixedRef.setf(std::ios::fixed, std::ios::floatfield);
+
+            std::ostringstream out;
+            std::ostringstream fixedOut;
+            {
+                OCIO::NumberWriter writer(out);
+                OCIO::NumberWriter fixedWriter(fixedOut);
+
+                for (double value : values)
+                {
+                    ref.precision(precision);
+                    ref.width(width);
+                    ref << value << " ";
+                    writer.writeGeneral(value, precision, width);
+                    writer.writeChar(' ');
+
+                    fixedRef.precision(precision);
+                    fixedRef.width(width);
+                    fixedRef << value << "\n";
+                    fixedWriter.writeFixed(value, precision, width);
+                    fixedWriter.writeChar('\n');
+                }
+            }
+
+            OCIO_CHECK_EQUAL(out.str(), ref.str());
+            OCIO_CHECK_EQUAL(fixedOut.str(), fixedRef.str());
+        }
+    }
+
+    std::ostringstream out;
+    OCIO::NumberWriter writer(out);
+    writer.writeInt(-42, 5);
+    writer.writeString("nan", 6);
+    writer.writeInt(7);
+    // The buffer is only written to the stream when flushed.
+    OCIO_CHECK_EQUAL(out.str(), "");
+    writer.flush();
+    OCIO_CHECK_EQUAL(out.str(), "  -42   nan7");
+
+    // Larger than the buffer.
+    const std::string str(100000, 'a');
+    writer.writeString(str.c_str());
+    writer.flush();
+    OCIO_CHECK_EQUAL(out.str().size(), 12 + str.size());
+}
+
 OCIO_ADD_TEST(ParseUtils, StringVecToIntVec)
 {
     std::vector<int> intArray;
@@ -1038,6 +1548,25 @@ OCIO_ADD_TEST(ParseUtils, SplitStringEnvStyle)
     OCIO_CHECK_EQUAL("", outputvec[2]);
 }
 
+OCIO_ADD_TEST(ParseUtils, case_ignore_hash)
+{
+    OCIO_CHECK_ASSERT(OCIO::StrEqualsCaseIgnore("Linear sRGB", "linear SRGB"));
+    OCIO_CHECK_ASSERT(!OCIO::StrEqualsCaseIgnore("Linear sRGB", "linear_sRGB"));
+    OCIO_CHECK_ASSERT(!OCIO::StrEqualsCaseIgnore("Linear sRGB", "Linear sRGB "));
+
+    const OCIO::CaseIgnoreHash hash;
+    OCIO_CHECK_EQUAL(hash("Linear sRGB"), hash("linear SRGB"));
+    OCIO_CHECK_NE(hash("Linear sRGB"), hash("linear_sRGB"));
+
+    std::unordered_map<std::string, int, OCIO::CaseIgnoreHash, OCIO::CaseIgnoreEqual> index;
+    index["ACEScg"] = 1;
+    index["lnf"]    = 2;
+    OCIO_CHECK_EQUAL(index.size(), 2);
+    OCIO_CHECK_EQUAL(index.count("acescg"), 1);
+    OCIO_CHECK_EQUAL(index["LNF"], 2);
+    OCIO_CHECK_EQUAL(index.count("aces"), 0);
+}
+
 OCIO_ADD_TEST(ParseUtils, IntersectStringVecsCaseIgnore)
 {
     OCIO::StringVec source1;
@@ -25,11 +25,59 @@ OCIO_NAMESPACE_ENTER
     std::string DoubleToString(double value);
     std::string DoubleVecToString(const double * fval, unsigned int size);
 
+    // Buffered writing of numbers (e.g. the LUT values of the writers & bakers) to a
+    // stream. The numbers are formatted as the stream formatting in the "C" locale
+    // but without its per-value cost, and the buffer is written by chunks to the
+    // stream (i.e. when full, on flush() and on destruction).
+    class NumberWriter
+    {
+    public:
+        NumberWriter() = delete;
+        NumberWriter(const NumberWriter &) = delete;
+        NumberWriter & operator=(const NumberWriter &) = delete;
+
+        explicit NumberWriter(std::ostream & ostream);
+        ~NumberWriter();
+
+        // As the stream default float formatting with the precision, the number
+        // being right-aligned on width characters (i.e. as "%*.*g").
+        void writeGeneral(double value, int precision, int width = 0);
+        // As the stream fixed float formatting (i.e. as "%*.*f").
+        void writeFixed(double value, int precision, int width = 0);
+        void writeInt(long value, int width = 0);
+        void writeString(const char * str, int width = 0);
+        void writeChar(char c);
+
+        void flush();
+
+    private:
+        void writeNumber(double value, int precision, int width, bool fixed);
+
+        std::ostream & m_ostream;
+        std::vector<char> m_buffer;
+        size_t m_size = 0;
+        // The decimal point of the "C" library locale, if not '.'.
+        char m_decimalPoint = '.';
+    };
+
+    // Locale-independent parsing of the number starting [str, end[ (i.e. str does not
+    // need to be null terminated), leading whitespaces being skipped. Return the
+    // pointer to the first character after the number, or str if there is no number.
+    // Note that the common numbers are parsed without any memory allocation nor stream,
+    // the result being the one of the stream parsing in the "C" locale.
+    const char * ParseFloat(const char * str, const char * end, float & value);
+    const char * ParseDouble(const char * str, const char * end, double & value);
+
     bool StringToFloat(float * fval, const char * str);
     bool StringToInt(int * ival, const char * str, bool failIfLeftoverChars=false);
     
     bool StringVecToFloatVec(std::vector<float> & floatArray,
                              const StringVec & lineParts);
+
+    // Parse all the whitespace separated numbers of the line, without splitting it.
+    // As for StringVecToFloatVec(), a token only needs to start with a number.
+    // Return false if a token is not a number.
+    bool StringToFloats(const char * str, std::vector<float> & floatArray);
     
     bool StringVecToIntVec(std::vector<int> & intArray,
                            const StringVec & lineParts);
@@ -42,6 +90,21 @@ OCIO_NAMESPACE_ENTER
     bool nextline(std::istream &istream, std::string &line);
     
     bool StrEqualsCaseIgnore(const std::string & a, const std::string & b);
+
+    // Case-insensitive hash & equality to index the names (e.g. color space or look
+    // names) with the unordered containers.
+    struct CaseIgnoreHash
+    {
+        size_t operator()(const std::string & str) const;
+    };
+
+    struct CaseIgnoreEqual
+    {
+        bool operator()(const std::string & a, const std::string & b) const
+        {
+            return StrEqualsCaseIgnore(a, b);
+        }
+    };
     
     // If a ',' is in the string, split on it
     // If a ':' is in the string, split on it
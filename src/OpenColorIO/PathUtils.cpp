@@ -1,16 +1,24 @@
 // SPDX-License-Identifier: BSD-3-Clause
 // Copyright Contributors to the OpenColorIO Project.
 
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <chrono>
 #include <cstdlib>
 #include <fstream>
 #include <iostream>
 #include <limits>
+#include <set>
 #include <sstream>
+#include <utility>
+#include <vector>
 #include <sys/stat.h>
 #include <errno.h>
 
 #include <OpenColorIO/OpenColorIO.h>
 
+#include "CacheStatistics.h"
 #include "Mutex.h"
 #include "PathUtils.h"
 #include "Platform.h"
@@ -40,10 +48,16 @@ OCIO_NAMESPACE_ENTER
             struct stat results;
             if (stat(filename.c_str(), &results) == 0)
             {
-                // Treat the mtime + inode as a proxy for the contents
+                // Treat the mtime + inode + size as a proxy for the contents
                 std::ostringstream fasthash;
                 fasthash << results.st_ino << ":";
                 fasthash << results.st_mtime;
+#if defined(__APPLE__)
+                fasthash << "." << results.st_mtimespec.tv_nsec;
+#elif defined(__linux__)
+                fasthash << "." << results.st_mtim.tv_nsec;
+#endif
+                fasthash << ":" << results.st_size;
                 return fasthash.str();
             }
             
@@ -60,6 +74,8 @@ OCIO_NAMESPACE_ENTER
             Mutex mutex;
             std::string hash;
             bool ready;
+            // The time of the last stat call (refer to SetFileCacheCheckInterval()).
+            std::chrono::steady_clock::time_point checkTime;
             
             FileHashResult():
                 ready(false)
@@ -71,25 +87,77 @@ OCIO_NAMESPACE_ENTER
         
         FileCacheMap g_fastFileHashCache;
         Mutex g_fastFileHashCache_mutex;
+
+        // The minimum number of milliseconds between two checks of a file.
+        std::atomic<unsigned> g_fileCacheCheckInterval{ 0 };
+
+        struct DirectoryListing
+        {
+            // The entry names, in lower case for the case-insensitive file systems.
+            std::set<std::string> names;
+            // False when the directory cannot be listed (e.g. missing directory).
+            bool readable;
+            // The time of the listing (refer to SetFileCacheCheckInterval()).
+            std::chrono::steady_clock::time_point checkTime;
+
+            DirectoryListing():
+                readable(false)
+            {}
+        };
+
+        typedef std::map<std::string, DirectoryListing> DirectoryListingMap;
+
+        DirectoryListingMap g_directoryListingCache;
+        Mutex g_directoryListingCache_mutex;
+
+        std::string GetDirectoryEntryKey(const std::string & name)
+        {
+#if defined(_WIN32) || defined(__APPLE__)
+            // The default file systems are case-insensitive.
+            std::string key(name);
+            std::transform(key.begin(), key.end(), key.begin(),
+                           [](unsigned char c) { return (char)std::tolower(c); });
+            return key;
+#else
+            return name;
+#endif
+        }
+    }
+
+    void SetFileCacheCheckInterval(unsigned milliseconds)
+    {
+        g_fileCacheCheckInterval = milliseconds;
+    }
+
+    unsigned GetFileCacheCheckInterval()
+    {
+        return g_fileCacheCheckInterval;
     }
     
     std::string GetFastFileHash(const std::string & filename)
     {
+        CacheStatistics & statistics = GetCacheStatistics(CACHE_PATH);
+
         FileHashResultPtr fileHashResultPtr;
         {
-            AutoMutex lock(g_fastFileHashCache_mutex);
+            AutoTimedMutex lock(g_fastFileHashCache_mutex, statistics);
             FileCacheMap::iterator iter = g_fastFileHashCache.find(filename);
             if(iter != g_fastFileHashCache.end())
             {
                 fileHashResultPtr = iter->second;
+                statistics.addHit();
             }
             else
             {
                 fileHashResultPtr = FileHashResultPtr(new FileHashResult);
                 g_fastFileHashCache[filename] = fileHashResultPtr;
+                statistics.addMiss();
+                statistics.addInsertion();
             }
         }
         
+        const unsigned checkInterval = g_fileCacheCheckInterval;
+
         std::string hash;
         {
             AutoMutex lock(fileHashResultPtr->mutex);
@@ -97,6 +165,17 @@ OCIO_NAMESPACE_ENTER
             {
                 fileHashResultPtr->ready = true;
                 fileHashResultPtr->hash = ComputeHash(filename);
+                fileHashResultPtr->checkTime = std::chrono::steady_clock::now();
+            }
+            else if(checkInterval != 0)
+            {
+                // Check the file again once the interval elapsed.
+                const auto now = std::chrono::steady_clock::now();
+                if(now - fileHashResultPtr->checkTime >= std::chrono::milliseconds(checkInterval))
+                {
+                    fileHashResultPtr->hash = ComputeHash(filename);
+                    fileHashResultPtr->checkTime = now;
+                }
             }
             
             hash = fileHashResultPtr->hash;
@@ -111,10 +190,97 @@ OCIO_NAMESPACE_ENTER
         return (!hash.empty());
     }
     
+    DirectoryEntryLookup FindDirectoryEntry(const std::string & dirname,
+                                            const std::string & name)
+    {
+        const std::string key = GetDirectoryEntryKey(name);
+        const unsigned checkInterval = g_fileCacheCheckInterval;
+        const auto now = std::chrono::steady_clock::now();
+
+        const auto lookup = [&key](const DirectoryListing & listing)
+        {
+            if(!listing.readable)
+            {
+                return DIRECTORY_ENTRY_UNKNOWN;
+            }
+            return listing.names.count(key) != 0 ? DIRECTORY_ENTRY_FOUND
+                                                 : DIRECTORY_ENTRY_MISSING;
+        };
+
+        CacheStatistics & statistics = GetCacheStatistics(CACHE_PATH);
+
+        {
+            AutoTimedMutex lock(g_directoryListingCache_mutex, statistics);
+
+            DirectoryListingMap::const_iterator iter = g_directoryListingCache.find(dirname);
+            if(iter != g_directoryListingCache.end()
+                && (checkInterval == 0
+                    || now - iter->second.checkTime < std::chrono::milliseconds(checkInterval)))
+            {
+                statistics.addHit();
+                return lookup(iter->second);
+            }
+        }
+
+        statistics.addMiss();
+
+        // Note that the lock is not held while listing the directory as it could be slow
+        // (e.g. a network file system).
+        DirectoryListing listing;
+        listing.checkTime = now;
+
+        std::vector<std::string> names;
+        listing.readable = Platform::ListDirectory(dirname, names);
+        for(const auto & entry : names)
+        {
+            listing.names.insert(GetDirectoryEntryKey(entry));
+        }
+
+        const DirectoryEntryLookup result = lookup(listing);
+
+        AutoTimedMutex lock(g_directoryListingCache_mutex, statistics);
+        if(g_directoryListingCache.find(dirname) == g_directoryListingCache.end())
+        {
+            statistics.addInsertion();
+        }
+        g_directoryListingCache[dirname] = std::move(listing);
+
+        return result;
+    }
+
     void ClearPathCaches()
+    {
+        {
+            AutoMutex lock(g_fastFileHashCache_mutex);
+            g_fastFileHashCache.clear();
+        }
+
+        AutoMutex lock(g_directoryListingCache_mutex);
+        g_directoryListingCache.clear();
+    }
+
+    size_t GetPathCacheMemoryUsage()
     {
         AutoMutex lock(g_fastFileHashCache_mutex);
-        g_fastFileHashCache.clear();
+
+        size_t numBytes = 0;
+        for(const auto & entry : g_fastFileHashCache)
+        {
+            numBytes += entry.first.capacity() + sizeof(FileHashResult)
+                      + entry.second->hash.capacity();
+        }
+
+        AutoMutex lock2(g_directoryListingCache_mutex);
+        for(const auto & entry : g_directoryListingCache)
+        {
+            numBytes += entry.first.capacity() + sizeof(DirectoryListing);
+            for(const auto & name : entry.second.names)
+            {
+                numBytes += name.capacity();
+            }
+        }
+
+        return numBytes;
     }
     
     namespace
@@ -247,4 +413,36 @@ OCIO_ADD_TEST(PathUtils, EnvExpand)
     OCIO_CHECK_ASSERT( testresult == foo_result );
 }
 
+OCIO_ADD_TEST(PathUtils, find_directory_entry)
+{
+    std::string filename;
+    OCIO_CHECK_NO_THROW(OCIO::Platform::CreateTempFilename(filename, ".txt"));
+
+    std::string dirname, basename;
+    pystring::os::path::split(dirname, basename, filename);
+
+    OCIO::ClearPathCaches();
+    OCIO_CHECK_EQUAL(OCIO::FindDirectoryEntry(dirname, basename),
+                     OCIO::DIRECTORY_ENTRY_MISSING);
+    OCIO_CHECK_EQUAL(OCIO::FindDirectoryEntry(dirname + "/missing_ocio_dir", basename),
+                     OCIO::DIRECTORY_ENTRY_UNKNOWN);
+
+    {
+        std::ofstream file(filename.c_str());
+        file << "content";
+    }
+
+    // The listing is cached.
+    OCIO_CHECK_EQUAL(OCIO::FindDirectoryEntry(dirname, basename),
+                     OCIO::DIRECTORY_ENTRY_MISSING);
+
+    // Until the cache is cleared.
+    OCIO::ClearPathCaches();
+    OCIO_CHECK_EQUAL(OCIO::FindDirectoryEntry(dirname, basename),
+                     OCIO::DIRECTORY_ENTRY_FOUND);
+
+    std::remove(filename.c_str());
+    OCIO::ClearPathCaches();
+}
+
 #endif // OCIO_BUILD_TESTS
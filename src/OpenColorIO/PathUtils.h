@@ -51,10 +51,29 @@ OCIO_NAMESPACE_ENTER
     bool FileExists(const std::string & filename);
     
     // Get a fast hash for a file, without reading all the contents.
-    // Currently, this checks the mtime and the inode number.
+    // Currently, this checks the mtime, the inode number and the size. The hash is
+    // cached, and only computed again once the check interval elapsed (refer to
+    // SetFileCacheCheckInterval()).
     std::string GetFastFileHash(const std::string & filename);
     
+    // Look for an entry (i.e. a file or a sub-directory) in a directory. The directory
+    // listings are cached, and only listed again once the check interval elapsed (refer to
+    // SetFileCacheCheckInterval()), so resolving many names through the same directories
+    // does not need a stat call per candidate path.
+    enum DirectoryEntryLookup
+    {
+        DIRECTORY_ENTRY_FOUND = 0,
+        DIRECTORY_ENTRY_MISSING,
+        DIRECTORY_ENTRY_UNKNOWN     // The directory cannot be listed.
+    };
+
+    DirectoryEntryLookup FindDirectoryEntry(const std::string & dirname,
+                                            const std::string & name);
+
     void ClearPathCaches();
+
+    // Get the approximate number of bytes held by the file hash & directory listing caches.
+    size_t GetPathCacheMemoryUsage();
 }
 OCIO_NAMESPACE_EXIT
 
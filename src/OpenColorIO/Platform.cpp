@@ -2,6 +2,8 @@
 // Copyright Contributors to the OpenColorIO Project.
 
 
+#include <algorithm>
+#include <cstdint>
 #include <vector>
 
 #include <OpenColorIO/OpenColorIO.h>
@@ -11,8 +13,27 @@
 #include "Platform.h"
 
 #ifndef _WIN32
+#include <cerrno>
 #include <chrono>
+#include <fcntl.h>
 #include <random>
+#include <thread>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#ifdef __APPLE__
+#include <sys/sysctl.h>
+#endif
+
+#ifndef _WIN32
+#include <dirent.h>
+#endif
+
+#ifdef __linux__
+#include <fstream>
+#include <sched.h>
 #endif
 
 
@@ -101,6 +122,83 @@ void AlignedFree(void* memBlock)
 #endif
 }
 
+void * HugePageMalloc(size_t size)
+{
+    if (size == 0 || (size % HUGE_PAGE_SIZE) != 0)
+    {
+        return nullptr;
+    }
+
+#ifdef _WIN32
+
+    // Large pages need the 'SeLockMemoryPrivilege' privilege, fall back to the regular
+    // pages (i.e. the allocation granularity is 64KB so the block is only aligned on it).
+    const SIZE_T largePageSize = GetLargePageMinimum();
+    if (largePageSize != 0 && (size % largePageSize) == 0)
+    {
+        void * memBlock = VirtualAlloc(nullptr, size,
+                                       MEM_COMMIT | MEM_RESERVE | MEM_LARGE_PAGES,
+                                       PAGE_READWRITE);
+        if (memBlock)
+        {
+            return memBlock;
+        }
+    }
+
+    return VirtualAlloc(nullptr, size, MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE);
+
+#else
+
+    // Over-allocate to align the block on the huge page size and unmap the extra parts.
+    const size_t mappedSize = size + HUGE_PAGE_SIZE;
+    void * mapped = mmap(nullptr, mappedSize, PROT_READ | PROT_WRITE,
+                         MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (mapped == MAP_FAILED)
+    {
+        return nullptr;
+    }
+
+    char * start = static_cast<char *>(mapped);
+    char * aligned
+        = reinterpret_cast<char *>((reinterpret_cast<uintptr_t>(start) + HUGE_PAGE_SIZE - 1)
+                                   & ~uintptr_t(HUGE_PAGE_SIZE - 1));
+
+    const size_t head = size_t(aligned - start);
+    if (head > 0)
+    {
+        munmap(start, head);
+    }
+    const size_t tail = mappedSize - head - size;
+    if (tail > 0)
+    {
+        munmap(aligned + size, tail);
+    }
+
+#ifdef MADV_HUGEPAGE
+    // Only a hint i.e. the transparent huge pages could be disabled.
+    madvise(aligned, size, MADV_HUGEPAGE);
+#endif
+
+    return aligned;
+
+#endif
+}
+
+void HugePageFree(void * memBlock, size_t size)
+{
+    if (!memBlock)
+    {
+        return;
+    }
+
+#ifdef _WIN32
+    (void)size;
+    VirtualFree(memBlock, 0, MEM_RELEASE);
+#else
+    munmap(memBlock, size);
+#endif
+}
+
 void CreateTempFilename(std::string & filename, const std::string & filenameExt)
 {
     // Note: Because of security issue, tmpnam could not be used.
@@ -134,6 +232,539 @@ void CreateTempFilename(std::string & filename, const std::string & filenameExt)
     filename += filenameExt;
 }
 
+bool ListDirectory(const std::string & dirname, std::vector<std::string> & names)
+{
+    names.clear();
+
+#ifdef _WIN32
+
+    WIN32_FIND_DATA data;
+    HANDLE handle = FindFirstFile((dirname + "\\*").c_str(), &data);
+    if(handle == INVALID_HANDLE_VALUE)
+    {
+        return false;
+    }
+
+    do
+    {
+        const std::string name(data.cFileName);
+        if(name != "." && name != "..")
+        {
+            names.push_back(name);
+        }
+    }
+    while(FindNextFile(handle, &data));
+
+    FindClose(handle);
+
+#else
+
+    DIR * dir = opendir(dirname.c_str());
+    if(!dir)
+    {
+        return false;
+    }
+
+    while(const dirent * entry = readdir(dir))
+    {
+        const std::string name(entry->d_name);
+        if(name != "." && name != "..")
+        {
+            names.push_back(name);
+        }
+    }
+
+    closedir(dir);
+
+#endif
+
+    return true;
+}
+
+size_t GetL1DataCacheSize()
+{
+#if defined(_WIN32)
+
+    DWORD bufferSize = 0;
+    GetLogicalProcessorInformation(nullptr, &bufferSize);
+
+    std::vector<SYSTEM_LOGICAL_PROCESSOR_INFORMATION> 
+        infos(bufferSize / sizeof(SYSTEM_LOGICAL_PROCESSOR_INFORMATION));
+
+    if(!infos.empty() && GetLogicalProcessorInformation(&infos[0], &bufferSize))
+    {
+        for(const auto & info : infos)
+        {
+            if(info.Relationship==RelationCache && info.Cache.Level==1
+                && (info.Cache.Type==CacheData || info.Cache.Type==CacheUnified))
+            {
+                return size_t(info.Cache.Size);
+            }
+        }
+    }
+
+    return 0;
+
+#elif defined(__APPLE__)
+
+    uint64_t cacheSize = 0;
+    size_t size = sizeof(cacheSize);
+    if(sysctlbyname("hw.l1dcachesize", &cacheSize, &size, nullptr, 0)==0)
+    {
+        return size_t(cacheSize);
+    }
+
+    return 0;
+
+#elif defined(_SC_LEVEL1_DCACHE_SIZE)
+
+    const long cacheSize = sysconf(_SC_LEVEL1_DCACHE_SIZE);
+    return cacheSize > 0 ? size_t(cacheSize) : 0;
+
+#else
+
+    return 0;
+
+#endif
+}
+
+size_t GetLastLevelCacheSize()
+{
+#if defined(_WIN32)
+
+    DWORD bufferSize = 0;
+    GetLogicalProcessorInformation(nullptr, &bufferSize);
+
+    std::vector<SYSTEM_LOGICAL_PROCESSOR_INFORMATION> 
+        infos(bufferSize / sizeof(SYSTEM_LOGICAL_PROCESSOR_INFORMATION));
+
+    size_t cacheSize = 0;
+    if(!infos.empty() && GetLogicalProcessorInformation(&infos[0], &bufferSize))
+    {
+        BYTE level = 0;
+        for(const auto & info : infos)
+        {
+            if(info.Relationship==RelationCache && info.Cache.Level>=level
+                && (info.Cache.Type==CacheData || info.Cache.Type==CacheUnified))
+            {
+                level     = info.Cache.Level;
+                cacheSize = size_t(info.Cache.Size);
+            }
+        }
+    }
+
+    return cacheSize;
+
+#elif defined(__APPLE__)
+
+    uint64_t cacheSize = 0;
+    size_t size = sizeof(cacheSize);
+    if(sysctlbyname("hw.l3cachesize", &cacheSize, &size, nullptr, 0)==0 && cacheSize>0)
+    {
+        return size_t(cacheSize);
+    }
+
+    size = sizeof(cacheSize);
+    if(sysctlbyname("hw.l2cachesize", &cacheSize, &size, nullptr, 0)==0)
+    {
+        return size_t(cacheSize);
+    }
+
+    return 0;
+
+#elif defined(_SC_LEVEL3_CACHE_SIZE) && defined(_SC_LEVEL2_CACHE_SIZE)
+
+    long cacheSize = sysconf(_SC_LEVEL3_CACHE_SIZE);
+    if(cacheSize<=0)
+    {
+        cacheSize = sysconf(_SC_LEVEL2_CACHE_SIZE);
+    }
+    return cacheSize > 0 ? size_t(cacheSize) : 0;
+
+#else
+
+    return 0;
+
+#endif
+}
+
+#ifdef __linux__
+namespace
+{
+
+// Parse a list of CPUs such as "0-15,32-47".
+std::vector<unsigned> ParseCPUList(const std::string & list)
+{
+    std::vector<unsigned> cpus;
+
+    std::stringstream ss(list);
+    std::string range;
+    while(std::getline(ss, range, ','))
+    {
+        unsigned first = 0, last = 0;
+        const int numValues = sscanf(range.c_str(), "%u-%u", &first, &last);
+        if(numValues==1)
+        {
+            cpus.push_back(first);
+        }
+        else if(numValues==2)
+        {
+            for(unsigned cpu=first; cpu<=last; ++cpu)
+            {
+                cpus.push_back(cpu);
+            }
+        }
+    }
+
+    return cpus;
+}
+
+}
+#endif
+
+std::vector<std::vector<unsigned>> GetNumaNodeCPUs()
+{
+    std::vector<std::vector<unsigned>> nodes;
+
+#ifdef __linux__
+
+    static const char * nodesPath = "/sys/devices/system/node";
+
+    // Note that the node numbers are not always contiguous.
+    std::vector<unsigned> nodeIds;
+    if(DIR * dir = opendir(nodesPath))
+    {
+        while(const dirent * entry = readdir(dir))
+        {
+            unsigned nodeId = 0;
+            char extra = 0;
+            if(sscanf(entry->d_name, "node%u%c", &nodeId, &extra)==1)
+            {
+                nodeIds.push_back(nodeId);
+            }
+        }
+        closedir(dir);
+    }
+    std::sort(nodeIds.begin(), nodeIds.end());
+
+    for(const unsigned nodeId : nodeIds)
+    {
+        std::ifstream file(std::string(nodesPath) + "/node" + std::to_string(nodeId) + "/cpulist");
+
+        std::string list;
+        if(std::getline(file, list))
+        {
+            std::vector<unsigned> cpus = ParseCPUList(list);
+            // A node could only have memory.
+            if(!cpus.empty())
+            {
+                nodes.push_back(cpus);
+            }
+        }
+    }
+
+#endif
+
+    return nodes;
+}
+
+void SetCurrentThreadAffinity(const std::vector<unsigned> & cpus)
+{
+#ifdef __linux__
+
+    cpu_set_t cpuSet;
+    CPU_ZERO(&cpuSet);
+    for(const unsigned cpu : cpus)
+    {
+        if(cpu<CPU_SETSIZE)
+        {
+            CPU_SET(cpu, &cpuSet);
+        }
+    }
+
+    // Note that it is only a performance hint so a failure is ignored.
+    pthread_setaffinity_np(pthread_self(), sizeof(cpuSet), &cpuSet);
+
+#else
+
+    (void)cpus;
+
+#endif
+}
+
+int GetCurrentCPU()
+{
+#ifdef __linux__
+    return sched_getcpu();
+#else
+    return -1;
+#endif
+}
+
+MappedFile::~MappedFile()
+{
+    close();
+}
+
+bool MappedFile::open(const std::string & filepath)
+{
+    close();
+
+#ifdef _WIN32
+
+    HANDLE file = CreateFileA(filepath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                              OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if(file == INVALID_HANDLE_VALUE)
+    {
+        return false;
+    }
+
+    LARGE_INTEGER fileSize;
+    if(!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0)
+    {
+        CloseHandle(file);
+        return false;
+    }
+
+    // The mapping keeps the file open.
+    m_mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    CloseHandle(file);
+    if(!m_mapping)
+    {
+        return false;
+    }
+
+    void * data = MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0);
+    if(!data)
+    {
+        CloseHandle(m_mapping);
+        m_mapping = nullptr;
+        return false;
+    }
+
+    m_data = static_cast<const char *>(data);
+    m_size = static_cast<size_t>(fileSize.QuadPart);
+
+#else
+
+    const int fd = ::open(filepath.c_str(), O_RDONLY);
+    if(fd < 0)
+    {
+        return false;
+    }
+
+    struct stat st;
+    if(fstat(fd, &st) != 0 || !S_ISREG(st.st_mode) || st.st_size == 0)
+    {
+        ::close(fd);
+        return false;
+    }
+
+    // The mapping keeps the file open.
+    void * data = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if(data == MAP_FAILED)
+    {
+        return false;
+    }
+
+    m_data = static_cast<const char *>(data);
+    m_size = static_cast<size_t>(st.st_size);
+
+#endif
+
+    return true;
+}
+
+void MappedFile::close()
+{
+    if(!m_data) return;
+
+#ifdef _WIN32
+    UnmapViewOfFile(m_data);
+    CloseHandle(m_mapping);
+    m_mapping = nullptr;
+#else
+    munmap(const_cast<char *>(m_data), m_size);
+#endif
+
+    m_data = nullptr;
+    m_size = 0;
+}
+
+SharedMemory::~SharedMemory()
+{
+    close();
+}
+
+size_t SharedMemory::GetPageSize()
+{
+#ifdef _WIN32
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return static_cast<size_t>(info.dwPageSize);
+#else
+    const long pageSize = sysconf(_SC_PAGESIZE);
+    return pageSize > 0 ? static_cast<size_t>(pageSize) : 4096;
+#endif
+}
+
+bool SharedMemory::open(const std::string & name, size_t size)
+{
+    close();
+
+    if(name.empty() || size == 0)
+    {
+        return false;
+    }
+
+#ifdef _WIN32
+
+    // The session namespace i.e. the processes of the same user.
+    const std::string mappingName = "Local\\" + name;
+
+    const unsigned long long numBytes = size;
+    m_mapping = CreateFileMappingA(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE,
+                                   static_cast<DWORD>(numBytes >> 32),
+                                   static_cast<DWORD>(numBytes & 0xFFFFFFFF),
+                                   mappingName.c_str());
+    if(!m_mapping)
+    {
+        return false;
+    }
+    m_creator = GetLastError() != ERROR_ALREADY_EXISTS;
+
+    // The existing mappings keep their own size.
+    void * data = MapViewOfFile(m_mapping, FILE_MAP_READ | FILE_MAP_WRITE, 0, 0, 0);
+    MEMORY_BASIC_INFORMATION info;
+    if(!data || VirtualQuery(data, &info, sizeof(info)) == 0 || info.RegionSize < size)
+    {
+        if(data) UnmapViewOfFile(data);
+        CloseHandle(m_mapping);
+        m_mapping = nullptr;
+        m_creator = false;
+        return false;
+    }
+
+    m_data = static_cast<char *>(data);
+    m_size = size;
+
+#else
+
+    // POSIX shared memory names start with a slash.
+    const std::string shmName = "/" + name;
+
+    // Only the processes of the same user could open it.
+    int fd = shm_open(shmName.c_str(), O_CREAT | O_EXCL | O_RDWR, S_IRUSR | S_IWUSR);
+    if(fd >= 0)
+    {
+        if(ftruncate(fd, static_cast<off_t>(size)) != 0)
+        {
+            ::close(fd);
+            shm_unlink(shmName.c_str());
+            return false;
+        }
+        m_creator = true;
+    }
+    else if(errno == EEXIST)
+    {
+        fd = shm_open(shmName.c_str(), O_RDWR, 0);
+        if(fd < 0)
+        {
+            return false;
+        }
+
+        // The creator sets the size right after the creation.
+        struct stat st = {};
+        for(int attempt = 0; ; ++attempt)
+        {
+            if(fstat(fd, &st) != 0 || st.st_size != 0 || attempt == 1000)
+            {
+                break;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+
+        if(static_cast<size_t>(st.st_size) != size)
+        {
+            ::close(fd);
+            return false;
+        }
+    }
+    else
+    {
+        return false;
+    }
+
+    // The mapping keeps the shared memory open.
+    void * data = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if(data == MAP_FAILED)
+    {
+        if(m_creator) shm_unlink(shmName.c_str());
+        m_creator = false;
+        return false;
+    }
+
+    m_name = shmName;
+    m_data = static_cast<char *>(data);
+    m_size = size;
+
+#endif
+
+    return true;
+}
+
+void SharedMemory::close()
+{
+#ifdef _WIN32
+    if(m_data)
+    {
+        UnmapViewOfFile(m_data);
+        CloseHandle(m_mapping);
+        m_mapping = nullptr;
+    }
+#else
+    if(m_data)
+    {
+        munmap(m_data, m_size);
+    }
+#endif
+
+    m_name.clear();
+    m_data = nullptr;
+    m_size = 0;
+    m_creator = false;
+}
+
+void SharedMemory::unlink()
+{
+#ifndef _WIN32
+    if(!m_name.empty())
+    {
+        shm_unlink(m_name.c_str());
+    }
+#endif
+}
+
+bool SharedMemory::protect(size_t offset, size_t size)
+{
+    const size_t pageSize = GetPageSize();
+    const size_t begin = (offset + pageSize - 1) / pageSize * pageSize;
+    const size_t end   = std::min(offset + size, m_size) / pageSize * pageSize;
+    if(!m_data || begin >= end)
+    {
+        return false;
+    }
+
+#ifdef _WIN32
+    DWORD oldProtection = 0;
+    return VirtualProtect(m_data + begin, end - begin, PAGE_READONLY, &oldProtection) != 0;
+#else
+    return mprotect(m_data + begin, end - begin, PROT_READ) == 0;
+#endif
+}
+
 
 } // Platform
 
@@ -146,6 +777,9 @@ OCIO_NAMESPACE_EXIT
 
 #ifdef OCIO_UNIT_TEST
 
+#include <cstdio>
+#include <fstream>
+
 namespace OCIO = OCIO_NAMESPACE;
 #include "UnitTest.h"
 
@@ -258,6 +892,73 @@ OCIO_ADD_TEST(Platform, aligned_memory_test)
 }
 
 
+OCIO_ADD_TEST(Platform, l1_data_cache_size)
+{
+    // The size is unknown on some platforms, but it is always a reasonable
+    // value when known.
+    const size_t cacheSize = OCIO::Platform::GetL1DataCacheSize();
+    OCIO_CHECK_ASSERT(cacheSize==0 || (cacheSize>=1024 && cacheSize<=16*1024*1024));
+}
+
+OCIO_ADD_TEST(Platform, numa_nodes)
+{
+    // The topology is unknown on some platforms, but each known node has some CPUs,
+    // a CPU being in only one node.
+    const std::vector<std::vector<unsigned>> nodes = OCIO::Platform::GetNumaNodeCPUs();
+
+    std::vector<unsigned> allCPUs;
+    for(const auto & cpus : nodes)
+    {
+        OCIO_CHECK_ASSERT(!cpus.empty());
+        allCPUs.insert(allCPUs.end(), cpus.begin(), cpus.end());
+    }
+
+    std::sort(allCPUs.begin(), allCPUs.end());
+    OCIO_CHECK_ASSERT(std::adjacent_find(allCPUs.begin(), allCPUs.end())==allCPUs.end());
+
+#ifdef __linux__
+    OCIO_CHECK_GE(OCIO::Platform::GetCurrentCPU(), 0);
+#endif
+}
+
+OCIO_ADD_TEST(Platform, last_level_cache_size)
+{
+    const size_t cacheSize = OCIO::Platform::GetLastLevelCacheSize();
+    OCIO_CHECK_ASSERT(cacheSize==0 || cacheSize>=OCIO::Platform::GetL1DataCacheSize());
+}
+
+OCIO_ADD_TEST(Platform, mapped_file)
+{
+    std::string filename;
+    OCIO_CHECK_NO_THROW(OCIO::Platform::CreateTempFilename(filename, ".txt"));
+
+    OCIO::Platform::MappedFile file;
+    OCIO_CHECK_ASSERT(!file.open(filename));
+    OCIO_CHECK_ASSERT(!file.data());
+
+    const std::string content("0.1 0.2 0.3\n0.4 0.5 0.6\n");
+    {
+        std::ofstream out(filename, std::ios_base::binary);
+        out << content;
+    }
+
+    OCIO_REQUIRE_ASSERT(file.open(filename));
+    OCIO_REQUIRE_EQUAL(file.size(), content.size());
+    OCIO_CHECK_EQUAL(std::string(file.data(), file.size()), content);
+
+    file.close();
+    OCIO_CHECK_ASSERT(!file.data());
+    OCIO_CHECK_EQUAL(file.size(), 0);
+
+    // An empty file is not mapped.
+    {
+        std::ofstream out(filename, std::ios_base::binary | std::ios_base::trunc);
+    }
+    OCIO_CHECK_ASSERT(!file.open(filename));
+
+    std::remove(filename.c_str());
+}
+
 OCIO_ADD_TEST(Platform, CreateTempFilename)
 {
     std::string f1, f2;
@@ -40,6 +40,8 @@
 #include <stdio.h>
 #include <math.h>
 #include <assert.h>
+#include <string>
+#include <vector>
 
 // missing functions on Windows
 #ifdef _WIN32
@@ -88,9 +90,112 @@ void* AlignedMalloc(size_t size, size_t alignment);
 // Frees a block of memory that was allocated with AlignedMalloc.
 void AlignedFree(void* memBlock);
 
+// Size of the huge (i.e. large) memory pages requested by HugePageMalloc.
+static constexpr size_t HUGE_PAGE_SIZE = 2 * 1024 * 1024;
+
+// Allocates a zero filled memory block aligned on HUGE_PAGE_SIZE and backed by huge pages
+// when the system allows it (i.e. transparent huge pages on Linux, large pages on Windows
+// when the process holds the privilege), by regular pages otherwise. The size must be a
+// multiple of HUGE_PAGE_SIZE. Must use HugePageFree to free the memory block. Return null
+// if an allocation error occurs.
+void * HugePageMalloc(size_t size);
+
+// Frees a block of memory that was allocated with HugePageMalloc.
+void HugePageFree(void * memBlock, size_t size);
+
 // Create a temporary filename where filenameExt could be empty.
 void CreateTempFilename(std::string & filename, const std::string & filenameExt);
 
+// Get the names of the entries (i.e. files & sub-directories, but not '.' & '..') of a
+// directory. Return false if the directory cannot be listed.
+bool ListDirectory(const std::string & dirname, std::vector<std::string> & names);
+
+// Get the size in bytes of the L1 data cache of the CPU, or zero if unknown.
+size_t GetL1DataCacheSize();
+
+// Get the size in bytes of the last level cache (i.e. usually the L3 cache) of the CPU,
+// or zero if unknown.
+size_t GetLastLevelCacheSize();
+
+// Get the CPUs of each NUMA node (i.e. the nodes without CPU are skipped), or nothing
+// if the topology is unknown.
+std::vector<std::vector<unsigned>> GetNumaNodeCPUs();
+
+// Restrict the calling thread to run on the CPUs, if supported.
+void SetCurrentThreadAffinity(const std::vector<unsigned> & cpus);
+
+// Get the CPU running the calling thread, or -1 if unknown.
+int GetCurrentCPU();
+
+// Read-only memory mapping of a whole file i.e. the file content is not copied.
+class MappedFile
+{
+public:
+    MappedFile() = default;
+    MappedFile(const MappedFile &) = delete;
+    MappedFile & operator=(const MappedFile &) = delete;
+    ~MappedFile();
+
+    // Return false if the file cannot be mapped (e.g. missing or empty file, or
+    // memory mapping not supported), the caller then reading the file instead.
+    bool open(const std::string & filepath);
+    void close();
+
+    const char * data() const { return m_data; }
+    size_t size() const { return m_size; }
+
+private:
+    const char * m_data = nullptr;
+    size_t       m_size = 0;
+#ifdef _WIN32
+    HANDLE       m_mapping = nullptr;
+#endif
+};
+
+// Named memory shared by the processes of the same user on the node. The memory is
+// mapped read-write, the callers protecting the parts that must stay read-only.
+class SharedMemory
+{
+public:
+    SharedMemory() = default;
+    SharedMemory(const SharedMemory &) = delete;
+    SharedMemory & operator=(const SharedMemory &) = delete;
+    ~SharedMemory();
+
+    // Map the shared memory of that name (i.e. a short name without any path separator),
+    // creating it with that size (i.e. zero filled) when it does not exist. Return false
+    // if the shared memory is not supported or could not be mapped (e.g. an existing one
+    // has another size).
+    bool open(const std::string & name, size_t size);
+    void close();
+
+    // Remove the name so the next open() creates a new shared memory, the existing
+    // mappings staying valid. The name is automatically removed with the last mapping on
+    // Windows.
+    void unlink();
+
+    // Make the whole pages of [offset, offset + size[ read-only.
+    bool protect(size_t offset, size_t size);
+
+    // Did the open() create the shared memory?
+    bool isCreator() const { return m_creator; }
+
+    char * data() const { return m_data; }
+    size_t size() const { return m_size; }
+
+    // Get the size of the memory pages i.e. the granularity of protect().
+    static size_t GetPageSize();
+
+private:
+    std::string m_name;
+    char *      m_data = nullptr;
+    size_t      m_size = 0;
+    bool        m_creator = false;
+#ifdef _WIN32
+    HANDLE      m_mapping = nullptr;
+#endif
+};
+
 }
 
 }
@@ -3,6 +3,8 @@
 
 #include <algorithm>
 #include <cstring>
+#include <fstream>
+#include <functional>
 #include <iterator>
 #include <sstream>
 
@@ -12,7 +14,10 @@
 #include "GPUProcessor.h"
 #include "HashUtils.h"
 #include "OpBuilders.h"
+#include "ParseUtils.h"
 #include "Processor.h"
+#include "ThreadPool.h"
+#include "Tracing.h"
 #include "TransformBuilder.h"
 #include "transforms/FileTransform.h"
 
@@ -28,6 +33,14 @@ OCIO_NAMESPACE_ENTER
     public:
         StringSet files;
         StringVec looks;
+
+        // Optimization report of a CPU processor.
+        StringVec originalOps;
+        StringVec optimizedOps;
+        StringVec optimizationPasses;
+        StringVec renderers;
+        double optimizationTime = 0.0;
+        double finalizationTime = 0.0;
         
         Impl()
         { }
@@ -105,6 +118,101 @@ OCIO_NAMESPACE_ENTER
     
     
     
+    namespace
+    {
+        const char * GetString(const StringVec & strings, int index)
+        {
+            if(index < 0 || index >= static_cast<int>(strings.size()))
+            {
+                return "";
+            }
+
+            return strings[index].c_str();
+        }
+    }
+
+    int ProcessorMetadata::getNumOriginalOps() const
+    {
+        return static_cast<int>(getImpl()->originalOps.size());
+    }
+
+    const char * ProcessorMetadata::getOriginalOp(int index) const
+    {
+        return GetString(getImpl()->originalOps, index);
+    }
+
+    int ProcessorMetadata::getNumOptimizedOps() const
+    {
+        return static_cast<int>(getImpl()->optimizedOps.size());
+    }
+
+    const char * ProcessorMetadata::getOptimizedOp(int index) const
+    {
+        return GetString(getImpl()->optimizedOps, index);
+    }
+
+    int ProcessorMetadata::getNumOptimizationPasses() const
+    {
+        return static_cast<int>(getImpl()->optimizationPasses.size());
+    }
+
+    const char * ProcessorMetadata::getOptimizationPass(int index) const
+    {
+        return GetString(getImpl()->optimizationPasses, index);
+    }
+
+    int ProcessorMetadata::getNumRenderers() const
+    {
+        return static_cast<int>(getImpl()->renderers.size());
+    }
+
+    const char * ProcessorMetadata::getRenderer(int index) const
+    {
+        return GetString(getImpl()->renderers, index);
+    }
+
+    double ProcessorMetadata::getOptimizationTime() const
+    {
+        return getImpl()->optimizationTime;
+    }
+
+    double ProcessorMetadata::getFinalizationTime() const
+    {
+        return getImpl()->finalizationTime;
+    }
+
+    void ProcessorMetadata::addOriginalOp(const char * op)
+    {
+        getImpl()->originalOps.push_back(op);
+    }
+
+    void ProcessorMetadata::addOptimizedOp(const char * op)
+    {
+        getImpl()->optimizedOps.push_back(op);
+    }
+
+    void ProcessorMetadata::addOptimizationPass(const char * pass)
+    {
+        getImpl()->optimizationPasses.push_back(pass);
+    }
+
+    void ProcessorMetadata::addRenderer(const char * renderer)
+    {
+        getImpl()->renderers.push_back(renderer);
+    }
+
+    void ProcessorMetadata::setOptimizationTime(double ms)
+    {
+        getImpl()->optimizationTime = ms;
+    }
+
+    void ProcessorMetadata::setFinalizationTime(double ms)
+    {
+        getImpl()->finalizationTime = ms;
+    }
+    
+    
+    
     //////////////////////////////////////////////////////////////////////////
     
     
@@ -210,6 +318,13 @@ OCIO_NAMESPACE_ENTER
         return getImpl()->getOptimizedGPUProcessor(oFlags, fFlags);
     }
 
+    ConstGPUProcessorRcPtr Processor::getOptimizedGPUProcessor(OptimizationFlags oFlags,
+                                                               FinalizationFlags fFlags,
+                                                               LutInterpolationQuality interpQuality) const
+    {
+        return getImpl()->getOptimizedGPUProcessor(oFlags, fFlags, interpQuality);
+    }
+
     ConstCPUProcessorRcPtr Processor::getDefaultCPUProcessor() const
     {
         return getImpl()->getDefaultCPUProcessor();
@@ -229,10 +344,37 @@ OCIO_NAMESPACE_ENTER
         return getImpl()->getOptimizedCPUProcessor(inBitDepth, outBitDepth, oFlags, fFlags);
     }
 
+    ConstCPUProcessorRcPtr Processor::getOptimizedCPUProcessor(BitDepth inBitDepth,
+                                                               BitDepth outBitDepth,
+                                                               OptimizationFlags oFlags,
+                                                               FinalizationFlags fFlags,
+                                                               const CPUCancellationToken & token) const
+    {
+        CancellationGuard guard(&token);
+        return getImpl()->getOptimizedCPUProcessor(inBitDepth, outBitDepth, oFlags, fFlags);
+    }
+
+    ConstCPUProcessorRcPtr Processor::getOptimizedCPUProcessor(BitDepth inBitDepth,
+                                                               BitDepth outBitDepth,
+                                                               OptimizationFlags oFlags,
+                                                               FinalizationFlags fFlags,
+                                                               LutInterpolationQuality interpQuality) const
+    {
+        return getImpl()->getOptimizedCPUProcessor(inBitDepth, outBitDepth,
+                                                   oFlags, fFlags, interpQuality);
+    }
+
+    ConstCPUProcessorRcPtr Processor::getRenderOnlyCPUProcessor(BitDepth inBitDepth,
+                                                                BitDepth outBitDepth,
+                                                                OptimizationFlags oFlags,
+                                                                FinalizationFlags fFlags) const
+    {
+        return getImpl()->getRenderOnlyCPUProcessor(inBitDepth, outBitDepth, oFlags, fFlags);
+    }
+
     
 
-    Processor::Impl::Impl():
-        m_metadata(ProcessorMetadata::Create())
+    Processor::Impl::Impl()
     {
     }
     
@@ -256,6 +398,20 @@ OCIO_NAMESPACE_ENTER
     
     ConstProcessorMetadataRcPtr Processor::Impl::getProcessorMetadata() const
     {
+        AutoMutex lock(m_resultsCacheMutex);
+
+        if(!m_metadata)
+        {
+            // Note that the processor ops are never optimized so the no-ops (e.g. the
+            // FileNoOps holding the file names) are still present.
+            ProcessorMetadataRcPtr metadata = ProcessorMetadata::Create();
+            for(const auto & op : m_ops)
+            {
+                op->dumpMetadata(metadata);
+            }
+            m_metadata = metadata;
+        }
+
         return m_metadata;
     }
 
@@ -330,6 +486,18 @@ OCIO_NAMESPACE_ENTER
         return false;
     }
 
+    bool Processor::Impl::isDynamic() const
+    {
+        for (const auto & op : m_ops)
+        {
+            if (op->isDynamic())
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
     DynamicPropertyRcPtr Processor::Impl::getDynamicProperty(DynamicPropertyType type) const
     {
         for(const auto & op : m_ops)
@@ -348,81 +516,206 @@ OCIO_NAMESPACE_ENTER
         AutoMutex lock(m_resultsCacheMutex);
         
         if(!m_cpuCacheID.empty()) return m_cpuCacheID.c_str();
-        
-        if(m_ops.empty())
+
+        // The cache id identifies the color processing rather than the transforms it comes
+        // from e.g. a file transform and the equivalent inline matrix transform, or an
+        // explicit and an inferred inverse, end up with the same optimized ops. Only the
+        // lossless optimizations are used so the equivalent processors render the same.
+        OpRcPtrVec ops;
+        ops.assignOps(m_ops);
+        OptimizeOpVec(ops, BIT_DEPTH_F32, OPTIMIZATION_LOSSLESS);
+        FinalizeOpVec(ops, FINALIZATION_EXACT);
+
+        if(ops.empty())
         {
             m_cpuCacheID = "<NOOP>";
         }
         else
         {
-            std::ostringstream cacheid;
-            for(const auto & op : m_ops)
+            CacheIDHasher hasher;
+            for(const auto & op : ops)
             {
-                cacheid << op->getCacheID() << " ";
+                hasher.update(op->getCacheID());
+                hasher.update(" ", 1);
             }
-            std::string fullstr = cacheid.str();
             
-            m_cpuCacheID = CacheIDHash(fullstr.c_str(), (int)fullstr.size());
+            m_cpuCacheID = hasher.digest();
         }
         
         return m_cpuCacheID.c_str();
     }
+
+    ConstGPUProcessorRcPtr Processor::Impl::getSharedGPUProcessor(
+        const FinalizationKey & key,
+        const std::function<ConstGPUProcessorRcPtr()> & create) const
+    {
+        // Only weak pointers are kept so a GPU processor is shared while at least one
+        // processor memoizes it (i.e. the cache does not extend the lifetime of any
+        // processor).
+        typedef std::pair<std::string, FinalizationKey> SharedKey;
+        static std::map<SharedKey, std::weak_ptr<const GPUProcessor>> s_processors;
+        static Mutex s_mutex;
+
+        const SharedKey sharedKey(getCacheID(), key);
+
+        {
+            AutoMutex lock(s_mutex);
+
+            const auto it = s_processors.find(sharedKey);
+            if (it != s_processors.end())
+            {
+                if (ConstGPUProcessorRcPtr gpu = it->second.lock())
+                {
+                    return gpu;
+                }
+            }
+        }
+
+        ConstGPUProcessorRcPtr gpu = create();
+
+        AutoMutex lock(s_mutex);
+
+        std::weak_ptr<const GPUProcessor> & shared = s_processors[sharedKey];
+        if (ConstGPUProcessorRcPtr other = shared.lock())
+        {
+            // Another thread finalized the same processor in the meantime.
+            return other;
+        }
+        shared = gpu;
+
+        // Purge the processors which are not used anymore.
+        if (s_processors.size() > 256)
+        {
+            for (auto it = s_processors.begin(); it != s_processors.end(); )
+            {
+                it = it->second.expired() ? s_processors.erase(it) : std::next(it);
+            }
+        }
+
+        return gpu;
+    }
     
     ///////////////////////////////////////////////////////////////////////////
 
-    ConstGPUProcessorRcPtr Processor::Impl::getDefaultGPUProcessor() const
+    namespace
+    {
+    // Get the memoized processor for the key or else, create one and memoize it
+    // (unless the processor is dynamic). Note that the finalization happens outside
+    // of the lock so concurrent requests for distinct keys do not wait for each other;
+    // when two threads finalize the same key, the first memoized processor wins.
+    template<typename ProcessorRcPtr, typename Key, typename Create>
+    ProcessorRcPtr GetMemoizedProcessor(Mutex & mutex,
+                                        std::map<Key, ProcessorRcPtr> & processors,
+                                        const Key & key,
+                                        bool isDynamic,
+                                        Create create)
     {
-        GPUProcessorRcPtr gpu = GPUProcessorRcPtr(new GPUProcessor(), &GPUProcessor::deleter);
+        if (!isDynamic)
+        {
+            AutoMutex lock(mutex);
+
+            auto it = processors.find(key);
+            if (it != processors.end())
+            {
+                return it->second;
+            }
+        }
 
-        gpu->getImpl()->finalize(m_ops, 
-                                 OPTIMIZATION_DEFAULT, FINALIZATION_DEFAULT);
+        ProcessorRcPtr processor = create();
 
-        return gpu;
+        if (!isDynamic)
+        {
+            AutoMutex lock(mutex);
+            return processors.emplace(key, processor).first->second;
+        }
+
+        return processor;
+    }
+    }
+
+    ConstGPUProcessorRcPtr Processor::Impl::getDefaultGPUProcessor() const
+    {
+        return getOptimizedGPUProcessor(OPTIMIZATION_DEFAULT, FINALIZATION_DEFAULT);
     }
 
     ConstGPUProcessorRcPtr Processor::Impl::getOptimizedGPUProcessor(OptimizationFlags oFlags,
-                                                                     FinalizationFlags fFlags) const
+                                                                     FinalizationFlags fFlags,
+                                                                     LutInterpolationQuality interpQuality) const
     {
-        GPUProcessorRcPtr gpu = GPUProcessorRcPtr(new GPUProcessor(), &GPUProcessor::deleter);
+        const FinalizationKey key(BIT_DEPTH_F32, BIT_DEPTH_F32, oFlags, fFlags,
+                                  IsCPUFastMath(), IsCPULut3DHalfStorage(),
+                                  GetBakedLut3DSize(), GetApproximationMaxError(),
+                                  IsCPUFiniteInputs(), interpQuality);
 
-        gpu->getImpl()->finalize(m_ops, oFlags, fFlags);
+        const bool dynamic = isDynamic();
 
-        return gpu;
+        return GetMemoizedProcessor(m_resultsCacheMutex, m_gpuProcessors, key, dynamic,
+            [this, &key, dynamic, oFlags, fFlags, interpQuality]() -> ConstGPUProcessorRcPtr
+            {
+                auto create = [this, oFlags, fFlags, interpQuality]() -> ConstGPUProcessorRcPtr
+                {
+                    GPUProcessorRcPtr gpu
+                        = GPUProcessorRcPtr(new GPUProcessor(), &GPUProcessor::deleter);
+
+                    gpu->getImpl()->finalize(m_ops, oFlags, fFlags, interpQuality);
+
+                    return gpu;
+                };
+
+                // A GPU processor only holds the optimized ops (i.e. no metadata of the
+                // processor) so it is shared by the equivalent processors, except when it
+                // owns dynamic properties.
+                return dynamic ? create() : getSharedGPUProcessor(key, create);
+            });
     }
 
     ///////////////////////////////////////////////////////////////////////////
 
     ConstCPUProcessorRcPtr Processor::Impl::getDefaultCPUProcessor() const
     {
-        CPUProcessorRcPtr cpu = CPUProcessorRcPtr(new CPUProcessor(), &CPUProcessor::deleter);
-
-        cpu->getImpl()->finalize(m_ops, 
-                                 BIT_DEPTH_F32, BIT_DEPTH_F32, 
-                                 OPTIMIZATION_DEFAULT, FINALIZATION_DEFAULT);
-
-        return cpu;
+        return getOptimizedCPUProcessor(BIT_DEPTH_F32, BIT_DEPTH_F32, 
+                                        OPTIMIZATION_DEFAULT, FINALIZATION_DEFAULT);
     }
 
     ConstCPUProcessorRcPtr Processor::Impl::getOptimizedCPUProcessor(OptimizationFlags oFlags,
                                                                      FinalizationFlags fFlags) const
     {
-        CPUProcessorRcPtr cpu = CPUProcessorRcPtr(new CPUProcessor(), &CPUProcessor::deleter);
-
-        cpu->getImpl()->finalize(m_ops,
-                                 BIT_DEPTH_F32, BIT_DEPTH_F32,
-                                 oFlags, fFlags);
-
-        return cpu;
+        return getOptimizedCPUProcessor(BIT_DEPTH_F32, BIT_DEPTH_F32, oFlags, fFlags);
     }
 
     ConstCPUProcessorRcPtr Processor::Impl::getOptimizedCPUProcessor(BitDepth inBitDepth, 
                                                                      BitDepth outBitDepth,
                                                                      OptimizationFlags oFlags,
-                                                                     FinalizationFlags fFlags) const
+                                                                     FinalizationFlags fFlags,
+                                                                     LutInterpolationQuality interpQuality) const
     {
+        const FinalizationKey key(inBitDepth, outBitDepth, oFlags, fFlags,
+                                  IsCPUFastMath(), IsCPULut3DHalfStorage(),
+                                  GetBakedLut3DSize(), GetApproximationMaxError(),
+                                  IsCPUFiniteInputs(), interpQuality);
+
+        return GetMemoizedProcessor(m_resultsCacheMutex, m_cpuProcessors, key, isDynamic(),
+            [this, inBitDepth, outBitDepth, oFlags, fFlags, interpQuality]() -> ConstCPUProcessorRcPtr
+            {
+                CPUProcessorRcPtr cpu
+                    = CPUProcessorRcPtr(new CPUProcessor(), &CPUProcessor::deleter);
+
+                cpu->getImpl()->finalize(m_ops, inBitDepth, outBitDepth, oFlags, fFlags,
+                                         false, interpQuality);
+
+                return cpu;
+            });
+    }
+
+    ConstCPUProcessorRcPtr Processor::Impl::getRenderOnlyCPUProcessor(BitDepth inBitDepth,
+                                                                      BitDepth outBitDepth,
+                                                                      OptimizationFlags oFlags,
+                                                                      FinalizationFlags fFlags) const
+    {
+        // Not memoized as the processor would then hold the instance.
         CPUProcessorRcPtr cpu = CPUProcessorRcPtr(new CPUProcessor(), &CPUProcessor::deleter);
 
-        cpu->getImpl()->finalize(m_ops, inBitDepth, outBitDepth, oFlags, fFlags);
+        cpu->getImpl()->finalize(m_ops, inBitDepth, outBitDepth, oFlags, fFlags, true);
 
         return cpu;
     }
@@ -440,7 +733,10 @@ OCIO_NAMESPACE_ENTER
         {
             throw Exception("Internal error: Processor should be empty");
         }
-        BuildColorSpaceOps(m_ops, config, context, srcColorSpace, dstColorSpace);
+        {
+            TracingSpan span("processor", "BuildOps");
+            BuildColorSpaceOps(m_ops, config, context, srcColorSpace, dstColorSpace);
+        }
         FinalizeOpVec(m_ops, FINALIZATION_EXACT);
         UnifyDynamicProperties(m_ops);
     }
@@ -454,22 +750,109 @@ OCIO_NAMESPACE_ENTER
         {
             throw Exception("Internal error: Processor should be empty");
         }
-        transform->validate();
-        BuildOps(m_ops, config, context, transform, direction);
+        {
+            TracingSpan span("processor", "BuildOps");
+            transform->validate();
+            BuildOps(m_ops, config, context, transform, direction);
+        }
         FinalizeOpVec(m_ops, FINALIZATION_EXACT);
         UnifyDynamicProperties(m_ops);
     }
 
-    void Processor::Impl::computeMetadata()
+    namespace
     {
-        AutoMutex lock(m_resultsCacheMutex);
+        const char * DISK_CACHE_HEADER = "OCIO Processor Cache 1";
 
-        // Pull out metadata, before the no-ops are removed.
-        for(auto & op : m_ops)
+        void WriteStrings(std::ostream & os, const char * name, int numStrings,
+                          const std::function<const char *(int)> & getString)
         {
-            op->dumpMetadata(m_metadata);
+            os << name << " " << numStrings << "\n";
+            for(int idx = 0; idx < numStrings; ++idx)
+            {
+                os << getString(idx) << "\n";
+            }
+        }
+
+        void ReadStrings(std::istream & is, const char * name, StringVec & strings)
+        {
+            std::string line;
+            int numStrings = -1;
+            if(!std::getline(is, line)
+                || line.compare(0, strlen(name) + 1, std::string(name) + " ") != 0
+                || !StringToInt(&numStrings, line.c_str() + strlen(name) + 1, true)
+                || numStrings < 0)
+            {
+                throw Exception("Invalid processor cache file.");
+            }
+
+            for(int idx = 0; idx < numStrings; ++idx)
+            {
+                if(!std::getline(is, line))
+                {
+                    throw Exception("Invalid processor cache file.");
+                }
+                strings.push_back(line);
+            }
         }
     }
 
+    void Processor::Impl::writeToDiskCache(std::ostream & os) const
+    {
+        // The files and looks of the metadata, followed by the ops in the CTF format.
+        ConstProcessorMetadataRcPtr metadata = getProcessorMetadata();
+
+        os << DISK_CACHE_HEADER << "\n";
+        WriteStrings(os, "files", metadata->getNumFiles(),
+                     [&metadata](int idx) { return metadata->getFile(idx); });
+        WriteStrings(os, "looks", metadata->getNumLooks(),
+                     [&metadata](int idx) { return metadata->getLook(idx); });
+        write(FILEFORMAT_CTF, os);
+    }
+
+    void Processor::Impl::readFromDiskCache(const Config & config,
+                                            const ConstContextRcPtr & context,
+                                            std::istream & is,
+                                            const std::string & filename)
+    {
+        if (!m_ops.empty())
+        {
+            throw Exception("Internal error: Processor should be empty");
+        }
+
+        std::string line;
+        if(!std::getline(is, line) || line != DISK_CACHE_HEADER)
+        {
+            throw Exception("Invalid processor cache file.");
+        }
+
+        StringVec files, looks;
+        ReadStrings(is, "files", files);
+        ReadStrings(is, "looks", looks);
+
+        FileFormat * format = FormatRegistry::GetInstance().getFileFormatByName(FILEFORMAT_CTF);
+        CachedFileRcPtr cachedFile = format->read(is, filename);
+
+        FileTransformRcPtr fileTransform = FileTransform::Create();
+        fileTransform->setSrc(filename.c_str());
+        format->buildFileOps(m_ops, config, context, cachedFile, *fileTransform,
+                             TRANSFORM_DIR_FORWARD);
+        FinalizeOpVec(m_ops, FINALIZATION_EXACT);
+        UnifyDynamicProperties(m_ops);
+
+        // The ops read from the cache file do not know the original files & looks.
+        ProcessorMetadataRcPtr metadata = ProcessorMetadata::Create();
+        for(const auto & file : files)
+        {
+            metadata->addFile(file.c_str());
+        }
+        for(const auto & look : looks)
+        {
+            metadata->addLook(look.c_str());
+        }
+
+        AutoMutex lock(m_resultsCacheMutex);
+        m_metadata = metadata;
+    }
+
 }
 OCIO_NAMESPACE_EXIT
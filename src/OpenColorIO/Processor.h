@@ -5,6 +5,10 @@
 #ifndef INCLUDED_OCIO_PROCESSOR_H
 #define INCLUDED_OCIO_PROCESSOR_H
 
+#include <functional>
+#include <map>
+#include <tuple>
+
 #include <OpenColorIO/OpenColorIO.h>
 
 #include "Mutex.h"
@@ -16,15 +20,37 @@ OCIO_NAMESPACE_ENTER
     class Processor::Impl
     {
     private:
-        ProcessorMetadataRcPtr m_metadata;
+        // The files & looks used, only computed on first request (refer to
+        // getProcessorMetadata()) as most callers never need them.
+        mutable ProcessorMetadataRcPtr m_metadata;
 
         // Vector of ops for the processor.
         OpRcPtrVec m_ops;
 
         mutable std::string m_cpuCacheID;
+
+        // The finalized CPU & GPU processors per finalization parameters i.e. the
+        // bit-depths, the flags and the global settings changing the finalization
+        // (refer to IsCPUFastMath(), IsCPULut3DHalfStorage(), GetBakedLut3DSize(),
+        // GetApproximationMaxError() & IsCPUFiniteInputs()), and the LUT interpolation
+        // quality.
+        // Note that the processors with dynamic properties are never memoized as each
+        // CPU or GPU processor owns its dynamic properties.
+        typedef std::tuple<BitDepth, BitDepth, OptimizationFlags, FinalizationFlags,
+                           bool, bool, unsigned, double, bool,
+                           LutInterpolationQuality> FinalizationKey;
+
+        mutable std::map<FinalizationKey, ConstCPUProcessorRcPtr> m_cpuProcessors;
+        mutable std::map<FinalizationKey, ConstGPUProcessorRcPtr> m_gpuProcessors;
         
         mutable Mutex m_resultsCacheMutex;
 
+        // Get the GPU processor finalized by an equivalent processor (i.e. with the same
+        // cache id) for the same finalization parameters or else, create one and share it.
+        ConstGPUProcessorRcPtr getSharedGPUProcessor(
+            const FinalizationKey & key,
+            const std::function<ConstGPUProcessorRcPtr()> & create) const;
+
     public:
         Impl();
         ~Impl();
@@ -42,6 +68,14 @@ OCIO_NAMESPACE_ENTER
         bool hasDynamicProperty(DynamicPropertyType type) const;
         DynamicPropertyRcPtr getDynamicProperty(DynamicPropertyType type) const;
 
+        // Does any op have a dynamic property?
+        bool isDynamic() const;
+
+        // The (unoptimized) ops of the processor.
+        const OpRcPtrVec & getOps() const { return m_ops; }
+
+        // Note that the cache id is computed from the losslessly optimized ops so the
+        // processors doing the same color processing have the same cache id.
         const char * getCacheID() const;
 
         GroupTransformRcPtr createGroupTransform() const;
@@ -54,8 +88,10 @@ OCIO_NAMESPACE_ENTER
         ConstGPUProcessorRcPtr getDefaultGPUProcessor() const;
 
         // Get an optimized GPU processor instance for F32 images.
-        ConstGPUProcessorRcPtr getOptimizedGPUProcessor(OptimizationFlags oFlags, 
-                                                        FinalizationFlags fFlags) const;
+        ConstGPUProcessorRcPtr getOptimizedGPUProcessor(OptimizationFlags oFlags,
+                                                        FinalizationFlags fFlags,
+                                                        LutInterpolationQuality interpQuality
+                                                            = LUT_INTERPOLATION_FULL) const;
 
         // Get an optimized CPU processor instance for F32 images with default optimizations.
         ConstCPUProcessorRcPtr getDefaultCPUProcessor() const;
@@ -68,7 +104,15 @@ OCIO_NAMESPACE_ENTER
         ConstCPUProcessorRcPtr getOptimizedCPUProcessor(BitDepth inBitDepth,
                                                         BitDepth outBitDepth,
                                                         OptimizationFlags oFlags,
-                                                        FinalizationFlags fFlags) const;
+                                                        FinalizationFlags fFlags,
+                                                        LutInterpolationQuality interpQuality
+                                                            = LUT_INTERPOLATION_FULL) const;
+
+        // Get a new CPU processor instance which only keeps its renderers.
+        ConstCPUProcessorRcPtr getRenderOnlyCPUProcessor(BitDepth inBitDepth,
+                                                         BitDepth outBitDepth,
+                                                         OptimizationFlags oFlags,
+                                                         FinalizationFlags fFlags) const;
 
         ////////////////////////////////////////////
         //
@@ -84,8 +128,17 @@ OCIO_NAMESPACE_ENTER
                           const ConstTransformRcPtr& transform,
                           TransformDirection direction);
 
-        void computeMetadata();
+        // Write & read the processor (i.e. its ops & metadata) for the processor disk
+        // cache (refer to SetProcessorDiskCacheDir()).
+        void writeToDiskCache(std::ostream & os) const;
+        void readFromDiskCache(const Config & config,
+                               const ConstContextRcPtr & context,
+                               std::istream & is,
+                               const std::string & filename);
     };
+
+    // Clear the processor caches of all the configs (refer to SetProcessorCacheSize()).
+    void ClearProcessorCaches();
     
 }
 OCIO_NAMESPACE_EXIT
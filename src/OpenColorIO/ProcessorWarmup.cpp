@@ -0,0 +1,138 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the OpenColorIO Project.
+
+#include <algorithm>
+
+#include <OpenColorIO/OpenColorIO.h>
+
+#include "Logging.h"
+#include "ProcessorWarmup.h"
+#include "ThreadPool.h"
+
+
+OCIO_NAMESPACE_ENTER
+{
+
+ProcessorWarmup::Impl::~Impl()
+{
+    cancel();
+    wait();
+}
+
+void ProcessorWarmup::Impl::start(std::vector<Task> && tasks, unsigned numThreads)
+{
+    m_tasks = std::move(tasks);
+
+    if (m_tasks.empty())
+    {
+        m_done = true;
+        return;
+    }
+
+    if (numThreads == 0)
+    {
+        numThreads = std::max(std::thread::hardware_concurrency(), 1u);
+    }
+    numThreads = std::min(numThreads, unsigned(m_tasks.size()));
+
+    m_thread = std::thread(&ProcessorWarmup::Impl::run, this, numThreads);
+}
+
+void ProcessorWarmup::Impl::run(unsigned numThreads)
+{
+    try
+    {
+        // The background thread participates to the processing so a dedicated pool is
+        // used (i.e. the CPU thread pool stays available for the image processing).
+        ThreadPool pool(numThreads);
+        pool.parallelFor(long(m_tasks.size()), [this](long idx)
+        {
+            if (!m_cancelled)
+            {
+                try
+                {
+                    m_tasks[idx]();
+                }
+                catch (const Exception & e)
+                {
+                    LogDebug(std::string("Processor warm-up failed: ") + e.what());
+                    ++m_numFailures;
+                }
+            }
+            ++m_numCompleted;
+        });
+    }
+    catch (const std::exception & e)
+    {
+        LogWarning(std::string("Processor warm-up failed: ") + e.what());
+        m_numCompleted = int(m_tasks.size());
+    }
+
+    m_done = true;
+}
+
+void ProcessorWarmup::Impl::wait()
+{
+    std::lock_guard<std::mutex> lock(m_waitMutex);
+    if (m_thread.joinable())
+    {
+        m_thread.join();
+    }
+}
+
+
+///////////////////////////////////////////////////////////////////////////
+
+ProcessorWarmupRcPtr ProcessorWarmup::Create()
+{
+    return ProcessorWarmupRcPtr(new ProcessorWarmup(), &deleter);
+}
+
+ProcessorWarmup::ProcessorWarmup()
+    : m_impl(new ProcessorWarmup::Impl)
+{
+}
+
+ProcessorWarmup::~ProcessorWarmup()
+{
+    delete m_impl;
+    m_impl = nullptr;
+}
+
+void ProcessorWarmup::deleter(ProcessorWarmup * c)
+{
+    delete c;
+}
+
+int ProcessorWarmup::getNumProcessors() const
+{
+    return static_cast<int>(getImpl()->m_tasks.size());
+}
+
+int ProcessorWarmup::getNumCompleted() const
+{
+    return getImpl()->m_numCompleted;
+}
+
+int ProcessorWarmup::getNumFailures() const
+{
+    return getImpl()->m_numFailures;
+}
+
+bool ProcessorWarmup::isDone() const
+{
+    return getImpl()->m_done;
+}
+
+void ProcessorWarmup::cancel()
+{
+    getImpl()->cancel();
+}
+
+void ProcessorWarmup::wait()
+{
+    getImpl()->wait();
+}
+
+}
+OCIO_NAMESPACE_EXIT
@@ -0,0 +1,58 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the OpenColorIO Project.
+
+
+#ifndef INCLUDED_OCIO_PROCESSORWARMUP_H
+#define INCLUDED_OCIO_PROCESSORWARMUP_H
+
+
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <OpenColorIO/OpenColorIO.h>
+
+
+OCIO_NAMESPACE_ENTER
+{
+
+class ProcessorWarmup::Impl
+{
+public:
+    typedef std::function<void()> Task;
+
+    Impl() = default;
+    Impl(const Impl &) = delete;
+    Impl & operator=(const Impl &) = delete;
+
+    // Cancel & wait for the background thread.
+    ~Impl();
+
+    // Run the tasks in a background thread using numThreads threads (or the number of
+    // hardware threads when zero). Note that a task failure is only counted.
+    void start(std::vector<Task> && tasks, unsigned numThreads);
+
+    void cancel() { m_cancelled = true; }
+    void wait();
+
+    std::vector<Task> m_tasks;
+
+    std::atomic<int>  m_numCompleted{ 0 };
+    std::atomic<int>  m_numFailures{ 0 };
+    std::atomic<bool> m_cancelled{ false };
+    std::atomic<bool> m_done{ false };
+
+private:
+    void run(unsigned numThreads);
+
+    std::thread m_thread;
+    std::mutex  m_waitMutex;
+};
+
+}
+OCIO_NAMESPACE_EXIT
+
+
+#endif // INCLUDED_OCIO_PROCESSORWARMUP_H
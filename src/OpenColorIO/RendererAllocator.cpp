@@ -0,0 +1,243 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the OpenColorIO Project.
+
+#include <map>
+#include <vector>
+
+#include <OpenColorIO/OpenColorIO.h>
+
+#include "CacheStatistics.h"
+#include "Mutex.h"
+#include "Platform.h"
+#include "RendererAllocator.h"
+
+
+OCIO_NAMESPACE_ENTER
+{
+
+namespace
+{
+
+// The released tables by rounded size.
+typedef std::map<size_t, std::vector<void *>> RendererTablePool;
+
+RendererTablePool g_rendererTablePool;
+size_t g_rendererTablePoolSize = 0;
+Mutex g_rendererTablePoolLock;
+
+inline bool IsHugePageTable(size_t numBytes)
+{
+    return numBytes >= HUGE_PAGE_TABLE_MIN_SIZE;
+}
+
+// The tables are pooled by rounded size so a table only needs the same rounded size to be
+// reused e.g. by the same LUT with another bit-depth or layout.
+inline size_t GetRoundedSize(size_t numBytes)
+{
+    const size_t granularity
+        = IsHugePageTable(numBytes) ? Platform::HUGE_PAGE_SIZE : RENDERER_TABLE_ALIGNMENT;
+    return ((numBytes + granularity - 1) / granularity) * granularity;
+}
+
+void ReleaseTable(void * table, size_t roundedSize)
+{
+    if (IsHugePageTable(roundedSize))
+    {
+        Platform::HugePageFree(table, roundedSize);
+    }
+    else
+    {
+        Platform::AlignedFree(table);
+    }
+}
+
+} // anon.
+
+void * AllocateRendererTable(size_t numBytes)
+{
+    if (numBytes == 0)
+    {
+        return nullptr;
+    }
+
+    const size_t roundedSize = GetRoundedSize(numBytes);
+
+    CacheStatistics & statistics = GetCacheStatistics(CACHE_RENDERER_TABLES);
+
+    {
+        AutoTimedMutex guard(g_rendererTablePoolLock, statistics);
+
+        RendererTablePool::iterator it = g_rendererTablePool.find(roundedSize);
+        if (it != g_rendererTablePool.end() && !it->second.empty())
+        {
+            void * table = it->second.back();
+            it->second.pop_back();
+            g_rendererTablePoolSize -= roundedSize;
+            statistics.addHit();
+            return table;
+        }
+    }
+
+    statistics.addMiss();
+
+    void * table = nullptr;
+    if (IsHugePageTable(roundedSize))
+    {
+        table = Platform::HugePageMalloc(roundedSize);
+    }
+    else
+    {
+        table = Platform::AlignedMalloc(roundedSize, RENDERER_TABLE_ALIGNMENT);
+    }
+
+    if (!table)
+    {
+        throw Exception("Could not allocate the renderer table.");
+    }
+
+    return table;
+}
+
+void FreeRendererTable(void * table, size_t numBytes)
+{
+    if (!table)
+    {
+        return;
+    }
+
+    const size_t roundedSize = GetRoundedSize(numBytes);
+
+    {
+        CacheStatistics & statistics = GetCacheStatistics(CACHE_RENDERER_TABLES);
+        AutoTimedMutex guard(g_rendererTablePoolLock, statistics);
+
+        if (g_rendererTablePoolSize + roundedSize <= MAX_RENDERER_TABLE_POOL_SIZE)
+        {
+            g_rendererTablePool[roundedSize].push_back(table);
+            g_rendererTablePoolSize += roundedSize;
+            statistics.addInsertion();
+            return;
+        }
+    }
+
+    ReleaseTable(table, roundedSize);
+}
+
+void ClearRendererTablePool()
+{
+    RendererTablePool pool;
+
+    {
+        AutoMutex guard(g_rendererTablePoolLock);
+        pool.swap(g_rendererTablePool);
+        g_rendererTablePoolSize = 0;
+    }
+
+    for (const auto & tables : pool)
+    {
+        for (void * table : tables.second)
+        {
+            ReleaseTable(table, tables.first);
+        }
+    }
+}
+
+size_t GetRendererTablePoolMemoryUsage()
+{
+    AutoMutex guard(g_rendererTablePoolLock);
+    return g_rendererTablePoolSize;
+}
+
+}
+OCIO_NAMESPACE_EXIT
+
+
+///////////////////////////////////////////////////////////////////////////////
+
+#ifdef OCIO_UNIT_TEST
+
+namespace OCIO = OCIO_NAMESPACE;
+
+#include <cstdint>
+#include <cstring>
+#include <sstream>
+
+#include "UnitTest.h"
+
+OCIO_ADD_TEST(RendererAllocator, alignment)
+{
+    OCIO::ClearRendererTablePool();
+
+    for (size_t numBytes : { size_t(1), size_t(100), size_t(64 * 1024),
+                             OCIO::HUGE_PAGE_TABLE_MIN_SIZE + 1 })
+    {
+        void * table = OCIO::AllocateRendererTable(numBytes);
+        OCIO_REQUIRE_ASSERT(table);
+        OCIO_CHECK_EQUAL(reinterpret_cast<uintptr_t>(table) % OCIO::RENDERER_TABLE_ALIGNMENT, 0);
+
+        // The whole table is writable.
+        std::memset(table, 0xFF, numBytes);
+
+        OCIO::FreeRendererTable(table, numBytes);
+    }
+
+    OCIO_CHECK_ASSERT(OCIO::GetRendererTablePoolMemoryUsage() > 0);
+
+    OCIO::ClearRendererTablePool();
+    OCIO_CHECK_EQUAL(OCIO::GetRendererTablePoolMemoryUsage(), 0);
+
+    OCIO_CHECK_ASSERT(OCIO::AllocateRendererTable(0) == nullptr);
+    OCIO_CHECK_NO_THROW(OCIO::FreeRendererTable(nullptr, 0));
+}
+
+OCIO_ADD_TEST(RendererAllocator, pool)
+{
+    OCIO::ClearRendererTablePool();
+
+    // A released table is reused by the next allocation of the same rounded size.
+    void * table = OCIO::AllocateRendererTable(1000);
+    OCIO::FreeRendererTable(table, 1000);
+    OCIO_CHECK_EQUAL(OCIO::GetRendererTablePoolMemoryUsage(), 1024);
+
+    void * other = OCIO::AllocateRendererTable(1010);
+    OCIO_CHECK_EQUAL(other, table);
+    OCIO_CHECK_EQUAL(OCIO::GetRendererTablePoolMemoryUsage(), 0);
+
+    // The huge page tables are rounded to whole huge pages.
+    const size_t numBytes = OCIO::HUGE_PAGE_TABLE_MIN_SIZE + 1;
+    void * hugeTable = OCIO::AllocateRendererTable(numBytes);
+    OCIO::FreeRendererTable(hugeTable, numBytes);
+    OCIO_CHECK_EQUAL(OCIO::GetRendererTablePoolMemoryUsage(), 2 * OCIO::Platform::HUGE_PAGE_SIZE);
+
+    OCIO::FreeRendererTable(other, 1010);
+    OCIO_CHECK_EQUAL(OCIO::GetRendererTablePoolMemoryUsage(),
+                     2 * OCIO::Platform::HUGE_PAGE_SIZE + 1024);
+
+    // The pool does not grow beyond its maximum size.
+    std::vector<void *> tables;
+    const size_t tableSize = 8 * 1024 * 1024;
+    for (size_t i = 0; i < OCIO::MAX_RENDERER_TABLE_POOL_SIZE / tableSize + 2; ++i)
+    {
+        tables.push_back(OCIO::AllocateRendererTable(tableSize));
+    }
+    for (void * t : tables)
+    {
+        OCIO::FreeRendererTable(t, tableSize);
+    }
+    OCIO_CHECK_ASSERT(OCIO::GetRendererTablePoolMemoryUsage()
+                          <= OCIO::MAX_RENDERER_TABLE_POOL_SIZE);
+
+    OCIO::ClearRendererTablePool();
+    OCIO_CHECK_EQUAL(OCIO::GetRendererTablePoolMemoryUsage(), 0);
+}
+
+OCIO_ADD_TEST(RendererAllocator, stl_allocator)
+{
+    std::vector<float, OCIO::RendererTableAllocator<float>> values(1000, 1.0f);
+    OCIO_CHECK_EQUAL(reinterpret_cast<uintptr_t>(values.data()) % OCIO::RENDERER_TABLE_ALIGNMENT, 0);
+    OCIO_CHECK_EQUAL(values[999], 1.0f);
+
+    OCIO::ClearRendererTablePool();
+}
+
+#endif // OCIO_UNIT_TEST
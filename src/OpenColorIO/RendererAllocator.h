@@ -0,0 +1,80 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the OpenColorIO Project.
+
+
+#ifndef INCLUDED_OCIO_RENDERERALLOCATOR_H
+#define INCLUDED_OCIO_RENDERERALLOCATOR_H
+
+#include <cstddef>
+#include <new>
+
+#include <OpenColorIO/OpenColorIO.h>
+
+
+OCIO_NAMESPACE_ENTER
+{
+
+// The tables of the CPU renderers (e.g. the optimized 3D LUTs, the 1D LUTs or the inverse
+// 3D LUT search grids) are aligned on a cache line so the SIMD loads never split lines.
+constexpr size_t RENDERER_TABLE_ALIGNMENT = 64;
+
+// The tables at least that large are backed by huge pages (refer to
+// Platform::HugePageMalloc()) to limit the TLB misses of the random LUT accesses.
+constexpr size_t HUGE_PAGE_TABLE_MIN_SIZE = 2 * 1024 * 1024;
+
+// At most that many bytes of released tables are kept for reuse.
+constexpr size_t MAX_RENDERER_TABLE_POOL_SIZE = 64 * 1024 * 1024;
+
+// Allocate a table aligned on RENDERER_TABLE_ALIGNMENT, reusing a released table of the
+// same rounded size when available. The content is undefined. Must use FreeRendererTable
+// with the same size to release it. An exception is thrown if an allocation error occurs.
+void * AllocateRendererTable(size_t numBytes);
+
+// Release a table allocated by AllocateRendererTable, keeping it for reuse (e.g. when a
+// processor is destroyed then recreated) until the pool is full.
+void FreeRendererTable(void * table, size_t numBytes);
+
+// Free all the tables kept for reuse.
+void ClearRendererTablePool();
+
+// Number of bytes held by the tables kept for reuse.
+size_t GetRendererTablePoolMemoryUsage();
+
+// STL allocator over the renderer tables (e.g. for the std::vector members of the renderers).
+template<typename T>
+class RendererTableAllocator
+{
+public:
+    typedef T value_type;
+
+    RendererTableAllocator() = default;
+    template<typename U>
+    RendererTableAllocator(const RendererTableAllocator<U> &) {}
+
+    T * allocate(size_t n)
+    {
+        return static_cast<T *>(AllocateRendererTable(n * sizeof(T)));
+    }
+
+    void deallocate(T * p, size_t n)
+    {
+        FreeRendererTable(p, n * sizeof(T));
+    }
+};
+
+template<typename T, typename U>
+bool operator==(const RendererTableAllocator<T> &, const RendererTableAllocator<U> &)
+{
+    return true;
+}
+
+template<typename T, typename U>
+bool operator!=(const RendererTableAllocator<T> &, const RendererTableAllocator<U> &)
+{
+    return false;
+}
+
+}
+OCIO_NAMESPACE_EXIT
+
+#endif
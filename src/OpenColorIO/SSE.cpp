@@ -293,6 +293,42 @@ OCIO_ADD_TEST(SSE, sse2_exp2_test)
     }
 }
 
+OCIO_ADD_TEST(SSE, sse2_fast_math_test)
+{
+    // Check the error bounds documented by SetCPUFastMath().
+    float sseResult[4];
+
+    for (unsigned i = 0; i < 1000; ++i)
+    {
+        // Values in [2^-20, 2^20[.
+        const float x = ldexpf(1.0f + float(i) / 1000.0f, int(i % 40) - 20);
+
+        _mm_storeu_ps(sseResult, OCIO::sseLog2Fast(_mm_set1_ps(x)));
+        OCIO_CHECK_CLOSE(sseResult[0], (float)log2((double)x), 1e-4f);
+
+        const float y = float(i) * 0.04f - 20.0f;
+        const double expected = exp2((double)y);
+
+        _mm_storeu_ps(sseResult, OCIO::sseExp2Fast(_mm_set1_ps(y)));
+        OCIO_CHECK_CLOSE(sseResult[0] / expected, 1.0, 7.5e-5);
+
+        const float exps[3] = { 2.4f, 1.0f / 2.4f, 2.6f };
+        for (const float exp : exps)
+        {
+            const float z = float(i) * 0.01f + 0.001f;
+            const double expectedPow = pow((double)z, (double)exp);
+
+            _mm_storeu_ps(sseResult, OCIO::ssePowerFast(_mm_set1_ps(z), _mm_set1_ps(exp)));
+            OCIO_CHECK_CLOSE(sseResult[0] / expectedPow, 1.0, 6.5e-5 * exp + 8e-5);
+        }
+    }
+
+    // Base values smaller or equal than zero are mapped to zero.
+    _mm_storeu_ps(sseResult, OCIO::ssePowerFast(_mm_set_ps(-1.0f, 0.0f, -0.0f, -1e-10f),
+                                                _mm_set1_ps(2.2f)));
+    OCIO_CHECK_ASSERT(AreAllZero(sseResult));
+}
+
 void EvaluateAtan(const float x, float* result)
 {
     __m128 mm_sseResult = OCIO::sseAtan(_mm_set1_ps(x));
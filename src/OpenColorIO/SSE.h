@@ -108,6 +108,117 @@ inline __m128 sseSelect(const __m128& mask, const __m128& arg_true, const __m128
     return _mm_xor_ps( arg_false, _mm_and_ps( mask, _mm_xor_ps( arg_true, arg_false ) ) );
 }
 
+// Load 'count' consecutive values (i.e. at most four) padding with zeros.
+// It is used by the planar renderers to process the end of a plane.
+inline __m128 sseLoadPartial(const float * in, long count)
+{
+    if(count>=4)
+    {
+        return _mm_loadu_ps(in);
+    }
+
+    OCIO_ALIGN(float buf[4]) = { 0.0f, 0.0f, 0.0f, 0.0f };
+    for(long idx=0; idx<count; ++idx)
+    {
+        buf[idx] = in[idx];
+    }
+    return _mm_load_ps(buf);
+}
+
+// Store the 'count' first values (i.e. at most four) of the register.
+inline void sseStorePartial(float * out, const __m128 & value, long count)
+{
+    if(count>=4)
+    {
+        _mm_storeu_ps(out, value);
+        return;
+    }
+
+    OCIO_ALIGN(float buf[4]);
+    _mm_store_ps(buf, value);
+    for(long idx=0; idx<count; ++idx)
+    {
+        out[idx] = buf[idx];
+    }
+}
+
+// The packed RGB renderers process four consecutive floats at a time so the channels
+// of the register lanes cycle through RGBR, GBRG and BRGB. The per-channel values are
+// then rotated the same way.
+inline void sseRGBRotations(float r, float g, float b, __m128 (&values)[3])
+{
+    values[0] = _mm_setr_ps(r, g, b, r);
+    values[1] = _mm_setr_ps(g, b, r, g);
+    values[2] = _mm_setr_ps(b, r, g, b);
+}
+
+// Apply a per-channel function to packed RGB pixels, the function getting the register
+// and the index of the rotation to use (refer to sseRGBRotations()).
+template<typename Func>
+inline void sseApplyRGB(const float * in, float * out, long numPixels, const Func & func)
+{
+    const long numValues = 3 * numPixels;
+
+    int rotation = 0;
+    for(long idx=0; idx<numValues; idx+=4)
+    {
+        const long count = numValues - idx;
+
+        sseStorePartial(out + idx, func(sseLoadPartial(in + idx, count), rotation), count);
+
+        rotation = rotation==2 ? 0 : rotation + 1;
+    }
+}
+
+// Apply a function to packed RGBA pixels four at a time, the function getting one register
+// per channel (i.e. the pixels are transposed) to update the red, green and blue registers.
+// The alpha values are copied. The last pixels are processed through a zero padded buffer.
+template<typename Func>
+inline void sseApplyTransposedRGB(const float * in, float * out, long numPixels, const Func & func)
+{
+    for(long idx=0; idx<numPixels; idx+=4)
+    {
+        const long count = numPixels - idx;
+
+        OCIO_ALIGN(float buf[16]);
+        const float * src = in;
+        if(count<4)
+        {
+            for(long i=0; i<16; ++i)
+            {
+                buf[i] = i < 4*count ? in[i] : 0.0f;
+            }
+            src = buf;
+        }
+
+        __m128 red = _mm_loadu_ps(src);
+        __m128 grn = _mm_loadu_ps(src + 4);
+        __m128 blu = _mm_loadu_ps(src + 8);
+        __m128 alp = _mm_loadu_ps(src + 12);
+        _MM_TRANSPOSE4_PS(red, grn, blu, alp);
+
+        func(red, grn, blu);
+
+        _MM_TRANSPOSE4_PS(red, grn, blu, alp);
+        float * dst = count<4 ? buf : out;
+        _mm_storeu_ps(dst,      red);
+        _mm_storeu_ps(dst + 4,  grn);
+        _mm_storeu_ps(dst + 8,  blu);
+        _mm_storeu_ps(dst + 12, alp);
+
+        if(count<4)
+        {
+            for(long i=0; i<4*count; ++i)
+            {
+                out[i] = buf[i];
+            }
+        }
+
+        in  += 16;
+        out += 16;
+    }
+}
+
 // Coefficients of Chebyshev (minimax) degree 5 polynomial
 // approximation to log2() over the range [1.0, 2.0[.
 static const __m128 PNLOG5 = _mm_set1_ps((float)+4.487361286440374006195e-2);
@@ -271,6 +382,125 @@ inline __m128 ssePower(__m128 x, __m128 exp)
     return values;
 }
 
+// Coefficients of minimax degree 4 polynomial approximation to log2()
+// over the range [1.0, 2.0[ (i.e. absolute error smaller than 8.8e-5).
+static const __m128 PNLOGF4 = _mm_set1_ps((float)-8.161580870888815e-2);
+static const __m128 PNLOGF3 = _mm_set1_ps((float)+6.451423648441851e-1);
+static const __m128 PNLOGF2 = _mm_set1_ps((float)-2.120675133862711);
+static const __m128 PNLOGF1 = _mm_set1_ps((float)+4.070090794467728);
+static const __m128 PNLOGF0 = _mm_set1_ps((float)-2.512854624818095);
+
+// Coefficients of minimax degree 3 polynomial approximation to exp2()
+// over the range [0.0, 1.0[ (i.e. relative error smaller than 7.5e-5).
+static const __m128 PNEXPF3 = _mm_set1_ps((float)7.802452266443176e-2);
+static const __m128 PNEXPF2 = _mm_set1_ps((float)2.260671553931302e-1);
+static const __m128 PNEXPF1 = _mm_set1_ps((float)6.958335405064480e-1);
+static const __m128 PNEXPF0 = _mm_set1_ps((float)9.999252185640100e-1);
+
+// Faster but less accurate version of sseLog2() i.e. the absolute error is
+// smaller than 1e-4 (instead of 1.3e-5). Refer to SetCPUFastMath().
+inline __m128 sseLog2Fast(__m128 x)
+{
+    __m128 mantissa
+        = _mm_or_ps(
+            _mm_andnot_ps(_mm_castsi128_ps(EMASK), x), EONE);
+
+    __m128 log2
+        = _mm_add_ps(
+            _mm_mul_ps(
+                _mm_add_ps(
+                    _mm_mul_ps(
+                        _mm_add_ps(
+                            _mm_mul_ps(
+                                _mm_add_ps(
+                                    _mm_mul_ps(PNLOGF4, mantissa),
+                                    PNLOGF3),
+                                mantissa),
+                            PNLOGF2),
+                        mantissa),
+                    PNLOGF1),
+                mantissa),
+            PNLOGF0);
+
+    __m128i exponent
+        = _mm_sub_epi32(
+            _mm_srli_epi32(
+                _mm_and_si128(_mm_castps_si128(x),
+                    EMASK),
+                EXP_SHIFT),
+            EBIAS);
+
+    log2 = _mm_add_ps(log2, _mm_cvtepi32_ps(exponent));
+
+    return log2;
+}
+
+// Faster but less accurate version of sseExp2() i.e. the relative error is
+// smaller than 7.5e-5 (instead of 2.6e-6). Refer to SetCPUFastMath().
+inline __m128 sseExp2Fast(__m128 x)
+{
+    __m128i floor_x
+        = _mm_add_epi32(
+            _mm_cvttps_epi32(x),
+            _mm_castps_si128(
+                _mm_cmpnle_ps(EZERO, x)));
+
+    __m128 zf
+        = _mm_castsi128_ps(
+            _mm_slli_epi32(
+                _mm_add_epi32(floor_x, EBIAS),
+                EXP_SHIFT));
+
+    __m128 iexp = _mm_cvtepi32_ps(floor_x);
+    __m128 fraction = _mm_sub_ps(x, iexp);
+
+    __m128 mexp
+        = _mm_add_ps(
+            _mm_mul_ps(
+                _mm_add_ps(
+                    _mm_mul_ps(
+                        _mm_add_ps(
+                            _mm_mul_ps(PNEXPF3, fraction),
+                            PNEXPF2),
+                        fraction),
+                    PNEXPF1),
+                fraction),
+            PNEXPF0);
+
+    __m128 exp2 = _mm_mul_ps(zf, mexp);
+
+    // Refer to sseExp2() for the underflow & overflow handling.
+    exp2 = _mm_andnot_ps(_mm_cmplt_ps(iexp, ENEG126), exp2);
+    exp2 = sseSelect(_mm_cmpgt_ps(iexp, EPOS127), EPOSINF, exp2);
+
+    return exp2;
+}
+
+// Faster but less accurate version of ssePower() i.e. the relative error is
+// smaller than 6.5e-5 * |exp| + 8e-5.
+// Refer to SetCPUFastMath().
+inline __m128 ssePowerFast(__m128 x, __m128 exp)
+{
+    __m128 values = sseLog2Fast(x);
+
+    values = _mm_mul_ps(exp, values);
+
+    values = sseExp2Fast(values);
+
+    // Handle values where base is smaller or equal than zero
+    values = _mm_and_ps(values, _mm_cmpgt_ps(x, EZERO));
+
+    return values;
+}
+
+// Select at compile time the accurate or the fast versions of the functions.
+template<bool fast> inline __m128 sseLog2(__m128 x) { return fast ? sseLog2Fast(x) : sseLog2(x); }
+template<bool fast> inline __m128 sseExp2(__m128 x) { return fast ? sseExp2Fast(x) : sseExp2(x); }
+template<bool fast> inline __m128 ssePower(__m128 x, __m128 exp)
+{
+    return fast ? ssePowerFast(x, exp) : ssePower(x, exp);
+}
+
 static const __m128 ESIGN_MASK = _mm_castsi128_ps(_mm_set1_epi32(0x80000000));
 static const __m128 EABS_MASK  = _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff));
 
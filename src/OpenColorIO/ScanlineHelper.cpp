@@ -2,10 +2,13 @@
 // Copyright Contributors to the OpenColorIO Project.
 
 #include <algorithm>
+#include <atomic>
+#include <cstring>
 
 #include <OpenColorIO/OpenColorIO.h>
 
 #include "BitDepthUtils.h"
+#include "Platform.h"
 #include "ScanlineHelper.h"
 
 
@@ -25,16 +28,252 @@ Optimizations GetOptimizationMode(const GenericImageDesc & imgDesc)
             optim = PACKED_FLOAT_OPTIMIZATION;
         }
     }
+    else if(imgDesc.isPackedFloatRGB())
+    {
+        optim = PACKED_RGB_FLOAT_OPTIMIZATION;
+    }
 
     return optim;
 }
 
+namespace
+{
+
+// Bounds of the computed block size (i.e. in pixels).
+constexpr long MIN_BLOCK_SIZE     = 256;
+constexpr long MAX_BLOCK_SIZE     = 8192;
+constexpr long DEFAULT_BLOCK_SIZE = 2048;
+
+std::atomic<long> g_blockSize(0); // Zero means computed from the L1 data cache size.
+
+// Used when the last level cache size is unknown.
+constexpr size_t DEFAULT_STREAMING_STORE_THRESHOLD = 32 * 1024 * 1024;
+
+// Zero means the last level cache size.
+std::atomic<size_t> g_streamingStoreThreshold(0);
+
+long ComputeBlockSize()
+{
+    const size_t cacheSize = Platform::GetL1DataCacheSize();
+    if(cacheSize==0)
+    {
+        return DEFAULT_BLOCK_SIZE;
+    }
+
+    // The RGBA F32 buffer uses 16 bytes per pixel.
+    return std::min(std::max(long(cacheSize / (4 * sizeof(float))), MIN_BLOCK_SIZE),
+                    MAX_BLOCK_SIZE);
+}
+
+}
+
+long GetCPUBlockSizeInPixels()
+{
+    const long blockSize = g_blockSize;
+    if(blockSize>0)
+    {
+        return blockSize;
+    }
+
+    static const long computedBlockSize = ComputeBlockSize();
+    return computedBlockSize;
+}
+
+void SetCPUBlockSize(long numPixels)
+{
+    if(numPixels<0)
+    {
+        throw Exception("Invalid CPU block size.");
+    }
+
+    g_blockSize = numPixels;
+}
+
+long GetCPUBlockSize()
+{
+    return GetCPUBlockSizeInPixels();
+}
+
+void SetCPUStreamingStoreThreshold(size_t numBytes)
+{
+    g_streamingStoreThreshold = numBytes;
+}
+
+size_t GetCPUStreamingStoreThreshold()
+{
+    const size_t threshold = g_streamingStoreThreshold;
+    if(threshold>0)
+    {
+        return threshold;
+    }
+
+    static const size_t cacheSize = Platform::GetLastLevelCacheSize();
+    return cacheSize>0 ? cacheSize : DEFAULT_STREAMING_STORE_THRESHOLD;
+}
+
+namespace
+{
+
+// Return the first byte of the first pixel if the pixels are only made of the color
+// channels (i.e. in any order, and without padding), or null otherwise.
+char * GetDensePixelData(const GenericImageDesc & img, size_t chanSizeBytes)
+{
+    char * chans[4] = { img.m_rData, img.m_gData, img.m_bData, img.m_aData };
+    const size_t numChans = img.m_aData ? 4 : 3;
+
+    if(img.m_xStrideBytes!=ptrdiff_t(numChans * chanSizeBytes))
+    {
+        return nullptr;
+    }
+
+    char * first = *std::min_element(chans, chans + numChans);
+
+    // Each channel must be at a distinct position inside the pixel.
+    bool used[4] = { false, false, false, false };
+    for(size_t idx=0; idx<numChans; ++idx)
+    {
+        const ptrdiff_t offset = chans[idx] - first;
+        if(offset % chanSizeBytes !=0 || size_t(offset / chanSizeBytes)>=numChans
+            || used[offset / chanSizeBytes])
+        {
+            return nullptr;
+        }
+        used[offset / chanSizeBytes] = true;
+    }
+
+    return first;
+}
+
+// Below this alpha, the color values of a premultiplied pixel are left untouched as they
+// could not be recovered (i.e. a transparent pixel keeps its color values as is).
+constexpr float PREMULTIPLIED_ALPHA_THRESHOLD = 1e-6f;
+
+// Divide the color values of packed RGBA F32 pixels by their alpha.
+void Unpremultiply(float * rgba, long numPixels)
+{
+    for(long idx=0; idx<numPixels; ++idx, rgba+=4)
+    {
+        const float alpha = rgba[3];
+        if(alpha>PREMULTIPLIED_ALPHA_THRESHOLD)
+        {
+            const float invAlpha = 1.0f / alpha;
+            rgba[0] *= invAlpha;
+            rgba[1] *= invAlpha;
+            rgba[2] *= invAlpha;
+        }
+    }
+}
+
+// Multiply the color values of packed RGBA F32 pixels by their alpha. When the source
+// pixels were premultiplied, the ones left untouched by Unpremultiply() are skipped
+// so the round trip preserves their color values.
+void Premultiply(float * rgba, long numPixels, bool skipTransparent)
+{
+    for(long idx=0; idx<numPixels; ++idx, rgba+=4)
+    {
+        const float alpha = rgba[3];
+        if(!skipTransparent || alpha>PREMULTIPLIED_ALPHA_THRESHOLD)
+        {
+            rgba[0] *= alpha;
+            rgba[1] *= alpha;
+            rgba[2] *= alpha;
+        }
+    }
+}
+
+// The 8x8 Bayer matrix i.e. the 64 rounding thresholds of the ordered dithering.
+constexpr uint8_t BAYER_MATRIX[8][8] =
+{
+    {  0, 32,  8, 40,  2, 34, 10, 42 },
+    { 48, 16, 56, 24, 50, 18, 58, 26 },
+    { 12, 44,  4, 36, 14, 46,  6, 38 },
+    { 60, 28, 52, 20, 62, 30, 54, 22 },
+    {  3, 35, 11, 43,  1, 33,  9, 41 },
+    { 51, 19, 59, 27, 49, 17, 57, 25 },
+    { 15, 47,  7, 39, 13, 45,  5, 37 },
+    { 63, 31, 55, 23, 61, 29, 53, 21 }
+};
+
+// Add to the color values of packed RGBA F32 pixels an offset in ]-0.5, 0.5[ of the output
+// code depending on the pixel position, so the rounding of the output conversion then
+// uses the matrix thresholds instead of 0.5. The pixels are at (x, y) in the image buffer.
+void DitherOrdered(float * rgba, long numPixels, long x, long y, BitDepth outBitDepth)
+{
+    const float codeSize = float(1.0 / GetBitDepthMaxValue(outBitDepth));
+
+    float offsets[8];
+    for(long idx=0; idx<8; ++idx)
+    {
+        offsets[idx] = ((BAYER_MATRIX[y & 7][idx] + 0.5f) / 64.0f - 0.5f) * codeSize;
+    }
+
+    for(long idx=0; idx<numPixels; ++idx, rgba+=4)
+    {
+        const float offset = offsets[(x + idx) & 7];
+        rgba[0] += offset;
+        rgba[1] += offset;
+        rgba[2] += offset;
+    }
+}
+
+// Move the first pixel of each run of identical packed RGBA F32 pixels (i.e. bitwise
+// identical) at the start of the buffer, and return the number of runs. 'runEnds' then
+// holds the index following the last pixel of each run.
+long CompactRuns(float * rgba, long numPixels, long * runEnds)
+{
+    constexpr size_t pixelSize = 4 * sizeof(float);
+
+    float run[4];
+    memcpy(run, rgba, pixelSize);
+
+    long numRuns = 0;
+    for(long idx=1; idx<numPixels; ++idx)
+    {
+        const float * pixel = rgba + 4 * idx;
+        if(memcmp(pixel, run, pixelSize)!=0)
+        {
+            // The run is moved before the current pixel.
+            memcpy(rgba + 4 * numRuns, run, pixelSize);
+            runEnds[numRuns++] = idx;
+
+            memcpy(run, pixel, pixelSize);
+        }
+    }
+
+    memcpy(rgba + 4 * numRuns, run, pixelSize);
+    runEnds[numRuns++] = numPixels;
+
+    return numRuns;
+}
+
+// Copy the processed first pixel of each run to all the pixels of the run, starting from
+// the last run so the first pixels of the other runs are not overwritten.
+void ExpandRuns(float * rgba, long numRuns, const long * runEnds)
+{
+    constexpr size_t pixelSize = 4 * sizeof(float);
+
+    for(long run=numRuns-1; run>=0; --run)
+    {
+        float pixel[4];
+        memcpy(pixel, rgba + 4 * run, pixelSize);
+
+        for(long idx=(run>0 ? runEnds[run-1] : 0); idx<runEnds[run]; ++idx)
+        {
+            memcpy(rgba + 4 * idx, pixel, pixelSize);
+        }
+    }
+}
+
+}
+
 
 template<typename InType, typename OutType>
 GenericScanlineHelper<InType, OutType>::GenericScanlineHelper(BitDepth inputBitDepth,
                                                               const ConstOpCPURcPtr & inBitDepthOp,
                                                               BitDepth outputBitDepth,
-                                                              const ConstOpCPURcPtr & outBitDepthOp)
+                                                              const ConstOpCPURcPtr & outBitDepthOp,
+                                                              bool touchesAlpha,
+                                                              bool repeatedPixels)
     :   ScanlineHelper()
     ,   m_inputBitDepth(inputBitDepth)
     ,   m_outputBitDepth(outputBitDepth)
@@ -43,7 +282,19 @@ GenericScanlineHelper<InType, OutType>::GenericScanlineHelper(BitDepth inputBitD
     ,   m_inOptimizedMode(NO_OPTIMIZATION)
     ,   m_outOptimizedMode(NO_OPTIMIZATION)
     ,   m_yIndex(0)
+    ,   m_yEnd(0)
+    ,   m_xIndex(0)
+    ,   m_blockSize(GetCPUBlockSizeInPixels())
+    ,   m_numPixelsInBlock(0)
     ,   m_useDstBuffer(false)
+    ,   m_touchesAlpha(touchesAlpha)
+    ,   m_repeatedPixels(repeatedPixels)
+    ,   m_numRuns(0)
+    ,   m_blockBuffer(nullptr)
+    ,   m_numEvaluatedPixels(0)
+    ,   m_srcAlphaData(nullptr)
+    ,   m_dstAlphaData(nullptr)
+    ,   m_dstPixelData(nullptr)
 {
 }
 
@@ -51,6 +302,10 @@ template<typename InType, typename OutType>
 void GenericScanlineHelper<InType, OutType>::init(const ImageDesc & srcImg, const ImageDesc & dstImg)
 {
     m_yIndex = 0;
+    m_xIndex = 0;
+
+    // Note that the helper could be reused for several images.
+    m_blockSize = GetCPUBlockSizeInPixels();
 
     m_srcImg.init(srcImg, m_inputBitDepth, m_inBitDepthOp);
     m_dstImg.init(dstImg, m_outputBitDepth, m_outBitDepthOp);
@@ -60,22 +315,28 @@ void GenericScanlineHelper<InType, OutType>::init(const ImageDesc & srcImg, cons
         throw Exception("Dimension inconsistency between source and destination image buffers.");
     }
 
+    m_yEnd = m_dstImg.m_height;
+
     m_inOptimizedMode  = GetOptimizationMode(m_srcImg);
     m_outOptimizedMode = GetOptimizationMode(m_dstImg);
 
+    initAlphaCopy();
+    initStreaming();
+
     // Can the output buffer be used as the internal RGBA F32 buffer?
     m_useDstBuffer
-        = (m_outOptimizedMode & PACKED_FLOAT_OPTIMIZATION) == PACKED_FLOAT_OPTIMIZATION;
+        = (m_outOptimizedMode & PACKED_FLOAT_OPTIMIZATION) == PACKED_FLOAT_OPTIMIZATION
+            && !m_dstPixelData;
 
     if( (m_inOptimizedMode & PACKED_OPTIMIZATION) != PACKED_OPTIMIZATION)
     {
-        const long bufferSize = 4 * m_dstImg.m_width;
+        const long bufferSize = 4 * std::min(m_dstImg.m_width, m_blockSize);
         m_inBitDepthBuffer.resize(bufferSize);
     }
 
     if(!m_useDstBuffer)
     {
-        const long bufferSize = 4 * m_dstImg.m_width;
+        const long bufferSize = 4 * std::min(m_dstImg.m_width, m_blockSize);
         m_rgbaFloatBuffer.resize(bufferSize);
         m_outBitDepthBuffer.resize(bufferSize);
     }
@@ -85,23 +346,34 @@ template<typename InType, typename OutType>
 void GenericScanlineHelper<InType, OutType>::init(const ImageDesc & img)
 {
     m_yIndex = 0;
+    m_xIndex = 0;
+
+    // Note that the helper could be reused for several images.
+    m_blockSize = GetCPUBlockSizeInPixels();
 
     m_srcImg.init(img, m_inputBitDepth, m_inBitDepthOp);
     m_dstImg.init(img, m_outputBitDepth, m_outBitDepthOp);
 
+    m_yEnd = m_dstImg.m_height;
+
     m_inOptimizedMode  = GetOptimizationMode(m_srcImg);
     m_outOptimizedMode = m_inOptimizedMode;
 
+    initAlphaCopy();
+
+    // The in-place processing always writes through the caches.
+    m_dstPixelData = nullptr;
+
     // Can the output buffer be used as the internal RGBA F32 buffer?
     m_useDstBuffer
         = (m_outOptimizedMode & PACKED_FLOAT_OPTIMIZATION) == PACKED_FLOAT_OPTIMIZATION;
 
     if(!m_useDstBuffer)
     {
-        // TODO: Re-use memory from thread-safe memory pool, rather
-        // than doing a new allocation each time.
+        // Note that the buffers only allocate if the helper is not reused
+        // (refer to the CPUProcessor pool of helpers) or if the image is wider.
 
-        const long bufferSize = 4 * m_dstImg.m_width;
+        const long bufferSize = 4 * std::min(m_dstImg.m_width, m_blockSize);
 
         m_rgbaFloatBuffer.resize(bufferSize);
         m_inBitDepthBuffer.resize(bufferSize);
@@ -109,6 +381,115 @@ void GenericScanlineHelper<InType, OutType>::init(const ImageDesc & img)
     }
 }
 
+template<typename InType, typename OutType>
+void GenericScanlineHelper<InType, OutType>::initAlphaCopy()
+{
+    m_srcAlphaData = nullptr;
+    m_dstAlphaData = nullptr;
+
+    // Only the arbitrary channel layouts are concerned as the packed RGBA buffers
+    // are converted at once (i.e. including the alpha channel). The (un)premultiplication
+    // always needs the alpha values.
+    if(m_touchesAlpha || m_srcImg.m_isPremultiplied || m_dstImg.m_isPremultiplied
+        || m_inputBitDepth!=m_outputBitDepth || !m_srcImg.m_aData
+        || (m_inOptimizedMode&PACKED_OPTIMIZATION)==PACKED_OPTIMIZATION
+        || (m_outOptimizedMode&PACKED_OPTIMIZATION)==PACKED_OPTIMIZATION)
+    {
+        return;
+    }
+
+    // The byte shuffles of the four channel layouts convert the alpha values along with the
+    // color ones at no cost, and exactly except for the 32-bit integers.
+    if(m_inputBitDepth!=BIT_DEPTH_UINT32
+        && CanShuffleRGBA(m_srcImg, sizeof(InType)) && CanShuffleRGBA(m_dstImg, sizeof(OutType)))
+    {
+        return;
+    }
+
+    // Nothing to copy when processing in place.
+    const bool sameAlpha = m_srcImg.m_aData==m_dstImg.m_aData
+                            && m_srcImg.m_xStrideBytes==m_dstImg.m_xStrideBytes
+                            && m_srcImg.m_yStrideBytes==m_dstImg.m_yStrideBytes
+                            && m_srcImg.m_rows[3]==m_dstImg.m_rows[3];
+
+    if(m_dstImg.m_aData && !sameAlpha)
+    {
+        m_srcAlphaData = m_srcImg.m_aData;
+        m_dstAlphaData = m_dstImg.m_aData;
+    }
+
+    // The packing then uses zeros for the alpha, and the unpacking ignores it.
+    m_srcImg.m_aData = nullptr;
+    m_dstImg.m_aData = nullptr;
+}
+
+template<typename InType, typename OutType>
+void GenericScanlineHelper<InType, OutType>::initStreaming()
+{
+    m_dstPixelData = nullptr;
+
+    // When the alpha values are copied, the destination pixels are not written at once.
+    // A line buffer (i.e. reused by all the lines, refer to CPUProcessorGroup) must stay
+    // in the caches, and the separate lines (refer to ScanlineImageDesc) are not a dense
+    // block of pixels.
+    if(m_dstAlphaData || !m_dstImg.m_rData || m_dstImg.m_yStrideBytes==0)
+    {
+        return;
+    }
+
+    char * pixelData = GetDensePixelData(m_dstImg, sizeof(OutType));
+    if(!pixelData)
+    {
+        return;
+    }
+
+    const size_t imgSizeBytes
+        = size_t(m_dstImg.m_xStrideBytes) * m_dstImg.m_width * m_dstImg.m_height;
+
+    if(imgSizeBytes<GetCPUStreamingStoreThreshold())
+    {
+        return;
+    }
+
+    m_dstPixelData = pixelData;
+
+    if((m_outOptimizedMode&PACKED_OPTIMIZATION)!=PACKED_OPTIMIZATION)
+    {
+        // The pixels are unpacked in a line buffer having the destination layout, which
+        // is then streamed to the destination image.
+
+        const long numPixels = std::min(m_dstImg.m_width, m_blockSize);
+        m_streamingBuffer.resize(numPixels * m_dstImg.m_xStrideBytes / sizeof(OutType));
+
+        char * streamingData = reinterpret_cast<char *>(&m_streamingBuffer[0]);
+
+        m_streamingImg = m_dstImg;
+        m_streamingImg.m_width  = numPixels;
+        m_streamingImg.m_height = 1;
+        m_streamingImg.m_yStrideBytes = numPixels * m_dstImg.m_xStrideBytes;
+        m_streamingImg.m_rData = streamingData + (m_dstImg.m_rData - pixelData);
+        m_streamingImg.m_gData = streamingData + (m_dstImg.m_gData - pixelData);
+        m_streamingImg.m_bData = streamingData + (m_dstImg.m_bData - pixelData);
+        m_streamingImg.m_aData
+            = m_dstImg.m_aData ? streamingData + (m_dstImg.m_aData - pixelData) : nullptr;
+    }
+}
+
+template<typename InType, typename OutType>
+void GenericScanlineHelper<InType, OutType>::setLineRange(long yBegin, long yEnd)
+{
+    if(yBegin<0 || yBegin>yEnd || yEnd>m_dstImg.m_height)
+    {
+        throw Exception("Invalid line range.");
+    }
+
+    m_yIndex = int(yBegin);
+    m_yEnd   = int(yEnd);
+    m_xIndex = 0;
+
+    m_numEvaluatedPixels = 0;
+}
+
 template<typename InType, typename OutType>
 GenericScanlineHelper<InType, OutType>::~GenericScanlineHelper()
 {
@@ -118,22 +499,27 @@ GenericScanlineHelper<InType, OutType>::~GenericScanlineHelper()
 template<typename InType, typename OutType>
 void GenericScanlineHelper<InType, OutType>::prepRGBAScanline(float** buffer, long & numPixels)
 {
-    // Note that only a line-by-line processing is done on the image buffer.
+    // Note that a line is processed block by block so the intermediate buffers fit
+    // in the CPU data cache.
 
-    if(m_yIndex >= m_dstImg.m_height)
+    if(m_yIndex >= m_yEnd)
     {
         numPixels = 0;
         return;
     }
 
-    *buffer = m_useDstBuffer ? (float*)(m_dstImg.m_rData + m_dstImg.m_yStrideBytes * m_yIndex)
+    m_numPixelsInBlock = std::min(m_dstImg.m_width - m_xIndex, m_blockSize);
+
+    *buffer = m_useDstBuffer ? (float*)(m_dstImg.getLineData(m_dstImg.m_rData, 0, m_yIndex)
+                                        + m_dstImg.m_xStrideBytes * m_xIndex)
                              : &m_rgbaFloatBuffer[0];
 
     if((m_inOptimizedMode&PACKED_OPTIMIZATION)==PACKED_OPTIMIZATION)
     {
-        const void * inBuffer = (void*)(m_srcImg.m_rData + m_srcImg.m_yStrideBytes * m_yIndex);
+        const void * inBuffer = (void*)(m_srcImg.getLineData(m_srcImg.m_rData, 0, m_yIndex)
+                                        + m_srcImg.m_xStrideBytes * m_xIndex);
 
-        m_srcImg.m_bitDepthOp->apply(inBuffer, *buffer, m_dstImg.m_width);
+        m_srcImg.m_bitDepthOp->apply(inBuffer, *buffer, m_numPixelsInBlock);
     }
     else
     {
@@ -142,26 +528,88 @@ void GenericScanlineHelper<InType, OutType>::prepRGBAScanline(float** buffer, lo
         Generic<InType>::PackRGBAFromImageDesc(m_srcImg,
                                                &m_inBitDepthBuffer[0],
                                                *buffer,
-                                               m_dstImg.m_width,
-                                               m_yIndex * m_dstImg.m_width);
+                                               int(m_numPixelsInBlock),
+                                               m_yIndex * m_dstImg.m_width + m_xIndex);
+    }
+
+    if(m_srcImg.m_isPremultiplied)
+    {
+        Unpremultiply(*buffer, m_numPixelsInBlock);
     }
 
-    numPixels = m_dstImg.m_width;
+    m_blockBuffer = *buffer;
+
+    if(m_repeatedPixels)
+    {
+        m_runEnds.resize(m_blockSize);
+        m_numRuns = CompactRuns(*buffer, m_numPixelsInBlock, &m_runEnds[0]);
+
+        numPixels = m_numRuns;
+    }
+    else
+    {
+        numPixels = m_numPixelsInBlock;
+    }
+
+    m_numEvaluatedPixels += numPixels;
 }
 
 // Write back the result of our work, from the scanline to our destination image.
 template<typename InType, typename OutType>
 void GenericScanlineHelper<InType, OutType>::finishRGBAScanline()
 {
-    // Note that only a line-by-line processing is done on the image buffer.
+    if(m_repeatedPixels && m_numRuns<m_numPixelsInBlock)
+    {
+        ExpandRuns(m_blockBuffer, m_numRuns, &m_runEnds[0]);
+    }
+
+    if(m_dstImg.m_isPremultiplied)
+    {
+        Premultiply(m_blockBuffer, m_numPixelsInBlock, m_srcImg.m_isPremultiplied);
+    }
 
-    if((m_outOptimizedMode&PACKED_OPTIMIZATION)==PACKED_OPTIMIZATION)
+    if(m_dstImg.m_dither==DITHER_ORDERED)
     {
-        void * out = (void*)(m_dstImg.m_rData + m_dstImg.m_yStrideBytes * m_yIndex);
+        // The destination image is not a float one so the block is in m_rgbaFloatBuffer.
+        DitherOrdered(&m_rgbaFloatBuffer[0], m_numPixelsInBlock,
+                      m_dstImg.m_ditherX + m_xIndex, m_dstImg.m_ditherY + m_yIndex,
+                      m_outputBitDepth);
+    }
+
+    if(m_dstPixelData)
+    {
+        // Prepare the block in the destination layout, and stream it.
+
+        char * out = m_dstPixelData + m_dstImg.m_yStrideBytes * m_yIndex
+                                    + m_dstImg.m_xStrideBytes * m_xIndex;
+
+        const void * block = nullptr;
+        if((m_outOptimizedMode&PACKED_OPTIMIZATION)==PACKED_OPTIMIZATION)
+        {
+            m_dstImg.m_bitDepthOp->apply(&m_rgbaFloatBuffer[0], &m_outBitDepthBuffer[0],
+                                         m_numPixelsInBlock);
+            block = &m_outBitDepthBuffer[0];
+        }
+        else
+        {
+            Generic<OutType>::UnpackRGBAToImageDesc(m_streamingImg,
+                                                    &m_rgbaFloatBuffer[0],
+                                                    &m_outBitDepthBuffer[0],
+                                                    int(m_numPixelsInBlock),
+                                                    0);
+            block = &m_streamingBuffer[0];
+        }
+
+        StreamingCopy(out, block, m_numPixelsInBlock * m_dstImg.m_xStrideBytes);
+    }
+    else if((m_outOptimizedMode&PACKED_OPTIMIZATION)==PACKED_OPTIMIZATION)
+    {
+        void * out = (void*)(m_dstImg.getLineData(m_dstImg.m_rData, 0, m_yIndex)
+                             + m_dstImg.m_xStrideBytes * m_xIndex);
 
         const void * in  = m_useDstBuffer ? out : (void*)&m_rgbaFloatBuffer[0];
 
-        m_dstImg.m_bitDepthOp->apply(in, out, m_dstImg.m_width);
+        m_dstImg.m_bitDepthOp->apply(in, out, m_numPixelsInBlock);
     }
     else
     {
@@ -169,11 +617,40 @@ void GenericScanlineHelper<InType, OutType>::finishRGBAScanline()
         Generic<OutType>::UnpackRGBAToImageDesc(m_dstImg,
                                                 &m_rgbaFloatBuffer[0],
                                                 &m_outBitDepthBuffer[0],
-                                                m_dstImg.m_width,
-                                                m_yIndex * m_dstImg.m_width);
+                                                int(m_numPixelsInBlock),
+                                                m_yIndex * m_dstImg.m_width + m_xIndex);
+    }
+
+    if(m_dstAlphaData)
+    {
+        // The bit-depths are the same, so the values are only copied.
+        const char * in = m_srcImg.getLineData(m_srcAlphaData, 3, m_yIndex)
+                            + m_srcImg.m_xStrideBytes * m_xIndex;
+        char * out = m_dstImg.getLineData(m_dstAlphaData, 3, m_yIndex)
+                        + m_dstImg.m_xStrideBytes * m_xIndex;
+
+        for(long idx=0; idx<m_numPixelsInBlock; ++idx)
+        {
+            *reinterpret_cast<OutType*>(out)
+                = static_cast<OutType>(*reinterpret_cast<const InType*>(in));
+
+            in  += m_srcImg.m_xStrideBytes;
+            out += m_dstImg.m_xStrideBytes;
+        }
     }
 
-    ++m_yIndex;
+    // Move to the next block, or to the next line.
+    m_xIndex += m_numPixelsInBlock;
+    if(m_xIndex >= m_dstImg.m_width)
+    {
+        m_xIndex = 0;
+        ++m_yIndex;
+
+        if(m_dstPixelData && m_yIndex>=m_yEnd)
+        {
+            StreamingFence();
+        }
+    }
 }
 
 
@@ -187,21 +664,31 @@ template class GenericScanlineHelper<uint8_t, uint8_t>;
 template class GenericScanlineHelper<uint8_t, uint16_t>;
 template class GenericScanlineHelper<uint8_t, half>;
 template class GenericScanlineHelper<uint8_t, float>;
+template class GenericScanlineHelper<uint8_t, uint32_t>;
 
 template class GenericScanlineHelper<uint16_t, uint8_t>;
 template class GenericScanlineHelper<uint16_t, uint16_t>;
 template class GenericScanlineHelper<uint16_t, half>;
 template class GenericScanlineHelper<uint16_t, float>;
+template class GenericScanlineHelper<uint16_t, uint32_t>;
 
 template class GenericScanlineHelper<half, uint8_t>;
 template class GenericScanlineHelper<half, uint16_t>;
 template class GenericScanlineHelper<half, half>;
 template class GenericScanlineHelper<half, float>;
+template class GenericScanlineHelper<half, uint32_t>;
 
 template class GenericScanlineHelper<float, uint8_t>;
 template class GenericScanlineHelper<float, uint16_t>;
 template class GenericScanlineHelper<float, half>;
 template class GenericScanlineHelper<float, float>;
+template class GenericScanlineHelper<float, uint32_t>;
+
+template class GenericScanlineHelper<uint32_t, uint8_t>;
+template class GenericScanlineHelper<uint32_t, uint16_t>;
+template class GenericScanlineHelper<uint32_t, half>;
+template class GenericScanlineHelper<uint32_t, float>;
+template class GenericScanlineHelper<uint32_t, uint32_t>;
 
 
 }
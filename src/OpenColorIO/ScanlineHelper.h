@@ -18,12 +18,17 @@ enum Optimizations
     NO_OPTIMIZATION     = 0x00,
     PACKED_OPTIMIZATION = 0x01,  // The image is a packed RGBA buffer.
     FLOAT_OPTIMIZATION  = 0x02,  // The image is a F32 i.e. 32-bit float.
+    PACKED_RGB_OPTIMIZATION = 0x04,  // The image is a packed RGB buffer (i.e. no alpha).
 
-    PACKED_FLOAT_OPTIMIZATION = (PACKED_OPTIMIZATION|FLOAT_OPTIMIZATION)
+    PACKED_FLOAT_OPTIMIZATION = (PACKED_OPTIMIZATION|FLOAT_OPTIMIZATION),
+    PACKED_RGB_FLOAT_OPTIMIZATION = (PACKED_RGB_OPTIMIZATION|FLOAT_OPTIMIZATION)
 };
 
 Optimizations GetOptimizationMode(const GenericImageDesc & imgDesc);
 
+// Get the number of pixels processed at once (refer to SetCPUBlockSize()).
+long GetCPUBlockSizeInPixels();
+
 
 class ScanlineHelper
 {
@@ -37,9 +42,17 @@ public:
     virtual void init(const ImageDesc & srcImg, const ImageDesc & dstImg) = 0;
     virtual void init(const ImageDesc & img) = 0;
 
+    // Restrict the processing to the lines [yBegin, yEnd[ of the image
+    // (i.e. to be called after init() which selects all the lines).
+    virtual void setLineRange(long yBegin, long yEnd) = 0;
+
     virtual void prepRGBAScanline(float** buffer, long & numPixels) = 0;
     
     virtual void finishRGBAScanline() = 0;
+
+    // Get the number of pixels returned by prepRGBAScanline() since setLineRange() i.e.
+    // the number of pixels evaluated by the CPU Ops.
+    virtual long long getNumEvaluatedPixels() const = 0;
 };
 
 template<typename InType, typename OutType>
@@ -50,16 +63,23 @@ public:
     GenericScanlineHelper(const GenericScanlineHelper&) = delete;
     GenericScanlineHelper& operator=(const GenericScanlineHelper&) = delete;
 
+    // Note that 'touchesAlpha' is false when the color processing only copies
+    // the alpha values (refer to OpData::touchesAlpha()), and that 'repeatedPixels'
+    // evaluates once each run of identical pixels (refer to OPTIMIZATION_REPEATED_PIXELS).
     GenericScanlineHelper(BitDepth inputBitDepth, const ConstOpCPURcPtr & inBitDepthOp,
-                          BitDepth outputBitDepth, const ConstOpCPURcPtr & outBitDepthOp);
+                          BitDepth outputBitDepth, const ConstOpCPURcPtr & outBitDepthOp,
+                          bool touchesAlpha, bool repeatedPixels);
 
     void init(const ImageDesc & srcImg, const ImageDesc & dstImg) override;
     void init(const ImageDesc & img) override;
 
+    void setLineRange(long yBegin, long yEnd) override;
+
     ~GenericScanlineHelper() override;
 
     // Copy from the src image to our scanline, in our preferred
-    // pixel layout. Return the number of pixels to process.
+    // pixel layout. Return the number of pixels to process i.e. a line is
+    // processed in several blocks when it is wider than the block size.
 
     void prepRGBAScanline(float** buffer, long & numPixels) override;
 
@@ -68,7 +88,15 @@ public:
 
     void finishRGBAScanline() override;
 
+    long long getNumEvaluatedPixels() const override { return m_numEvaluatedPixels; }
+
 private:
+    // When the alpha channel is untouched, bypass its packing & unpacking.
+    void initAlphaCopy();
+    // When the destination image is large, write it with streaming stores
+    // (refer to SetCPUStreamingStoreThreshold()).
+    void initStreaming();
+
     BitDepth m_inputBitDepth;
     BitDepth m_outputBitDepth;
     ConstOpCPURcPtr m_inBitDepthOp;
@@ -90,11 +118,47 @@ private:
 
     // The index of the current line to process.
     int m_yIndex;
+    // The index of the line ending the processing.
+    int m_yEnd;
+    // The index of the first pixel of the current block in the current line.
+    long m_xIndex;
+
+    // The maximum number of pixels of a block and the number of pixels
+    // of the current block.
+    long m_blockSize;
+    long m_numPixelsInBlock;
 
     // If the destination buffer is packed RGBA F32 it could then be used
     // as the internal processing buffer (i.e. instead of m_rgbaFloatBuffer
     // and m_outBitDepthBuffer).
     bool m_useDstBuffer;
+
+    // Does the color processing change (or use) the alpha channel?
+    bool m_touchesAlpha;
+
+    // When true, only the first pixel of each run of identical pixels is processed i.e.
+    // prepRGBAScanline() moves them at the start of the block, and finishRGBAScanline()
+    // copies the processed pixels to their runs, m_runEnds holding the index following
+    // the last pixel of each run.
+    bool m_repeatedPixels;
+    std::vector<long> m_runEnds;
+    long m_numRuns;
+    // The buffer holding the RGBA F32 pixels of the current block.
+    float * m_blockBuffer;
+
+    long long m_numEvaluatedPixels;
+
+    // When not null, the alpha values are directly copied from the source to
+    // the destination image instead of being packed & unpacked with the RGB ones.
+    char * m_srcAlphaData;
+    char * m_dstAlphaData;
+
+    // When not null, the first byte of the destination image which is then written
+    // block by block with streaming stores, the blocks being first unpacked (if needed)
+    // in m_streamingBuffer described by m_streamingImg.
+    char * m_dstPixelData;
+    GenericImageDesc m_streamingImg;
+    std::vector<OutType> m_streamingBuffer;
 };
 
 
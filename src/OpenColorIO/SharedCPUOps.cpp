@@ -0,0 +1,286 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the OpenColorIO Project.
+
+#include <map>
+#include <memory>
+#include <sstream>
+#include <string>
+
+#include <OpenColorIO/OpenColorIO.h>
+
+#include "BitDepthUtils.h"
+#include "Mutex.h"
+#include "ops/Lut1D/Lut1DOpData.h"
+#include "ops/Lut3D/Lut3DOpData.h"
+#include "SharedCPUOps.h"
+
+
+OCIO_NAMESPACE_ENTER
+{
+
+namespace
+{
+
+// The registry only holds weak references so a renderer is released with the last
+// processor using it. The key is the op cache id, the inversion quality (i.e. not part
+// of the LUT cache ids) and the bit-depths.
+typedef std::map<std::string, std::weak_ptr<const OpCPU>> SharedCPUOpMap;
+
+SharedCPUOpMap g_sharedCPUOps;
+Mutex g_sharedCPUOpsLock;
+
+// Number of entries after the last removal of the expired ones.
+size_t g_numSharedCPUOpsAfterSweep = 0;
+
+std::string GetSharedCPUOpKey(const ConstOpRcPtr & op, BitDepth in, BitDepth out)
+{
+    // A cache id is only available once the op is finalized.
+    const std::string cacheID = op->getCacheID();
+    if (cacheID.empty())
+    {
+        return "";
+    }
+
+    ConstOpDataRcPtr data = op->data();
+
+    LutInversionQuality quality = LUT_INVERSION_EXACT;
+    switch (data->getType())
+    {
+        case OpData::Lut1DType:
+        {
+            ConstLut1DOpDataRcPtr lut = DynamicPtrCast<const Lut1DOpData>(data);
+            quality = lut->getConcreteInversionQuality();
+            break;
+        }
+        case OpData::Lut3DType:
+        {
+            ConstLut3DOpDataRcPtr lut = DynamicPtrCast<const Lut3DOpData>(data);
+            quality = lut->getConcreteInversionQuality();
+            break;
+        }
+        default:
+        {
+            // The other renderers are cheap to create.
+            return "";
+        }
+    }
+
+    std::ostringstream oss;
+    oss << cacheID << " " << int(quality) << " "
+        << BitDepthToString(in) << " " << BitDepthToString(out);
+    return oss.str();
+}
+
+// Remove the expired entries once the map doubled since the last removal.
+void SweepSharedCPUOps()
+{
+    if (g_sharedCPUOps.size() < 2 * g_numSharedCPUOpsAfterSweep + 16)
+    {
+        return;
+    }
+
+    for (auto iter = g_sharedCPUOps.begin(); iter != g_sharedCPUOps.end(); )
+    {
+        if (iter->second.expired())
+        {
+            iter = g_sharedCPUOps.erase(iter);
+        }
+        else
+        {
+            ++iter;
+        }
+    }
+
+    g_numSharedCPUOpsAfterSweep = g_sharedCPUOps.size();
+}
+
+}
+
+ConstOpCPURcPtr GetSharedCPUOp(const ConstOpRcPtr & op, BitDepth in, BitDepth out,
+                               const std::function<ConstOpCPURcPtr()> & createRenderer)
+{
+    const std::string key = GetSharedCPUOpKey(op, in, out);
+    if (key.empty())
+    {
+        return createRenderer();
+    }
+
+    {
+        AutoMutex lock(g_sharedCPUOpsLock);
+
+        SharedCPUOpMap::const_iterator iter = g_sharedCPUOps.find(key);
+        if (iter != g_sharedCPUOps.end())
+        {
+            ConstOpCPURcPtr renderer = iter->second.lock();
+            if (renderer)
+            {
+                return renderer;
+            }
+        }
+    }
+
+    // Note that the lock is not held while creating the renderer as it could be
+    // expensive (e.g. the inverse LUTs).
+    ConstOpCPURcPtr renderer = createRenderer();
+
+    AutoMutex lock(g_sharedCPUOpsLock);
+
+    // Another thread could have created the same renderer in the meantime.
+    std::weak_ptr<const OpCPU> & entry = g_sharedCPUOps[key];
+    ConstOpCPURcPtr existing = entry.lock();
+    if (existing)
+    {
+        return existing;
+    }
+
+    entry = renderer;
+    SweepSharedCPUOps();
+
+    return renderer;
+}
+
+void ClearSharedCPUOpCache()
+{
+    AutoMutex lock(g_sharedCPUOpsLock);
+    g_sharedCPUOps.clear();
+    g_numSharedCPUOpsAfterSweep = 0;
+}
+
+size_t GetNumSharedCPUOps()
+{
+    AutoMutex lock(g_sharedCPUOpsLock);
+
+    size_t count = 0;
+    for (const auto & entry : g_sharedCPUOps)
+    {
+        if (!entry.second.expired())
+        {
+            ++count;
+        }
+    }
+    return count;
+}
+
+}
+OCIO_NAMESPACE_EXIT
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+
+
+
+#ifdef OCIO_UNIT_TEST
+
+#include <sstream>
+
+namespace OCIO = OCIO_NAMESPACE;
+#include "ops/Lut3D/Lut3DOp.h"
+#include "ops/Matrix/MatrixOps.h"
+#include "UnitTest.h"
+#include "UnitTestUtils.h"
+
+OCIO_ADD_TEST(SharedCPUOps, lut_renderers)
+{
+    OCIO::ClearSharedCPUOpCache();
+
+    auto lut = std::make_shared<OCIO::Lut3DOpData>(17);
+
+    OCIO::OpRcPtrVec ops;
+    OCIO::CreateLut3DOp(ops, lut, OCIO::TRANSFORM_DIR_FORWARD);
+    OCIO::CreateLut3DOp(ops, lut, OCIO::TRANSFORM_DIR_INVERSE);
+    const double scale[4] = { 2.0, 2.0, 2.0, 1.0 };
+    OCIO::CreateScaleOp(ops, scale, OCIO::TRANSFORM_DIR_FORWARD);
+    OCIO_REQUIRE_EQUAL(ops.size(), 3);
+
+    // Not finalized ops are never shared.
+    const OCIO::ConstOpRcPtr notFinalized = ops[0];
+    auto create = [&notFinalized]() { return notFinalized->getCPUOp(); };
+    OCIO::ConstOpCPURcPtr r1
+        = OCIO::GetSharedCPUOp(notFinalized, OCIO::BIT_DEPTH_F32, OCIO::BIT_DEPTH_F32, create);
+    OCIO_CHECK_EQUAL(OCIO::GetNumSharedCPUOps(), 0);
+
+    OCIO::OpRcPtrVec ops2;
+    for (const auto & op : ops)
+    {
+        ops2.push_back(op->clone());
+    }
+    OCIO_CHECK_NO_THROW(OCIO::FinalizeOpVec(ops, OCIO::FINALIZATION_EXACT));
+    OCIO_CHECK_NO_THROW(OCIO::FinalizeOpVec(ops2, OCIO::FINALIZATION_EXACT));
+
+    const OCIO::ConstOpRcPtr fwd1 = ops[0];
+    const OCIO::ConstOpRcPtr fwd2 = ops2[0];
+    OCIO_REQUIRE_ASSERT(fwd1.get() != fwd2.get());
+
+    // Identical ops share their renderer.
+    r1 = OCIO::GetSharedCPUOp(fwd1, OCIO::BIT_DEPTH_F32, OCIO::BIT_DEPTH_F32,
+                              [&fwd1]() { return fwd1->getCPUOp(); });
+    OCIO::ConstOpCPURcPtr r2
+        = OCIO::GetSharedCPUOp(fwd2, OCIO::BIT_DEPTH_F32, OCIO::BIT_DEPTH_F32,
+                               [&fwd2]() { return fwd2->getCPUOp(); });
+    OCIO_CHECK_EQUAL(r1.get(), r2.get());
+    OCIO_CHECK_EQUAL(OCIO::GetNumSharedCPUOps(), 1);
+
+    // The inverse is a different renderer.
+    const OCIO::ConstOpRcPtr inv = ops[1];
+    OCIO::ConstOpCPURcPtr r3
+        = OCIO::GetSharedCPUOp(inv, OCIO::BIT_DEPTH_F32, OCIO::BIT_DEPTH_F32,
+                               [&inv]() { return inv->getCPUOp(); });
+    OCIO_CHECK_NE(r1.get(), r3.get());
+    OCIO_CHECK_EQUAL(OCIO::GetNumSharedCPUOps(), 2);
+
+    // The matrix renderers are not shared.
+    const OCIO::ConstOpRcPtr mat = ops[2];
+    OCIO::ConstOpCPURcPtr r4
+        = OCIO::GetSharedCPUOp(mat, OCIO::BIT_DEPTH_F32, OCIO::BIT_DEPTH_F32,
+                               [&mat]() { return mat->getCPUOp(); });
+    OCIO_CHECK_ASSERT(r4);
+    OCIO_CHECK_EQUAL(OCIO::GetNumSharedCPUOps(), 2);
+
+    // The renderers are released with their last user.
+    r1.reset();
+    OCIO_CHECK_EQUAL(OCIO::GetNumSharedCPUOps(), 2);
+    r2.reset();
+    OCIO_CHECK_EQUAL(OCIO::GetNumSharedCPUOps(), 1);
+
+    OCIO::ClearSharedCPUOpCache();
+    OCIO_CHECK_EQUAL(OCIO::GetNumSharedCPUOps(), 0);
+}
+
+OCIO_ADD_TEST(SharedCPUOps, processors)
+{
+    OCIO::ClearAllCaches();
+
+    // Each processor comes from a different config.
+    OCIO::ConstProcessorRcPtr proc1;
+    OCIO_CHECK_NO_THROW(proc1 = OCIO::GetFileTransformProcessor("lut3d_1.spi3d"));
+    OCIO::ConstCPUProcessorRcPtr cpu1;
+    OCIO_CHECK_NO_THROW(cpu1 = proc1->getDefaultCPUProcessor());
+    OCIO_CHECK_EQUAL(OCIO::GetNumSharedCPUOps(), 1);
+
+    OCIO::ConstProcessorRcPtr proc2;
+    OCIO_CHECK_NO_THROW(proc2 = OCIO::GetFileTransformProcessor("lut3d_1.spi3d"));
+    OCIO_REQUIRE_ASSERT(proc1.get() != proc2.get());
+    OCIO::ConstCPUProcessorRcPtr cpu2;
+    OCIO_CHECK_NO_THROW(cpu2 = proc2->getDefaultCPUProcessor());
+    OCIO_CHECK_EQUAL(OCIO::GetNumSharedCPUOps(), 1);
+
+    // The shared renderer gives the same results.
+    float pixel1[4] = { 0.1f, 0.5f, 0.9f, 1.0f };
+    float pixel2[4] = { 0.1f, 0.5f, 0.9f, 1.0f };
+    cpu1->applyRGBA(pixel1);
+    cpu2->applyRGBA(pixel2);
+    for (int c = 0; c < 4; ++c)
+    {
+        OCIO_CHECK_EQUAL(pixel1[c], pixel2[c]);
+    }
+
+    cpu1.reset();
+    proc1.reset();
+    OCIO_CHECK_EQUAL(OCIO::GetNumSharedCPUOps(), 1);
+    cpu2.reset();
+    proc2.reset();
+    OCIO_CHECK_EQUAL(OCIO::GetNumSharedCPUOps(), 0);
+}
+
+#endif // OCIO_UNIT_TEST
@@ -0,0 +1,37 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the OpenColorIO Project.
+
+
+#ifndef INCLUDED_OCIO_SHAREDCPUOPS_H
+#define INCLUDED_OCIO_SHAREDCPUOPS_H
+
+
+#include <functional>
+
+#include <OpenColorIO/OpenColorIO.h>
+
+#include "Op.h"
+
+
+OCIO_NAMESPACE_ENTER
+{
+
+// Get the CPU renderer of a finalized op processing from 'in' to 'out' bit-depths. The
+// renderers of the LUT ops (i.e. holding large tables such as the optimized 3D LUT or the
+// inverse LUT search structures) are shared by all the processors using an identical op
+// (i.e. same cache id & inversion quality) while one of them holds it. The other renderers
+// are always created by 'createRenderer'.
+ConstOpCPURcPtr GetSharedCPUOp(const ConstOpRcPtr & op, BitDepth in, BitDepth out,
+                               const std::function<ConstOpCPURcPtr()> & createRenderer);
+
+// Forget the shared renderers i.e. the next processors create new ones.
+void ClearSharedCPUOpCache();
+
+// Number of shared renderers still used by at least one processor.
+size_t GetNumSharedCPUOps();
+
+}
+OCIO_NAMESPACE_EXIT
+
+
+#endif // INCLUDED_OCIO_SHAREDCPUOPS_H
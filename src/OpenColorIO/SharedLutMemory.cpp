@@ -0,0 +1,307 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the OpenColorIO Project.
+
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <stdint.h>
+#include <thread>
+
+#include <OpenColorIO/OpenColorIO.h>
+
+#include "HashUtils.h"
+#include "Logging.h"
+#include "Platform.h"
+#include "SharedLutMemory.h"
+
+
+OCIO_NAMESPACE_ENTER
+{
+
+namespace
+{
+
+const char * OCIO_CPU_SHARED_LUT_MEMORY_ENVVAR = "OCIO_CPU_SHARED_LUT_MEMORY";
+
+bool InitSharedLutMemory()
+{
+    std::string value;
+    Platform::Getenv(OCIO_CPU_SHARED_LUT_MEMORY_ENVVAR, value);
+    return !value.empty() && value != "0";
+}
+
+// Refer to SetCPUSharedLutMemory().
+std::atomic<bool> g_sharedLutMemory(InitSharedLutMemory());
+
+static_assert(ATOMIC_INT_LOCK_FREE == 2,
+              "The shared LUT payloads need lock-free atomics across the processes.");
+
+const char SHARED_LUT_MAGIC[8] = { 'O', 'C', 'I', 'O', 'S', 'L', 'U', 'T' };
+const uint32_t SHARED_LUT_VERSION = 1;
+
+constexpr size_t MAX_KEY_SIZE = 256;
+
+// The payload states.
+constexpr uint32_t PAYLOAD_FILLING = 0; // i.e. the zero filled new shared memory
+constexpr uint32_t PAYLOAD_READY   = 1;
+constexpr uint32_t PAYLOAD_FAILED  = 2;
+
+// The maximum time waiting for another process filling the payload, it then most likely
+// crashed while filling it.
+constexpr auto MAX_FILLING_TIME = std::chrono::seconds(10);
+
+// The header of the shared memory, on its own memory page(s) so the payload pages could be
+// read-only while the header stays writable. The key detects the hash collisions.
+struct PayloadHeader
+{
+    char                  magic[8];
+    uint32_t              version;
+    uint32_t              keySize;
+    uint64_t              size;
+    std::atomic<uint32_t> state;
+    // The number of mappings of the payload, the last one removing its name.
+    std::atomic<uint32_t> numUsers;
+    char                  key[MAX_KEY_SIZE];
+};
+
+size_t GetHeaderSize()
+{
+    const size_t pageSize = Platform::SharedMemory::GetPageSize();
+    return (sizeof(PayloadHeader) + pageSize - 1) / pageSize * pageSize;
+}
+
+class SharedLutPayloadImpl : public SharedLutPayload
+{
+public:
+    SharedLutPayloadImpl() = default;
+    SharedLutPayloadImpl(const SharedLutPayloadImpl &) = delete;
+    SharedLutPayloadImpl & operator=(const SharedLutPayloadImpl &) = delete;
+
+    ~SharedLutPayloadImpl()
+    {
+        if(m_header && m_header->numUsers.fetch_sub(1) == 1)
+        {
+            m_memory.unlink();
+        }
+    }
+
+    // Publish or map the payload. Return false if it could not be shared.
+    bool open(const std::string & key, size_t size, const std::function<void(void *)> & fill);
+
+    const void * data() const override { return m_memory.data() + m_headerSize; }
+    size_t size() const override { return m_size; }
+
+private:
+    Platform::SharedMemory m_memory;
+    PayloadHeader *        m_header = nullptr;
+    size_t                 m_headerSize = 0;
+    size_t                 m_size = 0;
+};
+
+bool SharedLutPayloadImpl::open(const std::string & key, size_t size,
+                                const std::function<void(void *)> & fill)
+{
+    m_headerSize = GetHeaderSize();
+    m_size = size;
+
+    // The short name (e.g. at most 31 characters on macOS) of the hash of the key.
+    const std::string hash = CacheIDHash(key.c_str(), key.size());
+    const std::string name = "ocio_" + hash.substr(hash.size() - 24);
+
+    if(!m_memory.open(name, m_headerSize + size))
+    {
+        return false;
+    }
+
+    m_header = reinterpret_cast<PayloadHeader *>(m_memory.data());
+    m_header->numUsers.fetch_add(1);
+
+    if(m_memory.isCreator())
+    {
+        std::memcpy(m_header->magic, SHARED_LUT_MAGIC, sizeof(SHARED_LUT_MAGIC));
+        m_header->version = SHARED_LUT_VERSION;
+        m_header->keySize = uint32_t(key.size());
+        m_header->size    = uint64_t(size);
+        std::memcpy(m_header->key, key.c_str(), key.size());
+
+        try
+        {
+            fill(m_memory.data() + m_headerSize);
+        }
+        catch(...)
+        {
+            m_header->state.store(PAYLOAD_FAILED, std::memory_order_release);
+            m_memory.unlink();
+            throw;
+        }
+
+        m_header->state.store(PAYLOAD_READY, std::memory_order_release);
+    }
+    else
+    {
+        const auto start = std::chrono::steady_clock::now();
+        while(m_header->state.load(std::memory_order_acquire) == PAYLOAD_FILLING)
+        {
+            if(std::chrono::steady_clock::now() - start > MAX_FILLING_TIME)
+            {
+                // Let the next processes publish it again.
+                m_memory.unlink();
+                LogWarning("A shared LUT payload was never filled, using private memory.");
+                return false;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+
+        if(m_header->state.load(std::memory_order_acquire) != PAYLOAD_READY
+            || std::memcmp(m_header->magic, SHARED_LUT_MAGIC, sizeof(SHARED_LUT_MAGIC)) != 0
+            || m_header->version != SHARED_LUT_VERSION
+            || m_header->size != uint64_t(size)
+            || m_header->keySize != uint32_t(key.size())
+            || std::memcmp(m_header->key, key.c_str(), key.size()) != 0)
+        {
+            return false;
+        }
+    }
+
+    // The payload never changes once published.
+    m_memory.protect(m_headerSize, size);
+
+    return true;
+}
+
+}
+
+void SetCPUSharedLutMemory(bool sharedMemory)
+{
+    g_sharedLutMemory = sharedMemory;
+}
+
+bool IsCPUSharedLutMemory()
+{
+    return g_sharedLutMemory;
+}
+
+ConstSharedLutPayloadRcPtr AcquireSharedLutPayload(const std::string & key, size_t size,
+                                                   const std::function<void(void *)> & fill)
+{
+    if(!g_sharedLutMemory || size < MIN_SHARED_LUT_PAYLOAD_SIZE || key.size() > MAX_KEY_SIZE)
+    {
+        return ConstSharedLutPayloadRcPtr();
+    }
+
+    auto payload = std::make_shared<SharedLutPayloadImpl>();
+    if(!payload->open(key, size, fill))
+    {
+        return ConstSharedLutPayloadRcPtr();
+    }
+
+    return payload;
+}
+
+}
+OCIO_NAMESPACE_EXIT
+
+
+///////////////////////////////////////////////////////////////////////////////
+
+
+#ifdef OCIO_UNIT_TEST
+
+namespace OCIO = OCIO_NAMESPACE;
+#include "UnitTest.h"
+
+#include <sstream>
+#include <vector>
+
+namespace
+{
+
+// Enable the shared LUT memory in a scope.
+class SharedLutMemoryGuard
+{
+public:
+    SharedLutMemoryGuard() : m_enabled(OCIO::IsCPUSharedLutMemory())
+    {
+        OCIO::SetCPUSharedLutMemory(true);
+    }
+    ~SharedLutMemoryGuard()
+    {
+        OCIO::SetCPUSharedLutMemory(m_enabled);
+    }
+
+private:
+    const bool m_enabled;
+};
+
+// A key not used by any other process.
+std::string GetUniqueKey(const char * name)
+{
+    std::ostringstream os;
+    os << name << " " << std::chrono::steady_clock::now().time_since_epoch().count()
+       << " " << static_cast<const void *>(&os);
+    return os.str();
+}
+
+}
+
+OCIO_ADD_TEST(SharedLutMemory, disabled)
+{
+    const size_t size = OCIO::MIN_SHARED_LUT_PAYLOAD_SIZE;
+    const std::string key = GetUniqueKey("disabled");
+
+    OCIO::SetCPUSharedLutMemory(false);
+    OCIO_CHECK_ASSERT(!OCIO::IsCPUSharedLutMemory());
+    OCIO_CHECK_ASSERT(!OCIO::AcquireSharedLutPayload(key, size, [](void *) {}));
+
+    // Too small to be shared.
+    SharedLutMemoryGuard guard;
+    OCIO_CHECK_ASSERT(!OCIO::AcquireSharedLutPayload(key, size - 1, [](void *) {}));
+}
+
+OCIO_ADD_TEST(SharedLutMemory, publish_and_map)
+{
+    SharedLutMemoryGuard guard;
+
+    const size_t size = OCIO::MIN_SHARED_LUT_PAYLOAD_SIZE + 100;
+    const std::string key = GetUniqueKey("publish_and_map");
+
+    int numFills = 0;
+    const auto fill = [&numFills, size](void * data)
+    {
+        ++numFills;
+        uint8_t * values = static_cast<uint8_t *>(data);
+        for(size_t idx = 0; idx < size; ++idx)
+        {
+            values[idx] = uint8_t(idx * 7);
+        }
+    };
+
+    // The first acquisition publishes the payload.
+    OCIO::ConstSharedLutPayloadRcPtr published = OCIO::AcquireSharedLutPayload(key, size, fill);
+    OCIO_REQUIRE_ASSERT(published);
+    OCIO_CHECK_EQUAL(numFills, 1);
+    OCIO_CHECK_EQUAL(published->size(), size);
+
+    // The next ones (i.e. as from other processes) only map it.
+    OCIO::ConstSharedLutPayloadRcPtr mapped = OCIO::AcquireSharedLutPayload(key, size, fill);
+    OCIO_REQUIRE_ASSERT(mapped);
+    OCIO_CHECK_EQUAL(numFills, 1);
+    OCIO_CHECK_NE(mapped->data(), published->data());
+
+    const std::vector<uint8_t> expected(static_cast<const uint8_t *>(published->data()),
+                                        static_cast<const uint8_t *>(published->data()) + size);
+    OCIO_CHECK_EQUAL(expected[size - 1], uint8_t((size - 1) * 7));
+    OCIO_CHECK_EQUAL(std::memcmp(mapped->data(), &expected[0], size), 0);
+
+    // Another size is another payload (i.e. the key must identify the content).
+    OCIO_CHECK_ASSERT(!OCIO::AcquireSharedLutPayload(key, size + 1, fill));
+    OCIO_CHECK_EQUAL(numFills, 1);
+
+    // The last mapping removes the payload so it is published again.
+    published.reset();
+    mapped.reset();
+    OCIO_CHECK_ASSERT(OCIO::AcquireSharedLutPayload(key, size, fill));
+    OCIO_CHECK_EQUAL(numFills, 2);
+}
+
+#endif // OCIO_UNIT_TEST
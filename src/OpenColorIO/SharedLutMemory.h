@@ -0,0 +1,45 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the OpenColorIO Project.
+
+
+#ifndef INCLUDED_OCIO_SHAREDLUTMEMORY_H
+#define INCLUDED_OCIO_SHAREDLUTMEMORY_H
+
+#include <functional>
+#include <string>
+
+#include <OpenColorIO/OpenColorIO.h>
+
+
+OCIO_NAMESPACE_ENTER
+{
+
+// The immutable LUT payloads (e.g. the 3D LUT tables of the CPU renderers) shared by the
+// processes of the node (refer to SetCPUSharedLutMemory()). The first process needing a
+// payload publishes it in a shared memory named from the hash of its key, and the other
+// processes map it read-only instead of computing their own copy.
+class SharedLutPayload
+{
+public:
+    virtual ~SharedLutPayload() = default;
+
+    virtual const void * data() const = 0;
+    virtual size_t size() const = 0;
+};
+
+typedef OCIO_SHARED_PTR<const SharedLutPayload> ConstSharedLutPayloadRcPtr;
+
+// The payloads smaller than that are not worth a shared memory.
+constexpr size_t MIN_SHARED_LUT_PAYLOAD_SIZE = 64 * 1024;
+
+// Get the payload of the key (i.e. identifying the payload content), calling the fill
+// function to write it when the process publishes it. Return null when the shared LUT
+// memory is disabled, the payload is too small, or the payload could not be shared (e.g.
+// shared memory not supported), the caller then using private memory.
+ConstSharedLutPayloadRcPtr AcquireSharedLutPayload(const std::string & key, size_t size,
+                                                   const std::function<void(void *)> & fill);
+
+}
+OCIO_NAMESPACE_EXIT
+
+#endif
@@ -0,0 +1,658 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the OpenColorIO Project.
+
+#include <algorithm>
+#include <exception>
+#include <iterator>
+
+#include <OpenColorIO/OpenColorIO.h>
+
+#include "Platform.h"
+#include "ThreadPool.h"
+
+
+OCIO_NAMESPACE_ENTER
+{
+
+namespace
+{
+
+struct NumaTopology
+{
+    // The CPUs of each node.
+    std::vector<std::vector<unsigned>> m_nodeCPUs;
+    // The node of each CPU, or -1.
+    std::vector<int> m_cpuNodes;
+};
+
+const NumaTopology & GetNumaTopology()
+{
+    static const NumaTopology topology = []()
+    {
+        NumaTopology topo;
+        topo.m_nodeCPUs = Platform::GetNumaNodeCPUs();
+
+        for(size_t node=0; node<topo.m_nodeCPUs.size(); ++node)
+        {
+            for(const unsigned cpu : topo.m_nodeCPUs[node])
+            {
+                if(cpu>=topo.m_cpuNodes.size())
+                {
+                    topo.m_cpuNodes.resize(cpu + 1, -1);
+                }
+                topo.m_cpuNodes[cpu] = int(node);
+            }
+        }
+
+        return topo;
+    }();
+
+    return topology;
+}
+
+// The NUMA node of a pinned worker thread, or -1.
+thread_local int t_numaNode = -1;
+
+// The cancellation token of the calling thread, or null.
+thread_local const CPUCancellationToken * t_cancellationToken = nullptr;
+
+}
+
+void CPUCancellationToken::cancel() noexcept
+{
+    m_cancelled = true;
+}
+
+bool CPUCancellationToken::isCancelled() const noexcept
+{
+    return m_cancelled;
+}
+
+void CPUCancellationToken::reset() noexcept
+{
+    m_cancelled = false;
+}
+
+void CPUCancellationToken::setPriority(CPUPriority priority) noexcept
+{
+    m_priority = int(priority);
+}
+
+CPUPriority CPUCancellationToken::getPriority() const noexcept
+{
+    return CPUPriority(m_priority.load());
+}
+
+CancellationGuard::CancellationGuard(const CPUCancellationToken * token)
+    :   m_previousToken(t_cancellationToken)
+{
+    t_cancellationToken = token;
+}
+
+CancellationGuard::~CancellationGuard()
+{
+    t_cancellationToken = m_previousToken;
+}
+
+const CPUCancellationToken * GetCurrentCancellationToken()
+{
+    return t_cancellationToken;
+}
+
+void CheckCancellation()
+{
+    if(t_cancellationToken && t_cancellationToken->isCancelled())
+    {
+        throw ExceptionCancelled("The processing was cancelled.");
+    }
+}
+
+unsigned GetNumNumaNodes()
+{
+    return std::max(unsigned(GetNumaTopology().m_nodeCPUs.size()), 1u);
+}
+
+int GetCurrentNumaNode()
+{
+    if(t_numaNode>=0)
+    {
+        return t_numaNode;
+    }
+
+    const NumaTopology & topology = GetNumaTopology();
+
+    const int cpu = Platform::GetCurrentCPU();
+    if(cpu>=0 && size_t(cpu)<topology.m_cpuNodes.size())
+    {
+        return topology.m_cpuNodes[cpu];
+    }
+
+    return -1;
+}
+
+// Holds the processing state of one parallelFor() call.
+struct ThreadPool::Job
+{
+    explicit Job(const std::function<void(long)> & task, long numTasks,
+                 const CPUCancellationToken * token)
+        :   m_task(task)
+        ,   m_token(token)
+        ,   m_numRemainingTasks(numTasks)
+    {
+    }
+
+    const std::function<void(long)> & m_task;
+    const CPUCancellationToken *      m_token; // Could be null.
+
+    // Note that the count is only changed while holding the mutex so the
+    // waiting thread cannot destroy the job while a worker still uses it.
+    std::mutex              m_mutex;
+    std::condition_variable m_done;
+    long                    m_numRemainingTasks;
+
+    std::atomic<bool>       m_failed{ false };
+    std::exception_ptr      m_exception;
+};
+
+ThreadPool::ThreadPool(unsigned numThreads, bool numaAware)
+    :   m_numThreads(std::max(numThreads, 1u))
+    ,   m_numPendingTasks(0)
+{
+    const unsigned numWorkers = m_numThreads - 1;
+    const unsigned numNodes   = GetNumNumaNodes();
+
+    m_numaAware = numaAware && numNodes>1;
+
+    m_queues.reserve(numWorkers);
+    m_queueNodes.reserve(numWorkers);
+    for(unsigned idx=0; idx<numWorkers; ++idx)
+    {
+        m_queues.push_back(std::unique_ptr<WorkQueue>(new WorkQueue));
+
+        // Each node gets a contiguous range of workers.
+        m_queueNodes.push_back(m_numaAware ? int((idx * numNodes) / numWorkers) : -1);
+    }
+
+    m_workers.reserve(numWorkers);
+    for(unsigned idx=0; idx<numWorkers; ++idx)
+    {
+        m_workers.push_back(std::thread(&ThreadPool::workerLoop, this, size_t(idx)));
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_wakeMutex);
+        m_stop = true;
+    }
+    m_wakeCondition.notify_all();
+
+    for(auto & worker : m_workers)
+    {
+        worker.join();
+    }
+}
+
+bool ThreadPool::popTask(size_t queueIdx, Task & task)
+{
+    WorkQueue & queue = *m_queues[queueIdx];
+
+    std::lock_guard<std::mutex> lock(queue.m_mutex);
+    if(queue.m_tasks.empty())
+    {
+        return false;
+    }
+
+    task = queue.m_tasks.front();
+    queue.m_tasks.pop_front();
+    --m_numPendingTasks;
+
+    return true;
+}
+
+bool ThreadPool::stealTask(size_t thiefIdx, int thiefNode, Task & task)
+{
+    const size_t numQueues = m_queues.size();
+
+    // In NUMA-aware mode, first steal from the same node to keep the memory accesses local.
+    const bool sameNodeFirst = m_numaAware && thiefNode>=0;
+
+    for(int pass=sameNodeFirst ? 0 : 1; pass<2; ++pass)
+    {
+        for(size_t offset=1; offset<=numQueues; ++offset)
+        {
+            const size_t queueIdx = (thiefIdx + offset) % numQueues;
+            if(pass==0 && m_queueNodes[queueIdx]!=thiefNode)
+            {
+                continue;
+            }
+
+            WorkQueue & queue = *m_queues[queueIdx];
+
+            std::lock_guard<std::mutex> lock(queue.m_mutex);
+            if(!queue.m_tasks.empty())
+            {
+                // Steal the tasks the owner would process last, unless the queue holds
+                // tasks of a higher priority.
+                if(queue.m_tasks.front().m_priority>queue.m_tasks.back().m_priority)
+                {
+                    task = queue.m_tasks.front();
+                    queue.m_tasks.pop_front();
+                }
+                else
+                {
+                    task = queue.m_tasks.back();
+                    queue.m_tasks.pop_back();
+                }
+                --m_numPendingTasks;
+
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+void ThreadPool::runTask(const Task & task)
+{
+    Job & job = *task.m_job;
+
+    // Skip the remaining tasks once one failed.
+    if(!job.m_failed)
+    {
+        try
+        {
+            // The task could run on any thread.
+            CancellationGuard guard(job.m_token);
+            CheckCancellation();
+
+            job.m_task(task.m_index);
+        }
+        catch(...)
+        {
+            std::lock_guard<std::mutex> lock(job.m_mutex);
+            if(!job.m_exception)
+            {
+                job.m_exception = std::current_exception();
+            }
+            job.m_failed = true;
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(job.m_mutex);
+    if(--job.m_numRemainingTasks == 0)
+    {
+        job.m_done.notify_all();
+    }
+}
+
+void ThreadPool::workerLoop(size_t queueIdx)
+{
+    const int node = m_queueNodes[queueIdx];
+    if(node>=0)
+    {
+        Platform::SetCurrentThreadAffinity(GetNumaTopology().m_nodeCPUs[node]);
+        t_numaNode = node;
+    }
+
+    while(true)
+    {
+        Task task;
+        if(popTask(queueIdx, task) || stealTask(queueIdx, node, task))
+        {
+            runTask(task);
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(m_wakeMutex);
+        m_wakeCondition.wait(lock, [this]() { return m_stop || m_numPendingTasks > 0; });
+
+        if(m_stop && m_numPendingTasks <= 0)
+        {
+            return;
+        }
+    }
+}
+
+void ThreadPool::parallelFor(long numTasks, const std::function<void(long)> & task)
+{
+    if(numTasks <= 0)
+    {
+        return;
+    }
+
+    if(m_queues.empty() || numTasks == 1)
+    {
+        for(long idx=0; idx<numTasks; ++idx)
+        {
+            CheckCancellation();
+            task(idx);
+        }
+        return;
+    }
+
+    const CPUCancellationToken * token = GetCurrentCancellationToken();
+    const int priority = token ? int(token->getPriority()) : int(CPU_PRIORITY_NORMAL);
+
+    Job job(task, numTasks, token);
+
+    // Give each worker a contiguous range of tasks, queued before the tasks of a lower
+    // priority.
+
+    const long numQueues = long(m_queues.size());
+    for(long queueIdx=0; queueIdx<numQueues; ++queueIdx)
+    {
+        const long begin = (numTasks * queueIdx) / numQueues;
+        const long end   = (numTasks * (queueIdx + 1)) / numQueues;
+
+        WorkQueue & queue = *m_queues[queueIdx];
+
+        std::lock_guard<std::mutex> lock(queue.m_mutex);
+
+        auto pos = queue.m_tasks.end();
+        while(pos!=queue.m_tasks.begin() && std::prev(pos)->m_priority<priority)
+        {
+            --pos;
+        }
+
+        for(long idx=begin; idx<end; ++idx)
+        {
+            Task t;
+            t.m_job      = &job;
+            t.m_index    = idx;
+            t.m_priority = priority;
+            pos = queue.m_tasks.insert(pos, t) + 1;
+        }
+    }
+
+    m_numPendingTasks += numTasks;
+    {
+        std::lock_guard<std::mutex> lock(m_wakeMutex);
+    }
+    m_wakeCondition.notify_all();
+
+    // The calling thread steals work until all the queues are empty.
+
+    const int node = m_numaAware ? GetCurrentNumaNode() : -1;
+
+    Task t;
+    while(stealTask(0, node, t))
+    {
+        runTask(t);
+    }
+
+    // Wait for the tasks still processed by the workers.
+
+    std::unique_lock<std::mutex> lock(job.m_mutex);
+    job.m_done.wait(lock, [&job]() { return job.m_numRemainingTasks == 0; });
+
+    if(job.m_exception)
+    {
+        std::rethrow_exception(job.m_exception);
+    }
+}
+
+
+namespace
+{
+
+std::mutex      g_threadPoolMutex;
+unsigned        g_numThreads = 0; // Zero means the number of hardware threads.
+bool            g_numaAware  = false;
+ThreadPoolRcPtr g_threadPool;
+
+unsigned GetDefaultNumThreads()
+{
+    const unsigned numThreads = std::thread::hardware_concurrency();
+    return numThreads == 0 ? 1 : numThreads;
+}
+
+}
+
+ThreadPoolRcPtr GetCPUThreadPool()
+{
+    std::lock_guard<std::mutex> lock(g_threadPoolMutex);
+
+    if(!g_threadPool)
+    {
+        g_threadPool
+            = std::make_shared<ThreadPool>(g_numThreads ? g_numThreads : GetDefaultNumThreads(),
+                                           g_numaAware);
+    }
+
+    return g_threadPool;
+}
+
+void SetNumCPUThreads(unsigned numThreads)
+{
+    std::lock_guard<std::mutex> lock(g_threadPoolMutex);
+
+    if(numThreads != g_numThreads)
+    {
+        g_numThreads = numThreads;
+
+        // The pool is recreated on next use. Note that any processing still
+        // in progress keeps the previous pool alive until it completes.
+        g_threadPool.reset();
+    }
+}
+
+unsigned GetNumCPUThreads()
+{
+    std::lock_guard<std::mutex> lock(g_threadPoolMutex);
+    return g_numThreads ? g_numThreads : GetDefaultNumThreads();
+}
+
+void SetCPUNumaAware(bool numaAware)
+{
+    std::lock_guard<std::mutex> lock(g_threadPoolMutex);
+
+    if(numaAware != g_numaAware)
+    {
+        g_numaAware = numaAware;
+        g_threadPool.reset();
+    }
+}
+
+bool IsCPUNumaAware()
+{
+    std::lock_guard<std::mutex> lock(g_threadPoolMutex);
+    return g_numaAware;
+}
+
+}
+OCIO_NAMESPACE_EXIT
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+
+
+
+#ifdef OCIO_UNIT_TEST
+
+namespace OCIO = OCIO_NAMESPACE;
+#include "UnitTest.h"
+
+
+OCIO_ADD_TEST(ThreadPool, parallel_for)
+{
+    OCIO::ThreadPool pool(4);
+    OCIO_CHECK_EQUAL(pool.getNumThreads(), 4u);
+
+    constexpr long numTasks = 1000;
+
+    std::vector<std::atomic<int>> counts(numTasks);
+    for(auto & count : counts) count = 0;
+
+    OCIO_CHECK_NO_THROW(pool.parallelFor(numTasks, [&counts](long idx) { ++counts[idx]; }));
+
+    for(long idx=0; idx<numTasks; ++idx)
+    {
+        OCIO_CHECK_EQUAL(counts[idx], 1);
+    }
+
+    // Nothing to do.
+    OCIO_CHECK_NO_THROW(pool.parallelFor(0, [&counts](long idx) { ++counts[idx]; }));
+}
+
+OCIO_ADD_TEST(ThreadPool, single_thread)
+{
+    OCIO::ThreadPool pool(0);
+    OCIO_CHECK_EQUAL(pool.getNumThreads(), 1u);
+
+    long sum = 0;
+    OCIO_CHECK_NO_THROW(pool.parallelFor(10, [&sum](long idx) { sum += idx; }));
+    OCIO_CHECK_EQUAL(sum, 45);
+}
+
+OCIO_ADD_TEST(ThreadPool, concurrent_calls)
+{
+    OCIO::ThreadPool pool(3);
+
+    std::atomic<long> sum1(0);
+    std::atomic<long> sum2(0);
+
+    std::thread other([&pool, &sum2]() {
+        pool.parallelFor(500, [&sum2](long idx) { sum2 += idx; });
+    });
+    pool.parallelFor(500, [&sum1](long idx) { sum1 += idx; });
+    other.join();
+
+    OCIO_CHECK_EQUAL(sum1, 124750);
+    OCIO_CHECK_EQUAL(sum2, 124750);
+}
+
+OCIO_ADD_TEST(ThreadPool, exception)
+{
+    OCIO::ThreadPool pool(4);
+
+    OCIO_CHECK_THROW_WHAT(pool.parallelFor(100, [](long idx)
+                                           {
+                                               if(idx == 42) throw OCIO::Exception("Task failure");
+                                           }),
+                          OCIO::Exception,
+                          "Task failure");
+
+    // The pool is still usable.
+    std::atomic<long> count(0);
+    OCIO_CHECK_NO_THROW(pool.parallelFor(100, [&count](long) { ++count; }));
+    OCIO_CHECK_EQUAL(count, 100);
+}
+
+OCIO_ADD_TEST(ThreadPool, cancellation)
+{
+    OCIO::ThreadPool pool(4);
+
+    OCIO::CPUCancellationToken token;
+    OCIO_CHECK_ASSERT(!token.isCancelled());
+    OCIO_CHECK_EQUAL(token.getPriority(), OCIO::CPU_PRIORITY_NORMAL);
+
+    // The tasks run with the token of the calling thread, whatever their thread.
+    {
+        OCIO::CancellationGuard guard(&token);
+
+        std::atomic<long> count(0);
+        OCIO_CHECK_NO_THROW(pool.parallelFor(100, [&count, &token](long)
+                                             {
+                                                 if(OCIO::GetCurrentCancellationToken()==&token)
+                                                 {
+                                                     ++count;
+                                                 }
+                                             }));
+        OCIO_CHECK_EQUAL(count, 100);
+    }
+    OCIO_CHECK_ASSERT(!OCIO::GetCurrentCancellationToken());
+
+    // The remaining tasks are skipped once the token is cancelled. Note that the tasks run
+    // in any order (e.g. the calling thread steals the last tasks first) so the token is
+    // cancelled by the tenth task to run, whatever its index.
+    {
+        OCIO::CancellationGuard guard(&token);
+
+        std::atomic<long> count(0);
+        OCIO_CHECK_THROW_WHAT(pool.parallelFor(1000, [&count, &token](long)
+                                               {
+                                                   if(++count==10) token.cancel();
+                                               }),
+                              OCIO::ExceptionCancelled,
+                              "The processing was cancelled");
+        OCIO_CHECK_ASSERT(count<1000);
+
+        // Even with a single task.
+        OCIO_CHECK_THROW_WHAT(pool.parallelFor(1, [](long) {}),
+                              OCIO::ExceptionCancelled,
+                              "The processing was cancelled");
+    }
+
+    // A reset token could be reused, with any priority.
+    token.reset();
+    token.setPriority(OCIO::CPU_PRIORITY_HIGH);
+    OCIO_CHECK_EQUAL(token.getPriority(), OCIO::CPU_PRIORITY_HIGH);
+
+    std::atomic<long> sum1(0);
+    std::atomic<long> sum2(0);
+
+    // The tasks of different priorities share the queues.
+    std::thread other([&pool, &sum2]() {
+        pool.parallelFor(500, [&sum2](long idx) { sum2 += idx; });
+    });
+    {
+        OCIO::CancellationGuard guard(&token);
+        OCIO_CHECK_NO_THROW(pool.parallelFor(500, [&sum1](long idx) { sum1 += idx; }));
+    }
+    other.join();
+
+    OCIO_CHECK_EQUAL(sum1, 124750);
+    OCIO_CHECK_EQUAL(sum2, 124750);
+}
+
+OCIO_ADD_TEST(ThreadPool, numa_aware)
+{
+    // Whatever the number of NUMA nodes of the machine, the processing is the same.
+    OCIO::ThreadPool pool(5, true);
+    OCIO_CHECK_EQUAL(pool.isNumaAware(), OCIO::GetNumNumaNodes()>1);
+
+    constexpr long numTasks = 1000;
+
+    std::vector<std::atomic<int>> counts(numTasks);
+    for(auto & count : counts) count = 0;
+
+    std::vector<std::atomic<int>> nodes(numTasks);
+    OCIO_CHECK_NO_THROW(pool.parallelFor(numTasks, [&counts, &nodes](long idx)
+                                         {
+                                             ++counts[idx];
+                                             nodes[idx] = OCIO::GetCurrentNumaNode();
+                                         }));
+
+    for(long idx=0; idx<numTasks; ++idx)
+    {
+        OCIO_CHECK_EQUAL(counts[idx], 1);
+        OCIO_CHECK_ASSERT(nodes[idx]>=-1 && nodes[idx]<int(OCIO::GetNumNumaNodes()));
+    }
+
+    OCIO_CHECK_ASSERT(!OCIO::IsCPUNumaAware());
+    OCIO::SetCPUNumaAware(true);
+    OCIO_CHECK_ASSERT(OCIO::IsCPUNumaAware());
+    OCIO_CHECK_EQUAL(OCIO::GetCPUThreadPool()->isNumaAware(), OCIO::GetNumNumaNodes()>1);
+    OCIO::SetCPUNumaAware(false);
+    OCIO_CHECK_ASSERT(!OCIO::GetCPUThreadPool()->isNumaAware());
+}
+
+OCIO_ADD_TEST(ThreadPool, num_cpu_threads)
+{
+    const unsigned defaultNumThreads = OCIO::GetNumCPUThreads();
+    OCIO_CHECK_GE(defaultNumThreads, 1u);
+
+    OCIO::SetNumCPUThreads(2);
+    OCIO_CHECK_EQUAL(OCIO::GetNumCPUThreads(), 2u);
+    OCIO_CHECK_EQUAL(OCIO::GetCPUThreadPool()->getNumThreads(), 2u);
+
+    OCIO::SetNumCPUThreads(0);
+    OCIO_CHECK_EQUAL(OCIO::GetNumCPUThreads(), defaultNumThreads);
+    OCIO_CHECK_EQUAL(OCIO::GetCPUThreadPool()->getNumThreads(), defaultNumThreads);
+}
+
+#endif // OCIO_UNIT_TEST
@@ -0,0 +1,143 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the OpenColorIO Project.
+
+
+#ifndef INCLUDED_OCIO_THREADPOOL_H
+#define INCLUDED_OCIO_THREADPOOL_H
+
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <OpenColorIO/OpenColorIO.h>
+
+
+OCIO_NAMESPACE_ENTER
+{
+
+// Work-stealing thread pool used by the CPU processing to process image bands
+// in parallel.
+//
+// Each worker thread owns a queue of tasks. A worker processes its own tasks in
+// order (i.e. from the front of its queue keeping a good memory locality between
+// consecutive image bands) and, when its queue is empty, steals tasks from the
+// back of the other queues. The thread calling parallelFor() also participates
+// to the processing so only numThreads-1 worker threads are created.
+//
+// In NUMA-aware mode (and when the machine has several NUMA nodes), the workers are
+// spread over the nodes and pinned to the CPUs of their node. As the tasks are given
+// to the queues in contiguous ranges, consecutive tasks (e.g. image bands) are then
+// processed by the same node, and a worker first steals from the queues of its node.
+//
+class ThreadPool
+{
+public:
+    ThreadPool() = delete;
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool & operator=(const ThreadPool &) = delete;
+
+    explicit ThreadPool(unsigned numThreads, bool numaAware = false);
+    ~ThreadPool();
+
+    unsigned getNumThreads() const noexcept { return m_numThreads; }
+
+    // Are the workers pinned to several NUMA nodes?
+    bool isNumaAware() const noexcept { return m_numaAware; }
+
+    // Call task(idx) for every idx in [0, numTasks[ and only return once all the
+    // calls completed. The first exception thrown by a task is rethrown once all
+    // the started tasks completed, the remaining tasks being skipped.
+    //
+    // The tasks use the cancellation token of the calling thread (refer to
+    // CancellationGuard): they are queued according to its priority, each task runs
+    // with the token, and the remaining tasks are skipped once it is cancelled.
+    //
+    // Note that concurrent calls from different threads are supported.
+    void parallelFor(long numTasks, const std::function<void(long)> & task);
+
+private:
+    struct Job;
+
+    struct Task
+    {
+        Job * m_job      = nullptr;
+        long  m_index    = 0;
+        int   m_priority = CPU_PRIORITY_NORMAL;
+    };
+
+    struct WorkQueue
+    {
+        std::mutex       m_mutex;
+        std::deque<Task> m_tasks;
+    };
+
+    // Get the next task from the front of its own queue. Note that the queues are ordered
+    // by decreasing priority.
+    bool popTask(size_t queueIdx, Task & task);
+    // Steal a task from the back of any other queue, starting with the queues of
+    // the thief node (if known i.e. not negative).
+    bool stealTask(size_t thiefIdx, int thiefNode, Task & task);
+
+    void runTask(const Task & task);
+    void workerLoop(size_t queueIdx);
+
+    const unsigned m_numThreads;
+    bool           m_numaAware = false;
+
+    std::vector<std::unique_ptr<WorkQueue>> m_queues;
+    std::vector<int>                        m_queueNodes; // The NUMA node of each worker.
+    std::vector<std::thread>                m_workers;
+
+    std::mutex              m_wakeMutex;
+    std::condition_variable m_wakeCondition;
+    std::atomic<long>       m_numPendingTasks;
+    bool                    m_stop = false;
+};
+
+typedef OCIO_SHARED_PTR<ThreadPool> ThreadPoolRcPtr;
+
+// Get the thread pool used by the CPU processing (created on first use).
+// Refer to SetNumCPUThreads() to change its number of threads, and to SetCPUNumaAware()
+// to pin its workers to the NUMA nodes.
+ThreadPoolRcPtr GetCPUThreadPool();
+
+// Set the cancellation token (could be null) of the calling thread while in scope. The token
+// is checked by CheckCancellation() and used by the ThreadPool::parallelFor() calls.
+class CancellationGuard
+{
+public:
+    CancellationGuard() = delete;
+    CancellationGuard(const CancellationGuard &) = delete;
+    CancellationGuard & operator=(const CancellationGuard &) = delete;
+
+    explicit CancellationGuard(const CPUCancellationToken * token);
+    ~CancellationGuard();
+
+private:
+    const CPUCancellationToken * m_previousToken;
+};
+
+// Get the cancellation token of the calling thread, or null.
+const CPUCancellationToken * GetCurrentCancellationToken();
+
+// Throw an ExceptionCancelled if the cancellation token of the calling thread is cancelled.
+void CheckCancellation();
+
+// Get the number of NUMA nodes having CPUs (i.e. one if unknown).
+unsigned GetNumNumaNodes();
+
+// Get the index (i.e. in [0, GetNumNumaNodes()[) of the NUMA node running the calling
+// thread, or -1 if unknown.
+int GetCurrentNumaNode();
+
+}
+OCIO_NAMESPACE_EXIT
+
+
+#endif // INCLUDED_OCIO_THREADPOOL_H
@@ -0,0 +1,233 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the OpenColorIO Project.
+
+#include <atomic>
+
+#include <OpenColorIO/OpenColorIO.h>
+
+#include "Tracing.h"
+
+
+OCIO_NAMESPACE_ENTER
+{
+
+namespace
+{
+
+// The flag avoids the atomic load of the shared pointer when tracing is disabled.
+std::atomic<bool> g_tracingEnabled{ false };
+
+// Only accessed using the atomic functions of the shared pointers.
+std::shared_ptr<const TracingFunction> g_tracingFunction;
+
+}
+
+void SetTracingFunction(const TracingFunction & traceFunction)
+{
+    std::shared_ptr<const TracingFunction> function;
+    if(traceFunction)
+    {
+        function = std::make_shared<const TracingFunction>(traceFunction);
+    }
+
+    std::atomic_store(&g_tracingFunction, function);
+    g_tracingEnabled.store(function!=nullptr, std::memory_order_relaxed);
+}
+
+bool IsTracingEnabled()
+{
+    return g_tracingEnabled.load(std::memory_order_relaxed);
+}
+
+TracingSpan::TracingSpan(const char * category, const char * name)
+{
+    if(IsTracingEnabled())
+    {
+        begin(category, name);
+    }
+}
+
+TracingSpan::TracingSpan(const char * category, const std::string & name)
+{
+    if(IsTracingEnabled())
+    {
+        begin(category, name.c_str());
+    }
+}
+
+void TracingSpan::begin(const char * category, const char * name)
+{
+    m_function = std::atomic_load(&g_tracingFunction);
+    if(!m_function)
+    {
+        return;
+    }
+
+    m_category = category;
+    m_name     = name ? name : "";
+
+    // A failing tracing function must not break the color processing.
+    try
+    {
+        (*m_function)(true, m_category, m_name.c_str());
+    }
+    catch(...)
+    {
+    }
+}
+
+TracingSpan::~TracingSpan()
+{
+    if(m_function)
+    {
+        try
+        {
+            (*m_function)(false, m_category, m_name.c_str());
+        }
+        catch(...)
+        {
+        }
+    }
+}
+
+}
+OCIO_NAMESPACE_EXIT
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+
+
+
+#ifdef OCIO_UNIT_TEST
+
+#include <sstream>
+#include <vector>
+
+namespace OCIO = OCIO_NAMESPACE;
+#include "UnitTest.h"
+
+
+namespace
+{
+
+struct TracingEvent
+{
+    bool m_begin;
+    std::string m_category;
+    std::string m_name;
+};
+
+// Reset the tracing function even if the test fails.
+class TracingGuard
+{
+public:
+    TracingGuard() = default;
+    TracingGuard(const TracingGuard &) = delete;
+    TracingGuard & operator=(const TracingGuard &) = delete;
+
+    ~TracingGuard() { OCIO::SetTracingFunction(OCIO::TracingFunction()); }
+};
+
+}
+
+OCIO_ADD_TEST(Tracing, spans)
+{
+    TracingGuard guard;
+
+    std::vector<TracingEvent> events;
+
+    // Disabled by default.
+    OCIO_CHECK_ASSERT(!OCIO::IsTracingEnabled());
+    {
+        OCIO::TracingSpan span("test", "disabled");
+    }
+
+    OCIO::SetTracingFunction([&events](bool begin, const char * category, const char * name)
+                             {
+                                 events.push_back({ begin, category, name });
+                             });
+    OCIO_CHECK_ASSERT(OCIO::IsTracingEnabled());
+
+    {
+        OCIO::TracingSpan outer("test", "outer");
+        {
+            OCIO::TracingSpan inner("test", std::string("inner"));
+        }
+    }
+
+    OCIO_REQUIRE_EQUAL(events.size(), 4u);
+    OCIO_CHECK_ASSERT(events[0].m_begin);
+    OCIO_CHECK_EQUAL(events[0].m_category, "test");
+    OCIO_CHECK_EQUAL(events[0].m_name, "outer");
+    OCIO_CHECK_ASSERT(events[1].m_begin);
+    OCIO_CHECK_EQUAL(events[1].m_name, "inner");
+    OCIO_CHECK_ASSERT(!events[2].m_begin);
+    OCIO_CHECK_EQUAL(events[2].m_name, "inner");
+    OCIO_CHECK_ASSERT(!events[3].m_begin);
+    OCIO_CHECK_EQUAL(events[3].m_name, "outer");
+
+    // The end event goes to the function which received the begin event.
+    events.clear();
+    std::vector<TracingEvent> otherEvents;
+    {
+        OCIO::TracingSpan span("test", "switch");
+
+        OCIO::SetTracingFunction([&otherEvents](bool begin, const char * category,
+                                                const char * name)
+                                 {
+                                     otherEvents.push_back({ begin, category, name });
+                                 });
+    }
+    OCIO_CHECK_EQUAL(events.size(), 2u);
+    OCIO_CHECK_ASSERT(otherEvents.empty());
+
+    // A throwing function does not break the traced code.
+    OCIO::SetTracingFunction([](bool, const char *, const char *)
+                             {
+                                 throw OCIO::Exception("Tracing failure");
+                             });
+    OCIO_CHECK_NO_THROW(OCIO::TracingSpan("test", "throw"));
+
+    OCIO::SetTracingFunction(OCIO::TracingFunction());
+    OCIO_CHECK_ASSERT(!OCIO::IsTracingEnabled());
+}
+
+OCIO_ADD_TEST(Tracing, processor)
+{
+    TracingGuard guard;
+
+    std::vector<TracingEvent> events;
+    OCIO::SetTracingFunction([&events](bool begin, const char * category, const char * name)
+                             {
+                                 events.push_back({ begin, category, name });
+                             });
+
+    OCIO::ConfigRcPtr config = OCIO::Config::Create();
+
+    OCIO::MatrixTransformRcPtr matrix = OCIO::MatrixTransform::Create();
+    const double offset[4] = { 0.1, 0.2, 0.3, 0.0 };
+    matrix->setOffset(offset);
+
+    OCIO::ConstProcessorRcPtr processor;
+    OCIO_CHECK_NO_THROW(processor = config->getProcessor(matrix));
+    OCIO_CHECK_NO_THROW(processor->getDefaultCPUProcessor());
+
+    // The begin and end events are balanced, and the processor steps are traced.
+    int depth = 0;
+    bool hasBuildOps = false;
+    bool hasCPUFinalize = false;
+    for(const auto & event : events)
+    {
+        depth += event.m_begin ? 1 : -1;
+        OCIO_CHECK_ASSERT(depth >= 0);
+
+        hasBuildOps    |= event.m_name == "BuildOps";
+        hasCPUFinalize |= event.m_name == "CPUProcessor::finalize";
+    }
+    OCIO_CHECK_EQUAL(depth, 0);
+    OCIO_CHECK_ASSERT(hasBuildOps);
+    OCIO_CHECK_ASSERT(hasCPUFinalize);
+}
+
+#endif // OCIO_UNIT_TEST
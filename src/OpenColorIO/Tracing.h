@@ -0,0 +1,55 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the OpenColorIO Project.
+
+
+#ifndef INCLUDED_OCIO_TRACING_H
+#define INCLUDED_OCIO_TRACING_H
+
+
+#include <memory>
+#include <string>
+
+#include <OpenColorIO/OpenColorIO.h>
+
+
+OCIO_NAMESPACE_ENTER
+{
+
+// Is a tracing function set (refer to SetTracingFunction())? The check does not lock
+// so it could guard the building of an expensive span name.
+bool IsTracingEnabled();
+
+// Emit the begin event of a tracing span on construction and its end event on destruction
+// (i.e. both from the same thread), when a tracing function is set. Otherwise it only
+// costs the check of IsTracingEnabled().
+//
+//   TracingSpan span("file", filepath);
+//
+class TracingSpan
+{
+public:
+    TracingSpan() = delete;
+    TracingSpan(const TracingSpan &) = delete;
+    TracingSpan & operator=(const TracingSpan &) = delete;
+
+    // Note that the category must be a string literal.
+    TracingSpan(const char * category, const char * name);
+    TracingSpan(const char * category, const std::string & name);
+
+    ~TracingSpan();
+
+private:
+    void begin(const char * category, const char * name);
+
+    // The function receiving the begin event also receives the end event (i.e. even if
+    // the tracing function changes in between).
+    std::shared_ptr<const TracingFunction> m_function;
+    const char * m_category = nullptr;
+    std::string m_name;
+};
+
+}
+OCIO_NAMESPACE_EXIT
+
+
+#endif // INCLUDED_OCIO_TRACING_H
@@ -8,6 +8,7 @@
 
 #include <OpenColorIO/OpenColorIO.h>
 
+#include "BakingUtils.h"
 #include "BitDepthUtils.h"
 #include "MathUtils.h"
 #include "ops/Lut1D/Lut1DOp.h"
@@ -81,6 +82,13 @@ OCIO_NAMESPACE_ENTER
             LocalCachedFile() = default;
             ~LocalCachedFile() = default;
 
+            size_t getMemorySize() const override
+            {
+                return sizeof(LocalCachedFile)
+                    + GetOpDataMemorySize(lut1D)
+                    + GetOpDataMemorySize(lut3D);
+            }
+
             Lut1DOpDataRcPtr lut1D;
             Lut3DOpDataRcPtr lut3D;
         };
@@ -503,39 +511,17 @@ OCIO_NAMESPACE_ENTER
                 throw Exception(os.str().c_str());
             }
 
-            ConstConfigRcPtr config = baker.getConfig();
-
             int cubeSize = baker.getCubeSize();
             if(cubeSize==-1) cubeSize = DEFAULT_CUBE_SIZE;
+            SelectCubeSize(baker, cubeSize);
             cubeSize = std::max(2, cubeSize); // smallest cube is 2x2x2
 
             int shaperSize = baker.getShaperSize();
             if(shaperSize==-1) shaperSize = cubeSize;
 
-            std::vector<float> cubeData;
-            cubeData.resize(cubeSize*cubeSize*cubeSize*3);
-            GenerateIdentityLut3D(&cubeData[0], cubeSize, 3, LUT3DORDER_FAST_BLUE);
-            PackedImageDesc cubeImg(&cubeData[0], cubeSize*cubeSize*cubeSize, 1, 3);
-
             // Apply our conversion from the input space to the output space.
-            ConstProcessorRcPtr inputToTarget;
-            std::string looks = baker.getLooks();
-            if (!looks.empty())
-            {
-                LookTransformRcPtr transform = LookTransform::Create();
-                transform->setLooks(looks.c_str());
-                transform->setSrc(baker.getInputSpace());
-                transform->setDst(baker.getTargetSpace());
-                inputToTarget = config->getProcessor(transform,
-                    TRANSFORM_DIR_FORWARD);
-            }
-            else
-            {
-              inputToTarget = config->getProcessor(baker.getInputSpace(),
-                  baker.getTargetSpace());
-            }
-            ConstCPUProcessorRcPtr cpu = inputToTarget->getDefaultCPUProcessor();
-            cpu->apply(cubeImg);
+            const std::vector<float> cubeData
+                = BakeLut3D(GetInputToTargetProcessor(baker), cubeSize, LUT3DORDER_FAST_BLUE);
 
             // Write out the file.
             // For for maximum compatibility with other apps, we will
@@ -554,13 +540,14 @@ OCIO_NAMESPACE_ENTER
             float shaperScale = static_cast<float>(
                 GetMaxValueFromIntegerBitDepth(SHAPER_BIT_DEPTH));
 
+            NumberWriter writer(ostream);
             for(unsigned int i=0; i<shaperData.size(); ++i)
             {
-                if(i != 0) ostream << " ";
+                if(i != 0) writer.writeChar(' ');
                 int val = GetClampedIntFromNormFloat(shaperData[i], shaperScale);
-                ostream << val;
+                writer.writeInt(val);
             }
-            ostream << "\n";
+            writer.writeChar('\n');
 
             // Write out the 3D Cube.
             float cubeScale = static_cast<float>(
@@ -574,9 +561,15 @@ OCIO_NAMESPACE_ENTER
                 int r = GetClampedIntFromNormFloat(cubeData[3*i+0], cubeScale);
                 int g = GetClampedIntFromNormFloat(cubeData[3*i+1], cubeScale);
                 int b = GetClampedIntFromNormFloat(cubeData[3*i+2], cubeScale);
-                ostream << r << " " << g << " " << b << "\n";
+                writer.writeInt(r);
+                writer.writeChar(' ');
+                writer.writeInt(g);
+                writer.writeChar(' ');
+                writer.writeInt(b);
+                writer.writeChar('\n');
             }
-            ostream << "\n";
+            writer.writeChar('\n');
+            writer.flush();
 
             if(formatName == "lustre")
             {
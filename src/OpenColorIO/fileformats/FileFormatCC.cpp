@@ -37,10 +37,16 @@ OCIO_NAMESPACE_ENTER
             ~LocalFileFormat() = default;
             
             void getFormatInfo(FormatInfoVec & formatInfoVec) const override;
+
+            int probe(const std::string & header) const override;
             
             CachedFileRcPtr read(
                 std::istream & istream,
                 const std::string & fileName) const override;
+
+            bool writeCachedFile(const CachedFile & cachedFile,
+                                 std::ostream & ostream) const override;
+            CachedFileRcPtr readCachedFile(std::istream & istream) const override;
             
             void buildFileOps(OpRcPtrVec & ops,
                               const Config& config,
@@ -62,6 +68,22 @@ OCIO_NAMESPACE_ENTER
         // Try and load the format
         // Raise an exception if it can't be loaded.
         
+        int LocalFileFormat::probe(const std::string & header) const
+        {
+            if (!IsProbeXML(header))
+            {
+                return FORMAT_PROBE_NO;
+            }
+            if (header.find("<ColorCorrection") == std::string::npos)
+            {
+                return FORMAT_PROBE_UNKNOWN;
+            }
+            // The parser also reads the other CDL root elements.
+            return (header.find("<ColorDecisionList") == std::string::npos
+                    && header.find("<ColorCorrectionCollection") == std::string::npos)
+                ? FORMAT_PROBE_CERTAIN : FORMAT_PROBE_LIKELY;
+        }
+
         CachedFileRcPtr LocalFileFormat::read(
             std::istream & istream,
             const std::string & fileName) const
@@ -86,6 +108,23 @@ OCIO_NAMESPACE_ENTER
             return cachedFile;
         }
         
+        bool LocalFileFormat::writeCachedFile(const CachedFile & cachedFile,
+                                              std::ostream & ostream) const
+        {
+            const LocalCachedFile & file = dynamic_cast<const LocalCachedFile &>(cachedFile);
+
+            WriteCachedCDL(ostream, file.transform);
+            return true;
+        }
+
+        CachedFileRcPtr LocalFileFormat::readCachedFile(std::istream & istream) const
+        {
+            LocalCachedFileRcPtr cachedFile = LocalCachedFileRcPtr(new LocalCachedFile());
+
+            ReadCachedCDL(istream, cachedFile->transform);
+            return cachedFile;
+        }
+
         void
         LocalFileFormat::buildFileOps(OpRcPtrVec & ops,
                                       const Config& config,
@@ -45,6 +45,8 @@ OCIO_NAMESPACE_ENTER
             ~LocalFileFormat() = default;
             
             void getFormatInfo(FormatInfoVec & formatInfoVec) const override;
+
+            int probe(const std::string & header) const override;
             
             CachedFileRcPtr read(
                 std::istream & istream,
@@ -70,6 +72,22 @@ OCIO_NAMESPACE_ENTER
         // Try and load the format
         // Raise an exception if it can't be loaded.
         
+        int LocalFileFormat::probe(const std::string & header) const
+        {
+            if (!IsProbeXML(header))
+            {
+                return FORMAT_PROBE_NO;
+            }
+            if (header.find("<ColorCorrectionCollection") != std::string::npos)
+            {
+                return FORMAT_PROBE_CERTAIN;
+            }
+            // The parser also reads the other CDL root elements.
+            return (header.find("<ColorDecisionList") != std::string::npos
+                    || header.find("<ColorCorrection") != std::string::npos) ? FORMAT_PROBE_LIKELY
+                                                                             : FORMAT_PROBE_UNKNOWN;
+        }
+
         CachedFileRcPtr LocalFileFormat::read(
             std::istream & istream,
             const std::string & fileName) const
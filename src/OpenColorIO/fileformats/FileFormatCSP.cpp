@@ -13,6 +13,7 @@
 
 #include <OpenColorIO/OpenColorIO.h>
 
+#include "BakingUtils.h"
 #include "MathUtils.h"
 #include "ops/Lut1D/Lut1DOp.h"
 #include "ops/Lut3D/Lut3DOp.h"
@@ -294,6 +295,14 @@ OCIO_NAMESPACE_ENTER
             {
             }
             ~CachedFileCSP() = default;
+
+            size_t getMemorySize() const override
+            {
+                return sizeof(CachedFileCSP)
+                    + GetOpDataMemorySize(prelut)
+                    + GetOpDataMemorySize(lut1D)
+                    + GetOpDataMemorySize(lut3D);
+            }
             
             std::string metadata;
 
@@ -319,6 +328,8 @@ OCIO_NAMESPACE_ENTER
 
             void getFormatInfo(FormatInfoVec & formatInfoVec) const override;
 
+            int probe(const std::string & header) const override;
+
             CachedFileRcPtr read(
                 std::istream & istream,
                 const std::string & fileName) const override;
@@ -355,6 +366,16 @@ OCIO_NAMESPACE_ENTER
             formatInfoVec.push_back(info);
         }
         
+        int LocalFileFormat::probe(const std::string & header) const
+        {
+            const std::string line = GetProbeFirstLine(header, true);
+            if (line.empty())
+            {
+                return FORMAT_PROBE_UNKNOWN;
+            }
+            return startswithU(line, "CSPLUTV100") ? FORMAT_PROBE_CERTAIN : FORMAT_PROBE_NO;
+        }
+
         CachedFileRcPtr LocalFileFormat::read(
             std::istream & istream,
             const std::string & fileName) const
@@ -702,23 +723,18 @@ OCIO_NAMESPACE_ENTER
             if(cubeSize==-1) cubeSize = DEFAULT_CUBE_SIZE;
             cubeSize = std::max(2, cubeSize); // smallest cube is 2x2x2
             std::vector<float> cubeData;
-            cubeData.resize(cubeSize*cubeSize*cubeSize*3);
-            GenerateIdentityLut3D(&cubeData[0], cubeSize, 3, LUT3DORDER_FAST_RED);
-            PackedImageDesc cubeImg(&cubeData[0], cubeSize*cubeSize*cubeSize, 1, 3);
 
-            std::string looks = baker.getLooks();
-            
             std::vector<float> shaperInData;
             std::vector<float> shaperOutData;
             
             // Use an explicitly shaper space.
             // TODO: Use the optional allocation for the shaper space,
             //       instead of the implied 0-1 uniform allocation.
-            std::string shaperSpace = baker.getShaperSpace();
-            if(!shaperSpace.empty())
+            if(HasShaper(baker))
             {
                 int shaperSize = baker.getShaperSize();
                 if(shaperSize<0) shaperSize = DEFAULT_SHAPER_SIZE;
+                SelectShaperAndCubeSizes(baker, shaperSize, cubeSize);
                 if(shaperSize<2)
                 {
                     std::ostringstream os;
@@ -727,15 +743,8 @@ OCIO_NAMESPACE_ENTER
                     throw Exception(os.str().c_str());
                 }
                 
-                shaperOutData.resize(shaperSize*3);
-                shaperInData.resize(shaperSize*3);
-                GenerateIdentityLut1D(&shaperOutData[0], shaperSize, 3);
-                GenerateIdentityLut1D(&shaperInData[0], shaperSize, 3);
-                
-                ConstCPUProcessorRcPtr shaperToInput 
-                    = config->getProcessor(baker.getShaperSpace(), 
-                                           baker.getInputSpace())->getDefaultCPUProcessor();
-                if(shaperToInput->hasChannelCrosstalk())
+                ConstProcessorRcPtr shaperToInput = GetShaperToInputProcessor(baker);
+                if(shaperToInput->getDefaultCPUProcessor()->hasChannelCrosstalk())
                 {
                     // TODO: Automatically turn shaper into non-crosstalked version?
                     std::ostringstream os;
@@ -744,27 +753,24 @@ OCIO_NAMESPACE_ENTER
                     os << "Please select an alternate shaper space or omit this option.";
                     throw Exception(os.str().c_str());
                 }
-                PackedImageDesc shaperInImg(&shaperInData[0], shaperSize, 1, 3);
-                shaperToInput->apply(shaperInImg);
 
-                ConstCPUProcessorRcPtr shaperToTarget;
-                if (!looks.empty())
-                {
-                    LookTransformRcPtr transform = LookTransform::Create();
-                    transform->setLooks(looks.c_str());
-                    transform->setSrc(baker.getShaperSpace());
-                    transform->setDst(baker.getTargetSpace());
-                    shaperToTarget
-                        = config->getProcessor(transform, 
-                                               TRANSFORM_DIR_FORWARD)->getDefaultCPUProcessor();
-                }
-                else
-                {
-                    shaperToTarget
-                        = config->getProcessor(baker.getShaperSpace(), 
-                                               baker.getTargetSpace())->getDefaultCPUProcessor();
-                }
-                shaperToTarget->apply(cubeImg);
+                shaperOutData = BakeLut1D(ConstProcessorRcPtr(), shaperSize);
+                shaperInData  = BakeLut1D(shaperToInput, shaperSize);
+
+                cubeData = BakeLut3D(GetShaperToTargetProcessor(baker), cubeSize,
+                                     LUT3DORDER_FAST_RED);
+            }
+            else if(baker.getProcessor())
+            {
+                // A processor to bake has no input space allocation, so the shaper is the
+                // identity i.e. a uniform allocation only needing 2 points.
+                SelectCubeSize(baker, cubeSize);
+
+                shaperOutData = BakeLut1D(ConstProcessorRcPtr(), 2);
+                shaperInData  = shaperOutData;
+
+                cubeData = BakeLut3D(GetInputToTargetProcessor(baker), cubeSize,
+                                     LUT3DORDER_FAST_RED);
             }
             else
             {
@@ -807,36 +813,21 @@ OCIO_NAMESPACE_ENTER
                     // If we know it's a uniform scaling, only 2 points will suffice!
                     shaperSize = 2;
                 }
-                shaperOutData.resize(shaperSize*3);
-                shaperInData.resize(shaperSize*3);
-                GenerateIdentityLut1D(&shaperOutData[0], shaperSize, 3);
-                GenerateIdentityLut1D(&shaperInData[0], shaperSize, 3);
-                
+
+                // The cube size is selected as if there was no shaper.
+                SelectCubeSize(baker, cubeSize);
+
                 // Apply the forward to the allocation to the output shaper y axis, and the cube
-                ConstCPUProcessorRcPtr shaperToInput
-                    = config->getProcessor(allocationTransform, TRANSFORM_DIR_INVERSE)->getDefaultCPUProcessor();
+                ConstProcessorRcPtr shaperToInput
+                    = config->getProcessor(allocationTransform, TRANSFORM_DIR_INVERSE);
+
+                shaperOutData = BakeLut1D(ConstProcessorRcPtr(), shaperSize);
+                shaperInData  = BakeLut1D(shaperToInput, shaperSize);
+
+                cubeData = BakeLut3D(shaperToInput, cubeSize, LUT3DORDER_FAST_RED);
 
-                PackedImageDesc shaperInImg(&shaperInData[0], shaperSize, 1, 3);
-                shaperToInput->apply(shaperInImg);
-                shaperToInput->apply(cubeImg);
-                
                 // Apply the 3D LUT to the remainder (from the input to the output).
-                ConstProcessorRcPtr inputToTarget;
-                if (!looks.empty())
-                {
-                    LookTransformRcPtr transform = LookTransform::Create();
-                    transform->setLooks(looks.c_str());
-                    transform->setSrc(baker.getInputSpace());
-                    transform->setDst(baker.getTargetSpace());
-                    inputToTarget = config->getProcessor(transform, 
-                                                         TRANSFORM_DIR_FORWARD);
-                }
-                else
-                {
-                    inputToTarget = config->getProcessor(baker.getInputSpace(), baker.getTargetSpace());
-                }
-                ConstCPUProcessorRcPtr cpu = inputToTarget->getDefaultCPUProcessor();
-                cpu->apply(cubeImg);
+                ApplyToRGB(GetInputToTargetProcessor(baker), cubeData);
             }
             
             // Write out the file.
@@ -861,39 +852,52 @@ OCIO_NAMESPACE_ENTER
                 throw Exception("Internal shaper size exception.");
             }
             
+            NumberWriter writer(ostream);
             if(!shaperInData.empty())
             {
+                const long shaperSize = static_cast<long>(shaperInData.size()/3);
                 for(int c=0; c<3; ++c)
                 {
-                    ostream << shaperInData.size()/3 << "\n";
-                    for(unsigned int i = 0; i<shaperInData.size()/3; ++i)
+                    writer.writeInt(shaperSize);
+                    writer.writeChar('\n');
+                    for(long i = 0; i<shaperSize; ++i)
                     {
-                        if(i != 0) ostream << " ";
-                        ostream << shaperInData[3*i+c];
+                        if(i != 0) writer.writeChar(' ');
+                        writer.writeFixed(shaperInData[3*i+c], 6);
                     }
-                    ostream << "\n";
+                    writer.writeChar('\n');
                     
-                    for(unsigned int i = 0; i<shaperInData.size()/3; ++i)
+                    for(long i = 0; i<shaperSize; ++i)
                     {
-                        if(i != 0) ostream << " ";
-                        ostream << shaperOutData[3*i+c];
+                        if(i != 0) writer.writeChar(' ');
+                        writer.writeFixed(shaperOutData[3*i+c], 6);
                     }
-                    ostream << "\n";
+                    writer.writeChar('\n');
                 }
             }
-            ostream << "\n";
+            writer.writeChar('\n');
             
             // Write out the 3D Cube.
             if(cubeSize < 2)
             {
                 throw Exception("Internal cube size exception.");
             }
-            ostream << cubeSize << " " << cubeSize << " " << cubeSize << "\n";
+            writer.writeInt(cubeSize);
+            writer.writeChar(' ');
+            writer.writeInt(cubeSize);
+            writer.writeChar(' ');
+            writer.writeInt(cubeSize);
+            writer.writeChar('\n');
             for(int i=0; i<cubeSize*cubeSize*cubeSize; ++i)
             {
-                ostream << cubeData[3*i+0] << " " << cubeData[3*i+1] << " " << cubeData[3*i+2] << "\n";
+                writer.writeFixed(cubeData[3*i+0], 6);
+                writer.writeChar(' ');
+                writer.writeFixed(cubeData[3*i+1], 6);
+                writer.writeChar(' ');
+                writer.writeFixed(cubeData[3*i+2], 6);
+                writer.writeChar('\n');
             }
-            ostream << "\n";
+            writer.writeChar('\n');
         }
         
         void
@@ -4,6 +4,7 @@
 #include <cstdio>
 #include <iostream>
 #include <fstream>
+#include <map>
 #include <sstream>
 
 #include <OpenColorIO/OpenColorIO.h>
@@ -15,6 +16,7 @@
 #include "fileformats/xmlutils/XMLReaderHelper.h"
 #include "fileformats/xmlutils/XMLReaderUtils.h"
 #include "fileformats/xmlutils/XMLWriterUtils.h"
+#include "Mutex.h"
 #include "OpBuilders.h"
 #include "ops/NoOp/NoOps.h"
 #include "Platform.h"
@@ -91,6 +93,24 @@ OCIO_NAMESPACE_ENTER
 namespace
 {
 
+// An op of a CTF/CLF file where the path of a Reference op is resolved (refer to
+// LocalCachedFile::getResolvedOps()).
+struct ResolvedOp
+{
+    // Op data of the file, null for a Reference op.
+    ConstOpDataRcPtr m_opData;
+
+    // Resolved path & direction of a Reference op.
+    std::string m_filePath;
+    TransformDirection m_dir = TRANSFORM_DIR_FORWARD;
+};
+
+typedef std::vector<ResolvedOp> ResolvedOpVec;
+typedef OCIO_SHARED_PTR<const ResolvedOpVec> ConstResolvedOpVecRcPtr;
+
+// Maximum number of context states for which the resolved ops of a file are kept.
+constexpr size_t MAX_RESOLVED_CONTEXTS = 16;
+
 class LocalCachedFile : public CachedFile
 {
 public:
@@ -98,10 +118,79 @@ public:
     {
     };
     ~LocalCachedFile() {};
+
+    // The Reference op paths only depend on the context so they are resolved once per
+    // context state, instead of once per processor, and then shared by all the processors
+    // (and all the files) referencing this file.
+    ConstResolvedOpVecRcPtr getResolvedOps(const ConstContextRcPtr & context) const
+    {
+        const std::string contextID = context->getCacheID();
+
+        {
+            AutoMutex lock(m_resolvedOpsMutex);
+            const auto it = m_resolvedOps.find(contextID);
+            if (it != m_resolvedOps.end())
+            {
+                return it->second;
+            }
+        }
+
+        // A failing resolution is not cached so it throws again with the same error.
+        auto resolvedOps = std::make_shared<ResolvedOpVec>();
+        for (const auto & opData : m_transform->getOps())
+        {
+            ResolvedOp resolvedOp;
+            if (opData->getType() == OpData::ReferenceType)
+            {
+                auto ref = DynamicPtrCast<const ReferenceOpData>(opData);
+                if (ref->getReferenceStyle() != REF_PATH)
+                {
+                    // Aliases are not supported.
+                    continue;
+                }
+
+                resolvedOp.m_filePath = context->resolveFileLocation(ref->getPath().c_str());
+                resolvedOp.m_dir = ref->getDirection();
+            }
+            else
+            {
+                resolvedOp.m_opData = opData;
+            }
+            resolvedOps->push_back(resolvedOp);
+        }
+
+        AutoMutex lock(m_resolvedOpsMutex);
+        if (m_resolvedOps.size() >= MAX_RESOLVED_CONTEXTS)
+        {
+            m_resolvedOps.clear();
+        }
+        m_resolvedOps[contextID] = resolvedOps;
+
+        return resolvedOps;
+    }
+
+    size_t getMemorySize() const override
+    {
+        size_t numBytes = sizeof(LocalCachedFile);
+        if (m_transform)
+        {
+            for (const auto & op : m_transform->getOps())
+            {
+                numBytes += GetOpDataMemorySize(op);
+            }
+        }
+        return numBytes;
+    }
             
     CTFReaderTransformPtr m_transform;
     std::string m_filePath;
 
+    // True if the file contains at least one Reference op.
+    bool m_hasReferences = false;
+
+private:
+    mutable Mutex m_resolvedOpsMutex;
+    mutable std::map<std::string, ConstResolvedOpVecRcPtr> m_resolvedOps;
 };
 
 typedef OCIO_SHARED_PTR<LocalCachedFile> LocalCachedFileRcPtr;
@@ -113,6 +202,8 @@ public:
     ~LocalFileFormat() {}
             
     void getFormatInfo(FormatInfoVec & formatInfoVec) const override;
+
+    int probe(const std::string & header) const override;
             
     CachedFileRcPtr read(std::istream & istream,
                          const std::string & fileName) const override;
@@ -147,6 +238,167 @@ void LocalFileFormat::getFormatInfo(FormatInfoVec & formatInfoVec) const
     formatInfoVec.push_back(info2);
 }
 
+// Identifiers of the element names handled by the reader.
+enum ElementTag
+{
+    ELT_UNKNOWN = 0,
+    ELT_ACES,
+    ELT_ACES_PARAMS,
+    ELT_ARRAY,
+    ELT_CDL,
+    ELT_DESCRIPTION,
+    ELT_DYNAMIC_PARAMETER,
+    ELT_EC_PARAMS,
+    ELT_EXPOSURE_CONTRAST,
+    ELT_FIXED_FUNCTION,
+    ELT_GAMMA,
+    ELT_GAMMA_PARAMS,
+    ELT_INDEX_MAP,
+    ELT_INFO,
+    ELT_INPUT_DESCRIPTION,
+    ELT_INPUT_DESCRIPTOR,
+    ELT_INVLUT1D,
+    ELT_INVLUT3D,
+    ELT_LOG,
+    ELT_LOG_PARAMS,
+    ELT_LUT1D,
+    ELT_LUT3D,
+    ELT_MATRIX,
+    ELT_MAX_IN_VALUE,
+    ELT_MAX_OUT_VALUE,
+    ELT_MIN_IN_VALUE,
+    ELT_MIN_OUT_VALUE,
+    ELT_OFFSET,
+    ELT_OUTPUT_DESCRIPTOR,
+    ELT_POWER,
+    ELT_PROCESS_LIST,
+    ELT_RANGE,
+    ELT_REFERENCE,
+    ELT_SATNODE,
+    ELT_SATURATION,
+    ELT_SLOPE,
+    ELT_SOPNODE,
+    ELT_VIEWING_DESCRIPTION,
+
+    ELT_ANY_PARENT // Only used as the expected parent of an element.
+};
+
+// The element names are case-insensitive. Rather than comparing each start tag against all
+// the supported names, the names are interned once in an open addressing hash table keyed
+// on the lower case name, so the lookup of a tag costs one hash and usually one comparison.
+class ElementTagTable
+{
+public:
+    ElementTagTable()
+    {
+        static const struct { const char * name; ElementTag tag; } entries[] = {
+            { TAG_ACES,                     ELT_ACES },
+            { TAG_ACES_PARAMS,              ELT_ACES_PARAMS },
+            { TAG_ARRAY,                    ELT_ARRAY },
+            { TAG_CDL,                      ELT_CDL },
+            { TAG_DESCRIPTION,              ELT_DESCRIPTION },
+            { TAG_DYNAMIC_PARAMETER,        ELT_DYNAMIC_PARAMETER },
+            { TAG_EC_PARAMS,                ELT_EC_PARAMS },
+            { TAG_EXPOSURE_CONTRAST,        ELT_EXPOSURE_CONTRAST },
+            { TAG_FIXED_FUNCTION,           ELT_FIXED_FUNCTION },
+            { TAG_GAMMA,                    ELT_GAMMA },
+            { TAG_GAMMA_PARAMS,             ELT_GAMMA_PARAMS },
+            { TAG_INDEX_MAP,                ELT_INDEX_MAP },
+            { TAG_INFO,                     ELT_INFO },
+            { METADATA_INPUT_DESCRIPTION,   ELT_INPUT_DESCRIPTION },
+            { TAG_INPUT_DESCRIPTOR,         ELT_INPUT_DESCRIPTOR },
+            { TAG_INVLUT1D,                 ELT_INVLUT1D },
+            { TAG_INVLUT3D,                 ELT_INVLUT3D },
+            { TAG_LOG,                      ELT_LOG },
+            { TAG_LOG_PARAMS,               ELT_LOG_PARAMS },
+            { TAG_LUT1D,                    ELT_LUT1D },
+            { TAG_LUT3D,                    ELT_LUT3D },
+            { TAG_MATRIX,                   ELT_MATRIX },
+            { TAG_MAX_IN_VALUE,             ELT_MAX_IN_VALUE },
+            { TAG_MAX_OUT_VALUE,            ELT_MAX_OUT_VALUE },
+            { TAG_MIN_IN_VALUE,             ELT_MIN_IN_VALUE },
+            { TAG_MIN_OUT_VALUE,            ELT_MIN_OUT_VALUE },
+            { TAG_OFFSET,                   ELT_OFFSET },
+            { TAG_OUTPUT_DESCRIPTOR,        ELT_OUTPUT_DESCRIPTOR },
+            { TAG_POWER,                    ELT_POWER },
+            { TAG_PROCESS_LIST,             ELT_PROCESS_LIST },
+            { TAG_RANGE,                    ELT_RANGE },
+            { TAG_REFERENCE,                ELT_REFERENCE },
+            // Note that TAG_SATNODEALT only differs by the case.
+            { TAG_SATNODE,                  ELT_SATNODE },
+            { TAG_SATURATION,               ELT_SATURATION },
+            { TAG_SLOPE,                    ELT_SLOPE },
+            { TAG_SOPNODE,                  ELT_SOPNODE },
+            { METADATA_VIEWING_DESCRIPTION, ELT_VIEWING_DESCRIPTION },
+        };
+
+        static_assert(sizeof(entries) / sizeof(entries[0]) < NumSlots / 2,
+                      "The element tag table is too small");
+
+        for (const auto & entry : entries)
+        {
+            const unsigned hash = Hash(entry.name);
+
+            unsigned idx = hash & (NumSlots - 1);
+            while (m_slots[idx].name)
+            {
+                idx = (idx + 1) & (NumSlots - 1);
+            }
+
+            m_slots[idx].name = entry.name;
+            m_slots[idx].hash = hash;
+            m_slots[idx].tag  = entry.tag;
+        }
+    }
+
+    ElementTag find(const char * name) const
+    {
+        const unsigned hash = Hash(name);
+
+        for (unsigned idx = hash & (NumSlots - 1); m_slots[idx].name;
+             idx = (idx + 1) & (NumSlots - 1))
+        {
+            if (m_slots[idx].hash == hash && 0 == Platform::Strcasecmp(name, m_slots[idx].name))
+            {
+                return m_slots[idx].tag;
+            }
+        }
+
+        return ELT_UNKNOWN;
+    }
+
+private:
+    // FNV-1a hash of the ASCII lower case name.
+    static unsigned Hash(const char * name)
+    {
+        unsigned hash = 2166136261u;
+        for (; *name; ++name)
+        {
+            const unsigned char c = (unsigned char)*name;
+            hash ^= (c >= 'A' && c <= 'Z') ? (unsigned)(c + ('a' - 'A')) : (unsigned)c;
+            hash *= 16777619u;
+        }
+        return hash;
+    }
+
+    static constexpr unsigned NumSlots = 128;
+
+    struct Slot
+    {
+        const char * name = nullptr;
+        unsigned hash = 0;
+        ElementTag tag = ELT_UNKNOWN;
+    };
+
+    Slot m_slots[NumSlots];
+};
+
+ElementTag GetElementTag(const char * name)
+{
+    static const ElementTagTable table;
+    return table.find(name);
+}
+
 class XMLParserHelper
 {
 public:
@@ -307,60 +559,18 @@ private:
         throw Exception(os.str().c_str());
     }
 
-    // Determines if the element name is supported in the current context.
-    static bool SupportedElement(const char * name,
-                                 ElementRcPtr & parent,
-                                 const char * tag,
-                                 const char * parentName,
-                                 bool & recognizedName)
-    {
-        if (name && *name && tag && *tag)
-        {
-            if (0 == Platform::Strcasecmp(name, tag))
-            {
-                recognizedName |= true;
-
-                if (!parentName || !strlen(parentName) ||
-                    (parent &&
-                     0 == Platform::Strcasecmp(parent->getName().c_str(),
-                                               parentName)))
-                {
-                    return true;
-                }
-            }
-        }
-
-        return false;
-    }
-
-    static bool SupportedElement(const char * name,
-                                 ElementRcPtr & parent,
-                                 const std::vector<const char *> & tags,
-                                 const char * parentName,
+    // Determines if the element is supported in the current context.
+    static bool SupportedElement(ElementTag tag,
+                                 ElementTag parentTag,
+                                 ElementTag expectedTag,
+                                 ElementTag expectedParentTag,
                                  bool & recognizedName)
     {
-        if (name && *name)
+        if (tag != ELT_UNKNOWN && tag == expectedTag)
         {
-            const size_t numTags(tags.size());
-            size_t i = 0;
-            for (; i<numTags; ++i)
-            {
-                if (0 == Platform::Strcasecmp(name, tags[i]))
-                {
-                    recognizedName |= true;
-                    break;
-                }
-            }
+            recognizedName |= true;
 
-            // If found name in the tag list, test the parent name.
-            if (i < numTags)
-            {
-                if (!parentName || !strlen(parentName) ||
-                    (parent && 0 == Platform::Strcasecmp(parent->getName().c_str(), parentName)))
-                {
-                    return true;
-                }
-            }
+            return expectedParentTag == ELT_ANY_PARENT || expectedParentTag == parentTag;
         }
 
         return false;
@@ -371,19 +581,6 @@ private:
                                     const XML_Char * name,
                                     const XML_Char ** atts)
     {
-        static const std::vector<const char *> rangeSubElements = {
-            TAG_MIN_IN_VALUE,
-            TAG_MAX_IN_VALUE,
-            TAG_MIN_OUT_VALUE,
-            TAG_MAX_OUT_VALUE
-        };
-
-        static const std::vector<const char *> sopSubElements = {
-            TAG_SLOPE,
-            TAG_OFFSET,
-            TAG_POWER
-        };
-
         XMLParserHelper * pImpl = (XMLParserHelper*)userData;
 
         if (!pImpl || !name || !*name)
@@ -419,8 +616,11 @@ private:
             }
         }
 
+        // Intern the element name once so the dispatch below only compares identifiers.
+        const ElementTag tag = GetElementTag(name);
+
         // Handle the ProcessList element or its children (the ops).
-        if (0 == Platform::Strcasecmp(name, TAG_PROCESS_LIST))
+        if (tag == ELT_PROCESS_LIST)
         {
             if (pImpl->m_transform.get())
             {
@@ -457,6 +657,9 @@ private:
                 pElt = pImpl->m_elms.back();
             }
 
+            const ElementTag parentTag
+                = pElt ? GetElementTag(pElt->getName().c_str()) : ELT_UNKNOWN;
+
             // Safety check to try and ensure that all new elements will get handled here.
             static_assert(CTFReaderOpElt::NoType == 13, "Need to handle new type here");
 
@@ -468,68 +671,68 @@ private:
 
             // For each possible element name, test against a tag name and a
             // current parent name to determine if the element should be handled.
-            if (SupportedElement(name, pElt, TAG_ACES,
-                                      TAG_PROCESS_LIST, recognizedName))
+            if (SupportedElement(tag, parentTag, ELT_ACES,
+                                      ELT_PROCESS_LIST, recognizedName))
             {
                 pImpl->AddOpReader(CTFReaderOpElt::ACESType, name);
             }
-            else if (SupportedElement(name, pElt, TAG_CDL,
-                                      TAG_PROCESS_LIST, recognizedName))
+            else if (SupportedElement(tag, parentTag, ELT_CDL,
+                                      ELT_PROCESS_LIST, recognizedName))
             {
                 pImpl->AddOpReader(CTFReaderOpElt::CDLType, name);
             }
-            else if (SupportedElement(name, pElt, TAG_EXPOSURE_CONTRAST,
-                                      TAG_PROCESS_LIST, recognizedName))
+            else if (SupportedElement(tag, parentTag, ELT_EXPOSURE_CONTRAST,
+                                      ELT_PROCESS_LIST, recognizedName))
             {
                 pImpl->AddOpReader(CTFReaderOpElt::ExposureContrastType, name);
             }
-            else if (SupportedElement(name, pElt, TAG_FIXED_FUNCTION,
-                                      TAG_PROCESS_LIST, recognizedName))
+            else if (SupportedElement(tag, parentTag, ELT_FIXED_FUNCTION,
+                                      ELT_PROCESS_LIST, recognizedName))
             {
                 pImpl->AddOpReader(CTFReaderOpElt::FixedFunctionType, name);
             }
-            else if (SupportedElement(name, pElt, TAG_GAMMA,
-                                      TAG_PROCESS_LIST, recognizedName))
+            else if (SupportedElement(tag, parentTag, ELT_GAMMA,
+                                      ELT_PROCESS_LIST, recognizedName))
             {
                 pImpl->AddOpReader(CTFReaderOpElt::GammaType, name);
             }
-            else if (SupportedElement(name, pElt, TAG_INVLUT1D,
-                                      TAG_PROCESS_LIST, recognizedName))
+            else if (SupportedElement(tag, parentTag, ELT_INVLUT1D,
+                                      ELT_PROCESS_LIST, recognizedName))
             {
                 pImpl->AddOpReader(CTFReaderOpElt::InvLut1DType, name);
             }
-            else if (SupportedElement(name, pElt, TAG_INVLUT3D,
-                                      TAG_PROCESS_LIST, recognizedName))
+            else if (SupportedElement(tag, parentTag, ELT_INVLUT3D,
+                                      ELT_PROCESS_LIST, recognizedName))
             {
                 pImpl->AddOpReader(CTFReaderOpElt::InvLut3DType, name);
             }
-            else if (SupportedElement(name, pElt, TAG_LOG,
-                                      TAG_PROCESS_LIST, recognizedName))
+            else if (SupportedElement(tag, parentTag, ELT_LOG,
+                                      ELT_PROCESS_LIST, recognizedName))
             {
                 pImpl->AddOpReader(CTFReaderOpElt::LogType, name);
             }
-            else if (SupportedElement(name, pElt, TAG_LUT1D,
-                                      TAG_PROCESS_LIST, recognizedName))
+            else if (SupportedElement(tag, parentTag, ELT_LUT1D,
+                                      ELT_PROCESS_LIST, recognizedName))
             {
                 pImpl->AddOpReader(CTFReaderOpElt::Lut1DType, name);
             }
-            else if (SupportedElement(name, pElt, TAG_LUT3D,
-                                      TAG_PROCESS_LIST, recognizedName))
+            else if (SupportedElement(tag, parentTag, ELT_LUT3D,
+                                      ELT_PROCESS_LIST, recognizedName))
             {
                 pImpl->AddOpReader(CTFReaderOpElt::Lut3DType, name);
             }
-            else if (SupportedElement(name, pElt, TAG_MATRIX,
-                                      TAG_PROCESS_LIST, recognizedName))
+            else if (SupportedElement(tag, parentTag, ELT_MATRIX,
+                                      ELT_PROCESS_LIST, recognizedName))
             {
                 pImpl->AddOpReader(CTFReaderOpElt::MatrixType, name);
             }
-            else if (SupportedElement(name, pElt, TAG_RANGE,
-                                      TAG_PROCESS_LIST, recognizedName))
+            else if (SupportedElement(tag, parentTag, ELT_RANGE,
+                                      ELT_PROCESS_LIST, recognizedName))
             {
                 pImpl->AddOpReader(CTFReaderOpElt::RangeType, name);
             }
-            else if (SupportedElement(name, pElt, TAG_REFERENCE,
-                                      TAG_PROCESS_LIST, recognizedName))
+            else if (SupportedElement(tag, parentTag, ELT_REFERENCE,
+                                      ELT_PROCESS_LIST, recognizedName))
             {
                 pImpl->AddOpReader(CTFReaderOpElt::ReferenceType, name);
             }
@@ -552,8 +755,8 @@ private:
                             pImpl->getXmlFilename(),
                             nullptr));
                 }
-                else if (SupportedElement(name, pElt, TAG_ACES_PARAMS,
-                                          TAG_ACES, recognizedName))
+                else if (SupportedElement(tag, parentTag, ELT_ACES_PARAMS,
+                                          ELT_ACES, recognizedName))
                 {
                     pImpl->m_elms.push_back(
                         std::make_shared<CTFReaderACESParamsElt>(
@@ -562,11 +765,11 @@ private:
                             pImpl->getXmLineNumber(),
                             pImpl->getXmlFilename()));
                 }
-                else if (SupportedElement(name, pElt, TAG_ARRAY, TAG_LUT1D, recognizedName) ||
-                         SupportedElement(name, pElt, TAG_ARRAY, TAG_INVLUT1D, recognizedName) ||
-                         SupportedElement(name, pElt, TAG_ARRAY, TAG_LUT3D, recognizedName) ||
-                         SupportedElement(name, pElt, TAG_ARRAY, TAG_INVLUT3D, recognizedName) ||
-                         SupportedElement(name, pElt, TAG_ARRAY, TAG_MATRIX, recognizedName))
+                else if (SupportedElement(tag, parentTag, ELT_ARRAY, ELT_LUT1D, recognizedName) ||
+                         SupportedElement(tag, parentTag, ELT_ARRAY, ELT_INVLUT1D, recognizedName) ||
+                         SupportedElement(tag, parentTag, ELT_ARRAY, ELT_LUT3D, recognizedName) ||
+                         SupportedElement(tag, parentTag, ELT_ARRAY, ELT_INVLUT3D, recognizedName) ||
+                         SupportedElement(tag, parentTag, ELT_ARRAY, ELT_MATRIX, recognizedName))
                 {
                     auto pA = std::dynamic_pointer_cast<CTFArrayMgt>(pContainer);
                     if (!pA || pA->isCompleted())
@@ -601,9 +804,9 @@ private:
                                 pImpl->getXmlFilename()));
                     }
                 }
-                else if (SupportedElement(name, pElt, TAG_DESCRIPTION, "", recognizedName) ||
-                         SupportedElement(name, pElt, METADATA_INPUT_DESCRIPTION, TAG_CDL, recognizedName) ||
-                         SupportedElement(name, pElt, METADATA_VIEWING_DESCRIPTION, TAG_CDL, recognizedName))
+                else if (SupportedElement(tag, parentTag, ELT_DESCRIPTION, ELT_ANY_PARENT, recognizedName) ||
+                         SupportedElement(tag, parentTag, ELT_INPUT_DESCRIPTION, ELT_CDL, recognizedName) ||
+                         SupportedElement(tag, parentTag, ELT_VIEWING_DESCRIPTION, ELT_CDL, recognizedName))
                 {
                     pImpl->m_elms.push_back(
                         std::make_shared<XmlReaderDescriptionElt>(
@@ -616,8 +819,8 @@ private:
                 // test if the tag is supported to set the recognizedName 
                 // accordingly, without testing for parents. Test for the
                 // parent type prior to testing the name.
-                else if (SupportedElement(name, pElt, TAG_DYNAMIC_PARAMETER,
-                                          "", recognizedName) &&
+                else if (SupportedElement(tag, parentTag, ELT_DYNAMIC_PARAMETER,
+                                          ELT_ANY_PARENT, recognizedName) &&
                          std::dynamic_pointer_cast<CTFReaderOpElt>(pContainer))
                 {
                     pImpl->m_elms.push_back(
@@ -627,8 +830,8 @@ private:
                             pImpl->getXmLineNumber(),
                             pImpl->getXmlFilename()));
                 }
-                else if (SupportedElement(name, pElt, TAG_EC_PARAMS,
-                                          TAG_EXPOSURE_CONTRAST, recognizedName))
+                else if (SupportedElement(tag, parentTag, ELT_EC_PARAMS,
+                                          ELT_EXPOSURE_CONTRAST, recognizedName))
                 {
                     pImpl->m_elms.push_back(
                         std::make_shared<CTFReaderECParamsElt>(
@@ -637,8 +840,8 @@ private:
                             pImpl->getXmLineNumber(),
                             pImpl->getXmlFilename()));
                 }
-                else if (SupportedElement(name, pElt, TAG_GAMMA_PARAMS,
-                                          TAG_GAMMA, recognizedName))
+                else if (SupportedElement(tag, parentTag, ELT_GAMMA_PARAMS,
+                                          ELT_GAMMA, recognizedName))
                 {
                     CTFReaderGammaElt * pGamma = dynamic_cast<CTFReaderGammaElt*>(pContainer.get());
                     pImpl->m_elms.push_back(
@@ -648,8 +851,8 @@ private:
                             pImpl->getXmLineNumber(),
                             pImpl->getXmlFilename()));
                 }
-                else if (SupportedElement(name, pElt, TAG_INDEX_MAP, TAG_LUT1D, recognizedName) ||
-                         SupportedElement(name, pElt, TAG_INDEX_MAP, TAG_LUT3D, recognizedName))
+                else if (SupportedElement(tag, parentTag, ELT_INDEX_MAP, ELT_LUT1D, recognizedName) ||
+                         SupportedElement(tag, parentTag, ELT_INDEX_MAP, ELT_LUT3D, recognizedName))
                 {
                     auto pA = std::dynamic_pointer_cast<CTFIndexMapMgt>(pContainer);
                     if (!pA || pA->isCompletedIM())
@@ -680,8 +883,8 @@ private:
                     }
 
                 }
-                else if (SupportedElement(name, pElt, TAG_INFO, 
-                                          TAG_PROCESS_LIST, recognizedName))
+                else if (SupportedElement(tag, parentTag, ELT_INFO, 
+                                          ELT_PROCESS_LIST, recognizedName))
                 {
                     pImpl->m_elms.push_back(
                         std::make_shared<CTFReaderInfoElt>(
@@ -690,8 +893,8 @@ private:
                             pImpl->getXmLineNumber(),
                             pImpl->getXmlFilename()));
                 }
-                else if (SupportedElement(name, pElt, TAG_INPUT_DESCRIPTOR,
-                                          TAG_PROCESS_LIST, recognizedName))
+                else if (SupportedElement(tag, parentTag, ELT_INPUT_DESCRIPTOR,
+                                          ELT_PROCESS_LIST, recognizedName))
                 {
                     pImpl->m_elms.push_back(
                         std::make_shared<CTFReaderInputDescriptorElt>(
@@ -700,8 +903,8 @@ private:
                             pImpl->getXmLineNumber(),
                             pImpl->getXmlFilename()));
                 }
-                else if (SupportedElement(name, pElt, TAG_LOG_PARAMS,
-                                          TAG_LOG, recognizedName))
+                else if (SupportedElement(tag, parentTag, ELT_LOG_PARAMS,
+                                          ELT_LOG, recognizedName))
                 {
                     auto pLog = std::dynamic_pointer_cast<CTFReaderLogElt>(pContainer);
                     const auto style = pLog->getCTFParams().m_style;
@@ -725,8 +928,8 @@ private:
                                 pImpl->getXmlFilename()));
                     }
                 }
-                else if (SupportedElement(name, pElt, TAG_OUTPUT_DESCRIPTOR,
-                    TAG_PROCESS_LIST, recognizedName))
+                else if (SupportedElement(tag, parentTag, ELT_OUTPUT_DESCRIPTOR,
+                    ELT_PROCESS_LIST, recognizedName))
                 {
                     pImpl->m_elms.push_back(
                         std::make_shared<CTFReaderOutputDescriptorElt>(
@@ -735,8 +938,10 @@ private:
                             pImpl->getXmLineNumber(),
                             pImpl->getXmlFilename()));
                 }
-                else if (SupportedElement(name, pElt, rangeSubElements,
-                                          TAG_RANGE, recognizedName))
+                else if (SupportedElement(tag, parentTag, ELT_MIN_IN_VALUE, ELT_RANGE, recognizedName) ||
+                         SupportedElement(tag, parentTag, ELT_MAX_IN_VALUE, ELT_RANGE, recognizedName) ||
+                         SupportedElement(tag, parentTag, ELT_MIN_OUT_VALUE, ELT_RANGE, recognizedName) ||
+                         SupportedElement(tag, parentTag, ELT_MAX_OUT_VALUE, ELT_RANGE, recognizedName))
                 {
                     pImpl->m_elms.push_back(
                         std::make_shared<CTFReaderRangeValueElt>(
@@ -745,10 +950,8 @@ private:
                             pImpl->getXmLineNumber(),
                             pImpl->getXmlFilename()));
                 }
-                else if (SupportedElement(name, pElt, TAG_SATNODE,
-                                          TAG_CDL, recognizedName) ||
-                         SupportedElement(name, pElt, TAG_SATNODEALT,
-                                          TAG_CDL, recognizedName))
+                else if (SupportedElement(tag, parentTag, ELT_SATNODE,
+                                          ELT_CDL, recognizedName))
                 {
                     auto pCDL =
                         std::dynamic_pointer_cast<CTFReaderCDLElt>(pContainer);
@@ -760,8 +963,8 @@ private:
                         pImpl->getXmlFilename());
                     pImpl->m_elms.push_back(satNodeElt);
                 }
-                else if (SupportedElement(name, pElt, TAG_SATURATION,
-                                          TAG_SATNODE, recognizedName))
+                else if (SupportedElement(tag, parentTag, ELT_SATURATION,
+                                          ELT_SATNODE, recognizedName))
                 {
                     pImpl->m_elms.push_back(
                         std::make_shared<XmlReaderSaturationElt>(
@@ -770,8 +973,8 @@ private:
                             pImpl->getXmLineNumber(),
                             pImpl->getXmlFilename()));
                 }
-                else if (SupportedElement(name, pElt, TAG_SOPNODE,
-                                          TAG_CDL, recognizedName))
+                else if (SupportedElement(tag, parentTag, ELT_SOPNODE,
+                                          ELT_CDL, recognizedName))
                 {
                     auto pCDL =
                         std::dynamic_pointer_cast<CTFReaderCDLElt>(pContainer);
@@ -783,8 +986,9 @@ private:
                         pImpl->getXmlFilename());
                     pImpl->m_elms.push_back(sopNodeElt);
                 }
-                else if (SupportedElement(name, pElt, sopSubElements,
-                                          TAG_SOPNODE, recognizedName))
+                else if (SupportedElement(tag, parentTag, ELT_SLOPE, ELT_SOPNODE, recognizedName) ||
+                         SupportedElement(tag, parentTag, ELT_OFFSET, ELT_SOPNODE, recognizedName) ||
+                         SupportedElement(tag, parentTag, ELT_POWER, ELT_SOPNODE, recognizedName))
                 {
                     pImpl->m_elms.push_back(
                         std::make_shared<XmlReaderSOPValueElt>(
@@ -1025,6 +1229,16 @@ bool isLoadableCTF(std::istream & istream)
     return foundPattern;
 }
 
+int LocalFileFormat::probe(const std::string & header) const
+{
+    if (!IsProbeXML(header))
+    {
+        return FORMAT_PROBE_NO;
+    }
+    return header.find("<ProcessList") != std::string::npos ? FORMAT_PROBE_CERTAIN
+                                                           : FORMAT_PROBE_UNKNOWN;
+}
+
 // Try and load the format.
 // Raise an exception if it can't be loaded.
 CachedFileRcPtr LocalFileFormat::read(
@@ -1048,40 +1262,137 @@ CachedFileRcPtr LocalFileFormat::read(
     cachedFile->m_transform = parser.getTransform();
     cachedFile->m_filePath = filePath;
 
+    for (const auto & opData : cachedFile->m_transform->getOps())
+    {
+        if (opData->getType() == OpData::ReferenceType)
+        {
+            cachedFile->m_hasReferences = true;
+            break;
+        }
+    }
+
     return cachedFile;
 }
 
-// Helper called by LocalFileFormat::buildFileOps
-void BuildOp(OpRcPtrVec & ops,
-             const Config& config,
-             const ConstContextRcPtr & context,
-             const ConstOpDataRcPtr & opData,
-             TransformDirection dir)
+void BuildCTFFileOps(OpRcPtrVec & ops,
+                     const Config & config,
+                     const ConstContextRcPtr & context,
+                     const LocalCachedFile & cachedFile,
+                     TransformDirection dir,
+                     StringVec & loadingFiles);
+
+// Helper called by BuildCTFFileOps to build the ops of a referenced file. Same as
+// BuildFileTransformOps() but the path is already resolved and the recursion is detected
+// using the paths of the files being loaded rather than by looking at all the built ops.
+void BuildReferencedFileOps(OpRcPtrVec & ops,
+                            const Config & config,
+                            const ConstContextRcPtr & context,
+                            const std::string & filepath,
+                            TransformDirection dir,
+                            StringVec & loadingFiles)
 {
-    if (opData->getType() == OpData::ReferenceType)
+    for (const auto & loadingFile : loadingFiles)
+    {
+        if (Platform::Strcasecmp(loadingFile.c_str(), filepath.c_str()) == 0)
+        {
+            std::ostringstream os;
+            os << "Reference to: " << filepath;
+            os << " is creating a recursion.";
+
+            throw Exception(os.str().c_str());
+        }
+    }
+
+    try
     {
-        // Recursively resolve the op.
-        ConstReferenceOpDataRcPtr ref = DynamicPtrCast<const ReferenceOpData>(opData);
-        if (ref->getReferenceStyle() == REF_PATH)
+        FileFormat * format = nullptr;
+        CachedFileRcPtr cachedFile;
+        GetCachedFileAndFormat(format, cachedFile, filepath);
+
+        CreateFileNoOp(ops, filepath);
+        ConstOpRcPtr fileNoOp = ops.back();
+
+        auto ctfFile = DynamicPtrCast<const LocalCachedFile>(cachedFile);
+        if (ctfFile)
+        {
+            loadingFiles.push_back(filepath);
+            BuildCTFFileOps(ops, config, context, *ctfFile, dir, loadingFiles);
+            loadingFiles.pop_back();
+        }
+        else
         {
-            dir = CombineTransformDirections(dir, ref->getDirection());
             FileTransformRcPtr fileTransform = FileTransform::Create();
             fileTransform->setInterpolation(INTERP_LINEAR);
             fileTransform->setDirection(TRANSFORM_DIR_FORWARD);
-            fileTransform->setSrc(ref->getPath().c_str());
-            FileTransform * pFileTranform = fileTransform.get();
+            fileTransform->setSrc(filepath.c_str());
 
-            // This might call LocalFileFormat::buildFileOps if the file
-            // is a CTF. BuildFileTransformOps is making sure there is no
-            // cycling recursion.
-            BuildFileTransformOps(ops, config, context, *pFileTranform, dir);
+            format->buildFileOps(ops, config, context, cachedFile, *fileTransform, dir);
+        }
+
+        // File has been loaded completely. It may now be referenced again.
+        auto fileData = DynamicPtrCast<const FileNoOpData>(fileNoOp->data());
+        if (fileData)
+        {
+            fileData->setComplete();
         }
     }
-    else
+    catch (Exception & e)
     {
-        CreateOpVecFromOpData(ops, opData, dir);
+        std::ostringstream err;
+        err << "The transform file: " << filepath;
+        err << " failed while loading ops with this error: ";
+        err << e.what();
+        throw Exception(err.str().c_str());
     }
+}
+
+// Build the ops of a CTF/CLF file, loading the referenced files. The paths of the
+// Reference ops are resolved once per context (refer to LocalCachedFile::getResolvedOps()).
+void BuildCTFFileOps(OpRcPtrVec & ops,
+                     const Config & config,
+                     const ConstContextRcPtr & context,
+                     const LocalCachedFile & cachedFile,
+                     TransformDirection dir,
+                     StringVec & loadingFiles)
+{
+    if (dir == TRANSFORM_DIR_UNKNOWN)
+    {
+        std::ostringstream os;
+        os << "Cannot build file format transform,";
+        os << " unspecified transform direction.";
+        throw Exception(os.str().c_str());
+    }
+
+    FormatMetadataImpl & processorData = ops.getFormatMetadata();
 
+    // Put CTF processList information into the FormatMetadata.
+    cachedFile.m_transform->toMetadata(processorData);
+
+    if (!cachedFile.m_hasReferences)
+    {
+        CreateOpVecFromOpDataVec(ops, cachedFile.m_transform->getOps(), dir);
+        return;
+    }
+
+    ConstResolvedOpVecRcPtr resolvedOps = cachedFile.getResolvedOps(context);
+
+    const int numOps = (int)resolvedOps->size();
+    for (int i = 0; i < numOps; ++i)
+    {
+        const ResolvedOp & resolvedOp
+            = (*resolvedOps)[dir == TRANSFORM_DIR_FORWARD ? i : numOps - 1 - i];
+
+        if (resolvedOp.m_opData)
+        {
+            CreateOpVecFromOpData(ops, resolvedOp.m_opData, dir);
+        }
+        else
+        {
+            BuildReferencedFileOps(ops, config, context, resolvedOp.m_filePath,
+                                   CombineTransformDirections(dir, resolvedOp.m_dir),
+                                   loadingFiles);
+        }
+    }
 }
 
 void
@@ -1104,35 +1415,9 @@ LocalFileFormat::buildFileOps(OpRcPtrVec & ops,
     const TransformDirection newDir 
         = CombineTransformDirections(dir, fileTransform.getDirection());
 
-    if(newDir == TRANSFORM_DIR_UNKNOWN)
-    {
-        std::ostringstream os;
-        os << "Cannot build file format transform,";
-        os << " unspecified transform direction.";
-        throw Exception(os.str().c_str());
-    }
-
-    FormatMetadataImpl & processorData = ops.getFormatMetadata();
-    
-    // Put CTF processList information into the FormatMetadata.
-    cachedFile->m_transform->toMetadata(processorData);
-
     // Resolve reference path using context and load referenced files.
-    const ConstOpDataVec & opDataVec = cachedFile->m_transform->getOps();
-    if (newDir == TRANSFORM_DIR_FORWARD)
-    {
-        for (auto & opData : opDataVec)
-        {
-            BuildOp(ops, config, context, opData, newDir);
-        }
-    }
-    else
-    {
-        for (int idx = (int)opDataVec.size() - 1; idx >= 0; --idx)
-        {
-            BuildOp(ops, config, context, opDataVec[idx], newDir);
-        }
-    }
+    StringVec loadingFiles{ cachedFile->m_filePath };
+    BuildCTFFileOps(ops, config, context, *cachedFile, newDir, loadingFiles);
 }
 
 void LocalFileFormat::write(const OpRcPtrVec & ops,
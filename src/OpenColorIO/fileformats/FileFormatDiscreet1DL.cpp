@@ -4,6 +4,8 @@
 #include <algorithm>
 #include <cmath>
 #include <cstdio>
+#include <cstring>
+#include <iterator>
 #include <sstream>
 #include <iostream>
 
@@ -294,10 +296,23 @@ OCIO_NAMESPACE_ENTER
             return true;
         }
 
-        // Load values from stream into table "ptable".
+        inline bool IsBlank(char c)
+        {
+            return c == ' ' || c == '\t';
+        }
+
+        inline bool IsDigit(char c)
+        {
+            return c >= '0' && c <= '9';
+        }
+
+        // Load values from the buffer [buffer, end) into table "ptable",
+        // moving buffer after the last line read. The table is parsed in
+        // place (i.e. no line copy nor per value string conversion).
         // Return an error status.
         static int tableLoad(
-            std::istream & istream,
+            const char * & buffer,  // Current position in the file content.
+            const char * end,       // End of the file content.
             unsigned short *ptable, // Destination table.
             int length,             // Length of ptable.
             int ptablestart,        // Start at ptable[ptablestart].
@@ -305,34 +320,89 @@ OCIO_NAMESPACE_ENTER
             std::string & errorLine // Line content in case of syntax err
         )
         {
-            char InString[200];
             int Count = ptablestart;
 
-            while (istream.good())
+            while (Count < length)
             {
                 line += 1;
-                istream.getline(InString, 200);
-                if (!istream.good())
+
+                // A value line must be terminated by a new line.
+                const char * eol
+                    = static_cast<const char *>(memchr(buffer, '\n', end - buffer));
+                if (!eol)
                     return Lut1dUtils::IMLUT_ERR_UNEXPECTED_EOF;
 
-                ReplaceTabsAndStripSpaces(InString);
-                StripEndNewLine(InString);
+                const char * ptr = buffer;
+                buffer = eol + 1;
 
-                if (isdigit(*InString))
+                while (ptr < eol && IsBlank(*ptr)) ++ptr;
+
+                if (ptr < eol && IsDigit(*ptr))
                 {
-                    ptable[Count++] = (unsigned short)std::stoi(InString);
-                    if (Count >= length)
-                        break;
+                    // Like std::stoi(), ignore what follows the digits.
+                    unsigned int value = 0;
+                    do
+                    {
+                        value = value * 10 + unsigned(*ptr - '0');
+                        ++ptr;
+                    }
+                    while (ptr < eol && IsDigit(*ptr));
+
+                    ptable[Count++] = (unsigned short)value;
                 }
-                else if (*InString != 0)
+                else
                 {
-                    errorLine = InString;
-                    return Lut1dUtils::IMLUT_ERR_SYNTAX;
+                    const char * last = eol;
+                    if (last > ptr && last[-1] == '\r') --last;
+                    while (last > ptr && IsBlank(last[-1])) --last;
+
+                    if (last != ptr)
+                    {
+                        errorLine.assign(ptr, last);
+                        return Lut1dUtils::IMLUT_ERR_SYNTAX;
+                    }
                 }
             }
             return Lut1dUtils::IMLUT_OK;
         }
 
+        // Find a line of the buffer [buffer, end) that is neither blank
+        // nor a comment, returning its content in line.
+        static bool FindNonComment(
+            const char * buffer,
+            const char * end,
+            int & line,
+            std::string & content)
+        {
+            while (buffer < end)
+            {
+                const char * eol
+                    = static_cast<const char *>(memchr(buffer, '\n', end - buffer));
+                if (!eol)
+                {
+                    // Like the stream version, ignore an unterminated last line.
+                    return false;
+                }
+
+                line += 1;
+
+                const char * ptr = buffer;
+                buffer = eol + 1;
+
+                const char * last = eol;
+                if (last > ptr && last[-1] == '\r') --last;
+                while (ptr < last && IsBlank(*ptr)) ++ptr;
+                while (last > ptr && IsBlank(last[-1])) --last;
+
+                if (last != ptr && *ptr != '#')
+                {
+                    content.assign(ptr, last);
+                    return true;
+                }
+            }
+            return false;
+        }
+
         // Find first line that is not blank or a comment:
         static bool FindNonComment(
             std::istream & istream,
@@ -368,6 +438,9 @@ OCIO_NAMESPACE_ENTER
             std::string & errorLine)
         {
             char InString[200];
+            std::string content;
+            const char * buffer = NULL;
+            const char * end = NULL;
             IMLutStruct * lut = NULL;
             int numtables;
             int length;
@@ -462,10 +535,17 @@ OCIO_NAMESPACE_ENTER
                 tablestart = 0;
             }
 
+            // Read the tables at once rather than line by line.
+            content.assign(std::istreambuf_iterator<char>(istream),
+                           std::istreambuf_iterator<char>());
+
+            buffer = content.data();
+            end = buffer + content.size();
+
             for (i = 0; i < numtables; i++)
             {
                 status = tableLoad(
-                    istream,
+                    buffer, end,
                     lut->tables[i],
                     length,
                     tablestart, 
@@ -496,9 +576,8 @@ OCIO_NAMESPACE_ENTER
 
             // If there are any more lines in the file that are not blank
             // or comments, it's a syntax error:
-            if (FindNonComment(istream, line, InString, 200))
+            if (FindNonComment(buffer, end, line, errorLine))
             {
-                errorLine = InString;
                 status = IMLUT_ERR_SYNTAX;
                 IMLutFree(&lut);
                 *plut = 0;
@@ -640,6 +719,11 @@ OCIO_NAMESPACE_ENTER
                 lut1D->setFileOutputBitDepth(outBitDepth);
             };
             ~LocalCachedFile() = default;
+
+            size_t getMemorySize() const override
+            {
+                return sizeof(LocalCachedFile) + GetOpDataMemorySize(lut1D);
+            }
             
             Lut1DOpDataRcPtr lut1D;
         };
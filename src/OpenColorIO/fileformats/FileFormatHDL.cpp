@@ -29,6 +29,7 @@
 
 #include <OpenColorIO/OpenColorIO.h>
 
+#include "BakingUtils.h"
 #include "MathUtils.h"
 #include "ops/Lut1D/Lut1DOp.h"
 #include "ops/Lut3D/Lut3DOp.h"
@@ -181,21 +182,20 @@ OCIO_NAMESPACE_ENTER
                 }
                 else if(inlut)
                 {
-                    // StringToFloat was far slower, for 787456 values:
-                    // - StringToFloat took 3879 (avg nanoseconds per value)
-                    // - stdtod took 169 nanoseconds
-                    char* endptr = 0;
-                    float v = static_cast<float>(strtod(word.c_str(), &endptr));
+                    // ParseFloat is locale-independent and faster than strtod.
+                    const char * str = word.c_str();
+                    const char * end = str + word.size();
+                    float v = 0.0f;
 
-                    if(!*endptr)
+                    if(ParseFloat(str, end, v) == end)
                     {
                         // Since each word should contain a single
-                        // float value, the pointer should be null
+                        // float value, the whole word is parsed
                         lutValues[lutname].push_back(v);
                     }
                     else
                     {
-                        // stdtod endptr still contained stuff,
+                        // The word still contained stuff,
                         // meaning an invalid float value
                         std::ostringstream os;
                         os << "Invalid float value in " << lutname;
@@ -229,6 +229,13 @@ OCIO_NAMESPACE_ENTER
             }
             ~CachedFileHDL() = default;
 
+            size_t getMemorySize() const override
+            {
+                return sizeof(CachedFileHDL)
+                    + GetOpDataMemorySize(lut1D)
+                    + GetOpDataMemorySize(lut3D);
+            }
+
             void setLUT1D(const std::vector<float> & values)
             {
                 auto lutSize = static_cast<unsigned long>(values.size());
@@ -565,9 +572,6 @@ OCIO_NAMESPACE_ENTER
                 throw Exception(os.str().c_str());
             }
 
-            // Get config
-            ConstConfigRcPtr config = baker.getConfig();
-
             // setup the floating point precision
             ostream.setf(std::ios::fixed, std::ios::floatfield);
             ostream.precision(6);
@@ -621,35 +625,14 @@ OCIO_NAMESPACE_ENTER
             const int HDL_3D = 2; // 3D LUT version number
             const int HDL_3D1D = 3; // 3D LUT with 1D prelut
 
-            // Get spaces from baker
-            const std::string shaperSpace = baker.getShaperSpace();
-            const std::string inputSpace = baker.getInputSpace();
-            const std::string targetSpace = baker.getTargetSpace();
-            const std::string looks = baker.getLooks();
-
             // Determine required LUT type
-            ConstProcessorRcPtr inputToTargetProc;
-            if (!looks.empty())
-            {
-                LookTransformRcPtr transform = LookTransform::Create();
-                transform->setLooks(looks.c_str());
-                transform->setSrc(inputSpace.c_str());
-                transform->setDst(targetSpace.c_str());
-                inputToTargetProc = config->getProcessor(transform,
-                    TRANSFORM_DIR_FORWARD);
-            }
-            else
-            {
-                inputToTargetProc = config->getProcessor(
-                    inputSpace.c_str(),
-                    targetSpace.c_str());
-            }
+            ConstProcessorRcPtr inputToTargetProc = GetInputToTargetProcessor(baker);
 
             int required_lut = -1;
 
             if(inputToTargetProc->hasChannelCrosstalk())
             {
-                if(shaperSpace.empty())
+                if(!HasShaper(baker))
                 {
                     // Has crosstalk, but no prelut, so need 3D LUT
                     required_lut = HDL_3D;
@@ -673,6 +656,20 @@ OCIO_NAMESPACE_ENTER
                     "Internal logic error, LUT type was not determined");
             }
 
+            // Select the sizes within the tolerance of the baker, if any.
+            if(required_lut == HDL_1D)
+            {
+                SelectLut1DSize(baker, onedSize);
+            }
+            else if(required_lut == HDL_3D)
+            {
+                SelectCubeSize(baker, cubeSize);
+            }
+            else
+            {
+                SelectShaperAndCubeSizes(baker, shaperSize, cubeSize);
+            }
+
             // Make prelut
             std::vector<float> prelutData;
 
@@ -684,9 +681,7 @@ OCIO_NAMESPACE_ENTER
                 // TODO: Later we only grab the green channel for the prelut,
                 // should ensure the prelut is monochromatic somehow?
 
-                ConstProcessorRcPtr inputToShaperProc = config->getProcessor(
-                    inputSpace.c_str(),
-                    shaperSpace.c_str());
+                ConstProcessorRcPtr inputToShaperProc = GetInputToShaperProcessor(baker);
 
                 if(inputToShaperProc->hasChannelCrosstalk())
                 {
@@ -701,44 +696,10 @@ OCIO_NAMESPACE_ENTER
                 }
 
                 // Calculate min/max value
-                {
-                    // Get input value of 1.0 in shaper space, as this
-                    // is the higest value that is transformed by the
-                    // cube (e.g for a generic lin-to-log transform,
-                    // what the log value 1.0 is in linear).
-                    ConstCPUProcessorRcPtr shaperToInputProc = config->getProcessor(
-                        shaperSpace.c_str(),
-                        inputSpace.c_str())->getDefaultCPUProcessor();
-
-                    float minval[3] = {0.0f, 0.0f, 0.0f};
-                    float maxval[3] = {1.0f, 1.0f, 1.0f};
-
-                    shaperToInputProc->applyRGB(minval);
-                    shaperToInputProc->applyRGB(maxval);
-
-                    // Grab green channel, as this is the one used later
-                    fromInStart = minval[1];
-                    fromInEnd = maxval[1];
-                }
+                GetShaperRange(baker, fromInStart, fromInEnd);
 
-                // Generate the identity prelut values, then apply the transform.
                 // Prelut is linearly sampled from fromInStart to fromInEnd
-                prelutData.resize(shaperSize*3);
-
-                for (int i = 0; i < shaperSize; ++i)
-                {
-                    const float x = (float)(double(i) / double(shaperSize - 1));
-                    float cur_value = lerpf(fromInStart, fromInEnd, x);
-
-                    prelutData[3*i+0] = cur_value;
-                    prelutData[3*i+1] = cur_value;
-                    prelutData[3*i+2] = cur_value;
-                }
-                
-                PackedImageDesc prelutImg(&prelutData[0], shaperSize, 1, 3);
-
-                ConstCPUProcessorRcPtr cpu = inputToShaperProc->getDefaultCPUProcessor();
-                cpu->apply(prelutImg);
+                prelutData = BakeLut1D(inputToShaperProc, shaperSize, fromInStart, fromInEnd);
             }
 
             // TODO: Do same "auto prelut" input-space allocation as FileFormatCSP?
@@ -747,38 +708,12 @@ OCIO_NAMESPACE_ENTER
             std::vector<float> cubeData;
             if(required_lut == HDL_3D || required_lut == HDL_3D1D)
             {
-                cubeData.resize(cubeSize*cubeSize*cubeSize*3);
-
-                GenerateIdentityLut3D(&cubeData[0], cubeSize, 3, LUT3DORDER_FAST_RED);
-                PackedImageDesc cubeImg(&cubeData[0], cubeSize*cubeSize*cubeSize, 1, 3);
+                // With a prelut, it goes from input-to-shaper so the cube goes from
+                // shaper-to-target, otherwise the cube goes from input-to-target.
+                ConstProcessorRcPtr cubeProc = required_lut == HDL_3D1D
+                    ? GetShaperToTargetProcessor(baker) : inputToTargetProc;
 
-                ConstProcessorRcPtr cubeProc;
-                if(required_lut == HDL_3D1D)
-                {
-                    // Prelut goes from input-to-shaper, so cube goes from shaper-to-target
-                    if (!looks.empty())
-                    {
-                        LookTransformRcPtr transform = LookTransform::Create();
-                        transform->setLooks(looks.c_str());
-                        transform->setSrc(shaperSpace.c_str());
-                        transform->setDst(targetSpace.c_str());
-                        cubeProc = config->getProcessor(transform,
-                            TRANSFORM_DIR_FORWARD);
-                    }
-                    else
-                    {
-                        cubeProc = config->getProcessor(shaperSpace.c_str(),
-                                                        targetSpace.c_str());
-                    }
-                }
-                else
-                {
-                    // No prelut, so cube goes from input-to-target
-                    cubeProc = inputToTargetProc;
-                }
-
-                ConstCPUProcessorRcPtr cpu = cubeProc->getDefaultCPUProcessor();
-                cpu->apply(cubeImg);
+                cubeData = BakeLut3D(cubeProc, cubeSize, LUT3DORDER_FAST_RED);
             }
 
 
@@ -786,12 +721,7 @@ OCIO_NAMESPACE_ENTER
             std::vector<float> onedData;
             if(required_lut == HDL_1D)
             {
-                onedData.resize(onedSize * 3);
-
-                GenerateIdentityLut1D(&onedData[0], onedSize, 3);
-                PackedImageDesc onedImg(&onedData[0], onedSize, 1, 3);
-                ConstCPUProcessorRcPtr cpu = inputToTargetProc->getDefaultCPUProcessor();
-                cpu->apply(onedImg);
+                onedData = BakeLut1D(inputToTargetProc, onedSize);
             }
 
 
@@ -1,14 +1,18 @@
 // SPDX-License-Identifier: BSD-3-Clause
 // Copyright Contributors to the OpenColorIO Project.
 
+#include <map>
+#include <sstream>
+
 #include <OpenColorIO/OpenColorIO.h>
 
+#include "HashUtils.h"
+#include "Mutex.h"
 #include "transforms/FileTransform.h"
 #include "pystring/pystring.h"
 #include "ops/Lut1D/Lut1DOp.h"
 #include "ops/Matrix/MatrixOps.h"
 #include "ops/Gamma/GammaOps.h"
-#include <sstream>
 
 #include "iccProfileReader.h"
 
@@ -32,6 +36,11 @@ OCIO_NAMESPACE_ENTER
         LocalCachedFile() = default;
         ~LocalCachedFile() = default;
 
+        size_t getMemorySize() const override
+        {
+            return sizeof(LocalCachedFile) + GetOpDataMemorySize(lut);
+        }
+
         // Matrix part
         double mMatrix44[16]{ 0.0 };
 
@@ -43,6 +52,84 @@ OCIO_NAMESPACE_ENTER
 
     typedef OCIO_SHARED_PTR<LocalCachedFile> LocalCachedFileRcPtr;
 
+    namespace
+    {
+        // The profiles are also cached by the content of their matrix/TRC tags (i.e. the
+        // only parts used) as many identical display profiles could be loaded under
+        // different file names. The entries only live while the file cache (or any
+        // other user) holds the profile.
+        typedef std::map<std::string, std::weak_ptr<LocalCachedFile>> ProfileCache;
+
+        ProfileCache g_profileCache;
+        Mutex g_profileCacheMutex;
+
+        // Tags larger than this are not hashed (i.e. the profile is not cached by content).
+        const icUInt32Number MAX_HASHED_TAG_SIZE = 4 * 1024 * 1024;
+
+        // Hash the raw bytes of the matrix/TRC tags, return an empty string on failure.
+        std::string GetProfileTagsHash(std::istream & istream,
+                                       const SampleICC::IccContent & icc)
+        {
+            static const icTagSignature tagSigs[] = {
+                icSigRedColorantTag, icSigGreenColorantTag, icSigBlueColorantTag,
+                icSigRedTRCTag,      icSigGreenTRCTag,      icSigBlueTRCTag
+            };
+
+            CacheIDHasher hasher;
+            std::vector<char> buffer;
+            for (const auto & sig : tagSigs)
+            {
+                const auto itTag = icc.FindTag(sig);
+                if (itTag == icc.mTags.end()
+                    || itTag->mTagInfo.size > MAX_HASHED_TAG_SIZE)
+                {
+                    return "";
+                }
+
+                buffer.resize(itTag->mTagInfo.size);
+                istream.seekg(itTag->mTagInfo.offset);
+                if (!istream.read(buffer.data(), std::streamsize(buffer.size())))
+                {
+                    istream.clear();
+                    return "";
+                }
+
+                hasher.update(&sig, sizeof(sig));
+                hasher.update(&itTag->mTagInfo.size, sizeof(itTag->mTagInfo.size));
+                hasher.update(buffer.data(), buffer.size());
+            }
+
+            return hasher.digest();
+        }
+
+        LocalCachedFileRcPtr GetCachedProfile(const std::string & hash)
+        {
+            AutoMutex lock(g_profileCacheMutex);
+            const auto it = g_profileCache.find(hash);
+            return it == g_profileCache.end() ? LocalCachedFileRcPtr() : it->second.lock();
+        }
+
+        void AddCachedProfile(const std::string & hash, const LocalCachedFileRcPtr & profile)
+        {
+            AutoMutex lock(g_profileCacheMutex);
+
+            // Remove the profiles not used anymore.
+            for (auto it = g_profileCache.begin(); it != g_profileCache.end(); )
+            {
+                if (it->second.expired())
+                {
+                    it = g_profileCache.erase(it);
+                }
+                else
+                {
+                    ++it;
+                }
+            }
+
+            g_profileCache[hash] = profile;
+        }
+    }
+
     class LocalFileFormat : public FileFormat
     {
     public:
@@ -51,6 +138,8 @@ OCIO_NAMESPACE_ENTER
 
         void getFormatInfo(FormatInfoVec & formatInfoVec) const override;
 
+        int probe(const std::string & header) const override;
+
         CachedFileRcPtr read(
             std::istream & istream,
             const std::string & fileName) const override;
@@ -103,6 +192,16 @@ OCIO_NAMESPACE_ENTER
 
     // Try and load the format
     // Raise an exception if it can't be loaded.
+    int LocalFileFormat::probe(const std::string & header) const
+    {
+        // The profile header holds the 'acsp' signature at the byte 36.
+        if (header.size() >= 40 && header.compare(36, 4, "acsp") == 0)
+        {
+            return FORMAT_PROBE_CERTAIN;
+        }
+        return FORMAT_PROBE_NO;
+    }
+
     CachedFileRcPtr LocalFileFormat::read(
         std::istream & istream,
         const std::string & fileName) const
@@ -182,6 +281,17 @@ OCIO_NAMESPACE_ENTER
             ThrowErrorMessage(error, fileName);
         }
 
+        // Reuse an identical profile already loaded.
+        const std::string tagsHash = GetProfileTagsHash(istream, icc);
+        if (!tagsHash.empty())
+        {
+            LocalCachedFileRcPtr cachedProfile = GetCachedProfile(tagsHash);
+            if (cachedProfile)
+            {
+                return cachedProfile;
+            }
+        }
+
         LocalCachedFileRcPtr cachedFile
             = LocalCachedFileRcPtr(new LocalCachedFile());
 
@@ -347,9 +457,18 @@ OCIO_NAMESPACE_ENTER
                 // Set the file bit-depth based on what is in the ICC profile
                 // (even though SampleICC has normalized the values).
                 cachedFile->lut->setFileOutputBitDepth(BIT_DEPTH_UINT16);
+
+                // Most display profiles have the same curve for all the channels so
+                // detect it once for all, instead of at each op finalization.
+                lutData.adjustColorComponentNumber();
             }
         }
 
+        if (!tagsHash.empty())
+        {
+            AddCachedProfile(tagsHash, cachedFile);
+        }
+
         return cachedFile;
     }
 
@@ -682,6 +801,34 @@ OCIO_ADD_TEST(FileFormatICC, test_file)
     }
 }
 
+OCIO_ADD_TEST(FileFormatICC, profile_cache)
+{
+    // The profiles with identical matrix/TRC tags share the cached file
+    // (i.e. whatever their file names are).
+    OCIO::LocalCachedFileRcPtr iccFile1;
+    OCIO_CHECK_NO_THROW(iccFile1 = LoadICCFile("icc-test-3.icm"));
+    OCIO_REQUIRE_ASSERT(iccFile1);
+    OCIO_REQUIRE_ASSERT(iccFile1->lut);
+
+    // The three curves are identical.
+    OCIO_CHECK_EQUAL(iccFile1->lut->getArray().getNumColorComponents(), 1);
+
+    OCIO::LocalCachedFileRcPtr iccFile2;
+    OCIO_CHECK_NO_THROW(iccFile2 = LoadICCFile("icc-test-3.icm"));
+    OCIO_CHECK_EQUAL(iccFile1.get(), iccFile2.get());
+
+    OCIO::LocalCachedFileRcPtr iccFile3;
+    OCIO_CHECK_NO_THROW(iccFile3 = LoadICCFile("icc-test-1.icc"));
+    OCIO_REQUIRE_ASSERT(iccFile3);
+    OCIO_CHECK_NE(iccFile1.get(), iccFile3.get());
+
+    // Once released, the profile is loaded again.
+    iccFile3.reset();
+    OCIO_CHECK_NO_THROW(iccFile3 = LoadICCFile("icc-test-1.icc"));
+    OCIO_REQUIRE_ASSERT(iccFile3);
+    OCIO_CHECK_EQUAL(iccFile3->mGammaRGB[0], 2.19921875f);
+}
+
 OCIO_ADD_TEST(FileFormatICC, test_apply)
 {
     OCIO::ContextRcPtr context = OCIO::Context::Create();
@@ -2,12 +2,14 @@
 // Copyright Contributors to the OpenColorIO Project.
 
 #include <algorithm>
+#include <array>
 #include <cstdio>
 #include <cstring>
 #include <iterator>
 
 #include <OpenColorIO/OpenColorIO.h>
 
+#include "BakingUtils.h"
 #include "ops/Lut1D/Lut1DOp.h"
 #include "ops/Lut3D/Lut3DOp.h"
 #include "ops/Matrix/MatrixOps.h"
@@ -73,6 +75,13 @@ OCIO_NAMESPACE_ENTER
             LocalCachedFile() = default;
             ~LocalCachedFile() = default;
 
+            size_t getMemorySize() const override
+            {
+                return sizeof(LocalCachedFile)
+                    + GetOpDataMemorySize(lut1D)
+                    + GetOpDataMemorySize(lut3D);
+            }
+
             Lut1DOpDataRcPtr lut1D;
             Lut3DOpDataRcPtr lut3D;
             float domain_min[3]{ 0.0f, 0.0f, 0.0f };
@@ -91,10 +100,20 @@ OCIO_NAMESPACE_ENTER
             ~LocalFileFormat() = default;
             
             void getFormatInfo(FormatInfoVec & formatInfoVec) const override;
+
+            int probe(const std::string & header) const override;
             
             CachedFileRcPtr read(
                 std::istream & istream,
                 const std::string & fileName) const override;
+
+            bool writeCachedFile(const CachedFile & cachedFile,
+                                 std::ostream & ostream) const override;
+            CachedFileRcPtr readCachedFile(std::istream & istream) const override;
+
+            bool readHeader(std::istream & istream,
+                            const std::string & fileName,
+                            FileHeader & header) const override;
             
             void bake(const Baker & baker,
                       const std::string & formatName,
@@ -142,6 +161,23 @@ OCIO_NAMESPACE_ENTER
             formatInfoVec.push_back(info);
         }
 
+        int LocalFileFormat::probe(const std::string & header) const
+        {
+            // The input range keywords are specific to the Resolve format.
+            if (HasProbeKeyword(header, "LUT_1D_INPUT_RANGE")
+                || HasProbeKeyword(header, "LUT_3D_INPUT_RANGE"))
+            {
+                return FORMAT_PROBE_NO;
+            }
+            if (HasProbeKeyword(header, "TITLE")
+                || HasProbeKeyword(header, "DOMAIN_MIN")
+                || HasProbeKeyword(header, "DOMAIN_MAX"))
+            {
+                return FORMAT_PROBE_LIKELY;
+            }
+            return FORMAT_PROBE_UNKNOWN;
+        }
+
         CachedFileRcPtr
         LocalFileFormat::read(
             std::istream & istream,
@@ -177,6 +213,23 @@ OCIO_NAMESPACE_ENTER
                     // All lines starting with '#' are comments
                     if(pystring::startswith(line,"#")) continue;
 
+                    // The color triples (i.e. most of the lines) are parsed
+                    // without splitting the line.
+                    if(StringToFloats(line.c_str(), tmpfloats) && !tmpfloats.empty())
+                    {
+                        if(tmpfloats.size() != 3)
+                        {
+                            ThrowErrorMessage(
+                                "Malformed color triples specified.",
+                                fileName,
+                                lineNumber,
+                                line);
+                        }
+
+                        raw.insert(raw.end(), tmpfloats.begin(), tmpfloats.end());
+                        continue;
+                    }
+
                     // Strip, lowercase, and split the line
                     pystring::split(pystring::lower(pystring::strip(line)), parts);
                     if(parts.empty()) continue;
@@ -342,6 +395,95 @@ OCIO_NAMESPACE_ENTER
 
             return cachedFile;
         }
+
+        bool LocalFileFormat::readHeader(std::istream & istream,
+                                         const std::string & fileName,
+                                         FileHeader & header) const
+        {
+            int size3d = 0;
+            int size1d = 0;
+
+            bool in1d = false;
+            bool in3d = false;
+
+            std::string line;
+            StringVec parts;
+            std::vector<float> tmpfloats;
+            int lineNumber = 0;
+
+            // Only read the tags i.e. stop at the first color triple.
+            while(nextline(istream, line))
+            {
+                ++lineNumber;
+                // All lines starting with '#' are comments
+                if(pystring::startswith(line,"#")) continue;
+
+                if(StringToFloats(line.c_str(), tmpfloats) && !tmpfloats.empty()) break;
+
+                // Strip, lowercase, and split the line
+                pystring::split(pystring::lower(pystring::strip(line)), parts);
+                if(parts.empty()) continue;
+
+                if(parts[0] == "lut_1d_size")
+                {
+                    if(parts.size() != 2
+                        || !StringToInt( &size1d, parts[1].c_str()))
+                    {
+                        ThrowErrorMessage(
+                            "Malformed LUT_1D_SIZE tag.",
+                            fileName,
+                            lineNumber,
+                            line);
+                    }
+                    in1d = true;
+                }
+                else if(parts[0] == "lut_2d_size")
+                {
+                    ThrowErrorMessage(
+                        "Unsupported tag: 'LUT_2D_SIZE'.",
+                        fileName,
+                        lineNumber,
+                        line);
+                }
+                else if(parts[0] == "lut_3d_size")
+                {
+                    if(parts.size() != 2
+                        || !StringToInt( &size3d, parts[1].c_str()))
+                    {
+                        ThrowErrorMessage(
+                            "Malformed LUT_3D_SIZE tag.",
+                            fileName,
+                            lineNumber,
+                            line);
+                    }
+                    in3d = true;
+                }
+                else if(parts[0] != "title"
+                        && parts[0] != "domain_min"
+                        && parts[0] != "domain_max")
+                {
+                    break;
+                }
+            }
+
+            // Like read(), the 1D LUT prevails.
+            if(in1d)
+            {
+                header.lut1DSize = static_cast<unsigned long>(size1d);
+            }
+            else if(in3d)
+            {
+                header.lut3DSize = static_cast<unsigned long>(size3d);
+            }
+            else
+            {
+                ThrowErrorMessage(
+                    "LUT type (1D/3D) unspecified.",
+                    fileName, -1, "");
+            }
+
+            return true;
+        }
         
         void LocalFileFormat::bake(const Baker & baker,
                                    const std::string & formatName,
@@ -358,34 +500,14 @@ OCIO_NAMESPACE_ENTER
                 throw Exception(os.str().c_str());
             }
 
-            ConstConfigRcPtr config = baker.getConfig();
-
             int cubeSize = baker.getCubeSize();
             if(cubeSize==-1) cubeSize = DEFAULT_CUBE_SIZE;
+            SelectCubeSize(baker, cubeSize);
             cubeSize = std::max(2, cubeSize); // smallest cube is 2x2x2
 
-            std::vector<float> cubeData;
-            cubeData.resize(cubeSize*cubeSize*cubeSize*3);
-            GenerateIdentityLut3D(&cubeData[0], cubeSize, 3, LUT3DORDER_FAST_RED);
-            PackedImageDesc cubeImg(&cubeData[0], cubeSize*cubeSize*cubeSize, 1, 3);
-
             // Apply our conversion from the input space to the output space.
-            ConstProcessorRcPtr inputToTarget;
-            std::string looks = baker.getLooks();
-            if(!looks.empty())
-            {
-                LookTransformRcPtr transform = LookTransform::Create();
-                transform->setLooks(looks.c_str());
-                transform->setSrc(baker.getInputSpace());
-                transform->setDst(baker.getTargetSpace());
-                inputToTarget = config->getProcessor(transform, TRANSFORM_DIR_FORWARD);
-            }
-            else
-            {
-                inputToTarget = config->getProcessor(baker.getInputSpace(), baker.getTargetSpace());
-            }
-            ConstCPUProcessorRcPtr cpu = inputToTarget->getDefaultCPUProcessor();
-            cpu->apply(cubeImg);
+            const std::vector<float> cubeData
+                = BakeLut3D(GetInputToTargetProcessor(baker), cubeSize, LUT3DORDER_FAST_RED);
 
             if(baker.getMetadata() != NULL)
             {
@@ -410,14 +532,43 @@ OCIO_NAMESPACE_ENTER
             // Set to a fixed 6 decimal precision
             ostream.setf(std::ios::fixed, std::ios::floatfield);
             ostream.precision(6);
+            NumberWriter writer(ostream);
             for(int i=0; i<cubeSize*cubeSize*cubeSize; ++i)
             {
-                ostream << cubeData[3*i+0] << " "
-                        << cubeData[3*i+1] << " "
-                        << cubeData[3*i+2] << "\n";
+                writer.writeFixed(cubeData[3*i+0], 6);
+                writer.writeChar(' ');
+                writer.writeFixed(cubeData[3*i+1], 6);
+                writer.writeChar(' ');
+                writer.writeFixed(cubeData[3*i+2], 6);
+                writer.writeChar('\n');
             }
         }
 
+        bool LocalFileFormat::writeCachedFile(const CachedFile & cachedFile,
+                                              std::ostream & ostream) const
+        {
+            const LocalCachedFile & file = dynamic_cast<const LocalCachedFile &>(cachedFile);
+
+            WriteCachedLut1D(ostream, file.lut1D);
+            WriteCachedLut3D(ostream, file.lut3D);
+            WriteCachedValue(ostream, file.domain_min);
+            WriteCachedValue(ostream, file.domain_max);
+            return true;
+        }
+
+        CachedFileRcPtr LocalFileFormat::readCachedFile(std::istream & istream) const
+        {
+            LocalCachedFileRcPtr cachedFile = LocalCachedFileRcPtr(new LocalCachedFile());
+
+            cachedFile->lut1D = ReadCachedLut1D(istream);
+            cachedFile->lut3D = ReadCachedLut3D(istream);
+            const auto domain_min = ReadCachedValue<std::array<float, 3>>(istream);
+            const auto domain_max = ReadCachedValue<std::array<float, 3>>(istream);
+            std::copy(domain_min.begin(), domain_min.end(), cachedFile->domain_min);
+            std::copy(domain_max.begin(), domain_max.end(), cachedFile->domain_max);
+            return cachedFile;
+        }
+
         void
         LocalFileFormat::buildFileOps(OpRcPtrVec & ops,
                                       const Config & /*config*/,
@@ -8,6 +8,7 @@
 
 #include <OpenColorIO/OpenColorIO.h>
 
+#include "BakingUtils.h"
 #include "ops/Lut1D/Lut1DOp.h"
 #include "ops/Lut3D/Lut3DOp.h"
 #include "ParseUtils.h"
@@ -50,6 +51,11 @@ OCIO_NAMESPACE_ENTER
             LocalCachedFile() = default;
             ~LocalCachedFile() = default;
 
+            size_t getMemorySize() const override
+            {
+                return sizeof(LocalCachedFile) + GetOpDataMemorySize(lut3D);
+            }
+
             Lut3DOpDataRcPtr lut3D;
         };
 
@@ -236,36 +242,14 @@ OCIO_NAMESPACE_ENTER
                 throw Exception(os.str().c_str());
             }
 
-            ConstConfigRcPtr config = baker.getConfig();
-
             int cubeSize = baker.getCubeSize();
             if(cubeSize==-1) cubeSize = DEFAULT_CUBE_SIZE;
+            SelectCubeSize(baker, cubeSize);
             cubeSize = std::max(2, cubeSize); // smallest cube is 2x2x2
 
-            std::vector<float> cubeData;
-            cubeData.resize(cubeSize*cubeSize*cubeSize*3);
-            GenerateIdentityLut3D(&cubeData[0], cubeSize, 3, LUT3DORDER_FAST_RED);
-            PackedImageDesc cubeImg(&cubeData[0], cubeSize*cubeSize*cubeSize, 1, 3);
-
             // Apply our conversion from the input space to the output space.
-            ConstProcessorRcPtr inputToTarget;
-            std::string looks = baker.getLooks();
-            if (!looks.empty())
-            {
-                LookTransformRcPtr transform = LookTransform::Create();
-                transform->setLooks(looks.c_str());
-                transform->setSrc(baker.getInputSpace());
-                transform->setDst(baker.getTargetSpace());
-                inputToTarget = config->getProcessor(transform,
-                    TRANSFORM_DIR_FORWARD);
-            }
-            else
-            {
-                inputToTarget = config->getProcessor(baker.getInputSpace(),
-                    baker.getTargetSpace());
-            }
-            ConstCPUProcessorRcPtr cpu = inputToTarget->getDefaultCPUProcessor();
-            cpu->apply(cubeImg);
+            const std::vector<float> cubeData
+                = BakeLut3D(GetInputToTargetProcessor(baker), cubeSize, LUT3DORDER_FAST_RED);
 
             // Write out the file.
             // For for maximum compatibility with other apps, we will
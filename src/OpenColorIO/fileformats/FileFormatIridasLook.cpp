@@ -13,6 +13,7 @@
 #include "ParseUtils.h"
 #include "Platform.h"
 #include "pystring/pystring.h"
+#include "SSE.h"
 #include "transforms/FileTransform.h"
 
 /*
@@ -124,6 +125,78 @@ OCIO_NAMESPACE_ENTER
 #endif
             return true;
         }
+
+#if defined(USE_SSE) && OCIO_LITTLE_ENDIAN
+        // Convert 16 hex ascii to 8 bytes (in the low half of the result),
+        // return false if any character is not an hex digit.
+        inline bool hexasciitobytes_sse(__m128i & bytes, const char * ascii)
+        {
+            const __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i *>(ascii));
+
+            // [0-9]
+            const __m128i digit = _mm_sub_epi8(c, _mm_set1_epi8('0'));
+            const __m128i isDigit
+                = _mm_cmpeq_epi8(_mm_min_epu8(digit, _mm_set1_epi8(9)), digit);
+
+            // [A-F] & [a-f]
+            const __m128i alpha
+                = _mm_sub_epi8(_mm_or_si128(c, _mm_set1_epi8(0x20)), _mm_set1_epi8('a'));
+            const __m128i isAlpha
+                = _mm_cmpeq_epi8(_mm_min_epu8(alpha, _mm_set1_epi8(5)), alpha);
+
+            if (_mm_movemask_epi8(_mm_or_si128(isDigit, isAlpha)) != 0xFFFF)
+            {
+                return false;
+            }
+
+            const __m128i nums
+                = _mm_or_si128(_mm_and_si128(isDigit, digit),
+                               _mm_and_si128(isAlpha,
+                                             _mm_add_epi8(alpha, _mm_set1_epi8(10))));
+
+            // Each 16-bit lane holds the high then the low nibble of a byte.
+            const __m128i high = _mm_slli_epi16(_mm_and_si128(nums, _mm_set1_epi16(0x00FF)), 4);
+            const __m128i low  = _mm_srli_epi16(nums, 8);
+
+            bytes = _mm_or_si128(high, low);
+            return true;
+        }
+#endif
+
+        // convert an array of 8*numValues hex ascii to f32, decoding all the
+        // values at once.
+        // return the index of the first ascii of the value holding non-hex
+        // characters on failure, or -1 on success.
+        long hexasciitofloats(float * fvals, const char * ascii, size_t numValues)
+        {
+            size_t i = 0;
+
+#if defined(USE_SSE) && OCIO_LITTLE_ENDIAN
+            for (; i + 4 <= numValues; i += 4)
+            {
+                __m128i bytes0, bytes1;
+                if (!hexasciitobytes_sse(bytes0, &ascii[8 * i])
+                    || !hexasciitobytes_sse(bytes1, &ascii[8 * i + 16]))
+                {
+                    // Let the scalar version find the faulty character.
+                    break;
+                }
+
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(&fvals[i]),
+                                 _mm_packus_epi16(bytes0, bytes1));
+            }
+#endif
+
+            for (; i < numValues; ++i)
+            {
+                if (!hexasciitofloat(fvals[i], &ascii[8 * i]))
+                {
+                    return static_cast<long>(8 * i);
+                }
+            }
+
+            return -1;
+        }
     }
 
     namespace
@@ -203,22 +276,20 @@ OCIO_NAMESPACE_ENTER
 
                 lutSize = m_lutSize;
                 int expactedVectorSize = 3 * (lutSize*lutSize*lutSize);
-                lut.reserve(expactedVectorSize);
 
-                const char * ascii = m_lutString.c_str();
-                float fval = 0.0f;
-                for (unsigned int i = 0; i<m_lutString.size() / 8; ++i)
+                // Decode the whole 'data' block at once.
+                lut.resize(m_lutString.size() / 8);
+
+                const long badIndex
+                    = hexasciitofloats(lut.data(), m_lutString.c_str(), lut.size());
+                if (badIndex >= 0)
                 {
-                    if (!hexasciitofloat(fval, &ascii[8 * i]))
-                    {
-                        std::ostringstream os;
-                        os << "Error parsing Iridas Look file (";
-                        os << m_fileName.c_str() << "). ";
-                        os << "Non-hex characters found in 'data' block ";
-                        os << "at index '" << (8 * i) << "'.";
-                        throw Exception(os.str().c_str());
-                    }
-                    lut.push_back(fval);
+                    std::ostringstream os;
+                    os << "Error parsing Iridas Look file (";
+                    os << m_fileName.c_str() << "). ";
+                    os << "Non-hex characters found in 'data' block ";
+                    os << "at index '" << badIndex << "'.";
+                    throw Exception(os.str().c_str());
                 }
 
                 if (expactedVectorSize != static_cast<int>(lut.size()))
@@ -433,16 +504,19 @@ OCIO_NAMESPACE_ENTER
                 }
                 else if (pImpl->m_data)
                 {
-                    // TODO: Possible parsing improvement: string copies
-                    //       could be avoided.
-                    // Remove spaces, quotes and newlines
-                    std::string what(s, len);
-                    what = pystring::replace(what, " ", "");
-                    what = pystring::replace(what, "\"", "");
-                    what = pystring::replace(what, "'", "");
-                    what = pystring::replace(what, "\n", "");
-                    // Append to lut string
-                    pImpl->m_lutString += what;
+                    // Remove spaces, quotes and newlines while appending
+                    // to lut string (i.e. in a single pass without copies).
+                    const XML_Char * end = s + len;
+                    const XML_Char * start = s;
+                    for (const XML_Char * c = s; c != end; ++c)
+                    {
+                        if (*c == ' ' || *c == '"' || *c == '\'' || *c == '\n')
+                        {
+                            pImpl->m_lutString.append(start, c);
+                            start = c + 1;
+                        }
+                    }
+                    pImpl->m_lutString.append(start, end);
                 }
             }
 
@@ -479,6 +553,11 @@ OCIO_NAMESPACE_ENTER
             LocalCachedFile () = default;
             ~LocalCachedFile()  = default;
 
+            size_t getMemorySize() const override
+            {
+                return sizeof(LocalCachedFile) + GetOpDataMemorySize(lut3D);
+            }
+
             Lut3DOpDataRcPtr lut3D;
         };
 
@@ -492,6 +571,8 @@ OCIO_NAMESPACE_ENTER
 
             void getFormatInfo(FormatInfoVec & formatInfoVec) const override;
 
+            int probe(const std::string & header) const override;
+
             CachedFileRcPtr read(
                 std::istream & istream,
                 const std::string & fileName) const override;
@@ -513,6 +594,16 @@ OCIO_NAMESPACE_ENTER
             formatInfoVec.push_back(info);
         }
 
+        int LocalFileFormat::probe(const std::string & header) const
+        {
+            if (!IsProbeXML(header))
+            {
+                return FORMAT_PROBE_NO;
+            }
+            return header.find("<look") != std::string::npos ? FORMAT_PROBE_LIKELY
+                                                             : FORMAT_PROBE_UNKNOWN;
+        }
+
         CachedFileRcPtr LocalFileFormat::read(
             std::istream & istream,
             const std::string & fileName) const
@@ -688,6 +779,42 @@ OCIO_ADD_TEST(FileFormatIridasLook, hexasciitofloat)
     }
 }
 
+OCIO_ADD_TEST(FileFormatIridasLook, hexasciitofloats)
+{
+    // Enough values to exercise both the vectorized and the scalar decoding.
+    const std::string values("0000003F0000803FAD10753F00000000"
+                             "0000803Fad10753f0000003F000080BF"
+                             "0000003F0000803FAD10753F");
+    const float expected[11] = { 0.5f, 1.0f, 0.9572857022285461f, 0.0f,
+                                 1.0f, 0.9572857022285461f, 0.5f, -1.0f,
+                                 0.5f, 1.0f, 0.9572857022285461f };
+
+    {
+    float fvals[11];
+    const long badIndex = OCIO::hexasciitofloats(fvals, values.c_str(), 11);
+    OCIO_CHECK_EQUAL(badIndex, -1);
+    for (unsigned i = 0; i < 11; ++i)
+    {
+        OCIO_CHECK_EQUAL(fvals[i], expected[i]);
+    }
+    }
+
+    // The index of the faulty value is reported wherever the bad character is.
+    const char badChars[] = { 'x', 'G', 'g', '/', ':', '@', '`', ' ', '\x10' };
+    for (size_t pos = 0; pos < values.size(); pos += 7)
+    {
+        for (char c : badChars)
+        {
+            std::string bad(values);
+            bad[pos] = c;
+
+            float fvals[11];
+            const long badIndex = OCIO::hexasciitofloats(fvals, bad.c_str(), 11);
+            OCIO_CHECK_EQUAL(badIndex, static_cast<long>(pos - pos % 8));
+        }
+    }
+}
+
 
 OCIO_ADD_TEST(FileFormatIridasLook, simple3d)
 {
@@ -24,6 +24,11 @@ OCIO_NAMESPACE_ENTER
             LocalCachedFile () = default;
             ~LocalCachedFile() = default;
 
+            size_t getMemorySize() const override
+            {
+                return sizeof(LocalCachedFile) + GetOpDataMemorySize(lut3D);
+            }
+
             Lut3DOpDataRcPtr lut3D;
         };
 
@@ -8,6 +8,7 @@
 
 #include <OpenColorIO/OpenColorIO.h>
 
+#include "BakingUtils.h"
 #include "ops/Lut1D/Lut1DOp.h"
 #include "ops/Lut3D/Lut3DOp.h"
 #include "ops/Matrix/MatrixOps.h"
@@ -179,6 +180,13 @@ OCIO_NAMESPACE_ENTER
             LocalCachedFile() = default;
             ~LocalCachedFile() = default;
 
+            size_t getMemorySize() const override
+            {
+                return sizeof(LocalCachedFile)
+                    + GetOpDataMemorySize(lut1D)
+                    + GetOpDataMemorySize(lut3D);
+            }
+
             Lut1DOpDataRcPtr lut1D;
             float range1d_min = 0.0f;
             float range1d_max = 1.0f;
@@ -200,10 +208,20 @@ OCIO_NAMESPACE_ENTER
             ~LocalFileFormat() = default;
             
             void getFormatInfo(FormatInfoVec & formatInfoVec) const override;
+
+            int probe(const std::string & header) const override;
             
             CachedFileRcPtr read(
                 std::istream & istream,
                 const std::string & fileName) const override;
+
+            bool writeCachedFile(const CachedFile & cachedFile,
+                                 std::ostream & ostream) const override;
+            CachedFileRcPtr readCachedFile(std::istream & istream) const override;
+
+            bool readHeader(std::istream & istream,
+                            const std::string & fileName,
+                            FileHeader & header) const override;
             
             void bake(const Baker & baker,
                       const std::string & formatName,
@@ -250,6 +268,23 @@ OCIO_NAMESPACE_ENTER
             formatInfoVec.push_back(info);
         }
         
+        int LocalFileFormat::probe(const std::string & header) const
+        {
+            // The title and domain keywords are specific to the Iridas format.
+            if (HasProbeKeyword(header, "TITLE")
+                || HasProbeKeyword(header, "DOMAIN_MIN")
+                || HasProbeKeyword(header, "DOMAIN_MAX"))
+            {
+                return FORMAT_PROBE_NO;
+            }
+            if (HasProbeKeyword(header, "LUT_1D_INPUT_RANGE")
+                || HasProbeKeyword(header, "LUT_3D_INPUT_RANGE"))
+            {
+                return FORMAT_PROBE_LIKELY;
+            }
+            return FORMAT_PROBE_UNKNOWN;
+        }
+
         CachedFileRcPtr LocalFileFormat::read(
             std::istream & istream,
             const std::string & fileName) const
@@ -480,6 +515,93 @@ OCIO_NAMESPACE_ENTER
             return cachedFile;
         }
         
+        bool LocalFileFormat::readHeader(std::istream & istream,
+                                         const std::string & fileName,
+                                         FileHeader & header) const
+        {
+            int size3d = 0;
+            int size1d = 0;
+
+            bool has1d = false;
+            bool has3d = false;
+
+            std::string line;
+            StringVec parts;
+            int lineNumber = 0;
+
+            // Only read the tags i.e. stop at the first color triple.
+            while(nextline(istream, line))
+            {
+                ++lineNumber;
+                // All lines starting with '#' are comments
+                if(pystring::startswith(line,"#")) continue;
+
+                // Strip, lowercase, and split the line
+                pystring::split(pystring::lower(pystring::strip(line)), parts);
+                if(parts.empty()) continue;
+
+                if(parts[0] == "title")
+                {
+                    ThrowErrorMessage(
+                        "Unsupported tag: 'TITLE'.",
+                        fileName,
+                        lineNumber,
+                        line);
+                }
+                else if(parts[0] == "lut_1d_size")
+                {
+                    if(parts.size() != 2
+                        || !StringToInt( &size1d, parts[1].c_str()))
+                    {
+                        ThrowErrorMessage(
+                            "Malformed LUT_1D_SIZE tag.",
+                            fileName,
+                            lineNumber,
+                            line);
+                    }
+                    has1d = true;
+                }
+                else if(parts[0] == "lut_2d_size")
+                {
+                    ThrowErrorMessage(
+                        "Unsupported tag: 'LUT_2D_SIZE'.",
+                        fileName,
+                        lineNumber,
+                        line);
+                }
+                else if(parts[0] == "lut_3d_size")
+                {
+                    if(parts.size() != 2
+                        || !StringToInt( &size3d, parts[1].c_str()))
+                    {
+                        ThrowErrorMessage(
+                            "Malformed LUT_3D_SIZE tag.",
+                            fileName,
+                            lineNumber,
+                            line);
+                    }
+                    has3d = true;
+                }
+                else if(parts[0] != "lut_1d_input_range"
+                        && parts[0] != "lut_3d_input_range")
+                {
+                    break;
+                }
+            }
+
+            if(!has1d && !has3d)
+            {
+                ThrowErrorMessage(
+                    "Lut type (1D/3D) unspecified.",
+                    fileName, -1, "");
+            }
+
+            header.lut1DSize = has1d ? static_cast<unsigned long>(size1d) : 0;
+            header.lut3DSize = has3d ? static_cast<unsigned long>(size3d) : 0;
+
+            return true;
+        }
+
         void LocalFileFormat::bake(const Baker & baker,
                                    const std::string & formatName,
                                    std::ostream & ostream) const
@@ -498,11 +620,9 @@ OCIO_NAMESPACE_ENTER
             }
 
             //
-            // Initialize config and data
+            // Initialize data
             //
 
-            ConstConfigRcPtr config = baker.getConfig();
-
             int onedSize = baker.getCubeSize();
             if(onedSize==-1) onedSize = DEFAULT_1D_SIZE;
             if(onedSize<2)
@@ -526,12 +646,6 @@ OCIO_NAMESPACE_ENTER
                 throw Exception(os.str().c_str());
             }
 
-            // Get spaces from baker
-            const std::string shaperSpace = baker.getShaperSpace();
-            const std::string inputSpace = baker.getInputSpace();
-            const std::string targetSpace = baker.getTargetSpace();
-            const std::string looks = baker.getLooks();
-
             //
             // Determine required LUT type
             //
@@ -540,28 +654,13 @@ OCIO_NAMESPACE_ENTER
             const int CUBE_3D = 2; // 3D LUT version number
             const int CUBE_1D_3D = 3; // 3D LUT with 1D prelut
 
-            ConstProcessorRcPtr inputToTargetProc;
-            if (!looks.empty())
-            {
-                LookTransformRcPtr transform = LookTransform::Create();
-                transform->setLooks(looks.c_str());
-                transform->setSrc(inputSpace.c_str());
-                transform->setDst(targetSpace.c_str());
-                inputToTargetProc = config->getProcessor(transform,
-                    TRANSFORM_DIR_FORWARD);
-            }
-            else
-            {
-                inputToTargetProc = config->getProcessor(
-                    inputSpace.c_str(),
-                    targetSpace.c_str());
-            }
+            ConstProcessorRcPtr inputToTargetProc = GetInputToTargetProcessor(baker);
 
             int required_lut = -1;
 
             if(inputToTargetProc->hasChannelCrosstalk())
             {
-                if(shaperSpace.empty())
+                if(!HasShaper(baker))
                 {
                     // Has crosstalk, but no shaper, so need 3D LUT
                     required_lut = CUBE_3D;
@@ -585,6 +684,20 @@ OCIO_NAMESPACE_ENTER
                     "Internal logic error, LUT type was not determined");
             }
 
+            // Select the sizes within the tolerance of the baker, if any.
+            if(required_lut == CUBE_1D)
+            {
+                SelectLut1DSize(baker, onedSize);
+            }
+            else if(required_lut == CUBE_3D)
+            {
+                SelectCubeSize(baker, cubeSize);
+            }
+            else
+            {
+                SelectShaperAndCubeSizes(baker, shaperSize, cubeSize);
+            }
+
             //
             // Generate Shaper
             //
@@ -599,9 +712,7 @@ OCIO_NAMESPACE_ENTER
                 // TODO: Later we only grab the green channel for the prelut,
                 // should ensure the prelut is monochromatic somehow?
                 
-                ConstProcessorRcPtr inputToShaperProc = config->getProcessor(
-                    inputSpace.c_str(),
-                    shaperSpace.c_str());
+                ConstProcessorRcPtr inputToShaperProc = GetInputToShaperProcessor(baker);
 
                 if(inputToShaperProc->hasChannelCrosstalk())
                 {
@@ -616,43 +727,10 @@ OCIO_NAMESPACE_ENTER
                 }
 
                 // Calculate min/max value
-                {
-                    // Get input value of 1.0 in shaper space, as this
-                    // is the higest value that is transformed by the
-                    // cube (e.g for a generic lin-to-log transform,
-                    // what the log value 1.0 is in linear).
-                    ConstCPUProcessorRcPtr shaperToInputProc = config->getProcessor(
-                        shaperSpace.c_str(),
-                        inputSpace.c_str())->getDefaultCPUProcessor();
-
-                    float minval[3] = {0.0f, 0.0f, 0.0f};
-                    float maxval[3] = {1.0f, 1.0f, 1.0f};
-
-                    shaperToInputProc->applyRGB(minval);
-                    shaperToInputProc->applyRGB(maxval);
-                    
-                    // Grab green channel, as this is the one used later
-                    fromInStart = minval[1];
-                    fromInEnd = maxval[1];
-                }
+                GetShaperRange(baker, fromInStart, fromInEnd);
 
-                // Generate the identity shaper values, then apply the transform.
                 // Shaper is linearly sampled from fromInStart to fromInEnd
-                shaperData.resize(shaperSize*3);
-
-                for (int i = 0; i < shaperSize; ++i)
-                {
-                    const float x = (float)(double(i) / double(shaperSize - 1));
-                    float cur_value = lerpf(fromInStart, fromInEnd, x);
-
-                    shaperData[3*i+0] = cur_value;
-                    shaperData[3*i+1] = cur_value;
-                    shaperData[3*i+2] = cur_value;
-                }
-
-                PackedImageDesc shaperImg(&shaperData[0], shaperSize, 1, 3);
-                ConstCPUProcessorRcPtr cpu = inputToShaperProc->getDefaultCPUProcessor();
-                cpu->apply(shaperImg);
+                shaperData = BakeLut1D(inputToShaperProc, shaperSize, fromInStart, fromInEnd);
             }
 
             //
@@ -662,37 +740,12 @@ OCIO_NAMESPACE_ENTER
             std::vector<float> cubeData;
             if(required_lut == CUBE_3D || required_lut == CUBE_1D_3D)
             {
-                cubeData.resize(cubeSize*cubeSize*cubeSize*3);
-                GenerateIdentityLut3D(&cubeData[0], cubeSize, 3, LUT3DORDER_FAST_RED);
-                PackedImageDesc cubeImg(&cubeData[0], cubeSize*cubeSize*cubeSize, 1, 3);
+                // With a shaper, it goes from input-to-shaper so the cube goes from
+                // shaper-to-target, otherwise the cube goes from input-to-target.
+                ConstProcessorRcPtr cubeProc = required_lut == CUBE_1D_3D
+                    ? GetShaperToTargetProcessor(baker) : inputToTargetProc;
 
-                ConstProcessorRcPtr cubeProc;
-                if(required_lut == CUBE_1D_3D)
-                {
-                    // Shaper goes from input-to-shaper, so cube goes from shaper-to-target
-                    if (!looks.empty())
-                    {
-                        LookTransformRcPtr transform = LookTransform::Create();
-                        transform->setLooks(looks.c_str());
-                        transform->setSrc(shaperSpace.c_str());
-                        transform->setDst(targetSpace.c_str());
-                        cubeProc = config->getProcessor(transform,
-                            TRANSFORM_DIR_FORWARD);
-                    }
-                    else
-                    {
-                        cubeProc = config->getProcessor(shaperSpace.c_str(),
-                                                        targetSpace.c_str());
-                    }
-                }
-                else
-                {
-                    // No shaper, so cube goes from input-to-target
-                    cubeProc = inputToTargetProc;
-                }
-
-                ConstCPUProcessorRcPtr cpu = cubeProc->getDefaultCPUProcessor();
-                cpu->apply(cubeImg);
+                cubeData = BakeLut3D(cubeProc, cubeSize, LUT3DORDER_FAST_RED);
             }
 
             //
@@ -702,12 +755,7 @@ OCIO_NAMESPACE_ENTER
             std::vector<float> onedData;
             if(required_lut == CUBE_1D)
             {
-                onedData.resize(onedSize * 3);
-                GenerateIdentityLut1D(&onedData[0], onedSize, 3);
-                PackedImageDesc onedImg(&onedData[0], onedSize, 1, 3);
-                
-                ConstCPUProcessorRcPtr cpu = inputToTargetProc->getDefaultCPUProcessor();
-                cpu->apply(onedImg);
+                onedData = BakeLut1D(inputToTargetProc, onedSize);
             }
 
             //
@@ -755,38 +803,64 @@ OCIO_NAMESPACE_ENTER
                 //ostream << "LUT_3D_INPUT_RANGE 0.0 1.0\n";
             }
 
-            // Write 1D data
-            if(required_lut == CUBE_1D)
+            NumberWriter writer(ostream);
+            const auto writeTriples = [&writer](const std::vector<float> & data, int numTriples)
             {
-                for(int i=0; i<onedSize; ++i)
+                for(int i=0; i<numTriples; ++i)
                 {
-                    ostream << onedData[3*i+0] << " "
-                            << onedData[3*i+1] << " "
-                            << onedData[3*i+2] << "\n";
+                    writer.writeFixed(data[3*i+0], 6);
+                    writer.writeChar(' ');
+                    writer.writeFixed(data[3*i+1], 6);
+                    writer.writeChar(' ');
+                    writer.writeFixed(data[3*i+2], 6);
+                    writer.writeChar('\n');
                 }
+            };
+
+            // Write 1D data
+            if(required_lut == CUBE_1D)
+            {
+                writeTriples(onedData, onedSize);
             }
             else if(required_lut == CUBE_1D_3D)
             {
-                for(int i=0; i<shaperSize; ++i)
-                {
-                    ostream << shaperData[3*i+0] << " "
-                            << shaperData[3*i+1] << " "
-                            << shaperData[3*i+2] << "\n";
-                }
+                writeTriples(shaperData, shaperSize);
             }
 
             // Write 3D data
             if(required_lut == CUBE_3D || required_lut == CUBE_1D_3D)
             {
-                for(int i=0; i<cubeSize*cubeSize*cubeSize; ++i)
-                {
-                    ostream << cubeData[3*i+0] << " "
-                            << cubeData[3*i+1] << " "
-                            << cubeData[3*i+2] << "\n";
-                }
+                writeTriples(cubeData, cubeSize*cubeSize*cubeSize);
             }
         }
 
+        bool LocalFileFormat::writeCachedFile(const CachedFile & cachedFile,
+                                              std::ostream & ostream) const
+        {
+            const LocalCachedFile & file = dynamic_cast<const LocalCachedFile &>(cachedFile);
+
+            WriteCachedLut1D(ostream, file.lut1D);
+            WriteCachedValue(ostream, file.range1d_min);
+            WriteCachedValue(ostream, file.range1d_max);
+            WriteCachedLut3D(ostream, file.lut3D);
+            WriteCachedValue(ostream, file.range3d_min);
+            WriteCachedValue(ostream, file.range3d_max);
+            return true;
+        }
+
+        CachedFileRcPtr LocalFileFormat::readCachedFile(std::istream & istream) const
+        {
+            LocalCachedFileRcPtr cachedFile = LocalCachedFileRcPtr(new LocalCachedFile());
+
+            cachedFile->lut1D = ReadCachedLut1D(istream);
+            cachedFile->range1d_min = ReadCachedValue<float>(istream);
+            cachedFile->range1d_max = ReadCachedValue<float>(istream);
+            cachedFile->lut3D = ReadCachedLut3D(istream);
+            cachedFile->range3d_min = ReadCachedValue<float>(istream);
+            cachedFile->range3d_max = ReadCachedValue<float>(istream);
+            return cachedFile;
+        }
+
         void
         LocalFileFormat::buildFileOps(OpRcPtrVec & ops,
                                       const Config & /*config*/,
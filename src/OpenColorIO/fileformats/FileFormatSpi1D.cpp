@@ -38,6 +38,11 @@ OCIO_NAMESPACE_ENTER
         public:
             LocalCachedFile() = default;
             ~LocalCachedFile() = default;
+
+            size_t getMemorySize() const override
+            {
+                return sizeof(LocalCachedFile) + GetOpDataMemorySize(lut);
+            }
             
             Lut1DOpDataRcPtr lut;
             float from_min = 0.0f;
@@ -59,6 +64,10 @@ OCIO_NAMESPACE_ENTER
                 std::istream & istream,
                 const std::string & fileName) const override;
 
+            bool writeCachedFile(const CachedFile & cachedFile,
+                                 std::ostream & ostream) const override;
+            CachedFileRcPtr readCachedFile(std::istream & istream) const override;
+
             void buildFileOps(OpRcPtrVec & ops,
                               const Config & config,
                               const ConstContextRcPtr & context,
@@ -258,6 +267,27 @@ OCIO_NAMESPACE_ENTER
             return cachedFile;
         }
 
+        bool LocalFileFormat::writeCachedFile(const CachedFile & cachedFile,
+                                              std::ostream & ostream) const
+        {
+            const LocalCachedFile & file = dynamic_cast<const LocalCachedFile &>(cachedFile);
+
+            WriteCachedLut1D(ostream, file.lut);
+            WriteCachedValue(ostream, file.from_min);
+            WriteCachedValue(ostream, file.from_max);
+            return true;
+        }
+
+        CachedFileRcPtr LocalFileFormat::readCachedFile(std::istream & istream) const
+        {
+            LocalCachedFileRcPtr cachedFile = LocalCachedFileRcPtr(new LocalCachedFile());
+
+            cachedFile->lut = ReadCachedLut1D(istream);
+            cachedFile->from_min = ReadCachedValue<float>(istream);
+            cachedFile->from_max = ReadCachedValue<float>(istream);
+            return cachedFile;
+        }
+
         void LocalFileFormat::buildFileOps(OpRcPtrVec & ops,
                                            const Config & /*config*/,
                                            const ConstContextRcPtr & /*context*/,
@@ -1,12 +1,14 @@
 // SPDX-License-Identifier: BSD-3-Clause
 // Copyright Contributors to the OpenColorIO Project.
 
+#include <cmath>
 #include <cstdio>
 #include <sstream>
 
 #include <OpenColorIO/OpenColorIO.h>
 
 #include "ops/Lut3D/Lut3DOp.h"
+#include "ParseUtils.h"
 #include "Platform.h"
 #include "pystring/pystring.h"
 #include "transforms/FileTransform.h"
@@ -36,6 +38,11 @@ OCIO_NAMESPACE_ENTER
         public:
             LocalCachedFile() = default;
             ~LocalCachedFile() = default;
+
+            size_t getMemorySize() const override
+            {
+                return sizeof(LocalCachedFile) + GetOpDataMemorySize(lut);
+            }
             
             Lut3DOpDataRcPtr lut;
         };
@@ -51,10 +58,20 @@ OCIO_NAMESPACE_ENTER
             ~LocalFileFormat() = default;
             
             void getFormatInfo(FormatInfoVec & formatInfoVec) const override;
+
+            int probe(const std::string & header) const override;
             
             CachedFileRcPtr read(
                 std::istream & istream,
                 const std::string & fileName) const override;
+
+            bool writeCachedFile(const CachedFile & cachedFile,
+                                 std::ostream & ostream) const override;
+            CachedFileRcPtr readCachedFile(std::istream & istream) const override;
+
+            bool readHeader(std::istream & istream,
+                            const std::string & fileName,
+                            FileHeader & header) const override;
             
             void buildFileOps(OpRcPtrVec & ops,
                               const Config & config,
@@ -74,14 +91,20 @@ OCIO_NAMESPACE_ENTER
             formatInfoVec.push_back(info);
         }
         
-        CachedFileRcPtr LocalFileFormat::read(
-            std::istream & istream,
-            const std::string & fileName) const
+        int LocalFileFormat::probe(const std::string & header) const
+        {
+            // The first line is always the 'SPILUT' one.
+            const std::string line = GetProbeFirstLine(header, false);
+            return pystring::startswith(pystring::lower(line), "spilut") ? FORMAT_PROBE_CERTAIN
+                                                                        : FORMAT_PROBE_NO;
+        }
+
+        // Read the header lines of the file, returning the size of the LUT.
+        int ReadLutSize(std::istream & istream, const std::string & fileName)
         {
             const int MAX_LINE_SIZE = 4096;
             char lineBuffer[MAX_LINE_SIZE];
 
-            // Read header information
             istream.getline(lineBuffer, MAX_LINE_SIZE);
             if(!pystring::startswith(pystring::lower(lineBuffer), "spilut"))
             {
@@ -123,6 +146,20 @@ OCIO_NAMESPACE_ENTER
                 throw Exception(os.str().c_str());
             }
 
+            return rSize;
+        }
+
+        CachedFileRcPtr LocalFileFormat::read(
+            std::istream & istream,
+            const std::string & fileName) const
+        {
+            const int MAX_LINE_SIZE = 4096;
+            char lineBuffer[MAX_LINE_SIZE];
+
+            // Read header information
+            const int rSize = ReadLutSize(istream, fileName);
+            const int gSize = rSize, bSize = rSize;
+
             Lut3DOpDataRcPtr lut3d = std::make_shared<Lut3DOpData>((unsigned long)rSize);
             lut3d->setFileOutputBitDepth(BIT_DEPTH_F32);
 
@@ -134,14 +171,27 @@ OCIO_NAMESPACE_ENTER
             int entriesRemaining = rSize * gSize * bSize;
             Array & lutArray = lut3d->getArray();
             unsigned long numVal = lutArray.getNumValues();
+            std::vector<float> values;
+            const auto isIndex = [](float v)
+            {
+                return v == std::floor(v) && std::fabs(v) < 1e9f;
+            };
             while (istream.good() && entriesRemaining > 0)
             {
                 istream.getline(lineBuffer, MAX_LINE_SIZE);
 
-                if (sscanf(lineBuffer, "%d %d %d %f %f %f",
-                    &rIndex, &gIndex, &bIndex,
-                    &redValue, &greenValue, &blueValue) == 6)
+                // Parse the line "rIndex gIndex bIndex red green blue" independently
+                // of the locale (i.e. unlike sscanf).
+                if (StringToFloats(lineBuffer, values) && values.size() >= 6
+                    && isIndex(values[0]) && isIndex(values[1]) && isIndex(values[2]))
                 {
+                    rIndex = static_cast<int>(values[0]);
+                    gIndex = static_cast<int>(values[1]);
+                    bIndex = static_cast<int>(values[2]);
+                    redValue   = values[3];
+                    greenValue = values[4];
+                    blueValue  = values[5];
+
                     bool invalidIndex = false;
                     if (rIndex < 0 || rIndex >= rSize
                         || gIndex < 0 || gIndex >= gSize
@@ -197,6 +247,31 @@ OCIO_NAMESPACE_ENTER
             return cachedFile;
         }
 
+        bool LocalFileFormat::writeCachedFile(const CachedFile & cachedFile,
+                                              std::ostream & ostream) const
+        {
+            const LocalCachedFile & file = dynamic_cast<const LocalCachedFile &>(cachedFile);
+
+            WriteCachedLut3D(ostream, file.lut);
+            return true;
+        }
+
+        CachedFileRcPtr LocalFileFormat::readCachedFile(std::istream & istream) const
+        {
+            LocalCachedFileRcPtr cachedFile = LocalCachedFileRcPtr(new LocalCachedFile());
+
+            cachedFile->lut = ReadCachedLut3D(istream);
+            return cachedFile;
+        }
+
+        bool LocalFileFormat::readHeader(std::istream & istream,
+                                         const std::string & fileName,
+                                         FileHeader & header) const
+        {
+            header.lut3DSize = (unsigned long)ReadLutSize(istream, fileName);
+            return true;
+        }
+
         void LocalFileFormat::buildFileOps(OpRcPtrVec & ops,
                                            const Config & /*config*/,
                                            const ConstContextRcPtr & /*context*/,
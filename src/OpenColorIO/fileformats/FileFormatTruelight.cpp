@@ -9,6 +9,7 @@
 
 #include <OpenColorIO/OpenColorIO.h>
 
+#include "BakingUtils.h"
 #include "ops/Lut1D/Lut1DOp.h"
 #include "ops/Lut3D/Lut3DOp.h"
 #include "ParseUtils.h"
@@ -41,6 +42,13 @@ OCIO_NAMESPACE_ENTER
             LocalCachedFile() = default;
             ~LocalCachedFile() = default;
 
+            size_t getMemorySize() const override
+            {
+                return sizeof(LocalCachedFile)
+                    + GetOpDataMemorySize(lut1D)
+                    + GetOpDataMemorySize(lut3D);
+            }
+
             Lut1DOpDataRcPtr lut1D;
             Lut3DOpDataRcPtr lut3D;
         };
@@ -270,23 +278,14 @@ OCIO_NAMESPACE_ENTER
             const int DEFAULT_CUBE_SIZE = 32;
             const int DEFAULT_SHAPER_SIZE = 1024;
 
-            ConstConfigRcPtr config = baker.getConfig();
-            
             int cubeSize = baker.getCubeSize();
             if (cubeSize==-1) cubeSize = DEFAULT_CUBE_SIZE;
+            SelectCubeSize(baker, cubeSize);
             cubeSize = std::max(2, cubeSize); // smallest cube is 2x2x2
 
-            std::vector<float> cubeData;
-            cubeData.resize(cubeSize*cubeSize*cubeSize*3);
-            GenerateIdentityLut3D(&cubeData[0], cubeSize, 3, LUT3DORDER_FAST_RED);
-            PackedImageDesc cubeImg(&cubeData[0], cubeSize*cubeSize*cubeSize, 1, 3);
-
             // Apply processor to LUT data
-            ConstCPUProcessorRcPtr inputToTarget;
-            inputToTarget
-                = config->getProcessor(baker.getInputSpace(), 
-                                       baker.getTargetSpace())->getDefaultCPUProcessor();
-            inputToTarget->apply(cubeImg);
+            const std::vector<float> cubeData
+                = BakeLut3D(GetInputToTargetProcessor(baker), cubeSize, LUT3DORDER_FAST_RED);
 
             int shaperSize = baker.getShaperSize();
             if (shaperSize==-1) shaperSize = DEFAULT_SHAPER_SIZE;
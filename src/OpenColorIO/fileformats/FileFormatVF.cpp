@@ -24,6 +24,11 @@ OCIO_NAMESPACE_ENTER
             LocalCachedFile() = default;
             ~LocalCachedFile() = default;
 
+            size_t getMemorySize() const override
+            {
+                return sizeof(LocalCachedFile) + GetOpDataMemorySize(lut3D);
+            }
+
             Lut3DOpDataRcPtr lut3D;
             double m44[16]{ 0 };
             bool useMatrix = false;
@@ -40,6 +45,8 @@ OCIO_NAMESPACE_ENTER
             ~LocalFileFormat() = default;
             
             void getFormatInfo(FormatInfoVec & formatInfoVec) const override;
+
+            int probe(const std::string & header) const override;
             
             CachedFileRcPtr read(
                 std::istream & istream,
@@ -87,6 +94,17 @@ OCIO_NAMESPACE_ENTER
             formatInfoVec.push_back(info);
         }
         
+        int LocalFileFormat::probe(const std::string & header) const
+        {
+            const std::string line = GetProbeFirstLine(header, true);
+            if (line.empty())
+            {
+                return FORMAT_PROBE_UNKNOWN;
+            }
+            return pystring::startswith(pystring::lower(line), "#inventor") ? FORMAT_PROBE_CERTAIN
+                                                                           : FORMAT_PROBE_NO;
+        }
+
         CachedFileRcPtr LocalFileFormat::read(
             std::istream & istream,
             const std::string & fileName) const
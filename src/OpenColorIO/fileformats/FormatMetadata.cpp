@@ -2,6 +2,7 @@
 // Copyright Contributors to the OpenColorIO Project.
 
 #include <sstream>
+#include <utility>
 
 #include <OpenColorIO/OpenColorIO.h>
 
@@ -47,6 +48,15 @@ FormatMetadataImpl::FormatMetadataImpl(const FormatMetadataImpl & other)
 {
 }
 
+FormatMetadataImpl::FormatMetadataImpl(FormatMetadataImpl && other)
+    : FormatMetadata()
+    , m_name(other.m_name)
+    , m_value(std::move(other.m_value))
+    , m_attributes(std::move(other.m_attributes))
+    , m_elements(std::move(other.m_elements))
+{
+}
+
 FormatMetadataImpl::FormatMetadataImpl(const FormatMetadata & other)
     : FormatMetadataImpl(dynamic_cast<const FormatMetadataImpl &>(other))
 {
@@ -175,6 +185,18 @@ FormatMetadataImpl & FormatMetadataImpl::operator=(const FormatMetadataImpl & rh
     return *this;
 }
 
+FormatMetadataImpl & FormatMetadataImpl::operator=(FormatMetadataImpl && rhs)
+{
+    if (this != &rhs)
+    {
+        m_name       = rhs.m_name;
+        m_value      = std::move(rhs.m_value);
+        m_attributes = std::move(rhs.m_attributes);
+        m_elements   = std::move(rhs.m_elements);
+    }
+    return *this;
+}
+
 bool FormatMetadataImpl::operator==(const FormatMetadataImpl & rhs) const
 {
     if (this != &rhs)
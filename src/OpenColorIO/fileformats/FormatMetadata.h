@@ -54,6 +54,8 @@ public:
                        const std::string & value);
 
     FormatMetadataImpl(const FormatMetadataImpl & other);
+    // The moved-from metadata keeps its name (i.e. it could still be combined).
+    FormatMetadataImpl(FormatMetadataImpl && other);
     FormatMetadataImpl(const FormatMetadata & other);
     ~FormatMetadataImpl();
 
@@ -70,6 +72,7 @@ public:
     void combine(const FormatMetadataImpl & rhs);
 
     FormatMetadataImpl & operator=(const FormatMetadataImpl & rhs);
+    FormatMetadataImpl & operator=(FormatMetadataImpl && rhs);
     bool operator==(const FormatMetadataImpl & rhs) const;
 
     // If child with a matching name exists, returns its index,
@@ -8,6 +8,7 @@
 #include "MathUtils.h"
 #include "Platform.h"
 #include "pystring/pystring.h"
+#include "ThreadPool.h"
 
 OCIO_NAMESPACE_ENTER
 {
@@ -306,6 +307,7 @@ void CTFReaderArrayElt::start(const char ** atts)
     }
 
     m_position = 0;
+    m_rawData.clear();
 }
 
 void CTFReaderArrayElt::end()
@@ -314,6 +316,10 @@ void CTFReaderArrayElt::end()
     // no need to validate it.
     if (getParent()->isDummy()) return;
 
+    parseValues();
+    m_rawData.clear();
+    m_rawData.shrink_to_fit();
+
     CTFArrayMgt* pArr = dynamic_cast<CTFArrayMgt*>(getParent().get());
     pArr->endArray(m_position);
 }
@@ -322,58 +328,125 @@ void CTFReaderArrayElt::setRawData(const char * s,
                                    size_t len,
                                    unsigned int/*xmlLine*/)
 {
-    const unsigned long maxValues = m_array->getNumValues();
-    size_t pos(0);
+    // The character data comes line by line, the values being parsed once the
+    // array is complete.
+    if (!m_rawData.empty())
+    {
+        m_rawData.push_back(' ');
+    }
+    m_rawData.append(s, len);
+}
 
-    //
-    // using GetNextNumber here instead of GetNumbers to leverage the loop
-    // needed here to process each value from the strings.  This function
-    // is the most used when reading in large transforms.
-    //
+void CTFReaderArrayElt::parseValues()
+{
+    // Note that the null terminated string makes the character after the last
+    // number accessible (refer to ParseNumber()).
+    const char * s = m_rawData.c_str();
+    const size_t len = m_rawData.size();
 
-    pos = FindNextTokenStart(s, len, 0);
-    while (pos != len)
-    {
-        double data(0.);
+    // Split the character data in chunks on the number delimiters.
+    static const size_t CHUNK_SIZE = 256 * 1024;
 
-        try
-        {
-            GetNextNumber(s, len, pos, data);
-        }
-        catch (Exception& /*ce*/)
+    std::vector<size_t> chunkStarts(1, 0);
+    for (size_t pos = CHUNK_SIZE; pos < len; pos += CHUNK_SIZE)
+    {
+        pos = std::max(pos, chunkStarts.back());
+        pos = FindDelim(s, len, pos);
+        if (pos < len)
         {
-            ThrowM(*this, "Illegal values '", TruncateString(s, len),
-                   "' in ", getTypeName());
+            chunkStarts.push_back(pos);
         }
+    }
 
-        if (m_position<maxValues)
-        {
-            m_array->setDoubleValue(m_position++, data);
-        }
-        else
+    const size_t numChunks = chunkStarts.size();
+    std::vector<std::vector<double>> chunkValues(numChunks);
+    std::vector<char> chunkFailed(numChunks, 0);
+
+    const auto parseChunk = [&](long idx)
+    {
+        const char * chunk = s + chunkStarts[idx];
+        const size_t chunkLen
+            = (size_t(idx) + 1 < numChunks ? chunkStarts[idx + 1] : len) - chunkStarts[idx];
+
+        std::vector<double> & values = chunkValues[idx];
+        values.reserve(chunkLen / 4);
+
+        //
+        // using GetNextNumber here instead of GetNumbers to leverage the loop
+        // needed here to process each value from the strings.  This function
+        // is the most used when reading in large transforms.
+        //
+
+        size_t pos = FindNextTokenStart(chunk, chunkLen, 0);
+        while (pos != chunkLen)
         {
-            const CTFReaderOpElt* p = static_cast<const CTFReaderOpElt*>(getParent().get());
+            double data(0.);
 
-            std::ostringstream arg;
-            if (p->getOp()->getType() == OpData::Lut1DType)
+            try
             {
-                arg << m_array->getLength();
-                arg << "x" << m_array->getNumColorComponents();
+                GetNextNumber(chunk, chunkLen, pos, data);
             }
-            else if (p->getOp()->getType() == OpData::Lut3DType)
+            catch (Exception& /*ce*/)
             {
-                arg << m_array->getLength() << "x" << m_array->getLength();
-                arg << "x" << m_array->getLength();
-                arg << "x" << m_array->getNumColorComponents();
+                chunkFailed[idx] = 1;
+                return;
             }
-            else  // Matrix
+
+            values.push_back(data);
+        }
+    };
+
+    if (numChunks == 1)
+    {
+        parseChunk(0);
+    }
+    else
+    {
+        GetCPUThreadPool()->parallelFor(long(numChunks), parseChunk);
+    }
+
+    // Fill the array in order, so the errors do not depend on the chunks.
+    const unsigned long maxValues = m_array->getNumValues();
+    for (size_t idx = 0; idx < numChunks; ++idx)
+    {
+        if (chunkFailed[idx])
+        {
+            ThrowM(*this, "Illegal values '", TruncateString(s + chunkStarts[idx],
+                                                             len - chunkStarts[idx]),
+                   "' in ", getTypeName());
+        }
+
+        for (const double data : chunkValues[idx])
+        {
+            if (m_position<maxValues)
             {
-                arg << m_array->getLength();
-                arg << "x" << m_array->getLength();
+                m_array->setDoubleValue(m_position++, data);
             }
+            else
+            {
+                const CTFReaderOpElt* p = static_cast<const CTFReaderOpElt*>(getParent().get());
 
-            ThrowM(*this, "Expected ", arg.str(),
-                   " Array, found too many values in '", getTypeName(), "'.");
+                std::ostringstream arg;
+                if (p->getOp()->getType() == OpData::Lut1DType)
+                {
+                    arg << m_array->getLength();
+                    arg << "x" << m_array->getNumColorComponents();
+                }
+                else if (p->getOp()->getType() == OpData::Lut3DType)
+                {
+                    arg << m_array->getLength() << "x" << m_array->getLength();
+                    arg << "x" << m_array->getLength();
+                    arg << "x" << m_array->getNumColorComponents();
+                }
+                else  // Matrix
+                {
+                    arg << m_array->getLength();
+                    arg << "x" << m_array->getLength();
+                }
+
+                ThrowM(*this, "Expected ", arg.str(),
+                       " Array, found too many values in '", getTypeName(), "'.");
+            }
         }
     }
 }
@@ -212,12 +212,19 @@ public:
 private:
     CTFReaderArrayElt() = delete;
 
+    // Parse the character data in the array, the large arrays being split in
+    // chunks parsed in parallel.
+    void parseValues();
+
     // The array to fill (pointer not owned).
     // Array is managed as a member object of an OpData.
     ArrayBase * m_array;
 
     // The current position to fill.
     unsigned int m_position;
+
+    // The character data, only parsed once the element is complete.
+    std::string m_rawData;
 };
 
 class CTFArrayMgt
@@ -19,6 +19,7 @@
 #include "ops/Matrix/MatrixOpData.h"
 #include "ops/Range/RangeOpData.h"
 #include "ops/reference/ReferenceOpData.h"
+#include "ParseUtils.h"
 #include "Platform.h"
 #include "transforms/CDLTransform.h"
 
@@ -456,20 +457,48 @@ typename std::enable_if<!std::is_floating_point<T>::value, void>::type WriteValu
     stream << value;
 }
 
+// Same as above for the array values.
 template <typename T>
-void SetOStream(T, std::ostream & xml)
+void WriteValue(T value, int precision, int width, NumberWriter & writer)
 {
-    xml.width(11);
-    xml.precision(8);
+    static_assert(std::is_floating_point<T>::value, "The values must be floating point.");
+
+    if (IsNan(value))
+    {
+        writer.writeString("nan", width);
+    }
+    else if (value == std::numeric_limits<T>::infinity())
+    {
+        writer.writeString("inf", width);
+    }
+    else if (value == -std::numeric_limits<T>::infinity())
+    {
+        writer.writeString("-inf", width);
+    }
+    else
+    {
+        writer.writeGeneral(value, precision, width);
+    }
+}
+
+// Number of significant digits and width of the F32 values.
+template <typename T>
+void GetF32Format(int & precision, int & width)
+{
+    precision = 8;
+    width = 11;
 }
 
 template <>
-void SetOStream<double>(double, std::ostream & xml)
+void GetF32Format<double>(int & precision, int & width)
 {
-    xml.width(19);
-    xml.precision(15);
+    precision = 15;
+    width = 19;
 }
 
+// Note that the values are formatted as the stream would do (i.e. the integer bit-depths
+// using the current stream precision) but through a NumberWriter, the array values being
+// the bulk of the written files.
 template<typename Iter, typename scaleType>
 void WriteValues(XmlFormatter & formatter,
                  Iter valuesBegin,
@@ -481,67 +510,58 @@ void WriteValues(XmlFormatter & formatter,
 {
     std::ostream& xml = formatter.getStream();
 
-    for (Iter it(valuesBegin); it != valuesEnd; it += iterStep)
+    int precision = static_cast<int>(xml.precision());
+    int width = 0;
+    switch (bitDepth)
     {
-        switch (bitDepth)
-        {
-        case BIT_DEPTH_UINT8:
-        {
-            xml.width(3);
-            xml << (*it) * scale;
-            break;
-        }
-        case BIT_DEPTH_UINT10:
-        {
-            xml.width(4);
-            xml << (*it) * scale;
-            break;
-        }
-
-        case BIT_DEPTH_UINT12:
-        {
-            xml.width(4);
-            xml << (*it) * scale;
-            break;
-        }
+    case BIT_DEPTH_UINT8:
+        width = 3;
+        break;
+    case BIT_DEPTH_UINT10:
+    case BIT_DEPTH_UINT12:
+        width = 4;
+        break;
+    case BIT_DEPTH_UINT16:
+        width = 5;
+        break;
+    case BIT_DEPTH_F16:
+        width = 11;
+        precision = 5;
+        break;
+    case BIT_DEPTH_F32:
+        GetF32Format<typename std::iterator_traits<Iter>::value_type>(precision, width);
+        break;
+    default:
+        throw Exception("Unknown bitdepth.");
+    }
 
-        case BIT_DEPTH_UINT16:
-        {
-            xml.width(5);
-            xml << (*it) * scale;
-            break;
-        }
+    // Keep the stream precision as if the stream formatted the values.
+    if (valuesBegin != valuesEnd)
+    {
+        xml.precision(precision);
+    }
 
-        case BIT_DEPTH_F16:
-        {
-            xml.width(11);
-            xml.precision(5);
-            WriteValue((*it) * scale, xml);
-            break;
-        }
+    NumberWriter writer(xml);
 
-        case BIT_DEPTH_F32:
+    for (Iter it(valuesBegin); it != valuesEnd; it += iterStep)
+    {
+        if (bitDepth == BIT_DEPTH_F16 || bitDepth == BIT_DEPTH_F32)
         {
-            SetOStream(*it, xml);
-            WriteValue((*it) * scale, xml);
-            break;
+            WriteValue((*it) * scale, precision, width, writer);
         }
-
-        default:
+        else
         {
-            throw Exception("Unknown bitdepth.");
-            break;
-        }
+            writer.writeGeneral((*it) * scale, precision, width);
         }
 
         if (std::distance(valuesBegin, it) % valuesPerLine
             == valuesPerLine - 1)
         {
-            xml << std::endl;
+            writer.writeChar('\n');
         }
         else
         {
-            xml << " ";
+            writer.writeChar(' ');
         }
     }
 }
@@ -4,6 +4,7 @@
 #ifndef INCLUDED_OCIO_FILEFORMATS_XML_XMLREADERUTILS_H
 #define INCLUDED_OCIO_FILEFORMATS_XML_XMLREADERUTILS_H
 
+#include <cctype>
 #include <string>
 #include <sstream>
 #include <vector>
@@ -11,6 +12,7 @@
 #include <OpenColorIO/OpenColorIO.h>
 
 #include "MathUtils.h"
+#include "ParseUtils.h"
 #include "Platform.h"
 
 OCIO_NAMESPACE_ENTER
@@ -152,8 +154,22 @@ void ParseNumber(const char * str, size_t startPos, size_t endPos, T & value)
     // However since strtod will stop parsing when it encounters characters
     // that it cannot convert to a number, in practice it does not need to
     // be null terminated.
-    // C++11 version of strtod processes NAN & INF ASCII values.
-    val = strtod(startParse, &endParse);
+    // The common numbers are first parsed with the fast locale-independent parser,
+    // the C++11 version of strtod processing the other ones (e.g. NAN & INF ASCII values).
+    // As strtod does not stop at endPos, the fast result is only used when the next
+    // character could not continue the number (e.g. an exponent or a hexadecimal value).
+    const char * fastEnd = ParseDouble(startParse, str + endPos, val);
+    const char next = str[endPos];
+    if (fastEnd == str + endPos
+        && !std::isalnum(static_cast<unsigned char>(next))
+        && next != '.' && next != '+' && next != '-')
+    {
+        endParse = const_cast<char *>(fastEnd);
+    }
+    else
+    {
+        val = strtod(startParse, &endParse);
+    }
     value = (T)val;
     if (endParse == startParse)
     {
@@ -63,12 +63,6 @@ void RenderParams::setSaturation(float sat)
 
 void RenderParams::update(ConstCDLOpDataRcPtr & cdl)
 {
-    double slope[4], offset[4], power[4];
-    cdl->getSlopeParams().getRGBA(slope);
-    cdl->getOffsetParams().getRGBA(offset);
-    cdl->getPowerParams().getRGBA(power);
-
-    const float saturation = (float)cdl->getSaturation();
     const CDLOpData::Style style = cdl->getStyle();
 
     m_isReverse
@@ -79,6 +73,38 @@ void RenderParams::update(ConstCDLOpDataRcPtr & cdl)
         = (style == CDLOpData::CDL_NO_CLAMP_FWD)
         || (style == CDLOpData::CDL_NO_CLAMP_REV);
 
+    if (cdl->isDynamic())
+    {
+        updateValues(*cdl->getCDLProperty());
+    }
+    else
+    {
+        double slope[4], offset[4], power[4];
+        cdl->getSlopeParams().getRGBA(slope);
+        cdl->getOffsetParams().getRGBA(offset);
+        cdl->getPowerParams().getRGBA(power);
+
+        setValues(slope, offset, power, cdl->getSaturation());
+    }
+}
+
+void RenderParams::updateValues(const DynamicPropertyImpl & cdlProperty)
+{
+    // Note: The alpha values are the ones of CDLOpData::ChannelParams(r, g, b).
+    double slope[4] = { 1., 1., 1., 1. };
+    double offset[4] = { 0., 0., 0., 1. };
+    double power[4] = { 1., 1., 1., 1. };
+    double saturation = 1.;
+    cdlProperty.getCDLValues(slope, offset, power, saturation);
+
+    setValues(slope, offset, power, saturation);
+}
+
+void RenderParams::setValues(const double * slope, const double * offset,
+                             const double * power, double sat)
+{
+    const float saturation = (float)sat;
+
     if (isReverse())
     {
         // Reverse render parameters
@@ -109,8 +135,6 @@ void RenderParams::update(ConstCDLOpDataRcPtr & cdl)
 
 #ifdef USE_SSE
 
-static const __m128 LumaWeights = _mm_setr_ps(0.2126f, 0.7152f, 0.0722f, 0.0);
-
 // Load a given pixel from the pixel list into a SSE register
 inline __m128 LoadPixel(const float * rgbaBuffer, float & inAlpha)
 {
@@ -125,177 +149,44 @@ inline void StorePixel(float * rgbaBuffer, const __m128 pix, const float outAlph
     rgbaBuffer[3] = outAlpha;
 }
 
-// Map pixel values from the input domain to the unit domain
-inline void ApplyInScale(__m128 & pix, const __m128 inScale)
-{
-    pix = _mm_mul_ps(pix, inScale);
-}
-
-// Map result from unit domain to the output domain
-inline void ApplyOutScale(__m128& pix, const __m128 outScale)
-{
-    pix = _mm_mul_ps(pix, outScale);
-}
-
-// Apply the slope component to the the pixel's values
-inline void ApplySlope(__m128& pix, const __m128 slope)
-{
-    pix = _mm_mul_ps(pix, slope);
-}
-
-// Apply the offset component to the the pixel's values
-inline void ApplyOffset(__m128& pix, const __m128 offset)
-{
-    pix = _mm_add_ps(pix, offset);
-}
-
-// Conditionally clamp the pixel's values to the range [0, 1]
-// When the template argument is true, the clamp mode is used,
-// and the values in pix are clamped to the range [0,1]. When
-// the argument is false, nothing is done.
-template<bool>
-inline void ApplyClamp(__m128& pix)
-{
-    pix = _mm_min_ps(_mm_max_ps(pix, EZERO), EONE);
-}
-
-template<>
-inline void ApplyClamp<false>(__m128&)
-{
-}
-
-// Apply the power component to the the pixel's values
-// When the template argument is true, the the values in pix
-// are clamped to the range [0,1] and the power operation is
-// applied. When the argument is false, the values in pix are
-// not clamped before the power operation is applied. When the
-// base is negative in this mode, pixel values are just passed
-// through.
-template<bool>
-inline void ApplyPower(__m128& pix, const __m128& power)
-{
-    ApplyClamp<true>(pix);
-    pix = ssePower(pix, power);
-}
-
-template<>
-inline void ApplyPower<false>(__m128& pix, const __m128& power)
-{
-    __m128 negMask = _mm_cmplt_ps(pix, EZERO);
-    __m128 pixPower = ssePower(pix, power);
-    pix = sseSelect(negMask, pix, pixPower);
-}
-
-// Apply the saturation component to the the pixel's values
-inline void ApplySaturation(__m128& pix, const __m128 saturation)
-{
-    // Compute luma: dot product of pixel values and the luma weigths
-    __m128 luma = _mm_mul_ps(pix, LumaWeights);
-
-    // luma = [ x+y , y+x , z+w , w+z ]
-    luma = _mm_add_ps(luma, _mm_shuffle_ps(luma, luma, _MM_SHUFFLE(2,3,0,1)));
-
-    // luma = [ x+y+z+w , y+x+w+z , z+w+x+y , w+z+y+x ]
-    luma = _mm_add_ps(luma, _mm_shuffle_ps(luma, luma, _MM_SHUFFLE(1,0,3,2)));
-
-    // Apply saturation
-    pix = _mm_add_ps(luma, _mm_mul_ps(saturation, _mm_sub_ps(pix, luma)));
-}
-
-#else // USE_SSE
-
-inline void ApplyScale(float * pix, const float scale)
-{
-    pix[0] = pix[0] * scale;
-    pix[1] = pix[1] * scale;
-    pix[2] = pix[2] * scale;
-}
-
-// Apply the slope component to the the pixel's values
-inline void ApplySlope(float * pix, const float * slope)
-{
-    pix[0] = pix[0] * slope[0];
-    pix[1] = pix[1] * slope[1];
-    pix[2] = pix[2] * slope[2];
-}
-
-// Apply the offset component to the the pixel's values
-inline void ApplyOffset(float * pix, const float * offset)
-{
-    pix[0] = pix[0] + offset[0];
-    pix[1] = pix[1] + offset[1];
-    pix[2] = pix[2] + offset[2];
-}
-
-// Apply the saturation component to the the pixel's values
-inline void ApplySaturation(float * pix, const float saturation)
-{
-    const float srcpix[3] = { pix[0], pix[1], pix[2] };
-
-    static const float LumaWeights[3] = { 0.2126f, 0.7152f, 0.0722f };
-
-    // Compute luma: dot product of pixel values and the luma weigths
-    ApplySlope(pix, LumaWeights);
-
-    // luma = x+y+z+w
-    const float luma = pix[0] + pix[1] + pix[2];
+#endif // USE_SSE
 
-    // Apply saturation
-    pix[0] = luma + saturation * (srcpix[0] - luma);
-    pix[1] = luma + saturation * (srcpix[1] - luma);
-    pix[2] = luma + saturation * (srcpix[2] - luma);
-}
 
-// Conditionally clamp the pixel's values to the range [0, 1]
-// When the template argument is true, the clamp mode is used,
-// and the values in pix are clamped to the range [0,1]. When
-// the argument is false, nothing is done.
-template<bool>
-inline void ApplyClamp(float * pix)
+CDLOpCPU::CDLOpCPU(ConstCDLOpDataRcPtr & cdl)
+    :   OpCPU()
 {
-    // NaNs become 0.
-    pix[0] = Clamp(pix[0], 0.f, 1.f);
-    pix[1] = Clamp(pix[1], 0.f, 1.f);
-    pix[2] = Clamp(pix[2], 0.f, 1.f);
+    m_renderParams.update(cdl);
+    m_cdlProperty = cdl->getCDLProperty();
 }
 
-template<>
-inline void ApplyClamp<false>(float *)
+bool CDLOpCPU::hasDynamicProperty(DynamicPropertyType type) const
 {
+    return type == DYNAMIC_PROPERTY_CDL && m_cdlProperty;
 }
 
-// Apply the power component to the the pixel's values
-// When the template argument is true, the the values in pix
-// are clamped to the range [0,1] and the power operation is
-// applied. When the argument is false, the values in pix are
-// not clamped before the power operation is applied. When the
-// base is negative in this mode, pixel values are just passed
-// through.
-template<bool>
-inline void ApplyPower(float * pix, const float * power)
+DynamicPropertyRcPtr CDLOpCPU::getDynamicProperty(DynamicPropertyType type) const
 {
-    ApplyClamp<true>(pix);
-    pix[0] = powf(pix[0], power[0]);
-    pix[1] = powf(pix[1], power[1]);
-    pix[2] = powf(pix[2], power[2]);
+    if (type != DYNAMIC_PROPERTY_CDL)
+    {
+        throw Exception("Dynamic property type not supported by CDL.");
+    }
+    if (!m_cdlProperty)
+    {
+        throw Exception("CDL property is not dynamic.");
+    }
+    return m_cdlProperty;
 }
 
-template<>
-inline void ApplyPower<false>(float * pix, const float * power)
+const RenderParams & CDLOpCPU::getRenderParams(RenderParams & dynamicParams) const
 {
-    // Note: Set NaNs to 0 to match the SSE path.
-    pix[0] = IsNan(pix[0]) ? 0.0f : (pix[0]<0.f ? pix[0] : powf(pix[0], power[0]));
-    pix[1] = IsNan(pix[1]) ? 0.0f : (pix[1]<0.f ? pix[1] : powf(pix[1], power[1]));
-    pix[2] = IsNan(pix[2]) ? 0.0f : (pix[2]<0.f ? pix[2] : powf(pix[2], power[2]));
-}
-
-#endif // USE_SSE
-
+    if (!m_cdlProperty)
+    {
+        return m_renderParams;
+    }
 
-CDLOpCPU::CDLOpCPU(ConstCDLOpDataRcPtr & cdl)
-    :   OpCPU()
-{
-    m_renderParams.update(cdl);
+    dynamicParams = m_renderParams;
+    dynamicParams.updateValues(*m_cdlProperty);
+    return dynamicParams;
 }
 
 #ifdef USE_SSE
@@ -325,9 +216,12 @@ void CDLRendererV1_2Fwd::apply(const void * inImg, void * outImg, long numPixels
 template<bool CLAMP>
 void CDLRendererV1_2Fwd::_apply(const float * inImg, float * outImg, long numPixels) const
 {
+    RenderParams dynamicParams;
+    const RenderParams & renderParams = getRenderParams(dynamicParams);
+
 #ifdef USE_SSE
     __m128 slope, offset, power, saturation, pix;
-    LoadRenderParams(m_renderParams,
+    LoadRenderParams(renderParams,
                      slope,
                      offset,
                      power,
@@ -342,13 +236,7 @@ void CDLRendererV1_2Fwd::_apply(const float * inImg, float * outImg, long numPix
     {
         pix = LoadPixel(in, inAlpha);
 
-        ApplySlope(pix, slope);
-        ApplyOffset(pix, offset);
-
-        ApplyPower<CLAMP>(pix, power);
-
-        ApplySaturation(pix, saturation);
-        ApplyClamp<CLAMP>(pix);
+        CDLUtil::ApplyForward<CLAMP>(pix, slope, offset, power, saturation);
 
         StorePixel(out, pix, inAlpha);
 
@@ -359,10 +247,6 @@ void CDLRendererV1_2Fwd::_apply(const float * inImg, float * outImg, long numPix
     const float * in = inImg;
     float * out = outImg;
 
-    // Combine inScale and slope
-    const float * slope = m_renderParams.getSlope();
-    float inSlope[3] = {slope[0], slope[1], slope[2]};
-
     for (long idx = 0; idx<numPixels; ++idx)
     {
         const float inAlpha = in[3];
@@ -370,13 +254,7 @@ void CDLRendererV1_2Fwd::_apply(const float * inImg, float * outImg, long numPix
         // NB: 'in' and 'out' could be pointers to the same memory buffer.
         memcpy(out, in, 4 * sizeof(float));
 
-        ApplySlope(out, inSlope);
-        ApplyOffset(out, m_renderParams.getOffset());
-
-        ApplyPower<CLAMP>(out, m_renderParams.getPower());
-
-        ApplySaturation(out, m_renderParams.getSaturation());
-        ApplyClamp<CLAMP>(out);
+        CDLUtil::ApplyForward<CLAMP>(out, renderParams);
 
         out[3] = inAlpha;
 
@@ -409,9 +287,12 @@ void CDLRendererV1_2Rev::apply(const void * inImg, void * outImg, long numPixels
 template<bool CLAMP>
 void CDLRendererV1_2Rev::_apply(const float * inImg, float * outImg, long numPixels) const
 {
+    RenderParams dynamicParams;
+    const RenderParams & renderParams = getRenderParams(dynamicParams);
+
 #ifdef USE_SSE
     __m128 slopeRev, offsetRev, powerRev, saturationRev, pix;
-    LoadRenderParams(m_renderParams,
+    LoadRenderParams(renderParams,
                      slopeRev,
                      offsetRev,
                      powerRev,
@@ -426,14 +307,7 @@ void CDLRendererV1_2Rev::_apply(const float * inImg, float * outImg, long numPix
     {
         pix = LoadPixel(in, inAlpha);
 
-        ApplyClamp<CLAMP>(pix);
-        ApplySaturation(pix, saturationRev);
-
-        ApplyPower<CLAMP>(pix, powerRev);
-
-        ApplyOffset(pix, offsetRev);
-        ApplySlope(pix, slopeRev);
-        ApplyClamp<CLAMP>(pix);
+        CDLUtil::ApplyReverse<CLAMP>(pix, slopeRev, offsetRev, powerRev, saturationRev);
 
         StorePixel(out, pix, inAlpha);
 
@@ -451,14 +325,7 @@ void CDLRendererV1_2Rev::_apply(const float * inImg, float * outImg, long numPix
         // NB: 'in' and 'out' could be pointers to the same memory buffer.
         memcpy(out, in, 4 * sizeof(float));
 
-        ApplyClamp<CLAMP>(out);
-        ApplySaturation(out, m_renderParams.getSaturation());
-
-        ApplyPower<CLAMP>(out, m_renderParams.getPower());
-
-        ApplyOffset(out, m_renderParams.getOffset());
-        ApplySlope(out, m_renderParams.getSlope());
-        ApplyClamp<CLAMP>(out);
+        CDLUtil::ApplyReverse<CLAMP>(out, renderParams);
 
         out[3] = inAlpha;
 
@@ -5,10 +5,14 @@
 #ifndef INCLUDED_OCIO_CDLOP_CPU
 #define INCLUDED_OCIO_CDLOP_CPU
 
+#include <cmath>
+
 #include <OpenColorIO/OpenColorIO.h>
 
+#include "MathUtils.h"
 #include "Op.h"
 #include "ops/CDL/CDLOpData.h"
+#include "SSE.h"
 
 
 OCIO_NAMESPACE_ENTER
@@ -42,7 +46,15 @@ struct RenderParams
     // Update the render parameters from the operation data
     void update(ConstCDLOpDataRcPtr & cdl);
 
+    // Update the values (i.e. not the style) from the current values of the
+    // dynamic property.
+    void updateValues(const DynamicPropertyImpl & cdlProperty);
+
 private:
+    // Note: slope, offset and power hold the four RGBA values.
+    void setValues(const double * slope, const double * offset, const double * power,
+                   double sat);
+
     float m_slope[4];
     float m_offset[4];
     float m_power[4];
@@ -51,6 +63,219 @@ private:
     bool m_isNoClamp;
 };
 
+// The processing of one pixel by the CDL renderers, also used by the fused CPU ops (refer
+// to CreateFusedCPUOps()). Only the RGB channels are processed i.e. the caller restores
+// the alpha channel.
+namespace CDLUtil
+{
+
+#ifdef USE_SSE
+
+static const __m128 LumaWeights = _mm_setr_ps(0.2126f, 0.7152f, 0.0722f, 0.0);
+
+// Apply the slope component to the the pixel's values
+inline void ApplySlope(__m128& pix, const __m128 slope)
+{
+    pix = _mm_mul_ps(pix, slope);
+}
+
+// Apply the offset component to the the pixel's values
+inline void ApplyOffset(__m128& pix, const __m128 offset)
+{
+    pix = _mm_add_ps(pix, offset);
+}
+
+// Conditionally clamp the pixel's values to the range [0, 1]
+// When the template argument is true, the clamp mode is used,
+// and the values in pix are clamped to the range [0,1]. When
+// the argument is false, nothing is done.
+template<bool>
+inline void ApplyClamp(__m128& pix)
+{
+    pix = _mm_min_ps(_mm_max_ps(pix, EZERO), EONE);
+}
+
+template<>
+inline void ApplyClamp<false>(__m128&)
+{
+}
+
+// Apply the power component to the the pixel's values
+// When the template argument is true, the the values in pix
+// are clamped to the range [0,1] and the power operation is
+// applied. When the argument is false, the values in pix are
+// not clamped before the power operation is applied. When the
+// base is negative in this mode, pixel values are just passed
+// through.
+template<bool>
+inline void ApplyPower(__m128& pix, const __m128& power)
+{
+    ApplyClamp<true>(pix);
+    pix = ssePower(pix, power);
+}
+
+template<>
+inline void ApplyPower<false>(__m128& pix, const __m128& power)
+{
+    __m128 negMask = _mm_cmplt_ps(pix, EZERO);
+    __m128 pixPower = ssePower(pix, power);
+    pix = sseSelect(negMask, pix, pixPower);
+}
+
+// Apply the saturation component to the the pixel's values
+inline void ApplySaturation(__m128& pix, const __m128 saturation)
+{
+    // Compute luma: dot product of pixel values and the luma weigths
+    __m128 luma = _mm_mul_ps(pix, LumaWeights);
+
+    // luma = [ x+y , y+x , z+w , w+z ]
+    luma = _mm_add_ps(luma, _mm_shuffle_ps(luma, luma, _MM_SHUFFLE(2,3,0,1)));
+
+    // luma = [ x+y+z+w , y+x+w+z , z+w+x+y , w+z+y+x ]
+    luma = _mm_add_ps(luma, _mm_shuffle_ps(luma, luma, _MM_SHUFFLE(1,0,3,2)));
+
+    // Apply saturation
+    pix = _mm_add_ps(luma, _mm_mul_ps(saturation, _mm_sub_ps(pix, luma)));
+}
+
+template<bool CLAMP>
+inline void ApplyForward(__m128& pix, const __m128 slope, const __m128 offset,
+                         const __m128 power, const __m128 saturation)
+{
+    ApplySlope(pix, slope);
+    ApplyOffset(pix, offset);
+
+    ApplyPower<CLAMP>(pix, power);
+
+    ApplySaturation(pix, saturation);
+    ApplyClamp<CLAMP>(pix);
+}
+
+// Note that the parameters are the reverse render parameters.
+template<bool CLAMP>
+inline void ApplyReverse(__m128& pix, const __m128 slope, const __m128 offset,
+                         const __m128 power, const __m128 saturation)
+{
+    ApplyClamp<CLAMP>(pix);
+    ApplySaturation(pix, saturation);
+
+    ApplyPower<CLAMP>(pix, power);
+
+    ApplyOffset(pix, offset);
+    ApplySlope(pix, slope);
+    ApplyClamp<CLAMP>(pix);
+}
+
+#else // USE_SSE
+
+// Apply the slope component to the the pixel's values
+inline void ApplySlope(float * pix, const float * slope)
+{
+    pix[0] = pix[0] * slope[0];
+    pix[1] = pix[1] * slope[1];
+    pix[2] = pix[2] * slope[2];
+}
+
+// Apply the offset component to the the pixel's values
+inline void ApplyOffset(float * pix, const float * offset)
+{
+    pix[0] = pix[0] + offset[0];
+    pix[1] = pix[1] + offset[1];
+    pix[2] = pix[2] + offset[2];
+}
+
+// Apply the saturation component to the the pixel's values
+inline void ApplySaturation(float * pix, const float saturation)
+{
+    const float srcpix[3] = { pix[0], pix[1], pix[2] };
+
+    static const float LumaWeights[3] = { 0.2126f, 0.7152f, 0.0722f };
+
+    // Compute luma: dot product of pixel values and the luma weigths
+    ApplySlope(pix, LumaWeights);
+
+    // luma = x+y+z+w
+    const float luma = pix[0] + pix[1] + pix[2];
+
+    // Apply saturation
+    pix[0] = luma + saturation * (srcpix[0] - luma);
+    pix[1] = luma + saturation * (srcpix[1] - luma);
+    pix[2] = luma + saturation * (srcpix[2] - luma);
+}
+
+// Conditionally clamp the pixel's values to the range [0, 1]
+// When the template argument is true, the clamp mode is used,
+// and the values in pix are clamped to the range [0,1]. When
+// the argument is false, nothing is done.
+template<bool>
+inline void ApplyClamp(float * pix)
+{
+    // NaNs become 0.
+    pix[0] = Clamp(pix[0], 0.f, 1.f);
+    pix[1] = Clamp(pix[1], 0.f, 1.f);
+    pix[2] = Clamp(pix[2], 0.f, 1.f);
+}
+
+template<>
+inline void ApplyClamp<false>(float *)
+{
+}
+
+// Apply the power component to the the pixel's values
+// When the template argument is true, the the values in pix
+// are clamped to the range [0,1] and the power operation is
+// applied. When the argument is false, the values in pix are
+// not clamped before the power operation is applied. When the
+// base is negative in this mode, pixel values are just passed
+// through.
+template<bool>
+inline void ApplyPower(float * pix, const float * power)
+{
+    ApplyClamp<true>(pix);
+    pix[0] = powf(pix[0], power[0]);
+    pix[1] = powf(pix[1], power[1]);
+    pix[2] = powf(pix[2], power[2]);
+}
+
+template<>
+inline void ApplyPower<false>(float * pix, const float * power)
+{
+    // Note: Set NaNs to 0 to match the SSE path.
+    pix[0] = IsNan(pix[0]) ? 0.0f : (pix[0]<0.f ? pix[0] : powf(pix[0], power[0]));
+    pix[1] = IsNan(pix[1]) ? 0.0f : (pix[1]<0.f ? pix[1] : powf(pix[1], power[1]));
+    pix[2] = IsNan(pix[2]) ? 0.0f : (pix[2]<0.f ? pix[2] : powf(pix[2], power[2]));
+}
+
+template<bool CLAMP>
+inline void ApplyForward(float * pix, const RenderParams & params)
+{
+    ApplySlope(pix, params.getSlope());
+    ApplyOffset(pix, params.getOffset());
+
+    ApplyPower<CLAMP>(pix, params.getPower());
+
+    ApplySaturation(pix, params.getSaturation());
+    ApplyClamp<CLAMP>(pix);
+}
+
+// Note that the parameters are the reverse render parameters.
+template<bool CLAMP>
+inline void ApplyReverse(float * pix, const RenderParams & params)
+{
+    ApplyClamp<CLAMP>(pix);
+    ApplySaturation(pix, params.getSaturation());
+
+    ApplyPower<CLAMP>(pix, params.getPower());
+
+    ApplyOffset(pix, params.getOffset());
+    ApplySlope(pix, params.getSlope());
+    ApplyClamp<CLAMP>(pix);
+}
+
+#endif // USE_SSE
+
+}
+
 class CDLOpCPU;
 typedef OCIO_SHARED_PTR<CDLOpCPU> CDLOpCPURcPtr;
 
@@ -64,11 +289,18 @@ public:
 
     CDLOpCPU(ConstCDLOpDataRcPtr & cdl);
 
+    bool hasDynamicProperty(DynamicPropertyType type) const override;
+    DynamicPropertyRcPtr getDynamicProperty(DynamicPropertyType type) const override;
+
 protected:
-    const RenderParams & getRenderParams() const { return m_renderParams; }
+    // Get the parameters to use for one apply() call. When dynamic, the property is only
+    // read once per call (i.e. per image band) into dynamicParams, so a change is seen at
+    // the start of the next call and never in the middle of a call.
+    const RenderParams & getRenderParams(RenderParams & dynamicParams) const;
 
 protected:
     RenderParams m_renderParams;
+    DynamicPropertyImplRcPtr m_cdlProperty; // Only when dynamic
 
 private:
     CDLOpCPU();
@@ -104,6 +104,39 @@ CDLOpData::CDLOpData(const CDLOpData::Style & style,
     validate();
 }
 
+CDLOpData::CDLOpData(const CDLOpData & rhs)
+    :   OpData()
+    ,   m_style(GetDefaultStyle())
+    ,   m_slopeParams(1.0)
+    ,   m_offsetParams(0.0)
+    ,   m_powerParams(1.0)
+    ,   m_saturation(1.0)
+{
+    *this = rhs;
+}
+
+CDLOpData & CDLOpData::operator=(const CDLOpData & rhs)
+{
+    if (this == &rhs) return *this;
+
+    OpData::operator=(rhs);
+
+    m_style        = rhs.m_style;
+    m_slopeParams  = rhs.m_slopeParams;
+    m_offsetParams = rhs.m_offsetParams;
+    m_powerParams  = rhs.m_powerParams;
+    m_saturation   = rhs.m_saturation;
+
+    // Copy the dynamic property. Sharing happens when needed, with CPUop for instance.
+    m_cdlProperty.reset();
+    if (rhs.m_cdlProperty)
+    {
+        m_cdlProperty = std::make_shared<DynamicPropertyImpl>(*rhs.m_cdlProperty);
+    }
+
+    return *this;
+}
+
 CDLOpData::~CDLOpData()
 {
 }
@@ -121,7 +154,10 @@ bool CDLOpData::operator==(const OpData& other) const
 
     const CDLOpData* cdl = static_cast<const CDLOpData*>(&other);
 
-    return m_style        == cdl->m_style 
+    // NB: The parameters of dynamic CDLs are still compared (i.e. contrary to the
+    //     other dynamic properties) as they hold the initial values.
+    return isDynamic()    == cdl->isDynamic()
+        && m_style        == cdl->m_style 
         && m_slopeParams  == cdl->m_slopeParams
         && m_offsetParams == cdl->m_offsetParams
         && m_powerParams  == cdl->m_powerParams
@@ -153,6 +189,50 @@ void CDLOpData::setSaturation(const double saturation)
     m_saturation = saturation;
 }
 
+void CDLOpData::makeDynamic()
+{
+    if (!m_cdlProperty)
+    {
+        m_cdlProperty = std::make_shared<DynamicPropertyImpl>(m_slopeParams.data(),
+                                                              m_offsetParams.data(),
+                                                              m_powerParams.data(),
+                                                              m_saturation,
+                                                              true);
+    }
+}
+
+bool CDLOpData::hasDynamicProperty(DynamicPropertyType type) const
+{
+    return type == DYNAMIC_PROPERTY_CDL && isDynamic();
+}
+
+DynamicPropertyRcPtr CDLOpData::getDynamicProperty(DynamicPropertyType type) const
+{
+    if (type != DYNAMIC_PROPERTY_CDL)
+    {
+        throw Exception("Dynamic property type not supported by CDL.");
+    }
+    if (!isDynamic())
+    {
+        throw Exception("CDL property is not dynamic.");
+    }
+    return m_cdlProperty;
+}
+
+void CDLOpData::replaceDynamicProperty(DynamicPropertyType type,
+                                       DynamicPropertyImplRcPtr prop)
+{
+    if (type != DYNAMIC_PROPERTY_CDL)
+    {
+        throw Exception("Dynamic property type not supported by CDL.");
+    }
+    if (!isDynamic())
+    {
+        throw Exception("CDL property is not dynamic.");
+    }
+    m_cdlProperty = prop;
+}
+
 // Validate if a parameter is greater than or equal to threshold value.
 void validateGreaterEqual(const char * name, 
                           const double value, 
@@ -227,6 +307,8 @@ bool CDLOpData::isNoOp() const
 
 bool CDLOpData::isIdentity() const
 {
+    if (isDynamic()) return false;
+
     return  m_slopeParams  == kOneParams  &&
             m_offsetParams == kZeroParams &&
             m_powerParams  == kOneParams  &&
@@ -263,7 +345,8 @@ OpDataRcPtr CDLOpData::getIdentityReplacement() const
 
 bool CDLOpData::hasChannelCrosstalk() const
 {
-    return m_saturation != 1.0;
+    // The saturation of a dynamic CDL could change.
+    return isDynamic() || m_saturation != 1.0;
 }
 
 void CDLOpData::validate() const
@@ -365,10 +448,19 @@ void CDLOpData::finalize()
     cacheIDStream.precision(DefaultValues::FLOAT_DECIMALS);
 
     cacheIDStream << GetStyleName(getStyle()) << " ";
-    cacheIDStream << getSlopeString() << " ";
-    cacheIDStream << getOffsetString() << " ";
-    cacheIDStream << getPowerString() << " ";
-    cacheIDStream << getSaturationString() << " ";
+
+    // Omit the values of a dynamic CDL as they could change.
+    if (isDynamic())
+    {
+        cacheIDStream << "dynamic ";
+    }
+    else
+    {
+        cacheIDStream << getSlopeString() << " ";
+        cacheIDStream << getOffsetString() << " ";
+        cacheIDStream << getPowerString() << " ";
+        cacheIDStream << getSaturationString() << " ";
+    }
 
     m_cacheID = cacheIDStream.str();
 }
@@ -763,4 +855,56 @@ OCIO_ADD_TEST(CDLOpData, channel)
   }
 }
 
+OCIO_ADD_TEST(CDLOpData, dynamic)
+{
+    OCIO::CDLOpData cdlOp;
+    OCIO_CHECK_ASSERT(!cdlOp.isDynamic());
+    OCIO_CHECK_ASSERT(!cdlOp.getCDLProperty());
+    OCIO_CHECK_ASSERT(!cdlOp.hasDynamicProperty(OCIO::DYNAMIC_PROPERTY_CDL));
+    OCIO_CHECK_THROW_WHAT(cdlOp.getDynamicProperty(OCIO::DYNAMIC_PROPERTY_CDL),
+                          OCIO::Exception, "CDL property is not dynamic");
+    OCIO_CHECK_ASSERT(cdlOp.isIdentity());
+
+    cdlOp.setSlopeParams(OCIO::CDLOpData::ChannelParams(1.1, 1.2, 1.3));
+    cdlOp.setSaturation(0.9);
+    cdlOp.makeDynamic();
+    OCIO_CHECK_ASSERT(cdlOp.isDynamic());
+    OCIO_CHECK_ASSERT(cdlOp.hasDynamicProperty(OCIO::DYNAMIC_PROPERTY_CDL));
+    OCIO_CHECK_ASSERT(!cdlOp.hasDynamicProperty(OCIO::DYNAMIC_PROPERTY_EXPOSURE));
+    OCIO_CHECK_THROW_WHAT(cdlOp.getDynamicProperty(OCIO::DYNAMIC_PROPERTY_EXPOSURE),
+                          OCIO::Exception, "not supported by CDL");
+
+    // The property is initialized with the parameters.
+    OCIO::DynamicPropertyRcPtr dp = cdlOp.getDynamicProperty(OCIO::DYNAMIC_PROPERTY_CDL);
+    double slope[3], offset[3], power[3], sat = 0.;
+    dp->getCDLValues(slope, offset, power, sat);
+    OCIO_CHECK_EQUAL(slope[1], 1.2);
+    OCIO_CHECK_EQUAL(offset[0], 0.0);
+    OCIO_CHECK_EQUAL(power[2], 1.0);
+    OCIO_CHECK_EQUAL(sat, 0.9);
+
+    // The values could change so a dynamic CDL is never an identity and
+    // the cache ID omits the values.
+    cdlOp.setSlopeParams(OCIO::kOneParams);
+    cdlOp.setSaturation(1.0);
+    OCIO_CHECK_ASSERT(!cdlOp.isIdentity());
+    OCIO_CHECK_ASSERT(!cdlOp.isNoOp());
+    OCIO_CHECK_ASSERT(cdlOp.hasChannelCrosstalk());
+    OCIO_CHECK_NO_THROW(cdlOp.finalize());
+    OCIO_CHECK_NE(cdlOp.getCacheID().find("dynamic"), std::string::npos);
+
+    // A copy has its own property.
+    OCIO::CDLOpDataRcPtr copy = cdlOp.clone();
+    OCIO_CHECK_ASSERT(copy->isDynamic());
+    OCIO_CHECK_NE(copy->getCDLProperty().get(), cdlOp.getCDLProperty().get());
+    OCIO_CHECK_ASSERT(*copy == cdlOp);
+
+    OCIO::CDLOpData other;
+    OCIO_CHECK_ASSERT(!(other == cdlOp));
+
+    OCIO::CDLOpDataRcPtr inv = cdlOp.inverse();
+    OCIO_CHECK_ASSERT(inv->isDynamic());
+    OCIO_CHECK_EQUAL(inv->getStyle(), OCIO::CDLOpData::CDL_V1_2_REV);
+}
+
 #endif
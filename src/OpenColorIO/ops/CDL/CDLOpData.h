@@ -141,6 +141,9 @@ public:
               const ChannelParams & powerParams,
               double saturation);
 
+    CDLOpData(const CDLOpData & rhs);
+    CDLOpData & operator=(const CDLOpData & rhs);
+
     virtual ~CDLOpData();
 
     CDLOpDataRcPtr clone() const;
@@ -168,6 +171,19 @@ public:
     double getSaturation() const { return m_saturation; }
     void setSaturation(const double saturation);
 
+    // When dynamic, the renderers use the current values of the dynamic property
+    // (initialized with the parameter values) instead of the parameters.
+    bool isDynamic() const { return (bool)m_cdlProperty; }
+    void makeDynamic();
+
+    bool hasDynamicProperty(DynamicPropertyType type) const;
+    DynamicPropertyRcPtr getDynamicProperty(DynamicPropertyType type) const;
+    void replaceDynamicProperty(DynamicPropertyType type,
+                                DynamicPropertyImplRcPtr prop);
+
+    // Null when not dynamic.
+    DynamicPropertyImplRcPtr getCDLProperty() const { return m_cdlProperty; }
+
     bool isNoOp() const override;
     bool isIdentity() const override;
 
@@ -177,6 +193,7 @@ public:
     OpDataRcPtr getIdentityReplacement() const;
 
     bool hasChannelCrosstalk() const override;
+    bool touchesAlpha() const override { return false; }
 
     virtual void validate() const override;
 
@@ -200,6 +217,8 @@ private:
     ChannelParams m_offsetParams;  // Offset parameters for RGB channels
     ChannelParams m_powerParams;   // Power parameters for RGB channels
     double        m_saturation;    // Saturation parameter
+
+    DynamicPropertyImplRcPtr m_cdlProperty; // Only when dynamic
 };
 
 }
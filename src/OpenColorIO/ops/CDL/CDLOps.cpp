@@ -8,6 +8,7 @@
 #include <OpenColorIO/OpenColorIO.h>
 
 #include "BitDepthUtils.h"
+#include "GpuShader.h"
 #include "GpuShaderUtils.h"
 #include "HashUtils.h"
 #include "MathUtils.h"
@@ -48,6 +49,7 @@ public:
     OpRcPtr clone() const override;
 
     std::string getInfo() const override;
+    double getCost() const override;
 
     bool isIdentity() const override;
     bool isSameType(ConstOpRcPtr & op) const override;
@@ -60,6 +62,12 @@ public:
     ConstOpCPURcPtr getCPUOp() const override;
 
     void extractGpuShaderInfo(GpuShaderDescRcPtr & shaderDesc) const override;
+
+    bool isDynamic() const override;
+    bool hasDynamicProperty(DynamicPropertyType type) const override;
+    DynamicPropertyRcPtr getDynamicProperty(DynamicPropertyType type) const override;
+    void replaceDynamicProperty(DynamicPropertyType type,
+                                DynamicPropertyImplRcPtr prop) override;
 	
 protected:
     ConstCDLOpDataRcPtr cdlData() const { return DynamicPtrCast<const CDLOpData>(data()); }
@@ -126,6 +134,12 @@ std::string CDLOp::getInfo() const
     return "<CDLOp>";
 }
 
+double CDLOp::getCost() const
+{
+    // A slope & offset, a power function per channel and the saturation.
+    return 6.0;
+}
+
 bool CDLOp::isIdentity() const
 {
     return cdlData()->isIdentity();
@@ -226,11 +240,44 @@ void CDLOp::extractGpuShaderInfo(GpuShaderDescRcPtr & shaderDesc) const
 
     // Since alpha is not affected, only need to use the RGB components
     ss.declareVec3f("lumaWeights", 0.2126f,   0.7152f,   0.0722f  );
-    ss.declareVec3f("slope",       slope [0], slope [1], slope [2]);
-    ss.declareVec3f("offset",      offset[0], offset[1], offset[2]);
-    ss.declareVec3f("power",       power [0], power [1], power [2]);
 
-    ss.declareVar("saturation" , saturation);
+    // When the uniform block is enabled, the values are members of the block.
+    const std::string prefix(shaderDesc->getResourcePrefix());
+    const float slope4[4] = { slope[0], slope[1], slope[2], 1.0f };
+
+    const std::string slopeName
+        = AddUniformBlockMember(*shaderDesc, prefix + "cdl_slope",
+                                GpuShaderDesc::UNIFORM_VEC4, slope4);
+
+    if (!slopeName.empty())
+    {
+        const float offset4[4] = { offset[0], offset[1], offset[2], 0.0f };
+        const float power4[4]  = { power[0],  power[1],  power[2],  1.0f };
+
+        const std::string offsetName
+            = AddUniformBlockMember(*shaderDesc, prefix + "cdl_offset",
+                                    GpuShaderDesc::UNIFORM_VEC4, offset4);
+        const std::string powerName
+            = AddUniformBlockMember(*shaderDesc, prefix + "cdl_power",
+                                    GpuShaderDesc::UNIFORM_VEC4, power4);
+        const std::string saturationName
+            = AddUniformBlockMember(*shaderDesc, prefix + "cdl_saturation",
+                                    GpuShaderDesc::UNIFORM_FLOAT, &saturation);
+
+        ss.newLine() << ss.vec3fDecl("slope")  << " = " << slopeName  << ".xyz;";
+        ss.newLine() << ss.vec3fDecl("offset") << " = " << offsetName << ".xyz;";
+        ss.newLine() << ss.vec3fDecl("power")  << " = " << powerName  << ".xyz;";
+
+        ss.declareVar("saturation", saturationName);
+    }
+    else
+    {
+        ss.declareVec3f("slope",       slope [0], slope [1], slope [2]);
+        ss.declareVec3f("offset",      offset[0], offset[1], offset[2]);
+        ss.declareVec3f("power",       power [0], power [1], power [2]);
+
+        ss.declareVar("saturation" , saturation);
+    }
 
     ss.newLine() << ss.vec3fDecl("pix") << " = "
                  << shaderDesc->getPixelName() << ".xyz;";
@@ -316,6 +363,27 @@ void CDLOp::extractGpuShaderInfo(GpuShaderDescRcPtr & shaderDesc) const
     shaderDesc->addToFunctionShaderCode(ss.string().c_str());
 }
 
+bool CDLOp::isDynamic() const
+{
+    return cdlData()->isDynamic();
+}
+
+bool CDLOp::hasDynamicProperty(DynamicPropertyType type) const
+{
+    return cdlData()->hasDynamicProperty(type);
+}
+
+DynamicPropertyRcPtr CDLOp::getDynamicProperty(DynamicPropertyType type) const
+{
+    return cdlData()->getDynamicProperty(type);
+}
+
+void CDLOp::replaceDynamicProperty(DynamicPropertyType type,
+                                   DynamicPropertyImplRcPtr prop)
+{
+    cdlData()->replaceDynamicProperty(type, prop);
+}
+
 }  // Anon namespace
 
 
@@ -377,6 +445,19 @@ void CreateCDLTransform(GroupTransformRcPtr & group, ConstOpRcPtr & op)
     cdlTransform->setSOP(vec9);
     cdlTransform->setSat(cdlData->getSaturation());
 
+    if (cdlData->isDynamic())
+    {
+        // Use the current values of the dynamic property.
+        double slope[3], offset[3], power[3], sat = 1.;
+        cdlData->getCDLProperty()->getCDLValues(slope, offset, power, sat);
+        cdlTransform->setSlope(slope);
+        cdlTransform->setOffset(offset);
+        cdlTransform->setPower(power);
+        cdlTransform->setSat(sat);
+
+        cdlTransform->makeDynamic();
+    }
+
     group->appendTransform(cdlTransform);
 }
 
@@ -444,6 +525,10 @@ void BuildCDLOps(OpRcPtrVec & ops,
             CDLOpData::ChannelParams(power4[0], power4[1], power4[2]),
             sat);
         cdlData->getFormatMetadata() = cdlTransform.getFormatMetadata();
+        if (cdlTransform.isDynamic())
+        {
+            cdlData->makeDynamic();
+        }
 
         CreateCDLOp(ops, 
                     cdlData,
@@ -1099,4 +1184,69 @@ OCIO_ADD_TEST(CDLOps, create_transform)
     OCIO_CHECK_EQUAL(cdlTransform->getSat(), CDL_DATA_1::saturation);
 }
 
+OCIO_ADD_TEST(CDLOps, apply_dynamic)
+{
+    // The values of a dynamic CDL could be changed once the op is finalized and the
+    // renderer created, the result then matching a CDL created with these values.
+    const double slope2[3]  = { 0.9,  1.1,  1.05 };
+    const double offset2[3] = { 0.02, -0.01, 0.0 };
+    const double power2[3]  = { 1.2,  0.8,  1.0  };
+    const double saturation2 = 0.7;
+
+    const float input_32f[] = {
+        0.3278f, 0.01f, 1.0f,  0.0f,
+        0.25f,   0.5f,  0.75f, 1.0f,
+       -0.2f,    0.5f,  1.4f,  0.5f };
+
+    for (auto style : { OCIO::CDLOpData::CDL_V1_2_FWD, OCIO::CDLOpData::CDL_NO_CLAMP_FWD,
+                        OCIO::CDLOpData::CDL_V1_2_REV, OCIO::CDLOpData::CDL_NO_CLAMP_REV })
+    {
+        OCIO::CDLOpDataRcPtr cdlData = std::make_shared<OCIO::CDLOpData>(
+            style,
+            OCIO::CDLOpData::ChannelParams(CDL_DATA_1::slope[0], CDL_DATA_1::slope[1],
+                                           CDL_DATA_1::slope[2]),
+            OCIO::CDLOpData::ChannelParams(CDL_DATA_1::offset[0], CDL_DATA_1::offset[1],
+                                           CDL_DATA_1::offset[2]),
+            OCIO::CDLOpData::ChannelParams(CDL_DATA_1::power[0], CDL_DATA_1::power[1],
+                                           CDL_DATA_1::power[2]),
+            CDL_DATA_1::saturation);
+        cdlData->makeDynamic();
+
+        OCIO::CDLOp dynOp(cdlData, OCIO::TRANSFORM_DIR_FORWARD);
+        OCIO_CHECK_NO_THROW(dynOp.finalize(OCIO::FINALIZATION_EXACT));
+        OCIO_CHECK_ASSERT(dynOp.isDynamic());
+        OCIO_CHECK_ASSERT(dynOp.hasDynamicProperty(OCIO::DYNAMIC_PROPERTY_CDL));
+
+        OCIO::ConstOpCPURcPtr cpuOp = dynOp.getCPUOp();
+        OCIO_REQUIRE_ASSERT(cpuOp->hasDynamicProperty(OCIO::DYNAMIC_PROPERTY_CDL));
+        OCIO::DynamicPropertyRcPtr dp = dynOp.getDynamicProperty(OCIO::DYNAMIC_PROPERTY_CDL);
+        OCIO_CHECK_EQUAL(dp.get(), cpuOp->getDynamicProperty(OCIO::DYNAMIC_PROPERTY_CDL).get());
+
+        for (int change = 0; change < 2; ++change)
+        {
+            if (change == 1)
+            {
+                dp->setCDLValues(slope2, offset2, power2, saturation2);
+            }
+
+            OCIO::CDLOp refOp(style,
+                              change ? slope2 : CDL_DATA_1::slope,
+                              change ? offset2 : CDL_DATA_1::offset,
+                              change ? power2 : CDL_DATA_1::power,
+                              change ? saturation2 : CDL_DATA_1::saturation,
+                              OCIO::TRANSFORM_DIR_FORWARD);
+            OCIO_CHECK_NO_THROW(refOp.finalize(OCIO::FINALIZATION_EXACT));
+
+            float dyn_32f[12], ref_32f[12];
+            cpuOp->apply(input_32f, dyn_32f, 3);
+            refOp.apply(input_32f, ref_32f, 3);
+
+            for (unsigned idx = 0; idx < 12; ++idx)
+            {
+                OCIO_CHECK_EQUAL(dyn_32f[idx], ref_32f[idx]);
+            }
+        }
+    }
+}
+
 #endif
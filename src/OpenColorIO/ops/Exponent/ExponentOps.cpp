@@ -12,6 +12,7 @@
 #include "ExponentOps.h"
 #include "GpuShaderUtils.h"
 #include "MathUtils.h"
+#include "SSE.h"
 
 OCIO_NAMESPACE_ENTER
 {
@@ -50,6 +51,7 @@ OCIO_NAMESPACE_ENTER
         {
             OpData::operator=(rhs);
             memcpy(m_exp4, rhs.m_exp4, sizeof(double)*4);
+            m_fastMath = rhs.m_fastMath;
         }
 
         return *this;
@@ -117,6 +119,48 @@ OCIO_NAMESPACE_ENTER
             }
         }
 
+#ifdef USE_SSE
+        // Renderer using the fast math approximation of the power function
+        // (refer to SetCPUFastMath()). The exponents must be positive.
+        class ExponentFastOpCPU : public OpCPU
+        {
+        public:
+            ExponentFastOpCPU(ConstExponentOpDataRcPtr exp);
+            virtual ~ExponentFastOpCPU() {}
+
+            void apply(const void * inImg, void * outImg, long numPixels) const override;
+
+        private:
+            __m128 m_exp;
+            // The channels having an exponent of one are only clamped.
+            __m128 m_isOne;
+        };
+
+        ExponentFastOpCPU::ExponentFastOpCPU(ConstExponentOpDataRcPtr exp)
+            : OpCPU()
+        {
+            m_exp = _mm_set_ps(float(exp->m_exp4[3]), float(exp->m_exp4[2]),
+                               float(exp->m_exp4[1]), float(exp->m_exp4[0]));
+            m_isOne = _mm_cmpeq_ps(m_exp, _mm_set1_ps(1.0f));
+        }
+
+        void ExponentFastOpCPU::apply(const void * inImg, void * outImg, long numPixels) const
+        {
+            const float * in = (const float *)inImg;
+            float * out = (float *)outImg;
+
+            for(long pixelIndex=0; pixelIndex<numPixels; ++pixelIndex)
+            {
+                const __m128 pixel = _mm_max_ps(_mm_loadu_ps(in), EZERO);
+
+                _mm_storeu_ps(out, sseSelect(m_isOne, pixel, ssePowerFast(pixel, m_exp)));
+
+                in  += 4;
+                out += 4;
+            }
+        }
+#endif
+
         class ExponentOp : public Op
         {
         public:
@@ -133,6 +177,7 @@ OCIO_NAMESPACE_ENTER
             OpRcPtr clone() const override;
 
             std::string getInfo() const override;
+            double getCost() const override;
 
             bool isSameType(ConstOpRcPtr & op) const override;
             bool isInverse(ConstOpRcPtr & op) const override;
@@ -180,6 +225,12 @@ OCIO_NAMESPACE_ENTER
             return "<ExponentOp>";
         }
 
+        double ExponentOp::getCost() const
+        {
+            // One power function per channel.
+            return 4.0;
+        }
+
         bool ExponentOp::isSameType(ConstOpRcPtr & op) const
         {
             ConstExponentOpRcPtr typedRcPtr = DynamicPtrCast<const ExponentOp>(op);
@@ -237,20 +288,34 @@ OCIO_NAMESPACE_ENTER
             }
         }
 
-        void ExponentOp::finalize(FinalizationFlags /*fFlags*/)
+        void ExponentOp::finalize(FinalizationFlags fFlags)
         {
+            expData()->m_fastMath = fFlags==FINALIZATION_FAST && IsCPUFastMath();
+
             expData()->finalize();
 
             // Create the cacheID
             std::ostringstream cacheIDStream;
             cacheIDStream << "<ExponentOp ";
             cacheIDStream << expData()->getCacheID() << " ";
+            if (expData()->m_fastMath)
+            {
+                cacheIDStream << "fast ";
+            }
             cacheIDStream << ">";
             m_cacheID = cacheIDStream.str();
         }
 
         ConstOpCPURcPtr ExponentOp::getCPUOp() const
         {
+#ifdef USE_SSE
+            const double * exp4 = expData()->m_exp4;
+            if (expData()->m_fastMath
+                && exp4[0] > 0. && exp4[1] > 0. && exp4[2] > 0. && exp4[3] > 0.)
+            {
+                return std::make_shared<ExponentFastOpCPU>(expData());
+            }
+#endif
             return std::make_shared<ExponentOpCPU>(expData());
         }
 
@@ -665,6 +730,48 @@ OCIO_ADD_TEST(ExponentOps, CacheID)
     OCIO_CHECK_NE(opCacheID0, opCacheID1);
 }
 
+OCIO_ADD_TEST(ExponentOps, FastMath)
+{
+    const double exp1[4] = { 2.2, 1.0 / 2.4, 2.6, 1.0 };
+
+    OCIO::OpRcPtrVec ops;
+    OCIO_CHECK_NO_THROW(OCIO::CreateExponentOp(ops, exp1, OCIO::TRANSFORM_DIR_FORWARD));
+    OCIO_CHECK_NO_THROW(OCIO::CreateExponentOp(ops, exp1, OCIO::TRANSFORM_DIR_FORWARD));
+    OCIO_REQUIRE_EQUAL(ops.size(), 2);
+
+    OCIO_CHECK_ASSERT(!OCIO::IsCPUFastMath());
+    OCIO::SetCPUFastMath(true);
+    OCIO_CHECK_NO_THROW(ops[0]->finalize(OCIO::FINALIZATION_EXACT));
+    OCIO_CHECK_NO_THROW(ops[1]->finalize(OCIO::FINALIZATION_FAST));
+    OCIO::SetCPUFastMath(false);
+
+    // The fast math is only used by the fast finalization.
+    OCIO_CHECK_NE(ops[0]->getCacheID(), ops[1]->getCacheID());
+
+    const long numPixels = 64;
+    std::vector<float> ref(numPixels * 4);
+    for (size_t idx = 0; idx < ref.size(); ++idx)
+    {
+        ref[idx] = float(idx) * 0.01f - 0.5f;
+    }
+    std::vector<float> res(ref);
+
+    ops[0]->apply(&ref[0], numPixels);
+    ops[1]->apply(&res[0], numPixels);
+
+    for (long idx = 0; idx < numPixels; ++idx)
+    {
+        // Refer to SetCPUFastMath() for the error bound.
+        for (long c = 0; c < 3; ++c)
+        {
+            OCIO_CHECK_CLOSE(res[4 * idx + c], ref[4 * idx + c],
+                             5e-4f * std::max(1.0f, ref[4 * idx + c]));
+        }
+        // The alpha exponent of one is exact.
+        OCIO_CHECK_EQUAL(res[4 * idx + 3], ref[4 * idx + 3]);
+    }
+}
+
 OCIO_ADD_TEST(ExponentOps, create_transform)
 {
     const double exp[4] = { 2.0, 2.1, 3.0, 3.1 };
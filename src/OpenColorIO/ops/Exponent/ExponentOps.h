@@ -34,6 +34,10 @@ OCIO_NAMESPACE_ENTER
 
         double m_exp4[4];
 
+        // The CPU renderer uses faster but less accurate approximations of the math
+        // functions when true (refer to SetCPUFastMath()).
+        bool m_fastMath = false;
+
         virtual void finalize() override;
     };
 
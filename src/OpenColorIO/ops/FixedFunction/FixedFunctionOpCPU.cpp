@@ -8,6 +8,9 @@
 
 #include "BitDepthUtils.h"
 #include "ops/FixedFunction/FixedFunctionOpCPU.h"
+#include "ops/Matrix/MatrixOpData.h"
+#include "ops/Range/RangeOpData.h"
+#include "SSE.h"
 
 
 OCIO_NAMESPACE_ENTER
@@ -145,6 +148,21 @@ __inline float CalcSatWeight(const float red, const float grn, const float blu,
     return sat;
 }
 
+#ifdef USE_SSE
+// SSE version of CalcSatWeight() i.e. processing four pixels at a time.
+inline __m128 sseCalcSatWeight(const __m128 red, const __m128 grn, const __m128 blu,
+                               const __m128 noiseLimit)
+{
+    const __m128 minVal = _mm_min_ps( red, _mm_min_ps( grn, blu ) );
+    const __m128 maxVal = _mm_max_ps( red, _mm_max_ps( grn, blu ) );
+
+    const __m128 lowLimit = _mm_set1_ps(1e-10f);
+    return _mm_div_ps( _mm_sub_ps( _mm_max_ps( maxVal, lowLimit ),
+                                   _mm_max_ps( minVal, lowLimit ) ),
+                       _mm_max_ps( maxVal, noiseLimit ) );
+}
+#endif
+
 Renderer_ACES_RedMod03_Fwd::Renderer_ACES_RedMod03_Fwd(ConstFixedFunctionOpDataRcPtr & func)
     :   FixedFunctionOpCPU(func)
 {
@@ -208,11 +226,136 @@ __inline float CalcHueWeight(const float red, const float grn, const float blu,
     return f_H;
 }
 
+#ifdef USE_SSE
+// SSE version of CalcHueWeight() i.e. processing four pixels at a time. Note that
+// the arc tangent is an approximation (refer to sseAtan2()).
+inline __m128 sseCalcHueWeight(const __m128 red, const __m128 grn, const __m128 blu,
+                               const __m128 inv_width)
+{
+    // Convert RGB to Yab (luma/chroma).
+    const __m128 a = _mm_sub_ps( _mm_mul_ps( _mm_set1_ps(2.f), red ), _mm_add_ps( grn, blu ) );
+    const __m128 b = _mm_mul_ps( _mm_set1_ps(1.7320508075688772f), _mm_sub_ps( grn, blu ) );
+
+    const __m128 hue = sseAtan2(b, a);
+
+    // Determine normalized input coords to B-spline.
+    const __m128 knot_coord = _mm_add_ps( _mm_mul_ps( hue, inv_width ), _mm_set1_ps(2.f) );
+    const __m128i j = _mm_cvttps_epi32(knot_coord);
+
+    const __m128 t = _mm_sub_ps( knot_coord, _mm_cvtepi32_ps(j) );
+
+    // Select the coefficients of the quadratic B-spline basis function (refer to
+    // CalcHueWeight()), all the coefficients being zero outside of the hue window.
+    const __m128 isJ0 = _mm_castsi128_ps( _mm_cmpeq_epi32( j, _mm_set1_epi32(0) ) );
+    const __m128 isJ1 = _mm_castsi128_ps( _mm_cmpeq_epi32( j, _mm_set1_epi32(1) ) );
+    const __m128 isJ2 = _mm_castsi128_ps( _mm_cmpeq_epi32( j, _mm_set1_epi32(2) ) );
+    const __m128 isJ3 = _mm_castsi128_ps( _mm_cmpeq_epi32( j, _mm_set1_epi32(3) ) );
+
+    const auto coef = [&](float c0, float c1, float c2, float c3)
+    {
+        return _mm_or_ps( _mm_or_ps( _mm_and_ps( isJ0, _mm_set1_ps(c0) ),
+                                     _mm_and_ps( isJ1, _mm_set1_ps(c1) ) ),
+                          _mm_or_ps( _mm_and_ps( isJ2, _mm_set1_ps(c2) ),
+                                     _mm_and_ps( isJ3, _mm_set1_ps(c3) ) ) );
+    };
+
+    const __m128 coef0 = coef( 0.25f, -0.75f,  0.75f, -0.25f);
+    const __m128 coef1 = coef( 0.00f,  0.75f, -1.50f,  0.75f);
+    const __m128 coef2 = coef( 0.00f,  0.75f,  0.00f, -0.75f);
+    const __m128 coef3 = coef( 0.00f,  0.25f,  1.00f,  0.25f);
+
+    return _mm_add_ps( coef3,
+                       _mm_mul_ps( t,
+                                   _mm_add_ps( coef2,
+                                               _mm_mul_ps( t,
+                                                           _mm_add_ps( coef1,
+                                                                       _mm_mul_ps( t, coef0 ) ) ) ) ) );
+}
+
+// Restore the hue after the red channel modification (refer to the RedMod03 renderers).
+inline void sseRestoreHue(const __m128 apply, const __m128 red, const __m128 newRed,
+                          __m128 & grn, __m128 & blu)
+{
+    const __m128 lowLimit = _mm_set1_ps(1e-10f);
+
+    // red >= grn >= blu
+    const __m128 grnHueFac = _mm_div_ps( _mm_sub_ps( grn, blu ),
+                                         _mm_max_ps( _mm_sub_ps( red, blu ), lowLimit ) );
+    const __m128 newGrn = _mm_add_ps( _mm_mul_ps( grnHueFac, _mm_sub_ps( newRed, blu ) ), blu );
+
+    // red >= blu >= grn
+    const __m128 bluHueFac = _mm_div_ps( _mm_sub_ps( blu, grn ),
+                                         _mm_max_ps( _mm_sub_ps( red, grn ), lowLimit ) );
+    const __m128 newBlu = _mm_add_ps( _mm_mul_ps( bluHueFac, _mm_sub_ps( newRed, grn ) ), grn );
+
+    const __m128 isGrnMid = _mm_cmpge_ps( grn, blu );
+    grn = sseSelect( _mm_and_ps( apply, isGrnMid ), newGrn, grn );
+    blu = sseSelect( _mm_andnot_ps( isGrnMid, apply ), newBlu, blu );
+}
+
+// Compute the red channel of the inverse red modifier (refer to the RedMod inverse renderers).
+inline __m128 sseInvRedMod(const __m128 red, const __m128 grn, const __m128 blu,
+                           const __m128 f_H, const __m128 pivot, const __m128 oneMinusScale)
+{
+    const __m128 minChan = _mm_min_ps( grn, blu );
+
+    const __m128 a = _mm_sub_ps( _mm_mul_ps( f_H, oneMinusScale ), EONE );
+    const __m128 b = _mm_sub_ps( red,
+                                 _mm_mul_ps( _mm_mul_ps( f_H, _mm_add_ps( pivot, minChan ) ),
+                                             oneMinusScale ) );
+    const __m128 c = _mm_mul_ps( _mm_mul_ps( _mm_mul_ps( f_H, pivot ), minChan ), oneMinusScale );
+
+    const __m128 minusB = _mm_xor_ps( b, ESIGN_MASK );
+    const __m128 disc = _mm_sub_ps( _mm_mul_ps( b, b ),
+                                    _mm_mul_ps( _mm_mul_ps( _mm_set1_ps(4.f), a ), c ) );
+
+    return _mm_div_ps( _mm_sub_ps( minusB, _mm_sqrt_ps(disc) ),
+                       _mm_mul_ps( _mm_set1_ps(2.f), a ) );
+}
+
+// Apply the forward red modifier to four transposed pixels, the hue being only restored
+// by the ACES 0.3/0.7 style (refer to the RedMod forward renderers).
+template<bool restoreHue>
+inline void sseRedModFwd(__m128 & red, __m128 & grn, __m128 & blu,
+                         const __m128 inv_width, const __m128 noiseLimit,
+                         const __m128 pivot, const __m128 oneMinusScale)
+{
+    const __m128 f_H = sseCalcHueWeight(red, grn, blu, inv_width);
+    const __m128 f_S = sseCalcSatWeight(red, grn, blu, noiseLimit);
+
+    const __m128 newRed
+        = _mm_add_ps( red,
+                      _mm_mul_ps( _mm_mul_ps( _mm_mul_ps( f_H, f_S ),
+                                              _mm_sub_ps( pivot, red ) ),
+                                  oneMinusScale ) );
+
+    // Hue is in range of the window, apply mod.
+    const __m128 apply = _mm_cmpgt_ps( f_H, EZERO );
+
+    if (restoreHue)
+    {
+        sseRestoreHue(apply, red, newRed, grn, blu);
+    }
+    red = sseSelect( apply, newRed, red );
+}
+#endif
+
 void Renderer_ACES_RedMod03_Fwd::apply(const void * inImg, void * outImg, long numPixels) const
 {
     const float * in = (const float *)inImg;
     float * out = (float *)outImg;
 
+#ifdef USE_SSE
+    const __m128 inv_width     = _mm_set1_ps(m_inv_width);
+    const __m128 noiseLimit    = _mm_set1_ps(m_noiseLimit);
+    const __m128 pivot         = _mm_set1_ps(m_pivot);
+    const __m128 oneMinusScale = _mm_set1_ps(m_1minusScale);
+
+    sseApplyTransposedRGB(in, out, numPixels, [&](__m128 & red, __m128 & grn, __m128 & blu)
+    {
+        sseRedModFwd<true>(red, grn, blu, inv_width, noiseLimit, pivot, oneMinusScale);
+    });
+#else
     for(long idx=0; idx<numPixels; ++idx)
     {
         float red = in[0];
@@ -257,6 +400,7 @@ void Renderer_ACES_RedMod03_Fwd::apply(const void * inImg, void * outImg, long n
         in  += 4;
         out += 4;
     }
+#endif
 }
 
 Renderer_ACES_RedMod03_Inv::Renderer_ACES_RedMod03_Inv(ConstFixedFunctionOpDataRcPtr & func)
@@ -269,6 +413,23 @@ void Renderer_ACES_RedMod03_Inv::apply(const void * inImg, void * outImg, long n
     const float * in = (const float *)inImg;
     float * out = (float *)outImg;
 
+#ifdef USE_SSE
+    const __m128 inv_width     = _mm_set1_ps(m_inv_width);
+    const __m128 pivot         = _mm_set1_ps(m_pivot);
+    const __m128 oneMinusScale = _mm_set1_ps(m_1minusScale);
+
+    sseApplyTransposedRGB(in, out, numPixels, [&](__m128 & red, __m128 & grn, __m128 & blu)
+    {
+        const __m128 f_H = sseCalcHueWeight(red, grn, blu, inv_width);
+
+        const __m128 newRed = sseInvRedMod(red, grn, blu, f_H, pivot, oneMinusScale);
+
+        const __m128 apply = _mm_cmpgt_ps( f_H, EZERO );
+
+        sseRestoreHue(apply, red, newRed, grn, blu);
+        red = sseSelect( apply, newRed, red );
+    });
+#else
     for(long idx=0; idx<numPixels; ++idx)
     {
         float red = in[0];
@@ -309,6 +470,7 @@ void Renderer_ACES_RedMod03_Inv::apply(const void * inImg, void * outImg, long n
         in  += 4;
         out += 4;
     }
+#endif
 }
 
 Renderer_ACES_RedMod10_Fwd::Renderer_ACES_RedMod10_Fwd(ConstFixedFunctionOpDataRcPtr & func)
@@ -331,6 +493,17 @@ void Renderer_ACES_RedMod10_Fwd::apply(const void * inImg, void * outImg, long n
     const float * in = (const float *)inImg;
     float * out = (float *)outImg;
 
+#ifdef USE_SSE
+    const __m128 inv_width     = _mm_set1_ps(m_inv_width);
+    const __m128 noiseLimit    = _mm_set1_ps(m_noiseLimit);
+    const __m128 pivot         = _mm_set1_ps(m_pivot);
+    const __m128 oneMinusScale = _mm_set1_ps(m_1minusScale);
+
+    sseApplyTransposedRGB(in, out, numPixels, [&](__m128 & red, __m128 & grn, __m128 & blu)
+    {
+        sseRedModFwd<false>(red, grn, blu, inv_width, noiseLimit, pivot, oneMinusScale);
+    });
+#else
     for(long idx=0; idx<numPixels; ++idx)
     {
         float red = in[0];
@@ -361,6 +534,7 @@ void Renderer_ACES_RedMod10_Fwd::apply(const void * inImg, void * outImg, long n
         in  += 4;
         out += 4;
     }
+#endif
 }
 
 Renderer_ACES_RedMod10_Inv::Renderer_ACES_RedMod10_Inv(ConstFixedFunctionOpDataRcPtr & func)
@@ -373,6 +547,20 @@ void Renderer_ACES_RedMod10_Inv::apply(const void * inImg, void * outImg, long n
     const float * in = (const float *)inImg;
     float * out = (float *)outImg;
 
+#ifdef USE_SSE
+    const __m128 inv_width     = _mm_set1_ps(m_inv_width);
+    const __m128 pivot         = _mm_set1_ps(m_pivot);
+    const __m128 oneMinusScale = _mm_set1_ps(m_1minusScale);
+
+    sseApplyTransposedRGB(in, out, numPixels, [&](__m128 & red, __m128 & grn, __m128 & blu)
+    {
+        const __m128 f_H = sseCalcHueWeight(red, grn, blu, inv_width);
+
+        const __m128 newRed = sseInvRedMod(red, grn, blu, f_H, pivot, oneMinusScale);
+
+        red = sseSelect( _mm_cmpgt_ps( f_H, EZERO ), newRed, red );
+    });
+#else
     for(long idx=0; idx<numPixels; ++idx)
     {
         float red = in[0];
@@ -400,6 +588,7 @@ void Renderer_ACES_RedMod10_Inv::apply(const void * inImg, void * outImg, long n
         in  += 4;
         out += 4;
     }
+#endif
 }
 
 Renderer_ACES_Glow03_Fwd::Renderer_ACES_Glow03_Fwd(ConstFixedFunctionOpDataRcPtr & func,
@@ -431,11 +620,78 @@ __inline float SigmoidShaper(const float sat)
     return s;
 }
 
+#ifdef USE_SSE
+// SSE version of rgbToYC() i.e. processing four pixels at a time.
+inline __m128 sseRgbToYC(const __m128 red, const __m128 grn, const __m128 blu)
+{
+    const __m128 YCRadiusWeight = _mm_set1_ps(1.75f);
+    const __m128 chroma
+        = _mm_sqrt_ps( _mm_add_ps( _mm_add_ps( _mm_mul_ps( blu, _mm_sub_ps( blu, grn ) ),
+                                               _mm_mul_ps( grn, _mm_sub_ps( grn, red ) ) ),
+                                   _mm_mul_ps( red, _mm_sub_ps( red, blu ) ) ) );
+    return _mm_div_ps( _mm_add_ps( _mm_add_ps( _mm_add_ps( blu, grn ), red ),
+                                   _mm_mul_ps( YCRadiusWeight, chroma ) ),
+                       _mm_set1_ps(3.f) );
+}
+
+// SSE version of SigmoidShaper() i.e. processing four pixels at a time.
+inline __m128 sseSigmoidShaper(const __m128 sat)
+{
+    const __m128 x = _mm_mul_ps( _mm_sub_ps( sat, _mm_set1_ps(0.4f) ), _mm_set1_ps(5.f) );
+    const __m128 sign = _mm_or_ps( _mm_and_ps( x, ESIGN_MASK ), EONE );
+    const __m128 t
+        = _mm_max_ps( _mm_sub_ps( EONE, _mm_mul_ps( _mm_mul_ps( _mm_set1_ps(0.5f), sign ), x ) ),
+                      EZERO );
+    return _mm_mul_ps( _mm_add_ps( EONE, _mm_mul_ps( sign, _mm_sub_ps( EONE, _mm_mul_ps( t, t ) ) ) ),
+                       _mm_set1_ps(0.5f) );
+}
+
+// Apply the forward glow to four transposed pixels (refer to Renderer_ACES_Glow03_Fwd).
+inline void sseGlowFwd(__m128 & red, __m128 & grn, __m128 & blu,
+                       const __m128 noiseLimit, const __m128 glowGain, const __m128 glowMid,
+                       const __m128 lowLimit, const __m128 highLimit)
+{
+    // NB: YC is at inScale.
+    const __m128 YC = sseRgbToYC(red, grn, blu);
+
+    const __m128 sat = sseCalcSatWeight(red, grn, blu, noiseLimit);
+
+    const __m128 s = sseSigmoidShaper(sat);
+
+    const __m128 GlowGain = _mm_mul_ps( glowGain, s );
+
+    // Apply FwdGlow.
+    __m128 glowGainOut
+        = _mm_mul_ps( GlowGain, _mm_sub_ps( _mm_div_ps( glowMid, YC ), _mm_set1_ps(0.5f) ) );
+    glowGainOut = sseSelect( _mm_cmple_ps( YC, lowLimit ), GlowGain, glowGainOut );
+    glowGainOut = _mm_andnot_ps( _mm_cmpge_ps( YC, highLimit ), glowGainOut );
+
+    // Calculate glow factor.
+    const __m128 addedGlow = _mm_add_ps( EONE, glowGainOut );
+
+    red = _mm_mul_ps( red, addedGlow );
+    grn = _mm_mul_ps( grn, addedGlow );
+    blu = _mm_mul_ps( blu, addedGlow );
+}
+#endif
+
 void Renderer_ACES_Glow03_Fwd::apply(const void * inImg, void * outImg, long numPixels) const
 {
     const float * in = (const float *)inImg;
     float * out = (float *)outImg;
 
+#ifdef USE_SSE
+    const __m128 noiseLimit = _mm_set1_ps(m_noiseLimit);
+    const __m128 glowGain   = _mm_set1_ps(m_glowGain);
+    const __m128 glowMid    = _mm_set1_ps(m_glowMid);
+    const __m128 highLimit  = _mm_set1_ps(m_glowMid * 2.f);
+    const __m128 lowLimit   = _mm_set1_ps(m_glowMid * 2.f / 3.f);
+
+    sseApplyTransposedRGB(in, out, numPixels, [&](__m128 & red, __m128 & grn, __m128 & blu)
+    {
+        sseGlowFwd(red, grn, blu, noiseLimit, glowGain, glowMid, lowLimit, highLimit);
+    });
+#else
     for(long idx=0; idx<numPixels; ++idx)
     {
         const float red = in[0];
@@ -478,6 +734,7 @@ void Renderer_ACES_Glow03_Fwd::apply(const void * inImg, void * outImg, long num
         in  += 4;
         out += 4;
     }
+#endif
 }
 
 Renderer_ACES_Glow03_Inv::Renderer_ACES_Glow03_Inv(ConstFixedFunctionOpDataRcPtr & func,
@@ -492,6 +749,46 @@ void Renderer_ACES_Glow03_Inv::apply(const void * inImg, void * outImg, long num
     const float * in = (const float *)inImg;
     float * out = (float *)outImg;
 
+#ifdef USE_SSE
+    const __m128 noiseLimit = _mm_set1_ps(m_noiseLimit);
+    const __m128 glowGain   = _mm_set1_ps(m_glowGain);
+    const __m128 glowMid    = _mm_set1_ps(m_glowMid);
+    const __m128 highLimit  = _mm_set1_ps(m_glowMid * 2.f);
+    const __m128 half       = _mm_set1_ps(0.5f);
+
+    sseApplyTransposedRGB(in, out, numPixels, [&](__m128 & red, __m128 & grn, __m128 & blu)
+    {
+        // NB: YC is at inScale.
+        const __m128 YC = sseRgbToYC(red, grn, blu);
+
+        const __m128 sat = sseCalcSatWeight(red, grn, blu, noiseLimit);
+
+        const __m128 s = sseSigmoidShaper(sat);
+
+        const __m128 GlowGain = _mm_mul_ps( glowGain, s );
+        const __m128 onePlusGlowGain = _mm_add_ps( EONE, GlowGain );
+
+        const __m128 lowLimit
+            = _mm_div_ps( _mm_mul_ps( _mm_mul_ps( onePlusGlowGain, glowMid ), _mm_set1_ps(2.f) ),
+                          _mm_set1_ps(3.f) );
+
+        // Apply InvGlow.
+        __m128 glowGainOut
+            = _mm_div_ps( _mm_mul_ps( GlowGain, _mm_sub_ps( _mm_div_ps( glowMid, YC ), half ) ),
+                          _mm_sub_ps( _mm_mul_ps( GlowGain, half ), EONE ) );
+        glowGainOut = sseSelect( _mm_cmple_ps( YC, lowLimit ),
+                                 _mm_div_ps( _mm_xor_ps( GlowGain, ESIGN_MASK ), onePlusGlowGain ),
+                                 glowGainOut );
+        glowGainOut = _mm_andnot_ps( _mm_cmpge_ps( YC, highLimit ), glowGainOut );
+
+        // Calculate glow factor.
+        const __m128 reducedGlow = _mm_add_ps( EONE, glowGainOut );
+
+        red = _mm_mul_ps( red, reducedGlow );
+        grn = _mm_mul_ps( grn, reducedGlow );
+        blu = _mm_mul_ps( blu, reducedGlow );
+    });
+#else
     for(long idx=0; idx<numPixels; ++idx)
     {
         const float red = in[0];
@@ -534,6 +831,7 @@ void Renderer_ACES_Glow03_Inv::apply(const void * inImg, void * outImg, long num
         in  += 4;
         out += 4;
     }
+#endif
 }
 
 Renderer_ACES_DarkToDim10_Fwd::Renderer_ACES_DarkToDim10_Fwd(ConstFixedFunctionOpDataRcPtr & func,
@@ -549,6 +847,26 @@ void Renderer_ACES_DarkToDim10_Fwd::apply(const void * inImg, void * outImg, lon
     const float * in = (const float *)inImg;
     float * out = (float *)outImg;
 
+#ifdef USE_SSE
+    const __m128 gamma  = _mm_set1_ps(m_gamma);
+    const __m128 minLum = _mm_set1_ps(1e-10f);
+
+    sseApplyTransposedRGB(in, out, numPixels, [&](__m128 & red, __m128 & grn, __m128 & blu)
+    {
+        // Calculate luminance assuming input is AP1 RGB.
+        const __m128 Y
+            = _mm_max_ps( _mm_add_ps( _mm_add_ps( _mm_mul_ps( _mm_set1_ps(0.27222871678091454f), red ),
+                                                  _mm_mul_ps( _mm_set1_ps(0.67408176581114831f), grn ) ),
+                                      _mm_mul_ps( _mm_set1_ps(0.053689517407937051f), blu ) ),
+                          minLum );
+
+        const __m128 Ypow_over_Y = ssePower(Y, gamma);
+
+        red = _mm_mul_ps( red, Ypow_over_Y );
+        grn = _mm_mul_ps( grn, Ypow_over_Y );
+        blu = _mm_mul_ps( blu, Ypow_over_Y );
+    });
+#else
     for(long idx=0; idx<numPixels; ++idx)
     {
         const float red = in[0];
@@ -565,8 +883,6 @@ void Renderer_ACES_DarkToDim10_Fwd::apply(const void * inImg, void * outImg, lon
                                             0.67408176581114831f  * grn + 
                                             0.053689517407937051f * blu ) );
 
-        // TODO: Currently our fast approx. requires SSE registers.
-        //       Either make this whole routine SSE or make fast scalar pow.
         const float Ypow_over_Y = powf(Y, m_gamma);
 
         out[0] = red * Ypow_over_Y;
@@ -577,6 +893,7 @@ void Renderer_ACES_DarkToDim10_Fwd::apply(const void * inImg, void * outImg, lon
         in  += 4;
         out += 4;
     }
+#endif
 }
 
 Renderer_REC2100_Surround::Renderer_REC2100_Surround(ConstFixedFunctionOpDataRcPtr & func)
@@ -594,6 +911,27 @@ void Renderer_REC2100_Surround::apply(const void * inImg, void * outImg, long nu
     const float * in = (const float *)inImg;
     float * out = (float *)outImg;
 
+#ifdef USE_SSE
+    const __m128 gamma  = _mm_set1_ps(m_gamma);
+    // Refer to the scalar version below for the threshold.
+    const __m128 minLum = _mm_set1_ps(1e-4f);
+
+    sseApplyTransposedRGB(in, out, numPixels, [&](__m128 & red, __m128 & grn, __m128 & blu)
+    {
+        // Calculate luminance assuming input is Rec.2100 RGB.
+        const __m128 Y
+            = _mm_max_ps( _mm_add_ps( _mm_add_ps( _mm_mul_ps( _mm_set1_ps(0.2627f), red ),
+                                                  _mm_mul_ps( _mm_set1_ps(0.6780f), grn ) ),
+                                      _mm_mul_ps( _mm_set1_ps(0.0593f), blu ) ),
+                          minLum );
+
+        const __m128 Ypow_over_Y = ssePower(Y, gamma);
+
+        red = _mm_mul_ps( red, Ypow_over_Y );
+        grn = _mm_mul_ps( grn, Ypow_over_Y );
+        blu = _mm_mul_ps( blu, Ypow_over_Y );
+    });
+#else
     for(long idx=0; idx<numPixels; ++idx)
     {
         const float red = in[0];
@@ -614,8 +952,6 @@ void Renderer_REC2100_Surround::apply(const void * inImg, void * outImg, long nu
                                             0.6780f * grn + 
                                             0.0593f * blu ) );
 
-        // TODO: Currently our fast approx. requires SSE registers.
-        //       Either make this whole routine SSE or make fast scalar pow.
         const float Ypow_over_Y = powf(Y, m_gamma);
 
         out[0] = red * Ypow_over_Y;
@@ -626,6 +962,7 @@ void Renderer_REC2100_Surround::apply(const void * inImg, void * outImg, long nu
         in  += 4;
         out += 4;
     }
+#endif
 }
 
 
@@ -688,6 +1025,278 @@ ConstOpCPURcPtr GetFixedFunctionCPURenderer(ConstFixedFunctionOpDataRcPtr & func
     throw Exception("Unsupported FixedFunction style");
 }
 
+
+#ifdef USE_SSE
+
+namespace
+{
+
+// The constants of the ACES 0.3/0.7 forward glow & red modifier styles
+// (refer to the individual renderers).
+struct ACES03Constants
+{
+    static constexpr float noiseLimit    = 1e-2f;
+
+    static constexpr float glowGain      = 0.075f;
+    static constexpr float glowMid       = 0.1f;
+
+    static constexpr bool  restoreHue    = true;
+    static constexpr float oneMinusScale = 1.f - 0.85f;
+    static constexpr float pivot         = 0.03f;
+    static constexpr float invWidth      = 1.9098593171027443f;
+};
+
+// The constants of the ACES 1.0 forward glow & red modifier styles.
+struct ACES10Constants
+{
+    static constexpr float noiseLimit    = 1e-2f;
+
+    static constexpr float glowGain      = 0.05f;
+    static constexpr float glowMid       = 0.08f;
+
+    static constexpr bool  restoreHue    = false;
+    static constexpr float oneMinusScale = 1.f - 0.82f;
+    static constexpr float pivot         = 0.03f;
+    static constexpr float invWidth      = 1.6976527263135504f;
+};
+
+// Fused renderer of the ACES RRT sweeteners i.e. the forward glow, then the forward red
+// modifier, then an optional lower bound clamp and an optional RGB matrix (e.g. AP0 to AP1).
+// The template parameters select the style constants and the stages at compile time so that
+// each chain has its own pixel loop, the pixels being transposed only once.
+template<typename ACES, bool hasClamp, bool hasMatrix>
+class Renderer_ACES_Chain : public OpCPU
+{
+public:
+    Renderer_ACES_Chain() = delete;
+    Renderer_ACES_Chain(const Renderer_ACES_Chain &) = delete;
+
+    Renderer_ACES_Chain(float lowerBound, const float * matrix, const float * offset);
+
+    void apply(const void * inImg, void * outImg, long numPixels) const override;
+
+protected:
+    float m_lowerBound = 0.f;
+    float m_matrix[9];      // RGB 3x3 matrix in row-major order.
+    float m_offset[3];
+};
+
+template<typename ACES, bool hasClamp, bool hasMatrix>
+Renderer_ACES_Chain<ACES, hasClamp, hasMatrix>::Renderer_ACES_Chain(float lowerBound,
+                                                                   const float * matrix,
+                                                                   const float * offset)
+    :   OpCPU()
+    ,   m_lowerBound(lowerBound)
+{
+    std::copy(matrix, matrix + 9, m_matrix);
+    std::copy(offset, offset + 3, m_offset);
+}
+
+template<typename ACES, bool hasClamp, bool hasMatrix>
+void Renderer_ACES_Chain<ACES, hasClamp, hasMatrix>::apply(const void * inImg,
+                                                          void * outImg,
+                                                          long numPixels) const
+{
+    const float * in = (const float *)inImg;
+    float * out = (float *)outImg;
+
+    const __m128 noiseLimit    = _mm_set1_ps(ACES::noiseLimit);
+
+    const __m128 glowGain      = _mm_set1_ps(ACES::glowGain);
+    const __m128 glowMid       = _mm_set1_ps(ACES::glowMid);
+    const __m128 highLimit     = _mm_set1_ps(ACES::glowMid * 2.f);
+    const __m128 lowLimit      = _mm_set1_ps(ACES::glowMid * 2.f / 3.f);
+
+    const __m128 inv_width     = _mm_set1_ps(ACES::invWidth);
+    const __m128 pivot         = _mm_set1_ps(ACES::pivot);
+    const __m128 oneMinusScale = _mm_set1_ps(ACES::oneMinusScale);
+
+    const __m128 lowerBound    = _mm_set1_ps(m_lowerBound);
+
+    __m128 m[9];
+    for (unsigned idx = 0; idx < 9; ++idx)
+    {
+        m[idx] = _mm_set1_ps(m_matrix[idx]);
+    }
+
+    const __m128 o[3] = { _mm_set1_ps(m_offset[0]),
+                          _mm_set1_ps(m_offset[1]),
+                          _mm_set1_ps(m_offset[2]) };
+
+    sseApplyTransposedRGB(in, out, numPixels, [&](__m128 & red, __m128 & grn, __m128 & blu)
+    {
+        sseGlowFwd(red, grn, blu, noiseLimit, glowGain, glowMid, lowLimit, highLimit);
+
+        sseRedModFwd<ACES::restoreHue>(red, grn, blu, inv_width, noiseLimit,
+                                       pivot, oneMinusScale);
+
+        if (hasClamp)
+        {
+            // NaNs become the lower bound.
+            red = _mm_max_ps( red, lowerBound );
+            grn = _mm_max_ps( grn, lowerBound );
+            blu = _mm_max_ps( blu, lowerBound );
+        }
+
+        if (hasMatrix)
+        {
+            const __m128 r = red;
+            const __m128 g = grn;
+            const __m128 b = blu;
+
+            red = _mm_add_ps( _mm_add_ps( _mm_add_ps( _mm_mul_ps( m[0], r ),
+                                                      _mm_mul_ps( m[1], g ) ),
+                                          _mm_mul_ps( m[2], b ) ),
+                              o[0] );
+            grn = _mm_add_ps( _mm_add_ps( _mm_add_ps( _mm_mul_ps( m[3], r ),
+                                                      _mm_mul_ps( m[4], g ) ),
+                                          _mm_mul_ps( m[5], b ) ),
+                              o[1] );
+            blu = _mm_add_ps( _mm_add_ps( _mm_add_ps( _mm_mul_ps( m[6], r ),
+                                                      _mm_mul_ps( m[7], g ) ),
+                                          _mm_mul_ps( m[8], b ) ),
+                              o[2] );
+        }
+    });
+}
+
+template<typename ACES>
+ConstOpCPURcPtr CreateACESChainRenderer(bool hasClamp, bool hasMatrix, float lowerBound,
+                                        const float * matrix, const float * offset)
+{
+    if (hasClamp && hasMatrix)
+    {
+        return std::make_shared<Renderer_ACES_Chain<ACES, true, true>>(lowerBound, matrix, offset);
+    }
+    else if (hasClamp)
+    {
+        return std::make_shared<Renderer_ACES_Chain<ACES, true, false>>(lowerBound, matrix, offset);
+    }
+    else if (hasMatrix)
+    {
+        return std::make_shared<Renderer_ACES_Chain<ACES, false, true>>(lowerBound, matrix, offset);
+    }
+
+    return std::make_shared<Renderer_ACES_Chain<ACES, false, false>>(lowerBound, matrix, offset);
+}
+
+bool IsFixedFunctionStyle(const ConstOpRcPtr & op, FixedFunctionOpData::Style style)
+{
+    if (op->data()->getType()!=OpData::FixedFunctionType)
+    {
+        return false;
+    }
+
+    ConstFixedFunctionOpDataRcPtr func
+        = DynamicPtrCast<const FixedFunctionOpData>(op->data());
+    return func->getStyle()==style;
+}
+
+// Is the op a lower bound clamp i.e. a Range op without scaling nor upper bound?
+bool IsLowerBoundClamp(const ConstOpRcPtr & op)
+{
+    if (op->data()->getType()!=OpData::RangeType)
+    {
+        return false;
+    }
+
+    ConstRangeOpDataRcPtr range = DynamicPtrCast<const RangeOpData>(op->data());
+    return !range->scales() && !range->minIsEmpty() && range->maxIsEmpty();
+}
+
+// Is the op a matrix only mixing the RGB channels i.e. the alpha channel is preserved?
+bool IsRGBMatrix(const ConstOpRcPtr & op)
+{
+    if (op->data()->getType()!=OpData::MatrixType)
+    {
+        return false;
+    }
+
+    ConstMatrixOpDataRcPtr mat = DynamicPtrCast<const MatrixOpData>(op->data());
+    if (mat->getArray().getLength()!=4)
+    {
+        return false;
+    }
+
+    const ArrayDouble::Values & m = mat->getArray().getValues();
+    return m[3]==0.  && m[7]==0.  && m[11]==0.
+        && m[12]==0. && m[13]==0. && m[14]==0. && m[15]==1.
+        && mat->getOffsets()[3]==0.;
+}
+
+}
+
+#endif
+
+ConstOpCPURcPtr GetACESChainCPURenderer(const OpRcPtrVec & ops, size_t first, size_t last,
+                                        size_t & numOps)
+{
+    numOps = 0;
+
+#ifdef USE_SSE
+    if (last<first+2)
+    {
+        return ConstOpCPURcPtr();
+    }
+
+    bool isACES10 = false;
+    if (IsFixedFunctionStyle(ops[first], FixedFunctionOpData::ACES_GLOW_10_FWD)
+        && IsFixedFunctionStyle(ops[first+1], FixedFunctionOpData::ACES_RED_MOD_10_FWD))
+    {
+        isACES10 = true;
+    }
+    else if (!IsFixedFunctionStyle(ops[first], FixedFunctionOpData::ACES_GLOW_03_FWD)
+             || !IsFixedFunctionStyle(ops[first+1], FixedFunctionOpData::ACES_RED_MOD_03_FWD))
+    {
+        return ConstOpCPURcPtr();
+    }
+
+    size_t idx = first + 2;
+
+    bool hasClamp = false;
+    float lowerBound = 0.f;
+    if (idx<last && IsLowerBoundClamp(ops[idx]))
+    {
+        ConstOpRcPtr op = ops[idx];
+        ConstRangeOpDataRcPtr range = DynamicPtrCast<const RangeOpData>(op->data());
+        lowerBound = (float)range->getMinOutValue();
+        hasClamp = true;
+        ++idx;
+    }
+
+    bool hasMatrix = false;
+    float matrix[9] = { 1.f, 0.f, 0.f, 0.f, 1.f, 0.f, 0.f, 0.f, 1.f };
+    float offset[3] = { 0.f, 0.f, 0.f };
+    if (idx<last && IsRGBMatrix(ops[idx]))
+    {
+        ConstOpRcPtr op = ops[idx];
+        ConstMatrixOpDataRcPtr mat = DynamicPtrCast<const MatrixOpData>(op->data());
+        const ArrayDouble::Values & m = mat->getArray().getValues();
+        for (unsigned row = 0; row < 3; ++row)
+        {
+            for (unsigned col = 0; col < 3; ++col)
+            {
+                matrix[row * 3 + col] = (float)m[row * 4 + col];
+            }
+            offset[row] = (float)mat->getOffsets()[row];
+        }
+        hasMatrix = true;
+        ++idx;
+    }
+
+    numOps = idx - first;
+
+    return isACES10
+        ? CreateACESChainRenderer<ACES10Constants>(hasClamp, hasMatrix, lowerBound, matrix, offset)
+        : CreateACESChainRenderer<ACES03Constants>(hasClamp, hasMatrix, lowerBound, matrix, offset);
+#else
+    (void)ops;
+    (void)first;
+    (void)last;
+    return ConstOpCPURcPtr();
+#endif
+}
+
 }
 OCIO_NAMESPACE_EXIT
 
@@ -703,6 +1312,9 @@ namespace OCIO = OCIO_NAMESPACE;
 #include <cstring>
 
 #include "MathUtils.h"
+#include "ops/FixedFunction/FixedFunctionOps.h"
+#include "ops/Matrix/MatrixOps.h"
+#include "ops/Range/RangeOps.h"
 #include "UnitTest.h"
 
 
@@ -953,7 +1565,11 @@ OCIO_ADD_TEST(FixedFunctionOpCPU, aces_dark_to_dim_10)
 
         ApplyFixedFunction(&output_32f[0], &expected_32f[0], num_samples, 
                            funcData,
+#ifdef USE_SSE
+                           1e-5f); // Note: Related to the ssePower optimization.
+#else
                            1e-7f);
+#endif
     }
 
     {
@@ -963,7 +1579,11 @@ OCIO_ADD_TEST(FixedFunctionOpCPU, aces_dark_to_dim_10)
 
         ApplyFixedFunction(&output_32f[0], &input_32f[0], num_samples, 
                            funcData,
+#ifdef USE_SSE
+                           1e-5f); // Note: Related to the ssePower optimization.
+#else
                            1e-7f);
+#endif
     }
 }   
 
@@ -992,7 +1612,174 @@ OCIO_ADD_TEST(FixedFunctionOpCPU, rec2100_surround)
 
     ApplyFixedFunction(&input_32f[0], &expected_32f[0], num_samples, 
                        funcData,
+#ifdef USE_SSE
+                       1e-5f); // Note: Related to the ssePower optimization.
+#else
                        1e-7f);
+#endif
 }   
 
+OCIO_ADD_TEST(FixedFunctionOpCPU, partial_pixel_block)
+{
+    // The renderers process the pixels by four so check that any number of pixels
+    // gives the same result and that the alpha is preserved.
+
+    const unsigned num_samples = 6;
+
+    const float input_32f[num_samples*4] = {
+            0.11f,  0.02f,  0.04f, 0.5f,
+            0.71f,  0.51f,  0.92f, 1.0f,
+            0.43f,  0.82f,  0.71f, 0.0f,
+           -0.3f,   0.5f,   1.2f,  0.1f,
+            0.9f,   0.05f,  0.22f, 0.2f,
+            0.01f,  0.01f,  0.01f, 0.3f
+        };
+
+    const OCIO::FixedFunctionOpData::Style styles[] = {
+        OCIO::FixedFunctionOpData::ACES_RED_MOD_03_FWD,
+        OCIO::FixedFunctionOpData::ACES_RED_MOD_10_INV,
+        OCIO::FixedFunctionOpData::ACES_GLOW_03_FWD,
+        OCIO::FixedFunctionOpData::ACES_DARK_TO_DIM_10_FWD };
+
+    for (const auto style : styles)
+    {
+        OCIO::ConstFixedFunctionOpDataRcPtr funcData 
+            = std::make_shared<OCIO::FixedFunctionOpData>(OCIO::FixedFunctionOpData::Params(),
+                                                          style);
+
+        OCIO::ConstOpCPURcPtr op;
+        OCIO_CHECK_NO_THROW(op = OCIO::GetFixedFunctionCPURenderer(funcData));
+
+        float expected_32f[num_samples*4];
+        OCIO_CHECK_NO_THROW(op->apply(input_32f, expected_32f, num_samples));
+
+        for (unsigned numPixels = 1; numPixels < num_samples; ++numPixels)
+        {
+            float output_32f[num_samples*4];
+            for (unsigned idx = 0; idx < num_samples*4; ++idx)
+            {
+                output_32f[idx] = -1.0f;
+            }
+
+            const unsigned offset = num_samples - numPixels;
+            OCIO_CHECK_NO_THROW(op->apply(&input_32f[4*offset], &output_32f[4*offset], numPixels));
+
+            for (unsigned idx = 0; idx < num_samples*4; ++idx)
+            {
+                OCIO_CHECK_EQUAL(output_32f[idx], idx < 4*offset ? -1.0f : expected_32f[idx]);
+            }
+        }
+
+        for (unsigned idx = 3; idx < num_samples*4; idx += 4)
+        {
+            OCIO_CHECK_EQUAL(expected_32f[idx], input_32f[idx]);
+        }
+    }
+}
+
+#ifdef USE_SSE
+
+namespace
+{
+
+// Compare the ACES chain CPU op with the processing of the individual CPU ops.
+void ValidateACESChain(OCIO::OpRcPtrVec & ops, size_t expectedNumOps)
+{
+    OCIO_CHECK_NO_THROW(OCIO::FinalizeOpVec(ops, OCIO::FINALIZATION_DEFAULT));
+
+    size_t numOps = 0;
+    OCIO::ConstOpCPURcPtr chain;
+    OCIO_CHECK_NO_THROW(chain = OCIO::GetACESChainCPURenderer(ops, 0, ops.size(), numOps));
+    OCIO_REQUIRE_ASSERT(chain);
+    OCIO_CHECK_EQUAL(numOps, expectedNumOps);
+
+    const std::vector<float> img = {
+         0.90f,  0.05f,   0.22f,   0.5f,
+         0.97f,  0.097f,  0.0097f, 1.0f,
+         0.89f,  0.15f,   0.56f,   0.0f,
+        -1.0f,  -0.001f,  1.2f,    0.0f,
+         0.11f,  0.02f,   0.04f,   0.25f,
+         0.01f,  0.02f,   0.03f,   1.0f,
+         4.50f,  0.50f,   0.20f,   1.0f,
+         0.00f,  0.00f,   0.00f,   0.0f,
+         0.05f,  0.06f,   0.01f,   0.75f };
+    const long numPixels = long(img.size() / 4);
+
+    std::vector<float> ref(img);
+    for (size_t idx = 0; idx < numOps; ++idx)
+    {
+        OCIO::ConstOpRcPtr op = ops[idx];
+        op->getCPUOp()->apply(&ref[0], &ref[0], numPixels);
+    }
+
+    std::vector<float> res(img.size(), -1.0f);
+    OCIO_CHECK_NO_THROW(chain->apply(&img[0], &res[0], numPixels));
+
+    for (size_t idx = 0; idx < res.size(); ++idx)
+    {
+        OCIO_CHECK_ASSERT(OCIO::EqualWithSafeRelError(res[idx], ref[idx], 1e-6f, 1.0f));
+    }
+}
+
+}
+
+OCIO_ADD_TEST(FixedFunctionOpCPU, aces_chain)
+{
+    const OCIO::FixedFunctionOpData::Params params;
+
+    // AP0 to AP1.
+    const double m44[16] = {  1.4514393161, -0.2365107469, -0.2149285693, 0.0,
+                             -0.0765537734,  1.1762296998, -0.0996759264, 0.0,
+                              0.0083161484, -0.0060324498,  0.9977163014, 0.0,
+                              0.0,           0.0,           0.0,          1.0 };
+
+    {
+        OCIO::OpRcPtrVec ops;
+        OCIO::CreateFixedFunctionOp(ops, params, OCIO::FixedFunctionOpData::ACES_GLOW_10_FWD);
+        OCIO::CreateFixedFunctionOp(ops, params, OCIO::FixedFunctionOpData::ACES_RED_MOD_10_FWD);
+        OCIO::CreateRangeOp(ops, 0., OCIO::RangeOpData::EmptyValue(),
+                            0., OCIO::RangeOpData::EmptyValue(), OCIO::TRANSFORM_DIR_FORWARD);
+        OCIO::CreateMatrixOp(ops, m44, OCIO::TRANSFORM_DIR_FORWARD);
+
+        ValidateACESChain(ops, 4);
+    }
+
+    {
+        OCIO::OpRcPtrVec ops;
+        OCIO::CreateFixedFunctionOp(ops, params, OCIO::FixedFunctionOpData::ACES_GLOW_03_FWD);
+        OCIO::CreateFixedFunctionOp(ops, params, OCIO::FixedFunctionOpData::ACES_RED_MOD_03_FWD);
+        OCIO::CreateMatrixOp(ops, m44, OCIO::TRANSFORM_DIR_FORWARD);
+
+        ValidateACESChain(ops, 3);
+    }
+
+    {
+        // The range scales so it is not part of the chain.
+        OCIO::OpRcPtrVec ops;
+        OCIO::CreateFixedFunctionOp(ops, params, OCIO::FixedFunctionOpData::ACES_GLOW_03_FWD);
+        OCIO::CreateFixedFunctionOp(ops, params, OCIO::FixedFunctionOpData::ACES_RED_MOD_03_FWD);
+        OCIO::CreateRangeOp(ops, 0., 1., 0., 2., OCIO::TRANSFORM_DIR_FORWARD);
+
+        ValidateACESChain(ops, 2);
+    }
+
+    {
+        // Mixing the ACES versions is not a chain.
+        OCIO::OpRcPtrVec ops;
+        OCIO::CreateFixedFunctionOp(ops, params, OCIO::FixedFunctionOpData::ACES_GLOW_10_FWD);
+        OCIO::CreateFixedFunctionOp(ops, params, OCIO::FixedFunctionOpData::ACES_RED_MOD_03_FWD);
+
+        size_t numOps = 1;
+        OCIO::ConstOpCPURcPtr chain;
+        OCIO_CHECK_NO_THROW(chain = OCIO::GetACESChainCPURenderer(ops, 0, ops.size(), numOps));
+        OCIO_CHECK_ASSERT(!chain);
+        OCIO_CHECK_EQUAL(numOps, 0);
+
+        OCIO_CHECK_NO_THROW(chain = OCIO::GetACESChainCPURenderer(ops, 1, ops.size(), numOps));
+        OCIO_CHECK_ASSERT(!chain);
+    }
+}
+
+#endif
+
 #endif
@@ -19,6 +19,14 @@ OCIO_NAMESPACE_ENTER
 
 ConstOpCPURcPtr GetFixedFunctionCPURenderer(ConstFixedFunctionOpDataRcPtr & func);
 
+// Recognize the ACES RRT sweeteners at the start of ops[first, last[ i.e. the forward glow
+// followed by the forward red modifier of the same ACES version, then optionally a lower
+// bound clamp and an RGB matrix, and return a single CPU op processing the whole chain
+// in one pass. The number of replaced ops is returned in numOps. A null CPU op is returned
+// (and numOps is zero) if the ops do not start with such a chain or if SSE is not available.
+ConstOpCPURcPtr GetACESChainCPURenderer(const OpRcPtrVec & ops, size_t first, size_t last,
+                                        size_t & numOps);
+
 }
 OCIO_NAMESPACE_EXIT
 
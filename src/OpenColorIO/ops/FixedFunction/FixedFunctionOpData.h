@@ -62,6 +62,7 @@ public:
     bool isNoOp() const override { return false; }
     bool isIdentity() const override { return false; }
     bool hasChannelCrosstalk() const override { return true; }
+    bool touchesAlpha() const override { return false; }
 
     bool isInverse(ConstFixedFunctionOpDataRcPtr & r) const;
     FixedFunctionOpDataRcPtr inverse() const;
@@ -37,6 +37,7 @@ public:
     OpRcPtr clone() const override;
 
     std::string getInfo() const override;
+    double getCost() const override;
 
     bool isIdentity() const override;
     bool isSameType(ConstOpRcPtr & op) const override;
@@ -77,6 +78,30 @@ std::string FixedFunctionOp::getInfo() const
     return "<FixedFunctionOp>";
 }
 
+double FixedFunctionOp::getCost() const
+{
+    switch (fnData()->getStyle())
+    {
+        // Hue computation, smooth step, and a quadratic solve for the inverse.
+        case FixedFunctionOpData::ACES_RED_MOD_03_FWD:
+        case FixedFunctionOpData::ACES_RED_MOD_03_INV:
+        case FixedFunctionOpData::ACES_RED_MOD_10_FWD:
+        case FixedFunctionOpData::ACES_RED_MOD_10_INV:
+            return 6.0;
+
+        // Saturation and sigmoid computations.
+        case FixedFunctionOpData::ACES_GLOW_03_FWD:
+        case FixedFunctionOpData::ACES_GLOW_03_INV:
+        case FixedFunctionOpData::ACES_GLOW_10_FWD:
+        case FixedFunctionOpData::ACES_GLOW_10_INV:
+            return 4.0;
+
+        // One power function on the luminance.
+        default:
+            return 5.0;
+    }
+}
+
 bool FixedFunctionOp::isIdentity() const
 {
     return fnData()->isIdentity();
@@ -21,6 +21,7 @@ OCIO_NAMESPACE_ENTER
 
 
 // Base class for the Gamma (i.e. basic style) operation renderers.
+template<bool fast>
 class GammaBasicOpCPU : public OpCPU
 {
 public:
@@ -52,6 +53,7 @@ protected:
     RendererParams m_alpha;
 };
 
+template<bool fast>
 class GammaMoncurveOpCPUFwd : public GammaMoncurveOpCPU
 {
 public:
@@ -63,6 +65,7 @@ protected:
     void update(ConstGammaOpDataRcPtr & gamma);
 };
 
+template<bool fast>
 class GammaMoncurveOpCPURev : public GammaMoncurveOpCPU
 {
 public:
@@ -76,26 +79,27 @@ protected:
 };
 
 
-ConstOpCPURcPtr GetGammaRenderer(ConstGammaOpDataRcPtr & gamma)
+template<bool fast>
+ConstOpCPURcPtr CreateGammaRenderer(ConstGammaOpDataRcPtr & gamma)
 {
     switch(gamma->getStyle())
     {
         case GammaOpData::MONCURVE_FWD:
         {
-            return std::make_shared<GammaMoncurveOpCPUFwd>(gamma);
+            return std::make_shared<GammaMoncurveOpCPUFwd<fast>>(gamma);
             break;
         }
 
         case GammaOpData::MONCURVE_REV:
         {
-            return std::make_shared<GammaMoncurveOpCPURev>(gamma);
+            return std::make_shared<GammaMoncurveOpCPURev<fast>>(gamma);
             break;
         }
 
         case GammaOpData::BASIC_FWD:
         case GammaOpData::BASIC_REV:
         {
-            return std::make_shared<GammaBasicOpCPU>(gamma);
+            return std::make_shared<GammaBasicOpCPU<fast>>(gamma);
             break;
         }
     }
@@ -103,10 +107,20 @@ ConstOpCPURcPtr GetGammaRenderer(ConstGammaOpDataRcPtr & gamma)
     throw Exception("Unsupported Gamma style");
 }
 
+ConstOpCPURcPtr GetGammaRenderer(ConstGammaOpDataRcPtr & gamma)
+{
+    if (gamma->isFastMath())
+    {
+        return CreateGammaRenderer<true>(gamma);
+    }
+    return CreateGammaRenderer<false>(gamma);
+}
+
 
 
 
-GammaBasicOpCPU::GammaBasicOpCPU(ConstGammaOpDataRcPtr & gamma)
+template<bool fast>
+GammaBasicOpCPU<fast>::GammaBasicOpCPU(ConstGammaOpDataRcPtr & gamma)
     :   OpCPU()
     ,   m_redGamma(0.0f)
     ,   m_grnGamma(0.0f)
@@ -116,7 +130,8 @@ GammaBasicOpCPU::GammaBasicOpCPU(ConstGammaOpDataRcPtr & gamma)
     update(gamma);
 }
 
-void GammaBasicOpCPU::update(ConstGammaOpDataRcPtr & gamma)
+template<bool fast>
+void GammaBasicOpCPU<fast>::update(ConstGammaOpDataRcPtr & gamma)
 {
     // The gamma calculations are done in normalized space.
     // Compute the scale factors for integer in/out depths.
@@ -143,7 +158,8 @@ void GammaBasicOpCPU::update(ConstGammaOpDataRcPtr & gamma)
         : 1. / gamma->getAlphaParams()[0]);
 }
 
-void GammaBasicOpCPU::apply(const void * inImg, void * outImg, long numPixels) const
+template<bool fast>
+void GammaBasicOpCPU<fast>::apply(const void * inImg, void * outImg, long numPixels) const
 {
     const float * in = (const float *)inImg;
     float * out = (float *)outImg;
@@ -155,7 +171,7 @@ void GammaBasicOpCPU::apply(const void * inImg, void * outImg, long numPixels) c
     {
         __m128 pixel = _mm_set_ps(in[3], in[2], in[1], in[0]);
 
-        pixel = ssePower(pixel, gamma);
+        pixel = ssePower<fast>(pixel, gamma);
 
         _mm_storeu_ps(out, pixel);
 
@@ -181,13 +197,15 @@ void GammaBasicOpCPU::apply(const void * inImg, void * outImg, long numPixels) c
 #endif
 }
 
-GammaMoncurveOpCPUFwd::GammaMoncurveOpCPUFwd(ConstGammaOpDataRcPtr & gamma)
+template<bool fast>
+GammaMoncurveOpCPUFwd<fast>::GammaMoncurveOpCPUFwd(ConstGammaOpDataRcPtr & gamma)
     :   GammaMoncurveOpCPU(gamma)
 {
     update(gamma);
 }
 
-void GammaMoncurveOpCPUFwd::update(ConstGammaOpDataRcPtr & gamma)
+template<bool fast>
+void GammaMoncurveOpCPUFwd<fast>::update(ConstGammaOpDataRcPtr & gamma)
 {
     ComputeParamsFwd(gamma->getRedParams(),   m_red);
     ComputeParamsFwd(gamma->getGreenParams(), m_green);
@@ -195,7 +213,8 @@ void GammaMoncurveOpCPUFwd::update(ConstGammaOpDataRcPtr & gamma)
     ComputeParamsFwd(gamma->getAlphaParams(), m_alpha);
 }
 
-void GammaMoncurveOpCPUFwd::apply(const void * inImg, void * outImg, long numPixels) const
+template<bool fast>
+void GammaMoncurveOpCPUFwd<fast>::apply(const void * inImg, void * outImg, long numPixels) const
 {
     const float * in = (const float *)inImg;
     float * out = (float *)outImg;
@@ -227,7 +246,7 @@ void GammaMoncurveOpCPUFwd::apply(const void * inImg, void * outImg, long numPix
 
         __m128 data = _mm_add_ps(_mm_mul_ps(pixel, scale), offset);
 
-        data = ssePower(data, gamma);
+        data = ssePower<fast>(data, gamma);
 
         __m128 flag = _mm_cmpgt_ps( pixel, breakPnt);
 
@@ -273,13 +292,15 @@ void GammaMoncurveOpCPUFwd::apply(const void * inImg, void * outImg, long numPix
 #endif
 }
 
-GammaMoncurveOpCPURev::GammaMoncurveOpCPURev(ConstGammaOpDataRcPtr & gamma)
+template<bool fast>
+GammaMoncurveOpCPURev<fast>::GammaMoncurveOpCPURev(ConstGammaOpDataRcPtr & gamma)
     :   GammaMoncurveOpCPU(gamma)
 {
     update(gamma);
 }
 
-void GammaMoncurveOpCPURev::update(ConstGammaOpDataRcPtr & gamma)
+template<bool fast>
+void GammaMoncurveOpCPURev<fast>::update(ConstGammaOpDataRcPtr & gamma)
 {
     ComputeParamsRev(gamma->getRedParams(),   m_red);
     ComputeParamsRev(gamma->getGreenParams(), m_green);
@@ -287,7 +308,8 @@ void GammaMoncurveOpCPURev::update(ConstGammaOpDataRcPtr & gamma)
     ComputeParamsRev(gamma->getAlphaParams(), m_alpha);
 }
 
-void GammaMoncurveOpCPURev::apply(const void * inImg, void * outImg, long numPixels) const
+template<bool fast>
+void GammaMoncurveOpCPURev<fast>::apply(const void * inImg, void * outImg, long numPixels) const
 {
     const float * in = (const float *)inImg;
     float * out = (float *)outImg;
@@ -317,7 +339,7 @@ void GammaMoncurveOpCPURev::apply(const void * inImg, void * outImg, long numPix
     {
         __m128 pixel = _mm_set_ps(in[3], in[2], in[1], in[0]);
 
-        __m128 data = ssePower(pixel, gamma);
+        __m128 data = ssePower<fast>(pixel, gamma);
 
         data = _mm_sub_ps(_mm_mul_ps(data, scale), offset);
 
@@ -367,4 +389,4 @@ void GammaMoncurveOpCPURev::apply(const void * inImg, void * outImg, long numPix
 }
 
 }
-OCIO_NAMESPACE_EXIT
\ No newline at end of file
+OCIO_NAMESPACE_EXIT
\ No newline at end of file
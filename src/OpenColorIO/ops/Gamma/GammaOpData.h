@@ -126,6 +126,11 @@ public:
     GammaOpDataRcPtr inverse() const;
     bool isInverse(const GammaOpData & B) const;
 
+    // The CPU renderer uses faster but less accurate approximations of the math
+    // functions when true (refer to SetCPUFastMath()).
+    inline bool isFastMath() const { return m_fastMath; }
+    inline void setFastMath(bool fastMath) { m_fastMath = fastMath; }
+
     virtual bool hasChannelCrosstalk() const override { return false; }
 
     virtual void validate() const override;
@@ -146,6 +151,8 @@ private:
     Params m_greenParams;
     Params m_blueParams;
     Params m_alphaParams;
+
+    bool m_fastMath = false;
 };
 
 }
@@ -137,6 +137,7 @@ public:
     TransformDirection getDirection() const noexcept override { return TRANSFORM_DIR_FORWARD; }
 
     std::string getInfo() const override;
+    double getCost() const override;
     
     OpRcPtr clone() const override;
     
@@ -184,6 +185,20 @@ std::string GammaOp::getInfo() const
     return "<GammaOp>";
 }
 
+double GammaOp::getCost() const
+{
+    switch (gammaData()->getStyle())
+    {
+        case GammaOpData::BASIC_FWD:
+        case GammaOpData::BASIC_REV:
+            return 4.0;
+
+        // The linear segment adds a scale, an offset and a per-channel selection.
+        default:
+            return 5.0;
+    }
+}
+
 OpRcPtr GammaOp::clone() const
 {
     GammaOpDataRcPtr f = gammaData()->clone();
@@ -226,14 +241,20 @@ void GammaOp::combineWith(OpRcPtrVec & ops, ConstOpRcPtr & secondOp) const
     CreateGammaOp(ops, res, TRANSFORM_DIR_FORWARD);
 }
 
-void GammaOp::finalize(FinalizationFlags /*fFlags*/)
+void GammaOp::finalize(FinalizationFlags fFlags)
 {
+    gammaData()->setFastMath(fFlags==FINALIZATION_FAST && IsCPUFastMath());
+
     gammaData()->finalize();
 
     // Create the cacheID
     std::ostringstream cacheIDStream;
     cacheIDStream << "<GammaOp ";
     cacheIDStream << gammaData()->getCacheID() << " ";
+    if (gammaData()->isFastMath())
+    {
+        cacheIDStream << "fast ";
+    }
     cacheIDStream << ">";
 
     m_cacheID = cacheIDStream.str();
@@ -729,6 +750,70 @@ OCIO_ADD_TEST(GammaOps, apply_moncurve_style_rev)
     ApplyGamma(ops[0], input_32f, expected_32f, numPixels, errorThreshold);
 }
 
+namespace
+{
+void ValidateFastMath(OCIO::GammaOpData::Style style, unsigned line)
+{
+    // The basic styles only have the gamma parameter.
+    const bool basic = style == OCIO::GammaOpData::BASIC_FWD
+                       || style == OCIO::GammaOpData::BASIC_REV;
+
+    const OCIO::GammaOpData::Params redParams
+        = basic ? OCIO::GammaOpData::Params{ 2.4 } : OCIO::GammaOpData::Params{ 2.4, 0.055 };
+    const OCIO::GammaOpData::Params greenParams
+        = basic ? OCIO::GammaOpData::Params{ 2.2 } : OCIO::GammaOpData::Params{ 2.2, 0.2 };
+    const OCIO::GammaOpData::Params blueParams
+        = basic ? OCIO::GammaOpData::Params{ 2.0 } : OCIO::GammaOpData::Params{ 2.0, 0.4 };
+    const OCIO::GammaOpData::Params alphaParams
+        = basic ? OCIO::GammaOpData::Params{ 1.8 } : OCIO::GammaOpData::Params{ 1.8, 0.6 };
+
+    auto gammaData = std::make_shared<OCIO::GammaOpData>(style,
+                                                         redParams,
+                                                         greenParams,
+                                                         blueParams,
+                                                         alphaParams);
+
+    OCIO::OpRcPtrVec ops;
+    OCIO_CHECK_NO_THROW_FROM(OCIO::CreateGammaOp(ops, gammaData, OCIO::TRANSFORM_DIR_FORWARD), line);
+    OCIO_REQUIRE_EQUAL_FROM(ops.size(), 1, line);
+
+    OCIO::OpRcPtrVec fastOps;
+    fastOps.push_back(ops[0]->clone());
+
+    OCIO_CHECK_NO_THROW_FROM(OCIO::FinalizeOpVec(ops, OCIO::FINALIZATION_FAST), line);
+
+    OCIO::SetCPUFastMath(true);
+    OCIO_CHECK_NO_THROW_FROM(OCIO::FinalizeOpVec(fastOps, OCIO::FINALIZATION_FAST), line);
+    OCIO::SetCPUFastMath(false);
+
+    // The fast math is only used when requested.
+    OCIO_REQUIRE_ASSERT_FROM(ops[0]->getCacheID() != fastOps[0]->getCacheID(), line);
+
+    const long numPixels = 64;
+    std::vector<float> image(numPixels * 4);
+    for (size_t idx = 0; idx < image.size(); ++idx)
+    {
+        image[idx] = float(idx) * 0.01f - 0.5f;
+    }
+
+    std::vector<float> result(image);
+    OCIO_CHECK_NO_THROW_FROM(ops[0]->apply(&result[0], numPixels), line);
+
+    // Refer to SetCPUFastMath() for the error bound.
+    ApplyGamma(fastOps[0], &image[0], &result[0], numPixels, 5e-4f);
+}
+};
+
+OCIO_ADD_TEST(GammaOps, apply_fast_math)
+{
+    OCIO_CHECK_ASSERT(!OCIO::IsCPUFastMath());
+
+    ValidateFastMath(OCIO::GammaOpData::BASIC_FWD, __LINE__);
+    ValidateFastMath(OCIO::GammaOpData::BASIC_REV, __LINE__);
+    ValidateFastMath(OCIO::GammaOpData::MONCURVE_FWD, __LINE__);
+    ValidateFastMath(OCIO::GammaOpData::MONCURVE_REV, __LINE__);
+}
+
 OCIO_ADD_TEST(GammaOps, combining)
 {
     OCIO::OpRcPtrVec ops;
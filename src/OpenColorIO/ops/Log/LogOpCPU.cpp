@@ -46,15 +46,24 @@ protected:
 };
 
 // Renderer for LogToLin operations.
+template<bool fast>
 class Log2LinRenderer : public L2LBaseRenderer
 {
 public:
     explicit Log2LinRenderer(ConstLogOpDataRcPtr & log);
 
     void apply(const void * inImg, void * outImg, long numPixels) const override;
+
+    bool hasPlanarApply() const override { return true; }
+    void applyPlanar(const float * const * inPlanes, float * const * outPlanes,
+                     long numPixels) const override;
+
+    bool hasRGBApply() const override { return true; }
+    void applyRGB(const float * inImg, float * outImg, long numPixels) const override;
 };
 
 // Renderer for Lin2Log operations.
+template<bool fast>
 class Lin2LogRenderer : public L2LBaseRenderer
 {
 public:
@@ -62,9 +71,16 @@ public:
 
     void apply(const void * inImg, void * outImg, long numPixels) const override;
 
+    bool hasPlanarApply() const override { return true; }
+    void applyPlanar(const float * const * inPlanes, float * const * outPlanes,
+                     long numPixels) const override;
+
+    bool hasRGBApply() const override { return true; }
+    void applyRGB(const float * inImg, float * outImg, long numPixels) const override;
 };
 
 // Renderer for Log10 and Log2 operations.
+template<bool fast>
 class LogRenderer : public LogOpCPU
 {
 public:
@@ -72,11 +88,19 @@ public:
 
     void apply(const void * inImg, void * outImg, long numPixels) const override;
 
+    bool hasPlanarApply() const override { return true; }
+    void applyPlanar(const float * const * inPlanes, float * const * outPlanes,
+                     long numPixels) const override;
+
+    bool hasRGBApply() const override { return true; }
+    void applyRGB(const float * inImg, float * outImg, long numPixels) const override;
+
 private:
     float m_logScale;
 };
 
 // Renderer for AntiLog10 and AntiLog2 operations.
+template<bool fast>
 class AntiLogRenderer : public LogOpCPU
 {
 public:
@@ -84,6 +108,13 @@ public:
 
     void apply(const void * inImg, void * outImg, long numPixels) const override;
 
+    bool hasPlanarApply() const override { return true; }
+    void applyPlanar(const float * const * inPlanes, float * const * outPlanes,
+                     long numPixels) const override;
+
+    bool hasRGBApply() const override { return true; }
+    void applyRGB(const float * inImg, float * outImg, long numPixels) const override;
+
 private:
     float m_log2_base;
 };
@@ -91,44 +122,54 @@ private:
 static constexpr float LOG2_10 = ((float) 3.3219280948873623478703194294894);
 static constexpr float LOG10_2 = ((float) 0.3010299956639811952137388947245);
 
-ConstOpCPURcPtr GetLogRenderer(ConstLogOpDataRcPtr & log)
+template<bool fast>
+ConstOpCPURcPtr CreateLogRenderer(ConstLogOpDataRcPtr & log)
 {
     const TransformDirection dir = log->getDirection();
     if (log->isLog2())
     {
         if (dir == TRANSFORM_DIR_FORWARD)
         {
-            return std::make_shared<LogRenderer>(log, 1.0f);
+            return std::make_shared<LogRenderer<fast>>(log, 1.0f);
         }
         else
         {
-            return std::make_shared<AntiLogRenderer>(log, 1.0f);
+            return std::make_shared<AntiLogRenderer<fast>>(log, 1.0f);
         }
     }
     else if (log->isLog10())
     {
         if (dir == TRANSFORM_DIR_FORWARD)
         {
-            return std::make_shared<LogRenderer>(log, LOG10_2);
+            return std::make_shared<LogRenderer<fast>>(log, LOG10_2);
         }
         else
         {
-            return std::make_shared<AntiLogRenderer>(log, LOG2_10);
+            return std::make_shared<AntiLogRenderer<fast>>(log, LOG2_10);
         }
     }
     else
     {
         if (dir == TRANSFORM_DIR_FORWARD)
         {
-            return std::make_shared<Lin2LogRenderer>(log);
+            return std::make_shared<Lin2LogRenderer<fast>>(log);
         }
         else
         {
-            return std::make_shared<Log2LinRenderer>(log);
+            return std::make_shared<Log2LinRenderer<fast>>(log);
         }
     }
 }
 
+ConstOpCPURcPtr GetLogRenderer(ConstLogOpDataRcPtr & log)
+{
+    if (log->isFastMath())
+    {
+        return CreateLogRenderer<true>(log);
+    }
+    return CreateLogRenderer<false>(log);
+}
+
 LogOpCPU::LogOpCPU(ConstLogOpDataRcPtr & log)
     : OpCPU()
 {
@@ -154,7 +195,8 @@ void L2LBaseRenderer::updateData(ConstLogOpDataRcPtr & pL)
     m_paramsB = pL->getBlueParams();
 }
 
-LogRenderer::LogRenderer(ConstLogOpDataRcPtr & log, float logScale)
+template<bool fast>
+LogRenderer<fast>::LogRenderer(ConstLogOpDataRcPtr & log, float logScale)
     : LogOpCPU(log)
     , m_logScale(logScale)
 {
@@ -207,7 +249,19 @@ inline void ApplyExp2(float * pix)
 }
 #endif
 
-void LogRenderer::apply(const void * inImg, void * outImg, long numPixels) const
+// The planar renderers process the RGB planes (i.e. four pixels of the same channel at
+// a time for SSE) and copy the alpha plane.
+inline void CopyAlphaPlane(const float * const * inPlanes, float * const * outPlanes,
+                           long numPixels)
+{
+    if (inPlanes[3]!=outPlanes[3])
+    {
+        memcpy(outPlanes[3], inPlanes[3], numPixels * sizeof(float));
+    }
+}
+
+template<bool fast>
+void LogRenderer<fast>::apply(const void * inImg, void * outImg, long numPixels) const
 {
     //
     // out = log2( max(in, minValue) ) * logScale;
@@ -227,7 +281,7 @@ void LogRenderer::apply(const void * inImg, void * outImg, long numPixels) const
     {
         mm_pixel = _mm_set_ps(0.0f, in[2], in[1], in[0]);
         mm_pixel = _mm_max_ps(mm_pixel, mm_minValue);
-        mm_pixel = sseLog2(mm_pixel);
+        mm_pixel = sseLog2<fast>(mm_pixel);
         mm_pixel = _mm_mul_ps(mm_pixel, mm_logScale);
 
         const float alphares = in[3];
@@ -258,15 +312,79 @@ void LogRenderer::apply(const void * inImg, void * outImg, long numPixels) const
 #endif
 }
 
+template<bool fast>
+void LogRenderer<fast>::applyPlanar(const float * const * inPlanes, float * const * outPlanes,
+                                    long numPixels) const
+{
+    const float minValue = std::numeric_limits<float>::min();
+
+#ifdef USE_SSE
+    const __m128 mm_minValue = _mm_set1_ps(minValue);
+    const __m128 mm_logScale = _mm_set1_ps(m_logScale);
+#endif
+
+    for (int c = 0; c < 3; ++c)
+    {
+        const float * in = inPlanes[c];
+        float * out = outPlanes[c];
+
+#ifdef USE_SSE
+        for (long idx = 0; idx<numPixels; idx += 4)
+        {
+            const long count = std::min(4L, numPixels - idx);
+
+            __m128 mm_pixel = sseLoadPartial(in + idx, count);
+            mm_pixel = _mm_max_ps(mm_pixel, mm_minValue);
+            mm_pixel = sseLog2<fast>(mm_pixel);
+            mm_pixel = _mm_mul_ps(mm_pixel, mm_logScale);
+
+            sseStorePartial(out + idx, mm_pixel, count);
+        }
+#else
+        for (long idx = 0; idx<numPixels; ++idx)
+        {
+            out[idx] = (float)log2(std::max(minValue, in[idx])) * m_logScale;
+        }
+#endif
+    }
+
+    CopyAlphaPlane(inPlanes, outPlanes, numPixels);
+}
+
+template<bool fast>
+void LogRenderer<fast>::applyRGB(const float * inImg, float * outImg, long numPixels) const
+{
+    const float minValue = std::numeric_limits<float>::min();
+
+#ifdef USE_SSE
+    const __m128 mm_minValue = _mm_set1_ps(minValue);
+    const __m128 mm_logScale = _mm_set1_ps(m_logScale);
+
+    sseApplyRGB(inImg, outImg, numPixels, [&](__m128 mm_pixel, int)
+    {
+        mm_pixel = _mm_max_ps(mm_pixel, mm_minValue);
+        mm_pixel = sseLog2<fast>(mm_pixel);
+        return _mm_mul_ps(mm_pixel, mm_logScale);
+    });
+#else
+    for (long idx = 0; idx<3*numPixels; ++idx)
+    {
+        outImg[idx] = (float)log2(std::max(minValue, inImg[idx])) * m_logScale;
+    }
+#endif
+}
+
 // Renderer for AntiLog10 and AntiLog2 operations
-AntiLogRenderer::AntiLogRenderer(ConstLogOpDataRcPtr & log, float log2base)
+template<bool fast>
+AntiLogRenderer<fast>::AntiLogRenderer(ConstLogOpDataRcPtr & log, float log2base)
     : LogOpCPU(log)
     , m_log2_base(log2base)
 {
     LogOpCPU::updateData(log);
 }
 
-void AntiLogRenderer::apply(const void * inImg, void * outImg, long numPixels) const
+template<bool fast>
+void AntiLogRenderer<fast>::apply(const void * inImg, void * outImg, long numPixels) const
 {
     //
     // out = pow(base, in);
@@ -287,7 +405,7 @@ void AntiLogRenderer::apply(const void * inImg, void * outImg, long numPixels) c
     for (long idx = 0; idx<numPixels; ++idx)
     {
         mm_pixel = _mm_set_ps(0.0f, in[2], in[1], in[0]);
-        mm_pixel = sseExp2(_mm_mul_ps(mm_pixel, mm_log2_base));
+        mm_pixel = sseExp2<fast>(_mm_mul_ps(mm_pixel, mm_log2_base));
 
         const float alphares = in[3];
 
@@ -316,14 +434,68 @@ void AntiLogRenderer::apply(const void * inImg, void * outImg, long numPixels) c
 #endif
 }
 
+template<bool fast>
+void AntiLogRenderer<fast>::applyPlanar(const float * const * inPlanes, float * const * outPlanes,
+                                        long numPixels) const
+{
+#ifdef USE_SSE
+    const __m128 mm_log2_base = _mm_set1_ps(m_log2_base);
+#endif
+
+    for (int c = 0; c < 3; ++c)
+    {
+        const float * in = inPlanes[c];
+        float * out = outPlanes[c];
+
+#ifdef USE_SSE
+        for (long idx = 0; idx<numPixels; idx += 4)
+        {
+            const long count = std::min(4L, numPixels - idx);
+
+            __m128 mm_pixel = sseLoadPartial(in + idx, count);
+            mm_pixel = sseExp2<fast>(_mm_mul_ps(mm_pixel, mm_log2_base));
+
+            sseStorePartial(out + idx, mm_pixel, count);
+        }
+#else
+        for (long idx = 0; idx<numPixels; ++idx)
+        {
+            out[idx] = (float)exp2(in[idx] * m_log2_base);
+        }
+#endif
+    }
+
+    CopyAlphaPlane(inPlanes, outPlanes, numPixels);
+}
+
+template<bool fast>
+void AntiLogRenderer<fast>::applyRGB(const float * inImg, float * outImg, long numPixels) const
+{
+#ifdef USE_SSE
+    const __m128 mm_log2_base = _mm_set1_ps(m_log2_base);
+
+    sseApplyRGB(inImg, outImg, numPixels, [&](__m128 mm_pixel, int)
+    {
+        return sseExp2<fast>(_mm_mul_ps(mm_pixel, mm_log2_base));
+    });
+#else
+    for (long idx = 0; idx<3*numPixels; ++idx)
+    {
+        outImg[idx] = (float)exp2(inImg[idx] * m_log2_base);
+    }
+#endif
+}
+
 // Renderer for LogToLin operations
-Log2LinRenderer::Log2LinRenderer(ConstLogOpDataRcPtr & log)
+template<bool fast>
+Log2LinRenderer<fast>::Log2LinRenderer(ConstLogOpDataRcPtr & log)
     : L2LBaseRenderer(log)
 {
     updateData(log);
 }
 
-void Log2LinRenderer::apply(const void * inImg, void * outImg, long numPixels) const
+template<bool fast>
+void Log2LinRenderer<fast>::apply(const void * inImg, void * outImg, long numPixels) const
 {
     //
     // out = ( pow( base, (in - logOffset) / logSlope ) - linOffset ) / linSlope;
@@ -371,7 +543,7 @@ void Log2LinRenderer::apply(const void * inImg, void * outImg, long numPixels) c
         mm_pixel = _mm_set_ps(0.0f, in[2], in[1], in[0]);
         mm_pixel = _mm_add_ps(mm_pixel, mm_minuskb);
         mm_pixel = _mm_mul_ps(mm_pixel, mm_kinv);
-        mm_pixel = sseExp2(mm_pixel);
+        mm_pixel = sseExp2<fast>(mm_pixel);
         mm_pixel = _mm_add_ps(mm_pixel, mm_minusb);
         mm_pixel = _mm_mul_ps(mm_pixel, mm_minv);
 
@@ -405,14 +577,104 @@ void Log2LinRenderer::apply(const void * inImg, void * outImg, long numPixels) c
 #endif
 }
 
+template<bool fast>
+void Log2LinRenderer<fast>::applyPlanar(const float * const * inPlanes, float * const * outPlanes,
+                                        long numPixels) const
+{
+    const LogOpData::Params * params[3] = { &m_paramsR, &m_paramsG, &m_paramsB };
+
+    for (int c = 0; c < 3; ++c)
+    {
+        const LogOpData::Params & p = *params[c];
+
+        const float kinv    = log2f(m_base) / (float)p[LOG_SIDE_SLOPE];
+        const float minuskb = -(float)p[LOG_SIDE_OFFSET];
+        const float minusb  = -(float)p[LIN_SIDE_OFFSET];
+        const float minv    = 1.0f / (float)p[LIN_SIDE_SLOPE];
+
+        const float * in = inPlanes[c];
+        float * out = outPlanes[c];
+
+#ifdef USE_SSE
+        const __m128 mm_kinv    = _mm_set1_ps(kinv);
+        const __m128 mm_minuskb = _mm_set1_ps(minuskb);
+        const __m128 mm_minusb  = _mm_set1_ps(minusb);
+        const __m128 mm_minv    = _mm_set1_ps(minv);
+
+        for (long idx = 0; idx<numPixels; idx += 4)
+        {
+            const long count = std::min(4L, numPixels - idx);
+
+            __m128 mm_pixel = sseLoadPartial(in + idx, count);
+            mm_pixel = _mm_add_ps(mm_pixel, mm_minuskb);
+            mm_pixel = _mm_mul_ps(mm_pixel, mm_kinv);
+            mm_pixel = sseExp2<fast>(mm_pixel);
+            mm_pixel = _mm_add_ps(mm_pixel, mm_minusb);
+            mm_pixel = _mm_mul_ps(mm_pixel, mm_minv);
+
+            sseStorePartial(out + idx, mm_pixel, count);
+        }
+#else
+        for (long idx = 0; idx<numPixels; ++idx)
+        {
+            out[idx] = ((float)exp2((in[idx] + minuskb) * kinv) + minusb) * minv;
+        }
+#endif
+    }
+
+    CopyAlphaPlane(inPlanes, outPlanes, numPixels);
+}
+
+template<bool fast>
+void Log2LinRenderer<fast>::applyRGB(const float * inImg, float * outImg, long numPixels) const
+{
+    const LogOpData::Params * params[3] = { &m_paramsR, &m_paramsG, &m_paramsB };
+
+    float kinv[3], minuskb[3], minusb[3], minv[3];
+    for (int c = 0; c < 3; ++c)
+    {
+        const LogOpData::Params & p = *params[c];
+
+        kinv[c]    = log2f(m_base) / (float)p[LOG_SIDE_SLOPE];
+        minuskb[c] = -(float)p[LOG_SIDE_OFFSET];
+        minusb[c]  = -(float)p[LIN_SIDE_OFFSET];
+        minv[c]    = 1.0f / (float)p[LIN_SIDE_SLOPE];
+    }
+
+#ifdef USE_SSE
+    __m128 mm_kinv[3], mm_minuskb[3], mm_minusb[3], mm_minv[3];
+    sseRGBRotations(kinv[0], kinv[1], kinv[2], mm_kinv);
+    sseRGBRotations(minuskb[0], minuskb[1], minuskb[2], mm_minuskb);
+    sseRGBRotations(minusb[0], minusb[1], minusb[2], mm_minusb);
+    sseRGBRotations(minv[0], minv[1], minv[2], mm_minv);
+
+    sseApplyRGB(inImg, outImg, numPixels, [&](__m128 mm_pixel, int rot)
+    {
+        mm_pixel = _mm_add_ps(mm_pixel, mm_minuskb[rot]);
+        mm_pixel = _mm_mul_ps(mm_pixel, mm_kinv[rot]);
+        mm_pixel = sseExp2<fast>(mm_pixel);
+        mm_pixel = _mm_add_ps(mm_pixel, mm_minusb[rot]);
+        return _mm_mul_ps(mm_pixel, mm_minv[rot]);
+    });
+#else
+    for (long idx = 0; idx<3*numPixels; ++idx)
+    {
+        const long c = idx % 3;
+        outImg[idx] = ((float)exp2((inImg[idx] + minuskb[c]) * kinv[c]) + minusb[c]) * minv[c];
+    }
+#endif
+}
+
 // Renderer for Lin2Log operations
-Lin2LogRenderer::Lin2LogRenderer(ConstLogOpDataRcPtr & log)
+template<bool fast>
+Lin2LogRenderer<fast>::Lin2LogRenderer(ConstLogOpDataRcPtr & log)
     : L2LBaseRenderer(log)
 {
     updateData(log);
 }
 
-void Lin2LogRenderer::apply(const void * inImg, void * outImg, long numPixels) const
+template<bool fast>
+void Lin2LogRenderer<fast>::apply(const void * inImg, void * outImg, long numPixels) const
 {
     // out = ( logSlope * log( base, max( minValue, (in*linSlope + linOffset) ) ) + logOffset )
     //
@@ -460,7 +722,7 @@ void Lin2LogRenderer::apply(const void * inImg, void * outImg, long numPixels) c
         mm_pixel = _mm_mul_ps(mm_pixel, mm_m);
         mm_pixel = _mm_add_ps(mm_pixel, mm_b);
         mm_pixel = _mm_max_ps(mm_pixel, mm_minValue);
-        mm_pixel = sseLog2(mm_pixel);
+        mm_pixel = sseLog2<fast>(mm_pixel);
         mm_pixel = _mm_mul_ps(mm_pixel, mm_klog);
         mm_pixel = _mm_add_ps(mm_pixel, mm_kb);
 
@@ -497,6 +759,103 @@ void Lin2LogRenderer::apply(const void * inImg, void * outImg, long numPixels) c
 #endif
 }
 
+template<bool fast>
+void Lin2LogRenderer<fast>::applyPlanar(const float * const * inPlanes, float * const * outPlanes,
+                                        long numPixels) const
+{
+    const float minValue = std::numeric_limits<float>::min();
+
+    const LogOpData::Params * params[3] = { &m_paramsR, &m_paramsG, &m_paramsB };
+
+    for (int c = 0; c < 3; ++c)
+    {
+        const LogOpData::Params & p = *params[c];
+
+        const float m    = (float)p[LIN_SIDE_SLOPE];
+        const float b    = (float)p[LIN_SIDE_OFFSET];
+        const float klog = (float)(p[LOG_SIDE_SLOPE] / log2(m_base));
+        const float kb   = (float)p[LOG_SIDE_OFFSET];
+
+        const float * in = inPlanes[c];
+        float * out = outPlanes[c];
+
+#ifdef USE_SSE
+        const __m128 mm_minValue = _mm_set1_ps(minValue);
+        const __m128 mm_m        = _mm_set1_ps(m);
+        const __m128 mm_b        = _mm_set1_ps(b);
+        const __m128 mm_klog     = _mm_set1_ps(klog);
+        const __m128 mm_kb       = _mm_set1_ps(kb);
+
+        for (long idx = 0; idx<numPixels; idx += 4)
+        {
+            const long count = std::min(4L, numPixels - idx);
+
+            __m128 mm_pixel = sseLoadPartial(in + idx, count);
+            mm_pixel = _mm_mul_ps(mm_pixel, mm_m);
+            mm_pixel = _mm_add_ps(mm_pixel, mm_b);
+            mm_pixel = _mm_max_ps(mm_pixel, mm_minValue);
+            mm_pixel = sseLog2<fast>(mm_pixel);
+            mm_pixel = _mm_mul_ps(mm_pixel, mm_klog);
+            mm_pixel = _mm_add_ps(mm_pixel, mm_kb);
+
+            sseStorePartial(out + idx, mm_pixel, count);
+        }
+#else
+        for (long idx = 0; idx<numPixels; ++idx)
+        {
+            out[idx] = (float)log2(std::max(minValue, in[idx] * m + b)) * klog + kb;
+        }
+#endif
+    }
+
+    CopyAlphaPlane(inPlanes, outPlanes, numPixels);
+}
+
+template<bool fast>
+void Lin2LogRenderer<fast>::applyRGB(const float * inImg, float * outImg, long numPixels) const
+{
+    const float minValue = std::numeric_limits<float>::min();
+
+    const LogOpData::Params * params[3] = { &m_paramsR, &m_paramsG, &m_paramsB };
+
+    float m[3], b[3], klog[3], kb[3];
+    for (int c = 0; c < 3; ++c)
+    {
+        const LogOpData::Params & p = *params[c];
+
+        m[c]    = (float)p[LIN_SIDE_SLOPE];
+        b[c]    = (float)p[LIN_SIDE_OFFSET];
+        klog[c] = (float)(p[LOG_SIDE_SLOPE] / log2(m_base));
+        kb[c]   = (float)p[LOG_SIDE_OFFSET];
+    }
+
+#ifdef USE_SSE
+    const __m128 mm_minValue = _mm_set1_ps(minValue);
+
+    __m128 mm_m[3], mm_b[3], mm_klog[3], mm_kb[3];
+    sseRGBRotations(m[0], m[1], m[2], mm_m);
+    sseRGBRotations(b[0], b[1], b[2], mm_b);
+    sseRGBRotations(klog[0], klog[1], klog[2], mm_klog);
+    sseRGBRotations(kb[0], kb[1], kb[2], mm_kb);
+
+    sseApplyRGB(inImg, outImg, numPixels, [&](__m128 mm_pixel, int rot)
+    {
+        mm_pixel = _mm_mul_ps(mm_pixel, mm_m[rot]);
+        mm_pixel = _mm_add_ps(mm_pixel, mm_b[rot]);
+        mm_pixel = _mm_max_ps(mm_pixel, mm_minValue);
+        mm_pixel = sseLog2<fast>(mm_pixel);
+        mm_pixel = _mm_mul_ps(mm_pixel, mm_klog[rot]);
+        return _mm_add_ps(mm_pixel, mm_kb[rot]);
+    });
+#else
+    for (long idx = 0; idx<3*numPixels; ++idx)
+    {
+        const long c = idx % 3;
+        outImg[idx] = (float)log2(std::max(minValue, inImg[idx] * m[c] + b[c])) * klog[c] + kb[c];
+    }
+#endif
+}
+
 }
 OCIO_NAMESPACE_EXIT
 
@@ -904,4 +1263,212 @@ OCIO_ADD_TEST(LogOpCPU, lin2log_test)
 // TODO: Test bitdepth support scaling - (logOp_Lin2Log_withScaling_test)
 // TODO: Test half supprt - (logOp_Lin2Log_withHalf_test)
 
+namespace
+{
+
+// Process the pixels as planes, and compare with the packed processing.
+void ValidateLogPlanar(OCIO::ConstLogOpDataRcPtr & log, unsigned line)
+{
+    OCIO::ConstOpCPURcPtr op = OCIO::GetLogRenderer(log);
+    OCIO_REQUIRE_ASSERT_FROM(op->hasPlanarApply(), line);
+
+    // Several SSE iterations and a partial one.
+    constexpr long numPixels = 10;
+
+    std::vector<float> img(4 * numPixels);
+    for (size_t idx = 0; idx < img.size(); ++idx)
+    {
+        img[idx] = float(idx) * 0.05f - 0.3f;
+    }
+
+    std::vector<float> ref(img.size());
+    op->apply(&img[0], &ref[0], numPixels);
+
+    std::vector<float> planes(img.size());
+    for (long idx = 0; idx < numPixels; ++idx)
+    {
+        for (long c = 0; c < 4; ++c)
+        {
+            planes[c * numPixels + idx] = img[4 * idx + c];
+        }
+    }
+
+    const float * in[4] = { &planes[0], &planes[numPixels],
+                            &planes[2 * numPixels], &planes[3 * numPixels] };
+
+    std::vector<float> res(img.size());
+    float * out[4] = { &res[0], &res[numPixels], &res[2 * numPixels], &res[3 * numPixels] };
+
+    op->applyPlanar(in, out, numPixels);
+
+    for (long idx = 0; idx < numPixels; ++idx)
+    {
+        for (long c = 0; c < 4; ++c)
+        {
+            OCIO_CHECK_EQUAL_FROM(res[c * numPixels + idx], ref[4 * idx + c], line);
+        }
+    }
+}
+
+}
+
+OCIO_ADD_TEST(LogOpCPU, planar_renderers)
+{
+    OCIO::ConstLogOpDataRcPtr log2
+        = std::make_shared<OCIO::LogOpData>(2.0, OCIO::TRANSFORM_DIR_FORWARD);
+    ValidateLogPlanar(log2, __LINE__);
+
+    OCIO::ConstLogOpDataRcPtr antiLog10
+        = std::make_shared<OCIO::LogOpData>(10.0, OCIO::TRANSFORM_DIR_INVERSE);
+    ValidateLogPlanar(antiLog10, __LINE__);
+
+    const OCIO::LogOpData::Params paramsR{ 0.5, 0.1, 1.2, 0.01 };
+    const OCIO::LogOpData::Params paramsG{ 0.6, 0.2, 1.1, 0.02 };
+    const OCIO::LogOpData::Params paramsB{ 0.7, 0.3, 1.3, 0.03 };
+
+    OCIO::ConstLogOpDataRcPtr lin2Log
+        = std::make_shared<OCIO::LogOpData>(OCIO::TRANSFORM_DIR_FORWARD, 10.0,
+                                            paramsR, paramsG, paramsB);
+    ValidateLogPlanar(lin2Log, __LINE__);
+
+    OCIO::ConstLogOpDataRcPtr log2Lin
+        = std::make_shared<OCIO::LogOpData>(OCIO::TRANSFORM_DIR_INVERSE, 10.0,
+                                            paramsR, paramsG, paramsB);
+    ValidateLogPlanar(log2Lin, __LINE__);
+}
+
+namespace
+{
+
+// Process packed RGB pixels, and compare with the packed RGBA processing.
+void ValidateLogRGB(OCIO::ConstLogOpDataRcPtr & log, unsigned line)
+{
+    OCIO::ConstOpCPURcPtr op = OCIO::GetLogRenderer(log);
+    OCIO_REQUIRE_ASSERT_FROM(op->hasRGBApply(), line);
+
+    // Several SSE iterations and a partial one.
+    constexpr long numPixels = 11;
+
+    std::vector<float> img(4 * numPixels);
+    for (size_t idx = 0; idx < img.size(); ++idx)
+    {
+        img[idx] = float(idx) * 0.05f - 0.3f;
+    }
+
+    std::vector<float> ref(img.size());
+    op->apply(&img[0], &ref[0], numPixels);
+
+    std::vector<float> rgb(3 * numPixels);
+    for (long idx = 0; idx < numPixels; ++idx)
+    {
+        for (long c = 0; c < 3; ++c)
+        {
+            rgb[3 * idx + c] = img[4 * idx + c];
+        }
+    }
+
+    std::vector<float> res(rgb.size());
+    op->applyRGB(&rgb[0], &res[0], numPixels);
+
+    // In place.
+    op->applyRGB(&rgb[0], &rgb[0], numPixels);
+
+    for (long idx = 0; idx < numPixels; ++idx)
+    {
+        for (long c = 0; c < 3; ++c)
+        {
+            OCIO_CHECK_EQUAL_FROM(res[3 * idx + c], ref[4 * idx + c], line);
+            OCIO_CHECK_EQUAL_FROM(rgb[3 * idx + c], ref[4 * idx + c], line);
+        }
+    }
+}
+
+}
+
+OCIO_ADD_TEST(LogOpCPU, packed_rgb_renderers)
+{
+    OCIO::ConstLogOpDataRcPtr log2
+        = std::make_shared<OCIO::LogOpData>(2.0, OCIO::TRANSFORM_DIR_FORWARD);
+    ValidateLogRGB(log2, __LINE__);
+
+    OCIO::ConstLogOpDataRcPtr antiLog10
+        = std::make_shared<OCIO::LogOpData>(10.0, OCIO::TRANSFORM_DIR_INVERSE);
+    ValidateLogRGB(antiLog10, __LINE__);
+
+    const OCIO::LogOpData::Params paramsR{ 0.5, 0.1, 1.2, 0.01 };
+    const OCIO::LogOpData::Params paramsG{ 0.6, 0.2, 1.1, 0.02 };
+    const OCIO::LogOpData::Params paramsB{ 0.7, 0.3, 1.3, 0.03 };
+
+    OCIO::ConstLogOpDataRcPtr lin2Log
+        = std::make_shared<OCIO::LogOpData>(OCIO::TRANSFORM_DIR_FORWARD, 10.0,
+                                            paramsR, paramsG, paramsB);
+    ValidateLogRGB(lin2Log, __LINE__);
+
+    OCIO::ConstLogOpDataRcPtr log2Lin
+        = std::make_shared<OCIO::LogOpData>(OCIO::TRANSFORM_DIR_INVERSE, 10.0,
+                                            paramsR, paramsG, paramsB);
+    ValidateLogRGB(log2Lin, __LINE__);
+}
+
+namespace
+{
+
+// Compare the fast math renderer with the accurate one (refer to SetCPUFastMath()).
+void ValidateLogFastMath(OCIO::ConstLogOpDataRcPtr & log, unsigned line)
+{
+    OCIO::LogOpDataRcPtr fastLog = log->clone();
+    fastLog->setFastMath(true);
+    OCIO::ConstLogOpDataRcPtr constFastLog = fastLog;
+
+    OCIO::ConstOpCPURcPtr op = OCIO::GetLogRenderer(log);
+    OCIO::ConstOpCPURcPtr fastOp = OCIO::GetLogRenderer(constFastLog);
+
+    constexpr long numPixels = 64;
+
+    std::vector<float> img(4 * numPixels);
+    for (size_t idx = 0; idx < img.size(); ++idx)
+    {
+        img[idx] = float(idx) * 0.0125f - 0.3f;
+    }
+
+    std::vector<float> ref(img.size());
+    op->apply(&img[0], &ref[0], numPixels);
+
+    std::vector<float> res(img.size());
+    fastOp->apply(&img[0], &res[0], numPixels);
+
+    for (size_t idx = 0; idx < img.size(); ++idx)
+    {
+        OCIO_CHECK_CLOSE_FROM(res[idx], ref[idx],
+                              1e-3f * std::max(1.0f, std::abs(ref[idx])), line);
+    }
+}
+
+}
+
+OCIO_ADD_TEST(LogOpCPU, fast_math_renderers)
+{
+    OCIO::ConstLogOpDataRcPtr log2
+        = std::make_shared<OCIO::LogOpData>(2.0, OCIO::TRANSFORM_DIR_FORWARD);
+    ValidateLogFastMath(log2, __LINE__);
+
+    OCIO::ConstLogOpDataRcPtr antiLog10
+        = std::make_shared<OCIO::LogOpData>(10.0, OCIO::TRANSFORM_DIR_INVERSE);
+    ValidateLogFastMath(antiLog10, __LINE__);
+
+    const OCIO::LogOpData::Params paramsR{ 0.5, 0.1, 1.2, 0.01 };
+    const OCIO::LogOpData::Params paramsG{ 0.6, 0.2, 1.1, 0.02 };
+    const OCIO::LogOpData::Params paramsB{ 0.7, 0.3, 1.3, 0.03 };
+
+    OCIO::ConstLogOpDataRcPtr lin2Log
+        = std::make_shared<OCIO::LogOpData>(OCIO::TRANSFORM_DIR_FORWARD, 10.0,
+                                            paramsR, paramsG, paramsB);
+    ValidateLogFastMath(lin2Log, __LINE__);
+
+    OCIO::ConstLogOpDataRcPtr log2Lin
+        = std::make_shared<OCIO::LogOpData>(OCIO::TRANSFORM_DIR_INVERSE, 10.0,
+                                            paramsR, paramsG, paramsB);
+    ValidateLogFastMath(log2Lin, __LINE__);
+}
+
 #endif
\ No newline at end of file
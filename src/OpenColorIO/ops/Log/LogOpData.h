@@ -67,6 +67,7 @@ public:
     bool isNoOp() const override;
 
     bool hasChannelCrosstalk() const override { return false; }
+    bool touchesAlpha() const override { return false; }
 
     void finalize() override;
 
@@ -106,6 +107,11 @@ public:
     bool isLog2() const;
     bool isLog10() const;
 
+    // The CPU renderer uses faster but less accurate approximations of the math
+    // functions when true (refer to SetCPUFastMath()).
+    inline bool isFastMath() const { return m_fastMath; }
+    inline void setFastMath(bool fastMath) { m_fastMath = fastMath; }
+
     void setBase(double base);
 
     double getBase() const;
@@ -133,6 +139,8 @@ private:
     double m_base = 2.0;
 
     TransformDirection m_direction = TRANSFORM_DIR_FORWARD;
+
+    bool m_fastMath = false;
 };
 
 }
@@ -35,6 +35,7 @@ OCIO_NAMESPACE_ENTER
             OpRcPtr clone() const override;
             
             std::string getInfo() const override;
+            double getCost() const override;
             
             bool isSameType(ConstOpRcPtr & op) const override;
             bool isInverse(ConstOpRcPtr & op) const override;
@@ -74,6 +75,12 @@ OCIO_NAMESPACE_ENTER
         {
             return "<LogOp>";
         }
+
+        double LogOp::getCost() const
+        {
+            // One log or exp function per channel.
+            return 4.0;
+        }
         
         bool LogOp::isSameType(ConstOpRcPtr & op) const
         {
@@ -91,14 +98,20 @@ OCIO_NAMESPACE_ENTER
             return logData()->isInverse(logOpData);
         }
         
-        void LogOp::finalize(FinalizationFlags /*fFlags*/)
+        void LogOp::finalize(FinalizationFlags fFlags)
         {
+            logData()->setFastMath(fFlags==FINALIZATION_FAST && IsCPUFastMath());
+
             logData()->finalize();
 
             // Create the cacheID
             std::ostringstream cacheIDStream;
             cacheIDStream << "<LogOp ";
             cacheIDStream << logData()->getCacheID() << " ";
+            if (logData()->isFastMath())
+            {
+                cacheIDStream << "fast ";
+            }
             cacheIDStream << ">";
             
             m_cacheID = cacheIDStream.str();
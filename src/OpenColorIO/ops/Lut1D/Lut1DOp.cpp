@@ -41,6 +41,7 @@ OCIO_NAMESPACE_ENTER
             OpRcPtr clone() const override;
 
             std::string getInfo() const override;
+            double getCost() const override;
 
             bool isSameType(ConstOpRcPtr & op) const override;
             bool isInverse(ConstOpRcPtr & op) const override;
@@ -76,6 +77,39 @@ OCIO_NAMESPACE_ENTER
             return "<Lut1DOp>";
         }
 
+        double Lut1DOp::getCost() const
+        {
+            ConstLut1DOpDataRcPtr lut = lut1DData();
+
+            double cost = 0.0;
+            size_t numBytes = lut->getArray().getNumValues() * sizeof(float);
+
+            if (lut->getDirection() == TRANSFORM_DIR_FORWARD)
+            {
+                // A half-domain LUT is directly indexed by the half bits of the input.
+                cost = lut->isInputHalfDomain() ? 1.5 : 2.0;
+            }
+            else if (lut->getConcreteInversionQuality() == LUT_INVERSION_FAST)
+            {
+                // Rendered with a forward LUT of at most 65536 entries approximating
+                // the inverse (refer to Lut1DOpData::MakeFastLut1DFromInverse()).
+                cost = 1.5;
+                numBytes = 65536 * 3 * sizeof(float);
+            }
+            else
+            {
+                // A binary search per channel.
+                cost = 2.0 + std::log2(double(lut->getArray().getLength()));
+            }
+
+            if (lut->getHueAdjust() != HUE_NONE)
+            {
+                cost += 2.0;
+            }
+
+            return cost + GetLutMemoryCost(numBytes);
+        }
+
         bool Lut1DOp::isSameType(ConstOpRcPtr & op) const
         {
             ConstLut1DOpRcPtr typedRcPtr = DynamicPtrCast<const Lut1DOp>(op);
@@ -105,6 +139,7 @@ OCIO_NAMESPACE_ENTER
 
             lutData->setInversionQuality(
                 fFlags==FINALIZATION_FAST ? LUT_INVERSION_FAST: LUT_INVERSION_EXACT);
+            lutData->setFiniteInputs(IsCPUFiniteInputs());
 
             lutData->finalize();
 
@@ -112,6 +147,11 @@ OCIO_NAMESPACE_ENTER
             std::ostringstream cacheIDStream;
             cacheIDStream << "<Lut1D ";
             cacheIDStream << lutData->getCacheID() << " ";
+            if (lutData->hasFiniteInputs())
+            {
+                // The CPU renderer differs (refer to SetCPUFiniteInputs()).
+                cacheIDStream << "finite ";
+            }
             cacheIDStream << ">";
 
             m_cacheID = cacheIDStream.str();
@@ -126,10 +166,12 @@ OCIO_NAMESPACE_ENTER
         void Lut1DOp::extractGpuShaderInfo(GpuShaderDescRcPtr & shaderDesc) const
         {
             ConstLut1DOpDataRcPtr lutData = lut1DData();
-            if (lutData->getDirection() == TRANSFORM_DIR_INVERSE)
+            if (IsInvLut1DSearchSupported(*shaderDesc, *lutData))
+            {
+                GetInvLut1DGPUShaderProgram(shaderDesc, lutData);
+            }
+            else if (lutData->getDirection() == TRANSFORM_DIR_INVERSE)
             {
-                // TODO: Add GPU renderer for EXACT mode.
-
                 Lut1DOpDataRcPtr newLut = Lut1DOpData::MakeFastLut1DFromInverse(lutData, true);
                 if (!newLut)
                 {
@@ -436,6 +478,29 @@ OCIO_ADD_TEST(Lut1DOp, finite_value)
     }
 }
 
+OCIO_ADD_TEST(Lut1DOp, finite_inputs)
+{
+    // The finalization records the global setting, and the cache identifier reflects it
+    // as the CPU renderer differs.
+    OCIO_CHECK_ASSERT(!OCIO::IsCPUFiniteInputs());
+
+    OCIO::Lut1DOpDataRcPtr lut = CreateSquareLut();
+
+    OCIO::OpRcPtrVec ops;
+    OCIO_CHECK_NO_THROW(CreateLut1DOp(ops, lut, OCIO::TRANSFORM_DIR_FORWARD));
+    OCIO_REQUIRE_EQUAL(ops.size(), 1);
+    OCIO_CHECK_NO_THROW(ops[0]->finalize(OCIO::FINALIZATION_EXACT));
+    OCIO_CHECK_ASSERT(!lut->hasFiniteInputs());
+    const std::string cacheID = ops[0]->getCacheID();
+
+    OCIO::SetCPUFiniteInputs(true);
+    OCIO_CHECK_NO_THROW(ops[0]->finalize(OCIO::FINALIZATION_EXACT));
+    OCIO::SetCPUFiniteInputs(false);
+
+    OCIO_CHECK_ASSERT(lut->hasFiniteInputs());
+    OCIO_CHECK_NE(ops[0]->getCacheID(), cacheID);
+}
+
 OCIO_ADD_TEST(Lut1DOp, gpu)
 {
     OCIO::Lut1DOpDataRcPtr lut = CreateSquareLut();
@@ -2,6 +2,8 @@
 // Copyright Contributors to the OpenColorIO Project.
 
 #include <algorithm>
+#include <cstring>
+#include <limits>
 #include <math.h>
 #include <memory>
 #include <stdint.h>
@@ -9,12 +11,18 @@
 #include <OpenColorIO/OpenColorIO.h>
 
 #include "BitDepthUtils.h"
+#include "CPUInfo.h"
 #include "MathUtils.h"
 #include "ops/Lut1D/Lut1DOpCPU.h"
 #include "OpTools.h"
 #include "Platform.h"
+#include "RendererAllocator.h"
 #include "SSE.h"
 
+#if defined(OCIO_USE_AVX)
+#include <immintrin.h>
+#endif
+
 
 #define L_ADJUST(val) \
     (T)((isOutInteger) ? Clamp((val)+0.5f, outMin,  outMax) : SanitizeFloat(val))
@@ -52,9 +60,10 @@ template<typename InType, typename OutType>
 struct LookupLut
 {
     static inline OutType compute(const OutType * lutData,
-                                  const InType & val)
+                                  const InType & val,
+                                  unsigned long stride)
     {
-        return lutData[GetLookupValue(val)];
+        return lutData[GetLookupValue(val) * stride];
     }
 };
 
@@ -71,6 +80,8 @@ public:
     //     that having a way to test it is critical.
     constexpr bool isLookup() const noexcept { return inBD != BIT_DEPTH_F32; }
 
+    size_t getMemorySize() const override { return m_tmpLutNumBytes; }
+
 protected:
 
     virtual void update(ConstLut1DOpDataRcPtr & lut);
@@ -80,15 +91,23 @@ protected:
 
     void reset();
 
+    // Allocate m_dim entries, either interleaved or in a single table.
     template<typename T>
-    void resetData();
+    void allocateData(bool singleLut);
 
 protected:
     unsigned long m_dim = 0;
 
+    // The LUT values are interleaved (i.e. R, G, B and a padding value per entry) so
+    // the three values of an entry share the same cache line, except when the three
+    // channels are identical where a single table is then used. The channel tables
+    // point into m_tmpLut, the values of a channel being m_lutStride apart.
+    void * m_tmpLut  = nullptr;
     void * m_tmpLutR = nullptr;
     void * m_tmpLutG = nullptr;
     void * m_tmpLutB = nullptr;
+    unsigned long m_lutStride = 1;
+    size_t m_tmpLutNumBytes = 0;
 
     float m_alphaScaling = 0.0f;
 
@@ -118,6 +137,9 @@ struct IndexPair
         fraction = 0.0f;
     }
 
+    // When finite is true, the value must be finite and within [-HALF_MAX, HALF_MAX]
+    // (refer to SetCPUFiniteInputs()) so the infinity clamping is skipped.
+    template<bool finite = false>
     static IndexPair GetEdgeFloatValues(float fIn);
 };
 
@@ -128,12 +150,39 @@ public:
     Lut1DRendererHalfCode() = delete;
 
     explicit Lut1DRendererHalfCode(ConstLut1DOpDataRcPtr & lut)
-        : BaseLut1DRenderer<inBD, outBD>(lut) {}
+        : BaseLut1DRenderer<inBD, outBD>(lut)
+        , m_finiteInputs(lut->hasFiniteInputs()) {}
 
     Lut1DRendererHalfCode(ConstLut1DOpDataRcPtr & lut, BitDepth outBitDepth)
-        : BaseLut1DRenderer<inBD, outBD>(lut, outBitDepth) {}
+        : BaseLut1DRenderer<inBD, outBD>(lut, outBitDepth)
+        , m_finiteInputs(lut->hasFiniteInputs()) {}
 
     void apply(const void * inImg, void * outImg, long numPixels) const override;
+
+    // Only the 32-bit float pixels could be planar or packed RGB.
+    bool hasPlanarApply() const override
+    {
+        return inBD==BIT_DEPTH_F32 && outBD==BIT_DEPTH_F32;
+    }
+    void applyPlanar(const float * const * inPlanes, float * const * outPlanes,
+                     long numPixels) const override;
+
+    bool hasRGBApply() const override { return inBD==BIT_DEPTH_F32 && outBD==BIT_DEPTH_F32; }
+    void applyRGB(const float * inImg, float * outImg, long numPixels) const override;
+
+protected:
+    // The input values are known to be finite and within the half range i.e. the
+    // renderers could skip the infinity clamping (refer to SetCPUFiniteInputs()).
+    const bool m_finiteInputs;
+
+private:
+    template<bool finite>
+    void interpolate(const float * in, void * outImg, long numPixels) const;
+    template<bool finite>
+    void interpolatePlanar(const float * const * inPlanes, float * const * outPlanes,
+                           long numPixels) const;
+    template<bool finite>
+    void interpolateRGB(const float * inImg, float * outImg, long numPixels) const;
 };
 
 template<BitDepth inBD, BitDepth outBD>
@@ -149,6 +198,17 @@ public:
         : BaseLut1DRenderer<inBD, outBD>(lut, outBitDepth) {}
 
     void apply(const void * inImg, void * outImg, long numPixels) const override;
+
+    // Only the 32-bit float pixels could be planar or packed RGB.
+    bool hasPlanarApply() const override
+    {
+        return inBD==BIT_DEPTH_F32 && outBD==BIT_DEPTH_F32;
+    }
+    void applyPlanar(const float * const * inPlanes, float * const * outPlanes,
+                     long numPixels) const override;
+
+    bool hasRGBApply() const override { return inBD==BIT_DEPTH_F32 && outBD==BIT_DEPTH_F32; }
+    void applyRGB(const float * inImg, float * outImg, long numPixels) const override;
 };
 
 template<BitDepth inBD, BitDepth outBD>
@@ -161,6 +221,10 @@ public:
         :  Lut1DRenderer<inBD, outBD>(lut, BIT_DEPTH_F32) {} // HueAdjust needs float processing.
 
     void apply(const void * inImg, void * outImg, long numPixels) const override;
+
+    // The hue adjustment needs all the channels of a pixel.
+    bool hasPlanarApply() const override { return false; }
+    bool hasRGBApply() const override { return false; }
 };
 
 template<BitDepth inBD, BitDepth outBD>
@@ -173,6 +237,184 @@ public:
         : Lut1DRendererHalfCode<inBD, outBD>(lut, BIT_DEPTH_F32) {} // HueAdjust needs float processing.
 
     void apply(const void * inImg, void * outImg, long numPixels) const override;
+
+    // The hue adjustment needs all the channels of a pixel.
+    bool hasPlanarApply() const override { return false; }
+    bool hasRGBApply() const override { return false; }
+};
+
+// Use the nearest LUT entry i.e. only for the 32-bit float input pixels (the other ones
+// use look-ups) with the draft interpolation quality (refer to LUT_INTERPOLATION_DRAFT).
+template<BitDepth inBD, BitDepth outBD>
+class Lut1DRendererNearest : public BaseLut1DRenderer<inBD, outBD>
+{
+public:
+    Lut1DRendererNearest() = delete;
+
+    explicit Lut1DRendererNearest(ConstLut1DOpDataRcPtr & lut)
+        : BaseLut1DRenderer<inBD, outBD>(lut) {}
+
+    void apply(const void * inImg, void * outImg, long numPixels) const override;
+};
+
+// The nearest entry of a half domain LUT is the one of the nearest half value.
+template<BitDepth inBD, BitDepth outBD>
+class Lut1DRendererHalfCodeNearest : public BaseLut1DRenderer<inBD, outBD>
+{
+public:
+    Lut1DRendererHalfCodeNearest() = delete;
+
+    explicit Lut1DRendererHalfCodeNearest(ConstLut1DOpDataRcPtr & lut)
+        : BaseLut1DRenderer<inBD, outBD>(lut) {}
+
+    void apply(const void * inImg, void * outImg, long numPixels) const override;
+};
+
+// Acceleration index to find the lower bound of a value in an increasing LUT
+// without a binary search of the whole LUT. The range of the LUT values is split
+// into buckets, each bucket knowing the range of the LUT entries it holds, so only
+// the entries of the value bucket are then searched.
+//
+// The buckets have the same size except for the half domain LUTs, where the values
+// usually span many orders of magnitude, which then use buckets of the same size
+// in the float bit patterns (i.e. a logarithmic scale).
+class LutSearchIndex
+{
+public:
+    // Build the index of the increasing entries [start, end[ (i.e. the values
+    // to search are in [*start, *end]).
+    void init(const float * start, const float * end, bool logBuckets)
+    {
+        m_start      = start;
+        m_end        = end;
+        m_logBuckets = logBuckets;
+        m_offsets.clear();
+
+        if (end <= start)
+        {
+            return;
+        }
+
+        const unsigned long numEntries = (unsigned long)(end - start);
+
+        // One bucket per entry on average.
+        unsigned long numBuckets = numEntries;
+
+        if (m_logBuckets)
+        {
+            const uint32_t range = GetOrderedBits(*end) - GetOrderedBits(*start);
+            if (range == 0)
+            {
+                return;
+            }
+
+            m_minBits = GetOrderedBits(*start);
+            m_shift   = 0;
+            while ((range >> m_shift) >= numEntries)
+            {
+                ++m_shift;
+            }
+            numBuckets = (range >> m_shift) + 1;
+        }
+        else
+        {
+            const float range = *end - *start;
+            const float scale = (float)numBuckets / range;
+
+            // Flat or non finite LUTs are searched without index.
+            const float maxFloat = std::numeric_limits<float>::max();
+            if (!(range > 0.f) || !(range <= maxFloat) || !(scale <= maxFloat))
+            {
+                return;
+            }
+
+            m_minValue    = *start;
+            m_bucketScale = scale;
+        }
+
+        m_maxBucket = numBuckets - 1;
+
+        // The first entry of each bucket (i.e. the first entry of a bucket at least
+        // as high) and the end of the LUT.
+        m_offsets.resize(numBuckets + 1);
+
+        unsigned long entry = 0;
+        for (unsigned long bucket = 0; bucket < numBuckets; ++bucket)
+        {
+            while (entry < numEntries && getBucket(start[entry]) < bucket)
+            {
+                ++entry;
+            }
+            m_offsets[bucket] = entry;
+        }
+        m_offsets[numBuckets] = numEntries;
+    }
+
+    // Same result as std::lower_bound(start, end, val).
+    inline const float * lowerBound(float val) const
+    {
+        if (m_offsets.empty())
+        {
+            return std::lower_bound(m_start, m_end, val);
+        }
+
+        // As getBucket() is increasing, all the entries of the previous buckets are
+        // lower than val and all the entries of the next buckets are higher.
+        const unsigned long bucket = getBucket(val);
+        return std::lower_bound(m_start + m_offsets[bucket],
+                                m_start + m_offsets[bucket + 1],
+                                val);
+    }
+
+    size_t getMemorySize() const { return m_offsets.capacity() * sizeof(unsigned long); }
+
+private:
+    // Get the float bit pattern as an unsigned integer having the same order
+    // as the float values (i.e. once -0 is changed to +0).
+    static inline uint32_t GetOrderedBits(float val)
+    {
+        uint32_t bits;
+        const float value = val + 0.f;
+        memcpy(&bits, &value, sizeof(bits));
+        return (bits & 0x80000000u) ? ~bits : (bits | 0x80000000u);
+    }
+
+    // Note that a NaN is in the first bucket.
+    inline unsigned long getBucket(float val) const
+    {
+        if (m_logBuckets)
+        {
+            if (IsNan(val))
+            {
+                return 0;
+            }
+
+            const uint32_t bits = GetOrderedBits(val);
+            const unsigned long bucket
+                = bits > m_minBits ? (unsigned long)((bits - m_minBits) >> m_shift) : 0;
+            return std::min(bucket, m_maxBucket);
+        }
+
+        float pos = (val - m_minValue) * m_bucketScale;
+        pos = pos > 0.f ? pos : 0.f;
+        pos = pos < (float)m_maxBucket ? pos : (float)m_maxBucket;
+        return (unsigned long)pos;
+    }
+
+    const float * m_start = nullptr;
+    const float * m_end   = nullptr;
+
+    bool m_logBuckets = false;
+
+    float m_minValue    = 0.f; // Uniform buckets.
+    float m_bucketScale = 0.f;
+
+    uint32_t m_minBits = 0;    // Logarithmic buckets.
+    unsigned m_shift   = 0;
+
+    unsigned long m_maxBucket = 0;
+
+    std::vector<unsigned long> m_offsets; // Index of the first entry of each bucket.
 };
 
 // Holds the parameters of a color component.
@@ -198,11 +440,16 @@ struct ComponentParams
     const float * negLutEnd;  // lutEnd for negative part of half domain LUT.
     float flipSign;           // Flip the sign of value to handle decreasing luts.
     float bisectPoint;        // Point of switching from pos to neg of half domain.
+    LutSearchIndex lutIndex;    // Search index of the effective lutData.
+    LutSearchIndex negLutIndex; // Search index of the negative part of half domain LUT.
 
     static void setComponentParams(ComponentParams & params,
                                    const Lut1DOpData::ComponentProperties & properties,
                                    const float * lutPtr,
                                    float lutZeroEntry);
+
+    // Build the search indices once the LUT values are set.
+    void initSearchIndices(bool isHalfDomain);
 };
 
 template<BitDepth inBD, BitDepth outBD>
@@ -217,6 +464,8 @@ public:
 
     void apply(const void * inImg, void * outImg, long numPixels) const override;
 
+    size_t getMemorySize() const override;
+
     void resetData();
 
     virtual void updateData(ConstLut1DOpDataRcPtr & lut);
@@ -325,7 +574,7 @@ template<BitDepth inBD, BitDepth outBD>
 template<typename T>
 void BaseLut1DRenderer<inBD, outBD>::updateData(ConstLut1DOpDataRcPtr & lut)
 {
-    resetData<T>();
+    reset();
 
     m_dim = lut->getArray().getLength();
 
@@ -337,6 +586,9 @@ void BaseLut1DRenderer<inBD, outBD>::updateData(ConstLut1DOpDataRcPtr & lut)
 
     const bool mustResample = !lut->mayLookup(inBD);
 
+    // Note that the resampling preserves the identical channels.
+    const bool singleLut = lut->hasSingleLut();
+
     if (isLookup())
     {
         ConstLut1DOpDataRcPtr newLut = lut;
@@ -356,33 +608,34 @@ void BaseLut1DRenderer<inBD, outBD>::updateData(ConstLut1DOpDataRcPtr & lut)
 
         m_dim = newLut->getArray().getLength();
 
-        m_tmpLutR = new T[m_dim];
-        m_tmpLutG = new T[m_dim];
-        m_tmpLutB = new T[m_dim];
+        allocateData<T>(singleLut);
 
         const Array::Values & lutValues = newLut->getArray().getValues();
 
-        // TODO: Would be faster if R, G, B were adjacent in memory?
         for(unsigned long i=0; i<m_dim; ++i)
         {
-            ((T*)m_tmpLutR)[i] = L_ADJUST(lutValues[i*3+0] * outMax);
-            ((T*)m_tmpLutG)[i] = L_ADJUST(lutValues[i*3+1] * outMax);
-            ((T*)m_tmpLutB)[i] = L_ADJUST(lutValues[i*3+2] * outMax);
+            ((T*)m_tmpLutR)[i*m_lutStride] = L_ADJUST(lutValues[i*3+0] * outMax);
+            if (!singleLut)
+            {
+                ((T*)m_tmpLutG)[i*m_lutStride] = L_ADJUST(lutValues[i*3+1] * outMax);
+                ((T*)m_tmpLutB)[i*m_lutStride] = L_ADJUST(lutValues[i*3+2] * outMax);
+            }
         }
     }
     else
     {
         const Array::Values & lutValues = lut->getArray().getValues();
 
-        m_tmpLutR = new float[m_dim];
-        m_tmpLutG = new float[m_dim];
-        m_tmpLutB = new float[m_dim];
+        allocateData<float>(singleLut);
 
         for(unsigned long i=0; i<m_dim; ++i)
         {
-            ((float*)m_tmpLutR)[i] = SanitizeFloat(lutValues[i*3+0] * outMax);
-            ((float*)m_tmpLutG)[i] = SanitizeFloat(lutValues[i*3+1] * outMax);
-            ((float*)m_tmpLutB)[i] = SanitizeFloat(lutValues[i*3+2] * outMax);
+            ((float*)m_tmpLutR)[i*m_lutStride] = SanitizeFloat(lutValues[i*3+0] * outMax);
+            if (!singleLut)
+            {
+                ((float*)m_tmpLutG)[i*m_lutStride] = SanitizeFloat(lutValues[i*3+1] * outMax);
+                ((float*)m_tmpLutB)[i*m_lutStride] = SanitizeFloat(lutValues[i*3+2] * outMax);
+            }
         }
     }
 
@@ -397,51 +650,30 @@ void BaseLut1DRenderer<inBD, outBD>::updateData(ConstLut1DOpDataRcPtr & lut)
 template<BitDepth inBD, BitDepth outBD>
 void BaseLut1DRenderer<inBD, outBD>::reset()
 {
-    if(!m_tmpLutR && !m_tmpLutG && !m_tmpLutB) return;
+    FreeRendererTable(m_tmpLut, m_tmpLutNumBytes); m_tmpLut = nullptr;
 
-    if (isLookup())
-    {
-        switch(m_outBitDepth)
-        {
-            case BIT_DEPTH_UINT8:
-                resetData<BitDepthInfo<BIT_DEPTH_UINT8>::Type>();
-                break;
-            case BIT_DEPTH_UINT10:
-                resetData<BitDepthInfo<BIT_DEPTH_UINT10>::Type>();
-                break;
-            case BIT_DEPTH_UINT12:
-                resetData<BitDepthInfo<BIT_DEPTH_UINT12>::Type>();
-                break;
-            case BIT_DEPTH_UINT16:
-                resetData<BitDepthInfo<BIT_DEPTH_UINT16>::Type>();
-                break;
-            case BIT_DEPTH_F16:
-                resetData<BitDepthInfo<BIT_DEPTH_F16>::Type>();
-                break;
-            case BIT_DEPTH_F32:
-                resetData<BitDepthInfo<BIT_DEPTH_F32>::Type>();
-                break;
-
-            case BIT_DEPTH_UINT14:
-            case BIT_DEPTH_UINT32:
-            case BIT_DEPTH_UNKNOWN:
-            default:
-                break;
-        }
-    }
-    else
-    {
-        resetData<float>();
-    }
+    m_tmpLutR = nullptr;
+    m_tmpLutG = nullptr;
+    m_tmpLutB = nullptr;
+
+    m_lutStride = 1;
+    m_tmpLutNumBytes = 0;
 }
 
 template<BitDepth inBD, BitDepth outBD>
 template<typename T>
-void BaseLut1DRenderer<inBD, outBD>::resetData()
+void BaseLut1DRenderer<inBD, outBD>::allocateData(bool singleLut)
 {
-    delete [](T*)m_tmpLutR; m_tmpLutR = nullptr;
-    delete [](T*)m_tmpLutG; m_tmpLutG = nullptr;
-    delete [](T*)m_tmpLutB; m_tmpLutB = nullptr;
+    m_lutStride = singleLut ? 1 : 4;
+
+    // The padding values are never read but are initialized anyway.
+    m_tmpLutNumBytes = m_dim * m_lutStride * sizeof(T);
+    m_tmpLut = AllocateRendererTable(m_tmpLutNumBytes);
+    std::memset(m_tmpLut, 0, m_tmpLutNumBytes);
+
+    m_tmpLutR = m_tmpLut;
+    m_tmpLutG = singleLut ? m_tmpLut : (void *)((T*)m_tmpLut + 1);
+    m_tmpLutB = singleLut ? m_tmpLut : (void *)((T*)m_tmpLut + 2);
 }
 
 template<BitDepth inBD, BitDepth outBD>
@@ -471,9 +703,9 @@ void Lut1DRendererHalfCode<inBD, outBD>::apply(const void * inImg, void * outImg
 
         for (long idx=0; idx<numPixels; ++idx)
         {
-            out[0] = LookupLut<InType, OutType>::compute(lutR, in[0]);
-            out[1] = LookupLut<InType, OutType>::compute(lutG, in[1]);
-            out[2] = LookupLut<InType, OutType>::compute(lutB, in[2]);
+            out[0] = LookupLut<InType, OutType>::compute(lutR, in[0], this->m_lutStride);
+            out[1] = LookupLut<InType, OutType>::compute(lutG, in[1], this->m_lutStride);
+            out[2] = LookupLut<InType, OutType>::compute(lutB, in[2], this->m_lutStride);
             out[3] = OutType(in[3] * this->m_alphaScaling);
 
             in  += 4;
@@ -482,50 +714,148 @@ void Lut1DRendererHalfCode<inBD, outBD>::apply(const void * inImg, void * outImg
     }
     else  // Need to interpolate rather than simply lookup.
     {
-        const float * lutR = (const float *)this->m_tmpLutR;
-        const float * lutG = (const float *)this->m_tmpLutG;
-        const float * lutB = (const float *)this->m_tmpLutB;
-
-        for(long idx=0; idx<numPixels; ++idx)
+        if (m_finiteInputs)
+        {
+            interpolate<true>((const float *)inImg, outImg, numPixels);
+        }
+        else
         {
-            const IndexPair redInterVals   = IndexPair::GetEdgeFloatValues(in[0]);
-            const IndexPair greenInterVals = IndexPair::GetEdgeFloatValues(in[1]);
-            const IndexPair blueInterVals  = IndexPair::GetEdgeFloatValues(in[2]);
+            interpolate<false>((const float *)inImg, outImg, numPixels);
+        }
+    }
+}
 
-            // Since fraction is in the domain [0, 1), interpolate using
-            // 1-fraction in order to avoid cases like -/+Inf * 0.
-            out[0] = Converter<outBD>::CastValue(
-                        lerpf(lutR[redInterVals.valB],
-                              lutR[redInterVals.valA],
-                              1.0f-redInterVals.fraction));
+template<BitDepth inBD, BitDepth outBD>
+template<bool finite>
+void Lut1DRendererHalfCode<inBD, outBD>::interpolate(const float * in, void * outImg,
+                                                     long numPixels) const
+{
+    typedef typename BitDepthInfo<outBD>::Type OutType;
 
-            out[1] = Converter<outBD>::CastValue(
-                        lerpf(lutG[greenInterVals.valB],
-                              lutG[greenInterVals.valA],
-                              1.0f-greenInterVals.fraction));
+    OutType * out = (OutType *)outImg;
 
-            out[2] = Converter<outBD>::CastValue(
-                        lerpf(lutB[blueInterVals.valB],
-                              lutB[blueInterVals.valA],
-                              1.0f-blueInterVals.fraction));
+    const float * lutR = (const float *)this->m_tmpLutR;
+    const float * lutG = (const float *)this->m_tmpLutG;
+    const float * lutB = (const float *)this->m_tmpLutB;
+    const unsigned long stride = this->m_lutStride;
 
-            out[3] = Converter<outBD>::CastValue(in[3] * this->m_alphaScaling);
+    for(long idx=0; idx<numPixels; ++idx)
+    {
+        const IndexPair redInterVals   = IndexPair::GetEdgeFloatValues<finite>(in[0]);
+        const IndexPair greenInterVals = IndexPair::GetEdgeFloatValues<finite>(in[1]);
+        const IndexPair blueInterVals  = IndexPair::GetEdgeFloatValues<finite>(in[2]);
 
-            in  += 4;
-            out += 4;
+        // Since fraction is in the domain [0, 1), interpolate using
+        // 1-fraction in order to avoid cases like -/+Inf * 0.
+        out[0] = Converter<outBD>::CastValue(
+                    lerpf(lutR[redInterVals.valB * stride],
+                          lutR[redInterVals.valA * stride],
+                          1.0f-redInterVals.fraction));
+
+        out[1] = Converter<outBD>::CastValue(
+                    lerpf(lutG[greenInterVals.valB * stride],
+                          lutG[greenInterVals.valA * stride],
+                          1.0f-greenInterVals.fraction));
+
+        out[2] = Converter<outBD>::CastValue(
+                    lerpf(lutB[blueInterVals.valB * stride],
+                          lutB[blueInterVals.valA * stride],
+                          1.0f-blueInterVals.fraction));
+
+        out[3] = Converter<outBD>::CastValue(in[3] * this->m_alphaScaling);
+
+        in  += 4;
+        out += 4;
+    }
+}
+
+template<BitDepth inBD, BitDepth outBD>
+void Lut1DRendererHalfCode<inBD, outBD>::applyPlanar(const float * const * inPlanes,
+                                                     float * const * outPlanes,
+                                                     long numPixels) const
+{
+    if (m_finiteInputs)
+    {
+        interpolatePlanar<true>(inPlanes, outPlanes, numPixels);
+    }
+    else
+    {
+        interpolatePlanar<false>(inPlanes, outPlanes, numPixels);
+    }
+}
+
+template<BitDepth inBD, BitDepth outBD>
+template<bool finite>
+void Lut1DRendererHalfCode<inBD, outBD>::interpolatePlanar(const float * const * inPlanes,
+                                                           float * const * outPlanes,
+                                                           long numPixels) const
+{
+    const float * luts[3] = { (const float *)this->m_tmpLutR,
+                              (const float *)this->m_tmpLutG,
+                              (const float *)this->m_tmpLutB };
+    const unsigned long stride = this->m_lutStride;
+
+    for (int c = 0; c < 3; ++c)
+    {
+        const float * lut = luts[c];
+        const float * in = inPlanes[c];
+        float * out = outPlanes[c];
+
+        for (long idx=0; idx<numPixels; ++idx)
+        {
+            const IndexPair interVals = IndexPair::GetEdgeFloatValues<finite>(in[idx]);
+
+            out[idx] = lerpf(lut[interVals.valB * stride], lut[interVals.valA * stride], 1.0f-interVals.fraction);
         }
     }
+
+    for (long idx=0; idx<numPixels; ++idx)
+    {
+        outPlanes[3][idx] = inPlanes[3][idx] * this->m_alphaScaling;
+    }
 }
 
-IndexPair IndexPair::GetEdgeFloatValues(float fIn)
+template<BitDepth inBD, BitDepth outBD>
+void Lut1DRendererHalfCode<inBD, outBD>::applyRGB(const float * inImg, float * outImg,
+                                                  long numPixels) const
 {
-    // TODO: Could we speed this up (perhaps alternate nan/inf behavior)?
+    if (m_finiteInputs)
+    {
+        interpolateRGB<true>(inImg, outImg, numPixels);
+    }
+    else
+    {
+        interpolateRGB<false>(inImg, outImg, numPixels);
+    }
+}
+
+template<BitDepth inBD, BitDepth outBD>
+template<bool finite>
+void Lut1DRendererHalfCode<inBD, outBD>::interpolateRGB(const float * inImg, float * outImg,
+                                                        long numPixels) const
+{
+    const float * luts[3] = { (const float *)this->m_tmpLutR,
+                              (const float *)this->m_tmpLutG,
+                              (const float *)this->m_tmpLutB };
+    const unsigned long stride = this->m_lutStride;
+
+    for (long idx=0; idx<3*numPixels; ++idx)
+    {
+        const float * lut = luts[idx % 3];
+        const IndexPair interVals = IndexPair::GetEdgeFloatValues<finite>(inImg[idx]);
+
+        outImg[idx] = lerpf(lut[interVals.valB * stride], lut[interVals.valA * stride], 1.0f-interVals.fraction);
+    }
+}
 
+template<bool finite>
+IndexPair IndexPair::GetEdgeFloatValues(float fIn)
+{
     half halfVal;
     IndexPair idxPair;
 
     halfVal = half( fIn );
-    if(halfVal.isInfinity())
+    if(!finite && halfVal.isInfinity())
     {
         halfVal = halfVal.isNegative() ? -HALF_MAX : HALF_MAX;
         fIn = halfVal;
@@ -590,9 +920,9 @@ void Lut1DRenderer<inBD, outBD>::apply(const void * inImg, void * outImg, long n
 
         for(long idx=0; idx<numPixels; ++idx)
         {
-            out[0] = LookupLut<InType, OutType>::compute(lutR, in[0]);
-            out[1] = LookupLut<InType, OutType>::compute(lutG, in[1]);
-            out[2] = LookupLut<InType, OutType>::compute(lutB, in[2]);
+            out[0] = LookupLut<InType, OutType>::compute(lutR, in[0], this->m_lutStride);
+            out[1] = LookupLut<InType, OutType>::compute(lutG, in[1], this->m_lutStride);
+            out[2] = LookupLut<InType, OutType>::compute(lutB, in[2], this->m_lutStride);
             out[3] = OutType(in[3] * this->m_alphaScaling);
 
             in  += 4;
@@ -604,6 +934,7 @@ void Lut1DRenderer<inBD, outBD>::apply(const void * inImg, void * outImg, long n
         const float * lutR = (const float *)this->m_tmpLutR;
         const float * lutG = (const float *)this->m_tmpLutG;
         const float * lutB = (const float *)this->m_tmpLutB;
+        const unsigned long stride = this->m_lutStride;
 
 #ifdef USE_SSE
         __m128 step = _mm_set_ps(1.0f, this->m_step, this->m_step, this->m_step);
@@ -676,16 +1007,16 @@ void Lut1DRenderer<inBD, outBD>::apply(const void * inImg, void * outImg, long n
             // 0*Infinity (which is NaN).
 
             out[0] = Converter<outBD>::CastValue(
-                        lerpf(lutR[(unsigned int)highIdx[0]], 
-                              lutR[(unsigned int)lowIdx[0]], 
+                        lerpf(lutR[(unsigned int)highIdx[0] * stride], 
+                              lutR[(unsigned int)lowIdx[0] * stride], 
                               delta[0]));
             out[1] = Converter<outBD>::CastValue(
-                        lerpf(lutG[(unsigned int)highIdx[1]],
-                              lutG[(unsigned int)lowIdx[1]],
+                        lerpf(lutG[(unsigned int)highIdx[1] * stride],
+                              lutG[(unsigned int)lowIdx[1] * stride],
                               delta[1]));
             out[2] = Converter<outBD>::CastValue(
-                        lerpf(lutB[(unsigned int)highIdx[2]], 
-                              lutB[(unsigned int)lowIdx[2]],
+                        lerpf(lutB[(unsigned int)highIdx[2] * stride], 
+                              lutB[(unsigned int)lowIdx[2] * stride],
                               delta[2]));
             out[3] = Converter<outBD>::CastValue(in[3] * this->m_alphaScaling);
 
@@ -695,6 +1026,137 @@ void Lut1DRenderer<inBD, outBD>::apply(const void * inImg, void * outImg, long n
     }
 }
 
+// Interpolate the values of one plane (i.e. four pixels at a time for the index
+// computations with SSE) doing the same computations than the packed renderer.
+// The LUT values are 'stride' apart (refer to BaseLut1DRenderer::m_lutStride).
+inline void ApplyLut1DPlane(const float * lut, unsigned long stride,
+                            float step, float dimMinusOne,
+                            const float * in, float * out, long numPixels)
+{
+#ifdef USE_SSE
+    const __m128 mm_step = _mm_set1_ps(step);
+    const __m128 mm_dimMinusOne = _mm_set1_ps(dimMinusOne);
+
+    for(long i=0; i<numPixels; i+=4)
+    {
+        const long count = std::min(4L, numPixels - i);
+
+        __m128 idx = _mm_mul_ps(sseLoadPartial(in + i, count), mm_step);
+
+        // _mm_max_ps => NaNs become 0
+        idx = _mm_min_ps(_mm_max_ps(idx, EZERO), mm_dimMinusOne);
+
+        const __m128 lIdx = _mm_cvtepi32_ps(_mm_cvttps_epi32(idx));
+        const __m128 hIdx = _mm_min_ps(_mm_add_ps(lIdx, EONE), mm_dimMinusOne);
+        const __m128 d = _mm_sub_ps(hIdx, idx);
+
+        OCIO_ALIGN(float delta[4]);   _mm_store_ps(delta, d);
+        OCIO_ALIGN(float lowIdx[4]);  _mm_store_ps(lowIdx, lIdx);
+        OCIO_ALIGN(float highIdx[4]); _mm_store_ps(highIdx, hIdx);
+
+        for(long j=0; j<count; ++j)
+        {
+            out[i + j] = lerpf(lut[(unsigned int)highIdx[j] * stride],
+                               lut[(unsigned int)lowIdx[j] * stride],
+                               delta[j]);
+        }
+    }
+#else
+    for(long i=0; i<numPixels; ++i)
+    {
+        // NaNs become 0
+        const float idx = std::min(std::max(0.f, step * in[i]), dimMinusOne);
+
+        const unsigned int lowIdx  = static_cast<unsigned int>(std::floor(idx));
+        const unsigned int highIdx = static_cast<unsigned int>(std::ceil(idx));
+
+        out[i] = lerpf(lut[highIdx * stride], lut[lowIdx * stride], (float)highIdx - idx);
+    }
+#endif
+}
+
+// Interpolate packed RGB pixels, the three channels sharing the same index
+// computations (i.e. only the LUT differs).
+inline void ApplyLut1DRGB(const float * const * luts, unsigned long stride,
+                          float step, float dimMinusOne,
+                          const float * in, float * out, long numPixels)
+{
+    const long numValues = 3 * numPixels;
+
+#ifdef USE_SSE
+    const __m128 mm_step = _mm_set1_ps(step);
+    const __m128 mm_dimMinusOne = _mm_set1_ps(dimMinusOne);
+
+    for(long i=0; i<numValues; i+=4)
+    {
+        const long count = std::min(4L, numValues - i);
+
+        __m128 idx = _mm_mul_ps(sseLoadPartial(in + i, count), mm_step);
+
+        // _mm_max_ps => NaNs become 0
+        idx = _mm_min_ps(_mm_max_ps(idx, EZERO), mm_dimMinusOne);
+
+        const __m128 lIdx = _mm_cvtepi32_ps(_mm_cvttps_epi32(idx));
+        const __m128 hIdx = _mm_min_ps(_mm_add_ps(lIdx, EONE), mm_dimMinusOne);
+        const __m128 d = _mm_sub_ps(hIdx, idx);
+
+        OCIO_ALIGN(float delta[4]);   _mm_store_ps(delta, d);
+        OCIO_ALIGN(float lowIdx[4]);  _mm_store_ps(lowIdx, lIdx);
+        OCIO_ALIGN(float highIdx[4]); _mm_store_ps(highIdx, hIdx);
+
+        for(long j=0; j<count; ++j)
+        {
+            const float * lut = luts[(i + j) % 3];
+            out[i + j] = lerpf(lut[(unsigned int)highIdx[j] * stride],
+                               lut[(unsigned int)lowIdx[j] * stride],
+                               delta[j]);
+        }
+    }
+#else
+    for(long i=0; i<numValues; ++i)
+    {
+        const float * lut = luts[i % 3];
+
+        // NaNs become 0
+        const float idx = std::min(std::max(0.f, step * in[i]), dimMinusOne);
+
+        const unsigned int lowIdx  = static_cast<unsigned int>(std::floor(idx));
+        const unsigned int highIdx = static_cast<unsigned int>(std::ceil(idx));
+
+        out[i] = lerpf(lut[highIdx * stride], lut[lowIdx * stride], (float)highIdx - idx);
+    }
+#endif
+}
+
+template<BitDepth inBD, BitDepth outBD>
+void Lut1DRenderer<inBD, outBD>::applyPlanar(const float * const * inPlanes,
+                                             float * const * outPlanes,
+                                             long numPixels) const
+{
+    ApplyLut1DPlane((const float *)this->m_tmpLutR, this->m_lutStride,
+                    this->m_step, this->m_dimMinusOne, inPlanes[0], outPlanes[0], numPixels);
+    ApplyLut1DPlane((const float *)this->m_tmpLutG, this->m_lutStride,
+                    this->m_step, this->m_dimMinusOne, inPlanes[1], outPlanes[1], numPixels);
+    ApplyLut1DPlane((const float *)this->m_tmpLutB, this->m_lutStride,
+                    this->m_step, this->m_dimMinusOne, inPlanes[2], outPlanes[2], numPixels);
+
+    for (long idx=0; idx<numPixels; ++idx)
+    {
+        outPlanes[3][idx] = inPlanes[3][idx] * this->m_alphaScaling;
+    }
+}
+
+template<BitDepth inBD, BitDepth outBD>
+void Lut1DRenderer<inBD, outBD>::applyRGB(const float * inImg, float * outImg,
+                                          long numPixels) const
+{
+    const float * luts[3] = { (const float *)this->m_tmpLutR,
+                              (const float *)this->m_tmpLutG,
+                              (const float *)this->m_tmpLutB };
+
+    ApplyLut1DRGB(luts, this->m_lutStride, this->m_step, this->m_dimMinusOne, inImg, outImg, numPixels);
+}
+
 namespace GamutMapUtils
 {
     // Compute the indices for the smallest, middle, and largest elements of
@@ -717,6 +1179,137 @@ namespace GamutMapUtils
         mid = table[++val];
         min = table[++val];
     }
+
+    // Restore the hue of the per-channel LUT values RGB2 of the pixel RGB i.e. the middle
+    // channel keeps its relative position between the smallest and the largest channels.
+    inline void HueAdjust(const float * RGB, float * RGB2)
+    {
+        int min, mid, max;
+        Order3(RGB, min, mid, max);
+
+        const float orig_chroma = RGB[max] - RGB[min];
+        const float hue_factor
+            = orig_chroma == 0.f ? 0.f
+                                 : (RGB[mid] - RGB[min]) / orig_chroma;
+
+        const float new_chroma = RGB2[max] - RGB2[min];
+        RGB2[mid] = hue_factor * new_chroma + RGB2[min];
+    }
+
+#ifdef USE_SSE
+    // Branch-free HueAdjust() of four pixels (i.e. one register per channel) doing the
+    // same floating-point operations. The masks reproduce the Order3() table, including
+    // the ties and the NaNs: the middle channel is green when (r>g) == (g>b), blue when
+    // (r>g) == (r>b) otherwise, and red in the remaining cases.
+    inline void HueAdjustSSE(const __m128 & r, const __m128 & g, const __m128 & b,
+                             __m128 & r2, __m128 & g2, __m128 & b2)
+    {
+        const __m128 rg = _mm_cmpgt_ps(r, g);
+        const __m128 gb = _mm_cmpgt_ps(g, b);
+        const __m128 rb = _mm_cmpgt_ps(r, b);
+
+        const __m128 notMidG = _mm_xor_ps(rg, gb);
+        const __m128 midR    = _mm_and_ps(notMidG, _mm_xor_ps(rg, rb));
+        const __m128 midG    = _mm_andnot_ps(notMidG, _mm_castsi128_ps(_mm_set1_epi32(-1)));
+        const __m128 midB    = _mm_andnot_ps(midR, notMidG);
+
+        // When red is not the middle channel, it is either the largest or the smallest
+        // one, the other one being the remaining channel.
+        const __m128 other  = sseSelect(midG, b, g);
+        const __m128 other2 = sseSelect(midG, b2, g2);
+
+        const __m128 maxV  = sseSelect(midR, sseSelect(gb, g, b), sseSelect(rg, r, other));
+        const __m128 minV  = sseSelect(midR, sseSelect(gb, b, g), sseSelect(rg, other, r));
+        const __m128 midV  = sseSelect(midR, r, sseSelect(midG, g, b));
+        const __m128 maxV2 = sseSelect(midR, sseSelect(gb, g2, b2), sseSelect(rg, r2, other2));
+        const __m128 minV2 = sseSelect(midR, sseSelect(gb, b2, g2), sseSelect(rg, other2, r2));
+
+        // The division result is discarded when the chroma is zero (but not when NaN).
+        const __m128 origChroma = _mm_sub_ps(maxV, minV);
+        const __m128 hueFactor  = _mm_and_ps(_mm_cmpneq_ps(origChroma, EZERO),
+                                             _mm_div_ps(_mm_sub_ps(midV, minV), origChroma));
+
+        const __m128 newChroma = _mm_sub_ps(maxV2, minV2);
+        const __m128 newMid    = _mm_add_ps(_mm_mul_ps(hueFactor, newChroma), minV2);
+
+        r2 = sseSelect(midR, newMid, r2);
+        g2 = sseSelect(midG, newMid, g2);
+        b2 = sseSelect(midB, newMid, b2);
+    }
+
+    // Restore the hue of the packed RGBA pixels 'lutValues' holding the per-channel LUT
+    // values of the pixels 'in' (refer to HueAdjust()) and write them to 'out', which
+    // could be 'in' but not 'lutValues'.
+    inline void HueAdjustPixelsSSE(const float * in, const float * lutValues,
+                                   float * out, long numPixels)
+    {
+        long idx = 0;
+        for (; idx + 4 <= numPixels; idx += 4)
+        {
+            __m128 r = _mm_loadu_ps(in);
+            __m128 g = _mm_loadu_ps(in + 4);
+            __m128 b = _mm_loadu_ps(in + 8);
+            __m128 a = _mm_loadu_ps(in + 12);
+            _MM_TRANSPOSE4_PS(r, g, b, a);
+
+            __m128 r2 = _mm_loadu_ps(lutValues);
+            __m128 g2 = _mm_loadu_ps(lutValues + 4);
+            __m128 b2 = _mm_loadu_ps(lutValues + 8);
+            __m128 a2 = _mm_loadu_ps(lutValues + 12);
+            _MM_TRANSPOSE4_PS(r2, g2, b2, a2);
+
+            HueAdjustSSE(r, g, b, r2, g2, b2);
+
+            _MM_TRANSPOSE4_PS(r2, g2, b2, a2);
+            _mm_storeu_ps(out,      r2);
+            _mm_storeu_ps(out + 4,  g2);
+            _mm_storeu_ps(out + 8,  b2);
+            _mm_storeu_ps(out + 12, a2);
+
+            in        += 16;
+            lutValues += 16;
+            out       += 16;
+        }
+
+        for (; idx < numPixels; ++idx)
+        {
+            const float RGB[] = { in[0], in[1], in[2] };
+            float RGB2[] = { lutValues[0], lutValues[1], lutValues[2] };
+            HueAdjust(RGB, RGB2);
+
+            out[0] = RGB2[0];
+            out[1] = RGB2[1];
+            out[2] = RGB2[2];
+            out[3] = lutValues[3];
+
+            in        += 4;
+            lutValues += 4;
+            out       += 4;
+        }
+    }
+
+    // Process 32-bit float RGBA pixels with a per-channel renderer, then restore their hue.
+    // The pixels are processed by small blocks so the input values are still available
+    // when processing in place.
+    template<typename Func>
+    inline void ApplyHueAdjustSSE(const float * in, float * out, long numPixels,
+                                  const Func & applyPerChannel)
+    {
+        static constexpr long BlockSize = 128;
+        OCIO_ALIGN(float lutValues[4 * BlockSize]);
+
+        for (long idx = 0; idx < numPixels; idx += BlockSize)
+        {
+            const long count = std::min(BlockSize, numPixels - idx);
+
+            applyPerChannel(in, lutValues, count);
+            HueAdjustPixelsSSE(in, lutValues, out, count);
+
+            in  += 4 * count;
+            out += 4 * count;
+        }
+    }
+#endif
 };
 
 
@@ -727,12 +1320,25 @@ namespace GamutMapUtils
 template<BitDepth inBD, BitDepth outBD>
 void Lut1DRendererHalfCodeHueAdjust<inBD, outBD>::apply(const void * inImg, void * outImg, long numPixels) const
 {
+#ifdef USE_SSE
+    if (inBD == BIT_DEPTH_F32 && outBD == BIT_DEPTH_F32)
+    {
+        GamutMapUtils::ApplyHueAdjustSSE((const float *)inImg, (float *)outImg, numPixels,
+            [this](const float * in, float * out, long count)
+            {
+                this->Lut1DRendererHalfCode<inBD, outBD>::apply(in, out, count);
+            });
+        return;
+    }
+#endif
+
     typedef typename BitDepthInfo<inBD>::Type InType;
     typedef typename BitDepthInfo<outBD>::Type OutType;
 
     const float * lutR = (const float *)this->m_tmpLutR;
     const float * lutG = (const float *)this->m_tmpLutG;
     const float * lutB = (const float *)this->m_tmpLutB;
+    const unsigned long stride = this->m_lutStride;
 
     const InType * in = (InType *)inImg;
     OutType * out = (OutType *)outImg;
@@ -754,9 +1360,9 @@ void Lut1DRendererHalfCodeHueAdjust<inBD, outBD>::apply(const void * inImg, void
                                       :  (RGB[mid] - RGB[min]) / orig_chroma;
 
             float RGB2[] = {
-                LookupLut<InType, float>::compute(lutR, in[0]),
-                LookupLut<InType, float>::compute(lutG, in[1]),
-                LookupLut<InType, float>::compute(lutB, in[2])   };
+                LookupLut<InType, float>::compute(lutR, in[0], this->m_lutStride),
+                LookupLut<InType, float>::compute(lutG, in[1], this->m_lutStride),
+                LookupLut<InType, float>::compute(lutB, in[2], this->m_lutStride)   };
 
             const float new_chroma = RGB2[max] - RGB2[min];
 
@@ -787,14 +1393,14 @@ void Lut1DRendererHalfCodeHueAdjust<inBD, outBD>::apply(const void * inImg, void
             // Since fraction is in the domain [0, 1), interpolate using
             // 1-fraction in order to avoid cases like -/+Inf * 0.
             float RGB2[] = {
-                lerpf(lutR[redInterVals.valB],
-                      lutR[redInterVals.valA],
+                lerpf(lutR[redInterVals.valB * stride],
+                      lutR[redInterVals.valA * stride],
                       1.0f-redInterVals.fraction),
-                lerpf(lutG[greenInterVals.valB],
-                      lutG[greenInterVals.valA],
+                lerpf(lutG[greenInterVals.valB * stride],
+                      lutG[greenInterVals.valA * stride],
                       1.0f-greenInterVals.fraction),
-                lerpf(lutB[blueInterVals.valB],
-                      lutB[blueInterVals.valA],
+                lerpf(lutB[blueInterVals.valB * stride],
+                      lutB[blueInterVals.valA * stride],
                       1.0f-blueInterVals.fraction)  };
 
             // TODO: ease SSE implementation (may be applied to all chans):
@@ -819,15 +1425,88 @@ void Lut1DRendererHalfCodeHueAdjust<inBD, outBD>::apply(const void * inImg, void
     }
 }
 
+template<BitDepth inBD, BitDepth outBD>
+void Lut1DRendererNearest<inBD, outBD>::apply(const void * inImg, void * outImg, long numPixels) const
+{
+    typedef typename BitDepthInfo<outBD>::Type OutType;
+
+    const float * in = (const float *)inImg;
+    OutType * out = (OutType *)outImg;
+
+    const float * luts[3] = { (const float *)this->m_tmpLutR,
+                              (const float *)this->m_tmpLutG,
+                              (const float *)this->m_tmpLutB };
+    const unsigned long stride = this->m_lutStride;
+
+    for (long i = 0; i < numPixels; ++i)
+    {
+        for (int c = 0; c < 3; ++c)
+        {
+            // NaNs become 0.
+            const float idx = std::min(std::max(0.f, this->m_step * in[c]), this->m_dimMinusOne);
+            out[c] = Converter<outBD>::CastValue(luts[c][(unsigned int)(idx + 0.5f) * stride]);
+        }
+        out[3] = Converter<outBD>::CastValue(in[3] * this->m_alphaScaling);
+
+        in  += 4;
+        out += 4;
+    }
+}
+
+template<BitDepth inBD, BitDepth outBD>
+void Lut1DRendererHalfCodeNearest<inBD, outBD>::apply(const void * inImg, void * outImg,
+                                                      long numPixels) const
+{
+    typedef typename BitDepthInfo<outBD>::Type OutType;
+
+    const float * in = (const float *)inImg;
+    OutType * out = (OutType *)outImg;
+
+    const float * luts[3] = { (const float *)this->m_tmpLutR,
+                              (const float *)this->m_tmpLutG,
+                              (const float *)this->m_tmpLutB };
+    const unsigned long stride = this->m_lutStride;
+
+    for (long i = 0; i < numPixels; ++i)
+    {
+        for (int c = 0; c < 3; ++c)
+        {
+            half halfVal = half(in[c]);
+            if (halfVal.isInfinity())
+            {
+                halfVal = halfVal.isNegative() ? -HALF_MAX : HALF_MAX;
+            }
+            out[c] = Converter<outBD>::CastValue(luts[c][halfVal.bits() * stride]);
+        }
+        out[3] = Converter<outBD>::CastValue(in[3] * this->m_alphaScaling);
+
+        in  += 4;
+        out += 4;
+    }
+}
+
 template<BitDepth inBD, BitDepth outBD>
 void Lut1DRendererHueAdjust<inBD, outBD>::apply(const void * inImg, void * outImg, long numPixels) const
 {
+#ifdef USE_SSE
+    if (inBD == BIT_DEPTH_F32 && outBD == BIT_DEPTH_F32)
+    {
+        GamutMapUtils::ApplyHueAdjustSSE((const float *)inImg, (float *)outImg, numPixels,
+            [this](const float * in, float * out, long count)
+            {
+                this->Lut1DRenderer<inBD, outBD>::apply(in, out, count);
+            });
+        return;
+    }
+#endif
+
     typedef typename BitDepthInfo<inBD>::Type InType;
     typedef typename BitDepthInfo<outBD>::Type OutType;
 
     const float * lutR = (const float *)this->m_tmpLutR;
     const float * lutG = (const float *)this->m_tmpLutG;
     const float * lutB = (const float *)this->m_tmpLutB;
+    const unsigned long stride = this->m_lutStride;
 
     const InType * in = (InType *)inImg;
     OutType * out = (OutType *)outImg;
@@ -849,9 +1528,9 @@ void Lut1DRendererHueAdjust<inBD, outBD>::apply(const void * inImg, void * outIm
                                      : (RGB[mid] - RGB[min]) / orig_chroma;
 
             float RGB2[] = {
-                LookupLut<InType, float>::compute(lutR, in[0]),
-                LookupLut<InType, float>::compute(lutG, in[1]),
-                LookupLut<InType, float>::compute(lutB, in[2])
+                LookupLut<InType, float>::compute(lutR, in[0], this->m_lutStride),
+                LookupLut<InType, float>::compute(lutG, in[1], this->m_lutStride),
+                LookupLut<InType, float>::compute(lutB, in[2], this->m_lutStride)
             };
 
             const float new_chroma = RGB2[max] - RGB2[min];
@@ -951,9 +1630,9 @@ void Lut1DRendererHueAdjust<inBD, outBD>::apply(const void * inImg, void * outIm
             // thus handle the case where A or B is infinity and return infinity rather than
             // 0*Infinity (which is NaN).
             float RGB2[] = {
-                lerpf(lutR[(unsigned int)highIdx[0]], lutR[(unsigned int)lowIdx[0]], delta[0]),
-                lerpf(lutG[(unsigned int)highIdx[1]], lutG[(unsigned int)lowIdx[1]], delta[1]),
-                lerpf(lutB[(unsigned int)highIdx[2]], lutB[(unsigned int)lowIdx[2]], delta[2])
+                lerpf(lutR[(unsigned int)highIdx[0] * stride], lutR[(unsigned int)lowIdx[0] * stride], delta[0]),
+                lerpf(lutG[(unsigned int)highIdx[1] * stride], lutG[(unsigned int)lowIdx[1] * stride], delta[1]),
+                lerpf(lutB[(unsigned int)highIdx[2] * stride], lutB[(unsigned int)lowIdx[2] * stride], delta[2])
             };
 
             const float new_chroma = RGB2[max] - RGB2[min];
@@ -980,6 +1659,7 @@ namespace
 // start:       Pointer to the first effective LUT entry (end of flat spot).
 // startOffset: Distance between first LUT entry and start.
 // end:         Pointer to the last effective LUT entry (start of flat spot).
+// index:       Search index of the entries from start to end.
 // flipSign:    Flips val if we're working with the negative of the orig LUT.
 // scale:       From LUT index units to outDepth units.
 // val:         The value to invert.
@@ -988,6 +1668,7 @@ namespace
 float FindLutInv(const float * start,
                  const float   startOffset,
                  const float * end,
+                 const LutSearchIndex & index,
                  const float   flipSign,
                  const float   scale,
                  const float   val)
@@ -1005,7 +1686,8 @@ float FindLutInv(const float * start,
     // (NB: This is correct using either end or end+1 since lower_bound will return a
     //  value one greater than the second argument if no values in the array are >= cv.)
     // http://www.sgi.com/tech/stl/lower_bound.html
-    const float* lowbound = std::lower_bound(start, end, cv);
+    // (The search index only restricts the range to search.)
+    const float* lowbound = index.lowerBound(cv);
 
     // lower_bound() returns first entry >= val so decrement it unless val == *start.
     if (lowbound > start) {
@@ -1042,6 +1724,7 @@ float FindLutInv(const float * start,
 // start:       Pointer to the first effective LUT entry (end of flat spot).
 // startOffset: Distance between first LUT entry and start.
 // end:         Pointer to the last effective LUT entry (start of flat spot).
+// index:       Search index of the entries from start to end.
 // flipSign:    Flips val if we're working with the negative of the orig LUT.
 // scale:       From LUT index units to outDepth units.
 // val:         The value to invert.
@@ -1050,6 +1733,7 @@ float FindLutInv(const float * start,
 float FindLutInvHalf(const float * start,
                      const float   startOffset,
                      const float * end,
+                     const LutSearchIndex & index,
                      const float   flipSign,
                      const float   scale,
                      const float   val)
@@ -1061,7 +1745,7 @@ float FindLutInvHalf(const float * start,
     // Clamp the value to the range of the LUT.
     const float cv = std::min( std::max( val * flipSign, *start ), *end );
 
-    const float* lowbound = std::lower_bound(start, end, cv);
+    const float* lowbound = index.lowerBound(cv);
 
     // lower_bound() returns first entry >= val so decrement it unless val == *start.
     if (lowbound > start) {
@@ -1134,6 +1818,29 @@ void ComponentParams::setComponentParams(ComponentParams & params,
     params.negLutEnd   = lutPtr + properties.negEndDomain;
 }
 
+void ComponentParams::initSearchIndices(bool isHalfDomain)
+{
+    lutIndex.init(lutStart, lutEnd, isHalfDomain);
+    if (isHalfDomain)
+    {
+        negLutIndex.init(negLutStart, negLutEnd, isHalfDomain);
+    }
+}
+
+template<BitDepth inBD, BitDepth outBD>
+size_t InvLut1DRenderer<inBD, outBD>::getMemorySize() const
+{
+    size_t numBytes
+        = (m_tmpLutR.capacity() + m_tmpLutG.capacity() + m_tmpLutB.capacity()) * sizeof(float);
+
+    for(const ComponentParams * params : { &m_paramsR, &m_paramsG, &m_paramsB })
+    {
+        numBytes += params->lutIndex.getMemorySize() + params->negLutIndex.getMemorySize();
+    }
+
+    return numBytes;
+}
+
 template<BitDepth inBD, BitDepth outBD>
 void InvLut1DRenderer<inBD, outBD>::resetData()
 {
@@ -1203,6 +1910,11 @@ void InvLut1DRenderer<inBD, outBD>::updateData(ConstLut1DOpDataRcPtr & lut)
         }
     }
 
+    // Build the search indices (refer to LutSearchIndex).
+    m_paramsR.initSearchIndices(false);
+    m_paramsG.initSearchIndices(false);
+    m_paramsB.initSearchIndices(false);
+
     const float outMax = (float)GetBitDepthMaxValue(outBD);
 
     m_alphaScaling = outMax / (float)GetBitDepthMaxValue(inBD);
@@ -1228,6 +1940,7 @@ void InvLut1DRenderer<inBD, outBD>::apply(const void * inImg, void * outImg, lon
                     FindLutInv(this->m_paramsR.lutStart,
                                this->m_paramsR.startOffset,
                                this->m_paramsR.lutEnd,
+                               this->m_paramsR.lutIndex,
                                this->m_paramsR.flipSign,
                                m_scale,
                                (float)in[0]));
@@ -1237,6 +1950,7 @@ void InvLut1DRenderer<inBD, outBD>::apply(const void * inImg, void * outImg, lon
                     FindLutInv(this->m_paramsG.lutStart,
                                this->m_paramsG.startOffset,
                                this->m_paramsG.lutEnd,
+                               this->m_paramsG.lutIndex,
                                this->m_paramsG.flipSign,
                                m_scale,
                                (float)in[1]));
@@ -1246,6 +1960,7 @@ void InvLut1DRenderer<inBD, outBD>::apply(const void * inImg, void * outImg, lon
                     FindLutInv(this->m_paramsB.lutStart,
                                this->m_paramsB.startOffset,
                                this->m_paramsB.lutEnd,
+                               this->m_paramsB.lutIndex,
                                this->m_paramsB.flipSign,
                                m_scale,
                                (float)in[2]));
@@ -1268,6 +1983,18 @@ InvLut1DRendererHueAdjust<inBD, outBD>::InvLut1DRendererHueAdjust(ConstLut1DOpDa
 template<BitDepth inBD, BitDepth outBD>
 void InvLut1DRendererHueAdjust<inBD, outBD>::apply(const void * inImg, void * outImg, long numPixels) const
 {
+#ifdef USE_SSE
+    if (inBD == BIT_DEPTH_F32 && outBD == BIT_DEPTH_F32)
+    {
+        GamutMapUtils::ApplyHueAdjustSSE((const float *)inImg, (float *)outImg, numPixels,
+            [this](const float * in, float * out, long count)
+            {
+                this->InvLut1DRenderer<inBD, outBD>::apply(in, out, count);
+            });
+        return;
+    }
+#endif
+
     typedef typename BitDepthInfo<inBD>::Type InType;
     typedef typename BitDepthInfo<outBD>::Type OutType;
 
@@ -1291,6 +2018,7 @@ void InvLut1DRendererHueAdjust<inBD, outBD>::apply(const void * inImg, void * ou
             FindLutInv(this->m_paramsR.lutStart,
                        this->m_paramsR.startOffset,
                        this->m_paramsR.lutEnd,
+                       this->m_paramsR.lutIndex,
                        this->m_paramsR.flipSign,
                        this->m_scale,
                        RGB[0]),
@@ -1298,6 +2026,7 @@ void InvLut1DRendererHueAdjust<inBD, outBD>::apply(const void * inImg, void * ou
             FindLutInv(this->m_paramsG.lutStart,
                        this->m_paramsG.startOffset,
                        this->m_paramsG.lutEnd,
+                       this->m_paramsG.lutIndex,
                        this->m_paramsG.flipSign,
                        this->m_scale,
                        RGB[1]),
@@ -1305,6 +2034,7 @@ void InvLut1DRendererHueAdjust<inBD, outBD>::apply(const void * inImg, void * ou
             FindLutInv(this->m_paramsB.lutStart,
                        this->m_paramsB.startOffset,
                        this->m_paramsB.lutEnd,
+                       this->m_paramsB.lutIndex,
                        this->m_paramsB.flipSign,
                        this->m_scale,
                        RGB[2])
@@ -1413,6 +2143,11 @@ void InvLut1DRendererHalfCode<inBD, outBD>::updateData(ConstLut1DOpDataRcPtr & l
         }
     }
 
+    // Build the search indices (refer to LutSearchIndex).
+    this->m_paramsR.initSearchIndices(true);
+    this->m_paramsG.initSearchIndices(true);
+    this->m_paramsB.initSearchIndices(true);
+
     const float outMax = (float)GetBitDepthMaxValue(outBD);
 
     this->m_alphaScaling = outMax / (float)GetBitDepthMaxValue(inBD);
@@ -1453,12 +2188,14 @@ void InvLut1DRendererHalfCode<inBD, outBD>::apply(const void * inImg, void * out
                 ? FindLutInvHalf(this->m_paramsR.lutStart,
                                  this->m_paramsR.startOffset,
                                  this->m_paramsR.lutEnd,
+                                 this->m_paramsR.lutIndex,
                                  this->m_paramsR.flipSign,
                                  this->m_scale,
                                  redIn) 
                 : FindLutInvHalf(this->m_paramsR.negLutStart,
                                  this->m_paramsR.negStartOffset,
                                  this->m_paramsR.negLutEnd,
+                                 this->m_paramsR.negLutIndex,
                                  -this->m_paramsR.flipSign,
                                  this->m_scale,
                                  redIn);
@@ -1469,12 +2206,14 @@ void InvLut1DRendererHalfCode<inBD, outBD>::apply(const void * inImg, void * out
                 ? FindLutInvHalf(this->m_paramsG.lutStart,
                                  this->m_paramsG.startOffset,
                                  this->m_paramsG.lutEnd,
+                                 this->m_paramsG.lutIndex,
                                  this->m_paramsG.flipSign,
                                  this->m_scale,
                                  grnIn) 
                 : FindLutInvHalf(this->m_paramsG.negLutStart,
                                  this->m_paramsG.negStartOffset,
                                  this->m_paramsG.negLutEnd,
+                                 this->m_paramsG.negLutIndex,
                                  -this->m_paramsG.flipSign,
                                  this->m_scale,
                                  grnIn);
@@ -1485,12 +2224,14 @@ void InvLut1DRendererHalfCode<inBD, outBD>::apply(const void * inImg, void * out
                 ? FindLutInvHalf(this->m_paramsB.lutStart,
                                  this->m_paramsB.startOffset,
                                  this->m_paramsB.lutEnd,
+                                 this->m_paramsB.lutIndex,
                                  this->m_paramsB.flipSign,
                                  this->m_scale,
                                  bluIn)
                 : FindLutInvHalf(this->m_paramsB.negLutStart,
                                  this->m_paramsB.negStartOffset,
                                  this->m_paramsB.negLutEnd,
+                                 this->m_paramsB.negLutIndex,
                                  -this->m_paramsR.flipSign,
                                  this->m_scale,
                                  bluIn);
@@ -1515,6 +2256,18 @@ InvLut1DRendererHalfCodeHueAdjust<inBD, outBD>::InvLut1DRendererHalfCodeHueAdjus
 template<BitDepth inBD, BitDepth outBD>
 void InvLut1DRendererHalfCodeHueAdjust<inBD, outBD>::apply(const void * inImg, void * outImg, long numPixels) const
 {
+#ifdef USE_SSE
+    if (inBD == BIT_DEPTH_F32 && outBD == BIT_DEPTH_F32)
+    {
+        GamutMapUtils::ApplyHueAdjustSSE((const float *)inImg, (float *)outImg, numPixels,
+            [this](const float * in, float * out, long count)
+            {
+                this->InvLut1DRendererHalfCode<inBD, outBD>::apply(in, out, count);
+            });
+        return;
+    }
+#endif
+
     typedef typename BitDepthInfo<inBD>::Type InType;
     typedef typename BitDepthInfo<outBD>::Type OutType;
 
@@ -1542,12 +2295,14 @@ void InvLut1DRendererHalfCodeHueAdjust<inBD, outBD>::apply(const void * inImg, v
                 ? FindLutInvHalf(this->m_paramsR.lutStart,
                                  this->m_paramsR.startOffset,
                                  this->m_paramsR.lutEnd,
+                                 this->m_paramsR.lutIndex,
                                  this->m_paramsR.flipSign,
                                  this->m_scale,
                                  RGB[0])
                 : FindLutInvHalf(this->m_paramsR.negLutStart,
                                  this->m_paramsR.negStartOffset,
                                  this->m_paramsR.negLutEnd,
+                                 this->m_paramsR.negLutIndex,
                                  -this->m_paramsR.flipSign,
                                  this->m_scale,
                                  RGB[0]);
@@ -1557,12 +2312,14 @@ void InvLut1DRendererHalfCodeHueAdjust<inBD, outBD>::apply(const void * inImg, v
                 ? FindLutInvHalf(this->m_paramsG.lutStart,
                                  this->m_paramsG.startOffset,
                                  this->m_paramsG.lutEnd,
+                                 this->m_paramsG.lutIndex,
                                  this->m_paramsG.flipSign,
                                  this->m_scale,
                                  RGB[1]) 
                 : FindLutInvHalf(this->m_paramsG.negLutStart,
                                  this->m_paramsG.negStartOffset,
                                  this->m_paramsG.negLutEnd,
+                                 this->m_paramsG.negLutIndex,
                                  -this->m_paramsG.flipSign,
                                  this->m_scale,
                                  RGB[1]);
@@ -1572,12 +2329,14 @@ void InvLut1DRendererHalfCodeHueAdjust<inBD, outBD>::apply(const void * inImg, v
                 ? FindLutInvHalf(this->m_paramsB.lutStart,
                                  this->m_paramsB.startOffset,
                                  this->m_paramsB.lutEnd,
+                                 this->m_paramsB.lutIndex,
                                  this->m_paramsB.flipSign,
                                  this->m_scale,
                                  RGB[2]) 
                 : FindLutInvHalf(this->m_paramsB.negLutStart,
                                  this->m_paramsB.negStartOffset,
                                  this->m_paramsB.negLutEnd,
+                                 this->m_paramsB.negLutIndex,
                                  -this->m_paramsR.flipSign,
                                  this->m_scale,
                                  RGB[2]);
@@ -1598,13 +2357,373 @@ void InvLut1DRendererHalfCodeHueAdjust<inBD, outBD>::apply(const void * inImg, v
     }
 }
 
+#if defined(OCIO_USE_AVX)
+
+// The AVX2 variants of the half domain renderers process 8 values at once: the values
+// are converted to their half codes with F16C and the codes are directly used as gather
+// indices in the LUT. They do exactly the same floating-point operations as
+// IndexPair::GetEdgeFloatValues() and lerpf() (i.e. FMA is not used) so all the CPUs
+// produce identical results.
+
+// Transpose each 128-bit lane i.e. RGBA pixels into R, G, B & A registers, and back.
+OCIO_TARGET_AVX2_F16C
+inline void Transpose4x4AVX2(__m256 & v0, __m256 & v1, __m256 & v2, __m256 & v3)
+{
+    const __m256 t0 = _mm256_unpacklo_ps(v0, v1);
+    const __m256 t1 = _mm256_unpacklo_ps(v2, v3);
+    const __m256 t2 = _mm256_unpackhi_ps(v0, v1);
+    const __m256 t3 = _mm256_unpackhi_ps(v2, v3);
+
+    v0 = _mm256_shuffle_ps(t0, t1, _MM_SHUFFLE(1, 0, 1, 0));
+    v1 = _mm256_shuffle_ps(t0, t1, _MM_SHUFFLE(3, 2, 3, 2));
+    v2 = _mm256_shuffle_ps(t2, t3, _MM_SHUFFLE(1, 0, 1, 0));
+    v3 = _mm256_shuffle_ps(t2, t3, _MM_SHUFFLE(3, 2, 3, 2));
+}
+
+// Convert the half codes (i.e. one per 32-bit element) to floats.
+OCIO_TARGET_AVX2_F16C
+inline __m256 HalfCodesToFloatAVX2(const __m256i & codes)
+{
+    const __m256i packed = _mm256_permute4x64_epi64(_mm256_packus_epi32(codes, codes),
+                                                    _MM_SHUFFLE(3, 1, 2, 0));
+    return _mm256_cvtph_ps(_mm256_castsi256_si128(packed));
+}
+
+// Interpolate the half domain LUT at 8 values, the LUT values being 'stride' apart. When
+// finite is true, the NaN and infinity handling of the values is skipped (refer to
+// IndexPair::GetEdgeFloatValues()).
+template<bool finite = false>
+OCIO_TARGET_AVX2_F16C
+inline __m256 ApplyHalfCodeLutAVX2(const float * lut, const __m256i & stride, __m256 val)
+{
+    const __m256i signBit = _mm256_set1_epi32(0x8000);
+    const __m256i absBits = _mm256_set1_epi32(0x7fff);
+    const __m256i infCode = _mm256_set1_epi32(0x7c00);
+    const __m256i maxCode = _mm256_set1_epi32(0x7bff);  // HALF_MAX
+    const __m256i one     = _mm256_set1_epi32(1);
+
+    // The half codes, rounded to the nearest even like the half type.
+    __m256i code = _mm256_cvtepu16_epi32(_mm256_cvtps_ph(val, _MM_FROUND_TO_NEAREST_INT));
+
+    __m256 codeVal;
+    if (finite)
+    {
+        codeVal = HalfCodesToFloatAVX2(code);
+    }
+    else
+    {
+        // F16C quiets the signaling NaNs whereas the half type keeps the 10 leftmost bits
+        // of the significand (with at least one bit set).
+        const __m256i valBits = _mm256_castps_si256(val);
+        const __m256i nanMant = _mm256_srli_epi32(_mm256_and_si256(valBits,
+                                                                   _mm256_set1_epi32(0x007fffff)),
+                                                  13);
+        const __m256i zeroMant = _mm256_cmpeq_epi32(nanMant, _mm256_setzero_si256());
+        const __m256i nanCode
+            = _mm256_or_si256(_mm256_or_si256(_mm256_and_si256(_mm256_srli_epi32(valBits, 16),
+                                                               signBit),
+                                              infCode),
+                              _mm256_or_si256(nanMant, _mm256_and_si256(zeroMant, one)));
+        const __m256 isNan = _mm256_cmp_ps(val, val, _CMP_UNORD_Q);
+        code = _mm256_castps_si256(_mm256_blendv_ps(_mm256_castsi256_ps(code),
+                                                    _mm256_castsi256_ps(nanCode),
+                                                    isNan));
+
+        // The infinities (including the overflows) are clamped to +/-HALF_MAX.
+        const __m256i isInf = _mm256_cmpeq_epi32(_mm256_and_si256(code, absBits), infCode);
+        code = _mm256_blendv_epi8(code,
+                                  _mm256_or_si256(_mm256_and_si256(code, signBit), maxCode),
+                                  isInf);
+
+        codeVal = HalfCodesToFloatAVX2(code);
+        val = _mm256_blendv_ps(val, codeVal, _mm256_castsi256_ps(isInf));
+    }
+
+    // When the half value is further from zero than the value, the value is between the
+    // previous code and the code, otherwise between the code and the next code.
+    const __m256 absMask = _mm256_castsi256_ps(_mm256_set1_epi32(0x7fffffff));
+    const __m256 isAway = _mm256_cmp_ps(_mm256_and_ps(codeVal, absMask),
+                                        _mm256_and_ps(val, absMask),
+                                        _CMP_GT_OQ);
+
+    const __m256i codeA = _mm256_sub_epi32(code,
+                                           _mm256_and_si256(_mm256_castps_si256(isAway), one));
+    __m256i codeB = _mm256_and_si256(_mm256_add_epi32(codeA, one), _mm256_set1_epi32(0xffff));
+
+    const __m256i isInfB = _mm256_cmpeq_epi32(_mm256_and_si256(codeB, absBits), infCode);
+    codeB = _mm256_blendv_epi8(codeB,
+                               _mm256_or_si256(_mm256_and_si256(codeB, signBit), maxCode),
+                               isInfB);
+
+    const __m256 valA = HalfCodesToFloatAVX2(codeA);
+    const __m256 valB = HalfCodesToFloatAVX2(codeB);
+
+    __m256 fraction = _mm256_div_ps(_mm256_sub_ps(val, valA), _mm256_sub_ps(valB, valA));
+    fraction = _mm256_and_ps(fraction, _mm256_cmp_ps(fraction, fraction, _CMP_ORD_Q));
+
+    // Since fraction is in the domain [0, 1), interpolate using
+    // 1-fraction in order to avoid cases like -/+Inf * 0.
+    const __m256 lutA = _mm256_i32gather_ps(lut, _mm256_mullo_epi32(codeA, stride), 4);
+    const __m256 lutB = _mm256_i32gather_ps(lut, _mm256_mullo_epi32(codeB, stride), 4);
+    const __m256 z = _mm256_sub_ps(_mm256_set1_ps(1.0f), fraction);
+
+    return _mm256_add_ps(_mm256_mul_ps(_mm256_sub_ps(lutA, lutB), z), lutB);
+}
+
+// Interpolate the R, G & B values of 8 RGBA pixels, and scale the alpha values.
+// Note that the values are then permuted within the channel registers (refer to
+// Transpose4x4AVX2()).
+template<bool finite = false>
+OCIO_TARGET_AVX2_F16C
+inline void LoadAndApplyHalfCodeLutAVX2(const float * in, const float * const luts[3],
+                                        const __m256i & stride, float alphaScaling,
+                                        __m256 & r, __m256 & g, __m256 & b, __m256 & a)
+{
+    r = _mm256_loadu_ps(in);
+    g = _mm256_loadu_ps(in + 8);
+    b = _mm256_loadu_ps(in + 16);
+    a = _mm256_loadu_ps(in + 24);
+    Transpose4x4AVX2(r, g, b, a);
+
+    r = ApplyHalfCodeLutAVX2<finite>(luts[0], stride, r);
+    g = ApplyHalfCodeLutAVX2<finite>(luts[1], stride, g);
+    b = ApplyHalfCodeLutAVX2<finite>(luts[2], stride, b);
+    a = _mm256_mul_ps(a, _mm256_set1_ps(alphaScaling));
+}
+
+// Return the number of processed pixels, the remaining ones being processed by the
+// scalar implementation.
+template<bool finite>
+OCIO_TARGET_AVX2_F16C
+long ApplyHalfCodeLutAVX2(const float * const luts[3], unsigned long stride,
+                          float alphaScaling, const float * in, float * out, long numPixels)
+{
+    const __m256i mm_stride = _mm256_set1_epi32((int)stride);
+
+    long idx = 0;
+    for (; idx + 8 <= numPixels; idx += 8)
+    {
+        __m256 r, g, b, a;
+        LoadAndApplyHalfCodeLutAVX2<finite>(in, luts, mm_stride, alphaScaling, r, g, b, a);
+
+        Transpose4x4AVX2(r, g, b, a);
+        _mm256_storeu_ps(out,      r);
+        _mm256_storeu_ps(out + 8,  g);
+        _mm256_storeu_ps(out + 16, b);
+        _mm256_storeu_ps(out + 24, a);
+
+        in  += 32;
+        out += 32;
+    }
+    return idx;
+}
+
+template<bool finite>
+OCIO_TARGET_AVX2_F16C
+void ApplyHalfCodeLutPlanarAVX2(const float * const luts[3], unsigned long stride,
+                                float alphaScaling,
+                                const float * const * inPlanes, float * const * outPlanes,
+                                long numPixels)
+{
+    const __m256i mm_stride = _mm256_set1_epi32((int)stride);
+    const long numVectorized = numPixels - numPixels % 8;
+
+    for (int c = 0; c < 3; ++c)
+    {
+        const float * in = inPlanes[c];
+        float * out = outPlanes[c];
+
+        for (long idx = 0; idx < numVectorized; idx += 8)
+        {
+            _mm256_storeu_ps(out + idx, ApplyHalfCodeLutAVX2<finite>(luts[c], mm_stride,
+                                                                        _mm256_loadu_ps(in + idx)));
+        }
+
+        for (long idx = numVectorized; idx < numPixels; ++idx)
+        {
+            const IndexPair interVals = IndexPair::GetEdgeFloatValues<finite>(in[idx]);
+
+            out[idx] = lerpf(luts[c][interVals.valB * stride], luts[c][interVals.valA * stride],
+                             1.0f-interVals.fraction);
+        }
+    }
+
+    for (long idx=0; idx<numPixels; ++idx)
+    {
+        outPlanes[3][idx] = inPlanes[3][idx] * alphaScaling;
+    }
+}
+
+// Only the 32-bit float images are interpolated (i.e. the other input bit-depths
+// directly use the half codes).
+class Lut1DRendererHalfCodeAVX2 : public Lut1DRendererHalfCode<BIT_DEPTH_F32, BIT_DEPTH_F32>
+{
+public:
+    explicit Lut1DRendererHalfCodeAVX2(ConstLut1DOpDataRcPtr & lut)
+        : Lut1DRendererHalfCode<BIT_DEPTH_F32, BIT_DEPTH_F32>(lut) {}
+
+    void apply(const void * inImg, void * outImg, long numPixels) const override
+    {
+        const float * luts[3] = { (const float *)m_tmpLutR,
+                                  (const float *)m_tmpLutG,
+                                  (const float *)m_tmpLutB };
+
+        const long done
+            = m_finiteInputs ? ApplyHalfCodeLutAVX2<true>(luts, m_lutStride, m_alphaScaling,
+                                                          (const float *)inImg, (float *)outImg,
+                                                          numPixels)
+                             : ApplyHalfCodeLutAVX2<false>(luts, m_lutStride, m_alphaScaling,
+                                                           (const float *)inImg, (float *)outImg,
+                                                           numPixels);
+        Lut1DRendererHalfCode<BIT_DEPTH_F32, BIT_DEPTH_F32>::apply(
+            (const float *)inImg + 4 * done, (float *)outImg + 4 * done, numPixels - done);
+    }
+
+    void applyPlanar(const float * const * inPlanes, float * const * outPlanes,
+                     long numPixels) const override
+    {
+        const float * luts[3] = { (const float *)m_tmpLutR,
+                                  (const float *)m_tmpLutG,
+                                  (const float *)m_tmpLutB };
+
+        if (m_finiteInputs)
+        {
+            ApplyHalfCodeLutPlanarAVX2<true>(luts, m_lutStride, m_alphaScaling,
+                                             inPlanes, outPlanes, numPixels);
+        }
+        else
+        {
+            ApplyHalfCodeLutPlanarAVX2<false>(luts, m_lutStride, m_alphaScaling,
+                                              inPlanes, outPlanes, numPixels);
+        }
+    }
+};
+
+class Lut1DRendererHalfCodeHueAdjustAVX2
+    : public Lut1DRendererHalfCodeHueAdjust<BIT_DEPTH_F32, BIT_DEPTH_F32>
+{
+public:
+    explicit Lut1DRendererHalfCodeHueAdjustAVX2(ConstLut1DOpDataRcPtr & lut)
+        : Lut1DRendererHalfCodeHueAdjust<BIT_DEPTH_F32, BIT_DEPTH_F32>(lut) {}
+
+    void apply(const void * inImg, void * outImg, long numPixels) const override;
+};
+
+// Same as GamutMapUtils::HueAdjustSSE() for 8 pixels.
+OCIO_TARGET_AVX2_F16C
+inline void HueAdjustAVX2(const __m256 & r, const __m256 & g, const __m256 & b,
+                          __m256 & r2, __m256 & g2, __m256 & b2)
+{
+    const __m256 rg = _mm256_cmp_ps(r, g, _CMP_GT_OQ);
+    const __m256 gb = _mm256_cmp_ps(g, b, _CMP_GT_OQ);
+    const __m256 rb = _mm256_cmp_ps(r, b, _CMP_GT_OQ);
+
+    const __m256 notMidG = _mm256_xor_ps(rg, gb);
+    const __m256 midR    = _mm256_and_ps(notMidG, _mm256_xor_ps(rg, rb));
+    const __m256 midG    = _mm256_andnot_ps(notMidG, _mm256_castsi256_ps(_mm256_set1_epi32(-1)));
+    const __m256 midB    = _mm256_andnot_ps(midR, notMidG);
+
+    const __m256 other  = _mm256_blendv_ps(g, b, midG);
+    const __m256 other2 = _mm256_blendv_ps(g2, b2, midG);
+
+    const __m256 maxV  = _mm256_blendv_ps(_mm256_blendv_ps(other, r, rg),
+                                          _mm256_blendv_ps(b, g, gb), midR);
+    const __m256 minV  = _mm256_blendv_ps(_mm256_blendv_ps(r, other, rg),
+                                          _mm256_blendv_ps(g, b, gb), midR);
+    const __m256 midV  = _mm256_blendv_ps(_mm256_blendv_ps(b, g, midG), r, midR);
+    const __m256 maxV2 = _mm256_blendv_ps(_mm256_blendv_ps(other2, r2, rg),
+                                          _mm256_blendv_ps(b2, g2, gb), midR);
+    const __m256 minV2 = _mm256_blendv_ps(_mm256_blendv_ps(r2, other2, rg),
+                                          _mm256_blendv_ps(g2, b2, gb), midR);
+
+    const __m256 origChroma = _mm256_sub_ps(maxV, minV);
+    const __m256 hueFactor
+        = _mm256_and_ps(_mm256_cmp_ps(origChroma, _mm256_setzero_ps(), _CMP_NEQ_UQ),
+                        _mm256_div_ps(_mm256_sub_ps(midV, minV), origChroma));
+
+    const __m256 newChroma = _mm256_sub_ps(maxV2, minV2);
+    const __m256 newMid    = _mm256_add_ps(_mm256_mul_ps(hueFactor, newChroma), minV2);
+
+    r2 = _mm256_blendv_ps(r2, newMid, midR);
+    g2 = _mm256_blendv_ps(g2, newMid, midG);
+    b2 = _mm256_blendv_ps(b2, newMid, midB);
+}
+
+OCIO_TARGET_AVX2_F16C
+void Lut1DRendererHalfCodeHueAdjustAVX2::apply(const void * inImg, void * outImg,
+                                               long numPixels) const
+{
+    const float * luts[3] = { (const float *)m_tmpLutR,
+                              (const float *)m_tmpLutG,
+                              (const float *)m_tmpLutB };
+    const __m256i stride = _mm256_set1_epi32((int)m_lutStride);
+
+    const float * in = (const float *)inImg;
+    float * out = (float *)outImg;
+
+    long idx = 0;
+    for (; idx + 8 <= numPixels; idx += 8)
+    {
+        // The original values are permuted the same way as the interpolated ones.
+        __m256 r = _mm256_loadu_ps(in);
+        __m256 g = _mm256_loadu_ps(in + 8);
+        __m256 b = _mm256_loadu_ps(in + 16);
+        __m256 a = _mm256_loadu_ps(in + 24);
+        Transpose4x4AVX2(r, g, b, a);
+
+        __m256 r2, g2, b2, a2;
+        LoadAndApplyHalfCodeLutAVX2(in, luts, stride, m_alphaScaling, r2, g2, b2, a2);
+
+        HueAdjustAVX2(r, g, b, r2, g2, b2);
+
+        Transpose4x4AVX2(r2, g2, b2, a2);
+        _mm256_storeu_ps(out,      r2);
+        _mm256_storeu_ps(out + 8,  g2);
+        _mm256_storeu_ps(out + 16, b2);
+        _mm256_storeu_ps(out + 24, a2);
+
+        in  += 32;
+        out += 32;
+    }
+
+    Lut1DRendererHalfCodeHueAdjust<BIT_DEPTH_F32, BIT_DEPTH_F32>::apply(in, out,
+                                                                        numPixels - idx);
+}
+
+#endif
+
 template<BitDepth inBD, BitDepth outBD>
 OpCPURcPtr GetForwardLut1DRenderer(ConstLut1DOpDataRcPtr & lut)
 {
+    // The integer input pixels always use look-ups.
+    if (inBD == BIT_DEPTH_F32
+        && lut->getConcreteInterpolation() == INTERP_NEAREST
+        && lut->getHueAdjust() == HUE_NONE)
+    {
+        if (lut->isInputHalfDomain())
+        {
+            return std::make_shared< Lut1DRendererHalfCodeNearest<inBD, outBD> >(lut);
+        }
+        return std::make_shared< Lut1DRendererNearest<inBD, outBD> >(lut);
+    }
+
     // NB: Unlike bit-depth, the half domain status of a LUT
     //     may not be changed.
     if (lut->isInputHalfDomain())
     {
+#if defined(OCIO_USE_AVX)
+        const CPUInfo & cpuInfo = CPUInfo::Instance();
+        if (inBD == BIT_DEPTH_F32 && outBD == BIT_DEPTH_F32
+            && cpuInfo.hasAVX2() && cpuInfo.hasF16C())
+        {
+            if (lut->getHueAdjust() == HUE_NONE)
+            {
+                return std::make_shared<Lut1DRendererHalfCodeAVX2>(lut);
+            }
+            return std::make_shared<Lut1DRendererHalfCodeHueAdjustAVX2>(lut);
+        }
+#endif
+
         if (lut->getHueAdjust() == HUE_NONE)
         {
             return std::make_shared< Lut1DRendererHalfCode<inBD, outBD> >(lut);
@@ -1849,15 +2968,73 @@ OCIO_ADD_TEST(GamutMapUtil, order3_test)
         OCIO_CHECK_EQUAL(min, 1);
     }
     {
-        const float RGB[] = { 3.f, -2.f, 10.f };
-        int min, mid, max;
-        OCIO::GamutMapUtils::Order3(RGB, min, mid, max);
-        OCIO_CHECK_EQUAL(max, 2);
-        OCIO_CHECK_EQUAL(mid, 0);
-        OCIO_CHECK_EQUAL(min, 1);
+        const float RGB[] = { 3.f, -2.f, 10.f };
+        int min, mid, max;
+        OCIO::GamutMapUtils::Order3(RGB, min, mid, max);
+        OCIO_CHECK_EQUAL(max, 2);
+        OCIO_CHECK_EQUAL(mid, 0);
+        OCIO_CHECK_EQUAL(min, 1);
+    }
+
+}
+
+#ifdef USE_SSE
+OCIO_ADD_TEST(GamutMapUtil, hue_adjust_sse)
+{
+    // The branch-free hue restoration must produce identical results to the scalar one,
+    // including the ties and the NaNs (i.e. except the sign of the NaNs which depends on
+    // the operand order the compiler picks).
+    const float qnan = std::numeric_limits<float>::quiet_NaN();
+    const float inf = std::numeric_limits<float>::infinity();
+    const float values[] = { -1.0f, 0.0f, 0.25f, 0.5f, 2.0f, qnan, inf, -inf };
+    const long numValues = 8;
+
+    std::vector<float> in, lutValues;
+    for (long r = 0; r < numValues; ++r)
+    {
+        for (long g = 0; g < numValues; ++g)
+        {
+            for (long b = 0; b < numValues; ++b)
+            {
+                const float RGB[] = { values[r], values[g], values[b] };
+                in.insert(in.end(), RGB, RGB + 3);
+                in.push_back(0.5f);
+
+                // Some arbitrary (and also special) per-channel values.
+                lutValues.push_back(values[(r + 3) % numValues] * 0.7f);
+                lutValues.push_back(values[(g + 1) % numValues] + 0.1f);
+                lutValues.push_back(values[(b + 5) % numValues] * 1.3f);
+                lutValues.push_back(0.25f);
+            }
+        }
+    }
+    const long numPixels = long(in.size() / 4);
+
+    std::vector<float> ref(lutValues);
+    for (long idx = 0; idx < numPixels; ++idx)
+    {
+        OCIO::GamutMapUtils::HueAdjust(&in[4 * idx], &ref[4 * idx]);
     }
 
+    // Process in place, with a number of pixels which is not a multiple of four.
+    std::vector<float> res(in);
+    OCIO::GamutMapUtils::HueAdjustPixelsSSE(&res[0], &lutValues[0], &res[0], numPixels - 1);
+    OCIO::GamutMapUtils::HueAdjustPixelsSSE(&in[4 * (numPixels - 1)],
+                                            &lutValues[4 * (numPixels - 1)],
+                                            &res[4 * (numPixels - 1)], 1);
+    for (size_t idx = 0; idx < res.size(); ++idx)
+    {
+        if (OCIO::IsNan(ref[idx]))
+        {
+            OCIO_CHECK_ASSERT(OCIO::IsNan(res[idx]));
+        }
+        else
+        {
+            OCIO_CHECK_ASSERT(std::memcmp(&res[idx], &ref[idx], sizeof(float)) == 0);
+        }
+    }
 }
+#endif
 
 OCIO_ADD_TEST(Lut1DRenderer, nan_test)
 {
@@ -1942,6 +3119,161 @@ OCIO_ADD_TEST(Lut1DRenderer, nan_half_test)
     OCIO_CHECK_ASSERT(OCIO::IsNan(pixels[15]));
 }
 
+#if defined(OCIO_USE_AVX)
+OCIO_ADD_TEST(Lut1DRenderer, avx_half_code_renderers)
+{
+    // The AVX2 renderers must produce exactly the same results as the scalar ones.
+
+    const OCIO::CPUInfo & cpuInfo = OCIO::CPUInfo::Instance();
+    if (!cpuInfo.hasAVX2() || !cpuInfo.hasF16C())
+    {
+        return;
+    }
+
+    OCIO::Lut1DOpDataRcPtr lut = std::make_shared<OCIO::Lut1DOpData>(
+        OCIO::Lut1DOpData::LUT_INPUT_HALF_CODE, 65536);
+
+    OCIO::Array::Values & values = lut->getArray().getValues();
+    for (size_t idx = 0; idx < values.size(); ++idx)
+    {
+        values[idx] = std::sin(float(idx) * 0.001f) * 2.0f + float(idx % 3);
+    }
+
+    OCIO::ConstLut1DOpDataRcPtr lutConst = lut;
+
+    const float qnan = std::numeric_limits<float>::quiet_NaN();
+    const float inf  = std::numeric_limits<float>::infinity();
+
+    // Not a multiple of 8 pixels to exercise the remaining pixels.
+    constexpr long numPixels = 27;
+    std::vector<float> img(4 * numPixels);
+    for (size_t idx = 0; idx < img.size(); ++idx)
+    {
+        img[idx] = (float(idx % 17) - 5.0f) * 0.37f;
+    }
+    // Check the special values, the half overflow, the denormals and the exact codes.
+    const float special[] = { qnan, -qnan, inf, -inf, 65504.0f, 65519.0f, 65520.0f, -70000.0f,
+                              1e-7f, -3e-8f, 1e-40f, -0.0f, 0.0f, 1.0f, -2.0f, 0.5f };
+    std::copy(special, special + 16, img.begin());
+    img[18] = std::numeric_limits<float>::signaling_NaN();
+
+    {
+        const OCIO::Lut1DRendererHalfCode<OCIO::BIT_DEPTH_F32, OCIO::BIT_DEPTH_F32> ref(lutConst);
+        std::vector<float> refRes(img.size());
+        ref.apply(&img[0], &refRes[0], numPixels);
+
+        std::vector<float> res(img);
+        OCIO::Lut1DRendererHalfCodeAVX2(lutConst).apply(&res[0], &res[0], numPixels);
+        OCIO_CHECK_ASSERT(std::memcmp(&res[0], &refRes[0], res.size() * sizeof(float)) == 0);
+
+        // The planar variant.
+        std::vector<float> planes(img.size()), refPlanes(img.size());
+        for (long idx = 0; idx < numPixels; ++idx)
+        {
+            for (long c = 0; c < 4; ++c)
+            {
+                planes[c * numPixels + idx] = img[4 * idx + c];
+            }
+        }
+        const float * inPlanes[4] = { &planes[0], &planes[numPixels],
+                                      &planes[2 * numPixels], &planes[3 * numPixels] };
+        float * refOutPlanes[4] = { &refPlanes[0], &refPlanes[numPixels],
+                                    &refPlanes[2 * numPixels], &refPlanes[3 * numPixels] };
+        ref.applyPlanar(inPlanes, refOutPlanes, numPixels);
+
+        std::vector<float> outPlanes(img.size());
+        float * resOutPlanes[4] = { &outPlanes[0], &outPlanes[numPixels],
+                                    &outPlanes[2 * numPixels], &outPlanes[3 * numPixels] };
+        OCIO::Lut1DRendererHalfCodeAVX2(lutConst).applyPlanar(inPlanes, resOutPlanes, numPixels);
+        OCIO_CHECK_ASSERT(
+            std::memcmp(&outPlanes[0], &refPlanes[0], outPlanes.size() * sizeof(float)) == 0);
+    }
+
+    {
+        lut->setHueAdjust(OCIO::HUE_DW3);
+
+        const OCIO::Lut1DRendererHalfCodeHueAdjust<OCIO::BIT_DEPTH_F32,
+                                                   OCIO::BIT_DEPTH_F32> ref(lutConst);
+        std::vector<float> refRes(img.size());
+        ref.apply(&img[0], &refRes[0], numPixels);
+
+        std::vector<float> res(img);
+        OCIO::Lut1DRendererHalfCodeHueAdjustAVX2(lutConst).apply(&res[0], &res[0], numPixels);
+        OCIO_CHECK_ASSERT(std::memcmp(&res[0], &refRes[0], res.size() * sizeof(float)) == 0);
+    }
+}
+#endif
+
+OCIO_ADD_TEST(Lut1DRenderer, finite_inputs)
+{
+    // The renderers skipping the NaN & infinity handling produce identical results for
+    // the finite values within the half range.
+
+    OCIO::Lut1DOpDataRcPtr lut = std::make_shared<OCIO::Lut1DOpData>(
+        OCIO::Lut1DOpData::LUT_INPUT_HALF_CODE, 65536);
+
+    OCIO::Array::Values & values = lut->getArray().getValues();
+    for (size_t idx = 0; idx < values.size(); ++idx)
+    {
+        values[idx] = std::sin(float(idx) * 0.001f) * 2.0f + float(idx % 3);
+    }
+
+    OCIO::ConstLut1DOpDataRcPtr lutConst = lut;
+
+    OCIO::Lut1DOpDataRcPtr finiteLut = lut->clone();
+    finiteLut->setFiniteInputs(true);
+    OCIO::ConstLut1DOpDataRcPtr finiteLutConst = finiteLut;
+
+    constexpr long numPixels = 27;
+    std::vector<float> img(4 * numPixels);
+    for (size_t idx = 0; idx < img.size(); ++idx)
+    {
+        img[idx] = (float(idx % 17) - 5.0f) * 0.37f;
+    }
+    const float special[] = { 65504.0f, -65504.0f, 65503.9f, -65000.5f, 1e-7f, -3e-8f,
+                              1e-40f, -0.0f, 0.0f, 1.0f, -2.0f, 0.5f };
+    std::copy(special, special + 12, img.begin());
+
+    typedef OCIO::Lut1DRendererHalfCode<OCIO::BIT_DEPTH_F32, OCIO::BIT_DEPTH_F32> Renderer;
+
+    const Renderer ref(lutConst);
+    const Renderer finite(finiteLutConst);
+
+    std::vector<float> refRes(img.size()), res(img.size());
+    ref.apply(&img[0], &refRes[0], numPixels);
+    finite.apply(&img[0], &res[0], numPixels);
+    OCIO_CHECK_ASSERT(std::memcmp(&res[0], &refRes[0], res.size() * sizeof(float)) == 0);
+
+    ref.applyRGB(&img[0], &refRes[0], numPixels);
+    finite.applyRGB(&img[0], &res[0], numPixels);
+    OCIO_CHECK_ASSERT(std::memcmp(&res[0], &refRes[0], res.size() * sizeof(float)) == 0);
+
+    const float * inPlanes[4] = { &img[0], &img[numPixels],
+                                  &img[2 * numPixels], &img[3 * numPixels] };
+    float * refOutPlanes[4] = { &refRes[0], &refRes[numPixels],
+                                &refRes[2 * numPixels], &refRes[3 * numPixels] };
+    float * resOutPlanes[4] = { &res[0], &res[numPixels],
+                                &res[2 * numPixels], &res[3 * numPixels] };
+    ref.applyPlanar(inPlanes, refOutPlanes, numPixels);
+    finite.applyPlanar(inPlanes, resOutPlanes, numPixels);
+    OCIO_CHECK_ASSERT(std::memcmp(&res[0], &refRes[0], res.size() * sizeof(float)) == 0);
+
+#if defined(OCIO_USE_AVX)
+    const OCIO::CPUInfo & cpuInfo = OCIO::CPUInfo::Instance();
+    if (cpuInfo.hasAVX2() && cpuInfo.hasF16C())
+    {
+        ref.apply(&img[0], &refRes[0], numPixels);
+        OCIO::Lut1DRendererHalfCodeAVX2(finiteLutConst).apply(&img[0], &res[0], numPixels);
+        OCIO_CHECK_ASSERT(std::memcmp(&res[0], &refRes[0], res.size() * sizeof(float)) == 0);
+
+        ref.applyPlanar(inPlanes, refOutPlanes, numPixels);
+        OCIO::Lut1DRendererHalfCodeAVX2(finiteLutConst).applyPlanar(inPlanes, resOutPlanes,
+                                                                    numPixels);
+        OCIO_CHECK_ASSERT(std::memcmp(&res[0], &refRes[0], res.size() * sizeof(float)) == 0);
+    }
+#endif
+}
+
 OCIO_ADD_TEST(Lut1DRenderer, bit_depth_support)
 {
     // Unit test to validate the pixel bit depth processing with the 1D LUT.
@@ -4310,5 +5642,388 @@ OCIO_ADD_TEST(Lut1DRenderer, lut_1d_inv_half_domain_hue_adjust)
     }
 }
 
+namespace
+{
+
+// Process the pixels as planes, and compare with the packed processing.
+void ValidateLut1DPlanar(OCIO::ConstOpCPURcPtr & op, unsigned line)
+{
+    OCIO_REQUIRE_ASSERT_FROM(op->hasPlanarApply(), line);
+
+    const float qnan = std::numeric_limits<float>::quiet_NaN();
+    const float inf = std::numeric_limits<float>::infinity();
+
+    // Several SSE iterations and a partial one.
+    constexpr long numPixels = 9;
+
+    std::vector<float> img(4 * numPixels);
+    for (size_t idx = 0; idx < img.size(); ++idx)
+    {
+        img[idx] = float(idx) * 0.037f - 0.2f;
+    }
+    img[4] = qnan;
+    img[9] = inf;
+    img[14] = -inf;
+
+    std::vector<float> ref(img.size());
+    op->apply(&img[0], &ref[0], numPixels);
+
+    std::vector<float> planes(img.size());
+    for (long idx = 0; idx < numPixels; ++idx)
+    {
+        for (long c = 0; c < 4; ++c)
+        {
+            planes[c * numPixels + idx] = img[4 * idx + c];
+        }
+    }
+
+    float * p[4] = { &planes[0], &planes[numPixels], &planes[2 * numPixels], &planes[3 * numPixels] };
+    op->applyPlanar(p, p, numPixels);
+
+    for (long idx = 0; idx < numPixels; ++idx)
+    {
+        for (long c = 0; c < 4; ++c)
+        {
+            OCIO_CHECK_EQUAL_FROM(planes[c * numPixels + idx], ref[4 * idx + c], line);
+        }
+    }
+}
+
+}
+
+OCIO_ADD_TEST(Lut1DRenderer, lut_1d_inv_search_index)
+{
+    // The search index must give the same result as a binary search of the LUT.
+
+    const float qnan = std::numeric_limits<float>::quiet_NaN();
+
+    // Increasing LUT with flat spots, a -0 / +0 pair and a large exponent range.
+    std::vector<float> lut;
+    for (int i = -200; i < 1000; ++i)
+    {
+        lut.push_back(i < 0 ? -std::ldexp(1.f, -i / 4) : std::ldexp(1.f + (i % 10) / 10.f, i / 40));
+        if (i % 7 == 0)
+        {
+            lut.push_back(lut.back());
+        }
+        if (i == 0)
+        {
+            lut.push_back(-0.f);
+            lut.push_back(0.f);
+        }
+    }
+    std::sort(lut.begin(), lut.end());
+
+    const float * start = lut.data();
+    const float * end   = lut.data() + lut.size() - 1;
+
+    for (bool logBuckets : { false, true })
+    {
+        OCIO::LutSearchIndex index;
+        index.init(start, end, logBuckets);
+
+        for (size_t idx = 0; idx < lut.size(); ++idx)
+        {
+            const float values[] = { lut[idx],
+                                     std::nextafter(lut[idx], -1e30f),
+                                     std::nextafter(lut[idx], 1e30f),
+                                     0.5f * (lut[idx] + lut[std::min(idx + 1, lut.size() - 1)]) };
+            for (float val : values)
+            {
+                const float cv = std::min(std::max(val, *start), *end);
+                OCIO_CHECK_EQUAL(index.lowerBound(cv), std::lower_bound(start, end, cv));
+            }
+        }
+
+        OCIO_CHECK_EQUAL(index.lowerBound(qnan), std::lower_bound(start, end, qnan));
+        OCIO_CHECK_EQUAL(index.lowerBound(-0.f), std::lower_bound(start, end, -0.f));
+    }
+
+    // A flat LUT is searched without index.
+    const std::vector<float> flat(10, 0.5f);
+    OCIO::LutSearchIndex index;
+    index.init(flat.data(), flat.data() + 9, false);
+    OCIO_CHECK_EQUAL(index.lowerBound(0.5f), flat.data());
+}
+
+OCIO_ADD_TEST(Lut1DRenderer, planar_renderers)
+{
+    OCIO::Lut1DOpDataRcPtr lut = std::make_shared<OCIO::Lut1DOpData>(8);
+
+    float * values = &lut->getArray().getValues()[0];
+    for (unsigned long idx = 0; idx < 24; ++idx)
+    {
+        values[idx] = float(idx * idx) / 500.0f;
+    }
+
+    OCIO::ConstLut1DOpDataRcPtr lutConst = lut;
+    OCIO::ConstOpCPURcPtr renderer;
+    OCIO_CHECK_NO_THROW(renderer = OCIO::GetLut1DRenderer(lutConst,
+                                                          OCIO::BIT_DEPTH_F32,
+                                                          OCIO::BIT_DEPTH_F32));
+    ValidateLut1DPlanar(renderer, __LINE__);
+
+    // Only the 32-bit float pixels could be planar.
+    OCIO_CHECK_NO_THROW(renderer = OCIO::GetLut1DRenderer(lutConst,
+                                                          OCIO::BIT_DEPTH_UINT8,
+                                                          OCIO::BIT_DEPTH_F32));
+    OCIO_CHECK_ASSERT(!renderer->hasPlanarApply());
+
+    // The hue adjustment needs all the channels of a pixel.
+    lut->setHueAdjust(OCIO::HUE_DW3);
+    OCIO_CHECK_NO_THROW(renderer = OCIO::GetLut1DRenderer(lutConst,
+                                                          OCIO::BIT_DEPTH_F32,
+                                                          OCIO::BIT_DEPTH_F32));
+    OCIO_CHECK_ASSERT(!renderer->hasPlanarApply());
+
+    OCIO::Lut1DOpDataRcPtr halfLut = std::make_shared<OCIO::Lut1DOpData>(
+        OCIO::Lut1DOpData::LUT_INPUT_HALF_CODE, 65536);
+
+    // Note that the values are finite for all the input values (including NaNs).
+    auto & halfValues = halfLut->getArray().getValues();
+    for (size_t idx = 0; idx < halfValues.size(); ++idx)
+    {
+        halfValues[idx] = float(idx % 1000) / 1000.0f;
+    }
+
+    OCIO::ConstLut1DOpDataRcPtr halfLutConst = halfLut;
+    OCIO_CHECK_NO_THROW(renderer = OCIO::GetLut1DRenderer(halfLutConst,
+                                                          OCIO::BIT_DEPTH_F32,
+                                                          OCIO::BIT_DEPTH_F32));
+    ValidateLut1DPlanar(renderer, __LINE__);
+}
+
+namespace
+{
+
+// Process packed RGB pixels, and compare with the packed RGBA processing.
+void ValidateLut1DRGB(OCIO::ConstOpCPURcPtr & op, unsigned line)
+{
+    OCIO_REQUIRE_ASSERT_FROM(op->hasRGBApply(), line);
+
+    const float qnan = std::numeric_limits<float>::quiet_NaN();
+    const float inf = std::numeric_limits<float>::infinity();
+
+    // Several SSE iterations and a partial one.
+    constexpr long numPixels = 9;
+
+    std::vector<float> img(4 * numPixels);
+    for (size_t idx = 0; idx < img.size(); ++idx)
+    {
+        img[idx] = float(idx) * 0.037f - 0.2f;
+    }
+    img[4] = qnan;
+    img[9] = inf;
+    img[14] = -inf;
+
+    std::vector<float> ref(img.size());
+    op->apply(&img[0], &ref[0], numPixels);
+
+    std::vector<float> rgb(3 * numPixels);
+    for (long idx = 0; idx < numPixels; ++idx)
+    {
+        for (long c = 0; c < 3; ++c)
+        {
+            rgb[3 * idx + c] = img[4 * idx + c];
+        }
+    }
+
+    // In place.
+    op->applyRGB(&rgb[0], &rgb[0], numPixels);
+
+    for (long idx = 0; idx < numPixels; ++idx)
+    {
+        for (long c = 0; c < 3; ++c)
+        {
+            OCIO_CHECK_EQUAL_FROM(rgb[3 * idx + c], ref[4 * idx + c], line);
+        }
+    }
+}
+
+}
+
+OCIO_ADD_TEST(Lut1DRenderer, packed_rgb_renderers)
+{
+    OCIO::Lut1DOpDataRcPtr lut = std::make_shared<OCIO::Lut1DOpData>(8);
+
+    float * values = &lut->getArray().getValues()[0];
+    for (unsigned long idx = 0; idx < 24; ++idx)
+    {
+        values[idx] = float(idx * idx) / 500.0f;
+    }
+
+    OCIO::ConstLut1DOpDataRcPtr lutConst = lut;
+    OCIO::ConstOpCPURcPtr renderer;
+    OCIO_CHECK_NO_THROW(renderer = OCIO::GetLut1DRenderer(lutConst,
+                                                          OCIO::BIT_DEPTH_F32,
+                                                          OCIO::BIT_DEPTH_F32));
+    ValidateLut1DRGB(renderer, __LINE__);
+
+    // Only the 32-bit float pixels could be packed RGB.
+    OCIO_CHECK_NO_THROW(renderer = OCIO::GetLut1DRenderer(lutConst,
+                                                          OCIO::BIT_DEPTH_F32,
+                                                          OCIO::BIT_DEPTH_UINT16));
+    OCIO_CHECK_ASSERT(!renderer->hasRGBApply());
+
+    // The hue adjustment needs all the channels of a pixel.
+    lut->setHueAdjust(OCIO::HUE_DW3);
+    OCIO_CHECK_NO_THROW(renderer = OCIO::GetLut1DRenderer(lutConst,
+                                                          OCIO::BIT_DEPTH_F32,
+                                                          OCIO::BIT_DEPTH_F32));
+    OCIO_CHECK_ASSERT(!renderer->hasRGBApply());
+
+    OCIO::Lut1DOpDataRcPtr halfLut = std::make_shared<OCIO::Lut1DOpData>(
+        OCIO::Lut1DOpData::LUT_INPUT_HALF_CODE, 65536);
+
+    // Note that the values are finite for all the input values (including NaNs).
+    auto & halfValues = halfLut->getArray().getValues();
+    for (size_t idx = 0; idx < halfValues.size(); ++idx)
+    {
+        halfValues[idx] = float(idx % 1000) / 1000.0f;
+    }
+
+    OCIO::ConstLut1DOpDataRcPtr halfLutConst = halfLut;
+    OCIO_CHECK_NO_THROW(renderer = OCIO::GetLut1DRenderer(halfLutConst,
+                                                          OCIO::BIT_DEPTH_F32,
+                                                          OCIO::BIT_DEPTH_F32));
+    ValidateLut1DRGB(renderer, __LINE__);
+}
+
+namespace
+{
+
+// Process the same image with a LUT having identical channels (i.e. rendered from a
+// single table) and with a LUT only differing in the blue channel (i.e. rendered
+// from the interleaved table), the red, green and alpha values must be identical.
+template<OCIO::BitDepth inBD, OCIO::BitDepth outBD>
+void ValidateLut1DSingleLut(OCIO::ConstLut1DOpDataRcPtr & singleLut,
+                            OCIO::ConstLut1DOpDataRcPtr & lut,
+                            const std::vector<typename OCIO::BitDepthInfo<inBD>::Type> & img,
+                            unsigned line)
+{
+    typedef typename OCIO::BitDepthInfo<outBD>::Type OutType;
+
+    OCIO::ConstOpCPURcPtr singleRenderer;
+    OCIO_CHECK_NO_THROW_FROM(singleRenderer = OCIO::GetLut1DRenderer(singleLut, inBD, outBD),
+                             line);
+    OCIO::ConstOpCPURcPtr renderer;
+    OCIO_CHECK_NO_THROW_FROM(renderer = OCIO::GetLut1DRenderer(lut, inBD, outBD), line);
+
+    const long numPixels = long(img.size() / 4);
+
+    std::vector<OutType> singleOut(img.size());
+    singleRenderer->apply(&img[0], &singleOut[0], numPixels);
+    std::vector<OutType> out(img.size());
+    renderer->apply(&img[0], &out[0], numPixels);
+
+    for (long idx = 0; idx < numPixels; ++idx)
+    {
+        OCIO_CHECK_EQUAL_FROM(singleOut[4 * idx + 0], out[4 * idx + 0], line);
+        OCIO_CHECK_EQUAL_FROM(singleOut[4 * idx + 1], out[4 * idx + 1], line);
+        OCIO_CHECK_EQUAL_FROM(singleOut[4 * idx + 3], out[4 * idx + 3], line);
+    }
+}
+
+}
+
+OCIO_ADD_TEST(Lut1DRenderer, single_lut_renderers)
+{
+    OCIO::Lut1DOpDataRcPtr singleLut = std::make_shared<OCIO::Lut1DOpData>(8);
+
+    float * values = &singleLut->getArray().getValues()[0];
+    for (unsigned long idx = 0; idx < 8; ++idx)
+    {
+        const float val = float(idx * idx) / 50.0f;
+        values[3 * idx + 0] = val;
+        values[3 * idx + 1] = val;
+        values[3 * idx + 2] = val;
+    }
+
+    OCIO::Lut1DOpDataRcPtr lut = singleLut->clone();
+    values = &lut->getArray().getValues()[0];
+    for (unsigned long idx = 0; idx < 8; ++idx)
+    {
+        values[3 * idx + 2] *= 0.5f;
+    }
+
+    OCIO_CHECK_NO_THROW(singleLut->finalize());
+    OCIO_CHECK_NO_THROW(lut->finalize());
+    OCIO_REQUIRE_ASSERT(singleLut->hasSingleLut());
+    OCIO_REQUIRE_ASSERT(!lut->hasSingleLut());
+
+    // The channels of a finalized single LUT could then differ.
+    OCIO::Lut1DOpDataRcPtr changedLut = singleLut->clone();
+    changedLut->getArray().getValues()[3 * 7 + 2] = 0.5f;
+    OCIO_CHECK_NO_THROW(changedLut->finalize());
+    OCIO_CHECK_ASSERT(!changedLut->hasSingleLut());
+
+    OCIO::ConstLut1DOpDataRcPtr singleLutConst = singleLut;
+    OCIO::ConstLut1DOpDataRcPtr lutConst = lut;
+
+    std::vector<float> imgF32(4 * 16);
+    for (size_t idx = 0; idx < imgF32.size(); ++idx)
+    {
+        imgF32[idx] = float(idx % 13) * 0.1f - 0.1f;
+    }
+    imgF32[5] = std::numeric_limits<float>::quiet_NaN();
+
+    ValidateLut1DSingleLut<OCIO::BIT_DEPTH_F32, OCIO::BIT_DEPTH_F32>(
+        singleLutConst, lutConst, imgF32, __LINE__);
+    ValidateLut1DSingleLut<OCIO::BIT_DEPTH_F32, OCIO::BIT_DEPTH_UINT10>(
+        singleLutConst, lutConst, imgF32, __LINE__);
+
+    std::vector<uint16_t> imgUINT16(4 * 16);
+    for (size_t idx = 0; idx < imgUINT16.size(); ++idx)
+    {
+        imgUINT16[idx] = uint16_t((idx * 4099) % 65536);
+    }
+
+    ValidateLut1DSingleLut<OCIO::BIT_DEPTH_UINT16, OCIO::BIT_DEPTH_UINT16>(
+        singleLutConst, lutConst, imgUINT16, __LINE__);
+    ValidateLut1DSingleLut<OCIO::BIT_DEPTH_UINT16, OCIO::BIT_DEPTH_F32>(
+        singleLutConst, lutConst, imgUINT16, __LINE__);
+
+    // The hue adjustment renderers.
+    singleLut->setHueAdjust(OCIO::HUE_DW3);
+    lut->setHueAdjust(OCIO::HUE_DW3);
+
+    // Only the pixels having identical red, green and blue input values are then
+    // comparable (i.e. the hue restoration uses the blue channel).
+    for (size_t idx = 0; idx < imgF32.size(); idx += 4)
+    {
+        imgF32[idx + 1] = imgF32[idx + 2] = imgF32[idx];
+    }
+    ValidateLut1DSingleLut<OCIO::BIT_DEPTH_F32, OCIO::BIT_DEPTH_F32>(
+        singleLutConst, lutConst, imgF32, __LINE__);
+
+    // The half domain renderers.
+    OCIO::Lut1DOpDataRcPtr singleHalfLut = std::make_shared<OCIO::Lut1DOpData>(
+        OCIO::Lut1DOpData::LUT_INPUT_HALF_CODE, 65536);
+
+    auto & halfValues = singleHalfLut->getArray().getValues();
+    for (size_t idx = 0; idx < halfValues.size(); ++idx)
+    {
+        halfValues[idx] = float((idx / 3) % 1000) / 1000.0f;
+    }
+
+    OCIO::Lut1DOpDataRcPtr halfLut = singleHalfLut->clone();
+    auto & halfValues2 = halfLut->getArray().getValues();
+    for (size_t idx = 2; idx < halfValues2.size(); idx += 3)
+    {
+        halfValues2[idx] *= 0.5f;
+    }
+
+    OCIO_CHECK_NO_THROW(singleHalfLut->finalize());
+    OCIO_CHECK_NO_THROW(halfLut->finalize());
+    OCIO_REQUIRE_ASSERT(singleHalfLut->hasSingleLut());
+
+    OCIO::ConstLut1DOpDataRcPtr singleHalfLutConst = singleHalfLut;
+    OCIO::ConstLut1DOpDataRcPtr halfLutConst = halfLut;
+
+    ValidateLut1DSingleLut<OCIO::BIT_DEPTH_F32, OCIO::BIT_DEPTH_F32>(
+        singleHalfLutConst, halfLutConst, imgF32, __LINE__);
+    ValidateLut1DSingleLut<OCIO::BIT_DEPTH_UINT16, OCIO::BIT_DEPTH_F32>(
+        singleHalfLutConst, halfLutConst, imgUINT16, __LINE__);
+}
 
 #endif
@@ -1,17 +1,19 @@
 // SPDX-License-Identifier: BSD-3-Clause
 // Copyright Contributors to the OpenColorIO Project.
 
+#include <map>
 #include <sstream>
 #include <string.h>
 
 #include <OpenColorIO/OpenColorIO.h>
 
 #include "BitDepthUtils.h"
+#include "CacheStatistics.h"
 #include "HashUtils.h"
 #include "MathUtils.h"
-#include "md5/md5.h"
 #include "ops/Lut1D/Lut1DOp.h"
 #include "ops/Lut1D/Lut1DOpData.h"
+#include "ops/Lut3D/Lut3DOpData.h"
 #include "ops/Matrix/MatrixOps.h"
 #include "ops/Range/RangeOpData.h"
 #include "OpTools.h"
@@ -21,6 +23,75 @@ OCIO_NAMESPACE_ENTER
 // Number of possible values for the Half domain.
 static const unsigned long HALF_DOMAIN_REQUIRED_ENTRIES = 65536;
 
+namespace
+{
+
+// The compositions of a 1D LUT with a list of ops are cached as identical compositions
+// are often computed again (e.g. the same separable prefix of the processors of a config).
+// The key is made of the hash of the LUT values and of the cache identifiers of the ops.
+typedef std::map<std::string, Array::Values> ComposeVecCacheMap;
+
+ComposeVecCacheMap g_composeVecCache;
+Mutex g_composeVecCacheLock;
+
+// Get the key of the composition of the LUT with the finalized ops, the key is empty
+// if the composition must not be cached (e.g. a dynamic op).
+std::string GetComposeVecKey(const Lut1DOpData & lut, const OpRcPtrVec & ops)
+{
+    std::ostringstream oss;
+    oss << lut.getArray().getValuesHash() << " "
+        << lut.getArray().getLength() << " "
+        << lut.getArray().getNumColorComponents();
+
+    for (const auto & op : ops)
+    {
+        ConstOpRcPtr constOp = op;
+        const std::string cacheID = constOp->getCacheID();
+        if (cacheID.empty() || constOp->isDynamic())
+        {
+            return "";
+        }
+
+        oss << " " << cacheID;
+
+        // The inversion quality is not part of the LUT cache identifiers.
+        ConstOpDataRcPtr data = constOp->data();
+        if (data->getType()==OpData::Lut1DType)
+        {
+            ConstLut1DOpDataRcPtr lut1D = DynamicPtrCast<const Lut1DOpData>(data);
+            oss << " " << int(lut1D->getConcreteInversionQuality());
+        }
+        else if (data->getType()==OpData::Lut3DType)
+        {
+            ConstLut3DOpDataRcPtr lut3D = DynamicPtrCast<const Lut3DOpData>(data);
+            oss << " " << int(lut3D->getConcreteInversionQuality());
+        }
+    }
+
+    return oss.str();
+}
+
+}
+
+void ClearLut1DComposeCache()
+{
+    AutoMutex lock(g_composeVecCacheLock);
+    g_composeVecCache.clear();
+}
+
+size_t GetLut1DComposeCacheMemoryUsage()
+{
+    AutoMutex lock(g_composeVecCacheLock);
+
+    size_t numBytes = 0;
+    for (const auto & entry : g_composeVecCache)
+    {
+        numBytes += entry.first.capacity() + entry.second.capacity() * sizeof(float);
+    }
+
+    return numBytes;
+}
+
 Lut1DOpData::Lut3by1DArray::Lut3by1DArray(HalfFlags halfFlags,
                                           unsigned long length)
 {
@@ -217,6 +288,14 @@ Interpolation Lut1DOpData::getConcreteInterpolation() const
     // using the 'Linear' even if GPU path already support the 'Nearest'
     // interpolation.
     // NB: invalid interpolation will make validate() throw.
+    // NB: Only the draft interpolation quality of the processor really uses the nearest
+    // entries i.e. without changing the processing of the 'Nearest' LUTs.
+    if (m_interpQuality == LUT_INTERPOLATION_DRAFT
+        && m_direction == TRANSFORM_DIR_FORWARD
+        && m_array.getLength() >= DRAFT_NEAREST_MIN_LENGTH)
+    {
+        return INTERP_NEAREST;
+    }
     return INTERP_LINEAR;
 }
 
@@ -245,6 +324,11 @@ void Lut1DOpData::setInversionQuality(LutInversionQuality style)
     m_invQuality = style;
 }
 
+void Lut1DOpData::setInterpolationQuality(LutInterpolationQuality quality)
+{
+    m_interpQuality = quality;
+}
+
 bool Lut1DOpData::isIdentity() const
 {
     return m_array.isIdentity(m_halfFlags);
@@ -474,7 +558,8 @@ bool Lut1DOpData::operator==(const OpData & other) const
 
     // NB: The m_invQuality is not currently included.
     if (m_direction != lop->m_direction
-        || m_interpolation != lop->m_interpolation)
+        || m_interpolation != lop->m_interpolation
+        || m_interpQuality != lop->m_interpQuality)
     {
         return false;
     }
@@ -573,21 +658,16 @@ void Lut1DOpData::finalize()
 
     validate();
 
-    md5_state_t state;
-    md5_byte_t digest[16];
-
-    md5_init(&state);
-    md5_append(&state,
-        (const md5_byte_t *)&(getArray().getValues()[0]),
-        (int)(getArray().getValues().size() * sizeof(float)));
-    md5_finish(&state, digest);
-
     std::ostringstream cacheIDStream;
-    cacheIDStream << GetPrintableHash(digest) << " ";
+    cacheIDStream << m_array.getValuesHash() << " ";
     cacheIDStream << TransformDirectionToString(m_direction) << " ";
     cacheIDStream << InterpolationToString(m_interpolation) << " ";
     cacheIDStream << (isInputHalfDomain()?"half domain ":"standard domain ");
     cacheIDStream << GetHueAdjustName(m_hueAdjust);
+    if (m_interpQuality != LUT_INTERPOLATION_FULL)
+    {
+        cacheIDStream << " " << GetInterpQualityName(m_interpQuality);
+    }
     // NB: The m_invQuality is not currently included.
 
     m_cacheID = cacheIDStream.str();
@@ -629,6 +709,10 @@ void Lut1DOpData::ComposeVec(Lut1DOpDataRcPtr & A, OpRcPtrVec & B)
         throw Exception("There is nothing to compose the 1D LUT with");
     }
 
+    // Only the finalized ops have a cache identifier.
+    FinalizeOpVec(B, FINALIZATION_EXACT);
+    const std::string key = GetComposeVecKey(*A, B);
+
     // Set up so that the eval directly fills in the array of the result LUT.
 
     const long numPixels = (long)A->getArray().getLength();
@@ -637,13 +721,38 @@ void Lut1DOpData::ComposeVec(Lut1DOpDataRcPtr & A, OpRcPtrVec & B)
     A->getArray().resize(numPixels, 3);
     Array::Values & inValues = A->getArray().getValues();
 
-    // Evaluate the transforms at 32f.
+    CacheStatistics & statistics = GetCacheStatistics(CACHE_LUT1D_COMPOSE);
+    if (!key.empty())
+    {
+        AutoTimedMutex lock(g_composeVecCacheLock, statistics);
+        ComposeVecCacheMap::const_iterator iter = g_composeVecCache.find(key);
+        if (iter != g_composeVecCache.end())
+        {
+            statistics.addHit();
+            inValues = iter->second;
+            return;
+        }
+
+        statistics.addMiss();
+    }
+
+    // Evaluate the transforms at 32f, the domain being processed in parallel blocks.
     // Note: If any ops are bypassed, that will be respected here.
 
     EvalTransform((const float*)(&inValues[0]),
                   (float*)(&inValues[0]),
                   numPixels,
                   B);
+
+    if (!key.empty())
+    {
+        AutoTimedMutex lock(g_composeVecCacheLock, statistics);
+        if (g_composeVecCache.find(key) == g_composeVecCache.end())
+        {
+            statistics.addInsertion();
+        }
+        g_composeVecCache[key] = inValues;
+    }
 }
 
 // Compose two Lut1DOpData.
@@ -772,6 +881,8 @@ Lut1DOpDataRcPtr Lut1DOpData::MakeFastLut1DFromInverse(ConstLut1DOpDataRcPtr & l
 
     Compose(newDomainLut, lut, COMPOSE_RESAMPLE_NO);
 
+    newDomainLut->setFiniteInputs(lut->hasFiniteInputs());
+
     return newDomainLut;
 }
 
@@ -1184,6 +1295,49 @@ OCIO_ADD_TEST(Lut1DOpData, clone)
     OCIO_CHECK_NO_THROW(pClone->validate());
     OCIO_CHECK_ASSERT(pClone->getArray() == ref.getArray());
     OCIO_CHECK_EQUAL(pClone->getHueAdjust(), OCIO::HUE_DW3);
+
+    // The clone shares the values until one of them is modified.
+    const OCIO::Lut1DOpData & constRef = ref;
+    OCIO_CHECK_ASSERT(pClone->getArray().sharesValues(constRef.getArray()));
+
+    pClone->getArray()[1] = 0.25f;
+    OCIO_CHECK_ASSERT(!pClone->getArray().sharesValues(constRef.getArray()));
+    OCIO_CHECK_EQUAL(constRef.getArray()[1], 0.5f);
+    OCIO_CHECK_EQUAL(pClone->getArray()[1], 0.25f);
+}
+
+OCIO_ADD_TEST(Lut1DOpData, values_hash)
+{
+    OCIO::Lut1DOpData ref(20);
+    ref.getArray()[1] = 0.5f;
+
+    OCIO_CHECK_NO_THROW(ref.finalize());
+
+    const OCIO::Array & refArray = ref.getArray();
+    const std::string hash = refArray.getValuesHash();
+    OCIO_CHECK_EQUAL(hash,
+                     OCIO::CacheIDHash((const char *)refArray.getValues().data(),
+                                       refArray.getValues().size() * sizeof(float)));
+    OCIO_CHECK_EQUAL(ref.getCacheID().substr(0, hash.size()), hash);
+
+    // The clones inherit the hash.
+
+    OCIO::Lut1DOpDataRcPtr pClone = ref.clone();
+    OCIO::ConstLut1DOpDataRcPtr pConstClone = pClone;
+    OCIO_CHECK_EQUAL(pConstClone->getArray().getValuesHash(), hash);
+
+    OCIO_CHECK_NO_THROW(pClone->finalize());
+    OCIO_CHECK_EQUAL(pClone->getCacheID(), ref.getCacheID());
+
+    // Changing the values resets the hash.
+
+    pClone->getArray()[1] = 0.25f;
+    OCIO_CHECK_NO_THROW(pClone->finalize());
+    OCIO_CHECK_NE(pConstClone->getArray().getValuesHash(), hash);
+    OCIO_CHECK_NE(pClone->getCacheID(), ref.getCacheID());
+
+    pClone->getArray()[1] = 0.5f;
+    OCIO_CHECK_EQUAL(pConstClone->getArray().getValuesHash(), hash);
 }
 
 OCIO_ADD_TEST(Lut1DOpData, equality_test)
@@ -1296,6 +1450,36 @@ OCIO_ADD_TEST(Lut1DOpData, interpolation)
     OCIO_CHECK_THROW_WHAT(l.validate(), OCIO::Exception, " does not support interpolation algorithm");
 }
 
+OCIO_ADD_TEST(Lut1DOpData, interpolation_quality)
+{
+    OCIO::Lut1DOpData l(17);
+    OCIO_CHECK_EQUAL(l.getInterpolationQuality(), OCIO::LUT_INTERPOLATION_FULL);
+
+    // Only the large forward 1D LUTs use the nearest entry in draft quality.
+    l.setInterpolationQuality(OCIO::LUT_INTERPOLATION_DRAFT);
+    OCIO_CHECK_EQUAL(l.getConcreteInterpolation(), OCIO::INTERP_LINEAR);
+
+    const unsigned long length = OCIO::Lut1DOpData::DRAFT_NEAREST_MIN_LENGTH;
+
+    OCIO::Lut1DOpData large(length);
+    OCIO_CHECK_NO_THROW(large.finalize());
+
+    OCIO::Lut1DOpData largeDraft(length);
+    largeDraft.setInterpolationQuality(OCIO::LUT_INTERPOLATION_DRAFT);
+    OCIO_CHECK_EQUAL(largeDraft.getConcreteInterpolation(), OCIO::INTERP_NEAREST);
+    OCIO_CHECK_ASSERT(!(large == largeDraft));
+    OCIO_CHECK_NO_THROW(largeDraft.finalize());
+    OCIO_CHECK_NE(largeDraft.getCacheID(), large.getCacheID());
+
+    largeDraft.setInterpolationQuality(OCIO::LUT_INTERPOLATION_PREVIEW);
+    OCIO_CHECK_EQUAL(largeDraft.getConcreteInterpolation(), OCIO::INTERP_LINEAR);
+
+    // The inverse 1D LUTs are not affected.
+    OCIO::Lut1DOpData inverse(length, OCIO::TRANSFORM_DIR_INVERSE);
+    inverse.setInterpolationQuality(OCIO::LUT_INTERPOLATION_DRAFT);
+    OCIO_CHECK_EQUAL(inverse.getConcreteInterpolation(), OCIO::INTERP_LINEAR);
+}
+
 OCIO_ADD_TEST(Lut1DOpData, inversion_quality)
 {
     OCIO::Lut1DOpData l(17);
@@ -1535,6 +1719,48 @@ OCIO_ADD_TEST(Lut1DOpData, lut_1d_compose_sc)
     }
 }
 
+OCIO_ADD_TEST(Lut1DOpData, compose_vec_cache)
+{
+    OCIO::ClearLut1DComposeCache();
+    OCIO_CHECK_EQUAL(OCIO::GetLut1DComposeCacheMemoryUsage(), 0);
+
+    OCIO::Lut1DOpDataRcPtr lut = std::make_shared<OCIO::Lut1DOpData>(1024);
+    lut->getArray().getValues()[1500] = 0.6f;
+
+    const auto compose = [&lut](double scale)
+    {
+        OCIO::OpRcPtrVec ops;
+        OCIO::Lut1DOpDataRcPtr lutClone = lut->clone();
+        OCIO::CreateLut1DOp(ops, lutClone, OCIO::TRANSFORM_DIR_FORWARD);
+        const double scale4[4] = { scale, scale, scale, 1.0 };
+        OCIO::CreateScaleOp(ops, scale4, OCIO::TRANSFORM_DIR_FORWARD);
+
+        OCIO::Lut1DOpDataRcPtr domain = std::make_shared<OCIO::Lut1DOpData>(4096);
+        OCIO::Lut1DOpData::ComposeVec(domain, ops);
+        return domain;
+    };
+
+    OCIO::Lut1DOpDataRcPtr computed;
+    OCIO_CHECK_NO_THROW(computed = compose(0.5));
+    const size_t usage = OCIO::GetLut1DComposeCacheMemoryUsage();
+    OCIO_CHECK_ASSERT(usage >= 4096 * 3 * sizeof(float));
+
+    // The identical composition comes from the cache.
+    OCIO::Lut1DOpDataRcPtr cached;
+    OCIO_CHECK_NO_THROW(cached = compose(0.5));
+    OCIO_CHECK_EQUAL(OCIO::GetLut1DComposeCacheMemoryUsage(), usage);
+    OCIO_CHECK_ASSERT(cached->getArray().getValues() == computed->getArray().getValues());
+
+    // Other ops lead to another composition.
+    OCIO::Lut1DOpDataRcPtr other;
+    OCIO_CHECK_NO_THROW(other = compose(0.25));
+    OCIO_CHECK_ASSERT(OCIO::GetLut1DComposeCacheMemoryUsage() > usage);
+    OCIO_CHECK_ASSERT(other->getArray().getValues() != computed->getArray().getValues());
+
+    OCIO::ClearLut1DComposeCache();
+    OCIO_CHECK_EQUAL(OCIO::GetLut1DComposeCacheMemoryUsage(), 0);
+}
+
 namespace
 {
 const char uid[] = "uid";
@@ -110,6 +110,19 @@ public:
 
     void setInversionQuality(LutInversionQuality style);
 
+    // The interpolation quality requested by the processor (refer to
+    // LutInterpolationQuality). With LUT_INTERPOLATION_DRAFT, the forward LUTs of at
+    // least DRAFT_NEAREST_MIN_LENGTH entries use their nearest entries.
+    static constexpr unsigned long DRAFT_NEAREST_MIN_LENGTH = 4096;
+
+    inline LutInterpolationQuality getInterpolationQuality() const { return m_interpQuality; }
+    void setInterpolationQuality(LutInterpolationQuality quality);
+
+    // The CPU renderers could skip the NaN & infinity handling when the input values
+    // are known to be finite (refer to SetCPUFiniteInputs()).
+    inline bool hasFiniteInputs() const { return m_finiteInputs; }
+    inline void setFiniteInputs(bool finite) { m_finiteInputs = finite; }
+
     Type getType() const override { return Lut1DType; }
 
     bool isNoOp() const override;
@@ -117,6 +130,7 @@ public:
     bool isIdentity() const override;
 
     bool hasChannelCrosstalk() const override;
+    bool touchesAlpha() const override { return false; }
 
     void finalize() override;
 
@@ -273,6 +287,10 @@ private:
     // Members for inverse LUT.
     LutInversionQuality m_invQuality;
 
+    LutInterpolationQuality m_interpQuality = LUT_INTERPOLATION_FULL;
+
+    bool m_finiteInputs = false;
+
     ComponentProperties m_componentProperties[3];
 
     // The LUT scaling for/from the file.
@@ -280,6 +298,12 @@ private:
     BitDepth m_fileOutBitDepth = BIT_DEPTH_UNKNOWN;
 };
 
+// The results of Lut1DOpData::ComposeVec() are cached.
+void ClearLut1DComposeCache();
+
+// Get the approximate number of bytes held by the composition cache.
+size_t GetLut1DComposeCacheMemoryUsage();
+
 }
 OCIO_NAMESPACE_EXIT
 
@@ -6,6 +6,7 @@
 
 #include <OpenColorIO/OpenColorIO.h>
 
+#include "GpuShader.h"
 #include "GpuShaderUtils.h"
 #include "MathUtils.h"
 #include "ops/Lut1D/Lut1DOpGPU.h"
@@ -78,6 +79,11 @@ void PadLutChannels(unsigned long width,
         chn.push_back(SanitizeFloat(channel[3 * (currWidth - 1) + 2]));
     }
 }
+
+std::string GetLut1DAtlasName(const GpuShaderDesc & shaderDesc)
+{
+    return std::string(shaderDesc.getResourcePrefix()) + "lut1d_atlas";
+}
 }
 
 void GetLut1DGPUShaderProgram(GpuShaderDescRcPtr & shaderDesc,
@@ -86,49 +92,104 @@ void GetLut1DGPUShaderProgram(GpuShaderDescRcPtr & shaderDesc,
     const unsigned long defaultMaxWidth = shaderDesc->getTextureMaxWidth();
 
     const unsigned long length = lutData->getArray().getLength();
-    const unsigned long width = std::min(length, defaultMaxWidth);
-    const unsigned long height = (length / defaultMaxWidth) + 1;
 
-    // Adjust LUT texture to allow for correct 2d linear interpolation, if needed.
+    // With the native textures, the LUT is a single-row texture of the LUT length
+    // (i.e. a 1D texture) instead of being folded in a 2D texture.
 
-    std::vector<float> values;
-    values.reserve(width*height*3);
+    const bool nativeTexture = shaderDesc->isLut1DNativeTexturesEnabled();
 
-    PadLutChannels(width, height, lutData->getArray().getValues(), values);
+    // The draft interpolation quality samples the center of the nearest texel so the
+    // result does not depend on the texture filtering (e.g. in the 1D LUT atlas).
+    const bool nearest = lutData->getConcreteInterpolation() == INTERP_NEAREST;
 
-    // Register the RGB LUT.
+    unsigned long width = nativeTexture ? length : std::min(length, defaultMaxWidth);
+    // The last texel of a row is repeated at the start of the next row (refer to
+    // PadLutChannels()) so each row holds (width - 1) new entries.
+    const unsigned long height = nativeTexture ? 1 : (length - 1) / (defaultMaxWidth - 1) + 1;
 
-    std::ostringstream resName;
-    resName << shaderDesc->getResourcePrefix()
-            << std::string("lut1d_")
-            << shaderDesc->getNumTextures();
+    // When enabled, the LUT is packed in the 1D LUT atlas i.e. a 2D texture shared by
+    // all the 1D LUTs, where the LUT rows have the texture maximum width.
 
-    const std::string name(resName.str());
-    
-    shaderDesc->addTexture(GpuShaderText::getSamplerName(name).c_str(),
-                           lutData->getCacheID().c_str(),
-                           width, height,
-                           GpuShaderDesc::TEXTURE_RGB_CHANNEL,
-                           lutData->getConcreteInterpolation(),
-                           &values[0]);
+    bool inAtlas = false;
+    unsigned atlasRow = 0;
 
-    // Add the LUT code to the OCIO shader program.
+    if (shaderDesc->isLut1DAtlasEnabled() && !nativeTexture)
+    {
+        std::vector<float> values;
+        values.reserve(defaultMaxWidth*height*3);
 
-    if (height > 1 || lutData->isInputHalfDomain())
+        PadLutChannels(defaultMaxWidth, height, lutData->getArray().getValues(), values);
+
+        if (AddToLut1DAtlas(*shaderDesc, lutData->getCacheID().c_str(),
+                            height, &values[0], atlasRow))
+        {
+            inAtlas = true;
+            width   = defaultMaxWidth;
+        }
+    }
+
+    std::string name;
+    std::string textureName;
+
+    if (inAtlas)
     {
-        // In case the 1D LUT length exceeds the 1D texture maximum length
-        // a 2D texture is used.
+        textureName = GetLut1DAtlasName(*shaderDesc);
+        name = textureName + "_" + std::to_string(atlasRow);
+    }
+    else
+    {
+        // Adjust LUT texture to allow for correct 2d linear interpolation, if needed.
+
+        std::vector<float> values;
+        values.reserve(width*height*3);
 
+        PadLutChannels(width, height, lutData->getArray().getValues(), values);
+
+        // Register the RGB LUT.
+
+        const unsigned textureIndex = shaderDesc->getNumTextures();
+
+        std::ostringstream resName;
+        resName << shaderDesc->getResourcePrefix()
+                << std::string("lut1d_")
+                << textureIndex;
+
+        name = resName.str();
+        textureName = name;
+
+        shaderDesc->addTexture(GpuShaderText::getSamplerName(name).c_str(),
+                               lutData->getCacheID().c_str(),
+                               width, height,
+                               GpuShaderDesc::TEXTURE_RGB_CHANNEL,
+                               lutData->getConcreteInterpolation(),
+                               &values[0]);
+
+        GpuShaderText ss(shaderDesc->getLanguage());
+        if (height > 1 || (lutData->isInputHalfDomain() && !nativeTexture))
         {
-            GpuShaderText ss(shaderDesc->getLanguage());
-            ss.declareTex2D(name);
-            shaderDesc->addToDeclareShaderCode(ss.string().c_str());
+            // In case the 1D LUT length exceeds the 1D texture maximum length
+            // a 2D texture is used.
+            ss.declareTex2D(name, textureIndex);
+        }
+        else
+        {
+            ss.declareTex1D(name, textureIndex);
         }
+        shaderDesc->addToDeclareShaderCode(ss.string().c_str());
+    }
+
+    // Add the LUT code to the OCIO shader program.
+
+    const bool use2D = inAtlas || height > 1 || (lutData->isInputHalfDomain() && !nativeTexture);
 
+    if (use2D || lutData->isInputHalfDomain())
+    {
         {
             GpuShaderText ss(shaderDesc->getLanguage());
 
-            ss.newLine() << ss.vec2fKeyword() << " " << name << "_computePos(float f)";
+            // A half-domain LUT in a native texture only needs the 1D coordinate.
+            ss.newLine() << (use2D ? ss.vec2fKeyword() : std::string("float"))
+                         << " " << name << "_computePos(float f)";
             ss.newLine() << "{";
             ss.indent();
 
@@ -165,24 +226,40 @@ void GetLut1DGPUShaderProgram(GpuShaderDescRcPtr & shaderDesc,
                 ss.dedent();
                 ss.newLine() << "}";
 
+                if (nearest)
+                {
+                    ss.newLine() << "dep = floor(dep + 0.5);";
+                }
+
                 // Adjust position for negative values
                 ss.newLine() << "dep += step(f, 0.0) * 32768.0;";
 
                 // At this point 'dep' contains the raw half
                 // Note: Raw halfs for NaN floats cannot be computed using
                 //       floating-point operations.
-                ss.newLine() << ss.vec2fDecl("retVal") << ";";
-                ss.newLine() << "retVal.y = floor(dep / " << float(width - 1) << ");";       // floor( dep / (width-1) ))
-                ss.newLine() << "retVal.x = dep - retVal.y * " << float(width - 1) << ";";   // dep - retVal.y * (width-1)
-
-                ss.newLine() << "retVal.x = (retVal.x + 0.5) / " << float(width) << ";";   // (retVal.x + 0.5) / width;
-                ss.newLine() << "retVal.y = (retVal.y + 0.5) / " << float(height) << ";";  // (retVal.x + 0.5) / height;
+                if (use2D)
+                {
+                    ss.newLine() << ss.vec2fDecl("retVal") << ";";
+                    ss.newLine() << "retVal.y = floor(dep / " << float(width - 1) << ");";       // floor( dep / (width-1) ))
+                    ss.newLine() << "retVal.x = dep - retVal.y * " << float(width - 1) << ";";   // dep - retVal.y * (width-1)
+
+                    ss.newLine() << "retVal.x = (retVal.x + 0.5) / " << float(width) << ";";   // (retVal.x + 0.5) / width;
+                }
+                else
+                {
+                    // (dep + 0.5) / width;
+                    ss.newLine() << "return (dep + 0.5) / " << float(width) << ";";
+                }
             }
             else
             {
                 // Need min() to protect against f > 1 causing a bogus x value.
                 // min( f, 1.) * (dim - 1)
                 ss.newLine() << "float dep = min(f, 1.0) * " << float(length - 1) << ";";
+                if (nearest)
+                {
+                    ss.newLine() << "dep = floor(dep + 0.5);";
+                }
 
                 ss.newLine() << ss.vec2fDecl("retVal") << ";";
                 // float(int( dep / (width-1) ))
@@ -192,23 +269,29 @@ void GetLut1DGPUShaderProgram(GpuShaderDescRcPtr & shaderDesc,
 
                 // (retVal.x + 0.5) / width;
                 ss.newLine() << "retVal.x = (retVal.x + 0.5) / " << float(width) << ";";
-                // (retVal.x + 0.5) / height;
+            }
+
+            if (inAtlas)
+            {
+                // (retVal.y + firstRow + 0.5) / atlasHeight where the atlas height is
+                // only known once all the LUTs are added.
+                ss.newLine() << "retVal.y = (retVal.y + " << (float(atlasRow) + 0.5f) << ") / "
+                             << textureName << "_height;";
+                ss.newLine() << "return retVal;";
+            }
+            else if (use2D)
+            {
+                // (retVal.y + 0.5) / height;
                 ss.newLine() << "retVal.y = (retVal.y + 0.5) / " << float(height) << ";";
+                ss.newLine() << "return retVal;";
             }
 
-            ss.newLine() << "return retVal;";
             ss.dedent();
             ss.newLine() << "}";
 
             shaderDesc->addToHelperShaderCode(ss.string().c_str());
         }
     }
-    else
-    {
-        GpuShaderText ss(shaderDesc->getLanguage());
-        ss.declareTex1D(name);
-        shaderDesc->addToDeclareShaderCode(ss.string().c_str());
-    }
 
     GpuShaderText ss(shaderDesc->getLanguage());
     ss.indent();
@@ -234,23 +317,44 @@ void GetLut1DGPUShaderProgram(GpuShaderDescRcPtr & shaderDesc,
         ss.newLine() << "";
     }
 
-    if (height > 1 || lutData->isInputHalfDomain())
+    if (use2D)
     {
         const std::string str = name + "_computePos(" + shaderDesc->getPixelName();
 
-        ss.newLine() << shaderDesc->getPixelName() << ".r = " << ss.sampleTex2D(name, str + ".r)") << ".r;";
-        ss.newLine() << shaderDesc->getPixelName() << ".g = " << ss.sampleTex2D(name, str + ".g)") << ".g;";
-        ss.newLine() << shaderDesc->getPixelName() << ".b = " << ss.sampleTex2D(name, str + ".b)") << ".b;";
+        ss.newLine() << shaderDesc->getPixelName() << ".r = " << ss.sampleTex2D(textureName, str + ".r)") << ".r;";
+        ss.newLine() << shaderDesc->getPixelName() << ".g = " << ss.sampleTex2D(textureName, str + ".g)") << ".g;";
+        ss.newLine() << shaderDesc->getPixelName() << ".b = " << ss.sampleTex2D(textureName, str + ".b)") << ".b;";
+    }
+    else if (lutData->isInputHalfDomain())
+    {
+        // A single 1D texture fetch per channel.
+        const std::string str = name + "_computePos(" + shaderDesc->getPixelName();
+
+        ss.newLine() << shaderDesc->getPixelName() << ".r = " << ss.sampleTex1D(name, str + ".r)") << ".r;";
+        ss.newLine() << shaderDesc->getPixelName() << ".g = " << ss.sampleTex1D(name, str + ".g)") << ".g;";
+        ss.newLine() << shaderDesc->getPixelName() << ".b = " << ss.sampleTex1D(name, str + ".b)") << ".b;";
     }
     else
     {
         const float dim = (float)lutData->getArray().getLength();
 
-        ss.newLine() << ss.vec3fDecl(name + "_coords")
-                        << " = (" << shaderDesc->getPixelName() << ".rgb * "
-                        << ss.vec3fConst(dim - 1)
-                        << " + " << ss.vec3fConst(0.5f) << " ) / "
-                        << ss.vec3fConst(dim) << ";";
+        if (nearest)
+        {
+            ss.newLine() << ss.vec3fDecl(name + "_coords")
+                            << " = (floor(" << shaderDesc->getPixelName() << ".rgb * "
+                            << ss.vec3fConst(dim - 1)
+                            << " + " << ss.vec3fConst(0.5f) << ") + "
+                            << ss.vec3fConst(0.5f) << " ) / "
+                            << ss.vec3fConst(dim) << ";";
+        }
+        else
+        {
+            ss.newLine() << ss.vec3fDecl(name + "_coords")
+                            << " = (" << shaderDesc->getPixelName() << ".rgb * "
+                            << ss.vec3fConst(dim - 1)
+                            << " + " << ss.vec3fConst(0.5f) << " ) / "
+                            << ss.vec3fConst(dim) << ";";
+        }
 
         ss.newLine() << shaderDesc->getPixelName() << ".r = "
                         << ss.sampleTex1D(name, name + "_coords.r") << ".r;";
@@ -282,6 +386,155 @@ void GetLut1DGPUShaderProgram(GpuShaderDescRcPtr & shaderDesc,
 
 }
 
+bool IsInvLut1DSearchSupported(const GpuShaderDesc & shaderDesc, const Lut1DOpData & lutData)
+{
+    return shaderDesc.isLut1DInverseSearchEnabled()
+        && lutData.getDirection() == TRANSFORM_DIR_INVERSE
+        && !lutData.isInputHalfDomain()
+        && lutData.getHueAdjust() == HUE_NONE
+        && lutData.getArray().getLength() >= 2
+        && lutData.getArray().getLength() <= shaderDesc.getTextureMaxWidth();
+}
+
+void GetInvLut1DGPUShaderProgram(GpuShaderDescRcPtr & shaderDesc,
+                                 ConstLut1DOpDataRcPtr & lutData)
+{
+    const unsigned long length = lutData->getArray().getLength();
+    const Array::Values & lutValues = lutData->getArray().getValues();
+
+    const Lut1DOpData::ComponentProperties * properties[3]
+        = { &lutData->getRedProperties(),
+            &lutData->getGreenProperties(),
+            &lutData->getBlueProperties() };
+
+    // As for the CPU renderer, the decreasing LUTs are negated so the searched values are
+    // always increasing.
+
+    std::vector<float> values(length * 3);
+    for (unsigned long idx = 0; idx < length; ++idx)
+    {
+        for (unsigned long c = 0; c < 3; ++c)
+        {
+            const float val = SanitizeFloat(lutValues[idx * 3 + c]);
+            values[idx * 3 + c] = properties[c]->isIncreasing ? val : -val;
+        }
+    }
+
+    // Register the RGB LUT. The texture is only sampled at the texel centers.
+
+    const unsigned textureIndex = shaderDesc->getNumTextures();
+
+    std::ostringstream resName;
+    resName << shaderDesc->getResourcePrefix()
+            << std::string("lut1d_")
+            << textureIndex;
+
+    const std::string name(resName.str());
+
+    shaderDesc->addTexture(GpuShaderText::getSamplerName(name).c_str(),
+                           lutData->getCacheID().c_str(),
+                           (unsigned)length, 1,
+                           GpuShaderDesc::TEXTURE_RGB_CHANNEL,
+                           INTERP_NEAREST,
+                           &values[0]);
+
+    {
+        GpuShaderText ss(shaderDesc->getLanguage());
+        ss.declareTex1D(name, textureIndex);
+        shaderDesc->addToDeclareShaderCode(ss.string().c_str());
+    }
+
+    GpuShaderText ss(shaderDesc->getLanguage());
+    ss.indent();
+
+    ss.newLine() << "";
+    ss.newLine() << "// Add an inverse LUT 1D processing for " << name;
+    ss.newLine() << "";
+
+    const std::string pix(shaderDesc->getPixelName());
+    const std::string width(std::to_string(length) + ".");
+    const char * channels[3] = { "r", "g", "b" };
+
+    for (unsigned c = 0; c < 3; ++c)
+    {
+        const std::string chan(channels[c]);
+
+        // Get the LUT entry at a given index.
+        const auto entry = [&ss, &name, &width, &chan](const std::string & index)
+        {
+            return ss.sampleTex1D(name, "(" + index + " + 0.5) / " + width) + "." + chan;
+        };
+
+        const unsigned long start = properties[c]->startDomain;
+        const unsigned long end   = properties[c]->endDomain;
+
+        // The number of bisections reducing [start, end] to adjacent entries.
+        unsigned numSteps = 0;
+        while ((1UL << numSteps) < end - start)
+        {
+            ++numSteps;
+        }
+
+        ss.newLine() << "{";
+        ss.indent();
+
+        // Clamp the value to the range of the LUT.
+        ss.newLine() << "float v = clamp(" << pix << "." << chan
+                     << (properties[c]->isIncreasing ? "" : " * -1.0")
+                     << ", " << values[start * 3 + c] << ", " << values[end * 3 + c] << ");";
+
+        // Find the last entry lower than the value (i.e. or the start of the LUT).
+        ss.newLine() << "float low = " << float(start) << ";";
+        ss.newLine() << "float high = " << float(end) << ";";
+        ss.newLine() << "for (int i = 0; i < " << numSteps << "; ++i)";
+        ss.newLine() << "{";
+        ss.indent();
+        ss.newLine() << "float mid = floor((low + high) * 0.5);";
+        ss.newLine() << "if (" << entry("mid") << " < v)";
+        ss.newLine() << "{";
+        ss.indent();
+        ss.newLine() << "low = mid;";
+        ss.dedent();
+        ss.newLine() << "}";
+        ss.newLine() << "else";
+        ss.newLine() << "{";
+        ss.indent();
+        ss.newLine() << "high = mid;";
+        ss.dedent();
+        ss.newLine() << "}";
+        ss.dedent();
+        ss.newLine() << "}";
+
+        // Interpolate between the two entries (i.e. handle flat spots by using the lower one).
+        ss.newLine() << "float lowVal = " << entry("low") << ";";
+        ss.newLine() << "float highVal = " << entry("high") << ";";
+        ss.newLine() << "float delta = (highVal > lowVal) ? (v - lowVal) / (highVal - lowVal) : 0.;";
+        ss.newLine() << pix << "." << chan << " = (low + delta) / " << float(length - 1) << ";";
+
+        ss.dedent();
+        ss.newLine() << "}";
+    }
+
+    shaderDesc->addToFunctionShaderCode(ss.string().c_str());
+}
+
+void GetLut1DAtlasGPUShaderProgram(GpuShaderDescRcPtr & shaderDesc)
+{
+    const std::string name = GetLut1DAtlasName(*shaderDesc);
+
+    const unsigned textureIndex = shaderDesc->getNumTextures();
+    const unsigned height 
+        = AddLut1DAtlasTexture(*shaderDesc, GpuShaderText::getSamplerName(name).c_str());
+
+    if (height > 0)
+    {
+        GpuShaderText ss(shaderDesc->getLanguage());
+        ss.declareTex2D(name, textureIndex);
+        ss.declareFloatConst(name + "_height", float(height));
+        shaderDesc->addToDeclareShaderCode(ss.string().c_str());
+    }
+}
+
 
 }
 OCIO_NAMESPACE_EXIT
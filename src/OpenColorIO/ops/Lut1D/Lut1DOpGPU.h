@@ -18,6 +18,21 @@ OCIO_NAMESPACE_ENTER
 void GetLut1DGPUShaderProgram(GpuShaderDescRcPtr & shaderDesc,
                               ConstLut1DOpDataRcPtr & lutData);
 
+// Can the inverse 1D LUT be rendered with a binary search in its forward values (refer to
+// GpuShaderDesc::setLut1DInverseSearchEnabled())? The search is used for the LUTs fitting in
+// a single texture row (i.e. all of them with the native textures), without half domain or
+// hue adjustment.
+bool IsInvLut1DSearchSupported(const GpuShaderDesc & shaderDesc, const Lut1DOpData & lutData);
+
+// Render an inverse 1D LUT with a binary search in its forward values i.e. an exact inversion
+// instead of baking an approximating forward LUT.
+void GetInvLut1DGPUShaderProgram(GpuShaderDescRcPtr & shaderDesc,
+                                 ConstLut1DOpDataRcPtr & lutData);
+
+// Add the 1D LUT atlas texture (i.e. when some 1D LUTs were packed in it, refer to
+// GpuShaderDesc::setLut1DAtlasEnabled()) once all the ops are added to the shader program.
+void GetLut1DAtlasGPUShaderProgram(GpuShaderDescRcPtr & shaderDesc);
+
 }
 OCIO_NAMESPACE_EXIT
 
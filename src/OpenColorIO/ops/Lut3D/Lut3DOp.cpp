@@ -2,6 +2,7 @@
 // Copyright Contributors to the OpenColorIO Project.
 
 #include <algorithm>
+#include <atomic>
 #include <cmath>
 #include <limits>
 #include <sstream>
@@ -99,6 +100,18 @@ namespace
         return static_cast<int>(roundf(std::max(std::min(k, maxVal), minVal)));
     }
 
+    // Refer to SetCPULut3DHalfStorage().
+    std::atomic<bool> g_lut3DHalfStorage{ false };
+}
+
+void SetCPULut3DHalfStorage(bool halfStorage)
+{
+    g_lut3DHalfStorage = halfStorage;
+}
+
+bool IsCPULut3DHalfStorage()
+{
+    return g_lut3DHalfStorage;
 }
 
 void GenerateIdentityLut3D(float* img, int edgeLen, int numChannels, Lut3DOrder lut3DOrder)
@@ -169,6 +182,7 @@ namespace
         OpRcPtr clone() const override;
 
         std::string getInfo() const override;
+        double getCost() const override;
 
         bool isSameType(ConstOpRcPtr & op) const override;
         bool isInverse(ConstOpRcPtr & op) const override;
@@ -222,6 +236,29 @@ namespace
         return "<Lut3DOp>";
     }
 
+    double Lut3DOp::getCost() const
+    {
+        ConstLut3DOpDataRcPtr lut = lut3DData();
+
+        if (lut->getDirection() == TRANSFORM_DIR_INVERSE
+            && lut->getConcreteInversionQuality() == LUT_INVERSION_EXACT)
+        {
+            // An iterative search through the lattice.
+            return 50.0;
+        }
+
+        // Note that the fast inverse is rendered with a forward LUT of a similar size
+        // (refer to MakeFastLut3DFromInverse()).
+        const double cost = lut->getConcreteInterpolation() == INTERP_TETRAHEDRAL ? 5.0 : 6.0;
+
+        // The CPU renderer stores RGBA entries of half or float values.
+        const size_t gridSize = (size_t)lut->getGridSize();
+        const size_t numBytes = gridSize * gridSize * gridSize * 4
+                                * (lut->isHalfStorage() ? 2 : 4);
+
+        return cost + GetLutMemoryCost(numBytes);
+    }
+
     bool Lut3DOp::isSameType(ConstOpRcPtr & op) const
     {
         ConstLut3DOpRcPtr lutRcPtr = DynamicPtrCast<const Lut3DOp>(op);
@@ -252,11 +289,17 @@ namespace
         lutData->setInversionQuality(
             fFlags==FINALIZATION_FAST ? LUT_INVERSION_FAST: LUT_INVERSION_EXACT);
 
+        lutData->setHalfStorage(fFlags==FINALIZATION_FAST && IsCPULut3DHalfStorage());
+
         lutData->finalize();
 
         std::ostringstream cacheIDStream;
         cacheIDStream << "<Lut3D ";
         cacheIDStream << lutData->getCacheID() << " ";
+        if (lutData->isHalfStorage())
+        {
+            cacheIDStream << "half ";
+        }
         cacheIDStream << ">";
 
         m_cacheID = cacheIDStream.str();
@@ -564,6 +607,33 @@ OCIO_ADD_TEST(Lut3DOp, cache_id)
     OCIO_CHECK_EQUAL(cacheID, ops[1]->getCacheID());
 }
 
+OCIO_ADD_TEST(Lut3DOp, half_storage)
+{
+    OCIO::OpRcPtrVec ops;
+    OCIO::Lut3DOpDataRcPtr lut = std::make_shared<OCIO::Lut3DOpData>(3);
+    OCIO_CHECK_NO_THROW(CreateLut3DOp(ops, lut, OCIO::TRANSFORM_DIR_FORWARD));
+    OCIO_REQUIRE_EQUAL(ops.size(), 1);
+
+    // Disabled by default.
+    OCIO_CHECK_ASSERT(!OCIO::IsCPULut3DHalfStorage());
+    OCIO_CHECK_NO_THROW(ops[0]->finalize(OCIO::FINALIZATION_FAST));
+    OCIO_CHECK_ASSERT(!lut->isHalfStorage());
+    const std::string floatCacheID = ops[0]->getCacheID();
+
+    OCIO::SetCPULut3DHalfStorage(true);
+
+    // Only used by the fast finalization.
+    OCIO_CHECK_NO_THROW(ops[0]->finalize(OCIO::FINALIZATION_EXACT));
+    OCIO_CHECK_ASSERT(!lut->isHalfStorage());
+    OCIO_CHECK_EQUAL(ops[0]->getCacheID(), floatCacheID);
+
+    OCIO_CHECK_NO_THROW(ops[0]->finalize(OCIO::FINALIZATION_FAST));
+    OCIO_CHECK_ASSERT(lut->isHalfStorage());
+    OCIO_CHECK_NE(ops[0]->getCacheID(), floatCacheID);
+
+    OCIO::SetCPULut3DHalfStorage(false);
+}
+
 OCIO_ADD_TEST(Lut3DOp, edge_len_from_num_pixels)
 {
     OCIO_CHECK_THROW_WHAT(OCIO::Get3DLutEdgeLenFromNumPixels(10),
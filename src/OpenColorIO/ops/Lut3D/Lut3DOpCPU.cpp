@@ -3,43 +3,103 @@
 
 #include <algorithm>
 #include <math.h>
+#include <sstream>
 #include <stdint.h>
 #include <vector>
 
 #include <OpenColorIO/OpenColorIO.h>
 
 #include "BitDepthUtils.h"
+#include "CPUInfo.h"
 #include "MathUtils.h"
+#include "ops/Lut1D/Lut1DOpCPU.h"
 #include "ops/Lut3D/Lut3DOpCPU.h"
 #include "OpTools.h"
 #include "Platform.h"
+#include "RendererAllocator.h"
+#include "SharedLutMemory.h"
 #include "SSE.h"
+#include "ThreadPool.h"
+
+#if defined(OCIO_USE_AVX)
+#include <immintrin.h>
+#endif
 
 OCIO_NAMESPACE_ENTER
 {
 namespace
 {
 
+#ifdef USE_SSE
+// The entries are padded to RGBA in order to be able to load them using _mm_load_ps.
+constexpr int LUT3D_ENTRY_SIZE = 4;
+#else
+constexpr int LUT3D_ENTRY_SIZE = 3;
+#endif
+
+// From that grid size, the LUT entries are stored in bricks of 4x4x4 entries instead of
+// the blue-fastest order so the corners of a cell (which are up to two planes apart in
+// the blue-fastest order) are usually in the same brick i.e. in a few cache lines of the
+// same memory page. The grid is then padded to a multiple of 4, which is a small memory
+// overhead for large grids.
+constexpr unsigned long LUT3D_BLOCKED_LAYOUT_MIN_SIZE = 48;
+
+// Describe how the LUT entries are stored (i.e. the offsets are in values).
+struct Lut3DLayout
+{
+    // The offset of consecutive entries (of a brick) along each axis.
+    int entryStrides[3];
+    // The offset of consecutive bricks along each axis. Note that the blue-fastest order
+    // is a layout where the brick strides are 4 times the entry strides.
+    int brickStrides[3];
+    // The number of entries including the padding ones.
+    long numEntries;
+    // The entry (r, g, b) starts at offsets[0][r] + offsets[1][g] + offsets[2][b].
+    std::vector<int> offsets[3];
+
+    inline int getOffset(int indexR, int indexG, int indexB) const
+    {
+        return offsets[0][indexR] + offsets[1][indexG] + offsets[2][indexB];
+    }
+};
+
 class BaseLut3DRenderer : public OpCPU
 {
 public:
     explicit BaseLut3DRenderer(ConstLut3DOpDataRcPtr & lut);
     virtual ~BaseLut3DRenderer();
 
+    size_t getMemorySize() const override;
+
 protected:
     void updateData(ConstLut3DOpDataRcPtr & lut);
 
+    void updateLayout();
+
     // Creates a LUT aligned to a 16 byte boundary with RGB and 0 for alpha
-    // in order to be able to load the LUT using _mm_load_ps.
-    float* createOptLut(const Array::Values& lut) const;
+    // in order to be able to load the LUT using _mm_load_ps. The LutType is
+    // float, or half to halve the memory footprint (refer to SetCPULut3DHalfStorage()).
+    // The LUT could be shared with the other processes (refer to SetCPUSharedLutMemory()).
+    template<typename LutType>
+    LutType* createOptLut(ConstLut3DOpDataRcPtr & lut);
+    template<typename LutType>
+    void fillOptLut(const Array::Values& lut, LutType* optLut) const;
+    void freeOptLuts();
 
 protected:
     // Keep all these values because they are invariant during the
     // processing. So to slim the processing code, these variables
     // are computed in the constructor.
     float*        m_optLut;
+    half*         m_optLutHalf; // Used instead of m_optLut when not null.
     unsigned long m_dim;
     float         m_step;
+    Lut3DLayout   m_layout;
+
+    // The shared memory holding the optimized LUT, if any.
+    ConstSharedLutPayloadRcPtr m_sharedOptLut;
+    // Size of the private optimized LUT (refer to AllocateRendererTable()).
+    size_t m_optLutNumBytes = 0;
 
 private:
     BaseLut3DRenderer() = delete;
@@ -66,6 +126,17 @@ public:
 
 };
 
+// Use the nearest LUT entry i.e. only for the draft interpolation quality (refer to
+// LUT_INTERPOLATION_DRAFT).
+class Lut3DNearestRenderer : public BaseLut3DRenderer
+{
+public:
+    explicit Lut3DNearestRenderer(ConstLut3DOpDataRcPtr & lut);
+    virtual ~Lut3DNearestRenderer();
+
+    void apply(const void * inImg, void * outImg, long numPixels) const;
+};
+
 class InvLut3DRenderer : public OpCPU
 {
     typedef std::vector<unsigned long> ulongVector;
@@ -133,6 +204,9 @@ class InvLut3DRenderer : public OpCPU
         // Get the offsets to the base of the vectors.
         inline const BaseIndsVec& getBaseInds() const { return m_baseInds; }
 
+        // Get the number of bytes of the tree structures.
+        size_t getMemorySize() const;
+
         // Debugging method to print tree properties.
         // void print() const;
 
@@ -165,6 +239,8 @@ public:
 
     virtual void apply(const void * inImg, void * outImg, long numPixels) const;
 
+    size_t getMemorySize() const override;
+
     virtual void updateData(ConstLut3DOpDataRcPtr & lut);
 
     // Extrapolate the 3d-LUT to handle values outside the LUT gamut
@@ -176,7 +252,8 @@ protected:
     long               m_dim;          // grid size of the extrapolated 3d-LUT
     RangeTree          m_tree;         // object to allow fast range queries of
                                        // the LUT
-    std::vector<float> m_grvec;        // extrapolated 3d-LUT values
+    // Extrapolated 3d-LUT values.
+    std::vector<float, RendererTableAllocator<float>> m_grvec;
 
 private:
     InvLut3DRenderer() = delete;
@@ -185,91 +262,73 @@ private:
 };
 
 
-int GetLut3DIndexBlueFast(int indexR, int indexG, int indexB, long dim)
+#ifdef USE_SSE
+inline __m128 LoadLut3DEntry(const float * entry)
 {
-    return 3 * (indexB + (int)dim * (indexG + (int)dim * indexR));
+    return _mm_load_ps(entry);
 }
 
-#ifdef USE_SSE
-//----------------------------------------------------------------------------
-// RGB channel ordering.
-// Pixels ordered in such a way that the blue coordinate changes fastest,
-// then the green coordinate, and finally, the red coordinate changes slowest
-//
-inline __m128i GetLut3DIndices(const __m128i &idxR,
-                               const __m128i &idxG,
-                               const __m128i &idxB,
-                               const __m128i /*&sizesR*/,
-                               const __m128i &sizesG,
-                               const __m128i &sizesB)
-{
-    // SSE2 doesn't have 4-way multiplication for integer registers, so we need
-    // split them into two register and multiply-add them separately, and then
-    // combine the results.
-
-    // r02 = { sizesG * idxR0, -, sizesG * idxR2, - }
-    // r13 = { sizesG * idxR1, -, sizesG * idxR3, - }
-    __m128i r02 = _mm_mul_epu32(sizesG, idxR);
-    __m128i r13 = _mm_mul_epu32(sizesG, _mm_srli_si128(idxR,4));
-
-    // r02 = { idxG0 + sizesG * idxR0, -, idxG2 + sizesG * idxR2, - }
-    // r13 = { idxG1 + sizesG * idxR1, -, idxG3 + sizesG * idxR3, - }
-    r02 = _mm_add_epi32(idxG, r02);
-    r13 = _mm_add_epi32(_mm_srli_si128(idxG,4), r13);
-
-    // r02 = { sizesB * (idxG0 + sizesG * idxR0), -, sizesB * (idxG2 + sizesG * idxR2), - }
-    // r13 = { sizesB * (idxG1 + sizesG * idxR1), -, sizesB * (idxG3 + sizesG * idxR3), - }
-    r02 = _mm_mul_epu32(sizesB, r02);
-    r13 = _mm_mul_epu32(sizesB, r13);
-
-    // r02 = { idxB0 + sizesB * (idxG0 + sizesG * idxR0), -, idxB2 + sizesB * (idxG2 + sizesG * idxR2), - }
-    // r13 = { idxB1 + sizesB * (idxG1 + sizesG * idxR1), -, idxB3 + sizesB * (idxG3 + sizesG * idxR3), - }
-    r02 = _mm_add_epi32(idxB, r02);
-    r13 = _mm_add_epi32(_mm_srli_si128(idxB,4), r13);
-
-    // r = { idxB0 + sizesB * (idxG0 + sizesG * idxR0),
-    //       idxB1 + sizesB * (idxG1 + sizesG * idxR1),
-    //       idxB2 + sizesB * (idxG2 + sizesG * idxR2),
-    //       idxB3 + sizesB * (idxG3 + sizesG * idxR3) }
-    __m128i r = _mm_unpacklo_epi32(_mm_shuffle_epi32(r02, _MM_SHUFFLE(0,0,2,0)),
-                                   _mm_shuffle_epi32(r13, _MM_SHUFFLE(0,0,2,0)));
-
-    // return { 4 * (idxB0 + sizesB * (idxG0 + sizesG * idxR0)),
-    //          4 * (idxB1 + sizesB * (idxG1 + sizesG * idxR1)),
-    //          4 * (idxB2 + sizesB * (idxG2 + sizesG * idxR2)),
-    //          4 * (idxB3 + sizesB * (idxG3 + sizesG * idxR3)) }
-    return _mm_slli_epi32(r, 2);
-}
-
-inline void LookupNearest4(float* optLut,
-                           const __m128i &rIndices,
-                           const __m128i &gIndices,
-                           const __m128i &bIndices,
-                           const __m128i &dim,
-                           __m128 res[4])
+// Convert the padded RGBA half float entry. Note that the conversion is exact and
+// does not need the F16C instructions as the LUT values are finite.
+inline __m128 LoadLut3DEntry(const half * entry)
 {
-    __m128i offsets = GetLut3DIndices(rIndices, gIndices, bIndices, dim, dim, dim);
+    const __m128i h = _mm_unpacklo_epi16(_mm_loadl_epi64((const __m128i *)entry),
+                                         _mm_setzero_si128());
+
+    const __m128i sign = _mm_slli_epi32(_mm_and_si128(h, _mm_set1_epi32(0x8000)), 16);
+    const __m128i expMant = _mm_slli_epi32(_mm_and_si128(h, _mm_set1_epi32(0x7fff)), 13);
+
+    // Rebias the exponent (i.e. multiply by 2^112) which also handles the denormals.
+    const __m128 value = _mm_mul_ps(_mm_castsi128_ps(expMant),
+                                    _mm_castsi128_ps(_mm_set1_epi32(0x77800000)));
 
-    int* offsetInt = (int*)&offsets;
+    return _mm_or_ps(value, _mm_castsi128_ps(sign));
+}
+
+// Get the offsets of the entries { idx0, idx1, idx2 } along the R, G & B axes.
+inline __m128i GetLut3DAxisOffsets(const Lut3DLayout & layout, const __m128i & indices)
+{
+    OCIO_ALIGN(int idx[4]);
+    _mm_store_si128((__m128i *)idx, indices);
+
+    return _mm_set_epi32(0,
+                         layout.offsets[2][idx[2]],
+                         layout.offsets[1][idx[1]],
+                         layout.offsets[0][idx[0]]);
+}
 
-    res[0] = _mm_load_ps(optLut + offsetInt[0]);
-    res[1] = _mm_load_ps(optLut + offsetInt[1]);
-    res[2] = _mm_load_ps(optLut + offsetInt[2]);
-    res[3] = _mm_load_ps(optLut + offsetInt[3]);
+// The vertices are given by their offsets along each axis.
+template<typename LutType>
+inline void LookupNearest4(const LutType * optLut,
+                           const __m128i &rOffsets,
+                           const __m128i &gOffsets,
+                           const __m128i &bOffsets,
+                           __m128 res[4])
+{
+    OCIO_ALIGN(int offsets[4]);
+    _mm_store_si128((__m128i *)offsets,
+                    _mm_add_epi32(_mm_add_epi32(rOffsets, gOffsets), bOffsets));
+
+    res[0] = LoadLut3DEntry(optLut + offsets[0]);
+    res[1] = LoadLut3DEntry(optLut + offsets[1]);
+    res[2] = LoadLut3DEntry(optLut + offsets[2]);
+    res[3] = LoadLut3DEntry(optLut + offsets[3]);
 }
 #else
 
 // Linear
-inline void lerp_rgb(float* out, float* a, float* b, float* z)
+template<typename LutType>
+inline void lerp_rgb(float* out, const LutType* a, const LutType* b, const float* z)
 {
-    out[0] = (b[0] - a[0]) * z[0] + a[0];
-    out[1] = (b[1] - a[1]) * z[1] + a[1];
-    out[2] = (b[2] - a[2]) * z[2] + a[2];
+    out[0] = ((float)b[0] - (float)a[0]) * z[0] + (float)a[0];
+    out[1] = ((float)b[1] - (float)a[1]) * z[1] + (float)a[1];
+    out[2] = ((float)b[2] - (float)a[2]) * z[2] + (float)a[2];
 }
 
 // Bilinear
-inline void lerp_rgb(float* out, float* a, float* b, float* c,
-                     float* d, float* y, float* z)
+template<typename LutType>
+inline void lerp_rgb(float* out, const LutType* a, const LutType* b, const LutType* c,
+                     const LutType* d, const float* y, const float* z)
 {
     float v1[3];
     float v2[3];
@@ -280,9 +339,11 @@ inline void lerp_rgb(float* out, float* a, float* b, float* c,
 }
 
 // Trilinear
-inline void lerp_rgb(float* out, float* a, float* b, float* c, float* d,
-                     float* e, float* f, float* g, float* h,
-                     float* x, float* y, float* z)
+template<typename LutType>
+inline void lerp_rgb(float* out, const LutType* a, const LutType* b, const LutType* c,
+                     const LutType* d, const LutType* e, const LutType* f,
+                     const LutType* g, const LutType* h,
+                     const float* x, const float* y, const float* z)
 {
     float v1[3];
     float v2[3];
@@ -296,6 +357,7 @@ inline void lerp_rgb(float* out, float* a, float* b, float* c, float* d,
 BaseLut3DRenderer::BaseLut3DRenderer(ConstLut3DOpDataRcPtr & lut)
     : OpCPU()
     , m_optLut(0x0)
+    , m_optLutHalf(0x0)
     , m_dim(0)
     , m_step(0.0f)
 {
@@ -304,11 +366,45 @@ BaseLut3DRenderer::BaseLut3DRenderer(ConstLut3DOpDataRcPtr & lut)
 
 BaseLut3DRenderer::~BaseLut3DRenderer()
 {
-#ifdef USE_SSE
-    Platform::AlignedFree(m_optLut);
-#else
-    free(m_optLut);
-#endif
+    freeOptLuts();
+}
+
+size_t BaseLut3DRenderer::getMemorySize() const
+{
+    size_t numBytes = 0;
+    for(const auto & offsets : m_layout.offsets)
+    {
+        numBytes += offsets.capacity() * sizeof(int);
+    }
+
+    const size_t numValues = m_layout.numEntries * LUT3D_ENTRY_SIZE;
+    if (m_optLutHalf)
+    {
+        numBytes += numValues * sizeof(half);
+    }
+    else if (m_optLut)
+    {
+        numBytes += numValues * sizeof(float);
+    }
+
+    return numBytes;
+}
+
+void BaseLut3DRenderer::freeOptLuts()
+{
+    if (m_sharedOptLut)
+    {
+        m_sharedOptLut.reset();
+        m_optLut = 0x0;
+        m_optLutHalf = 0x0;
+        return;
+    }
+
+    FreeRendererTable(m_optLut, m_optLutNumBytes);
+    FreeRendererTable(m_optLutHalf, m_optLutNumBytes);
+    m_optLut = 0x0;
+    m_optLutHalf = 0x0;
+    m_optLutNumBytes = 0;
 }
 
 void BaseLut3DRenderer::updateData(ConstLut3DOpDataRcPtr & lut)
@@ -317,76 +413,142 @@ void BaseLut3DRenderer::updateData(ConstLut3DOpDataRcPtr & lut)
 
     m_step = ((float)m_dim - 1.0f);
 
-#ifdef USE_SSE
-    Platform::AlignedFree(m_optLut);
-#else
-    free(m_optLut);
-#endif
-    m_optLut = createOptLut(lut->getArray().getValues());
+    updateLayout();
+
+    freeOptLuts();
+    if (lut->isHalfStorage())
+    {
+        m_optLutHalf = createOptLut<half>(lut);
+    }
+    else
+    {
+        m_optLut = createOptLut<float>(lut);
+    }
 }
 
-#ifdef USE_SSE
-// Creates a LUT aligned to a 16 byte boundary with RGB and 0 for alpha
-// in order to be able to load the LUT using _mm_load_ps.
-float* BaseLut3DRenderer::createOptLut(const Array::Values& lut) const
+void BaseLut3DRenderer::updateLayout()
 {
-    const long maxEntries = m_dim * m_dim * m_dim;
+    const int dim = (int)m_dim;
+
+    if (m_dim >= LUT3D_BLOCKED_LAYOUT_MIN_SIZE)
+    {
+        // The bricks, and the entries of a brick, are in blue-fastest order.
+        const int numBricks = (dim + 3) / 4;
+        const int brickSize = 64 * LUT3D_ENTRY_SIZE;
+
+        m_layout.entryStrides[0] = 16 * LUT3D_ENTRY_SIZE;
+        m_layout.entryStrides[1] = 4 * LUT3D_ENTRY_SIZE;
+        m_layout.entryStrides[2] = LUT3D_ENTRY_SIZE;
 
-    float *optLut =
-        (float*)Platform::AlignedMalloc(maxEntries * 4 * sizeof(float), 16);
+        m_layout.brickStrides[0] = numBricks * numBricks * brickSize;
+        m_layout.brickStrides[1] = numBricks * brickSize;
+        m_layout.brickStrides[2] = brickSize;
 
-    float* currentValue = optLut;
-    for (long idx = 0; idx<maxEntries; idx++)
+        m_layout.numEntries = 64 * (long)numBricks * numBricks * numBricks;
+    }
+    else
     {
-        currentValue[0] = SanitizeFloat(lut[idx * 3]);
-        currentValue[1] = SanitizeFloat(lut[idx * 3 + 1]);
-        currentValue[2] = SanitizeFloat(lut[idx * 3 + 2]);
-        currentValue[3] = 0.0f;
-        currentValue += 4;
+        m_layout.entryStrides[0] = dim * dim * LUT3D_ENTRY_SIZE;
+        m_layout.entryStrides[1] = dim * LUT3D_ENTRY_SIZE;
+        m_layout.entryStrides[2] = LUT3D_ENTRY_SIZE;
+
+        for (int c = 0; c < 3; ++c)
+        {
+            m_layout.brickStrides[c] = 4 * m_layout.entryStrides[c];
+        }
+
+        m_layout.numEntries = (long)dim * dim * dim;
     }
 
-    return optLut;
+    for (int c = 0; c < 3; ++c)
+    {
+        m_layout.offsets[c].resize(dim);
+        for (int idx = 0; idx < dim; ++idx)
+        {
+            m_layout.offsets[c][idx] = (idx / 4) * m_layout.brickStrides[c]
+                                     + (idx % 4) * m_layout.entryStrides[c];
+        }
+    }
 }
-#else
-float* BaseLut3DRenderer::createOptLut(const Array::Values& lut) const
+
+inline void SetLut3DValue(float & value, float lutValue)
 {
-    const long maxEntries = m_dim * m_dim * m_dim;
+    value = SanitizeFloat(lutValue);
+}
 
-    float *optLut =
-        (float*)malloc(maxEntries * 3 * sizeof(float));
+// The half float values are clamped to stay finite.
+inline void SetLut3DValue(half & value, float lutValue)
+{
+    value = half(Clamp(SanitizeFloat(lutValue), -HALF_MAX, HALF_MAX));
+}
 
-    float* currentValue = optLut;
-    for (long idx = 0; idx<maxEntries; idx++)
+// Creates a LUT aligned to a cache line (i.e. also a 16 byte boundary) with RGB and 0 for
+// alpha in order to be able to load the LUT using _mm_load_ps.
+template<typename LutType>
+LutType* BaseLut3DRenderer::createOptLut(ConstLut3DOpDataRcPtr & lut)
+{
+    const size_t numValues = m_layout.numEntries * LUT3D_ENTRY_SIZE;
+    const Array::Values & values = lut->getArray().getValues();
+
+    // The same LUT values always give the same optimized LUT (i.e. the shared memory is
+    // page aligned).
+    std::ostringstream key;
+    key << "Lut3D " << lut->getArray().getValuesHash() << " " << m_dim
+        << " " << m_layout.numEntries << " " << sizeof(LutType);
+
+    m_sharedOptLut = AcquireSharedLutPayload(key.str(), numValues * sizeof(LutType),
+                                             [this, &values](void * data)
+                                             {
+                                                 fillOptLut(values, (LutType*)data);
+                                             });
+    if (m_sharedOptLut)
     {
-        currentValue[0] = SanitizeFloat(lut[idx * 3]);
-        currentValue[1] = SanitizeFloat(lut[idx * 3 + 1]);
-        currentValue[2] = SanitizeFloat(lut[idx * 3 + 2]);
-        currentValue += 3;
+        return (LutType*)m_sharedOptLut->data();
     }
 
+    m_optLutNumBytes = numValues * sizeof(LutType);
+    LutType *optLut = (LutType*)AllocateRendererTable(m_optLutNumBytes);
+
+    fillOptLut(values, optLut);
+
     return optLut;
 }
-#endif
 
-Lut3DTetrahedralRenderer::Lut3DTetrahedralRenderer(ConstLut3DOpDataRcPtr & lut)
-    : BaseLut3DRenderer(lut)
+template<typename LutType>
+void BaseLut3DRenderer::fillOptLut(const Array::Values& lut, LutType* optLut) const
 {
-}
+    const size_t numValues = m_layout.numEntries * LUT3D_ENTRY_SIZE;
 
-Lut3DTetrahedralRenderer::~Lut3DTetrahedralRenderer()
-{
+    // Zero the alpha values and the padding entries.
+    std::fill(optLut, optLut + numValues, LutType(0.0f));
+
+    const int dim = (int)m_dim;
+    long idx = 0;
+    for (int r = 0; r < dim; ++r)
+    {
+        for (int g = 0; g < dim; ++g)
+        {
+            for (int b = 0; b < dim; ++b)
+            {
+                LutType* currentValue = optLut + m_layout.getOffset(r, g, b);
+                SetLut3DValue(currentValue[0], lut[idx * 3]);
+                SetLut3DValue(currentValue[1], lut[idx * 3 + 1]);
+                SetLut3DValue(currentValue[2], lut[idx * 3 + 2]);
+                ++idx;
+            }
+        }
+    }
 }
 
-void Lut3DTetrahedralRenderer::apply(const void * inImg, void * outImg, long numPixels) const
+template<typename LutType>
+void ApplyLut3DTetrahedral(const LutType * optLut, const Lut3DLayout & layout,
+                           unsigned long lutDim, float lutStep,
+                           const float * in, float * out, long numPixels)
 {
-    const float * in = (const float *)inImg;
-    float * out = (float *)outImg;
-
 #ifdef USE_SSE
 
-    __m128 step = _mm_set1_ps(m_step);
-    __m128 maxIdx = _mm_set1_ps((float)(m_dim - 1));
-    __m128i dim = _mm_set1_epi32(m_dim);
+    __m128 step = _mm_set1_ps(lutStep);
+    __m128 maxIdx = _mm_set1_ps((float)(lutDim - 1));
 
     __m128 v[4];
     OCIO_ALIGN(float cmpDelta[4]);
@@ -415,10 +577,15 @@ void Lut3DTetrahedralRenderer::apply(const void * inImg, void * outImg, long num
         __m128 delta1 = _mm_shuffle_ps(delta, delta, _MM_SHUFFLE(1, 1, 1, 1));
         __m128 delta2 = _mm_shuffle_ps(delta, delta, _MM_SHUFFLE(2, 2, 2, 2));
 
+        // Use the offsets of the entries along each axis instead of the indices
+        // (refer to Lut3DLayout).
+        const __m128i lowOffsets = GetLut3DAxisOffsets(layout, lowIdxInt32);
+        const __m128i highOffsets = GetLut3DAxisOffsets(layout, highIdxInt32);
+
         // lh01 = {L0, H0, L1, H1}
         // lh23 = {L2, H2, L3, H3}, L3 and H3 are not used
-        __m128i lh01 = _mm_unpacklo_epi32(lowIdxInt32, highIdxInt32);
-        __m128i lh23 = _mm_unpackhi_epi32(lowIdxInt32, highIdxInt32);
+        __m128i lh01 = _mm_unpacklo_epi32(lowOffsets, highOffsets);
+        __m128i lh23 = _mm_unpackhi_epi32(lowOffsets, highOffsets);
 
         // Since the cube is split along the main diagonal, the lowest corner
         // and highest corner are always used.
@@ -462,7 +629,7 @@ void Lut3DTetrahedralRenderer::apply(const void * inImg, void * outImg, long num
                 idxG = _mm_shuffle_epi32(lh01, _MM_SHUFFLE(3, 3, 2, 2));
                 idxB = _mm_shuffle_epi32(lh23, _MM_SHUFFLE(1, 0, 0, 0));
 
-                LookupNearest4(m_optLut, idxR, idxG, idxB, dim, v);
+                LookupNearest4(optLut, idxR, idxG, idxB, v);
 
                 // Order: R G B => 0 1 2
                 dv0 = _mm_sub_ps(v[1], v[0]);
@@ -483,7 +650,7 @@ void Lut3DTetrahedralRenderer::apply(const void * inImg, void * outImg, long num
                 idxG = _mm_shuffle_epi32(lh01, _MM_SHUFFLE(3, 2, 2, 2));
                 idxB = _mm_shuffle_epi32(lh23, _MM_SHUFFLE(1, 1, 0, 0));
 
-                LookupNearest4(m_optLut, idxR, idxG, idxB, dim, v);
+                LookupNearest4(optLut, idxR, idxG, idxB, v);
 
                 // Order: R B G => 0 2 1
                 dv0 = _mm_sub_ps(v[1], v[0]);
@@ -504,7 +671,7 @@ void Lut3DTetrahedralRenderer::apply(const void * inImg, void * outImg, long num
                 idxG = _mm_shuffle_epi32(lh01, _MM_SHUFFLE(3, 2, 2, 2));
                 idxB = _mm_shuffle_epi32(lh23, _MM_SHUFFLE(1, 1, 1, 0));
 
-                LookupNearest4(m_optLut, idxR, idxG, idxB, dim, v);
+                LookupNearest4(optLut, idxR, idxG, idxB, v);
 
                 // Order: B R G => 2 0 1
                 dv2 = _mm_sub_ps(v[1], v[0]);
@@ -528,7 +695,7 @@ void Lut3DTetrahedralRenderer::apply(const void * inImg, void * outImg, long num
                 idxG = _mm_shuffle_epi32(lh01, _MM_SHUFFLE(3, 3, 2, 2));
                 idxB = _mm_shuffle_epi32(lh23, _MM_SHUFFLE(1, 1, 1, 0));
 
-                LookupNearest4(m_optLut, idxR, idxG, idxB, dim, v);
+                LookupNearest4(optLut, idxR, idxG, idxB, v);
 
                 // Order: B G R => 2 1 0
                 dv2 = _mm_sub_ps(v[1], v[0]);
@@ -549,7 +716,7 @@ void Lut3DTetrahedralRenderer::apply(const void * inImg, void * outImg, long num
                 idxG = _mm_shuffle_epi32(lh01, _MM_SHUFFLE(3, 3, 3, 2));
                 idxB = _mm_shuffle_epi32(lh23, _MM_SHUFFLE(1, 0, 0, 0));
 
-                LookupNearest4(m_optLut, idxR, idxG, idxB, dim, v);
+                LookupNearest4(optLut, idxR, idxG, idxB, v);
 
                 // Order: G R B => 1 0 2
                 dv1 = _mm_sub_ps(v[1], v[0]);
@@ -570,7 +737,7 @@ void Lut3DTetrahedralRenderer::apply(const void * inImg, void * outImg, long num
                 idxG = _mm_shuffle_epi32(lh01, _MM_SHUFFLE(3, 3, 3, 2));
                 idxB = _mm_shuffle_epi32(lh23, _MM_SHUFFLE(1, 1, 0, 0));
 
-                LookupNearest4(m_optLut, idxR, idxG, idxB, dim, v);
+                LookupNearest4(optLut, idxR, idxG, idxB, v);
 
                 // Order: G B R => 1 2 0
                 dv1 = _mm_sub_ps(v[1], v[0]);
@@ -590,16 +757,16 @@ void Lut3DTetrahedralRenderer::apply(const void * inImg, void * outImg, long num
         out += 4;
     }
 #else
-    const float dimMinusOne = float(m_dim) - 1.f;
+    const float dimMinusOne = float(lutDim) - 1.f;
 
     for (long i = 0; i < numPixels; ++i)
     {
         float newAlpha = (float)in[3];
 
         float idx[3];
-        idx[0] = in[0] * m_step;
-        idx[1] = in[1] * m_step;
-        idx[2] = in[2] * m_step;
+        idx[0] = in[0] * lutStep;
+        idx[1] = in[1] * lutStep;
+        idx[2] = in[2] * lutStep;
 
         // NaNs become 0.
         idx[0] = Clamp(idx[0], 0.f, dimMinusOne);
@@ -626,89 +793,81 @@ void Lut3DTetrahedralRenderer::apply(const void * inImg, void * outImg, long num
 
         // Compute index into LUT for surrounding corners
         const int n000 =
-            GetLut3DIndexBlueFast(indexLow[0], indexLow[1], indexLow[2],
-                                  m_dim);
+            layout.getOffset(indexLow[0], indexLow[1], indexLow[2]);
         const int n100 =
-            GetLut3DIndexBlueFast(indexHigh[0], indexLow[1], indexLow[2],
-                                  m_dim);
+            layout.getOffset(indexHigh[0], indexLow[1], indexLow[2]);
         const int n010 =
-            GetLut3DIndexBlueFast(indexLow[0], indexHigh[1], indexLow[2],
-                                  m_dim);
+            layout.getOffset(indexLow[0], indexHigh[1], indexLow[2]);
         const int n001 =
-            GetLut3DIndexBlueFast(indexLow[0], indexLow[1], indexHigh[2],
-                                  m_dim);
+            layout.getOffset(indexLow[0], indexLow[1], indexHigh[2]);
         const int n110 =
-            GetLut3DIndexBlueFast(indexHigh[0], indexHigh[1], indexLow[2],
-                                  m_dim);
+            layout.getOffset(indexHigh[0], indexHigh[1], indexLow[2]);
         const int n101 =
-            GetLut3DIndexBlueFast(indexHigh[0], indexLow[1], indexHigh[2],
-                                  m_dim);
+            layout.getOffset(indexHigh[0], indexLow[1], indexHigh[2]);
         const int n011 =
-            GetLut3DIndexBlueFast(indexLow[0], indexHigh[1], indexHigh[2],
-                                  m_dim);
+            layout.getOffset(indexLow[0], indexHigh[1], indexHigh[2]);
         const int n111 =
-            GetLut3DIndexBlueFast(indexHigh[0], indexHigh[1], indexHigh[2],
-                                  m_dim);
+            layout.getOffset(indexHigh[0], indexHigh[1], indexHigh[2]);
 
         if (fx > fy) {
             if (fy > fz) {
                 out[0] =
-                    (1 - fx)  * m_optLut[n000] +
-                    (fx - fy) * m_optLut[n100] +
-                    (fy - fz) * m_optLut[n110] +
-                    (fz)      * m_optLut[n111];
+                    (1 - fx)  * optLut[n000] +
+                    (fx - fy) * optLut[n100] +
+                    (fy - fz) * optLut[n110] +
+                    (fz)      * optLut[n111];
 
                 out[1] =
-                    (1 - fx)  * m_optLut[n000 + 1] +
-                    (fx - fy) * m_optLut[n100 + 1] +
-                    (fy - fz) * m_optLut[n110 + 1] +
-                    (fz)      * m_optLut[n111 + 1];
+                    (1 - fx)  * optLut[n000 + 1] +
+                    (fx - fy) * optLut[n100 + 1] +
+                    (fy - fz) * optLut[n110 + 1] +
+                    (fz)      * optLut[n111 + 1];
 
                 out[2] =
-                    (1 - fx)  * m_optLut[n000 + 2] +
-                    (fx - fy) * m_optLut[n100 + 2] +
-                    (fy - fz) * m_optLut[n110 + 2] +
-                    (fz)      * m_optLut[n111 + 2];
+                    (1 - fx)  * optLut[n000 + 2] +
+                    (fx - fy) * optLut[n100 + 2] +
+                    (fy - fz) * optLut[n110 + 2] +
+                    (fz)      * optLut[n111 + 2];
             }
             else if (fx > fz)
             {
                 out[0] =
-                    (1 - fx)  * m_optLut[n000] +
-                    (fx - fz) * m_optLut[n100] +
-                    (fz - fy) * m_optLut[n101] +
-                    (fy)      * m_optLut[n111];
+                    (1 - fx)  * optLut[n000] +
+                    (fx - fz) * optLut[n100] +
+                    (fz - fy) * optLut[n101] +
+                    (fy)      * optLut[n111];
 
                 out[1] =
-                    (1 - fx)  * m_optLut[n000 + 1] +
-                    (fx - fz) * m_optLut[n100 + 1] +
-                    (fz - fy) * m_optLut[n101 + 1] +
-                    (fy)      * m_optLut[n111 + 1];
+                    (1 - fx)  * optLut[n000 + 1] +
+                    (fx - fz) * optLut[n100 + 1] +
+                    (fz - fy) * optLut[n101 + 1] +
+                    (fy)      * optLut[n111 + 1];
 
                 out[2] =
-                    (1 - fx)  * m_optLut[n000 + 2] +
-                    (fx - fz) * m_optLut[n100 + 2] +
-                    (fz - fy) * m_optLut[n101 + 2] +
-                    (fy)      * m_optLut[n111 + 2];
+                    (1 - fx)  * optLut[n000 + 2] +
+                    (fx - fz) * optLut[n100 + 2] +
+                    (fz - fy) * optLut[n101 + 2] +
+                    (fy)      * optLut[n111 + 2];
             }
             else
             {
                 out[0] =
-                    (1 - fz)  * m_optLut[n000] +
-                    (fz - fx) * m_optLut[n001] +
-                    (fx - fy) * m_optLut[n101] +
-                    (fy)      * m_optLut[n111];
+                    (1 - fz)  * optLut[n000] +
+                    (fz - fx) * optLut[n001] +
+                    (fx - fy) * optLut[n101] +
+                    (fy)      * optLut[n111];
 
                 out[1] =
-                    (1 - fz)  * m_optLut[n000 + 1] +
-                    (fz - fx) * m_optLut[n001 + 1] +
-                    (fx - fy) * m_optLut[n101 + 1] +
-                    (fy)      * m_optLut[n111 + 1];
+                    (1 - fz)  * optLut[n000 + 1] +
+                    (fz - fx) * optLut[n001 + 1] +
+                    (fx - fy) * optLut[n101 + 1] +
+                    (fy)      * optLut[n111 + 1];
 
                 out[2] =
-                    (1 - fz)  * m_optLut[n000 + 2] +
-                    (fz - fx) * m_optLut[n001 + 2] +
-                    (fx - fy) * m_optLut[n101 + 2] +
-                    (fy)      * m_optLut[n111 + 2];
+                    (1 - fz)  * optLut[n000 + 2] +
+                    (fz - fx) * optLut[n001 + 2] +
+                    (fx - fy) * optLut[n101 + 2] +
+                    (fy)      * optLut[n111 + 2];
             }
         }
         else
@@ -716,62 +875,62 @@ void Lut3DTetrahedralRenderer::apply(const void * inImg, void * outImg, long num
             if (fz > fy)
             {
                 out[0] =
-                    (1 - fz)  * m_optLut[n000] +
-                    (fz - fy) * m_optLut[n001] +
-                    (fy - fx) * m_optLut[n011] +
-                    (fx)      * m_optLut[n111];
+                    (1 - fz)  * optLut[n000] +
+                    (fz - fy) * optLut[n001] +
+                    (fy - fx) * optLut[n011] +
+                    (fx)      * optLut[n111];
 
                 out[1] =
-                    (1 - fz)  * m_optLut[n000 + 1] +
-                    (fz - fy) * m_optLut[n001 + 1] +
-                    (fy - fx) * m_optLut[n011 + 1] +
-                    (fx)      * m_optLut[n111 + 1];
+                    (1 - fz)  * optLut[n000 + 1] +
+                    (fz - fy) * optLut[n001 + 1] +
+                    (fy - fx) * optLut[n011 + 1] +
+                    (fx)      * optLut[n111 + 1];
 
                 out[2] =
-                    (1 - fz)  * m_optLut[n000 + 2] +
-                    (fz - fy) * m_optLut[n001 + 2] +
-                    (fy - fx) * m_optLut[n011 + 2] +
-                    (fx)      * m_optLut[n111 + 2];
+                    (1 - fz)  * optLut[n000 + 2] +
+                    (fz - fy) * optLut[n001 + 2] +
+                    (fy - fx) * optLut[n011 + 2] +
+                    (fx)      * optLut[n111 + 2];
             }
             else if (fz > fx)
             {
                 out[0] =
-                    (1 - fy)  * m_optLut[n000] +
-                    (fy - fz) * m_optLut[n010] +
-                    (fz - fx) * m_optLut[n011] +
-                    (fx)      * m_optLut[n111];
+                    (1 - fy)  * optLut[n000] +
+                    (fy - fz) * optLut[n010] +
+                    (fz - fx) * optLut[n011] +
+                    (fx)      * optLut[n111];
 
                 out[1] =
-                    (1 - fy)  * m_optLut[n000 + 1] +
-                    (fy - fz) * m_optLut[n010 + 1] +
-                    (fz - fx) * m_optLut[n011 + 1] +
-                    (fx)      * m_optLut[n111 + 1];
+                    (1 - fy)  * optLut[n000 + 1] +
+                    (fy - fz) * optLut[n010 + 1] +
+                    (fz - fx) * optLut[n011 + 1] +
+                    (fx)      * optLut[n111 + 1];
 
                 out[2] =
-                    (1 - fy)  * m_optLut[n000 + 2] +
-                    (fy - fz) * m_optLut[n010 + 2] +
-                    (fz - fx) * m_optLut[n011 + 2] +
-                    (fx)      * m_optLut[n111 + 2];
+                    (1 - fy)  * optLut[n000 + 2] +
+                    (fy - fz) * optLut[n010 + 2] +
+                    (fz - fx) * optLut[n011 + 2] +
+                    (fx)      * optLut[n111 + 2];
             }
             else
             {
                 out[0] =
-                    (1 - fy)  * m_optLut[n000] +
-                    (fy - fx) * m_optLut[n010] +
-                    (fx - fz) * m_optLut[n110] +
-                    (fz)      * m_optLut[n111];
+                    (1 - fy)  * optLut[n000] +
+                    (fy - fx) * optLut[n010] +
+                    (fx - fz) * optLut[n110] +
+                    (fz)      * optLut[n111];
 
                 out[1] =
-                    (1 - fy)  * m_optLut[n000 + 1] +
-                    (fy - fx) * m_optLut[n010 + 1] +
-                    (fx - fz) * m_optLut[n110 + 1] +
-                    (fz)      * m_optLut[n111 + 1];
+                    (1 - fy)  * optLut[n000 + 1] +
+                    (fy - fx) * optLut[n010 + 1] +
+                    (fx - fz) * optLut[n110 + 1] +
+                    (fz)      * optLut[n111 + 1];
 
                 out[2] =
-                    (1 - fy)  * m_optLut[n000 + 2] +
-                    (fy - fx) * m_optLut[n010 + 2] +
-                    (fx - fz) * m_optLut[n110 + 2] +
-                    (fz)      * m_optLut[n111 + 2];
+                    (1 - fy)  * optLut[n000 + 2] +
+                    (fy - fx) * optLut[n010 + 2] +
+                    (fx - fz) * optLut[n110 + 2] +
+                    (fz)      * optLut[n111 + 2];
             }
         }
 
@@ -783,25 +942,212 @@ void Lut3DTetrahedralRenderer::apply(const void * inImg, void * outImg, long num
 #endif
 }
 
-Lut3DRenderer::Lut3DRenderer(ConstLut3DOpDataRcPtr & lut)
+
+Lut3DTetrahedralRenderer::Lut3DTetrahedralRenderer(ConstLut3DOpDataRcPtr & lut)
     : BaseLut3DRenderer(lut)
 {
 }
 
-Lut3DRenderer::~Lut3DRenderer()
+Lut3DTetrahedralRenderer::~Lut3DTetrahedralRenderer()
 {
 }
 
-void Lut3DRenderer::apply(const void * inImg, void * outImg, long numPixels) const
+void Lut3DTetrahedralRenderer::apply(const void * inImg, void * outImg, long numPixels) const
 {
-    const float * in = (const float *)inImg;
-    float * out = (float *)outImg;
+    if (m_optLutHalf)
+    {
+        ApplyLut3DTetrahedral(m_optLutHalf, m_layout, m_dim, m_step,
+                              (const float *)inImg, (float *)outImg, numPixels);
+    }
+    else
+    {
+        ApplyLut3DTetrahedral(m_optLut, m_layout, m_dim, m_step,
+                              (const float *)inImg, (float *)outImg, numPixels);
+    }
+}
+
+// Tetrahedral interpolation of 8-bit input pixels to 32-bit float pixels. The grid cell and
+// the fractional position of each input code are precomputed (per axis) so the processing
+// skips the conversion to float and the index computation. With a shaper (i.e. a renderer
+// from 8-bit to 32-bit float pixels applied before the 3D LUT, refer to
+// GetShaperLut3DRenderer()), the tables hold the grid coordinates of the shaped codes so the
+// shaper costs nothing. The results are the ones of the shaper (or of the conversion to
+// float) followed by the Lut3DTetrahedralRenderer.
+class Lut3DTetrahedralUInt8Renderer : public BaseLut3DRenderer
+{
+public:
+    Lut3DTetrahedralUInt8Renderer(ConstLut3DOpDataRcPtr & lut, const ConstOpCPURcPtr & shaper);
+    virtual ~Lut3DTetrahedralUInt8Renderer();
+
+    void apply(const void * inImg, void * outImg, long numPixels) const override;
+
+    size_t getMemorySize() const override;
+
+private:
+    static constexpr int NUM_CODES = 256;
+
+    // The offset of the low entry of the cell along each axis.
+    int   m_lowOffsets[3][NUM_CODES];
+    // The offset from the low to the high entry of the cell along each axis.
+    int   m_highSteps[3][NUM_CODES];
+    // The fractional position in the cell along each axis.
+    float m_deltas[3][NUM_CODES];
+    // The alpha values.
+    float m_alphas[NUM_CODES];
+};
+
+Lut3DTetrahedralUInt8Renderer::Lut3DTetrahedralUInt8Renderer(ConstLut3DOpDataRcPtr & lut,
+                                                             const ConstOpCPURcPtr & shaper)
+    : BaseLut3DRenderer(lut)
+{
+    // The input values of the 3D LUT for all the codes.
+    std::vector<float> values(4 * NUM_CODES);
+    if (shaper)
+    {
+        std::vector<uint8_t> codes(4 * NUM_CODES);
+        for (int code = 0; code < NUM_CODES; ++code)
+        {
+            std::fill(&codes[4 * code], &codes[4 * code] + 4, uint8_t(code));
+        }
+        shaper->apply(&codes[0], &values[0], NUM_CODES);
+    }
+    else
+    {
+        // Same computation as the conversion to float of the codes.
+        const float scale = 1.0f / float(BitDepthInfo<BIT_DEPTH_UINT8>::maxValue);
+        for (int code = 0; code < NUM_CODES; ++code)
+        {
+            std::fill(&values[4 * code], &values[4 * code] + 4, float(code) * scale);
+        }
+    }
+
+    // Same computation as the index computation of the Lut3DTetrahedralRenderer.
+    const int   maxIdx  = int(m_dim) - 1;
+    const float maxIdxF = float(maxIdx);
+
+    for (int code = 0; code < NUM_CODES; ++code)
+    {
+        for (int c = 0; c < 3; ++c)
+        {
+            float idx = values[4 * code + c] * m_step;
+            idx = idx > 0.0f ? idx : 0.0f; // NaNs become 0
+            idx = idx < maxIdxF ? idx : maxIdxF;
+
+            const int lowIdx  = int(idx);
+            const int highIdx = std::min(lowIdx + 1, maxIdx);
+
+            m_deltas[c][code]     = idx - float(lowIdx);
+            m_lowOffsets[c][code] = m_layout.offsets[c][lowIdx];
+            m_highSteps[c][code]  = m_layout.offsets[c][highIdx] - m_layout.offsets[c][lowIdx];
+        }
+
+        m_alphas[code] = values[4 * code + 3];
+    }
+}
+
+Lut3DTetrahedralUInt8Renderer::~Lut3DTetrahedralUInt8Renderer()
+{
+}
+
+size_t Lut3DTetrahedralUInt8Renderer::getMemorySize() const
+{
+    return BaseLut3DRenderer::getMemorySize()
+           + sizeof(m_lowOffsets) + sizeof(m_highSteps) + sizeof(m_deltas) + sizeof(m_alphas);
+}
+
+template<typename LutType>
+void ApplyLut3DTetrahedralUInt8(const LutType * optLut,
+                                const int (&lowOffsets)[3][256],
+                                const int (&highSteps)[3][256],
+                                const float (&deltas)[3][256],
+                                const float * alphas,
+                                const uint8_t * in, float * out, long numPixels)
+{
+    for (long i = 0; i < numPixels; ++i)
+    {
+        const float d[3] = { deltas[0][in[0]], deltas[1][in[1]], deltas[2][in[2]] };
+
+        const int steps[3] = { highSteps[0][in[0]], highSteps[1][in[1]], highSteps[2][in[2]] };
+
+        // Sort the axes by decreasing fractional position to select the tetrahedron, the
+        // ties being broken as in ApplyLut3DTetrahedral().
+        int a0, a1, a2;
+        if (d[0] >= d[1])
+        {
+            if (d[1] >= d[2])      { a0 = 0; a1 = 1; a2 = 2; }
+            else if (d[2] < d[0])  { a0 = 0; a1 = 2; a2 = 1; }
+            else                   { a0 = 2; a1 = 0; a2 = 1; }
+        }
+        else
+        {
+            if (d[1] < d[2])       { a0 = 2; a1 = 1; a2 = 0; }
+            else if (d[2] < d[0])  { a0 = 1; a1 = 0; a2 = 2; }
+            else                   { a0 = 1; a1 = 2; a2 = 0; }
+        }
+
+        // The vertices go from the lowest to the highest corner of the cell.
+        const int n0 = lowOffsets[0][in[0]] + lowOffsets[1][in[1]] + lowOffsets[2][in[2]];
+        const int n1 = n0 + steps[a0];
+        const int n2 = n1 + steps[a1];
+        const int n3 = n2 + steps[a2];
 
 #ifdef USE_SSE
+        const __m128 v0 = LoadLut3DEntry(optLut + n0);
+        const __m128 v1 = LoadLut3DEntry(optLut + n1);
+        const __m128 v2 = LoadLut3DEntry(optLut + n2);
+        const __m128 v3 = LoadLut3DEntry(optLut + n3);
+
+        __m128 dv[3];
+        dv[a0] = _mm_sub_ps(v1, v0);
+        dv[a1] = _mm_sub_ps(v2, v1);
+        dv[a2] = _mm_sub_ps(v3, v2);
 
-    __m128 step = _mm_set1_ps(m_step);
-    __m128 maxIdx = _mm_set1_ps((float)(m_dim - 1));
-    __m128i dim = _mm_set1_epi32(m_dim);
+        const __m128 result
+            = _mm_add_ps(_mm_add_ps(v0, _mm_mul_ps(_mm_set1_ps(d[0]), dv[0])),
+                         _mm_add_ps(_mm_mul_ps(_mm_set1_ps(d[1]), dv[1]),
+                                    _mm_mul_ps(_mm_set1_ps(d[2]), dv[2])));
+
+        _mm_storeu_ps(out, result);
+#else
+        for (int c = 0; c < 3; ++c)
+        {
+            out[c] = (1 - d[a0])     * (float)optLut[n0 + c] +
+                     (d[a0] - d[a1]) * (float)optLut[n1 + c] +
+                     (d[a1] - d[a2]) * (float)optLut[n2 + c] +
+                     (d[a2])         * (float)optLut[n3 + c];
+        }
+#endif
+
+        out[3] = alphas[in[3]];
+
+        in  += 4;
+        out += 4;
+    }
+}
+
+void Lut3DTetrahedralUInt8Renderer::apply(const void * inImg, void * outImg, long numPixels) const
+{
+    if (m_optLutHalf)
+    {
+        ApplyLut3DTetrahedralUInt8(m_optLutHalf, m_lowOffsets, m_highSteps, m_deltas, m_alphas,
+                                   (const uint8_t *)inImg, (float *)outImg, numPixels);
+    }
+    else
+    {
+        ApplyLut3DTetrahedralUInt8(m_optLut, m_lowOffsets, m_highSteps, m_deltas, m_alphas,
+                                   (const uint8_t *)inImg, (float *)outImg, numPixels);
+    }
+}
+
+template<typename LutType>
+void ApplyLut3DTrilinear(const LutType * optLut, const Lut3DLayout & layout,
+                         unsigned long lutDim, float lutStep,
+                         const float * in, float * out, long numPixels)
+{
+#ifdef USE_SSE
+
+    __m128 step = _mm_set1_ps(lutStep);
+    __m128 maxIdx = _mm_set1_ps((float)(lutDim - 1));
 
     __m128 v[8];
 
@@ -827,10 +1173,15 @@ void Lut3DRenderer::apply(const void * inImg, void * outImg, long numPixels) con
 
         __m128 delta = _mm_sub_ps(idx, lowIdx);
 
+        // Use the offsets of the entries along each axis instead of the indices
+        // (refer to Lut3DLayout).
+        const __m128i lowOffsets = GetLut3DAxisOffsets(layout, lowIdxInt32);
+        const __m128i highOffsets = GetLut3DAxisOffsets(layout, highIdxInt32);
+
         // lh01 = {L0, H0, L1, H1}
         // lh23 = {L2, H2, L3, H3}, L3 and H3 are not used
-        __m128i lh01 = _mm_unpacklo_epi32(lowIdxInt32, highIdxInt32);
-        __m128i lh23 = _mm_unpackhi_epi32(lowIdxInt32, highIdxInt32);
+        __m128i lh01 = _mm_unpacklo_epi32(lowOffsets, highOffsets);
+        __m128i lh23 = _mm_unpackhi_epi32(lowOffsets, highOffsets);
 
         // v[0] = { L0, L1, L2 }
         // v[1] = { L0, L1, H2 }
@@ -854,8 +1205,8 @@ void Lut3DRenderer::apply(const void * inImg, void * outImg, long numPixels) con
         idxB = _mm_unpacklo_epi64(lh23, lh23);
 
         // Lookup 8 corners of cube
-        LookupNearest4(m_optLut, idxR_L0, idxG, idxB, dim, v);
-        LookupNearest4(m_optLut, idxR_H0, idxG, idxB, dim, v + 4);
+        LookupNearest4(optLut, idxR_L0, idxG, idxB, v);
+        LookupNearest4(optLut, idxR_H0, idxG, idxB, v + 4);
 
         // Perform the trilinear interpolation
         __m128 wr = _mm_shuffle_ps(delta, delta, _MM_SHUFFLE(0, 0, 0, 0));
@@ -898,16 +1249,16 @@ void Lut3DRenderer::apply(const void * inImg, void * outImg, long numPixels) con
         out += 4;
     }
 #else
-    const float dimMinusOne = float(m_dim) - 1.f;
+    const float dimMinusOne = float(lutDim) - 1.f;
 
     for (long i = 0; i < numPixels; ++i)
     {
         float newAlpha = (float)in[3];
 
         float idx[3];
-        idx[0] = in[0] * m_step;
-        idx[1] = in[1] * m_step;
-        idx[2] = in[2] * m_step;
+        idx[0] = in[0] * lutStep;
+        idx[1] = in[1] * lutStep;
+        idx[2] = in[2] * lutStep;
 
         // NaNs become 0.
         idx[0] = Clamp(idx[0], 0.f, dimMinusOne);
@@ -935,49 +1286,644 @@ void Lut3DRenderer::apply(const void * inImg, void * outImg, long numPixels) con
 
         // Compute index into LUT for surrounding corners
         const int n000 =
-            GetLut3DIndexBlueFast(indexLow[0], indexLow[1], indexLow[2],
-                                  m_dim);
+            layout.getOffset(indexLow[0], indexLow[1], indexLow[2]);
         const int n100 =
-            GetLut3DIndexBlueFast(indexHigh[0], indexLow[1], indexLow[2],
-                                  m_dim);
+            layout.getOffset(indexHigh[0], indexLow[1], indexLow[2]);
         const int n010 =
-            GetLut3DIndexBlueFast(indexLow[0], indexHigh[1], indexLow[2],
-                                  m_dim);
+            layout.getOffset(indexLow[0], indexHigh[1], indexLow[2]);
         const int n001 =
-            GetLut3DIndexBlueFast(indexLow[0], indexLow[1], indexHigh[2],
-                                  m_dim);
+            layout.getOffset(indexLow[0], indexLow[1], indexHigh[2]);
         const int n110 =
-            GetLut3DIndexBlueFast(indexHigh[0], indexHigh[1], indexLow[2],
-                                  m_dim);
+            layout.getOffset(indexHigh[0], indexHigh[1], indexLow[2]);
         const int n101 =
-            GetLut3DIndexBlueFast(indexHigh[0], indexLow[1], indexHigh[2],
-                                  m_dim);
+            layout.getOffset(indexHigh[0], indexLow[1], indexHigh[2]);
         const int n011 =
-            GetLut3DIndexBlueFast(indexLow[0], indexHigh[1], indexHigh[2],
-                                  m_dim);
+            layout.getOffset(indexLow[0], indexHigh[1], indexHigh[2]);
         const int n111 =
-            GetLut3DIndexBlueFast(indexHigh[0], indexHigh[1], indexHigh[2],
-                                  m_dim);
+            layout.getOffset(indexHigh[0], indexHigh[1], indexHigh[2]);
 
         float x[3], y[3], z[3];
         x[0] = delta[0]; x[1] = delta[0]; x[2] = delta[0];
         y[0] = delta[1]; y[1] = delta[1]; y[2] = delta[1];
         z[0] = delta[2]; z[1] = delta[2]; z[2] = delta[2];
 
-        lerp_rgb(out,
-                 &m_optLut[n000], &m_optLut[n001],
-                 &m_optLut[n010], &m_optLut[n011],
-                 &m_optLut[n100], &m_optLut[n101],
-                 &m_optLut[n110], &m_optLut[n111],
-                 x, y, z);
+        lerp_rgb(out,
+                 &optLut[n000], &optLut[n001],
+                 &optLut[n010], &optLut[n011],
+                 &optLut[n100], &optLut[n101],
+                 &optLut[n110], &optLut[n111],
+                 x, y, z);
+
+        out[3] = newAlpha;
+
+        in  += 4;
+        out += 4;
+    }
+#endif
+}
+
+
+template<typename LutType>
+void ApplyLut3DNearest(const LutType * optLut, const Lut3DLayout & layout,
+                       unsigned long lutDim, float lutStep,
+                       const float * in, float * out, long numPixels)
+{
+    const float dimMinusOne = float(lutDim) - 1.f;
+
+    for (long i = 0; i < numPixels; ++i)
+    {
+        int index[3];
+        for (int c = 0; c < 3; ++c)
+        {
+            // NaNs become 0.
+            const float idx = Clamp(in[c] * lutStep, 0.f, dimMinusOne);
+            index[c] = static_cast<int>(idx + 0.5f);
+        }
+
+        const LutType * entry = optLut + layout.getOffset(index[0], index[1], index[2]);
+
+        out[0] = (float)entry[0];
+        out[1] = (float)entry[1];
+        out[2] = (float)entry[2];
+        out[3] = in[3];
+
+        in  += 4;
+        out += 4;
+    }
+}
+
+Lut3DRenderer::Lut3DRenderer(ConstLut3DOpDataRcPtr & lut)
+    : BaseLut3DRenderer(lut)
+{
+}
+
+Lut3DRenderer::~Lut3DRenderer()
+{
+}
+
+void Lut3DRenderer::apply(const void * inImg, void * outImg, long numPixels) const
+{
+    if (m_optLutHalf)
+    {
+        ApplyLut3DTrilinear(m_optLutHalf, m_layout, m_dim, m_step,
+                            (const float *)inImg, (float *)outImg, numPixels);
+    }
+    else
+    {
+        ApplyLut3DTrilinear(m_optLut, m_layout, m_dim, m_step,
+                            (const float *)inImg, (float *)outImg, numPixels);
+    }
+}
+
+Lut3DNearestRenderer::Lut3DNearestRenderer(ConstLut3DOpDataRcPtr & lut)
+    : BaseLut3DRenderer(lut)
+{
+}
+
+Lut3DNearestRenderer::~Lut3DNearestRenderer()
+{
+}
+
+void Lut3DNearestRenderer::apply(const void * inImg, void * outImg, long numPixels) const
+{
+    if (m_optLutHalf)
+    {
+        ApplyLut3DNearest(m_optLutHalf, m_layout, m_dim, m_step,
+                          (const float *)inImg, (float *)outImg, numPixels);
+    }
+    else
+    {
+        ApplyLut3DNearest(m_optLut, m_layout, m_dim, m_step,
+                          (const float *)inImg, (float *)outImg, numPixels);
+    }
+}
+
+#if defined(OCIO_USE_AVX)
+
+// The AVX variants interpolate 8 (AVX2) or 16 (AVX-512) pixels at once: the pixels are
+// transposed into R, G & B registers, the cells of all the pixels are computed in
+// parallel and the corner values are fetched from the padded RGBA LUT with gather
+// instructions. They do exactly the same floating-point operations as the SSE
+// implementation (i.e. FMA is not used) so all the CPUs produce identical results.
+//
+// The functions return the number of processed pixels, the remaining ones being
+// processed by the SSE implementation.
+
+// Transpose each 128-bit lane i.e. RGBA pixels into R, G, B & A registers, and back.
+// Note that the pixels are permuted within the channel registers, which is harmless
+// as all the computations are done per element.
+OCIO_TARGET_AVX2
+inline void Transpose4x4AVX2(__m256 & v0, __m256 & v1, __m256 & v2, __m256 & v3)
+{
+    const __m256 t0 = _mm256_unpacklo_ps(v0, v1);
+    const __m256 t1 = _mm256_unpacklo_ps(v2, v3);
+    const __m256 t2 = _mm256_unpackhi_ps(v0, v1);
+    const __m256 t3 = _mm256_unpackhi_ps(v2, v3);
+
+    v0 = _mm256_shuffle_ps(t0, t1, _MM_SHUFFLE(1, 0, 1, 0));
+    v1 = _mm256_shuffle_ps(t0, t1, _MM_SHUFFLE(3, 2, 3, 2));
+    v2 = _mm256_shuffle_ps(t2, t3, _MM_SHUFFLE(1, 0, 1, 0));
+    v3 = _mm256_shuffle_ps(t2, t3, _MM_SHUFFLE(3, 2, 3, 2));
+}
+
+// Compute the offset in the LUT of the lowest corner of the cells, the offset
+// increments to reach the highest corner along each axis, and the position of
+// the pixels within the cells.
+OCIO_TARGET_AVX2
+inline void GetLut3DCellsAVX2(const __m256 rgb[3], const Lut3DLayout & layout, long dim,
+                              float step, __m256i & base, __m256i inc[3], __m256 delta[3])
+{
+    const __m256 stepV  = _mm256_set1_ps(step);
+    const __m256 maxIdx = _mm256_set1_ps((float)(dim - 1));
+    const __m256i three = _mm256_set1_epi32(3);
+
+    base = _mm256_setzero_si256();
+    for (int c = 0; c < 3; ++c)
+    {
+        __m256 idx = _mm256_mul_ps(rgb[c], stepV);
+
+        idx = _mm256_max_ps(idx, _mm256_setzero_ps());  // NaNs become 0
+        idx = _mm256_min_ps(idx, maxIdx);
+
+        const __m256i lowIdxInt32 = _mm256_cvttps_epi32(idx);
+        const __m256 lowIdx = _mm256_cvtepi32_ps(lowIdxInt32);
+
+        // The highest corner only differs from the lowest one when lowIdx < maxIdx.
+        const __m256i highIdxInt32 = _mm256_sub_epi32(lowIdxInt32,
+            _mm256_castps_si256(_mm256_cmp_ps(lowIdx, maxIdx, _CMP_LT_OQ)));
+
+        delta[c] = _mm256_sub_ps(idx, lowIdx);
+
+        // offset = (idx / 4) * brickStride + (idx % 4) * entryStride
+        const __m256i brickStride = _mm256_set1_epi32(layout.brickStrides[c]);
+        const __m256i entryStride = _mm256_set1_epi32(layout.entryStrides[c]);
+
+        const __m256i lowOffset = _mm256_add_epi32(
+            _mm256_mullo_epi32(_mm256_srli_epi32(lowIdxInt32, 2), brickStride),
+            _mm256_mullo_epi32(_mm256_and_si256(lowIdxInt32, three), entryStride));
+        const __m256i highOffset = _mm256_add_epi32(
+            _mm256_mullo_epi32(_mm256_srli_epi32(highIdxInt32, 2), brickStride),
+            _mm256_mullo_epi32(_mm256_and_si256(highIdxInt32, three), entryStride));
+
+        base = _mm256_add_epi32(base, lowOffset);
+        inc[c] = _mm256_sub_epi32(highOffset, lowOffset);
+    }
+}
+
+OCIO_TARGET_AVX2
+long ApplyLut3DTetrahedralAVX2(const float * lut, const Lut3DLayout & layout,
+                               long dim, float step,
+                               const float * in, float * out, long numPixels)
+{
+    const __m256 ones = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+
+    long idx = 0;
+    for (; idx + 8 <= numPixels; idx += 8)
+    {
+        __m256 rgb[3] = { _mm256_loadu_ps(in),
+                          _mm256_loadu_ps(in + 8),
+                          _mm256_loadu_ps(in + 16) };
+        __m256 alpha = _mm256_loadu_ps(in + 24);
+        Transpose4x4AVX2(rgb[0], rgb[1], rgb[2], alpha);
+
+        __m256i base, inc[3];
+        __m256 delta[3];
+        GetLut3DCellsAVX2(rgb, layout, dim, step, base, inc, delta);
+
+        // Select the tetrahedron using the same comparisons as the SSE implementation.
+        const __m256 c0 = _mm256_cmp_ps(delta[0], delta[1], _CMP_GE_OQ);
+        const __m256 c1 = _mm256_cmp_ps(delta[1], delta[2], _CMP_GE_OQ);
+        const __m256 c2 = _mm256_cmp_ps(delta[2], delta[0], _CMP_GE_OQ);
+
+        const __m256 notC0 = _mm256_andnot_ps(c0, ones);
+        const __m256 notC1 = _mm256_andnot_ps(c1, ones);
+        const __m256 notC2 = _mm256_andnot_ps(c2, ones);
+
+        // The vertices v0 to v3 of the tetrahedron go from the lowest to the highest
+        // corner of the cell crossing one axis at a time. Find the axis crossed first
+        // (i.e. from v0 to v1) and the one crossed last (i.e. from v2 to v3).
+        const __m256 firstR = _mm256_and_ps(c0, _mm256_or_ps(c1, notC2));
+        const __m256 firstG = _mm256_and_ps(notC0, c1);
+        const __m256 firstB = _mm256_and_ps(notC1, _mm256_or_ps(notC0, c2));
+        const __m256 lastR  = _mm256_and_ps(notC0, _mm256_or_ps(notC1, c2));
+        const __m256 lastG  = _mm256_and_ps(c0, notC1);
+        const __m256 lastB  = _mm256_and_ps(c1, _mm256_or_ps(c0, notC2));
+
+        const __m256 incR = _mm256_castsi256_ps(inc[0]);
+        const __m256 incG = _mm256_castsi256_ps(inc[1]);
+        const __m256 incB = _mm256_castsi256_ps(inc[2]);
+
+        const __m256i incFirst = _mm256_castps_si256(
+            _mm256_blendv_ps(_mm256_blendv_ps(incB, incG, firstG), incR, firstR));
+        const __m256i incLast = _mm256_castps_si256(
+            _mm256_blendv_ps(_mm256_blendv_ps(incR, incG, lastG), incB, lastB));
+
+        const __m256i off0 = base;
+        const __m256i off1 = _mm256_add_epi32(base, incFirst);
+        const __m256i off3 = _mm256_add_epi32(
+            base, _mm256_add_epi32(inc[0], _mm256_add_epi32(inc[1], inc[2])));
+        const __m256i off2 = _mm256_sub_epi32(off3, incLast);
+
+        __m256 res[3];
+        for (int c = 0; c < 3; ++c)
+        {
+            const __m256 v0 = _mm256_i32gather_ps(lut + c, off0, 4);
+            const __m256 v1 = _mm256_i32gather_ps(lut + c, off1, 4);
+            const __m256 v2 = _mm256_i32gather_ps(lut + c, off2, 4);
+            const __m256 v3 = _mm256_i32gather_ps(lut + c, off3, 4);
+
+            const __m256 dv01 = _mm256_sub_ps(v1, v0);
+            const __m256 dv12 = _mm256_sub_ps(v2, v1);
+            const __m256 dv23 = _mm256_sub_ps(v3, v2);
+
+            // Vertices differences along each axis.
+            const __m256 dvR = _mm256_blendv_ps(_mm256_blendv_ps(dv12, dv01, firstR), dv23, lastR);
+            const __m256 dvG = _mm256_blendv_ps(_mm256_blendv_ps(dv12, dv01, firstG), dv23, lastG);
+            const __m256 dvB = _mm256_blendv_ps(_mm256_blendv_ps(dv12, dv01, firstB), dv23, lastB);
+
+            res[c] = _mm256_add_ps(_mm256_add_ps(v0, _mm256_mul_ps(delta[0], dvR)),
+                                   _mm256_add_ps(_mm256_mul_ps(delta[1], dvG),
+                                                 _mm256_mul_ps(delta[2], dvB)));
+        }
+
+        // The alpha values are untouched.
+        Transpose4x4AVX2(res[0], res[1], res[2], alpha);
+
+        _mm256_storeu_ps(out,      res[0]);
+        _mm256_storeu_ps(out + 8,  res[1]);
+        _mm256_storeu_ps(out + 16, res[2]);
+        _mm256_storeu_ps(out + 24, alpha);
+
+        in  += 32;
+        out += 32;
+    }
+
+    return idx;
+}
+
+OCIO_TARGET_AVX2
+long ApplyLut3DTrilinearAVX2(const float * lut, const Lut3DLayout & layout,
+                             long dim, float step,
+                             const float * in, float * out, long numPixels)
+{
+    const __m256 one = _mm256_set1_ps(1.0f);
+
+    long idx = 0;
+    for (; idx + 8 <= numPixels; idx += 8)
+    {
+        __m256 rgb[3] = { _mm256_loadu_ps(in),
+                          _mm256_loadu_ps(in + 8),
+                          _mm256_loadu_ps(in + 16) };
+        __m256 alpha = _mm256_loadu_ps(in + 24);
+        Transpose4x4AVX2(rgb[0], rgb[1], rgb[2], alpha);
+
+        __m256i base, inc[3];
+        __m256 delta[3];
+        GetLut3DCellsAVX2(rgb, layout, dim, step, base, inc, delta);
+
+        // off[i] is the offset of the corner { i&4 ? H0 : L0, i&2 ? H1 : L1, i&1 ? H2 : L2 }.
+        __m256i off[8];
+        off[0] = base;
+        off[1] = _mm256_add_epi32(off[0], inc[2]);
+        off[2] = _mm256_add_epi32(off[0], inc[1]);
+        off[3] = _mm256_add_epi32(off[2], inc[2]);
+        off[4] = _mm256_add_epi32(off[0], inc[0]);
+        off[5] = _mm256_add_epi32(off[4], inc[2]);
+        off[6] = _mm256_add_epi32(off[4], inc[1]);
+        off[7] = _mm256_add_epi32(off[6], inc[2]);
+
+        const __m256 oneMinusWr = _mm256_sub_ps(one, delta[0]);
+        const __m256 oneMinusWg = _mm256_sub_ps(one, delta[1]);
+        const __m256 oneMinusWb = _mm256_sub_ps(one, delta[2]);
+
+        __m256 res[3];
+        for (int c = 0; c < 3; ++c)
+        {
+            __m256 v[8];
+            for (int i = 0; i < 8; ++i)
+            {
+                v[i] = _mm256_i32gather_ps(lut + c, off[i], 4);
+            }
+
+            // Compute linear interpolation along the blue axis.
+            const __m256 blue1 = _mm256_add_ps(_mm256_mul_ps(v[0], oneMinusWb),
+                                               _mm256_mul_ps(v[1], delta[2]));
+            const __m256 blue2 = _mm256_add_ps(_mm256_mul_ps(v[2], oneMinusWb),
+                                               _mm256_mul_ps(v[3], delta[2]));
+            const __m256 blue3 = _mm256_add_ps(_mm256_mul_ps(v[4], oneMinusWb),
+                                               _mm256_mul_ps(v[5], delta[2]));
+            const __m256 blue4 = _mm256_add_ps(_mm256_mul_ps(v[6], oneMinusWb),
+                                               _mm256_mul_ps(v[7], delta[2]));
+
+            // Compute linear interpolation along the green axis.
+            const __m256 green1 = _mm256_add_ps(_mm256_mul_ps(blue1, oneMinusWg),
+                                                _mm256_mul_ps(blue2, delta[1]));
+            const __m256 green2 = _mm256_add_ps(_mm256_mul_ps(blue3, oneMinusWg),
+                                                _mm256_mul_ps(blue4, delta[1]));
+
+            // Compute linear interpolation along the red axis.
+            res[c] = _mm256_add_ps(_mm256_mul_ps(green1, oneMinusWr),
+                                   _mm256_mul_ps(green2, delta[0]));
+        }
+
+        // The alpha values are untouched.
+        Transpose4x4AVX2(res[0], res[1], res[2], alpha);
+
+        _mm256_storeu_ps(out,      res[0]);
+        _mm256_storeu_ps(out + 8,  res[1]);
+        _mm256_storeu_ps(out + 16, res[2]);
+        _mm256_storeu_ps(out + 24, alpha);
+
+        in  += 32;
+        out += 32;
+    }
+
+    return idx;
+}
+
+OCIO_AVX512_DIAGNOSTIC_PUSH
+
+OCIO_TARGET_AVX512
+inline void Transpose4x4AVX512(__m512 & v0, __m512 & v1, __m512 & v2, __m512 & v3)
+{
+    const __m512 t0 = _mm512_unpacklo_ps(v0, v1);
+    const __m512 t1 = _mm512_unpacklo_ps(v2, v3);
+    const __m512 t2 = _mm512_unpackhi_ps(v0, v1);
+    const __m512 t3 = _mm512_unpackhi_ps(v2, v3);
+
+    v0 = _mm512_shuffle_ps(t0, t1, _MM_SHUFFLE(1, 0, 1, 0));
+    v1 = _mm512_shuffle_ps(t0, t1, _MM_SHUFFLE(3, 2, 3, 2));
+    v2 = _mm512_shuffle_ps(t2, t3, _MM_SHUFFLE(1, 0, 1, 0));
+    v3 = _mm512_shuffle_ps(t2, t3, _MM_SHUFFLE(3, 2, 3, 2));
+}
+
+OCIO_TARGET_AVX512
+inline void GetLut3DCellsAVX512(const __m512 rgb[3], const Lut3DLayout & layout, long dim,
+                                float step, __m512i & base, __m512i inc[3], __m512 delta[3])
+{
+    const __m512 stepV  = _mm512_set1_ps(step);
+    const __m512 maxIdx = _mm512_set1_ps((float)(dim - 1));
+    const __m512i three = _mm512_set1_epi32(3);
+
+    base = _mm512_setzero_si512();
+    for (int c = 0; c < 3; ++c)
+    {
+        __m512 idx = _mm512_mul_ps(rgb[c], stepV);
+
+        idx = _mm512_max_ps(idx, _mm512_setzero_ps());  // NaNs become 0
+        idx = _mm512_min_ps(idx, maxIdx);
+
+        const __m512i lowIdxInt32 = _mm512_cvttps_epi32(idx);
+        const __m512 lowIdx = _mm512_cvtepi32_ps(lowIdxInt32);
+
+        // The highest corner only differs from the lowest one when lowIdx < maxIdx.
+        const __m512i highIdxInt32 = _mm512_mask_add_epi32(lowIdxInt32,
+            _mm512_cmp_ps_mask(lowIdx, maxIdx, _CMP_LT_OQ), lowIdxInt32, _mm512_set1_epi32(1));
+
+        delta[c] = _mm512_sub_ps(idx, lowIdx);
+
+        // offset = (idx / 4) * brickStride + (idx % 4) * entryStride
+        const __m512i brickStride = _mm512_set1_epi32(layout.brickStrides[c]);
+        const __m512i entryStride = _mm512_set1_epi32(layout.entryStrides[c]);
+
+        const __m512i lowOffset = _mm512_add_epi32(
+            _mm512_mullo_epi32(_mm512_srli_epi32(lowIdxInt32, 2), brickStride),
+            _mm512_mullo_epi32(_mm512_and_si512(lowIdxInt32, three), entryStride));
+        const __m512i highOffset = _mm512_add_epi32(
+            _mm512_mullo_epi32(_mm512_srli_epi32(highIdxInt32, 2), brickStride),
+            _mm512_mullo_epi32(_mm512_and_si512(highIdxInt32, three), entryStride));
+
+        base = _mm512_add_epi32(base, lowOffset);
+        inc[c] = _mm512_sub_epi32(highOffset, lowOffset);
+    }
+}
+
+OCIO_TARGET_AVX512
+long ApplyLut3DTetrahedralAVX512(const float * lut, const Lut3DLayout & layout,
+                                 long dim, float step,
+                                 const float * in, float * out, long numPixels)
+{
+    long idx = 0;
+    for (; idx + 16 <= numPixels; idx += 16)
+    {
+        __m512 rgb[3] = { _mm512_loadu_ps(in),
+                          _mm512_loadu_ps(in + 16),
+                          _mm512_loadu_ps(in + 32) };
+        __m512 alpha = _mm512_loadu_ps(in + 48);
+        Transpose4x4AVX512(rgb[0], rgb[1], rgb[2], alpha);
+
+        __m512i base, inc[3];
+        __m512 delta[3];
+        GetLut3DCellsAVX512(rgb, layout, dim, step, base, inc, delta);
+
+        // Select the tetrahedron using the same comparisons as the SSE implementation.
+        const __mmask16 c0 = _mm512_cmp_ps_mask(delta[0], delta[1], _CMP_GE_OQ);
+        const __mmask16 c1 = _mm512_cmp_ps_mask(delta[1], delta[2], _CMP_GE_OQ);
+        const __mmask16 c2 = _mm512_cmp_ps_mask(delta[2], delta[0], _CMP_GE_OQ);
+
+        // Refer to the AVX2 implementation.
+        const __mmask16 firstR = __mmask16(c0 & (c1 | ~c2));
+        const __mmask16 firstG = __mmask16(~c0 & c1);
+        const __mmask16 firstB = __mmask16(~c1 & (~c0 | c2));
+        const __mmask16 lastR  = __mmask16(~c0 & (~c1 | c2));
+        const __mmask16 lastG  = __mmask16(c0 & ~c1);
+        const __mmask16 lastB  = __mmask16(c1 & (c0 | ~c2));
+
+        const __m512i incFirst = _mm512_mask_blend_epi32(
+            firstR, _mm512_mask_blend_epi32(firstG, inc[2], inc[1]), inc[0]);
+        const __m512i incLast = _mm512_mask_blend_epi32(
+            lastB, _mm512_mask_blend_epi32(lastG, inc[0], inc[1]), inc[2]);
+
+        const __m512i off0 = base;
+        const __m512i off1 = _mm512_add_epi32(base, incFirst);
+        const __m512i off3 = _mm512_add_epi32(
+            base, _mm512_add_epi32(inc[0], _mm512_add_epi32(inc[1], inc[2])));
+        const __m512i off2 = _mm512_sub_epi32(off3, incLast);
+
+        __m512 res[3];
+        for (int c = 0; c < 3; ++c)
+        {
+            const __m512 v0 = _mm512_i32gather_ps(off0, lut + c, 4);
+            const __m512 v1 = _mm512_i32gather_ps(off1, lut + c, 4);
+            const __m512 v2 = _mm512_i32gather_ps(off2, lut + c, 4);
+            const __m512 v3 = _mm512_i32gather_ps(off3, lut + c, 4);
+
+            const __m512 dv01 = _mm512_sub_ps(v1, v0);
+            const __m512 dv12 = _mm512_sub_ps(v2, v1);
+            const __m512 dv23 = _mm512_sub_ps(v3, v2);
+
+            // Vertices differences along each axis.
+            const __m512 dvR = _mm512_mask_blend_ps(lastR, _mm512_mask_blend_ps(firstR, dv12, dv01), dv23);
+            const __m512 dvG = _mm512_mask_blend_ps(lastG, _mm512_mask_blend_ps(firstG, dv12, dv01), dv23);
+            const __m512 dvB = _mm512_mask_blend_ps(lastB, _mm512_mask_blend_ps(firstB, dv12, dv01), dv23);
+
+            res[c] = _mm512_add_ps(_mm512_add_ps(v0, _mm512_mul_ps(delta[0], dvR)),
+                                   _mm512_add_ps(_mm512_mul_ps(delta[1], dvG),
+                                                 _mm512_mul_ps(delta[2], dvB)));
+        }
+
+        // The alpha values are untouched.
+        Transpose4x4AVX512(res[0], res[1], res[2], alpha);
+
+        _mm512_storeu_ps(out,      res[0]);
+        _mm512_storeu_ps(out + 16, res[1]);
+        _mm512_storeu_ps(out + 32, res[2]);
+        _mm512_storeu_ps(out + 48, alpha);
+
+        in  += 64;
+        out += 64;
+    }
+
+    return idx;
+}
+
+OCIO_TARGET_AVX512
+long ApplyLut3DTrilinearAVX512(const float * lut, const Lut3DLayout & layout,
+                               long dim, float step,
+                               const float * in, float * out, long numPixels)
+{
+    const __m512 one = _mm512_set1_ps(1.0f);
+
+    long idx = 0;
+    for (; idx + 16 <= numPixels; idx += 16)
+    {
+        __m512 rgb[3] = { _mm512_loadu_ps(in),
+                          _mm512_loadu_ps(in + 16),
+                          _mm512_loadu_ps(in + 32) };
+        __m512 alpha = _mm512_loadu_ps(in + 48);
+        Transpose4x4AVX512(rgb[0], rgb[1], rgb[2], alpha);
+
+        __m512i base, inc[3];
+        __m512 delta[3];
+        GetLut3DCellsAVX512(rgb, layout, dim, step, base, inc, delta);
+
+        // off[i] is the offset of the corner { i&4 ? H0 : L0, i&2 ? H1 : L1, i&1 ? H2 : L2 }.
+        __m512i off[8];
+        off[0] = base;
+        off[1] = _mm512_add_epi32(off[0], inc[2]);
+        off[2] = _mm512_add_epi32(off[0], inc[1]);
+        off[3] = _mm512_add_epi32(off[2], inc[2]);
+        off[4] = _mm512_add_epi32(off[0], inc[0]);
+        off[5] = _mm512_add_epi32(off[4], inc[2]);
+        off[6] = _mm512_add_epi32(off[4], inc[1]);
+        off[7] = _mm512_add_epi32(off[6], inc[2]);
+
+        const __m512 oneMinusWr = _mm512_sub_ps(one, delta[0]);
+        const __m512 oneMinusWg = _mm512_sub_ps(one, delta[1]);
+        const __m512 oneMinusWb = _mm512_sub_ps(one, delta[2]);
+
+        __m512 res[3];
+        for (int c = 0; c < 3; ++c)
+        {
+            __m512 v[8];
+            for (int i = 0; i < 8; ++i)
+            {
+                v[i] = _mm512_i32gather_ps(off[i], lut + c, 4);
+            }
+
+            // Compute linear interpolation along the blue axis.
+            const __m512 blue1 = _mm512_add_ps(_mm512_mul_ps(v[0], oneMinusWb),
+                                               _mm512_mul_ps(v[1], delta[2]));
+            const __m512 blue2 = _mm512_add_ps(_mm512_mul_ps(v[2], oneMinusWb),
+                                               _mm512_mul_ps(v[3], delta[2]));
+            const __m512 blue3 = _mm512_add_ps(_mm512_mul_ps(v[4], oneMinusWb),
+                                               _mm512_mul_ps(v[5], delta[2]));
+            const __m512 blue4 = _mm512_add_ps(_mm512_mul_ps(v[6], oneMinusWb),
+                                               _mm512_mul_ps(v[7], delta[2]));
+
+            // Compute linear interpolation along the green axis.
+            const __m512 green1 = _mm512_add_ps(_mm512_mul_ps(blue1, oneMinusWg),
+                                                _mm512_mul_ps(blue2, delta[1]));
+            const __m512 green2 = _mm512_add_ps(_mm512_mul_ps(blue3, oneMinusWg),
+                                                _mm512_mul_ps(blue4, delta[1]));
+
+            // Compute linear interpolation along the red axis.
+            res[c] = _mm512_add_ps(_mm512_mul_ps(green1, oneMinusWr),
+                                   _mm512_mul_ps(green2, delta[0]));
+        }
+
+        // The alpha values are untouched.
+        Transpose4x4AVX512(res[0], res[1], res[2], alpha);
+
+        _mm512_storeu_ps(out,      res[0]);
+        _mm512_storeu_ps(out + 16, res[1]);
+        _mm512_storeu_ps(out + 32, res[2]);
+        _mm512_storeu_ps(out + 48, alpha);
+
+        in  += 64;
+        out += 64;
+    }
+
+    return idx;
+}
+
+OCIO_AVX512_DIAGNOSTIC_POP
+
+class Lut3DTetrahedralAVX2Renderer : public Lut3DTetrahedralRenderer
+{
+public:
+    explicit Lut3DTetrahedralAVX2Renderer(ConstLut3DOpDataRcPtr & lut)
+        : Lut3DTetrahedralRenderer(lut) {}
+
+    void apply(const void * inImg, void * outImg, long numPixels) const override
+    {
+        const long done = ApplyLut3DTetrahedralAVX2(m_optLut, m_layout, (long)m_dim, m_step,
+                                                    (const float *)inImg, (float *)outImg,
+                                                    numPixels);
+        Lut3DTetrahedralRenderer::apply((const float *)inImg + 4 * done,
+                                        (float *)outImg + 4 * done, numPixels - done);
+    }
+};
+
+class Lut3DTetrahedralAVX512Renderer : public Lut3DTetrahedralRenderer
+{
+public:
+    explicit Lut3DTetrahedralAVX512Renderer(ConstLut3DOpDataRcPtr & lut)
+        : Lut3DTetrahedralRenderer(lut) {}
+
+    void apply(const void * inImg, void * outImg, long numPixels) const override
+    {
+        const long done = ApplyLut3DTetrahedralAVX512(m_optLut, m_layout, (long)m_dim, m_step,
+                                                      (const float *)inImg, (float *)outImg,
+                                                      numPixels);
+        Lut3DTetrahedralRenderer::apply((const float *)inImg + 4 * done,
+                                        (float *)outImg + 4 * done, numPixels - done);
+    }
+};
+
+class Lut3DAVX2Renderer : public Lut3DRenderer
+{
+public:
+    explicit Lut3DAVX2Renderer(ConstLut3DOpDataRcPtr & lut)
+        : Lut3DRenderer(lut) {}
 
-        out[3] = newAlpha;
+    void apply(const void * inImg, void * outImg, long numPixels) const override
+    {
+        const long done = ApplyLut3DTrilinearAVX2(m_optLut, m_layout, (long)m_dim, m_step,
+                                                  (const float *)inImg, (float *)outImg,
+                                                  numPixels);
+        Lut3DRenderer::apply((const float *)inImg + 4 * done,
+                             (float *)outImg + 4 * done, numPixels - done);
+    }
+};
 
-        in  += 4;
-        out += 4;
+class Lut3DAVX512Renderer : public Lut3DRenderer
+{
+public:
+    explicit Lut3DAVX512Renderer(ConstLut3DOpDataRcPtr & lut)
+        : Lut3DRenderer(lut) {}
+
+    void apply(const void * inImg, void * outImg, long numPixels) const override
+    {
+        const long done = ApplyLut3DTrilinearAVX512(m_optLut, m_layout, (long)m_dim, m_step,
+                                                    (const float *)inImg, (float *)outImg,
+                                                    numPixels);
+        Lut3DRenderer::apply((const float *)inImg + 4 * done,
+                             (float *)outImg + 4 * done, numPixels - done);
     }
-#endif
-}
+};
+
+#endif // OCIO_USE_AVX
 
 // The inversion code is based on an algorithm in "Numerical Linear Algebra
 // and Optimization, vol. 1," by Gill, Murray, and Wright.
@@ -1237,6 +2183,25 @@ unsigned long invert_hypercube
     }
 }
 
+// The RangeTree levels are built by ranges of elements processed in parallel.
+static constexpr unsigned long TreeRangeSize = 4096;
+
+inline long GetNumTreeRanges(unsigned long numElems)
+{
+    return long((numElems + TreeRangeSize - 1) / TreeRangeSize);
+}
+
+// Call func(rangeIdx, begin, end) for all the ranges of [0, numElems[.
+template<typename Func>
+void ParallelForTreeRanges(unsigned long numElems, const Func & func)
+{
+    GetCPUThreadPool()->parallelFor(GetNumTreeRanges(numElems), [&](long rangeIdx)
+    {
+        const unsigned long begin = rangeIdx * TreeRangeSize;
+        func(rangeIdx, begin, std::min(begin + TreeRangeSize, numElems));
+    });
+}
+
 InvLut3DRenderer::RangeTree::RangeTree()
 {
 }
@@ -1282,38 +2247,41 @@ void InvLut3DRenderer::RangeTree::initRanges(float *grvec)
         throw Exception("Unsupported channel number.");
     }
 
-    float minVal[MAX_N] = { 0.0f, 0.0f, 0.0f, 0.0f };
-    float maxVal[MAX_N] = { 0.0f, 0.0f, 0.0f, 0.0f };
-    for (unsigned long i = 0; i < N; i++)
+    ParallelForTreeRanges(N, [&](long, unsigned long begin, unsigned long end)
     {
-        const unsigned long baseOffset = m_baseInds[i].inds[0] * ind0scale +
-            m_baseInds[i].inds[1] * ind1scale + m_baseInds[i].inds[2];
-
-        for (unsigned long k = 0; k < m_chans; k++)
+        float minVal[MAX_N] = { 0.0f, 0.0f, 0.0f, 0.0f };
+        float maxVal[MAX_N] = { 0.0f, 0.0f, 0.0f, 0.0f };
+        for (unsigned long i = begin; i < end; i++)
         {
-            minVal[k] = grvec[baseOffset * m_chans + k];
-            maxVal[k] = minVal[k];
-        }
+            const unsigned long baseOffset = m_baseInds[i].inds[0] * ind0scale +
+                m_baseInds[i].inds[1] * ind1scale + m_baseInds[i].inds[2];
 
-        for (unsigned long j = 1; j < corners; j++)
-        {
-            const unsigned long index = (baseOffset + cornerOffsets[j]) * m_chans;
             for (unsigned long k = 0; k < m_chans; k++)
             {
-                minVal[k] = std::min(minVal[k], grvec[index + k]);
-                maxVal[k] = std::max(maxVal[k], grvec[index + k]);
+                minVal[k] = grvec[baseOffset * m_chans + k];
+                maxVal[k] = minVal[k];
             }
-        }
 
-        // Expand the ranges slightly to allow for error in forward evaluation.
-        const float TOL = 1e-6f;
+            for (unsigned long j = 1; j < corners; j++)
+            {
+                const unsigned long index = (baseOffset + cornerOffsets[j]) * m_chans;
+                for (unsigned long k = 0; k < m_chans; k++)
+                {
+                    minVal[k] = std::min(minVal[k], grvec[index + k]);
+                    maxVal[k] = std::max(maxVal[k], grvec[index + k]);
+                }
+            }
 
-        for (unsigned long k = 0; k < m_chans; k++)
-        {
-            m_levels[depthm1].minVals[i * m_chans + k] = minVal[k] - TOL;
-            m_levels[depthm1].maxVals[i * m_chans + k] = maxVal[k] + TOL;
+            // Expand the ranges slightly to allow for error in forward evaluation.
+            const float TOL = 1e-6f;
+
+            for (unsigned long k = 0; k < m_chans; k++)
+            {
+                m_levels[depthm1].minVals[i * m_chans + k] = minVal[k] - TOL;
+                m_levels[depthm1].maxVals[i * m_chans + k] = maxVal[k] + TOL;
+            }
         }
-    }
+    });
 }
 
 void InvLut3DRenderer::RangeTree::initInds()
@@ -1395,18 +2363,43 @@ void InvLut3DRenderer::RangeTree::updateChildren(
 
     const unsigned long maxChildren = 1 << m_chans;
     const unsigned long gap = m_levelScales[level + 1] * maxChildren;
+    const unsigned long prevSize = (const unsigned long)hashes.size();
+
+    // A new element starts at each gap between the sorted hashes. The gaps are
+    // first counted per range to then find, in parallel, the offsets of the elements.
+    std::vector<unsigned long> rangeCounts(GetNumTreeRanges(prevSize), 0);
+    ParallelForTreeRanges(prevSize, [&](long rangeIdx, unsigned long begin, unsigned long end)
+    {
+        for (unsigned long i = std::max(begin, 1ul); i < end; i++)
+        {
+            if (hashes[i] - hashes[i - 1] > gap)
+            {
+                rangeCounts[rangeIdx]++;
+            }
+        }
+    });
+
     unsigned long cnt = 1;
+    for (auto & rangeCount : rangeCounts)
+    {
+        const unsigned long rangeFirst = cnt;
+        cnt += rangeCount;
+        rangeCount = rangeFirst;
+    }
 
     m_levels[level].child0offsets[0] = 0;
-    const unsigned long prevSize = (const unsigned long)hashes.size();
-    for (unsigned long i = 1; i < prevSize; i++)
+    ParallelForTreeRanges(prevSize, [&](long rangeIdx, unsigned long begin, unsigned long end)
     {
-        if (hashes[i] - hashes[i - 1] > gap)
+        unsigned long elemIdx = rangeCounts[rangeIdx];
+        for (unsigned long i = std::max(begin, 1ul); i < end; i++)
         {
-            m_levels[level].child0offsets[cnt] = i;
-            cnt++;
+            if (hashes[i] - hashes[i - 1] > gap)
+            {
+                m_levels[level].child0offsets[elemIdx] = i;
+                elemIdx++;
+            }
         }
-    }
+    });
 
     for (unsigned long i = 0; i < levelSize - 1; i++)
     {
@@ -1425,41 +2418,60 @@ void InvLut3DRenderer::RangeTree::updateRanges(const unsigned long level)
     m_levels[level].minVals.resize(levelSize * m_chans);
     m_levels[level].maxVals.resize(levelSize * m_chans);
 
-    for (unsigned long i = 0; i < levelSize; i++)
+    ParallelForTreeRanges(levelSize, [&](long, unsigned long begin, unsigned long end)
     {
-        const unsigned long index = m_levels[level].child0offsets[i];
-        for (unsigned long k = 0; k < m_chans; k++)
+        for (unsigned long i = begin; i < end; i++)
         {
-            m_levels[level].minVals[i * m_chans + k] =
-                m_levels[level + 1].minVals[index * m_chans + k];
-            m_levels[level].maxVals[i * m_chans + k] =
-                m_levels[level + 1].maxVals[index * m_chans + k];
-        }
+            const unsigned long index = m_levels[level].child0offsets[i];
+            for (unsigned long k = 0; k < m_chans; k++)
+            {
+                m_levels[level].minVals[i * m_chans + k] =
+                    m_levels[level + 1].minVals[index * m_chans + k];
+                m_levels[level].maxVals[i * m_chans + k] =
+                    m_levels[level + 1].maxVals[index * m_chans + k];
+            }
 
-        // New min/max combine the min/max for all children from next lower level.
-        for (unsigned long j = 2; j <= maxChildren; j++)
-        {
-            if (m_levels[level].numChildren[i] >= j)
+            // New min/max combine the min/max for all children from next lower level.
+            for (unsigned long j = 2; j <= maxChildren; j++)
             {
-                const unsigned long ind = index + j - 1;
-                for (unsigned long k = 0; k < m_chans; k++)
+                if (m_levels[level].numChildren[i] >= j)
                 {
-                    const float minVal = m_levels[level].minVals[i * m_chans + k];
-                    const float childMinVal = m_levels[level + 1].minVals[ind * m_chans + k];
-                    if (childMinVal < minVal)
+                    const unsigned long ind = index + j - 1;
+                    for (unsigned long k = 0; k < m_chans; k++)
                     {
-                        m_levels[level].minVals[i * m_chans + k] = childMinVal;
-                    }
-                    const float maxVal = m_levels[level].maxVals[i * m_chans + k];
-                    const float childMaxVal = m_levels[level + 1].maxVals[ind * m_chans + k];
-                    if (childMaxVal > maxVal)
-                    {
-                        m_levels[level].maxVals[i * m_chans + k] = childMaxVal;
+                        const float minVal = m_levels[level].minVals[i * m_chans + k];
+                        const float childMinVal = m_levels[level + 1].minVals[ind * m_chans + k];
+                        if (childMinVal < minVal)
+                        {
+                            m_levels[level].minVals[i * m_chans + k] = childMinVal;
+                        }
+                        const float maxVal = m_levels[level].maxVals[i * m_chans + k];
+                        const float childMaxVal = m_levels[level + 1].maxVals[ind * m_chans + k];
+                        if (childMaxVal > maxVal)
+                        {
+                            m_levels[level].maxVals[i * m_chans + k] = childMaxVal;
+                        }
                     }
                 }
             }
         }
+    });
+}
+
+size_t InvLut3DRenderer::RangeTree::getMemorySize() const
+{
+    size_t numBytes = m_baseInds.capacity() * sizeof(baseInd)
+                    + m_levelScales.capacity() * sizeof(unsigned long);
+
+    for(const auto & level : m_levels)
+    {
+        numBytes += sizeof(treeLevel)
+                  + (level.minVals.capacity() + level.maxVals.capacity()) * sizeof(float)
+                  + (level.child0offsets.capacity() + level.numChildren.capacity())
+                        * sizeof(unsigned long);
     }
+
+    return numBytes;
 }
 
 void InvLut3DRenderer::RangeTree::initialize(float *grvec, unsigned long gsz)
@@ -1510,10 +2522,13 @@ void InvLut3DRenderer::RangeTree::initialize(float *grvec, unsigned long gsz)
     // Calculate hash for indices.
 
     const unsigned long cnt = (const unsigned long)m_baseInds.size();
-    for (unsigned long i = 0; i < cnt; i++)
+    ParallelForTreeRanges(cnt, [this](long, unsigned long begin, unsigned long end)
     {
-        indsToHash(i);
-    }
+        for (unsigned long i = begin; i < end; i++)
+        {
+            indsToHash(i);
+        }
+    });
 
     // Sort indices based on hash.
     std::sort(m_baseInds.begin(), m_baseInds.end());
@@ -1588,6 +2603,11 @@ float* extrapolate(float RGB[3], float center, float scale)
     return RGB;
 }
 
+size_t InvLut3DRenderer::getMemorySize() const
+{
+    return m_grvec.capacity() * sizeof(float) + m_tree.getMemorySize();
+}
+
 InvLut3DRenderer::InvLut3DRenderer(ConstLut3DOpDataRcPtr & lut)
     : OpCPU()
     , m_scale(0.0f)
@@ -1746,7 +2766,8 @@ void InvLut3DRenderer::extrapolate3DArray(ConstLut3DOpDataRcPtr & lut)
         }
     }
 
-    m_grvec = newArray.getValues();
+    const Array::Values & newValues = newArray.getValues();
+    m_grvec.assign(newValues.begin(), newValues.end());
 }
 
 // TODO apply() needs further optimization work.
@@ -1897,6 +2918,36 @@ void InvLut3DRenderer::apply(const void * inImg, void * outImg, long numPixels)
 ConstOpCPURcPtr GetForwardLut3DRenderer(ConstLut3DOpDataRcPtr & lut)
 {
     const Interpolation interp = lut->getConcreteInterpolation();
+
+    if (interp == INTERP_NEAREST)
+    {
+        return std::make_shared<Lut3DNearestRenderer>(lut);
+    }
+
+#if defined(OCIO_USE_AVX)
+    // The gather instructions only apply to the float LUT values.
+    if (!lut->isHalfStorage())
+    {
+        const CPUInfo & cpuInfo = CPUInfo::Instance();
+        if (cpuInfo.hasAVX512F())
+        {
+            if (interp == INTERP_TETRAHEDRAL)
+            {
+                return std::make_shared<Lut3DTetrahedralAVX512Renderer>(lut);
+            }
+            return std::make_shared<Lut3DAVX512Renderer>(lut);
+        }
+        else if (cpuInfo.hasAVX2())
+        {
+            if (interp == INTERP_TETRAHEDRAL)
+            {
+                return std::make_shared<Lut3DTetrahedralAVX2Renderer>(lut);
+            }
+            return std::make_shared<Lut3DAVX2Renderer>(lut);
+        }
+    }
+#endif
+
     if (interp == INTERP_TETRAHEDRAL)
     {
         return std::make_shared<Lut3DTetrahedralRenderer>(lut);
@@ -1909,6 +2960,36 @@ ConstOpCPURcPtr GetForwardLut3DRenderer(ConstLut3DOpDataRcPtr & lut)
 
 } // anonymous namspace
 
+bool IsLut3DRendererBitDepth(ConstLut3DOpDataRcPtr & lut, BitDepth inBitDepth)
+{
+    return inBitDepth == BIT_DEPTH_UINT8
+        && lut->getDirection() == TRANSFORM_DIR_FORWARD
+        && lut->getConcreteInterpolation() == INTERP_TETRAHEDRAL;
+}
+
+ConstOpCPURcPtr GetLut3DRenderer(ConstLut3DOpDataRcPtr & lut, BitDepth inBitDepth)
+{
+    if (!IsLut3DRendererBitDepth(lut, inBitDepth))
+    {
+        throw Exception("Unsupported input bit-depth for the 3D LUT renderer.");
+    }
+
+    return std::make_shared<Lut3DTetrahedralUInt8Renderer>(lut, ConstOpCPURcPtr());
+}
+
+ConstOpCPURcPtr GetShaperLut3DRenderer(ConstLut1DOpDataRcPtr & shaper,
+                                       ConstLut3DOpDataRcPtr & lut,
+                                       BitDepth inBitDepth)
+{
+    if (!IsLut3DRendererBitDepth(lut, inBitDepth))
+    {
+        throw Exception("Unsupported input bit-depth for the 3D LUT renderer.");
+    }
+
+    ConstOpCPURcPtr shaperRenderer = GetLut1DRenderer(shaper, inBitDepth, BIT_DEPTH_F32);
+    return std::make_shared<Lut3DTetrahedralUInt8Renderer>(lut, shaperRenderer);
+}
+
 ConstOpCPURcPtr GetLut3DRenderer(ConstLut3DOpDataRcPtr & lut)
 {
     if (lut->getDirection() == TRANSFORM_DIR_FORWARD)
@@ -1919,9 +3000,11 @@ ConstOpCPURcPtr GetLut3DRenderer(ConstLut3DOpDataRcPtr & lut)
     {
         if (lut->getConcreteInversionQuality() == LUT_INVERSION_FAST)
         {
-            ConstLut3DOpDataRcPtr newLut = MakeFastLut3DFromInverse(lut);
+            Lut3DOpDataRcPtr tmp = MakeFastLut3DFromInverse(lut);
+            tmp->setHalfStorage(lut->isHalfStorage());
 
             // Render with a Lut3D renderer.
+            ConstLut3DOpDataRcPtr newLut = tmp;
             return GetForwardLut3DRenderer(newLut);
         }
         else  // LUT_INVERSION_EXACT
@@ -1938,7 +3021,9 @@ OCIO_NAMESPACE_EXIT
 
 namespace OCIO = OCIO_NAMESPACE;
 
+#include <cstring>
 #include <limits>
+#include "CPUProcessor.h"
 #include "UnitTest.h"
 
 void Lut3DRendererNaNTest(OCIO::Interpolation interpol)
@@ -1985,4 +3070,365 @@ OCIO_ADD_TEST(Lut3DRenderer, nan_tetra_test)
     Lut3DRendererNaNTest(OCIO::INTERP_TETRAHEDRAL);
 }
 
+OCIO_ADD_TEST(Lut3DRenderer, blocked_layout)
+{
+    // From a grid size of 48, the renderers store the LUT entries in bricks (with
+    // padding entries when the grid size is not a multiple of 4).
+    constexpr unsigned long dim = 50;
+    OCIO::Lut3DOpDataRcPtr lut = std::make_shared<OCIO::Lut3DOpData>(dim);
+
+    OCIO::Array::Values & values = lut->getArray().getValues();
+    for (size_t idx = 0; idx < values.size(); ++idx)
+    {
+        values[idx] = float(idx) / float(values.size());
+    }
+
+    // The grid points (including the last ones) and a cell center.
+    const int gridPoints[4][3] = { { 0, 0, 0 }, { 3, 4, 5 }, { 49, 17, 48 }, { 49, 49, 49 } };
+
+    std::vector<float> img(4 * 5);
+    for (int pt = 0; pt < 4; ++pt)
+    {
+        for (int c = 0; c < 3; ++c)
+        {
+            img[4 * pt + c] = float(gridPoints[pt][c]) / float(dim - 1);
+        }
+        img[4 * pt + 3] = 1.0f;
+    }
+    img[16] = img[17] = img[18] = 4.5f / float(dim - 1);
+    img[19] = 1.0f;
+
+    for (auto interp : { OCIO::INTERP_LINEAR, OCIO::INTERP_TETRAHEDRAL })
+    {
+        lut->setInterpolation(interp);
+
+        OCIO::ConstLut3DOpDataRcPtr lutConst = lut;
+        std::vector<float> res(img.size());
+        OCIO::GetLut3DRenderer(lutConst)->apply(&img[0], &res[0], 5);
+
+        for (int pt = 0; pt < 4; ++pt)
+        {
+            const size_t idx = 3 * ((gridPoints[pt][0] * dim + gridPoints[pt][1]) * dim
+                                    + gridPoints[pt][2]);
+            OCIO_CHECK_CLOSE(res[4 * pt + 0], values[idx + 0], 1e-6f);
+            OCIO_CHECK_CLOSE(res[4 * pt + 1], values[idx + 1], 1e-6f);
+            OCIO_CHECK_CLOSE(res[4 * pt + 2], values[idx + 2], 1e-6f);
+        }
+
+        // The LUT being affine, the center of the cell [4, 5]^3 is the mean of its corners.
+        float mean[3] = { 0.0f, 0.0f, 0.0f };
+        for (int corner = 0; corner < 8; ++corner)
+        {
+            const size_t r = 4 + ((corner >> 2) & 1);
+            const size_t g = 4 + ((corner >> 1) & 1);
+            const size_t b = 4 + (corner & 1);
+            for (int c = 0; c < 3; ++c)
+            {
+                mean[c] += values[3 * ((r * dim + g) * dim + b) + c] / 8.0f;
+            }
+        }
+        OCIO_CHECK_CLOSE(res[16], mean[0], 1e-5f);
+        OCIO_CHECK_CLOSE(res[17], mean[1], 1e-5f);
+        OCIO_CHECK_CLOSE(res[18], mean[2], 1e-5f);
+    }
+}
+
+OCIO_ADD_TEST(Lut3DRenderer, half_storage)
+{
+    OCIO::Lut3DOpDataRcPtr lut = std::make_shared<OCIO::Lut3DOpData>(17);
+
+    OCIO::Array::Values & values = lut->getArray().getValues();
+    for (size_t idx = 0; idx < values.size(); ++idx)
+    {
+        values[idx] = std::sin(float(idx) * 0.01f) * 1.2f;
+    }
+    // Out of the half float range.
+    values[0] = 1e6f;
+
+    constexpr long numPixels = 37;
+    std::vector<float> img(4 * numPixels);
+    for (size_t idx = 0; idx < img.size(); ++idx)
+    {
+        img[idx] = float(idx % 13) * 0.09f - 0.1f;
+    }
+    // The first pixel is on the first LUT entry (i.e. the NaN is processed as 0).
+    img[0] = std::numeric_limits<float>::quiet_NaN();
+    img[1] = 0.0f;
+    img[2] = 0.0f;
+
+    for (auto interp : { OCIO::INTERP_LINEAR, OCIO::INTERP_TETRAHEDRAL })
+    {
+        lut->setInterpolation(interp);
+        lut->setHalfStorage(false);
+
+        OCIO::ConstLut3DOpDataRcPtr lutConst = lut;
+        std::vector<float> ref(img.size());
+        OCIO::GetLut3DRenderer(lutConst)->apply(&img[0], &ref[0], numPixels);
+
+        lut->setHalfStorage(true);
+        std::vector<float> res(img.size());
+        OCIO::GetLut3DRenderer(lutConst)->apply(&img[0], &res[0], numPixels);
+
+        // The half float values have 11 bits of precision.
+        for (size_t idx = 4; idx < img.size(); ++idx)
+        {
+            OCIO_CHECK_CLOSE(res[idx], ref[idx], 1e-3f);
+        }
+        // The first pixel uses the clamped out of range value.
+        OCIO_CHECK_EQUAL(res[0], HALF_MAX);
+        OCIO_CHECK_CLOSE(res[1], ref[1], 1e-3f);
+        OCIO_CHECK_CLOSE(res[2], ref[2], 1e-3f);
+    }
+}
+
+OCIO_ADD_TEST(Lut3DRenderer, shared_lut_memory)
+{
+    // The renderers of the same LUT values share their optimized LUT through the shared
+    // LUT memory, without changing the results.
+
+    OCIO::Lut3DOpDataRcPtr lut
+        = std::make_shared<OCIO::Lut3DOpData>(OCIO::INTERP_TETRAHEDRAL, 33);
+    OCIO::Array::Values & values = lut->getArray().getValues();
+    for (size_t idx = 0; idx < values.size(); ++idx)
+    {
+        // Unique values (i.e. not shared with another test process).
+        values[idx] = std::cos(float(idx) * 0.003f) + float(uintptr_t(&lut) % 997) * 1e-4f;
+    }
+    OCIO::ConstLut3DOpDataRcPtr lutConst = lut;
+
+    constexpr long numPixels = 1000;
+    std::vector<float> img(4 * numPixels);
+    for (size_t idx = 0; idx < img.size(); ++idx)
+    {
+        img[idx] = float(idx % 113) / 100.0f;
+    }
+
+    std::vector<float> expected(img.size());
+    OCIO::GetLut3DRenderer(lutConst)->apply(&img[0], &expected[0], numPixels);
+
+    const bool sharedMemory = OCIO::IsCPUSharedLutMemory();
+    OCIO::SetCPUSharedLutMemory(true);
+
+    OCIO::ConstOpCPURcPtr renderer1, renderer2;
+    OCIO_CHECK_NO_THROW(renderer1 = OCIO::GetLut3DRenderer(lutConst));
+    OCIO_CHECK_NO_THROW(renderer2 = OCIO::GetLut3DRenderer(lutConst));
+
+    OCIO::SetCPUSharedLutMemory(sharedMemory);
+
+    for (const auto & renderer : { renderer1, renderer2 })
+    {
+        std::vector<float> res(img.size());
+        renderer->apply(&img[0], &res[0], numPixels);
+        OCIO_CHECK_EQUAL(std::memcmp(&res[0], &expected[0], res.size() * sizeof(float)), 0);
+    }
+}
+
+OCIO_ADD_TEST(Lut3DRenderer, uint8_input)
+{
+    // The 8-bit renderer gives the results of the 32-bit float renderer processing the
+    // normalized codes, whatever the grid size (i.e. aligned or not with the codes).
+
+    for (unsigned long dim : { 2ul, 17ul, 33ul, 50ul })
+    {
+        OCIO::Lut3DOpDataRcPtr lut
+            = std::make_shared<OCIO::Lut3DOpData>(OCIO::INTERP_TETRAHEDRAL, dim);
+
+        OCIO::Array::Values & values = lut->getArray().getValues();
+        for (size_t idx = 0; idx < values.size(); ++idx)
+        {
+            values[idx] = std::sin(float(idx) * 0.01f) * 1.2f;
+        }
+
+        OCIO::ConstLut3DOpDataRcPtr lutConst = lut;
+        OCIO_CHECK_ASSERT(OCIO::IsLut3DRendererBitDepth(lutConst, OCIO::BIT_DEPTH_UINT8));
+        OCIO_CHECK_ASSERT(!OCIO::IsLut3DRendererBitDepth(lutConst, OCIO::BIT_DEPTH_UINT16));
+        OCIO_CHECK_ASSERT(!OCIO::IsLut3DRendererBitDepth(lutConst, OCIO::BIT_DEPTH_F32));
+
+        // All the codes along each axis, with ties between the fractional positions.
+        constexpr long numPixels = 3 * 256 + 2;
+        std::vector<uint8_t> codes(4 * numPixels);
+        for (long idx = 0; idx < 256; ++idx)
+        {
+            for (long c = 0; c < 3; ++c)
+            {
+                uint8_t * pxl = &codes[4 * (c * 256 + idx)];
+                pxl[0] = uint8_t((idx * 7 + c * 31) % 256);
+                pxl[1] = uint8_t((idx * 13 + c * 17) % 256);
+                pxl[2] = uint8_t((idx * 29 + c * 5) % 256);
+                pxl[3] = uint8_t(idx);
+                pxl[c] = uint8_t(idx);
+            }
+        }
+        for (long c = 0; c < 4; ++c)
+        {
+            codes[4 * 3 * 256 + c] = 128;
+            codes[4 * 3 * 256 + 4 + c] = 255;
+        }
+
+        std::vector<float> img(codes.size());
+        for (size_t idx = 0; idx < codes.size(); ++idx)
+        {
+            img[idx] = float(codes[idx]) * (1.0f / 255.0f);
+        }
+
+        for (bool halfStorage : { false, true })
+        {
+            lut->setHalfStorage(halfStorage);
+
+            std::vector<float> ref(img.size());
+            OCIO::Lut3DTetrahedralRenderer(lutConst).apply(&img[0], &ref[0], numPixels);
+
+            std::vector<float> res(img.size());
+            OCIO::ConstOpCPURcPtr renderer;
+            OCIO_CHECK_NO_THROW(renderer = OCIO::GetLut3DRenderer(lutConst,
+                                                                  OCIO::BIT_DEPTH_UINT8));
+            renderer->apply(&codes[0], &res[0], numPixels);
+
+#ifdef USE_SSE
+            OCIO_CHECK_ASSERT(res == ref);
+#else
+            for (size_t idx = 0; idx < res.size(); ++idx)
+            {
+                OCIO_CHECK_CLOSE(res[idx], ref[idx], 1e-6f);
+            }
+#endif
+        }
+    }
+
+    // Only the forward tetrahedral 3D LUTs are supported.
+    OCIO::Lut3DOpDataRcPtr lut = std::make_shared<OCIO::Lut3DOpData>(OCIO::INTERP_LINEAR, 17);
+    OCIO::ConstLut3DOpDataRcPtr lutConst = lut;
+    OCIO_CHECK_ASSERT(!OCIO::IsLut3DRendererBitDepth(lutConst, OCIO::BIT_DEPTH_UINT8));
+    OCIO_CHECK_THROW_WHAT(OCIO::GetLut3DRenderer(lutConst, OCIO::BIT_DEPTH_UINT8),
+                          OCIO::Exception,
+                          "Unsupported input bit-depth for the 3D LUT renderer");
+}
+
+OCIO_ADD_TEST(Lut3DRenderer, interpolation_quality)
+{
+    constexpr unsigned long dim = 9;
+    OCIO::Lut3DOpDataRcPtr lut = std::make_shared<OCIO::Lut3DOpData>(OCIO::INTERP_TETRAHEDRAL,
+                                                                     dim);
+    OCIO::Array::Values & values = lut->getArray().getValues();
+    for (size_t idx = 0; idx < values.size(); ++idx)
+    {
+        values[idx] = std::sin(float(idx) * 0.01f) * 0.5f + 0.5f;
+    }
+
+    constexpr long numPixels = 4;
+    const float img[4 * numPixels] = {  0.10f,  0.40f, 0.90f, 0.5f,
+                                        0.00f,  1.00f, 0.51f, 1.0f,
+                                       -0.20f,  1.30f, 0.24f, 0.0f,
+                                        0.74f,  0.26f, 0.49f, 1.0f };
+
+    // The draft quality renders the nearest LUT entry.
+    lut->setInterpolationQuality(OCIO::LUT_INTERPOLATION_DRAFT);
+    OCIO::ConstLut3DOpDataRcPtr lutConst = lut;
+    OCIO::ConstOpCPURcPtr renderer = OCIO::GetLut3DRenderer(lutConst);
+    OCIO_CHECK_EQUAL(OCIO::GetRendererName(*renderer), std::string("Lut3DNearestRenderer"));
+
+    std::vector<float> res(4 * numPixels);
+    renderer->apply(img, &res[0], numPixels);
+
+    for (long pix = 0; pix < numPixels; ++pix)
+    {
+        size_t index[3];
+        for (int c = 0; c < 3; ++c)
+        {
+            const float pos = std::min(std::max(img[4 * pix + c], 0.0f), 1.0f) * (dim - 1);
+            index[c] = size_t(pos + 0.5f);
+        }
+        const size_t idx = 3 * ((index[0] * dim + index[1]) * dim + index[2]);
+
+        OCIO_CHECK_EQUAL(res[4 * pix + 0], values[idx + 0]);
+        OCIO_CHECK_EQUAL(res[4 * pix + 1], values[idx + 1]);
+        OCIO_CHECK_EQUAL(res[4 * pix + 2], values[idx + 2]);
+        OCIO_CHECK_EQUAL(res[4 * pix + 3], img[4 * pix + 3]);
+    }
+
+    // The preview quality renders the trilinear interpolation.
+    lut->setInterpolationQuality(OCIO::LUT_INTERPOLATION_PREVIEW);
+    std::vector<float> ref(4 * numPixels);
+    OCIO::Lut3DRenderer(lutConst).apply(img, &ref[0], numPixels);
+    OCIO::GetLut3DRenderer(lutConst)->apply(img, &res[0], numPixels);
+    for (size_t idx = 0; idx < res.size(); ++idx)
+    {
+        OCIO_CHECK_CLOSE(res[idx], ref[idx], 1e-6f);
+    }
+}
+
+#if defined(OCIO_USE_AVX)
+OCIO_ADD_TEST(Lut3DRenderer, avx_renderers)
+{
+    // The AVX renderers must produce exactly the same results as the SSE ones.
+
+    OCIO::Lut3DOpDataRcPtr lut = std::make_shared<OCIO::Lut3DOpData>(17);
+
+    OCIO::Array::Values & values = lut->getArray().getValues();
+    for (size_t idx = 0; idx < values.size(); ++idx)
+    {
+        values[idx] = std::sin(float(idx) * 0.01f) * 1.2f;
+    }
+
+    OCIO::ConstLut3DOpDataRcPtr lutConst = lut;
+
+    // Not a multiple of 16 pixels to exercise the remaining pixels.
+    constexpr long numPixels = 37;
+    std::vector<float> img(4 * numPixels);
+    for (size_t idx = 0; idx < img.size(); ++idx)
+    {
+        img[idx] = float(idx % 13) * 0.09f - 0.1f;
+    }
+    // Check the clamping and the cell boundaries.
+    img[0] = std::numeric_limits<float>::quiet_NaN();
+    img[1] = std::numeric_limits<float>::infinity();
+    img[2] = -std::numeric_limits<float>::infinity();
+    img[4] = 0.5f;
+    img[5] = 1.0f;
+    img[6] = 0.0f;
+
+    const OCIO::CPUInfo & cpuInfo = OCIO::CPUInfo::Instance();
+
+    {
+        const OCIO::Lut3DTetrahedralRenderer ref(lutConst);
+        std::vector<float> refRes(img.size());
+        ref.apply(&img[0], &refRes[0], numPixels);
+
+        if (cpuInfo.hasAVX2())
+        {
+            std::vector<float> res(img);
+            OCIO::Lut3DTetrahedralAVX2Renderer(lutConst).apply(&res[0], &res[0], numPixels);
+            OCIO_CHECK_ASSERT(res == refRes);
+        }
+
+        if (cpuInfo.hasAVX512F())
+        {
+            std::vector<float> res(img);
+            OCIO::Lut3DTetrahedralAVX512Renderer(lutConst).apply(&res[0], &res[0], numPixels);
+            OCIO_CHECK_ASSERT(res == refRes);
+        }
+    }
+
+    {
+        const OCIO::Lut3DRenderer ref(lutConst);
+        std::vector<float> refRes(img.size());
+        ref.apply(&img[0], &refRes[0], numPixels);
+
+        if (cpuInfo.hasAVX2())
+        {
+            std::vector<float> res(img);
+            OCIO::Lut3DAVX2Renderer(lutConst).apply(&res[0], &res[0], numPixels);
+            OCIO_CHECK_ASSERT(res == refRes);
+        }
+
+        if (cpuInfo.hasAVX512F())
+        {
+            std::vector<float> res(img);
+            OCIO::Lut3DAVX512Renderer(lutConst).apply(&res[0], &res[0], numPixels);
+            OCIO_CHECK_ASSERT(res == refRes);
+        }
+    }
+}
+#endif
+
 #endif
@@ -8,6 +8,7 @@
 #include <OpenColorIO/OpenColorIO.h>
 
 #include "Op.h"
+#include "ops/Lut1D/Lut1DOpData.h"
 #include "ops/Lut3D/Lut3DOpData.h"
 
 OCIO_NAMESPACE_ENTER
@@ -15,6 +16,23 @@ OCIO_NAMESPACE_ENTER
 
 ConstOpCPURcPtr GetLut3DRenderer(ConstLut3DOpDataRcPtr & lut);
 
+// Could the 3D LUT directly process the integer input pixels of that bit-depth (i.e. the
+// 8-bit forward tetrahedral 3D LUTs)?
+bool IsLut3DRendererBitDepth(ConstLut3DOpDataRcPtr & lut, BitDepth inBitDepth);
+
+// Get the renderer processing integer input pixels to 32-bit float output pixels. It throws
+// if the input bit-depth is not supported, refer to IsLut3DRendererBitDepth().
+ConstOpCPURcPtr GetLut3DRenderer(ConstLut3DOpDataRcPtr & lut, BitDepth inBitDepth);
+
+// Get the renderer processing integer input pixels with the shaper 1D LUT followed by the
+// 3D LUT (i.e. the layout of the baked LUT formats) in one pass. The shaper results are
+// precomputed as grid coordinates of the 3D LUT so the processing costs as much as the 3D LUT
+// alone. It throws if the input bit-depth is not supported, refer to
+// IsLut3DRendererBitDepth().
+ConstOpCPURcPtr GetShaperLut3DRenderer(ConstLut1DOpDataRcPtr & shaper,
+                                       ConstLut3DOpDataRcPtr & lut,
+                                       BitDepth inBitDepth);
+
 }
 OCIO_NAMESPACE_EXIT
 
@@ -1,14 +1,19 @@
 // SPDX-License-Identifier: BSD-3-Clause
 // Copyright Contributors to the OpenColorIO Project.
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <map>
 #include <sstream>
 
 #include <OpenColorIO/OpenColorIO.h>
 
 #include "BitDepthUtils.h"
+#include "CacheStatistics.h"
 #include "HashUtils.h"
 #include "MathUtils.h"
-#include "md5/md5.h"
+#include "Mutex.h"
 #include "ops/Lut3D/Lut3DOp.h"
 #include "ops/Lut3D/Lut3DOpData.h"
 #include "ops/Range/RangeOpData.h"
@@ -18,6 +23,38 @@
 OCIO_NAMESPACE_ENTER
 {
 
+namespace
+{
+
+// The fast inverses are expensive to compute so their values are cached by the
+// cache identifier of the inverse LUT (i.e. which includes the values, the
+// interpolation and the direction of the LUT).
+typedef std::map<std::string, Array::Values> FastInverseCacheMap;
+
+FastInverseCacheMap g_fastInverseCache;
+Mutex g_fastInverseCacheLock;
+
+}
+
+void ClearLut3DFastInverseCache()
+{
+    AutoMutex lock(g_fastInverseCacheLock);
+    g_fastInverseCache.clear();
+}
+
+size_t GetLut3DFastInverseCacheMemoryUsage()
+{
+    AutoMutex lock(g_fastInverseCacheLock);
+
+    size_t numBytes = 0;
+    for(const auto & entry : g_fastInverseCache)
+    {
+        numBytes += entry.first.capacity() + entry.second.capacity() * sizeof(float);
+    }
+
+    return numBytes;
+}
+
 Lut3DOpDataRcPtr MakeFastLut3DFromInverse(ConstLut3DOpDataRcPtr & lut)
 {
     if (lut->getDirection() != TRANSFORM_DIR_INVERSE)
@@ -25,11 +62,6 @@ Lut3DOpDataRcPtr MakeFastLut3DFromInverse(ConstLut3DOpDataRcPtr & lut)
         throw Exception("MakeFastLut3DFromInverse expects an inverse LUT");
     }
 
-    // The composition needs to use the EXACT renderer.
-    // (Also avoids infinite loop.)
-    // So temporarily set the style to EXACT.
-    LutStyleGuard<Lut3DOpData> guard(*lut);
-
     // Make a domain for the composed Lut3D.
     // TODO: Using a large number like 48 here is better for accuracy, 
     // but it causes a delay when creating the renderer. 
@@ -38,8 +70,35 @@ Lut3DOpDataRcPtr MakeFastLut3DFromInverse(ConstLut3DOpDataRcPtr & lut)
 
     newDomain->setFileOutputBitDepth(lut->getFileOutputBitDepth());
 
-    // Compose the LUT newDomain with our inverse LUT (using INV_EXACT style).
-    Lut3DOpData::Compose(newDomain, lut);
+    // Only a finalized LUT has a cache identifier.
+    const std::string cacheID = lut->getCacheID();
+    CacheStatistics & statistics = GetCacheStatistics(CACHE_LUT3D_FAST_INVERSE);
+    if (!cacheID.empty())
+    {
+        AutoTimedMutex lock(g_fastInverseCacheLock, statistics);
+        FastInverseCacheMap::const_iterator iter = g_fastInverseCache.find(cacheID);
+        if (iter != g_fastInverseCache.end())
+        {
+            statistics.addHit();
+
+            // Same metadata as the composition result.
+            newDomain->getFormatMetadata().combine(lut->getFormatMetadata());
+            newDomain->getArray().getValues() = iter->second;
+            return newDomain;
+        }
+
+        statistics.addMiss();
+    }
+
+    {
+        // The composition needs to use the EXACT renderer.
+        // (Also avoids infinite loop.)
+        // So temporarily set the style to EXACT.
+        LutStyleGuard<Lut3DOpData> guard(*lut);
+
+        // Compose the LUT newDomain with our inverse LUT (using INV_EXACT style).
+        Lut3DOpData::Compose(newDomain, lut);
+    }
 
     // The INV_EXACT inversion style computes an inverse to the tetrahedral
     // style of forward evalutation.
@@ -47,6 +106,16 @@ Lut3DOpDataRcPtr MakeFastLut3DFromInverse(ConstLut3DOpDataRcPtr & lut)
     // not seem to help accuracy (and is slower).  To investigate ...
     //newLut->setInterpolation(INTERP_TETRAHEDRAL);
 
+    if (!cacheID.empty())
+    {
+        AutoTimedMutex lock(g_fastInverseCacheLock, statistics);
+        if (g_fastInverseCache.find(cacheID) == g_fastInverseCache.end())
+        {
+            statistics.addInsertion();
+        }
+        g_fastInverseCache[cacheID] = newDomain->getArray().getValues();
+    }
+
     return newDomain;
 }
 
@@ -310,6 +379,20 @@ void Lut3DOpData::setInterpolation(Interpolation algo)
 
 Interpolation Lut3DOpData::getConcreteInterpolation() const
 {
+    // NB: Only the draft interpolation quality of the processor really uses the nearest
+    // entries i.e. without changing the processing of the 'Nearest' LUTs.
+    if (m_direction == TRANSFORM_DIR_FORWARD)
+    {
+        if (m_interpQuality == LUT_INTERPOLATION_DRAFT)
+        {
+            return INTERP_NEAREST;
+        }
+        else if (m_interpQuality == LUT_INTERPOLATION_PREVIEW)
+        {
+            return INTERP_LINEAR;
+        }
+    }
+
     switch (m_interpolation)
     {
     case INTERP_BEST:
@@ -349,6 +432,11 @@ void Lut3DOpData::setInversionQuality(LutInversionQuality style)
     m_invQuality = style;
 }
 
+void Lut3DOpData::setInterpolationQuality(LutInterpolationQuality quality)
+{
+    m_interpQuality = quality;
+}
+
 void Lut3DOpData::setArrayFromRedFastestOrder(const std::vector<float> & lut)
 {
     Array & lutArray = getArray();
@@ -471,7 +559,8 @@ bool Lut3DOpData::operator==(const OpData & other) const
 
     // NB: The m_invQuality is not currently included.
     if (m_direction != lop->m_direction
-        || m_interpolation != lop->m_interpolation)
+        || m_interpolation != lop->m_interpolation
+        || m_interpQuality != lop->m_interpQuality)
     {
         return false;
     }
@@ -515,19 +604,14 @@ void Lut3DOpData::finalize()
 
     validate();
 
-    md5_state_t state;
-    md5_byte_t digest[16];
-
-    md5_init(&state);
-    md5_append(&state,
-               (const md5_byte_t *)&(getArray().getValues()[0]),
-               (int)(getArray().getValues().size() * sizeof(float)));
-    md5_finish(&state, digest);
-
     std::ostringstream cacheIDStream;
-    cacheIDStream << GetPrintableHash(digest) << " ";
+    cacheIDStream << m_array.getValuesHash() << " ";
     cacheIDStream << InterpolationToString(m_interpolation) << " ";
     cacheIDStream << TransformDirectionToString(m_direction) << " ";
+    if (m_interpQuality != LUT_INTERPOLATION_FULL)
+    {
+        cacheIDStream << GetInterpQualityName(m_interpQuality) << " ";
+    }
     // NB: The m_invQuality is not currently included.
 
     m_cacheID = cacheIDStream.str();
@@ -538,6 +622,146 @@ void Lut3DOpData::scale(float scale)
     getArray().scale(scale);
 }
 
+float InterpolateCellTrilinear(const float (&v)[8], float fr, float fg, float fb)
+{
+    const float v00 = v[0] + (v[1] - v[0]) * fb;
+    const float v01 = v[2] + (v[3] - v[2]) * fb;
+    const float v10 = v[4] + (v[5] - v[4]) * fb;
+    const float v11 = v[6] + (v[7] - v[6]) * fb;
+
+    const float v0 = v00 + (v01 - v00) * fg;
+    const float v1 = v10 + (v11 - v10) * fg;
+
+    return v0 + (v1 - v0) * fr;
+}
+
+float InterpolateCellTetrahedral(const float (&v)[8], float fr, float fg, float fb)
+{
+    // Walk the cell edges from the corner 0 to the corner 7 in decreasing order of the
+    // fractional parts.
+    float f[3]   = { fr, fg, fb };
+    int   bit[3] = { 4, 2, 1 };
+
+    for (int i = 0; i < 2; ++i)
+    {
+        for (int j = 2; j > i; --j)
+        {
+            if (f[j] > f[j - 1])
+            {
+                std::swap(f[j], f[j - 1]);
+                std::swap(bit[j], bit[j - 1]);
+            }
+        }
+    }
+
+    const int c1 = bit[0];
+    const int c2 = c1 + bit[1];
+
+    return (1.f - f[0]) * v[0] + (f[0] - f[1]) * v[c1] + (f[1] - f[2]) * v[c2] + f[2] * v[7];
+}
+
+namespace
+{
+// Does the sub-grid of every step-th grid point reproduce all the LUT values?
+bool IsSubGridAccurate(const Array::Values & values, unsigned long dim, unsigned long step,
+                       bool tetrahedral, float tolerance)
+{
+    const unsigned long last = dim - 1;
+
+    for (unsigned long r = 0; r < dim; ++r)
+    {
+        const unsigned long r0 = std::min(r / step * step, last - step);
+        const float fr = float(r - r0) / float(step);
+
+        for (unsigned long g = 0; g < dim; ++g)
+        {
+            const unsigned long g0 = std::min(g / step * step, last - step);
+            const float fg = float(g - g0) / float(step);
+
+            for (unsigned long b = 0; b < dim; ++b)
+            {
+                const unsigned long b0 = std::min(b / step * step, last - step);
+                const float fb = float(b - b0) / float(step);
+
+                for (unsigned long c = 0; c < 3; ++c)
+                {
+                    float v[8];
+                    for (unsigned long corner = 0; corner < 8; ++corner)
+                    {
+                        const unsigned long idx
+                            = ((r0 + (corner >> 2) * step) * dim
+                               + g0 + ((corner >> 1) & 1) * step) * dim
+                              + b0 + (corner & 1) * step;
+                        v[corner] = values[idx * 3 + c];
+                    }
+
+                    const float val = tetrahedral ? InterpolateCellTetrahedral(v, fr, fg, fb)
+                                                  : InterpolateCellTrilinear(v, fr, fg, fb);
+
+                    // Note that a NaN value is never accurate.
+                    if (!(std::fabs(val - values[((r * dim + g) * dim + b) * 3 + c])
+                          <= tolerance))
+                    {
+                        return false;
+                    }
+                }
+            }
+        }
+    }
+
+    return true;
+}
+}
+
+Lut3DOpDataRcPtr Lut3DOpData::makeCompact(float tolerance) const
+{
+    const unsigned long dim = (unsigned long)getGridSize();
+    const Array::Values & values = getArray().getValues();
+
+    const bool tetrahedral = getConcreteInterpolation() == INTERP_TETRAHEDRAL;
+
+    // Look for the largest accurate step i.e. the smallest sub-grid.
+    unsigned long bestStep = 1;
+    for (unsigned long step = 2; (dim - 1) % step == 0; step *= 2)
+    {
+        if (!IsSubGridAccurate(values, dim, step, tetrahedral, tolerance))
+        {
+            break;
+        }
+        bestStep = step;
+    }
+
+    if (bestStep == 1)
+    {
+        return Lut3DOpDataRcPtr();
+    }
+
+    const unsigned long subDim = (dim - 1) / bestStep + 1;
+
+    Lut3DOpDataRcPtr lut = clone();
+    lut->getArray().resize(subDim, 3);
+
+    Array::Values & subValues = lut->getArray().getValues();
+    for (unsigned long r = 0; r < subDim; ++r)
+    {
+        for (unsigned long g = 0; g < subDim; ++g)
+        {
+            for (unsigned long b = 0; b < subDim; ++b)
+            {
+                const unsigned long src
+                    = ((r * bestStep * dim + g * bestStep) * dim + b * bestStep) * 3;
+                const unsigned long dst = ((r * subDim + g) * subDim + b) * 3;
+
+                subValues[dst + 0] = values[src + 0];
+                subValues[dst + 1] = values[src + 1];
+                subValues[dst + 2] = values[src + 2];
+            }
+        }
+    }
+
+    return lut;
+}
+
 }
 OCIO_NAMESPACE_EXIT
 
@@ -687,6 +911,32 @@ OCIO_ADD_TEST(Lut3DOpData, interpolation)
     OCIO_CHECK_THROW_WHAT(l.validate(), OCIO::Exception, "invalid interpolation");
 }
 
+OCIO_ADD_TEST(Lut3DOpData, interpolation_quality)
+{
+    OCIO::Lut3DOpData l(OCIO::INTERP_TETRAHEDRAL, 2);
+    OCIO_CHECK_EQUAL(l.getInterpolationQuality(), OCIO::LUT_INTERPOLATION_FULL);
+    OCIO_CHECK_NO_THROW(l.finalize());
+
+    OCIO::Lut3DOpData preview(OCIO::INTERP_TETRAHEDRAL, 2);
+    preview.setInterpolationQuality(OCIO::LUT_INTERPOLATION_PREVIEW);
+    OCIO_CHECK_EQUAL(preview.getConcreteInterpolation(), OCIO::INTERP_LINEAR);
+    OCIO_CHECK_ASSERT(!(l == preview));
+    OCIO_CHECK_NO_THROW(preview.finalize());
+    OCIO_CHECK_NE(preview.getCacheID(), l.getCacheID());
+
+    OCIO::Lut3DOpData draft(OCIO::INTERP_TETRAHEDRAL, 2);
+    draft.setInterpolationQuality(OCIO::LUT_INTERPOLATION_DRAFT);
+    OCIO_CHECK_EQUAL(draft.getConcreteInterpolation(), OCIO::INTERP_NEAREST);
+    OCIO_CHECK_NO_THROW(draft.finalize());
+    OCIO_CHECK_NE(draft.getCacheID(), preview.getCacheID());
+
+    // The inverse 3D LUTs are not affected.
+    OCIO::Lut3DOpData inverse(2, OCIO::TRANSFORM_DIR_INVERSE);
+    inverse.setInterpolation(OCIO::INTERP_TETRAHEDRAL);
+    inverse.setInterpolationQuality(OCIO::LUT_INTERPOLATION_DRAFT);
+    OCIO_CHECK_EQUAL(inverse.getConcreteInterpolation(), OCIO::INTERP_TETRAHEDRAL);
+}
+
 OCIO_ADD_TEST(Lut3DOpData, inversion_quality)
 {
     OCIO::Lut3DOpData l(2);
@@ -886,5 +1136,123 @@ OCIO_ADD_TEST(Lut3DOpData, inv_lut3d_lut_size)
     OCIO_CHECK_EQUAL(invFastLutData->getArray().getLength(), 48);
 }
 
-#endif
+OCIO_ADD_TEST(Lut3DOpData, fast_inverse_cache)
+{
+    const std::string fileName("lut3d_17x17x17_10i_12i.clf");
+    OCIO::OpRcPtrVec ops;
+    OCIO::ContextRcPtr context = OCIO::Context::Create();
+    OCIO_CHECK_NO_THROW(BuildOpsTest(ops, fileName, context,
+                                     OCIO::TRANSFORM_DIR_FORWARD));
+
+    OCIO_REQUIRE_EQUAL(2, ops.size());
+
+    auto op1 = std::dynamic_pointer_cast<const OCIO::Op>(ops[1]);
+    OCIO_REQUIRE_ASSERT(op1);
+    auto fwdLutData = std::dynamic_pointer_cast<const OCIO::Lut3DOpData>(op1->data());
+    OCIO_REQUIRE_ASSERT(fwdLutData);
+
+    OCIO::Lut3DOpDataRcPtr invLutData = fwdLutData->inverse();
+    OCIO::ConstLut3DOpDataRcPtr constInvLutData = invLutData;
+
+    // Not finalized i.e. no cache identifier.
+    OCIO::ClearLut3DFastInverseCache();
+    OCIO::Lut3DOpDataRcPtr uncached = MakeFastLut3DFromInverse(constInvLutData);
+
+    invLutData->finalize();
+    OCIO_REQUIRE_ASSERT(!invLutData->getCacheID().empty());
 
+    OCIO::Lut3DOpDataRcPtr computed = MakeFastLut3DFromInverse(constInvLutData);
+    OCIO::Lut3DOpDataRcPtr cached = MakeFastLut3DFromInverse(constInvLutData);
+
+    // The cached inverse is a distinct but identical LUT.
+    OCIO_CHECK_NE(cached.get(), computed.get());
+    OCIO_CHECK_ASSERT(*cached == *computed);
+    OCIO_CHECK_ASSERT(*cached == *uncached);
+    OCIO_CHECK_EQUAL(cached->getFileOutputBitDepth(), OCIO::BIT_DEPTH_UINT12);
+    OCIO_CHECK_EQUAL(cached->getInversionQuality(), computed->getInversionQuality());
+
+    // Changing a result does not change the cache.
+    cached->getArray().getValues()[0] = 0.5f;
+    OCIO::Lut3DOpDataRcPtr cached2 = MakeFastLut3DFromInverse(constInvLutData);
+    OCIO_CHECK_ASSERT(*cached2 == *computed);
+
+    OCIO::ClearLut3DFastInverseCache();
+}
+
+namespace
+{
+// Add a residual (of the red and green components) to the identity LUT values.
+void AddResidual(OCIO::Lut3DOpData & lut, float (*residual)(float r, float g))
+{
+    OCIO::Array::Values & values = lut.getArray().getValues();
+    for (size_t idx = 0; idx < values.size(); idx += 3)
+    {
+        const float delta = residual(values[idx + 0], values[idx + 1]);
+        values[idx + 0] += delta;
+        values[idx + 1] += delta;
+        values[idx + 2] += delta;
+    }
+}
+}
+
+OCIO_ADD_TEST(Lut3DOpData, make_compact)
+{
+    // An identity LUT only needs the corners.
+    OCIO::Lut3DOpData identity(OCIO::INTERP_TETRAHEDRAL, 33);
+    OCIO::Lut3DOpDataRcPtr compact = identity.makeCompact(1e-6f);
+    OCIO_REQUIRE_ASSERT(compact);
+    OCIO_CHECK_EQUAL(compact->getGridSize(), 2);
+    OCIO_CHECK_EQUAL(compact->getInterpolation(), OCIO::INTERP_TETRAHEDRAL);
+    OCIO_CHECK_ASSERT(compact->isIdentity());
+    OCIO_CHECK_NO_THROW(compact->validate());
+
+    // An affine residual is also interpolated exactly.
+    OCIO::Lut3DOpData affine(OCIO::INTERP_TETRAHEDRAL, 33);
+    AddResidual(affine, [](float r, float g) { return 0.01f * r - 0.02f * g; });
+    compact = affine.makeCompact(1e-6f);
+    OCIO_REQUIRE_ASSERT(compact);
+    OCIO_CHECK_EQUAL(compact->getGridSize(), 2);
+    OCIO_CHECK_CLOSE(compact->getArray().getValues()[21], 1.f + 0.01f - 0.02f, 1e-6f);
+
+    // A bilinear residual is only interpolated exactly by the trilinear interpolation.
+    OCIO::Lut3DOpData bilinear(OCIO::INTERP_LINEAR, 33);
+    AddResidual(bilinear, [](float r, float g) { return 0.05f * r * g; });
+    compact = bilinear.makeCompact(1e-6f);
+    OCIO_REQUIRE_ASSERT(compact);
+    OCIO_CHECK_EQUAL(compact->getGridSize(), 2);
+
+    bilinear.setInterpolation(OCIO::INTERP_TETRAHEDRAL);
+    OCIO_CHECK_ASSERT(!bilinear.makeCompact(1e-6f));
+
+    // A smooth residual needs the sub-grid whose interpolation error is within the tolerance.
+    OCIO::Lut3DOpData smooth(OCIO::INTERP_LINEAR, 33);
+    AddResidual(smooth, [](float r, float) { return 1e-4f * r * r; });
+    compact = smooth.makeCompact(1e-6f);
+    OCIO_REQUIRE_ASSERT(compact);
+    OCIO_CHECK_EQUAL(compact->getGridSize(), 9);
+
+    // The sub-grid values are the LUT ones.
+    const OCIO::Array::Values & subValues = compact->getArray().getValues();
+    const OCIO::Array::Values & values = smooth.getArray().getValues();
+    OCIO_CHECK_EQUAL(subValues[((1 * 9 + 2) * 9 + 3) * 3], values[((4 * 33 + 8) * 33 + 12) * 3]);
+
+    // A larger tolerance allows a smaller sub-grid.
+    compact = smooth.makeCompact(1e-5f);
+    OCIO_REQUIRE_ASSERT(compact);
+    OCIO_CHECK_EQUAL(compact->getGridSize(), 3);
+
+    // A local change (or a NaN) needs the whole grid.
+    OCIO::Lut3DOpData local(OCIO::INTERP_LINEAR, 33);
+    local.getArray().getValues()[((16 * 33 + 16) * 33 + 15) * 3] += 0.001f;
+    OCIO_CHECK_ASSERT(!local.makeCompact(1e-6f));
+
+    OCIO::Lut3DOpData nan(OCIO::INTERP_LINEAR, 5);
+    nan.getArray().getValues()[0] = std::numeric_limits<float>::quiet_NaN();
+    OCIO_CHECK_ASSERT(!nan.makeCompact(1e-6f));
+
+    // The grid size has to be a multiple of 2 plus 1.
+    OCIO::Lut3DOpData even(OCIO::INTERP_LINEAR, 32);
+    OCIO_CHECK_ASSERT(!even.makeCompact(1e-6f));
+}
+
+#endif
@@ -19,6 +19,11 @@ class Lut3DOpData;
 typedef OCIO_SHARED_PTR<Lut3DOpData> Lut3DOpDataRcPtr;
 typedef OCIO_SHARED_PTR<const Lut3DOpData> ConstLut3DOpDataRcPtr;
 
+// Interpolate a grid cell whose corner values are indexed by (r * 4 + g * 2 + b) at the
+// fractional position (fr, fg, fb).
+float InterpolateCellTrilinear(const float (&v)[8], float fr, float fg, float fb);
+float InterpolateCellTetrahedral(const float (&v)[8], float fr, float fg, float fb);
+
 class Lut3DOpData : public OpData
 {
 public:
@@ -65,6 +70,16 @@ public:
 
     void setInversionQuality(LutInversionQuality style);
 
+    // The interpolation quality requested by the processor (refer to
+    // LutInterpolationQuality) which replaces the interpolation of a forward LUT.
+    inline LutInterpolationQuality getInterpolationQuality() const { return m_interpQuality; }
+    void setInterpolationQuality(LutInterpolationQuality quality);
+
+    // The CPU renderer stores the LUT values as half floats when true, in order to
+    // halve its memory footprint (refer to SetCPULut3DHalfStorage()).
+    inline bool isHalfStorage() const { return m_halfStorage; }
+    inline void setHalfStorage(bool halfStorage) { m_halfStorage = halfStorage; }
+
     // Note: The Lut3DOpData Array stores the values in blue-fastest order.
     inline const Array & getArray() const { return m_array; }
     inline Array & getArray() { return m_array; }
@@ -84,6 +99,7 @@ public:
     bool isIdentity() const override;
 
     bool hasChannelCrosstalk() const override { return true; }
+    bool touchesAlpha() const override { return false; }
 
     OpDataRcPtr getIdentityReplacement() const;
 
@@ -102,6 +118,15 @@ public:
 
     void scale(float scale);
 
+    // Get a copy of the LUT on the smallest sub-grid (i.e. every 2^n-th grid point) whose
+    // interpolation reproduces all the LUT values within the tolerance, or null if there
+    // is none. As any grid size interpolates the identity exactly, a LUT which is an
+    // identity plus low-frequency changes (e.g. a grade) only needs the resolution of the
+    // changes. Note that the trilinear interpolation of the sub-grid then differs from the
+    // LUT one by at most the tolerance (i.e. the difference is trilinear in each LUT cell),
+    // and the tetrahedral one by about the tolerance.
+    Lut3DOpDataRcPtr makeCompact(float tolerance) const;
+
 protected:
     // Test core parts of LUTs for equality.
     bool haveEqualBasics(const Lut3DOpData & B) const;
@@ -146,6 +171,9 @@ private:
 
     TransformDirection  m_direction;
     LutInversionQuality m_invQuality;
+    bool                m_halfStorage = false;
+
+    LutInterpolationQuality m_interpQuality = LUT_INTERPOLATION_FULL;
 
     // Out bit-depth to be used for file I/O.
     BitDepth m_fileOutBitDepth = BIT_DEPTH_UNKNOWN;
@@ -155,8 +183,14 @@ private:
 // Make a forward Lut3DOpData that approximates the exact inverse Lut3DOpData
 // to be used for the fast rendering style.
 // LUT has to be inverse or the function will throw.
+// The result values are cached by the cache identifier of the LUT (when finalized).
 Lut3DOpDataRcPtr MakeFastLut3DFromInverse(ConstLut3DOpDataRcPtr & lut);
 
+void ClearLut3DFastInverseCache();
+
+// Get the approximate number of bytes held by the fast inverse cache.
+size_t GetLut3DFastInverseCacheMemoryUsage();
+
 }
 OCIO_NAMESPACE_EXIT
 
@@ -2,9 +2,11 @@
 // Copyright Contributors to the OpenColorIO Project.
 
 #include <algorithm>
+#include <cmath>
 
 #include <OpenColorIO/OpenColorIO.h>
 
+#include "GpuShader.h"
 #include "GpuShaderUtils.h"
 #include "MathUtils.h"
 #include "ops/Lut3D/Lut3DOpGPU.h"
@@ -15,21 +17,29 @@ OCIO_NAMESPACE_ENTER
 void GetLut3DGPUShaderProgram(GpuShaderDescRcPtr & shaderDesc,
                               ConstLut3DOpDataRcPtr & lutData)
 {
+    // The hardware trilinear filtering replaces the tetrahedral interpolation when enabled.
+    const Interpolation concreteInterpolation = lutData->getConcreteInterpolation();
+    const Interpolation interpolation
+        = (concreteInterpolation == INTERP_TETRAHEDRAL
+           && shaderDesc->isLut3DHardwareTrilinearEnabled())
+            ? INTERP_LINEAR : concreteInterpolation;
+
+    const unsigned textureIndex = shaderDesc->getNum3DTextures();
 
     std::ostringstream resName;
     resName << shaderDesc->getResourcePrefix()
             << std::string("lut3d_")
-            << shaderDesc->getNum3DTextures();
+            << textureIndex;
 
     const std::string name(resName.str());
 
     shaderDesc->add3DTexture(GpuShaderText::getSamplerName(name).c_str(),
         lutData->getCacheID().c_str(), lutData->getGridSize(),
-        lutData->getConcreteInterpolation(), &lutData->getArray()[0]);
+        interpolation, &lutData->getArray()[0]);
 
     {
         GpuShaderText ss(shaderDesc->getLanguage());
-        ss.declareTex3D(name);
+        ss.declareTex3D(name, textureIndex);
         shaderDesc->addToDeclareShaderCode(ss.string().c_str());
     }
 
@@ -41,6 +51,8 @@ void GetLut3DGPUShaderProgram(GpuShaderDescRcPtr & shaderDesc,
 
     {
         GpuShaderText ss(shaderDesc->getLanguage());
+        // The tetrahedral interpolation may blend the samples in half precision.
+        ss.setHalfPrecision(IsHalfPrecisionOp(*shaderDesc));
         ss.indent();
 
         ss.newLine() << "";
@@ -54,7 +66,7 @@ void GetLut3DGPUShaderProgram(GpuShaderDescRcPtr & shaderDesc,
         // (f1,f2,f3,f4), and then perform the interpolation manually.
         // One side benefit of this is that we are not subject to the 8-bit
         // quantization of the fractional weights that happens using GL_LINEAR.
-        if (lutData->getConcreteInterpolation() == INTERP_TETRAHEDRAL)
+        if (interpolation == INTERP_TETRAHEDRAL)
         {
             ss.newLine() << "{";
             ss.indent();
@@ -72,13 +84,15 @@ void GetLut3DGPUShaderProgram(GpuShaderDescRcPtr & shaderDesc,
             // scale/offset baseInd onto [0,1] as usual for doing texture lookups
             // we use zyx to flip the order since blue varies most rapidly
             // in the grid array ordering
-            ss.newLine() << ss.vec3fDecl("f1, f4") << ";";
+            ss.newLine() << ss.vec3hDecl("f1, f4") << ";";
 
             ss.newLine() << "baseInd = ( baseInd.zyx + " << ss.vec3fConst(0.5f) << " ) / " << ss.vec3fConst(dim) << ";";
-            ss.newLine() << ss.vec3fDecl("v1") << " = " << ss.sampleTex3D(name, "baseInd") << ".rgb;";
+            ss.newLine() << ss.vec3hDecl("v1") << " = "
+                         << ss.vec3hCast(ss.sampleTex3D(name, "baseInd") + ".rgb") << ";";
 
             ss.newLine() << ss.vec3fDecl("nextInd") << " = baseInd + " << ss.vec3fConst(incr) << ";";
-            ss.newLine() << ss.vec3fDecl("v4") << " = " << ss.sampleTex3D(name, "nextInd") << ".rgb;";
+            ss.newLine() << ss.vec3hDecl("v4") << " = "
+                         << ss.vec3hCast(ss.sampleTex3D(name, "nextInd") + ".rgb") << ";";
 
             ss.newLine() << "if (frac.r >= frac.g)";
             ss.newLine() << "{";
@@ -90,51 +104,57 @@ void GetLut3DGPUShaderProgram(GpuShaderDescRcPtr & shaderDesc,
             // we increment in inverted order since baseInd & nextInd
             // are essentially BGR rather than RGB.
             ss.newLine() << "nextInd = baseInd + " << ss.vec3fConst(0.0f, 0.0f, incr) << ";";
-            ss.newLine() << ss.vec3fDecl("v2") << " = " << ss.sampleTex3D(name, "nextInd") << ".rgb;";
+            ss.newLine() << ss.vec3hDecl("v2") << " = "
+                         << ss.vec3hCast(ss.sampleTex3D(name, "nextInd") + ".rgb") << ";";
 
             ss.newLine() << "nextInd = baseInd + " << ss.vec3fConst(0.0f, incr, incr) << ";";
-            ss.newLine() << ss.vec3fDecl("v3") << " = " << ss.sampleTex3D(name, "nextInd") << ".rgb;";
+            ss.newLine() << ss.vec3hDecl("v3") << " = "
+                         << ss.vec3hCast(ss.sampleTex3D(name, "nextInd") + ".rgb") << ";";
 
-            ss.newLine() << "f1 = " << ss.vec3fConst("1. - frac.r") << ";";
-            ss.newLine() << "f4 = " << ss.vec3fConst("frac.b") << ";";
-            ss.newLine() << ss.vec3fDecl("f2") << " = " << ss.vec3fConst("frac.r - frac.g") << ";";
-            ss.newLine() << ss.vec3fDecl("f3") << " = " << ss.vec3fConst("frac.g - frac.b") << ";";
+            ss.newLine() << "f1 = " << ss.vec3hConst("1. - frac.r") << ";";
+            ss.newLine() << "f4 = " << ss.vec3hConst("frac.b") << ";";
+            ss.newLine() << ss.vec3hDecl("f2") << " = " << ss.vec3hConst("frac.r - frac.g") << ";";
+            ss.newLine() << ss.vec3hDecl("f3") << " = " << ss.vec3hConst("frac.g - frac.b") << ";";
 
-            ss.newLine() << shaderDesc->getPixelName() << ".rgb = (f2 * v2) + (f3 * v3);";
+            ss.newLine() << shaderDesc->getPixelName() << ".rgb = " << ss.vec3fCast("(f2 * v2) + (f3 * v3)") << ";";
             ss.dedent();
             ss.newLine() << "}";
             ss.newLine() << "else if (frac.r >= frac.b)";  // R > B > G
             ss.newLine() << "{";
             ss.indent();
             ss.newLine() << "nextInd = baseInd + " << ss.vec3fConst(0.0f, 0.0f, incr) << ";";
-            ss.newLine() << ss.vec3fDecl("v2") << " = " << ss.sampleTex3D(name, "nextInd") << ".rgb;";
+            ss.newLine() << ss.vec3hDecl("v2") << " = "
+                         << ss.vec3hCast(ss.sampleTex3D(name, "nextInd") + ".rgb") << ";";
 
             ss.newLine() << "nextInd = baseInd + " << ss.vec3fConst(incr, 0.0f, incr) << ";";
-            ss.newLine() << ss.vec3fDecl("v3") << " = " << ss.sampleTex3D(name, "nextInd") << ".rgb;";
+            ss.newLine() << ss.vec3hDecl("v3") << " = "
+                         << ss.vec3hCast(ss.sampleTex3D(name, "nextInd") + ".rgb") << ";";
 
-            ss.newLine() << "f1 = " << ss.vec3fConst("1. - frac.r") << ";";
-            ss.newLine() << "f4 = " << ss.vec3fConst("frac.g") << ";";
-            ss.newLine() << ss.vec3fDecl("f2") << " = " << ss.vec3fConst("frac.r - frac.b") << ";";
-            ss.newLine() << ss.vec3fDecl("f3") << " = " << ss.vec3fConst("frac.b - frac.g") << ";";
+            ss.newLine() << "f1 = " << ss.vec3hConst("1. - frac.r") << ";";
+            ss.newLine() << "f4 = " << ss.vec3hConst("frac.g") << ";";
+            ss.newLine() << ss.vec3hDecl("f2") << " = " << ss.vec3hConst("frac.r - frac.b") << ";";
+            ss.newLine() << ss.vec3hDecl("f3") << " = " << ss.vec3hConst("frac.b - frac.g") << ";";
 
-            ss.newLine() << shaderDesc->getPixelName() << ".rgb = (f2 * v2) + (f3 * v3);";
+            ss.newLine() << shaderDesc->getPixelName() << ".rgb = " << ss.vec3fCast("(f2 * v2) + (f3 * v3)") << ";";
             ss.dedent();
             ss.newLine() << "}";
             ss.newLine() << "else";  // B > R > G
             ss.newLine() << "{";
             ss.indent();
             ss.newLine() << "nextInd = baseInd + " << ss.vec3fConst(incr, 0.0f, 0.0f) << ";";
-            ss.newLine() << ss.vec3fDecl("v2") << " = " << ss.sampleTex3D(name, "nextInd") << ".rgb;";
+            ss.newLine() << ss.vec3hDecl("v2") << " = "
+                         << ss.vec3hCast(ss.sampleTex3D(name, "nextInd") + ".rgb") << ";";
 
             ss.newLine() << "nextInd = baseInd + " << ss.vec3fConst(incr, 0.0f, incr) << ";";
-            ss.newLine() << ss.vec3fDecl("v3") << " = " << ss.sampleTex3D(name, "nextInd") << ".rgb;";
+            ss.newLine() << ss.vec3hDecl("v3") << " = "
+                         << ss.vec3hCast(ss.sampleTex3D(name, "nextInd") + ".rgb") << ";";
 
-            ss.newLine() << "f1 = " << ss.vec3fConst("1. - frac.b") << ";";
-            ss.newLine() << "f4 = " << ss.vec3fConst("frac.g") << ";";
-            ss.newLine() << ss.vec3fDecl("f2") << " = " << ss.vec3fConst("frac.b - frac.r") << ";";
-            ss.newLine() << ss.vec3fDecl("f3") << " = " << ss.vec3fConst("frac.r - frac.g") << ";";
+            ss.newLine() << "f1 = " << ss.vec3hConst("1. - frac.b") << ";";
+            ss.newLine() << "f4 = " << ss.vec3hConst("frac.g") << ";";
+            ss.newLine() << ss.vec3hDecl("f2") << " = " << ss.vec3hConst("frac.b - frac.r") << ";";
+            ss.newLine() << ss.vec3hDecl("f3") << " = " << ss.vec3hConst("frac.r - frac.g") << ";";
 
-            ss.newLine() << shaderDesc->getPixelName() << ".rgb = (f2 * v2) + (f3 * v3);";
+            ss.newLine() << shaderDesc->getPixelName() << ".rgb = " << ss.vec3fCast("(f2 * v2) + (f3 * v3)") << ";";
             ss.dedent();
             ss.newLine() << "}";
             ss.dedent();
@@ -146,51 +166,57 @@ void GetLut3DGPUShaderProgram(GpuShaderDescRcPtr & shaderDesc,
             ss.newLine() << "{";
             ss.indent();
             ss.newLine() << "nextInd = baseInd + " << ss.vec3fConst(incr, 0.0f, 0.0f) << ";";
-            ss.newLine() << ss.vec3fDecl("v2") << " = " << ss.sampleTex3D(name, "nextInd") << ".rgb;";
+            ss.newLine() << ss.vec3hDecl("v2") << " = "
+                         << ss.vec3hCast(ss.sampleTex3D(name, "nextInd") + ".rgb") << ";";
 
             ss.newLine() << "nextInd = baseInd + " << ss.vec3fConst(incr, incr, 0.0f) << ";";
-            ss.newLine() << ss.vec3fDecl("v3") << " = " << ss.sampleTex3D(name, "nextInd") << ".rgb;";
+            ss.newLine() << ss.vec3hDecl("v3") << " = "
+                         << ss.vec3hCast(ss.sampleTex3D(name, "nextInd") + ".rgb") << ";";
 
-            ss.newLine() << "f1 = " << ss.vec3fConst("1. - frac.b") << ";";
-            ss.newLine() << "f4 = " << ss.vec3fConst("frac.r") << ";";
-            ss.newLine() << ss.vec3fDecl("f2") << " = " << ss.vec3fConst("frac.b - frac.g") << ";";
-            ss.newLine() << ss.vec3fDecl("f3") << " = " << ss.vec3fConst("frac.g - frac.r") << ";";
+            ss.newLine() << "f1 = " << ss.vec3hConst("1. - frac.b") << ";";
+            ss.newLine() << "f4 = " << ss.vec3hConst("frac.r") << ";";
+            ss.newLine() << ss.vec3hDecl("f2") << " = " << ss.vec3hConst("frac.b - frac.g") << ";";
+            ss.newLine() << ss.vec3hDecl("f3") << " = " << ss.vec3hConst("frac.g - frac.r") << ";";
 
-            ss.newLine() << shaderDesc->getPixelName() << ".rgb = (f2 * v2) + (f3 * v3);";
+            ss.newLine() << shaderDesc->getPixelName() << ".rgb = " << ss.vec3fCast("(f2 * v2) + (f3 * v3)") << ";";
             ss.dedent();
             ss.newLine() << "}";
             ss.newLine() << "else if (frac.r >= frac.b)";  // G > R > B
             ss.newLine() << "{";
             ss.indent();
             ss.newLine() << "nextInd = baseInd + " << ss.vec3fConst(0.0f, incr, 0.0f) << ";";
-            ss.newLine() << ss.vec3fDecl("v2") << " = " << ss.sampleTex3D(name, "nextInd") << ".rgb;";
+            ss.newLine() << ss.vec3hDecl("v2") << " = "
+                         << ss.vec3hCast(ss.sampleTex3D(name, "nextInd") + ".rgb") << ";";
 
             ss.newLine() << "nextInd = baseInd + " << ss.vec3fConst(0.0f, incr, incr) << ";";
-            ss.newLine() << ss.vec3fDecl("v3") << " = " << ss.sampleTex3D(name, "nextInd") << ".rgb;";
+            ss.newLine() << ss.vec3hDecl("v3") << " = "
+                         << ss.vec3hCast(ss.sampleTex3D(name, "nextInd") + ".rgb") << ";";
 
-            ss.newLine() << "f1 = " << ss.vec3fConst("1. - frac.g") << ";";
-            ss.newLine() << "f4 = " << ss.vec3fConst("frac.b") << ";";
-            ss.newLine() << ss.vec3fDecl("f2") << " = " << ss.vec3fConst("frac.g - frac.r") << ";";
-            ss.newLine() << ss.vec3fDecl("f3") << " = " << ss.vec3fConst("frac.r - frac.b") << ";";
+            ss.newLine() << "f1 = " << ss.vec3hConst("1. - frac.g") << ";";
+            ss.newLine() << "f4 = " << ss.vec3hConst("frac.b") << ";";
+            ss.newLine() << ss.vec3hDecl("f2") << " = " << ss.vec3hConst("frac.g - frac.r") << ";";
+            ss.newLine() << ss.vec3hDecl("f3") << " = " << ss.vec3hConst("frac.r - frac.b") << ";";
 
-            ss.newLine() << shaderDesc->getPixelName() << ".rgb = (f2 * v2) + (f3 * v3);";
+            ss.newLine() << shaderDesc->getPixelName() << ".rgb = " << ss.vec3fCast("(f2 * v2) + (f3 * v3)") << ";";
             ss.dedent();
             ss.newLine() << "}";
             ss.newLine() << "else";  // G > B > R
             ss.newLine() << "{";
             ss.indent();
             ss.newLine() << "nextInd = baseInd + " << ss.vec3fConst(0.0f, incr, 0.0f) << ";";
-            ss.newLine() << ss.vec3fDecl("v2") << " = " << ss.sampleTex3D(name, "nextInd") << ".rgb;";
+            ss.newLine() << ss.vec3hDecl("v2") << " = "
+                         << ss.vec3hCast(ss.sampleTex3D(name, "nextInd") + ".rgb") << ";";
 
             ss.newLine() << "nextInd = baseInd + " << ss.vec3fConst(incr, incr, 0.0f) << ";";
-            ss.newLine() << ss.vec3fDecl("v3") << " = " << ss.sampleTex3D(name, "nextInd") << ".rgb;";
+            ss.newLine() << ss.vec3hDecl("v3") << " = "
+                         << ss.vec3hCast(ss.sampleTex3D(name, "nextInd") + ".rgb") << ";";
 
-            ss.newLine() << "f1 = " << ss.vec3fConst("1. - frac.g") << ";";
-            ss.newLine() << "f4 = " << ss.vec3fConst("frac.r") << ";";
-            ss.newLine() << ss.vec3fDecl("f2") << " = " << ss.vec3fConst("frac.g - frac.b") << ";";
-            ss.newLine() << ss.vec3fDecl("f3") << " = " << ss.vec3fConst("frac.b - frac.r") << ";";
+            ss.newLine() << "f1 = " << ss.vec3hConst("1. - frac.g") << ";";
+            ss.newLine() << "f4 = " << ss.vec3hConst("frac.r") << ";";
+            ss.newLine() << ss.vec3hDecl("f2") << " = " << ss.vec3hConst("frac.g - frac.b") << ";";
+            ss.newLine() << ss.vec3hDecl("f3") << " = " << ss.vec3hConst("frac.b - frac.r") << ";";
 
-            ss.newLine() << shaderDesc->getPixelName() << ".rgb = (f2 * v2) + (f3 * v3);";
+            ss.newLine() << shaderDesc->getPixelName() << ".rgb = " << ss.vec3fCast("(f2 * v2) + (f3 * v3)") << ";";
             ss.dedent();
             ss.newLine() << "}";
             ss.dedent();
@@ -199,11 +225,27 @@ void GetLut3DGPUShaderProgram(GpuShaderDescRcPtr & shaderDesc,
             ss.newLine() << shaderDesc->getPixelName()
                          << ".rgb = "
                          << shaderDesc->getPixelName()
-                         << ".rgb + (f1 * v1) + (f4 * v4);";
+                         << ".rgb + " << ss.vec3fCast("(f1 * v1) + (f4 * v4)") << ";";
 
             ss.dedent();
             ss.newLine() << "}";
         }
+        else if (interpolation == INTERP_NEAREST)
+        {
+            // Nearest entry (i.e. the draft interpolation quality)
+            // Sample the center of the nearest texel so the result does not depend on
+            // the texture filtering.
+
+            ss.newLine() << ss.vec3fDecl(name + "_coords")
+                         << " = (floor(" << shaderDesc->getPixelName() << ".zyx * "
+                         << ss.vec3fConst(dim - 1) << " + "
+                         << ss.vec3fConst(0.5f) << ") + "
+                         << ss.vec3fConst(0.5f) << ") / "
+                         << ss.vec3fConst(dim) << ";";
+
+            ss.newLine() << shaderDesc->getPixelName() << ".rgb = "
+                         << ss.sampleTex3D(name, name + "_coords") << ".rgb;";
+        }
         else
         {
             // Trilinear interpolation
@@ -214,7 +256,7 @@ void GetLut3DGPUShaderProgram(GpuShaderDescRcPtr & shaderDesc,
             ss.newLine() << ss.vec3fDecl(name + "_coords")
                          << " = (" << shaderDesc->getPixelName() << ".zyx * "
                          << ss.vec3fConst(dim - 1) << " + "
-                         << ss.vec3fConst(0.5f) + ") / "
+                         << ss.vec3fConst(0.5f) << ") / "
                          << ss.vec3fConst(dim) << ";";
 
             ss.newLine() << shaderDesc->getPixelName() << ".rgb = "
@@ -225,7 +267,96 @@ void GetLut3DGPUShaderProgram(GpuShaderDescRcPtr & shaderDesc,
     }
 }
 
+namespace
+{
+// The fractional positions sampled in each grid cell.
+constexpr float CellSamples[3] = { 0.25f, 0.5f, 0.75f };
+
+}
+
+double ComputeLut3DTrilinearError(unsigned edgelen, const float * values)
+{
+    double maxError = 0.;
+
+    const unsigned long dim = edgelen;
+
+    for (unsigned long r = 0; r + 1 < dim; ++r)
+    {
+        for (unsigned long g = 0; g + 1 < dim; ++g)
+        {
+            for (unsigned long b = 0; b + 1 < dim; ++b)
+            {
+                for (unsigned long c = 0; c < 3; ++c)
+                {
+                    float v[8];
+                    for (unsigned long corner = 0; corner < 8; ++corner)
+                    {
+                        const unsigned long idx = ((r + (corner >> 2)) * dim
+                                                   + g + ((corner >> 1) & 1)) * dim
+                                                  + b + (corner & 1);
+                        v[corner] = values[idx * 3 + c];
+                    }
+
+                    for (float fr : CellSamples)
+                    {
+                        for (float fg : CellSamples)
+                        {
+                            for (float fb : CellSamples)
+                            {
+                                const double error = std::fabs(
+                                    double(InterpolateCellTrilinear(v, fr, fg, fb))
+                                        - double(InterpolateCellTetrahedral(v, fr, fg, fb)));
+
+                                maxError = std::max(maxError, error);
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    return maxError;
+}
+
 
 }
 OCIO_NAMESPACE_EXIT
 
+#ifdef OCIO_UNIT_TEST
+
+namespace OCIO = OCIO_NAMESPACE;
+#include "UnitTest.h"
+
+OCIO_ADD_TEST(Lut3DOpGPU, trilinear_error)
+{
+    // The interpolations are identical for an affine LUT.
+    const unsigned edgelen = 5;
+    std::vector<float> values(edgelen * edgelen * edgelen * 3);
+    for (unsigned r = 0; r < edgelen; ++r)
+    {
+        for (unsigned g = 0; g < edgelen; ++g)
+        {
+            for (unsigned b = 0; b < edgelen; ++b)
+            {
+                const unsigned idx = ((r * edgelen + g) * edgelen + b) * 3;
+                values[idx + 0] = 0.5f * r - 0.25f * g + 0.1f;
+                values[idx + 1] = 0.2f * b;
+                values[idx + 2] = 1.f - 0.1f * r - 0.1f * g - 0.1f * b;
+            }
+        }
+    }
+    OCIO_CHECK_CLOSE(OCIO::ComputeLut3DTrilinearError(edgelen, &values[0]), 0., 1e-6);
+
+    // A single cell whose last corner is 1 i.e. the largest difference is at its center
+    // where the trilinear interpolation is 1/8 and the tetrahedral one 1/2.
+    std::vector<float> cell(2 * 2 * 2 * 3, 0.f);
+    cell[7 * 3 + 1] = 1.f;
+    OCIO_CHECK_CLOSE(OCIO::ComputeLut3DTrilinearError(2, &cell[0]), 0.375, 1e-6);
+    OCIO_CHECK_CLOSE(OCIO::GpuShaderDesc::GetLut3DTrilinearError(2, &cell[0]), 0.375, 1e-6);
+
+    OCIO_CHECK_THROW_WHAT(OCIO::GpuShaderDesc::GetLut3DTrilinearError(2, nullptr),
+                          OCIO::Exception, "The 3D texture values are missing");
+}
+
+#endif // OCIO_UNIT_TEST
@@ -18,6 +18,11 @@ OCIO_NAMESPACE_ENTER
 void GetLut3DGPUShaderProgram(GpuShaderDescRcPtr & shaderDesc,
                               ConstLut3DOpDataRcPtr & lutData);
 
+// Estimate the maximum absolute difference between the trilinear and the tetrahedral
+// interpolation of the RGB values of a 3D LUT, refer to
+// GpuShaderDesc::GetLut3DTrilinearError().
+double ComputeLut3DTrilinearError(unsigned edgelen, const float * values);
+
 }
 OCIO_NAMESPACE_EXIT
 
@@ -1,14 +1,23 @@
 // SPDX-License-Identifier: BSD-3-Clause
 // Copyright Contributors to the OpenColorIO Project.
 
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
 #include <OpenColorIO/OpenColorIO.h>
 
 #include "BitDepthUtils.h"
+#include "CPUInfo.h"
 #include "MathUtils.h"
 #include "ops/Matrix/MatrixOpCPU.h"
 #include "Platform.h"
 #include "SSE.h"
 
+#if defined(OCIO_USE_AVX)
+#include <immintrin.h>
+#endif
+
 OCIO_NAMESPACE_ENTER
 {
 namespace
@@ -23,7 +32,14 @@ public:
 
     void apply(const void * inImg, void * outImg, long numPixels) const override;
 
-private:
+    bool hasPlanarApply() const override { return true; }
+    void applyPlanar(const float * const * inPlanes, float * const * outPlanes,
+                     long numPixels) const override;
+
+    bool hasRGBApply() const override { return true; }
+    void applyRGB(const float * inImg, float * outImg, long numPixels) const override;
+
+protected:
     float m_scale[4];
 };
 
@@ -36,7 +52,14 @@ public:
 
     void apply(const void * inImg, void * outImg, long numPixels) const override;
 
-private:
+    bool hasPlanarApply() const override { return true; }
+    void applyPlanar(const float * const * inPlanes, float * const * outPlanes,
+                     long numPixels) const override;
+
+    bool hasRGBApply() const override { return true; }
+    void applyRGB(const float * inImg, float * outImg, long numPixels) const override;
+
+protected:
     float m_scale[4];
     float m_offset[4];
 };
@@ -50,8 +73,14 @@ public:
 
     void apply(const void * inImg, void * outImg, long numPixels) const override;
 
-private:
+    bool hasPlanarApply() const override { return true; }
+    void applyPlanar(const float * const * inPlanes, float * const * outPlanes,
+                     long numPixels) const override;
+
+    bool hasRGBApply() const override { return true; }
+    void applyRGB(const float * inImg, float * outImg, long numPixels) const override;
 
+protected:
     float m_column1[4];
     float m_column2[4];
     float m_column3[4];
@@ -69,13 +98,144 @@ public:
 
     void apply(const void * inImg, void * outImg, long numPixels) const override;
 
-private:
+    bool hasPlanarApply() const override { return true; }
+    void applyPlanar(const float * const * inPlanes, float * const * outPlanes,
+                     long numPixels) const override;
+
+    bool hasRGBApply() const override { return true; }
+    void applyRGB(const float * inImg, float * outImg, long numPixels) const override;
+
+protected:
     float m_column1[4];
     float m_column2[4];
     float m_column3[4];
     float m_column4[4];
 };
 
+// Process planar pixels i.e. four pixels of each channel at a time for SSE. Note that
+// the computations are done in the same order than the packed renderers.
+template<bool hasOffset>
+void ApplyMatrixPlanar(const float * const * in, float * const * out, long numPixels,
+                       const float * column1, const float * column2,
+                       const float * column3, const float * column4,
+                       const float * offset)
+{
+#ifdef USE_SSE
+    __m128 m0[4], m1[4], m2[4], m3[4], o[4];
+    for (int c = 0; c < 4; ++c)
+    {
+        m0[c] = _mm_set1_ps(column1[c]);
+        m1[c] = _mm_set1_ps(column2[c]);
+        m2[c] = _mm_set1_ps(column3[c]);
+        m3[c] = _mm_set1_ps(column4[c]);
+        o[c]  = _mm_set1_ps(offset[c]);
+    }
+
+    for (long idx = 0; idx < numPixels; idx += 4)
+    {
+        const long count = std::min(4L, numPixels - idx);
+
+        const __m128 r = sseLoadPartial(in[0] + idx, count);
+        const __m128 g = sseLoadPartial(in[1] + idx, count);
+        const __m128 b = sseLoadPartial(in[2] + idx, count);
+        const __m128 a = sseLoadPartial(in[3] + idx, count);
+
+        for (int c = 0; c < 4; ++c)
+        {
+            __m128 img = _mm_add_ps(_mm_add_ps(_mm_mul_ps(m0[c], r), _mm_mul_ps(m1[c], g)),
+                                    _mm_add_ps(_mm_mul_ps(m2[c], b), _mm_mul_ps(m3[c], a)));
+            if (hasOffset)
+            {
+                img = _mm_add_ps(img, o[c]);
+            }
+
+            sseStorePartial(out[c] + idx, img, count);
+        }
+    }
+#else
+    for (long idx = 0; idx < numPixels; ++idx)
+    {
+        const float r = in[0][idx];
+        const float g = in[1][idx];
+        const float b = in[2][idx];
+        const float a = in[3][idx];
+
+        for (int c = 0; c < 4; ++c)
+        {
+            float img = r*column1[c]
+                      + g*column2[c]
+                      + b*column3[c]
+                      + a*column4[c];
+            if (hasOffset)
+            {
+                img = img + offset[c];
+            }
+
+            out[c][idx] = img;
+        }
+    }
+#endif
+}
+
+// Process packed RGB pixels. The missing alpha being zero, the alpha column is ignored
+// and the results are the same as the packed RGBA renderers (i.e. bm2 + am3 = bm2).
+template<bool hasOffset>
+void ApplyMatrixRGB(const float * in, float * out, long numPixels,
+                    const float * column1, const float * column2,
+                    const float * column3, const float * offset)
+{
+#ifdef USE_SSE
+    const __m128 m0 = _mm_loadu_ps(column1);
+    const __m128 m1 = _mm_loadu_ps(column2);
+    const __m128 m2 = _mm_loadu_ps(column3);
+    const __m128 o  = _mm_loadu_ps(offset);
+
+    for (long idx = 0; idx < numPixels; ++idx)
+    {
+        const __m128 r = _mm_set1_ps(in[0]);
+        const __m128 g = _mm_set1_ps(in[1]);
+        const __m128 b = _mm_set1_ps(in[2]);
+
+        __m128 img = _mm_add_ps(_mm_add_ps(_mm_mul_ps(m0, r), _mm_mul_ps(m1, g)),
+                                _mm_mul_ps(m2, b));
+        if (hasOffset)
+        {
+            img = _mm_add_ps(img, o);
+        }
+
+        // Only write the three channels as the next pixel could be the input one.
+        _mm_storel_pi((__m64 *)out, img);
+        _mm_store_ss(out + 2, _mm_movehl_ps(img, img));
+
+        in  += 3;
+        out += 3;
+    }
+#else
+    for (long idx = 0; idx < numPixels; ++idx)
+    {
+        const float r = in[0];
+        const float g = in[1];
+        const float b = in[2];
+
+        for (int c = 0; c < 3; ++c)
+        {
+            float img = r*column1[c]
+                      + g*column2[c]
+                      + b*column3[c];
+            if (hasOffset)
+            {
+                img = img + offset[c];
+            }
+
+            out[c] = img;
+        }
+
+        in  += 3;
+        out += 3;
+    }
+#endif
+}
+
 ScaleRenderer::ScaleRenderer(ConstMatrixOpDataRcPtr & mat)
     : OpCPU()
 {
@@ -104,6 +264,40 @@ void ScaleRenderer::apply(const void * inImg, void * outImg, long numPixels) con
     }
 }
 
+void ScaleRenderer::applyPlanar(const float * const * inPlanes, float * const * outPlanes,
+                                long numPixels) const
+{
+    for (int c = 0; c < 4; ++c)
+    {
+        const float * in = inPlanes[c];
+        float * out = outPlanes[c];
+        const float scale = m_scale[c];
+
+        for (long idx = 0; idx < numPixels; ++idx)
+        {
+            out[idx] = in[idx] * scale;
+        }
+    }
+}
+
+void ScaleRenderer::applyRGB(const float * inImg, float * outImg, long numPixels) const
+{
+#ifdef USE_SSE
+    __m128 scale[3];
+    sseRGBRotations(m_scale[0], m_scale[1], m_scale[2], scale);
+
+    sseApplyRGB(inImg, outImg, numPixels, [&](__m128 pix, int rot)
+    {
+        return _mm_mul_ps(pix, scale[rot]);
+    });
+#else
+    for (long idx = 0; idx < 3 * numPixels; ++idx)
+    {
+        outImg[idx] = inImg[idx] * m_scale[idx % 3];
+    }
+#endif
+}
+
 ScaleWithOffsetRenderer::ScaleWithOffsetRenderer(ConstMatrixOpDataRcPtr & mat)
     : OpCPU()
 {
@@ -139,6 +333,44 @@ void ScaleWithOffsetRenderer::apply(const void * inImg, void * outImg, long numP
     }
 }
 
+void ScaleWithOffsetRenderer::applyPlanar(const float * const * inPlanes,
+                                          float * const * outPlanes,
+                                          long numPixels) const
+{
+    for (int c = 0; c < 4; ++c)
+    {
+        const float * in = inPlanes[c];
+        float * out = outPlanes[c];
+        const float scale  = m_scale[c];
+        const float offset = m_offset[c];
+
+        for (long idx = 0; idx < numPixels; ++idx)
+        {
+            out[idx] = in[idx] * scale + offset;
+        }
+    }
+}
+
+void ScaleWithOffsetRenderer::applyRGB(const float * inImg, float * outImg,
+                                       long numPixels) const
+{
+#ifdef USE_SSE
+    __m128 scale[3], offset[3];
+    sseRGBRotations(m_scale[0], m_scale[1], m_scale[2], scale);
+    sseRGBRotations(m_offset[0], m_offset[1], m_offset[2], offset);
+
+    sseApplyRGB(inImg, outImg, numPixels, [&](__m128 pix, int rot)
+    {
+        return _mm_add_ps(_mm_mul_ps(pix, scale[rot]), offset[rot]);
+    });
+#else
+    for (long idx = 0; idx < 3 * numPixels; ++idx)
+    {
+        outImg[idx] = inImg[idx] * m_scale[idx % 3] + m_offset[idx % 3];
+    }
+#endif
+}
+
 MatrixWithOffsetRenderer::MatrixWithOffsetRenderer(ConstMatrixOpDataRcPtr & mat)
     : OpCPU()
 {
@@ -287,6 +519,20 @@ void MatrixWithOffsetRenderer::apply(const void * inImg, void * outImg, long num
 
 }
 
+void MatrixWithOffsetRenderer::applyPlanar(const float * const * inPlanes,
+                                           float * const * outPlanes,
+                                           long numPixels) const
+{
+    ApplyMatrixPlanar<true>(inPlanes, outPlanes, numPixels,
+                            m_column1, m_column2, m_column3, m_column4, m_offset);
+}
+
+void MatrixWithOffsetRenderer::applyRGB(const float * inImg, float * outImg,
+                                        long numPixels) const
+{
+    ApplyMatrixRGB<true>(inImg, outImg, numPixels, m_column1, m_column2, m_column3, m_offset);
+}
+
 MatrixRenderer::MatrixRenderer(ConstMatrixOpDataRcPtr & mat)
     : OpCPU()
 {
@@ -395,12 +641,291 @@ void MatrixRenderer::apply(const void * inImg, void * outImg, long numPixels) co
 #endif
 }
 
+void MatrixRenderer::applyPlanar(const float * const * inPlanes, float * const * outPlanes,
+                                 long numPixels) const
+{
+    static const float noOffset[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+    ApplyMatrixPlanar<false>(inPlanes, outPlanes, numPixels,
+                             m_column1, m_column2, m_column3, m_column4, noOffset);
+}
+
+void MatrixRenderer::applyRGB(const float * inImg, float * outImg, long numPixels) const
+{
+    static const float noOffset[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+    ApplyMatrixRGB<false>(inImg, outImg, numPixels, m_column1, m_column2, m_column3, noOffset);
+}
+
+#if defined(OCIO_USE_AVX)
+
+// The AVX variants process several pixels per instruction (i.e. one pixel per
+// 128-bit lane) but do exactly the same operations than the SSE implementation,
+// so all the CPUs produce identical results. Note that FMA is not used for that
+// reason.
+
+template<bool hasOffset>
+OCIO_TARGET_AVX2
+void ApplyMatrixAVX2(const float * in, float * out, long numPixels,
+                     const float * column1, const float * column2,
+                     const float * column3, const float * column4,
+                     const float * offset)
+{
+    const __m256 m0 = _mm256_broadcast_ps((const __m128 *)column1);
+    const __m256 m1 = _mm256_broadcast_ps((const __m128 *)column2);
+    const __m256 m2 = _mm256_broadcast_ps((const __m128 *)column3);
+    const __m256 m3 = _mm256_broadcast_ps((const __m128 *)column4);
+    const __m256 o  = _mm256_broadcast_ps((const __m128 *)offset);
+
+    long idx = 0;
+    for (; idx + 2 <= numPixels; idx += 2)
+    {
+        const __m256 pix = _mm256_loadu_ps(in);
+
+        const __m256 r = _mm256_permute_ps(pix, _MM_SHUFFLE(0, 0, 0, 0));
+        const __m256 g = _mm256_permute_ps(pix, _MM_SHUFFLE(1, 1, 1, 1));
+        const __m256 b = _mm256_permute_ps(pix, _MM_SHUFFLE(2, 2, 2, 2));
+        const __m256 a = _mm256_permute_ps(pix, _MM_SHUFFLE(3, 3, 3, 3));
+
+        __m256 img = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(m0, r), _mm256_mul_ps(m1, g)),
+                                   _mm256_add_ps(_mm256_mul_ps(m2, b), _mm256_mul_ps(m3, a)));
+        if (hasOffset)
+        {
+            img = _mm256_add_ps(img, o);
+        }
+
+        _mm256_storeu_ps(out, img);
+
+        in  += 8;
+        out += 8;
+    }
+
+    // Process the remaining pixel.
+    if (idx < numPixels)
+    {
+        __m128 img = _mm_add_ps(
+            _mm_add_ps(_mm_mul_ps(_mm256_castps256_ps128(m0), _mm_set1_ps(in[0])),
+                       _mm_mul_ps(_mm256_castps256_ps128(m1), _mm_set1_ps(in[1]))),
+            _mm_add_ps(_mm_mul_ps(_mm256_castps256_ps128(m2), _mm_set1_ps(in[2])),
+                       _mm_mul_ps(_mm256_castps256_ps128(m3), _mm_set1_ps(in[3]))));
+        if (hasOffset)
+        {
+            img = _mm_add_ps(img, _mm256_castps256_ps128(o));
+        }
+
+        _mm_storeu_ps(out, img);
+    }
+}
+
+// Apply a diagonal matrix i.e. the pixels do not need to be transposed.
+template<bool hasOffset>
+OCIO_TARGET_AVX2
+void ApplyScaleAVX2(const float * in, float * out, long numPixels,
+                    const float * scale, const float * offset)
+{
+    const __m256 s = _mm256_broadcast_ps((const __m128 *)scale);
+    const __m256 o = _mm256_broadcast_ps((const __m128 *)offset);
+
+    long idx = 0;
+    for (; idx + 8 <= numPixels; idx += 8)
+    {
+        __m256 img[4];
+        for (int i = 0; i < 4; ++i)
+        {
+            img[i] = _mm256_mul_ps(_mm256_loadu_ps(in + 8 * i), s);
+            if (hasOffset)
+            {
+                img[i] = _mm256_add_ps(img[i], o);
+            }
+        }
+
+        for (int i = 0; i < 4; ++i)
+        {
+            _mm256_storeu_ps(out + 8 * i, img[i]);
+        }
+
+        in  += 32;
+        out += 32;
+    }
+
+    // Process the remaining pixels.
+    for (; idx < numPixels; ++idx)
+    {
+        __m128 img = _mm_mul_ps(_mm_loadu_ps(in), _mm256_castps256_ps128(s));
+        if (hasOffset)
+        {
+            img = _mm_add_ps(img, _mm256_castps256_ps128(o));
+        }
+
+        _mm_storeu_ps(out, img);
+
+        in  += 4;
+        out += 4;
+    }
+}
+
+OCIO_AVX512_DIAGNOSTIC_PUSH
+
+template<bool hasOffset>
+OCIO_TARGET_AVX512
+void ApplyMatrixAVX512(const float * in, float * out, long numPixels,
+                       const float * column1, const float * column2,
+                       const float * column3, const float * column4,
+                       const float * offset)
+{
+    const __m512 m0 = _mm512_broadcast_f32x4(_mm_loadu_ps(column1));
+    const __m512 m1 = _mm512_broadcast_f32x4(_mm_loadu_ps(column2));
+    const __m512 m2 = _mm512_broadcast_f32x4(_mm_loadu_ps(column3));
+    const __m512 m3 = _mm512_broadcast_f32x4(_mm_loadu_ps(column4));
+    const __m512 o  = _mm512_broadcast_f32x4(_mm_loadu_ps(offset));
+
+    long idx = 0;
+    for (; idx + 4 <= numPixels; idx += 4)
+    {
+        const __m512 pix = _mm512_loadu_ps(in);
+
+        const __m512 r = _mm512_permute_ps(pix, _MM_SHUFFLE(0, 0, 0, 0));
+        const __m512 g = _mm512_permute_ps(pix, _MM_SHUFFLE(1, 1, 1, 1));
+        const __m512 b = _mm512_permute_ps(pix, _MM_SHUFFLE(2, 2, 2, 2));
+        const __m512 a = _mm512_permute_ps(pix, _MM_SHUFFLE(3, 3, 3, 3));
+
+        __m512 img = _mm512_add_ps(_mm512_add_ps(_mm512_mul_ps(m0, r), _mm512_mul_ps(m1, g)),
+                                   _mm512_add_ps(_mm512_mul_ps(m2, b), _mm512_mul_ps(m3, a)));
+        if (hasOffset)
+        {
+            img = _mm512_add_ps(img, o);
+        }
+
+        _mm512_storeu_ps(out, img);
+
+        in  += 16;
+        out += 16;
+    }
+
+    // Process the remaining pixels.
+    for (; idx < numPixels; ++idx)
+    {
+        __m128 img = _mm_add_ps(
+            _mm_add_ps(_mm_mul_ps(_mm512_castps512_ps128(m0), _mm_set1_ps(in[0])),
+                       _mm_mul_ps(_mm512_castps512_ps128(m1), _mm_set1_ps(in[1]))),
+            _mm_add_ps(_mm_mul_ps(_mm512_castps512_ps128(m2), _mm_set1_ps(in[2])),
+                       _mm_mul_ps(_mm512_castps512_ps128(m3), _mm_set1_ps(in[3]))));
+        if (hasOffset)
+        {
+            img = _mm_add_ps(img, _mm512_castps512_ps128(o));
+        }
+
+        _mm_storeu_ps(out, img);
+
+        in  += 4;
+        out += 4;
+    }
+}
+
+OCIO_AVX512_DIAGNOSTIC_POP
+
+class MatrixWithOffsetAVX2Renderer : public MatrixWithOffsetRenderer
+{
+public:
+    explicit MatrixWithOffsetAVX2Renderer(ConstMatrixOpDataRcPtr & mat)
+        : MatrixWithOffsetRenderer(mat) {}
+
+    void apply(const void * inImg, void * outImg, long numPixels) const override
+    {
+        ApplyMatrixAVX2<true>((const float *)inImg, (float *)outImg, numPixels,
+                              m_column1, m_column2, m_column3, m_column4, m_offset);
+    }
+};
+
+class MatrixWithOffsetAVX512Renderer : public MatrixWithOffsetRenderer
+{
+public:
+    explicit MatrixWithOffsetAVX512Renderer(ConstMatrixOpDataRcPtr & mat)
+        : MatrixWithOffsetRenderer(mat) {}
+
+    void apply(const void * inImg, void * outImg, long numPixels) const override
+    {
+        ApplyMatrixAVX512<true>((const float *)inImg, (float *)outImg, numPixels,
+                                m_column1, m_column2, m_column3, m_column4, m_offset);
+    }
+};
+
+class MatrixAVX2Renderer : public MatrixRenderer
+{
+public:
+    explicit MatrixAVX2Renderer(ConstMatrixOpDataRcPtr & mat)
+        : MatrixRenderer(mat) {}
+
+    void apply(const void * inImg, void * outImg, long numPixels) const override
+    {
+        static const float noOffset[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+        ApplyMatrixAVX2<false>((const float *)inImg, (float *)outImg, numPixels,
+                               m_column1, m_column2, m_column3, m_column4, noOffset);
+    }
+};
+
+class MatrixAVX512Renderer : public MatrixRenderer
+{
+public:
+    explicit MatrixAVX512Renderer(ConstMatrixOpDataRcPtr & mat)
+        : MatrixRenderer(mat) {}
+
+    void apply(const void * inImg, void * outImg, long numPixels) const override
+    {
+        static const float noOffset[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+        ApplyMatrixAVX512<false>((const float *)inImg, (float *)outImg, numPixels,
+                                 m_column1, m_column2, m_column3, m_column4, noOffset);
+    }
+};
+
+class ScaleWithOffsetAVX2Renderer : public ScaleWithOffsetRenderer
+{
+public:
+    explicit ScaleWithOffsetAVX2Renderer(ConstMatrixOpDataRcPtr & mat)
+        : ScaleWithOffsetRenderer(mat) {}
+
+    void apply(const void * inImg, void * outImg, long numPixels) const override
+    {
+        ApplyScaleAVX2<true>((const float *)inImg, (float *)outImg, numPixels,
+                             m_scale, m_offset);
+    }
+};
+
+class ScaleAVX2Renderer : public ScaleRenderer
+{
+public:
+    explicit ScaleAVX2Renderer(ConstMatrixOpDataRcPtr & mat)
+        : ScaleRenderer(mat) {}
+
+    void apply(const void * inImg, void * outImg, long numPixels) const override
+    {
+        static const float noOffset[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+        ApplyScaleAVX2<false>((const float *)inImg, (float *)outImg, numPixels,
+                              m_scale, noOffset);
+    }
+};
+
+#endif // OCIO_USE_AVX
+
 }
 
 ConstOpCPURcPtr GetMatrixRenderer(ConstMatrixOpDataRcPtr & mat)
 {
+#if defined(OCIO_USE_AVX)
+    const CPUInfo & cpuInfo = CPUInfo::Instance();
+#endif
+
     if (mat->isDiagonal())
     {
+#if defined(OCIO_USE_AVX)
+        if (cpuInfo.hasAVX2())
+        {
+            if (mat->hasOffsets())
+            {
+                return std::make_shared<ScaleWithOffsetAVX2Renderer>(mat);
+            }
+            return std::make_shared<ScaleAVX2Renderer>(mat);
+        }
+#endif
+
         if (mat->hasOffsets())
         {
             return std::make_shared<ScaleWithOffsetRenderer>(mat);
@@ -412,6 +937,26 @@ ConstOpCPURcPtr GetMatrixRenderer(ConstMatrixOpDataRcPtr & mat)
     }
     else
     {
+#if defined(OCIO_USE_AVX)
+        // Select the widest vector unit available on the CPU.
+        if (cpuInfo.hasAVX512F())
+        {
+            if (mat->hasOffsets())
+            {
+                return std::make_shared<MatrixWithOffsetAVX512Renderer>(mat);
+            }
+            return std::make_shared<MatrixAVX512Renderer>(mat);
+        }
+        else if (cpuInfo.hasAVX2())
+        {
+            if (mat->hasOffsets())
+            {
+                return std::make_shared<MatrixWithOffsetAVX2Renderer>(mat);
+            }
+            return std::make_shared<MatrixAVX2Renderer>(mat);
+        }
+#endif
+
         if (mat->hasOffsets())
         {
             return std::make_shared<MatrixWithOffsetRenderer>(mat);
@@ -546,5 +1091,246 @@ OCIO_ADD_TEST(MatrixOpCPU, matrix_renderer)
 }
 
 
+#if defined(OCIO_USE_AVX)
+OCIO_ADD_TEST(MatrixOpCPU, avx_renderers)
+{
+    // The AVX renderers must produce exactly the same results as the SSE ones.
+
+    OCIO::MatrixOpDataRcPtr mat = std::make_shared<OCIO::MatrixOpData>();
+    const double m44[16] = {  1.1, 0.2,  0.3, 0.4,
+                              0.5, 1.6, -0.7, 0.8,
+                             -0.2, 0.1,  1.1, 0.2,
+                              0.3, 0.4,  0.5, 1.6 };
+    mat->setRGBA(m44);
+    mat->setOffsetValue(0, 0.1);
+    mat->setOffsetValue(1, -0.2);
+    mat->setOffsetValue(2, 0.3);
+    mat->setOffsetValue(3, -0.4);
+
+    OCIO::ConstMatrixOpDataRcPtr m = mat;
+
+    // Odd number of pixels to exercise the remaining pixels, including non-finite values
+    // in the color and alpha channels of the pairs and of the remaining pixel.
+    constexpr long numPixels = 19;
+    std::vector<float> img(4 * numPixels);
+    for (size_t idx = 0; idx < img.size(); ++idx)
+    {
+        img[idx] = float(idx) * 0.37f - 2.0f;
+    }
+    img[4 * 2 + 0]  = std::numeric_limits<float>::quiet_NaN();
+    img[4 * 5 + 3]  = std::numeric_limits<float>::quiet_NaN();
+    img[4 * 7 + 1]  = std::numeric_limits<float>::infinity();
+    img[4 * 18 + 2] = std::numeric_limits<float>::quiet_NaN();
+    img[4 * 18 + 1] = -std::numeric_limits<float>::infinity();
+
+    // The NaNs are compared bitwise.
+    auto sameBits = [](const std::vector<float> & a, const std::vector<float> & b)
+    {
+        return a.size() == b.size() && std::memcmp(&a[0], &b[0], a.size() * sizeof(float)) == 0;
+    };
+
+    const OCIO::MatrixWithOffsetRenderer refOffset(m);
+    const OCIO::MatrixRenderer ref(m);
+
+    std::vector<float> refOffsetRes(img.size());
+    refOffset.apply(&img[0], &refOffsetRes[0], numPixels);
+    std::vector<float> refRes(img.size());
+    ref.apply(&img[0], &refRes[0], numPixels);
+
+    const OCIO::CPUInfo & cpuInfo = OCIO::CPUInfo::Instance();
+
+    if (cpuInfo.hasAVX2())
+    {
+        std::vector<float> res(img);
+        OCIO::MatrixWithOffsetAVX2Renderer(m).apply(&res[0], &res[0], numPixels);
+        OCIO_CHECK_ASSERT(sameBits(res, refOffsetRes));
+
+        res = img;
+        OCIO::MatrixAVX2Renderer(m).apply(&res[0], &res[0], numPixels);
+        OCIO_CHECK_ASSERT(sameBits(res, refRes));
+    }
+
+    if (cpuInfo.hasAVX512F())
+    {
+        std::vector<float> res(img);
+        OCIO::MatrixWithOffsetAVX512Renderer(m).apply(&res[0], &res[0], numPixels);
+        OCIO_CHECK_ASSERT(sameBits(res, refOffsetRes));
+
+        res = img;
+        OCIO::MatrixAVX512Renderer(m).apply(&res[0], &res[0], numPixels);
+        OCIO_CHECK_ASSERT(sameBits(res, refRes));
+    }
+
+    if (cpuInfo.hasAVX2())
+    {
+        // A matrix leaving the alpha untouched is still fully computed as the NaNs and
+        // the infinities of the color channels propagate to the alpha channel.
+        const double m33[16] = {  1.1, 0.2,  0.3, 0.0,
+                                  0.5, 1.6, -0.7, 0.0,
+                                 -0.2, 0.1,  1.1, 0.0,
+                                  0.0, 0.0,  0.0, 1.0 };
+        mat->setRGBA(m33);
+        mat->setOffsetValue(3, 0.0);
+        OCIO_REQUIRE_ASSERT(!mat->touchesAlpha());
+
+        const OCIO::MatrixWithOffsetRenderer refOffset33(m);
+        refOffset33.apply(&img[0], &refOffsetRes[0], numPixels);
+
+        std::vector<float> res(img);
+        OCIO::ConstOpCPURcPtr renderer = OCIO::GetMatrixRenderer(m);
+        renderer->apply(&res[0], &res[0], numPixels);
+        OCIO_CHECK_ASSERT(sameBits(res, refOffsetRes));
+
+        // A diagonal matrix.
+        OCIO::MatrixOpDataRcPtr diag = OCIO::MatrixOpData::CreateDiagonalMatrix(1.5);
+        diag->setArrayValue(5, -0.5);
+        diag->setOffsetValue(1, 0.25);
+        diag->setOffsetValue(3, -0.5);
+        OCIO::ConstMatrixOpDataRcPtr d = diag;
+
+        const OCIO::ScaleWithOffsetRenderer refScaleOffset(d);
+        const OCIO::ScaleRenderer refScale(d);
+
+        refScaleOffset.apply(&img[0], &refOffsetRes[0], numPixels);
+        refScale.apply(&img[0], &refRes[0], numPixels);
+
+        res = img;
+        OCIO::ScaleWithOffsetAVX2Renderer(d).apply(&res[0], &res[0], numPixels);
+        OCIO_CHECK_ASSERT(sameBits(res, refOffsetRes));
+
+        res = img;
+        OCIO::ScaleAVX2Renderer(d).apply(&res[0], &res[0], numPixels);
+        OCIO_CHECK_ASSERT(sameBits(res, refRes));
+    }
+}
+#endif
+
+namespace
+{
+
+// Process the pixels as planes, and compare with the packed processing.
+void ValidateMatrixPlanar(OCIO::ConstMatrixOpDataRcPtr & mat, unsigned line)
+{
+    OCIO::ConstOpCPURcPtr op = OCIO::GetMatrixRenderer(mat);
+    OCIO_REQUIRE_ASSERT(op->hasPlanarApply());
+
+    // Several SSE iterations and a partial one.
+    constexpr long numPixels = 11;
+
+    std::vector<float> img(4 * numPixels);
+    for (size_t idx = 0; idx < img.size(); ++idx)
+    {
+        img[idx] = float(idx) * 0.37f - 2.0f;
+    }
+
+    std::vector<float> ref(img.size());
+    op->apply(&img[0], &ref[0], numPixels);
+
+    std::vector<float> planes(img.size());
+    for (long idx = 0; idx < numPixels; ++idx)
+    {
+        for (long c = 0; c < 4; ++c)
+        {
+            planes[c * numPixels + idx] = img[4 * idx + c];
+        }
+    }
+
+    float * p[4] = { &planes[0], &planes[numPixels], &planes[2 * numPixels], &planes[3 * numPixels] };
+    op->applyPlanar(p, p, numPixels);
+
+    for (long idx = 0; idx < numPixels; ++idx)
+    {
+        for (long c = 0; c < 4; ++c)
+        {
+            OCIO_CHECK_EQUAL_FROM(planes[c * numPixels + idx], ref[4 * idx + c], line);
+        }
+    }
+}
+
+}
+
+OCIO_ADD_TEST(MatrixOpCPU, planar_renderers)
+{
+    OCIO::MatrixOpDataRcPtr mat(OCIO::MatrixOpData::CreateDiagonalMatrix(2.0));
+    OCIO::ConstMatrixOpDataRcPtr m = mat;
+    ValidateMatrixPlanar(m, __LINE__);
+
+    mat->setOffsetValue(0, 1.f);
+    mat->setOffsetValue(3, 4.f);
+    ValidateMatrixPlanar(m, __LINE__);
+
+    mat->setArrayValue(1, 0.5f);
+    mat->setArrayValue(14, -0.25f);
+    ValidateMatrixPlanar(m, __LINE__);
+
+    mat->setOffsetValue(0, 0.f);
+    mat->setOffsetValue(3, 0.f);
+    ValidateMatrixPlanar(m, __LINE__);
+}
+
+namespace
+{
+
+// Process packed RGB pixels, and compare with the packed RGBA processing of pixels
+// having a zero alpha.
+void ValidateMatrixRGB(OCIO::ConstMatrixOpDataRcPtr & mat, unsigned line)
+{
+    OCIO::ConstOpCPURcPtr op = OCIO::GetMatrixRenderer(mat);
+    OCIO_REQUIRE_ASSERT_FROM(op->hasRGBApply(), line);
+
+    // Several SSE iterations and a partial one.
+    constexpr long numPixels = 11;
+
+    std::vector<float> img(4 * numPixels);
+    std::vector<float> rgb(3 * numPixels);
+    for (long idx = 0; idx < numPixels; ++idx)
+    {
+        for (long c = 0; c < 3; ++c)
+        {
+            img[4 * idx + c] = float(3 * idx + c) * 0.37f - 2.0f;
+            rgb[3 * idx + c] = img[4 * idx + c];
+        }
+    }
+
+    std::vector<float> ref(img.size());
+    op->apply(&img[0], &ref[0], numPixels);
+
+    std::vector<float> res(rgb.size());
+    op->applyRGB(&rgb[0], &res[0], numPixels);
+
+    // In place.
+    op->applyRGB(&rgb[0], &rgb[0], numPixels);
+
+    for (long idx = 0; idx < numPixels; ++idx)
+    {
+        for (long c = 0; c < 3; ++c)
+        {
+            OCIO_CHECK_EQUAL_FROM(res[3 * idx + c], ref[4 * idx + c], line);
+            OCIO_CHECK_EQUAL_FROM(rgb[3 * idx + c], ref[4 * idx + c], line);
+        }
+    }
+}
+
+}
+
+OCIO_ADD_TEST(MatrixOpCPU, packed_rgb_renderers)
+{
+    OCIO::MatrixOpDataRcPtr mat(OCIO::MatrixOpData::CreateDiagonalMatrix(2.0));
+    OCIO::ConstMatrixOpDataRcPtr m = mat;
+    ValidateMatrixRGB(m, __LINE__);
+
+    mat->setOffsetValue(0, 1.f);
+    mat->setOffsetValue(2, 4.f);
+    ValidateMatrixRGB(m, __LINE__);
+
+    mat->setArrayValue(1, 0.5f);
+    mat->setArrayValue(6, -0.25f);
+    mat->setArrayValue(3, 0.75f);
+    ValidateMatrixRGB(m, __LINE__);
+
+    mat->setOffsetValue(0, 0.f);
+    mat->setOffsetValue(2, 0.f);
+    ValidateMatrixRGB(m, __LINE__);
+}
 
 #endif
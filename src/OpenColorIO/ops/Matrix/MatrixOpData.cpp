@@ -584,6 +584,15 @@ bool MatrixOpData::hasAlpha() const
 
 }
 
+bool MatrixOpData::touchesAlpha() const
+{
+    const ArrayDouble::Values & m = getArray().getValues();
+
+    return m[3] != 0.0 || m[7] != 0.0 || m[11] != 0.0
+        || m[12] != 0.0 || m[13] != 0.0 || m[14] != 0.0 || m[15] != 1.0
+        || m_offsets[3] != 0.0;
+}
+
 MatrixOpDataRcPtr MatrixOpData::CreateDiagonalMatrix(double diagValue)
 {
     // Create a matrix with no offset.
@@ -818,20 +827,12 @@ void MatrixOpData::finalize()
     std::ostringstream cacheIDStream;
     cacheIDStream << getID();
 
-    md5_state_t state;
-    md5_byte_t digest[16];
-
     // TODO: array and offset do not require double precison in cache.
-    md5_init(&state);
-    md5_append(&state,
-        (const md5_byte_t *)&(getArray().getValues()[0]),
-        (int)(16 * sizeof(double)));
-    md5_append(&state,
-        (const md5_byte_t *)getOffsets().getValues(),
-        (int)(4 * sizeof(double)));
-    md5_finish(&state, digest);
-
-    cacheIDStream << GetPrintableHash(digest);
+    CacheIDHasher hasher;
+    hasher.update(&(getArray().getValues()[0]), 16 * sizeof(double));
+    hasher.update(getOffsets().getValues(), 4 * sizeof(double));
+
+    cacheIDStream << hasher.digest();
     m_cacheID = cacheIDStream.str();
 }
 
@@ -994,6 +995,36 @@ OCIO_ADD_TEST(MatrixOpData, has_alpha)
 
 #undef MATRIX_TEST_HAS_ALPHA
 
+OCIO_ADD_TEST(MatrixOpData, touches_alpha)
+{
+    OCIO::MatrixOpData mat;
+    OCIO_CHECK_ASSERT(!mat.touchesAlpha());
+
+    // Only the last row & column, and the alpha offset, are concerned.
+    mat.setArrayValue(0, 2.0);
+    mat.setArrayValue(1, 0.5);
+    OCIO_CHECK_ASSERT(!mat.touchesAlpha());
+
+    // Unlike hasAlpha(), the comparisons are strict.
+    mat.setArrayValue(15, 1.0 + 1e-9);
+    OCIO_CHECK_ASSERT(!mat.hasAlpha());
+    OCIO_CHECK_ASSERT(mat.touchesAlpha());
+    mat.setArrayValue(15, 1.0);
+
+    mat.setArrayValue(12, 0.1);
+    OCIO_CHECK_ASSERT(mat.touchesAlpha());
+    mat.setArrayValue(12, 0.0);
+
+    mat.setArrayValue(7, 0.1);
+    OCIO_CHECK_ASSERT(mat.touchesAlpha());
+    mat.setArrayValue(7, 0.0);
+
+    mat.getOffsets()[3] = 0.001;
+    OCIO_CHECK_ASSERT(mat.touchesAlpha());
+    mat.getOffsets()[3] = 0.0;
+    OCIO_CHECK_ASSERT(!mat.touchesAlpha());
+}
+
 OCIO_ADD_TEST(MatrixOpData, clone)
 {
     OCIO::MatrixOpData ref;
@@ -157,6 +157,10 @@ public:
     // Returns true if the op's output combines input channels.
     bool hasChannelCrosstalk() const override { return !isDiagonal(); }
 
+    // The alpha is untouched when the last row & column (and the alpha offset)
+    // are the identity ones (i.e. strict comparisons, unlike hasAlpha()).
+    bool touchesAlpha() const override;
+
     void finalize() override;
 
     OpDataRcPtr getIdentityReplacement() const;
@@ -8,6 +8,7 @@
 #include <OpenColorIO/OpenColorIO.h>
 
 #include "BitDepthUtils.h"
+#include "GpuShader.h"
 #include "GpuShaderUtils.h"
 #include "HashUtils.h"
 #include "MathUtils.h"
@@ -53,6 +54,7 @@ OCIO_NAMESPACE_ENTER
             OpRcPtr clone() const override;
 
             std::string getInfo() const override;
+            double getCost() const override;
 
             bool isSameType(ConstOpRcPtr & op) const override;
             bool isInverse(ConstOpRcPtr & op) const override;
@@ -122,6 +124,12 @@ OCIO_NAMESPACE_ENTER
             return "<MatrixOffsetOp>";
         }
 
+        double MatrixOffsetOp::getCost() const
+        {
+            // A diagonal matrix is only a scale (and offset) per channel.
+            return matrixData()->isDiagonal() ? 0.5 : 1.0;
+        }
+
         bool MatrixOffsetOp::isSameType(ConstOpRcPtr & op) const
         {
             ConstMatrixOffsetOpRcPtr typedRcPtr = DynamicPtrCast<const MatrixOffsetOp>(op);
@@ -232,7 +240,70 @@ OCIO_NAMESPACE_ENTER
             ArrayDouble::Values values = matData->getArray().getValues();
             MatrixOpData::Offsets offs(matData->getOffsets());
 
-            if (!matData->isUnityDiagonal())
+            // When the uniform block is enabled, the code does not depend on the values.
+            float matrix[16];
+            for (unsigned row = 0; row < 4; ++row)
+            {
+                for (unsigned col = 0; col < 4; ++col)
+                {
+                    matrix[col * 4 + row] = (float)values[row * 4 + col];
+                }
+            }
+
+            const std::string matrixName 
+                = AddUniformBlockMember(*shaderDesc,
+                                        std::string(shaderDesc->getResourcePrefix()) + "matrix",
+                                        GpuShaderDesc::UNIFORM_MAT4, matrix);
+
+            if (!matrixName.empty())
+            {
+                const float offsets[4] = { (float)offs[0], (float)offs[1],
+                                           (float)offs[2], (float)offs[3] };
+
+                const std::string offsetName
+                    = AddUniformBlockMember(*shaderDesc,
+                                            std::string(shaderDesc->getResourcePrefix()) + "offset",
+                                            GpuShaderDesc::UNIFORM_VEC4, offsets);
+
+                ss.newLine() << shaderDesc->getPixelName() << " = "
+                             << ss.mat4fMul(matrixName, shaderDesc->getPixelName())
+                             << " + " << offsetName << ";";
+            }
+            else if (IsHalfPrecisionOp(*shaderDesc))
+            {
+                // Process a half copy of the pixel.
+                ss.setHalfPrecision(true);
+
+                const std::string pix(std::string(shaderDesc->getPixelName()) + "_h");
+
+                ss.newLine() << "{";
+                ss.indent();
+                ss.newLine() << ss.vec4hDecl(pix) << " = "
+                             << ss.vec4hCast(shaderDesc->getPixelName()) << ";";
+
+                if (matData->isDiagonal())
+                {
+                    ss.newLine() << pix << " = "
+                                 << ss.vec4hConst(values[0], values[5], values[10], values[15])
+                                 << " * " << pix << ";";
+                }
+                else
+                {
+                    ss.newLine() << pix << " = " << ss.mat4hMul(&values[0], pix) << ";";
+                }
+
+                if (matData->hasOffsets())
+                {
+                    ss.newLine() << pix << " = "
+                                 << ss.vec4hConst(offs[0], offs[1], offs[2], offs[3])
+                                 << " + " << pix << ";";
+                }
+
+                ss.newLine() << shaderDesc->getPixelName() << " = " << ss.vec4fCast(pix) << ";";
+                ss.dedent();
+                ss.newLine() << "}";
+            }
+            else if (!matData->isUnityDiagonal())
             {
                 if (matData->isDiagonal())
                 {
@@ -251,7 +322,7 @@ OCIO_NAMESPACE_ENTER
                 }
             }
 
-            if (matData->hasOffsets())
+            if (matrixName.empty() && !ss.isHalfPrecision() && matData->hasOffsets())
             {
                 ss.newLine() << shaderDesc->getPixelName() << " = "
                              << ss.vec4fConst((float)offs[0], (float)offs[1], (float)offs[2], (float)offs[3])
@@ -37,6 +37,7 @@ OCIO_NAMESPACE_ENTER
 
             std::string getInfo() const override { return "<AllocationNoOp>"; }
             std::string getCacheID() const override { return ""; }
+            double getCost() const override { return 0.0; }
 
             bool isSameType(ConstOpRcPtr & op) const override;
             bool isInverse(ConstOpRcPtr & op) const override;
@@ -150,22 +151,21 @@ OCIO_NAMESPACE_ENTER
             if(startIndex) *startIndex = start;
             if(endIndex) *endIndex = end;
         }
+    }
 
+    bool GetGpuAllocation(AllocationData & allocation,
+                          const OpRcPtr & op)
+    {
+        AllocationNoOpRcPtr allocationNoOpRcPtr =
+            DynamicPtrCast<AllocationNoOp>(op);
 
-        bool GetGpuAllocation(AllocationData & allocation,
-                              const OpRcPtr & op)
+        if(!allocationNoOpRcPtr)
         {
-            AllocationNoOpRcPtr allocationNoOpRcPtr =
-                DynamicPtrCast<AllocationNoOp>(op);
-
-            if(!allocationNoOpRcPtr)
-            {
-                return false;
-            }
-
-            allocationNoOpRcPtr->getGpuAllocation(allocation);
-            return true;
+            return false;
         }
+
+        allocationNoOpRcPtr->getGpuAllocation(allocation);
+        return true;
     }
 
 
@@ -319,6 +319,7 @@ OCIO_NAMESPACE_ENTER
 
             std::string getInfo() const override { return "<FileNoOp>"; }
             std::string getCacheID() const override { return ""; }
+            double getCost() const override { return 0.0; }
 
             bool isSameType(ConstOpRcPtr & op) const override;
             bool isInverse(ConstOpRcPtr & op) const override;
@@ -403,6 +404,7 @@ OCIO_NAMESPACE_ENTER
 
             std::string getInfo() const override { return "<LookNoOp>"; }
             std::string getCacheID() const override { return ""; }
+            double getCost() const override { return 0.0; }
 
             bool isSameType(ConstOpRcPtr & op) const override;
             bool isInverse(ConstOpRcPtr & op) const override;
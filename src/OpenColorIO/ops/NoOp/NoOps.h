@@ -16,6 +16,10 @@ OCIO_NAMESPACE_ENTER
     void CreateGpuAllocationNoOp(OpRcPtrVec & ops,
                                  const AllocationData & allocationData);
 
+    // Get the allocation of the op if it is an allocation NoOp.
+    bool GetGpuAllocation(AllocationData & allocation,
+                          const OpRcPtr & op);
+
 
     // Partition an opvec into 3 segments for GPU Processing
     //
@@ -46,6 +50,7 @@ OCIO_NAMESPACE_ENTER
         bool isNoOp() const override { return true; }
         bool isIdentity() const override { return true; }
         bool hasChannelCrosstalk() const override { return false; }
+        bool touchesAlpha() const override { return false; }
         void finalize() override { m_cacheID = ""; }
     };
 
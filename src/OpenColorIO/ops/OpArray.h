@@ -4,11 +4,14 @@
 #ifndef INCLUDED_OCIO_OPARRAY_H
 #define INCLUDED_OCIO_OPARRAY_H
 
+#include <memory>
 #include <sstream>
 #include <vector>
 
 #include <OpenColorIO/OpenColorIO.h>
 
+#include "HashUtils.h"
+
 OCIO_NAMESPACE_ENTER
 {
 
@@ -32,6 +35,10 @@ public:
 // other classes. Since the dimensionality of the underlying array of those 
 // classes varies, the interpretation of "length" is defined by child classes.
 // The class represents the array for a 3by1D LUT and a 3D LUT or a matrix.
+//
+// The values are copy-on-write i.e. the copies of an array (e.g. the clones of
+// a LUT) share the values until one of them is modified. Note that a reference
+// obtained from a non-const access must not be used once the array is copied.
 template<typename T> class ArrayT : public ArrayBase
 {
 public:
@@ -41,6 +48,7 @@ public:
     ArrayT()
         : m_length(0)
         , m_numColorComponents(0)
+        , m_data(std::make_shared<Values>())
     {
     }
 
@@ -55,7 +63,7 @@ public:
     {
         m_length = length;
         m_numColorComponents = numColorComponents;
-        m_data.resize(getNumValues());
+        data().resize(getNumValues());
     }
 
     void setLength(unsigned long length)
@@ -63,13 +71,13 @@ public:
         if (m_length != length)
         {
             m_length = length;
-            m_data.resize(getNumValues());
+            data().resize(getNumValues());
         }
     }
 
     void setDoubleValue(unsigned long index, double value) override
     {
-        m_data[index] = (T)value;
+        data()[index] = (T)value;
     }
 
     unsigned long getLength() const override
@@ -82,7 +90,7 @@ public:
         if (m_numColorComponents != getMaxColorComponents())
         {
             m_numColorComponents = getMaxColorComponents();
-            m_data.resize(getNumValues());
+            data().resize(getNumValues());
         }
     }
 
@@ -96,29 +104,30 @@ public:
         if (m_numColorComponents != numColorComponents)
         {
             m_numColorComponents = numColorComponents;
-            m_data.resize(getNumValues());
+            data().resize(getNumValues());
         }
     }
 
+    // Note that the values may have changed since the last adjustment so the number of
+    // color components is recomputed in both directions (i.e. the three values are kept).
     void adjustColorComponentNumber()
     {
-        if (m_numColorComponents == 3)
+        const Values & values = *m_data;
+        if ((m_numColorComponents == 3 || m_numColorComponents == 1)
+            && values.size() == m_length * 3)
         {
             bool sameCoeff = true;
             for (unsigned long idx = 0; idx < m_length && sameCoeff; ++idx)
             {
-                if (m_data[idx * 3] != m_data[idx * 3 + 1]
-                    || m_data[idx * 3] != m_data[idx * 3 + 2])
+                if (values[idx * 3] != values[idx * 3 + 1]
+                    || values[idx * 3] != values[idx * 3 + 2])
                 {
                     sameCoeff = false;
                     break;
                 }
             }
 
-            if (sameCoeff)
-            {
-                m_numColorComponents = 1;  // But keep the three values...
-            }
+            m_numColorComponents = sameCoeff ? 1 : 3;
         }
     }
 
@@ -129,22 +138,44 @@ public:
 
     inline const Values& getValues() const
     {
-        return m_data;
+        return *m_data;
     }
 
+    // Note that the non-const accesses to the values reset the values hash, and
+    // stop sharing the values with the copies of the array.
     inline Values& getValues()
     {
-        return m_data;
+        return data();
     }
 
     inline const T& operator[](unsigned long index) const
     {
-        return m_data[index];
+        return (*m_data)[index];
     }
 
     inline T& operator[](unsigned long index)
     {
-        return m_data[index];
+        return data()[index];
+    }
+
+    // Are the values shared with the array (i.e. one is a copy of the other)?
+    bool sharesValues(const ArrayT & a) const
+    {
+        return m_data == a.m_data;
+    }
+
+    // Get the hash of the values (refer to CacheIDHash()). It is only computed once
+    // until the values change, and the copies of the array inherit it so the LUTs
+    // shared by many processors (e.g. the cached file LUTs) are not hashed again for
+    // each finalization or clone.
+    const std::string & getValuesHash() const
+    {
+        if (m_valuesHash.empty())
+        {
+            m_valuesHash = CacheIDHash(reinterpret_cast<const char *>(m_data->data()),
+                                       m_data->size() * sizeof(T));
+        }
+        return m_valuesHash;
     }
 
     virtual void validate() const
@@ -156,10 +187,10 @@ public:
 
         // getNumValues is based on the dimensions claimed in the file.  Check
         // that this matches the number of values that were actually set.
-        if (m_data.size() != getNumValues())
+        if (m_data->size() != getNumValues())
         {
             std::ostringstream os;
-            os << "Array contains: " << m_data.size() << " values, ";
+            os << "Array contains: " << m_data->size() << " values, ";
             os << "but " << getNumValues() << " are expected.";
             throw Exception(os.str().c_str());
         }
@@ -170,25 +201,43 @@ public:
         if (this == &a) return true;
         return (m_length == a.m_length)
             && (m_numColorComponents == a.m_numColorComponents)
-            && (m_data == a.m_data);
+            && (m_data == a.m_data || *m_data == *a.m_data);
     }
 
     void scale(T scale)
     {
         if (scale != (T)1.)
         {
-            const size_t nbVal = m_data.size();
+            Values & values = data();
+            const size_t nbVal = values.size();
             for (size_t i = 0; i < nbVal; ++i)
             {
-                m_data[i] *= scale;
+                values[i] *= scale;
             }
         }
     }
 
 protected:
+    // Get the values to modify them i.e. copy the values if shared, and reset
+    // the values hash.
+    Values & data()
+    {
+        if (m_data.use_count() != 1)
+        {
+            m_data = std::make_shared<Values>(*m_data);
+        }
+        m_valuesHash.clear();
+        return *m_data;
+    }
+
     unsigned long m_length;
     unsigned long m_numColorComponents;
-    Values        m_data;
+
+    // The values, shared between the copies of the array until modified.
+    std::shared_ptr<Values> m_data;
+
+    // The hash of m_data, empty when not yet computed.
+    mutable std::string m_valuesHash;
 };
 
 typedef ArrayT<double> ArrayDouble;
@@ -6,19 +6,160 @@
 
 #include <OpenColorIO/OpenColorIO.h>
 
+#include "CPUInfo.h"
 #include "MathUtils.h"
 #include "ops/Range/RangeOpCPU.h"
+#include "SSE.h"
+
+#if defined(OCIO_USE_AVX)
+#include <immintrin.h>
+#endif
 
 
 OCIO_NAMESPACE_ENTER
 {
 
+namespace
+{
+
+template<bool scale, bool lower, bool upper>
+inline float ApplyRange(float t, float s, float o, float lowerBound, float upperBound)
+{
+    if(scale)
+    {
+        t = t * s + o;
+    }
+
+    // NaNs become the bounds.
+    if(lower)
+    {
+        t = std::max(lowerBound, t);
+    }
+    if(upper)
+    {
+        t = std::min(upperBound, t);
+    }
+
+    return t;
+}
+
+// Process contiguous color values i.e. packed RGB pixels or planes.
+template<bool scale, bool lower, bool upper>
+void ApplyRangeValues(const float * in, float * out, long numValues,
+                      float s, float o, float lowerBound, float upperBound)
+{
+    long idx = 0;
+
+#ifdef USE_SSE
+    // Note that _mm_max_ps() & _mm_min_ps() return their second argument for NaNs
+    // i.e. the same results as the std::max() & std::min() calls.
+    const __m128 sv = _mm_set1_ps(s);
+    const __m128 ov = _mm_set1_ps(o);
+    const __m128 lv = _mm_set1_ps(lowerBound);
+    const __m128 uv = _mm_set1_ps(upperBound);
+
+    for(; idx + 4 <= numValues; idx += 4)
+    {
+        __m128 t = _mm_loadu_ps(in + idx);
+        if(scale)
+        {
+            t = _mm_add_ps(_mm_mul_ps(t, sv), ov);
+        }
+        if(lower)
+        {
+            t = _mm_max_ps(t, lv);
+        }
+        if(upper)
+        {
+            t = _mm_min_ps(t, uv);
+        }
+        _mm_storeu_ps(out + idx, t);
+    }
+#endif
+
+    for(; idx < numValues; ++idx)
+    {
+        out[idx] = ApplyRange<scale, lower, upper>(in[idx], s, o, lowerBound, upperBound);
+    }
+}
+
+// Process packed RGBA pixels, the alpha values being copied.
+template<bool scale, bool lower, bool upper>
+void ApplyRangeRGBA(const float * in, float * out, long numPixels,
+                    float s, float o, float lowerBound, float upperBound)
+{
+#ifdef USE_SSE
+    const __m128 sv = _mm_set1_ps(s);
+    const __m128 ov = _mm_set1_ps(o);
+    const __m128 lv = _mm_set1_ps(lowerBound);
+    const __m128 uv = _mm_set1_ps(upperBound);
+
+    const __m128 alphaMask = _mm_castsi128_ps(_mm_set_epi32(-1, 0, 0, 0));
+
+    for(long idx=0; idx<numPixels; ++idx)
+    {
+        const __m128 pix = _mm_loadu_ps(in);
+
+        __m128 t = pix;
+        if(scale)
+        {
+            t = _mm_add_ps(_mm_mul_ps(t, sv), ov);
+        }
+        if(lower)
+        {
+            t = _mm_max_ps(t, lv);
+        }
+        if(upper)
+        {
+            t = _mm_min_ps(t, uv);
+        }
+
+        _mm_storeu_ps(out, _mm_or_ps(_mm_andnot_ps(alphaMask, t),
+                                     _mm_and_ps(alphaMask, pix)));
+
+        in  += 4;
+        out += 4;
+    }
+#else
+    for(long idx=0; idx<numPixels; ++idx)
+    {
+        out[0] = ApplyRange<scale, lower, upper>(in[0], s, o, lowerBound, upperBound);
+        out[1] = ApplyRange<scale, lower, upper>(in[1], s, o, lowerBound, upperBound);
+        out[2] = ApplyRange<scale, lower, upper>(in[2], s, o, lowerBound, upperBound);
+        out[3] = in[3];
+
+        in  += 4;
+        out += 4;
+    }
+#endif
+}
+
+}
+
 class RangeOpCPU : public OpCPU
 {
 public:
 
     RangeOpCPU(ConstRangeOpDataRcPtr & range);
 
+    bool hasPlanarApply() const override { return true; }
+    bool hasRGBApply() const override { return true; }
+
+protected:
+    // Process the packed RGBA pixels, copying the alpha values.
+    template<bool scale, bool lower, bool upper>
+    void applyRGBARange(const float * in, float * out, long numPixels) const;
+
+    // Process the RGB planes and copy the alpha plane, doing the same computations
+    // than the corresponding packed renderer.
+    template<bool scale, bool lower, bool upper>
+    void applyPlanarRange(const float * const * inPlanes, float * const * outPlanes,
+                          long numPixels) const;
+
+    // Process the packed RGB pixels i.e. the three channels have the same parameters.
+    template<bool scale, bool lower, bool upper>
+    void applyRGBRange(const float * in, float * out, long numPixels) const;
+
 protected:
     float m_scale;
     float m_offset;
@@ -35,6 +176,9 @@ public:
     RangeScaleMinMaxRenderer(ConstRangeOpDataRcPtr & range);
 
     virtual void apply(const void * inImg, void * outImg, long numPixels) const override;
+    void applyPlanar(const float * const * inPlanes, float * const * outPlanes,
+                     long numPixels) const override;
+    void applyRGB(const float * inImg, float * outImg, long numPixels) const override;
 };
 
 class RangeScaleMinRenderer : public RangeOpCPU
@@ -43,6 +187,9 @@ public:
     RangeScaleMinRenderer(ConstRangeOpDataRcPtr & range);
 
     virtual void apply(const void * inImg, void * outImg, long numPixels) const override;
+    void applyPlanar(const float * const * inPlanes, float * const * outPlanes,
+                     long numPixels) const override;
+    void applyRGB(const float * inImg, float * outImg, long numPixels) const override;
 };
 
 class RangeScaleMaxRenderer : public RangeOpCPU
@@ -51,6 +198,9 @@ public:
     RangeScaleMaxRenderer(ConstRangeOpDataRcPtr & range);
 
     virtual void apply(const void * inImg, void * outImg, long numPixels) const override;
+    void applyPlanar(const float * const * inPlanes, float * const * outPlanes,
+                     long numPixels) const override;
+    void applyRGB(const float * inImg, float * outImg, long numPixels) const override;
 };
 
 class RangeScaleRenderer : public RangeOpCPU
@@ -59,6 +209,9 @@ public:
     RangeScaleRenderer(ConstRangeOpDataRcPtr & range);
 
     virtual void apply(const void * inImg, void * outImg, long numPixels) const override;
+    void applyPlanar(const float * const * inPlanes, float * const * outPlanes,
+                     long numPixels) const override;
+    void applyRGB(const float * inImg, float * outImg, long numPixels) const override;
 };
 
 class RangeMinMaxRenderer : public RangeOpCPU
@@ -67,6 +220,9 @@ public:
     RangeMinMaxRenderer(ConstRangeOpDataRcPtr & range);
 
     virtual void apply(const void * inImg, void * outImg, long numPixels) const override;
+    void applyPlanar(const float * const * inPlanes, float * const * outPlanes,
+                     long numPixels) const override;
+    void applyRGB(const float * inImg, float * outImg, long numPixels) const override;
 };
 
 class RangeMinRenderer : public RangeOpCPU
@@ -75,6 +231,9 @@ public:
     RangeMinRenderer(ConstRangeOpDataRcPtr & range);
 
     virtual void apply(const void * inImg, void * outImg, long numPixels) const override;
+    void applyPlanar(const float * const * inPlanes, float * const * outPlanes,
+                     long numPixels) const override;
+    void applyRGB(const float * inImg, float * outImg, long numPixels) const override;
 };
 
 class RangeMaxRenderer : public RangeOpCPU
@@ -83,6 +242,9 @@ public:
     RangeMaxRenderer(ConstRangeOpDataRcPtr & range);
 
     virtual void apply(const void * inImg, void * outImg, long numPixels) const override;
+    void applyPlanar(const float * const * inPlanes, float * const * outPlanes,
+                     long numPixels) const override;
+    void applyRGB(const float * inImg, float * outImg, long numPixels) const override;
 };
 
 
@@ -99,6 +261,36 @@ RangeOpCPU::RangeOpCPU(ConstRangeOpDataRcPtr & range)
     m_upperBound = (float)range->getMaxOutValue();
 }
 
+template<bool scale, bool lower, bool upper>
+void RangeOpCPU::applyRGBARange(const float * in, float * out, long numPixels) const
+{
+    ApplyRangeRGBA<scale, lower, upper>(in, out, numPixels,
+                                        m_scale, m_offset, m_lowerBound, m_upperBound);
+}
+
+template<bool scale, bool lower, bool upper>
+void RangeOpCPU::applyPlanarRange(const float * const * inPlanes, float * const * outPlanes,
+                                  long numPixels) const
+{
+    for(int c=0; c<3; ++c)
+    {
+        ApplyRangeValues<scale, lower, upper>(inPlanes[c], outPlanes[c], numPixels,
+                                              m_scale, m_offset, m_lowerBound, m_upperBound);
+    }
+
+    if(inPlanes[3]!=outPlanes[3])
+    {
+        std::copy(inPlanes[3], inPlanes[3] + numPixels, outPlanes[3]);
+    }
+}
+
+template<bool scale, bool lower, bool upper>
+void RangeOpCPU::applyRGBRange(const float * in, float * out, long numPixels) const
+{
+    ApplyRangeValues<scale, lower, upper>(in, out, 3 * numPixels,
+                                          m_scale, m_offset, m_lowerBound, m_upperBound);
+}
+
 RangeScaleMinMaxRenderer::RangeScaleMinMaxRenderer(ConstRangeOpDataRcPtr & range)
     :  RangeOpCPU(range)
 {
@@ -106,24 +298,18 @@ RangeScaleMinMaxRenderer::RangeScaleMinMaxRenderer(ConstRangeOpDataRcPtr & range
 
 void RangeScaleMinMaxRenderer::apply(const void * inImg, void * outImg, long numPixels) const
 {
-    const float * in = (const float *)inImg;
-    float * out = (float *)outImg;
-
-    for(long idx=0; idx<numPixels; ++idx)
-    {
-        const float t[3] = { in[0] * m_scale + m_offset,
-                             in[1] * m_scale + m_offset,
-                             in[2] * m_scale + m_offset };
+    applyRGBARange<true, true, true>((const float *)inImg, (float *)outImg, numPixels);
+}
 
-        // NaNs become m_lowerBound.
-        out[0] = Clamp(t[0], m_lowerBound, m_upperBound);
-        out[1] = Clamp(t[1], m_lowerBound, m_upperBound);
-        out[2] = Clamp(t[2], m_lowerBound, m_upperBound);
-        out[3] = in[3];
+void RangeScaleMinMaxRenderer::applyPlanar(const float * const * inPlanes, float * const * outPlanes,
+                                           long numPixels) const
+{
+    applyPlanarRange<true, true, true>(inPlanes, outPlanes, numPixels);
+}
 
-        in  += 4;
-        out += 4;
-    }
+void RangeScaleMinMaxRenderer::applyRGB(const float * inImg, float * outImg, long numPixels) const
+{
+    applyRGBRange<true, true, true>(inImg, outImg, numPixels);
 }
 
 RangeScaleMinRenderer::RangeScaleMinRenderer(ConstRangeOpDataRcPtr & range)
@@ -133,24 +319,18 @@ RangeScaleMinRenderer::RangeScaleMinRenderer(ConstRangeOpDataRcPtr & range)
 
 void RangeScaleMinRenderer::apply(const void * inImg, void * outImg, long numPixels) const
 {
-    const float * in = (const float *)inImg;
-    float * out = (float *)outImg;
-
-    for(long idx=0; idx<numPixels; ++idx)
-    {
-        out[0] = in[0] * m_scale + m_offset;
-        out[1] = in[1] * m_scale + m_offset;
-        out[2] = in[2] * m_scale + m_offset;
+    applyRGBARange<true, true, false>((const float *)inImg, (float *)outImg, numPixels);
+}
 
-        // NaNs become m_lowerBound.
-        out[0] = std::max(m_lowerBound, out[0]);
-        out[1] = std::max(m_lowerBound, out[1]);
-        out[2] = std::max(m_lowerBound, out[2]);
-        out[3] = in[3];
+void RangeScaleMinRenderer::applyPlanar(const float * const * inPlanes, float * const * outPlanes,
+                                        long numPixels) const
+{
+    applyPlanarRange<true, true, false>(inPlanes, outPlanes, numPixels);
+}
 
-        in  += 4;
-        out += 4;
-    }
+void RangeScaleMinRenderer::applyRGB(const float * inImg, float * outImg, long numPixels) const
+{
+    applyRGBRange<true, true, false>(inImg, outImg, numPixels);
 }
 
 RangeScaleMaxRenderer::RangeScaleMaxRenderer(ConstRangeOpDataRcPtr & range)
@@ -160,24 +340,18 @@ RangeScaleMaxRenderer::RangeScaleMaxRenderer(ConstRangeOpDataRcPtr & range)
 
 void RangeScaleMaxRenderer::apply(const void * inImg, void * outImg, long numPixels) const
 {
-    const float * in = (const float *)inImg;
-    float * out = (float *)outImg;
-
-    for(long idx=0; idx<numPixels; ++idx)
-    {
-        out[0] = in[0] * m_scale + m_offset;
-        out[1] = in[1] * m_scale + m_offset;
-        out[2] = in[2] * m_scale + m_offset;
+    applyRGBARange<true, false, true>((const float *)inImg, (float *)outImg, numPixels);
+}
 
-        // NaNs become m_upperBound.
-        out[0] = std::min(m_upperBound, out[0]),
-        out[1] = std::min(m_upperBound, out[1]),
-        out[2] = std::min(m_upperBound, out[2]),
-        out[3] = in[3];
+void RangeScaleMaxRenderer::applyPlanar(const float * const * inPlanes, float * const * outPlanes,
+                                        long numPixels) const
+{
+    applyPlanarRange<true, false, true>(inPlanes, outPlanes, numPixels);
+}
 
-        in  += 4;
-        out += 4;
-    }
+void RangeScaleMaxRenderer::applyRGB(const float * inImg, float * outImg, long numPixels) const
+{
+    applyRGBRange<true, false, true>(inImg, outImg, numPixels);
 }
 
 // NOTE: Currently there is no way to create the Scale renderer.  If a Range Op
@@ -192,19 +366,18 @@ RangeScaleRenderer::RangeScaleRenderer(ConstRangeOpDataRcPtr & range)
 
 void RangeScaleRenderer::apply(const void * inImg, void * outImg, long numPixels) const
 {
-    const float * in = (const float *)inImg;
-    float * out = (float *)outImg;
+    applyRGBARange<true, false, false>((const float *)inImg, (float *)outImg, numPixels);
+}
 
-    for(long idx=0; idx<numPixels; ++idx)
-    {
-        out[0] = in[0] * m_scale + m_offset;
-        out[1] = in[1] * m_scale + m_offset;
-        out[2] = in[2] * m_scale + m_offset;
-        out[3] = in[3];
+void RangeScaleRenderer::applyPlanar(const float * const * inPlanes, float * const * outPlanes,
+                                     long numPixels) const
+{
+    applyPlanarRange<true, false, false>(inPlanes, outPlanes, numPixels);
+}
 
-        in  += 4;
-        out += 4;
-    }
+void RangeScaleRenderer::applyRGB(const float * inImg, float * outImg, long numPixels) const
+{
+    applyRGBRange<true, false, false>(inImg, outImg, numPixels);
 }
 
 RangeMinMaxRenderer::RangeMinMaxRenderer(ConstRangeOpDataRcPtr & range)
@@ -214,20 +387,18 @@ RangeMinMaxRenderer::RangeMinMaxRenderer(ConstRangeOpDataRcPtr & range)
 
 void RangeMinMaxRenderer::apply(const void * inImg, void * outImg, long numPixels) const
 {
-    const float * in = (const float *)inImg;
-    float * out = (float *)outImg;
+    applyRGBARange<false, true, true>((const float *)inImg, (float *)outImg, numPixels);
+}
 
-    for(long idx=0; idx<numPixels; ++idx)
-    {
-        // NaNs become m_lowerBound.
-        out[0] = Clamp(in[0], m_lowerBound, m_upperBound);
-        out[1] = Clamp(in[1], m_lowerBound, m_upperBound);
-        out[2] = Clamp(in[2], m_lowerBound, m_upperBound);
-        out[3] = in[3];
+void RangeMinMaxRenderer::applyPlanar(const float * const * inPlanes, float * const * outPlanes,
+                                      long numPixels) const
+{
+    applyPlanarRange<false, true, true>(inPlanes, outPlanes, numPixels);
+}
 
-        in  += 4;
-        out += 4;
-    }
+void RangeMinMaxRenderer::applyRGB(const float * inImg, float * outImg, long numPixels) const
+{
+    applyRGBRange<false, true, true>(inImg, outImg, numPixels);
 }
 
 RangeMinRenderer::RangeMinRenderer(ConstRangeOpDataRcPtr & range)
@@ -237,20 +408,18 @@ RangeMinRenderer::RangeMinRenderer(ConstRangeOpDataRcPtr & range)
 
 void RangeMinRenderer::apply(const void * inImg, void * outImg, long numPixels) const
 {
-    const float * in = (const float *)inImg;
-    float * out = (float *)outImg;
+    applyRGBARange<false, true, false>((const float *)inImg, (float *)outImg, numPixels);
+}
 
-    for(long idx=0; idx<numPixels; ++idx)
-    {
-        // NaNs become m_lowerBound.
-        out[0] = std::max(m_lowerBound, in[0]);
-        out[1] = std::max(m_lowerBound, in[1]);
-        out[2] = std::max(m_lowerBound, in[2]);
-        out[3] = in[3];
+void RangeMinRenderer::applyPlanar(const float * const * inPlanes, float * const * outPlanes,
+                                   long numPixels) const
+{
+    applyPlanarRange<false, true, false>(inPlanes, outPlanes, numPixels);
+}
 
-        in  += 4;
-        out += 4;
-    }
+void RangeMinRenderer::applyRGB(const float * inImg, float * outImg, long numPixels) const
+{
+    applyRGBRange<false, true, false>(inImg, outImg, numPixels);
 }
 
 RangeMaxRenderer::RangeMaxRenderer(ConstRangeOpDataRcPtr & range)
@@ -260,22 +429,317 @@ RangeMaxRenderer::RangeMaxRenderer(ConstRangeOpDataRcPtr & range)
 
 void RangeMaxRenderer::apply(const void * inImg, void * outImg, long numPixels) const
 {
-    const float * in = (const float *)inImg;
-    float * out = (float *)outImg;
+    applyRGBARange<false, false, true>((const float *)inImg, (float *)outImg, numPixels);
+}
 
-    for(long idx=0; idx<numPixels; ++idx)
+
+void RangeMaxRenderer::applyPlanar(const float * const * inPlanes, float * const * outPlanes,
+                                   long numPixels) const
+{
+    applyPlanarRange<false, false, true>(inPlanes, outPlanes, numPixels);
+}
+
+void RangeMaxRenderer::applyRGB(const float * inImg, float * outImg, long numPixels) const
+{
+    applyRGBRange<false, false, true>(inImg, outImg, numPixels);
+}
+
+#if defined(OCIO_USE_AVX)
+
+// The AVX variants process several pixels per instruction but do exactly the same
+// operations than the SSE implementation, so all the CPUs produce identical results.
+
+template<bool scale, bool lower, bool upper>
+OCIO_TARGET_AVX2
+inline __m256 ApplyRangeAVX2(__m256 t, const __m256 & s, const __m256 & o,
+                             const __m256 & lowerBound, const __m256 & upperBound)
+{
+    if(scale)
+    {
+        t = _mm256_add_ps(_mm256_mul_ps(t, s), o);
+    }
+    if(lower)
+    {
+        t = _mm256_max_ps(t, lowerBound);
+    }
+    if(upper)
+    {
+        t = _mm256_min_ps(t, upperBound);
+    }
+    return t;
+}
+
+template<bool scale, bool lower, bool upper>
+OCIO_TARGET_AVX2
+void ApplyRangeValuesAVX2(const float * in, float * out, long numValues,
+                          float s, float o, float lowerBound, float upperBound)
+{
+    const __m256 sv = _mm256_set1_ps(s);
+    const __m256 ov = _mm256_set1_ps(o);
+    const __m256 lv = _mm256_set1_ps(lowerBound);
+    const __m256 uv = _mm256_set1_ps(upperBound);
+
+    long idx = 0;
+    for(; idx + 32 <= numValues; idx += 32)
+    {
+        __m256 t[4];
+        for(int i = 0; i < 4; ++i)
+        {
+            t[i] = ApplyRangeAVX2<scale, lower, upper>(_mm256_loadu_ps(in + idx + 8 * i),
+                                                       sv, ov, lv, uv);
+        }
+        for(int i = 0; i < 4; ++i)
+        {
+            _mm256_storeu_ps(out + idx + 8 * i, t[i]);
+        }
+    }
+
+    for(; idx + 8 <= numValues; idx += 8)
+    {
+        _mm256_storeu_ps(out + idx,
+                         ApplyRangeAVX2<scale, lower, upper>(_mm256_loadu_ps(in + idx),
+                                                             sv, ov, lv, uv));
+    }
+
+    // Process the remaining values.
+    for(; idx < numValues; ++idx)
+    {
+        out[idx] = ApplyRange<scale, lower, upper>(in[idx], s, o, lowerBound, upperBound);
+    }
+}
+
+template<bool scale, bool lower, bool upper>
+OCIO_TARGET_AVX2
+void ApplyRangeRGBAAVX2(const float * in, float * out, long numPixels,
+                        float s, float o, float lowerBound, float upperBound)
+{
+    const __m256 sv = _mm256_set1_ps(s);
+    const __m256 ov = _mm256_set1_ps(o);
+    const __m256 lv = _mm256_set1_ps(lowerBound);
+    const __m256 uv = _mm256_set1_ps(upperBound);
+
+    long idx = 0;
+    for(; idx + 2 <= numPixels; idx += 2)
+    {
+        const __m256 pix = _mm256_loadu_ps(in);
+        const __m256 t = ApplyRangeAVX2<scale, lower, upper>(pix, sv, ov, lv, uv);
+
+        // Copy the alpha values.
+        _mm256_storeu_ps(out, _mm256_blend_ps(t, pix, 0x88));
+
+        in  += 8;
+        out += 8;
+    }
+
+    // Process the remaining pixel.
+    if(idx < numPixels)
     {
-        // NaNs become m_upperBound.
-        out[0] = std::min(m_upperBound, in[0]);
-        out[1] = std::min(m_upperBound, in[1]);
-        out[2] = std::min(m_upperBound, in[2]);
+        out[0] = ApplyRange<scale, lower, upper>(in[0], s, o, lowerBound, upperBound);
+        out[1] = ApplyRange<scale, lower, upper>(in[1], s, o, lowerBound, upperBound);
+        out[2] = ApplyRange<scale, lower, upper>(in[2], s, o, lowerBound, upperBound);
         out[3] = in[3];
+    }
+}
 
-        in  += 4;
-        out += 4;
+OCIO_AVX512_DIAGNOSTIC_PUSH
+
+template<bool scale, bool lower, bool upper>
+OCIO_TARGET_AVX512
+inline __m512 ApplyRangeAVX512(__m512 t, const __m512 & s, const __m512 & o,
+                               const __m512 & lowerBound, const __m512 & upperBound)
+{
+    if(scale)
+    {
+        t = _mm512_add_ps(_mm512_mul_ps(t, s), o);
+    }
+    if(lower)
+    {
+        t = _mm512_max_ps(t, lowerBound);
+    }
+    if(upper)
+    {
+        t = _mm512_min_ps(t, upperBound);
     }
+    return t;
 }
 
+template<bool scale, bool lower, bool upper>
+OCIO_TARGET_AVX512
+void ApplyRangeValuesAVX512(const float * in, float * out, long numValues,
+                            float s, float o, float lowerBound, float upperBound)
+{
+    const __m512 sv = _mm512_set1_ps(s);
+    const __m512 ov = _mm512_set1_ps(o);
+    const __m512 lv = _mm512_set1_ps(lowerBound);
+    const __m512 uv = _mm512_set1_ps(upperBound);
+
+    long idx = 0;
+    for(; idx + 16 <= numValues; idx += 16)
+    {
+        _mm512_storeu_ps(out + idx,
+                         ApplyRangeAVX512<scale, lower, upper>(_mm512_loadu_ps(in + idx),
+                                                               sv, ov, lv, uv));
+    }
+
+    // Process the remaining values using masked loads & stores.
+    if(idx < numValues)
+    {
+        const __mmask16 mask = (__mmask16)((1u << (numValues - idx)) - 1u);
+        const __m512 t = _mm512_maskz_loadu_ps(mask, in + idx);
+        _mm512_mask_storeu_ps(out + idx, mask,
+                              ApplyRangeAVX512<scale, lower, upper>(t, sv, ov, lv, uv));
+    }
+}
+
+template<bool scale, bool lower, bool upper>
+OCIO_TARGET_AVX512
+void ApplyRangeRGBAAVX512(const float * in, float * out, long numPixels,
+                          float s, float o, float lowerBound, float upperBound)
+{
+    const __m512 sv = _mm512_set1_ps(s);
+    const __m512 ov = _mm512_set1_ps(o);
+    const __m512 lv = _mm512_set1_ps(lowerBound);
+    const __m512 uv = _mm512_set1_ps(upperBound);
+
+    // Copy the alpha values.
+    const __mmask16 alphaMask = 0x8888;
+
+    long idx = 0;
+    for(; idx + 4 <= numPixels; idx += 4)
+    {
+        const __m512 pix = _mm512_loadu_ps(in);
+        const __m512 t = ApplyRangeAVX512<scale, lower, upper>(pix, sv, ov, lv, uv);
+
+        _mm512_storeu_ps(out, _mm512_mask_blend_ps(alphaMask, t, pix));
+
+        in  += 16;
+        out += 16;
+    }
+
+    // Process the remaining pixels using masked loads & stores.
+    if(idx < numPixels)
+    {
+        const __mmask16 mask = (__mmask16)((1u << (4 * (numPixels - idx))) - 1u);
+
+        const __m512 pix = _mm512_maskz_loadu_ps(mask, in);
+        const __m512 t = ApplyRangeAVX512<scale, lower, upper>(pix, sv, ov, lv, uv);
+
+        _mm512_mask_storeu_ps(out, mask, _mm512_mask_blend_ps(alphaMask, t, pix));
+    }
+}
+
+OCIO_AVX512_DIAGNOSTIC_POP
+
+// The vectorized variant of a Range renderer i.e. 'Renderer' is the renderer of the
+// Range style and 'Kernels' provides the functions for the vector unit.
+template<typename Renderer, typename Kernels, bool scale, bool lower, bool upper>
+class RangeVectorRenderer : public Renderer
+{
+public:
+    explicit RangeVectorRenderer(ConstRangeOpDataRcPtr & range)
+        :  Renderer(range) {}
+
+    void apply(const void * inImg, void * outImg, long numPixels) const override
+    {
+        Kernels::template ApplyRGBA<scale, lower, upper>(
+            (const float *)inImg, (float *)outImg, numPixels,
+            this->m_scale, this->m_offset, this->m_lowerBound, this->m_upperBound);
+    }
+
+    void applyPlanar(const float * const * inPlanes, float * const * outPlanes,
+                     long numPixels) const override
+    {
+        for(int c=0; c<3; ++c)
+        {
+            Kernels::template ApplyValues<scale, lower, upper>(
+                inPlanes[c], outPlanes[c], numPixels,
+                this->m_scale, this->m_offset, this->m_lowerBound, this->m_upperBound);
+        }
+
+        if(inPlanes[3]!=outPlanes[3])
+        {
+            std::copy(inPlanes[3], inPlanes[3] + numPixels, outPlanes[3]);
+        }
+    }
+
+    void applyRGB(const float * inImg, float * outImg, long numPixels) const override
+    {
+        Kernels::template ApplyValues<scale, lower, upper>(
+            inImg, outImg, 3 * numPixels,
+            this->m_scale, this->m_offset, this->m_lowerBound, this->m_upperBound);
+    }
+};
+
+// 8-wide kernels.
+struct RangeAVX2Kernels
+{
+    template<bool scale, bool lower, bool upper>
+    static void ApplyValues(const float * in, float * out, long numValues,
+                            float s, float o, float lowerBound, float upperBound)
+    {
+        ApplyRangeValuesAVX2<scale, lower, upper>(in, out, numValues,
+                                                  s, o, lowerBound, upperBound);
+    }
+
+    template<bool scale, bool lower, bool upper>
+    static void ApplyRGBA(const float * in, float * out, long numPixels,
+                          float s, float o, float lowerBound, float upperBound)
+    {
+        ApplyRangeRGBAAVX2<scale, lower, upper>(in, out, numPixels,
+                                                s, o, lowerBound, upperBound);
+    }
+};
+
+// 16-wide kernels.
+struct RangeAVX512Kernels
+{
+    template<bool scale, bool lower, bool upper>
+    static void ApplyValues(const float * in, float * out, long numValues,
+                            float s, float o, float lowerBound, float upperBound)
+    {
+        ApplyRangeValuesAVX512<scale, lower, upper>(in, out, numValues,
+                                                    s, o, lowerBound, upperBound);
+    }
+
+    template<bool scale, bool lower, bool upper>
+    static void ApplyRGBA(const float * in, float * out, long numPixels,
+                          float s, float o, float lowerBound, float upperBound)
+    {
+        ApplyRangeRGBAAVX512<scale, lower, upper>(in, out, numPixels,
+                                                  s, o, lowerBound, upperBound);
+    }
+};
+
+template<typename Renderer, bool scale, bool lower, bool upper>
+using RangeAVX2Renderer
+    = RangeVectorRenderer<Renderer, RangeAVX2Kernels, scale, lower, upper>;
+
+template<typename Renderer, bool scale, bool lower, bool upper>
+using RangeAVX512Renderer
+    = RangeVectorRenderer<Renderer, RangeAVX512Kernels, scale, lower, upper>;
+
+#endif // OCIO_USE_AVX
+
+// Create the renderer of a Range style, selecting the widest vector unit available
+// on the CPU.
+template<typename Renderer, bool scale, bool lower, bool upper>
+ConstOpCPURcPtr CreateRangeRenderer(ConstRangeOpDataRcPtr & range)
+{
+#if defined(OCIO_USE_AVX)
+    const CPUInfo & cpuInfo = CPUInfo::Instance();
+
+    if (cpuInfo.hasAVX512F())
+    {
+        return std::make_shared<RangeAVX512Renderer<Renderer, scale, lower, upper>>(range);
+    }
+    else if (cpuInfo.hasAVX2())
+    {
+        return std::make_shared<RangeAVX2Renderer<Renderer, scale, lower, upper>>(range);
+    }
+#endif
+
+    return std::make_shared<Renderer>(range);
+}
 
 ConstOpCPURcPtr GetRangeRenderer(ConstRangeOpDataRcPtr & range)
 {
@@ -285,23 +749,23 @@ ConstOpCPURcPtr GetRangeRenderer(ConstRangeOpDataRcPtr & range)
         {
             if (!range->maxIsEmpty())
             {
-                return std::make_shared<RangeScaleMinMaxRenderer>(range);
+                return CreateRangeRenderer<RangeScaleMinMaxRenderer, true, true, true>(range);
             }
             else
             {
-                return std::make_shared<RangeScaleMinRenderer>(range);
+                return CreateRangeRenderer<RangeScaleMinRenderer, true, true, false>(range);
             }
         }
         else
         {
             if (!range->maxIsEmpty())
             {
-                return std::make_shared<RangeScaleMaxRenderer>(range);
+                return CreateRangeRenderer<RangeScaleMaxRenderer, true, false, true>(range);
             }
             else
             {
                 // (Currently we will not get here, see comment above.)
-                return std::make_shared<RangeScaleRenderer>(range);
+                return CreateRangeRenderer<RangeScaleRenderer, true, false, false>(range);
             }
         }
     }
@@ -311,16 +775,16 @@ ConstOpCPURcPtr GetRangeRenderer(ConstRangeOpDataRcPtr & range)
         {
             if (!range->maxIsEmpty())
             {
-                return std::make_shared<RangeMinMaxRenderer>(range);
+                return CreateRangeRenderer<RangeMinMaxRenderer, false, true, true>(range);
             }
             else
             {
-                return std::make_shared<RangeMinRenderer>(range);
+                return CreateRangeRenderer<RangeMinRenderer, false, true, false>(range);
             }
         }
         else if (!range->maxIsEmpty())
         {
-            return std::make_shared<RangeMaxRenderer>(range);
+            return CreateRangeRenderer<RangeMaxRenderer, false, false, true>(range);
         }
 
         // Else, no rendering/scaling is needed.
@@ -343,6 +807,7 @@ OCIO_NAMESPACE_EXIT
 
 namespace OCIO = OCIO_NAMESPACE;
 
+#include <cstring>
 #include <limits>
 #include "ops/Range/RangeOpData.h"
 #include "pystring/pystring.h"
@@ -791,6 +1256,232 @@ OCIO_ADD_TEST(RangeOpCPU, high_clipping)
     OCIO_CHECK_CLOSE(image[11],  0.00f, g_error);
 }
 
+OCIO_ADD_TEST(RangeOpCPU, planar_renderers)
+{
+    const double empty = OCIO::RangeOpData::EmptyValue();
+
+    // Scale with low & high clippings, low clipping, high clipping, and only clippings.
+    const double values[][4] = { {  0.,    1.,     0.5,   1.5 },
+                                 {  0.,    empty,  0.5,   empty },
+                                 {  empty, 1.,     empty, 1.5 },
+                                 {  0.,    1.,     0.,    1. },
+                                 {  0.1,   empty,  0.1,   empty },
+                                 {  empty, 0.9,    empty, 0.9 } };
+
+    const float qnan = std::numeric_limits<float>::quiet_NaN();
+    const float inf = std::numeric_limits<float>::infinity();
+
+    constexpr long numPixels = 5;
+    const float image[4*numPixels] = { -0.50f, -0.25f, 0.50f, 0.0f,
+                                        0.75f,  1.00f, 1.25f, 1.0f,
+                                         qnan,   qnan,  qnan, 0.3f,
+                                          inf,    inf,   inf, 0.0f,
+                                         -inf,   -inf,  -inf, 0.7f };
+
+    for (const auto & v : values)
+    {
+        OCIO::RangeOpDataRcPtr range = std::make_shared<OCIO::RangeOpData>(v[0], v[1], v[2], v[3]);
+        OCIO_CHECK_NO_THROW(range->validate());
+        OCIO_CHECK_NO_THROW(range->finalize());
+
+        OCIO::ConstRangeOpDataRcPtr r = range;
+        OCIO::ConstOpCPURcPtr op = OCIO::GetRangeRenderer(r);
+        OCIO_REQUIRE_ASSERT(op->hasPlanarApply());
+
+        float ref[4*numPixels];
+        op->apply(image, ref, numPixels);
+
+        float planes[4][numPixels];
+        for (long idx = 0; idx < numPixels; ++idx)
+        {
+            for (long c = 0; c < 4; ++c)
+            {
+                planes[c][idx] = image[4 * idx + c];
+            }
+        }
+
+        const float * in[4] = { planes[0], planes[1], planes[2], planes[3] };
+        float res[4][numPixels];
+        float * out[4] = { res[0], res[1], res[2], res[3] };
+        op->applyPlanar(in, out, numPixels);
+
+        for (long idx = 0; idx < numPixels; ++idx)
+        {
+            for (long c = 0; c < 4; ++c)
+            {
+                OCIO_CHECK_EQUAL(res[c][idx], ref[4 * idx + c]);
+            }
+        }
+    }
+}
+
+OCIO_ADD_TEST(RangeOpCPU, packed_rgb_renderers)
+{
+    const double empty = OCIO::RangeOpData::EmptyValue();
+
+    // Scale with low & high clippings, low clipping, high clipping, and only clippings.
+    const double values[][4] = { {  0.,    1.,     0.5,   1.5 },
+                                 {  0.,    empty,  0.5,   empty },
+                                 {  empty, 1.,     empty, 1.5 },
+                                 {  0.,    1.,     0.,    1. },
+                                 {  0.1,   empty,  0.1,   empty },
+                                 {  empty, 0.9,    empty, 0.9 } };
+
+    const float inf = std::numeric_limits<float>::infinity();
+
+    constexpr long numPixels = 5;
+    const float image[4*numPixels] = { -0.50f, -0.25f, 0.50f, 0.0f,
+                                        0.75f,  1.00f, 1.25f, 1.0f,
+                                        0.10f,  0.30f, 0.90f, 0.3f,
+                                          inf,    inf,   inf, 0.0f,
+                                         -inf,   -inf,  -inf, 0.7f };
+
+    for (const auto & v : values)
+    {
+        OCIO::RangeOpDataRcPtr range = std::make_shared<OCIO::RangeOpData>(v[0], v[1], v[2], v[3]);
+        OCIO_CHECK_NO_THROW(range->validate());
+        OCIO_CHECK_NO_THROW(range->finalize());
+
+        OCIO::ConstRangeOpDataRcPtr r = range;
+        OCIO::ConstOpCPURcPtr op = OCIO::GetRangeRenderer(r);
+        OCIO_REQUIRE_ASSERT(op->hasRGBApply());
+
+        float ref[4*numPixels];
+        op->apply(image, ref, numPixels);
+
+        float rgb[3*numPixels];
+        for (long idx = 0; idx < numPixels; ++idx)
+        {
+            for (long c = 0; c < 3; ++c)
+            {
+                rgb[3 * idx + c] = image[4 * idx + c];
+            }
+        }
+
+        // In place.
+        op->applyRGB(rgb, rgb, numPixels);
+
+        for (long idx = 0; idx < numPixels; ++idx)
+        {
+            for (long c = 0; c < 3; ++c)
+            {
+                OCIO_CHECK_EQUAL(rgb[3 * idx + c], ref[4 * idx + c]);
+            }
+        }
+    }
+}
+
+#if defined(OCIO_USE_AVX)
+
+namespace
+{
+
+// The results of the apply, applyRGB & applyPlanar methods.
+std::vector<float> Render(const OCIO::OpCPU & op, const std::vector<float> & image)
+{
+    const long numPixels = long(image.size() / 4);
+
+    std::vector<float> res(image.size() * 3);
+
+    op.apply(&image[0], &res[0], numPixels);
+
+    float * rgb = &res[image.size()];
+    for (long idx = 0; idx < numPixels; ++idx)
+    {
+        for (long c = 0; c < 3; ++c)
+        {
+            rgb[3 * idx + c] = image[4 * idx + c];
+        }
+    }
+    op.applyRGB(rgb, rgb, numPixels);
+
+    float * planes = &res[image.size() * 2];
+    for (long idx = 0; idx < numPixels; ++idx)
+    {
+        for (long c = 0; c < 4; ++c)
+        {
+            planes[c * numPixels + idx] = image[4 * idx + c];
+        }
+    }
+    float * p[4] = { planes, planes + numPixels, planes + 2 * numPixels, planes + 3 * numPixels };
+    op.applyPlanar(p, p, numPixels);
+
+    return res;
+}
+
+template<typename Renderer, bool scale, bool lower, bool upper>
+void ValidateVectorRenderers(double minIn, double maxIn, double minOut, double maxOut,
+                             const std::vector<float> & image, unsigned line)
+{
+    OCIO::RangeOpDataRcPtr range
+        = std::make_shared<OCIO::RangeOpData>(minIn, maxIn, minOut, maxOut);
+    OCIO_CHECK_NO_THROW_FROM(range->validate(), line);
+    OCIO_CHECK_NO_THROW_FROM(range->finalize(), line);
+
+    OCIO::ConstRangeOpDataRcPtr r = range;
+
+    const std::vector<float> ref = Render(Renderer(r), image);
+
+    const OCIO::CPUInfo & cpuInfo = OCIO::CPUInfo::Instance();
+
+    // Bitwise comparisons as the NaNs are expected at the same places.
+    if (cpuInfo.hasAVX2())
+    {
+        const std::vector<float> res
+            = Render(OCIO::RangeAVX2Renderer<Renderer, scale, lower, upper>(r), image);
+        OCIO_CHECK_EQUAL_FROM(std::memcmp(&res[0], &ref[0], ref.size() * sizeof(float)), 0,
+                              line);
+    }
+
+    if (cpuInfo.hasAVX512F())
+    {
+        const std::vector<float> res
+            = Render(OCIO::RangeAVX512Renderer<Renderer, scale, lower, upper>(r), image);
+        OCIO_CHECK_EQUAL_FROM(std::memcmp(&res[0], &ref[0], ref.size() * sizeof(float)), 0,
+                              line);
+    }
+}
+
+}
+
+OCIO_ADD_TEST(RangeOpCPU, vector_renderers)
+{
+    // The AVX renderers must produce exactly the same results as the SSE ones.
+
+    const double empty = OCIO::RangeOpData::EmptyValue();
+
+    const float qnan = std::numeric_limits<float>::quiet_NaN();
+    const float inf = std::numeric_limits<float>::infinity();
+
+    // Odd number of pixels to exercise the remaining pixels.
+    constexpr long numPixels = 19;
+    std::vector<float> image(4 * numPixels);
+    for (size_t idx = 0; idx < image.size(); ++idx)
+    {
+        image[idx] = float(idx) * 0.037f - 0.8f;
+    }
+    image[5]  = qnan;
+    image[10] = inf;
+    image[15] = qnan;
+    image[40] = -inf;
+    image[41] = -0.0f;
+
+    ValidateVectorRenderers<OCIO::RangeScaleMinMaxRenderer, true, true, true>(
+        0., 1., 0.5, 1.5, image, __LINE__);
+    ValidateVectorRenderers<OCIO::RangeScaleMinRenderer, true, true, false>(
+        0., empty, 0.5, empty, image, __LINE__);
+    ValidateVectorRenderers<OCIO::RangeScaleMaxRenderer, true, false, true>(
+        empty, 1., empty, 1.5, image, __LINE__);
+    ValidateVectorRenderers<OCIO::RangeScaleRenderer, true, false, false>(
+        empty, empty, empty, empty, image, __LINE__);
+    ValidateVectorRenderers<OCIO::RangeMinMaxRenderer, false, true, true>(
+        0., 1., 0., 1., image, __LINE__);
+    ValidateVectorRenderers<OCIO::RangeMinRenderer, false, true, false>(
+        0.1, empty, 0.1, empty, image, __LINE__);
+    ValidateVectorRenderers<OCIO::RangeMaxRenderer, false, false, true>(
+        empty, 0.9, empty, 0.9, image, __LINE__);
+}
 
+#endif // OCIO_USE_AVX
 
 #endif
@@ -129,6 +129,7 @@ public:
     bool isClampNegs() const;
 
     bool hasChannelCrosstalk() const override { return false; }
+    bool touchesAlpha() const override { return false; }
 
     // True if minIn & minOut do not request clipping
     bool minIsEmpty() const;
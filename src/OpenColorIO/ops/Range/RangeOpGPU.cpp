@@ -5,6 +5,7 @@
 
 #include <OpenColorIO/OpenColorIO.h>
 
+#include "GpuShader.h"
 #include "MathUtils.h"
 #include "ops/Range/RangeOpGPU.h"
 
@@ -16,12 +17,26 @@ void GetRangeGPUShaderProgram(GpuShaderDescRcPtr & shaderDesc,
                               ConstRangeOpDataRcPtr & range)
 {
     GpuShaderText ss(shaderDesc->getLanguage());
+    ss.setHalfPrecision(IsHalfPrecisionOp(*shaderDesc));
     ss.indent();
 
     ss.newLine() << "";
     ss.newLine() << "// Add a Range processing";
     ss.newLine() << "";
 
+    // In half precision, the processing is done on a half copy of the pixel.
+    std::string pix(shaderDesc->getPixelName());
+    pix += ".rgb";
+    if(ss.isHalfPrecision())
+    {
+        ss.newLine() << "{";
+        ss.indent();
+
+        const std::string halfPix(std::string(shaderDesc->getPixelName()) + "_h");
+        ss.newLine() << ss.vec3hDecl(halfPix) << " = " << ss.vec3hCast(pix) << ";";
+        pix = halfPix;
+    }
+
     if(range->scales())
     {
         const double scale[3]
@@ -34,11 +49,11 @@ void GetRangeGPUShaderProgram(GpuShaderDescRcPtr & shaderDesc,
                 range->getOffset(), 
                 range->getOffset() };
 
-        ss.newLine() << shaderDesc->getPixelName() << ".rgb = "
-                     << shaderDesc->getPixelName() << ".rgb * "
-                     << ss.vec3fConst(scale[0], scale[1], scale[2])
+        ss.newLine() << pix << " = "
+                     << pix << " * "
+                     << ss.vec3hConst(scale[0], scale[1], scale[2])
                      << " + "
-                     << ss.vec3fConst(offset[0], offset[1], offset[2])
+                     << ss.vec3hConst(offset[0], offset[1], offset[2])
                      << ";";
     }
 
@@ -49,12 +64,12 @@ void GetRangeGPUShaderProgram(GpuShaderDescRcPtr & shaderDesc,
                 range->getMinOutValue(), 
                 range->getMinOutValue() };
 
-        ss.newLine() << shaderDesc->getPixelName() << ".rgb = "
-                     << "max(" << ss.vec3fConst(lowerBound[0],
+        ss.newLine() << pix << " = "
+                     << "max(" << ss.vec3hConst(lowerBound[0],
                                                 lowerBound[1],
                                                 lowerBound[2]) << ", "
-                     << shaderDesc->getPixelName()
-                     << ".rgb);";
+                     << pix
+                     << ");";
     }
 
     if (!range->maxIsEmpty())
@@ -64,12 +79,19 @@ void GetRangeGPUShaderProgram(GpuShaderDescRcPtr & shaderDesc,
                 range->getMaxOutValue(),
                 range->getMaxOutValue() };
 
-        ss.newLine() << shaderDesc->getPixelName() << ".rgb = "
-            << "min(" << ss.vec3fConst(upperBound[0],
+        ss.newLine() << pix << " = "
+            << "min(" << ss.vec3hConst(upperBound[0],
                                        upperBound[1],
                                        upperBound[2]) << ", "
-            << shaderDesc->getPixelName()
-            << ".rgb);";
+            << pix
+            << ");";
+    }
+
+    if(ss.isHalfPrecision())
+    {
+        ss.newLine() << shaderDesc->getPixelName() << ".rgb = " << ss.vec3fCast(pix) << ";";
+        ss.dedent();
+        ss.newLine() << "}";
     }
 
     shaderDesc->addToFunctionShaderCode(ss.string().c_str());
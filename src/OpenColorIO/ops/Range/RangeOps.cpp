@@ -41,6 +41,7 @@ public:
     OpRcPtr clone() const override;
 
     std::string getInfo() const override;
+    double getCost() const override;
 
     bool isSameType(ConstOpRcPtr & op) const override;
     bool isInverse(ConstOpRcPtr & op) const override;
@@ -92,6 +93,12 @@ std::string RangeOp::getInfo() const
     return "<RangeOp>";
 }
 
+double RangeOp::getCost() const
+{
+    // A scale & offset followed by a clamp.
+    return 0.5;
+}
+
 bool RangeOp::isSameType(ConstOpRcPtr & op) const
 {
     ConstRangeOpRcPtr typedRcPtr = DynamicPtrCast<const RangeOp>(op);
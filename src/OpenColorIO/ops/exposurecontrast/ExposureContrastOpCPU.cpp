@@ -2,11 +2,14 @@
 // Copyright Contributors to the OpenColorIO Project.
 
 #include <algorithm>
+#include <atomic>
 #include <cmath>
 
 #include <OpenColorIO/OpenColorIO.h>
 
+#include "AVX.h"
 #include "BitDepthUtils.h"
+#include "CPUInfo.h"
 #include "DynamicProperty.h"
 #include "ops/exposurecontrast/ExposureContrastOpCPU.h"
 #include "SSE.h"
@@ -31,12 +34,45 @@ public:
 protected:
     virtual void updateData(ConstExposureContrastOpDataRcPtr & ec) = 0;
 
+    // The values derived from the dynamic properties (their meaning depends on the renderer).
+    struct DynamicValues
+    {
+        float m_contrast    = 1.0f;
+        float m_invContrast = 1.0f;
+        float m_scale       = 1.0f;
+        float m_offset      = 0.0f;
+    };
+
+    virtual void computeDynamicValues(double exposure, double contrast, double gamma,
+                                      DynamicValues & values) const = 0;
+
+    // Get the values to use for the processing. The dynamic properties are only read once
+    // per apply() call so a property change is seen at the start of the next call (i.e. of
+    // the next image band). The derived values are cached and only recomputed when the
+    // version of a property changes. Note that the values overridden by the calling thread
+    // (refer to DynamicPropertyOverridesGuard) have precedence.
+    void getDynamicValues(DynamicValues & values) const;
+
     DynamicPropertyImplRcPtr m_exposure;
     DynamicPropertyImplRcPtr m_contrast;
     DynamicPropertyImplRcPtr m_gamma;
 
     float m_pivot = 0.0f;
     float m_logExposureStep = 0.088f;
+
+    // Use the AVX2 variants (i.e. selected once for the CPU).
+    bool m_useAVX2 = false;
+
+private:
+    // Lock-free cache of the derived values i.e. a sequence lock where the sequence is odd
+    // while a thread updates the cache. The apply threads never wait: when the cache is not
+    // usable they compute their own values.
+    mutable std::atomic<unsigned> m_cacheSequence{ 0 };
+    mutable std::atomic<unsigned long long> m_cacheVersion{ ~0ULL };
+    mutable std::atomic<float> m_cacheContrast{ 1.0f };
+    mutable std::atomic<float> m_cacheInvContrast{ 1.0f };
+    mutable std::atomic<float> m_cacheScale{ 1.0f };
+    mutable std::atomic<float> m_cacheOffset{ 0.0f };
 };
 
 ECRendererBase::ECRendererBase(ConstExposureContrastOpDataRcPtr & ec)
@@ -47,6 +83,10 @@ ECRendererBase::ECRendererBase(ConstExposureContrastOpDataRcPtr & ec)
     m_exposure = ec->getExposureProperty();
     m_contrast = ec->getContrastProperty();
     m_gamma = ec->getGammaProperty();
+
+#if defined(OCIO_USE_AVX)
+    m_useAVX2 = CPUInfo::Instance().hasAVX2();
+#endif
 }
 
 ECRendererBase::~ECRendererBase()
@@ -104,6 +144,265 @@ DynamicPropertyRcPtr ECRendererBase::getDynamicProperty(DynamicPropertyType type
     throw Exception("ExposureContrast property is not dynamic.");
 }
 
+void ECRendererBase::getDynamicValues(DynamicValues & values) const
+{
+    // The values overridden for the current apply call are neither read from nor
+    // written to the cache shared by all the calls.
+    const DynamicPropertyOverrides * overrides = GetThreadDynamicPropertyOverrides();
+    if (overrides && !overrides->isEmpty())
+    {
+        computeDynamicValues(GetDynamicPropertyValue(*m_exposure, overrides),
+                             GetDynamicPropertyValue(*m_contrast, overrides),
+                             GetDynamicPropertyValue(*m_gamma, overrides),
+                             values);
+        return;
+    }
+
+    // Read the versions before the values so the values are at least as recent as the
+    // versions (refer to DynamicPropertyImpl::getVersion()).
+    const unsigned long long version
+        = m_exposure->getVersion() + m_contrast->getVersion() + m_gamma->getVersion();
+
+    unsigned sequence = m_cacheSequence.load(std::memory_order_acquire);
+    if ((sequence & 1) == 0 && m_cacheVersion.load(std::memory_order_relaxed) == version)
+    {
+        values.m_contrast    = m_cacheContrast.load(std::memory_order_relaxed);
+        values.m_invContrast = m_cacheInvContrast.load(std::memory_order_relaxed);
+        values.m_scale       = m_cacheScale.load(std::memory_order_relaxed);
+        values.m_offset      = m_cacheOffset.load(std::memory_order_relaxed);
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (m_cacheSequence.load(std::memory_order_relaxed) == sequence)
+        {
+            return;
+        }
+    }
+
+    computeDynamicValues(m_exposure->getDoubleValue(),
+                         m_contrast->getDoubleValue(),
+                         m_gamma->getDoubleValue(),
+                         values);
+
+    // Only one thread at a time updates the cache.
+    if ((sequence & 1) == 0
+        && m_cacheSequence.compare_exchange_strong(sequence, sequence + 1,
+                                                   std::memory_order_relaxed))
+    {
+        std::atomic_thread_fence(std::memory_order_release);
+
+        m_cacheVersion.store(version, std::memory_order_relaxed);
+        m_cacheContrast.store(values.m_contrast, std::memory_order_relaxed);
+        m_cacheInvContrast.store(values.m_invContrast, std::memory_order_relaxed);
+        m_cacheScale.store(values.m_scale, std::memory_order_relaxed);
+        m_cacheOffset.store(values.m_offset, std::memory_order_relaxed);
+
+        m_cacheSequence.store(sequence + 2, std::memory_order_release);
+    }
+}
+
+#if defined(OCIO_USE_AVX)
+
+// The AVX2 variants process two pixels per register (i.e. one pixel per 128-bit lane) doing
+// exactly the same operations than the SSE implementations, so all the CPUs produce identical
+// results. They return the number of processed pixels, the remaining one being processed by
+// the SSE implementation.
+
+OCIO_TARGET_AVX2
+long ApplyScaleAVX2(const float * in, float * out, long numPixels, float scale)
+{
+    const __m256 s = _mm256_set1_ps(scale);
+
+    long idx = 0;
+    for (; idx + 2 <= numPixels; idx += 2)
+    {
+        const __m256 pix = _mm256_loadu_ps(in);
+
+        // The alpha values are copied.
+        _mm256_storeu_ps(out, _mm256_blend_ps(_mm256_mul_ps(pix, s), pix, 0x88));
+
+        in  += 8;
+        out += 8;
+    }
+    return idx;
+}
+
+OCIO_TARGET_AVX2
+long ApplyScaleOffsetAVX2(const float * in, float * out, long numPixels,
+                          float scale, float offset)
+{
+    const __m256 s = _mm256_set1_ps(scale);
+    const __m256 o = _mm256_set1_ps(offset);
+
+    long idx = 0;
+    for (; idx + 2 <= numPixels; idx += 2)
+    {
+        const __m256 pix = _mm256_loadu_ps(in);
+
+        _mm256_storeu_ps(out,
+                         _mm256_blend_ps(_mm256_add_ps(o, _mm256_mul_ps(pix, s)), pix, 0x88));
+
+        in  += 8;
+        out += 8;
+    }
+    return idx;
+}
+
+OCIO_TARGET_AVX2
+long ApplyPowerAVX2(const float * in, float * out, long numPixels,
+                    float inScale, float exponent, float outScale)
+{
+    const __m256 inS  = _mm256_set1_ps(inScale);
+    const __m256 e    = _mm256_set1_ps(exponent);
+    const __m256 outS = _mm256_set1_ps(outScale);
+
+    long idx = 0;
+    for (; idx + 2 <= numPixels; idx += 2)
+    {
+        const __m256 pix = _mm256_loadu_ps(in);
+
+        const __m256 res = _mm256_mul_ps(avxPower(_mm256_mul_ps(pix, inS), e), outS);
+        _mm256_storeu_ps(out, _mm256_blend_ps(res, pix, 0x88));
+
+        in  += 8;
+        out += 8;
+    }
+    return idx;
+}
+
+#endif // OCIO_USE_AVX
+
+// The functions below process the RGB values of packed RGBA pixels, the alpha values being
+// copied. The contrast and exposure values are the ones derived by the renderers.
+
+// out = in * scale
+void ApplyScale(const float * in, float * out, long numPixels, float scale, bool useAVX2)
+{
+#if defined(OCIO_USE_AVX)
+    if (useAVX2)
+    {
+        const long done = ApplyScaleAVX2(in, out, numPixels, scale);
+        in  += 4 * done;
+        out += 4 * done;
+        numPixels -= done;
+    }
+#else
+    (void)useAVX2;
+#endif
+
+#ifdef USE_SSE
+    const __m128 s = _mm_set1_ps(scale);
+    const __m128 alphaMask = _mm_castsi128_ps(_mm_setr_epi32(0, 0, 0, -1));
+
+    for (long idx = 0; idx<numPixels; ++idx)
+    {
+        const __m128 pix = _mm_loadu_ps(in);
+        _mm_storeu_ps(out, sseSelect(alphaMask, pix, _mm_mul_ps(pix, s)));
+
+        in += 4;
+        out += 4;
+    }
+#else
+    for (long idx = 0; idx<numPixels; ++idx)
+    {
+        out[0] = in[0] * scale;
+        out[1] = in[1] * scale;
+        out[2] = in[2] * scale;
+        out[3] = in[3];
+
+        in += 4;
+        out += 4;
+    }
+#endif
+}
+
+// out = ( in * scale ) + offset
+void ApplyScaleOffset(const float * in, float * out, long numPixels,
+                      float scale, float offset, bool useAVX2)
+{
+#if defined(OCIO_USE_AVX)
+    if (useAVX2)
+    {
+        const long done = ApplyScaleOffsetAVX2(in, out, numPixels, scale, offset);
+        in  += 4 * done;
+        out += 4 * done;
+        numPixels -= done;
+    }
+#else
+    (void)useAVX2;
+#endif
+
+#ifdef USE_SSE
+    const __m128 s = _mm_set1_ps(scale);
+    const __m128 o = _mm_set1_ps(offset);
+    const __m128 alphaMask = _mm_castsi128_ps(_mm_setr_epi32(0, 0, 0, -1));
+
+    for (long idx = 0; idx<numPixels; ++idx)
+    {
+        const __m128 pix = _mm_loadu_ps(in);
+        _mm_storeu_ps(out, sseSelect(alphaMask, pix, _mm_add_ps(o, _mm_mul_ps(pix, s))));
+
+        in += 4;
+        out += 4;
+    }
+#else
+    for (long idx = 0; idx<numPixels; ++idx)
+    {
+        out[0] = in[0] * scale + offset;
+        out[1] = in[1] * scale + offset;
+        out[2] = in[2] * scale + offset;
+        out[3] = in[3];
+
+        in += 4;
+        out += 4;
+    }
+#endif
+}
+
+// out = powf( in * inScale, exponent ) * outScale
+void ApplyPower(const float * in, float * out, long numPixels,
+                float inScale, float exponent, float outScale, bool useAVX2)
+{
+#if defined(OCIO_USE_AVX)
+    if (useAVX2)
+    {
+        const long done = ApplyPowerAVX2(in, out, numPixels, inScale, exponent, outScale);
+        in  += 4 * done;
+        out += 4 * done;
+        numPixels -= done;
+    }
+#else
+    (void)useAVX2;
+#endif
+
+#ifdef USE_SSE
+    const __m128 inS  = _mm_set1_ps(inScale);
+    const __m128 e    = _mm_set1_ps(exponent);
+    const __m128 outS = _mm_set1_ps(outScale);
+    const __m128 alphaMask = _mm_castsi128_ps(_mm_setr_epi32(0, 0, 0, -1));
+
+    for (long idx = 0; idx<numPixels; ++idx)
+    {
+        const __m128 pix = _mm_loadu_ps(in);
+        const __m128 res = _mm_mul_ps(ssePower(_mm_mul_ps(pix, inS), e), outS);
+        _mm_storeu_ps(out, sseSelect(alphaMask, pix, res));
+
+        in += 4;
+        out += 4;
+    }
+#else
+    for (long idx = 0; idx<numPixels; ++idx)
+    {
+        // Note: With std::max NAN becomes 0.
+        out[0] = powf(std::max(0.0f, in[0] * inScale), exponent) * outScale;
+        out[1] = powf(std::max(0.0f, in[1] * inScale), exponent) * outScale;
+        out[2] = powf(std::max(0.0f, in[2] * inScale), exponent) * outScale;
+        out[3] = in[3];
+
+        in += 4;
+        out += 4;
+    }
+#endif
+}
 
 class ECLinearRenderer : public ECRendererBase
 {
@@ -114,6 +413,8 @@ public:
 
 protected:
     void updateData(ConstExposureContrastOpDataRcPtr & ec) override;
+    void computeDynamicValues(double exposure, double contrast, double gamma,
+                              DynamicValues & values) const override;
 };
 
 ECLinearRenderer::ECLinearRenderer(ConstExposureContrastOpDataRcPtr & ec)
@@ -127,85 +428,36 @@ void ECLinearRenderer::updateData(ConstExposureContrastOpDataRcPtr & ec)
     m_pivot = (float)std::max(EC::MIN_PIVOT, ec->getPivot());
 }
 
-void ECLinearRenderer::apply(const void * inImg, void * outImg, long numPixels) const
+void ECLinearRenderer::computeDynamicValues(double exposure, double contrast, double gamma,
+                                            DynamicValues & values) const
 {
     // TODO: allow negative contrast?
-    // TODO: is it worth adding a code path without dynamic paramaters?
-    const float contrastVal = (float)std::max(EC::MIN_CONTRAST,
-                                              m_contrast->getDoubleValue() *
-                                              m_gamma->getDoubleValue());
-    const float exposureVal = powf(2.f, (float)m_exposure->getDoubleValue());
+    values.m_contrast = (float)std::max(EC::MIN_CONTRAST, contrast * gamma);
+    values.m_scale    = powf(2.f, (float)exposure);
+}
+
+void ECLinearRenderer::apply(const void * inImg, void * outImg, long numPixels) const
+{
+    DynamicValues values;
+    getDynamicValues(values);
 
-    const float * in = (float *)inImg;
+    const float * in = (const float *)inImg;
     float * out = (float *)outImg;
 
-    if (contrastVal == 1.f)
+    if (values.m_contrast == 1.f)
     {
-        for (long idx = 0; idx<numPixels; ++idx)
-        {
-            //
-            // out = in * exposure;
-            //
-            out[0] = in[0] * exposureVal;
-            out[1] = in[1] * exposureVal;
-            out[2] = in[2] * exposureVal;
-            out[3] = in[3];
-
-            in += 4;
-            out += 4;
-        }
+        //
+        // out = in * exposure;
+        //
+        ApplyScale(in, out, numPixels, values.m_scale, m_useAVX2);
     }
     else
     {
-#ifdef USE_SSE
-        __m128 contrast = _mm_set1_ps(contrastVal);
-        __m128 exposure_over_pivot = _mm_set1_ps(exposureVal / m_pivot);
-        __m128 piv = _mm_set1_ps(m_pivot);
-        for (long idx = 0; idx<numPixels; ++idx)
-        {
-            const float outAlpha = in[3];
-            __m128 data = _mm_set_ps(in[3],
-                                     in[2],
-                                     in[1],
-                                     in[0]);
-
-            //
-            // out = powf( i * exposure / pivot, contrast ) * pivot
-            //
-            _mm_storeu_ps(out,
-                _mm_mul_ps(
-                    ssePower(
-                        _mm_mul_ps(
-                            data,
-                            exposure_over_pivot),
-                        contrast),
-                    piv));
-            out[3] = outAlpha;
-
-            in += 4;
-            out += 4;
-        }
-#else
-        const float exposureOverPivotVal = exposureVal / m_pivot;
-        for (long idx = 0; idx<numPixels; ++idx)
-        {
-
-            //
-            // out = powf( i * exposure / iPivot, contrast ) * oPivot
-            //
-            // Note: With std::max NAN becomes 0.
-            out[0] = powf(std::max(0.0f, in[0] * exposureOverPivotVal),
-                           contrastVal) * m_pivot;
-            out[1] = powf(std::max(0.0f, in[1] * exposureOverPivotVal),
-                           contrastVal) * m_pivot;
-            out[2] = powf(std::max(0.0f, in[2] * exposureOverPivotVal),
-                           contrastVal) * m_pivot;
-            out[3] = in[3];
-
-            in += 4;
-            out += 4;
-        }
-#endif
+        //
+        // out = powf( i * exposure / pivot, contrast ) * pivot
+        //
+        ApplyPower(in, out, numPixels, values.m_scale / m_pivot, values.m_contrast, m_pivot,
+                   m_useAVX2);
     }
 }
 
@@ -218,6 +470,8 @@ public:
 
 protected:
     void updateData(ConstExposureContrastOpDataRcPtr & ec) override;
+    void computeDynamicValues(double exposure, double contrast, double gamma,
+                              DynamicValues & values) const override;
 };
 
 ECLinearRevRenderer::ECLinearRevRenderer(ConstExposureContrastOpDataRcPtr & ec)
@@ -231,87 +485,37 @@ void ECLinearRevRenderer::updateData(ConstExposureContrastOpDataRcPtr & ec)
     m_pivot = (float)std::max(EC::MIN_PIVOT, ec->getPivot());
 }
 
-void ECLinearRevRenderer::apply(const void * inImg, void * outImg, long numPixels) const
+void ECLinearRevRenderer::computeDynamicValues(double exposure, double contrast, double gamma,
+                                               DynamicValues & values) const
 {
     // TODO: allow negative contrast?
-    const float contrastVal = (float)std::max(EC::MIN_CONTRAST,
-                                              (m_contrast->getDoubleValue() * m_gamma->getDoubleValue()));
-    const float invContrastVal = 1.f / contrastVal;
-    const float invExposureVal = 1.f / powf(2.f, (float)m_exposure->getDoubleValue());
+    values.m_contrast    = (float)std::max(EC::MIN_CONTRAST, contrast * gamma);
+    values.m_invContrast = 1.f / values.m_contrast;
+    values.m_scale       = 1.f / powf(2.f, (float)exposure);
+}
 
-    const float * in = (float *)inImg;
+void ECLinearRevRenderer::apply(const void * inImg, void * outImg, long numPixels) const
+{
+    DynamicValues values;
+    getDynamicValues(values);
+
+    const float * in = (const float *)inImg;
     float * out = (float *)outImg;
 
-    if (contrastVal == 1.f)
+    if (values.m_contrast == 1.f)
     {
-        for (long idx = 0; idx<numPixels; ++idx)
-        {
-            out[0] = in[0] * invExposureVal;
-            out[1] = in[1] * invExposureVal;
-            out[2] = in[2] * invExposureVal;
-            out[3] = in[3];
-
-            in += 4;
-            out += 4;
-        }
+        //
+        // out = in / exposure
+        //
+        ApplyScale(in, out, numPixels, values.m_scale, m_useAVX2);
     }
     else
     {
-#ifdef USE_SSE
-        __m128 inv_contrast = _mm_set1_ps(invContrastVal);
-
-        const float pivotOverExposureVal = m_pivot * invExposureVal;
-        const float invPivotVal = 1.f / m_pivot;
-
-        __m128 pivot_over_exposure = _mm_set1_ps(pivotOverExposureVal);
-        __m128 inv_pivot = _mm_set1_ps(invPivotVal);
-
-        for (long idx = 0; idx<numPixels; ++idx)
-        {
-            const float outAlpha = in[3];
-            __m128 data = _mm_set_ps(in[3],
-                                     in[2],
-                                     in[1],
-                                     in[0]);
-
-            //
-            // out = powf( i / pivot, 1 / contrast ) * pivot / exposure
-            //
-            _mm_storeu_ps(out,
-                _mm_mul_ps(
-                    ssePower(
-                        _mm_mul_ps(
-                            data,
-                            inv_pivot),
-                        inv_contrast),
-                    pivot_over_exposure));
-
-            out[3] = outAlpha;
-
-            in += 4;
-            out += 4;
-        }
-#else
-        const float pivotOverExposureVal = m_pivot * invExposureVal;
-        const float invPivotVal = 1.f / m_pivot;
-
-        for (long idx = 0; idx<numPixels; ++idx)
-        {
-            //
-            // out = powf( i / pivot, 1 / contrast ) * pivot / exposure
-            //
-            out[0] = powf(std::max(0.0f, in[0] * invPivotVal),
-                           invContrastVal) * pivotOverExposureVal;
-            out[1] = powf(std::max(0.0f, in[1] * invPivotVal),
-                           invContrastVal) * pivotOverExposureVal;
-            out[2] = powf(std::max(0.0f, in[2] * invPivotVal),
-                           invContrastVal) * pivotOverExposureVal;
-            out[3] = in[3];
-
-            in += 4;
-            out += 4;
-        }
-#endif
+        //
+        // out = powf( i / pivot, 1 / contrast ) * pivot / exposure
+        //
+        ApplyPower(in, out, numPixels, 1.f / m_pivot, values.m_invContrast,
+                   m_pivot * values.m_scale, m_useAVX2);
     }
 }
 
@@ -324,6 +528,8 @@ public:
 
 protected:
     void updateData(ConstExposureContrastOpDataRcPtr & ec) override;
+    void computeDynamicValues(double exposure, double contrast, double gamma,
+                              DynamicValues & values) const override;
 };
 
 ECVideoRenderer::ECVideoRenderer(ConstExposureContrastOpDataRcPtr & ec)
@@ -338,82 +544,36 @@ void ECVideoRenderer::updateData(ConstExposureContrastOpDataRcPtr & ec)
                    (float)EC::VIDEO_OETF_POWER);
 }
 
-void ECVideoRenderer::apply(const void * inImg, void * outImg, long numPixels) const
+void ECVideoRenderer::computeDynamicValues(double exposure, double contrast, double gamma,
+                                           DynamicValues & values) const
 {
     // TODO: allow negative contrast?
-    const float contrastVal = (float)std::max(EC::MIN_CONTRAST,
-                                              (m_contrast->getDoubleValue() * m_gamma->getDoubleValue()));
-    const float exposureVal = powf(powf(2.f, (float)m_exposure->getDoubleValue()),
-                                   (float)EC::VIDEO_OETF_POWER);
+    values.m_contrast = (float)std::max(EC::MIN_CONTRAST, contrast * gamma);
+    values.m_scale    = powf(powf(2.f, (float)exposure), (float)EC::VIDEO_OETF_POWER);
+}
+
+void ECVideoRenderer::apply(const void * inImg, void * outImg, long numPixels) const
+{
+    DynamicValues values;
+    getDynamicValues(values);
 
-    const float * in = (float *)inImg;
+    const float * in = (const float *)inImg;
     float * out = (float *)outImg;
 
-    if (contrastVal == 1.f)
+    if (values.m_contrast == 1.f)
     {
-        for (long idx = 0; idx<numPixels; ++idx)
-        {
-            //
-            // out = in * exposure;
-            //
-            out[0] = in[0] * exposureVal;
-            out[1] = in[1] * exposureVal;
-            out[2] = in[2] * exposureVal;
-            out[3] = in[3];
-
-            in += 4;
-            out += 4;
-        }
+        //
+        // out = in * exposure;
+        //
+        ApplyScale(in, out, numPixels, values.m_scale, m_useAVX2);
     }
     else
     {
-#ifdef USE_SSE
-        __m128 contrast = _mm_set1_ps(contrastVal);
-        __m128 exposure_over_pivot = _mm_set1_ps(exposureVal / m_pivot);
-        __m128 piv = _mm_set1_ps(m_pivot);
-        for (long idx = 0; idx<numPixels; ++idx)
-        {
-            const float outAlpha = in[3];
-            __m128 data = _mm_set_ps(in[3],
-                                     in[2],
-                                     in[1],
-                                     in[0]);
-
-            //
-            // out = powf( i * exposure / pivot, contrast ) * pivot
-            //
-            _mm_storeu_ps(out,
-                _mm_mul_ps(
-                    ssePower(
-                        _mm_mul_ps(
-                            data,
-                            exposure_over_pivot),
-                        contrast),
-                    piv));
-            out[3] = outAlpha;
-
-            in += 4;
-            out += 4;
-        }
-#else
-        const float exposureOverPivotVal = exposureVal / m_pivot;
-        for (long idx = 0; idx<numPixels; ++idx)
-        {
-            //
-            // out = powf( i * exposure / pivot, contrast ) * pivot
-            //
-            out[0] = powf(std::max(0.0f, in[0] * exposureOverPivotVal),
-                           contrastVal) * m_pivot;
-            out[1] = powf(std::max(0.0f, in[1] * exposureOverPivotVal),
-                           contrastVal) * m_pivot;
-            out[2] = powf(std::max(0.0f, in[2] * exposureOverPivotVal),
-                           contrastVal) * m_pivot;
-            out[3] = in[3];
-
-            in += 4;
-            out += 4;
-        }
-#endif
+        //
+        // out = powf( i * exposure / pivot, contrast ) * pivot
+        //
+        ApplyPower(in, out, numPixels, values.m_scale / m_pivot, values.m_contrast, m_pivot,
+                   m_useAVX2);
     }
 }
 
@@ -426,6 +586,8 @@ public:
 
 protected:
     void updateData(ConstExposureContrastOpDataRcPtr & ec) override;
+    void computeDynamicValues(double exposure, double contrast, double gamma,
+                              DynamicValues & values) const override;
 };
 
 ECVideoRevRenderer::ECVideoRevRenderer(ConstExposureContrastOpDataRcPtr & ec)
@@ -440,85 +602,37 @@ void ECVideoRevRenderer::updateData(ConstExposureContrastOpDataRcPtr & ec)
                    (float)EC::VIDEO_OETF_POWER);
 }
 
-void ECVideoRevRenderer::apply(const void * inImg, void * outImg, long numPixels) const
+void ECVideoRevRenderer::computeDynamicValues(double exposure, double contrast, double gamma,
+                                              DynamicValues & values) const
 {
     // TODO: allow negative contrast?
-    const float contrastVal = (float)std::max(EC::MIN_CONTRAST,
-                                              (m_contrast->getDoubleValue() * m_gamma->getDoubleValue()));
-    const float invContrastVal = 1.f / contrastVal;
-    const float invExposureVal = 1.f / powf(powf(2.f, (float)m_exposure->getDoubleValue()),
-                                            (float)EC::VIDEO_OETF_POWER);
-    const float pivotOverExposureVal = m_pivot * invExposureVal;
-    const float invPivotVal = 1.f / m_pivot;
-
-    const float * in = (float *)inImg;
+    values.m_contrast    = (float)std::max(EC::MIN_CONTRAST, contrast * gamma);
+    values.m_invContrast = 1.f / values.m_contrast;
+    values.m_scale       = 1.f / powf(powf(2.f, (float)exposure), (float)EC::VIDEO_OETF_POWER);
+}
+
+void ECVideoRevRenderer::apply(const void * inImg, void * outImg, long numPixels) const
+{
+    DynamicValues values;
+    getDynamicValues(values);
+
+    const float * in = (const float *)inImg;
     float * out = (float *)outImg;
 
-    if (contrastVal == 1.f)
+    if (values.m_contrast == 1.f)
     {
-        for (long idx = 0; idx<numPixels; ++idx)
-        {
-            //
-            // out = in / exposure
-            //
-            out[0] = in[0] * invExposureVal;
-            out[1] = in[1] * invExposureVal;
-            out[2] = in[2] * invExposureVal;
-            out[3] = in[3];
-
-            in += 4;
-            out += 4;
-        }
+        //
+        // out = in / exposure
+        //
+        ApplyScale(in, out, numPixels, values.m_scale, m_useAVX2);
     }
     else
     {
-#ifdef USE_SSE
-        __m128 inv_contrast = _mm_set1_ps(invContrastVal);
-        __m128 pivot_over_exposure = _mm_set1_ps(pivotOverExposureVal);
-        __m128 inv_pivot = _mm_set1_ps(invPivotVal);
-
-        for (long idx = 0; idx<numPixels; ++idx)
-        {
-            const float outAlpha = in[3];
-            __m128 data = _mm_set_ps(in[3],
-                                     in[2],
-                                     in[1],
-                                     in[0]);
-
-            //
-            // out = powf( i / pivot, 1 / contrast ) * pivot / exposure
-            //
-            _mm_storeu_ps(out,
-                _mm_mul_ps(
-                    ssePower(
-                        _mm_mul_ps(
-                            data,
-                            inv_pivot),
-                        inv_contrast),
-                    pivot_over_exposure));
-            out[3] = outAlpha;
-
-            in += 4;
-            out += 4;
-        }
-#else
-        for (long idx = 0; idx<numPixels; ++idx)
-        {
-            //
-            // out = powf( i / pivot, 1 / contrast ) * pivot / exposure
-            //
-            out[0] = powf(std::max(0.0f, in[0] * invPivotVal),
-                           invContrastVal) * pivotOverExposureVal;
-            out[1] = powf(std::max(0.0f, in[1] * invPivotVal),
-                           invContrastVal) * pivotOverExposureVal;
-            out[2] = powf(std::max(0.0f, in[2] * invPivotVal),
-                           invContrastVal) * pivotOverExposureVal;
-            out[3] = in[3];
-
-            in += 4;
-            out += 4;
-        }
-#endif
+        //
+        // out = powf( i / pivot, 1 / contrast ) * pivot / exposure
+        //
+        ApplyPower(in, out, numPixels, 1.f / m_pivot, values.m_invContrast,
+                   m_pivot * values.m_scale, m_useAVX2);
     }
 }
 
@@ -531,6 +645,8 @@ public:
 
 protected:
     void updateData(ConstExposureContrastOpDataRcPtr & ec) override;
+    void computeDynamicValues(double exposure, double contrast, double gamma,
+                              DynamicValues & values) const override;
 };
 
 ECLogarithmicRenderer::ECLogarithmicRenderer(ConstExposureContrastOpDataRcPtr & ec)
@@ -549,61 +665,30 @@ void ECLogarithmicRenderer::updateData(ConstExposureContrastOpDataRcPtr & ec)
     m_logExposureStep = (float)ec->getLogExposureStep();
 }
 
+void ECLogarithmicRenderer::computeDynamicValues(double exposure, double contrast, double gamma,
+                                                 DynamicValues & values) const
+{
+    const float exposureVal = (float)exposure * m_logExposureStep;
+
+    values.m_contrast = (float)std::max(EC::MIN_CONTRAST, contrast * gamma);
+    values.m_offset   = (exposureVal - m_pivot) * values.m_contrast + m_pivot;
+}
+
 void ECLogarithmicRenderer::apply(const void * inImg, void * outImg, long numPixels) const
 {
-    const float exposureVal = (float)m_exposure->getDoubleValue() *
-                              m_logExposureStep;
-    const float contrastVal
-        = (float)std::max(EC::MIN_CONTRAST,
-                          (m_contrast->getDoubleValue() * m_gamma->getDoubleValue()));
-    const float offsetVal = (exposureVal - m_pivot) * contrastVal + m_pivot;
-
-    const float * in = (float *)inImg;
-    float * out = (float *)outImg;
+    DynamicValues values;
+    getDynamicValues(values);
 
-#ifdef USE_SSE
     // Equation is:
     // out = ( (in + expos) - pivot ) * contrast + pivot
     // Rearrange as:
     // out = [in * contrast] + [(expos - pivot) * contrast + pivot]
 
-    __m128 contrast = _mm_set1_ps(contrastVal);
-    __m128 offset = _mm_set1_ps(offsetVal);
-
-    for (long idx = 0; idx<numPixels; ++idx)
-    {
-        const float outAlpha = in[3];
-        __m128 data = _mm_set_ps(in[3],
-                                 in[2],
-                                 in[1],
-                                 in[0]);
-
-        //
-        // out = ( in * contrast ) + offset
-        //
-        _mm_storeu_ps(out,
-            _mm_add_ps(offset,
-                _mm_mul_ps(data, contrast)));
-        out[3] = outAlpha;
-
-        in += 4;
-        out += 4;
-    }
-#else
-    for (long idx = 0; idx<numPixels; ++idx)
-    {
-        //
-        // out = ( in * contrast ) + offset
-        //
-        out[0] = in[0] * contrastVal + offsetVal;
-        out[1] = in[1] * contrastVal + offsetVal;
-        out[2] = in[2] * contrastVal + offsetVal;
-        out[3] = in[3];
-
-        in += 4;
-        out += 4;
-    }
-#endif
+    //
+    // out = ( in * contrast ) + offset
+    //
+    ApplyScaleOffset((const float *)inImg, (float *)outImg, numPixels,
+                     values.m_contrast, values.m_offset, m_useAVX2);
 }
 
 class ECLogarithmicRevRenderer : public ECRendererBase
@@ -615,6 +700,8 @@ public:
 
 protected:
     void updateData(ConstExposureContrastOpDataRcPtr & ec) override;
+    void computeDynamicValues(double exposure, double contrast, double gamma,
+                              DynamicValues & values) const override;
 };
 
 ECLogarithmicRevRenderer::ECLogarithmicRevRenderer(ConstExposureContrastOpDataRcPtr & ec)
@@ -631,32 +718,25 @@ void ECLogarithmicRevRenderer::updateData(ConstExposureContrastOpDataRcPtr & ec)
                                   ec->getLogMidGray());
 }
 
-void ECLogarithmicRevRenderer::apply(const void * inImg, void * outImg, long numPixels) const
+void ECLogarithmicRevRenderer::computeDynamicValues(double exposure, double contrast, double gamma,
+                                                    DynamicValues & values) const
 {
-    const float exposureVal = (float)m_exposure->getDoubleValue() *
-                              m_logExposureStep;
-    const float inv_contrastVal
-        = (float)std::max(EC::MIN_CONTRAST,
-                          1. / (m_contrast->getDoubleValue() * m_gamma->getDoubleValue()));
-    const float negOffsetVal = m_pivot - m_pivot * inv_contrastVal -
-                               exposureVal;
-
-    const float * in = (float *)inImg;
-    float * out = (float *)outImg;
+    const float exposureVal = (float)exposure * m_logExposureStep;
 
-    for (long idx = 0; idx<numPixels; ++idx)
-    {
-        //
-        // out = ( in * inv_contrast ) + neg_offset
-        //
-        out[0] = in[0] * inv_contrastVal + negOffsetVal;
-        out[1] = in[1] * inv_contrastVal + negOffsetVal;
-        out[2] = in[2] * inv_contrastVal + negOffsetVal;
-        out[3] = in[3];
+    values.m_invContrast = (float)std::max(EC::MIN_CONTRAST, 1. / (contrast * gamma));
+    values.m_offset      = m_pivot - m_pivot * values.m_invContrast - exposureVal;
+}
 
-        in += 4;
-        out += 4;
-    }
+void ECLogarithmicRevRenderer::apply(const void * inImg, void * outImg, long numPixels) const
+{
+    DynamicValues values;
+    getDynamicValues(values);
+
+    //
+    // out = ( in * inv_contrast ) + neg_offset
+    //
+    ApplyScaleOffset((const float *)inImg, (float *)outImg, numPixels,
+                     values.m_invContrast, values.m_offset, m_useAVX2);
 }
 
 }
@@ -689,6 +769,11 @@ OCIO_NAMESPACE_EXIT
 #ifdef OCIO_UNIT_TEST
 
 namespace OCIO = OCIO_NAMESPACE;
+
+#include <cstring>
+#include <limits>
+#include <thread>
+
 #include "UnitTest.h"
 
 namespace
@@ -1072,4 +1157,157 @@ OCIO_ADD_TEST(ExposureContrastRenderer, log_params)
     TestLogParamForStyle(OCIO::ExposureContrastOpData::STYLE_LOGARITHMIC_REV, true);
 }
 
+OCIO_ADD_TEST(ExposureContrastRenderer, dynamic_changes)
+{
+    const std::vector<float> rgbaImage { 0.0f, 0.5f, 1.f,  0.f,
+                                         0.2f, 0.8f, .99f, 1.f };
+
+    OCIO::ExposureContrastOpDataRcPtr ec =
+        std::make_shared<OCIO::ExposureContrastOpData>(
+            OCIO::ExposureContrastOpData::STYLE_LOGARITHMIC);
+
+    ec->getExposureProperty()->makeDynamic();
+
+    OCIO::ConstExposureContrastOpDataRcPtr const_ec = ec;
+    OCIO::OpCPURcPtr renderer = OCIO::GetExposureContrastCPURenderer(const_ec);
+
+    std::vector<float> rgbaRef = rgbaImage;
+    renderer->apply(rgbaRef.data(), rgbaRef.data(), 2);
+
+    OCIO::DynamicPropertyRcPtr dp;
+    OCIO_REQUIRE_ASSERT(dp = renderer->getDynamicProperty(OCIO::DYNAMIC_PROPERTY_EXPOSURE));
+
+    // The change is seen by the next apply.
+    dp->setValue(1.0);
+    std::vector<float> rgbaExposed = rgbaImage;
+    renderer->apply(rgbaExposed.data(), rgbaExposed.data(), 2);
+    OCIO_CHECK_NE(rgbaExposed[0], rgbaRef[0]);
+    OCIO_CHECK_EQUAL(rgbaExposed[3], rgbaRef[3]);
+
+    // Restoring the value restores the result i.e. the cached values are recomputed.
+    dp->setValue(0.0);
+    std::vector<float> rgba = rgbaImage;
+    renderer->apply(rgba.data(), rgba.data(), 2);
+    for (size_t idx = 0; idx < rgba.size(); ++idx)
+    {
+        OCIO_CHECK_EQUAL(rgba[idx], rgbaRef[idx]);
+    }
+
+    // Per-call overrides neither change the property nor the next calls.
+    {
+        OCIO::DynamicPropertyOverrides overrides;
+        overrides.setValue(OCIO::DYNAMIC_PROPERTY_EXPOSURE, 1.0);
+
+        OCIO::DynamicPropertyOverridesGuard guard(&overrides);
+        rgba = rgbaImage;
+        renderer->apply(rgba.data(), rgba.data(), 2);
+        for (size_t idx = 0; idx < rgba.size(); ++idx)
+        {
+            OCIO_CHECK_EQUAL(rgba[idx], rgbaExposed[idx]);
+        }
+        OCIO_CHECK_EQUAL(dp->getDoubleValue(), 0.0);
+    }
+
+    rgba = rgbaImage;
+    renderer->apply(rgba.data(), rgba.data(), 2);
+    for (size_t idx = 0; idx < rgba.size(); ++idx)
+    {
+        OCIO_CHECK_EQUAL(rgba[idx], rgbaRef[idx]);
+    }
+
+    // Change the value while several threads are processing: each apply must see either
+    // the old or the new value, for all its pixels.
+    static constexpr long numPixels = 1024;
+    std::vector<float> rgbaLarge(numPixels * 4);
+    for (long idx = 0; idx < numPixels * 4; ++idx)
+    {
+        rgbaLarge[idx] = rgbaImage[idx % 8];
+    }
+
+    const unsigned numThreads = 4;
+    std::vector<unsigned> numFailures(numThreads, 0);
+    std::vector<std::thread> threads;
+    for (unsigned t = 0; t < numThreads; ++t)
+    {
+        threads.emplace_back([&, t]()
+        {
+            std::vector<float> out(numPixels * 4);
+            for (int iter = 0; iter < 200; ++iter)
+            {
+                renderer->apply(rgbaLarge.data(), out.data(), numPixels);
+
+                const std::vector<float> & expected
+                    = (out[0] == rgbaRef[0]) ? rgbaRef : rgbaExposed;
+                for (long idx = 0; idx < numPixels * 4; ++idx)
+                {
+                    if (out[idx] != expected[idx % 8])
+                    {
+                        ++numFailures[t];
+                        break;
+                    }
+                }
+            }
+        });
+    }
+
+    for (int iter = 0; iter < 1000; ++iter)
+    {
+        dp->setValue((iter % 2) ? 0.0 : 1.0);
+    }
+
+    for (auto & thread : threads)
+    {
+        thread.join();
+    }
+
+    for (unsigned t = 0; t < numThreads; ++t)
+    {
+        OCIO_CHECK_EQUAL(numFailures[t], 0u);
+    }
+}
+
+#if defined(OCIO_USE_AVX)
+OCIO_ADD_TEST(ExposureContrastRenderer, avx2)
+{
+    // The AVX2 variants produce identical results to the SSE ones, including an odd
+    // number of pixels and the special values.
+
+    if (!OCIO::CPUInfo::Instance().hasAVX2())
+    {
+        return;
+    }
+
+    const long numPixels = 37;
+    std::vector<float> img(4 * numPixels);
+    for (size_t idx = 0; idx < img.size(); ++idx)
+    {
+        img[idx] = (float(idx % 23) - 4.0f) * 0.137f;
+    }
+    img[1] = std::numeric_limits<float>::quiet_NaN();
+    img[6] = std::numeric_limits<float>::infinity();
+    img[9] = -0.0f;
+    img[11] = -0.0f;
+
+    std::vector<float> res(img.size()), ref(img.size());
+
+    OCIO::ApplyScale(&img[0], &ref[0], numPixels, 1.3f, false);
+    OCIO::ApplyScale(&img[0], &res[0], numPixels, 1.3f, true);
+    OCIO_CHECK_ASSERT(std::memcmp(&res[0], &ref[0], res.size() * sizeof(float)) == 0);
+
+    OCIO::ApplyScaleOffset(&img[0], &ref[0], numPixels, 0.7f, 0.2f, false);
+    OCIO::ApplyScaleOffset(&img[0], &res[0], numPixels, 0.7f, 0.2f, true);
+    OCIO_CHECK_ASSERT(std::memcmp(&res[0], &ref[0], res.size() * sizeof(float)) == 0);
+
+    OCIO::ApplyPower(&img[0], &ref[0], numPixels, 2.5f, 1.4f, 0.4f, false);
+    OCIO::ApplyPower(&img[0], &res[0], numPixels, 2.5f, 1.4f, 0.4f, true);
+    OCIO_CHECK_ASSERT(std::memcmp(&res[0], &ref[0], res.size() * sizeof(float)) == 0);
+
+    // The alpha values are copied.
+    for (long idx = 0; idx < numPixels; ++idx)
+    {
+        OCIO_CHECK_ASSERT(std::memcmp(&res[4 * idx + 3], &img[4 * idx + 3], sizeof(float)) == 0);
+    }
+}
+#endif
+
 #endif
@@ -154,6 +154,7 @@ public:
     bool isNoOp() const override;
     bool isIdentity() const override;
     bool hasChannelCrosstalk() const override { return false; }
+    bool touchesAlpha() const override { return false; }
 
     bool isDynamic() const;
     bool isInverse(ConstExposureContrastOpDataRcPtr & r) const;
@@ -6,6 +6,7 @@
 
 #include <OpenColorIO/OpenColorIO.h>
 
+#include "GpuShader.h"
 #include "ops/exposurecontrast/ExposureContrastOpGPU.h"
 
 
@@ -23,12 +24,18 @@ void AddUniform(GpuShaderDescRcPtr & shaderDesc,
                 DynamicPropertyImplRcPtr prop,
                 const std::string & name)
 {
+    // When enabled, the uniform block declares the property.
+    if (AddUniformBlockMember(*shaderDesc, name, prop))
+    {
+        return;
+    }
+
     // Add the uniform if it does not already exist.
     if (shaderDesc->addUniform(name.c_str(), prop))
     {
         // Declare uniform.
         GpuShaderText stDecl(shaderDesc->getLanguage());
-        stDecl.declareUniformFloat(name);
+        stDecl.declareUniformFloat(name, shaderDesc->getNumUniforms() - 1);
         shaderDesc->addToDeclareShaderCode(stDecl.string().c_str());
     }
 }
@@ -52,9 +59,17 @@ std::string AddDynamicProperty(GpuShaderDescRcPtr & shaderDesc,
     }
     else
     {
-        finalName = name;
+        // When enabled, the value is a member of the uniform block.
+        const float value = (float)prop->getDoubleValue();
+        finalName = AddUniformBlockMember(*shaderDesc, shaderDesc->getResourcePrefix() + name,
+                                          GpuShaderDesc::UNIFORM_FLOAT, &value);
+
+        if (finalName.empty())
+        {
+            finalName = name;
 
-        st.declareVar(finalName, (float)prop->getDoubleValue());
+            st.declareVar(finalName, value);
+        }
     }
 
     return finalName;
@@ -33,6 +33,7 @@ public:
     OpRcPtr clone() const override;
 
     std::string getInfo() const override;
+    double getCost() const override;
 
     bool isIdentity() const override;
     bool isSameType(ConstOpRcPtr & op) const override;
@@ -85,6 +86,21 @@ std::string ExposureContrastOp::getInfo() const
     return "<ExposureContrastOp>";
 }
 
+double ExposureContrastOp::getCost() const
+{
+    switch (ecData()->getStyle())
+    {
+        // Only a scale & offset per channel.
+        case ExposureContrastOpData::STYLE_LOGARITHMIC:
+        case ExposureContrastOpData::STYLE_LOGARITHMIC_REV:
+            return 2.0;
+
+        // One power function per channel.
+        default:
+            return 4.0;
+    }
+}
+
 bool ExposureContrastOp::isIdentity() const
 {
     return ecData()->isIdentity();
@@ -7,6 +7,7 @@
 
 #include <OpenColorIO/OpenColorIO.h>
 
+#include "CacheStatistics.h"
 #include "fileformats/cdl/CDLParser.h"
 #include "CDLTransform.h"
 #include "MathUtils.h"
@@ -14,8 +15,8 @@
 #include "OpBuilders.h"
 #include "ops/CDL/CDLOpData.h"
 #include "ParseUtils.h"
+#include "PathUtils.h"
 #include "Platform.h"
-#include "pystring/pystring.h"
 
 
 OCIO_NAMESPACE_ENTER
@@ -172,31 +173,133 @@ OCIO_NAMESPACE_ENTER
     
     namespace
     {
-        std::string GetCDLLocalCacheKey(const std::string & src, const std::string & cccid)
+        // The transforms of a cached source file, shared by all the look-ups in it.
+        struct CDLCollection
         {
-            std::ostringstream os;
-            os << src << " : " << cccid;
-            return os.str();
-        }
-        
-        std::string GetCDLLocalCacheKey(const char * src,
-                                        int cccindex)
+            // Is the source file a pure ColorCorrection element (i.e. the cccid
+            // is then ignored)?
+            bool m_isCC = false;
+            // The hash of the source file (refer to SetFileCacheCheckInterval()).
+            std::string m_srcHash;
+
+            // The transforms in the file order, and indexed by id.
+            CDLTransformVec m_transforms;
+            CDLTransformMap m_transformsById;
+
+            CDLTransformRcPtr find(const std::string & cccid) const
+            {
+                if (m_isCC)
+                {
+                    return m_transforms.front();
+                }
+
+                // Search for the cccid by name.
+                const auto iter = m_transformsById.find(cccid);
+                if (iter != m_transformsById.end())
+                {
+                    return iter->second;
+                }
+
+                // Search for the cccid by index.
+                int cccindex = 0;
+                if (StringToInt(&cccindex, cccid.c_str(), true)
+                    && cccindex >= 0 && size_t(cccindex) < m_transforms.size())
+                {
+                    return m_transforms[cccindex];
+                }
+
+                return CDLTransformRcPtr();
+            }
+        };
+
+        typedef OCIO_SHARED_PTR<CDLCollection> CDLCollectionRcPtr;
+
+        // The cached source files, by file path.
+        std::unordered_map<std::string, CDLCollectionRcPtr> g_cache;
+        Mutex g_cacheMutex;
+
+        CDLCollectionRcPtr LoadCDLCollection(const char * src, const std::string & srcHash)
         {
-            std::ostringstream os;
-            os << src << " : " << cccindex;
-            return os.str();
+            std::ifstream istream(src);
+            if(istream.fail()) {
+                std::ostringstream os;
+                os << "Error could not read CDL source file '" << src;
+                os << "'. Please verify the file exists and appropriate ";
+                os << "permissions are set.";
+                throw Exception (os.str().c_str());
+            }
+            
+            CDLParser parser(src);
+            parser.parse(istream);
+
+            CDLCollectionRcPtr collection = std::make_shared<CDLCollection>();
+            collection->m_srcHash = srcHash;
+
+            if (parser.isCC())
+            {
+                // Load a single ColorCorrection.
+                CDLTransformRcPtr cdl = CDLTransform::Create();
+                parser.getCDLTransform(cdl);
+
+                collection->m_isCC = true;
+                collection->m_transforms.push_back(cdl);
+            }
+            else if(parser.isCCC())
+            {
+                // Load all CCs from the ColorCorrectionCollection.
+                FormatMetadataImpl metadata;
+                parser.getCDLTransforms(collection->m_transformsById,
+                                        collection->m_transforms,
+                                        metadata);
+                
+                if(collection->m_transforms.empty())
+                {
+                    std::ostringstream os;
+                    os << "Error loading ccc xml. ";
+                    os << "No ColorCorrection elements found in file '";
+                    os << src << "'.";
+                    throw Exception(os.str().c_str());
+                }
+            }
+
+            return collection;
         }
-        
-        CDLTransformMap g_cache;
-        StringBoolMap g_cacheSrcIsCC;
-        Mutex g_cacheMutex;
     }
     
     void ClearCDLTransformFileCache()
     {
         AutoMutex lock(g_cacheMutex);
         g_cache.clear();
-        g_cacheSrcIsCC.clear();
+    }
+
+    void ClearCDLTransformFileCache(const std::string & src)
+    {
+        AutoMutex lock(g_cacheMutex);
+        g_cache.erase(src);
+    }
+
+    size_t GetCDLTransformFileCacheMemoryUsage()
+    {
+        AutoMutex lock(g_cacheMutex);
+
+        size_t numBytes = 0;
+        for(const auto & entry : g_cache)
+        {
+            const CDLCollection & collection = *entry.second;
+
+            numBytes += entry.first.capacity() + sizeof(CDLCollection)
+                      + collection.m_srcHash.capacity()
+                      + collection.m_transforms.capacity() * sizeof(CDLTransformRcPtr)
+                      + collection.m_transforms.size()
+                            * (sizeof(CDLTransform) + sizeof(CDLOpData));
+
+            for(const auto & id : collection.m_transformsById)
+            {
+                numBytes += id.first.capacity() + sizeof(CDLTransformRcPtr);
+            }
+        }
+
+        return numBytes;
     }
     
     // TODO: Expose functions for introspecting in ccc file
@@ -215,128 +318,52 @@ OCIO_NAMESPACE_ENTER
         std::string cccid;
         if(cccid_) cccid = cccid_;
         
+        // When the files are checked (refer to SetFileCacheCheckInterval()), a source
+        // file changed since its loading is loaded again.
+        const std::string srcHash
+            = GetFileCacheCheckInterval() != 0 ? GetFastFileHash(src) : "";
+
         // Check cache
-        AutoMutex lock(g_cacheMutex);
-        
-        // Use g_cacheSrcIsCC as a proxy for if we have loaded this source
-        // file already (in which case it must be in cache, or an error)
-        
-        StringBoolMap::iterator srcIsCCiter = g_cacheSrcIsCC.find(src);
-        if(srcIsCCiter != g_cacheSrcIsCC.end())
+        CacheStatistics & statistics = GetCacheStatistics(CACHE_CDL_FILE);
+        AutoTimedMutex lock(g_cacheMutex, statistics);
+
+        CDLCollectionRcPtr & collection = g_cache[src];
+        if(collection && !srcHash.empty())
         {
-            // If the source file is known to be a pure ColorCorrection element,
-            // null out the cccid so its ignored.
-            if(srcIsCCiter->second) cccid = "";
-            
-            // Search for the cccid by name
-            CDLTransformMap::iterator iter = 
-                g_cache.find(GetCDLLocalCacheKey(src, cccid));
-            if(iter != g_cache.end())
+            if(collection->m_srcHash.empty())
             {
-                return iter->second;
+                // The file was loaded when the files were not checked.
+                collection->m_srcHash = srcHash;
             }
-            
-            // Search for cccid by index
-            int cccindex=0;
-            if(StringToInt(&cccindex, cccid.c_str(), true))
+            else if(collection->m_srcHash != srcHash)
             {
-                iter = g_cache.find(GetCDLLocalCacheKey(src, cccindex));
-                if(iter != g_cache.end())
-                {
-                    return iter->second;
-                }
+                collection.reset();
+                statistics.addEvictions(1);
             }
-            
-            std::ostringstream os;
-            os << "The specified cccid/cccindex '" << cccid;
-            os << "' could not be loaded from the src file '";
-            os << src;
-            os << "'.";
-            throw Exception (os.str().c_str());
         }
-        
-        
-        // Try to read all ccs from the file, into cache
-        std::ifstream istream(src);
-        if(istream.fail()) {
-            std::ostringstream os;
-            os << "Error could not read CDL source file '" << src;
-            os << "'. Please verify the file exists and appropriate ";
-            os << "permissions are set.";
-            throw Exception (os.str().c_str());
-        }
-        
-        CDLParser parser(src);
-        parser.parse(istream);
 
-        if (parser.isCC())
+        if(collection)
         {
-            // Load a single ColorCorrection into the cache
-            CDLTransformRcPtr cdl = CDLTransform::Create();
-            parser.getCDLTransform(cdl);
-
-            cccid = "";
-            g_cacheSrcIsCC[src] = true;
-            g_cache[GetCDLLocalCacheKey(src, cccid)] = cdl;
+            statistics.addHit();
         }
-        else if(parser.isCCC())
+        else
         {
-            // Load all CCs from the ColorCorrectionCollection
-            // into the cache
-            CDLTransformMap transformMap;
-            CDLTransformVec transformVec;
-            FormatMetadataImpl metadata;
-
-            parser.getCDLTransforms(transformMap, transformVec, metadata);
-            
-            if(transformVec.empty())
+            statistics.addMiss();
+            try
             {
-                std::ostringstream os;
-                os << "Error loading ccc xml. ";
-                os << "No ColorCorrection elements found in file '";
-                os << src << "'.";
-                throw Exception(os.str().c_str());
+                collection = LoadCDLCollection(src, srcHash);
+                statistics.addInsertion();
             }
-            
-            g_cacheSrcIsCC[src] = false;
-            
-            // Add all by transforms to cache
-            // First by index, then by id
-            for(unsigned int i=0; i<transformVec.size(); ++i)
+            catch(...)
             {
-                g_cache[GetCDLLocalCacheKey(src, i)] = transformVec[i];
-            }
-            
-            for(CDLTransformMap::iterator iter = transformMap.begin();
-                iter != transformMap.end();
-                ++iter)
-            {
-                g_cache[GetCDLLocalCacheKey(src, iter->first)] = iter->second;
+                g_cache.erase(src);
+                throw;
             }
         }
-        
-        // The all transforms should be in the cache.  Look it up, and try
-        // to return it.
+
+        CDLTransformRcPtr cdl = collection->find(cccid);
+        if(!cdl)
         {
-            // Search for the cccid by name
-            CDLTransformMap::iterator iter = 
-                g_cache.find(GetCDLLocalCacheKey(src, cccid));
-            if(iter != g_cache.end())
-            {
-                return iter->second;
-            }
-            
-            // Search for cccid by index
-            int cccindex=0;
-            if(StringToInt(&cccindex, cccid.c_str(), true))
-            {
-                iter = g_cache.find(GetCDLLocalCacheKey(src, cccindex));
-                if(iter != g_cache.end())
-                {
-                    return iter->second;
-                }
-            }
-            
             std::ostringstream os;
             os << "The specified cccid/cccindex '" << cccid;
             os << "' could not be loaded from the src file '";
@@ -344,6 +371,8 @@ OCIO_NAMESPACE_ENTER
             os << "'.";
             throw Exception (os.str().c_str());
         }
+
+        return cdl;
     }
     
     void CDLTransform::deleter(CDLTransform* t)
@@ -594,6 +623,16 @@ OCIO_NAMESPACE_ENTER
     {
         return getImpl()->getID().c_str();
     }
+
+    bool CDLTransform::isDynamic() const
+    {
+        return getImpl()->isDynamic();
+    }
+
+    void CDLTransform::makeDynamic()
+    {
+        getImpl()->makeDynamic();
+    }
     
     void CDLTransform::setDescription(const char * desc)
     {
@@ -653,6 +692,9 @@ OCIO_NAMESPACE_EXIT
 
 #ifdef OCIO_UNIT_TEST
 
+#include <chrono>
+#include <thread>
+
 #include "UnitTest.h"
 #include "UnitTestUtils.h"
 #include "Platform.h"
@@ -939,6 +981,68 @@ OCIO_ADD_TEST(CDLTransform, clear_caches)
     OCIO_CHECK_EQUAL(slope[0], 1.1);
     OCIO_CHECK_EQUAL(slope[1], 2.2);
     OCIO_CHECK_EQUAL(slope[2], 3.3);
+
+    // Only evict the file from the cache.
+    const std::string cccPath(std::string(OCIO::getTestFilesDir()) + "/cdl_test1.ccc");
+    OCIO::CDLTransformRcPtr cccTransform;
+    OCIO_CHECK_NO_THROW(cccTransform = OCIO::CDLTransform::CreateFromFile(cccPath.c_str(), "1"));
+
+    stream.open(filename, std::ios_base::out|std::ios_base::trunc);
+    stream << kContentsA;
+    stream.close();
+
+    OCIO_CHECK_NO_THROW(OCIO::ClearCDLTransformFileCache(filename));
+
+    OCIO_CHECK_NO_THROW(transform = OCIO::CDLTransform::CreateFromFile(filename.c_str(), "cc03343"));
+    OCIO_CHECK_NO_THROW(transform->getSlope(slope));
+    OCIO_CHECK_EQUAL(slope[0], 0.1);
+
+    OCIO::CDLTransformRcPtr cccTransform2;
+    OCIO_CHECK_NO_THROW(cccTransform2 = OCIO::CDLTransform::CreateFromFile(cccPath.c_str(), "1"));
+    OCIO_CHECK_EQUAL(cccTransform2.get(), cccTransform.get());
+}
+
+OCIO_ADD_TEST(CDLTransform, check_file_changes)
+{
+    OCIO::ClearAllCaches();
+
+    std::string filename;
+    OCIO_CHECK_NO_THROW(OCIO::Platform::CreateTempFilename(filename, ""));
+
+    std::fstream stream(filename, std::ios_base::out|std::ios_base::trunc);
+    stream << kContentsA;
+    stream.close();
+
+    OCIO::SetFileCacheCheckInterval(1);
+    OCIO_CHECK_EQUAL(OCIO::GetFileCacheCheckInterval(), 1);
+
+    OCIO::CDLTransformRcPtr transform; 
+    OCIO_CHECK_NO_THROW(transform = OCIO::CDLTransform::CreateFromFile(filename.c_str(), "cc03343"));
+
+    double slope[3];
+    OCIO_CHECK_NO_THROW(transform->getSlope(slope));
+    OCIO_CHECK_EQUAL(slope[0], 0.1);
+
+    // The unchanged file stays in the cache.
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    OCIO::CDLTransformRcPtr transform2; 
+    OCIO_CHECK_NO_THROW(transform2 = OCIO::CDLTransform::CreateFromFile(filename.c_str(), "cc03343"));
+    OCIO_CHECK_EQUAL(transform2.get(), transform.get());
+
+    // The changed file (i.e. its size also differs in case the file system has a coarse
+    // modification time) is loaded again without clearing the caches.
+    stream.open(filename, std::ios_base::out|std::ios_base::trunc);
+    stream << kContentsB << "\n";
+    stream.close();
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    OCIO_CHECK_NO_THROW(transform = OCIO::CDLTransform::CreateFromFile(filename.c_str(), "cc03343"));
+    OCIO_CHECK_NO_THROW(transform->getSlope(slope));
+    OCIO_CHECK_EQUAL(slope[0], 1.1);
+    OCIO_CHECK_EQUAL(slope[1], 2.2);
+    OCIO_CHECK_EQUAL(slope[2], 3.3);
+
+    OCIO::SetFileCacheCheckInterval(0);
 }
 
 OCIO_ADD_TEST(CDLTransform, faulty_file_content)
@@ -1026,6 +1130,75 @@ OCIO_ADD_TEST(CDLTransform, buildops)
     OCIO_REQUIRE_ASSERT(cdldata);
 }
 
+OCIO_ADD_TEST(CDLTransform, dynamic)
+{
+    const std::string filePath(std::string(OCIO::getTestFilesDir())
+                               + "/cdl_test1.ccc");
+
+    // Note: The transforms of the file cache are shared so only edit copies.
+    OCIO::ConstCDLTransformRcPtr shot1 =
+        OCIO::CDLTransform::CreateFromFile(filePath.c_str(), "cc0003");
+    OCIO::ConstCDLTransformRcPtr shot2 =
+        OCIO::CDLTransform::CreateFromFile(filePath.c_str(), "3");
+
+    OCIO::CDLTransformRcPtr cdl
+        = OCIO::DynamicPtrCast<OCIO::CDLTransform>(shot1->createEditableCopy());
+    OCIO_CHECK_ASSERT(!cdl->isDynamic());
+    cdl->makeDynamic();
+    OCIO_CHECK_ASSERT(cdl->isDynamic());
+    OCIO_CHECK_ASSERT(!shot1->isDynamic());
+    OCIO_CHECK_ASSERT(!cdl->equals(shot1));
+
+    OCIO::ConfigRcPtr config = OCIO::Config::Create();
+    config->setMajorVersion(2);
+
+    OCIO::ConstProcessorRcPtr proc;
+    OCIO_CHECK_NO_THROW(proc = config->getProcessor(cdl));
+    OCIO_REQUIRE_ASSERT(proc->hasDynamicProperty(OCIO::DYNAMIC_PROPERTY_CDL));
+    OCIO::ConstCPUProcessorRcPtr cpu = proc->getDefaultCPUProcessor();
+
+    OCIO::DynamicPropertyRcPtr dp;
+    OCIO_CHECK_NO_THROW(dp = cpu->getDynamicProperty(OCIO::DYNAMIC_PROPERTY_CDL));
+    OCIO_REQUIRE_ASSERT(dp);
+    OCIO_CHECK_EQUAL(dp->getValueType(), OCIO::DYNAMIC_PROPERTY_CDL_VALUES);
+
+    const float srcPixel[4] = { 0.3f, 0.5f, 0.1f, 1.0f };
+
+    // Switch between the shots without creating new processors.
+    for (const auto & shot : { shot1, shot2, shot1 })
+    {
+        double slope[3], offset[3], power[3];
+        shot->getSlope(slope);
+        shot->getOffset(offset);
+        shot->getPower(power);
+        OCIO_CHECK_NO_THROW(dp->setCDLValues(slope, offset, power, shot->getSat()));
+
+        float pixel[4] = { srcPixel[0], srcPixel[1], srcPixel[2], srcPixel[3] };
+        cpu->applyRGBA(pixel);
+
+        float refPixel[4] = { srcPixel[0], srcPixel[1], srcPixel[2], srcPixel[3] };
+        config->getProcessor(shot)->getDefaultCPUProcessor()->applyRGBA(refPixel);
+
+        OCIO_CHECK_EQUAL(pixel[0], refPixel[0]);
+        OCIO_CHECK_EQUAL(pixel[1], refPixel[1]);
+        OCIO_CHECK_EQUAL(pixel[2], refPixel[2]);
+        OCIO_CHECK_EQUAL(pixel[3], refPixel[3]);
+    }
+
+    // The transform keeps its own values.
+    double slope[3] = { 0., 0., 0. };
+    cdl->getSlope(slope);
+    OCIO_CHECK_EQUAL(slope[0], 1.2);
+
+    // An identity dynamic CDL is not optimized out.
+    OCIO::CDLTransformRcPtr identity = OCIO::CDLTransform::Create();
+    identity->makeDynamic();
+    OCIO_CHECK_NO_THROW(proc = config->getProcessor(identity));
+    OCIO_CHECK_ASSERT(proc->hasDynamicProperty(OCIO::DYNAMIC_PROPERTY_CDL));
+    OCIO_CHECK_NO_THROW(proc->getDefaultCPUProcessor()->getDynamicProperty(
+        OCIO::DYNAMIC_PROPERTY_CDL));
+}
+
 OCIO_ADD_TEST(CDLTransform, description)
 {
     auto cdl = OCIO::CDLTransform::Create();
@@ -5,7 +5,7 @@
 #ifndef INCLUDED_OCIO_CDLTRANSFORM_H
 #define INCLUDED_OCIO_CDLTRANSFORM_H
 
-#include <map>
+#include <unordered_map>
 #include <vector>
 
 #include <OpenColorIO/OpenColorIO.h>
@@ -17,10 +17,18 @@ static constexpr const char * METADATA_VIEWING_DESCRIPTION = "ViewingDescription
 static constexpr const char * METADATA_SOP_DESCRIPTION = "SOPDescription";
 static constexpr const char * METADATA_SAT_DESCRIPTION = "SATDescription";
 
-typedef std::map<std::string,CDLTransformRcPtr> CDLTransformMap;
+// Index of the ColorCorrection ids i.e. constant time look-up when switching between
+// the corrections of a ColorCorrectionCollection (e.g. per shot).
+typedef std::unordered_map<std::string,CDLTransformRcPtr> CDLTransformMap;
 typedef std::vector<CDLTransformRcPtr> CDLTransformVec;
 
 void ClearCDLTransformFileCache();
+// Remove the transforms of a source file from the cache (refer to
+// CDLTransform::CreateFromFile()).
+void ClearCDLTransformFileCache(const std::string & src);
+
+// Get the approximate number of bytes held by the cache of the CDL files.
+size_t GetCDLTransformFileCacheMemoryUsage();
 
 void LoadCDL(CDLTransform * cdl, const char * xml);
 
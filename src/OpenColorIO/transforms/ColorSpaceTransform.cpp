@@ -1,10 +1,17 @@
 // SPDX-License-Identifier: BSD-3-Clause
 // Copyright Contributors to the OpenColorIO Project.
 
+#include <map>
+#include <sstream>
+#include <utility>
+
 #include <OpenColorIO/OpenColorIO.h>
 
+#include "CacheStatistics.h"
+#include "Mutex.h"
 #include "ops/NoOp/NoOps.h"
 #include "OpBuilders.h"
+#include "transforms/ColorSpaceTransform.h"
 
 
 OCIO_NAMESPACE_ENTER
@@ -173,6 +180,202 @@ OCIO_NAMESPACE_ENTER
             if(!a.empty()) return (a==b);
             return false;
         }
+
+        // Build the ops going to the reference space, or coming from it.
+        void BuildReferenceOps(OpRcPtrVec & ops,
+                               const Config & config,
+                               const ConstContextRcPtr & context,
+                               const ConstColorSpaceRcPtr & colorSpace,
+                               ColorSpaceDirection dir)
+        {
+            const ColorSpaceDirection otherDir
+                = dir==COLORSPACE_DIR_TO_REFERENCE ? COLORSPACE_DIR_FROM_REFERENCE
+                                                   : COLORSPACE_DIR_TO_REFERENCE;
+
+            // Use the transform in the requested direction, otherwise invert the other one.
+            if(colorSpace->getTransform(dir))
+            {
+                BuildOps(ops, config, context, colorSpace->getTransform(dir), TRANSFORM_DIR_FORWARD);
+            }
+            else if(colorSpace->getTransform(otherDir))
+            {
+                BuildOps(ops, config, context, colorSpace->getTransform(otherDir), TRANSFORM_DIR_INVERSE);
+            }
+            // Otherwise, both are not defined so its a no-op. This is not an error condition.
+        }
+
+        // Is the transform built the same way whatever the context is, i.e. it neither
+        // references files nor other color spaces (which could reference files)?
+        bool IsContextIndependent(const ConstTransformRcPtr & transform)
+        {
+            if(!transform) return true;
+
+            if(ConstGroupTransformRcPtr group = DynamicPtrCast<const GroupTransform>(transform))
+            {
+                for(int idx = 0; idx < group->getNumTransforms(); ++idx)
+                {
+                    if(!IsContextIndependent(group->getTransform(idx)))
+                    {
+                        return false;
+                    }
+                }
+                return true;
+            }
+
+            return !DynamicPtrCast<const FileTransform>(transform)
+                && !DynamicPtrCast<const ColorSpaceTransform>(transform)
+                && !DynamicPtrCast<const LookTransform>(transform)
+                && !DynamicPtrCast<const DisplayTransform>(transform);
+        }
+
+        // A viewer typically creates the processors from one color space to all
+        // the display/view combinations so the op chains going to (or coming from)
+        // the reference space are cached, the processors then sharing the same
+        // (finalized) ops instead of building them again.
+        //
+        // The key is the config cache id (i.e. including the context & the file
+        // references), the color space name and the direction. The color spaces
+        // which do not depend on the context (e.g. the matrices of the hub spaces)
+        // only use the config cache id without context so all the contexts (e.g. one
+        // per shot) share their op chains.
+
+        typedef std::map<std::string, OpRcPtrVec> ColorSpaceOpsCache;
+
+        ColorSpaceOpsCache g_colorSpaceOpsCache;
+        Mutex g_colorSpaceOpsCacheLock;
+
+        void BuildCachedReferenceOps(OpRcPtrVec & ops,
+                                     const Config & config,
+                                     const ConstContextRcPtr & context,
+                                     const ConstColorSpaceRcPtr & colorSpace,
+                                     ColorSpaceDirection dir)
+        {
+            const ColorSpaceDirection otherDir
+                = dir==COLORSPACE_DIR_TO_REFERENCE ? COLORSPACE_DIR_FROM_REFERENCE
+                                                   : COLORSPACE_DIR_TO_REFERENCE;
+
+            std::string key;
+
+            // Only the color spaces of the config are identified by the config cache id.
+            if(config.getColorSpace(colorSpace->getName()).get() == colorSpace.get())
+            {
+                try
+                {
+                    const bool contextIndependent
+                        = IsContextIndependent(colorSpace->getTransform(dir))
+                            && IsContextIndependent(colorSpace->getTransform(otherDir));
+
+                    // When the files are checked (refer to SetFileCacheCheckInterval()),
+                    // the op chains possibly using files are not cached as the key does
+                    // not change with the file contents.
+                    if(contextIndependent || GetFileCacheCheckInterval() == 0)
+                    {
+                        std::ostringstream oss;
+                        oss << config.getCacheID(contextIndependent ? ConstContextRcPtr()
+                                                                    : context)
+                            << " " << colorSpace->getName() << " "
+                            << ColorSpaceDirectionToString(dir);
+                        key = oss.str();
+                    }
+                }
+                catch(const Exception &)
+                {
+                    key.clear();
+                }
+            }
+
+            if(key.empty())
+            {
+                BuildReferenceOps(ops, config, context, colorSpace, dir);
+                return;
+            }
+
+            CacheStatistics & statistics = GetCacheStatistics(CACHE_COLORSPACE_OPS);
+
+            {
+                AutoTimedMutex lock(g_colorSpaceOpsCacheLock, statistics);
+
+                ColorSpaceOpsCache::const_iterator iter = g_colorSpaceOpsCache.find(key);
+                if(iter != g_colorSpaceOpsCache.end())
+                {
+                    statistics.addHit();
+                    ops += iter->second;
+                    return;
+                }
+            }
+
+            statistics.addMiss();
+
+            // Note that the lock is not held while building the ops as they could
+            // recursively need other color spaces (e.g. a ColorSpaceTransform).
+
+            // As in the processor op list, the op chain never starts the list (i.e. it
+            // follows the allocation no-op) so a group transform does not copy its
+            // metadata as the processor one.
+            OpRcPtrVec newOps;
+            CreateGpuAllocationNoOp(newOps, AllocationData());
+            BuildReferenceOps(newOps, config, context, colorSpace, dir);
+            newOps.erase(newOps.begin());
+
+            // The op chains adding processor metadata (e.g. from a CLF file) are not
+            // shared as the metadata is then directly updated in the processor op list
+            // (i.e. not combined).
+            const FormatMetadataImpl & metadata = newOps.getFormatMetadata();
+            if(metadata.getNumAttributes() != 0 || metadata.getNumChildrenElements() != 0
+                || *metadata.getValue() != 0)
+            {
+                BuildReferenceOps(ops, config, context, colorSpace, dir);
+                return;
+            }
+
+            FinalizeOpVec(newOps, FINALIZATION_EXACT);
+
+            // The dynamic properties are unified per processor so the dynamic ops are
+            // never shared.
+            for(const auto & op : newOps)
+            {
+                if(op->isDynamic())
+                {
+                    ops += newOps;
+                    return;
+                }
+            }
+
+            for(auto & op : newOps)
+            {
+                op->setShared();
+            }
+
+            AutoTimedMutex lock(g_colorSpaceOpsCacheLock, statistics);
+
+            // Another thread could have cached the same op chain in the meantime.
+            const auto result
+                = g_colorSpaceOpsCache.insert(std::make_pair(key, std::move(newOps)));
+            if(result.second)
+            {
+                statistics.addInsertion();
+            }
+            ops += result.first->second;
+        }
+    }
+
+    void ClearColorSpaceOpsCache()
+    {
+        AutoMutex lock(g_colorSpaceOpsCacheLock);
+        g_colorSpaceOpsCache.clear();
+    }
+
+    size_t GetColorSpaceOpsCacheMemoryUsage()
+    {
+        AutoMutex lock(g_colorSpaceOpsCacheLock);
+
+        size_t numBytes = 0;
+        for(const auto & entry : g_colorSpaceOpsCache)
+        {
+            numBytes += entry.first.capacity() + GetOpVecMemorySize(entry.second);
+        }
+
+        return numBytes;
     }
     
     void BuildColorSpaceOps(OpRcPtrVec & ops,
@@ -209,28 +412,12 @@ OCIO_NAMESPACE_ENTER
         // Go to the reference space, either by using
         // * cs->ref in the forward direction
         // * ref->cs in the inverse direction
-        if(srcColorSpace->getTransform(COLORSPACE_DIR_TO_REFERENCE))
-        {
-            BuildOps(ops, config, context, srcColorSpace->getTransform(COLORSPACE_DIR_TO_REFERENCE), TRANSFORM_DIR_FORWARD);
-        }
-        else if(srcColorSpace->getTransform(COLORSPACE_DIR_FROM_REFERENCE))
-        {
-            BuildOps(ops, config, context, srcColorSpace->getTransform(COLORSPACE_DIR_FROM_REFERENCE), TRANSFORM_DIR_INVERSE);
-        }
-        // Otherwise, both are not defined so its a no-op. This is not an error condition.
+        BuildCachedReferenceOps(ops, config, context, srcColorSpace, COLORSPACE_DIR_TO_REFERENCE);
         
         // Go from the reference space, either by using
         // * ref->cs in the forward direction
         // * cs->ref in the inverse direction
-        if(dstColorSpace->getTransform(COLORSPACE_DIR_FROM_REFERENCE))
-        {
-            BuildOps(ops, config, context, dstColorSpace->getTransform(COLORSPACE_DIR_FROM_REFERENCE), TRANSFORM_DIR_FORWARD);
-        }
-        else if(dstColorSpace->getTransform(COLORSPACE_DIR_TO_REFERENCE))
-        {
-            BuildOps(ops, config, context, dstColorSpace->getTransform(COLORSPACE_DIR_TO_REFERENCE), TRANSFORM_DIR_INVERSE);
-        }
-        // Otherwise, both are not defined so its a no-op. This is not an error condition.
+        BuildCachedReferenceOps(ops, config, context, dstColorSpace, COLORSPACE_DIR_FROM_REFERENCE);
         
         AllocationData dstAllocation;
         dstAllocation.allocation = dstColorSpace->getAllocation();
@@ -0,0 +1,23 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the OpenColorIO Project.
+
+
+#ifndef INCLUDED_OCIO_COLORSPACETRANSFORM_H
+#define INCLUDED_OCIO_COLORSPACETRANSFORM_H
+
+#include <OpenColorIO/OpenColorIO.h>
+
+OCIO_NAMESPACE_ENTER
+{
+
+// Clear the cache of the op chains going to (or coming from) the reference
+// space of the color spaces.
+void ClearColorSpaceOpsCache();
+
+// Get the approximate number of bytes held by the color space ops cache.
+size_t GetColorSpaceOpsCacheMemoryUsage();
+
+}
+OCIO_NAMESPACE_EXIT
+
+#endif
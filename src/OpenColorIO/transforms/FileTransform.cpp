@@ -2,19 +2,32 @@
 // Copyright Contributors to the OpenColorIO Project.
 
 #include <algorithm>
+#include <array>
+#include <atomic>
+#include <cctype>
+#include <cstring>
 #include <fstream>
+#include <functional>
+#include <list>
 #include <map>
+#include <random>
 #include <sstream>
+#include <unordered_map>
 
 #include <OpenColorIO/OpenColorIO.h>
 
+#include "CacheStatistics.h"
 #include "FileTransform.h"
+#include "HashUtils.h"
 #include "Logging.h"
 #include "Mutex.h"
+#include "ops/Lut1D/Lut1DOpData.h"
+#include "ops/Lut3D/Lut3DOpData.h"
 #include "ops/NoOp/NoOps.h"
 #include "PathUtils.h"
 #include "Platform.h"
 #include "pystring/pystring.h"
+#include "Tracing.h"
 
 OCIO_NAMESPACE_ENTER
 {
@@ -416,6 +429,93 @@ OCIO_NAMESPACE_ENTER
         }
         return "Unknown Format";
     }
+
+    int FileFormat::probe(const std::string & /*header*/) const
+    {
+        return FORMAT_PROBE_UNKNOWN;
+    }
+
+    std::string GetProbeFirstLine(const std::string & header, bool skipBlankLines)
+    {
+        size_t start = 0;
+        while (start < header.size())
+        {
+            size_t end = header.find('\n', start);
+            if (end == std::string::npos)
+            {
+                end = header.size();
+            }
+
+            std::string line = header.substr(start, end - start);
+            if (!line.empty() && line[line.size() - 1] == '\r')
+            {
+                line.resize(line.size() - 1);
+            }
+
+            if (!skipBlankLines || !pystring::strip(line).empty())
+            {
+                return line;
+            }
+
+            start = end + 1;
+        }
+
+        return "";
+    }
+
+    bool IsProbeXML(const std::string & header)
+    {
+        size_t pos = 0;
+        if (header.compare(0, 3, "\xEF\xBB\xBF") == 0)
+        {
+            pos = 3;
+        }
+
+        pos = header.find_first_not_of(" \t\r\n", pos);
+        return pos != std::string::npos && header[pos] == '<';
+    }
+
+    bool HasProbeKeyword(const std::string & header, const char * keyword)
+    {
+        const size_t keywordLen = strlen(keyword);
+
+        size_t start = 0;
+        while (start < header.size())
+        {
+            start = header.find_first_not_of(" \t", start);
+            if (start == std::string::npos)
+            {
+                break;
+            }
+
+            if (header.size() - start >= keywordLen)
+            {
+                size_t idx = 0;
+                while (idx < keywordLen
+                       && std::tolower((unsigned char)header[start + idx])
+                            == std::tolower((unsigned char)keyword[idx]))
+                {
+                    ++idx;
+                }
+                const size_t end = start + keywordLen;
+                if (idx == keywordLen && (end == header.size()
+                                          || (!std::isalnum((unsigned char)header[end])
+                                              && header[end] != '_')))
+                {
+                    return true;
+                }
+            }
+
+            start = header.find('\n', start);
+            if (start == std::string::npos)
+            {
+                break;
+            }
+            ++start;
+        }
+
+        return false;
+    }
         
     
     
@@ -438,23 +538,327 @@ OCIO_NAMESPACE_ENTER
         throw Exception(os.str().c_str());
     }
 
+    bool FileFormat::writeCachedFile(const CachedFile & /*cachedFile*/,
+                                     std::ostream & /*ostream*/) const
+    {
+        return false;
+    }
+
+    CachedFileRcPtr FileFormat::readCachedFile(std::istream & /*istream*/) const
+    {
+        std::ostringstream os;
+        os << "Format " << getName() << " does not support the file disk cache.";
+        throw Exception(os.str().c_str());
+    }
+
+    bool FileFormat::readHeader(std::istream & /*istream*/,
+                                const std::string & /*originalFileName*/,
+                                FileHeader & /*header*/) const
+    {
+        return false;
+    }
+
+    void WriteCachedString(std::ostream & ostream, const std::string & str)
+    {
+        WriteCachedValue(ostream, uint64_t(str.size()));
+        ostream.write(str.c_str(), str.size());
+    }
+
+    std::string ReadCachedString(std::istream & istream)
+    {
+        const uint64_t size = ReadCachedValue<uint64_t>(istream);
+        if (size > (uint64_t(1) << 32))
+        {
+            throw Exception("Corrupted cached file.");
+        }
+
+        std::string str(size_t(size), ' ');
+        if (size && !istream.read(&str[0], std::streamsize(size)))
+        {
+            throw Exception("Truncated cached file.");
+        }
+        return str;
+    }
+
+    void WriteCachedMetadata(std::ostream & ostream, const FormatMetadata & metadata)
+    {
+        WriteCachedString(ostream, metadata.getName());
+        WriteCachedString(ostream, metadata.getValue());
+
+        WriteCachedValue(ostream, int32_t(metadata.getNumAttributes()));
+        for (int idx = 0; idx < metadata.getNumAttributes(); ++idx)
+        {
+            WriteCachedString(ostream, metadata.getAttributeName(idx));
+            WriteCachedString(ostream, metadata.getAttributeValue(idx));
+        }
+
+        WriteCachedValue(ostream, int32_t(metadata.getNumChildrenElements()));
+        for (int idx = 0; idx < metadata.getNumChildrenElements(); ++idx)
+        {
+            WriteCachedMetadata(ostream, metadata.getChildElement(idx));
+        }
+    }
+
     namespace
     {
-    
-        void LoadFileUncached(FileFormat * & returnFormat,
-            CachedFileRcPtr & returnCachedFile,
-            const std::string & filepath)
+        // Read the attributes and the children elements of the metadata.
+        void ReadCachedMetadataContent(std::istream & istream, FormatMetadata & metadata)
         {
-            returnFormat = NULL;
-            
+            const int32_t numAttributes = ReadCachedValue<int32_t>(istream);
+            for (int32_t idx = 0; idx < numAttributes; ++idx)
             {
-                std::ostringstream os;
-                os << "Opening " << filepath;
-                LogDebug(os.str());
+                const std::string name = ReadCachedString(istream);
+                metadata.addAttribute(name.c_str(), ReadCachedString(istream).c_str());
             }
-            
-            // Try the initial format.
-            std::string primaryErrorText;
+
+            const int32_t numChildren = ReadCachedValue<int32_t>(istream);
+            for (int32_t idx = 0; idx < numChildren; ++idx)
+            {
+                const std::string name = ReadCachedString(istream);
+                const std::string value = ReadCachedString(istream);
+                ReadCachedMetadataContent(istream,
+                                          metadata.addChildElement(name.c_str(), value.c_str()));
+            }
+        }
+    }
+
+    void ReadCachedMetadata(std::istream & istream, FormatMetadata & metadata)
+    {
+        metadata.clear();
+
+        const std::string name = ReadCachedString(istream);
+        metadata.setName(name.c_str());
+        metadata.setValue(ReadCachedString(istream).c_str());
+
+        ReadCachedMetadataContent(istream, metadata);
+    }
+
+    namespace
+    {
+        void WriteCachedValues(std::ostream & ostream, const std::vector<float> & values)
+        {
+            WriteCachedValue(ostream, uint64_t(values.size()));
+            ostream.write(reinterpret_cast<const char *>(values.data()),
+                          values.size() * sizeof(float));
+        }
+
+        void ReadCachedValues(std::istream & istream, std::vector<float> & values)
+        {
+            if (ReadCachedValue<uint64_t>(istream) != values.size())
+            {
+                throw Exception("Corrupted cached file: unexpected number of LUT values.");
+            }
+
+            if (!istream.read(reinterpret_cast<char *>(values.data()),
+                              std::streamsize(values.size() * sizeof(float))))
+            {
+                throw Exception("Truncated cached file.");
+            }
+        }
+    }
+
+    void WriteCachedLut1D(std::ostream & ostream, const ConstLut1DOpDataRcPtr & lut)
+    {
+        WriteCachedValue(ostream, uint8_t(lut ? 1 : 0));
+        if (!lut)
+        {
+            return;
+        }
+
+        if (lut->getDirection() != TRANSFORM_DIR_FORWARD)
+        {
+            throw Exception("Only the forward LUTs can be cached.");
+        }
+
+        const Array & array = lut->getArray();
+        WriteCachedValue(ostream, uint32_t(array.getLength()));
+        WriteCachedValue(ostream, uint32_t(array.getNumColorComponents()));
+        WriteCachedValue(ostream, int32_t(lut->getHalfFlags()));
+        WriteCachedValue(ostream, int32_t(lut->getHueAdjust()));
+        WriteCachedValue(ostream, int32_t(lut->getInterpolation()));
+        WriteCachedValue(ostream, int32_t(lut->getInversionQuality()));
+        WriteCachedValue(ostream, int32_t(lut->getFileOutputBitDepth()));
+        WriteCachedMetadata(ostream, lut->getFormatMetadata());
+        WriteCachedValues(ostream, array.getValues());
+    }
+
+    Lut1DOpDataRcPtr ReadCachedLut1D(std::istream & istream)
+    {
+        if (ReadCachedValue<uint8_t>(istream) == 0)
+        {
+            return Lut1DOpDataRcPtr();
+        }
+
+        const uint32_t length = ReadCachedValue<uint32_t>(istream);
+        const uint32_t numComponents = ReadCachedValue<uint32_t>(istream);
+        const int32_t halfFlags = ReadCachedValue<int32_t>(istream);
+        if (length < 2 || (numComponents != 1 && numComponents != 3)
+            || halfFlags < Lut1DOpData::LUT_STANDARD
+            || halfFlags > Lut1DOpData::LUT_INPUT_OUTPUT_HALF_CODE)
+        {
+            throw Exception("Corrupted cached file: invalid 1D LUT.");
+        }
+
+        auto lut = std::make_shared<Lut1DOpData>(Lut1DOpData::HalfFlags(halfFlags), length);
+        lut->setHueAdjust(LUT1DHueAdjust(ReadCachedValue<int32_t>(istream)));
+        lut->setInterpolation(Interpolation(ReadCachedValue<int32_t>(istream)));
+        lut->setInversionQuality(LutInversionQuality(ReadCachedValue<int32_t>(istream)));
+        lut->setFileOutputBitDepth(BitDepth(ReadCachedValue<int32_t>(istream)));
+        ReadCachedMetadata(istream, lut->getFormatMetadata());
+
+        Array & array = lut->getArray();
+        array.resize(length, numComponents);
+        ReadCachedValues(istream, array.getValues());
+
+        return lut;
+    }
+
+    void WriteCachedLut3D(std::ostream & ostream, const ConstLut3DOpDataRcPtr & lut)
+    {
+        WriteCachedValue(ostream, uint8_t(lut ? 1 : 0));
+        if (!lut)
+        {
+            return;
+        }
+
+        if (lut->getDirection() != TRANSFORM_DIR_FORWARD)
+        {
+            throw Exception("Only the forward LUTs can be cached.");
+        }
+
+        WriteCachedValue(ostream, uint32_t(lut->getGridSize()));
+        WriteCachedValue(ostream, int32_t(lut->getInterpolation()));
+        WriteCachedValue(ostream, int32_t(lut->getInversionQuality()));
+        WriteCachedValue(ostream, int32_t(lut->getFileOutputBitDepth()));
+        WriteCachedMetadata(ostream, lut->getFormatMetadata());
+        WriteCachedValues(ostream, lut->getArray().getValues());
+    }
+
+    Lut3DOpDataRcPtr ReadCachedLut3D(std::istream & istream)
+    {
+        if (ReadCachedValue<uint8_t>(istream) == 0)
+        {
+            return Lut3DOpDataRcPtr();
+        }
+
+        const uint32_t gridSize = ReadCachedValue<uint32_t>(istream);
+        if (gridSize < 2 || gridSize > 129)
+        {
+            throw Exception("Corrupted cached file: invalid 3D LUT.");
+        }
+
+        auto lut = std::make_shared<Lut3DOpData>((unsigned long)gridSize);
+        lut->setInterpolation(Interpolation(ReadCachedValue<int32_t>(istream)));
+        lut->setInversionQuality(LutInversionQuality(ReadCachedValue<int32_t>(istream)));
+        lut->setFileOutputBitDepth(BitDepth(ReadCachedValue<int32_t>(istream)));
+        ReadCachedMetadata(istream, lut->getFormatMetadata());
+        ReadCachedValues(istream, lut->getArray().getValues());
+
+        return lut;
+    }
+
+    void WriteCachedCDL(std::ostream & ostream, const ConstCDLTransformRcPtr & cdl)
+    {
+        std::array<double, 9> sop;
+        cdl->getSOP(sop.data());
+
+        WriteCachedValue(ostream, int32_t(cdl->getDirection()));
+        WriteCachedValue(ostream, sop);
+        WriteCachedValue(ostream, cdl->getSat());
+        WriteCachedString(ostream, cdl->getID());
+        WriteCachedMetadata(ostream, cdl->getFormatMetadata());
+    }
+
+    void ReadCachedCDL(std::istream & istream, CDLTransformRcPtr & cdl)
+    {
+        cdl->setDirection(TransformDirection(ReadCachedValue<int32_t>(istream)));
+
+        const auto sop = ReadCachedValue<std::array<double, 9>>(istream);
+        cdl->setSOP(sop.data());
+        cdl->setSat(ReadCachedValue<double>(istream));
+
+        const std::string id = ReadCachedString(istream);
+        ReadCachedMetadata(istream, cdl->getFormatMetadata());
+        cdl->setID(id.c_str());
+    }
+
+    namespace
+    {
+
+        // Stream buffer reading a memory buffer (e.g. a mapped file) without copying it.
+        class MemoryStreamBuf : public std::streambuf
+        {
+        public:
+            MemoryStreamBuf(const char * data, size_t size)
+            {
+                // The get area is never written.
+                char * begin = const_cast<char *>(data);
+                setg(begin, begin, begin + size);
+            }
+
+        protected:
+            pos_type seekoff(off_type off,
+                             std::ios_base::seekdir dir,
+                             std::ios_base::openmode which) override
+            {
+                if(!(which & std::ios_base::in))
+                {
+                    return pos_type(off_type(-1));
+                }
+
+                const off_type size = egptr() - eback();
+                const off_type pos
+                    = dir == std::ios_base::beg ? off
+                    : dir == std::ios_base::cur ? (gptr() - eback()) + off
+                                                : size + off;
+                if(pos < 0 || pos > size)
+                {
+                    return pos_type(off_type(-1));
+                }
+
+                setg(eback(), eback() + pos, egptr());
+                return pos_type(pos);
+            }
+
+            pos_type seekpos(pos_type pos, std::ios_base::openmode which) override
+            {
+                return seekoff(off_type(pos), std::ios_base::beg, which);
+            }
+        };
+
+        // A format able to read a file (refer to GetFormatCandidates()).
+        struct FormatCandidate
+        {
+            FileFormat * format;
+            int confidence;
+            bool primary; // Is the format registered for the file extension?
+        };
+
+        // Get the formats to try to read a file, from the most confident ones.
+        //
+        // The formats registered for the extension are always tried (i.e. to report
+        // their errors) whereas all other formats are only tried when their probe
+        // does not reject the file. The primary formats come first for the same
+        // confidence.
+        void GetFormatCandidates(const std::string & filepath,
+                                 const Platform::MappedFile & mappedFile,
+                                 std::vector<FormatCandidate> & candidates)
+        {
+            // The first bytes of the file are used to rank the formats.
+            std::string header;
+            if(mappedFile.data())
+            {
+                header.assign(mappedFile.data(),
+                              std::min(mappedFile.size(), FORMAT_PROBE_SIZE));
+            }
+            else
+            {
+                std::ifstream filestream(filepath.c_str(), std::ios_base::binary);
+                char buffer[FORMAT_PROBE_SIZE];
+                filestream.read(buffer, FORMAT_PROBE_SIZE);
+                header.assign(buffer, size_t(filestream.gcount()));
+            }
+
             std::string root, extension;
             pystring::os::path::splitext(root, extension, filepath);
             // remove the leading '.'
@@ -465,134 +869,332 @@ OCIO_NAMESPACE_ENTER
             FileFormatVector possibleFormats;
             formatRegistry.getFileFormatForExtension(
                 extension, possibleFormats);
-            FileFormatVector::const_iterator endFormat = possibleFormats.end();
-            FileFormatVector::const_iterator itFormat =
-                possibleFormats.begin();
-            while(itFormat != endFormat)
+
+            candidates.clear();
+            for(auto format : possibleFormats)
             {
+                candidates.push_back({ format, format->probe(header), true });
+            }
 
-                FileFormat * tryFormat = *itFormat;
-                std::ifstream filestream;
-                try
+            for(int findex = 0;
+                findex<formatRegistry.getNumRawFormats();
+                ++findex)
+            {
+                FileFormat * altFormat = formatRegistry.getRawFormatByIndex(findex);
+                
+                // Do not try primary formats twice.
+                if(std::find(possibleFormats.begin(), possibleFormats.end(), altFormat)
+                        != possibleFormats.end())
+                    continue;
+
+                const int confidence = altFormat->probe(header);
+                if(confidence != FORMAT_PROBE_NO)
                 {
-                    // Open the filePath
-                    filestream.open(
-                        filepath.c_str(),
-                        tryFormat->isBinary()
-                            ? std::ios_base::binary : std::ios_base::in);
-                    if (!filestream.good())
-                    {
-                        std::ostringstream os;
-                        os << "The specified FileTransform srcfile, '";
-                        os << filepath << "', could not be opened. ";
-                        os << "Please confirm the file exists with ";
-                        os << "appropriate read permissions.";
-                        throw Exception(os.str().c_str());
-                    }
+                    candidates.push_back({ altFormat, confidence, false });
+                }
+            }
 
-                    CachedFileRcPtr cachedFile = tryFormat->read(
-                        filestream,
-                        filepath);
-                    
-                    if(IsDebugLoggingEnabled())
-                    {
-                        std::ostringstream os;
-                        os << "    Loaded primary format ";
-                        os << tryFormat->getName();
-                        LogDebug(os.str());
-                    }
-                    
-                    returnFormat = tryFormat;
-                    returnCachedFile = cachedFile;
-                    filestream.close();
+            std::stable_sort(candidates.begin(), candidates.end(),
+                             [](const FormatCandidate & a, const FormatCandidate & b)
+                             {
+                                 return a.confidence > b.confidence;
+                             });
+        }
+
+        // Read the file with the format, directly from the file memory mapping when
+        // available (i.e. instead of copying the file through a file stream).
+        void ReadFileStream(const FileFormat * format,
+                            const std::string & filepath,
+                            const Platform::MappedFile & mappedFile,
+                            const std::function<void(std::istream &)> & reader)
+        {
+#ifdef _WIN32
+            // The text mode of the file streams converts the line endings.
+            const bool useMapping = mappedFile.data() && format->isBinary();
+#else
+            const bool useMapping = mappedFile.data() != nullptr;
+#endif
+            if(useMapping)
+            {
+                MemoryStreamBuf buffer(mappedFile.data(), mappedFile.size());
+                std::istream istream(&buffer);
+                reader(istream);
+                return;
+            }
+
+            std::ifstream filestream;
+            filestream.open(filepath.c_str(), format->isBinary()
+                ? std::ios_base::binary : std::ios_base::in);
+            if (!filestream.good())
+            {
+                std::ostringstream os;
+                os << "The specified FileTransform srcfile, '";
+                os << filepath << "', could not be opened. ";
+                os << "Please confirm the file exists with ";
+                os << "appropriate read permissions.";
+                throw Exception(os.str().c_str());
+            }
+
+            reader(filestream);
+        }
+
+        CachedFileRcPtr ReadFile(const FileFormat * format,
+                                 const std::string & filepath,
+                                 const Platform::MappedFile & mappedFile)
+        {
+            CachedFileRcPtr cachedFile;
+            ReadFileStream(format, filepath, mappedFile, [&](std::istream & istream)
+            {
+                cachedFile = format->read(istream, filepath);
+            });
+            return cachedFile;
+        }
+
+        const char * OCIO_FILE_CACHE_DIR_ENVVAR = "OCIO_FILE_CACHE_DIR";
+
+        std::string InitFileDiskCacheDir()
+        {
+            std::string dir;
+            Platform::Getenv(OCIO_FILE_CACHE_DIR_ENVVAR, dir);
+            return dir;
+        }
+
+        // The directory of the file disk cache (refer to SetFileDiskCacheDir()).
+        std::string g_fileDiskCacheDir = InitFileDiskCacheDir();
+        Mutex g_fileDiskCacheDirMutex;
+
+        // The file disk cache files start with the magic number, the layout version,
+        // the key (i.e. to detect the hash collisions) and the format name followed
+        // by the cached file written by the format.
+        const char FILE_DISK_CACHE_MAGIC[8] = { 'O', 'C', 'I', 'O', 'L', 'U', 'T', 'C' };
+        const uint32_t FILE_DISK_CACHE_VERSION = 1;
+
+        // Get the key identifying the file content (i.e. its path and its fast hash)
+        // and the name of its disk cache file. Return false if the disk cache is
+        // disabled or the file is missing.
+        bool GetFileDiskCacheKey(const std::string & filepath,
+                                 std::string & key,
+                                 std::string & filename)
+        {
+            std::string dir;
+            {
+                AutoMutex lock(g_fileDiskCacheDirMutex);
+                dir = g_fileDiskCacheDir;
+            }
+
+            if(dir.empty())
+            {
+                return false;
+            }
+
+            const std::string hash = GetFastFileHash(filepath);
+            if(hash.empty())
+            {
+                return false;
+            }
+
+            key = filepath + "\n" + hash + "\n" + GetVersion();
+
+            // Skip the '$' prefix of the hash.
+            filename = dir + "/" + CacheIDHash(key.c_str(), key.size()).substr(1) + ".ociolut";
+            return true;
+        }
+
+        bool ReadFileDiskCache(std::istream & istream,
+                               const std::string & key,
+                               const std::string & filename,
+                               FileFormat * & format,
+                               CachedFileRcPtr & cachedFile)
+        {
+            try
+            {
+                char magic[sizeof(FILE_DISK_CACHE_MAGIC)];
+                if(!istream.read(magic, sizeof(magic))
+                    || memcmp(magic, FILE_DISK_CACHE_MAGIC, sizeof(magic)) != 0)
+                {
+                    throw Exception("Not a file disk cache file.");
+                }
+
+                if(ReadCachedValue<uint32_t>(istream) != FILE_DISK_CACHE_VERSION)
+                {
+                    throw Exception("Unsupported layout version.");
+                }
+
+                if(ReadCachedString(istream) != key)
+                {
+                    throw Exception("The file is for another LUT file.");
+                }
+
+                const std::string formatName = ReadCachedString(istream);
+                FileFormat * cachedFormat
+                    = FormatRegistry::GetInstance().getFileFormatByName(formatName);
+                if(!cachedFormat)
+                {
+                    throw Exception("Unknown file format.");
+                }
+
+                cachedFile = cachedFormat->readCachedFile(istream);
+                format = cachedFormat;
+                return true;
+            }
+            catch(std::exception & e)
+            {
+                OCIO_LOG_DEBUG("Could not read the file cache file '" << filename << "': "
+                               << e.what());
+            }
+
+            return false;
+        }
+
+        bool LoadFromFileDiskCache(const std::string & key,
+                                   const std::string & filename,
+                                   FileFormat * & format,
+                                   CachedFileRcPtr & cachedFile)
+        {
+            Platform::MappedFile mappedFile;
+            if(mappedFile.open(filename))
+            {
+                MemoryStreamBuf buffer(mappedFile.data(), mappedFile.size());
+                std::istream istream(&buffer);
+                return ReadFileDiskCache(istream, key, filename, format, cachedFile);
+            }
+
+            std::ifstream filestream(filename.c_str(), std::ios_base::in | std::ios_base::binary);
+            if(!filestream)
+            {
+                return false;
+            }
+            return ReadFileDiskCache(filestream, key, filename, format, cachedFile);
+        }
+
+        void SaveToFileDiskCache(const std::string & key,
+                                 const std::string & filename,
+                                 const FileFormat * format,
+                                 const CachedFile & cachedFile)
+        {
+            // Write a temporary file renamed once complete so that the concurrent readers
+            // (e.g. other processes sharing the directory) never see a partial file.
+            std::string tmpFilename;
+
+            try
+            {
+                std::ostringstream payload;
+                if(!format->writeCachedFile(cachedFile, payload))
+                {
                     return;
                 }
-                catch(std::exception & e)
+
+                std::ostringstream oss;
+                oss << filename << "." << std::random_device()() << ".tmp";
+                tmpFilename = oss.str();
+
                 {
-                    if (filestream.is_open())
+                    std::ofstream os(tmpFilename.c_str(),
+                                     std::ios_base::out | std::ios_base::binary);
+                    if(!os)
                     {
-                        filestream.close();
+                        throw Exception("Could not open the file.");
                     }
 
-                    primaryErrorText += tryFormat->getName();
-                    primaryErrorText += " failed with: '";
-                    primaryErrorText = e.what();
-                    primaryErrorText += "'.  ";
+                    os.write(FILE_DISK_CACHE_MAGIC, sizeof(FILE_DISK_CACHE_MAGIC));
+                    WriteCachedValue(os, FILE_DISK_CACHE_VERSION);
+                    WriteCachedString(os, key);
+                    WriteCachedString(os, format->getName());
+                    const std::string data = payload.str();
+                    os.write(data.data(), std::streamsize(data.size()));
 
-                    if(IsDebugLoggingEnabled())
+                    os.close();
+                    if(!os)
                     {
-                        std::ostringstream os;
-                        os << "    Failed primary format ";
-                        os << tryFormat->getName();
-                        os << ":  " << e.what();
-                        LogDebug(os.str());
+                        throw Exception("Could not write the file.");
                     }
                 }
-                ++itFormat;
+
+                if(std::rename(tmpFilename.c_str(), filename.c_str()) != 0)
+                {
+                    // Another thread or process could have written it in the meantime.
+                    std::remove(tmpFilename.c_str());
+                }
+            }
+            catch(std::exception & e)
+            {
+                if(!tmpFilename.empty())
+                {
+                    std::remove(tmpFilename.c_str());
+                }
+
+                OCIO_LOG_DEBUG("Could not write the file cache file '" << filename << "': "
+                               << e.what());
             }
+        }
+    
+        // Return false, with the error in errorText, when no format could read the file
+        // i.e. a failing load does not throw.
+        bool LoadFileUncached(FileFormat * & returnFormat,
+            CachedFileRcPtr & returnCachedFile,
+            const std::string & filepath,
+            std::string & errorText)
+        {
+            returnFormat = NULL;
             
-            // If this fails, try all other formats
-            CachedFileRcPtr cachedFile;
-            FileFormat * altFormat = NULL;
+            OCIO_LOG_DEBUG("Opening " << filepath);
+
+            // Try the file disk cache first.
+            std::string diskCacheKey, diskCacheFilename;
+            const bool useDiskCache
+                = GetFileDiskCacheKey(filepath, diskCacheKey, diskCacheFilename);
+            if(useDiskCache && LoadFromFileDiskCache(diskCacheKey, diskCacheFilename,
+                                                     returnFormat, returnCachedFile))
+            {
+                OCIO_LOG_DEBUG("    Loaded from the file disk cache " << returnFormat->getName());
+                return true;
+            }
+
+            // The file is mapped once for all the formats to try.
+            Platform::MappedFile mappedFile;
+            mappedFile.open(filepath);
             
-            for(int findex = 0;
-                findex<formatRegistry.getNumRawFormats();
-                ++findex)
+            std::vector<FormatCandidate> candidates;
+            GetFormatCandidates(filepath, mappedFile, candidates);
+
+            std::string primaryErrorText;
+            bool hasPrimaryFormat = false;
+
+            for(const auto & candidate : candidates)
             {
-                altFormat = formatRegistry.getRawFormatByIndex(findex);
-                
-                // Do not try primary formats twice.
-                FileFormatVector::const_iterator itAlt = std::find(
-                    possibleFormats.begin(), possibleFormats.end(), altFormat);
-                if(itAlt != endFormat)
-                    continue;
-                
-                std::ifstream filestream;
+                FileFormat * tryFormat = candidate.format;
                 try
                 {
-                    filestream.open(filepath.c_str(), altFormat->isBinary()
-                        ? std::ios_base::binary : std::ios_base::in);
-                    if (!filestream.good())
-                    {
-                        std::ostringstream os;
-                        os << "The specified FileTransform srcfile, '";
-                        os << filepath << "', could not be opened. ";
-                        os << "Please confirm the file exists with ";
-                        os << "appropriate read";
-                        os << " permissions.";
-                        throw Exception(os.str().c_str());
-                    }
-
-                    cachedFile = altFormat->read(filestream, filepath);
+                    CachedFileRcPtr cachedFile = ReadFile(tryFormat, filepath, mappedFile);
+                    
+                    OCIO_LOG_DEBUG((candidate.primary ? "    Loaded primary format "
+                                                      : "    Loaded alt format ")
+                                   << tryFormat->getName());
                     
-                    if(IsDebugLoggingEnabled())
+                    if(useDiskCache)
                     {
-                        std::ostringstream os;
-                        os << "    Loaded alt format ";
-                        os << altFormat->getName();
-                        LogDebug(os.str());
+                        SaveToFileDiskCache(diskCacheKey, diskCacheFilename,
+                                            tryFormat, *cachedFile);
                     }
-                    
-                    returnFormat = altFormat;
+
+                    returnFormat = tryFormat;
                     returnCachedFile = cachedFile;
-                    filestream.close();
-                    return;
+                    return true;
                 }
                 catch(std::exception & e)
                 {
-                    if (filestream.is_open())
+                    if(candidate.primary)
                     {
-                        filestream.close();
+                        hasPrimaryFormat = true;
+                        primaryErrorText += tryFormat->getName();
+                        primaryErrorText += " failed with: '";
+                        primaryErrorText = e.what();
+                        primaryErrorText += "'.  ";
                     }
 
-                    if(IsDebugLoggingEnabled())
-                    {
-                        std::ostringstream os;
-                        os << "    Failed alt format ";
-                        os << altFormat->getName();
-                        os << ":  " << e.what();
-                        LogDebug(os.str());
-                    }
+                    OCIO_LOG_DEBUG((candidate.primary ? "    Failed primary format "
+                                                      : "    Failed alt format ")
+                                   << tryFormat->getName() << ":  " << e.what());
                 }
             }
             
@@ -610,7 +1212,7 @@ OCIO_NAMESPACE_ENTER
                 os << "(Enable debug log for errors from all formats). ";
             }
 
-            if(!possibleFormats.empty())
+            if(hasPrimaryFormat)
             {
                 os << "All formats have been tried including ";
                 os << "formats registered for the given extension. ";
@@ -618,7 +1220,8 @@ OCIO_NAMESPACE_ENTER
                 os << primaryErrorText;
             }
 
-            throw Exception(os.str().c_str());
+            errorText = os.str();
+            return false;
         }
         
         // We mutex both the main map and each item individually, so that
@@ -642,32 +1245,229 @@ OCIO_NAMESPACE_ENTER
         };
         
         typedef OCIO_SHARED_PTR<FileCacheResult> FileCacheResultPtr;
-        typedef std::map<std::string, FileCacheResultPtr> FileCacheMap;
-        
-        FileCacheMap g_fileCache;
-        Mutex g_fileCacheLock;
-        
-    } // namespace
 
-    void GetCachedFileAndFormat(FileFormat * & format,
-                                CachedFileRcPtr & cachedFile,
-                                const std::string & filepath)
-    {
-        // Load the file cache ptr from the global map
-        FileCacheResultPtr result;
+        // The maximum number of bytes held by the file cache (refer to SetFileCacheMemoryBudget()).
+        std::atomic<size_t> g_fileCacheMemoryBudget{ 512 * 1024 * 1024 };
+        // The number of bytes held by the loaded files of all the shards.
+        std::atomic<size_t> g_fileCacheMemoryUsage{ 0 };
+
+        // The file cache is split in several shards (selected from the file path) each
+        // having its own mutex so concurrent lookups of different files rarely contend.
+        // Each shard gets an equal part of the memory budget and, when over it, removes
+        // its least recently used files.
+        class FileCacheShard
         {
-            AutoMutex lock(g_fileCacheLock);
-            FileCacheMap::iterator iter = g_fileCache.find(filepath);
-            if (iter != g_fileCache.end())
+        public:
+            static constexpr size_t NUM_SHARDS = 16;
+
+            FileCacheShard() = default;
+            FileCacheShard(const FileCacheShard &) = delete;
+            FileCacheShard & operator=(const FileCacheShard &) = delete;
+
+            // Get the cache entry of the file (i.e. creating it when missing). When not
+            // empty, the file hash (refer to GetFastFileHash()) replaces the entry of a
+            // file changed since its loading.
+            FileCacheResultPtr get(const std::string & filepath, const std::string & fileHash)
+            {
+                CacheStatistics & statistics = GetCacheStatistics(CACHE_FILE);
+                AutoTimedMutex lock(m_mutex, statistics);
+
+                Index::iterator iter = m_index.find(filepath);
+                if (iter != m_index.end())
+                {
+                    Entry & entry = *iter->second;
+                    if (entry.m_fileHash.empty())
+                    {
+                        // The file was loaded when the files were not checked.
+                        entry.m_fileHash = fileHash;
+                    }
+
+                    if (fileHash.empty() || entry.m_fileHash == fileHash)
+                    {
+                        // It is now the most recently used file.
+                        m_entries.splice(m_entries.begin(), m_entries, iter->second);
+                        statistics.addHit();
+                        return entry.m_result;
+                    }
+
+                    // The file changed so its entry is replaced.
+                    m_numBytes -= entry.m_numBytes;
+                    g_fileCacheMemoryUsage -= entry.m_numBytes;
+                    m_entries.erase(iter->second);
+                    m_index.erase(iter);
+                    statistics.addEvictions(1);
+                }
+
+                statistics.addMiss();
+                statistics.addInsertion();
+
+                FileCacheResultPtr result = std::make_shared<FileCacheResult>();
+                m_entries.emplace_front(filepath, fileHash, result);
+                m_index[filepath] = m_entries.begin();
+                return result;
+            }
+
+            // Account for the memory of a loaded file, and then trim the shard
+            // to its part of the budget.
+            void setLoaded(const std::string & filepath, const FileCacheResultPtr & result)
+            {
+                const size_t numBytes = result->cachedFile ? result->cachedFile->getMemorySize()
+                                                           : sizeof(FileCacheResult);
+
+                AutoTimedMutex lock(m_mutex, GetCacheStatistics(CACHE_FILE));
+
+                // The file could have been removed from the cache during the loading.
+                Index::iterator iter = m_index.find(filepath);
+                if (iter == m_index.end() || iter->second->m_result != result)
+                {
+                    return;
+                }
+
+                iter->second->m_numBytes = numBytes;
+                m_numBytes += numBytes;
+                g_fileCacheMemoryUsage += numBytes;
+
+                trimEntries();
+            }
+
+            // Remove the least recently used files until the shard fits in its part of the
+            // budget, but always keep the most recently used one.
+            void trim()
             {
-                result = iter->second;
+                AutoMutex lock(m_mutex);
+                trimEntries();
             }
-            else
+
+            void clear()
+            {
+                AutoMutex lock(m_mutex);
+                m_entries.clear();
+                m_index.clear();
+                g_fileCacheMemoryUsage -= m_numBytes;
+                m_numBytes = 0;
+            }
+
+        private:
+            void trimEntries()
             {
-                result = FileCacheResultPtr(new FileCacheResult);
-                g_fileCache[filepath] = result;
+                const size_t budget = g_fileCacheMemoryBudget / NUM_SHARDS;
+                size_t numEvictions = 0;
+                while (m_numBytes > budget && m_entries.size() > 1)
+                {
+                    const Entry & entry = m_entries.back();
+                    m_numBytes -= entry.m_numBytes;
+                    g_fileCacheMemoryUsage -= entry.m_numBytes;
+                    m_index.erase(entry.m_filepath);
+                    m_entries.pop_back();
+                    ++numEvictions;
+                }
+                GetCacheStatistics(CACHE_FILE).addEvictions(numEvictions);
             }
+
+            struct Entry
+            {
+                Entry(const std::string & filepath, const std::string & fileHash,
+                      const FileCacheResultPtr & result)
+                    :   m_filepath(filepath)
+                    ,   m_fileHash(fileHash)
+                    ,   m_result(result)
+                {}
+
+                std::string        m_filepath;
+                std::string        m_fileHash; // Empty if the file is not checked.
+                FileCacheResultPtr m_result;
+                size_t             m_numBytes = 0; // Zero until the file is loaded.
+            };
+
+            typedef std::list<Entry> Entries;
+            typedef std::unordered_map<std::string, Entries::iterator> Index;
+
+            Entries m_entries; // The most recently used file first.
+            Index   m_index;
+            size_t  m_numBytes = 0;
+            Mutex   m_mutex;
+        };
+
+        FileCacheShard g_fileCache[FileCacheShard::NUM_SHARDS];
+
+        FileCacheShard & GetFileCacheShard(const std::string & filepath)
+        {
+            return g_fileCache[std::hash<std::string>()(filepath) % FileCacheShard::NUM_SHARDS];
+        }
+        
+    } // namespace
+
+    void SetFileCacheMemoryBudget(size_t numBytes)
+    {
+        g_fileCacheMemoryBudget = numBytes;
+
+        for (auto & shard : g_fileCache)
+        {
+            shard.trim();
+        }
+    }
+
+    size_t GetFileCacheMemoryBudget()
+    {
+        return g_fileCacheMemoryBudget;
+    }
+
+    size_t GetFileCacheMemoryUsage()
+    {
+        return g_fileCacheMemoryUsage;
+    }
+
+    void SetFileDiskCacheDir(const char * dir)
+    {
+        AutoMutex lock(g_fileDiskCacheDirMutex);
+        g_fileDiskCacheDir = dir ? dir : "";
+    }
+
+    const char * GetFileDiskCacheDir()
+    {
+        AutoMutex lock(g_fileDiskCacheDirMutex);
+        return g_fileDiskCacheDir.c_str();
+    }
+
+    size_t GetOpDataMemorySize(const ConstOpDataRcPtr & data)
+    {
+        if (!data)
+        {
+            return 0;
+        }
+
+        if (auto lut = DynamicPtrCast<const Lut1DOpData>(data))
+        {
+            return sizeof(Lut1DOpData)
+                + lut->getArray().getValues().capacity() * sizeof(float);
         }
+        else if (auto lut = DynamicPtrCast<const Lut3DOpData>(data))
+        {
+            return sizeof(Lut3DOpData)
+                + lut->getArray().getValues().capacity() * sizeof(float);
+        }
+
+        // The other op data only hold a few parameters.
+        return sizeof(OpData);
+    }
+
+    // Same as GetCachedFileAndFormat() but return false, with the error in errorText,
+    // when the file fails to load.
+    bool TryGetCachedFileAndFormat(FileFormat * & format,
+                                   CachedFileRcPtr & cachedFile,
+                                   const std::string & filepath,
+                                   std::string & errorText)
+    {
+        TracingSpan span("file", filepath);
+
+        // When the files are checked (refer to SetFileCacheCheckInterval()), a file
+        // changed since its loading is loaded again.
+        const std::string fileHash
+            = GetFileCacheCheckInterval() != 0 ? GetFastFileHash(filepath) : "";
+
+        // Load the file cache ptr from its shard.
+        FileCacheShard & shard = GetFileCacheShard(filepath);
+        FileCacheResultPtr result = shard.get(filepath, fileHash);
 
         // If this file has already been loaded, return
         // the result immediately
@@ -680,9 +1480,10 @@ OCIO_NAMESPACE_ENTER
 
             try
             {
-                LoadFileUncached(result->format,
-                    result->cachedFile,
-                    filepath);
+                result->error = !LoadFileUncached(result->format,
+                                                  result->cachedFile,
+                                                  filepath,
+                                                  result->exceptionText);
             }
             catch (std::exception & e)
             {
@@ -697,11 +1498,14 @@ OCIO_NAMESPACE_ENTER
                 os << filepath;
                 result->exceptionText = os.str();
             }
+
+            shard.setLoaded(filepath, result);
         }
 
         if (result->error)
         {
-            throw Exception(result->exceptionText.c_str());
+            errorText = result->exceptionText;
+            return false;
         }
         else
         {
@@ -715,7 +1519,8 @@ OCIO_NAMESPACE_ENTER
             os << "The specified file load ";
             os << filepath << " appeared to succeed, but no format ";
             os << "was returned.";
-            throw Exception(os.str().c_str());
+            errorText = os.str();
+            return false;
         }
 
         if (!cachedFile.get())
@@ -724,14 +1529,93 @@ OCIO_NAMESPACE_ENTER
             os << "The specified file load ";
             os << filepath << " appeared to succeed, but no cachedFile ";
             os << "was returned.";
-            throw Exception(os.str().c_str());
+            errorText = os.str();
+            return false;
+        }
+
+        return true;
+    }
+
+    void GetCachedFileAndFormat(FileFormat * & format,
+                                CachedFileRcPtr & cachedFile,
+                                const std::string & filepath)
+    {
+        std::string errorText;
+        if (!TryGetCachedFileAndFormat(format, cachedFile, filepath, errorText))
+        {
+            throw Exception(errorText.c_str());
+        }
+    }
+
+    bool TryLoadFile(const std::string & filepath, std::string & errorText)
+    {
+        FileFormat * format = nullptr;
+        CachedFileRcPtr cachedFile;
+        return TryGetCachedFileAndFormat(format, cachedFile, filepath, errorText);
+    }
+
+    bool ReadFileHeader(const std::string & filepath, FileHeader & header)
+    {
+        Platform::MappedFile mappedFile;
+        mappedFile.open(filepath);
+
+        std::vector<FormatCandidate> candidates;
+        GetFormatCandidates(filepath, mappedFile, candidates);
+
+        for(const auto & candidate : candidates)
+        {
+            try
+            {
+                bool supported = false;
+                FileHeader fileHeader;
+                ReadFileStream(candidate.format, filepath, mappedFile,
+                               [&](std::istream & istream)
+                {
+                    supported = candidate.format->readHeader(istream, filepath, fileHeader);
+                });
+
+                if(supported)
+                {
+                    header = fileHeader;
+                    return true;
+                }
+            }
+            catch(std::exception & e)
+            {
+                OCIO_LOG_DEBUG("    Failed header of format " << candidate.format->getName()
+                               << ":  " << e.what());
+            }
+        }
+
+        return false;
+    }
+
+    bool GetFileLutDimensions(const char * filepath,
+                              unsigned & lut1DSize,
+                              unsigned & lut3DSize)
+    {
+        if(!filepath || !*filepath)
+        {
+            throw Exception("The file path is empty.");
+        }
+
+        FileHeader header;
+        if(!ReadFileHeader(filepath, header))
+        {
+            return false;
         }
+
+        lut1DSize = static_cast<unsigned>(header.lut1DSize);
+        lut3DSize = static_cast<unsigned>(header.lut3DSize);
+        return true;
     }
 
     void ClearFileTransformCaches()
     {
-        AutoMutex lock(g_fileCacheLock);
-        g_fileCache.clear();
+        for (auto & shard : g_fileCache)
+        {
+            shard.clear();
+        }
     }
     
     void BuildFileTransformOps(OpRcPtrVec & ops,
@@ -10,6 +10,8 @@
 #include <OpenColorIO/OpenColorIO.h>
 
 #include "Op.h"
+#include "ops/Lut1D/Lut1DOpData.h"
+#include "ops/Lut3D/Lut3DOpData.h"
 #include "ops/NoOp/NoOps.h"
 #include "PrivateTypes.h"
 #include "Processor.h"
@@ -17,15 +19,43 @@
 OCIO_NAMESPACE_ENTER
 {
     void ClearFileTransformCaches();
+
+    // Get the number of bytes held by the file cache (refer to SetFileCacheMemoryBudget()).
+    size_t GetFileCacheMemoryUsage();
+
+    // Load the file in the file cache, if not already loaded. Return false, with the
+    // error in errorText, if the loading fails.
+    bool TryLoadFile(const std::string & filepath, std::string & errorText);
+
+    // Dimensions of the LUTs of a file (i.e. zero when the file has no such LUT).
+    struct FileHeader
+    {
+        unsigned long lut1DSize = 0;
+        unsigned long lut3DSize = 0;
+    };
+
+    // Read the header of the file without reading (nor caching) the LUT values.
+    // Return false if no format able to read the file supports the header-only
+    // reading (refer to FileFormat::readHeader()).
+    bool ReadFileHeader(const std::string & filepath, FileHeader & header);
     
     class CachedFile
     {
     public:
         CachedFile() {};
         virtual ~CachedFile() {};
+
+        // Approximate number of bytes held by the cached file, used to keep the
+        // file cache in its memory budget. The formats holding LUTs must override
+        // it to account for the LUT values.
+        virtual size_t getMemorySize() const { return sizeof(CachedFile); }
     };
     
     typedef OCIO_SHARED_PTR<CachedFile> CachedFileRcPtr;
+
+    // Approximate number of bytes held by an op data (i.e. zero for an empty pointer)
+    // to help computing CachedFile::getMemorySize().
+    size_t GetOpDataMemorySize(const ConstOpDataRcPtr & data);
     
     const int FORMAT_CAPABILITY_NONE = 0;
     const int FORMAT_CAPABILITY_READ = 1;
@@ -45,6 +75,64 @@ OCIO_NAMESPACE_ENTER
     
     typedef std::vector<FormatInfo> FormatInfoVec;
 
+    // Confidence of a format in the first bytes of a file (refer to FileFormat::probe()).
+    const int FORMAT_PROBE_NO      = 0; // The file is not in the format.
+    const int FORMAT_PROBE_UNKNOWN = 1; // The format cannot tell from the first bytes.
+    const int FORMAT_PROBE_LIKELY  = 2; // e.g. keyword specific to the format found.
+    const int FORMAT_PROBE_CERTAIN = 3; // e.g. magic number or XML root element found.
+
+    // Maximum number of first bytes of a file given to FileFormat::probe().
+    const size_t FORMAT_PROBE_SIZE = 4096;
+
+    // Helpers for the probes.
+
+    // Get the first line of the header (i.e. the first non-blank one when
+    // skipBlankLines is true) without its end of line.
+    std::string GetProbeFirstLine(const std::string & header, bool skipBlankLines);
+    // Is the header starting (after an optional UTF-8 BOM) with a XML tag?
+    bool IsProbeXML(const std::string & header);
+    // Does a line of the header start (after whitespaces) with the keyword (i.e. as
+    // a whole word)?
+    // Note that the comparison ignores the case.
+    bool HasProbeKeyword(const std::string & header, const char * keyword);
+
+    // Helpers for the binary serialization of the cached files (refer to
+    // FileFormat::writeCachedFile()). The read functions throw when the data
+    // is truncated or corrupted.
+
+    template<typename T>
+    void WriteCachedValue(std::ostream & ostream, const T & value)
+    {
+        ostream.write(reinterpret_cast<const char *>(&value), sizeof(T));
+    }
+
+    template<typename T>
+    T ReadCachedValue(std::istream & istream)
+    {
+        T value;
+        if (!istream.read(reinterpret_cast<char *>(&value), sizeof(T)))
+        {
+            throw Exception("Truncated cached file.");
+        }
+        return value;
+    }
+
+    void WriteCachedString(std::ostream & ostream, const std::string & str);
+    std::string ReadCachedString(std::istream & istream);
+
+    void WriteCachedMetadata(std::ostream & ostream, const FormatMetadata & metadata);
+    void ReadCachedMetadata(std::istream & istream, FormatMetadata & metadata);
+
+    // Note that the LUT could be empty, and that only the forward LUTs are supported.
+    void WriteCachedLut1D(std::ostream & ostream, const ConstLut1DOpDataRcPtr & lut);
+    Lut1DOpDataRcPtr ReadCachedLut1D(std::istream & istream);
+
+    void WriteCachedLut3D(std::ostream & ostream, const ConstLut3DOpDataRcPtr & lut);
+    Lut3DOpDataRcPtr ReadCachedLut3D(std::istream & istream);
+
+    void WriteCachedCDL(std::ostream & ostream, const ConstCDLTransformRcPtr & cdl);
+    void ReadCachedCDL(std::istream & istream, CDLTransformRcPtr & cdl);
+
     class FileFormat
     {
     public:
@@ -52,12 +140,32 @@ OCIO_NAMESPACE_ENTER
         
         virtual void getFormatInfo(FormatInfoVec & formatInfoVec) const = 0;
         
+        // Cheap check of the first bytes of a file (up to FORMAT_PROBE_SIZE bytes,
+        // the last line being possibly truncated) to rank the formats able to read
+        // it, only the best ones then reading the whole file. Return one of the
+        // FORMAT_PROBE_* values, the default being FORMAT_PROBE_UNKNOWN.
+        virtual int probe(const std::string & header) const;
+
         // read an istream. originalFileName is used by parsers that make use
         // of aspects of the file name as part of the parsing.
         // It may be set to an empty string if not known.
         virtual CachedFileRcPtr read(
             std::istream & istream,
             const std::string & originalFileName) const = 0;
+
+        // Binary serialization of the cached files used by the file disk cache (refer
+        // to SetFileDiskCacheDir()). Only the formats overriding both methods are saved
+        // in the disk cache, the default writeCachedFile() returning false.
+        virtual bool writeCachedFile(const CachedFile & cachedFile,
+                                     std::ostream & ostream) const;
+        virtual CachedFileRcPtr readCachedFile(std::istream & istream) const;
+
+        // Read only the header of a file (i.e. stopping before the LUT values) to get
+        // the LUT dimensions. Throw if the file is not in the format, and return false
+        // if the format does not support the header-only reading (the default).
+        virtual bool readHeader(std::istream & istream,
+                                const std::string & originalFileName,
+                                FileHeader & header) const;
         
         virtual void bake(const Baker & baker,
                           const std::string & formatName,
@@ -87,6 +195,12 @@ OCIO_NAMESPACE_ENTER
         FileFormat& operator= (const FileFormat &);
     };
     
+    // Get the file (and its format) from the file cache, loading it if needed. Throw if
+    // the file fails to load.
+    void GetCachedFileAndFormat(FileFormat * & format,
+                                CachedFileRcPtr & cachedFile,
+                                const std::string & filepath);
+
     typedef std::map<std::string, FileFormat*> FileFormatMap;
     typedef std::vector<FileFormat*> FileFormatVector;
     typedef std::map<std::string, FileFormatVector> FileFormatVectorMap;
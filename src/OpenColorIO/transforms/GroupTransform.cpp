@@ -2,8 +2,13 @@
 // Copyright Contributors to the OpenColorIO Project.
 
 #include <OpenColorIO/OpenColorIO.h>
+#include "Mutex.h"
 #include "OpBuilders.h"
+#include "ops/NoOp/NoOps.h"
+#include "transforms/GroupTransform.h"
 
+#include <atomic>
+#include <map>
 #include <sstream>
 
 OCIO_NAMESPACE_ENTER
@@ -21,6 +26,13 @@ OCIO_NAMESPACE_ENTER
     namespace
     {
         typedef std::vector<TransformRcPtr> TransformRcPtrVec;
+
+        // Incremented to invalidate the op chains cached by all the groups
+        // (refer to ClearGroupOpsCache()).
+        std::atomic<unsigned> g_groupOpsGeneration{ 0 };
+
+        // Maximum number of op chains cached per group (i.e. per config & context).
+        const size_t MAX_GROUP_OPS_CACHE_SIZE = 16;
     }
     
     class GroupTransform::Impl
@@ -34,6 +46,21 @@ OCIO_NAMESPACE_ENTER
             , m_metadata()
         { }
 
+        // The flattened op chains of the group per config cache id (i.e. including the
+        // context) & direction. An empty entry means that the op chain cannot be cached.
+        struct OpsCacheEntry
+        {
+            bool m_cached = false;
+            OpRcPtrVec m_ops;
+            // The processor metadata when the group starts the op list.
+            FormatMetadataImpl m_metadata;
+        };
+        typedef std::map<std::string, OpsCacheEntry> OpsCache;
+
+        mutable OpsCache m_opsCache;
+        mutable unsigned m_opsCacheGeneration = 0;
+        mutable Mutex m_opsCacheMutex;
+
         Impl(const Impl &) = delete;
 
         ~Impl()
@@ -45,6 +72,8 @@ OCIO_NAMESPACE_ENTER
         {
             if (this != &rhs)
             {
+                clearOpsCache();
+
                 dir_ = rhs.dir_;
 
                 vec_.clear();
@@ -67,6 +96,13 @@ OCIO_NAMESPACE_ENTER
             return m_metadata;
         }
 
+        // Any non-const access could modify the group or its children.
+        void clearOpsCache()
+        {
+            AutoMutex lock(m_opsCacheMutex);
+            m_opsCache.clear();
+        }
+
     private:
         FormatMetadataImpl m_metadata;
     };
@@ -111,6 +147,7 @@ OCIO_NAMESPACE_ENTER
     
     void GroupTransform::setDirection(TransformDirection dir)
     {
+        getImpl()->clearOpsCache();
         getImpl()->dir_ = dir;
     }
     
@@ -126,6 +163,7 @@ OCIO_NAMESPACE_ENTER
 
     FormatMetadata & GroupTransform::getFormatMetadata()
     {
+        m_impl->clearOpsCache();
         return m_impl->getFormatMetadata();
     }
 
@@ -160,11 +198,13 @@ OCIO_NAMESPACE_ENTER
             throw Exception(os.str().c_str());
         }
 
+        getImpl()->clearOpsCache();
         return getImpl()->vec_[index];
     }
 
     void GroupTransform::appendTransform(TransformRcPtr transform)
     {
+        getImpl()->clearOpsCache();
         getImpl()->vec_.push_back(transform);
     }
 
@@ -186,38 +226,216 @@ OCIO_NAMESPACE_ENTER
     ///////////////////////////////////////////////////////////////////////////
     
     
-    void BuildGroupOps(OpRcPtrVec & ops,
-                       const Config & config,
-                       const ConstContextRcPtr & context,
-                       const GroupTransform & groupTransform,
-                       TransformDirection dir)
+    class GroupOpsBuilder
     {
-        if (ops.size() == 0)
+    public:
+        // Build the op chain of the group, the nested groups being directly flattened
+        // in the op list.
+        static void BuildUncachedOps(OpRcPtrVec & ops,
+                                     const Config & config,
+                                     const ConstContextRcPtr & context,
+                                     const GroupTransform & groupTransform,
+                                     TransformDirection dir)
         {
-            // If group is the first transform, copy the group metadata.
-            FormatMetadataImpl & processorData = ops.getFormatMetadata();
-            processorData = groupTransform.getFormatMetadata();
+            if (ops.size() == 0)
+            {
+                // If group is the first transform, copy the group metadata.
+                FormatMetadataImpl & processorData = ops.getFormatMetadata();
+                processorData = groupTransform.getFormatMetadata();
+            }
+
+            TransformDirection combinedDir
+                = CombineTransformDirections(dir, groupTransform.getDirection());
+
+            if(combinedDir != TRANSFORM_DIR_FORWARD && combinedDir != TRANSFORM_DIR_INVERSE)
+            {
+                return;
+            }
+
+            const TransformRcPtrVec & children = groupTransform.getImpl()->vec_;
+            const int numChildren = static_cast<int>(children.size());
+            for(int idx=0; idx<numChildren; ++idx)
+            {
+                const TransformRcPtr & childTransform
+                    = children[combinedDir == TRANSFORM_DIR_FORWARD ? idx
+                                                                    : numChildren - 1 - idx];
+
+                if(const GroupTransform * childGroup
+                    = dynamic_cast<const GroupTransform *>(childTransform.get()))
+                {
+                    BuildUncachedOps(ops, config, context, *childGroup, combinedDir);
+                }
+                else
+                {
+                    BuildOps(ops, config, context, childTransform, combinedDir);
+                }
+            }
         }
 
-        TransformDirection combinedDir
-            = CombineTransformDirections(dir, groupTransform.getDirection());
-        
-        if(combinedDir == TRANSFORM_DIR_FORWARD)
+        // The children only held by the group (i.e. recursively) can only change through
+        // the non-const methods of the group which clear its cache.
+        static bool HasOwnedChildren(const GroupTransform & groupTransform)
         {
-            for(int i=0; i<groupTransform.getNumTransforms(); ++i)
+            for(const auto & childTransform : groupTransform.getImpl()->vec_)
             {
-                ConstTransformRcPtr childTransform = groupTransform.getTransform(i);
-                BuildOps(ops, config, context, childTransform, TRANSFORM_DIR_FORWARD);
+                if(!childTransform || childTransform.use_count() != 1)
+                {
+                    return false;
+                }
+
+                if(const GroupTransform * childGroup
+                    = dynamic_cast<const GroupTransform *>(childTransform.get()))
+                {
+                    if(!HasOwnedChildren(*childGroup))
+                    {
+                        return false;
+                    }
+                }
             }
+            return true;
         }
-        else if(combinedDir == TRANSFORM_DIR_INVERSE)
+
+        static void BuildCachedOps(OpRcPtrVec & ops,
+                                   const Config & config,
+                                   const ConstContextRcPtr & context,
+                                   const GroupTransform & groupTransform,
+                                   TransformDirection dir)
         {
-            for(int i=groupTransform.getNumTransforms()-1; i>=0; --i)
+            std::string key;
+            if(HasOwnedChildren(groupTransform))
+            {
+                try
+                {
+                    std::ostringstream oss;
+                    oss << config.getCacheID(context) << " " << TransformDirectionToString(dir);
+                    key = oss.str();
+                }
+                catch(const Exception &)
+                {
+                    key.clear();
+                }
+            }
+
+            if(key.empty())
+            {
+                BuildUncachedOps(ops, config, context, groupTransform, dir);
+                return;
+            }
+
+            const GroupTransform::Impl * impl = groupTransform.getImpl();
+
+            {
+                AutoMutex lock(impl->m_opsCacheMutex);
+
+                const unsigned generation = g_groupOpsGeneration;
+                if(impl->m_opsCacheGeneration != generation)
+                {
+                    impl->m_opsCache.clear();
+                    impl->m_opsCacheGeneration = generation;
+                }
+
+                GroupTransform::Impl::OpsCache::const_iterator iter = impl->m_opsCache.find(key);
+                if(iter != impl->m_opsCache.end())
+                {
+                    if(iter->second.m_cached)
+                    {
+                        if(ops.size() == 0)
+                        {
+                            ops.getFormatMetadata() = iter->second.m_metadata;
+                        }
+                        ops += iter->second.m_ops;
+                        return;
+                    }
+
+                    BuildUncachedOps(ops, config, context, groupTransform, dir);
+                    return;
+                }
+            }
+
+            // Note that the lock is not held while building the ops as they could be long
+            // to build (e.g. loading the files).
+
+            GroupTransform::Impl::OpsCacheEntry entry;
+
+            // As in the color space op chains, the op chain never starts the list so the
+            // metadata only holds the ones added by the children (e.g. from a CLF file).
+            // These op chains are not cached as the metadata are then combined.
+            OpRcPtrVec newOps;
+            CreateGpuAllocationNoOp(newOps, AllocationData());
+            BuildUncachedOps(newOps, config, context, groupTransform, dir);
+            newOps.erase(newOps.begin());
+
+            const FormatMetadataImpl & metadata = newOps.getFormatMetadata();
+            entry.m_cached = metadata.getNumAttributes() == 0
+                             && metadata.getNumChildrenElements() == 0
+                             && *metadata.getValue() == 0;
+
+            if(entry.m_cached)
+            {
+                FinalizeOpVec(newOps, FINALIZATION_EXACT);
+
+                // The dynamic properties are unified per processor so the dynamic ops are
+                // never shared.
+                for(const auto & op : newOps)
+                {
+                    if(op->isDynamic())
+                    {
+                        entry.m_cached = false;
+                        break;
+                    }
+                }
+            }
+
+            if(entry.m_cached)
             {
-                ConstTransformRcPtr childTransform = groupTransform.getTransform(i);
-                BuildOps(ops, config, context, childTransform, TRANSFORM_DIR_INVERSE);
+                for(auto & op : newOps)
+                {
+                    op->setShared();
+                }
+                entry.m_ops = newOps;
+
+                // The metadata copied by the (nested) groups starting the op list.
+                OpRcPtrVec leadingOps;
+                BuildUncachedOps(leadingOps, config, context, groupTransform, dir);
+                entry.m_metadata = leadingOps.getFormatMetadata();
             }
+
+            {
+                AutoMutex lock(impl->m_opsCacheMutex);
+
+                if(impl->m_opsCache.size() >= MAX_GROUP_OPS_CACHE_SIZE)
+                {
+                    impl->m_opsCache.clear();
+                }
+                impl->m_opsCache[key] = entry;
+            }
+
+            if(!entry.m_cached)
+            {
+                BuildUncachedOps(ops, config, context, groupTransform, dir);
+                return;
+            }
+
+            if(ops.size() == 0)
+            {
+                ops.getFormatMetadata() = entry.m_metadata;
+            }
+            ops += entry.m_ops;
         }
+    };
+
+    void BuildGroupOps(OpRcPtrVec & ops,
+                       const Config & config,
+                       const ConstContextRcPtr & context,
+                       const GroupTransform & groupTransform,
+                       TransformDirection dir)
+    {
+        GroupOpsBuilder::BuildCachedOps(ops, config, context, groupTransform, dir);
+    }
+
+    void ClearGroupOpsCache()
+    {
+        ++g_groupOpsGeneration;
     }
 
 }
@@ -228,6 +446,7 @@ OCIO_NAMESPACE_EXIT
 #ifdef OCIO_UNIT_TEST
 
 namespace OCIO = OCIO_NAMESPACE;
+#include "Op.h"
 #include "UnitTest.h"
 
 OCIO_ADD_TEST(GroupTransform, basic)
@@ -269,4 +488,102 @@ OCIO_ADD_TEST(GroupTransform, basic)
     metadata.addChildElement("child1", "content1");
 }
 
+OCIO_ADD_TEST(GroupTransform, cached_ops)
+{
+    OCIO::ClearAllCaches();
+
+    OCIO::ConstConfigRcPtr config = OCIO::Config::CreateRaw();
+
+    OCIO::GroupTransformRcPtr group = OCIO::GroupTransform::Create();
+    group->getFormatMetadata().addAttribute("id", "outer");
+    OCIO::GroupTransformRcPtr nested = OCIO::GroupTransform::Create();
+    nested->getFormatMetadata().addAttribute("id", "nested");
+    const double m44[16] = { 2.0, 0.0, 0.0, 0.0,
+                             0.0, 2.0, 0.0, 0.0,
+                             0.0, 0.0, 2.0, 0.0,
+                             0.0, 0.0, 0.0, 1.0 };
+    OCIO::MatrixTransformRcPtr matrix = OCIO::MatrixTransform::Create();
+    matrix->setMatrix(m44);
+    nested->appendTransform(matrix);
+    matrix.reset();
+    const double gamma[4] = { 2.2, 2.2, 2.2, 1.0 };
+    OCIO::ExponentTransformRcPtr exponent = OCIO::ExponentTransform::Create();
+    exponent->setValue(gamma);
+    nested->appendTransform(exponent);
+    exponent.reset();
+    group->appendTransform(nested);
+    nested.reset();
+    group->appendTransform(OCIO::LogTransform::Create());
+
+    // The nested groups are flattened, and the op chain is shared.
+    OCIO::OpRcPtrVec ops1;
+    OCIO_CHECK_NO_THROW(OCIO::BuildOps(ops1, *config, config->getCurrentContext(), group,
+                                       OCIO::TRANSFORM_DIR_FORWARD));
+    OCIO_REQUIRE_EQUAL(ops1.size(), 3);
+    OCIO_CHECK_ASSERT(ops1[0]->isShared());
+
+    OCIO::OpRcPtrVec ops2;
+    OCIO_CHECK_NO_THROW(OCIO::BuildOps(ops2, *config, config->getCurrentContext(), group,
+                                       OCIO::TRANSFORM_DIR_FORWARD));
+    OCIO_REQUIRE_EQUAL(ops2.size(), 3);
+    for (size_t idx = 0; idx < ops1.size(); ++idx)
+    {
+        OCIO_CHECK_EQUAL(ops1[idx].get(), ops2[idx].get());
+    }
+
+    // The group starting the op list copies the metadata of the (nested) first group.
+    OCIO_CHECK_EQUAL(std::string(ops2.getFormatMetadata().getAttributeValue(0)), "nested");
+
+    // Not when following other ops.
+    OCIO::OpRcPtrVec ops3;
+    OCIO_CHECK_NO_THROW(OCIO::BuildOps(ops3, *config, config->getCurrentContext(),
+                                       OCIO::LogTransform::Create(),
+                                       OCIO::TRANSFORM_DIR_FORWARD));
+    OCIO_CHECK_NO_THROW(OCIO::BuildOps(ops3, *config, config->getCurrentContext(), group,
+                                       OCIO::TRANSFORM_DIR_FORWARD));
+    OCIO_REQUIRE_EQUAL(ops3.size(), 4);
+    OCIO_CHECK_EQUAL(ops3.getFormatMetadata().getNumAttributes(), 0);
+    OCIO_CHECK_EQUAL(ops1[0].get(), ops3[1].get());
+
+    // The inverse direction is another op chain.
+    OCIO::OpRcPtrVec ops4;
+    OCIO_CHECK_NO_THROW(OCIO::BuildOps(ops4, *config, config->getCurrentContext(), group,
+                                       OCIO::TRANSFORM_DIR_INVERSE));
+    OCIO_REQUIRE_EQUAL(ops4.size(), 3);
+    OCIO_CHECK_NE(ops1[2].get(), ops4[0].get());
+
+    // A change through the group rebuilds the op chain.
+    OCIO::TransformRcPtr & child = group->getTransform(1);
+    OCIO::ExponentTransformRcPtr newExponent = OCIO::ExponentTransform::Create();
+    newExponent->setValue(gamma);
+    child = newExponent;
+    newExponent.reset();
+    OCIO::OpRcPtrVec ops5;
+    OCIO_CHECK_NO_THROW(OCIO::BuildOps(ops5, *config, config->getCurrentContext(), group,
+                                       OCIO::TRANSFORM_DIR_FORWARD));
+    OCIO_REQUIRE_EQUAL(ops5.size(), 3);
+    OCIO_CHECK_NE(ops1[0].get(), ops5[0].get());
+    OCIO_CHECK_NE(ops1[2]->getInfo(), ops5[2]->getInfo());
+
+    // The children held elsewhere could change so the op chain is not cached.
+    OCIO::ConstTransformRcPtr held = group->getTransform(0);
+    OCIO::OpRcPtrVec ops6;
+    OCIO_CHECK_NO_THROW(OCIO::BuildOps(ops6, *config, config->getCurrentContext(), group,
+                                       OCIO::TRANSFORM_DIR_FORWARD));
+    OCIO_REQUIRE_EQUAL(ops6.size(), 3);
+    OCIO_CHECK_ASSERT(!ops6[0]->isShared());
+
+    // Clearing the caches rebuilds the op chains.
+    held.reset();
+    OCIO::OpRcPtrVec ops7;
+    OCIO_CHECK_NO_THROW(OCIO::BuildOps(ops7, *config, config->getCurrentContext(), group,
+                                       OCIO::TRANSFORM_DIR_FORWARD));
+    OCIO::ClearAllCaches();
+    OCIO::OpRcPtrVec ops8;
+    OCIO_CHECK_NO_THROW(OCIO::BuildOps(ops8, *config, config->getCurrentContext(), group,
+                                       OCIO::TRANSFORM_DIR_FORWARD));
+    OCIO_REQUIRE_EQUAL(ops8.size(), 3);
+    OCIO_CHECK_NE(ops7[0].get(), ops8[0].get());
+}
+
 #endif
\ No newline at end of file
@@ -0,0 +1,19 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the OpenColorIO Project.
+
+
+#ifndef INCLUDED_OCIO_GROUPTRANSFORM_H
+#define INCLUDED_OCIO_GROUPTRANSFORM_H
+
+#include <OpenColorIO/OpenColorIO.h>
+
+OCIO_NAMESPACE_ENTER
+{
+
+// Invalidate the op chains cached by the groups.
+void ClearGroupOpsCache();
+
+}
+OCIO_NAMESPACE_EXIT
+
+#endif
@@ -5,12 +5,18 @@
 
 #include <algorithm>
 #include <iterator>
+#include <map>
+#include <sstream>
+#include <utility>
 
+#include "CacheStatistics.h"
 #include "LookParse.h"
+#include "Mutex.h"
 #include "ops/NoOp/NoOps.h"
 #include "OpBuilders.h"
 #include "ParseUtils.h"
 #include "pystring/pystring.h"
+#include "transforms/LookTransform.h"
 
 
 OCIO_NAMESPACE_ENTER
@@ -161,6 +167,147 @@ OCIO_NAMESPACE_ENTER
     namespace
     {
     
+    // The ops of a single look, preceded by a look no-op naming it.
+    void BuildLookTokenOps(OpRcPtrVec & ops,
+                           const Config & config,
+                           const ConstContextRcPtr & context,
+                           const ConstLookRcPtr & look,
+                           const LookParseResult::Token & lookToken)
+    {
+        if(lookToken.dir == TRANSFORM_DIR_FORWARD)
+        {
+            CreateLookNoOp(ops, lookToken.name);
+            if(look->getTransform())
+            {
+                BuildOps(ops, config, context, look->getTransform(), TRANSFORM_DIR_FORWARD);
+            }
+            else if(look->getInverseTransform())
+            {
+                BuildOps(ops, config, context, look->getInverseTransform(), TRANSFORM_DIR_INVERSE);
+            }
+        }
+        else if(lookToken.dir == TRANSFORM_DIR_INVERSE)
+        {
+            CreateLookNoOp(ops, std::string("-") + lookToken.name);
+            if(look->getInverseTransform())
+            {
+                BuildOps(ops, config, context, look->getInverseTransform(), TRANSFORM_DIR_FORWARD);
+            }
+            else if(look->getTransform())
+            {
+                BuildOps(ops, config, context, look->getTransform(), TRANSFORM_DIR_INVERSE);
+            }
+        }
+        else
+        {
+            std::ostringstream os;
+            os << "BuildLookOps error. ";
+            os << "The specified look, '" << lookToken.name;
+            os << "' has an ill-defined transform direction.";
+            throw Exception(os.str().c_str());
+        }
+    }
+
+    // When looks are stacked interactively, the look strings mostly differ by one look
+    // so the op chain of each look is cached as well (i.e. in addition to the op chains
+    // of the complete look strings).
+    //
+    // The key is the config cache id (i.e. including the context & the file references),
+    // the look name, its direction and its process space.
+
+    typedef std::map<std::string, OpRcPtrVec> LookTokenOpsCache;
+
+    LookTokenOpsCache g_lookTokenOpsCache;
+
+    // Protects both the look token ops cache and the look ops cache.
+    Mutex g_lookOpsCacheLock;
+
+    void BuildCachedLookTokenOps(OpRcPtrVec & ops,
+                                 const Config & config,
+                                 const ConstContextRcPtr & context,
+                                 const ConstLookRcPtr & look,
+                                 const LookParseResult::Token & lookToken)
+    {
+        // When the files are checked (refer to SetFileCacheCheckInterval()), the looks
+        // are not cached as the key does not change with the file contents.
+        if(GetFileCacheCheckInterval() != 0)
+        {
+            BuildLookTokenOps(ops, config, context, look, lookToken);
+            return;
+        }
+
+        std::ostringstream oss;
+        try
+        {
+            oss << config.getCacheID(context);
+        }
+        catch(const Exception &)
+        {
+            BuildLookTokenOps(ops, config, context, look, lookToken);
+            return;
+        }
+
+        oss << " " << lookToken.name
+            << " " << TransformDirectionToString(lookToken.dir)
+            << " " << look->getProcessSpace();
+        const std::string key = oss.str();
+
+        CacheStatistics & statistics = GetCacheStatistics(CACHE_LOOK_OPS);
+
+        {
+            AutoTimedMutex lock(g_lookOpsCacheLock, statistics);
+
+            LookTokenOpsCache::const_iterator iter = g_lookTokenOpsCache.find(key);
+            if(iter != g_lookTokenOpsCache.end())
+            {
+                statistics.addHit();
+                ops += iter->second;
+                return;
+            }
+        }
+
+        statistics.addMiss();
+
+        // Same rules as the op chains of the complete look strings (see below).
+        OpRcPtrVec newOps;
+        CreateGpuAllocationNoOp(newOps, AllocationData());
+        BuildLookTokenOps(newOps, config, context, look, lookToken);
+        newOps.erase(newOps.begin());
+
+        const FormatMetadataImpl & metadata = newOps.getFormatMetadata();
+        if(metadata.getNumAttributes() != 0 || metadata.getNumChildrenElements() != 0
+            || *metadata.getValue() != 0)
+        {
+            BuildLookTokenOps(ops, config, context, look, lookToken);
+            return;
+        }
+
+        FinalizeOpVec(newOps, FINALIZATION_EXACT);
+
+        for(const auto & op : newOps)
+        {
+            if(op->isDynamic())
+            {
+                ops += newOps;
+                return;
+            }
+        }
+
+        for(auto & op : newOps)
+        {
+            op->setShared();
+        }
+
+        AutoTimedMutex lock(g_lookOpsCacheLock, statistics);
+
+        const auto result = g_lookTokenOpsCache.insert(std::make_pair(key, std::move(newOps)));
+        if(result.second)
+        {
+            statistics.addInsertion();
+        }
+        ops += result.first->second;
+    }
+    
     void RunLookTokens(OpRcPtrVec & ops,
                        ConstColorSpaceRcPtr & currentColorSpace,
                        bool skipColorSpaceConversions,
@@ -204,39 +351,7 @@ OCIO_NAMESPACE_ENTER
             // Put the new ops into a temp array, to see if it's a no-op
             // If it is a no-op, dont bother doing the colorspace conversion.
             OpRcPtrVec tmpOps;
-            
-            if(lookTokens[i].dir == TRANSFORM_DIR_FORWARD)
-            {
-                CreateLookNoOp(tmpOps, lookName);
-                if(look->getTransform())
-                {
-                    BuildOps(tmpOps, config, context, look->getTransform(), TRANSFORM_DIR_FORWARD);
-                }
-                else if(look->getInverseTransform())
-                {
-                    BuildOps(tmpOps, config, context, look->getInverseTransform(), TRANSFORM_DIR_INVERSE);
-                }
-            }
-            else if(lookTokens[i].dir == TRANSFORM_DIR_INVERSE)
-            {
-                CreateLookNoOp(tmpOps, std::string("-") + lookName);
-                if(look->getInverseTransform())
-                {
-                    BuildOps(tmpOps, config, context, look->getInverseTransform(), TRANSFORM_DIR_FORWARD);
-                }
-                else if(look->getTransform())
-                {
-                    BuildOps(tmpOps, config, context, look->getTransform(), TRANSFORM_DIR_INVERSE);
-                }
-            }
-            else
-            {
-                std::ostringstream os;
-                os << "BuildLookOps error. ";
-                os << "The specified look, '" << lookTokens[i].name;
-                os << "' has an ill-defined transform direction.";
-                throw Exception(os.str().c_str());
-            }
+            BuildCachedLookTokenOps(tmpOps, config, context, look, lookTokens[i]);
             
             if(!IsOpVecNoOp(tmpOps))
             {
@@ -264,8 +379,163 @@ OCIO_NAMESPACE_ENTER
         }
     }
     
+    void BuildUncachedLookOps(OpRcPtrVec & ops,
+                              ConstColorSpaceRcPtr & currentColorSpace,
+                              bool skipColorSpaceConversions,
+                              const Config& config,
+                              const ConstContextRcPtr & context,
+                              const LookParseResult & looks)
+    {
+        const LookParseResult::Options & options = looks.getOptions();
+        
+        if(options.empty())
+        {
+            // Do nothing
+        }
+        else if(options.size() == 1)
+        {
+            // As an optimization, if we only have a single look option,
+            // just push back onto the final location
+            RunLookTokens(ops,
+                          currentColorSpace,
+                          skipColorSpaceConversions,
+                          config,
+                          context,
+                          options[0]);
+        }
+        else
+        {
+            // If we have multiple look options, try each one in order,
+            // and if we can create the ops without a missing file exception,
+            // push back it's results and return
+            
+            bool success = false;
+            std::ostringstream os;
+            
+            OpRcPtrVec tmpOps;
+            ConstColorSpaceRcPtr cs;
+            
+            for(unsigned int i=0; i<options.size(); ++i)
+            {
+                cs = currentColorSpace;
+                tmpOps.clear();
+                
+                try
+                {
+                    RunLookTokens(tmpOps,
+                                  cs,
+                                  skipColorSpaceConversions,
+                                  config,
+                                  context,
+                                  options[i]);
+                    success = true;
+                    break;
+                }
+                catch(ExceptionMissingFile & e)
+                {
+                    if(i != 0) os << "  ...  ";
+                    
+                    os << "(";
+                    LookParseResult::serialize(os, options[i]);
+                    os << ") " << e.what();
+                }
+            }
+            
+            if(success)
+            {
+                currentColorSpace = cs;
+                ops += tmpOps;
+            }
+            else
+            {
+                throw ExceptionMissingFile(os.str().c_str());
+            }
+        }
+    }
+
+    // A viewer typically toggles the looks of a display/view while the other parts of
+    // its processors come from the color space ops cache, so the (finalized) op chains
+    // applying the looks are cached too.
+    //
+    // The key is the config cache id (i.e. including the context & the file references),
+    // the color space the looks start from, the looks and whether the color space
+    // conversions are skipped. The entry also holds the color space the looks end in.
+
+    struct LookOpsCacheEntry
+    {
+        OpRcPtrVec m_ops;
+        std::string m_colorSpaceName;
+    };
+
+    typedef std::map<std::string, LookOpsCacheEntry> LookOpsCache;
+
+    LookOpsCache g_lookOpsCache;
+
+    std::string GetLookOpsCacheKey(const ConstColorSpaceRcPtr & currentColorSpace,
+                                   bool skipColorSpaceConversions,
+                                   const Config & config,
+                                   const ConstContextRcPtr & context,
+                                   const LookParseResult & looks)
+    {
+        // Only the color spaces of the config are identified by the config cache id, and
+        // the file contents are not part of the key (refer to SetFileCacheCheckInterval()).
+        if(config.getColorSpace(currentColorSpace->getName()).get() != currentColorSpace.get()
+            || GetFileCacheCheckInterval() != 0)
+        {
+            return "";
+        }
+
+        std::ostringstream oss;
+        try
+        {
+            oss << config.getCacheID(context);
+        }
+        catch(const Exception &)
+        {
+            return "";
+        }
+
+        oss << " " << currentColorSpace->getName()
+            << " " << (skipColorSpaceConversions ? "skip" : "convert") << " ";
+
+        const LookParseResult::Options & options = looks.getOptions();
+        for(size_t idx = 0; idx < options.size(); ++idx)
+        {
+            if(idx != 0) oss << "|";
+            LookParseResult::serialize(oss, options[idx]);
+        }
+
+        return oss.str();
+    }
+
     } // anon namespace
     
+    void ClearLookOpsCache()
+    {
+        AutoMutex lock(g_lookOpsCacheLock);
+        g_lookOpsCache.clear();
+        g_lookTokenOpsCache.clear();
+    }
+
+    size_t GetLookOpsCacheMemoryUsage()
+    {
+        AutoMutex lock(g_lookOpsCacheLock);
+
+        size_t numBytes = 0;
+        for(const auto & entry : g_lookOpsCache)
+        {
+            numBytes += entry.first.capacity() + entry.second.m_colorSpaceName.capacity()
+                      + GetOpVecMemorySize(entry.second.m_ops);
+        }
+
+        for(const auto & entry : g_lookTokenOpsCache)
+        {
+            numBytes += entry.first.capacity() + GetOpVecMemorySize(entry.second);
+        }
+
+        return numBytes;
+    }
+
     ////////////////////////////////////////////////////////////////////////////
     
     
@@ -333,71 +603,88 @@ OCIO_NAMESPACE_ENTER
                       const ConstContextRcPtr & context,
                       const LookParseResult & looks)
     {
-        const LookParseResult::Options & options = looks.getOptions();
-        
-        if(options.empty())
+        const std::string key
+            = GetLookOpsCacheKey(currentColorSpace, skipColorSpaceConversions,
+                                 config, context, looks);
+        if(key.empty())
         {
-            // Do nothing
+            BuildUncachedLookOps(ops, currentColorSpace, skipColorSpaceConversions,
+                                 config, context, looks);
+            return;
         }
-        else if(options.size() == 1)
-        {
-            // As an optimization, if we only have a single look option,
-            // just push back onto the final location
-            RunLookTokens(ops,
-                          currentColorSpace,
-                          skipColorSpaceConversions,
-                          config,
-                          context,
-                          options[0]);
-        }
-        else
+
+        CacheStatistics & statistics = GetCacheStatistics(CACHE_LOOK_OPS);
+
         {
-            // If we have multiple look options, try each one in order,
-            // and if we can create the ops without a missing file exception,
-            // push back it's results and return
-            
-            bool success = false;
-            std::ostringstream os;
-            
-            OpRcPtrVec tmpOps;
-            ConstColorSpaceRcPtr cs;
-            
-            for(unsigned int i=0; i<options.size(); ++i)
-            {
-                cs = currentColorSpace;
-                tmpOps.clear();
-                
-                try
-                {
-                    RunLookTokens(tmpOps,
-                                  cs,
-                                  skipColorSpaceConversions,
-                                  config,
-                                  context,
-                                  options[i]);
-                    success = true;
-                    break;
-                }
-                catch(ExceptionMissingFile & e)
-                {
-                    if(i != 0) os << "  ...  ";
-                    
-                    os << "(";
-                    LookParseResult::serialize(os, options[i]);
-                    os << ") " << e.what();
-                }
-            }
-            
-            if(success)
+            AutoTimedMutex lock(g_lookOpsCacheLock, statistics);
+
+            LookOpsCache::const_iterator iter = g_lookOpsCache.find(key);
+            if(iter != g_lookOpsCache.end())
             {
-                currentColorSpace = cs;
-                ops += tmpOps;
+                statistics.addHit();
+                ops += iter->second.m_ops;
+                currentColorSpace = config.getColorSpace(iter->second.m_colorSpaceName.c_str());
+                return;
             }
-            else
+        }
+
+        statistics.addMiss();
+
+        // Note that the lock is not held while building the ops as the looks could
+        // recursively need other looks (e.g. a LookTransform).
+
+        // As in the processor op list, the op chain never starts the list so a group
+        // transform does not copy its metadata as the processor one.
+        OpRcPtrVec newOps;
+        CreateGpuAllocationNoOp(newOps, AllocationData());
+        ConstColorSpaceRcPtr colorSpace = currentColorSpace;
+        BuildUncachedLookOps(newOps, colorSpace, skipColorSpaceConversions,
+                             config, context, looks);
+        newOps.erase(newOps.begin());
+
+        // The op chains adding processor metadata (e.g. from a CLF file) are not shared
+        // as the metadata is then directly updated in the processor op list.
+        const FormatMetadataImpl & metadata = newOps.getFormatMetadata();
+        if(metadata.getNumAttributes() != 0 || metadata.getNumChildrenElements() != 0
+            || *metadata.getValue() != 0)
+        {
+            BuildUncachedLookOps(ops, currentColorSpace, skipColorSpaceConversions,
+                                 config, context, looks);
+            return;
+        }
+
+        FinalizeOpVec(newOps, FINALIZATION_EXACT);
+        currentColorSpace = colorSpace;
+
+        // The dynamic properties are unified per processor so the dynamic ops are
+        // never shared.
+        for(const auto & op : newOps)
+        {
+            if(op->isDynamic())
             {
-                throw ExceptionMissingFile(os.str().c_str());
+                ops += newOps;
+                return;
             }
         }
+
+        for(auto & op : newOps)
+        {
+            op->setShared();
+        }
+
+        LookOpsCacheEntry entry;
+        entry.m_ops = std::move(newOps);
+        entry.m_colorSpaceName = colorSpace->getName();
+
+        AutoTimedMutex lock(g_lookOpsCacheLock, statistics);
+
+        // Another thread could have cached the same op chain in the meantime.
+        const auto result = g_lookOpsCache.insert(std::make_pair(key, std::move(entry)));
+        if(result.second)
+        {
+            statistics.addInsertion();
+        }
+        ops += result.first->second.m_ops;
     }
 }
 OCIO_NAMESPACE_EXIT
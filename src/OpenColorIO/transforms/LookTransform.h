@@ -0,0 +1,23 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the OpenColorIO Project.
+
+
+#ifndef INCLUDED_OCIO_LOOKTRANSFORM_H
+#define INCLUDED_OCIO_LOOKTRANSFORM_H
+
+#include <OpenColorIO/OpenColorIO.h>
+
+OCIO_NAMESPACE_ENTER
+{
+
+// Clear the cache of the op chains applying the looks (i.e. of the look strings and of
+// each look).
+void ClearLookOpsCache();
+
+// Get the approximate number of bytes held by the look ops cache.
+size_t GetLookOpsCacheMemoryUsage();
+
+}
+OCIO_NAMESPACE_EXIT
+
+#endif
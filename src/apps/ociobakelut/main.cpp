@@ -1,11 +1,15 @@
 // SPDX-License-Identifier: BSD-3-Clause
 // Copyright Contributors to the OpenColorIO Project.
 
+#include <algorithm>
+#include <atomic>
 #include <cmath>
 #include <cstdlib>
 #include <iostream>
 #include <sstream>
 #include <fstream>
+#include <mutex>
+#include <thread>
 #include <vector>
 
 #include <OpenColorIO/OpenColorIO.h>
@@ -30,6 +34,166 @@ parse_end_args(int argc, const char *argv[])
 OCIO::GroupTransformRcPtr
 parse_luts(int argc, const char *argv[]);
 
+// A LUT to bake i.e. the format, the cube size (-1 for the format default) and the
+// output file (empty to write to stdout).
+struct BakeTarget
+{
+    std::string format;
+    int cubesize = -1;
+    std::string outputfile;
+};
+
+std::vector<BakeTarget>
+parse_bake_targets(int argc, const char *argv[]);
+
+struct ICCOptions
+{
+    int whitepointtemp = 6505;
+    std::string displayicc;
+    std::string description;
+    std::string copyright;
+};
+
+static std::mutex logMutex;
+
+// Bake one target from the baker holding the config, the color spaces and the looks.
+// The target bakers are copies of it so they all share the same config and then the
+// processors it caches.
+void Bake(const OCIO::Baker & baseBaker, const BakeTarget & target,
+          const ICCOptions & iccOptions, bool verbose)
+{
+    if(target.format == "icc")
+    {
+        std::string description = iccOptions.description;
+        if(description.empty())
+        {
+            description = target.outputfile;
+            if(verbose)
+            {
+                std::lock_guard<std::mutex> lock(logMutex);
+                std::cout << "[OpenColorIO INFO]: \"--description\" set to default value of filename.icc: " << target.outputfile << "" << std::endl;
+            }
+        }
+
+        const int cubesize = target.cubesize<2 ? 32 : target.cubesize; // default
+
+        OCIO::ConstConfigRcPtr config = baseBaker.getConfig();
+        const std::string looks = baseBaker.getLooks();
+
+        OCIO::ConstCPUProcessorRcPtr processor;
+        if (!looks.empty())
+        {
+            OCIO::LookTransformRcPtr transform =
+                OCIO::LookTransform::Create();
+            transform->setLooks(looks.c_str());
+            transform->setSrc(baseBaker.getInputSpace());
+            transform->setDst(baseBaker.getTargetSpace());
+            processor = config->getProcessor(transform,
+                OCIO::TRANSFORM_DIR_FORWARD)->getDefaultCPUProcessor();
+        }
+        else
+        {
+            processor = config->getProcessor(baseBaker.getInputSpace(),
+                baseBaker.getTargetSpace())->getDefaultCPUProcessor();
+        }
+
+        SaveICCProfileToFile(target.outputfile,
+                             processor,
+                             cubesize,
+                             iccOptions.whitepointtemp,
+                             iccOptions.displayicc,
+                             description,
+                             iccOptions.copyright,
+                             verbose);
+    }
+    else
+    {
+        OCIO::BakerRcPtr baker = baseBaker.createEditableCopy();
+
+        // setup the baker for our LUT type
+        baker->setFormat(target.format.c_str());
+        if(target.cubesize!=-1) baker->setCubeSize(target.cubesize);
+
+        if(verbose && !target.outputfile.empty())
+        {
+            std::lock_guard<std::mutex> lock(logMutex);
+            std::cout << "[OpenColorIO INFO]: Baking '" << target.format << "' LUT" << std::endl;
+        }
+
+        if(target.outputfile.empty())
+        {
+            baker->bake(std::cout);
+        }
+        else
+        {
+            std::ofstream f(target.outputfile.c_str());
+            if(f.fail())
+            {
+                std::ostringstream os;
+                os << "Non-writable file path " << target.outputfile << " specified.";
+                throw OCIO::Exception(os.str().c_str());
+            }
+            baker->bake(f);
+            if(verbose)
+            {
+                std::lock_guard<std::mutex> lock(logMutex);
+                std::cout << "[OpenColorIO INFO]: Wrote '" << target.outputfile << "'" << std::endl;
+            }
+        }
+    }
+}
+
+// Bake all the targets, at most numBakes of them concurrently. The first error is
+// rethrown once all the started bakes are done.
+void BakeAll(const OCIO::Baker & baseBaker, const std::vector<BakeTarget> & targets,
+             const ICCOptions & iccOptions, int numBakes, bool verbose)
+{
+    std::atomic<size_t> nextTarget(0);
+    std::atomic<bool> failed(false);
+
+    std::mutex mutex;
+    std::string error;
+
+    auto worker = [&]()
+    {
+        size_t idx = 0;
+        while (!failed && (idx = nextTarget++) < targets.size())
+        {
+            try
+            {
+                Bake(baseBaker, targets[idx], iccOptions, verbose);
+            }
+            catch (std::exception & ex)
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (!failed)
+                {
+                    error = targets.size()==1 ? ex.what()
+                        : "'" + targets[idx].outputfile + "': " + ex.what();
+                    failed = true;
+                }
+            }
+        }
+    };
+
+    std::vector<std::thread> workers;
+    const size_t numWorkers = std::min(size_t(std::max(1, numBakes)), targets.size());
+    for (size_t idx = 1; idx < numWorkers; ++idx)
+    {
+        workers.emplace_back(worker);
+    }
+    worker();
+    for (auto & thread : workers)
+    {
+        thread.join();
+    }
+
+    if (failed)
+    {
+        throw OCIO::Exception(error.c_str());
+    }
+}
+
 int main (int argc, const char* argv[])
 {
     
@@ -44,6 +208,9 @@ int main (int argc, const char* argv[])
     std::string outputspace;
     bool usestdout = false;
     bool verbose = false;
+    int numBakes = 0;
+    float tolerance = 0.0f;
+    bool autoshaper = false;
     
     int whitepointtemp = 6505;
     std::string displayicc;
@@ -63,7 +230,8 @@ int main (int argc, const char* argv[])
     
     std::string formatstr = formats.str();
     
-    std::string dummystr;
+    std::string dummystr, dummystr2;
+    int dummyi;
     float dummyf1, dummyf2, dummyf3;
     
     ArgParse ap;
@@ -74,7 +242,8 @@ int main (int argc, const char* argv[])
                "example:  ociobakelut --cccid 0 --lut cdlgrade.ccc --lut calibration.3dl --format flame graded_display.3dl\n"
                "example:  ociobakelut --lut look.3dl --offset 0.01 -0.02 0.03 --lut display.3dl --format flame display_with_look.3dl\n"
                "example:  ociobakelut --inputspace lg10 --outputspace srgb8 --format icc ~/Library/ColorSync/Profiles/test.icc\n"
-               "example:  ociobakelut --lut filmlut.3dl --lut calibration.3dl --format icc ~/Library/ColorSync/Profiles/test.icc\n\n",
+               "example:  ociobakelut --lut filmlut.3dl --lut calibration.3dl --format icc ~/Library/ColorSync/Profiles/test.icc\n"
+               "example:  ociobakelut --inputspace lg10 --outputspace srgb8 --bake flame -1 lg_to_srgb.3dl --bake iridas_cube 33 lg_to_srgb_33.cube --bake iridas_cube 65 lg_to_srgb_65.cube\n\n",
                "%*", parse_end_args, "",
                "<SEPARATOR>", "Using Existing OCIO Configurations",
                "--inputspace %s", &inputspace, "Input OCIO ColorSpace (or Role)",
@@ -96,6 +265,11 @@ int main (int argc, const char* argv[])
                "--format %s", &format, formatstr.c_str(),
                "--shapersize %d", &shapersize, "size of the shaper (default: format specific)",
                "--cubesize %d", &cubesize, "size of the cube (default: format specific)",
+               "--bake %s %d %s", &dummystr, &dummyi, &dummystr2, "Bake an additional LUT: format, cube size (-1 for the format default) and output file "
+                                                                   "(can be specified multiple times). All the LUTs share the config and the processors",
+               "--tolerance %f", &tolerance, "maximum interpolation error of the LUT, selecting the smallest shaper and cube sizes within it (default: disabled)",
+               "--autoshaper", &autoshaper, "select the shaper space giving the smallest LUT within the --tolerance (if no --shaperspace)",
+               "--parallelbakes %d", &numBakes, "Maximum number of LUTs concurrently baked (default: number of cores)",
                "--stdout", &usestdout, "Write to stdout (rather than file)",
                "--v", &verbose, "Verbose",
                "--help", &help, "Print help message\n",
@@ -134,10 +308,12 @@ int main (int argc, const char* argv[])
     
     
     OCIO::GroupTransformRcPtr groupTransform;
+    std::vector<BakeTarget> bakeTargets;
     
     try
     {
         groupTransform = parse_luts(argc, argv);
+        bakeTargets = parse_bake_targets(argc, argv);
     }
     catch(const OCIO::Exception & e)
     {
@@ -229,7 +405,7 @@ int main (int argc, const char* argv[])
             return 1;
         }
         
-        if(format.empty())
+        if(format.empty() && bakeTargets.empty())
         {
             std::cerr << "\nERROR: You must specify the LUT format using --format.\n\n";
             std::cerr << "See --help for more info." << std::endl;
@@ -260,104 +436,60 @@ int main (int argc, const char* argv[])
         }
     }
     
-    if(outputfile.empty() && !usestdout)
+    // The LUT of --format is baked along with the --bake ones.
+    std::vector<BakeTarget> targets;
+    if(!format.empty() || bakeTargets.empty())
     {
-        std::cerr << "\nERROR: You must specify the outputfile or --stdout.\n\n";
-        std::cerr << "See --help for more info." << std::endl;
-        return 1;
+        if(outputfile.empty() && !usestdout)
+        {
+            std::cerr << "\nERROR: You must specify the outputfile or --stdout.\n\n";
+            std::cerr << "See --help for more info." << std::endl;
+            return 1;
+        }
+
+        BakeTarget target;
+        target.format = format;
+        target.cubesize = cubesize;
+        if(!usestdout) target.outputfile = outputfile;
+        targets.push_back(target);
+    }
+    targets.insert(targets.end(), bakeTargets.begin(), bakeTargets.end());
+
+    for(const auto & target : targets)
+    {
+        if(target.format == "icc" && target.outputfile.empty())
+        {
+            std::cerr << "\nERROR: --stdout not supported when writing ICC profiles.\n\n";
+            std::cerr << "See --help for more info." << std::endl;
+            return 1;
+        }
     }
     
     try
     {
-        if(format == "icc")
-        {
-            if(description.empty())
-            {
-                description = outputfile;
-                if(verbose)
-                    std::cout << "[OpenColorIO INFO]: \"--description\" set to default value of filename.icc: " << outputfile << "" << std::endl;
-            }
-            
-            if(usestdout)
-            {
-                std::cerr << "\nERROR: --stdout not supported when writing ICC profiles.\n\n";
-                std::cerr << "See --help for more info." << std::endl;
-                return 1;
-            }
-            
-            if(outputfile.empty())
-            {
-                std::cerr << "ERROR: you need to specify a output ICC path\n";
-                std::cerr << "See --help for more info." << std::endl;
-                return 1;
-            }
-            
-            if(cubesize<2) cubesize = 32; // default
+        OCIO::BakerRcPtr baker = OCIO::Baker::Create();
 
-            OCIO::ConstCPUProcessorRcPtr processor;
-            if (!looks.empty())
-            {
-                OCIO::LookTransformRcPtr transform =
-                    OCIO::LookTransform::Create();
-                transform->setLooks(looks.c_str());
-                transform->setSrc(inputspace.c_str());
-                transform->setDst(outputspace.c_str());
-                processor = config->getProcessor(transform,
-                    OCIO::TRANSFORM_DIR_FORWARD)->getDefaultCPUProcessor();
-            }
-            else
-            {
-                processor = config->getProcessor(inputspace.c_str(),
-                    outputspace.c_str())->getDefaultCPUProcessor();
-            }
-            
-            SaveICCProfileToFile(outputfile,
-                                 processor,
-                                 cubesize,
-                                 whitepointtemp,
-                                 displayicc,
-                                 description,
-                                 copyright,
-                                 verbose);
-        }
-        else
+        baker->setConfig(config);
+        baker->setInputSpace(inputspace.c_str());
+        baker->setShaperSpace(shaperspace.c_str());
+        baker->setLooks(looks.c_str());
+        baker->setTargetSpace(outputspace.c_str());
+        if(shapersize!=-1) baker->setShaperSize(shapersize);
+        baker->setTolerance(tolerance);
+        baker->setAutoShaperSpace(autoshaper);
+
+        ICCOptions iccOptions;
+        iccOptions.whitepointtemp = whitepointtemp;
+        iccOptions.displayicc = displayicc;
+        iccOptions.description = description;
+        iccOptions.copyright = copyright;
+
+        if(numBakes<=0)
         {
-        
-            OCIO::BakerRcPtr baker = OCIO::Baker::Create();
-            
-            // setup the baker for our LUT type
-            baker->setConfig(config);
-            baker->setFormat(format.c_str());
-            baker->setInputSpace(inputspace.c_str());
-            baker->setShaperSpace(shaperspace.c_str());
-            baker->setLooks(looks.c_str());
-            baker->setTargetSpace(outputspace.c_str());
-            if(shapersize!=-1) baker->setShaperSize(shapersize);
-            if(cubesize!=-1) baker->setCubeSize(cubesize);
-            
-            // output LUT
-            std::ostringstream output;
-            
-            if(!usestdout && verbose)
-                std::cout << "[OpenColorIO INFO]: Baking '" << format << "' LUT" << std::endl;
-            
-            if(usestdout)
-            {
-                baker->bake(std::cout);
-            }
-            else
-            {
-                std::ofstream f(outputfile.c_str());
-                if(f.fail())
-                {
-                    std::cerr << "ERROR: Non-writable file path " << outputfile << " specified." << std::endl;
-                    return 1;
-                }
-                baker->bake(f);
-                if(verbose)
-                    std::cout << "[OpenColorIO INFO]: Wrote '" << outputfile << "'" << std::endl;
-            }
+            numBakes = std::max(1, (int)std::thread::hardware_concurrency());
         }
+
+        BakeAll(*baker, targets, iccOptions, numBakes, verbose);
     }
     catch(OCIO::Exception & exception)
     {
@@ -538,3 +670,38 @@ parse_luts(int argc, const char *argv[])
     return groupTransform;
 }
 
+std::vector<BakeTarget>
+parse_bake_targets(int argc, const char *argv[])
+{
+    std::vector<BakeTarget> targets;
+
+    for(int i=0; i<argc; ++i)
+    {
+        std::string arg(argv[i]);
+
+        if(arg == "--bake" || arg == "-bake")
+        {
+            if(i+3>=argc)
+            {
+                throw OCIO::Exception("Error parsing --bake. Invalid num args");
+            }
+
+            BakeTarget target;
+            target.format = argv[i+1];
+            target.cubesize = atoi(argv[i+2]);
+            target.outputfile = argv[i+3];
+
+            if(target.outputfile.empty())
+            {
+                throw OCIO::Exception("Error parsing --bake. Missing output file");
+            }
+
+            targets.push_back(target);
+
+            i += 3;
+        }
+    }
+
+    return targets;
+}
+
@@ -34,8 +34,61 @@ typedef struct
     cmsHTRANSFORM from_PCS16;
     //OCIO::ConstProcessorRcPtr shaper_processor;
     OCIO::ConstCPUProcessorRcPtr processor;
+    // Lab values of the AToB0 CLUT grid (refer to ComputeDisplay2PCSGrid()).
+    int cubesize;
+    std::vector<cmsUInt16Number> display2PCS;
 } SamplerData;
 
+// Same quantization as the little CMS CLUT sampling i.e. the 16-bit value of the
+// grid index i.
+static cmsUInt16Number QuantizeGridIndex(int i, int cubesize)
+{
+    const double x = ((double)i * 65535.) / (double)(cubesize - 1);
+    return (cmsUInt16Number)std::floor(x + 0.5);
+}
+
+static int GridIndex(cmsUInt16Number value, int cubesize)
+{
+    return (int)std::floor((double)value * (double)(cubesize - 1) / 65535. + 0.5);
+}
+
+// Compute all the AToB0 CLUT grid values at once rather than pixel by pixel from the
+// sampler i.e. the grid is processed as one image, using several threads, and then
+// converted to Lab by one little CMS call.
+static void ComputeDisplay2PCSGrid(SamplerData & data)
+{
+    const int cubesize = data.cubesize;
+    const size_t numPixels = (size_t)cubesize * cubesize * cubesize;
+
+    // The first channel varies the slowest, as in the little CMS CLUTs.
+    std::vector<float> grid(numPixels * 3);
+    size_t idx = 0;
+    for(int r = 0; r < cubesize; ++r)
+    {
+        for(int g = 0; g < cubesize; ++g)
+        {
+            for(int b = 0; b < cubesize; ++b)
+            {
+                grid[idx++] = static_cast<float>(QuantizeGridIndex(r, cubesize))/65535.f;
+                grid[idx++] = static_cast<float>(QuantizeGridIndex(g, cubesize))/65535.f;
+                grid[idx++] = static_cast<float>(QuantizeGridIndex(b, cubesize))/65535.f;
+            }
+        }
+    }
+
+    PackedImageDesc img(&grid[0], (long)numPixels, 1, 3);
+    data.processor->apply(img, CPUExecutor());
+
+    data.display2PCS.resize(numPixels * 3);
+    for(idx = 0; idx < numPixels * 3; ++idx)
+    {
+        data.display2PCS[idx] = (cmsUInt16Number)std::max(std::min(grid[idx] * 65535.f, 65535.f), 0.f);
+    }
+
+    cmsDoTransform(data.to_PCS16, &data.display2PCS[0], &data.display2PCS[0],
+                   (cmsUInt32Number)numPixels);
+}
+
 static void Add3GammaCurves(cmsPipeline* lut, cmsFloat64Number Curve)
 {
     cmsToneCurve* id = cmsBuildGamma(NULL, Curve);
@@ -61,14 +114,13 @@ static cmsInt32Number Display2PCS_Sampler16(const cmsUInt16Number in[], cmsUInt1
 {
     //std::cout << "r" << in[0] << " g" << in[1] << " b" << in[2] << "\n";
     SamplerData* data = (SamplerData*) userdata;
-    cmsFloat32Number pix[3] = { static_cast<float>(in[0])/65535.f,
-                                static_cast<float>(in[1])/65535.f,
-                                static_cast<float>(in[2])/65535.f};
-    data->processor->applyRGB(pix);
-    out[0] = (cmsUInt16Number)std::max(std::min(pix[0] * 65535.f, 65535.f), 0.f);
-    out[1] = (cmsUInt16Number)std::max(std::min(pix[1] * 65535.f, 65535.f), 0.f);
-    out[2] = (cmsUInt16Number)std::max(std::min(pix[2] * 65535.f, 65535.f), 0.f);
-    cmsDoTransform(data->to_PCS16, out, out, 1);
+    const int cubesize = data->cubesize;
+    const size_t idx = 3 * (((size_t)GridIndex(in[0], cubesize) * cubesize
+                              + GridIndex(in[1], cubesize)) * cubesize
+                             + GridIndex(in[2], cubesize));
+    out[0] = data->display2PCS[idx];
+    out[1] = data->display2PCS[idx + 1];
+    out[2] = data->display2PCS[idx + 2];
     return 1;
 }
 
@@ -134,6 +186,7 @@ void SaveICCProfileToFile(const std::string & outputfile,
     //
     SamplerData data;
     data.processor = processor;
+    data.cubesize = cubesize;
 
     // 16Bit
     data.to_PCS16 = cmsCreateTransform(DisplayProfile, TYPE_RGB_16, labProfile, TYPE_LabV2_16,
@@ -162,6 +215,7 @@ void SaveICCProfileToFile(const std::string & outputfile,
     
     if(verbose)
         std::cout << "[OpenColorIO INFO]: Sampling AToB0 CLUT from Display to Lab\n";
+    ComputeDisplay2PCSGrid(data);
     cmsStageSampleCLut16bit(AToB0Clut, Display2PCS_Sampler16, &data, 0);
     cmsPipelineInsertStage(AToB0Tag, cmsAT_END, AToB0Clut);
 
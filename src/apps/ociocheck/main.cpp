@@ -1,10 +1,16 @@
 // SPDX-License-Identifier: BSD-3-Clause
 // Copyright Contributors to the OpenColorIO Project.
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <cstdlib>
+#include <functional>
 #include <iostream>
 #include <fstream>
+#include <map>
 #include <set>
+#include <thread>
 #include <vector>
 
 #include <OpenColorIO/OpenColorIO.h>
@@ -21,10 +27,58 @@ const char * DESC_STRING = "\n\n"
 "ociocheck can also be used to clean up formatting on an existing profile\n"
 "that has been manually edited, using the '-o' option.\n";
 
+
+// Call task(idx) for every idx in [0, numTasks[ using numThreads threads. The
+// results are stored by index so the report does not depend on the thread scheduling.
+void ParallelFor(int numTasks, int numThreads, const std::function<void(int)> & task)
+{
+    std::atomic<int> nextIdx(0);
+    const auto worker = [&]()
+    {
+        for(int idx = nextIdx++; idx < numTasks; idx = nextIdx++)
+        {
+            task(idx);
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for(int i=1; i<std::min(numThreads, numTasks); ++i)
+    {
+        threads.push_back(std::thread(worker));
+    }
+    worker();
+
+    for(auto & thread : threads)
+    {
+        thread.join();
+    }
+}
+
+void GetFileTransforms(std::map<std::string, OCIO::ConstFileTransformRcPtr> & files,
+                       const OCIO::ConstTransformRcPtr & transform)
+{
+    if(!transform) return;
+
+    if(OCIO::ConstGroupTransformRcPtr groupTransform
+        = OCIO::DynamicPtrCast<const OCIO::GroupTransform>(transform))
+    {
+        for(int i=0; i<groupTransform->getNumTransforms(); ++i)
+        {
+            GetFileTransforms(files, groupTransform->getTransform(i));
+        }
+    }
+    else if(OCIO::ConstFileTransformRcPtr fileTransform
+        = OCIO::DynamicPtrCast<const OCIO::FileTransform>(transform))
+    {
+        files.insert(std::make_pair(std::string(fileTransform->getSrc()), fileTransform));
+    }
+}
+
 int main(int argc, const char **argv)
 {
     bool help = false;
     int errorcount = 0;
+    int numThreads = std::max(int(std::thread::hardware_concurrency()), 1);
     std::string inputconfig;
     std::string outputconfig;
     
@@ -34,6 +88,8 @@ int main(int argc, const char **argv)
                "--help", &help, "Print help message",
                "--iconfig %s", &inputconfig, "Input .ocio configuration file (default: $OCIO)",
                "--oconfig %s", &outputconfig, "Output .ocio file",
+               "--threads %d", &numThreads, "Number of threads loading the files "
+                                            "(default: number of hardware threads)",
                NULL);
     
     if (ap.parse(argc, argv) < 0)
@@ -136,6 +192,74 @@ int main(int argc, const char **argv)
             }
         }
         
+        {
+            std::cout << std::endl;
+            std::cout << "** Files **" << std::endl;
+
+            // Load the files in parallel, before the processors of the color spaces
+            // then only use the file cache.
+            std::map<std::string, OCIO::ConstFileTransformRcPtr> files;
+            for(int i=0; i<config->getNumColorSpaces(); ++i)
+            {
+                OCIO::ConstColorSpaceRcPtr cs
+                    = config->getColorSpace(config->getColorSpaceNameByIndex(i));
+                GetFileTransforms(files, cs->getTransform(OCIO::COLORSPACE_DIR_TO_REFERENCE));
+                GetFileTransforms(files, cs->getTransform(OCIO::COLORSPACE_DIR_FROM_REFERENCE));
+            }
+            for(int i=0; i<config->getNumLooks(); ++i)
+            {
+                OCIO::ConstLookRcPtr look = config->getLook(config->getLookNameByIndex(i));
+                GetFileTransforms(files, look->getTransform());
+                GetFileTransforms(files, look->getInverseTransform());
+            }
+
+            std::vector<OCIO::ConstFileTransformRcPtr> fileTransforms;
+            for(const auto & file : files)
+            {
+                fileTransforms.push_back(file.second);
+            }
+
+            std::vector<float> durations(fileTransforms.size(), 0.0f);
+            std::vector<std::string> errors(fileTransforms.size());
+
+            ParallelFor(int(fileTransforms.size()), numThreads, [&](int idx)
+            {
+                const auto start = std::chrono::high_resolution_clock::now();
+                try
+                {
+                    config->getProcessor(fileTransforms[idx]);
+                }
+                catch(std::exception & exception)
+                {
+                    errors[idx] = exception.what();
+                }
+                const std::chrono::duration<float, std::milli> duration
+                    = std::chrono::high_resolution_clock::now() - start;
+                durations[idx] = duration.count();
+            });
+
+            if(fileTransforms.empty())
+            {
+                std::cout << "no files referenced" << std::endl;
+            }
+
+            for(size_t idx=0; idx<fileTransforms.size(); ++idx)
+            {
+                std::cout << fileTransforms[idx]->getSrc()
+                          << " (" << durations[idx] << " ms)";
+                if(errors[idx].empty())
+                {
+                    std::cout << std::endl;
+                }
+                else
+                {
+                    std::cout << " -- error" << std::endl;
+                    std::cout << "\t" << errors[idx] << std::endl;
+                    errorcount += 1;
+                }
+            }
+        }
+
         std::cout << std::endl;
         std::cout << "** ColorSpaces **" << std::endl;
         OCIO::ConstColorSpaceRcPtr lin = config->getColorSpace(OCIO::ROLE_SCENE_LINEAR);
@@ -146,24 +270,23 @@ int main(int argc, const char **argv)
         }
         else
         {
-            for(int i=0; i<config->getNumColorSpaces(); ++i)
+            const int numColorSpaces = config->getNumColorSpaces();
+
+            std::vector<std::string> toLinearErrors(numColorSpaces);
+            std::vector<std::string> fromLinearErrors(numColorSpaces);
+
+            // Build the processors in parallel.
+            ParallelFor(numColorSpaces, numThreads, [&](int i)
             {
                 OCIO::ConstColorSpaceRcPtr cs = config->getColorSpace(config->getColorSpaceNameByIndex(i));
-                
-                bool convertsToLinear = true;
-                std::string convertsToLinearErrorText;
-                
-                bool convertsFromLinear = true;
-                std::string convertsFromLinearErrorText;
-                
+
                 try
                 {
                     OCIO::ConstProcessorRcPtr p = config->getProcessor(cs, lin);
                 }
                 catch(OCIO::Exception & exception)
                 {
-                    convertsToLinear = false;
-                    convertsToLinearErrorText = exception.what();
+                    toLinearErrors[i] = exception.what();
                 }
                 
                 try
@@ -172,9 +295,19 @@ int main(int argc, const char **argv)
                 }
                 catch(OCIO::Exception & exception)
                 {
-                    convertsFromLinear = false;
-                    convertsFromLinearErrorText = exception.what();
+                    fromLinearErrors[i] = exception.what();
                 }
+            });
+
+            for(int i=0; i<numColorSpaces; ++i)
+            {
+                OCIO::ConstColorSpaceRcPtr cs = config->getColorSpace(config->getColorSpaceNameByIndex(i));
+                
+                const bool convertsToLinear = toLinearErrors[i].empty();
+                const std::string & convertsToLinearErrorText = toLinearErrors[i];
+                
+                const bool convertsFromLinear = fromLinearErrors[i].empty();
+                const std::string & convertsFromLinearErrorText = fromLinearErrors[i];
                 
                 if(convertsToLinear && convertsFromLinear)
                 {
@@ -0,0 +1,117 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the OpenColorIO Project.
+
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+
+#include <OpenColorIO/OpenColorIO.h>
+namespace OCIO = OCIO_NAMESPACE;
+
+#include "argparse.h"
+
+
+int main(int argc, const char **argv)
+{
+    bool verbose = false;
+    std::string inputColorSpace, outputColorSpace;
+    std::string functionName = "ProcessPixels";
+    std::string filepath;
+
+    bool help = false;
+
+    ArgParse ap;
+    ap.options("ociocodegen -- write the C++ source code of a color transformation\n\n"
+               "usage: ociocodegen [options] --colorspaces in out --file outputfile\n\n"
+               "The generated function processes in place packed RGBA 32-bit float pixels.\n\n",
+               "--h", &help, "Display the help and exit",
+               "--v", &verbose, "Display some general information",
+               "--colorspaces %s %s", &inputColorSpace, &outputColorSpace,
+                                      "Provide the input and output color spaces",
+               "--function %s", &functionName, "Name of the generated function "
+                                               "(default: ProcessPixels)",
+               "--file %s", &filepath, "C++ source file path",
+               NULL);
+
+    if (argc <= 1 || ap.parse(argc, argv) < 0)
+    {
+        std::cerr << ap.geterror() << std::endl;
+        ap.usage();
+        exit(1);
+    }
+
+    if (help)
+    {
+        ap.usage();
+        exit(1);
+    }
+
+    if (filepath.empty())
+    {
+        std::cerr << std::endl;
+        std::cerr << "The output source code filepath is missing." << std::endl;
+        exit(1);
+    }
+
+    if (inputColorSpace.empty() || outputColorSpace.empty())
+    {
+        std::cerr << std::endl;
+        std::cerr << "Source and destination color space must be specified." << std::endl;
+        exit(1);
+    }
+
+    const char * env = OCIO::GetEnvVariable("OCIO");
+    if (!env || !*env)
+    {
+        std::cerr << std::endl;
+        std::cerr << "Missing the ${OCIO} env. variable." << std::endl;
+        exit(1);
+    }
+
+    try
+    {
+        OCIO::ConstConfigRcPtr config = OCIO::Config::CreateFromEnv();
+
+        if (verbose)
+        {
+            std::cout << std::endl;
+            std::cout << "OCIO Version: " << OCIO::GetVersion() << std::endl;
+            std::cout << "OCIO Configuration: '" << env << "'" << std::endl;
+            std::cout << "Processing from '" << inputColorSpace << "' to '"
+                      << outputColorSpace << "'" << std::endl;
+        }
+
+        OCIO::ConstProcessorRcPtr processor
+            = config->getProcessor(inputColorSpace.c_str(), outputColorSpace.c_str());
+
+        OCIO::ConstCPUProcessorRcPtr cpuProcessor = processor->getDefaultCPUProcessor();
+
+        std::ofstream outfs(filepath.c_str(), std::ios::out | std::ios::trunc);
+        if (!outfs)
+        {
+            std::cerr << std::endl;
+            std::cerr << "Could not open file: " << filepath << std::endl;
+            exit(1);
+        }
+
+        cpuProcessor->writeSourceCode(functionName.c_str(), outfs);
+        outfs.close();
+
+        if (verbose)
+        {
+            std::cout << "Cache identifier: " << cpuProcessor->getCacheID() << std::endl;
+        }
+    }
+    catch(OCIO::Exception & exception)
+    {
+        std::cerr << "OCIO Error: " << exception.what() << std::endl;
+        exit(1);
+    }
+    catch(...)
+    {
+        std::cerr << "Unknown OCIO error encountered." << std::endl;
+        exit(1);
+    }
+
+    return 0;
+}
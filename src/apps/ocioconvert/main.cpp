@@ -1,10 +1,18 @@
 // SPDX-License-Identifier: BSD-3-Clause
 // Copyright Contributors to the OpenColorIO Project.
 
+#include <algorithm>
+#include <atomic>
 #include <chrono>
+#include <condition_variable>
 #include <cstdlib>
+#include <deque>
+#include <future>
 #include <iostream>
+#include <memory>
+#include <mutex>
 #include <sstream>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -344,6 +352,536 @@ bool StringToInt(int * ival, const char * str);
 
 bool StringToVector(std::vector<int> * ivector, const char * str);
 
+// Set the provided OpenImageIO attributes, and return false on any parsing error.
+bool SetAttributes(OIIO::ImageSpec & spec,
+                   const std::vector<std::string> & floatAttrs,
+                   const std::vector<std::string> & intAttrs,
+                   const std::vector<std::string> & stringAttrs);
+
+// Convert the image chunk by chunk (i.e. bands of scanlines or rows of tiles) keeping at
+// most numChunks chunks in memory. The chunks are read in order, processed concurrently
+// by the internal thread pool of the CPU processing, and written in order by a dedicated
+// thread so the reading, the processing and the writing overlap.
+void StreamImage(const char * inputimage, const char * outputimage,
+                 const OCIO::ConstProcessorRcPtr & processor,
+                 const std::vector<std::string> & floatAttrs,
+                 const std::vector<std::string> & intAttrs,
+                 const std::vector<std::string> & stringAttrs,
+                 int chunkLines, int numChunks, bool verbose)
+{
+    if (chunkLines < 1 || numChunks < 1)
+    {
+        throw OCIO::Exception("The number of lines per chunk and the number of chunks "
+                              "must be positive.");
+    }
+
+    std::cout << std::endl;
+    std::cout << "Streaming " << inputimage << std::endl;
+
+#if OIIO_VERSION < 10903
+    std::unique_ptr<OIIO::ImageInput, void(*)(OIIO::ImageInput*)>
+        in(OIIO::ImageInput::create(inputimage), OIIO::ImageInput::destroy);
+#else
+    auto in = OIIO::ImageInput::create(inputimage);
+#endif
+    if (!in)
+    {
+        throw OCIO::Exception("Could not create image input.");
+    }
+
+    OIIO::ImageSpec spec;
+    if (!in->open(inputimage, spec))
+    {
+        std::string err("Error loading image ");
+        err += in->geterror();
+        throw OCIO::Exception(err.c_str());
+    }
+
+    OCIO::PrintImageSpec(spec, verbose);
+
+    if (spec.deep || spec.depth > 1)
+    {
+        throw OCIO::Exception("Deep and volume images are not supported by the streaming mode.");
+    }
+
+    // A chunk contains complete rows of tiles.
+    const bool tiled = spec.tile_width > 0 && spec.tile_height > 0;
+    if (tiled)
+    {
+        chunkLines = ((chunkLines + spec.tile_height - 1) / spec.tile_height) * spec.tile_height;
+    }
+    chunkLines = std::min(chunkLines, spec.height);
+
+    // The output is always written by scanlines, in order.
+    OIIO::ImageSpec outSpec = spec;
+    outSpec.tile_width  = 0;
+    outSpec.tile_height = 0;
+    outSpec.tile_depth  = 0;
+    if (!SetAttributes(outSpec, floatAttrs, intAttrs, stringAttrs))
+    {
+        throw OCIO::Exception("Invalid image attributes.");
+    }
+
+#if OIIO_VERSION < 10903
+    std::unique_ptr<OIIO::ImageOutput, void(*)(OIIO::ImageOutput*)>
+        out(OIIO::ImageOutput::create(outputimage), OIIO::ImageOutput::destroy);
+#else
+    auto out = OIIO::ImageOutput::create(outputimage);
+#endif
+    if (!out)
+    {
+        throw OCIO::Exception("Could not create output input.");
+    }
+
+    if (!out->open(outputimage, outSpec))
+    {
+        std::string err("Error writing \"");
+        err += outputimage;
+        err += "\" : ";
+        err += out->geterror();
+        throw OCIO::Exception(err.c_str());
+    }
+
+    const OCIO::BitDepth bitDepth = OCIO::GetBitDepth(spec);
+
+    OCIO::ConstCPUProcessorRcPtr cpuProcessor
+        = processor->getOptimizedCPUProcessor(bitDepth, bitDepth,
+                                              OCIO::OPTIMIZATION_DEFAULT,
+                                              OCIO::FINALIZATION_DEFAULT);
+
+    struct Chunk
+    {
+        OCIO::ImgBuffer      m_buffer;
+        OIIO::ImageSpec      m_spec;    // The specifications of the chunk lines.
+        OCIO::ImageDescRcPtr m_imgDesc;
+        int                  m_ybegin = 0;
+        int                  m_yend   = 0;
+        std::future<void>    m_done;    // The completion of the processing.
+    };
+
+    OIIO::ImageSpec chunkSpec = spec;
+    chunkSpec.height = chunkLines;
+
+    // Only numChunks chunks are allocated, and then recycled.
+    std::vector<std::unique_ptr<Chunk>> chunks;
+    std::vector<Chunk *> freeChunks;
+    for (int idx = 0; idx < numChunks; ++idx)
+    {
+        chunks.emplace_back(new Chunk);
+        chunks.back()->m_buffer.allocate(chunkSpec);
+        freeChunks.push_back(chunks.back().get());
+    }
+
+    std::deque<Chunk *> processingChunks; // The chunks to write, in order.
+    bool readDone = false;
+    std::string writeError;
+
+    std::mutex mutex;
+    std::condition_variable condition;
+
+    const std::chrono::high_resolution_clock::time_point start
+        = std::chrono::high_resolution_clock::now();
+
+    // Write the processed chunks in order.
+    std::thread writer([&]()
+    {
+        while (true)
+        {
+            Chunk * chunk = nullptr;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                condition.wait(lock, [&]() { return readDone || !processingChunks.empty(); });
+                if (processingChunks.empty())
+                {
+                    return;
+                }
+                chunk = processingChunks.front();
+                processingChunks.pop_front();
+            }
+
+            std::string error;
+            try
+            {
+                chunk->m_done.get();
+
+                if (writeError.empty()
+                    && !out->write_scanlines(chunk->m_ybegin, chunk->m_yend, spec.z,
+                                             spec.format, chunk->m_buffer.getBuffer()))
+                {
+                    error = "Error writing \"";
+                    error += outputimage;
+                    error += "\" : ";
+                    error += out->geterror();
+                }
+            }
+            catch (std::exception & ex)
+            {
+                error = ex.what();
+            }
+
+            std::lock_guard<std::mutex> lock(mutex);
+            if (!error.empty() && writeError.empty())
+            {
+                writeError = error;
+            }
+            freeChunks.push_back(chunk);
+            condition.notify_all();
+        }
+    });
+
+    // Read the chunks in order, and start their processing.
+    std::string readError;
+    for (int ybegin = spec.y; ybegin < spec.y + spec.height; ybegin += chunkLines)
+    {
+        Chunk * chunk = nullptr;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            condition.wait(lock, [&]() { return !freeChunks.empty(); });
+            if (!writeError.empty())
+            {
+                break;
+            }
+            chunk = freeChunks.back();
+            freeChunks.pop_back();
+        }
+
+        chunk->m_ybegin = ybegin;
+        chunk->m_yend   = std::min(ybegin + chunkLines, spec.y + spec.height);
+
+        try
+        {
+            const bool ok
+                = tiled ? in->read_tiles(spec.x, spec.x + spec.width,
+                                         chunk->m_ybegin, chunk->m_yend,
+                                         spec.z, spec.z + 1,
+                                         spec.format, chunk->m_buffer.getBuffer())
+                        : in->read_scanlines(chunk->m_ybegin, chunk->m_yend, spec.z,
+                                             spec.format, chunk->m_buffer.getBuffer());
+            if (!ok)
+            {
+                readError = "Error reading \"";
+                readError += inputimage;
+                readError += "\" : ";
+                readError += in->geterror();
+                break;
+            }
+
+            chunk->m_spec = chunkSpec;
+            chunk->m_spec.height = chunk->m_yend - chunk->m_ybegin;
+            chunk->m_imgDesc = OCIO::CreateImageDesc(chunk->m_spec, chunk->m_buffer);
+
+            // Apply the color transformation (in place).
+            chunk->m_done = cpuProcessor->applyAsync(*chunk->m_imgDesc);
+        }
+        catch (std::exception & ex)
+        {
+            // Stop reading, but the writer thread must first complete.
+            readError = ex.what();
+            break;
+        }
+
+        std::lock_guard<std::mutex> lock(mutex);
+        processingChunks.push_back(chunk);
+        condition.notify_all();
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        readDone = true;
+        condition.notify_all();
+    }
+    writer.join();
+
+    if (!readError.empty())
+    {
+        throw OCIO::Exception(readError.c_str());
+    }
+    if (!writeError.empty())
+    {
+        throw OCIO::Exception(writeError.c_str());
+    }
+
+    if (!out->close())
+    {
+        std::string err("Error writing \"");
+        err += outputimage;
+        err += "\" : ";
+        err += out->geterror();
+        throw OCIO::Exception(err.c_str());
+    }
+
+    if (verbose)
+    {
+        const std::chrono::duration<float, std::milli> duration
+            = std::chrono::high_resolution_clock::now() - start;
+
+        std::cout << std::endl;
+        std::cout << "Streaming " << spec.height << " lines by chunks of " << chunkLines
+                  << " lines took: " << duration.count() << " ms" << std::endl;
+    }
+}
+
+// Convert the complete image using the internal thread pool of the CPU processing.
+void ConvertImage(const char * inputimage, const char * outputimage,
+                  const OCIO::ConstProcessorRcPtr & processor,
+                  const std::vector<std::string> & floatAttrs,
+                  const std::vector<std::string> & intAttrs,
+                  const std::vector<std::string> & stringAttrs)
+{
+#if OIIO_VERSION < 10903
+    std::unique_ptr<OIIO::ImageInput, void(*)(OIIO::ImageInput*)>
+        in(OIIO::ImageInput::create(inputimage), OIIO::ImageInput::destroy);
+#else
+    auto in = OIIO::ImageInput::create(inputimage);
+#endif
+    if (!in)
+    {
+        throw OCIO::Exception("Could not create image input.");
+    }
+
+    OIIO::ImageSpec spec;
+    OCIO::ImgBuffer img;
+
+    bool ok = in->open(inputimage, spec);
+    if (ok)
+    {
+        img.allocate(spec);
+        ok = in->read_image(spec.format, img.getBuffer());
+    }
+
+    if (!ok)
+    {
+        std::string err("Error reading \"");
+        err += inputimage;
+        err += "\" : ";
+        err += in->geterror();
+        throw OCIO::Exception(err.c_str());
+    }
+    in->close();
+
+    const OCIO::BitDepth bitDepth = OCIO::GetBitDepth(spec);
+
+    // The CPU processors are cached by the processor so all the frames having the same
+    // bit-depth share the same one.
+    OCIO::ConstCPUProcessorRcPtr cpuProcessor
+        = processor->getOptimizedCPUProcessor(bitDepth, bitDepth,
+                                              OCIO::OPTIMIZATION_DEFAULT,
+                                              OCIO::FINALIZATION_DEFAULT);
+
+    OCIO::ImageDescRcPtr imgDesc = OCIO::CreateImageDesc(spec, img);
+    cpuProcessor->apply(*imgDesc, OCIO::CPUExecutor());
+
+    if (!SetAttributes(spec, floatAttrs, intAttrs, stringAttrs))
+    {
+        throw OCIO::Exception("Invalid image attributes.");
+    }
+
+#if OIIO_VERSION < 10903
+    std::unique_ptr<OIIO::ImageOutput, void(*)(OIIO::ImageOutput*)>
+        out(OIIO::ImageOutput::create(outputimage), OIIO::ImageOutput::destroy);
+#else
+    auto out = OIIO::ImageOutput::create(outputimage);
+#endif
+    if (!out)
+    {
+        throw OCIO::Exception("Could not create output input.");
+    }
+
+    if (!out->open(outputimage, spec)
+        || !out->write_image(spec.format, img.getBuffer())
+        || !out->close())
+    {
+        std::string err("Error writing \"");
+        err += outputimage;
+        err += "\" : ";
+        err += out->geterror();
+        throw OCIO::Exception(err.c_str());
+    }
+}
+
+// Get the filepath of a frame from a sequence filepath where the frame number is
+// either a sequence of '#' (i.e. one per digit) or a printf-like '%0Nd'.
+std::string GetFramePath(const std::string & sequencePath, int frame)
+{
+    std::string path(sequencePath);
+
+    size_t pos = path.find('#');
+    size_t len = 0;
+    int padding = 0;
+    if (pos != std::string::npos)
+    {
+        len = path.find_first_not_of('#', pos);
+        len = (len == std::string::npos ? path.size() : len) - pos;
+        padding = int(len);
+    }
+    else
+    {
+        pos = path.find('%');
+        if (pos == std::string::npos)
+        {
+            std::string err("Missing the frame number (i.e. '#' or '%0Nd') in: ");
+            err += sequencePath;
+            throw OCIO::Exception(err.c_str());
+        }
+
+        const size_t end = path.find('d', pos);
+        if (end == std::string::npos
+            || path.find_first_not_of("0123456789", pos + 1) != end)
+        {
+            std::string err("Invalid frame number format in: ");
+            err += sequencePath;
+            throw OCIO::Exception(err.c_str());
+        }
+
+        len = end + 1 - pos;
+        padding = end > pos + 1 ? std::atoi(path.substr(pos + 1, end - pos - 1).c_str()) : 0;
+    }
+
+    std::ostringstream number;
+    if (frame < 0)
+    {
+        number << "-";
+        --padding;
+    }
+    number.width(std::max(padding, 0));
+    number.fill('0');
+    number << std::abs(frame);
+
+    return path.replace(pos, len, number.str());
+}
+
+// Parse a frame range i.e. 'first-last' with an optional step (e.g. '1001-1100x2').
+std::vector<int> ParseFrameRange(const std::string & range)
+{
+    int first = 0;
+    int last = 0;
+    int step = 1;
+    char sep = 0;
+    char stepSep = 0;
+
+    std::istringstream iss(range);
+    if (!(iss >> first))
+    {
+        throw OCIO::Exception("Invalid frame range.");
+    }
+
+    last = first;
+    if (iss >> sep)
+    {
+        if (sep != '-' || !(iss >> last)
+            || ((iss >> stepSep) && (stepSep != 'x' || !(iss >> step))))
+        {
+            throw OCIO::Exception("Invalid frame range.");
+        }
+    }
+
+    if (last < first || step < 1)
+    {
+        throw OCIO::Exception("Invalid frame range.");
+    }
+
+    std::vector<int> frames;
+    for (int frame = first; frame <= last; frame += step)
+    {
+        frames.push_back(frame);
+    }
+    return frames;
+}
+
+// Convert all the frames of a sequence using the same processor (i.e. the config and
+// the processor are only loaded and finalized once). Several frames are concurrently
+// converted so the reading and the writing of a frame overlap with the processing of
+// the others, while at most numFrames frames (or chunks of frames when streaming)
+// are in memory.
+void ConvertSequence(const std::string & inputSequence, const std::string & outputSequence,
+                     const std::vector<int> & frames,
+                     const OCIO::ConstProcessorRcPtr & processor,
+                     const std::vector<std::string> & floatAttrs,
+                     const std::vector<std::string> & intAttrs,
+                     const std::vector<std::string> & stringAttrs,
+                     int numFrames, bool streaming, int chunkLines, int numChunks)
+{
+    if (numFrames < 1)
+    {
+        throw OCIO::Exception("The number of concurrent frames must be positive.");
+    }
+
+    // Validate the filepaths before starting.
+    GetFramePath(inputSequence, frames.front());
+    GetFramePath(outputSequence, frames.front());
+
+    std::atomic<size_t> nextFrame(0);
+    std::atomic<bool> failed(false);
+
+    std::mutex mutex;
+    std::string error;
+
+    const std::chrono::high_resolution_clock::time_point start
+        = std::chrono::high_resolution_clock::now();
+
+    auto worker = [&]()
+    {
+        size_t idx = 0;
+        while (!failed && (idx = nextFrame++) < frames.size())
+        {
+            const std::string inputimage  = GetFramePath(inputSequence, frames[idx]);
+            const std::string outputimage = GetFramePath(outputSequence, frames[idx]);
+
+            try
+            {
+                if (streaming)
+                {
+                    StreamImage(inputimage.c_str(), outputimage.c_str(), processor,
+                                floatAttrs, intAttrs, stringAttrs,
+                                chunkLines, numChunks, false);
+                }
+                else
+                {
+                    ConvertImage(inputimage.c_str(), outputimage.c_str(), processor,
+                                 floatAttrs, intAttrs, stringAttrs);
+                }
+
+                std::lock_guard<std::mutex> lock(mutex);
+                std::cout << "Wrote " << outputimage << std::endl;
+            }
+            catch (std::exception & ex)
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (!failed)
+                {
+                    error = "Frame " + std::to_string(frames[idx]) + ": " + ex.what();
+                    failed = true;
+                }
+            }
+        }
+    };
+
+    std::vector<std::thread> workers;
+    const size_t numWorkers = std::min(size_t(numFrames), frames.size());
+    for (size_t idx = 1; idx < numWorkers; ++idx)
+    {
+        workers.emplace_back(worker);
+    }
+    worker();
+    for (auto & thread : workers)
+    {
+        thread.join();
+    }
+
+    if (failed)
+    {
+        throw OCIO::Exception(error.c_str());
+    }
+
+    const std::chrono::duration<float, std::milli> duration
+        = std::chrono::high_resolution_clock::now() - start;
+
+    std::cout << std::endl;
+    std::cout << "Converted " << frames.size() << " frames in " << duration.count()
+              << " ms (" << duration.count() / float(frames.size()) << " ms per frame)"
+              << std::endl;
+}
+
 int main(int argc, const char **argv)
 {
     ArgParse ap;
@@ -356,6 +894,11 @@ int main(int argc, const char **argv)
     bool usegpu = false;
     bool usegpuLegacy = false;
     bool outputgpuInfo = false;
+    bool streaming = false;
+    int chunkLines = 64;
+    int numChunks = 4;
+    std::string frameRange;
+    int numFrames = 2;
     bool verbose = false;
 
     ap.options("ocioconvert -- apply colorspace transform to an image \n\n"
@@ -371,6 +914,19 @@ int main(int argc, const char **argv)
                "--gpulegacy", &usegpuLegacy, "Use the legacy (i.e. baked) GPU color processing "
                                              "instead of the CPU one (--gpu is ignored)",
                "--gpuinfo", &outputgpuInfo, "Output the OCIO shader program",
+               "--stream", &streaming, "Convert the image chunk by chunk (i.e. scanlines or "
+                                       "rows of tiles) using a bounded memory, the reading, "
+                                       "the processing and the writing overlapping",
+               "--chunklines %d", &chunkLines, "Number of lines per chunk of the streaming mode "
+                                               "(rounded up to the tile height). Default is 64",
+               "--chunks %d", &numChunks, "Maximum number of chunks in memory of the streaming "
+                                          "mode. Default is 4",
+               "--frames %s", &frameRange, "Convert the frames of an image sequence (e.g. "
+                                           "1001-1100 or 1001-1100x2) where the image filepaths "
+                                           "contain '#' (one per digit) or '%04d' for the frame "
+                                           "number. The config and the processor are only loaded once",
+               "--parallelframes %d", &numFrames, "Maximum number of frames concurrently converted "
+                                                  "by the sequence mode. Default is 2",
                "--v", &verbose, "Display general information",
                NULL
                );
@@ -425,6 +981,82 @@ int main(int argc, const char **argv)
     const char * inputcolorspace = args[1].c_str();
     const char * outputimage = args[2].c_str();
     const char * outputcolorspace = args[3].c_str();
+
+    if (!frameRange.empty())
+    {
+        if (usegpu || usegpuLegacy || croptofull || !keepChannels.empty())
+        {
+            std::cerr << "Error: The sequence mode only supports the CPU processing "
+                      << "of the complete images." << std::endl;
+            exit(1);
+        }
+
+        try
+        {
+            const std::vector<int> frames = ParseFrameRange(frameRange);
+
+            // Load the config and create the processor only once for all the frames.
+            OCIO::ConstConfigRcPtr config = OCIO::GetCurrentConfig();
+            OCIO::ConstProcessorRcPtr processor
+                = config->getProcessor(inputcolorspace, outputcolorspace);
+
+            std::cout << std::endl;
+            std::cout << "Converting " << frames.size() << " frames of " << inputimage
+                      << std::endl;
+
+            ConvertSequence(inputimage, outputimage, frames, processor,
+                            floatAttrs, intAttrs, stringAttrs,
+                            numFrames, streaming, chunkLines, numChunks);
+        }
+        catch(OCIO::Exception & exception)
+        {
+            std::cerr << "OCIO Error: " << exception.what() << std::endl;
+            exit(1);
+        }
+        catch(...)
+        {
+            std::cerr << "Unknown OCIO error encountered." << std::endl;
+            exit(1);
+        }
+
+        return 0;
+    }
+
+    if (streaming)
+    {
+        if (usegpu || usegpuLegacy || croptofull || !keepChannels.empty())
+        {
+            std::cerr << "Error: The streaming mode only supports the CPU processing "
+                      << "of the complete image." << std::endl;
+            exit(1);
+        }
+
+        try
+        {
+            OCIO::ConstConfigRcPtr config = OCIO::GetCurrentConfig();
+            OCIO::ConstProcessorRcPtr processor
+                = config->getProcessor(inputcolorspace, outputcolorspace);
+
+            StreamImage(inputimage, outputimage, processor,
+                        floatAttrs, intAttrs, stringAttrs,
+                        chunkLines, numChunks, verbose);
+        }
+        catch(OCIO::Exception & exception)
+        {
+            std::cerr << "OCIO Error: " << exception.what() << std::endl;
+            exit(1);
+        }
+        catch(...)
+        {
+            std::cerr << "Unknown OCIO error encountered." << std::endl;
+            exit(1);
+        }
+
+        std::cout << std::endl;
+        std::cout << "Wrote " << outputimage << std::endl;
+
+        return 0;
+    }
     
     OIIO::ImageSpec spec;
     OCIO::ImgBuffer img;
@@ -679,52 +1311,7 @@ int main(int argc, const char **argv)
     //
     // set the provided OpenImageIO attributes
     //
-    bool parseerror = false;
-    for(unsigned int i=0; i<floatAttrs.size(); ++i)
-    {
-        std::string name, value;
-        float fval = 0.0f;
-        
-        if(!ParseNameValuePair(name, value, floatAttrs[i]) ||
-           !StringToFloat(&fval,value.c_str()))
-        {
-            std::cerr << "Error: attribute string '" << floatAttrs[i] << "' should be in the form name=floatvalue\n";
-            parseerror = true;
-            continue;
-        }
-        
-        spec.attribute(name, fval);
-    }
-    
-    for(unsigned int i=0; i<intAttrs.size(); ++i)
-    {
-        std::string name, value;
-        int ival = 0;
-        if(!ParseNameValuePair(name, value, intAttrs[i]) ||
-           !StringToInt(&ival,value.c_str()))
-        {
-            std::cerr << "Error: attribute string '" << intAttrs[i] << "' should be in the form name=intvalue\n";
-            parseerror = true;
-            continue;
-        }
-        
-        spec.attribute(name, ival);
-    }
-    
-    for(unsigned int i=0; i<stringAttrs.size(); ++i)
-    {
-        std::string name, value;
-        if(!ParseNameValuePair(name, value, stringAttrs[i]))
-        {
-            std::cerr << "Error: attribute string '" << stringAttrs[i] << "' should be in the form name=value\n";
-            parseerror = true;
-            continue;
-        }
-        
-        spec.attribute(name, value);
-    }
-   
-    if(parseerror)
+    if(!SetAttributes(spec, floatAttrs, intAttrs, stringAttrs))
     {
         exit(1);
     }
@@ -834,6 +1421,55 @@ bool StringToVector(std::vector<int> * ivector, const char * str)
     return ivector->size() != 0;
 }
 
+bool SetAttributes(OIIO::ImageSpec & spec,
+                   const std::vector<std::string> & floatAttrs,
+                   const std::vector<std::string> & intAttrs,
+                   const std::vector<std::string> & stringAttrs)
+{
+    bool parseerror = false;
+    for(unsigned int i=0; i<floatAttrs.size(); ++i)
+    {
+        std::string name, value;
+        float fval = 0.0f;
+        
+        if(!ParseNameValuePair(name, value, floatAttrs[i]) ||
+           !StringToFloat(&fval,value.c_str()))
+        {
+            std::cerr << "Error: attribute string '" << floatAttrs[i] << "' should be in the form name=floatvalue\n";
+            parseerror = true;
+            continue;
+        }
+        
+        spec.attribute(name, fval);
+    }
+    
+    for(unsigned int i=0; i<intAttrs.size(); ++i)
+    {
+        std::string name, value;
+        int ival = 0;
+        if(!ParseNameValuePair(name, value, intAttrs[i]) ||
+           !StringToInt(&ival,value.c_str()))
+        {
+            std::cerr << "Error: attribute string '" << intAttrs[i] << "' should be in the form name=intvalue\n";
+            parseerror = true;
+            continue;
+        }
+        
+        spec.attribute(name, ival);
+    }
+    
+    for(unsigned int i=0; i<stringAttrs.size(); ++i)
+    {
+        std::string name, value;
+        if(!ParseNameValuePair(name, value, stringAttrs[i]))
+        {
+            std::cerr << "Error: attribute string '" << stringAttrs[i] << "' should be in the form name=value\n";
+            parseerror = true;
+            continue;
+        }
+        
+        spec.attribute(name, value);
+    }
 
-
-
+    return !parseerror;
+}
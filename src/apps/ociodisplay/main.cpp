@@ -2,10 +2,13 @@
 // Copyright Contributors to the OpenColorIO Project.
 
 
+#include <algorithm>
+#include <chrono>
 #include <cstdlib>
 #include <cmath>
 #include <cstdio>
 #include <cstring>
+#include <future>
 #include <iostream>
 #include <fstream>
 #include <sstream>
@@ -35,6 +38,8 @@ namespace OCIO = OCIO_NAMESPACE;
 bool g_verbose   = false;
 bool g_gpulegacy = false;
 bool g_gpuinfo   = false;
+bool g_syncbuild = false;
+bool g_nopbo     = false;
 
 std::string g_filename;
 
@@ -61,6 +66,7 @@ int g_channelHot[4] = { 1, 1, 1, 1 };  // show rgb
 
 
 void UpdateOCIOGLState();
+void UpdateDynamicProperties();
 
 static void InitImageTexture(const char * filename)
 {
@@ -325,6 +331,10 @@ static void Key(unsigned char key, int /*x*/, int /*y*/)
         CleanUp();
         exit(0);
     }
+    else
+    {
+        return;
+    }
     
     UpdateOCIOGLState();
     glutPostRedisplay();
@@ -365,8 +375,13 @@ static void SpecialKey(int key, int x, int y)
         g_exposure_fstop = 0.0f;
         g_display_gamma = 1.0f;
     }
+    else
+    {
+        return;
+    }
     
-    UpdateOCIOGLState();
+    // The exposure & gamma are dynamic properties i.e. no processor rebuild is needed.
+    UpdateDynamicProperties();
     
     glutPostRedisplay();
 }
@@ -382,122 +397,258 @@ const char * g_fragShaderText = ""
 "}\n";
 
 
-void UpdateOCIOGLState()
+// The display pipeline settings needing a new processor. The exposure & the gamma are
+// not part of it as they are dynamic properties only updating the shader uniforms.
+struct DisplayPipeline
+{
+    std::string m_inputColorSpace;
+    std::string m_display;
+    std::string m_view;
+    std::string m_look;
+    int m_channelHot[4];
+};
+
+// The part of a shader update which does not need the OpenGL context i.e. the processor
+// creation and the shader program information extraction (including the LUT baking).
+struct ShaderBuild
+{
+    OCIO::ConstGPUProcessorRcPtr m_gpuProcessor;
+    OCIO::GpuShaderDescRcPtr m_shaderDesc;
+};
+
+// The processor currently used, to update its dynamic properties.
+OCIO::ConstGPUProcessorRcPtr g_gpuProcessor;
+
+// The shader build running on a background thread, if any.
+std::future<ShaderBuild> g_pendingBuild;
+// The settings changed again while building i.e. the pending build is already stale.
+bool g_rebuildRequested = false;
+
+// The delay (in milliseconds) between the polls of a pending shader build.
+const unsigned int BUILD_POLL_DELAY = 5;
+
+DisplayPipeline GetDisplayPipeline()
+{
+    DisplayPipeline pipeline;
+    pipeline.m_inputColorSpace = g_inputColorSpace;
+    pipeline.m_display         = g_display;
+    pipeline.m_view            = g_transformName;
+    pipeline.m_look            = g_look;
+    for(int i=0; i<4; ++i)
+    {
+        pipeline.m_channelHot[i] = g_channelHot[i];
+    }
+    return pipeline;
+}
+
+// Note: It could be called from any thread.
+ShaderBuild BuildShader(const DisplayPipeline & pipeline)
 {
     // Step 0: Get the processor using any of the pipelines mentioned above.
     OCIO::ConstConfigRcPtr config = OCIO::GetCurrentConfig();
     
     OCIO::DisplayTransformRcPtr transform = OCIO::DisplayTransform::Create();
-    transform->setInputColorSpaceName( g_inputColorSpace.c_str() );
-    transform->setDisplay( g_display.c_str() );
-    transform->setView( g_transformName.c_str() );
-    transform->setLooksOverride( g_look.c_str() );
-
-    if(g_verbose)
-    {
-        std::cout << std::endl;
-        std::cout << "Color transformation composed of:" << std::endl;
-        std::cout << "      Image ColorSpace is:\t" << g_inputColorSpace << std::endl;
-        std::cout << "      Transform is:\t\t" << g_transformName << std::endl;
-        std::cout << "      Device is:\t\t" << g_display << std::endl;
-        std::cout << "      Looks Override is:\t'" << g_look << "'" << std::endl;
-        std::cout << "  with:" << std::endl;
-        std::cout << "    exposure_fstop = " << g_exposure_fstop << std::endl;
-        std::cout << "    display_gamma  = " << g_display_gamma << std::endl;
-        std::cout << "    channels       = " 
-                  << (g_channelHot[0] ? "R" : "")
-                  << (g_channelHot[1] ? "G" : "")
-                  << (g_channelHot[2] ? "B" : "")
-                  << (g_channelHot[3] ? "A" : "") << std::endl;
+    transform->setInputColorSpaceName( pipeline.m_inputColorSpace.c_str() );
+    transform->setDisplay( pipeline.m_display.c_str() );
+    transform->setView( pipeline.m_view.c_str() );
+    transform->setLooksOverride( pipeline.m_look.c_str() );
 
-    }
-    
     // Add optional transforms to create a full-featured, "canonical" display pipeline
     // Fstop exposure control (in SCENE_LINEAR)
     {
-        double gain = powf(2.0f, g_exposure_fstop);
-        const double slope4f[] = { gain, gain, gain, gain };
-        double m44[16];
-        double offset4[4];
-        OCIO::MatrixTransform::Scale(m44, offset4, slope4f);
-        OCIO::MatrixTransformRcPtr mtx =  OCIO::MatrixTransform::Create();
-        mtx->setMatrix(m44);
-        mtx->setOffset(offset4);
-        transform->setLinearCC(mtx);
+        OCIO::ExposureContrastTransformRcPtr exposure = OCIO::ExposureContrastTransform::Create();
+        exposure->setStyle(OCIO::EXPOSURE_CONTRAST_LINEAR);
+        exposure->makeExposureDynamic();
+        transform->setLinearCC(exposure);
     }
     
     // Channel swizzling
     {
+        int channelHot[4] = { pipeline.m_channelHot[0], pipeline.m_channelHot[1],
+                              pipeline.m_channelHot[2], pipeline.m_channelHot[3] };
         double lumacoef[3];
         config->getDefaultLumaCoefs(lumacoef);
         double m44[16];
         double offset[4];
-        OCIO::MatrixTransform::View(m44, offset, g_channelHot, lumacoef);
+        OCIO::MatrixTransform::View(m44, offset, channelHot, lumacoef);
         OCIO::MatrixTransformRcPtr swizzle = OCIO::MatrixTransform::Create();
         swizzle->setMatrix(m44);
         swizzle->setOffset(offset);
         transform->setChannelView(swizzle);
     }
     
-    // Post-display transform gamma
+    // Post-display transform gamma (i.e. out = pow(in, gamma) with a pivot of 1)
     {
-        double exponent = 1.0/std::max(1e-6, static_cast<double>(g_display_gamma));
-        const double exponent4f[4] = { exponent, exponent, exponent, exponent };
-        OCIO::ExponentTransformRcPtr expTransform =  OCIO::ExponentTransform::Create();
-        expTransform->setValue(exponent4f);
-        transform->setDisplayCC(expTransform);
+        OCIO::ExposureContrastTransformRcPtr gamma = OCIO::ExposureContrastTransform::Create();
+        gamma->setStyle(OCIO::EXPOSURE_CONTRAST_LINEAR);
+        gamma->setPivot(1.0);
+        gamma->makeGammaDynamic();
+        transform->setDisplayCC(gamma);
     }
     
-    OCIO::ConstProcessorRcPtr processor;
-    try
-    {
-        processor = config->getProcessor(transform);
-    }
-    catch(OCIO::Exception & e)
-    {
-        std::cerr << e.what() << std::endl;
-        return;
-    }
-    catch(...)
-    {
-        return;
-    }
+    ShaderBuild build;
+
+    OCIO::ConstProcessorRcPtr processor = config->getProcessor(transform);
     
     // Step 1: Create the appropriate GPU shader description
-    OCIO::GpuShaderDescRcPtr shaderDesc 
+    build.m_shaderDesc 
         = g_gpulegacy ? OCIO::GpuShaderDesc::CreateLegacyShaderDesc(LUT3D_EDGE_SIZE)
                       : OCIO::GpuShaderDesc::CreateShaderDesc();
-    shaderDesc->setLanguage(OCIO::GPU_LANGUAGE_GLSL_1_0);
-    shaderDesc->setFunctionName("OCIODisplay");
-    shaderDesc->setResourcePrefix("ocio_");
+    build.m_shaderDesc->setLanguage(OCIO::GPU_LANGUAGE_GLSL_1_0);
+    build.m_shaderDesc->setFunctionName("OCIODisplay");
+    build.m_shaderDesc->setResourcePrefix("ocio_");
 
     // Step 2: Collect the shader program information for a specific processor    
-    OCIO::ConstGPUProcessorRcPtr gpuProcessor
-        = processor->getDefaultGPUProcessor();
-    gpuProcessor->extractGpuShaderInfo(shaderDesc);
+    build.m_gpuProcessor = processor->getDefaultGPUProcessor();
+    build.m_gpuProcessor->extractGpuShaderInfo(build.m_shaderDesc);
+
+    return build;
+}
+
+// Note: It must be called from the OpenGL thread.
+void ApplyShaderBuild(const ShaderBuild & build)
+{
+    const auto start = std::chrono::steady_clock::now();
 
     // Step 3: Use the helper OpenGL builder
-    g_oglBuilder = OCIO::OpenGLBuilder::Create(shaderDesc);
-    g_oglBuilder->setVerbose(g_gpuinfo);
+    OCIO::OpenGLBuilderRcPtr oglBuilder = OCIO::OpenGLBuilder::Create(build.m_shaderDesc);
+    oglBuilder->setVerbose(g_gpuinfo);
+    oglBuilder->setUsePixelBuffers(!g_nopbo);
 
     // Step 4: Allocate & upload all the LUTs
     // 
     // NB: The start index for the texture indices is 1 as one texture
     //     was already created for the input image.
     //     
-    g_oglBuilder->allocateAllTextures(1);
+    oglBuilder->allocateAllTextures(1);
     
     // Step 5: Build the fragment shader program
-    g_oglBuilder->buildProgram(g_fragShaderText);
+    oglBuilder->buildProgram(g_fragShaderText);
 
     // Step 6: Enable the fragment shader program, and all needed textures
-    g_oglBuilder->useProgram();
+    oglBuilder->useProgram();
     // The image texture
-    glUniform1i(glGetUniformLocation(g_oglBuilder->getProgramHandle(), "tex1"), 0);
+    glUniform1i(glGetUniformLocation(oglBuilder->getProgramHandle(), "tex1"), 0);
     // The LUT textures
-    g_oglBuilder->useAllTextures();
+    oglBuilder->useAllTextures();
+
+    g_oglBuilder = oglBuilder;
+    g_gpuProcessor = build.m_gpuProcessor;
+
     // Enable uniforms for dynamic properties
+    UpdateDynamicProperties();
+
+    if(g_verbose)
+    {
+        const std::chrono::duration<float, std::milli> duration
+            = std::chrono::steady_clock::now() - start;
+        std::cout << "  OpenGL update:  " << duration.count() << " ms" << std::endl;
+    }
+}
+
+void UpdateDynamicProperties()
+{
+    if(!g_gpuProcessor || !g_oglBuilder)
+    {
+        return;
+    }
+
+    g_gpuProcessor->getDynamicProperty(OCIO::DYNAMIC_PROPERTY_EXPOSURE)
+        ->setValue(g_exposure_fstop);
+    g_gpuProcessor->getDynamicProperty(OCIO::DYNAMIC_PROPERTY_GAMMA)
+        ->setValue(1.0/std::max(1e-6, static_cast<double>(g_display_gamma)));
+
     g_oglBuilder->useAllUniforms();
+
+    if(g_verbose)
+    {
+        std::cout << "    exposure_fstop = " << g_exposure_fstop << std::endl;
+        std::cout << "    display_gamma  = " << g_display_gamma << std::endl;
+    }
+}
+
+void PollShaderBuild(int /*value*/)
+{
+    if(g_pendingBuild.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+    {
+        glutTimerFunc(BUILD_POLL_DELAY, PollShaderBuild, 0);
+        return;
+    }
+
+    try
+    {
+        const ShaderBuild build = g_pendingBuild.get();
+
+        // Do not spend the OpenGL upload & compilation on outdated settings.
+        if(!g_rebuildRequested)
+        {
+            ApplyShaderBuild(build);
+            glutPostRedisplay();
+        }
+    }
+    catch(OCIO::Exception & e)
+    {
+        std::cerr << e.what() << std::endl;
+    }
+    catch(...)
+    {
+    }
+
+    if(g_rebuildRequested)
+    {
+        g_rebuildRequested = false;
+        UpdateOCIOGLState();
+    }
+}
+
+// Update the shader program after a change of the display pipeline settings. The processor
+// is built on a background thread so the viewer stays responsive, and the OpenGL part of
+// the update is then performed by the OpenGL thread.
+void UpdateOCIOGLState()
+{
+    if(g_pendingBuild.valid())
+    {
+        // Only the latest settings matter, so build them once the pending build completes.
+        g_rebuildRequested = true;
+        return;
+    }
+
+    const DisplayPipeline pipeline = GetDisplayPipeline();
+
+    if(g_verbose)
+    {
+        std::cout << std::endl;
+        std::cout << "Color transformation composed of:" << std::endl;
+        std::cout << "      Image ColorSpace is:\t" << pipeline.m_inputColorSpace << std::endl;
+        std::cout << "      Transform is:\t\t" << pipeline.m_view << std::endl;
+        std::cout << "      Device is:\t\t" << pipeline.m_display << std::endl;
+        std::cout << "      Looks Override is:\t'" << pipeline.m_look << "'" << std::endl;
+        std::cout << "  with:" << std::endl;
+        std::cout << "    channels       = " 
+                  << (pipeline.m_channelHot[0] ? "R" : "")
+                  << (pipeline.m_channelHot[1] ? "G" : "")
+                  << (pipeline.m_channelHot[2] ? "B" : "")
+                  << (pipeline.m_channelHot[3] ? "A" : "") << std::endl;
+    }
+
+    if(g_syncbuild)
+    {
+        try
+        {
+            ApplyShaderBuild(BuildShader(pipeline));
+        }
+        catch(OCIO::Exception & e)
+        {
+            std::cerr << e.what() << std::endl;
+        }
+        catch(...)
+        {
+        }
+        return;
+    }
+
+    g_pendingBuild = std::async(std::launch::async, BuildShader, pipeline);
+    glutTimerFunc(BUILD_POLL_DELAY, PollShaderBuild, 0);
 }
 
 void menuCallback(int /*id*/)
@@ -643,6 +794,7 @@ const char * USAGE_TEXT = "\n"
 "\tAlt+Up:    Gamma up (post display transform)\n"
 "\tAlt+Down:  Gamma down (post display transform)\n"
 "\tAlt+Home:  Reset Exposure + Gamma\n"
+"\t(The exposure & gamma are shader uniforms i.e. no processor rebuild)\n"
 "\n"
 "\tC:   View Color\n"
 "\tR:   View Red  \n"
@@ -671,6 +823,14 @@ void parseArguments(int argc, char **argv)
         {
             g_gpuinfo = true;
         }
+        else if(0==strcmp(argv[i], "-syncbuild"))
+        {
+            g_syncbuild = true;
+        }
+        else if(0==strcmp(argv[i], "-nopbo"))
+        {
+            g_nopbo = true;
+        }
         else if(0==strcmp(argv[i], "-h"))
         {
             std::cout << std::endl;
@@ -682,6 +842,9 @@ void parseArguments(int argc, char **argv)
             std::cout << "     -v         :  displays the color space information" << std::endl;
             std::cout << "     -gpulegacy :  use the legacy (i.e. baked) GPU color processing" << std::endl;
             std::cout << "     -gpuinfo   :  output the OCIO shader program" << std::endl;
+            std::cout << "     -syncbuild :  build the processors on the OpenGL thread instead of a" << std::endl;
+            std::cout << "                   background thread" << std::endl;
+            std::cout << "     -nopbo     :  upload the LUT textures without pixel buffer objects" << std::endl;
              std::cout << std::endl;
             exit(0);
         }
@@ -711,6 +874,11 @@ int main(int argc, char **argv)
         std::cerr << "OpenGL 2.0 not supported" << std::endl;
         exit(1);
     }
+    // The pixel buffer objects are part of OpenGL 2.1.
+    if (!g_nopbo && !glewIsSupported("GL_VERSION_2_1"))
+    {
+        g_nopbo = true;
+    }
 #endif
     
     glutReshapeFunc(Reshape);
@@ -780,7 +948,8 @@ int main(int argc, char **argv)
     
     try
     {
-        UpdateOCIOGLState();
+        // The first shader program is built before entering the main loop.
+        ApplyShaderBuild(BuildShader(GetDisplayPipeline()));
     }
     catch(OCIO::Exception & e)
     {
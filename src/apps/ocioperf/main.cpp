@@ -1,7 +1,16 @@
 // SPDX-License-Identifier: BSD-3-Clause
 // Copyright Contributors to the OpenColorIO Project.
 
+#include <algorithm>
 #include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <vector>
 
 #include <OpenColorIO/OpenColorIO.h>
 
@@ -11,7 +20,21 @@
 namespace OIIO = OIIO_NAMESPACE;
 #endif
 
+#ifdef __APPLE__
+#include <OpenGL/gl.h>
+#include <OpenGL/glext.h>
+#include <GLUT/glut.h>
+#elif _WIN32
+#include <GL/glew.h>
+#include <GL/glut.h>
+#else
+#include <GL/glew.h>
+#include <GL/gl.h>
+#include <GL/glut.h>
+#endif
+
 #include "argparse.h"
+#include "glsl.h"
 #include "OpenEXR/half.h"
 #include "oiiohelpers.h"
 #include "pystring/pystring.h"
@@ -21,6 +44,252 @@ namespace OCIO = OCIO_NAMESPACE;
 
 
 
+// Escape a string to be written in a JSON file.
+std::string JsonEscape(const std::string & str)
+{
+    std::string res;
+    for(const char c : str)
+    {
+        switch(c)
+        {
+            case '"':  res += "\\\""; break;
+            case '\\': res += "\\\\"; break;
+            case '\n': res += "\\n";  break;
+            case '\t': res += "\\t";  break;
+            default:   res += c;     break;
+        }
+    }
+    return res;
+}
+
+// Collect all the measured times (in ms) to save them in a JSON file or to compare
+// them with the ones of a baseline (i.e. a JSON file previously saved).
+class Report
+{
+public:
+    struct Entry
+    {
+        std::string m_name;
+        double      m_ms;
+    };
+
+    // The errors of an optimized processor compared to the exact one (refer to
+    // MeasureAccuracy()).
+    struct AccuracyEntry
+    {
+        std::string m_config;
+        std::string m_samples;
+        double      m_maxAbs;
+        double      m_rmsAbs;
+        double      m_maxRel;
+        double      m_rmsRel;
+        double      m_maxUlp;
+        double      m_rmsUlp;
+        size_t      m_mismatches;
+    };
+
+    void add(const std::string & name, double ms)
+    {
+        m_entries.push_back(Entry{name, ms});
+    }
+
+    void addAccuracy(const AccuracyEntry & entry)
+    {
+        m_accuracies.push_back(entry);
+    }
+
+    // Add a general information (e.g. the image size) to the JSON file.
+    void addInfo(const std::string & name, const std::string & value)
+    {
+        m_infos.push_back(std::make_pair(name, value));
+    }
+
+    void write(const std::string & filepath) const
+    {
+        std::ofstream ofs(filepath.c_str());
+        if(!ofs)
+        {
+            std::string err("Could not create the JSON file: ");
+            err += filepath;
+            throw OCIO::Exception(err.c_str());
+        }
+
+        ofs.precision(6);
+        ofs << std::fixed;
+
+        ofs << "{" << std::endl;
+        for(const auto & info : m_infos)
+        {
+            ofs << "  \"" << JsonEscape(info.first) << "\": \""
+                << JsonEscape(info.second) << "\"," << std::endl;
+        }
+        ofs << "  \"measures\": [" << std::endl;
+        for(size_t idx=0; idx<m_entries.size(); ++idx)
+        {
+            ofs << "    { \"name\": \"" << JsonEscape(m_entries[idx].m_name) << "\", "
+                << "\"ms\": " << m_entries[idx].m_ms << " }"
+                << (idx+1<m_entries.size() ? "," : "") << std::endl;
+        }
+        ofs << "  ]";
+        if(!m_accuracies.empty())
+        {
+            // Note that the entries do not use the "name" key so Read() ignores them.
+            ofs << "," << std::endl;
+            ofs << "  \"accuracy\": [" << std::endl;
+            ofs << std::scientific;
+            for(size_t idx=0; idx<m_accuracies.size(); ++idx)
+            {
+                const AccuracyEntry & acc = m_accuracies[idx];
+                ofs << "    { \"config\": \"" << JsonEscape(acc.m_config) << "\", "
+                    << "\"samples\": \"" << JsonEscape(acc.m_samples) << "\", "
+                    << "\"max_abs\": " << acc.m_maxAbs << ", "
+                    << "\"rms_abs\": " << acc.m_rmsAbs << ", "
+                    << "\"max_rel\": " << acc.m_maxRel << ", "
+                    << "\"rms_rel\": " << acc.m_rmsRel << ", "
+                    << "\"max_ulp\": " << acc.m_maxUlp << ", "
+                    << "\"rms_ulp\": " << acc.m_rmsUlp << ", "
+                    << "\"mismatches\": " << acc.m_mismatches << " }"
+                    << (idx+1<m_accuracies.size() ? "," : "") << std::endl;
+            }
+            ofs << "  ]";
+        }
+        ofs << std::endl;
+        ofs << "}" << std::endl;
+    }
+
+    // Read the measures of a JSON file written by write(). Note that it is not a
+    // generic JSON parser i.e. it only looks for the "name" & "ms" pairs.
+    static std::vector<Entry> Read(const std::string & filepath)
+    {
+        std::ifstream ifs(filepath.c_str());
+        if(!ifs)
+        {
+            std::string err("Could not open the baseline file: ");
+            err += filepath;
+            throw OCIO::Exception(err.c_str());
+        }
+
+        std::stringstream ss;
+        ss << ifs.rdbuf();
+        const std::string json = ss.str();
+
+        std::vector<Entry> entries;
+
+        size_t pos = 0;
+        while((pos = json.find("\"name\"", pos))!=std::string::npos)
+        {
+            // Read the name.
+            pos = json.find('"', json.find(':', pos));
+            if(pos==std::string::npos)
+            {
+                break;
+            }
+
+            std::string name;
+            for(++pos; pos<json.size() && json[pos]!='"'; ++pos)
+            {
+                if(json[pos]=='\\' && pos+1<json.size())
+                {
+                    ++pos;
+                    name += json[pos]=='n' ? '\n' : json[pos]=='t' ? '\t' : json[pos];
+                }
+                else
+                {
+                    name += json[pos];
+                }
+            }
+
+            // Read the time.
+            pos = json.find("\"ms\"", pos);
+            if(pos==std::string::npos)
+            {
+                break;
+            }
+            pos = json.find(':', pos);
+            if(pos==std::string::npos)
+            {
+                break;
+            }
+
+            const char * start = json.c_str() + pos + 1;
+            char * end = nullptr;
+            const double ms = strtod(start, &end);
+            if(end==start)
+            {
+                std::string err("Invalid time for '");
+                err += name;
+                err += "' in the baseline file: ";
+                err += filepath;
+                throw OCIO::Exception(err.c_str());
+            }
+            pos += end - start;
+
+            entries.push_back(Entry{name, ms});
+        }
+
+        if(entries.empty())
+        {
+            std::string err("No measure found in the baseline file: ");
+            err += filepath;
+            throw OCIO::Exception(err.c_str());
+        }
+
+        return entries;
+    }
+
+    // Compare the measures with the baseline ones, and return the number of regressions
+    // i.e. measures slower than the baseline by more than the tolerance (in percent).
+    unsigned compare(const std::string & baselineFilepath, double tolerance) const
+    {
+        const std::vector<Entry> baseline = Read(baselineFilepath);
+
+        // Differences below the timer precision are only noise.
+        static constexpr double MIN_DIFFERENCE_MS = 0.01;
+
+        std::cout << std::endl;
+        std::cout << "Comparison with the baseline '" << baselineFilepath
+                  << "' (tolerance of " << tolerance << "%):" << std::endl;
+
+        unsigned numRegressions = 0;
+        for(const auto & entry : m_entries)
+        {
+            auto it = std::find_if(baseline.begin(), baseline.end(),
+                                   [&entry](const Entry & e) { return e.m_name==entry.m_name; });
+
+            std::cout << "  " << entry.m_name << ": ";
+
+            if(it==baseline.end())
+            {
+                std::cout << entry.m_ms << " ms (not in the baseline)" << std::endl;
+                continue;
+            }
+
+            const double diff = entry.m_ms - it->m_ms;
+            const double percent = it->m_ms>0.0 ? 100.0 * diff / it->m_ms : 0.0;
+
+            std::cout << it->m_ms << " ms -> " << entry.m_ms << " ms ("
+                      << (percent>=0.0 ? "+" : "") << percent << "%)";
+
+            if(percent>tolerance && diff>MIN_DIFFERENCE_MS)
+            {
+                std::cout << "  REGRESSION";
+                ++numRegressions;
+            }
+            std::cout << std::endl;
+        }
+
+        std::cout << std::endl;
+        std::cout << numRegressions << " regression(s) found." << std::endl;
+
+        return numRegressions;
+    }
+
+private:
+    std::vector<std::pair<std::string, std::string>> m_infos;
+    std::vector<Entry> m_entries;
+    std::vector<AccuracyEntry> m_accuracies;
+};
+
 // Utility to measure time in ms.
 class Measure
 {
@@ -28,9 +297,13 @@ public:
     Measure() = delete;
     Measure(const Measure &) = delete;
 
-    explicit Measure(const char * explanation, unsigned iterations)
+    // The key identifies the measure in the report.
+    explicit Measure(const char * explanation, const std::string & key,
+                     unsigned iterations, Report & report)
         :   m_explanations(explanation)
+        ,   m_key(key)
         ,   m_iterations(iterations)
+        ,   m_report(report)
         ,   m_started(false)
         ,   m_duration(0)
     {
@@ -43,11 +316,13 @@ public:
             pause();
         }
 
+        const double ms = m_duration.count()/double(m_iterations);
+
         std::cout << std::endl;
         std::cout << m_explanations << std::endl;
-        std::cout << "  CPU processing took: "
-                  << (m_duration.count()/float(m_iterations))
-                  <<  " ms" << std::endl;
+        std::cout << "  CPU processing took: " << ms <<  " ms" << std::endl;
+
+        m_report.add(m_key, ms);
     }
 
     void resume()
@@ -82,7 +357,9 @@ public:
 
 private:
     const std::string m_explanations;
+    const std::string m_key;
     const unsigned m_iterations;
+    Report & m_report;
 
     bool m_started;
     std::chrono::high_resolution_clock::time_point m_start;
@@ -247,6 +524,658 @@ void ProcessPixels(Measure & m, OCIO::ConstCPUProcessorRcPtr & cpuProcessor,
     m.pause();
 }
 
+// Process the complete image (with input and output buffers) using several threads.
+void ProcessImageParallel(Measure & m, OCIO::ConstCPUProcessorRcPtr & cpuProcessor,
+                          const OIIO::ImageSpec & spec, const OCIO::ImgBuffer & img,
+                          const OIIO::ImageSpec & dstSpec, OCIO::ImgBuffer & dstImg)
+{
+    // Always process the same complete image.
+    OCIO::ImgBuffer srcImg(img);
+    OCIO::ImageDescRcPtr srcImgDesc = OCIO::CreateImageDesc(spec, srcImg);
+    OCIO::ImageDescRcPtr dstImgDesc = OCIO::CreateImageDesc(dstSpec, dstImg);
+
+    m.resume();
+
+    // Apply the color transformation using the internal thread pool.
+    cpuProcessor->apply(*srcImgDesc, *dstImgDesc, OCIO::CPUExecutor());
+
+    m.pause();
+}
+
+// Measure the time spent by each op (i.e. by each renderer of the 32-bit float processor).
+// Convert the image to packed RGBA 32-bit float pixels (using an identity processor).
+std::vector<float> ConvertToRGBAF32(const OIIO::ImageSpec & spec, const OCIO::ImgBuffer & img)
+{
+    const long numPixels = long(spec.width) * long(spec.height);
+    std::vector<float> rgbaImg(4 * numPixels, 1.0f);
+
+    OCIO::ConstConfigRcPtr config = OCIO::Config::Create();
+    OCIO::ConstProcessorRcPtr identity = config->getProcessor(OCIO::GroupTransform::Create());
+    OCIO::ConstCPUProcessorRcPtr converter
+        = identity->getOptimizedCPUProcessor(OCIO::GetBitDepth(spec), OCIO::BIT_DEPTH_F32,
+                                             OCIO::OPTIMIZATION_DEFAULT,
+                                             OCIO::FINALIZATION_DEFAULT);
+
+    OCIO::ImgBuffer srcImg(img);
+    OCIO::ImageDescRcPtr srcImgDesc = OCIO::CreateImageDesc(spec, srcImg);
+    OCIO::PackedImageDesc dstImgDesc(&rgbaImg[0], spec.width, spec.height, 4);
+    converter->apply(*srcImgDesc, dstImgDesc);
+
+    return rgbaImg;
+}
+
+void ProfileOps(OCIO::ConstProcessorRcPtr & processor,
+                const OIIO::ImageSpec & spec, const OCIO::ImgBuffer & img,
+                unsigned iterations, Report & report)
+{
+    // The per-op processing only works on packed RGBA 32-bit float pixels.
+    const long numPixels = long(spec.width) * long(spec.height);
+    const std::vector<float> rgbaImg = ConvertToRGBAF32(spec, img);
+
+    OCIO::ConstCPUProcessorRcPtr cpuProcessor
+        = processor->getOptimizedCPUProcessor(OCIO::BIT_DEPTH_F32, OCIO::BIT_DEPTH_F32,
+                                              OCIO::OPTIMIZATION_DEFAULT,
+                                              OCIO::FINALIZATION_DEFAULT);
+
+    OCIO::ConstProcessorMetadataRcPtr metadata = cpuProcessor->getProcessorMetadata();
+    const int numRenderers = metadata->getNumRenderers();
+
+    std::vector<double> times(numRenderers, 0.0);
+    for(unsigned iter=0; iter<iterations; ++iter)
+    {
+        // Always process the same complete image.
+        std::vector<float> buffer(rgbaImg);
+        cpuProcessor->profileRenderers(&buffer[0], numPixels, &times[0]);
+    }
+
+    double total = 0.0;
+    for(const double time : times)
+    {
+        total += time;
+    }
+
+    std::cout << std::endl;
+    std::cout << "Process the complete image (32-bit float RGBA) op per op:" << std::endl;
+    for(int idx=0; idx<numRenderers; ++idx)
+    {
+        const double ms = times[idx] / double(iterations);
+
+        std::cout << "  " << idx << ": " << metadata->getRenderer(idx) << " took: "
+                  << ms << " ms (" << (total>0.0 ? 100.0 * times[idx] / total : 0.0)
+                  << "%)" << std::endl;
+
+        std::ostringstream key;
+        key << "op_" << idx << "_" << metadata->getRenderer(idx);
+        report.add(key.str(), ms);
+    }
+}
+
+// Parse a comma separated list of thread counts (e.g. "1,2,4,8").
+std::vector<unsigned> ParseThreads(const std::string & str)
+{
+    std::vector<unsigned> threads;
+    if(str.empty())
+    {
+        return threads;
+    }
+
+    std::vector<std::string> tokens;
+    pystring::split(str, tokens, ",");
+
+    for(const auto & token : tokens)
+    {
+        const std::string value = pystring::strip(token);
+        char * end = nullptr;
+        const long num = strtol(value.c_str(), &end, 10);
+        if(value.empty() || *end!='\0' || num<1)
+        {
+            std::string err("Invalid number of threads: '");
+            err += token;
+            err += "'.";
+            throw OCIO::Exception(err.c_str());
+        }
+        threads.push_back(unsigned(num));
+    }
+
+    return threads;
+}
+
+// Return the elapsed time in ms.
+double GetElapsedTime(const std::chrono::high_resolution_clock::time_point & start)
+{
+    const std::chrono::duration<double, std::milli> elapsed
+        = std::chrono::high_resolution_clock::now() - start;
+    return elapsed.count();
+}
+
+// Measure the GPU processing of the image i.e. the shader generation, the shader
+// compilation, the texture uploads, the processing (once the GPU is in a steady
+// state) and the readback of the processed image.
+void MeasureGPU(OCIO::ConstProcessorRcPtr & processor, bool legacyShader, bool verbose,
+                const OIIO::ImageSpec & spec, const OCIO::ImgBuffer & img,
+                unsigned iterations, Report & report)
+{
+    // The number of frames processed before measuring the steady-state processing
+    // (i.e. to exclude the driver lazy initializations).
+    static constexpr unsigned NUM_WARMUP_FRAMES = 3;
+
+    const std::vector<float> rgbaImg = ConvertToRGBAF32(spec, img);
+    const GLsizei width  = spec.width;
+    const GLsizei height = spec.height;
+
+    // Initialize the OpenGL context.
+
+    int argcgl = 2;
+    const char * argvgl[] = { "main", "-glDebug" };
+    glutInit(&argcgl, const_cast<char**>(&argvgl[0]));
+
+    glutInitDisplayMode(GLUT_RGB | GLUT_DOUBLE | GLUT_DEPTH);
+    glutInitWindowSize(10, 10);
+    glutInitWindowPosition(0, 0);
+
+    const GLint glwin = glutCreateWindow(argvgl[0]);
+
+#ifndef __APPLE__
+    glewInit();
+    if(!glewIsSupported("GL_VERSION_2_0"))
+    {
+        throw OCIO::Exception("OpenGL 2.0 not supported.");
+    }
+
+    const bool timerQuery = GLEW_ARB_timer_query || GLEW_VERSION_3_3;
+#else
+    const bool timerQuery = false;
+#endif
+
+    if(verbose)
+    {
+        std::cout << std::endl
+                  << "GL Vendor:    " << glGetString(GL_VENDOR) << std::endl
+                  << "GL Renderer:  " << glGetString(GL_RENDERER) << std::endl
+                  << "GL Version:   " << glGetString(GL_VERSION) << std::endl
+                  << "GLSL Version: " << glGetString(GL_SHADING_LANGUAGE_VERSION) << std::endl;
+    }
+
+    GLint maxTextureSize = 0;
+    glGetIntegerv(GL_MAX_TEXTURE_SIZE, &maxTextureSize);
+    if(width>maxTextureSize || height>maxTextureSize)
+    {
+        throw OCIO::Exception("The image is too big for the GPU processing.");
+    }
+
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+#ifndef __APPLE__
+    glClampColor(GL_CLAMP_READ_COLOR, GL_FALSE);
+    glClampColor(GL_CLAMP_VERTEX_COLOR, GL_FALSE);
+    glClampColor(GL_CLAMP_FRAGMENT_COLOR, GL_FALSE);
+#endif
+
+    std::cout << std::endl;
+    std::cout << "Process the complete image using the GPU"
+              << (legacyShader ? " (legacy shader):" : ":") << std::endl;
+
+    // Generate the shader program.
+
+    auto start = std::chrono::high_resolution_clock::now();
+
+    OCIO::GpuShaderDescRcPtr shaderDesc
+        = legacyShader ? OCIO::GpuShaderDesc::CreateLegacyShaderDesc(32)
+                       : OCIO::GpuShaderDesc::CreateShaderDesc();
+    shaderDesc->setLanguage(OCIO::GPU_LANGUAGE_GLSL_1_3);
+
+    OCIO::ConstGPUProcessorRcPtr gpuProcessor = processor->getDefaultGPUProcessor();
+    const double gpuProcessorTime = GetElapsedTime(start);
+
+    start = std::chrono::high_resolution_clock::now();
+    gpuProcessor->extractGpuShaderInfo(shaderDesc);
+    const double shaderTime = GetElapsedTime(start);
+
+    // Upload the LUTs.
+
+    OCIO::OpenGLBuilderRcPtr oglBuilder = OCIO::OpenGLBuilder::Create(shaderDesc);
+
+    glFinish();
+    start = std::chrono::high_resolution_clock::now();
+    oglBuilder->allocateAllTextures(1);
+    glFinish();
+    const double lutUploadTime = GetElapsedTime(start);
+
+    // Compile the shader program.
+
+    std::ostringstream main;
+    main << std::endl
+         << "uniform sampler2D img;" << std::endl
+         << std::endl
+         << "void main()" << std::endl
+         << "{" << std::endl
+         << "    vec4 col = texture2D(img, gl_TexCoord[0].st);" << std::endl
+         << "    gl_FragColor = " << shaderDesc->getFunctionName() << "(col);" << std::endl
+         << "}" << std::endl;
+
+    start = std::chrono::high_resolution_clock::now();
+    oglBuilder->buildProgram(main.str().c_str());
+    glFinish();
+    const double compileTime = GetElapsedTime(start);
+
+    oglBuilder->useProgram();
+    glUniform1i(glGetUniformLocation(oglBuilder->getProgramHandle(), "img"), 0);
+    oglBuilder->useAllTextures();
+    oglBuilder->useAllUniforms();
+
+    // Upload the image.
+
+    GLuint textureIds[2] = { 0, 0 };
+    glGenTextures(2, textureIds);
+
+    glActiveTexture(GL_TEXTURE0);
+
+    glFinish();
+    start = std::chrono::high_resolution_clock::now();
+    glBindTexture(GL_TEXTURE_2D, textureIds[0]);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA32F_ARB, width, height, 0,
+                 GL_RGBA, GL_FLOAT, &rgbaImg[0]);
+    glFinish();
+    const double imageUploadTime = GetElapsedTime(start);
+
+    for(const GLuint textureId : textureIds)
+    {
+        glBindTexture(GL_TEXTURE_2D, textureId);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    }
+
+    // The processed image is rendered in a 32-bit float texture.
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA32F_ARB, width, height, 0,
+                 GL_RGBA, GL_FLOAT, nullptr);
+
+    GLuint fboId = 0;
+    glGenFramebuffers(1, &fboId);
+    glBindFramebuffer(GL_FRAMEBUFFER, fboId);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D,
+                           textureIds[1], 0);
+    glDrawBuffer(GL_COLOR_ATTACHMENT0);
+
+    glBindTexture(GL_TEXTURE_2D, textureIds[0]);
+
+    glEnable(GL_TEXTURE_2D);
+    glViewport(0, 0, width, height);
+    glMatrixMode(GL_PROJECTION);
+    glLoadIdentity();
+    glOrtho(0.0, width, 0.0, height, -100.0, 100.0);
+    glMatrixMode(GL_MODELVIEW);
+    glLoadIdentity();
+
+    // Process the image.
+
+    GLuint query = 0;
+#ifndef __APPLE__
+    if(timerQuery)
+    {
+        glGenQueries(1, &query);
+    }
+#endif
+
+    double processingTime = 0.0;
+    for(unsigned frame=0; frame<NUM_WARMUP_FRAMES + iterations; ++frame)
+    {
+        glFinish();
+        start = std::chrono::high_resolution_clock::now();
+#ifndef __APPLE__
+        if(timerQuery)
+        {
+            glBeginQuery(GL_TIME_ELAPSED, query);
+        }
+#endif
+
+        glBegin(GL_QUADS);
+            glTexCoord2f(0.0f, 1.0f);
+            glVertex2f(0.0f, (float)height);
+
+            glTexCoord2f(0.0f, 0.0f);
+            glVertex2f(0.0f, 0.0f);
+
+            glTexCoord2f(1.0f, 0.0f);
+            glVertex2f((float)width, 0.0f);
+
+            glTexCoord2f(1.0f, 1.0f);
+            glVertex2f((float)width, (float)height);
+        glEnd();
+
+        double ms = 0.0;
+#ifndef __APPLE__
+        if(timerQuery)
+        {
+            glEndQuery(GL_TIME_ELAPSED);
+
+            // Wait for the result.
+            GLuint64 elapsedNs = 0;
+            glGetQueryObjectui64v(query, GL_QUERY_RESULT, &elapsedNs);
+            ms = double(elapsedNs) * 1e-6;
+        }
+        else
+#endif
+        {
+            glFinish();
+            ms = GetElapsedTime(start);
+        }
+
+        if(frame>=NUM_WARMUP_FRAMES)
+        {
+            processingTime += ms;
+        }
+    }
+    processingTime /= double(iterations);
+
+    // Read the processed image.
+
+    std::vector<float> processedImg(rgbaImg.size());
+
+    start = std::chrono::high_resolution_clock::now();
+    glReadBuffer(GL_COLOR_ATTACHMENT0);
+    glReadPixels(0, 0, width, height, GL_RGBA, GL_FLOAT, &processedImg[0]);
+    const double readbackTime = GetElapsedTime(start);
+
+    std::cout << "  GPU processor creation took: " << gpuProcessorTime << " ms" << std::endl;
+    std::cout << "  Shader generation took: " << shaderTime << " ms" << std::endl;
+    std::cout << "  LUT upload took: " << lutUploadTime << " ms" << std::endl;
+    std::cout << "  Shader compilation took: " << compileTime << " ms" << std::endl;
+    std::cout << "  Image upload took: " << imageUploadTime << " ms" << std::endl;
+    std::cout << "  GPU processing took: " << processingTime << " ms"
+              << (timerQuery ? "" : " (measured on the CPU)") << std::endl;
+    std::cout << "  Image readback took: " << readbackTime << " ms" << std::endl;
+
+    report.add("gpu_processor_creation", gpuProcessorTime);
+    report.add("gpu_shader_generation", shaderTime);
+    report.add("gpu_lut_upload", lutUploadTime);
+    report.add("gpu_shader_compilation", compileTime);
+    report.add("gpu_image_upload", imageUploadTime);
+    report.add("gpu_processing", processingTime);
+    report.add("gpu_image_readback", readbackTime);
+
+    // Clean up.
+
+#ifndef __APPLE__
+    if(timerQuery)
+    {
+        glDeleteQueries(1, &query);
+    }
+#endif
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    glDeleteFramebuffers(1, &fboId);
+    glDeleteTextures(2, textureIds);
+
+    oglBuilder.reset();
+    glutDestroyWindow(glwin);
+}
+
+// Accumulate the errors of processed values compared to the reference ones.
+class ErrorStats
+{
+public:
+    void add(float ref, float val)
+    {
+        // The relative error of values close to zero is relative to this floor instead.
+        const double relFloor = 1e-3;
+
+        if(!std::isfinite(ref) || !std::isfinite(val))
+        {
+            // Only identical non-finite values (e.g. both +inf or both NaN) are accurate.
+            const bool same = (std::isnan(ref) && std::isnan(val)) || ref==val;
+            if(!same)
+            {
+                ++m_mismatches;
+            }
+            return;
+        }
+
+        const double absErr = std::fabs(double(val) - double(ref));
+        const double relErr = absErr / std::max(std::fabs(double(ref)), relFloor);
+        const double ulpErr = double(UlpDistance(ref, val));
+
+        m_maxAbs = std::max(m_maxAbs, absErr);
+        m_maxRel = std::max(m_maxRel, relErr);
+        m_maxUlp = std::max(m_maxUlp, ulpErr);
+
+        m_sumSqAbs += absErr * absErr;
+        m_sumSqRel += relErr * relErr;
+        m_sumSqUlp += ulpErr * ulpErr;
+
+        ++m_num;
+    }
+
+    Report::AccuracyEntry getEntry(const std::string & config,
+                                   const std::string & samples) const
+    {
+        const double num = m_num>0 ? double(m_num) : 1.0;
+        return Report::AccuracyEntry{ config, samples,
+                                      m_maxAbs, std::sqrt(m_sumSqAbs / num),
+                                      m_maxRel, std::sqrt(m_sumSqRel / num),
+                                      m_maxUlp, std::sqrt(m_sumSqUlp / num),
+                                      m_mismatches };
+    }
+
+private:
+    // Number of representable floats between two finite values.
+    static uint64_t UlpDistance(float a, float b)
+    {
+        return uint64_t(std::llabs(OrderedBits(a) - OrderedBits(b)));
+    }
+
+    // Map the float bits to integers with the same ordering as the floats (i.e. the
+    // negative values are mirrored so -0 and +0 are equal).
+    static int64_t OrderedBits(float value)
+    {
+        int32_t bits = 0;
+        std::memcpy(&bits, &value, sizeof(float));
+        return bits>=0 ? int64_t(bits) : int64_t(INT32_MIN) - int64_t(bits);
+    }
+
+    double m_maxAbs   = 0.0;
+    double m_maxRel   = 0.0;
+    double m_maxUlp   = 0.0;
+    double m_sumSqAbs = 0.0;
+    double m_sumSqRel = 0.0;
+    double m_sumSqUlp = 0.0;
+    size_t m_num        = 0;
+    size_t m_mismatches = 0;
+};
+
+// A named set of packed RGBA 32-bit float pixels used to measure the accuracy.
+struct SampleSet
+{
+    std::string        m_name;
+    std::vector<float> m_pixels;
+};
+
+// All the finite half-float values, each channel using a different rotation of the
+// sweep so the pixels are not only grays.
+SampleSet CreateHalfSweep()
+{
+    std::vector<float> values;
+    for(unsigned bits=0; bits<=0xFFFF; ++bits)
+    {
+        half h;
+        h.setBits((unsigned short)bits);
+        if(h.isFinite())
+        {
+            values.push_back(float(h));
+        }
+    }
+
+    const size_t num = values.size();
+
+    SampleSet samples{ "half_sweep", std::vector<float>(4 * num) };
+    for(size_t idx=0; idx<num; ++idx)
+    {
+        samples.m_pixels[4 * idx + 0] = values[idx];
+        samples.m_pixels[4 * idx + 1] = values[(idx + num / 3) % num];
+        samples.m_pixels[4 * idx + 2] = values[(idx + 2 * num / 3) % num];
+        samples.m_pixels[4 * idx + 3] = 1.0f;
+    }
+
+    return samples;
+}
+
+// A regular grid of the [0, 1] RGB cube.
+SampleSet CreateRGBGrid(unsigned gridSize)
+{
+    SampleSet samples{ "rgb_grid", {} };
+    samples.m_pixels.reserve(size_t(4) * gridSize * gridSize * gridSize);
+
+    const float scale = 1.0f / float(gridSize - 1);
+    for(unsigned r=0; r<gridSize; ++r)
+    {
+        for(unsigned g=0; g<gridSize; ++g)
+        {
+            for(unsigned b=0; b<gridSize; ++b)
+            {
+                samples.m_pixels.push_back(float(r) * scale);
+                samples.m_pixels.push_back(float(g) * scale);
+                samples.m_pixels.push_back(float(b) * scale);
+                samples.m_pixels.push_back(1.0f);
+            }
+        }
+    }
+
+    return samples;
+}
+
+// Process the samples (in place) and return the average processing time in ms.
+double ProcessSamples(const OCIO::ConstCPUProcessorRcPtr & cpuProcessor,
+                      const std::vector<float> & pixels, unsigned iterations,
+                      std::vector<float> & result)
+{
+    const long numPixels = long(pixels.size() / 4);
+
+    double total = 0.0;
+    for(unsigned iter=0; iter<std::max(iterations, 1u); ++iter)
+    {
+        // Always process the same samples.
+        result = pixels;
+        OCIO::PackedImageDesc imgDesc(&result[0], numPixels, 1, 4);
+
+        const auto start = std::chrono::high_resolution_clock::now();
+        cpuProcessor->apply(imgDesc);
+        total += GetElapsedTime(start);
+    }
+
+    return total / double(std::max(iterations, 1u));
+}
+
+// Compare the processing of optimized processors (i.e. the fast paths) with the exact one
+// (i.e. without optimization and with the exact finalization) on a half-float sweep, on a
+// RGB grid and on the image, and report the errors next to the processing times.
+void MeasureAccuracy(OCIO::ConstProcessorRcPtr & processor,
+                     const OIIO::ImageSpec & spec, const OCIO::ImgBuffer & img,
+                     unsigned iterations, Report & report)
+{
+    static constexpr unsigned RGB_GRID_SIZE = 65;
+
+    struct Config
+    {
+        const char *                  m_name;
+        OCIO::OptimizationFlags       m_oFlags;
+        OCIO::FinalizationFlags       m_fFlags;
+        OCIO::LutInterpolationQuality m_interpQuality;
+    };
+
+    static const Config configs[] = {
+        { "lossless_exact",   OCIO::OPTIMIZATION_LOSSLESS, OCIO::FINALIZATION_EXACT,
+                              OCIO::LUT_INTERPOLATION_FULL },
+        { "default_exact",    OCIO::OPTIMIZATION_DEFAULT,  OCIO::FINALIZATION_EXACT,
+                              OCIO::LUT_INTERPOLATION_FULL },
+        { "default_fast",     OCIO::OPTIMIZATION_DEFAULT,  OCIO::FINALIZATION_FAST,
+                              OCIO::LUT_INTERPOLATION_FULL },
+        { "good_fast",        OCIO::OPTIMIZATION_GOOD,     OCIO::FINALIZATION_FAST,
+                              OCIO::LUT_INTERPOLATION_FULL },
+        { "draft_fast",       OCIO::OPTIMIZATION_DRAFT,    OCIO::FINALIZATION_FAST,
+                              OCIO::LUT_INTERPOLATION_FULL },
+        { "default_preview",  OCIO::OPTIMIZATION_DEFAULT,  OCIO::FINALIZATION_FAST,
+                              OCIO::LUT_INTERPOLATION_PREVIEW },
+        { "default_draft",    OCIO::OPTIMIZATION_DEFAULT,  OCIO::FINALIZATION_FAST,
+                              OCIO::LUT_INTERPOLATION_DRAFT },
+    };
+
+    std::vector<SampleSet> sampleSets;
+    sampleSets.push_back(CreateHalfSweep());
+    sampleSets.push_back(CreateRGBGrid(RGB_GRID_SIZE));
+    sampleSets.push_back(SampleSet{ "image", ConvertToRGBAF32(spec, img) });
+
+    OCIO::ConstCPUProcessorRcPtr refProcessor
+        = processor->getOptimizedCPUProcessor(OCIO::BIT_DEPTH_F32, OCIO::BIT_DEPTH_F32,
+                                              OCIO::OPTIMIZATION_NONE,
+                                              OCIO::FINALIZATION_EXACT);
+
+    for(const SampleSet & samples : sampleSets)
+    {
+        const size_t numPixels = samples.m_pixels.size() / 4;
+
+        std::vector<float> refResult;
+        const double refMs
+            = ProcessSamples(refProcessor, samples.m_pixels, iterations, refResult);
+
+        std::cout << std::endl;
+        std::cout << "Accuracy on the " << samples.m_name << " (" << numPixels
+                  << " pixels) compared to the exact processing (" << refMs << " ms):"
+                  << std::endl;
+        std::cout << "  " << std::left << std::setw(16) << "config" << std::right
+                  << std::setw(10) << "ms"
+                  << std::setw(10) << "Mpix/s"
+                  << std::setw(12) << "max abs"
+                  << std::setw(12) << "rms abs"
+                  << std::setw(12) << "max rel"
+                  << std::setw(12) << "rms rel"
+                  << std::setw(12) << "max ulp"
+                  << std::setw(12) << "rms ulp"
+                  << std::setw(12) << "mismatches" << std::endl;
+
+        report.add("accuracy_exact_" + samples.m_name, refMs);
+
+        for(const Config & config : configs)
+        {
+            OCIO::ConstCPUProcessorRcPtr cpuProcessor
+                = processor->getOptimizedCPUProcessor(OCIO::BIT_DEPTH_F32, OCIO::BIT_DEPTH_F32,
+                                                      config.m_oFlags, config.m_fFlags,
+                                                      config.m_interpQuality);
+
+            std::vector<float> result;
+            const double ms = ProcessSamples(cpuProcessor, samples.m_pixels, iterations, result);
+
+            ErrorStats stats;
+            for(size_t idx=0; idx<result.size(); ++idx)
+            {
+                // The alpha channel is not part of the color accuracy.
+                if(idx % 4 != 3)
+                {
+                    stats.add(refResult[idx], result[idx]);
+                }
+            }
+
+            const Report::AccuracyEntry entry = stats.getEntry(config.m_name, samples.m_name);
+            const double mpixPerSec = ms>0.0 ? double(numPixels) / (ms * 1000.0) : 0.0;
+
+            std::cout << "  " << std::left << std::setw(16) << entry.m_config << std::right
+                      << std::fixed << std::setprecision(3)
+                      << std::setw(10) << ms
+                      << std::setw(10) << mpixPerSec
+                      << std::scientific << std::setprecision(3)
+                      << std::setw(12) << entry.m_maxAbs
+                      << std::setw(12) << entry.m_rmsAbs
+                      << std::setw(12) << entry.m_maxRel
+                      << std::setw(12) << entry.m_rmsRel
+                      << std::setw(12) << entry.m_maxUlp
+                      << std::setw(12) << entry.m_rmsUlp
+                      << std::defaultfloat << std::setprecision(6)
+                      << std::setw(12) << entry.m_mismatches << std::endl;
+
+            report.add("accuracy_" + entry.m_config + "_" + samples.m_name, ms);
+            report.addAccuracy(entry);
+        }
+    }
+}
+
 int main(int argc, const char **argv)
 {
     bool verbose = false;
@@ -256,6 +1185,14 @@ int main(int argc, const char **argv)
     std::string filepath;
     unsigned iterations = 10;
     std::string outBitDepthStr("auto");
+    std::string threadsStr;
+    bool profileOps = false;
+    std::string jsonFilepath;
+    std::string baselineFilepath;
+    float tolerance = 10.0f;
+    bool usegpu = false;
+    bool usegpuLegacy = false;
+    bool accuracy = false;
 
     bool help = false;
 
@@ -274,6 +1211,24 @@ int main(int argc, const char **argv)
                "--iter %d", &iterations, "Provide the number of iterations on the processing. Default is 10",
                "--out %s", &outBitDepthStr, "Provide an output bit-depth (auto, ui16, f32)"\
                                             " where auto preserves the input bit-depth",
+               "--threads %s", &threadsStr, "Also process the complete image using the internal "\
+                                            "thread pool for each number of threads of the comma "\
+                                            "separated list (e.g. 1,2,4,8)",
+               "--ops", &profileOps, "Also measure the time spent by each op (i.e. on the "\
+                                     "32-bit float RGBA image)",
+               "--gpu", &usegpu, "Also measure the GPU processing i.e. the shader generation, "\
+                                 "the shader compilation, the texture uploads and the processing",
+               "--gpulegacy", &usegpuLegacy, "Also measure the legacy (i.e. baked) GPU processing",
+               "--accuracy", &accuracy, "Also compare the optimized processings (i.e. the fast "\
+                                        "paths) with the exact one on a half-float sweep, a RGB "\
+                                        "grid and the image, reporting their errors (absolute, "\
+                                        "relative and in ULPs) next to their processing times",
+               "--json %s", &jsonFilepath, "Save all the measures in a JSON file",
+               "--compare %s", &baselineFilepath, "Compare the measures with the ones of a JSON "\
+                                                  "file previously saved (i.e. using --json) and "\
+                                                  "exit with an error if any regression is found",
+               "--tolerance %f", &tolerance, "Provide the tolerance (in percent) of the comparison "\
+                                             "with the baseline. Default is 10",
                NULL);
 
     if(ap.parse (argc, argv) < 0) {
@@ -318,12 +1273,27 @@ int main(int argc, const char **argv)
 
     outBitDepthStr = pystring::lower(outBitDepthStr);
 
+    Report report;
+    report.addInfo("ocio_version", OCIO::GetVersion());
+    report.addInfo("image", filepath);
+    report.addInfo("resolution", std::to_string(spec.width) + "x" + std::to_string(spec.height));
+    report.addInfo("channels", std::to_string(spec.nchannels));
+    report.addInfo("iterations", std::to_string(iterations));
+
+    unsigned numRegressions = 0;
+
     // Process the image.
     try
     {
+        const std::vector<unsigned> threads = ParseThreads(threadsStr);
+
         // Load the current config.
 
         OCIO::ConstProcessorRcPtr processor;
+
+        // Note that the config is created just before so the processor is not cached.
+        auto start = std::chrono::high_resolution_clock::now();
+
         if(!transformFile.empty())
         {
             OCIO::ConstConfigRcPtr config  = OCIO::Config::Create();
@@ -336,6 +1306,7 @@ int main(int argc, const char **argv)
             transform->setSrc(transformFile.c_str());
 
             // Get the processor
+            start = std::chrono::high_resolution_clock::now();
             processor = config->getProcessor(transform);
         }
         else if(!inputColorSpace.empty() && !outputColorSpace.empty())
@@ -358,6 +1329,7 @@ int main(int argc, const char **argv)
             OCIO::ConstConfigRcPtr config  = OCIO::Config::CreateFromEnv();
 
             // Get the processor
+            start = std::chrono::high_resolution_clock::now();
             processor = config->getProcessor(inputColorSpace.c_str(), outputColorSpace.c_str());
         }
         else
@@ -365,6 +1337,8 @@ int main(int argc, const char **argv)
             throw OCIO::Exception("Missing color transformation description.");
         }
 
+        const double processorTime = GetElapsedTime(start);
+
         const OCIO::BitDepth inBitDepth  = OCIO::GetBitDepth(spec);
         OCIO::BitDepth outBitDepth = inBitDepth;
         if(outBitDepthStr=="f32")
@@ -383,10 +1357,48 @@ int main(int argc, const char **argv)
         }
 
         // Get the CPU processor.
+        start = std::chrono::high_resolution_clock::now();
         OCIO::ConstCPUProcessorRcPtr cpuProcessor
             = processor->getOptimizedCPUProcessor(inBitDepth, outBitDepth,
                                                   OCIO::OPTIMIZATION_DEFAULT,
                                                   OCIO::FINALIZATION_DEFAULT);
+        const double cpuProcessorTime = GetElapsedTime(start);
+
+        OCIO::ConstProcessorMetadataRcPtr metadata = cpuProcessor->getProcessorMetadata();
+
+        std::cout << std::endl;
+        std::cout << "Create the processors:" << std::endl;
+        std::cout << "  Processor creation took: " << processorTime << " ms" << std::endl;
+        std::cout << "  CPU processor creation took: " << cpuProcessorTime << " ms" << std::endl;
+        std::cout << "    including the optimization: "
+                  << metadata->getOptimizationTime() << " ms" << std::endl;
+        std::cout << "    including the finalization: "
+                  << metadata->getFinalizationTime() << " ms" << std::endl;
+
+        report.add("processor_creation", processorTime);
+        report.add("cpu_processor_creation", cpuProcessorTime);
+        report.add("cpu_processor_optimization", metadata->getOptimizationTime());
+        report.add("cpu_processor_finalization", metadata->getFinalizationTime());
+
+        // The output image specifications when using two buffers.
+        OIIO::TypeDesc fmt = spec.format;
+        if(inBitDepth!=outBitDepth)
+        {
+            if(outBitDepth==OCIO::BIT_DEPTH_F32)
+            {
+                fmt = OIIO::TypeDesc::FLOAT;
+            }
+            else if(outBitDepth==OCIO::BIT_DEPTH_UINT16)
+            {
+                fmt = OIIO::TypeDesc::UINT16;
+            }
+            else
+            {
+                throw OCIO::Exception("Unsupported output bit-depth.");
+            }
+        }
+
+        OIIO::ImageSpec dstSpec(spec.width, spec.height, spec.nchannels, fmt);
 
         if(testType==0 || testType==-1)
         {
@@ -394,7 +1406,8 @@ int main(int argc, const char **argv)
 
             if(inBitDepth==outBitDepth)
             {
-                Measure m("Process the complete image (in place):", iterations);
+                Measure m("Process the complete image (in place):",
+                          "image_in_place", iterations, report);
 
                 for(unsigned iter=0; iter<iterations; ++iter)
                 {
@@ -404,26 +1417,9 @@ int main(int argc, const char **argv)
 
             // Process the complete image with input and output buffers.
 
-            Measure m("Process the complete image (two buffers):", iterations);
+            Measure m("Process the complete image (two buffers):",
+                      "image_two_buffers", iterations, report);
 
-            OIIO::TypeDesc fmt = spec.format;
-            if(inBitDepth!=outBitDepth)
-            {
-                if(outBitDepth==OCIO::BIT_DEPTH_F32)
-                {
-                    fmt = OIIO::TypeDesc::FLOAT;
-                }
-                else if(outBitDepth==OCIO::BIT_DEPTH_UINT16)
-                {
-                    fmt = OIIO::TypeDesc::UINT16;
-                }
-                else
-                {
-                    throw OCIO::Exception("Unsupported output bit-depth.");
-                }
-            }
-
-            OIIO::ImageSpec dstSpec(spec.width, spec.height, spec.nchannels, fmt);
             OCIO::ImgBuffer dstImg(dstSpec);
             OCIO::ImageDescRcPtr dstImgDesc = OCIO::CreateImageDesc(dstSpec, dstImg);
 
@@ -445,7 +1441,8 @@ int main(int argc, const char **argv)
         {
             // Process line by line.
 
-            Measure m("Process the complete image (in place) but line by line:", iterations);
+            Measure m("Process the complete image (in place) but line by line:",
+                      "image_lines", iterations, report);
 
             for(unsigned iter=0; iter<iterations; ++iter)
             {
@@ -468,7 +1465,8 @@ int main(int argc, const char **argv)
 
             if(imgDesc.isRGBAPacked() && imgDesc.isFloat())
             {
-                Measure m("Process the complete image (in place) but pixel per pixel:", iterations);
+                Measure m("Process the complete image (in place) but pixel per pixel:",
+                          "image_pixels", iterations, report);
 
                 for(unsigned iter=0; iter<iterations; ++iter)
                 {
@@ -476,6 +1474,63 @@ int main(int argc, const char **argv)
                 }
             }
         }
+
+        if(!threads.empty())
+        {
+            // Process the complete image with input and output buffers using the
+            // internal thread pool with each number of threads.
+
+            const unsigned defaultNumThreads = OCIO::GetNumCPUThreads();
+
+            OCIO::ImgBuffer dstImg(dstSpec);
+
+            for(const unsigned numThreads : threads)
+            {
+                OCIO::SetNumCPUThreads(numThreads);
+
+                const std::string explanation
+                    = "Process the complete image (two buffers) using "
+                      + std::to_string(numThreads) + " thread(s):";
+
+                Measure m(explanation.c_str(), "threads_" + std::to_string(numThreads),
+                          iterations, report);
+
+                for(unsigned iter=0; iter<iterations; ++iter)
+                {
+                    ProcessImageParallel(m, cpuProcessor, spec, img, dstSpec, dstImg);
+                }
+            }
+
+            OCIO::SetNumCPUThreads(defaultNumThreads);
+        }
+
+        if(profileOps)
+        {
+            ProfileOps(processor, spec, img, iterations, report);
+        }
+
+        if(usegpu || usegpuLegacy)
+        {
+            MeasureGPU(processor, usegpuLegacy, verbose, spec, img, iterations, report);
+        }
+
+        if(accuracy)
+        {
+            MeasureAccuracy(processor, spec, img, iterations, report);
+        }
+
+        if(!jsonFilepath.empty())
+        {
+            report.write(jsonFilepath);
+
+            std::cout << std::endl;
+            std::cout << "Measures saved in '" << jsonFilepath << "'" << std::endl;
+        }
+
+        if(!baselineFilepath.empty())
+        {
+            numRegressions = report.compare(baselineFilepath, tolerance);
+        }
     }
     catch(OCIO::Exception & exception)
     {
@@ -488,5 +1543,5 @@ int main(int argc, const char **argv)
         exit(1);
     }
 
-    return 0;
+    return numRegressions==0 ? 0 : 1;
 }
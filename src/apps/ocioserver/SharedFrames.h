@@ -0,0 +1,107 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the OpenColorIO Project.
+
+
+#ifndef INCLUDED_OCIOSERVER_SHAREDFRAMES_H
+#define INCLUDED_OCIOSERVER_SHAREDFRAMES_H
+
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include <semaphore.h>
+
+
+// Layout of the shared memory between ocioserver and its clients: a header followed by a
+// ring of frame slots, each one holding a request and its pixels (i.e. processed in place
+// so the frames are never copied). The ring is scanned by the server in order, and the
+// process-shared semaphores signal the submitted and the processed frames. The server
+// reclaims the frames of the clients which exited without releasing them.
+
+namespace ocioserver
+{
+
+constexpr uint32_t SHARED_MAGIC     = 0x4F43494F; // i.e. "OCIO"
+constexpr uint32_t SHARED_VERSION   = 2;
+
+constexpr size_t MAX_NAME_LENGTH    = 256;
+constexpr size_t MAX_ERROR_LENGTH   = 512;
+constexpr size_t PIXELS_ALIGNMENT   = 64;
+
+enum SlotState : uint32_t
+{
+    SLOT_FREE = 0,   // Available to the clients.
+    SLOT_CLAIMED,    // Owned by a client filling the pixels.
+    SLOT_SUBMITTED,  // Waiting for the server.
+    SLOT_PROCESSING, // Owned by the server.
+    SLOT_DONE        // Processed, the client owning it again.
+};
+
+struct SharedHeader
+{
+    uint32_t m_magic;
+    uint32_t m_version;
+    uint32_t m_numSlots;
+    uint32_t m_maxNumPixels;        // Maximum number of pixels of a frame.
+    uint64_t m_slotStride;          // Number of bytes between two slots.
+
+    std::atomic<uint32_t> m_running;
+
+    sem_t m_submitted;              // Posted for each submitted frame.
+};
+
+struct SharedSlot
+{
+    std::atomic<uint32_t> m_state;
+    std::atomic<int32_t>  m_owner;  // Process id of the owning client, 0 when unknown.
+
+    sem_t m_processed;              // Posted when the frame is processed.
+
+    uint32_t m_width;
+    uint32_t m_height;
+    uint32_t m_numChannels;         // i.e. packed RGB or RGBA 32-bit float pixels.
+    int32_t  m_status;              // 0 when the processing succeeded.
+
+    char m_srcColorSpace[MAX_NAME_LENGTH];
+    char m_dstColorSpace[MAX_NAME_LENGTH];
+    char m_error[MAX_ERROR_LENGTH];
+};
+
+inline size_t AlignUp(size_t numBytes)
+{
+    return (numBytes + PIXELS_ALIGNMENT - 1) & ~(PIXELS_ALIGNMENT - 1);
+}
+
+inline size_t GetSlotStride(uint32_t maxNumPixels)
+{
+    return AlignUp(sizeof(SharedSlot)) + AlignUp(size_t(maxNumPixels) * 4 * sizeof(float));
+}
+
+inline size_t GetSharedSize(uint32_t numSlots, uint32_t maxNumPixels)
+{
+    return AlignUp(sizeof(SharedHeader)) + size_t(numSlots) * GetSlotStride(maxNumPixels);
+}
+
+inline SharedSlot * GetSlot(SharedHeader * header, uint32_t index)
+{
+    char * base = reinterpret_cast<char *>(header) + AlignUp(sizeof(SharedHeader));
+    return reinterpret_cast<SharedSlot *>(base + size_t(index) * header->m_slotStride);
+}
+
+inline float * GetPixels(SharedSlot * slot)
+{
+    char * pixels = reinterpret_cast<char *>(slot) + AlignUp(sizeof(SharedSlot));
+    return reinterpret_cast<float *>(pixels);
+}
+
+// The POSIX shared memory object name of a server.
+inline std::string GetSharedName(const char * serverName)
+{
+    return std::string("/") + serverName;
+}
+
+}
+
+#endif // INCLUDED_OCIOSERVER_SHAREDFRAMES_H
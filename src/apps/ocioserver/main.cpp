@@ -0,0 +1,330 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the OpenColorIO Project.
+
+#include <cerrno>
+#include <chrono>
+#include <csignal>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <iostream>
+#include <new>
+
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+#include <OpenColorIO/OpenColorIO.h>
+namespace OCIO = OCIO_NAMESPACE;
+
+#include "argparse.h"
+#include "SharedFrames.h"
+
+
+namespace
+{
+
+volatile sig_atomic_t g_stop = 0;
+ocioserver::SharedHeader * g_header = nullptr;
+
+void StopHandler(int)
+{
+    g_stop = 1;
+    // Wake up the server (sem_post() is async-signal-safe).
+    if (g_header)
+    {
+        sem_post(&g_header->m_submitted);
+    }
+}
+
+// Free the frames owned by the clients which exited (or were killed) without releasing
+// them, so the short-lived clients cannot exhaust the frames.
+void ReclaimSlots(ocioserver::SharedHeader * header)
+{
+    for (uint32_t idx = 0; idx < header->m_numSlots; ++idx)
+    {
+        ocioserver::SharedSlot * slot = ocioserver::GetSlot(header, idx);
+
+        uint32_t state = slot->m_state.load();
+        if (state != ocioserver::SLOT_CLAIMED && state != ocioserver::SLOT_DONE)
+        {
+            continue;
+        }
+
+        const pid_t owner = pid_t(slot->m_owner.load());
+        if (owner <= 0 || kill(owner, 0) == 0 || errno != ESRCH)
+        {
+            continue;
+        }
+
+        if (state == ocioserver::SLOT_DONE)
+        {
+            // The processed notification the client did not wait for.
+            while (sem_trywait(&slot->m_processed) == 0) {}
+        }
+
+        slot->m_owner.store(0);
+        slot->m_state.compare_exchange_strong(state, ocioserver::SLOT_FREE);
+    }
+}
+
+void SetSlotError(ocioserver::SharedSlot & slot, const char * error)
+{
+    slot.m_status = 1;
+    strncpy(slot.m_error, error, ocioserver::MAX_ERROR_LENGTH - 1);
+    slot.m_error[ocioserver::MAX_ERROR_LENGTH - 1] = '\0';
+}
+
+// Convert the frame in place. The config memoizes the processors so only the first frame
+// of a conversion pays for the LUT loading and the processor finalization.
+void ProcessFrame(const OCIO::ConstConfigRcPtr & config, uint32_t maxNumPixels,
+                  ocioserver::SharedSlot & slot, bool verbose)
+{
+    slot.m_srcColorSpace[ocioserver::MAX_NAME_LENGTH - 1] = '\0';
+    slot.m_dstColorSpace[ocioserver::MAX_NAME_LENGTH - 1] = '\0';
+
+    if ((slot.m_numChannels != 3 && slot.m_numChannels != 4)
+        || uint64_t(slot.m_width) * slot.m_height > maxNumPixels)
+    {
+        SetSlotError(slot, "Invalid frame description.");
+        return;
+    }
+
+    try
+    {
+        const auto start = std::chrono::steady_clock::now();
+
+        OCIO::ConstProcessorRcPtr processor
+            = config->getProcessor(slot.m_srcColorSpace, slot.m_dstColorSpace);
+        OCIO::ConstCPUProcessorRcPtr cpuProcessor = processor->getDefaultCPUProcessor();
+
+        OCIO::PackedImageDesc img(ocioserver::GetPixels(&slot),
+                                  slot.m_width, slot.m_height, slot.m_numChannels);
+
+        // Process the frame using the internal thread pool.
+        cpuProcessor->apply(img, OCIO::CPUExecutor());
+
+        slot.m_status   = 0;
+        slot.m_error[0] = '\0';
+
+        if (verbose)
+        {
+            const std::chrono::duration<double, std::milli> elapsed
+                = std::chrono::steady_clock::now() - start;
+            std::cout << "Processed " << slot.m_width << "x" << slot.m_height << " from '"
+                      << slot.m_srcColorSpace << "' to '" << slot.m_dstColorSpace
+                      << "' in " << elapsed.count() << " ms" << std::endl;
+        }
+    }
+    catch (const OCIO::Exception & e)
+    {
+        SetSlotError(slot, e.what());
+    }
+    catch (...)
+    {
+        SetSlotError(slot, "Unknown OCIO error encountered.");
+    }
+}
+
+}
+
+int main(int argc, const char ** argv)
+{
+    bool verbose = false;
+    std::string serverName = "ocioserver";
+    std::string configFilepath;
+    int numSlots = 8;
+    int maxWidth = 4096;
+    int maxHeight = 2160;
+
+    bool help = false;
+
+    ArgParse ap;
+    ap.options("ocioserver -- convert the frames submitted by the clients through shared memory\n\n"
+               "usage: ocioserver [options]\n\n"
+               "The config is loaded once and its processors stay warm for all the clients,\n"
+               "refer to ocioclient.h for the client API.\n\n",
+               "--h", &help, "Display the help and exit",
+               "--v", &verbose, "Display the processed frames",
+               "--name %s", &serverName, "Name of the server used by the clients "
+                                         "(default: ocioserver)",
+               "--config %s", &configFilepath, "Config file path (default: ${OCIO})",
+               "--frames %d", &numSlots, "Number of frames shared with the clients (default: 8)",
+               "--size %d %d", &maxWidth, &maxHeight, "Maximum frame size "
+                                                      "(default: 4096 2160)",
+               NULL);
+
+    if (ap.parse(argc, argv) < 0)
+    {
+        std::cerr << ap.geterror() << std::endl;
+        ap.usage();
+        exit(1);
+    }
+
+    if (help)
+    {
+        ap.usage();
+        exit(1);
+    }
+
+    if (serverName.empty() || serverName.find('/') != std::string::npos)
+    {
+        std::cerr << "Invalid server name: '" << serverName << "'." << std::endl;
+        exit(1);
+    }
+
+    if (numSlots < 1 || maxWidth < 1 || maxHeight < 1
+        || uint64_t(maxWidth) * uint64_t(maxHeight) > 0xFFFFFFFFull)
+    {
+        std::cerr << "Invalid number or size of frames." << std::endl;
+        exit(1);
+    }
+
+    OCIO::ConstConfigRcPtr config;
+    try
+    {
+        config = configFilepath.empty() ? OCIO::Config::CreateFromEnv()
+                                        : OCIO::Config::CreateFromFile(configFilepath.c_str());
+    }
+    catch (const OCIO::Exception & e)
+    {
+        std::cerr << "OCIO Error: " << e.what() << std::endl;
+        exit(1);
+    }
+
+    // Create the shared memory, replacing the one of a previous server with the same name.
+
+    const uint32_t maxNumPixels = uint32_t(uint64_t(maxWidth) * uint64_t(maxHeight));
+    const size_t sharedSize = ocioserver::GetSharedSize(uint32_t(numSlots), maxNumPixels);
+    const std::string sharedName = ocioserver::GetSharedName(serverName.c_str());
+
+    shm_unlink(sharedName.c_str());
+    const int fd = shm_open(sharedName.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+    if (fd < 0 || ftruncate(fd, off_t(sharedSize)) != 0)
+    {
+        std::cerr << "Cannot create the shared memory '" << sharedName << "': "
+                  << strerror(errno) << std::endl;
+        if (fd >= 0)
+        {
+            close(fd);
+            shm_unlink(sharedName.c_str());
+        }
+        exit(1);
+    }
+
+    void * base = mmap(nullptr, sharedSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (base == MAP_FAILED)
+    {
+        std::cerr << "Cannot map the shared memory '" << sharedName << "': "
+                  << strerror(errno) << std::endl;
+        close(fd);
+        shm_unlink(sharedName.c_str());
+        exit(1);
+    }
+
+    auto header = new (base) ocioserver::SharedHeader;
+    header->m_magic        = ocioserver::SHARED_MAGIC;
+    header->m_version      = ocioserver::SHARED_VERSION;
+    header->m_numSlots     = uint32_t(numSlots);
+    header->m_maxNumPixels = maxNumPixels;
+    header->m_slotStride   = ocioserver::GetSlotStride(maxNumPixels);
+    header->m_running.store(0);
+    sem_init(&header->m_submitted, 1, 0);
+
+    for (uint32_t idx = 0; idx < header->m_numSlots; ++idx)
+    {
+        auto slot = new (ocioserver::GetSlot(header, idx)) ocioserver::SharedSlot;
+        slot->m_state.store(ocioserver::SLOT_FREE);
+        slot->m_owner.store(0);
+        sem_init(&slot->m_processed, 1, 0);
+    }
+
+    g_header = header;
+    signal(SIGINT, StopHandler);
+    signal(SIGTERM, StopHandler);
+
+    header->m_running.store(1);
+
+    std::cout << "ocioserver '" << serverName << "' is running with " << numSlots
+              << " frame(s) of at most " << maxWidth << "x" << maxHeight << " pixels"
+              << std::endl;
+
+    // Process the submitted frames in the ring order, one notification per frame. A
+    // notification without frame is left by a client withdrawing its frame. The frames
+    // of the exited clients are reclaimed every second.
+
+    const auto reclaimInterval = std::chrono::seconds(1);
+    auto reclaimTime = std::chrono::steady_clock::now();
+
+    uint32_t next = 0;
+    while (!g_stop)
+    {
+        const auto now = std::chrono::steady_clock::now();
+        if (now - reclaimTime >= reclaimInterval)
+        {
+            ReclaimSlots(header);
+            reclaimTime = now;
+        }
+
+        struct timespec deadline;
+        clock_gettime(CLOCK_REALTIME, &deadline);
+        deadline.tv_sec += 1;
+
+        if (sem_timedwait(&header->m_submitted, &deadline) != 0)
+        {
+            if (errno == EINTR || errno == ETIMEDOUT)
+            {
+                continue;
+            }
+            break;
+        }
+
+        for (uint32_t n = 0; n < header->m_numSlots && !g_stop; ++n)
+        {
+            const uint32_t idx = (next + n) % header->m_numSlots;
+            ocioserver::SharedSlot * slot = ocioserver::GetSlot(header, idx);
+
+            uint32_t expected = ocioserver::SLOT_SUBMITTED;
+            if (slot->m_state.compare_exchange_strong(expected, ocioserver::SLOT_PROCESSING))
+            {
+                ProcessFrame(config, maxNumPixels, *slot, verbose);
+
+                slot->m_state.store(ocioserver::SLOT_DONE);
+                sem_post(&slot->m_processed);
+
+                next = idx + 1;
+                break;
+            }
+        }
+    }
+
+    // Fail the frames still waiting so their clients do not wait forever.
+
+    header->m_running.store(0);
+    for (uint32_t idx = 0; idx < header->m_numSlots; ++idx)
+    {
+        ocioserver::SharedSlot * slot = ocioserver::GetSlot(header, idx);
+
+        uint32_t expected = ocioserver::SLOT_SUBMITTED;
+        if (slot->m_state.compare_exchange_strong(expected, ocioserver::SLOT_PROCESSING))
+        {
+            SetSlotError(*slot, "The server stopped.");
+            slot->m_state.store(ocioserver::SLOT_DONE);
+            sem_post(&slot->m_processed);
+        }
+    }
+
+    g_header = nullptr;
+
+    // The clients still connected keep their mapping until they disconnect.
+    munmap(base, sharedSize);
+    close(fd);
+    shm_unlink(sharedName.c_str());
+
+    std::cout << "ocioserver '" << serverName << "' stopped" << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,363 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the OpenColorIO Project.
+
+#include <cerrno>
+#include <cstring>
+#include <ctime>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "ocioclient.h"
+#include "SharedFrames.h"
+
+
+struct OCIOClient
+{
+    int m_fd = -1;
+    void * m_base = nullptr;
+    size_t m_size = 0;
+
+    ocioserver::SharedHeader * m_header = nullptr;
+
+    // The frames acquired by this client (i.e. released on disconnection).
+    std::vector<bool> m_owned;
+    // The submitted frames whose processed notification is not consumed yet (i.e. the
+    // semaphore is waited for once per submission).
+    std::vector<bool> m_pending;
+
+    std::string m_lastError;
+};
+
+namespace
+{
+
+thread_local std::string g_connectError;
+
+int SetError(OCIOClient * client, const std::string & error)
+{
+    client->m_lastError = error;
+    return -1;
+}
+
+ocioserver::SharedSlot * GetOwnedSlot(OCIOClient * client, int frame)
+{
+    if (frame < 0 || frame >= int(client->m_owned.size()) || !client->m_owned[frame])
+    {
+        SetError(client, "Invalid frame " + std::to_string(frame) + ".");
+        return nullptr;
+    }
+
+    return ocioserver::GetSlot(client->m_header, uint32_t(frame));
+}
+
+// Consume the notification of a frame known to be processed. Note that the server
+// publishes the SLOT_DONE state before posting so the notification could be late.
+void ConsumeProcessed(ocioserver::SharedSlot * slot)
+{
+    while (sem_wait(&slot->m_processed) != 0 && errno == EINTR) {}
+}
+
+void CopyName(char * dst, const char * src)
+{
+    strncpy(dst, src, ocioserver::MAX_NAME_LENGTH - 1);
+    dst[ocioserver::MAX_NAME_LENGTH - 1] = '\0';
+}
+
+}
+
+extern "C"
+{
+
+OCIOClient * OCIOClientConnect(const char * serverName)
+{
+    if (!serverName || !*serverName)
+    {
+        g_connectError = "The server name is empty.";
+        return nullptr;
+    }
+
+    const std::string name = ocioserver::GetSharedName(serverName);
+
+    const int fd = shm_open(name.c_str(), O_RDWR, 0);
+    if (fd < 0)
+    {
+        g_connectError = "Cannot connect to the server '" + std::string(serverName)
+                         + "': " + strerror(errno) + ".";
+        return nullptr;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || size_t(st.st_size) < sizeof(ocioserver::SharedHeader))
+    {
+        close(fd);
+        g_connectError = "Invalid shared memory for the server '" + std::string(serverName)
+                         + "'.";
+        return nullptr;
+    }
+
+    void * base = mmap(nullptr, size_t(st.st_size), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (base == MAP_FAILED)
+    {
+        close(fd);
+        g_connectError = "Cannot map the shared memory of the server '"
+                         + std::string(serverName) + "': " + strerror(errno) + ".";
+        return nullptr;
+    }
+
+    auto header = static_cast<ocioserver::SharedHeader *>(base);
+    if (header->m_magic != ocioserver::SHARED_MAGIC
+        || header->m_version != ocioserver::SHARED_VERSION
+        || size_t(st.st_size)
+               < ocioserver::GetSharedSize(header->m_numSlots, header->m_maxNumPixels)
+        || header->m_running.load() == 0)
+    {
+        munmap(base, size_t(st.st_size));
+        close(fd);
+        g_connectError = "The server '" + std::string(serverName)
+                         + "' is not running or has an incompatible version.";
+        return nullptr;
+    }
+
+    OCIOClient * client = new OCIOClient;
+    client->m_fd     = fd;
+    client->m_base   = base;
+    client->m_size   = size_t(st.st_size);
+    client->m_header = header;
+    client->m_owned.resize(header->m_numSlots, false);
+    client->m_pending.resize(header->m_numSlots, false);
+
+    return client;
+}
+
+void OCIOClientDisconnect(OCIOClient * client)
+{
+    if (!client)
+    {
+        return;
+    }
+
+    for (size_t idx = 0; idx < client->m_owned.size(); ++idx)
+    {
+        if (client->m_owned[idx])
+        {
+            OCIOClientReleaseFrame(client, int(idx));
+        }
+    }
+
+    munmap(client->m_base, client->m_size);
+    close(client->m_fd);
+
+    delete client;
+}
+
+int OCIOClientAcquireFrame(OCIOClient * client, unsigned width, unsigned height,
+                           unsigned numChannels, float ** pixels)
+{
+    if (!client || !pixels)
+    {
+        return -1;
+    }
+
+    if (numChannels != 3 && numChannels != 4)
+    {
+        return SetError(client, "Only RGB and RGBA frames are supported.");
+    }
+
+    if (width == 0 || height == 0
+        || uint64_t(width) * height > client->m_header->m_maxNumPixels)
+    {
+        return SetError(client, "The frame size is not supported by the server (at most "
+                                + std::to_string(client->m_header->m_maxNumPixels)
+                                + " pixels).");
+    }
+
+    for (uint32_t idx = 0; idx < client->m_header->m_numSlots; ++idx)
+    {
+        ocioserver::SharedSlot * slot = ocioserver::GetSlot(client->m_header, idx);
+
+        uint32_t expected = ocioserver::SLOT_FREE;
+        if (slot->m_state.compare_exchange_strong(expected, ocioserver::SLOT_CLAIMED))
+        {
+            slot->m_owner.store(int32_t(getpid()));
+            slot->m_width       = width;
+            slot->m_height      = height;
+            slot->m_numChannels = numChannels;
+            slot->m_status      = 0;
+            slot->m_error[0]    = '\0';
+
+            client->m_owned[idx] = true;
+
+            *pixels = ocioserver::GetPixels(slot);
+            return int(idx);
+        }
+    }
+
+    return SetError(client, "All the frames of the server are in use.");
+}
+
+int OCIOClientSubmit(OCIOClient * client, int frame,
+                     const char * srcColorSpace, const char * dstColorSpace)
+{
+    if (!client)
+    {
+        return -1;
+    }
+
+    ocioserver::SharedSlot * slot = GetOwnedSlot(client, frame);
+    if (!slot)
+    {
+        return -1;
+    }
+
+    if (!srcColorSpace || !dstColorSpace
+        || strlen(srcColorSpace) >= ocioserver::MAX_NAME_LENGTH
+        || strlen(dstColorSpace) >= ocioserver::MAX_NAME_LENGTH)
+    {
+        return SetError(client, "Invalid color space names.");
+    }
+
+    const uint32_t state = slot->m_state.load();
+    if (state != ocioserver::SLOT_CLAIMED && state != ocioserver::SLOT_DONE)
+    {
+        return SetError(client, "The frame is already submitted.");
+    }
+
+    if (client->m_header->m_running.load() == 0)
+    {
+        return SetError(client, "The server is not running.");
+    }
+
+    if (client->m_pending[frame])
+    {
+        // Consume the notification of a processing not waited for.
+        ConsumeProcessed(slot);
+        client->m_pending[frame] = false;
+    }
+
+    CopyName(slot->m_srcColorSpace, srcColorSpace);
+    CopyName(slot->m_dstColorSpace, dstColorSpace);
+    slot->m_status   = 0;
+    slot->m_error[0] = '\0';
+
+    client->m_pending[frame] = true;
+
+    slot->m_state.store(ocioserver::SLOT_SUBMITTED);
+    sem_post(&client->m_header->m_submitted);
+
+    return 0;
+}
+
+int OCIOClientWait(OCIOClient * client, int frame, int timeoutMs)
+{
+    if (!client)
+    {
+        return -1;
+    }
+
+    ocioserver::SharedSlot * slot = GetOwnedSlot(client, frame);
+    if (!slot)
+    {
+        return -1;
+    }
+
+    if (!client->m_pending[frame])
+    {
+        if (slot->m_state.load() == ocioserver::SLOT_CLAIMED)
+        {
+            return SetError(client, "The frame is not submitted.");
+        }
+
+        // Already waited for.
+    }
+    else
+    {
+        int res = 0;
+        if (timeoutMs < 0)
+        {
+            while ((res = sem_wait(&slot->m_processed)) != 0 && errno == EINTR) {}
+        }
+        else
+        {
+            struct timespec deadline;
+            clock_gettime(CLOCK_REALTIME, &deadline);
+            deadline.tv_sec  += timeoutMs / 1000;
+            deadline.tv_nsec += long(timeoutMs % 1000) * 1000000L;
+            if (deadline.tv_nsec >= 1000000000L)
+            {
+                deadline.tv_sec  += 1;
+                deadline.tv_nsec -= 1000000000L;
+            }
+
+            while ((res = sem_timedwait(&slot->m_processed, &deadline)) != 0
+                   && errno == EINTR) {}
+        }
+
+        if (res != 0)
+        {
+            return SetError(client, errno == ETIMEDOUT ? "Timed out waiting for the frame."
+                                                       : "Failed waiting for the frame.");
+        }
+
+        client->m_pending[frame] = false;
+    }
+
+    if (slot->m_status != 0)
+    {
+        slot->m_error[ocioserver::MAX_ERROR_LENGTH - 1] = '\0';
+        return SetError(client, slot->m_error);
+    }
+
+    return 0;
+}
+
+int OCIOClientReleaseFrame(OCIOClient * client, int frame)
+{
+    if (!client)
+    {
+        return -1;
+    }
+
+    ocioserver::SharedSlot * slot = GetOwnedSlot(client, frame);
+    if (!slot)
+    {
+        return -1;
+    }
+
+    // The owner is cleared first so the server never reclaims the free frame once
+    // acquired by another client.
+    slot->m_owner.store(0);
+
+    // A frame not yet taken by the server is withdrawn (the server then ignoring the
+    // extra notification).
+    uint32_t expected = ocioserver::SLOT_SUBMITTED;
+    if (!slot->m_state.compare_exchange_strong(expected, ocioserver::SLOT_FREE))
+    {
+        if (expected == ocioserver::SLOT_PROCESSING)
+        {
+            slot->m_owner.store(int32_t(getpid()));
+            return SetError(client, "The frame is being processed.");
+        }
+
+        if (client->m_pending[frame])
+        {
+            ConsumeProcessed(slot);
+        }
+        slot->m_state.store(ocioserver::SLOT_FREE);
+    }
+
+    client->m_pending[frame] = false;
+    client->m_owned[frame]   = false;
+    return 0;
+}
+
+const char * OCIOClientGetLastError(const OCIOClient * client)
+{
+    return client ? client->m_lastError.c_str() : g_connectError.c_str();
+}
+
+}
@@ -0,0 +1,72 @@
+/* SPDX-License-Identifier: BSD-3-Clause */
+/* Copyright Contributors to the OpenColorIO Project. */
+
+
+#ifndef INCLUDED_OCIOCLIENT_H
+#define INCLUDED_OCIOCLIENT_H
+
+
+/*
+ * C API of the ocioserver clients. The frames are packed RGB or RGBA 32-bit float pixels
+ * living in the shared memory of the server, so the client writes the pixels in place,
+ * submits the frame and reads back the processed pixels without any copy. For example:
+ *
+ *     OCIOClient * client = OCIOClientConnect("ocioserver");
+ *     if (!client) { puts(OCIOClientGetLastError(NULL)); return; }
+ *
+ *     float * pixels = NULL;
+ *     const int frame = OCIOClientAcquireFrame(client, width, height, 4, &pixels);
+ *     ...fill the pixels...
+ *     if (OCIOClientSubmit(client, frame, "lnf", "vd8") != 0
+ *         || OCIOClientWait(client, frame, -1) != 0)
+ *     {
+ *         puts(OCIOClientGetLastError(client));
+ *     }
+ *     ...read the processed pixels...
+ *     OCIOClientReleaseFrame(client, frame);
+ *
+ *     OCIOClientDisconnect(client);
+ *
+ * A client is not thread-safe, but several clients (i.e. threads or processes) could share
+ * the same server.
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct OCIOClient OCIOClient;
+
+/* Connect to a running server, return NULL in case of failure. */
+OCIOClient * OCIOClientConnect(const char * serverName);
+
+/* Disconnect from the server, releasing the frames still owned by the client. */
+void OCIOClientDisconnect(OCIOClient * client);
+
+/* Acquire a free frame of the server for a width x height image having 3 or 4 channels,
+   and return its index (or -1 in case of failure) and its pixels. */
+int OCIOClientAcquireFrame(OCIOClient * client, unsigned width, unsigned height,
+                           unsigned numChannels, float ** pixels);
+
+/* Submit the frame to the server for a conversion between two color spaces (or roles) of
+   the server config. Return 0 on success. */
+int OCIOClientSubmit(OCIOClient * client, int frame,
+                     const char * srcColorSpace, const char * dstColorSpace);
+
+/* Wait for the processing of a submitted frame, at most timeoutMs milliseconds if not
+   negative. Return 0 on success, the frame pixels then being the processed ones. */
+int OCIOClientWait(OCIOClient * client, int frame, int timeoutMs);
+
+/* Give the frame back to the server. Return 0 on success, a frame being processed not
+   being releasable. */
+int OCIOClientReleaseFrame(OCIOClient * client, int frame);
+
+/* Return the last error of the client or, for a NULL client, the last connection error
+   of the calling thread. */
+const char * OCIOClientGetLastError(const OCIOClient * client);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INCLUDED_OCIOCLIENT_H */
@@ -1,6 +1,7 @@
 // SPDX-License-Identifier: BSD-3-Clause
 // Copyright Contributors to the OpenColorIO Project.
 
+#include <limits>
 #include <string>
 #include <sstream>
 #include <vector>
@@ -10,6 +11,70 @@
 #include "JNIUtil.h"
 OCIO_NAMESPACE_USING
 
+namespace
+{
+
+size_t GetChannelSize(BitDepth bitDepth)
+{
+    switch(bitDepth)
+    {
+        case BIT_DEPTH_UINT8:
+            return 1;
+        case BIT_DEPTH_UINT10:
+        case BIT_DEPTH_UINT12:
+        case BIT_DEPTH_UINT14:
+        case BIT_DEPTH_UINT16:
+        case BIT_DEPTH_F16:
+            return 2;
+        case BIT_DEPTH_UINT32:
+        case BIT_DEPTH_F32:
+            return 4;
+        case BIT_DEPTH_UNKNOWN:
+        default:
+            break;
+    }
+    throw Exception("Unsupported bit-depth for the pixel buffer.");
+}
+
+// Process in place the pixels of a direct NIO buffer i.e. no copy of the pixels. The
+// Java Processor.AutoStride value (i.e. Long.MIN_VALUE) means packed pixels.
+void ApplyDirectBuffer(JNIEnv * env, jobject self, jobject data, jlong width, jlong height,
+                       jlong numChannels, jobject bitDepth, jlong chanStrideBytes,
+                       jlong xStrideBytes, jlong yStrideBytes)
+{
+    ConstProcessorRcPtr ptr = GetConstJOCIO<ConstProcessorRcPtr, ProcessorJNI>(env, self);
+    const BitDepth depth = GetJEnum<BitDepth>(env, bitDepth);
+
+    if(width<=0 || height<=0 || (numChannels!=3 && numChannels!=4))
+    {
+        throw Exception("Invalid pixel buffer dimensions.");
+    }
+
+    const jlong autoStride = std::numeric_limits<jlong>::min();
+    const jlong chanStride = chanStrideBytes==autoStride ? (jlong)GetChannelSize(depth)
+                                                         : chanStrideBytes;
+    const jlong xStride = xStrideBytes==autoStride ? chanStride * numChannels : xStrideBytes;
+    const jlong yStride = yStrideBytes==autoStride ? xStride * width : yStrideBytes;
+    if(chanStride<=0 || xStride<=0 || yStride<=0)
+    {
+        throw Exception("The pixel buffer strides must be positive.");
+    }
+
+    const jlong sizeBytes = yStride * (height - 1) + xStride * (width - 1)
+                            + chanStride * (numChannels - 1) + (jlong)GetChannelSize(depth);
+    void* _data = GetJDirectBuffer(env, data, sizeBytes);
+
+    PackedImageDesc img(_data, (long)width, (long)height, (long)numChannels, depth,
+                        (ptrdiff_t)chanStride, (ptrdiff_t)xStride, (ptrdiff_t)yStride);
+
+    // The CPU processors are cached by the processor (per bit-depth).
+    ConstCPUProcessorRcPtr cpu
+        = ptr->getOptimizedCPUProcessor(depth, depth, OPTIMIZATION_DEFAULT, FINALIZATION_DEFAULT);
+    cpu->apply(img, CPUExecutor());
+}
+
+}; // end anon namespace
+
 JNIEXPORT jobject JNICALL
 Java_org_OpenColorIO_Processor_Create(JNIEnv * env, jobject self) {
     OCIO_JNITRY_ENTER()
@@ -36,11 +101,33 @@ Java_org_OpenColorIO_Processor_hasChannelCrosstalk(JNIEnv * env, jobject self) {
 }
 
 JNIEXPORT void JNICALL
-Java_org_OpenColorIO_Processor_apply(JNIEnv * env, jobject self, jobject img) {
+Java_org_OpenColorIO_Processor_apply__Lorg_OpenColorIO_ImageDesc_2(JNIEnv * env,
+    jobject self, jobject img) {
     OCIO_JNITRY_ENTER()
     ConstProcessorRcPtr ptr = GetConstJOCIO<ConstProcessorRcPtr, ProcessorJNI>(env, self);
     ImageDescRcPtr _img = GetEditableJOCIO<ImageDescRcPtr, ImageDescJNI>(env, img);
-    ptr->apply(*_img.get());
+    ptr->getDefaultCPUProcessor()->apply(*_img.get());
+    OCIO_JNITRY_EXIT()
+}
+
+JNIEXPORT void JNICALL
+Java_org_OpenColorIO_Processor_apply__Ljava_nio_Buffer_2JJJLorg_OpenColorIO_BitDepth_2(
+    JNIEnv * env, jobject self, jobject data, jlong width, jlong height, jlong numChannels,
+    jobject bitDepth) {
+    OCIO_JNITRY_ENTER()
+    const jlong autoStride = std::numeric_limits<jlong>::min();
+    ApplyDirectBuffer(env, self, data, width, height, numChannels, bitDepth,
+                      autoStride, autoStride, autoStride);
+    OCIO_JNITRY_EXIT()
+}
+
+JNIEXPORT void JNICALL
+Java_org_OpenColorIO_Processor_apply__Ljava_nio_Buffer_2JJJLorg_OpenColorIO_BitDepth_2JJJ(
+    JNIEnv * env, jobject self, jobject data, jlong width, jlong height, jlong numChannels,
+    jobject bitDepth, jlong chanStrideBytes, jlong xStrideBytes, jlong yStrideBytes) {
+    OCIO_JNITRY_ENTER()
+    ApplyDirectBuffer(env, self, data, width, height, numChannels, bitDepth,
+                      chanStrideBytes, xStrideBytes, yStrideBytes);
     OCIO_JNITRY_EXIT()
 }
 
@@ -48,7 +135,7 @@ JNIEXPORT void JNICALL
 Java_org_OpenColorIO_Processor_applyRGB(JNIEnv * env, jobject self, jfloatArray pixel) {
     OCIO_JNITRY_ENTER()
     ConstProcessorRcPtr ptr = GetConstJOCIO<ConstProcessorRcPtr, ProcessorJNI>(env, self);
-    ptr->applyRGB(GetJFloatArrayValue(env, pixel, "pixel", 3)());
+    ptr->getDefaultCPUProcessor()->applyRGB(GetJFloatArrayValue(env, pixel, "pixel", 3)());
     OCIO_JNITRY_EXIT()
 }
 
@@ -56,7 +143,7 @@ JNIEXPORT void JNICALL
 Java_org_OpenColorIO_Processor_applyRGBA(JNIEnv * env, jobject self, jfloatArray pixel) {
     OCIO_JNITRY_ENTER()
     ConstProcessorRcPtr ptr = GetConstJOCIO<ConstProcessorRcPtr, ProcessorJNI>(env, self);
-    ptr->applyRGBA(GetJFloatArrayValue(env, pixel, "pixel", 4)());
+    ptr->getDefaultCPUProcessor()->applyRGBA(GetJFloatArrayValue(env, pixel, "pixel", 4)());
     OCIO_JNITRY_EXIT()
 }
 
@@ -35,6 +35,35 @@ float* GetJFloatBuffer(JNIEnv * env, jobject buffer, int32_t len) {
     return (float*)env->GetDirectBufferAddress(buffer);
 }
 
+void* GetJDirectBuffer(JNIEnv * env, jobject buffer, jlong sizeBytes) {
+    void* ptr = env->GetDirectBufferAddress(buffer);
+    if(!ptr) {
+        std::ostringstream err;
+        err << "the Buffer object is not 'direct' it needs to be created ";
+        err << "from a ByteBuffer.allocateDirect(..) call.";
+        throw Exception(err.str().c_str());
+    }
+    // The capacity is a number of elements of the buffer type.
+    jlong elementSize = 1;
+    if(env->IsInstanceOf(buffer, env->FindClass("java/nio/FloatBuffer"))
+        || env->IsInstanceOf(buffer, env->FindClass("java/nio/IntBuffer")))
+        elementSize = 4;
+    else if(env->IsInstanceOf(buffer, env->FindClass("java/nio/ShortBuffer"))
+        || env->IsInstanceOf(buffer, env->FindClass("java/nio/CharBuffer")))
+        elementSize = 2;
+    else if(env->IsInstanceOf(buffer, env->FindClass("java/nio/DoubleBuffer"))
+        || env->IsInstanceOf(buffer, env->FindClass("java/nio/LongBuffer")))
+        elementSize = 8;
+    const jlong capacityBytes = env->GetDirectBufferCapacity(buffer) * elementSize;
+    if(capacityBytes < sizeBytes) {
+        std::ostringstream err;
+        err << "the Buffer object is not allocated correctly it needs at least ";
+        err << sizeBytes << " bytes but has " << capacityBytes << ".";
+        throw Exception(err.str().c_str());
+    }
+    return ptr;
+}
+
 const char* GetOCIOTClass(ConstTransformRcPtr tran) {
     if(ConstAllocationTransformRcPtr at = DynamicPtrCast<const AllocationTransform>(tran))
         return "org/OpenColorIO/AllocationTransform";
@@ -244,6 +244,8 @@ private:
 
 jobject NewJFloatBuffer(JNIEnv * env, float* ptr, int32_t len);
 float* GetJFloatBuffer(JNIEnv * env, jobject buffer, int32_t len);
+// Get the address of a direct NIO buffer (of any type) holding at least sizeBytes bytes.
+void* GetJDirectBuffer(JNIEnv * env, jobject buffer, jlong sizeBytes);
 const char* GetOCIOTClass(ConstTransformRcPtr tran);
 void JNI_Handle_Exception(JNIEnv * env);
 
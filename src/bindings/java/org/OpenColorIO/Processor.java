@@ -3,6 +3,7 @@
 
 package org.OpenColorIO;
 import org.OpenColorIO.*;
+import java.nio.Buffer;
 import java.nio.FloatBuffer;
 
 public class Processor extends LoadLibrary
@@ -15,6 +16,15 @@ public class Processor extends LoadLibrary
     public native boolean isNoOp();
     public native boolean hasChannelCrosstalk();
     public native void apply(ImageDesc img);
+    // Process in place the pixels of a direct buffer (e.g. ByteBuffer.allocateDirect(..))
+    // i.e. without copying them. The bit-depth gives the type of the channel values and
+    // AutoStride means packed pixels.
+    public static final long AutoStride = Long.MIN_VALUE;
+    public native void apply(Buffer data, long width, long height, long numChannels,
+                             BitDepth bitDepth);
+    public native void apply(Buffer data, long width, long height, long numChannels,
+                             BitDepth bitDepth, long chanStrideBytes, long xStrideBytes,
+                             long yStrideBytes);
     public native void applyRGB(float[] pixel);
     public native void applyRGBA(float[] pixel);
     public native String getCpuCacheID();
@@ -647,3 +647,25 @@ class Config:
         :type context: object
         """
         pass
+
+    def getProcessors(self, requests, numThreads=0, context=None):
+        """
+        getProcessors(requests[, numThreads[, context]])
+        
+        Returns the processors of several requests, built concurrently with
+        the GIL released, in the order of the requests. Each request is either
+        a transform or a (source, destination) pair of ColorSpace names,
+        objects, or roles (as for
+        :py:meth:`PyOpenColorIO.Config.getProcessor`).
+        
+        The first error met is raised once all the started buildings are done.
+        
+        :param requests: transforms or (source, destination) pairs
+        :type requests: sequence
+        :param numThreads: optional, the number of hardware threads when zero
+        :type numThreads: int
+        :param context: optional
+        :type context: object
+        :return: list of Processor objects
+        """
+        pass
@@ -19,4 +19,66 @@ class GpuShaderDesc:
         pass
     def finalize(self):
         pass
+    def getShaderText(self):
+        pass
+    def getNumTextures(self):
+        pass
+    def getTexture(self, index):
+        """
+        getTexture(index)
+        
+        Returns the description of a 1D or 2D texture.
+        
+        :param index: texture index
+        :type index: int
+        :return: name, id, width, height, number of channels (1 or 3) and interpolation
+        :rtype: tuple
+        """
+        pass
+    def getTextureValues(self, index):
+        """
+        getTextureValues(index)
+        
+        Returns the 32-bit float values of a texture as a read-only memoryview
+        of shape (height, width, channels), usable as is by numpy.asarray or
+        by a GPU upload. The values are not copied so the view is only valid
+        while the shader description is not modified (e.g. by another
+        :py:meth:`PyOpenColorIO.Processor.extractGpuShaderInfo`).
+        
+        :param index: texture index
+        :type index: int
+        :return: texture values
+        :rtype: memoryview
+        """
+        pass
+    def getNum3DTextures(self):
+        pass
+    def get3DTexture(self, index):
+        """
+        get3DTexture(index)
+        
+        Returns the description of a 3D texture.
+        
+        :param index: 3D texture index
+        :type index: int
+        :return: name, id, edge length and interpolation
+        :rtype: tuple
+        """
+        pass
+    def get3DTextureValues(self, index):
+        """
+        get3DTextureValues(index)
+        
+        Returns the 32-bit float RGB values of a 3D texture as a read-only
+        memoryview of shape (edgelen, edgelen, edgelen, 3) indexed by
+        [red, green, blue] i.e. with blue changing the fastest. Like
+        :py:meth:`PyOpenColorIO.GpuShaderDesc.getTextureValues`, the values
+        are not copied.
+        
+        :param index: 3D texture index
+        :type index: int
+        :return: 3D texture values
+        :rtype: memoryview
+        """
+        pass
 
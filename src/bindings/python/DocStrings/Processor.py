@@ -78,6 +78,40 @@ class Processor:
         """
         pass
         
+    def apply(self, pixeldata, numChannels=0, bitDepth=None):
+        """
+        apply(pixeldata, numChannels=0, bitDepth=None)
+        
+        Apply the transform represented by :py:class:`PyOpenColorIO.Processor`
+        in place to any writable and contiguous buffer (e.g. a numpy array) of
+        uint8, uint16, float16 or float32 values. Unlike applyRGB and applyRGBA,
+        no copy of the pixels is made, and the GIL is released while the pixels
+        are processed using several threads.
+        
+        :param pixeldata: the RGB or RGBA pixels to process in place
+        :type pixeldata: buffer
+        :param numChannels: 3 or 4, defaults to the last dimension of the buffer
+        :type numChannels: int
+        :param bitDepth: overrides the bit-depth of uint16 values (e.g. BIT_DEPTH_UINT10)
+        :type bitDepth: string
+        :return: pixeldata
+        :rtype: buffer
+        """
+        pass
+        
+    def extractGpuShaderInfo(self, shaderDesc):
+        """
+        extractGpuShaderInfo(shaderDesc)
+        
+        Fill the shader description (i.e. the shader program and the textures)
+        of the transform represented by :py:class:`PyOpenColorIO.Processor`.
+        The GIL is released while the GPU processor is built.
+        
+        :param shaderDesc: the shader description to fill
+        :type shaderDesc: :py:class:`PyOpenColorIO.GpuShaderDesc`
+        """
+        pass
+        
     def getCpuCacheID(self):
         """
         getCpuCacheID()
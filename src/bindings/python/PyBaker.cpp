@@ -407,9 +407,13 @@ OCIO_NAMESPACE_ENTER
         {
             OCIO_PYTRY_ENTER()
             ConstBakerRcPtr baker = GetConstBaker(self);
-            std::ostringstream os;
-            baker->bake(os);
-            return PyString_FromString(os.str().c_str());
+            const std::string lut = CallWithoutGIL([&baker]()
+                {
+                    std::ostringstream os;
+                    baker->bake(os);
+                    return os.str();
+                });
+            return PyString_FromString(lut.c_str());
             OCIO_PYTRY_EXIT(NULL)
         }
         
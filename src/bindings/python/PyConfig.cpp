@@ -2,7 +2,12 @@
 // Copyright Contributors to the OpenColorIO Project.
 
 #include <Python.h>
+#include <algorithm>
+#include <atomic>
+#include <mutex>
 #include <sstream>
+#include <thread>
+#include <vector>
 #include <OpenColorIO/OpenColorIO.h>
 
 #include "PyUtil.h"
@@ -118,6 +123,7 @@ OCIO_NAMESPACE_ENTER
         PyObject * PyOCIO_Config_addLook(PyObject * self, PyObject * args);
         PyObject * PyOCIO_Config_clearLooks(PyObject * self, PyObject *);
         PyObject * PyOCIO_Config_getProcessor(PyObject * self, PyObject * args, PyObject * kwargs);
+        PyObject * PyOCIO_Config_getProcessors(PyObject * self, PyObject * args, PyObject * kwargs);
         
         ///////////////////////////////////////////////////////////////////////
         ///
@@ -260,6 +266,8 @@ OCIO_NAMESPACE_ENTER
             (PyCFunction) PyOCIO_Config_clearLooks, METH_NOARGS, CONFIG_CLEARLOOKS__DOC__ },
             { "getProcessor",
             (PyCFunction) PyOCIO_Config_getProcessor, METH_VARARGS|METH_KEYWORDS, CONFIG_GETPROCESSOR__DOC__ },
+            { "getProcessors",
+            (PyCFunction) PyOCIO_Config_getProcessors, METH_VARARGS|METH_KEYWORDS, CONFIG_GETPROCESSORS__DOC__ },
             { NULL, NULL, 0, NULL }
         };
         
@@ -324,7 +332,7 @@ OCIO_NAMESPACE_ENTER
         PyObject * PyOCIO_Config_CreateFromEnv(PyObject *, PyObject * /*self*, *args*/)
         {
             OCIO_PYTRY_ENTER()
-            return BuildConstPyConfig(Config::CreateFromEnv());
+            return BuildConstPyConfig(CallWithoutGIL([]() { return Config::CreateFromEnv(); }));
             OCIO_PYTRY_EXIT(NULL)
         }
         
@@ -333,7 +341,10 @@ OCIO_NAMESPACE_ENTER
             OCIO_PYTRY_ENTER()
             char* filename = 0;
             if (!PyArg_ParseTuple(args,"s:CreateFromFile", &filename)) return NULL;
-            return BuildConstPyConfig(Config::CreateFromFile(filename));
+            return BuildConstPyConfig(CallWithoutGIL([filename]()
+                {
+                    return Config::CreateFromFile(filename);
+                }));
             OCIO_PYTRY_EXIT(NULL)
         }
         
@@ -342,9 +353,13 @@ OCIO_NAMESPACE_ENTER
             OCIO_PYTRY_ENTER()
             char* stream = 0;
             if (!PyArg_ParseTuple(args,"s:CreateFromStream", &stream)) return NULL;
-            std::istringstream is;
-            is.str(stream);
-            return BuildConstPyConfig(Config::CreateFromStream(is));
+            const std::string str(stream);
+            return BuildConstPyConfig(CallWithoutGIL([&str]()
+                {
+                    std::istringstream is;
+                    is.str(str);
+                    return Config::CreateFromStream(is);
+                }));
             OCIO_PYTRY_EXIT(NULL)
         }
         
@@ -1056,7 +1071,10 @@ OCIO_NAMESPACE_ENTER
                 
             if(IsPyTransform(arg1)) {
                 ConstTransformRcPtr transform = GetConstTransform(arg1, true);
-                return BuildConstPyProcessor(config->getProcessor(context, transform, dir));
+                return BuildConstPyProcessor(CallWithoutGIL([&]()
+                    {
+                        return config->getProcessor(context, transform, dir);
+                    }));
             }
             
             // Any two (Colorspaces, colorspace name, roles)
@@ -1084,7 +1102,155 @@ OCIO_NAMESPACE_ENTER
                 return NULL;
             }
             
-            return BuildConstPyProcessor(config->getProcessor(context, cs1, cs2));
+            return BuildConstPyProcessor(CallWithoutGIL([&]()
+                {
+                    return config->getProcessor(context, cs1, cs2);
+                }));
+            OCIO_PYTRY_EXIT(NULL)
+        }
+        
+        // A processor to build by getProcessors() i.e. from a transform or from
+        // two color spaces.
+        struct ProcessorRequest
+        {
+            ConstTransformRcPtr transform;
+            ConstColorSpaceRcPtr src;
+            ConstColorSpaceRcPtr dst;
+        };
+        
+        ConstColorSpaceRcPtr GetColorSpaceArg(const ConstConfigRcPtr & config, PyObject * arg)
+        {
+            if(IsPyColorSpace(arg))
+                return GetConstColorSpace(arg, true);
+            else if(PyString_Check(arg))
+                return config->getColorSpace(PyString_AsString(arg));
+            return ConstColorSpaceRcPtr();
+        }
+        
+        PyObject * PyOCIO_Config_getProcessors(PyObject * self, PyObject * args, PyObject * kwargs)
+        {
+            OCIO_PYTRY_ENTER()
+            
+            PyObject* pyRequests = Py_None;
+            int numThreads = 0;
+            PyObject* pycontext = Py_None;
+            
+            const char* kwlist[] = { "requests", "numThreads", "context",  NULL };
+            
+            if (!PyArg_ParseTupleAndKeywords(args, kwargs, "O|iO",
+                const_cast<char**>(kwlist),
+                &pyRequests, &numThreads, &pycontext)) return 0;
+            
+            ConstConfigRcPtr config = GetConstConfig(self, true);
+            
+            ConstContextRcPtr context;
+            if(pycontext != Py_None) context = GetConstContext(pycontext, true);
+            if(!context) context = config->getCurrentContext();
+            
+            if(!PySequence_Check(pyRequests))
+            {
+                PyErr_SetString(PyExc_TypeError,
+                    "The first argument must be a sequence of transforms or of (src, dst) pairs.");
+                return NULL;
+            }
+            
+            // Only the parsing of the Python objects needs the GIL.
+            const Py_ssize_t numRequests = PySequence_Size(pyRequests);
+            std::vector<ProcessorRequest> requests(size_t(std::max<Py_ssize_t>(numRequests, 0)));
+            for(Py_ssize_t idx = 0; idx < numRequests; ++idx)
+            {
+                PyObject * item = PySequence_GetItem(pyRequests, idx);
+                if(!item) return NULL;
+                
+                ProcessorRequest & request = requests[size_t(idx)];
+                if(IsPyTransform(item))
+                {
+                    request.transform = GetConstTransform(item, true);
+                }
+                else if(PySequence_Check(item) && PySequence_Size(item) == 2)
+                {
+                    PyObject * src = PySequence_GetItem(item, 0);
+                    PyObject * dst = PySequence_GetItem(item, 1);
+                    if(src) request.src = GetColorSpaceArg(config, src);
+                    if(dst) request.dst = GetColorSpaceArg(config, dst);
+                    Py_XDECREF(src);
+                    Py_XDECREF(dst);
+                }
+                Py_DECREF(item);
+                
+                if(!request.transform && (!request.src || !request.dst))
+                {
+                    std::ostringstream os;
+                    os << "Could not parse the request " << idx << ". Allowed types include ";
+                    os << "Transform and (src, dst) pairs of ColorSpace, ColorSpace name, Role.";
+                    PyErr_SetString(PyExc_ValueError, os.str().c_str());
+                    return NULL;
+                }
+            }
+            
+            // Build the processors concurrently, the first error being reported.
+            std::vector<ConstProcessorRcPtr> processors(requests.size());
+            CallWithoutGIL([&]()
+            {
+                std::atomic<size_t> nextRequest(0);
+                std::atomic<bool> failed(false);
+                std::exception_ptr error;
+                std::mutex errorMutex;
+                
+                auto worker = [&]()
+                {
+                    size_t idx = 0;
+                    while(!failed && (idx = nextRequest++) < requests.size())
+                    {
+                        try
+                        {
+                            const ProcessorRequest & request = requests[idx];
+                            processors[idx] = request.transform
+                                ? config->getProcessor(context, request.transform,
+                                                       TRANSFORM_DIR_FORWARD)
+                                : config->getProcessor(context, request.src, request.dst);
+                        }
+                        catch(...)
+                        {
+                            std::lock_guard<std::mutex> lock(errorMutex);
+                            if(!failed)
+                            {
+                                error = std::current_exception();
+                                failed = true;
+                            }
+                        }
+                    }
+                };
+                
+                size_t numWorkers = numThreads > 0 ? size_t(numThreads)
+                                                   : size_t(std::thread::hardware_concurrency());
+                numWorkers = std::max(std::min(numWorkers, requests.size()), size_t(1));
+                
+                std::vector<std::thread> workers;
+                for(size_t idx = 1; idx < numWorkers; ++idx)
+                {
+                    workers.emplace_back(worker);
+                }
+                worker();
+                for(auto & thread : workers)
+                {
+                    thread.join();
+                }
+                
+                if(error)
+                {
+                    std::rethrow_exception(error);
+                }
+                return true;
+            });
+            
+            PyObject * list = PyList_New(Py_ssize_t(processors.size()));
+            if(!list) return NULL;
+            for(size_t idx = 0; idx < processors.size(); ++idx)
+            {
+                PyList_SET_ITEM(list, Py_ssize_t(idx), BuildConstPyProcessor(processors[idx]));
+            }
+            return list;
             OCIO_PYTRY_EXIT(NULL)
         }
         
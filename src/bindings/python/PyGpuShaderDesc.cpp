@@ -36,6 +36,13 @@ OCIO_NAMESPACE_ENTER
         PyObject * PyOCIO_GpuShaderDesc_getFunctionName(PyObject * self);
         PyObject * PyOCIO_GpuShaderDesc_getCacheID(PyObject * self);
         PyObject * PyOCIO_GpuShaderDesc_finalize(PyObject * self);
+        PyObject * PyOCIO_GpuShaderDesc_getShaderText(PyObject * self);
+        PyObject * PyOCIO_GpuShaderDesc_getNumTextures(PyObject * self);
+        PyObject * PyOCIO_GpuShaderDesc_getTexture(PyObject * self, PyObject * args);
+        PyObject * PyOCIO_GpuShaderDesc_getTextureValues(PyObject * self, PyObject * args);
+        PyObject * PyOCIO_GpuShaderDesc_getNum3DTextures(PyObject * self);
+        PyObject * PyOCIO_GpuShaderDesc_get3DTexture(PyObject * self, PyObject * args);
+        PyObject * PyOCIO_GpuShaderDesc_get3DTextureValues(PyObject * self, PyObject * args);
         
         ///////////////////////////////////////////////////////////////////////
         ///
@@ -53,6 +60,20 @@ OCIO_NAMESPACE_ENTER
             (PyCFunction) PyOCIO_GpuShaderDesc_getCacheID, METH_NOARGS, GPUSHADERDESC_GETCACHEID__DOC__ },
             { "finalize",
             (PyCFunction) PyOCIO_GpuShaderDesc_finalize, METH_NOARGS, GPUSHADERDESC_FINALIZE__DOC__ },
+            { "getShaderText",
+            (PyCFunction) PyOCIO_GpuShaderDesc_getShaderText, METH_NOARGS, GPUSHADERDESC_GETSHADERTEXT__DOC__ },
+            { "getNumTextures",
+            (PyCFunction) PyOCIO_GpuShaderDesc_getNumTextures, METH_NOARGS, GPUSHADERDESC_GETNUMTEXTURES__DOC__ },
+            { "getTexture",
+            PyOCIO_GpuShaderDesc_getTexture, METH_VARARGS, GPUSHADERDESC_GETTEXTURE__DOC__ },
+            { "getTextureValues",
+            PyOCIO_GpuShaderDesc_getTextureValues, METH_VARARGS, GPUSHADERDESC_GETTEXTUREVALUES__DOC__ },
+            { "getNum3DTextures",
+            (PyCFunction) PyOCIO_GpuShaderDesc_getNum3DTextures, METH_NOARGS, GPUSHADERDESC_GETNUM3DTEXTURES__DOC__ },
+            { "get3DTexture",
+            PyOCIO_GpuShaderDesc_get3DTexture, METH_VARARGS, GPUSHADERDESC_GET3DTEXTURE__DOC__ },
+            { "get3DTextureValues",
+            PyOCIO_GpuShaderDesc_get3DTextureValues, METH_VARARGS, GPUSHADERDESC_GET3DTEXTUREVALUES__DOC__ },
             { NULL, NULL, 0, NULL }
         };
         
@@ -110,6 +131,135 @@ OCIO_NAMESPACE_ENTER
         ///////////////////////////////////////////////////////////////////////
         ///
         
+        // Read-only exporter (refer to the Python buffer protocol) of the 32-bit float
+        // values of a texture. The values are owned by the shader description so the
+        // exporter keeps a reference to it instead of copying them.
+        struct PyOCIO_TextureValues
+        {
+            PyObject_HEAD
+            PyObject * owner;
+            const float * values;
+            int ndim;
+            Py_ssize_t shape[4];
+            Py_ssize_t strides[4];
+        };
+        
+        void PyOCIO_TextureValues_delete(PyOCIO_TextureValues * self)
+        {
+            Py_XDECREF(self->owner);
+            PyObject_Del(self);
+        }
+        
+        int PyOCIO_TextureValues_getbuffer(PyObject * self, Py_buffer * view, int flags)
+        {
+            PyOCIO_TextureValues * texture = (PyOCIO_TextureValues *)self;
+            
+            Py_ssize_t numValues = 1;
+            for(int dim=0; dim<texture->ndim; ++dim) numValues *= texture->shape[dim];
+            
+            // Also rejects the writable requests.
+            if(PyBuffer_FillInfo(view, self, (void *)texture->values,
+                                 numValues * Py_ssize_t(sizeof(float)), 1, flags) < 0)
+            {
+                return -1;
+            }
+            
+            // Without a shape request, the buffer is seen as unsigned bytes.
+            if((flags & PyBUF_ND) == PyBUF_ND)
+            {
+                view->itemsize = sizeof(float);
+                view->format   = (flags & PyBUF_FORMAT) ? (char *)"f" : NULL;
+                view->ndim     = texture->ndim;
+                view->shape    = texture->shape;
+                view->strides
+                    = ((flags & PyBUF_STRIDES) == PyBUF_STRIDES) ? texture->strides : NULL;
+            }
+            
+            return 0;
+        }
+        
+#if PY_MAJOR_VERSION >= 3
+        PyBufferProcs PyOCIO_TextureValues_as_buffer = {
+            (getbufferproc) PyOCIO_TextureValues_getbuffer, //bf_getbuffer
+            0,                                              //bf_releasebuffer
+        };
+        
+        const long PyOCIO_TextureValues_flags = Py_TPFLAGS_DEFAULT;
+#else
+        PyBufferProcs PyOCIO_TextureValues_as_buffer = {
+            0,                                              //bf_getreadbuffer
+            0,                                              //bf_getwritebuffer
+            0,                                              //bf_getsegcount
+            0,                                              //bf_getcharbuffer
+            (getbufferproc) PyOCIO_TextureValues_getbuffer, //bf_getbuffer
+            0,                                              //bf_releasebuffer
+        };
+        
+        const long PyOCIO_TextureValues_flags = Py_TPFLAGS_DEFAULT | Py_TPFLAGS_HAVE_NEWBUFFER;
+#endif
+        
+        PyTypeObject PyOCIO_TextureValuesType = {
+            PyVarObject_HEAD_INIT(NULL, 0)              //ob_size
+            OCIO_PYTHON_NAMESPACE(TextureValues),       //tp_name
+            sizeof(PyOCIO_TextureValues),               //tp_basicsize
+            0,                                          //tp_itemsize
+            (destructor)PyOCIO_TextureValues_delete,    //tp_dealloc
+            0,                                          //tp_print
+            0,                                          //tp_getattr
+            0,                                          //tp_setattr
+            0,                                          //tp_compare
+            0,                                          //tp_repr
+            0,                                          //tp_as_number
+            0,                                          //tp_as_sequence
+            0,                                          //tp_as_mapping
+            0,                                          //tp_hash 
+            0,                                          //tp_call
+            0,                                          //tp_str
+            0,                                          //tp_getattro
+            0,                                          //tp_setattro
+            &PyOCIO_TextureValues_as_buffer,            //tp_as_buffer
+            PyOCIO_TextureValues_flags,                 //tp_flags
+            0,                                          //tp_doc 
+        };
+        
+        // Build a read-only memoryview of texture values owned by a shader description.
+        PyObject * BuildTextureValuesView(PyObject * owner, const float * values,
+                                          int ndim, const Py_ssize_t * shape)
+        {
+            if(!values)
+            {
+                PyErr_SetString(PyExc_RuntimeError, "The texture has no 32-bit float values.");
+                return NULL;
+            }
+            
+            if(!(PyOCIO_TextureValuesType.tp_flags & Py_TPFLAGS_READY)
+                && PyType_Ready(&PyOCIO_TextureValuesType) < 0)
+            {
+                return NULL;
+            }
+            
+            PyOCIO_TextureValues * texture
+                = PyObject_New(PyOCIO_TextureValues, &PyOCIO_TextureValuesType);
+            if(!texture) return NULL;
+            
+            Py_INCREF(owner);
+            texture->owner  = owner;
+            texture->values = values;
+            texture->ndim   = ndim;
+            
+            Py_ssize_t stride = sizeof(float);
+            for(int dim=ndim-1; dim>=0; --dim)
+            {
+                texture->shape[dim]   = shape[dim];
+                texture->strides[dim] = stride;
+                stride *= shape[dim];
+            }
+            
+            PyObject * view = PyMemoryView_FromObject((PyObject *)texture);
+            Py_DECREF(texture);
+            return view;
+        }
+        
         int PyOCIO_GpuShaderDesc_init(PyOCIO_GpuShaderDesc* self, PyObject * /*args*/, PyObject * /*kwds*/)
         {
             OCIO_PYTRY_ENTER()
@@ -181,6 +331,110 @@ OCIO_NAMESPACE_ENTER
             OCIO_PYTRY_EXIT(NULL)
         }
         
+        PyObject * PyOCIO_GpuShaderDesc_getShaderText(PyObject * self)
+        {
+            OCIO_PYTRY_ENTER()
+            ConstGpuShaderDescRcPtr desc = GetConstGpuShaderDesc(self);
+            return PyString_FromString(desc->getShaderText());
+            OCIO_PYTRY_EXIT(NULL)
+        }
+        
+        PyObject * PyOCIO_GpuShaderDesc_getNumTextures(PyObject * self)
+        {
+            OCIO_PYTRY_ENTER()
+            ConstGpuShaderDescRcPtr desc = GetConstGpuShaderDesc(self);
+            return PyInt_FromLong(desc->getNumTextures());
+            OCIO_PYTRY_EXIT(NULL)
+        }
+        
+        PyObject * PyOCIO_GpuShaderDesc_getTexture(PyObject * self, PyObject * args)
+        {
+            OCIO_PYTRY_ENTER()
+            unsigned index = 0;
+            if (!PyArg_ParseTuple(args, "I:getTexture",
+                &index)) return NULL;
+            ConstGpuShaderDescRcPtr desc = GetConstGpuShaderDesc(self);
+            const char * name = 0;
+            const char * id = 0;
+            unsigned width = 0, height = 0;
+            GpuShaderDesc::TextureType channel = GpuShaderDesc::TEXTURE_RGB_CHANNEL;
+            Interpolation interpolation = INTERP_UNKNOWN;
+            desc->getTexture(index, name, id, width, height, channel, interpolation);
+            return Py_BuildValue("(ssIIIs)", name, id, width, height,
+                channel==GpuShaderDesc::TEXTURE_RED_CHANNEL ? 1u : 3u,
+                InterpolationToString(interpolation));
+            OCIO_PYTRY_EXIT(NULL)
+        }
+        
+        PyObject * PyOCIO_GpuShaderDesc_getTextureValues(PyObject * self, PyObject * args)
+        {
+            OCIO_PYTRY_ENTER()
+            unsigned index = 0;
+            if (!PyArg_ParseTuple(args, "I:getTextureValues",
+                &index)) return NULL;
+            ConstGpuShaderDescRcPtr desc = GetConstGpuShaderDesc(self);
+            const char * name = 0;
+            const char * id = 0;
+            unsigned width = 0, height = 0;
+            GpuShaderDesc::TextureType channel = GpuShaderDesc::TEXTURE_RGB_CHANNEL;
+            Interpolation interpolation = INTERP_UNKNOWN;
+            desc->getTexture(index, name, id, width, height, channel, interpolation);
+            const float * values = 0;
+            desc->getTextureValues(index, values);
+            const Py_ssize_t shape[3] = {
+                Py_ssize_t(height), Py_ssize_t(width),
+                channel==GpuShaderDesc::TEXTURE_RED_CHANNEL ? 1 : 3 };
+            return BuildTextureValuesView(self, values, 3, shape);
+            OCIO_PYTRY_EXIT(NULL)
+        }
+        
+        PyObject * PyOCIO_GpuShaderDesc_getNum3DTextures(PyObject * self)
+        {
+            OCIO_PYTRY_ENTER()
+            ConstGpuShaderDescRcPtr desc = GetConstGpuShaderDesc(self);
+            return PyInt_FromLong(desc->getNum3DTextures());
+            OCIO_PYTRY_EXIT(NULL)
+        }
+        
+        PyObject * PyOCIO_GpuShaderDesc_get3DTexture(PyObject * self, PyObject * args)
+        {
+            OCIO_PYTRY_ENTER()
+            unsigned index = 0;
+            if (!PyArg_ParseTuple(args, "I:get3DTexture",
+                &index)) return NULL;
+            ConstGpuShaderDescRcPtr desc = GetConstGpuShaderDesc(self);
+            const char * name = 0;
+            const char * id = 0;
+            unsigned edgelen = 0;
+            Interpolation interpolation = INTERP_UNKNOWN;
+            desc->get3DTexture(index, name, id, edgelen, interpolation);
+            return Py_BuildValue("(ssIs)", name, id, edgelen,
+                InterpolationToString(interpolation));
+            OCIO_PYTRY_EXIT(NULL)
+        }
+        
+        PyObject * PyOCIO_GpuShaderDesc_get3DTextureValues(PyObject * self, PyObject * args)
+        {
+            OCIO_PYTRY_ENTER()
+            unsigned index = 0;
+            if (!PyArg_ParseTuple(args, "I:get3DTextureValues",
+                &index)) return NULL;
+            ConstGpuShaderDescRcPtr desc = GetConstGpuShaderDesc(self);
+            const char * name = 0;
+            const char * id = 0;
+            unsigned edgelen = 0;
+            Interpolation interpolation = INTERP_UNKNOWN;
+            desc->get3DTexture(index, name, id, edgelen, interpolation);
+            const float * values = 0;
+            desc->get3DTextureValues(index, values);
+            // The 3D LUT values are ordered with the blue coordinate changing the fastest
+            // i.e. indexed by [red, green, blue, channel].
+            const Py_ssize_t len = Py_ssize_t(edgelen);
+            const Py_ssize_t shape[4] = { len, len, len, 3 };
+            return BuildTextureValuesView(self, values, 4, shape);
+            OCIO_PYTRY_EXIT(NULL)
+        }
+        
     } // anon namespace
     
 }
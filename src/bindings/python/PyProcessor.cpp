@@ -41,6 +41,8 @@ OCIO_NAMESPACE_ENTER
         PyObject * PyOCIO_Processor_getProcessorMetadata(PyObject * self, PyObject *);
         PyObject * PyOCIO_Processor_applyRGB(PyObject * self, PyObject * args);
         PyObject * PyOCIO_Processor_applyRGBA(PyObject * self, PyObject * args);
+        PyObject * PyOCIO_Processor_apply(PyObject * self, PyObject * args, PyObject * kwds);
+        PyObject * PyOCIO_Processor_extractGpuShaderInfo(PyObject * self, PyObject * args);
         
         ///////////////////////////////////////////////////////////////////////
         ///
@@ -56,6 +58,10 @@ OCIO_NAMESPACE_ENTER
             PyOCIO_Processor_applyRGB, METH_VARARGS, PROCESSOR_APPLYRGB__DOC__ },
             { "applyRGBA",
             PyOCIO_Processor_applyRGBA, METH_VARARGS, PROCESSOR_APPLYRGBA__DOC__ },
+            { "apply",
+            (PyCFunction) PyOCIO_Processor_apply, METH_VARARGS|METH_KEYWORDS, PROCESSOR_APPLY__DOC__ },
+            { "extractGpuShaderInfo",
+            PyOCIO_Processor_extractGpuShaderInfo, METH_VARARGS, PROCESSOR_EXTRACTGPUSHADERINFO__DOC__ },
             { NULL, NULL, 0, NULL }
         };
         
@@ -120,6 +126,87 @@ OCIO_NAMESPACE_ENTER
         ///////////////////////////////////////////////////////////////////////
         ///
         
+        // The number of pixels per line when processing packed pixels i.e. the
+        // parallel processing splits the pixels in lines.
+        const long APPLY_LINE_WIDTH = 1024;
+        
+        // Apply the CPU processor to packed pixels in place. The GIL is released
+        // during the processing so other Python threads keep running.
+        void ApplyPacked(ConstCPUProcessorRcPtr cpu, char * data, long numPixels,
+                         long numChannels, BitDepth bitDepth, size_t channelSize)
+        {
+            const long numLines = numPixels / APPLY_LINE_WIDTH;
+            const long remainder = numPixels % APPLY_LINE_WIDTH;
+            
+            CallWithoutGIL([&]()
+            {
+                if(numLines>0)
+                {
+                    PackedImageDesc img(data, APPLY_LINE_WIDTH, numLines, numChannels,
+                                        bitDepth, AutoStride, AutoStride, AutoStride);
+                    cpu->apply(img, CPUExecutor());
+                }
+                if(remainder>0)
+                {
+                    char * last = data + numLines * APPLY_LINE_WIDTH * numChannels * channelSize;
+                    PackedImageDesc img(last, remainder, 1, numChannels,
+                                        bitDepth, AutoStride, AutoStride, AutoStride);
+                    cpu->apply(img);
+                }
+                return true;
+            });
+        }
+        
+        // The CPU processor finalization could be long (e.g. an inverse LUT).
+        ConstCPUProcessorRcPtr GetDefaultCPUProcessor(const ConstProcessorRcPtr & processor)
+        {
+            return CallWithoutGIL([&processor]()
+                {
+                    return processor->getDefaultCPUProcessor();
+                });
+        }
+        
+        // Get the bit-depth of a buffer from its struct module format
+        // (e.g. 'f' for numpy.float32).
+        BitDepth GetBufferBitDepth(const char * format)
+        {
+            // A null format means unsigned bytes.
+            if(!format) return BIT_DEPTH_UINT8;
+            
+            // Skip the byte order character when it means the native byte order.
+            const unsigned short one = 1;
+            const char nativeOrder = (*(const char *)&one == 1) ? '<' : '>';
+            if(*format=='@' || *format=='=' || *format==nativeOrder) ++format;
+            
+            if(!*format || *(format+1)) return BIT_DEPTH_UNKNOWN;
+            
+            switch(*format)
+            {
+                case 'B': return BIT_DEPTH_UINT8;
+                case 'H': return BIT_DEPTH_UINT16;
+                case 'e': return BIT_DEPTH_F16;
+                case 'f': return BIT_DEPTH_F32;
+                default:  return BIT_DEPTH_UNKNOWN;
+            }
+        }
+        
+        // Release the buffer view on any exit path.
+        class PyBufferGuard
+        {
+        public:
+            explicit PyBufferGuard(Py_buffer & view) : m_view(view) {}
+            ~PyBufferGuard() { PyBuffer_Release(&m_view); }
+            
+        private:
+            PyBufferGuard(const PyBufferGuard &);
+            PyBufferGuard & operator=(const PyBufferGuard &);
+            
+            Py_buffer & m_view;
+        };
+        
+        ///////////////////////////////////////////////////////////////////////
+        ///
+        
         int PyOCIO_Processor_init(PyOCIO_Processor * /*self*/, PyObject * /*args*/, PyObject * /*kwds*/)
         {
             PyErr_SetString( PyExc_RuntimeError, initMessage);
@@ -177,8 +264,8 @@ OCIO_NAMESPACE_ENTER
                 PyErr_SetString(PyExc_TypeError, os.str().c_str());
                 return 0;
             }
-            PackedImageDesc img(&data[0], long(data.size()/3), 1, 3);
-            processor->getDefaultCPUProcessor()->apply(img);
+            ApplyPacked(GetDefaultCPUProcessor(processor), (char *)&data[0],
+                        long(data.size()/3), 3, BIT_DEPTH_F32, sizeof(float));
             return CreatePyListFromFloatVector(data);
             OCIO_PYTRY_EXIT(NULL)
         }
@@ -205,12 +292,115 @@ OCIO_NAMESPACE_ENTER
                 PyErr_SetString(PyExc_TypeError, os.str().c_str());
                 return 0;
             }
-            PackedImageDesc img(&data[0], long(data.size()/4), 1, 4);
-            processor->getDefaultCPUProcessor()->apply(img);
+            ApplyPacked(GetDefaultCPUProcessor(processor), (char *)&data[0],
+                        long(data.size()/4), 4, BIT_DEPTH_F32, sizeof(float));
             return CreatePyListFromFloatVector(data);
             OCIO_PYTRY_EXIT(NULL)
         }
         
+        PyObject * PyOCIO_Processor_apply(PyObject * self, PyObject * args, PyObject * kwds)
+        {
+            OCIO_PYTRY_ENTER()
+            PyObject * pyData = 0;
+            int numChannels = 0;
+            const char * bitDepthName = 0;
+            const char * kwlist[] = { "pixeldata", "numChannels", "bitDepth", NULL };
+            if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|iz:apply",
+                const_cast<char **>(kwlist),
+                &pyData, &numChannels, &bitDepthName)) return NULL;
+            
+            // The pixels are processed in place so the buffer must be writable and
+            // contiguous (e.g. a numpy array).
+            Py_buffer view;
+            if(PyObject_GetBuffer(pyData, &view,
+                                  PyBUF_C_CONTIGUOUS | PyBUF_FORMAT | PyBUF_WRITABLE) != 0)
+            {
+                return NULL;
+            }
+            PyBufferGuard guard(view);
+            
+            BitDepth bitDepth = GetBufferBitDepth(view.format);
+            if(bitDepth==BIT_DEPTH_UNKNOWN)
+            {
+                std::ostringstream os;
+                os << "Unsupported buffer format '" << (view.format ? view.format : "") << "'. ";
+                os << "Expecting uint8, uint16, float16 or float32 values.";
+                PyErr_SetString(PyExc_TypeError, os.str().c_str());
+                return NULL;
+            }
+            
+            // The 10 and 12 bits integer values are stored in 16 bits integers.
+            if(bitDepthName && *bitDepthName)
+            {
+                const BitDepth requested = BitDepthFromString(bitDepthName);
+                const bool isUInt16Storage = requested==BIT_DEPTH_UINT10
+                                             || requested==BIT_DEPTH_UINT12
+                                             || requested==BIT_DEPTH_UINT16;
+                if(requested!=bitDepth && !(isUInt16Storage && bitDepth==BIT_DEPTH_UINT16))
+                {
+                    std::ostringstream os;
+                    os << "The bit-depth '" << bitDepthName << "' does not match the buffer ";
+                    os << "format '" << view.format << "'.";
+                    PyErr_SetString(PyExc_TypeError, os.str().c_str());
+                    return NULL;
+                }
+                bitDepth = requested;
+            }
+            
+            // By default, the last dimension holds the channels.
+            if(numChannels==0 && view.ndim>1)
+            {
+                numChannels = int(view.shape[view.ndim-1]);
+            }
+            
+            const Py_ssize_t numValues = view.itemsize>0 ? view.len / view.itemsize : 0;
+            if((numChannels!=3 && numChannels!=4) || (numValues % numChannels)!=0)
+            {
+                std::ostringstream os;
+                os << "The pixel data must hold RGB or RGBA pixels, ";
+                os << "use numChannels for a flat buffer. ";
+                os << "Channels: " << numChannels << ", size: " << numValues << ".";
+                PyErr_SetString(PyExc_TypeError, os.str().c_str());
+                return NULL;
+            }
+            
+            ConstProcessorRcPtr processor = GetConstProcessor(self);
+            if(!processor->isNoOp() && numValues>0)
+            {
+                // The CPU processors are cached by the processor (per bit-depth).
+                ConstCPUProcessorRcPtr cpu = CallWithoutGIL([&]()
+                    {
+                        return processor->getOptimizedCPUProcessor(bitDepth, bitDepth,
+                                                                   OPTIMIZATION_DEFAULT,
+                                                                   FINALIZATION_DEFAULT);
+                    });
+                
+                ApplyPacked(cpu, (char *)view.buf, long(numValues / numChannels),
+                            numChannels, bitDepth, size_t(view.itemsize));
+            }
+            
+            Py_INCREF(pyData);
+            return pyData;
+            OCIO_PYTRY_EXIT(NULL)
+        }
+        
+        PyObject * PyOCIO_Processor_extractGpuShaderInfo(PyObject * self, PyObject * args)
+        {
+            OCIO_PYTRY_ENTER()
+            PyObject * pyShaderDesc = 0;
+            if (!PyArg_ParseTuple(args, "O!:extractGpuShaderInfo",
+                &PyOCIO_GpuShaderDescType, &pyShaderDesc)) return NULL;
+            ConstProcessorRcPtr processor = GetConstProcessor(self);
+            GpuShaderDescRcPtr shaderDesc = GetEditableGpuShaderDesc(pyShaderDesc);
+            CallWithoutGIL([&]()
+                {
+                    processor->getDefaultGPUProcessor()->extractGpuShaderInfo(shaderDesc);
+                    return true;
+                });
+            Py_RETURN_NONE;
+            OCIO_PYTRY_EXIT(NULL)
+        }
+        
     }
     
 }
@@ -6,6 +6,7 @@
 
 #include <PyOpenColorIO/PyOpenColorIO.h>
 
+#include <exception>
 #include <vector>
 #include <map>
 #include <iostream>
@@ -126,6 +127,7 @@ OCIO_NAMESPACE_ENTER
     ///////////////////////////////////////////////////////////////////////////
     
     ConstGpuShaderDescRcPtr GetConstGpuShaderDesc(PyObject * pyobject);
+    GpuShaderDescRcPtr GetEditableGpuShaderDesc(PyObject * pyobject);
     
     ///////////////////////////////////////////////////////////////////////////
     
@@ -303,6 +305,35 @@ OCIO_NAMESPACE_ENTER
     
     void Python_Handle_Exception();
     
+    //! Call the function with the GIL released so other Python threads keep running
+    //! during a potentially long native call (e.g. a config loading or a processor
+    //! building). The function must not use any Python object. Its exception, if any,
+    //! is rethrown once the GIL is acquired again.
+    template<typename Func>
+    auto CallWithoutGIL(Func func) -> decltype(func())
+    {
+        decltype(func()) result;
+        std::exception_ptr error;
+        
+        Py_BEGIN_ALLOW_THREADS
+        try
+        {
+            result = func();
+        }
+        catch(...)
+        {
+            error = std::current_exception();
+        }
+        Py_END_ALLOW_THREADS
+        
+        if(error)
+        {
+            std::rethrow_exception(error);
+        }
+        
+        return result;
+    }
+    
 }
 OCIO_NAMESPACE_EXIT
 
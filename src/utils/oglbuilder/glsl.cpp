@@ -78,10 +78,77 @@ namespace
         glTexParameteri(textureType, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
     }
 
+    // The texture values to upload, in the format requested by the shader description.
+    struct TextureValues
+    {
+        const void * m_values = nullptr;
+        GLint  m_internalFormat = GL_RGB32F_ARB;
+        GLenum m_type = GL_FLOAT;
+
+        void setValues16(GpuShaderDesc::TextureFormat format, const unsigned short * values)
+        {
+            m_values = values;
+            if(format==GpuShaderDesc::TEXTURE_FORMAT_UNORM16)
+            {
+                m_internalFormat = GL_RGB16;
+                m_type = GL_UNSIGNED_SHORT;
+            }
+            else
+            {
+                m_internalFormat = GL_RGB16F_ARB;
+                m_type = GL_HALF_FLOAT_ARB;
+            }
+        }
+
+        size_t getChannelSize() const { return m_type==GL_FLOAT ? 4 : 2; }
+    };
+
+    // When requested, the texture values are staged in a pixel buffer object: the glTexImage
+    // call then sources the bound buffer and returns without waiting for the transfer.
+    class PixelUnpackBuffer
+    {
+    public:
+        PixelUnpackBuffer(bool enabled, size_t size, const void * values)
+            :   m_pbo(0)
+            ,   m_values(values)
+        {
+            if(enabled)
+            {
+                glGenBuffers(1, &m_pbo);
+                glBindBuffer(GL_PIXEL_UNPACK_BUFFER, m_pbo);
+                glBufferData(GL_PIXEL_UNPACK_BUFFER, size, values, GL_STREAM_DRAW);
+                // The values are now read from the offset 0 of the bound buffer.
+                m_values = nullptr;
+            }
+        }
+
+        ~PixelUnpackBuffer()
+        {
+            if(m_pbo)
+            {
+                // The driver keeps the buffer content alive until the transfer completes.
+                glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+                glDeleteBuffers(1, &m_pbo);
+            }
+        }
+
+        const void * getValues() const { return m_values; }
+
+    private:
+        PixelUnpackBuffer() = delete;
+        PixelUnpackBuffer(const PixelUnpackBuffer &) = delete;
+        PixelUnpackBuffer & operator=(const PixelUnpackBuffer &) = delete;
+
+        GLuint m_pbo;
+        const void * m_values;
+    };
+
     void AllocateTexture3D(unsigned index, unsigned & texId, 
                            Interpolation interpolation,
-                           unsigned edgelen, const float * values)
+                           unsigned edgelen, const TextureValues & texValues,
+                           bool usePixelBuffer)
     {
+        const void * values = texValues.m_values;
         if(values==0x0)
         {
             throw Exception("Missing texture data");
@@ -95,13 +162,19 @@ namespace
 
         SetTextureParameters(GL_TEXTURE_3D, interpolation);
 
-        glTexImage3D(GL_TEXTURE_3D, 0, GL_RGB32F_ARB,
-                     edgelen, edgelen, edgelen, 0, GL_RGB, GL_FLOAT, values);
+        const PixelUnpackBuffer buffer(usePixelBuffer,
+                                       edgelen * edgelen * edgelen * 3 * texValues.getChannelSize(),
+                                       values);
+
+        glTexImage3D(GL_TEXTURE_3D, 0, texValues.m_internalFormat,
+                     edgelen, edgelen, edgelen, 0, GL_RGB, texValues.m_type, buffer.getValues());
     }
 
     void AllocateTexture2D(unsigned index, unsigned & texId, unsigned width, unsigned height,
-                           Interpolation interpolation, const float * values)
+                           Interpolation interpolation, const TextureValues & texValues,
+                           bool usePixelBuffer)
     {
+        const void * values = texValues.m_values;
         if(values==0x0)
         {
             throw Exception("Missing texture data");
@@ -111,13 +184,18 @@ namespace
 
         glActiveTexture(GL_TEXTURE0 + index);
 
+        const PixelUnpackBuffer buffer(usePixelBuffer,
+                                       width * height * 3 * texValues.getChannelSize(),
+                                       values);
+
         if(height>1)
         {
             glBindTexture(GL_TEXTURE_2D, texId);
 
             SetTextureParameters(GL_TEXTURE_2D, interpolation);
 
-            glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB32F_ARB, width, height, 0, GL_RGB, GL_FLOAT, values);
+            glTexImage2D(GL_TEXTURE_2D, 0, texValues.m_internalFormat, width, height, 0,
+                         GL_RGB, texValues.m_type, buffer.getValues());
         }
         else
         {
@@ -125,7 +203,8 @@ namespace
 
             SetTextureParameters(GL_TEXTURE_1D, interpolation);
 
-            glTexImage1D(GL_TEXTURE_1D, 0, GL_RGB32F_ARB, width, 0, GL_RGB, GL_FLOAT, values);
+            glTexImage1D(GL_TEXTURE_1D, 0, texValues.m_internalFormat, width, 0,
+                         GL_RGB, texValues.m_type, buffer.getValues());
         }
     }
 
@@ -236,6 +315,7 @@ OpenGLBuilder::OpenGLBuilder(const GpuShaderDescRcPtr & shaderDesc)
     ,   m_fragShader(0)
     ,   m_program(glCreateProgram())
     ,   m_verbose(false)
+    ,   m_usePixelBuffers(false)
 {
 }
 
@@ -283,9 +363,21 @@ void OpenGLBuilder::allocateAllTextures(unsigned startIndex)
             throw Exception("The texture data is corrupted");
         }
 
-        const float* values = 0x0;
-        m_shaderDesc->get3DTextureValues(idx, values);
-        if(!values)
+        TextureValues values;
+        if(m_shaderDesc->getTextureFormat()==GpuShaderDesc::TEXTURE_FORMAT_F32)
+        {
+            const float * values32 = 0x0;
+            m_shaderDesc->get3DTextureValues(idx, values32);
+            values.m_values = values32;
+        }
+        else
+        {
+            GpuShaderDesc::TextureFormat format = GpuShaderDesc::TEXTURE_FORMAT_F16;
+            const unsigned short * values16 = 0x0;
+            m_shaderDesc->get3DTextureValues16(idx, format, values16);
+            values.setValues16(format, values16);
+        }
+        if(!values.m_values)
         {
             throw Exception("The texture values are missing");
         }
@@ -293,7 +385,7 @@ void OpenGLBuilder::allocateAllTextures(unsigned startIndex)
         // 2. Allocate the 3D LUT.
 
         unsigned texId = 0;
-        AllocateTexture3D(currIndex, texId, interpolation, edgelen, values);
+        AllocateTexture3D(currIndex, texId, interpolation, edgelen, values, m_usePixelBuffers);
 
         // 3. Keep the texture id & name for the later enabling.
 
@@ -322,9 +414,21 @@ void OpenGLBuilder::allocateAllTextures(unsigned startIndex)
             throw Exception("The texture data is corrupted");
         }
 
-        const float * values = 0x0;
-        m_shaderDesc->getTextureValues(idx, values);
-        if(!values)
+        TextureValues values;
+        if(m_shaderDesc->getTextureFormat()==GpuShaderDesc::TEXTURE_FORMAT_F32)
+        {
+            const float * values32 = 0x0;
+            m_shaderDesc->getTextureValues(idx, values32);
+            values.m_values = values32;
+        }
+        else
+        {
+            GpuShaderDesc::TextureFormat format = GpuShaderDesc::TEXTURE_FORMAT_F16;
+            const unsigned short * values16 = 0x0;
+            m_shaderDesc->getTextureValues16(idx, format, values16);
+            values.setValues16(format, values16);
+        }
+        if(!values.m_values)
         {
             throw Exception("The texture values are missing");
         }
@@ -332,7 +436,8 @@ void OpenGLBuilder::allocateAllTextures(unsigned startIndex)
         // 2. Allocate the 1D LUT (a 2D texture is needed to hold large LUTs).
 
         unsigned texId = 0;
-        AllocateTexture2D(currIndex, texId, width, height, interpolation, values);
+        AllocateTexture2D(currIndex, texId, width, height, interpolation, values,
+                          m_usePixelBuffers);
 
         // 3. Keep the texture id & name for the later enabling.
 
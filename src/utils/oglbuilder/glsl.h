@@ -72,6 +72,11 @@ public:
     inline void setVerbose(bool verbose) { m_verbose = verbose; }
     inline bool isVerbose() const { return m_verbose; }
 
+    // Upload the textures through pixel buffer objects (requires OpenGL 2.1) so the
+    // transfers to the graphic card do not stall the calling thread.
+    inline void setUsePixelBuffers(bool use) { m_usePixelBuffers = use; }
+    inline bool getUsePixelBuffers() const { return m_usePixelBuffers; }
+
     // Allocate & upload all the needed textures
     //  (i.e. the index is the first available index for any kind of textures).
     void allocateAllTextures(unsigned startIndex);
@@ -112,6 +117,7 @@ private:
     unsigned m_program;                    // Program identifier
     std::string m_shaderCacheID;           // Current shader program key
     bool m_verbose;                        // Print shader code to std::cout for debugging purposes
+    bool m_usePixelBuffers;                // Upload the textures through pixel buffer objects
 };
 
 }
@@ -0,0 +1,443 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the OpenColorIO Project.
+
+
+// The benchmark of the control-plane latency i.e. the loading & saving of the configs, the
+// color space look-ups, and the creation of the processors and the GPU shaders, as the
+// interactive hosts see it. Each step is timed cold (i.e. after ClearAllCaches() on a
+// freshly loaded config) and warm (i.e. the same step again).
+//
+//   bench_config [--colorspaces <n>] [--looks <n>] [--displays <n>] [--views <n>]
+//                [config.ocio ...]
+//
+// It measures a synthetic config (using the LUT files of the unit tests) of the requested
+// size, and the config files given on the command line.
+
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <OpenColorIO/OpenColorIO.h>
+
+
+namespace OCIO = OCIO_NAMESPACE;
+
+
+#ifndef OCIO_UNIT_TEST_FILES_DIR
+#error Expecting OCIO_UNIT_TEST_FILES_DIR to be defined. Check relevant CMakeLists.txt
+#endif
+
+// For explanation, refer to https://gcc.gnu.org/onlinedocs/cpp/Stringizing.html
+#define _STR(x) #x
+#define STR(x) _STR(x)
+
+
+namespace
+{
+
+struct SyntheticConfigSizes
+{
+    int m_numColorSpaces = 1000;
+    int m_numLooks       = 100;
+    int m_numDisplays    = 10;
+    int m_numViews       = 10;
+};
+
+// Create a config with input color spaces (i.e. converting to the reference space),
+// display color spaces (i.e. converting from the reference space), looks and views,
+// mixing the analytical transforms and the LUT files.
+OCIO::ConfigRcPtr CreateSyntheticConfig(const SyntheticConfigSizes & sizes)
+{
+    OCIO::ConfigRcPtr config = OCIO::Config::Create();
+    config->setSearchPath(STR(OCIO_UNIT_TEST_FILES_DIR));
+
+    OCIO::ColorSpaceRcPtr reference = OCIO::ColorSpace::Create();
+    reference->setName("reference");
+    reference->setFamily("reference");
+    config->addColorSpace(reference);
+
+    config->setRole(OCIO::ROLE_DEFAULT, "reference");
+    config->setRole(OCIO::ROLE_SCENE_LINEAR, "reference");
+    config->setRole(OCIO::ROLE_REFERENCE, "reference");
+
+    const int numDisplaySpaces = sizes.m_numDisplays * sizes.m_numViews;
+    const int numInputSpaces   = std::max(1, sizes.m_numColorSpaces - numDisplaySpaces);
+
+    for(int idx = 0; idx < numInputSpaces; ++idx)
+    {
+        const double scale = 1.0 + 0.001 * idx;
+        const double m44[16] = { scale, 0.05,  0.0,   0.0,
+                                 0.02,  scale, 0.03,  0.0,
+                                 0.0,   0.01,  scale, 0.0,
+                                 0.0,   0.0,   0.0,   1.0 };
+
+        OCIO::MatrixTransformRcPtr matrix = OCIO::MatrixTransform::Create();
+        matrix->setMatrix(m44);
+
+        OCIO::GroupTransformRcPtr group = OCIO::GroupTransform::Create();
+        switch(idx % 4)
+        {
+            case 0:
+            {
+                OCIO::LogTransformRcPtr log = OCIO::LogTransform::Create();
+                log->setBase(2.0);
+                log->setDirection(OCIO::TRANSFORM_DIR_INVERSE);
+                group->appendTransform(log);
+                break;
+            }
+            case 1:
+            {
+                OCIO::FileTransformRcPtr file = OCIO::FileTransform::Create();
+                file->setSrc("lut1d_5.spi1d");
+                file->setInterpolation(OCIO::INTERP_LINEAR);
+                group->appendTransform(file);
+                break;
+            }
+            case 2:
+            {
+                OCIO::FileTransformRcPtr file = OCIO::FileTransform::Create();
+                file->setSrc("lut3d_1.spi3d");
+                file->setInterpolation(OCIO::INTERP_LINEAR);
+                group->appendTransform(file);
+                break;
+            }
+            default:
+                break;
+        }
+        group->appendTransform(matrix);
+
+        OCIO::ColorSpaceRcPtr cs = OCIO::ColorSpace::Create();
+        cs->setName(("input_" + std::to_string(idx)).c_str());
+        cs->setFamily(("input/family_" + std::to_string(idx % 20)).c_str());
+        cs->setTransform(group, OCIO::COLORSPACE_DIR_TO_REFERENCE);
+        config->addColorSpace(cs);
+    }
+
+    for(int idx = 0; idx < sizes.m_numLooks; ++idx)
+    {
+        const double slope[3]  = { 1.0 + 0.001 * idx, 1.0, 1.0 - 0.001 * idx };
+        const double offset[3] = { 0.01, 0.0, -0.01 };
+
+        OCIO::CDLTransformRcPtr cdl = OCIO::CDLTransform::Create();
+        cdl->setSlope(slope);
+        cdl->setOffset(offset);
+        cdl->setSat(0.9);
+
+        OCIO::LookRcPtr look = OCIO::Look::Create();
+        look->setName(("look_" + std::to_string(idx)).c_str());
+        look->setProcessSpace(("input_" + std::to_string(idx % numInputSpaces)).c_str());
+        look->setTransform(cdl);
+        config->addLook(look);
+    }
+
+    for(int displayIdx = 0; displayIdx < sizes.m_numDisplays; ++displayIdx)
+    {
+        const std::string display("display_" + std::to_string(displayIdx));
+
+        for(int viewIdx = 0; viewIdx < sizes.m_numViews; ++viewIdx)
+        {
+            const int idx = displayIdx * sizes.m_numViews + viewIdx;
+
+            OCIO::GroupTransformRcPtr group = OCIO::GroupTransform::Create();
+
+            const double gain = 0.9 - 0.001 * idx;
+            const double m44[16] = { gain, 0.0,  0.0,  0.0,
+                                     0.0,  gain, 0.0,  0.0,
+                                     0.0,  0.0,  gain, 0.0,
+                                     0.0,  0.0,  0.0,  1.0 };
+
+            OCIO::MatrixTransformRcPtr matrix = OCIO::MatrixTransform::Create();
+            matrix->setMatrix(m44);
+            group->appendTransform(matrix);
+
+            OCIO::LogTransformRcPtr log = OCIO::LogTransform::Create();
+            log->setBase(10.0);
+            group->appendTransform(log);
+
+            if(idx % 2 == 0)
+            {
+                OCIO::FileTransformRcPtr file = OCIO::FileTransform::Create();
+                file->setSrc("comp2.spi3d");
+                file->setInterpolation(OCIO::INTERP_TETRAHEDRAL);
+                group->appendTransform(file);
+            }
+
+            const std::string csName("display_space_" + std::to_string(idx));
+
+            OCIO::ColorSpaceRcPtr cs = OCIO::ColorSpace::Create();
+            cs->setName(csName.c_str());
+            cs->setFamily("display");
+            cs->setTransform(group, OCIO::COLORSPACE_DIR_FROM_REFERENCE);
+            config->addColorSpace(cs);
+
+            // One view out of three applies a look.
+            std::string looks;
+            if(sizes.m_numLooks > 0 && viewIdx % 3 == 0)
+            {
+                looks = "look_" + std::to_string(idx % sizes.m_numLooks);
+            }
+
+            config->addDisplay(display.c_str(), ("view_" + std::to_string(viewIdx)).c_str(),
+                               csName.c_str(), looks.c_str());
+        }
+    }
+
+    return config;
+}
+
+double GetElapsedMs(const std::chrono::steady_clock::time_point & start)
+{
+    const std::chrono::duration<double, std::milli> elapsed
+        = std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+
+double TimeMs(const std::function<void()> & step)
+{
+    const auto start = std::chrono::steady_clock::now();
+    step();
+    return GetElapsedMs(start);
+}
+
+// Print the cold & warm times of a step done 'count' times.
+void PrintStep(const std::string & name, size_t count, double coldMs, double warmMs)
+{
+    std::cout << std::left << std::setw(44) << name
+              << std::right << std::setw(8) << count
+              << std::fixed << std::setprecision(3)
+              << std::setw(14) << coldMs
+              << std::setw(14) << warmMs
+              << std::setw(14) << (count ? coldMs / count : 0.0)
+              << std::setw(14) << (count ? warmMs / count : 0.0)
+              << std::endl;
+}
+
+const struct
+{
+    const char *            m_name;
+    OCIO::OptimizationFlags m_flags;
+} OptimizationLevels[] = {
+    { "none",      OCIO::OPTIMIZATION_NONE      },
+    { "lossless",  OCIO::OPTIMIZATION_LOSSLESS  },
+    { "very good", OCIO::OPTIMIZATION_VERY_GOOD },
+    { "good",      OCIO::OPTIMIZATION_GOOD      },
+    { "draft",     OCIO::OPTIMIZATION_DRAFT     },
+};
+
+void BenchmarkConfig(const std::string & filename)
+{
+    std::cout << std::endl << "Config: " << filename << std::endl << std::endl;
+
+    std::cout << std::left << std::setw(44) << "Step"
+              << std::right << std::setw(8) << "Count"
+              << std::setw(14) << "Cold (ms)" << std::setw(14) << "Warm (ms)"
+              << std::setw(14) << "Cold/call" << std::setw(14) << "Warm/call"
+              << std::endl;
+
+    OCIO::ClearAllCaches();
+
+    // The loading.
+
+    OCIO::ConstConfigRcPtr config;
+    const double coldLoad = TimeMs([&]() { config = OCIO::Config::CreateFromFile(filename.c_str()); });
+    const double warmLoad = TimeMs([&]() { OCIO::Config::CreateFromFile(filename.c_str()); });
+    PrintStep("Config::CreateFromFile", 1, coldLoad, warmLoad);
+
+    // The saving.
+
+    const auto serialize = [&]()
+    {
+        std::ostringstream os;
+        config->serialize(os);
+    };
+    const double coldSave = TimeMs(serialize);
+    const double warmSave = TimeMs(serialize);
+    PrintStep("Config::serialize", 1, coldSave, warmSave);
+
+    // The color space look-ups (i.e. by name, and by index).
+
+    const int numColorSpaces = config->getNumColorSpaces();
+    std::vector<std::string> names;
+    for(int idx = 0; idx < numColorSpaces; ++idx)
+    {
+        names.push_back(config->getColorSpaceNameByIndex(idx));
+    }
+
+    const auto lookup = [&]()
+    {
+        for(const auto & name : names)
+        {
+            config->getColorSpace(name.c_str());
+            config->getIndexForColorSpace(name.c_str());
+        }
+    };
+    const double coldLookup = TimeMs(lookup);
+    const double warmLookup = TimeMs(lookup);
+    PrintStep("Config::getColorSpace", names.size(), coldLookup, warmLookup);
+
+    // The processors of all the (display, view) pairs, from the scene linear role.
+
+    std::vector<OCIO::ConstTransformRcPtr> displayViews;
+    for(int displayIdx = 0; displayIdx < config->getNumDisplays(); ++displayIdx)
+    {
+        const char * display = config->getDisplay(displayIdx);
+        for(int viewIdx = 0; viewIdx < config->getNumViews(display); ++viewIdx)
+        {
+            OCIO::DisplayTransformRcPtr transform = OCIO::DisplayTransform::Create();
+            transform->setInputColorSpaceName(OCIO::ROLE_SCENE_LINEAR);
+            transform->setDisplay(display);
+            transform->setView(config->getView(display, viewIdx));
+            displayViews.push_back(transform);
+        }
+    }
+
+    std::vector<OCIO::ConstProcessorRcPtr> processors;
+    const auto getProcessors = [&]()
+    {
+        processors.clear();
+        for(const auto & transform : displayViews)
+        {
+            try
+            {
+                processors.push_back(config->getProcessor(transform));
+            }
+            catch(const OCIO::Exception & e)
+            {
+                std::cerr << "Warning: " << e.what() << std::endl;
+            }
+        }
+    };
+    const double coldProcessors = TimeMs(getProcessors);
+    const double warmProcessors = TimeMs(getProcessors);
+    PrintStep("Config::getProcessor (display, view)", displayViews.size(),
+              coldProcessors, warmProcessors);
+
+    // The CPU processors at each optimization level.
+
+    for(const auto & level : OptimizationLevels)
+    {
+        const auto getCPUProcessors = [&]()
+        {
+            for(const auto & processor : processors)
+            {
+                processor->getOptimizedCPUProcessor(level.m_flags, OCIO::FINALIZATION_DEFAULT);
+            }
+        };
+        const double coldCPU = TimeMs(getCPUProcessors);
+        const double warmCPU = TimeMs(getCPUProcessors);
+        PrintStep(std::string("Processor::getOptimizedCPUProcessor (") + level.m_name + ")",
+                  processors.size(), coldCPU, warmCPU);
+    }
+
+    // The GPU shaders.
+
+    const auto extractShaders = [&]()
+    {
+        for(const auto & processor : processors)
+        {
+            OCIO::GpuShaderDescRcPtr shaderDesc = OCIO::GpuShaderDesc::CreateShaderDesc();
+            shaderDesc->setLanguage(OCIO::GPU_LANGUAGE_GLSL_1_3);
+            processor->getDefaultGPUProcessor()->extractGpuShaderInfo(shaderDesc);
+        }
+    };
+    const double coldGPU = TimeMs(extractShaders);
+    const double warmGPU = TimeMs(extractShaders);
+    PrintStep("GPUProcessor::extractGpuShaderInfo", processors.size(), coldGPU, warmGPU);
+}
+
+void PrintUsage()
+{
+    std::cerr << "Usage: bench_config [--colorspaces <n>] [--looks <n>] [--displays <n>] "
+                 "[--views <n>] [config.ocio ...]\n";
+}
+
+}
+
+
+int main(int argc, const char ** argv)
+{
+    SyntheticConfigSizes sizes;
+    std::vector<std::string> filenames;
+
+    for(int idx = 1; idx < argc; ++idx)
+    {
+        const std::string arg(argv[idx]);
+        const bool hasValue = idx + 1 < argc;
+
+        if(arg == "--colorspaces" && hasValue)
+        {
+            sizes.m_numColorSpaces = std::atoi(argv[++idx]);
+        }
+        else if(arg == "--looks" && hasValue)
+        {
+            sizes.m_numLooks = std::atoi(argv[++idx]);
+        }
+        else if(arg == "--displays" && hasValue)
+        {
+            sizes.m_numDisplays = std::atoi(argv[++idx]);
+        }
+        else if(arg == "--views" && hasValue)
+        {
+            sizes.m_numViews = std::atoi(argv[++idx]);
+        }
+        else if(!arg.empty() && arg[0] != '-')
+        {
+            filenames.push_back(arg);
+        }
+        else
+        {
+            PrintUsage();
+            return 1;
+        }
+    }
+
+    // Silence the warnings of the configs (e.g. the unused files).
+    OCIO::SetLoggingLevel(OCIO::LOGGING_LEVEL_NONE);
+
+    const std::string syntheticFilename("bench_config_synthetic.ocio");
+
+    try
+    {
+        // The synthetic config is saved so its loading is measured as for any config file.
+        {
+            OCIO::ConstConfigRcPtr config = CreateSyntheticConfig(sizes);
+
+            std::ofstream file(syntheticFilename.c_str());
+            config->serialize(file);
+            if(!file)
+            {
+                throw OCIO::Exception("Could not write the synthetic config file.");
+            }
+        }
+
+        std::cout << "Synthetic config: " << sizes.m_numColorSpaces << " color spaces, "
+                  << sizes.m_numLooks << " looks, " << sizes.m_numDisplays << " displays of "
+                  << sizes.m_numViews << " views." << std::endl;
+
+        BenchmarkConfig(syntheticFilename);
+
+        for(const auto & filename : filenames)
+        {
+            BenchmarkConfig(filename);
+        }
+    }
+    catch(const std::exception & e)
+    {
+        std::cerr << "Error: " << e.what() << std::endl;
+        std::remove(syntheticFilename.c_str());
+        return 1;
+    }
+
+    std::remove(syntheticFilename.c_str());
+
+    return 0;
+}
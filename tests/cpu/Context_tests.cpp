@@ -2,6 +2,8 @@
 // Copyright Contributors to the OpenColorIO Project.
 
 #include <algorithm>
+#include <thread>
+#include <vector>
 
 #include "Context.cpp"
 
@@ -145,3 +147,184 @@ OCIO_ADD_TEST(Context, use_searchpaths_workingdir)
                              SanitizePath(res2.c_str()).c_str()) == 0);
 }
 
+OCIO_ADD_TEST(Context, concurrent_resolve)
+{
+    OCIO::ContextRcPtr context = OCIO::Context::Create();
+
+    const std::string searchPath1 = ociodir + "/src/OpenColorIO";
+    const std::string searchPath2 = ociodir + "/tests/gpu";
+    context->addSearchPath(searchPath1.c_str());
+    context->addSearchPath(searchPath2.c_str());
+
+    OCIO::ConstContextRcPtr constContext = context;
+
+    // All the threads resolve the same file names: the cached results are shared.
+
+    static const int numThreads = 8;
+    std::vector<const char *> results1(numThreads, nullptr);
+    std::vector<const char *> results2(numThreads, nullptr);
+    std::vector<const char *> cacheIDs(numThreads, nullptr);
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < numThreads; ++t)
+    {
+        threads.emplace_back([&, t]()
+        {
+            for (int i = 0; i < 100; ++i)
+            {
+                results1[t] = constContext->resolveFileLocation("Context.cpp");
+                results2[t] = constContext->resolveFileLocation("GPUHelpers.h");
+                cacheIDs[t] = constContext->getCacheID();
+            }
+        });
+    }
+    for (auto & thread : threads)
+    {
+        thread.join();
+    }
+
+    const std::string res1 = searchPath1 + "/Context.cpp";
+    const std::string res2 = searchPath2 + "/GPUHelpers.h";
+    for (int t = 0; t < numThreads; ++t)
+    {
+        OCIO_REQUIRE_ASSERT(results1[t]);
+        OCIO_REQUIRE_ASSERT(results2[t]);
+        OCIO_CHECK_EQUAL(results1[t], results1[0]);
+        OCIO_CHECK_EQUAL(results2[t], results2[0]);
+        OCIO_CHECK_EQUAL(cacheIDs[t], cacheIDs[0]);
+    }
+    OCIO_CHECK_EQUAL(SanitizePath(results1[0]), SanitizePath(res1.c_str()));
+    OCIO_CHECK_EQUAL(SanitizePath(results2[0]), SanitizePath(res2.c_str()));
+}
+
+OCIO_ADD_TEST(Context, resolve_with_directory_listings)
+{
+    OCIO::ClearAllCaches();
+
+    OCIO::ContextRcPtr context = OCIO::Context::Create();
+
+    // Several search paths (including a missing directory) where only the last one
+    // contains the file.
+    const std::string searchPath1 = ociodir + "/tests/gpu";
+    const std::string searchPath2 = ociodir + "/missing_directory";
+    const std::string searchPath3 = ociodir + "/src";
+    context->addSearchPath(searchPath1.c_str());
+    context->addSearchPath(searchPath2.c_str());
+    context->addSearchPath(searchPath3.c_str());
+
+    // A relative file reference with a sub-directory.
+    std::string resolvedSource;
+    OCIO_CHECK_NO_THROW(resolvedSource = context->resolveFileLocation("OpenColorIO/Context.cpp"));
+    const std::string res1 = searchPath3 + "/OpenColorIO/Context.cpp";
+    OCIO_CHECK_EQUAL(SanitizePath(resolvedSource.c_str()), SanitizePath(res1.c_str()));
+
+    OCIO_CHECK_THROW(context->resolveFileLocation("missing_file.cpp"), OCIO::ExceptionMissingFile);
+
+    // The expanded search paths are computed again when the search paths change.
+    context->setSearchPath((ociodir + "/src/OpenColorIO").c_str());
+    OCIO_CHECK_NO_THROW(resolvedSource = context->resolveFileLocation("Context.cpp"));
+    OCIO_CHECK_EQUAL(SanitizePath(resolvedSource.c_str()), SanitizePath(res1.c_str()));
+
+    // Or when the variables change.
+    context->setSearchPath("${OCIO_TEST_DIR}");
+    context->setStringVar("OCIO_TEST_DIR", searchPath1.c_str());
+    OCIO_CHECK_THROW(context->resolveFileLocation("Context.cpp"), OCIO::ExceptionMissingFile);
+    context->setStringVar("OCIO_TEST_DIR", (ociodir + "/src/OpenColorIO").c_str());
+    OCIO_CHECK_NO_THROW(resolvedSource = context->resolveFileLocation("Context.cpp"));
+    OCIO_CHECK_EQUAL(SanitizePath(resolvedSource.c_str()), SanitizePath(res1.c_str()));
+}
+
+OCIO_ADD_TEST(Context, try_resolve_file_location)
+{
+    OCIO::ContextRcPtr context = OCIO::Context::Create();
+    const std::string searchPath1 = ociodir + "/tests/gpu";
+    const std::string searchPath2 = ociodir + "/src/OpenColorIO";
+    context->addSearchPath(searchPath1.c_str());
+    context->addSearchPath(searchPath2.c_str());
+
+    const char * resolved = nullptr;
+    OCIO_CHECK_NO_THROW(resolved = context->tryResolveFileLocation("Context.cpp"));
+    OCIO_REQUIRE_ASSERT(resolved);
+    const std::string res = searchPath2 + "/Context.cpp";
+    OCIO_CHECK_EQUAL(SanitizePath(resolved), SanitizePath(res.c_str()));
+    OCIO_CHECK_EQUAL(std::string(resolved), std::string(context->resolveFileLocation("Context.cpp")));
+
+    OCIO_CHECK_NO_THROW(resolved = context->tryResolveFileLocation("missing_file.cpp"));
+    OCIO_CHECK_ASSERT(!resolved);
+    OCIO_CHECK_THROW_WHAT(context->resolveFileLocation("missing_file.cpp"),
+                          OCIO::ExceptionMissingFile,
+                          "The following attempts were made");
+
+    const std::string missingAbsolute = ociodir + "/missing_file.cpp";
+    OCIO_CHECK_NO_THROW(resolved = context->tryResolveFileLocation(missingAbsolute.c_str()));
+    OCIO_CHECK_ASSERT(!resolved);
+    OCIO_CHECK_THROW_WHAT(context->resolveFileLocation(missingAbsolute.c_str()),
+                          OCIO::Exception,
+                          "absolute file reference");
+
+    OCIO_CHECK_EQUAL(std::string(context->tryResolveFileLocation("")), "");
+}
+
+OCIO_ADD_TEST(Context, cache_id_states)
+{
+    OCIO::ContextRcPtr context = OCIO::Context::Create();
+    context->addSearchPath(ociodir.c_str());
+    context->setStringVar("SEQ", "seq01");
+    context->setStringVar("SHOT", "shot010");
+
+    const std::string cacheID1 = context->getCacheID();
+    const char * resolved1 = context->resolveStringVar("${SEQ}/${SHOT}");
+    OCIO_CHECK_EQUAL(std::string(resolved1), "seq01/shot010");
+
+    context->setStringVar("SHOT", "shot020");
+    const std::string cacheID2 = context->getCacheID();
+    OCIO_CHECK_NE(cacheID2, cacheID1);
+    OCIO_CHECK_EQUAL(std::string(context->resolveStringVar("${SEQ}/${SHOT}")), "seq01/shot020");
+
+    // Going back to the previous shot reuses its results.
+    OCIO::ResetCacheStatistics();
+    context->setStringVar("SHOT", "shot010");
+    OCIO_CHECK_EQUAL(std::string(context->getCacheID()), cacheID1);
+    OCIO_CHECK_EQUAL(context->resolveStringVar("${SEQ}/${SHOT}"), resolved1);
+    OCIO_CHECK_EQUAL(OCIO::GetCacheStatistic(OCIO::CACHE_CONTEXT_RESULTS,
+                                             OCIO::CACHE_STATISTIC_HITS), 1);
+    OCIO_CHECK_EQUAL(OCIO::GetCacheStatistic(OCIO::CACHE_CONTEXT_RESULTS,
+                                             OCIO::CACHE_STATISTIC_MISSES), 0);
+
+    // The cache id does not depend on the order of the variables.
+    OCIO::ContextRcPtr other = OCIO::Context::Create();
+    other->setStringVar("SHOT", "shot010");
+    other->setStringVar("TMP", "tmp");
+    other->addSearchPath(ociodir.c_str());
+    other->setStringVar("SEQ", "seq01");
+    OCIO_CHECK_NE(std::string(other->getCacheID()), cacheID1);
+    other->setStringVar("TMP", nullptr);
+    OCIO_CHECK_EQUAL(std::string(other->getCacheID()), cacheID1);
+
+    // The name and the value of a variable are not mixed up.
+    other->setStringVar("SHOT", nullptr);
+    other->setStringVar("SHOTs", "hot010");
+    OCIO_CHECK_NE(std::string(other->getCacheID()), cacheID1);
+
+    // A copy has the same cache id.
+    OCIO::ContextRcPtr copy = context->createEditableCopy();
+    OCIO_CHECK_EQUAL(std::string(copy->getCacheID()), cacheID1);
+    OCIO_CHECK_EQUAL(std::string(copy->resolveStringVar("${SEQ}/${SHOT}")), "seq01/shot010");
+
+    // Only the results of the recent states are kept.
+    OCIO::ResetCacheStatistics();
+    for (int shot = 0; shot < 32; ++shot)
+    {
+        const std::string name = "shot" + std::to_string(shot);
+        context->setStringVar("SHOT", name.c_str());
+        OCIO_CHECK_EQUAL(std::string(context->resolveStringVar("${SHOT}")), name);
+    }
+    OCIO_CHECK_GT(OCIO::GetCacheStatistic(OCIO::CACHE_CONTEXT_RESULTS,
+                                          OCIO::CACHE_STATISTIC_EVICTIONS), 0);
+
+    // Clearing the variables gives the cache id of a new context with the same search path.
+    context->clearStringVars();
+    OCIO::ContextRcPtr empty = OCIO::Context::Create();
+    empty->addSearchPath(ociodir.c_str());
+    OCIO_CHECK_EQUAL(std::string(context->getCacheID()), std::string(empty->getCacheID()));
+}
@@ -0,0 +1,498 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the OpenColorIO Project.
+
+
+// The benchmark of the LUT file parsing i.e. the FileFormat::read() methods of the file
+// format readers, on synthetic large files of each format. It reports the throughput in
+// megabytes and in millions of LUT values parsed per second, cold (i.e. the first read
+// from the file) and warm (i.e. the average of the next reads from memory).
+//
+//   bench_fileformats [--size <cube size>] [--time <milliseconds>] [--keep] [lutfile ...]
+//
+// The synthetic files are written in the working directory and removed at the end (unless
+// --keep is given). The LUT files given on the command line are measured with each
+// format registered for their extension.
+
+
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <OpenColorIO/OpenColorIO.h>
+
+#include "pystring/pystring.h"
+#include "transforms/FileTransform.h"
+
+
+namespace OCIO = OCIO_NAMESPACE;
+
+
+namespace
+{
+
+// Size of the 1D LUTs and of the shapers.
+const int Lut1DSize   = 65536;
+const int ShaperSize  = 4096;
+
+// A smooth but not trivial function to fill the LUTs (i.e. not an identity).
+void ComputeValue(float r, float g, float b, float * out)
+{
+    out[0] = std::pow(0.9f * r + 0.05f * g + 0.05f * b, 1.0f / 2.2f);
+    out[1] = std::pow(0.1f * r + 0.8f  * g + 0.1f  * b, 1.0f / 2.2f);
+    out[2] = std::pow(0.05f * r + 0.15f * g + 0.8f * b, 1.0f / 2.2f);
+}
+
+float ComputeValue1D(int idx, int size)
+{
+    return std::pow(float(idx) / float(size - 1), 1.0f / 2.4f);
+}
+
+// Loop over the cube entries, the blue index changing the fastest unless redFastest.
+void ForEachCubeEntry(int size, bool redFastest,
+                      const std::function<void(int, int, int, const float *)> & func)
+{
+    float rgb[3];
+    const float scale = 1.0f / float(size - 1);
+    for(int i = 0; i < size; ++i)
+    {
+        for(int j = 0; j < size; ++j)
+        {
+            for(int k = 0; k < size; ++k)
+            {
+                const int r = redFastest ? k : i;
+                const int b = redFastest ? i : k;
+                ComputeValue(r * scale, j * scale, b * scale, rgb);
+                func(r, j, b, rgb);
+            }
+        }
+    }
+}
+
+void WriteIridasCube(std::ostream & os, int size)
+{
+    os << "TITLE \"bench_fileformats\"\n";
+    os << "LUT_3D_SIZE " << size << "\n\n";
+    ForEachCubeEntry(size, true, [&os](int, int, int, const float * rgb)
+                     {
+                         os << rgb[0] << " " << rgb[1] << " " << rgb[2] << "\n";
+                     });
+}
+
+void WriteSpi3D(std::ostream & os, int size)
+{
+    os << "SPILUT 1.0\n3 3\n" << size << " " << size << " " << size << "\n";
+    ForEachCubeEntry(size, false, [&os](int r, int g, int b, const float * rgb)
+                     {
+                         os << r << " " << g << " " << b << " "
+                            << rgb[0] << " " << rgb[1] << " " << rgb[2] << "\n";
+                     });
+}
+
+void Write3DL(std::ostream & os, int size)
+{
+    // The flame flavor i.e. a 10-bit shaper and a 12-bit cube.
+    os << "# bench_fileformats\n";
+    for(int i = 0; i < size; ++i)
+    {
+        os << (i ? " " : "") << (i * 1023) / (size - 1);
+    }
+    os << "\n";
+    ForEachCubeEntry(size, false, [&os](int, int, int, const float * rgb)
+                     {
+                         os << int(rgb[0] * 4095.0f + 0.5f) << " "
+                            << int(rgb[1] * 4095.0f + 0.5f) << " "
+                            << int(rgb[2] * 4095.0f + 0.5f) << "\n";
+                     });
+}
+
+void WriteCLF(std::ostream & os, int size)
+{
+    os << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n";
+    os << "<ProcessList id=\"bench_fileformats\" compCLFversion=\"2.0\">\n";
+    os << "    <LUT1D inBitDepth=\"32f\" outBitDepth=\"32f\">\n";
+    os << "        <Array dim=\"" << Lut1DSize << " 3\">\n";
+    for(int i = 0; i < Lut1DSize; ++i)
+    {
+        const float value = ComputeValue1D(i, Lut1DSize);
+        os << value << " " << value << " " << value << "\n";
+    }
+    os << "        </Array>\n";
+    os << "    </LUT1D>\n";
+    os << "    <LUT3D inBitDepth=\"32f\" outBitDepth=\"32f\">\n";
+    os << "        <Array dim=\"" << size << " " << size << " " << size << " 3\">\n";
+    ForEachCubeEntry(size, false, [&os](int, int, int, const float * rgb)
+                     {
+                         os << rgb[0] << " " << rgb[1] << " " << rgb[2] << "\n";
+                     });
+    os << "        </Array>\n";
+    os << "    </LUT3D>\n";
+    os << "</ProcessList>\n";
+}
+
+void WriteCSP(std::ostream & os, int size)
+{
+    os << "CSPLUTV100\n3D\n\n";
+    os << "BEGIN METADATA\nbench_fileformats\nEND METADATA\n\n";
+    for(int c = 0; c < 3; ++c)
+    {
+        os << ShaperSize << "\n";
+        for(int i = 0; i < ShaperSize; ++i)
+        {
+            os << (i ? " " : "") << float(i) / float(ShaperSize - 1);
+        }
+        os << "\n";
+        for(int i = 0; i < ShaperSize; ++i)
+        {
+            os << (i ? " " : "") << ComputeValue1D(i, ShaperSize);
+        }
+        os << "\n";
+    }
+    os << "\n" << size << " " << size << " " << size << "\n";
+    ForEachCubeEntry(size, true, [&os](int, int, int, const float * rgb)
+                     {
+                         os << rgb[0] << " " << rgb[1] << " " << rgb[2] << "\n";
+                     });
+}
+
+void WriteHDL(std::ostream & os, int size)
+{
+    os << "Version\t\t3\nFormat\t\tany\nType\t\t3D+1D\n";
+    os << "From\t\t0 1\nTo\t\t0 1\nBlack\t\t0\nWhite\t\t1\n";
+    os << "Length\t\t" << size << " " << ShaperSize << "\nLUT:\n";
+    os << "Pre {\n";
+    for(int i = 0; i < ShaperSize; ++i)
+    {
+        os << "\t" << ComputeValue1D(i, ShaperSize) << "\n";
+    }
+    os << "}\n3D {\n";
+    ForEachCubeEntry(size, true, [&os](int, int, int, const float * rgb)
+                     {
+                         os << "\t" << rgb[0] << " " << rgb[1] << " " << rgb[2] << "\n";
+                     });
+    os << "}\n";
+}
+
+void WriteDiscreet1DL(std::ostream & os, int /*size*/)
+{
+    // Three 16-bit tables.
+    os << "LUT: 3 " << Lut1DSize << "\n";
+    for(int c = 0; c < 3; ++c)
+    {
+        os << "\n";
+        for(int i = 0; i < Lut1DSize; ++i)
+        {
+            os << int(ComputeValue1D(i, Lut1DSize) * 65535.0f + 0.5f) << "\n";
+        }
+    }
+}
+
+void WriteHexFloat(std::ostream & os, float value)
+{
+    static const char Digits[] = "0123456789ABCDEF";
+
+    uint32_t bits = 0;
+    std::memcpy(&bits, &value, sizeof(float));
+
+    // Little-endian byte ordering.
+    for(int byte = 0; byte < 4; ++byte)
+    {
+        const uint32_t v = (bits >> (8 * byte)) & 0xFF;
+        os << Digits[v >> 4] << Digits[v & 0xF];
+    }
+}
+
+void WriteIridasLook(std::ostream & os, int size)
+{
+    os << "<?xml version=\"1.0\" ?>\n<look>\n  <shaders>\n  </shaders>\n";
+    os << "  <LUT>\n    <size>\"" << size << "\"</size>\n    <data>\"\n";
+    int count = 0;
+    ForEachCubeEntry(size, true, [&os, &count](int, int, int, const float * rgb)
+                     {
+                         for(int c = 0; c < 3; ++c)
+                         {
+                             if(count % 8 == 0)
+                             {
+                                 os << (count ? "\n      " : "      ");
+                             }
+                             WriteHexFloat(os, rgb[c]);
+                             ++count;
+                         }
+                     });
+    os << "\"\n    </data>\n  </LUT>\n</look>\n";
+}
+
+struct SyntheticFile
+{
+    const char * m_formatName;
+    const char * m_extension;
+    std::function<void(std::ostream &, int)> m_writer;
+    // Number of LUT values for a cube size.
+    std::function<long(int)> m_numValues;
+};
+
+long CubeValues(int size)
+{
+    return 3L * size * size * size;
+}
+
+std::vector<SyntheticFile> GetSyntheticFiles()
+{
+    return {
+        { "iridas_cube",       "cube", WriteIridasCube, CubeValues },
+        { "spi3d",             "spi3d", WriteSpi3D,
+          [](int size) { return 2 * CubeValues(size); } },
+        { "flame",             "3dl",  Write3DL,
+          [](int size) { return size + CubeValues(size); } },
+        { OCIO::FILEFORMAT_CLF, "clf", WriteCLF,
+          [](int size) { return 3L * Lut1DSize + CubeValues(size); } },
+        { "cinespace",         "csp",  WriteCSP,
+          [](int size) { return 6L * ShaperSize + CubeValues(size); } },
+        { "houdini",           "lut",  WriteHDL,
+          [](int size) { return ShaperSize + CubeValues(size); } },
+        { "Discreet 1D LUT",   "lut",  WriteDiscreet1DL,
+          [](int) { return 3L * Lut1DSize; } },
+        { "iridas_look",       "look", WriteIridasLook, CubeValues },
+    };
+}
+
+std::string ReadFileContent(const std::string & filepath)
+{
+    std::ifstream file(filepath.c_str(), std::ios_base::in | std::ios_base::binary);
+    if(!file)
+    {
+        throw OCIO::Exception(("Cannot open the file '" + filepath + "'.").c_str());
+    }
+    std::ostringstream oss;
+    oss << file.rdbuf();
+    return oss.str();
+}
+
+struct Measure
+{
+    double m_coldSeconds = 0.0;
+    double m_warmSeconds = 0.0;
+};
+
+// The cold read opens the file (as FileTransform does), the warm reads parse the content
+// from memory to only measure the parsing.
+Measure MeasureRead(const OCIO::FileFormat & format, const std::string & filepath,
+                    const std::string & content, double minSeconds)
+{
+    Measure measure;
+
+    {
+        const auto start = std::chrono::steady_clock::now();
+        std::ifstream file(filepath.c_str(), format.isBinary() ? std::ios_base::binary
+                                                               : std::ios_base::in);
+        format.read(file, filepath);
+        const std::chrono::duration<double> duration = std::chrono::steady_clock::now() - start;
+        measure.m_coldSeconds = duration.count();
+    }
+
+    long numReads = 0;
+    const auto start = std::chrono::steady_clock::now();
+    std::chrono::duration<double> duration(0.0);
+    do
+    {
+        std::istringstream istream(content);
+        format.read(istream, filepath);
+        ++numReads;
+        duration = std::chrono::steady_clock::now() - start;
+    }
+    while(duration.count() < minSeconds);
+
+    measure.m_warmSeconds = duration.count() / double(numReads);
+
+    return measure;
+}
+
+void PrintHeader()
+{
+    std::cout << "Throughput in MB/s and millions of LUT values per second." << std::endl
+              << std::endl;
+    std::cout << std::left << std::setw(32) << "Format" << std::setw(36) << "File"
+              << std::right << std::setw(10) << "MB" << std::setw(12) << "Mvalues"
+              << std::setw(12) << "Cold MB/s" << std::setw(12) << "Warm MB/s"
+              << std::setw(14) << "Warm Mval/s" << std::endl;
+}
+
+void PrintMeasure(const std::string & formatName, const std::string & filepath,
+                  size_t numBytes, long numValues, const Measure & measure)
+{
+    const double megabytes = double(numBytes) / (1024.0 * 1024.0);
+    const double mvalues   = double(numValues) / 1.0e6;
+
+    std::cout << std::left << std::setw(32) << formatName << std::setw(36) << filepath
+              << std::right << std::fixed << std::setprecision(2)
+              << std::setw(10) << megabytes;
+
+    if(numValues > 0)
+    {
+        std::cout << std::setw(12) << mvalues;
+    }
+    else
+    {
+        std::cout << std::setw(12) << "-";
+    }
+
+    std::cout << std::setw(12) << megabytes / measure.m_coldSeconds
+              << std::setw(12) << megabytes / measure.m_warmSeconds;
+
+    if(numValues > 0)
+    {
+        std::cout << std::setw(14) << mvalues / measure.m_warmSeconds;
+    }
+    else
+    {
+        std::cout << std::setw(14) << "-";
+    }
+    std::cout << std::endl;
+}
+
+void PrintUsage()
+{
+    std::cerr << "Usage: bench_fileformats [--size <cube size>] [--time <milliseconds>] "
+                 "[--keep] [lutfile ...]\n";
+}
+
+}
+
+
+int main(int argc, const char ** argv)
+{
+    int cubeSize = 65;
+    double minSeconds = 1.0;
+    bool keepFiles = false;
+    std::vector<std::string> lutFiles;
+
+    for(int idx = 1; idx < argc; ++idx)
+    {
+        const std::string arg(argv[idx]);
+        if(arg == "--size" && idx + 1 < argc)
+        {
+            cubeSize = std::atoi(argv[++idx]);
+        }
+        else if(arg == "--time" && idx + 1 < argc)
+        {
+            minSeconds = std::atof(argv[++idx]) / 1000.0;
+        }
+        else if(arg == "--keep")
+        {
+            keepFiles = true;
+        }
+        else if(!arg.empty() && arg[0] != '-')
+        {
+            lutFiles.push_back(arg);
+        }
+        else
+        {
+            PrintUsage();
+            return 1;
+        }
+    }
+
+    if(cubeSize < 2)
+    {
+        PrintUsage();
+        return 1;
+    }
+
+    std::vector<std::string> syntheticFilenames;
+    int status = 0;
+
+    try
+    {
+        OCIO::FormatRegistry & registry = OCIO::FormatRegistry::GetInstance();
+
+        PrintHeader();
+
+        int fileIdx = 0;
+        for(const auto & synthetic : GetSyntheticFiles())
+        {
+            const OCIO::FileFormat * format = registry.getFileFormatByName(synthetic.m_formatName);
+            if(!format)
+            {
+                throw OCIO::Exception((std::string("Unknown file format '")
+                                       + synthetic.m_formatName + "'.").c_str());
+            }
+
+            std::ostringstream filename;
+            filename << "bench_fileformats_" << fileIdx++ << "." << synthetic.m_extension;
+            const std::string filepath(filename.str());
+
+            {
+                std::ofstream file(filepath.c_str());
+                file.setf(std::ios::fixed, std::ios::floatfield);
+                file.precision(6);
+                synthetic.m_writer(file, cubeSize);
+                if(!file)
+                {
+                    throw OCIO::Exception(("Cannot write the file '" + filepath + "'.").c_str());
+                }
+            }
+            syntheticFilenames.push_back(filepath);
+
+            const std::string content(ReadFileContent(filepath));
+            const Measure measure = MeasureRead(*format, filepath, content, minSeconds);
+
+            PrintMeasure(synthetic.m_formatName, filepath, content.size(),
+                         synthetic.m_numValues(cubeSize), measure);
+        }
+
+        for(const auto & filepath : lutFiles)
+        {
+            std::string root, extension;
+            pystring::os::path::splitext(root, extension, filepath);
+            extension = pystring::replace(extension, ".", "", 1);
+
+            OCIO::FileFormatVector formats;
+            registry.getFileFormatForExtension(extension, formats);
+            if(formats.empty())
+            {
+                std::cerr << "No file format for '" << filepath << "'." << std::endl;
+                status = 1;
+                continue;
+            }
+
+            const std::string content(ReadFileContent(filepath));
+
+            // As in FileTransform, the formats not able to read the file are skipped.
+            for(const auto format : formats)
+            {
+                try
+                {
+                    const Measure measure = MeasureRead(*format, filepath, content, minSeconds);
+                    PrintMeasure(format->getName(), filepath, content.size(), 0, measure);
+                }
+                catch(const OCIO::Exception &)
+                {
+                }
+            }
+        }
+    }
+    catch(const std::exception & e)
+    {
+        std::cerr << "Error: " << e.what() << std::endl;
+        status = 1;
+    }
+
+    if(!keepFiles)
+    {
+        for(const auto & filepath : syntheticFilenames)
+        {
+            std::remove(filepath.c_str());
+        }
+    }
+
+    return status;
+}
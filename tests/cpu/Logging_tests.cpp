@@ -179,3 +179,38 @@ OCIO_ADD_TEST(Logging, message_function)
                                  "[OpenColorIO Debug]: My third msg\n");
     }
 }
+
+OCIO_ADD_TEST(Logging, lazy_message)
+{
+    LogGuard guard;
+
+    int numFormatted = 0;
+    auto format = [&numFormatted]() { ++numFormatted; return 42; };
+
+    OCIO::SetLoggingLevel(OCIO::LOGGING_LEVEL_INFO);
+
+    // The message is not even built when the level is disabled.
+    OCIO_LOG_DEBUG("Value " << format());
+    OCIO_CHECK_EQUAL(numFormatted, 0);
+    OCIO_CHECK_ASSERT(output.empty());
+
+    OCIO_LOG_INFO("Value " << format());
+    OCIO_CHECK_EQUAL(numFormatted, 1);
+    OCIO_CHECK_EQUAL(output, "[OpenColorIO Info]: Value 42\n");
+    output.clear();
+
+    OCIO_LOG_WARNING("Value " << format());
+    OCIO_CHECK_EQUAL(numFormatted, 2);
+    OCIO_CHECK_EQUAL(output, "[OpenColorIO Warning]: Value 42\n");
+    output.clear();
+
+    OCIO::SetLoggingLevel(OCIO::LOGGING_LEVEL_DEBUG);
+
+    OCIO_LOG_DEBUG("Value " << format());
+    OCIO_CHECK_EQUAL(numFormatted, 3);
+    OCIO_CHECK_EQUAL(output, "[OpenColorIO Debug]: Value 42\n");
+
+    OCIO_CHECK_ASSERT(OCIO::IsLoggingLevelEnabled(OCIO::LOGGING_LEVEL_WARNING));
+    OCIO::SetLoggingLevel(OCIO::LOGGING_LEVEL_NONE);
+    OCIO_CHECK_ASSERT(!OCIO::IsLoggingLevelEnabled(OCIO::LOGGING_LEVEL_WARNING));
+}
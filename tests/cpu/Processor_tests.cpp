@@ -25,7 +25,7 @@ OCIO_ADD_TEST(Processor, basic)
     auto processorMat = config->getProcessor(mat);
     OCIO_CHECK_EQUAL(processorMat->getNumTransforms(), 1);
 
-    OCIO_CHECK_EQUAL(std::string(processorMat->getCacheID()), "$c15dfc9b251ee075f33c4ccb3eb1e4b8");
+    OCIO_CHECK_EQUAL(std::string(processorMat->getCacheID()), "$20efae7cac22cde77361bf6a13048267");
 }
 
 OCIO_ADD_TEST(Processor, shared_dynamic_properties)
@@ -75,6 +75,990 @@ OCIO_ADD_TEST(Processor, shared_dynamic_properties)
     OCIO_CHECK_EQUAL(dp0.get(), dp0_post.get());
 }
 
+OCIO_ADD_TEST(Processor, memoized_processors)
+{
+    OCIO::ConfigRcPtr config = OCIO::Config::Create();
+    config->setMajorVersion(2);
+
+    auto log = OCIO::LogTransform::Create();
+    log->setBase(10.0);
+
+    OCIO::ConstProcessorRcPtr processor;
+    OCIO_CHECK_NO_THROW(processor = config->getProcessor(log));
+
+    // The same finalization parameters return the same CPU & GPU processors.
+
+    OCIO::ConstCPUProcessorRcPtr cpu = processor->getDefaultCPUProcessor();
+    OCIO_CHECK_EQUAL(cpu.get(), processor->getDefaultCPUProcessor().get());
+    OCIO_CHECK_EQUAL(cpu.get(),
+                     processor->getOptimizedCPUProcessor(OCIO::OPTIMIZATION_DEFAULT,
+                                                         OCIO::FINALIZATION_DEFAULT).get());
+    OCIO_CHECK_EQUAL(cpu.get(),
+                     processor->getOptimizedCPUProcessor(OCIO::BIT_DEPTH_F32,
+                                                         OCIO::BIT_DEPTH_F32,
+                                                         OCIO::OPTIMIZATION_DEFAULT,
+                                                         OCIO::FINALIZATION_DEFAULT).get());
+
+    OCIO::ConstCPUProcessorRcPtr cpu8
+        = processor->getOptimizedCPUProcessor(OCIO::BIT_DEPTH_UINT8,
+                                              OCIO::BIT_DEPTH_F32,
+                                              OCIO::OPTIMIZATION_DEFAULT,
+                                              OCIO::FINALIZATION_DEFAULT);
+    OCIO_CHECK_NE(cpu.get(), cpu8.get());
+    OCIO_CHECK_EQUAL(cpu8->getInputBitDepth(), OCIO::BIT_DEPTH_UINT8);
+    OCIO_CHECK_EQUAL(cpu8.get(),
+                     processor->getOptimizedCPUProcessor(OCIO::BIT_DEPTH_UINT8,
+                                                         OCIO::BIT_DEPTH_F32,
+                                                         OCIO::OPTIMIZATION_DEFAULT,
+                                                         OCIO::FINALIZATION_DEFAULT).get());
+
+    OCIO_CHECK_NE(cpu.get(),
+                  processor->getOptimizedCPUProcessor(OCIO::OPTIMIZATION_NONE,
+                                                      OCIO::FINALIZATION_EXACT).get());
+
+    OCIO::ConstGPUProcessorRcPtr gpu = processor->getDefaultGPUProcessor();
+    OCIO_CHECK_EQUAL(gpu.get(), processor->getDefaultGPUProcessor().get());
+    OCIO_CHECK_NE(gpu.get(),
+                  processor->getOptimizedGPUProcessor(OCIO::OPTIMIZATION_NONE,
+                                                      OCIO::FINALIZATION_EXACT).get());
+
+    // The global settings changing the finalization are part of the key.
+
+    const bool fastMath = OCIO::IsCPUFastMath();
+    OCIO::SetCPUFastMath(!fastMath);
+    OCIO::ConstCPUProcessorRcPtr cpuFast = processor->getDefaultCPUProcessor();
+    OCIO::SetCPUFastMath(fastMath);
+
+    OCIO_CHECK_NE(cpu.get(), cpuFast.get());
+    OCIO_CHECK_EQUAL(cpu.get(), processor->getDefaultCPUProcessor().get());
+
+    // The processors with dynamic properties are never memoized.
+
+    auto ec = OCIO::ExposureContrastTransform::Create();
+    ec->setExposure(1.2);
+    ec->makeExposureDynamic();
+
+    OCIO_CHECK_NO_THROW(processor = config->getProcessor(ec));
+
+    cpu = processor->getDefaultCPUProcessor();
+    OCIO_CHECK_NE(cpu.get(), processor->getDefaultCPUProcessor().get());
+    gpu = processor->getDefaultGPUProcessor();
+    OCIO_CHECK_NE(gpu.get(), processor->getDefaultGPUProcessor().get());
+}
+
+OCIO_ADD_TEST(Processor, canonical_cache_id)
+{
+    OCIO::ConfigRcPtr config = OCIO::Config::Create();
+    config->setMajorVersion(2);
+
+    const double scale2[16]{ 2.0, 0.0, 0.0, 0.0,
+                             0.0, 2.0, 0.0, 0.0,
+                             0.0, 0.0, 2.0, 0.0,
+                             0.0, 0.0, 0.0, 1.0 };
+    const double scaleHalf[16]{ 0.5, 0.0, 0.0, 0.0,
+                                0.0, 0.5, 0.0, 0.0,
+                                0.0, 0.0, 0.5, 0.0,
+                                0.0, 0.0, 0.0, 1.0 };
+
+    auto inferred = OCIO::MatrixTransform::Create();
+    inferred->setMatrix(scale2);
+    inferred->setDirection(OCIO::TRANSFORM_DIR_INVERSE);
+
+    auto explicitInverse = OCIO::MatrixTransform::Create();
+    explicitInverse->setMatrix(scaleHalf);
+
+    OCIO::ConstProcessorRcPtr proc1, proc2;
+    OCIO_CHECK_NO_THROW(proc1 = config->getProcessor(inferred));
+    OCIO_CHECK_NO_THROW(proc2 = config->getProcessor(explicitInverse));
+    OCIO_REQUIRE_ASSERT(proc1.get() != proc2.get());
+
+    // An explicit inverse and the inferred one are the same color processing.
+    OCIO_CHECK_EQUAL(std::string(proc1->getCacheID()), std::string(proc2->getCacheID()));
+
+    // So the finalized GPU processors are shared.
+    OCIO::ConstGPUProcessorRcPtr gpu = proc1->getDefaultGPUProcessor();
+    OCIO_CHECK_EQUAL(gpu.get(), proc2->getDefaultGPUProcessor().get());
+    OCIO_CHECK_NE(gpu.get(),
+                  proc2->getOptimizedGPUProcessor(OCIO::OPTIMIZATION_NONE,
+                                                  OCIO::FINALIZATION_EXACT).get());
+
+    // A different color processing has a different cache id.
+    auto forward = OCIO::MatrixTransform::Create();
+    forward->setMatrix(scale2);
+
+    OCIO::ConstProcessorRcPtr proc3;
+    OCIO_CHECK_NO_THROW(proc3 = config->getProcessor(forward));
+    OCIO_CHECK_NE(std::string(proc1->getCacheID()), std::string(proc3->getCacheID()));
+    OCIO_CHECK_NE(gpu.get(), proc3->getDefaultGPUProcessor().get());
+
+    // Ops cancelling each other are a no-op.
+    auto group = OCIO::GroupTransform::Create();
+    group->appendTransform(forward);
+    group->appendTransform(explicitInverse);
+
+    OCIO::ConstProcessorRcPtr proc4;
+    OCIO_CHECK_NO_THROW(proc4 = config->getProcessor(group));
+    OCIO_CHECK_EQUAL(proc4->getNumTransforms(), 2);
+    OCIO_CHECK_EQUAL(std::string(proc4->getCacheID()), "<NOOP>");
+}
+
+OCIO_ADD_TEST(Processor, gpu_shader_fragment_cache)
+{
+    OCIO::ConfigRcPtr config = OCIO::Config::Create();
+    config->setMajorVersion(2);
+
+    auto mat = OCIO::MatrixTransform::Create();
+    double offset[4]{ 0.1, 0.2, 0.3, 0.4 };
+    mat->setOffset(offset);
+
+    OCIO::ConstProcessorRcPtr processor;
+    OCIO_CHECK_NO_THROW(processor = config->getProcessor(mat));
+    OCIO::ConstGPUProcessorRcPtr gpu = processor->getDefaultGPUProcessor();
+
+    OCIO::ClearGpuShaderFragmentCache();
+
+    OCIO::GpuShaderDescRcPtr shaderDesc1 = OCIO::GpuShaderDesc::CreateShaderDesc();
+    shaderDesc1->setLanguage(OCIO::GPU_LANGUAGE_GLSL_1_3);
+    OCIO_CHECK_NO_THROW(gpu->extractGpuShaderInfo(shaderDesc1));
+
+    // The second shader reuses the matrix shader code and is identical.
+    OCIO::GpuShaderDescRcPtr shaderDesc2 = OCIO::GpuShaderDesc::CreateShaderDesc();
+    shaderDesc2->setLanguage(OCIO::GPU_LANGUAGE_GLSL_1_3);
+    OCIO_CHECK_NO_THROW(gpu->extractGpuShaderInfo(shaderDesc2));
+    OCIO_CHECK_EQUAL(std::string(shaderDesc1->getShaderText()),
+                     std::string(shaderDesc2->getShaderText()));
+    OCIO_CHECK_EQUAL(std::string(shaderDesc1->getCacheID()),
+                     std::string(shaderDesc2->getCacheID()));
+
+    // The shader code depends on the pixel name.
+    OCIO::GpuShaderDescRcPtr shaderDesc3 = OCIO::GpuShaderDesc::CreateShaderDesc();
+    shaderDesc3->setLanguage(OCIO::GPU_LANGUAGE_GLSL_1_3);
+    shaderDesc3->setPixelName("otherPixel");
+    OCIO_CHECK_NO_THROW(gpu->extractGpuShaderInfo(shaderDesc3));
+
+    const std::string text(shaderDesc3->getShaderText());
+    OCIO_CHECK_NE(text.find("otherPixel = "), std::string::npos);
+    OCIO_CHECK_EQUAL(text.find(shaderDesc1->getPixelName()), std::string::npos);
+}
+
+OCIO_ADD_TEST(Processor, gpu_shader_program_cache)
+{
+    OCIO::ConfigRcPtr config = OCIO::Config::Create();
+    config->setMajorVersion(2);
+
+    auto lut = OCIO::LUT3DTransform::Create(5);
+    lut->setValue(0, 0, 0, 0.1f, 0.2f, 0.3f);
+
+    OCIO::ConstProcessorRcPtr processor;
+    OCIO_CHECK_NO_THROW(processor = config->getProcessor(lut));
+    OCIO::ConstGPUProcessorRcPtr gpu = processor->getDefaultGPUProcessor();
+
+    OCIO::ClearAllCaches();
+
+    OCIO::GpuShaderDescRcPtr shaderDesc1 = OCIO::GpuShaderDesc::CreateShaderDesc();
+    shaderDesc1->setLanguage(OCIO::GPU_LANGUAGE_GLSL_1_3);
+    OCIO_CHECK_NO_THROW(gpu->extractGpuShaderInfo(shaderDesc1));
+    OCIO_REQUIRE_EQUAL(shaderDesc1->getNum3DTextures(), 1U);
+
+    // The second extraction copies the cached shader program.
+    OCIO::GpuShaderDescRcPtr shaderDesc2 = OCIO::GpuShaderDesc::CreateShaderDesc();
+    shaderDesc2->setLanguage(OCIO::GPU_LANGUAGE_GLSL_1_3);
+    OCIO_CHECK_NO_THROW(gpu->extractGpuShaderInfo(shaderDesc2));
+    OCIO_REQUIRE_EQUAL(shaderDesc2->getNum3DTextures(), 1U);
+    OCIO_CHECK_EQUAL(std::string(shaderDesc1->getShaderText()),
+                     std::string(shaderDesc2->getShaderText()));
+    OCIO_CHECK_EQUAL(std::string(shaderDesc1->getCacheID()),
+                     std::string(shaderDesc2->getCacheID()));
+
+    // The texture values are shared.
+    const float * values1 = nullptr;
+    const float * values2 = nullptr;
+    shaderDesc1->get3DTextureValues(0, values1);
+    shaderDesc2->get3DTextureValues(0, values2);
+    OCIO_CHECK_EQUAL(values1, values2);
+    OCIO_CHECK_EQUAL(values1[0], 0.1f);
+
+    // Another processor using the same LUT shares its texture values.
+    auto group = OCIO::GroupTransform::Create();
+    group->appendTransform(lut);
+    auto mat = OCIO::MatrixTransform::Create();
+    double offset[4]{ 0.1, 0.2, 0.3, 0.4 };
+    mat->setOffset(offset);
+    group->appendTransform(mat);
+
+    OCIO_CHECK_NO_THROW(processor = config->getProcessor(group));
+    gpu = processor->getDefaultGPUProcessor();
+
+    OCIO::GpuShaderDescRcPtr shaderDesc3 = OCIO::GpuShaderDesc::CreateShaderDesc();
+    shaderDesc3->setLanguage(OCIO::GPU_LANGUAGE_GLSL_1_3);
+    OCIO_CHECK_NO_THROW(gpu->extractGpuShaderInfo(shaderDesc3));
+    OCIO_REQUIRE_EQUAL(shaderDesc3->getNum3DTextures(), 1U);
+    OCIO_CHECK_NE(std::string(shaderDesc1->getShaderText()),
+                  std::string(shaderDesc3->getShaderText()));
+
+    const float * values3 = nullptr;
+    shaderDesc3->get3DTextureValues(0, values3);
+    OCIO_CHECK_EQUAL(values1, values3);
+
+    // A shader description with other settings is not shared.
+    OCIO::GpuShaderDescRcPtr shaderDesc4 = OCIO::GpuShaderDesc::CreateShaderDesc();
+    shaderDesc4->setLanguage(OCIO::GPU_LANGUAGE_GLSL_1_3);
+    shaderDesc4->setFunctionName("otherFunction");
+    OCIO_CHECK_NO_THROW(gpu->extractGpuShaderInfo(shaderDesc4));
+    OCIO_CHECK_NE(std::string(shaderDesc4->getShaderText()).find("otherFunction"),
+                  std::string::npos);
+}
+
+OCIO_ADD_TEST(Processor, gpu_shader_legacy_lut3d_cache)
+{
+    OCIO::ConfigRcPtr config = OCIO::Config::Create();
+    config->setMajorVersion(2);
+
+    auto lut = OCIO::LUT3DTransform::Create(5);
+    lut->setValue(0, 0, 0, 0.1f, 0.2f, 0.3f);
+
+    OCIO::ConstProcessorRcPtr processor;
+    OCIO_CHECK_NO_THROW(processor = config->getProcessor(lut));
+    OCIO::ConstGPUProcessorRcPtr gpu = processor->getDefaultGPUProcessor();
+
+    OCIO::ClearAllCaches();
+
+    const unsigned edgelen = 32;
+    const size_t lutSize = size_t(edgelen) * edgelen * edgelen * 3 * sizeof(float);
+
+    OCIO::GpuShaderDescRcPtr shaderDesc1 = OCIO::GpuShaderDesc::CreateLegacyShaderDesc(edgelen);
+    shaderDesc1->setLanguage(OCIO::GPU_LANGUAGE_GLSL_1_3);
+    OCIO_CHECK_NO_THROW(gpu->extractGpuShaderInfo(shaderDesc1));
+    OCIO_REQUIRE_EQUAL(shaderDesc1->getNum3DTextures(), 1U);
+
+    // The shader program and the baked 3D LUT are both cached.
+    const size_t usage1 = OCIO::GetCacheMemoryUsage(OCIO::CACHE_GPU_SHADER_PROGRAM);
+    OCIO_CHECK_ASSERT(usage1 >= 2 * lutSize);
+
+    // Another function name needs another shader program but reuses the baked 3D LUT.
+    OCIO::GpuShaderDescRcPtr shaderDesc2 = OCIO::GpuShaderDesc::CreateLegacyShaderDesc(edgelen);
+    shaderDesc2->setLanguage(OCIO::GPU_LANGUAGE_GLSL_1_3);
+    shaderDesc2->setFunctionName("otherFunction");
+    OCIO_CHECK_NO_THROW(gpu->extractGpuShaderInfo(shaderDesc2));
+    OCIO_REQUIRE_EQUAL(shaderDesc2->getNum3DTextures(), 1U);
+
+    const size_t usage2 = OCIO::GetCacheMemoryUsage(OCIO::CACHE_GPU_SHADER_PROGRAM);
+    OCIO_CHECK_ASSERT(usage2 > usage1);
+    OCIO_CHECK_ASSERT(usage2 - usage1 < 2 * lutSize);
+
+    const float * values1 = nullptr;
+    const float * values2 = nullptr;
+    shaderDesc1->get3DTextureValues(0, values1);
+    shaderDesc2->get3DTextureValues(0, values2);
+    for (size_t idx = 0; idx < size_t(edgelen) * edgelen * edgelen * 3; ++idx)
+    {
+        OCIO_REQUIRE_EQUAL(values1[idx], values2[idx]);
+    }
+
+    OCIO::ClearGpuShaderProgramCache();
+    OCIO_CHECK_EQUAL(OCIO::GetCacheMemoryUsage(OCIO::CACHE_GPU_SHADER_PROGRAM), 0);
+}
+
+OCIO_ADD_TEST(Processor, gpu_shader_lut1d_atlas)
+{
+    OCIO::ConfigRcPtr config = OCIO::Config::Create();
+    config->setMajorVersion(2);
+
+    // Two 1D LUTs (i.e. separated by a matrix to avoid their composition).
+    auto lut1 = OCIO::LUT1DTransform::Create(5, false);
+    lut1->setValue(0, 0.1f, 0.2f, 0.3f);
+    auto lut2 = OCIO::LUT1DTransform::Create(20, false);
+    lut2->setValue(0, 0.4f, 0.5f, 0.6f);
+    auto mat = OCIO::MatrixTransform::Create();
+    double offset[4]{ 0.1, 0.2, 0.3, 0.4 };
+    mat->setOffset(offset);
+
+    auto group = OCIO::GroupTransform::Create();
+    group->appendTransform(lut1);
+    group->appendTransform(mat);
+    group->appendTransform(lut2);
+
+    OCIO::ConstProcessorRcPtr processor;
+    OCIO_CHECK_NO_THROW(processor = config->getProcessor(group));
+    OCIO::ConstGPUProcessorRcPtr gpu = processor->getDefaultGPUProcessor();
+
+    OCIO::GpuShaderDescRcPtr shaderDesc = OCIO::GpuShaderDesc::CreateShaderDesc();
+    shaderDesc->setLanguage(OCIO::GPU_LANGUAGE_GLSL_1_3);
+    shaderDesc->setTextureMaxWidth(8);
+    OCIO_CHECK_NO_THROW(gpu->extractGpuShaderInfo(shaderDesc));
+    OCIO_CHECK_EQUAL(shaderDesc->getNumTextures(), 2U);
+
+    OCIO::GpuShaderDescRcPtr atlasDesc = OCIO::GpuShaderDesc::CreateShaderDesc();
+    atlasDesc->setLanguage(OCIO::GPU_LANGUAGE_GLSL_1_3);
+    atlasDesc->setTextureMaxWidth(8);
+    OCIO_CHECK_ASSERT(!atlasDesc->isLut1DAtlasEnabled());
+    atlasDesc->setLut1DAtlasEnabled(true);
+    OCIO_CHECK_ASSERT(atlasDesc->isLut1DAtlasEnabled());
+    OCIO_CHECK_NO_THROW(gpu->extractGpuShaderInfo(atlasDesc));
+    OCIO_CHECK_NE(std::string(shaderDesc->getCacheID()), std::string(atlasDesc->getCacheID()));
+
+    // The LUTs are packed in a single texture i.e. one row for the first LUT and three
+    // rows (i.e. 20 entries in rows of 8 texels, one being shared) for the second one.
+    OCIO_REQUIRE_EQUAL(atlasDesc->getNumTextures(), 1U);
+
+    const char * name = nullptr;
+    const char * id = nullptr;
+    unsigned width = 0;
+    unsigned height = 0;
+    OCIO::GpuShaderDesc::TextureType channel = OCIO::GpuShaderDesc::TEXTURE_RED_CHANNEL;
+    OCIO::Interpolation interpolation = OCIO::INTERP_UNKNOWN;
+    atlasDesc->getTexture(0, name, id, width, height, channel, interpolation);
+    OCIO_CHECK_EQUAL(std::string(name), "ociolut1d_atlasSampler");
+    OCIO_CHECK_EQUAL(width, 8U);
+    OCIO_CHECK_EQUAL(height, 4U);
+    OCIO_CHECK_EQUAL(channel, OCIO::GpuShaderDesc::TEXTURE_RGB_CHANNEL);
+    OCIO_CHECK_EQUAL(interpolation, OCIO::INTERP_LINEAR);
+
+    const float * values = nullptr;
+    atlasDesc->getTextureValues(0, values);
+    OCIO_CHECK_EQUAL(values[0], 0.1f);
+    OCIO_CHECK_EQUAL(values[8 * 3], 0.4f);
+
+    const std::string text(atlasDesc->getShaderText());
+    OCIO_CHECK_NE(text.find("uniform sampler2D ociolut1d_atlasSampler;"), std::string::npos);
+    OCIO_CHECK_NE(text.find("const float ociolut1d_atlas_height = 4.;"), std::string::npos);
+    OCIO_CHECK_NE(text.find("ociolut1d_atlas_0_computePos"), std::string::npos);
+    OCIO_CHECK_NE(text.find("retVal.y = (retVal.y + 1.5) / ociolut1d_atlas_height;"),
+                  std::string::npos);
+}
+
+namespace
+{
+OCIO::ConstGPUProcessorRcPtr GetUniformBlockProcessor(double m01, double m10)
+{
+    OCIO::ConfigRcPtr config = OCIO::Config::Create();
+    config->setMajorVersion(2);
+
+    auto mat = OCIO::MatrixTransform::Create();
+    const double m44[16]{ 1., m01, 0., 0.,
+                          m10, 1., 0., 0.,
+                          0.,  0., 1., 0.,
+                          0.,  0., 0., 1. };
+    mat->setMatrix(m44);
+    const double offset[4]{ 0.1, 0.2, 0.3, 0. };
+    mat->setOffset(offset);
+
+    auto ec = OCIO::ExposureContrastTransform::Create();
+    ec->setExposure(1.5);
+    ec->makeExposureDynamic();
+
+    auto group = OCIO::GroupTransform::Create();
+    group->appendTransform(mat);
+    group->appendTransform(ec);
+
+    return config->getProcessor(group)->getDefaultGPUProcessor();
+}
+}
+
+OCIO_ADD_TEST(Processor, gpu_shader_uniform_block)
+{
+    OCIO::ConstGPUProcessorRcPtr gpu = GetUniformBlockProcessor(0.1, 0.2);
+
+    OCIO::GpuShaderDescRcPtr shaderDesc = OCIO::GpuShaderDesc::CreateShaderDesc();
+    shaderDesc->setLanguage(OCIO::GPU_LANGUAGE_GLSL_4_0);
+    OCIO_CHECK_ASSERT(!shaderDesc->isUniformBlockEnabled());
+    shaderDesc->setUniformBlockEnabled(true);
+    OCIO_CHECK_ASSERT(shaderDesc->isUniformBlockEnabled());
+    OCIO_CHECK_NO_THROW(gpu->extractGpuShaderInfo(shaderDesc));
+
+    // The dynamic property is not a standalone uniform.
+    OCIO_CHECK_EQUAL(shaderDesc->getNumUniforms(), 0U);
+
+    // The matrix, its offsets and the exposure & contrast values are in the block.
+    OCIO_REQUIRE_EQUAL(shaderDesc->getNumUniformBlockMembers(), 5U);
+    OCIO_CHECK_EQUAL(shaderDesc->getUniformBlockSize(), 96U);
+
+    const char * name = nullptr;
+    OCIO::GpuShaderDesc::UniformType type = OCIO::GpuShaderDesc::UNIFORM_FLOAT;
+    unsigned offset = 0;
+    OCIO::DynamicPropertyRcPtr value;
+
+    shaderDesc->getUniformBlockMember(0, name, type, offset, value);
+    OCIO_CHECK_EQUAL(std::string(name), "ociomatrix_0");
+    OCIO_CHECK_EQUAL(type, OCIO::GpuShaderDesc::UNIFORM_MAT4);
+    OCIO_CHECK_EQUAL(offset, 0U);
+    OCIO_CHECK_ASSERT(!value);
+
+    shaderDesc->getUniformBlockMember(1, name, type, offset, value);
+    OCIO_CHECK_EQUAL(std::string(name), "ociooffset_1");
+    OCIO_CHECK_EQUAL(type, OCIO::GpuShaderDesc::UNIFORM_VEC4);
+    OCIO_CHECK_EQUAL(offset, 64U);
+
+    shaderDesc->getUniformBlockMember(2, name, type, offset, value);
+    OCIO_CHECK_EQUAL(std::string(name), "ocioexposureVal");
+    OCIO_CHECK_EQUAL(type, OCIO::GpuShaderDesc::UNIFORM_FLOAT);
+    OCIO_CHECK_EQUAL(offset, 80U);
+    OCIO_REQUIRE_ASSERT(value);
+
+    std::vector<float> buffer(shaderDesc->getUniformBlockSize() / sizeof(float), -1.f);
+    OCIO_CHECK_NO_THROW(shaderDesc->fillUniformBlock(buffer.data()));
+    // The matrix is column-major.
+    OCIO_CHECK_EQUAL(buffer[1], 0.2f);
+    OCIO_CHECK_EQUAL(buffer[4], 0.1f);
+    OCIO_CHECK_EQUAL(buffer[16], 0.1f);
+    OCIO_CHECK_EQUAL(buffer[20], 1.5f);
+    // The padding is cleared.
+    OCIO_CHECK_EQUAL(buffer[23], 0.f);
+
+    // The dynamic property values are read when filling the block.
+    value->setValue(2.);
+    OCIO_CHECK_NO_THROW(shaderDesc->fillUniformBlock(buffer.data()));
+    OCIO_CHECK_EQUAL(buffer[20], 2.f);
+
+    const std::string text(shaderDesc->getShaderText());
+    OCIO_CHECK_NE(text.find("layout(std140) uniform ocioUniformBlock"), std::string::npos);
+    OCIO_CHECK_NE(text.find("mat4 ociomatrix_0;"), std::string::npos);
+    OCIO_CHECK_NE(text.find("outColor = ociomatrix_0 * outColor + ociooffset_1;"),
+                  std::string::npos);
+
+    // Another grade shares the same shader program, only the block values differ.
+    OCIO::ConstGPUProcessorRcPtr gpu2 = GetUniformBlockProcessor(0.3, 0.4);
+
+    OCIO::GpuShaderDescRcPtr shaderDesc2 = OCIO::GpuShaderDesc::CreateShaderDesc();
+    shaderDesc2->setLanguage(OCIO::GPU_LANGUAGE_GLSL_4_0);
+    shaderDesc2->setUniformBlockEnabled(true);
+    OCIO_CHECK_NO_THROW(gpu2->extractGpuShaderInfo(shaderDesc2));
+    OCIO_CHECK_EQUAL(text, std::string(shaderDesc2->getShaderText()));
+    OCIO_CHECK_EQUAL(std::string(shaderDesc->getCacheID()),
+                     std::string(shaderDesc2->getCacheID()));
+
+    OCIO_CHECK_NO_THROW(shaderDesc2->fillUniformBlock(buffer.data()));
+    OCIO_CHECK_EQUAL(buffer[1], 0.4f);
+    OCIO_CHECK_EQUAL(buffer[4], 0.3f);
+
+    // Uniform blocks are not available in GLSL 1.x.
+    OCIO::GpuShaderDescRcPtr shaderDesc3 = OCIO::GpuShaderDesc::CreateShaderDesc();
+    shaderDesc3->setLanguage(OCIO::GPU_LANGUAGE_GLSL_1_3);
+    shaderDesc3->setUniformBlockEnabled(true);
+    OCIO_CHECK_THROW_WHAT(gpu->extractGpuShaderInfo(shaderDesc3), OCIO::Exception,
+                          "The uniform block is not supported by the GPU language");
+}
+
+OCIO_ADD_TEST(Processor, gpu_shader_live_dynamic_properties)
+{
+    OCIO::ConfigRcPtr config = OCIO::Config::Create();
+    config->setMajorVersion(2);
+
+    auto ec = OCIO::ExposureContrastTransform::Create();
+    ec->makeExposureDynamic();
+    ec->makeContrastDynamic();
+
+    OCIO::ConstGPUProcessorRcPtr gpu = config->getProcessor(ec)->getDefaultGPUProcessor();
+
+    // By default, the dynamic properties are uniforms.
+    OCIO::GpuShaderDescRcPtr liveDesc = OCIO::GpuShaderDesc::CreateShaderDesc();
+    liveDesc->setLanguage(OCIO::GPU_LANGUAGE_GLSL_4_0);
+    OCIO_CHECK_NO_THROW(gpu->extractGpuShaderInfo(liveDesc));
+    OCIO_CHECK_EQUAL(liveDesc->getNumUniforms(), 2U);
+
+    // Only the exposure stays live.
+    OCIO::GpuShaderDescRcPtr frozenDesc = OCIO::GpuShaderDesc::CreateShaderDesc();
+    frozenDesc->setLanguage(OCIO::GPU_LANGUAGE_GLSL_4_0);
+    OCIO_CHECK_ASSERT(frozenDesc->isDynamicPropertyLive(OCIO::DYNAMIC_PROPERTY_CONTRAST));
+    frozenDesc->setDynamicPropertyLive(OCIO::DYNAMIC_PROPERTY_CONTRAST, false);
+    OCIO_CHECK_ASSERT(!frozenDesc->isDynamicPropertyLive(OCIO::DYNAMIC_PROPERTY_CONTRAST));
+    OCIO_CHECK_ASSERT(frozenDesc->isDynamicPropertyLive(OCIO::DYNAMIC_PROPERTY_EXPOSURE));
+    OCIO_CHECK_NE(std::string(liveDesc->getCacheID()), std::string(frozenDesc->getCacheID()));
+    OCIO_CHECK_NO_THROW(gpu->extractGpuShaderInfo(frozenDesc));
+    OCIO_REQUIRE_EQUAL(frozenDesc->getNumUniforms(), 1U);
+
+    const char * name = nullptr;
+    OCIO::DynamicPropertyRcPtr value;
+    frozenDesc->getUniform(0, name, value);
+    OCIO_CHECK_EQUAL(std::string(name), "ocioexposureVal");
+
+    // The processor property is still dynamic.
+    OCIO::DynamicPropertyRcPtr contrast;
+    OCIO_CHECK_NO_THROW(contrast = gpu->getDynamicProperty(OCIO::DYNAMIC_PROPERTY_CONTRAST));
+    OCIO_CHECK_ASSERT(contrast->isDynamic());
+
+    // Without any live property, the identity op is removed.
+    OCIO::GpuShaderDescRcPtr emptyDesc = OCIO::GpuShaderDesc::CreateShaderDesc();
+    emptyDesc->setLanguage(OCIO::GPU_LANGUAGE_GLSL_4_0);
+    emptyDesc->setDynamicPropertyLive(OCIO::DYNAMIC_PROPERTY_EXPOSURE, false);
+    emptyDesc->setDynamicPropertyLive(OCIO::DYNAMIC_PROPERTY_CONTRAST, false);
+    OCIO_CHECK_NO_THROW(gpu->extractGpuShaderInfo(emptyDesc));
+    OCIO_CHECK_EQUAL(emptyDesc->getNumUniforms(), 0U);
+    OCIO_CHECK_EQUAL(std::string(emptyDesc->getShaderText()).find("exposure"),
+                     std::string::npos);
+
+    // Otherwise the current values are constants.
+    contrast->setValue(1.2);
+    emptyDesc = OCIO::GpuShaderDesc::CreateShaderDesc();
+    emptyDesc->setLanguage(OCIO::GPU_LANGUAGE_GLSL_4_0);
+    emptyDesc->setDynamicPropertyLive(OCIO::DYNAMIC_PROPERTY_EXPOSURE, false);
+    emptyDesc->setDynamicPropertyLive(OCIO::DYNAMIC_PROPERTY_CONTRAST, false);
+    OCIO_CHECK_NO_THROW(gpu->extractGpuShaderInfo(emptyDesc));
+    OCIO_CHECK_EQUAL(emptyDesc->getNumUniforms(), 0U);
+    OCIO_CHECK_NE(std::string(emptyDesc->getShaderText()).find("contrastVal = 1.2"),
+                  std::string::npos);
+}
+
+OCIO_ADD_TEST(Processor, gpu_shader_compute_kernel)
+{
+    OCIO::ConstGPUProcessorRcPtr gpu = GetUniformBlockProcessor(0.1, 0.2);
+
+    OCIO::GpuShaderDescRcPtr shaderDesc = OCIO::GpuShaderDesc::CreateShaderDesc();
+    shaderDesc->setLanguage(OCIO::GPU_LANGUAGE_GLSL_4_0);
+    OCIO_CHECK_ASSERT(!shaderDesc->isComputeKernelEnabled());
+    shaderDesc->setComputeKernelEnabled(true);
+    OCIO_CHECK_ASSERT(shaderDesc->isComputeKernelEnabled());
+    OCIO_CHECK_NO_THROW(gpu->extractGpuShaderInfo(shaderDesc));
+
+    std::string text(shaderDesc->getShaderText());
+    OCIO_CHECK_NE(text.find("layout(local_size_x = 16, local_size_y = 16) in;"),
+                  std::string::npos);
+    OCIO_CHECK_NE(text.find("readonly buffer ocioInBuffer { vec4 ocioInPixels[]; };"),
+                  std::string::npos);
+    OCIO_CHECK_NE(text.find("uniform uint ocioImageWidth;"), std::string::npos);
+    OCIO_CHECK_NE(text.find("ocioOutPixels[idx] = OCIOMain(ocioInPixels[idx]);"),
+                  std::string::npos);
+
+    shaderDesc = OCIO::GpuShaderDesc::CreateShaderDesc();
+    shaderDesc->setLanguage(OCIO::GPU_LANGUAGE_HLSL_DX11);
+    shaderDesc->setComputeKernelEnabled(true);
+    OCIO_CHECK_NO_THROW(gpu->extractGpuShaderInfo(shaderDesc));
+
+    text = shaderDesc->getShaderText();
+    OCIO_CHECK_NE(text.find("RWStructuredBuffer<float4> ocioOutPixels;"), std::string::npos);
+    OCIO_CHECK_NE(text.find("[numthreads(16, 16, 1)]"), std::string::npos);
+    OCIO_CHECK_NE(text.find("void OCIOMainKernel(uint3 id : SV_DispatchThreadID)"),
+                  std::string::npos);
+
+    // The work groups cover the whole image.
+    unsigned numGroupsX = 0;
+    unsigned numGroupsY = 0;
+    OCIO::GpuShaderDesc::GetComputeNumWorkGroups(100, 33, numGroupsX, numGroupsY);
+    OCIO_CHECK_EQUAL(numGroupsX, 7U);
+    OCIO_CHECK_EQUAL(numGroupsY, 3U);
+
+    // Compute shaders are not available in GLSL 1.x.
+    shaderDesc = OCIO::GpuShaderDesc::CreateShaderDesc();
+    shaderDesc->setLanguage(OCIO::GPU_LANGUAGE_GLSL_1_3);
+    shaderDesc->setComputeKernelEnabled(true);
+    OCIO_CHECK_THROW_WHAT(gpu->extractGpuShaderInfo(shaderDesc), OCIO::Exception,
+                          "The compute kernel is not supported by the GPU language");
+}
+
+OCIO_ADD_TEST(Processor, gpu_shader_budget)
+{
+    OCIO::ConfigRcPtr config = OCIO::Config::Create();
+    config->setMajorVersion(2);
+
+    auto log = OCIO::LogTransform::Create();
+    log->setBase(10.0);
+
+    auto exp = OCIO::ExponentTransform::Create();
+    const double gamma[4]{ 2.2, 2.2, 2.2, 1. };
+    exp->setValue(gamma);
+
+    auto ec = OCIO::ExposureContrastTransform::Create();
+    ec->setExposure(1.5);
+    ec->makeExposureDynamic();
+
+    auto group = OCIO::GroupTransform::Create();
+    group->appendTransform(log);
+    group->appendTransform(exp);
+    group->appendTransform(ec);
+
+    OCIO::ConstGPUProcessorRcPtr gpu
+        = config->getProcessor(group)->getDefaultGPUProcessor();
+
+    // Without budget, all the ops are analytic.
+    OCIO::GpuShaderDescRcPtr shaderDesc = OCIO::GpuShaderDesc::CreateShaderDesc();
+    shaderDesc->setLanguage(OCIO::GPU_LANGUAGE_GLSL_1_3);
+    OCIO_CHECK_EQUAL(shaderDesc->getMaxAluCost(), 0U);
+    OCIO_CHECK_EQUAL(shaderDesc->getMaxNumTextures(), 0U);
+    OCIO_CHECK_EQUAL(shaderDesc->getMaxTextureMemory(), 0U);
+    OCIO_CHECK_EQUAL(shaderDesc->getBudgetLut3DEdgelen(), 32U);
+    OCIO_CHECK_NO_THROW(gpu->extractGpuShaderInfo(shaderDesc));
+    OCIO_CHECK_EQUAL(shaderDesc->getNum3DTextures(), 0U);
+    OCIO_CHECK_EQUAL(shaderDesc->getNumUniforms(), 1U);
+
+    // A low ALU budget bakes the static ops into a 3D LUT.
+    OCIO::GpuShaderDescRcPtr budgetDesc = OCIO::GpuShaderDesc::CreateShaderDesc();
+    budgetDesc->setLanguage(OCIO::GPU_LANGUAGE_GLSL_1_3);
+    budgetDesc->setGpuBudget(1, 0, 0);
+    OCIO_CHECK_THROW_WHAT(budgetDesc->setBudgetLut3DEdgelen(1), OCIO::Exception,
+                          "Invalid budget 3D LUT edge length 1");
+    OCIO_CHECK_NO_THROW(budgetDesc->setBudgetLut3DEdgelen(17));
+    OCIO_CHECK_NE(std::string(shaderDesc->getCacheID()),
+                  std::string(budgetDesc->getCacheID()));
+    OCIO_CHECK_NO_THROW(gpu->extractGpuShaderInfo(budgetDesc));
+
+    OCIO_REQUIRE_EQUAL(budgetDesc->getNum3DTextures(), 1U);
+    const char * name = nullptr;
+    const char * id = nullptr;
+    unsigned edgelen = 0;
+    OCIO::Interpolation interpolation = OCIO::INTERP_UNKNOWN;
+    budgetDesc->get3DTexture(0, name, id, edgelen, interpolation);
+    OCIO_CHECK_EQUAL(edgelen, 17U);
+
+    // The dynamic property is never baked.
+    OCIO_CHECK_EQUAL(budgetDesc->getNumUniforms(), 1U);
+
+    // A large enough budget keeps all the ops analytic.
+    OCIO::GpuShaderDescRcPtr largeDesc = OCIO::GpuShaderDesc::CreateShaderDesc();
+    largeDesc->setLanguage(OCIO::GPU_LANGUAGE_GLSL_1_3);
+    largeDesc->setGpuBudget(1000, 4, 1024 * 1024);
+    OCIO_CHECK_NO_THROW(gpu->extractGpuShaderInfo(largeDesc));
+    OCIO_CHECK_EQUAL(largeDesc->getNum3DTextures(), 0U);
+    OCIO_CHECK_EQUAL(std::string(shaderDesc->getShaderText()),
+                     std::string(largeDesc->getShaderText()));
+}
+
+OCIO_ADD_TEST(Processor, gpu_shader_half_precision)
+{
+    OCIO::ConfigRcPtr config = OCIO::Config::Create();
+    config->setMajorVersion(2);
+
+    auto log = OCIO::LogTransform::Create();
+    log->setBase(10.0);
+
+    auto lut = OCIO::LUT3DTransform::Create(3);
+    lut->setValue(1, 1, 1, 0.4f, 0.5f, 0.6f);
+    lut->setInterpolation(OCIO::INTERP_TETRAHEDRAL);
+
+    // The matrix scales the alpha so it is not folded into the 3D LUT.
+    auto mat = OCIO::MatrixTransform::Create();
+    const double m44[16]{ 0.9, 0.1, 0.,  0.,
+                          0.,  0.8, 0.2, 0.,
+                          0.1, 0.,  0.9, 0.,
+                          0.,  0.,  0.,  0.5 };
+    mat->setMatrix(m44);
+
+    auto group = OCIO::GroupTransform::Create();
+    group->appendTransform(log);
+    group->appendTransform(lut);
+    group->appendTransform(mat);
+
+    // Keep the log analytic.
+    OCIO::ConstGPUProcessorRcPtr gpu
+        = config->getProcessor(group)->getOptimizedGPUProcessor(OCIO::OPTIMIZATION_NONE,
+                                                                OCIO::FINALIZATION_DEFAULT);
+
+    OCIO::GpuShaderDescRcPtr fullDesc = OCIO::GpuShaderDesc::CreateShaderDesc();
+    fullDesc->setLanguage(OCIO::GPU_LANGUAGE_MSL_2_0);
+    OCIO_CHECK_NO_THROW(gpu->extractGpuShaderInfo(fullDesc));
+    const std::string fullText(fullDesc->getShaderText());
+    OCIO_CHECK_EQUAL(fullText.find("half"), std::string::npos);
+
+    OCIO::GpuShaderDescRcPtr halfDesc = OCIO::GpuShaderDesc::CreateShaderDesc();
+    halfDesc->setLanguage(OCIO::GPU_LANGUAGE_MSL_2_0);
+    OCIO_CHECK_ASSERT(!halfDesc->isHalfPrecisionEnabled());
+    halfDesc->setHalfPrecisionEnabled(true);
+    OCIO_CHECK_ASSERT(halfDesc->isHalfPrecisionEnabled());
+    OCIO_CHECK_NE(std::string(fullDesc->getCacheID()), std::string(halfDesc->getCacheID()));
+    OCIO_CHECK_NO_THROW(gpu->extractGpuShaderInfo(halfDesc));
+
+    const std::string halfText(halfDesc->getShaderText());
+
+    // The 3D LUT samples are blended in half precision.
+    OCIO_CHECK_NE(halfText.find("half3 v1 = half3("), std::string::npos);
+    OCIO_CHECK_NE(halfText.find("outColor.rgb = outColor.rgb + float3((f1 * v1) + (f4 * v4));"),
+                  std::string::npos);
+
+    // The matrix on the display-referred values is in half precision.
+    OCIO_CHECK_NE(halfText.find("half4 outColor_h = half4(outColor);"), std::string::npos);
+    OCIO_CHECK_NE(halfText.find("outColor = float4(outColor_h);"), std::string::npos);
+
+    // The log stays in full precision, and is the same as without half precision.
+    const std::string logCode("// Add Log processing");
+    const size_t fullLog = fullText.find(logCode);
+    const size_t halfLog = halfText.find(logCode);
+    OCIO_REQUIRE_ASSERT(fullLog != std::string::npos && halfLog != std::string::npos);
+    OCIO_CHECK_EQUAL(fullText.substr(fullLog, fullText.find("// Add a LUT 3D") - fullLog),
+                     halfText.substr(halfLog, halfText.find("// Add a LUT 3D") - halfLog));
+
+    // A GLSL ES shader only qualifies the declarations.
+    OCIO::GpuShaderDescRcPtr glslDesc = OCIO::GpuShaderDesc::CreateShaderDesc();
+    glslDesc->setLanguage(OCIO::GPU_LANGUAGE_GLSL_ES_3_0);
+    glslDesc->setHalfPrecisionEnabled(true);
+    OCIO_CHECK_NO_THROW(gpu->extractGpuShaderInfo(glslDesc));
+    OCIO_CHECK_NE(std::string(glslDesc->getShaderText()).find("mediump vec4 outColor_h = outColor;"),
+                  std::string::npos);
+}
+
+OCIO_ADD_TEST(Processor, gpu_shader_concatenate)
+{
+    OCIO::ConfigRcPtr config = OCIO::Config::Create();
+    config->setMajorVersion(2);
+
+    // The input processing i.e. a LUT followed by a conversion to a log working space.
+    auto lut1 = OCIO::LUT1DTransform::Create(5, false);
+    lut1->setValue(0, 0.1f, 0.2f, 0.3f);
+    auto log = OCIO::LogTransform::Create();
+    log->setBase(10.0);
+    auto input = OCIO::GroupTransform::Create();
+    input->appendTransform(lut1);
+    input->appendTransform(log);
+
+    // The display processing i.e. a conversion from the log working space followed by
+    // a matrix.
+    auto invLog = OCIO::LogTransform::Create();
+    invLog->setBase(10.0);
+    invLog->setDirection(OCIO::TRANSFORM_DIR_INVERSE);
+    auto mat = OCIO::MatrixTransform::Create();
+    const double m44[16]{ 0.9, 0.1, 0.,  0.,
+                          0.,  0.8, 0.2, 0.,
+                          0.1, 0.,  0.9, 0.,
+                          0.,  0.,  0.,  1. };
+    mat->setMatrix(m44);
+    auto display = OCIO::GroupTransform::Create();
+    display->appendTransform(invLog);
+    display->appendTransform(mat);
+
+    // The output processing.
+    auto lut2 = OCIO::LUT1DTransform::Create(20, false);
+    lut2->setValue(0, 0.4f, 0.5f, 0.6f);
+
+    const OCIO::ConstGPUProcessorRcPtr gpus[3]{
+        config->getProcessor(input)->getOptimizedGPUProcessor(OCIO::OPTIMIZATION_NONE,
+                                                              OCIO::FINALIZATION_DEFAULT),
+        config->getProcessor(display)->getOptimizedGPUProcessor(OCIO::OPTIMIZATION_NONE,
+                                                                OCIO::FINALIZATION_DEFAULT),
+        config->getProcessor(lut2)->getOptimizedGPUProcessor(OCIO::OPTIMIZATION_NONE,
+                                                             OCIO::FINALIZATION_DEFAULT) };
+
+    OCIO::ConstGPUProcessorRcPtr gpu;
+    OCIO_CHECK_NO_THROW(gpu = OCIO::GPUProcessor::Concatenate(gpus, 3,
+                                                              OCIO::OPTIMIZATION_NONE,
+                                                              OCIO::FINALIZATION_DEFAULT));
+    OCIO_REQUIRE_ASSERT(gpu);
+
+    OCIO::GpuShaderDescRcPtr shaderDesc = OCIO::GpuShaderDesc::CreateShaderDesc();
+    shaderDesc->setLanguage(OCIO::GPU_LANGUAGE_GLSL_1_3);
+    OCIO_CHECK_NO_THROW(gpu->extractGpuShaderInfo(shaderDesc));
+
+    // The log & its inverse cancel out across the processor boundary.
+    const std::string text(shaderDesc->getShaderText());
+    OCIO_CHECK_EQUAL(text.find("Log processing"), std::string::npos);
+    OCIO_CHECK_NE(text.find("// Add a Matrix processing"), std::string::npos);
+
+    // The LUT textures of the different processors do not collide.
+    OCIO_REQUIRE_EQUAL(shaderDesc->getNumTextures(), 2U);
+
+    const char * name0 = nullptr;
+    const char * name1 = nullptr;
+    const char * id = nullptr;
+    unsigned width = 0;
+    unsigned height = 0;
+    OCIO::GpuShaderDesc::TextureType channel = OCIO::GpuShaderDesc::TEXTURE_RED_CHANNEL;
+    OCIO::Interpolation interpolation = OCIO::INTERP_UNKNOWN;
+    shaderDesc->getTexture(0, name0, id, width, height, channel, interpolation);
+    OCIO_CHECK_EQUAL(width, 5U);
+    shaderDesc->getTexture(1, name1, id, width, height, channel, interpolation);
+    OCIO_CHECK_EQUAL(width, 20U);
+    OCIO_CHECK_NE(std::string(name0), std::string(name1));
+
+    // Only one function is emitted.
+    const std::string fcn(std::string(shaderDesc->getFunctionName()) + "(");
+    const size_t pos = text.find(fcn);
+    OCIO_REQUIRE_ASSERT(pos != std::string::npos);
+    OCIO_CHECK_EQUAL(text.find(fcn, pos + 1), std::string::npos);
+
+    OCIO_CHECK_THROW_WHAT(OCIO::GPUProcessor::Concatenate(gpus, 0,
+                                                          OCIO::OPTIMIZATION_NONE,
+                                                          OCIO::FINALIZATION_DEFAULT),
+                          OCIO::Exception, "empty list of GPU processors");
+
+    const OCIO::ConstGPUProcessorRcPtr nullGpus[2]{ gpus[0], nullptr };
+    OCIO_CHECK_THROW_WHAT(OCIO::GPUProcessor::Concatenate(nullGpus, 2,
+                                                          OCIO::OPTIMIZATION_NONE,
+                                                          OCIO::FINALIZATION_DEFAULT),
+                          OCIO::Exception, "null GPU processor");
+}
+
+OCIO_ADD_TEST(Processor, gpu_shader_lut1d_inverse_search)
+{
+    OCIO::ConfigRcPtr config = OCIO::Config::Create();
+    config->setMajorVersion(2);
+
+    auto lut = OCIO::LUT1DTransform::Create(32, false);
+    for (unsigned long idx = 0; idx < 32; ++idx)
+    {
+        const float val = float(idx * idx) / (31.f * 31.f);
+        lut->setValue(idx, val, val, 1.f - val);
+    }
+    lut->setDirection(OCIO::TRANSFORM_DIR_INVERSE);
+
+    OCIO::ConstGPUProcessorRcPtr gpu = config->getProcessor(lut)->getDefaultGPUProcessor();
+
+    // By default, the inverse is baked in a forward LUT.
+    OCIO::GpuShaderDescRcPtr fastDesc = OCIO::GpuShaderDesc::CreateShaderDesc();
+    fastDesc->setLanguage(OCIO::GPU_LANGUAGE_GLSL_1_3);
+    OCIO_CHECK_NO_THROW(gpu->extractGpuShaderInfo(fastDesc));
+    OCIO_REQUIRE_EQUAL(fastDesc->getNumTextures(), 1U);
+    OCIO_CHECK_EQUAL(std::string(fastDesc->getShaderText()).find("inverse LUT 1D"),
+                     std::string::npos);
+
+    OCIO::GpuShaderDescRcPtr searchDesc = OCIO::GpuShaderDesc::CreateShaderDesc();
+    searchDesc->setLanguage(OCIO::GPU_LANGUAGE_GLSL_1_3);
+    OCIO_CHECK_ASSERT(!searchDesc->isLut1DInverseSearchEnabled());
+    searchDesc->setLut1DInverseSearchEnabled(true);
+    OCIO_CHECK_ASSERT(searchDesc->isLut1DInverseSearchEnabled());
+    OCIO_CHECK_NE(std::string(fastDesc->getCacheID()), std::string(searchDesc->getCacheID()));
+    OCIO_CHECK_NO_THROW(gpu->extractGpuShaderInfo(searchDesc));
+
+    // The search uses the forward LUT values as is.
+    OCIO_REQUIRE_EQUAL(searchDesc->getNumTextures(), 1U);
+
+    const char * name = nullptr;
+    const char * id = nullptr;
+    unsigned width = 0;
+    unsigned height = 0;
+    OCIO::GpuShaderDesc::TextureType channel = OCIO::GpuShaderDesc::TEXTURE_RED_CHANNEL;
+    OCIO::Interpolation interpolation = OCIO::INTERP_UNKNOWN;
+    searchDesc->getTexture(0, name, id, width, height, channel, interpolation);
+    OCIO_CHECK_EQUAL(width, 32U);
+    OCIO_CHECK_EQUAL(height, 1U);
+    OCIO_CHECK_EQUAL(interpolation, OCIO::INTERP_NEAREST);
+
+    const std::string text(searchDesc->getShaderText());
+    OCIO_CHECK_NE(text.find("// Add an inverse LUT 1D processing"), std::string::npos);
+
+    // A LUT too large for a single texture row falls back to the baked inverse.
+    OCIO::GpuShaderDescRcPtr smallDesc = OCIO::GpuShaderDesc::CreateShaderDesc();
+    smallDesc->setLanguage(OCIO::GPU_LANGUAGE_GLSL_1_3);
+    smallDesc->setLut1DInverseSearchEnabled(true);
+    smallDesc->setTextureMaxWidth(16);
+    OCIO_CHECK_NO_THROW(gpu->extractGpuShaderInfo(smallDesc));
+    OCIO_CHECK_EQUAL(std::string(smallDesc->getShaderText()).find("inverse LUT 1D"),
+                     std::string::npos);
+}
+
+OCIO_ADD_TEST(Processor, lut1d_native_textures)
+{
+    OCIO::ConfigRcPtr config = OCIO::Config::Create();
+    config->setMajorVersion(2);
+
+    const char * name = nullptr;
+    const char * id = nullptr;
+    unsigned width = 0;
+    unsigned height = 0;
+    OCIO::GpuShaderDesc::TextureType channel = OCIO::GpuShaderDesc::TEXTURE_RED_CHANNEL;
+    OCIO::Interpolation interpolation = OCIO::INTERP_UNKNOWN;
+
+    // A LUT longer than the texture maximum width.
+    auto lut = OCIO::LUT1DTransform::Create(64, false);
+    for (unsigned long idx = 0; idx < 64; ++idx)
+    {
+        const float val = float(idx) / 63.f;
+        lut->setValue(idx, val, val * val, 1.f - val);
+    }
+
+    OCIO::ConstGPUProcessorRcPtr gpu = config->getProcessor(lut)->getDefaultGPUProcessor();
+
+    // By default, the LUT is folded in a 2D texture.
+    OCIO::GpuShaderDescRcPtr foldedDesc = OCIO::GpuShaderDesc::CreateShaderDesc();
+    foldedDesc->setLanguage(OCIO::GPU_LANGUAGE_GLSL_1_3);
+    foldedDesc->setTextureMaxWidth(16);
+    OCIO_CHECK_NO_THROW(gpu->extractGpuShaderInfo(foldedDesc));
+    OCIO_REQUIRE_EQUAL(foldedDesc->getNumTextures(), 1U);
+    foldedDesc->getTexture(0, name, id, width, height, channel, interpolation);
+    OCIO_CHECK_EQUAL(width, 16U);
+    OCIO_CHECK_EQUAL(height, 5U);
+    OCIO_CHECK_NE(std::string(foldedDesc->getShaderText()).find("_computePos"),
+                  std::string::npos);
+
+    OCIO::GpuShaderDescRcPtr nativeDesc = OCIO::GpuShaderDesc::CreateShaderDesc();
+    nativeDesc->setLanguage(OCIO::GPU_LANGUAGE_GLSL_1_3);
+    OCIO_CHECK_ASSERT(!nativeDesc->isLut1DNativeTexturesEnabled());
+    nativeDesc->setLut1DNativeTexturesEnabled(true);
+    OCIO_CHECK_ASSERT(nativeDesc->isLut1DNativeTexturesEnabled());
+    // The single-row texture still has to fit in the texture maximum width.
+    nativeDesc->setTextureMaxWidth(64);
+    // The native textures are never packed in the atlas.
+    nativeDesc->setLut1DAtlasEnabled(true);
+    OCIO_CHECK_NE(std::string(foldedDesc->getCacheID()), std::string(nativeDesc->getCacheID()));
+    OCIO_CHECK_NO_THROW(gpu->extractGpuShaderInfo(nativeDesc));
+    OCIO_REQUIRE_EQUAL(nativeDesc->getNumTextures(), 1U);
+    nativeDesc->getTexture(0, name, id, width, height, channel, interpolation);
+    OCIO_CHECK_EQUAL(width, 64U);
+    OCIO_CHECK_EQUAL(height, 1U);
+
+    std::string text(nativeDesc->getShaderText());
+    OCIO_CHECK_EQUAL(text.find("_computePos"), std::string::npos);
+    OCIO_CHECK_NE(text.find("sampler1D"), std::string::npos);
+    OCIO_CHECK_EQUAL(text.find("sampler2D"), std::string::npos);
+
+    // A half-domain LUT only needs the raw half index.
+    auto halfLut = OCIO::LUT1DTransform::Create(65536, true);
+    // Not an identity (i.e. the entry of the half 1.0).
+    halfLut->setValue(15360, 0.9f, 0.9f, 0.9f);
+    gpu = config->getProcessor(halfLut)->getDefaultGPUProcessor();
+
+    nativeDesc = OCIO::GpuShaderDesc::CreateShaderDesc();
+    nativeDesc->setLanguage(OCIO::GPU_LANGUAGE_GLSL_1_3);
+    nativeDesc->setLut1DNativeTexturesEnabled(true);
+    nativeDesc->setTextureMaxWidth(65536);
+    OCIO_CHECK_NO_THROW(gpu->extractGpuShaderInfo(nativeDesc));
+    OCIO_REQUIRE_EQUAL(nativeDesc->getNumTextures(), 1U);
+    nativeDesc->getTexture(0, name, id, width, height, channel, interpolation);
+    OCIO_CHECK_EQUAL(width, 65536U);
+    OCIO_CHECK_EQUAL(height, 1U);
+
+    text = nativeDesc->getShaderText();
+    OCIO_CHECK_NE(text.find("float ociolut1d_0_computePos(float f)"), std::string::npos);
+    OCIO_CHECK_NE(text.find("return (dep + 0.5) / 65536"), std::string::npos);
+    OCIO_CHECK_EQUAL(text.find("retVal"), std::string::npos);
+    OCIO_CHECK_EQUAL(text.find("sampler2D"), std::string::npos);
+}
+
+OCIO_ADD_TEST(Processor, lut3d_hardware_trilinear)
+{
+    OCIO::ConfigRcPtr config = OCIO::Config::Create();
+    config->setMajorVersion(2);
+
+    auto lut = OCIO::LUT3DTransform::Create(4);
+    lut->setInterpolation(OCIO::INTERP_TETRAHEDRAL);
+    lut->setValue(3, 3, 3, 0.5f, 0.6f, 0.7f);
+
+    OCIO::ConstGPUProcessorRcPtr gpu = config->getProcessor(lut)->getDefaultGPUProcessor();
+
+    const char * name = nullptr;
+    const char * id = nullptr;
+    unsigned edgelen = 0;
+    OCIO::Interpolation interpolation = OCIO::INTERP_UNKNOWN;
+    const float * values = nullptr;
+
+    // By default, the tetrahedral interpolation is computed in the shader code.
+    OCIO::GpuShaderDescRcPtr tetraDesc = OCIO::GpuShaderDesc::CreateShaderDesc();
+    tetraDesc->setLanguage(OCIO::GPU_LANGUAGE_GLSL_1_3);
+    OCIO_CHECK_NO_THROW(gpu->extractGpuShaderInfo(tetraDesc));
+    OCIO_REQUIRE_EQUAL(tetraDesc->getNum3DTextures(), 1U);
+    tetraDesc->get3DTexture(0, name, id, edgelen, interpolation);
+    OCIO_CHECK_EQUAL(interpolation, OCIO::INTERP_TETRAHEDRAL);
+    OCIO_CHECK_NE(std::string(tetraDesc->getShaderText()).find("frac.r >= frac.g"),
+                  std::string::npos);
+
+    // The difference comes from the modified corner.
+    tetraDesc->get3DTextureValues(0, values);
+    const double error = OCIO::GpuShaderDesc::GetLut3DTrilinearError(edgelen, values);
+    OCIO_CHECK_ASSERT(error > 0.01);
+    OCIO_CHECK_ASSERT(error < 0.3);
+
+    OCIO::GpuShaderDescRcPtr trilinearDesc = OCIO::GpuShaderDesc::CreateShaderDesc();
+    trilinearDesc->setLanguage(OCIO::GPU_LANGUAGE_GLSL_1_3);
+    OCIO_CHECK_ASSERT(!trilinearDesc->isLut3DHardwareTrilinearEnabled());
+    trilinearDesc->setLut3DHardwareTrilinearEnabled(true);
+    OCIO_CHECK_ASSERT(trilinearDesc->isLut3DHardwareTrilinearEnabled());
+    OCIO_CHECK_NE(std::string(tetraDesc->getCacheID()), std::string(trilinearDesc->getCacheID()));
+    OCIO_CHECK_NO_THROW(gpu->extractGpuShaderInfo(trilinearDesc));
+    OCIO_REQUIRE_EQUAL(trilinearDesc->getNum3DTextures(), 1U);
+    trilinearDesc->get3DTexture(0, name, id, edgelen, interpolation);
+    OCIO_CHECK_EQUAL(interpolation, OCIO::INTERP_LINEAR);
+
+    const std::string text(trilinearDesc->getShaderText());
+    OCIO_CHECK_EQUAL(text.find("frac.r >= frac.g"), std::string::npos);
+    OCIO_CHECK_NE(text.find("ociolut3d_0_coords"), std::string::npos);
+}
+
 namespace
 {
 void GetFormatName(const std::string & extension, std::string & name)
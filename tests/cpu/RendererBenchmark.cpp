@@ -0,0 +1,641 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the OpenColorIO Project.
+
+
+// The benchmark of the CPU renderers (i.e. the OpCPU classes) processing synthetic
+// buffers of several sizes and bit-depths. It reports the number of pixels processed
+// per second, to compare the SIMD or fused implementations with the generic ones.
+//
+//   bench_renderers [--filter <substring>] [--time <milliseconds>]
+//
+// The filter only keeps the cases whose description (i.e. the renderer class name, the
+// bit-depths or the case name) contains the substring.
+
+
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <OpenColorIO/OpenColorIO.h>
+
+#include "BitDepthUtils.h"
+#include "CPUProcessor.h"
+#include "FusedOpCPU.h"
+#include "ops/CDL/CDLOpCPU.h"
+#include "ops/exposurecontrast/ExposureContrastOpCPU.h"
+#include "ops/FixedFunction/FixedFunctionOpCPU.h"
+#include "ops/Gamma/GammaOpCPU.h"
+#include "ops/Log/LogOpCPU.h"
+#include "ops/Lut1D/Lut1DOpCPU.h"
+#include "ops/Lut3D/Lut3DOpCPU.h"
+#include "ops/Matrix/MatrixOpCPU.h"
+#include "ops/Matrix/MatrixOps.h"
+#include "ops/Range/RangeOpCPU.h"
+#include "ops/Range/RangeOps.h"
+
+
+namespace OCIO = OCIO_NAMESPACE;
+
+
+namespace
+{
+
+// The numbers of pixels of the buffers i.e. fitting in the L1 cache, in the L2 cache,
+// and only in the main memory (in 32-bit float).
+const long BufferSizes[] = { 1024, 64 * 1024, 1024 * 1024 };
+
+struct BenchmarkCase
+{
+    std::string           m_name;
+    OCIO::BitDepth        m_inBitDepth;
+    OCIO::BitDepth        m_outBitDepth;
+    OCIO::ConstOpCPURcPtr m_renderer;
+};
+
+typedef std::vector<BenchmarkCase> BenchmarkCases;
+
+void AddCase(BenchmarkCases & cases, const std::string & name, OCIO::ConstOpCPURcPtr renderer,
+             OCIO::BitDepth inBD = OCIO::BIT_DEPTH_F32, OCIO::BitDepth outBD = OCIO::BIT_DEPTH_F32)
+{
+    cases.push_back({ name, inBD, outBD, renderer });
+}
+
+size_t GetChannelSize(OCIO::BitDepth bitDepth)
+{
+    switch(bitDepth)
+    {
+        case OCIO::BIT_DEPTH_UINT8:  return 1;
+        case OCIO::BIT_DEPTH_UINT10:
+        case OCIO::BIT_DEPTH_UINT12:
+        case OCIO::BIT_DEPTH_UINT14:
+        case OCIO::BIT_DEPTH_UINT16:
+        case OCIO::BIT_DEPTH_F16:    return 2;
+        case OCIO::BIT_DEPTH_UINT32:
+        case OCIO::BIT_DEPTH_F32:    return 4;
+        case OCIO::BIT_DEPTH_UNKNOWN:
+        default:
+            break;
+    }
+
+    throw OCIO::Exception("Unsupported bit-depth.");
+}
+
+// Fill the buffer with values spread over [-0.1, 1.1] for the float bit-depths, and over
+// the whole range of the integer bit-depths.
+void FillBuffer(std::vector<char> & buffer, OCIO::BitDepth bitDepth, size_t numValues)
+{
+    buffer.resize(numValues * GetChannelSize(bitDepth));
+
+    const double maxValue = OCIO::GetBitDepthMaxValue(bitDepth);
+
+    for(size_t idx = 0; idx < numValues; ++idx)
+    {
+        const float value = float((idx * 7919) % 1201) / 1000.0f - 0.1f;
+        const double code = std::round(std::min(std::max(value, 0.0f), 1.0f) * maxValue);
+
+        switch(bitDepth)
+        {
+            case OCIO::BIT_DEPTH_UINT8:
+                reinterpret_cast<uint8_t *>(&buffer[0])[idx] = uint8_t(code);
+                break;
+            case OCIO::BIT_DEPTH_UINT10:
+            case OCIO::BIT_DEPTH_UINT12:
+            case OCIO::BIT_DEPTH_UINT14:
+            case OCIO::BIT_DEPTH_UINT16:
+                reinterpret_cast<uint16_t *>(&buffer[0])[idx] = uint16_t(code);
+                break;
+            case OCIO::BIT_DEPTH_UINT32:
+                reinterpret_cast<uint32_t *>(&buffer[0])[idx] = uint32_t(code);
+                break;
+            case OCIO::BIT_DEPTH_F16:
+                reinterpret_cast<half *>(&buffer[0])[idx] = half(value);
+                break;
+            case OCIO::BIT_DEPTH_F32:
+                reinterpret_cast<float *>(&buffer[0])[idx] = value;
+                break;
+            case OCIO::BIT_DEPTH_UNKNOWN:
+            default:
+                break;
+        }
+    }
+}
+
+// Process the buffer until the minimum time elapsed, and return the number of pixels
+// processed per second.
+double MeasurePixelsPerSecond(const OCIO::OpCPU & renderer,
+                              const void * inImg, void * outImg, long numPixels,
+                              double minSeconds)
+{
+    // Warm up the caches.
+    renderer.apply(inImg, outImg, numPixels);
+
+    long long totalPixels = 0;
+    double elapsed = 0.0;
+
+    const auto start = std::chrono::steady_clock::now();
+    do
+    {
+        renderer.apply(inImg, outImg, numPixels);
+        totalPixels += numPixels;
+
+        const std::chrono::duration<double> duration = std::chrono::steady_clock::now() - start;
+        elapsed = duration.count();
+    }
+    while(elapsed < minSeconds);
+
+    return double(totalPixels) / elapsed;
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+// The renderer cases.
+
+void AddMatrixCases(BenchmarkCases & cases)
+{
+    const double offsets[4] = { 0.01, 0.02, 0.03, 0.0 };
+
+    OCIO::MatrixOpDataRcPtr scale = std::make_shared<OCIO::MatrixOpData>();
+    scale->setArrayValue(0, 1.1);
+    scale->setArrayValue(5, 1.2);
+    scale->setArrayValue(10, 1.3);
+
+    OCIO::ConstMatrixOpDataRcPtr constMat = scale;
+    AddCase(cases, "scale", OCIO::GetMatrixRenderer(constMat));
+
+    OCIO::MatrixOpDataRcPtr scaleOffset = scale->clone();
+    scaleOffset->setRGBAOffsets(offsets);
+    constMat = scaleOffset;
+    AddCase(cases, "scale+offset", OCIO::GetMatrixRenderer(constMat));
+
+    OCIO::MatrixOpDataRcPtr matrix = scaleOffset->clone();
+    matrix->setArrayValue(1, 0.1);
+    matrix->setArrayValue(4, 0.2);
+    matrix->setArrayValue(9, 0.3);
+    constMat = matrix;
+    AddCase(cases, "matrix3x3+offset", OCIO::GetMatrixRenderer(constMat));
+
+    OCIO::MatrixOpDataRcPtr matrix4x4 = matrix->clone();
+    matrix4x4->setArrayValue(12, 0.1);
+    constMat = matrix4x4;
+    AddCase(cases, "matrix4x4+offset", OCIO::GetMatrixRenderer(constMat));
+}
+
+// A gamma curve (i.e. an increasing function) sampling [0, 1] or the half-float codes.
+OCIO::Lut1DOpDataRcPtr CreateLut1D(bool halfDomain)
+{
+    OCIO::Lut1DOpDataRcPtr lut
+        = halfDomain ? std::make_shared<OCIO::Lut1DOpData>(OCIO::Lut1DOpData::LUT_INPUT_HALF_CODE,
+                                                           65536)
+                     : std::make_shared<OCIO::Lut1DOpData>(4096);
+
+    OCIO::Array & array = lut->getArray();
+    const unsigned long length = array.getLength();
+    const unsigned long numChannels = array.getNumColorComponents();
+
+    for(unsigned long idx = 0; idx < length; ++idx)
+    {
+        float in = float(idx) / float(length - 1);
+        if(halfDomain)
+        {
+            half code;
+            code.setBits((unsigned short)idx);
+            in = code.isFinite() ? float(code) : 0.0f;
+        }
+
+        const float out = std::copysign(std::pow(std::fabs(in), 1.0f / 2.2f), in);
+        for(unsigned long channel = 0; channel < numChannels; ++channel)
+        {
+            array.getValues()[idx * numChannels + channel] = out * (1.0f - 0.05f * channel);
+        }
+    }
+
+    lut->finalize();
+    return lut;
+}
+
+void AddLut1DCases(BenchmarkCases & cases)
+{
+    const struct
+    {
+        OCIO::BitDepth m_in;
+        OCIO::BitDepth m_out;
+    } bitDepths[] = {
+        { OCIO::BIT_DEPTH_F32,    OCIO::BIT_DEPTH_F32    },
+        { OCIO::BIT_DEPTH_F16,    OCIO::BIT_DEPTH_F32    },
+        { OCIO::BIT_DEPTH_UINT8,  OCIO::BIT_DEPTH_UINT8  },
+        { OCIO::BIT_DEPTH_UINT8,  OCIO::BIT_DEPTH_F32    },
+        { OCIO::BIT_DEPTH_UINT10, OCIO::BIT_DEPTH_UINT10 },
+        { OCIO::BIT_DEPTH_UINT16, OCIO::BIT_DEPTH_UINT16 },
+        { OCIO::BIT_DEPTH_UINT16, OCIO::BIT_DEPTH_F32    },
+        { OCIO::BIT_DEPTH_F32,    OCIO::BIT_DEPTH_UINT16 },
+    };
+
+    for(bool halfDomain : { false, true })
+    {
+        const std::string domain(halfDomain ? "half domain" : "4096 entries");
+
+        OCIO::Lut1DOpDataRcPtr lut = CreateLut1D(halfDomain);
+        OCIO::ConstLut1DOpDataRcPtr constLut = lut;
+
+        for(const auto & bd : bitDepths)
+        {
+            AddCase(cases, domain,
+                    OCIO::GetLut1DRenderer(constLut, bd.m_in, bd.m_out), bd.m_in, bd.m_out);
+        }
+
+        OCIO::Lut1DOpDataRcPtr hueLut = lut->clone();
+        hueLut->setHueAdjust(OCIO::HUE_DW3);
+        hueLut->finalize();
+        constLut = hueLut;
+        AddCase(cases, domain + ", hue adjust",
+                OCIO::GetLut1DRenderer(constLut, OCIO::BIT_DEPTH_F32, OCIO::BIT_DEPTH_F32));
+
+        // The exact inverse searches the LUT values.
+        OCIO::Lut1DOpDataRcPtr invLut = lut->inverse();
+        invLut->setInversionQuality(OCIO::LUT_INVERSION_EXACT);
+        invLut->finalize();
+        constLut = invLut;
+
+        for(const auto & bd : bitDepths)
+        {
+            AddCase(cases, domain + ", exact inverse",
+                    OCIO::GetLut1DRenderer(constLut, bd.m_in, bd.m_out), bd.m_in, bd.m_out);
+        }
+
+        OCIO::Lut1DOpDataRcPtr invHueLut = hueLut->inverse();
+        invHueLut->setInversionQuality(OCIO::LUT_INVERSION_EXACT);
+        invHueLut->finalize();
+        constLut = invHueLut;
+        AddCase(cases, domain + ", exact inverse, hue adjust",
+                OCIO::GetLut1DRenderer(constLut, OCIO::BIT_DEPTH_F32, OCIO::BIT_DEPTH_F32));
+
+        // The fast inverse resamples the inverse in a forward LUT.
+        OCIO::Lut1DOpDataRcPtr fastInvLut = lut->inverse();
+        fastInvLut->setInversionQuality(OCIO::LUT_INVERSION_FAST);
+        fastInvLut->finalize();
+        constLut = fastInvLut;
+        AddCase(cases, domain + ", fast inverse",
+                OCIO::GetLut1DRenderer(constLut, OCIO::BIT_DEPTH_F32, OCIO::BIT_DEPTH_F32));
+    }
+}
+
+void AddLut3DCases(BenchmarkCases & cases)
+{
+    for(unsigned long gridSize : { 17ul, 33ul, 65ul })
+    {
+        OCIO::Lut3DOpDataRcPtr lut = std::make_shared<OCIO::Lut3DOpData>(gridSize);
+
+        // A smooth change of the identity.
+        std::vector<float> & values = lut->getArray().getValues();
+        for(size_t idx = 0; idx < values.size(); ++idx)
+        {
+            values[idx] = std::pow(values[idx], 1.0f / 2.2f);
+        }
+
+        const std::string size(std::to_string(gridSize) + "^3");
+
+        for(auto interpolation : { OCIO::INTERP_TETRAHEDRAL, OCIO::INTERP_LINEAR })
+        {
+            const std::string name(size + (interpolation == OCIO::INTERP_LINEAR
+                                           ? " trilinear" : " tetrahedral"));
+
+            for(bool halfStorage : { false, true })
+            {
+                OCIO::Lut3DOpDataRcPtr interpLut = lut->clone();
+                interpLut->setInterpolation(interpolation);
+                interpLut->setHalfStorage(halfStorage);
+                interpLut->finalize();
+
+                OCIO::ConstLut3DOpDataRcPtr constLut = interpLut;
+                AddCase(cases, name + (halfStorage ? ", half storage" : ""),
+                        OCIO::GetLut3DRenderer(constLut));
+            }
+        }
+
+        // The exact inverse of the large LUTs takes a while to create.
+        if(gridSize <= 33)
+        {
+            OCIO::Lut3DOpDataRcPtr invLut = lut->inverse();
+            invLut->setInversionQuality(OCIO::LUT_INVERSION_EXACT);
+            invLut->finalize();
+
+            OCIO::ConstLut3DOpDataRcPtr constLut = invLut;
+            AddCase(cases, size + " exact inverse", OCIO::GetLut3DRenderer(constLut));
+        }
+    }
+}
+
+void AddLogCases(BenchmarkCases & cases)
+{
+    for(auto dir : { OCIO::TRANSFORM_DIR_FORWARD, OCIO::TRANSFORM_DIR_INVERSE })
+    {
+        const std::string direction(dir == OCIO::TRANSFORM_DIR_FORWARD ? "" : ", inverse");
+
+        OCIO::ConstLogOpDataRcPtr log2 = std::make_shared<OCIO::LogOpData>(2.0, dir);
+        AddCase(cases, "base 2" + direction, OCIO::GetLogRenderer(log2));
+
+        OCIO::ConstLogOpDataRcPtr log10 = std::make_shared<OCIO::LogOpData>(10.0, dir);
+        AddCase(cases, "base 10" + direction, OCIO::GetLogRenderer(log10));
+
+        const double logSlope[3]  = { 0.18, 0.18, 0.18 };
+        const double logOffset[3] = { 0.6, 0.6, 0.6 };
+        const double linSlope[3]  = { 1.1, 1.1, 1.1 };
+        const double linOffset[3] = { 0.01, 0.01, 0.01 };
+        OCIO::ConstLogOpDataRcPtr affine
+            = std::make_shared<OCIO::LogOpData>(10.0, logSlope, logOffset,
+                                                linSlope, linOffset, dir);
+        AddCase(cases, "affine" + direction, OCIO::GetLogRenderer(affine));
+    }
+}
+
+void AddGammaCases(BenchmarkCases & cases)
+{
+    const OCIO::GammaOpData::Params basic      = { 2.2 };
+    const OCIO::GammaOpData::Params basicAlpha = { 1.0 };
+    const OCIO::GammaOpData::Params moncurve      = { 2.4, 0.055 };
+    const OCIO::GammaOpData::Params moncurveAlpha = { 1.0, 0.0 };
+
+    const struct
+    {
+        const char * m_name;
+        OCIO::GammaOpData::Style m_style;
+        const OCIO::GammaOpData::Params & m_params;
+        const OCIO::GammaOpData::Params & m_alphaParams;
+    } styles[] = {
+        { "basic",            OCIO::GammaOpData::BASIC_FWD,    basic,    basicAlpha    },
+        { "basic, inverse",   OCIO::GammaOpData::BASIC_REV,    basic,    basicAlpha    },
+        { "moncurve",         OCIO::GammaOpData::MONCURVE_FWD, moncurve, moncurveAlpha },
+        { "moncurve, inverse",OCIO::GammaOpData::MONCURVE_REV, moncurve, moncurveAlpha },
+    };
+
+    for(const auto & style : styles)
+    {
+        for(bool fastMath : { false, true })
+        {
+            OCIO::GammaOpDataRcPtr gamma
+                = std::make_shared<OCIO::GammaOpData>(style.m_style, style.m_params,
+                                                      style.m_params, style.m_params,
+                                                      style.m_alphaParams);
+            gamma->setFastMath(fastMath);
+
+            OCIO::ConstGammaOpDataRcPtr constGamma = gamma;
+            AddCase(cases, std::string(style.m_name) + (fastMath ? ", fast math" : ""),
+                    OCIO::GetGammaRenderer(constGamma));
+        }
+    }
+}
+
+void AddCDLCases(BenchmarkCases & cases)
+{
+    for(auto style : { OCIO::CDLOpData::CDL_V1_2_FWD, OCIO::CDLOpData::CDL_V1_2_REV,
+                       OCIO::CDLOpData::CDL_NO_CLAMP_FWD, OCIO::CDLOpData::CDL_NO_CLAMP_REV })
+    {
+        OCIO::ConstCDLOpDataRcPtr cdl
+            = std::make_shared<OCIO::CDLOpData>(style,
+                                                OCIO::CDLOpData::ChannelParams(1.1, 1.0, 0.9),
+                                                OCIO::CDLOpData::ChannelParams(0.01),
+                                                OCIO::CDLOpData::ChannelParams(1.2, 1.0, 0.8),
+                                                0.9);
+        AddCase(cases, OCIO::CDLOpData::GetStyleName(style), OCIO::CDLOpCPU::GetRenderer(cdl));
+    }
+}
+
+void AddRangeCases(BenchmarkCases & cases)
+{
+    const double empty = OCIO::RangeOpData::EmptyValue();
+
+    OCIO::ConstRangeOpDataRcPtr clamp = std::make_shared<OCIO::RangeOpData>(0., 1., 0., 1.);
+    AddCase(cases, "clamp", OCIO::GetRangeRenderer(clamp));
+
+    OCIO::ConstRangeOpDataRcPtr scale = std::make_shared<OCIO::RangeOpData>(0., 1., 0.1, 0.9);
+    AddCase(cases, "scale+clamp", OCIO::GetRangeRenderer(scale));
+
+    OCIO::ConstRangeOpDataRcPtr minOnly
+        = std::make_shared<OCIO::RangeOpData>(0., empty, 0., empty);
+    AddCase(cases, "min clamp", OCIO::GetRangeRenderer(minOnly));
+
+    OCIO::ConstRangeOpDataRcPtr maxOnly
+        = std::make_shared<OCIO::RangeOpData>(empty, 1., empty, 1.);
+    AddCase(cases, "max clamp", OCIO::GetRangeRenderer(maxOnly));
+}
+
+void AddExposureContrastCases(BenchmarkCases & cases)
+{
+    for(auto style : { OCIO::ExposureContrastOpData::STYLE_LINEAR,
+                       OCIO::ExposureContrastOpData::STYLE_LINEAR_REV,
+                       OCIO::ExposureContrastOpData::STYLE_VIDEO,
+                       OCIO::ExposureContrastOpData::STYLE_VIDEO_REV,
+                       OCIO::ExposureContrastOpData::STYLE_LOGARITHMIC,
+                       OCIO::ExposureContrastOpData::STYLE_LOGARITHMIC_REV })
+    {
+        OCIO::ExposureContrastOpDataRcPtr ec
+            = std::make_shared<OCIO::ExposureContrastOpData>(style);
+        ec->setExposure(0.5);
+        ec->setContrast(1.2);
+        ec->setGamma(1.1);
+
+        OCIO::ConstExposureContrastOpDataRcPtr constEC = ec;
+        AddCase(cases, OCIO::ExposureContrastOpData::ConvertStyleToString(style),
+                OCIO::GetExposureContrastCPURenderer(constEC));
+    }
+}
+
+void AddFixedFunctionCases(BenchmarkCases & cases)
+{
+    for(auto style : { OCIO::FixedFunctionOpData::ACES_RED_MOD_03_FWD,
+                       OCIO::FixedFunctionOpData::ACES_RED_MOD_03_INV,
+                       OCIO::FixedFunctionOpData::ACES_RED_MOD_10_FWD,
+                       OCIO::FixedFunctionOpData::ACES_RED_MOD_10_INV,
+                       OCIO::FixedFunctionOpData::ACES_GLOW_03_FWD,
+                       OCIO::FixedFunctionOpData::ACES_GLOW_03_INV,
+                       OCIO::FixedFunctionOpData::ACES_GLOW_10_FWD,
+                       OCIO::FixedFunctionOpData::ACES_GLOW_10_INV,
+                       OCIO::FixedFunctionOpData::ACES_DARK_TO_DIM_10_FWD,
+                       OCIO::FixedFunctionOpData::ACES_DARK_TO_DIM_10_INV,
+                       OCIO::FixedFunctionOpData::REC2100_SURROUND })
+    {
+        OCIO::FixedFunctionOpData::Params params;
+        if(style == OCIO::FixedFunctionOpData::REC2100_SURROUND)
+        {
+            params.push_back(0.78);
+        }
+
+        OCIO::ConstFixedFunctionOpDataRcPtr func
+            = std::make_shared<OCIO::FixedFunctionOpData>(params, style);
+        AddCase(cases, OCIO::FixedFunctionOpData::ConvertStyleToString(style, false),
+                OCIO::GetFixedFunctionCPURenderer(func));
+    }
+}
+
+void AddBitDepthCases(BenchmarkCases & cases)
+{
+    for(auto bitDepth : { OCIO::BIT_DEPTH_UINT8, OCIO::BIT_DEPTH_UINT10,
+                          OCIO::BIT_DEPTH_UINT16, OCIO::BIT_DEPTH_F16 })
+    {
+        AddCase(cases, "to float",
+                OCIO::CreateGenericBitDepthHelper(bitDepth, OCIO::BIT_DEPTH_F32),
+                bitDepth, OCIO::BIT_DEPTH_F32);
+        AddCase(cases, "from float",
+                OCIO::CreateGenericBitDepthHelper(OCIO::BIT_DEPTH_F32, bitDepth),
+                OCIO::BIT_DEPTH_F32, bitDepth);
+    }
+}
+
+void AddFusedCases(BenchmarkCases & cases)
+{
+    // A typical chain of simple ops (e.g. from a camera log space to a display space).
+    const double m44[16] = { 1.1, 0.1, 0.0, 0.0,
+                             0.2, 1.2, 0.1, 0.0,
+                             0.0, 0.3, 1.3, 0.0,
+                             0.0, 0.0, 0.0, 1.0 };
+    const double offset4[4] = { 0.01, 0.02, 0.03, 0.0 };
+
+    OCIO::OpRcPtrVec ops;
+    OCIO::CreateRangeOp(ops, 0., 1., 0., 1., OCIO::TRANSFORM_DIR_FORWARD);
+    OCIO::CreateMatrixOffsetOp(ops, m44, offset4, OCIO::TRANSFORM_DIR_FORWARD);
+    OCIO::CreateRangeOp(ops, 0., 1., 0., 1., OCIO::TRANSFORM_DIR_FORWARD);
+    OCIO::FinalizeOpVec(ops, OCIO::FINALIZATION_DEFAULT);
+
+    OCIO::ConstOpCPURcPtrVec cpuOps;
+    OCIO::CreateFusedCPUOps(ops, 0, ops.size(), cpuOps);
+
+    for(const auto & cpuOp : cpuOps)
+    {
+        AddCase(cases, "range+matrix+range", cpuOp);
+    }
+}
+
+BenchmarkCases BuildBenchmarkCases()
+{
+    BenchmarkCases cases;
+
+    AddMatrixCases(cases);
+    AddLut1DCases(cases);
+    AddLut3DCases(cases);
+    AddLogCases(cases);
+    AddGammaCases(cases);
+    AddCDLCases(cases);
+    AddRangeCases(cases);
+    AddExposureContrastCases(cases);
+    AddFixedFunctionCases(cases);
+    AddBitDepthCases(cases);
+    AddFusedCases(cases);
+
+    return cases;
+}
+
+std::string FormatBufferSize(long numPixels)
+{
+    std::ostringstream oss;
+    if(numPixels >= 1024 * 1024)
+    {
+        oss << numPixels / (1024 * 1024) << "M";
+    }
+    else
+    {
+        oss << numPixels / 1024 << "K";
+    }
+    oss << " px";
+    return oss.str();
+}
+
+void PrintUsage()
+{
+    std::cerr << "Usage: bench_renderers [--filter <substring>] [--time <milliseconds>]\n";
+}
+
+}
+
+
+int main(int argc, const char ** argv)
+{
+    std::string filter;
+    double minSeconds = 0.2;
+
+    for(int idx = 1; idx < argc; ++idx)
+    {
+        const std::string arg(argv[idx]);
+        if(arg == "--filter" && idx + 1 < argc)
+        {
+            filter = argv[++idx];
+        }
+        else if(arg == "--time" && idx + 1 < argc)
+        {
+            minSeconds = std::atof(argv[++idx]) / 1000.0;
+        }
+        else
+        {
+            PrintUsage();
+            return 1;
+        }
+    }
+
+    try
+    {
+        const BenchmarkCases cases = BuildBenchmarkCases();
+
+        std::cout << "Millions of pixels processed per second (RGBA)." << std::endl << std::endl;
+
+        std::cout << std::left << std::setw(44) << "Renderer"
+                  << std::setw(9) << "In" << std::setw(9) << "Out"
+                  << std::setw(40) << "Case";
+        for(long numPixels : BufferSizes)
+        {
+            std::cout << std::right << std::setw(12) << FormatBufferSize(numPixels);
+        }
+        std::cout << std::endl;
+
+        for(const auto & benchmark : cases)
+        {
+            const std::string rendererName(OCIO::GetRendererName(*benchmark.m_renderer));
+            const std::string inName(OCIO::BitDepthToString(benchmark.m_inBitDepth));
+            const std::string outName(OCIO::BitDepthToString(benchmark.m_outBitDepth));
+
+            if(!filter.empty())
+            {
+                const std::string description
+                    = rendererName + " " + inName + " " + outName + " " + benchmark.m_name;
+                if(description.find(filter) == std::string::npos)
+                {
+                    continue;
+                }
+            }
+
+            std::cout << std::left << std::setw(44) << rendererName
+                      << std::setw(9) << inName << std::setw(9) << outName
+                      << std::setw(40) << benchmark.m_name << std::flush;
+
+            for(long numPixels : BufferSizes)
+            {
+                std::vector<char> inImg;
+                FillBuffer(inImg, benchmark.m_inBitDepth, 4 * size_t(numPixels));
+
+                std::vector<char> outImg(4 * size_t(numPixels)
+                                           * GetChannelSize(benchmark.m_outBitDepth));
+
+                const double pixelsPerSecond
+                    = MeasurePixelsPerSecond(*benchmark.m_renderer, &inImg[0], &outImg[0],
+                                             numPixels, minSeconds);
+
+                std::cout << std::right << std::setw(12) << std::fixed << std::setprecision(1)
+                          << pixelsPerSecond / 1.0e6 << std::flush;
+            }
+            std::cout << std::endl;
+        }
+    }
+    catch(const std::exception & e)
+    {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -32,6 +32,24 @@ OCIO_ADD_TEST(FileFormatCTF, missing_file)
                           "Error opening test file.");
 }
 
+OCIO_ADD_TEST(FileFormatCTF, element_tag)
+{
+    // The element names are case-insensitive.
+    OCIO_CHECK_EQUAL(OCIO::GetElementTag("ProcessList"), OCIO::ELT_PROCESS_LIST);
+    OCIO_CHECK_EQUAL(OCIO::GetElementTag("PROCESSLIST"), OCIO::ELT_PROCESS_LIST);
+    OCIO_CHECK_EQUAL(OCIO::GetElementTag("Matrix"), OCIO::ELT_MATRIX);
+    OCIO_CHECK_EQUAL(OCIO::GetElementTag("matrix"), OCIO::ELT_MATRIX);
+    OCIO_CHECK_EQUAL(OCIO::GetElementTag("minInValue"), OCIO::ELT_MIN_IN_VALUE);
+    OCIO_CHECK_EQUAL(OCIO::GetElementTag("ViewingDescription"), OCIO::ELT_VIEWING_DESCRIPTION);
+    OCIO_CHECK_EQUAL(OCIO::GetElementTag(OCIO::TAG_SATNODE), OCIO::ELT_SATNODE);
+    OCIO_CHECK_EQUAL(OCIO::GetElementTag(OCIO::TAG_SATNODEALT), OCIO::ELT_SATNODE);
+
+    OCIO_CHECK_EQUAL(OCIO::GetElementTag(""), OCIO::ELT_UNKNOWN);
+    OCIO_CHECK_EQUAL(OCIO::GetElementTag("Matri"), OCIO::ELT_UNKNOWN);
+    OCIO_CHECK_EQUAL(OCIO::GetElementTag("Matrixx"), OCIO::ELT_UNKNOWN);
+    OCIO_CHECK_EQUAL(OCIO::GetElementTag("Metadata"), OCIO::ELT_UNKNOWN);
+}
+
 OCIO_ADD_TEST(FileFormatCTF, wrong_format)
 {
     OCIO::LocalCachedFileRcPtr cachedFile;
@@ -2672,6 +2690,47 @@ OCIO_ADD_TEST(Reference, load_multiple)
     OCIO_CHECK_EQUAL(ref3->getDirection(), OCIO::TRANSFORM_DIR_FORWARD);
 }
 
+OCIO_ADD_TEST(Reference, resolved_ops)
+{
+    OCIO::LocalCachedFileRcPtr cachedFile;
+    std::string fileName("references_some_inverted.ctf");
+    OCIO_CHECK_NO_THROW(cachedFile = LoadCLFFile(fileName));
+    OCIO_CHECK_ASSERT(cachedFile->m_hasReferences);
+
+    OCIO::ContextRcPtr context = OCIO::Context::Create();
+    context->addSearchPath(OCIO::getTestFilesDir());
+
+    OCIO::ConstResolvedOpVecRcPtr resolvedOps;
+    OCIO_CHECK_NO_THROW(resolvedOps = cachedFile->getResolvedOps(context));
+    OCIO_REQUIRE_ASSERT(resolvedOps);
+    OCIO_REQUIRE_EQUAL(resolvedOps->size(), 4);
+
+    OCIO_CHECK_ASSERT(!(*resolvedOps)[0].m_opData);
+    OCIO_CHECK_NE((*resolvedOps)[0].m_filePath.find("matrix_example.clf"), std::string::npos);
+    OCIO_CHECK_EQUAL((*resolvedOps)[0].m_dir, OCIO::TRANSFORM_DIR_FORWARD);
+    OCIO_CHECK_ASSERT(!(*resolvedOps)[1].m_opData);
+    OCIO_CHECK_NE((*resolvedOps)[1].m_filePath.find("xyz_to_rgb.clf"), std::string::npos);
+    OCIO_CHECK_EQUAL((*resolvedOps)[1].m_dir, OCIO::TRANSFORM_DIR_INVERSE);
+    OCIO_CHECK_ASSERT((*resolvedOps)[2].m_opData);
+    OCIO_CHECK_ASSERT((*resolvedOps)[2].m_filePath.empty());
+    OCIO_CHECK_ASSERT(!(*resolvedOps)[3].m_opData);
+
+    // The resolution is shared by the contexts having the same state.
+    OCIO::ContextRcPtr context2 = context->createEditableCopy();
+    OCIO_CHECK_EQUAL(cachedFile->getResolvedOps(context2), resolvedOps);
+
+    // A different context state resolves the references again.
+    context2->setStringVar("VAR", "value");
+    OCIO_CHECK_NE(cachedFile->getResolvedOps(context2), resolvedOps);
+
+    // A failing resolution is not cached.
+    OCIO::ContextRcPtr context3 = OCIO::Context::Create();
+    OCIO_CHECK_THROW_WHAT(cachedFile->getResolvedOps(context3), OCIO::Exception,
+                          "could not be located");
+    OCIO_CHECK_THROW_WHAT(cachedFile->getResolvedOps(context3), OCIO::Exception,
+                          "could not be located");
+}
+
 OCIO_ADD_TEST(Reference, load_path_utf8)
 {
     OCIO::LocalCachedFileRcPtr cachedFile;
@@ -2890,6 +2949,66 @@ OCIO_ADD_TEST(FileFormatCTF, attribute_float_parse_leading_spaces)
     OCIO_CHECK_EQUAL(ec->getExposure(), -1.5);
 }
 
+OCIO_ADD_TEST(FileFormatCTF, large_array_parse)
+{
+    // The character data of a large array is split in several chunks parsed in
+    // parallel, check that the values are still in order.
+    const unsigned long length = 33;
+    const unsigned long numValues = length * length * length * 3;
+
+    std::ostringstream values;
+    for (unsigned long idx = 0; idx < numValues; ++idx)
+    {
+        values << double(idx % 1000) / 8. << ((idx % 3) == 2 ? "\n" : " ");
+    }
+
+    const std::string header(R"(<?xml version="1.0" encoding="UTF-8"?>
+<ProcessList id="large" version="1.7">
+   <LUT3D inBitDepth="32f" outBitDepth="32f">
+      <Array dim="33 33 33 3">
+)");
+    const std::string footer(R"(      </Array>
+   </LUT3D>
+</ProcessList>
+)");
+
+    std::istringstream ctf;
+    ctf.str(header + values.str() + footer);
+
+    std::string emptyString;
+    OCIO::LocalFileFormat tester;
+    OCIO::CachedFileRcPtr file;
+    OCIO_CHECK_NO_THROW(file = tester.read(ctf, emptyString));
+    OCIO::LocalCachedFileRcPtr cachedFile = OCIO_DYNAMIC_POINTER_CAST<OCIO::LocalCachedFile>(file);
+    const auto & fileOps = cachedFile->m_transform->getOps();
+
+    OCIO_REQUIRE_EQUAL(fileOps.size(), 1);
+    auto pLut = std::dynamic_pointer_cast<const OCIO::Lut3DOpData>(fileOps[0]);
+    OCIO_REQUIRE_ASSERT(pLut);
+
+    const OCIO::Array & array = pLut->getArray();
+    OCIO_REQUIRE_EQUAL(array.getValues().size(), numValues);
+    for (unsigned long idx = 0; idx < numValues; ++idx)
+    {
+        OCIO_REQUIRE_EQUAL(array.getValues()[idx], float(idx % 1000) / 8.f);
+    }
+
+    // An illegal value in the last chunk is still detected.
+    std::string illegal(values.str());
+    illegal.replace(illegal.size() - 8, 1, "x");
+
+    ctf.clear();
+    ctf.str(header + illegal + footer);
+    OCIO_CHECK_THROW_WHAT(tester.read(ctf, emptyString), OCIO::Exception,
+                          "Illegal values");
+
+    // As well as too many values.
+    ctf.clear();
+    ctf.str(header + values.str() + "0.5\n" + footer);
+    OCIO_CHECK_THROW_WHAT(tester.read(ctf, emptyString), OCIO::Exception,
+                          "Expected 33x33x33x3 Array, found too many values");
+}
+
 OCIO_ADD_TEST(FixedFunction, load_ff_aces_redmod)
 {
     OCIO::LocalCachedFileRcPtr cachedFile;
@@ -267,3 +267,292 @@ OCIO_ADD_TEST(FileTransform, validate)
     tr->setSrc("");
     OCIO_CHECK_THROW(tr->validate(), OCIO::Exception);
 }
+
+OCIO_ADD_TEST(FileTransform, memory_stream_buf)
+{
+    const std::string content("LUT_1D_SIZE 2\n0 0 0\n1 1 1\n");
+
+    OCIO::MemoryStreamBuf buffer(content.c_str(), content.size());
+    std::istream istream(&buffer);
+
+    std::string line;
+    OCIO_CHECK_ASSERT(std::getline(istream, line));
+    OCIO_CHECK_EQUAL(line, "LUT_1D_SIZE 2");
+    OCIO_CHECK_EQUAL(istream.tellg(), std::streampos(14));
+
+    // The readers could seek in the stream.
+    istream.seekg(-6, std::ios_base::end);
+    OCIO_CHECK_ASSERT(std::getline(istream, line));
+    OCIO_CHECK_EQUAL(line, "1 1 1");
+    OCIO_CHECK_ASSERT(!std::getline(istream, line));
+
+    istream.clear();
+    istream.seekg(0);
+    OCIO_CHECK_ASSERT(std::getline(istream, line));
+    OCIO_CHECK_EQUAL(line, "LUT_1D_SIZE 2");
+
+    istream.seekg(100);
+    OCIO_CHECK_ASSERT(istream.fail());
+}
+
+OCIO_ADD_TEST(FileTransform, format_probe)
+{
+    OCIO_CHECK_EQUAL(OCIO::GetProbeFirstLine("\r\n  \nSPILUT 1.0\r\n3 3\n", true), "SPILUT 1.0");
+    OCIO_CHECK_EQUAL(OCIO::GetProbeFirstLine("\nSPILUT 1.0\n", false), "");
+    OCIO_CHECK_EQUAL(OCIO::GetProbeFirstLine("CSPLUTV1", true), "CSPLUTV1");
+
+    OCIO_CHECK_ASSERT(OCIO::IsProbeXML("\xEF\xBB\xBF  <?xml version=\"1.0\"?>"));
+    OCIO_CHECK_ASSERT(OCIO::IsProbeXML("\n<ProcessList>"));
+    OCIO_CHECK_ASSERT(!OCIO::IsProbeXML("LUT_3D_SIZE 2"));
+    OCIO_CHECK_ASSERT(!OCIO::IsProbeXML(""));
+
+    OCIO_CHECK_ASSERT(OCIO::HasProbeKeyword("# Comment\n  domain_min 0 0 0\n", "DOMAIN_MIN"));
+    OCIO_CHECK_ASSERT(!OCIO::HasProbeKeyword("# DOMAIN_MIN 0 0 0\n", "DOMAIN_MIN"));
+    OCIO_CHECK_ASSERT(!OCIO::HasProbeKeyword("DOMAIN_MINIMUM 0 0 0\n", "DOMAIN_MIN"));
+    OCIO_CHECK_ASSERT(OCIO::HasProbeKeyword("LUT_3D_SIZE 2\nTITLE", "title"));
+
+    OCIO::FormatRegistry & formatRegistry = OCIO::FormatRegistry::GetInstance();
+    const OCIO::FileFormat * iridas = formatRegistry.getFileFormatByName("iridas_cube");
+    const OCIO::FileFormat * resolve = formatRegistry.getFileFormatByName("resolve_cube");
+    const OCIO::FileFormat * clf = formatRegistry.getFileFormatByName(OCIO::FILEFORMAT_CLF);
+    const OCIO::FileFormat * spi3d = formatRegistry.getFileFormatByName("spi3d");
+    OCIO_REQUIRE_ASSERT(iridas && resolve && clf && spi3d);
+
+    // The ambiguous .cube extension.
+    const std::string iridasCube("TITLE \"lut\"\nLUT_3D_SIZE 2\nDOMAIN_MIN 0 0 0\n0 0 0\n");
+    OCIO_CHECK_EQUAL(iridas->probe(iridasCube), OCIO::FORMAT_PROBE_LIKELY);
+    OCIO_CHECK_EQUAL(resolve->probe(iridasCube), OCIO::FORMAT_PROBE_NO);
+
+    const std::string resolveCube("LUT_3D_SIZE 2\nLUT_3D_INPUT_RANGE 0.0 1.0\n0 0 0\n");
+    OCIO_CHECK_EQUAL(iridas->probe(resolveCube), OCIO::FORMAT_PROBE_NO);
+    OCIO_CHECK_EQUAL(resolve->probe(resolveCube), OCIO::FORMAT_PROBE_LIKELY);
+
+    const std::string cube("LUT_3D_SIZE 2\n0 0 0\n");
+    OCIO_CHECK_EQUAL(iridas->probe(cube), OCIO::FORMAT_PROBE_UNKNOWN);
+    OCIO_CHECK_EQUAL(resolve->probe(cube), OCIO::FORMAT_PROBE_UNKNOWN);
+
+    const std::string ctf("<?xml version=\"1.0\"?>\n<ProcessList id=\"1\" compCLFversion=\"3\">");
+    OCIO_CHECK_EQUAL(clf->probe(ctf), OCIO::FORMAT_PROBE_CERTAIN);
+    OCIO_CHECK_EQUAL(clf->probe(cube), OCIO::FORMAT_PROBE_NO);
+    OCIO_CHECK_EQUAL(spi3d->probe(ctf), OCIO::FORMAT_PROBE_NO);
+    OCIO_CHECK_EQUAL(spi3d->probe("SPILUT 1.0\n3 3\n"), OCIO::FORMAT_PROBE_CERTAIN);
+
+    // The loading tries the most confident formats first.
+    OCIO::ClearAllCaches();
+    OCIO::FileFormat * format = nullptr;
+    OCIO::CachedFileRcPtr cachedFile;
+    OCIO_CHECK_NO_THROW(OCIO::GetCachedFileAndFormat(format, cachedFile,
+        std::string(OCIO::getTestFilesDir()) + "/lut3d_17x17x17_32f_12i.clf"));
+    OCIO_CHECK_EQUAL(format, clf);
+}
+
+OCIO_ADD_TEST(FileTransform, file_disk_cache)
+{
+    std::string tmpFilename;
+    OCIO_CHECK_NO_THROW(OCIO::Platform::CreateTempFilename(tmpFilename, ""));
+    const std::string dir = pystring::os::path::dirname(tmpFilename);
+
+    OCIO_CHECK_EQUAL(std::string(OCIO::GetFileDiskCacheDir()), std::string(""));
+    OCIO::SetFileDiskCacheDir(dir.c_str());
+    OCIO_CHECK_EQUAL(std::string(OCIO::GetFileDiskCacheDir()), dir);
+
+    for (const std::string fileName : { "lut1d_1.spi1d", "lut3d_1.spi3d", "iridas_3d.cube",
+                                        "resolve_1d3d.cube", "cdl_test1.cc" })
+    {
+        // The file path as resolved by the context.
+        const std::string filePath = pystring::os::path::normpath(
+            std::string(OCIO::getTestFilesDir()) + "/" + fileName);
+
+        std::string key, filename;
+        OCIO_REQUIRE_ASSERT(OCIO::GetFileDiskCacheKey(filePath, key, filename));
+        std::remove(filename.c_str());
+
+        // Loading the file saves it.
+        OCIO::ClearAllCaches();
+        OCIO::ConstProcessorRcPtr proc1;
+        OCIO_CHECK_NO_THROW(proc1 = OCIO::GetFileTransformProcessor(fileName));
+        OCIO_CHECK_ASSERT(std::ifstream(filename).good());
+
+        OCIO::FileFormat * format = nullptr;
+        OCIO::CachedFileRcPtr cachedFile;
+        OCIO_CHECK_ASSERT(OCIO::LoadFromFileDiskCache(key, filename, format, cachedFile));
+        OCIO_CHECK_ASSERT(format && cachedFile);
+
+        // The file is then loaded from the disk cache, building the same processor.
+        OCIO::ClearAllCaches();
+        OCIO::ConstProcessorRcPtr proc2;
+        OCIO_CHECK_NO_THROW(proc2 = OCIO::GetFileTransformProcessor(fileName));
+        OCIO_CHECK_NE(proc1, proc2);
+        OCIO_CHECK_EQUAL(std::string(proc1->getCacheID()), std::string(proc2->getCacheID()));
+
+        // An invalid file is ignored.
+        {
+            std::ofstream dst(filename, std::ios_base::binary | std::ios_base::trunc);
+            dst << "Not a cached file";
+        }
+        OCIO_CHECK_ASSERT(!OCIO::LoadFromFileDiskCache(key, filename, format, cachedFile));
+
+        OCIO::ClearAllCaches();
+        OCIO::ConstProcessorRcPtr proc3;
+        OCIO_CHECK_NO_THROW(proc3 = OCIO::GetFileTransformProcessor(fileName));
+        OCIO_CHECK_EQUAL(std::string(proc1->getCacheID()), std::string(proc3->getCacheID()));
+
+        std::remove(filename.c_str());
+    }
+
+    OCIO::SetFileDiskCacheDir(nullptr);
+    OCIO_CHECK_EQUAL(std::string(OCIO::GetFileDiskCacheDir()), std::string(""));
+    OCIO::ClearAllCaches();
+}
+
+OCIO_ADD_TEST(FileTransform, lut_header)
+{
+    OCIO::ClearFileTransformCaches();
+
+    const std::string dir(OCIO::getTestFilesDir());
+
+    unsigned lut1DSize = 1, lut3DSize = 1;
+    OCIO_CHECK_ASSERT(OCIO::GetFileLutDimensions((dir + "/lut3d_1.spi3d").c_str(),
+                                                 lut1DSize, lut3DSize));
+    OCIO_CHECK_EQUAL(lut1DSize, 0u);
+    OCIO_CHECK_EQUAL(lut3DSize, 32u);
+
+    OCIO_CHECK_ASSERT(OCIO::GetFileLutDimensions((dir + "/iridas_3d.cube").c_str(),
+                                                 lut1DSize, lut3DSize));
+    OCIO_CHECK_EQUAL(lut1DSize, 0u);
+    OCIO_CHECK_EQUAL(lut3DSize, 2u);
+
+    OCIO_CHECK_ASSERT(OCIO::GetFileLutDimensions((dir + "/iridas_1d.cube").c_str(),
+                                                 lut1DSize, lut3DSize));
+    OCIO_CHECK_EQUAL(lut1DSize, 5u);
+    OCIO_CHECK_EQUAL(lut3DSize, 0u);
+
+    OCIO_CHECK_ASSERT(OCIO::GetFileLutDimensions((dir + "/resolve_1d3d.cube").c_str(),
+                                                 lut1DSize, lut3DSize));
+    OCIO_CHECK_EQUAL(lut1DSize, 6u);
+    OCIO_CHECK_EQUAL(lut3DSize, 3u);
+
+    // The LUT values are neither read nor cached.
+    OCIO_CHECK_EQUAL(OCIO::GetFileCacheMemoryUsage(), 0);
+
+    // The format does not support the header-only reading.
+    OCIO_CHECK_ASSERT(!OCIO::GetFileLutDimensions((dir + "/lut1d_1.spi1d").c_str(),
+                                                  lut1DSize, lut3DSize));
+
+    OCIO_CHECK_THROW_WHAT(OCIO::GetFileLutDimensions("", lut1DSize, lut3DSize),
+                          OCIO::Exception, "The file path is empty.");
+}
+
+OCIO_ADD_TEST(FileTransform, file_cache_budget)
+{
+    OCIO::ClearAllCaches();
+    OCIO_CHECK_EQUAL(OCIO::GetFileCacheMemoryUsage(), 0);
+
+    const std::string filePath(std::string(OCIO::getTestFilesDir()) + "/lustre_33x33x33.3dl");
+
+    OCIO::FileFormat * format = nullptr;
+    OCIO::CachedFileRcPtr file1;
+    OCIO_CHECK_NO_THROW(OCIO::GetCachedFileAndFormat(format, file1, filePath));
+    OCIO_REQUIRE_ASSERT(file1);
+
+    // The memory of the 3D LUT values is accounted for.
+    const size_t fileSize = file1->getMemorySize();
+    OCIO_CHECK_ASSERT(fileSize > 33 * 33 * 33 * 3 * sizeof(float));
+    OCIO_CHECK_EQUAL(OCIO::GetFileCacheMemoryUsage(), fileSize);
+
+    OCIO::CachedFileRcPtr file;
+    OCIO_CHECK_NO_THROW(OCIO::GetCachedFileAndFormat(format, file, filePath));
+    OCIO_CHECK_EQUAL(file.get(), file1.get());
+
+    // Find another path of the same file using the same shard of the cache.
+    std::string otherPath;
+    std::string dots;
+    for (int idx = 0; idx < 1000 && otherPath.empty(); ++idx)
+    {
+        dots += "/.";
+        const std::string path
+            = std::string(OCIO::getTestFilesDir()) + dots + "/lustre_33x33x33.3dl";
+        if (&OCIO::GetFileCacheShard(path) == &OCIO::GetFileCacheShard(filePath))
+        {
+            otherPath = path;
+        }
+    }
+    OCIO_REQUIRE_ASSERT(!otherPath.empty());
+
+    OCIO::CachedFileRcPtr file2;
+    OCIO_CHECK_NO_THROW(OCIO::GetCachedFileAndFormat(format, file2, otherPath));
+    OCIO_CHECK_NE(file2.get(), file1.get());
+    OCIO_CHECK_EQUAL(OCIO::GetFileCacheMemoryUsage(), 2 * fileSize);
+
+    // The shard now only holds one file so the least recently used one is removed.
+
+    const size_t budget = OCIO::GetFileCacheMemoryBudget();
+    OCIO::SetFileCacheMemoryBudget(OCIO::FileCacheShard::NUM_SHARDS * (fileSize + fileSize / 2));
+    OCIO_CHECK_EQUAL(OCIO::GetFileCacheMemoryUsage(), fileSize);
+
+    OCIO_CHECK_NO_THROW(OCIO::GetCachedFileAndFormat(format, file, otherPath));
+    OCIO_CHECK_EQUAL(file.get(), file2.get());
+
+    OCIO_CHECK_NO_THROW(OCIO::GetCachedFileAndFormat(format, file, filePath));
+    OCIO_CHECK_NE(file.get(), file1.get());
+    OCIO_CHECK_EQUAL(OCIO::GetFileCacheMemoryUsage(), fileSize);
+
+    OCIO::SetFileCacheMemoryBudget(budget);
+    OCIO_CHECK_EQUAL(OCIO::GetFileCacheMemoryBudget(), budget);
+
+    OCIO::ClearAllCaches();
+    OCIO_CHECK_EQUAL(OCIO::GetFileCacheMemoryUsage(), 0);
+}
+
+OCIO_ADD_TEST(FileTransform, preload_files)
+{
+    OCIO::ClearAllCaches();
+    OCIO_CHECK_EQUAL(OCIO::GetFileCacheMemoryUsage(), 0);
+
+    OCIO::ConfigRcPtr config = OCIO::Config::Create();
+    config->setSearchPath(OCIO::getTestFilesDir());
+
+    OCIO::ColorSpaceRcPtr cs = OCIO::ColorSpace::Create();
+    cs->setName("raw");
+    config->addColorSpace(cs);
+
+    OCIO::FileTransformRcPtr file1 = OCIO::FileTransform::Create();
+    file1->setSrc("lustre_33x33x33.3dl");
+    file1->setInterpolation(OCIO::INTERP_LINEAR);
+    cs = OCIO::ColorSpace::Create();
+    cs->setName("lustre");
+    cs->setTransform(file1, OCIO::COLORSPACE_DIR_FROM_REFERENCE);
+    config->addColorSpace(cs);
+
+    OCIO::FileTransformRcPtr file2 = OCIO::FileTransform::Create();
+    file2->setSrc("logtolin_8to8.lut");
+    OCIO::GroupTransformRcPtr group = OCIO::GroupTransform::Create();
+    group->appendTransform(file2);
+    OCIO::LookRcPtr look = OCIO::Look::Create();
+    look->setName("look");
+    look->setProcessSpace("raw");
+    look->setTransform(group);
+    config->addLook(look);
+
+    // The missing files are skipped.
+    OCIO::FileTransformRcPtr missing = OCIO::FileTransform::Create();
+    missing->setSrc("missing.lut");
+    cs = OCIO::ColorSpace::Create();
+    cs->setName("missing");
+    cs->setTransform(missing, OCIO::COLORSPACE_DIR_TO_REFERENCE);
+    config->addColorSpace(cs);
+
+    OCIO_CHECK_NO_THROW(config->preloadFiles(config->getCurrentContext(), 4));
+
+    const size_t usage = OCIO::GetFileCacheMemoryUsage();
+    OCIO_CHECK_ASSERT(usage > 33 * 33 * 33 * 3 * sizeof(float));
+
+    // The processors use the preloaded files.
+    OCIO_CHECK_NO_THROW(config->getProcessor("raw", "lustre"));
+    OCIO_CHECK_NO_THROW(config->getProcessor(file2));
+    OCIO_CHECK_EQUAL(OCIO::GetFileCacheMemoryUsage(), usage);
+
+    OCIO_CHECK_THROW(config->getProcessor("missing", "raw"), OCIO::Exception);
+
+    OCIO::ClearAllCaches();
+}
@@ -28,7 +28,11 @@ OCIO_ADD_GPU_TEST(FixedFunction, style_aces_redmod03_fwd)
         };
     test.setCustomValues(values);
 
+#ifdef USE_SSE
+    test.setErrorThreshold(2e-5f); // Note: Related to the sseAtan2 optimization.
+#else
     test.setErrorThreshold(1e-6f);
+#endif
 }
 
 OCIO_ADD_GPU_TEST(FixedFunction, style_aces_redmod03_inv)
@@ -50,7 +54,11 @@ OCIO_ADD_GPU_TEST(FixedFunction, style_aces_redmod03_inv)
         };
     test.setCustomValues(values);
 
+#ifdef USE_SSE
+    test.setErrorThreshold(2e-5f); // Note: Related to the sseAtan2 optimization.
+#else
     test.setErrorThreshold(1e-6f);
+#endif
 }
 
 OCIO_ADD_GPU_TEST(FixedFunction, style_aces_redmod10_fwd)
@@ -72,7 +80,11 @@ OCIO_ADD_GPU_TEST(FixedFunction, style_aces_redmod10_fwd)
         };
     test.setCustomValues(values);
 
+#ifdef USE_SSE
+    test.setErrorThreshold(2e-5f); // Note: Related to the sseAtan2 optimization.
+#else
     test.setErrorThreshold(1e-6f);
+#endif
 }
 
 OCIO_ADD_GPU_TEST(FixedFunction, style_aces_redmod10_inv)
@@ -94,7 +106,11 @@ OCIO_ADD_GPU_TEST(FixedFunction, style_aces_redmod10_inv)
         };
     test.setCustomValues(values);
 
+#ifdef USE_SSE
+    test.setErrorThreshold(2e-5f); // Note: Related to the sseAtan2 optimization.
+#else
     test.setErrorThreshold(1e-6f);
+#endif
 }
 
 OCIO_ADD_GPU_TEST(FixedFunction, style_aces_glow03_fwd)
@@ -193,7 +209,11 @@ OCIO_ADD_GPU_TEST(FixedFunction, style_aces_darktodim10_fwd)
     OCIO::GpuShaderDescRcPtr shaderDesc = OCIO::GpuShaderDesc::CreateShaderDesc();
     test.setContext(func->createEditableCopy(), shaderDesc);
 
+#ifdef USE_SSE
+    test.setErrorThreshold(5e-5f); // Note: Related to the ssePower optimization.
+#else
     test.setErrorThreshold(1e-6f);
+#endif
 
     test.setTestInfinity(false);
 }
@@ -207,7 +227,11 @@ OCIO_ADD_GPU_TEST(FixedFunction, style_aces_darktodim10_inv)
     OCIO::GpuShaderDescRcPtr shaderDesc = OCIO::GpuShaderDesc::CreateShaderDesc();
     test.setContext(func->createEditableCopy(), shaderDesc);
 
+#ifdef USE_SSE
+    test.setErrorThreshold(5e-5f); // Note: Related to the ssePower optimization.
+#else
     test.setErrorThreshold(1e-6f);
+#endif
 
     test.setTestInfinity(false);
 }
@@ -223,7 +247,11 @@ OCIO_ADD_GPU_TEST(FixedFunction, style_rec2100_surround_fwd)
     OCIO::GpuShaderDescRcPtr shaderDesc = OCIO::GpuShaderDesc::CreateShaderDesc();
     test.setContext(func->createEditableCopy(), shaderDesc);
 
+#ifdef USE_SSE
+    test.setErrorThreshold(5e-5f); // Note: Related to the ssePower optimization.
+#else
     test.setErrorThreshold(2e-6f);
+#endif
 
     test.setTestInfinity(false);
 }
@@ -240,7 +268,11 @@ OCIO_ADD_GPU_TEST(FixedFunction, style_rec2100_surround_inv)
     OCIO::GpuShaderDescRcPtr shaderDesc = OCIO::GpuShaderDesc::CreateShaderDesc();
     test.setContext(func->createEditableCopy(), shaderDesc);
 
+#ifdef USE_SSE
+    test.setErrorThreshold(5e-5f); // Note: Related to the ssePower optimization.
+#else
     test.setErrorThreshold(1e-6f);
+#endif
 
     test.setTestInfinity(false);
 }
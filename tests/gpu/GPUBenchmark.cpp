@@ -0,0 +1,572 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the OpenColorIO Project.
+
+
+#ifdef __APPLE__
+
+/* Defined before OpenGL and GLUT includes to avoid deprecation messages */
+#define GL_SILENCE_DEPRECATION
+
+#include <OpenGL/gl.h>
+#include <OpenGL/glext.h>
+#include <GLUT/glut.h>
+
+#elif _WIN32
+
+#include <GL/glew.h>
+#include <GL/glut.h>
+
+#else
+
+#include <GL/glew.h>
+#include <GL/gl.h>
+#include <GL/glut.h>
+
+#endif
+
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <OpenColorIO/OpenColorIO.h>
+
+#include "glsl.h"
+#include "GPUUnitTest.h"
+
+namespace OCIO = OCIO_NAMESPACE;
+
+
+// GPU benchmark of the color transforms of the GPU unit tests (i.e. of each op type and
+// its variants).
+//
+// For each test, it measures the creation & extraction of the shader program, the GLSL
+// program compilation and the LUT texture upload. Then for each image size, it measures
+// the image upload and the GPU time to process a frame, using timer queries when available
+// (otherwise the CPU time of a synchronized frame). The results are written in JSON to
+// compare the GPU cost between OCIO versions or drivers.
+//
+// Note that the drivers could defer a part of the compilation to the first frame, which
+// is then excluded from the frame times by warm-up frames.
+//
+// Usage: test_gpu_bench_exec [--sizes 512,1024,2048,4096] [--frames 20]
+//                            [--filter <group or name>] [--output <file.json>]
+
+namespace
+{
+
+constexpr unsigned g_components = 4;
+constexpr unsigned g_numWarmupFrames = 2;
+
+struct Options
+{
+    std::vector<unsigned> m_sizes{ 512, 1024, 2048, 4096 };
+    unsigned m_numFrames = 20;
+    std::string m_filter;
+    std::string m_output;
+};
+
+struct SizeResult
+{
+    unsigned m_size = 0;
+    double m_imageUploadMs = 0.;
+    double m_frameMinMs = 0.;
+    double m_frameMedianMs = 0.;
+    double m_frameMeanMs = 0.;
+};
+
+struct TestResult
+{
+    std::string m_group;
+    std::string m_name;
+    std::string m_error;
+
+    unsigned m_numTextures = 0;
+    unsigned m_num3DTextures = 0;
+
+    double m_extractMs = 0.;
+    double m_compileMs = 0.;
+    double m_lutUploadMs = 0.;
+
+    std::vector<SizeResult> m_sizes;
+};
+
+typedef std::chrono::steady_clock Clock;
+
+double ElapsedMs(const Clock::time_point & start)
+{
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+void PrintUsage()
+{
+    std::cerr << "Usage: test_gpu_bench_exec [--sizes 512,1024,2048,4096] [--frames 20]"
+              << " [--filter <group or name>] [--output <file.json>]" << std::endl;
+}
+
+bool ParseOptions(int argc, char ** argv, Options & options)
+{
+    for (int idx = 1; idx < argc; ++idx)
+    {
+        const std::string arg(argv[idx]);
+        if (idx + 1 >= argc)
+        {
+            return false;
+        }
+
+        const std::string value(argv[++idx]);
+        if (arg == "--sizes")
+        {
+            options.m_sizes.clear();
+
+            std::istringstream iss(value);
+            std::string size;
+            while (std::getline(iss, size, ','))
+            {
+                const int s = std::atoi(size.c_str());
+                if (s <= 0)
+                {
+                    return false;
+                }
+                options.m_sizes.push_back(unsigned(s));
+            }
+        }
+        else if (arg == "--frames")
+        {
+            const int n = std::atoi(value.c_str());
+            if (n <= 0)
+            {
+                return false;
+            }
+            options.m_numFrames = unsigned(n);
+        }
+        else if (arg == "--filter")
+        {
+            options.m_filter = value;
+        }
+        else if (arg == "--output")
+        {
+            options.m_output = value;
+        }
+        else
+        {
+            return false;
+        }
+    }
+
+    return !options.m_sizes.empty();
+}
+
+bool HasTimerQuery()
+{
+#ifdef __APPLE__
+    return false;
+#else
+    return GLEW_ARB_timer_query || GLEW_VERSION_3_3;
+#endif
+}
+
+// Process the input image texture (i.e. bound to the texture unit 0) into the frame buffer.
+void DrawImage(unsigned size)
+{
+    glViewport(0, 0, size, size);
+    glMatrixMode(GL_PROJECTION);
+    glLoadIdentity();
+    glOrtho(0.0, size, 0.0, size, -100.0, 100.0);
+    glMatrixMode(GL_MODELVIEW);
+    glLoadIdentity();
+
+    glBegin(GL_QUADS);
+        glTexCoord2f(0.0f, 1.0f);
+        glVertex2f(0.0f, (float)size);
+
+        glTexCoord2f(0.0f, 0.0f);
+        glVertex2f(0.0f, 0.0f);
+
+        glTexCoord2f(1.0f, 0.0f);
+        glVertex2f((float)size, 0.0f);
+
+        glTexCoord2f(1.0f, 1.0f);
+        glVertex2f((float)size, (float)size);
+    glEnd();
+}
+
+// Get the time to process one frame.
+double RenderFrameMs(bool timerQuery, GLuint query, unsigned size)
+{
+#ifndef __APPLE__
+    if (timerQuery)
+    {
+        glBeginQuery(GL_TIME_ELAPSED, query);
+        DrawImage(size);
+        glEndQuery(GL_TIME_ELAPSED);
+
+        // Wait for the result.
+        GLuint64 elapsedNs = 0;
+        glGetQueryObjectui64v(query, GL_QUERY_RESULT, &elapsedNs);
+        return double(elapsedNs) * 1e-6;
+    }
+#endif
+
+    glFinish();
+    const Clock::time_point start = Clock::now();
+    DrawImage(size);
+    glFinish();
+    return ElapsedMs(start);
+}
+
+GLuint CreateImageTexture(unsigned size, const float * values)
+{
+    GLuint texID = 0;
+    glGenTextures(1, &texID);
+    glBindTexture(GL_TEXTURE_2D, texID);
+
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA32F_ARB, size, size, 0,
+                 GL_RGBA, GL_FLOAT, values);
+
+    return texID;
+}
+
+// Benchmark the shader program of one test.
+void RunTest(OCIOGPUTest & test, const Options & options, bool timerQuery, GLuint query,
+             GLuint fboId, TestResult & result)
+{
+    OCIO::GpuShaderDescRcPtr & shaderDesc = test.getShaderDesc();
+    shaderDesc->setLanguage(OCIO::GPU_LANGUAGE_GLSL_1_3);
+
+    // Step 1: Create the shader program.
+
+    Clock::time_point start = Clock::now();
+    OCIO::ConstGPUProcessorRcPtr gpuProcessor = test.getProcessor()->getDefaultGPUProcessor();
+    gpuProcessor->extractGpuShaderInfo(shaderDesc);
+    result.m_extractMs = ElapsedMs(start);
+
+    result.m_numTextures   = shaderDesc->getNumTextures();
+    result.m_num3DTextures = shaderDesc->getNum3DTextures();
+
+    OCIO::OpenGLBuilderRcPtr oglBuilder = OCIO::OpenGLBuilder::Create(shaderDesc);
+
+    // Step 2: Upload the LUTs.
+
+    glFinish();
+    start = Clock::now();
+    oglBuilder->allocateAllTextures(1);
+    glFinish();
+    result.m_lutUploadMs = ElapsedMs(start);
+
+    // Step 3: Compile the GLSL program.
+
+    std::ostringstream main;
+    main << std::endl
+         << "uniform sampler2D img;" << std::endl
+         << std::endl
+         << "void main()" << std::endl
+         << "{" << std::endl
+         << "    vec4 col = texture2D(img, gl_TexCoord[0].st);" << std::endl
+         << "    gl_FragColor = " << shaderDesc->getFunctionName() << "(col);" << std::endl
+         << "}" << std::endl;
+
+    start = Clock::now();
+    oglBuilder->buildProgram(main.str().c_str());
+    glFinish();
+    result.m_compileMs = ElapsedMs(start);
+
+    oglBuilder->useProgram();
+    glUniform1i(glGetUniformLocation(oglBuilder->getProgramHandle(), "img"), 0);
+    oglBuilder->useAllTextures();
+    oglBuilder->useAllUniforms();
+
+    // Step 4: Process the images.
+
+    GLint maxTextureSize = 0;
+    glGetIntegerv(GL_MAX_TEXTURE_SIZE, &maxTextureSize);
+
+    for (const unsigned size : options.m_sizes)
+    {
+        if (size > unsigned(maxTextureSize))
+        {
+            continue;
+        }
+
+        SizeResult sizeResult;
+        sizeResult.m_size = size;
+
+        // A ramp on [-1, 2] i.e. including values outside of the normalized range.
+        std::vector<float> image(size_t(size) * size * g_components);
+        for (size_t idx = 0; idx < image.size(); ++idx)
+        {
+            image[idx] = -1.0f + 3.0f * float(idx) / float(image.size());
+        }
+
+        glActiveTexture(GL_TEXTURE0);
+
+        glFinish();
+        start = Clock::now();
+        GLuint imageTexID = CreateImageTexture(size, image.data());
+        glFinish();
+        sizeResult.m_imageUploadMs = ElapsedMs(start);
+
+        GLuint outputTexID = CreateImageTexture(size, nullptr);
+
+        glBindFramebuffer(GL_FRAMEBUFFER, fboId);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D,
+                               outputTexID, 0);
+        glDrawBuffer(GL_COLOR_ATTACHMENT0);
+
+        glActiveTexture(GL_TEXTURE0);
+        glBindTexture(GL_TEXTURE_2D, imageTexID);
+
+        std::vector<double> frameMs;
+        for (unsigned frame = 0; frame < g_numWarmupFrames + options.m_numFrames; ++frame)
+        {
+            const double ms = RenderFrameMs(timerQuery, query, size);
+            if (frame >= g_numWarmupFrames)
+            {
+                frameMs.push_back(ms);
+            }
+        }
+
+        std::sort(frameMs.begin(), frameMs.end());
+        sizeResult.m_frameMinMs    = frameMs.front();
+        sizeResult.m_frameMedianMs = frameMs[frameMs.size() / 2];
+        sizeResult.m_frameMeanMs
+            = std::accumulate(frameMs.begin(), frameMs.end(), 0.) / double(frameMs.size());
+
+        result.m_sizes.push_back(sizeResult);
+
+        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+        glDeleteTextures(1, &outputTexID);
+        glDeleteTextures(1, &imageTexID);
+    }
+
+    glUseProgram(0);
+}
+
+std::string JsonString(const std::string & str)
+{
+    std::ostringstream oss;
+    oss << '"';
+    for (const char c : str)
+    {
+        if (c == '"' || c == '\\')
+        {
+            oss << '\\' << c;
+        }
+        else if ((unsigned char)c < 0x20)
+        {
+            oss << "\\u" << std::hex << std::setw(4) << std::setfill('0') << int(c)
+                << std::dec << std::setfill(' ');
+        }
+        else
+        {
+            oss << c;
+        }
+    }
+    oss << '"';
+    return oss.str();
+}
+
+std::string GLString(GLenum name)
+{
+    const GLubyte * str = glGetString(name);
+    return str ? reinterpret_cast<const char *>(str) : "";
+}
+
+void WriteResults(std::ostream & os, const Options & options, bool timerQuery,
+                  const std::vector<TestResult> & results)
+{
+    os << std::setprecision(6) << std::fixed;
+
+    os << "{" << std::endl
+       << "  \"ocio_version\": " << JsonString(OCIO::GetVersion()) << "," << std::endl
+       << "  \"gl_vendor\": " << JsonString(GLString(GL_VENDOR)) << "," << std::endl
+       << "  \"gl_renderer\": " << JsonString(GLString(GL_RENDERER)) << "," << std::endl
+       << "  \"gl_version\": " << JsonString(GLString(GL_VERSION)) << "," << std::endl
+       << "  \"glsl_version\": " << JsonString(GLString(GL_SHADING_LANGUAGE_VERSION))
+       << "," << std::endl
+       << "  \"frame_timer\": " << JsonString(timerQuery ? "gpu" : "cpu") << "," << std::endl
+       << "  \"num_frames\": " << options.m_numFrames << "," << std::endl
+       << "  \"tests\": [";
+
+    for (size_t idx = 0; idx < results.size(); ++idx)
+    {
+        const TestResult & r = results[idx];
+
+        os << (idx == 0 ? "" : ",") << std::endl
+           << "    {" << std::endl
+           << "      \"group\": " << JsonString(r.m_group) << "," << std::endl
+           << "      \"name\": " << JsonString(r.m_name) << "," << std::endl;
+
+        if (!r.m_error.empty())
+        {
+            os << "      \"error\": " << JsonString(r.m_error) << std::endl
+               << "    }";
+            continue;
+        }
+
+        os << "      \"num_textures\": " << r.m_numTextures << "," << std::endl
+           << "      \"num_3d_textures\": " << r.m_num3DTextures << "," << std::endl
+           << "      \"extract_ms\": " << r.m_extractMs << "," << std::endl
+           << "      \"compile_ms\": " << r.m_compileMs << "," << std::endl
+           << "      \"lut_upload_ms\": " << r.m_lutUploadMs << "," << std::endl
+           << "      \"sizes\": [";
+
+        for (size_t s = 0; s < r.m_sizes.size(); ++s)
+        {
+            const SizeResult & sr = r.m_sizes[s];
+            os << (s == 0 ? "" : ",") << std::endl
+               << "        { \"width\": " << sr.m_size
+               << ", \"height\": " << sr.m_size
+               << ", \"image_upload_ms\": " << sr.m_imageUploadMs
+               << ", \"frame_min_ms\": " << sr.m_frameMinMs
+               << ", \"frame_median_ms\": " << sr.m_frameMedianMs
+               << ", \"frame_mean_ms\": " << sr.m_frameMeanMs << " }";
+        }
+
+        os << std::endl << "      ]" << std::endl
+           << "    }";
+    }
+
+    os << std::endl << "  ]" << std::endl
+       << "}" << std::endl;
+}
+
+};
+
+int main(int argc, char ** argv)
+{
+    Options options;
+    if (!ParseOptions(argc, argv, options))
+    {
+        PrintUsage();
+        return 1;
+    }
+
+    int glutArgc = 1;
+    const char * glutArgv[] = { "main" };
+    glutInit(&glutArgc, const_cast<char**>(&glutArgv[0]));
+
+    glutInitDisplayMode(GLUT_RGBA | GLUT_DOUBLE);
+    glutInitWindowSize(64, 64);
+    glutInitWindowPosition(0, 0);
+    glutCreateWindow(glutArgv[0]);
+
+#ifndef __APPLE__
+    glewInit();
+    if (!glewIsSupported("GL_VERSION_2_0"))
+    {
+        std::cerr << "OpenGL 2.0 not supported" << std::endl;
+        return 1;
+    }
+#endif
+
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+
+#ifndef __APPLE__
+    glClampColor(GL_CLAMP_READ_COLOR, GL_FALSE);
+    glClampColor(GL_CLAMP_VERTEX_COLOR, GL_FALSE);
+    glClampColor(GL_CLAMP_FRAGMENT_COLOR, GL_FALSE);
+#endif
+
+    glEnable(GL_TEXTURE_2D);
+
+    GLuint fboId = 0;
+    glGenFramebuffers(1, &fboId);
+
+    const bool timerQuery = HasTimerQuery();
+    GLuint query = 0;
+#ifndef __APPLE__
+    if (timerQuery)
+    {
+        glGenQueries(1, &query);
+    }
+#endif
+
+    std::vector<TestResult> results;
+    unsigned failures = 0;
+
+    UnitTests & tests = GetUnitTests();
+    for (size_t idx = 0; idx < tests.size(); ++idx)
+    {
+        OCIOGPUTestRcPtr test = tests[idx];
+
+        if (!options.m_filter.empty()
+            && test->group().find(options.m_filter) == std::string::npos
+            && test->name().find(options.m_filter) == std::string::npos)
+        {
+            continue;
+        }
+
+        TestResult result;
+        result.m_group = test->group();
+        result.m_name  = test->name();
+
+        try
+        {
+            test->setup();
+            if (!test->isEnabled())
+            {
+                continue;
+            }
+            if (!test->isValid())
+            {
+                throw OCIO::Exception("Invalid test");
+            }
+
+            std::cerr << "Benchmarking " << result.m_group << " / " << result.m_name
+                      << std::endl;
+
+            RunTest(*test, options, timerQuery, query, fboId, result);
+        }
+        catch (std::exception & ex)
+        {
+            ++failures;
+            result.m_error = ex.what();
+        }
+
+        results.push_back(result);
+
+        // Get rid of the test.
+        tests[idx] = nullptr;
+
+        glUseProgram(0);
+        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    }
+
+#ifndef __APPLE__
+    if (timerQuery)
+    {
+        glDeleteQueries(1, &query);
+    }
+#endif
+    glDeleteFramebuffers(1, &fboId);
+
+    if (options.m_output.empty())
+    {
+        WriteResults(std::cout, options, timerQuery, results);
+    }
+    else
+    {
+        std::ofstream ofs(options.m_output.c_str());
+        if (!ofs)
+        {
+            std::cerr << "Cannot write the file: " << options.m_output << std::endl;
+            return 1;
+        }
+        WriteResults(ofs, options, timerQuery, results);
+    }
+
+    return failures;
+}
@@ -202,6 +202,9 @@ AddTest::AddTest(OCIOGPUTestRcPtr test)
 }
 
 
+// The benchmark (refer to GPUBenchmark.cpp) reuses the tests but has its own main().
+#ifndef OCIO_GPU_BENCHMARK
+
 namespace
 {
     GLint g_win = 0;
@@ -782,3 +785,5 @@ int main(int, char **)
 
     return failures;
 }
+
+#endif // OCIO_GPU_BENCHMARK
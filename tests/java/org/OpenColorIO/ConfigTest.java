@@ -201,6 +201,19 @@ public class ConfigTest extends TestCase {
         float rgbafoo[] = new float[]{0.48f, 0.18f, 0.18f, 1.f};
         _proc.applyRGBA(rgbafoo);
         assertEquals(1.f, rgbafoo[3], 1e-8);
+        FloatBuffer direct = ByteBuffer.allocateDirect(2 * 4 * Float.SIZE / 8)
+            .order(ByteOrder.nativeOrder()).asFloatBuffer();
+        direct.put(new float[]{0.48f, 0.18f, 0.18f, 1.f, 0.48f, 0.18f, 0.18f, 1.f});
+        _proc.apply(direct, 2, 1, 4, BitDepth.BIT_DEPTH_F32);
+        assertEquals(rgbafoo[0], direct.get(0), 1e-6);
+        assertEquals(rgbafoo[0], direct.get(4), 1e-6);
+        FloatBuffer strided = ByteBuffer.allocateDirect(2 * 4 * Float.SIZE / 8)
+            .order(ByteOrder.nativeOrder()).asFloatBuffer();
+        strided.put(new float[]{0.48f, 0.18f, 0.18f, 1.f, 0.48f, 0.18f, 0.18f, 1.f});
+        _proc.apply(strided, 1, 2, 3, BitDepth.BIT_DEPTH_F32,
+                    Processor.AutoStride, 16, 16);
+        assertEquals(rgbfoo[0], strided.get(0), 1e-6);
+        assertEquals(1.f, strided.get(3), 1e-8);
         //assertEquals("$a92ef63abd9edf61ad5a7855da064648", _proc.getCpuCacheID());
         GpuShaderDesc desc = new GpuShaderDesc();
         desc.setLanguage(GpuLanguage.GPU_LANGUAGE_GLSL_1_3);
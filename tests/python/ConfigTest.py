@@ -1,7 +1,7 @@
 # SPDX-License-Identifier: BSD-3-Clause
 # Copyright Contributors to the OpenColorIO Project.
 
-import unittest, os, sys
+import unittest, os, sys, array
 import PyOpenColorIO as OCIO
 
 import platform
@@ -225,8 +225,32 @@ return out_pixel;
         # TODO: these should work in-place
         rgbafoo = _proc.applyRGBA([0.48, 0.18, 0.18, 1.0])
         self.assertAlmostEqual(1.0, rgbafoo[3], delta=1e-8)
+        
+        # In place processing of any buffer.
+        rgbbuf = array.array('f', [0.48, 0.18, 0.18, 0.48, 0.18, 0.18])
+        self.assertTrue(rgbbuf is _proc.apply(rgbbuf, 3))
+        self.assertAlmostEqual(1.9351077, rgbbuf[0], delta=1e-6)
+        self.assertAlmostEqual(1.9351077, rgbbuf[3], delta=1e-6)
+        rgbabuf = array.array('f', [0.48, 0.18, 0.18, 1.0])
+        _proc.apply(rgbabuf, numChannels=4)
+        self.assertAlmostEqual(1.0, rgbabuf[3], delta=1e-8)
+        with self.assertRaises(TypeError):
+            _proc.apply(array.array('f', [0.48, 0.18]), 3)
+        with self.assertRaises(TypeError):
+            _proc.apply(array.array('d', [0.48, 0.18, 0.18]), 3)
         #self.assertEqual("$a92ef63abd9edf61ad5a7855da064648", _proc.getCpuCacheID())
         
+        # Several processors built concurrently.
+        _cst = OCIO.ColorSpaceTransform()
+        _cst.setSrc("vd8")
+        _cst.setDst("lnh")
+        _procs = _cfg.getProcessors([("lnh", "vd8"), _cst, ("vd8", "lnh")], numThreads=2)
+        self.assertEqual(3, len(_procs))
+        self.assertAlmostEqual(1.9351077, _procs[0].applyRGB([0.48, 0.18, 0.18])[0], delta=1e-7)
+        self.assertEqual(_procs[1].applyRGB([0.5, 0.5, 0.5]), _procs[2].applyRGB([0.5, 0.5, 0.5]))
+        with self.assertRaises(ValueError):
+            _cfg.getProcessors([("lnh", "missing")])
+        
         _cfge.clearSearchPaths()
         self.assertEqual(0, _cfge.getNumSearchPaths())
         _cfge.addSearchPath("First/ Path")
@@ -13,6 +13,28 @@ class GpuShaderDescTest(unittest.TestCase):
         desc.setFunctionName("foo123")
         self.assertEqual("foo123", desc.getFunctionName())
         desc.finalize()
-        self.assertEqual("glsl_1.3 foo123 ocio outColor $159b6ac2bdbbe3b57824faea46bd829b", 
+        self.assertEqual("glsl_1.3 foo123 ocio outColor $c81cdb2bf12e1f33bf489e799e8e181a", 
                          desc.getCacheID())
 
+
+    def test_texture_values(self):
+        cfg = OCIO.Config()
+        exp = OCIO.ExponentTransform()
+        exp.setValue([2.2, 2.2, 2.2, 1.0])
+        proc = cfg.getProcessor(exp)
+        desc = OCIO.GpuShaderDesc()
+        proc.extractGpuShaderInfo(desc)
+        self.assertTrue(len(desc.getShaderText()) > 0)
+        for index in range(desc.getNumTextures()):
+            name, _id, width, height, channels, interp = desc.getTexture(index)
+            values = desc.getTextureValues(index)
+            self.assertTrue(values.readonly)
+            self.assertEqual('f', values.format)
+            self.assertEqual((height, width, channels), values.shape)
+        for index in range(desc.getNum3DTextures()):
+            name, _id, edgelen, interp = desc.get3DTexture(index)
+            values = desc.get3DTextureValues(index)
+            self.assertTrue(values.readonly)
+            self.assertEqual((edgelen, edgelen, edgelen, 3), values.shape)
+            # The legacy shader description bakes a 3D LUT of 32 entries per edge.
+            self.assertEqual(32, edgelen)